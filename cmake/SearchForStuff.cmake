@@ -552,6 +552,28 @@ if (PKG_CONFIG_FOUND)
     BUILD_WARNING ("GNU Triangulation Surface library not found - Gazebo will not have CSG support.")
   endif ()
 
+  ########################################
+  # Find zstd, an optional codec for state logs
+  pkg_check_modules(zstd libzstd)
+  if (zstd_FOUND)
+    message (STATUS "Looking for zstd - found")
+    set (HAVE_ZSTD TRUE)
+  else ()
+    set (HAVE_ZSTD FALSE)
+    BUILD_WARNING ("zstd not found - state logs can not be recorded with zstd compression.")
+  endif ()
+
+  ########################################
+  # Find google benchmark, optional for the gazebo_microbench target
+  find_package(benchmark QUIET)
+  if (benchmark_FOUND)
+    message (STATUS "Looking for google benchmark - found")
+    set (HAVE_GOOGLE_BENCHMARK TRUE)
+  else ()
+    message (STATUS "Looking for google benchmark - not found, gazebo_microbench will not be built")
+    set (HAVE_GOOGLE_BENCHMARK FALSE)
+  endif ()
+
   #################################################
   # Find bullet
   # First and preferred option is to look for bullet standard pkgconfig,
@@ -575,6 +597,11 @@ if (PKG_CONFIG_FOUND)
     add_definitions( -DLIBBULLET_VERSION_GT_282 )
   endif()
 
+  # The multithreaded dynamics world and constraint solver
+  if (BULLET_FOUND AND NOT BULLET_VERSION VERSION_LESS 2.88)
+    add_definitions( -DLIBBULLET_VERSION_GE_288 )
+  endif()
+
   ########################################
   # Find libusb
   pkg_check_modules(libusb-1.0 libusb-1.0)
@@ -108,6 +108,31 @@ ODE_API int dWorldGetIslandThreads (dWorldID);
  */
 ODE_API void dWorldSetIslandThreads (dWorldID, int num_island_threads);
 
+/**
+ * @brief Callback called when an island starts or ends being stepped.
+ *
+ * @param data User data given to dWorldSetIslandCallbacks.
+ * @param bodies Number of bodies in the island.
+ * @param joints Number of joints in the island.
+ * @ingroup world
+ */
+typedef void dIslandCallback (void *data, int bodies, int joints);
+
+/**
+ * @brief Set callbacks called around the stepping of each island, for
+ * example to profile them.
+ *
+ * The callbacks are called from the thread that steps the island, which is
+ * one of the island threads when there are any.
+ *
+ * @param begin Called before the island is stepped, may be NULL.
+ * @param end Called after the island is stepped, may be NULL.
+ * @param data User data passed to the callbacks.
+ * @ingroup world
+ */
+ODE_API void dWorldSetIslandCallbacks (dWorldID, dIslandCallback *begin,
+    dIslandCallback *end, void *data);
+
 /**
  * @brief Set the number of thread pool threads for quickstep
  *
@@ -511,6 +536,32 @@ ODE_API int dWorldGetQuickStepNumIterations (dWorldID);
  */
 ODE_API int dWorldGetQuickStepPreconIterations (dWorldID);
 
+/**
+ * @brief Set the least number of iterations the QuickStep method performs
+ *        per step before stopping on the tolerance set by
+ *        dWorldSetQuickStepTolerance.
+ * @ingroup world
+ * @param num The default is 0 iterations.
+ */
+ODE_API void dWorldSetQuickStepMinIterations (dWorldID, int num);
+
+/**
+ * @brief Get the least number of iterations the QuickStep method performs
+ *        per step.
+ * @ingroup world
+ * @return nr of iterations
+ */
+ODE_API int dWorldGetQuickStepMinIterations (dWorldID);
+
+/**
+ * @brief Get the number of iterations, including preconditioning
+ *        iterations, that the last QuickStep performed. With several
+ *        islands, this is the largest count of all islands.
+ * @ingroup world
+ * @return nr of iterations
+ */
+ODE_API int dWorldGetQuickStepIterationsUsed (dWorldID);
+
 /**
  * @brief Set the SOR over-relaxation parameter
  * @ingroup world
@@ -1851,6 +1902,30 @@ ODE_API void dBodySetGyroscopicMode(dBodyID b, int enabled);
 
 ODE_API void dJointReset(dJointID);
 
+/**
+ * @brief Get the constraint impulses computed by the last quickstep.
+ *
+ * Together with dJointSetLambda, this allows the impulses of a contact
+ * joint to be carried over to the contact joint that replaces it on the
+ * next step, which is then used as the initial guess of the solver when
+ * warm starting is enabled.
+ * @ingroup joints
+ * @param lambda Array of 6 values that receives the impulses.
+ * @param lambda_erp Array of 6 values that receives the position
+ * correction impulses.
+ */
+ODE_API void dJointGetLambda(dJointID, dReal *lambda, dReal *lambda_erp);
+
+/**
+ * @brief Set the initial guess of the constraint impulses for the next
+ * quickstep.
+ * @ingroup joints
+ * @param lambda Array of 6 impulses.
+ * @param lambda_erp Array of 6 position correction impulses.
+ */
+ODE_API void dJointSetLambda(dJointID, const dReal *lambda,
+    const dReal *lambda_erp);
+
 /**
  * @brief Create a new joint of the ball type.
  * @ingroup joints
@@ -26,6 +26,8 @@ spaces
 
 */
 
+#include <vector>
+
 #include <gazebo/ode/common.h>
 #include <gazebo/ode/matrix.h>
 #include <gazebo/ode/collision_space.h>
@@ -372,17 +374,52 @@ static unsigned long getVirtualAddress (int level, int x, int y, int z)
 //****************************************************************************
 // hash space
 
+// an AABB in the cached hash table of a hash space
+struct dxCachedAABB {
+  dxGeom *geom;		// corresponding geometry object (AABB stored here)
+  int level;		// the level this is stored in (cell size = 2^level)
+  int dbounds[6];	// AABB bounds, discretized to cell size
+  unsigned stamp;	// last query that tested this AABB
+};
+
+
+// a node of the cached hash table, nodes are linked by index
+struct dxCachedNode {
+  int next;		// next node in hash table collision list, -1 if none
+  int x,y,z;		// cell position in space, discretized to cell size
+  int aabb;		// index of the AABB that intersects this cell
+};
+
+
 struct dxHashSpace : public dxSpace {
   int global_minlevel;	// smallest hash table level to put AABBs in
   int global_maxlevel;	// objects that need a level larger than this will be
 			// put in a "big objects" list instead of a hash table
 
+  // collide2 keeps the hash table around when the space is unchanged
+  // between calls, which is the case for spaces of static geoms. the state
+  // is 0 if the space changed since the last collide2, 1 if it didn't but
+  // there is no table yet, and 2 if the table is valid.
+  int cache_state;
+  unsigned cache_stamp;			// stamp of the current query
+  std::vector<dxCachedAABB> cache_aabbs;
+  std::vector<dxCachedNode> cache_nodes;
+  std::vector<int> cache_table;		// first node of each bucket, or -1
+  std::vector<int> cache_big;		// AABBs too big for the table
+  std::vector<std::vector<int> > cache_levels;	// AABBs of each level
+
   dxHashSpace (dSpaceID _space);
   void setLevels (int minlevel, int maxlevel);
   void getLevels (int *minlevel, int *maxlevel);
+  void add (dxGeom *);
+  void remove (dxGeom *);
+  void dirty (dxGeom *);
   void cleanGeoms();
   void collide (void *data, dNearCallback *callback);
   void collide2 (void *data, dxGeom *geom, dNearCallback *callback);
+
+  void buildCache();
+  void collideCached (void *data, dxGeom *geom, dNearCallback *callback);
 };
 
 
@@ -391,6 +428,8 @@ dxHashSpace::dxHashSpace (dSpaceID _space) : dxSpace (_space)
   type = dHashSpaceClass;
   global_minlevel = -3;
   global_maxlevel = 10;
+  cache_state = 0;
+  cache_stamp = 0;
 }
 
 
@@ -399,6 +438,28 @@ void dxHashSpace::setLevels (int minlevel, int maxlevel)
   dAASSERT (minlevel <= maxlevel);
   global_minlevel = minlevel;
   global_maxlevel = maxlevel;
+  cache_state = 0;
+}
+
+
+void dxHashSpace::add (dxGeom *geom)
+{
+  dxSpace::add (geom);
+  cache_state = 0;
+}
+
+
+void dxHashSpace::remove (dxGeom *geom)
+{
+  dxSpace::remove (geom);
+  cache_state = 0;
+}
+
+
+void dxHashSpace::dirty (dxGeom *geom)
+{
+  dxSpace::dirty (geom);
+  cache_state = 0;
 }
 
 
@@ -605,21 +666,153 @@ void dxHashSpace::collide2 (void *_data, dxGeom *geom,
 {
   dAASSERT (geom && callback);
   
-  // this could take advantage of the hash structure to avoid
-  // O(n2) complexity, but it does not yet.
-  
   lock_count++;
   cleanGeoms();
   geom->recomputeAABB();
-  
-  // intersect bounding boxes
-  for (dxGeom *g=first; g; g=g->next) {
-    if (GEOM_ENABLED(g)) collideAABBs (g,geom,_data,callback);
+
+  // building the hash table costs more than a single pass over the geoms,
+  // so it's only done once the space was left unchanged between two calls.
+  if (cache_state == 0) {
+    // intersect bounding boxes
+    for (dxGeom *g=first; g; g=g->next) {
+      if (GEOM_ENABLED(g)) collideAABBs (g,geom,_data,callback);
+    }
+    cache_state = 1;
   }
-  
+  else {
+    if (cache_state == 1) {
+      buildCache();
+      cache_state = 2;
+    }
+    collideCached (_data,geom,callback);
+  }
+
   lock_count--;
 }
 
+
+void dxHashSpace::buildCache()
+{
+  cache_aabbs.clear();
+  cache_nodes.clear();
+  cache_big.clear();
+  cache_levels.clear();
+  cache_levels.resize (global_maxlevel - global_minlevel + 1);
+  cache_stamp = 0;
+
+  int n = 0;
+  for (dxGeom *geom = first; geom; geom=geom->next) {
+    dxCachedAABB aabb;
+    aabb.geom = geom;
+    aabb.stamp = 0;
+    int level = findLevel (geom->aabb);
+    if (level < global_minlevel) level = global_minlevel;
+    aabb.level = level;
+    if (level <= global_maxlevel) {
+      dReal cellsize = (dReal) ldexp (1.0,level);
+      for (int i=0; i < 6; i++) aabb.dbounds[i] = (int)
+        floor (geom->aabb[i]/cellsize);
+      cache_levels[level - global_minlevel].push_back (n);
+    }
+    else {
+      cache_big.push_back (n);
+    }
+    cache_aabbs.push_back (aabb);
+    n++;
+  }
+
+  // compute hash table size sz to be a prime > 8*n
+  int i;
+  for (i=0; i<NUM_PRIMES; i++) {
+    if (prime[i] >= (8*n)) break;
+  }
+  if (i >= NUM_PRIMES) i = NUM_PRIMES-1;
+  int sz = prime[i];
+  cache_table.assign (sz,-1);
+
+  for (int a = 0; a < n; a++) {
+    const dxCachedAABB &aabb = cache_aabbs[a];
+    if (aabb.level > global_maxlevel) continue;
+    const int *dbounds = aabb.dbounds;
+    for (int xi = dbounds[0]; xi <= dbounds[1]; xi++) {
+      for (int yi = dbounds[2]; yi <= dbounds[3]; yi++) {
+        for (int zi = dbounds[4]; zi <= dbounds[5]; zi++) {
+          unsigned long hi = getVirtualAddress (aabb.level,xi,yi,zi) % sz;
+          dxCachedNode node;
+          node.x = xi;
+          node.y = yi;
+          node.z = zi;
+          node.aabb = a;
+          node.next = cache_table[hi];
+          cache_table[hi] = (int) cache_nodes.size();
+          cache_nodes.push_back (node);
+        }
+      }
+    }
+  }
+}
+
+
+void dxHashSpace::collideCached (void *_data, dxGeom *geom,
+                                 dNearCallback *callback)
+{
+  // stamps tell which AABBs were already tested, since an AABB is in up to
+  // 8 cells of its level
+  if (++cache_stamp == 0) {
+    for (size_t a = 0; a < cache_aabbs.size(); a++) cache_aabbs[a].stamp = 0;
+    cache_stamp = 1;
+  }
+
+  const int glevel = findLevel (geom->aabb);
+  const unsigned long sz = cache_table.size();
+  for (size_t l = 0; l < cache_levels.size(); l++) {
+    const std::vector<int> &aabbs = cache_levels[l];
+    if (aabbs.empty()) continue;
+
+    const int level = global_minlevel + (int) l;
+    int db[6];
+    double cells = dInfinity;
+    if (glevel != MAXINT) {
+      dReal cellsize = (dReal) ldexp (1.0,level);
+      for (int i=0; i < 6; i++) db[i] = (int) floor (geom->aabb[i]/cellsize);
+      cells = (double) (db[1] - db[0] + 1) * (db[3] - db[2] + 1) *
+        (db[5] - db[4] + 1);
+    }
+
+    if (cells > (double) aabbs.size()) {
+      // the geom covers more cells of this level than there are AABBs in
+      // it, test them all
+      for (size_t k = 0; k < aabbs.size(); k++) {
+        dxGeom *g = cache_aabbs[aabbs[k]].geom;
+        if (GEOM_ENABLED(g)) collideAABBs (g,geom,_data,callback);
+      }
+      continue;
+    }
+
+    for (int xi = db[0]; xi <= db[1]; xi++) {
+      for (int yi = db[2]; yi <= db[3]; yi++) {
+        for (int zi = db[4]; zi <= db[5]; zi++) {
+          unsigned long hi = getVirtualAddress (level,xi,yi,zi) % sz;
+          for (int n = cache_table[hi]; n >= 0; n = cache_nodes[n].next) {
+            const dxCachedNode &node = cache_nodes[n];
+            dxCachedAABB &aabb = cache_aabbs[node.aabb];
+            if (aabb.level != level || aabb.stamp == cache_stamp ||
+                node.x != xi || node.y != yi || node.z != zi) continue;
+            aabb.stamp = cache_stamp;
+            if (GEOM_ENABLED(aabb.geom))
+              collideAABBs (aabb.geom,geom,_data,callback);
+          }
+        }
+      }
+    }
+  }
+
+  for (size_t k = 0; k < cache_big.size(); k++) {
+    dxGeom *g = cache_aabbs[cache_big[k]].geom;
+    if (GEOM_ENABLED(g)) collideAABBs (g,geom,_data,callback);
+  }
+}
+
 //****************************************************************************
 // space functions
 
@@ -26,6 +26,7 @@
 #ifndef _ODE_OBJECT_H_
 #define _ODE_OBJECT_H_
 
+#include <atomic>
 #include <limits>
 #include <gazebo/ode/common.h>
 #include <gazebo/ode/memory.h>
@@ -98,6 +99,8 @@ struct dxDampingParameters {
 struct dxQuickStepParameters {
   int precon_iterations;  // number of preconditioned PGS iterations to perform (without error correction)
   int num_iterations;    // number of PGS iterations to perform
+  int min_iterations;    // least number of PGS iterations before stopping on pgs_lcp_tolerance
+  std::atomic<int> iterations_used; // most iterations done by an island in the last step
   dReal w;      // the PGS over-relaxation parameter
   int num_chunks;    // divide rows to these many chunks
   int num_overlap;    // divide rows but over lap this many rows
@@ -185,6 +188,17 @@ struct dxBody : public dObject {
 };
 
 
+// range of the body and joint arrays that make up an island
+struct dxIslandRange {
+  int index;                 // index of the island working memory
+  size_t req;                // memory estimate, used as a cost estimate
+  dxBody *const *bodystart;
+  int bcount;
+  dxJoint *const *jointstart;
+  int jcount;
+};
+
+
 struct dxWorld : public dBase {
   dxBody *firstbody;    // body linked list
   dxJoint *firstjoint;    // joint linked list
@@ -204,6 +218,10 @@ struct dxWorld : public dBase {
   dReal max_angular_speed;      // limit the angular velocity to this magnitude
   boost::threadpool::pool *threadpool;
   boost::threadpool::pool *row_threadpool;
+  std::vector<dxIslandRange> island_ranges; // islands in scheduling order
+  dIslandCallback *island_begin_fn; // called before stepping an island
+  dIslandCallback *island_end_fn;   // called after stepping an island
+  void *island_fn_data;             // user data for the island callbacks
 };
 
 
@@ -1222,6 +1222,27 @@ void dJointReset(dJointID _j)
     _j->lambda[i] = 0.0;
 }
 
+void dJointGetLambda(dJointID _j, dReal *_lambda, dReal *_lambda_erp)
+{
+  dAASSERT (_j && _lambda && _lambda_erp);
+  for (unsigned int i=0; i<6; i++)
+  {
+    _lambda[i] = _j->lambda[i];
+    _lambda_erp[i] = _j->lambda_erp[i];
+  }
+}
+
+void dJointSetLambda(dJointID _j, const dReal *_lambda,
+    const dReal *_lambda_erp)
+{
+  dAASSERT (_j && _lambda && _lambda_erp);
+  for (unsigned int i=0; i<6; i++)
+  {
+    _j->lambda[i] = _lambda[i];
+    _j->lambda_erp[i] = _lambda_erp[i];
+  }
+}
+
 dxJoint * dJointCreateBall (dWorldID w, dJointGroupID group)
 {
     dAASSERT (w);
@@ -1648,6 +1669,8 @@ dxWorld * dWorldCreate()
   w->adis.linear_average_threshold = REAL(0.01)*REAL(0.01);    // (magnitude squared)
 
   w->qs.num_iterations = 20;
+  w->qs.min_iterations = 0;
+  w->qs.iterations_used = 0;
   w->qs.precon_iterations = 0;
   w->qs.w = REAL(1.3);
   w->qs.num_chunks = 1;
@@ -1683,6 +1706,9 @@ dxWorld * dWorldCreate()
 
   w->threadpool = NULL; // new boost::threadpool::pool(0);
   w->row_threadpool = NULL; // new boost::threadpool::pool(0);
+  w->island_begin_fn = NULL;
+  w->island_end_fn = NULL;
+  w->island_fn_data = NULL;
 
   return w;
 }
@@ -1792,6 +1818,18 @@ void dWorldSetIslandThreads (dWorldID w, int num_island_threads)
   }
 }
 
+void dWorldSetIslandCallbacks (dWorldID w, dIslandCallback *begin,
+    dIslandCallback *end, void *data)
+{
+  dAASSERT (w);
+  if (w->threadpool) {
+    w->threadpool->wait();
+  }
+  w->island_begin_fn = begin;
+  w->island_end_fn = end;
+  w->island_fn_data = data;
+}
+
 void dWorldSetQuickStepThreads (dWorldID w, int num_quickstep_threads)
 {
   dAASSERT (w);
@@ -1984,6 +2022,8 @@ int dWorldQuickStep (dWorldID w, dReal stepsize)
 
   bool result = false;
 
+  w->qs.iterations_used = 0;
+
   if (dxReallocateWorldProcessContext (w, stepsize, &dxEstimateQuickStepMemoryRequirements))
   {
     dxProcessIslands (w, stepsize, &dxQuickStepper);
@@ -2239,6 +2279,24 @@ int dWorldGetQuickStepNumIterations (dWorldID w)
   return w->qs.num_iterations;
 }
 
+void dWorldSetQuickStepMinIterations (dWorldID w, int num)
+{
+  dAASSERT(w);
+  w->qs.min_iterations = num;
+}
+
+int dWorldGetQuickStepMinIterations (dWorldID w)
+{
+  dAASSERT(w);
+  return w->qs.min_iterations;
+}
+
+int dWorldGetQuickStepIterationsUsed (dWorldID w)
+{
+  dAASSERT(w);
+  return w->qs.iterations_used;
+}
+
 void dWorldSetRobustStepMaxIterations (dWorldID w, int num)
 {
   dAASSERT(w);
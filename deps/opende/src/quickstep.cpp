@@ -524,8 +524,9 @@ void dxQuickStepper (dxWorldProcessContext *context,
     {
       // warm starting
       // save lambda for the next iteration
-      //@@@ note that this doesn't work for contact joints yet, as they are
-      // recreated every iteration
+      // contact joints are recreated every iteration, so their lambdas
+      // only carry over if the caller copies them with dJointGetLambda
+      // and dJointSetLambda
       const dReal *lambdacurr = lambda;
       const dReal *lambda_erpcurr = lambda_erp;
       const dJointWithInfo1 *jicurr = jointiinfos;
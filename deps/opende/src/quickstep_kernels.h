@@ -0,0 +1,126 @@
+/*************************************************************************
+ *                                                                       *
+ * Open Dynamics Engine, Copyright (C) 2001,2002 Russell L. Smith.       *
+ * All rights reserved.  Email: russ@q12.org   Web: www.q12.org          *
+ *                                                                       *
+ * This library is free software; you can redistribute it and/or         *
+ * modify it under the terms of EITHER:                                  *
+ *   (1) The GNU Lesser General Public License as published by the Free  *
+ *       Software Foundation; either version 2.1 of the License, or (at  *
+ *       your option) any later version. The text of the GNU Lesser      *
+ *       General Public License is included with this library in the     *
+ *       file LICENSE.TXT.                                               *
+ *   (2) The BSD-style license that is included with this library in     *
+ *       the file LICENSE-BSD.TXT.                                       *
+ *                                                                       *
+ * This library is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the files    *
+ * LICENSE.TXT and LICENSE-BSD.TXT for more details.                     *
+ *                                                                       *
+ *************************************************************************/
+
+// 6-wide kernels used by the PGS row update, one call per body of each
+// constraint row. They are kept apart from quickstep_util.h so that they
+// can be benchmarked on their own.
+//
+// define ODE_SSE to enable SSE, which is used to speed up
+// vector math operations with gcc compiler
+// macro SSE is renamed to ODE_SSE due to conflict with Eigen3 in DART
+//
+// define ODE_AVX (x86_64, needs -mavx2) or ODE_NEON (aarch64) to use the
+// wider or native registers of those targets instead. only valid in double
+// precision. all vector versions add the products in the same order as the
+// SSE version, so switching between them doesn't change the results as
+// long as the compiler doesn't fuse the multiply and add (no -mfma, or
+// -ffp-contract=off).
+
+#ifndef _ODE_QUICK_STEP_KERNELS_H_
+#define _ODE_QUICK_STEP_KERNELS_H_
+
+#include <gazebo/ode/common.h>
+
+#if defined(ODE_AVX) || defined(ODE_NEON)
+#ifndef dDOUBLE
+#error "ODE_AVX and ODE_NEON require double precision"
+#endif
+#endif
+
+#if defined(ODE_AVX)
+#include <immintrin.h>
+#elif defined(ODE_NEON)
+#include <arm_neon.h>
+#endif
+
+#ifdef ODE_SSE
+#include <xmmintrin.h>
+#define Kf(x) _mm_set_pd((x),(x))
+#endif
+
+namespace ode {
+    namespace quickstep{
+
+// dot product of two vector a and b with length 6
+inline dReal dot6(const dReal *a, const dReal *b)
+{
+#if defined(ODE_AVX)
+  // a[0..3]*b[0..3] in one register, then fold it the way the SSE version
+  // adds its lanes. unaligned loads, body blocks are only 16 byte aligned.
+  __m256d p = _mm256_mul_pd(_mm256_loadu_pd(a), _mm256_loadu_pd(b));
+  __m128d d = _mm_add_pd(_mm_add_pd(_mm256_castpd256_pd128(p),
+                                    _mm256_extractf128_pd(p, 1)),
+                         _mm_mul_pd(_mm_loadu_pd(a+4), _mm_loadu_pd(b+4)));
+  return _mm_cvtsd_f64(d) + _mm_cvtsd_f64(_mm_unpackhi_pd(d, d));
+#elif defined(ODE_NEON)
+  float64x2_t d = vaddq_f64(vaddq_f64(vmulq_f64(vld1q_f64(a+0), vld1q_f64(b+0)),
+                                      vmulq_f64(vld1q_f64(a+2), vld1q_f64(b+2))),
+                            vmulq_f64(vld1q_f64(a+4), vld1q_f64(b+4)));
+  return vgetq_lane_f64(d, 0) + vgetq_lane_f64(d, 1);
+#elif defined(ODE_SSE)
+  __m128d d = _mm_load_pd(a+0) * _mm_load_pd(b+0) + _mm_load_pd(a+2) * _mm_load_pd(b+2) + _mm_load_pd(a+4) * _mm_load_pd(b+4);
+  double r[2];
+  _mm_store_pd(r, d);
+  return r[0] + r[1];
+#else
+  return a[0] * b[0] +
+         a[1] * b[1] +
+         a[2] * b[2] +
+         a[3] * b[3] +
+         a[4] * b[4] +
+         a[5] * b[5];
+#endif
+}
+
+// a = a + delta * b, vector a and b with length 6
+inline void sum6(dReal *a, dReal delta, const dReal *b)
+{
+#if defined(ODE_AVX)
+  __m256d delta4 = _mm256_set1_pd(delta);
+  _mm256_storeu_pd(a + 0, _mm256_add_pd(_mm256_loadu_pd(a + 0),
+                                        _mm256_mul_pd(delta4, _mm256_loadu_pd(b + 0))));
+  _mm_storeu_pd(a + 4, _mm_add_pd(_mm_loadu_pd(a + 4),
+                                  _mm_mul_pd(_mm256_castpd256_pd128(delta4),
+                                             _mm_loadu_pd(b + 4))));
+#elif defined(ODE_NEON)
+  float64x2_t delta2 = vdupq_n_f64(delta);
+  vst1q_f64(a + 0, vaddq_f64(vld1q_f64(a + 0), vmulq_f64(delta2, vld1q_f64(b + 0))));
+  vst1q_f64(a + 2, vaddq_f64(vld1q_f64(a + 2), vmulq_f64(delta2, vld1q_f64(b + 2))));
+  vst1q_f64(a + 4, vaddq_f64(vld1q_f64(a + 4), vmulq_f64(delta2, vld1q_f64(b + 4))));
+#elif defined(ODE_SSE)
+  __m128d __delta = Kf(delta);
+  _mm_store_pd(a + 0, _mm_load_pd(a + 0) + __delta * _mm_load_pd(b + 0));
+  _mm_store_pd(a + 2, _mm_load_pd(a + 2) + __delta * _mm_load_pd(b + 2));
+  _mm_store_pd(a + 4, _mm_load_pd(a + 4) + __delta * _mm_load_pd(b + 4));
+#else
+  a[0] += delta * b[0];
+  a[1] += delta * b[1];
+  a[2] += delta * b[2];
+  a[3] += delta * b[3];
+  a[4] += delta * b[4];
+  a[5] += delta * b[5];
+#endif
+}
+
+    } // namespace quickstep
+} // namespace ode
+#endif
@@ -205,6 +205,9 @@ static void* ComputeRows(void *p)
   dRealMutablePtr cforce_ptr2;
   int total_iterations = precon_iterations + num_iterations +
     friction_iterations;
+  // iterations before the tolerance may stop the solver
+  int min_iterations = precon_iterations + qs->min_iterations;
+  int iterations_done = total_iterations;
   for (int iteration = 0; iteration < total_iterations; ++iteration)
   {
     // reset rms_dlambda at beginning of iteration
@@ -886,6 +889,7 @@ static void* ComputeRows(void *p)
 
     // option to stop when tolerance has been met
     if (iteration >= precon_iterations &&
+        iteration + 1 >= min_iterations &&
         qs->rms_constraint_residual[3] < pgs_lcp_tolerance)
     {
       #ifdef DEBUG_CONVERGENCE_TOLERANCE
@@ -897,6 +901,7 @@ static void* ComputeRows(void *p)
           pgs_lcp_tolerance);
       #endif
       // tolerance satisfied, stop iterating
+      iterations_done = iteration + 1;
       break;
     }
     else if (iteration >= total_iterations - 1)
@@ -937,6 +942,16 @@ static void* ComputeRows(void *p)
   printf("      quickstep row thread %d start time %f ended time %f duration %f\n",thread_id,cur_time,end_time,end_time - cur_time);
   #endif
 
+  // islands may be solved at the same time, keep the largest count
+  if (!position_correction_thread)
+  {
+    int used = qs->iterations_used;
+    while (used < iterations_done &&
+           !qs->iterations_used.compare_exchange_weak(used, iterations_done))
+    {
+    }
+  }
+
   if (position_correction_thread)
     IFTIMING (dTimerNow ("ComputeRows_erp ends"));
   else
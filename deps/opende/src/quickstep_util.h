@@ -26,10 +26,7 @@
 #include <gazebo/ode/common.h>
 #include "gazebo/gazebo_config.h"
 
-#ifdef ODE_SSE
-#include <xmmintrin.h>
-#define Kf(x) _mm_set_pd((x),(x))
-#endif
+#include "quickstep_kernels.h"
 
 
 #undef REPORT_THREAD_TIMING
@@ -215,45 +212,6 @@ inline void scaled_add (int n, dRealMutablePtr x, dRealPtr y, dRealPtr z, dReal
   for (int i=0; i<n; i++) x[i] = y[i] + z[i]*alpha;
 }
 
-// dot product of two vector a and b with length 6
-// define ODE_SSE to enable SSE, which is used to speed up
-// vector math operations with gcc compiler
-// macro SSE is renamed to ODE_SSE due to conflict with Eigen3 in DART
-inline dReal dot6(dRealPtr a, dRealPtr b)
-{
-#ifdef ODE_SSE
-  __m128d d = _mm_load_pd(a+0) * _mm_load_pd(b+0) + _mm_load_pd(a+2) * _mm_load_pd(b+2) + _mm_load_pd(a+4) * _mm_load_pd(b+4);
-  double r[2];
-  _mm_store_pd(r, d);
-  return r[0] + r[1];
-#else
-  return a[0] * b[0] +
-         a[1] * b[1] +
-         a[2] * b[2] +
-         a[3] * b[3] +
-         a[4] * b[4] +
-         a[5] * b[5];
-#endif
-}
-
-// a = a + delta * b, vector a and b with length 6
-inline void sum6(dRealMutablePtr a, dReal delta, dRealPtr b)
-{
-#ifdef ODE_SSE
-  __m128d __delta = Kf(delta);
-  _mm_store_pd(a + 0, _mm_load_pd(a + 0) + __delta * _mm_load_pd(b + 0));
-  _mm_store_pd(a + 2, _mm_load_pd(a + 2) + __delta * _mm_load_pd(b + 2));
-  _mm_store_pd(a + 4, _mm_load_pd(a + 4) + __delta * _mm_load_pd(b + 4));
-#else
-  a[0] += delta * b[0];
-  a[1] += delta * b[1];
-  a[2] += delta * b[2];
-  a[3] += delta * b[3];
-  a[4] += delta * b[4];
-  a[5] += delta * b[5];
-#endif
-}
-
 // compare the index error when REORDER_CONSTRAINTS is defined
 int compare_index_error (const void *a, const void *b);
 
@@ -27,6 +27,7 @@
 #include "util.h"
 #include <boost/thread/recursive_mutex.hpp>
 #include <boost/bind/bind.hpp>
+#include <algorithm>
 #include <gazebo/ode/timer.h>
 
 #undef REPORT_THREAD_TIMING
@@ -582,10 +583,16 @@ void dxProcessOneIsland(dxWorldProcessContext *island_context, dxWorld *world, d
     printf("island thread started time %f\n",cur_time);
 #endif
 
+    if (world->island_begin_fn)
+      world->island_begin_fn(world->island_fn_data, bcount, jcount);
+
     BEGIN_STATE_SAVE(island_context, island_stepperstate) {
       stepper (island_context,world,bodystart,bcount,jointstart,jcount,stepsize);
     } END_STATE_SAVE(island_context, island_stepperstate);
 
+    if (world->island_end_fn)
+      world->island_end_fn(world->island_fn_data, bcount, jcount);
+
 #ifdef REPORT_THREAD_TIMING
     gettimeofday(&tv,NULL);
     double end_time = (double)tv.tv_sec + (double)tv.tv_usec / 1.e6;
@@ -613,7 +620,6 @@ void dxProcessIslands (dxWorld *world, dReal stepsize, dstepper_fn_t stepper)
   dxJoint *const *jointstart = joint;
 
   IFTIMING(dTimerStart("preprocessing islands"));
-  int island_index = 0;
   int const *const sizesend = islandsizes + islandcount * sizeelements;
 
 #ifdef REPORT_THREAD_TIMING
@@ -624,33 +630,62 @@ void dxProcessIslands (dxWorld *world, dReal stepsize, dstepper_fn_t stepper)
   printf(">>>>>>>>>>>> start island spawn threads at time %f\n",cur_time);
 #endif
 
-  for (int const *sizescurr = islandsizes; sizescurr != sizesend; sizescurr += sizeelements) {
-    int bcount = sizescurr[0];
-    int jcount = sizescurr[1];
+  // find where each island starts, so that they can be scheduled in any
+  // order
+  std::vector<dxIslandRange> &ranges = world->island_ranges;
+  ranges.resize(islandcount);
+  {
+    int island_index = 0;
+    for (int const *sizescurr = islandsizes; sizescurr != sizesend; sizescurr += sizeelements) {
+      dxIslandRange &range = ranges[island_index];
+      range.index = island_index;
+      range.req = islandreqs[island_index];
+      range.bodystart = bodystart;
+      range.bcount = sizescurr[0];
+      range.jointstart = jointstart;
+      range.jcount = sizescurr[1];
+      bodystart += range.bcount;
+      jointstart += range.jcount;
+      ++island_index;
+    }
+  }
+
+#define USE_TPISLAND
+#ifdef USE_TPISLAND
+  const bool use_threadpool = world->threadpool && world->threadpool->size() > 0;
+
+  // the pool hands tasks out in order, so scheduling the most expensive
+  // islands first keeps one big island from starting last and leaving the
+  // other threads idle while it finishes. the stepper memory estimate grows
+  // with the number of constraint rows and bodies, which is what the cost
+  // of an island depends on.
+  if (use_threadpool && islandcount > 1) {
+    std::stable_sort(ranges.begin(), ranges.end(),
+      [](const dxIslandRange &a, const dxIslandRange &b) {
+        return a.req > b.req;
+      });
+  }
+#endif
 
+  for (const dxIslandRange &range : ranges) {
     // get working memory for each island
-    dxStepWorkingMemory *island_wmem = world->island_wmems[island_index++];
+    dxStepWorkingMemory *island_wmem = world->island_wmems[range.index];
     dIASSERT(island_wmem != NULL);
     dxWorldProcessContext *island_context = island_wmem->GetWorldProcessingContext();
 
-#define USE_TPISLAND
 #ifdef USE_TPISLAND
     IFTIMING(dTimerNow("scheduling island"));
-    //printf("debug opende tp %d\n",world->threadpool->size());
-    if (world->threadpool && world->threadpool->size() > 0)
-      world->threadpool->schedule(boost::bind(dxProcessOneIsland,island_context, world, stepsize, stepper,bodystart, bcount, jointstart, jcount));
+    if (use_threadpool)
+      world->threadpool->schedule(boost::bind(dxProcessOneIsland,island_context, world, stepsize, stepper,range.bodystart, range.bcount, range.jointstart, range.jcount));
     else //automatically skip threadpool if only 1 thread allocated
-      dxProcessOneIsland(island_context, world, stepsize, stepper,bodystart, bcount, jointstart, jcount);
+      dxProcessOneIsland(island_context, world, stepsize, stepper,range.bodystart, range.bcount, range.jointstart, range.jcount);
 #else
-    dxProcessOneIsland(island_context, world, stepsize, stepper,bodystart, bcount, jointstart, jcount);
+    dxProcessOneIsland(island_context, world, stepsize, stepper,range.bodystart, range.bcount, range.jointstart, range.jcount);
 #endif
-
-    bodystart += bcount;
-    jointstart += jcount;
   }
 #ifdef USE_TPISLAND
   IFTIMING(dTimerNow("islands wait"));
-  if (world->threadpool && world->threadpool->size() > 0)
+  if (use_threadpool)
     world->threadpool->wait();
 #endif
   IFTIMING(dTimerEnd());
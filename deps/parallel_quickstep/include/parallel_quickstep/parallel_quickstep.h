@@ -1,7 +1,7 @@
 #ifndef PARALLEL_ODE_H
 #define PARALLEL_ODE_H
 
-#include <ode/objects.h>
+#include <gazebo/ode/objects.h>
 
 #ifdef __cplusplus
 extern "C" {
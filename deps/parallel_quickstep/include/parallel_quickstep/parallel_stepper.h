@@ -1,7 +1,7 @@
 #ifndef _PARALLEL_STEPPER_H_
 #define _PARALLEL_STEPPER_H_
 
-#include <ode/ode.h>
+#include <gazebo/ode/ode.h>
 
 #include "util.h"
 
@@ -1,9 +1,9 @@
-#include <parallel_batch.h>
-#include <parallel_utils.h>
-
 #include <map>
 #include <boost/unordered_map.hpp>
 
+#include <parallel_batch.h>
+#include <parallel_utils.h>
+
 namespace parallel_ode
 {
 
@@ -1,11 +1,11 @@
-#include <ode/objects.h>
-#include <ode/ode.h>
-#include <ode/odemath.h>
-#include <ode/rotation.h>
-#include <ode/timer.h>
-#include <ode/error.h>
-#include <ode/matrix.h>
-#include <ode/misc.h>
+#include <gazebo/ode/objects.h>
+#include <gazebo/ode/ode.h>
+#include <gazebo/ode/odemath.h>
+#include <gazebo/ode/rotation.h>
+#include <gazebo/ode/timer.h>
+#include <gazebo/ode/error.h>
+#include <gazebo/ode/matrix.h>
+#include <gazebo/ode/misc.h>
 #include "objects.h"
 #include "config.h"
 #include "joints/joint.h"
@@ -35,6 +35,12 @@ typedef parallel_ode::OpenMPPGSSolver<dReal> SolverType;
 static SolverType parallelSolver;
 #endif
 
+// The islands are built by the regular ODE code, which leaves the enabled
+// bodies and joints of all the islands next to each other. They are then
+// stepped together, so that a parallel solver sees every constraint at once,
+// in a context of their own sized for all of them.
+static dxWorldProcessContext *parallel_context = NULL;
+
 typedef const dReal *dRealPtr;
 typedef dReal *dRealMutablePtr;
 
@@ -361,10 +367,12 @@ void dxParallelProcessIslands (dxWorld *world, dReal stepsize, dstepper_fn_t ste
     jcount += sizescurr[1];
   }
 
-  BEGIN_STATE_SAVE(context, stepperstate) {
-    stepper (context,world,bodystart,bcount,jointstart,jcount,stepsize);
-  } END_STATE_SAVE(context, stepperstate);
+  dIASSERT(parallel_context != NULL);
+  BEGIN_STATE_SAVE(parallel_context, stepperstate) {
+    stepper (parallel_context,world,bodystart,bcount,jointstart,jcount,stepsize);
+  } END_STATE_SAVE(parallel_context, stepperstate);
 
+  parallel_context->CleanupContext();
   context->CleanupContext();
   dIASSERT(context->IsStructureValid());
 }
@@ -576,7 +584,7 @@ void dxParallelQuickStepper( dxWorldProcessContext *context,
   int *jb = NULL;
 
   if (m > 0) {
-    dReal *cfm, *lo, *hi, *rhs, *Jcopy;
+    dReal *cfm, *lo, *hi, *rhs, *Jcopy, *c_v_max;
     int *findex;
 
     {
@@ -601,6 +609,9 @@ void dxParallelQuickStepper( dxWorldProcessContext *context,
       findex = context->AllocateArray<int> (mlocal);
       for (int i=0; i<mlocal; i++) findex[i] = -1;
 
+      c_v_max = context->AllocateArray<dReal> (mlocal);
+      for (int i=0; i<mlocal; i++) c_v_max[i] = world->contactp.max_vel;
+
       const unsigned jbelements = mlocal*2;
       jb = context->AllocateArray<int> (jbelements);
 
@@ -649,7 +660,7 @@ void dxParallelQuickStepper( dxWorldProcessContext *context,
           Jinfo.lo = lo + ofsi;
           Jinfo.hi = hi + ofsi;
           Jinfo.findex = findex + ofsi;
-
+          Jinfo.c_v_max = c_v_max + ofsi;
 
           // now write all information into J
           dxJoint *joint = jicurr->joint;
@@ -918,7 +929,7 @@ size_t dxEstimateParallelStepMemoryRequirements (
     size_t sub1_res2 = dEFFICIENT_SIZE(sizeof(dJointWithInfo1) * nj); // for shrunk jointiinfos
     if (m > 0) {
       sub1_res2 += dEFFICIENT_SIZE(sizeof(dReal) * 12 * m); // for J
-      sub1_res2 += 4 * dEFFICIENT_SIZE(sizeof(dReal) * m); // for cfm, lo, hi, rhs
+      sub1_res2 += 5 * dEFFICIENT_SIZE(sizeof(dReal) * m); // for cfm, lo, hi, rhs, c_v_max
       sub1_res2 += dEFFICIENT_SIZE(sizeof(int) * 12 * m); // for jb            FIXME: shoulbe be 2 not 12?
       sub1_res2 += dEFFICIENT_SIZE(sizeof(int) * m); // for findex
       sub1_res2 += dEFFICIENT_SIZE(sizeof(dReal) * 12 * mfb); // for Jcopy
@@ -935,6 +946,8 @@ size_t dxEstimateParallelStepMemoryRequirements (
 
         size_t sub2_res2 = dEFFICIENT_SIZE(sizeof(dReal) * m); // for lambda
         sub2_res2 += dEFFICIENT_SIZE(sizeof(dReal) * 6 * nb); // for cforce
+        sub2_res2 += dEFFICIENT_SIZE(sizeof(dReal) * 12 * m); // for iMJ
+        sub2_res2 += dEFFICIENT_SIZE(sizeof(dReal) * m); // for Ad
         {
           size_t sub3_res1 = EstimateParallelSOR_LCPMemoryRequirements(m,nj); // for SOR_LCP
           size_t sub3_res2 = 0;
@@ -950,327 +963,28 @@ size_t dxEstimateParallelStepMemoryRequirements (
 
   return res;
 }
-
-static size_t BuildIslandAndEstimateStepperMemoryRequirements(dxWorldProcessContext *context,
-  dxWorld *world, dReal stepsize, dmemestimate_fn_t stepperestimate)
-{
-  const int sizeelements = 2;
-  size_t maxreq = 0;
-
-  // handle auto-disabling of bodies
-  dInternalHandleAutoDisabling (world,stepsize);
-
-  int nb = world->nb, nj = world->nj;
-  // Make array for island body/joint counts
-  int *islandsizes = context->AllocateArray<int>(sizeelements);
-
-  // make arrays for body and joint lists (for a single island) to go into
-  dxBody **body = context->AllocateArray<dxBody *>(nb);
-  dxJoint **joint = context->AllocateArray<dxJoint *>(nj);
-
-  BEGIN_STATE_SAVE(context, stackstate) {
-    // allocate a stack of unvisited bodies in the island. the maximum size of
-    // the stack can be the lesser of the number of bodies or joints, because
-    // new bodies are only ever added to the stack by going through untagged
-    // joints. all the bodies in the stack must be tagged!
-
-    int stackalloc = (nj < nb) ? nj : nb;
-    dxBody **stack = context->AllocateArray<dxBody *>(stackalloc);
-
-    {
-      // set all body/joint tags to 0
-      for (dxBody *b=world->firstbody; b; b=(dxBody*)b->next) b->tag = 0;
-      for (dxJoint *j=world->firstjoint; j; j=(dxJoint*)j->next) j->tag = 0;
-    }
-
-    int bcount = 0, jcount =0;
-
-    dxBody **bodystart = body;
-    dxJoint **jointstart = joint;
-    for (dxBody *bb=world->firstbody; bb; bb=(dxBody*)bb->next) {
-      // get bb = the next enabled, untagged body, and tag it
-      if (!bb->tag) {
-        if (!(bb->flags & dxBodyDisabled)) {
-          bb->tag = 1;
-
-          dxBody **bodycurr = bodystart;
-          dxJoint **jointcurr = jointstart;
-
-          // tag all bodies and joints starting from bb.
-          *bodycurr++ = bb;
-
-          int stacksize = 0;
-          dxBody *b = bb;
-
-          while (true) {
-            // traverse and tag all body's joints, add untagged connected bodies
-            // to stack
-            for (dxJointNode *n=b->firstjoint; n; n=n->next) {
-              dxJoint *njoint = n->joint;
-              if (!njoint->tag) {
-                if (njoint->isEnabled()) {
-                  njoint->tag = 1;
-                  *jointcurr++ = njoint;
-
-                  dxBody *nbody = n->body;
-                  // Body disabled flag is not checked here. This is how auto-enable works.
-                  if (nbody && nbody->tag <= 0) {
-                    nbody->tag = 1;
-                    // Make sure all bodies are in the enabled state.
-                    nbody->flags &= ~dxBodyDisabled;
-                    stack[stacksize++] = nbody;
-                  }
-                } else {
-                  njoint->tag = -1; // Used in Step to prevent search over disabled joints (not needed for QuickStep so far)
-                }
-              }
-            }
-            dIASSERT(stacksize <= world->nb);
-            dIASSERT(stacksize <= world->nj);
-
-            if (stacksize == 0) {
-              break;
-            }
-
-            b = stack[--stacksize];	// pop body off stack
-            *bodycurr++ = b;	// put body on body list
-          }
-
-          bcount += (bodycurr - bodystart);
-          jcount += (jointcurr - jointstart);
-
-          bodystart = bodycurr;
-          jointstart = jointcurr;
-        } else {
-          bb->tag = -1; // Not used so far (assigned to retain consistency with joints)
-        }
-      }
-    }
-
-    islandsizes[0] = bcount;
-    islandsizes[1] = jcount;
-
-    size_t islandreq = stepperestimate(body, bcount, joint, jcount);
-    maxreq = islandreq;
-
-  } END_STATE_SAVE(context, stackstate);
-
-# ifndef dNODEBUG
-  // if debugging, check that all objects (except for disabled bodies,
-  // unconnected joints, and joints that are connected to disabled bodies)
-  // were tagged.
-  {
-    for (dxBody *b=world->firstbody; b; b=(dxBody*)b->next) {
-      if (b->flags & dxBodyDisabled) {
-        if (b->tag > 0) dDebug (0,"disabled body tagged");
-      }
-      else {
-        if (b->tag <= 0) dDebug (0,"enabled body not tagged");
-      }
-    }
-    for (dxJoint *j=world->firstjoint; j; j=(dxJoint*)j->next) {
-      if ( (( j->node[0].body && (j->node[0].body->flags & dxBodyDisabled)==0 ) ||
-        (j->node[1].body && (j->node[1].body->flags & dxBodyDisabled)==0) )
-        &&
-        j->isEnabled() ) {
-          if (j->tag <= 0) dDebug (0,"attached enabled joint not tagged");
-      }
-      else {
-        if (j->tag > 0) dDebug (0,"unattached or disabled joint tagged");
-      }
-    }
-  }
-# endif
-
-  size_t const *islandreqs = NULL;
-  int islandcount = 1;
-  context->SavePreallocations(islandcount, islandsizes, body, joint, islandreqs);
-
-  return maxreq;
-}
-
-static size_t EstimateIslandsProcessingMemoryRequirements(dxWorld *world, size_t &sesize)
-{
-  size_t res = 0;
-
-  size_t islandcounts = dEFFICIENT_SIZE(world->nb * 2 * sizeof(int));
-  res += islandcounts;
-
-  size_t bodiessize = dEFFICIENT_SIZE(world->nb * sizeof(dxBody*));
-  size_t jointssize = dEFFICIENT_SIZE(world->nj * sizeof(dxJoint*));
-  res += bodiessize + jointssize;
-
-  sesize = (bodiessize < jointssize) ? bodiessize : jointssize;
-  return res;
-}
-
-static size_t AdjustArenaSizeForReserveRequirements(size_t arenareq, float rsrvfactor, unsigned rsrvminimum)
-{
-  float scaledarena = arenareq * rsrvfactor;
-  size_t adjustedarena = (scaledarena < SIZE_MAX) ? (size_t)scaledarena : SIZE_MAX;
-  size_t boundedarena = (adjustedarena > rsrvminimum) ? adjustedarena : (size_t)rsrvminimum;
-  return dEFFICIENT_SIZE(boundedarena);
-}
-
-static dxWorldProcessContext *InternalReallocateWorldProcessContext (
-  dxWorldProcessContext *oldcontext, size_t memreq,
-  const dxWorldProcessMemoryManager *memmgr, float rsrvfactor, unsigned rsrvminimum)
-{
-  dxWorldProcessContext *context = oldcontext;
-  bool allocsuccess = false;
-
-  size_t oldarenasize;
-  void *pOldArena;
-
-  do {
-    size_t oldmemsize = oldcontext ? oldcontext->GetMemorySize() : 0;
-    if (!oldcontext || oldmemsize < memreq) {
-      oldarenasize = oldcontext ? dxWorldProcessContext::MakeArenaSize(oldmemsize) : 0;
-      pOldArena = oldcontext ? oldcontext->m_pArenaBegin : NULL;
-
-      if (!dxWorldProcessContext::IsArenaPossible(memreq)) {
-        break;
-      }
-
-      size_t arenareq = dxWorldProcessContext::MakeArenaSize(memreq);
-      size_t arenareq_with_reserve = AdjustArenaSizeForReserveRequirements(arenareq, rsrvfactor, rsrvminimum);
-      size_t memreq_with_reserve = memreq + (arenareq_with_reserve - arenareq);
-
-      if (oldcontext) {
-
-        if (oldcontext->m_pAllocCurrent != oldcontext->m_pAllocBegin) {
-
-          // Save old efficient offset and meaningful data size for the case if
-          // reallocation throws the block at different efficient offset
-          size_t oldcontextofs = (size_t)oldcontext - (size_t)pOldArena;
-          size_t datasize = (size_t)oldcontext->m_pAllocCurrent - (size_t)oldcontext;
-
-          // Extra EFFICIENT_ALIGNMENT bytes might be needed after re-allocation with different alignment
-          size_t shrunkarenasize = dEFFICIENT_SIZE(datasize + oldcontextofs) + EFFICIENT_ALIGNMENT;
-          if (shrunkarenasize < oldarenasize) {
-
-            void *pShrunkOldArena = oldcontext->m_pArenaMemMgr->m_fnShrink(pOldArena, oldarenasize, shrunkarenasize);
-            if (!pShrunkOldArena) {
-              break;
-            }
-
-            // In case if shrinking is not supported and memory manager had to allocate-copy-free
-            if (pShrunkOldArena != pOldArena) {
-              dxWorldProcessContext *shrunkcontext = (dxWorldProcessContext *)dEFFICIENT_PTR(pShrunkOldArena);
-
-              // Preform data shift in case if efficient alignment of new block
-              // does not match that of old block
-              size_t shrunkcontextofs = (size_t)shrunkcontext - (size_t)pShrunkOldArena;
-              size_t offsetdiff = oldcontextofs - shrunkcontextofs;
-              if (offsetdiff != 0) {
-                memmove(shrunkcontext, (void *)((size_t)shrunkcontext + offsetdiff), datasize);
-              }
-
-              // Make sure allocation pointers are valid - that is necessary to
-              // be able to calculate size and free old arena later
-              size_t shrunkdatasize = dxWorldProcessContext::MakeBufferSize(shrunkarenasize);
-              void *blockbegin = dEFFICIENT_PTR(shrunkcontext + 1);
-              void *blockend = dOFFSET_EFFICIENTLY(blockbegin, shrunkdatasize);
-              shrunkcontext->m_pAllocBegin = blockbegin;
-              shrunkcontext->m_pAllocEnd = blockend;
-              shrunkcontext->m_pAllocCurrent = blockend; // -- set to end to prevent possibility of further allocation
-              shrunkcontext->m_pArenaBegin = pShrunkOldArena;
-
-              size_t stOffset = ((size_t)pShrunkOldArena - (size_t)pOldArena) - offsetdiff;
-              shrunkcontext->OffsetPreallocations(stOffset);
-
-              oldcontext = shrunkcontext;
-
-              // Reassign to old arena variables for potential freeing at exit
-              pOldArena = pShrunkOldArena;
-            }
-
-            // Reassign to old arena variables for potential freeing at exit
-            oldarenasize = shrunkarenasize;
-          }
-
-        } else {
-          oldcontext->m_pArenaMemMgr->m_fnFree(pOldArena, oldarenasize);
-          oldcontext = NULL;
-
-          // Zero variables to avoid another freeing on exit
-          pOldArena = NULL;
-          oldarenasize = 0;
-        }
-      }
-
-      // Allocate new arena
-      void *pNewArena = memmgr->m_fnAlloc(arenareq_with_reserve);
-      if (!pNewArena) {
-        break;
-      }
-
-      context = (dxWorldProcessContext *)dEFFICIENT_PTR(pNewArena);
-
-      void *blockbegin = dEFFICIENT_PTR(context + 1);
-      void *blockend = dOFFSET_EFFICIENTLY(blockbegin, memreq_with_reserve);
-
-      context->m_pAllocBegin = blockbegin;
-      context->m_pAllocEnd = blockend;
-      context->m_pArenaBegin = pNewArena;
-      context->m_pAllocCurrent = blockbegin;
-
-      if (oldcontext) {
-        context->CopyPreallocations(oldcontext);
-      } else {
-        context->ClearPreallocations();
-      }
-
-      context->m_pArenaMemMgr = memmgr;
-      context->m_pPreallocationcContext = oldcontext;
-    }
-
-    allocsuccess = true;
-  } while (false);
-
-  if (!allocsuccess) {
-    if (pOldArena) {
-      dIASSERT(oldcontext);
-      oldcontext->m_pArenaMemMgr->m_fnFree(pOldArena, oldarenasize);
-    }
-    context = NULL;
-  }
-
-  return context;
-}
-
 bool dxReallocateParallelWorldProcessContext (dxWorld *world, dReal stepsize, dmemestimate_fn_t stepperestimate)
 {
-  dxStepWorkingMemory *wmem = AllocateOnDemand(world->wmem);
-  if (!wmem) return false;
-
-  dxWorldProcessContext *oldcontext = wmem->GetWorldProcessingContext();
-  dIASSERT (!oldcontext || oldcontext->IsStructureValid());
-
-  const dxWorldProcessMemoryReserveInfo *reserveinfo = wmem->SureGetMemoryReserveInfo();
-  const dxWorldProcessMemoryManager *memmgr = wmem->SureGetMemoryManager();
-
-  dxWorldProcessContext *context = oldcontext;
+  if (!dxReallocateWorldProcessContext (world, stepsize, stepperestimate))
+    return false;
 
-  size_t sesize;
-  size_t islandsreq = EstimateIslandsProcessingMemoryRequirements(world, sesize);
-  dIASSERT(islandsreq == dEFFICIENT_SIZE(islandsreq));
-  dIASSERT(sesize == dEFFICIENT_SIZE(sesize));
+  dxWorldProcessContext *context = world->wmem->GetWorldProcessingContext();
 
-  size_t stepperestimatereq = islandsreq + sesize;
-  context = InternalReallocateWorldProcessContext(context, stepperestimatereq, memmgr, 1.0f, reserveinfo->m_uiReserveMinimum);
-
-  if (context)
-  {
-    size_t stepperreq = BuildIslandAndEstimateStepperMemoryRequirements(context, world, stepsize, stepperestimate);
-    dIASSERT(stepperreq == dEFFICIENT_SIZE(stepperreq));
+  size_t const *islandreqs;
+  int islandcount;
+  int const *islandsizes;
+  dxBody *const *body;
+  dxJoint *const *joint;
+  context->RetrievePreallocations(islandcount, islandsizes, body, joint, islandreqs);
 
-    size_t memreq = stepperreq + islandsreq;
-    context = InternalReallocateWorldProcessContext(context, memreq, memmgr, reserveinfo->m_fReserveFactor, reserveinfo->m_uiReserveMinimum);
+  int bcount = 0;
+  int jcount = 0;
+  for (int i = 0; i < islandcount; i++) {
+    bcount += islandsizes[2*i];
+    jcount += islandsizes[2*i+1];
   }
 
-  wmem->SetWorldProcessingContext(context);
-  return context != NULL;
+  size_t memreq = stepperestimate (body, bcount, joint, jcount);
+  parallel_context = dxReallocateTemporayWorldProcessContext (parallel_context, memreq, NULL, NULL);
+  return parallel_context != NULL;
 }
-
-
@@ -18,11 +18,15 @@
 #include <functional>
 #include <thread>
 #include <mutex>
+#include <random>
+#include <sstream>
+#include <tuple>
 
 #include <boost/bind/bind.hpp>
 #include <boost/make_shared.hpp>
 #include <google/protobuf/descriptor.h>
 #include <set>
+#include "gazebo/common/SamplingProfiler.hh"
 #include "gazebo/transport/IOManager.hh"
 
 #include "Master.hh"
@@ -31,6 +35,10 @@
 
 using namespace gazebo;
 
+/// \brief Number of publisher changes the master remembers. Clients whose
+/// cached topic table is older than that get the full table instead.
+static const size_t kTopicTableChangeLogSize = 4096;
+
 namespace gazebo
 {
   struct MasterPrivate
@@ -64,6 +72,22 @@ namespace gazebo
 
     /// \brief Mutex to protect msg bufferes.
     std::recursive_mutex msgsMutex;
+
+    /// \brief Identifies this run of the master, so that clients can tell
+    /// whether their cached topic table versions still apply.
+    std::string epoch;
+
+    /// \brief Version of the topic table, bumped every time a publisher
+    /// is added or removed.
+    uint64_t tableVersion;
+
+    /// \brief Recent publisher changes, oldest first. The flag is true
+    /// for additions. Each publisher carries the version of its change.
+    std::deque<std::pair<bool, msgs::Publish> > changeLog;
+
+    /// \brief Connections that have not synchronized their topic table
+    /// yet. They don't receive table updates until they do.
+    std::set<unsigned int> unsynced;
   };
 }
 
@@ -74,6 +98,13 @@ Master::Master()
   this->dataPtr->stop = false;
   this->dataPtr->runThread = NULL;
   this->dataPtr->connection = boost::make_shared<transport::Connection>();
+  this->dataPtr->tableVersion = 0;
+
+  std::random_device rd;
+  std::ostringstream epoch;
+  epoch << std::hex << rd() << rd() << "-"
+        << common::Time::GetWallTime().sec;
+  this->dataPtr->epoch = epoch.str();
 }
 
 /////////////////////////////////////////////////
@@ -106,28 +137,8 @@ void Master::OnAccept(transport::ConnectionPtr _newConnection)
   versionMsg.set_data(std::string("gazebo ") + GAZEBO_VERSION);
   _newConnection->EnqueueMsg(msgs::Package("version_init", versionMsg), true);
 
-  // Send all the current topic namespaces
-  msgs::GzString_V namespacesMsg;
-  std::list<std::string>::iterator iter;
-  for (iter = this->dataPtr->worldNames.begin();
-       iter != this->dataPtr->worldNames.end(); ++iter)
-  {
-    namespacesMsg.add_data(*iter);
-  }
-  _newConnection->EnqueueMsg(msgs::Package("topic_namepaces_init",
-                              namespacesMsg), true);
-
-  // Send all the publishers
-  msgs::Publishers publishersMsg;
-  PubList::iterator pubiter;
-  for (pubiter = this->dataPtr->publishers.begin();
-       pubiter != this->dataPtr->publishers.end(); ++pubiter)
-  {
-    msgs::Publish *pub = publishersMsg.add_publisher();
-    pub->CopyFrom(pubiter->first);
-  }
-  _newConnection->EnqueueMsg(
-      msgs::Package("publishers_init", publishersMsg), true);
+  // The topic table is sent when the client asks for it with a
+  // topic_table_sync message. Clients that only issue requests never do.
 
   // Add the connection to our list
   {
@@ -135,6 +146,7 @@ void Master::OnAccept(transport::ConnectionPtr _newConnection)
     int index = this->dataPtr->connections.size();
 
     this->dataPtr->connections[index] = _newConnection;
+    this->dataPtr->unsynced.insert(index);
 
     // Start reading from the connection
     using namespace boost::placeholders;
@@ -191,6 +203,78 @@ void Master::SendSubscribers(const std::string &_topic,
     conn->EnqueueMsg(_buffer);
 }
 
+//////////////////////////////////////////////////
+void Master::SendTableUpdate(const std::string &_buffer)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->connectionMutex);
+  for (auto const &conn : this->dataPtr->connections)
+  {
+    if (this->dataPtr->unsynced.find(conn.first) ==
+        this->dataPtr->unsynced.end())
+    {
+      conn.second->EnqueueMsg(_buffer);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void Master::RecordChange(bool _added, msgs::Publish &_pub)
+{
+  _pub.set_version(++this->dataPtr->tableVersion);
+
+  this->dataPtr->changeLog.push_back(std::make_pair(_added, _pub));
+  while (this->dataPtr->changeLog.size() > kTopicTableChangeLogSize)
+    this->dataPtr->changeLog.pop_front();
+}
+
+//////////////////////////////////////////////////
+void Master::FillTopicTable(const msgs::TopicTable &_request,
+                            msgs::TopicTable &_table) const
+{
+  _table.set_epoch(this->dataPtr->epoch);
+  _table.set_version(this->dataPtr->tableVersion);
+
+  for (auto const &name : this->dataPtr->worldNames)
+    _table.add_topic_namespace(name);
+
+  // The change log covers every version after the one preceding its first
+  // entry.
+  uint64_t oldest = this->dataPtr->changeLog.empty() ?
+      this->dataPtr->tableVersion :
+      this->dataPtr->changeLog.front().second.version() - 1;
+
+  if (_request.epoch() != this->dataPtr->epoch ||
+      _request.version() < oldest ||
+      _request.version() > this->dataPtr->tableVersion)
+  {
+    _table.set_full(true);
+    for (auto const &pub : this->dataPtr->publishers)
+      _table.add_publisher()->CopyFrom(pub.first);
+    return;
+  }
+
+  // Walk the log backwards so that only the latest change to each
+  // publisher is reported.
+  typedef std::tuple<std::string, std::string, uint32_t> Key;
+  std::map<Key, const std::pair<bool, msgs::Publish> *> changes;
+  for (auto iter = this->dataPtr->changeLog.rbegin();
+       iter != this->dataPtr->changeLog.rend() &&
+       iter->second.version() > _request.version(); ++iter)
+  {
+    changes.insert(std::make_pair(Key(iter->second.topic(),
+        iter->second.host(), iter->second.port()), &(*iter)));
+  }
+
+  _table.set_full(false);
+  for (auto const &change : changes)
+  {
+    if (change.second->first)
+      _table.add_publisher()->CopyFrom(change.second->second);
+    else
+      _table.add_removed()->CopyFrom(change.second->second);
+  }
+}
+
 //////////////////////////////////////////////////
 void Master::ProcessMessage(const unsigned int _connectionIndex,
                             const std::string &_data)
@@ -214,31 +298,31 @@ void Master::ProcessMessage(const unsigned int _connectionIndex,
                      worldNameMsg.data());
     if (iter == this->dataPtr->worldNames.end())
     {
-      std::lock_guard<std::recursive_mutex>
-          lock(this->dataPtr->connectionMutex);
       this->dataPtr->worldNames.push_back(worldNameMsg.data());
-
-      Connection_M::iterator iter2;
-      for (iter2 = this->dataPtr->connections.begin();
-          iter2 != this->dataPtr->connections.end(); ++iter2)
-      {
-        iter2->second->EnqueueMsg(
-            msgs::Package("topic_namespace_add", worldNameMsg));
-      }
+      this->SendTableUpdate(msgs::Package("topic_namespace_add",
+            worldNameMsg));
     }
   }
-  else if (packet.type() == "advertise")
+  else if (packet.type() == "topic_table_sync")
   {
+    msgs::TopicTable request;
+    request.ParseFromString(packet.serialized_data());
+
+    msgs::TopicTable table;
+    this->FillTopicTable(request, table);
+    conn->EnqueueMsg(msgs::Package("topic_table", table), true);
+
+    // From now on the connection is kept up to date incrementally.
     std::lock_guard<std::recursive_mutex> lock(this->dataPtr->connectionMutex);
+    this->dataPtr->unsynced.erase(_connectionIndex);
+  }
+  else if (packet.type() == "advertise")
+  {
     msgs::Publish pub;
     pub.ParseFromString(packet.serialized_data());
 
-    Connection_M::iterator iter2;
-    for (iter2 = this->dataPtr->connections.begin();
-         iter2 != this->dataPtr->connections.end(); ++iter2)
-    {
-      iter2->second->EnqueueMsg(msgs::Package("publisher_add", pub));
-    }
+    this->RecordChange(true, pub);
+    this->SendTableUpdate(msgs::Package("publisher_add", pub));
 
     this->dataPtr->publishers.push_back(std::make_pair(pub, conn));
 
@@ -266,11 +350,14 @@ void Master::ProcessMessage(const unsigned int _connectionIndex,
 
     PubList::iterator iter;
 
-    // Find all publishers of the topic
+    // Find all publishers of the topic that the subscriber doesn't know
+    // about yet
     for (iter = this->dataPtr->publishers.begin();
         iter != this->dataPtr->publishers.end(); ++iter)
     {
-      if (iter->first.topic() == sub.topic())
+      if (iter->first.topic() == sub.topic() &&
+          (!sub.has_table_version() ||
+           iter->first.version() > sub.table_version()))
       {
         conn->EnqueueMsg(msgs::Package("publisher_subscribe", iter->first));
       }
@@ -384,6 +471,7 @@ void Master::ProcessMessage(const unsigned int _connectionIndex,
 //////////////////////////////////////////////////
 void Master::Run()
 {
+  common::SetThreadName("Master");
   while (!this->dataPtr->stop)
   {
     this->RunOnce();
@@ -493,24 +581,18 @@ void Master::RemoveConnection(Connection_M::iterator _connIter)
     }
   }
 
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->connectionMutex);
+    this->dataPtr->unsynced.erase(_connIter->first);
+  }
+
   this->dataPtr->connections.erase(_connIter);
 }
 
 /////////////////////////////////////////////////
 void Master::RemovePublisher(const msgs::Publish _pub)
 {
-  {
-    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->connectionMutex);
-    Connection_M::iterator iter2;
-    for (iter2 = this->dataPtr->connections.begin();
-        iter2 != this->dataPtr->connections.end(); ++iter2)
-    {
-      iter2->second->EnqueueMsg(msgs::Package("publisher_del", _pub));
-    }
-  }
-
-  this->SendSubscribers(_pub.topic(), msgs::Package("unadvertise", _pub));
-
+  bool removed = false;
   PubList::iterator pubIter = this->dataPtr->publishers.begin();
   while (pubIter != this->dataPtr->publishers.end())
   {
@@ -519,10 +601,18 @@ void Master::RemovePublisher(const msgs::Publish _pub)
         pubIter->first.port() == _pub.port())
     {
       pubIter = this->dataPtr->publishers.erase(pubIter);
+      removed = true;
     }
     else
       ++pubIter;
   }
+
+  msgs::Publish delMsg = _pub;
+  if (removed)
+    this->RecordChange(false, delMsg);
+  this->SendTableUpdate(msgs::Package("publisher_del", delMsg));
+
+  this->SendSubscribers(_pub.topic(), msgs::Package("unadvertise", _pub));
 }
 
 /////////////////////////////////////////////////
@@ -583,6 +673,8 @@ void Master::Fini()
   this->dataPtr->connections.clear();
   this->dataPtr->subscribers.clear();
   this->dataPtr->publishers.clear();
+  this->dataPtr->changeLog.clear();
+  this->dataPtr->unsynced.clear();
 }
 
 //////////////////////////////////////////////////
@@ -83,6 +83,26 @@ namespace gazebo
     private: void SendSubscribers(const std::string &_topic,
                                   const std::string &_buffer);
 
+    /// \brief Send a topic table update to every connection that has
+    /// synchronized its topic table.
+    /// \param[in] _buffer Data to write
+    private: void SendTableUpdate(const std::string &_buffer);
+
+    /// \brief Bump the topic table version and remember the change.
+    /// \param[in] _added True if the publisher was added, false if it was
+    /// removed.
+    /// \param[in,out] _pub The publisher. Its version is set to the new
+    /// table version.
+    private: void RecordChange(bool _added, msgs::Publish &_pub);
+
+    /// \brief Fill a topic table reply for a client. The reply only holds
+    /// the changes since the client's version when the change log still
+    /// covers it, and the full table otherwise.
+    /// \param[in] _request Epoch and version cached by the client.
+    /// \param[out] _table The reply.
+    private: void FillTopicTable(const msgs::TopicTable &_request,
+                                 msgs::TopicTable &_table) const;
+
     /// \brief Process a message
     /// \param[in] _connectionIndex Index of the connection which generated the
     /// message
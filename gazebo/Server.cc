@@ -24,8 +24,22 @@
 
 #include <stdio.h>
 #include <signal.h>
+#ifndef _WIN32
+  #include <sys/types.h>
+  #include <sys/wait.h>
+  #include <unistd.h>
+#endif
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
 #include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
 #include <boost/algorithm/string.hpp>
+#include <boost/bind/bind.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/program_options.hpp>
@@ -46,14 +60,18 @@
 #include <ignition/fuel_tools/Interface.hh>
 
 #include "gazebo/gazebo.hh"
+#include "gazebo/gazebo_config.h"
 #include "gazebo/transport/transport.hh"
 
 #include "gazebo/util/LogRecord.hh"
 #include "gazebo/util/LogPlay.hh"
+#include "gazebo/common/MeshManager.hh"
 #include "gazebo/common/ModelDatabase.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Plugin.hh"
 #include "gazebo/common/CommonIface.hh"
+#include "gazebo/common/SamplingProfiler.hh"
+#include "gazebo/common/StartupTrace.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Events.hh"
 
@@ -134,11 +152,79 @@ namespace gazebo
 
     /// \brief Set whether to lockstep physics and rendering
     bool lockstep = false;
+
+    /// \brief Appended to the name of every world loaded, set in the
+    /// workers of --prefork.
+    std::string worldSuffix;
+
+    /// \brief World file parsed before forking, which the workers load
+    /// instead of parsing it again.
+    sdf::SDFPtr preforkSDF;
   };
 }
 
 bool ServerPrivate::stop = true;
 
+/////////////////////////////////////////////////
+/// \brief Get the file caching the resolved SDF of a world file, with its
+/// includes expanded and its URIs converted to full paths, in the
+/// directory named by GAZEBO_SDF_CACHE. The world file's path and
+/// modification time are part of the name, a change to an included model
+/// isn't detected though.
+/// \param[in] _worldFile World file.
+/// \return The cache file, empty if the cache is disabled.
+static std::string sdf_cache_file(const std::string &_worldFile)
+{
+  const char *dir = std::getenv("GAZEBO_SDF_CACHE");
+  if (!dir || !*dir)
+    return std::string();
+
+  boost::system::error_code ec;
+  auto modified = boost::filesystem::last_write_time(_worldFile, ec);
+  if (ec)
+    return std::string();
+
+  std::string key = boost::filesystem::absolute(_worldFile).string() + ":" +
+      std::to_string(modified) + ":" + SDF_VERSION + ":" +
+      GAZEBO_VERSION_FULL;
+
+  std::ostringstream name;
+  name << std::hex << std::hash<std::string>()(key) << ".sdf";
+  return (boost::filesystem::path(dir) / name.str()).string();
+}
+
+/////////////////////////////////////////////////
+/// \brief Write the resolved SDF of a world file to the cache.
+/// \param[in] _root SDF root read from the world file.
+/// \param[in] _cacheFile File returned by sdf_cache_file.
+static void write_sdf_cache(sdf::ElementPtr _root,
+    const std::string &_cacheFile)
+{
+  sdf::ElementPtr root = _root->Clone();
+  common::convertToFullPaths(root);
+
+  boost::filesystem::path cachePath(_cacheFile);
+  boost::system::error_code ec;
+  boost::filesystem::create_directories(cachePath.parent_path(), ec);
+
+  // Write then rename, so concurrent servers never read a partial file
+  boost::filesystem::path tmpPath = cachePath;
+  tmpPath += boost::filesystem::unique_path(".%%%%-%%%%.tmp");
+  {
+    std::ofstream out(tmpPath.string());
+    out << root->ToString("");
+    if (!out)
+    {
+      gzwarn << "Unable to write SDF cache [" << _cacheFile << "]\n";
+      boost::filesystem::remove(tmpPath, ec);
+      return;
+    }
+  }
+  boost::filesystem::rename(tmpPath, cachePath, ec);
+  if (ec)
+    boost::filesystem::remove(tmpPath, ec);
+}
+
 /////////////////////////////////////////////////
 Server::Server()
   : dataPtr(new ServerPrivate())
@@ -187,19 +273,42 @@ bool Server::ParseArgs(int _argc, char **_argv)
     ("physics,e", po::value<std::string>(),
      "Specify a physics engine (ode|bullet|dart|simbody).")
     ("play,p", po::value<std::string>(), "Play a log file.")
+    ("play_max_speed", "Play the log file as fast as sensors consume it. "
+     "Implies --lockstep and decodes chunks ahead of playback.")
     ("record,r", "Record state data.")
     ("record_encoding", po::value<std::string>()->default_value("zlib"),
-     "Compression encoding format for log data (zlib|bz2|txt).")
+     "Compression encoding format for log data (zlib|bz2|zstd|txt|binary).")
     ("record_path", po::value<std::string>()->default_value(""),
      "Absolute path in which to store state data")
     ("record_period", po::value<double>()->default_value(-1),
      "Recording period (seconds).")
     ("record_filter", po::value<std::string>()->default_value(""),
      "Recording filter (supports wildcard and regular expression).")
+    ("record_topic", po::value<std::vector<std::string> >(),
+     "Record the messages of a topic next to the state data. "
+     "May be repeated.")
+    ("record_keyframe_period", po::value<double>()->default_value(-1),
+     "Sim time between full states (seconds). In between, only models "
+     "that moved past the record tolerances are recorded.")
+    ("record_position_tolerance", po::value<double>()->default_value(1e-3),
+     "Distance a model moves before it is recorded again (meters).")
+    ("record_orientation_tolerance",
+     po::value<double>()->default_value(1e-3),
+     "Angle a model turns before it is recorded again (radians).")
     ("record_resources", "Recording with model meshes and materials.")
     ("seed",  po::value<double>(), "Start with a given random number seed.")
     ("iters",  po::value<unsigned int>(), "Number of iterations to simulate.")
+    ("world_copies", po::value<unsigned int>(),
+     "Run N copies of each world, named <world>_0 to <world>_N-1, each on "
+     "its own thread.")
+    ("prefork", po::value<unsigned int>(),
+     "Parse the world and its meshes once, then fork N server processes, "
+     "each with its own master port (GAZEBO_MASTER_URI port + i) and its "
+     "worlds named <world>_i.")
     ("minimal_comms", "Reduce the TCP/IP traffic output by gzserver")
+    ("physics_only", "Run physics and transport only: don't start the "
+     "rendering engine and skip the sensors that render. Also set by the "
+     "GAZEBO_PHYSICS_ONLY environment variable.")
     ("server-plugin,s", po::value<std::vector<std::string> >(),
      "Load a plugin.")
     ("profile,o", po::value<std::string>(),
@@ -317,12 +426,48 @@ bool Server::ParseArgs(int _argc, char **_argv)
     }
   }
 
-  if (this->dataPtr->vm.count("lockstep"))
+  if (this->dataPtr->vm.count("world_copies"))
+  {
+    this->dataPtr->params["world_copies"] = boost::lexical_cast<std::string>(
+        this->dataPtr->vm["world_copies"].as<unsigned int>());
+  }
+
+  if (this->dataPtr->vm.count("lockstep") ||
+      (this->dataPtr->vm.count("play") &&
+       this->dataPtr->vm.count("play_max_speed")))
   {
     this->dataPtr->lockstep = true;
   }
+
+  // Must run before PreLoad, which loads the sensors
+  const char *physicsOnlyEnv = std::getenv("GAZEBO_PHYSICS_ONLY");
+  if (this->dataPtr->vm.count("physics_only") ||
+      (physicsOnlyEnv && std::string(physicsOnlyEnv) == "1"))
+  {
+    sensors::disable_rendering();
+    if (this->dataPtr->lockstep)
+    {
+      gzwarn << "Lockstep waits on rendering sensors, which don't run with "
+             << "--physics_only, ignoring it.\n";
+      this->dataPtr->lockstep = false;
+    }
+  }
   rendering::set_lockstep_enabled(this->dataPtr->lockstep);
 
+  // Must run before PreLoad, which starts the master and transport threads
+  if (this->dataPtr->vm.count("prefork"))
+  {
+    if (this->dataPtr->vm.count("play"))
+    {
+      gzerr << "--prefork can't be used with --play, ignoring it.\n";
+    }
+    else if (!this->Prefork(this->dataPtr->vm["prefork"].as<unsigned int>()))
+    {
+      // This is the parent, all the workers have exited
+      return true;
+    }
+  }
+
   if (!this->PreLoad())
   {
     gzerr << "Unable to load gazebo\n";
@@ -337,6 +482,14 @@ bool Server::ParseArgs(int _argc, char **_argv)
   // command line.
   if (this->dataPtr->vm.count("play"))
   {
+    // Rendering waits on the decoder otherwise, unless a read-ahead was
+    // already requested through the environment
+    if (this->dataPtr->vm.count("play_max_speed") &&
+        !std::getenv("GAZEBO_LOG_READ_AHEAD"))
+    {
+      util::LogPlay::Instance()->SetReadAhead(2);
+    }
+
     // Load the log file
     util::LogPlay::Instance()->Open(
         this->dataPtr->vm["play"].as<std::string>());
@@ -376,7 +529,12 @@ bool Server::ParseArgs(int _argc, char **_argv)
       physics = this->dataPtr->vm["physics"].as<std::string>();
 
     // Load the server
-    if (!this->LoadFile(configFilename, physics))
+    if (this->dataPtr->preforkSDF)
+    {
+      if (!this->LoadImpl(this->dataPtr->preforkSDF->Root(), physics))
+        return false;
+    }
+    else if (!this->LoadFile(configFilename, physics))
     {
       gzwarn << "Falling back on worlds/empty.world\n";
       if (!this->LoadFile("worlds/empty.world", physics))
@@ -421,6 +579,8 @@ bool Server::GetInitialized() const
 bool Server::LoadFile(const std::string &_filename,
                       const std::string &_physics)
 {
+  common::StartupTraceScope trace("Server::LoadFile", "server", _filename);
+
   // Load the world file
   sdf::SDFPtr sdf(new sdf::SDF);
   if (!sdf::init(sdf))
@@ -474,13 +634,46 @@ bool Server::LoadFile(const std::string &_filename,
     }
     fclose(test);
 
-    if (!sdf::readFile(foundFile, sdf))
+    std::string cacheFile = sdf_cache_file(foundFile);
+    if (!cacheFile.empty() && boost::filesystem::exists(cacheFile))
+    {
+      std::ifstream in(cacheFile);
+      std::stringstream cached;
+      cached << in.rdbuf();
+      bool read;
+      {
+        common::StartupTraceScope parseTrace("sdf::readString", "sdf",
+            cacheFile);
+        read = sdf::readString(cached.str(), sdf);
+      }
+      if (read)
+      {
+        gzmsg << "Loading world file [" << foundFile << "] from ["
+              << cacheFile << "]" << std::endl;
+        return this->LoadImpl(sdf->Root(), _physics);
+      }
+
+      gzwarn << "Ignoring unreadable SDF cache [" << cacheFile << "]\n";
+      sdf.reset(new sdf::SDF);
+      sdf::init(sdf);
+    }
+
+    bool read;
+    {
+      common::StartupTraceScope parseTrace("sdf::readFile", "sdf",
+          foundFile);
+      read = sdf::readFile(foundFile, sdf);
+    }
+    if (!read)
     {
       gzerr << "Unable to read sdf file[" << filename << "]\n";
       return false;
     }
 
     gzmsg << "Loading world file [" << foundFile << "]" << std::endl;
+
+    if (!cacheFile.empty())
+      write_sdf_cache(sdf->Root(), cacheFile);
   }
   
   return this->LoadImpl(sdf->Root(), _physics);
@@ -506,6 +699,108 @@ bool Server::LoadString(const std::string &_sdfString)
   return this->LoadImpl(sdf->Root());
 }
 
+/////////////////////////////////////////////////
+bool Server::Prefork(const unsigned int _workers)
+{
+#ifdef _WIN32
+  gzerr << "--prefork isn't supported on Windows, ignoring it.\n";
+  return true;
+#else
+  if (_workers == 0)
+    return true;
+
+  // Same setup as gazebo_shared::setup, without starting any thread
+  common::load();
+  using namespace boost::placeholders;
+  sdf::setFindCallback(boost::bind(&common::find_file, _1));
+
+  std::string configFilename = "worlds/empty.world";
+  if (this->dataPtr->vm.count("world_file"))
+    configFilename = this->dataPtr->vm["world_file"].as<std::string>();
+
+  // Fuel worlds are left to the workers, they download them to a shared
+  // cache anyway
+  auto scheme = ignition::common::URI(configFilename).Scheme();
+  if (scheme != "http" && scheme != "https")
+  {
+    sdf::SDFPtr sdf(new sdf::SDF);
+    if (sdf::init(sdf) &&
+        sdf::readFile(common::find_file(configFilename), sdf))
+    {
+      this->dataPtr->preforkSDF = sdf;
+
+      // Parse the meshes once, the workers share the parsed meshes with
+      // the parent until they write to them. They are parsed serially,
+      // MeshManager::Prefetch would start a thread pool, which doesn't
+      // survive fork.
+      std::vector<std::string> meshFiles;
+      physics::collect_mesh_files(sdf->Root(), meshFiles);
+      for (auto const &file : meshFiles)
+        common::MeshManager::Instance()->Load(file);
+
+      gzmsg << "Parsed [" << configFilename << "] and "
+            << meshFiles.size() << " meshes before forking\n";
+    }
+    else
+    {
+      gzwarn << "Unable to parse [" << configFilename << "] before forking, "
+             << "each worker will read it\n";
+    }
+  }
+
+  std::string host;
+  unsigned int port;
+  transport::get_master_uri(host, port);
+
+  const char *partitionEnv = std::getenv("IGN_PARTITION");
+  const std::string partition = partitionEnv ? partitionEnv : "";
+
+  std::vector<pid_t> children;
+  for (unsigned int i = 0; i < _workers; ++i)
+  {
+    pid_t pid = fork();
+    if (pid < 0)
+    {
+      gzerr << "Unable to fork worker [" << i << "]\n";
+      break;
+    }
+
+    if (pid == 0)
+    {
+      // Each worker has its own master, and its own ignition partition
+      // for introspection
+      std::string uri = "http://" + host + ":" + std::to_string(port + i);
+      setenv("GAZEBO_MASTER_URI", uri.c_str(), 1);
+      std::string workerPartition = partition + "_" + std::to_string(i);
+      setenv("IGN_PARTITION", workerPartition.c_str(), 1);
+
+      this->dataPtr->worldSuffix = "_" + std::to_string(i);
+
+      // Keep the workers from running the same random sequence
+      ignition::math::Rand::Seed(ignition::math::Rand::Seed() + i);
+      return true;
+    }
+
+    gzmsg << "Started worker [" << i << "] with pid [" << pid
+          << "] on master port [" << port + i << "]\n";
+    children.push_back(pid);
+  }
+
+  // The parent only waits for the workers. Ctrl-C reaches the whole
+  // process group, so the workers get it too.
+  signal(SIGINT, SIG_IGN);
+  for (auto const &pid : children)
+  {
+    int status;
+    while (waitpid(pid, &status, 0) < 0 && errno == EINTR)
+      continue;
+  }
+
+  this->dataPtr->stop = true;
+  return false;
+#endif
+}
+
 /////////////////////////////////////////////////
 bool Server::PreLoad()
 {
@@ -518,9 +813,12 @@ bool Server::PreLoad()
 bool Server::LoadImpl(sdf::ElementPtr _elem,
                       const std::string &_physics)
 {
+  common::StartupTraceScope trace("Server::LoadImpl", "server");
+
   this->dataPtr->InspectSDFElement(_elem);
 
   // If a physics engine is specified,
+  bool setPhysics = false;
   if (_physics.length())
   {
     // Check if physics engine name is valid
@@ -530,32 +828,79 @@ bool Server::LoadImpl(sdf::ElementPtr _elem,
       gzerr << "Unregistered physics engine [" << _physics
             << "], the default will be used instead.\n";
     }
-    // Try inserting physics engine name if one is given
-    else if (_elem->HasElement("world") &&
-             _elem->GetElement("world")->HasElement("physics"))
+    else
+      setPhysics = true;
+  }
+
+  unsigned int copies = 1;
+  common::StrStr_M::iterator piter = this->dataPtr->params.find("world_copies");
+  if (piter != this->dataPtr->params.end())
+  {
+    try
     {
-      _elem->GetElement("world")->GetElement("physics")
-           ->GetAttribute("type")->Set(_physics);
+      copies = std::max(1u, boost::lexical_cast<unsigned int>(piter->second));
     }
-    else
+    catch(...)
     {
-      gzerr << "Cannot set physics engine: <world> does not have <physics>\n";
+      gzerr << "Unable to cast world_copies[" << piter->second << "] "
+        << "to unsigned integer\n";
     }
   }
 
+  // Every <world> is loaded, each world runs on its own thread and has its
+  // own transport namespace.
   sdf::ElementPtr worldElem = _elem->GetElement("world");
-  if (worldElem)
+  for (; worldElem; worldElem = worldElem->GetNextElement("world"))
   {
-    physics::WorldPtr world = physics::create_world();
-
-    // Create the world
-    try
+    // Try inserting physics engine name if one is given
+    if (setPhysics)
     {
-      physics::load_world(world, worldElem);
+      if (worldElem->HasElement("physics"))
+      {
+        worldElem->GetElement("physics")->GetAttribute("type")->Set(
+            _physics);
+      }
+      else
+      {
+        gzerr << "Cannot set physics engine: <world> does not have "
+              << "<physics>\n";
+      }
     }
-    catch(common::Exception &e)
+
+    const std::string worldName =
+        worldElem->Get<std::string>("name") + this->dataPtr->worldSuffix;
+    for (unsigned int i = 0; i < copies; ++i)
     {
-      gzthrow("Failed to load the World\n"  << e);
+      sdf::ElementPtr elem = worldElem;
+      if (copies > 1)
+      {
+        elem = worldElem->Clone();
+        elem->GetAttribute("name")->Set(worldName + "_" + std::to_string(i));
+      }
+      else if (!this->dataPtr->worldSuffix.empty())
+      {
+        elem->GetAttribute("name")->Set(worldName);
+      }
+
+      const std::string name = elem->Get<std::string>("name");
+      if (!name.empty() && physics::has_world(name))
+      {
+        gzerr << "A world named [" << name << "] is already loaded, "
+              << "skipping it.\n";
+        continue;
+      }
+
+      physics::WorldPtr world = physics::create_world();
+
+      // Create the world
+      try
+      {
+        physics::load_world(world, elem);
+      }
+      catch(common::Exception &e)
+      {
+        gzthrow("Failed to load the World\n"  << e);
+      }
     }
   }
 
@@ -646,9 +991,16 @@ void Server::Run()
   if (this->dataPtr->stop)
     return;
 
+  const char *profile = std::getenv("GAZEBO_SAMPLING_PROFILER");
+  if (profile)
+    common::SamplingProfiler::Start(profile);
+
   // Make sure the sensors are updated once before running the world.
   // This makes sure plugins get loaded properly.
-  sensors::run_once(true);
+  {
+    common::StartupTraceScope trace("sensors::run_once", "sensors");
+    sensors::run_once(true);
+  }
 
   // Run the sensor threads
   sensors::run_threads();
@@ -672,9 +1024,11 @@ void Server::Run()
   // Run each world. Each world starts a new thread
   physics::run_worlds(iterations);
 
+  common::StartupTrace::Finish("gzserver");
+
   this->dataPtr->initialized = true;
 
-  IGN_PROFILE_THREAD_NAME("gzserver");
+  common::SetThreadName("gzserver");
   // Stay on this loop until Gazebo needs to be shut down
   // The server and sensor manager outlive worlds
   while (!this->dataPtr->stop)
@@ -707,6 +1061,9 @@ void Server::Run()
       common::Time::MSleep(1);
   }
 
+  if (common::SamplingProfiler::Running())
+    common::SamplingProfiler::Stop();
+
   // Shutdown gazebo
   gazebo::shutdown();
 }
@@ -716,6 +1073,12 @@ void Server::ProcessParams()
 {
   bool p = this->dataPtr->vm.count("pause") > 0;
   physics::pause_worlds(p);
+
+  if (this->dataPtr->vm.count("play") &&
+      this->dataPtr->vm.count("play_max_speed"))
+  {
+    physics::get_world()->SetLogPlayMaxSpeed(true);
+  }
   common::StrStr_M::const_iterator iter;
   for (iter = this->dataPtr->params.begin();
        iter != this->dataPtr->params.end();
@@ -729,6 +1092,17 @@ void Server::ProcessParams()
       params.path = iter->second;
       params.period = this->dataPtr->vm["record_period"].as<double>();
       params.filter = this->dataPtr->vm["record_filter"].as<std::string>();
+      if (this->dataPtr->vm.count("record_topic"))
+      {
+        params.topics = this->dataPtr->vm["record_topic"].as<
+            std::vector<std::string> >();
+      }
+      params.keyframePeriod =
+          this->dataPtr->vm["record_keyframe_period"].as<double>();
+      params.positionTolerance =
+          this->dataPtr->vm["record_position_tolerance"].as<double>();
+      params.orientationTolerance =
+          this->dataPtr->vm["record_orientation_tolerance"].as<double>();
       params.recordResources =
           this->dataPtr->params.count("record_resources") > 0;
       util::LogRecord::Instance()->Start(params);
@@ -88,6 +88,14 @@ namespace gazebo
     /// \return True if initialized.
     public: bool GetInitialized() const;
 
+    /// \brief Parse the world file and its meshes, then fork the worker
+    /// processes of --prefork. Each worker gets its own master port and
+    /// world name suffix.
+    /// \param[in] _workers Number of worker processes.
+    /// \return True in a worker, or if nothing was forked. False in the
+    /// parent, once all the workers have exited.
+    private: bool Prefork(const unsigned int _workers);
+
     /// \brief Load implementation.
     /// \param[in] _elem Description of the world to load.
     /// \param[in] _physics Physics engine type (ode|bullet|dart|simbody).
@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "gazebo/gazebo_config.h"
+#include "gazebo/common/AllocationCounter.hh"
+
+using namespace gazebo;
+
+#ifdef ENABLE_ALLOCATION_TRACKING
+
+/// \brief Allocations in the process.
+static std::atomic<uint64_t> g_allocations{0};
+
+/// \brief Allocations of the current thread. Zero initialized, so it is
+/// usable from operator new before any constructor runs.
+static thread_local uint64_t t_allocations = 0;
+
+/////////////////////////////////////////////////
+/// \brief Allocate and count a block.
+/// \param[in] _size Requested size.
+/// \return The block, null if out of memory.
+static void *countedAlloc(std::size_t _size)
+{
+  ++t_allocations;
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  return std::malloc(_size > 0 ? _size : 1);
+}
+
+/////////////////////////////////////////////////
+void *operator new(std::size_t _size)
+{
+  void *ptr = countedAlloc(_size);
+  if (!ptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+
+/////////////////////////////////////////////////
+void *operator new[](std::size_t _size)
+{
+  void *ptr = countedAlloc(_size);
+  if (!ptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+
+/////////////////////////////////////////////////
+void *operator new(std::size_t _size, const std::nothrow_t &) noexcept
+{
+  return countedAlloc(_size);
+}
+
+/////////////////////////////////////////////////
+void *operator new[](std::size_t _size, const std::nothrow_t &) noexcept
+{
+  return countedAlloc(_size);
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_ptr) noexcept
+{
+  std::free(_ptr);
+}
+
+/////////////////////////////////////////////////
+void operator delete[](void *_ptr) noexcept
+{
+  std::free(_ptr);
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_ptr, std::size_t) noexcept
+{
+  std::free(_ptr);
+}
+
+/////////////////////////////////////////////////
+void operator delete[](void *_ptr, std::size_t) noexcept
+{
+  std::free(_ptr);
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_ptr, const std::nothrow_t &) noexcept
+{
+  std::free(_ptr);
+}
+
+/////////////////////////////////////////////////
+void operator delete[](void *_ptr, const std::nothrow_t &) noexcept
+{
+  std::free(_ptr);
+}
+
+/////////////////////////////////////////////////
+bool common::AllocationTrackingEnabled()
+{
+  return true;
+}
+
+/////////////////////////////////////////////////
+uint64_t common::AllocationCount()
+{
+  return g_allocations.load(std::memory_order_relaxed);
+}
+
+/////////////////////////////////////////////////
+uint64_t common::ThreadAllocationCount()
+{
+  return t_allocations;
+}
+
+#else
+
+/////////////////////////////////////////////////
+bool common::AllocationTrackingEnabled()
+{
+  return false;
+}
+
+/////////////////////////////////////////////////
+uint64_t common::AllocationCount()
+{
+  return 0;
+}
+
+/////////////////////////////////////////////////
+uint64_t common::ThreadAllocationCount()
+{
+  return 0;
+}
+
+#endif
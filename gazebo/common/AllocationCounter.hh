@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GAZEBO_COMMON_ALLOCATIONCOUNTER_HH_
+#define GAZEBO_COMMON_ALLOCATIONCOUNTER_HH_
+
+#include <cstdint>
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \addtogroup gazebo_common
+    /// \{
+
+    /// \brief Check whether heap allocations are counted. They are when
+    /// gazebo is built with ENABLE_ALLOCATION_TRACKING, which replaces the
+    /// global operator new and delete.
+    /// \return True if the counters below are live.
+    GZ_COMMON_VISIBLE
+    bool AllocationTrackingEnabled();
+
+    /// \brief Get the number of heap allocations made in the process.
+    /// \return Allocations since startup, 0 without allocation tracking.
+    GZ_COMMON_VISIBLE
+    uint64_t AllocationCount();
+
+    /// \brief Get the number of heap allocations made by the calling
+    /// thread. The difference of two calls attributes allocations to the
+    /// code that ran in between, without interference from other threads.
+    /// \return Allocations of the thread since it started, 0 without
+    /// allocation tracking.
+    GZ_COMMON_VISIBLE
+    uint64_t ThreadAllocationCount();
+
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <thread>
+
+#include "gazebo/common/AllocationCounter.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class AllocationCounterTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(AllocationCounterTest, ThreadCount)
+{
+  const uint64_t before = common::ThreadAllocationCount();
+  const uint64_t totalBefore = common::AllocationCount();
+  std::unique_ptr<int> value(new int(3));
+  const uint64_t after = common::ThreadAllocationCount();
+
+  if (!common::AllocationTrackingEnabled())
+  {
+    EXPECT_EQ(before, 0u);
+    EXPECT_EQ(after, 0u);
+    EXPECT_EQ(common::AllocationCount(), 0u);
+    return;
+  }
+
+  EXPECT_EQ(after - before, 1u);
+  EXPECT_GE(common::AllocationCount() - totalBefore, 1u);
+
+  // Allocations of other threads are not attributed to this one
+  std::thread thread([]()
+  {
+    for (int i = 0; i < 10; ++i)
+      std::unique_ptr<int> other(new int(i));
+  });
+  thread.join();
+  EXPECT_LE(common::ThreadAllocationCount() - after, 2u);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
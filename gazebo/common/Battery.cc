@@ -78,6 +78,7 @@ void Battery::InitConsumers()
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->powerLoadsMutex);
   this->dataPtr->powerLoads.clear();
+  this->dataPtr->totalPowerLoad = 0.0;
 }
 
 /////////////////////////////////////////////////
@@ -95,6 +96,7 @@ bool Battery::RemoveConsumer(uint32_t _consumerId)
   std::lock_guard<std::mutex> lock(this->dataPtr->powerLoadsMutex);
   if (this->dataPtr->powerLoads.erase(_consumerId))
   {
+    this->dataPtr->UpdateTotalPowerLoad();
     return true;
   }
   else
@@ -115,7 +117,11 @@ bool Battery::SetPowerLoad(const uint32_t _consumerId, const double _powerLoad)
     return false;
   }
 
-  iter->second = _powerLoad;
+  if (iter->second != _powerLoad)
+  {
+    iter->second = _powerLoad;
+    this->dataPtr->UpdateTotalPowerLoad();
+  }
   return true;
 }
 
@@ -141,6 +147,13 @@ const Battery::PowerLoad_M &Battery::PowerLoads() const
   return this->dataPtr->powerLoads;
 }
 
+/////////////////////////////////////////////////
+double Battery::TotalPowerLoad() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->powerLoadsMutex);
+  return this->dataPtr->totalPowerLoad;
+}
+
 /////////////////////////////////////////////////
 double Battery::Voltage() const
 {
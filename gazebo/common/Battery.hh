@@ -107,6 +107,12 @@ namespace gazebo
       /// \return List of power loads in watts.
       public: const PowerLoad_M &PowerLoads() const;
 
+      /// \brief Get the sum of the power loads of all consumers, without
+      /// walking the consumers. Update functions should prefer this to
+      /// summing PowerLoads().
+      /// \return Total power load in watts.
+      public: double TotalPowerLoad() const;
+
       /// \brief Get the real voltage in volts.
       /// \return Voltage.
       public: double Voltage() const;
@@ -40,6 +40,10 @@ namespace gazebo
       /// \brief Map of unique consumer ID to power loads in watts.
       public: std::map<uint32_t, double> powerLoads;
 
+      /// \brief Sum of the power loads in watts, recomputed whenever a
+      /// power load changes.
+      public: double totalPowerLoad = 0.0;
+
       /// \brief Counter used to produce unique consumer (powerload) ids.
       public: uint32_t powerLoadCounter;
 
@@ -52,6 +56,16 @@ namespace gazebo
 
       /// \brief Mutex that protects the powerLoads map
       public: std::mutex powerLoadsMutex;
+
+      /// \brief Recompute totalPowerLoad. Summing from scratch keeps the
+      /// total exact however often the loads change. Call with
+      /// powerLoadsMutex locked.
+      public: void UpdateTotalPowerLoad()
+      {
+        this->totalPowerLoad = 0.0;
+        for (const auto &load : this->powerLoads)
+          this->totalPowerLoad += load.second;
+      }
     };
   }
 }
@@ -121,6 +121,17 @@ TEST_F(BatteryTest, SetPowerLoad)
   EXPECT_DOUBLE_EQ(powerLoad1, 1.0);
   EXPECT_TRUE(battery->PowerLoad(consumerId2, powerLoad2));
   EXPECT_DOUBLE_EQ(powerLoad2, 2.0);
+
+  // The total follows every change of the consumers
+  EXPECT_DOUBLE_EQ(battery->TotalPowerLoad(), 3.0);
+  EXPECT_TRUE(battery->SetPowerLoad(consumerId1, 0.5));
+  EXPECT_DOUBLE_EQ(battery->TotalPowerLoad(), 2.5);
+  EXPECT_FALSE(battery->SetPowerLoad(consumerId2 + 1, 10.0));
+  EXPECT_DOUBLE_EQ(battery->TotalPowerLoad(), 2.5);
+  EXPECT_TRUE(battery->RemoveConsumer(consumerId2));
+  EXPECT_DOUBLE_EQ(battery->TotalPowerLoad(), 0.5);
+  battery->Init();
+  EXPECT_DOUBLE_EQ(battery->TotalPowerLoad(), 0.0);
 }
 
 /// \brief A fixture class to help with updating the battery voltage.
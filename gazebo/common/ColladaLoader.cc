@@ -18,9 +18,11 @@
 #include <curl/curl.h>
 #include <tinyxml.h>
 #include <math.h>
+#include <cstdlib>
 #include <sstream>
 #include <set>
 #include <memory>
+#include <unordered_map>
 #include <boost/algorithm/string.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/unordered_map.hpp>
@@ -81,6 +83,79 @@ struct Vector2dHash : unary_function<const ignition::math::Vector2d,
   }
 };
 
+/////////////////////////////////////////////////
+/// \brief Read the next number of a whitespace separated list in place,
+/// without copying the text or splitting it into strings.
+/// \param[in,out] _cur Position in the text, moved past the number.
+/// \param[out] _value Number read.
+/// \return False if there is no number left.
+static bool NextDouble(const char *&_cur, double &_value)
+{
+  char *end = nullptr;
+  _value = std::strtod(_cur, &end);
+  if (end == _cur)
+    return false;
+  _cur = end;
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Read all the indices of a whitespace separated list.
+/// \param[in] _text Text to read.
+/// \param[out] _values Indices read.
+static void ParseIndices(const char *_text, std::vector<unsigned int> &_values)
+{
+  const char *cur = _text;
+  char *end = nullptr;
+  while (true)
+  {
+    unsigned long value = std::strtoul(cur, &end, 10);
+    if (end == cur)
+      break;
+    _values.push_back(static_cast<unsigned int>(value));
+    cur = end;
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Record the index of the first value equal to a value.
+/// \param[in,out] _duplicates Table to update. Values missing from the
+/// table are their own first instance.
+/// \param[in] _index Index of the value.
+/// \param[in] _first Index of the first equal value.
+static void SetDuplicate(std::vector<unsigned int> &_duplicates,
+    const unsigned int _index, const unsigned int _first)
+{
+  while (_duplicates.size() < _index)
+    _duplicates.push_back(_duplicates.size());
+
+  if (_index < _duplicates.size())
+    _duplicates[_index] = _first;
+  else
+    _duplicates.push_back(_first);
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the index of the first value equal to a value.
+/// \param[in] _duplicates Table built by SetDuplicate.
+/// \param[in] _index Index of the value.
+/// \return Index of the first equal value.
+static unsigned int FirstDuplicate(
+    const std::vector<unsigned int> &_duplicates, const unsigned int _index)
+{
+  return _index < _duplicates.size() ? _duplicates[_index] : _index;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the count attribute of an element.
+/// \param[in] _elem Element to read.
+/// \return The count, 0 if missing or invalid.
+static size_t CountAttribute(TiXmlElement *_elem)
+{
+  const char *count = _elem->Attribute("count");
+  return count ? std::strtoul(count, nullptr, 10) : 0;
+}
+
 //////////////////////////////////////////////////
   ColladaLoader::ColladaLoader()
 : MeshLoader(), dataPtr(new ColladaLoaderPrivate)
@@ -944,8 +1019,8 @@ void ColladaLoader::LoadVertices(const std::string &_id,
     std::vector<ignition::math::Vector3d> &_verts,
     std::vector<ignition::math::Vector3d> &_norms)
 {
-  std::map<unsigned int, unsigned int> vertDup;
-  std::map<unsigned int, unsigned int> normDup;
+  std::vector<unsigned int> vertDup;
+  std::vector<unsigned int> normDup;
   this->LoadVertices(_id, _transform, _verts, _norms, vertDup, normDup);
 }
 
@@ -954,8 +1029,8 @@ void ColladaLoader::LoadVertices(const std::string &_id,
     const ignition::math::Matrix4d &_transform,
     std::vector<ignition::math::Vector3d> &_verts,
     std::vector<ignition::math::Vector3d> &_norms,
-    std::map<unsigned int, unsigned int> &_vertDups,
-    std::map<unsigned int, unsigned int> &_normDups)
+    std::vector<unsigned int> &_vertDups,
+    std::vector<unsigned int> &_normDups)
 {
   TiXmlElement *verticesXml = this->GetElementId(this->dataPtr->colladaXml,
                                                  "vertices", _id);
@@ -988,7 +1063,7 @@ void ColladaLoader::LoadVertices(const std::string &_id,
 void ColladaLoader::LoadPositions(const std::string &_id,
     const ignition::math::Matrix4d &_transform,
     std::vector<ignition::math::Vector3d> &_values,
-    std::map<unsigned int, unsigned int> &_duplicates)
+    std::vector<unsigned int> &_duplicates)
 {
   if (this->dataPtr->positionIds.find(_id) != this->dataPtr->positionIds.end())
   {
@@ -1033,30 +1108,26 @@ void ColladaLoader::LoadPositions(const std::string &_id,
 
     return;
   }
-  std::string valueStr = floatArrayXml->GetText();
+  // Read the values straight out of the document, three at a time
+  const size_t count = CountAttribute(floatArrayXml) / 3;
+  _values.reserve(_values.size() + count);
+  _duplicates.reserve(_values.size() + count);
 
   boost::unordered_map<ignition::math::Vector3d,
     unsigned int, Vector3Hash> unique;
+  unique.reserve(count);
 
-  std::vector<std::string> strs;
-  std::vector<std::string>::iterator iter, end;
-  boost::split(strs, valueStr, boost::is_any_of(" \t"));
-
-  end = strs.end();
-  for (iter = strs.begin(); iter != end; iter += 3)
+  const char *cur = floatArrayXml->GetText();
+  ignition::math::Vector3d vec;
+  while (NextDouble(cur, vec.X()) && NextDouble(cur, vec.Y()) &&
+         NextDouble(cur, vec.Z()))
   {
-    ignition::math::Vector3d vec(ignition::math::parseFloat(*iter),
-        ignition::math::parseFloat(*(iter+1)),
-        ignition::math::parseFloat(*(iter+2)));
-
-    vec = _transform * vec;
-    _values.push_back(vec);
+    _values.push_back(_transform * vec);
 
-    // create a map of duplicate indices
-    if (unique.find(vec) != unique.end())
-      _duplicates[_values.size()-1] = unique[vec];
-    else
-      unique[vec] = _values.size()-1;
+    // record the first instance of each position
+    const unsigned int index = _values.size()-1;
+    SetDuplicate(_duplicates, index,
+        unique.insert(std::make_pair(_values.back(), index)).first->second);
   }
 
   this->dataPtr->positionDuplicateMap[_id] = _duplicates;
@@ -1067,7 +1138,7 @@ void ColladaLoader::LoadPositions(const std::string &_id,
 void ColladaLoader::LoadNormals(const std::string &_id,
     const ignition::math::Matrix4d &_transform,
     std::vector<ignition::math::Vector3d> &_values,
-    std::map<unsigned int, unsigned int> &_duplicates)
+    std::vector<unsigned int> &_duplicates)
 {
   if (this->dataPtr->normalIds.find(_id) != this->dataPtr->normalIds.end())
   {
@@ -1116,28 +1187,26 @@ void ColladaLoader::LoadNormals(const std::string &_id,
     return;
   }
 
+  const size_t count = CountAttribute(floatArrayXml) / 3;
+  _values.reserve(_values.size() + count);
+  _duplicates.reserve(_values.size() + count);
+
   boost::unordered_map<ignition::math::Vector3d,
     unsigned int, Vector3Hash> unique;
+  unique.reserve(count);
 
-  std::string valueStr = floatArrayXml->GetText();
-  std::istringstream iss(valueStr);
-  do
+  const char *cur = floatArrayXml->GetText();
+  ignition::math::Vector3d vec;
+  while (NextDouble(cur, vec.X()) && NextDouble(cur, vec.Y()) &&
+         NextDouble(cur, vec.Z()))
   {
-    ignition::math::Vector3d vec;
-    iss >> vec.X() >> vec.Y() >> vec.Z();
-    if (iss)
-    {
-      vec = rotMat * vec;
-      vec.Normalize();
-      _values.push_back(vec);
+    _values.push_back((rotMat * vec).Normalize());
 
-      // create a map of duplicate indices
-      if (unique.find(vec) != unique.end())
-        _duplicates[_values.size()-1] = unique[vec];
-      else
-        unique[vec] = _values.size()-1;
-    }
-  } while (iss);
+    // record the first instance of each normal
+    const unsigned int index = _values.size()-1;
+    SetDuplicate(_duplicates, index,
+        unique.insert(std::make_pair(_values.back(), index)).first->second);
+  }
 
   this->dataPtr->normalDuplicateMap[_id] = _duplicates;
   this->dataPtr->normalIds[_id] = _values;
@@ -1146,7 +1215,7 @@ void ColladaLoader::LoadNormals(const std::string &_id,
 /////////////////////////////////////////////////
 void ColladaLoader::LoadTexCoords(const std::string &_id,
     std::vector<ignition::math::Vector2d> &_values,
-    std::map<unsigned int, unsigned int> &_duplicates)
+    std::vector<unsigned int> &_duplicates)
 {
   if (this->dataPtr->texcoordIds.find(_id) != this->dataPtr->texcoordIds.end())
   {
@@ -1264,29 +1333,34 @@ void ColladaLoader::LoadTexCoords(const std::string &_id,
   if (totCount == 0)
     return;
 
+  _values.reserve(_values.size() + texCount);
+  _duplicates.reserve(_values.size() + texCount);
+
   boost::unordered_map<ignition::math::Vector2d,
     unsigned int, Vector2dHash> unique;
+  unique.reserve(texCount);
 
-  // Read the raw texture values, and split them on spaces.
-  std::string valueStr = floatArrayXml->GetText();
-  std::vector<std::string> values;
-  boost::split(values, valueStr, boost::is_any_of(" "));
-
-  // Read in all the texture coordinates.
-  for (int i = 0; i < totCount; i += stride)
+  // Read in all the texture coordinates, straight out of the document.
+  const char *cur = floatArrayXml->GetText();
+  for (int i = 0; i < texCount; ++i)
   {
     // We only handle 2D texture coordinates right now.
-    ignition::math::Vector2d vec(boost::lexical_cast<double>(values[i]),
-          1.0 - boost::lexical_cast<double>(values[i+1]));
-    _values.push_back(vec);
-
-    // create a map of duplicate indices
-    if (unique.find(vec) != unique.end())
+    double u, v, skip;
+    if (!NextDouble(cur, u) || !NextDouble(cur, v))
     {
-      _duplicates[_values.size()-1] = unique[vec];
+      gzerr << "Texture coordinates with id[" << _id << "] are missing "
+            << "values\n";
+      break;
     }
-    else
-      unique[vec] = _values.size()-1;
+    for (int j = 2; j < stride; ++j)
+      NextDouble(cur, skip);
+
+    _values.push_back(ignition::math::Vector2d(u, 1.0 - v));
+
+    // record the first instance of each texture coordinate
+    const unsigned int index = _values.size()-1;
+    SetDuplicate(_duplicates, index,
+        unique.insert(std::make_pair(_values.back(), index)).first->second);
   }
 
   this->dataPtr->texcoordDuplicateMap[_id] = _duplicates;
@@ -1561,9 +1635,9 @@ void ColladaLoader::LoadPolylist(TiXmlElement *_polylistXml,
   unsigned int otherSemantics = TEXCOORD + 1;
 
   // look up table of position/normal/texcoord duplicate indices
-  std::map<unsigned int, unsigned int> texDupMap;
-  std::map<unsigned int, unsigned int> normalDupMap;
-  std::map<unsigned int, unsigned int> positionDupMap;
+  std::vector<unsigned int> texDupMap;
+  std::vector<unsigned int> normalDupMap;
+  std::vector<unsigned int> positionDupMap;
 
   ignition::math::Matrix4d bindShapeMat(ignition::math::Matrix4d::Identity);
   if (_mesh->HasSkeleton())
@@ -1619,32 +1693,42 @@ void ColladaLoader::LoadPolylist(TiXmlElement *_polylistXml,
   // break poly into triangles
   // if vcount >= 4, anchor around 0 (note this is bad for concave elements)
   //   e.g. if vcount = 4, break into triangle 1: [0,1,2], triangle 2: [0,2,3]
-  std::vector<std::string> vcountStrs;
+  std::vector<unsigned int> vcounts;
+  vcounts.reserve(CountAttribute(_polylistXml));
   TiXmlElement *vcountXml = _polylistXml->FirstChildElement("vcount");
-  std::string vcountStr = vcountXml->GetText();
-  boost::split(vcountStrs, vcountStr, boost::is_any_of(" \t"));
-  std::vector<int> vcounts;
-  for (unsigned int j = 0; j < vcountStrs.size(); ++j)
-    vcounts.push_back(ignition::math::parseInt(vcountStrs[j]));
+  ParseIndices(vcountXml->GetText(), vcounts);
 
   // read p
+  size_t pCount = 0;
+  for (const auto vcount : vcounts)
+    pCount += vcount * inputSize;
+
+  std::vector<unsigned int> indices;
+  indices.reserve(pCount);
   TiXmlElement *pXml = _polylistXml->FirstChildElement("p");
-  std::string pStr = pXml->GetText();
+  ParseIndices(pXml->GetText(), indices);
+  if (indices.size() < pCount)
+  {
+    gzerr << "Collada file[" << this->dataPtr->filename
+      << "] has a polylist with fewer indices than its vcount requires\n";
+    delete subMesh;
+    return;
+  }
 
   // vertexIndexMap is a map of collada vertex index to Gazebo submesh vertex
   // indices, used for identifying vertices that can be shared.
-  std::map<unsigned int, std::vector<GeometryIndices> > vertexIndexMap;
+  std::unordered_map<unsigned int, std::vector<GeometryIndices> >
+      vertexIndexMap;
+  vertexIndexMap.reserve(verts.size());
   unsigned int *values = new unsigned int[inputSize];
   memset(values, 0, inputSize);
 
-  std::vector<std::string> strs;
-  boost::split(strs, pStr, boost::is_any_of(" \t"));
-  std::vector<std::string>::iterator strsIter = strs.begin();
+  const unsigned int *polygon = indices.data();
   for (unsigned int l = 0; l < vcounts.size(); ++l)
   {
     // put us at the beginning of the polygon list
     if (l > 0)
-      strsIter += inputSize*vcounts[l-1];
+      polygon += inputSize*vcounts[l-1];
 
     for (unsigned int k = 2; k < (unsigned int)vcounts[l]; ++k)
     {
@@ -1665,7 +1749,7 @@ void ColladaLoader::LoadPolylist(TiXmlElement *_polylistXml,
 
         for (unsigned int i = 0; i < inputSize; ++i)
         {
-          values[i] = ignition::math::parseInt(strsIter[triangle_index+i]);
+          values[i] = polygon[triangle_index+i];
           /*gzerr << "debug parsing "
                 << " poly-i[" << l
                 << "] tri-end-index[" << k
@@ -1686,9 +1770,8 @@ void ColladaLoader::LoadPolylist(TiXmlElement *_polylistXml,
         {
           // Get the vertex position index value. If it is a duplicate then use
           // the existing index instead
-          daeVertIndex = values[*inputs[VERTEX].begin()];
-          if (positionDupMap.find(daeVertIndex) != positionDupMap.end())
-            daeVertIndex = positionDupMap[daeVertIndex];
+          daeVertIndex = FirstDuplicate(positionDupMap,
+              values[*inputs[VERTEX].begin()]);
 
           // if the vertex index has not been previously added then just add it.
           if (vertexIndexMap.find(daeVertIndex) == vertexIndexMap.end())
@@ -1701,7 +1784,7 @@ void ColladaLoader::LoadPolylist(TiXmlElement *_polylistXml,
             // the same normal and texcoord index values
             bool toDuplicate = true;
             unsigned int reuseIndex = 0;
-            std::vector<GeometryIndices> inputValues =
+            const std::vector<GeometryIndices> &inputValues =
                 vertexIndexMap[daeVertIndex];
 
             for (unsigned int i = 0; i < inputValues.size(); ++i)
@@ -1715,13 +1798,8 @@ void ColladaLoader::LoadPolylist(TiXmlElement *_polylistXml,
                 // Get the vertex normal index value. If the normal is a
                 // duplicate then reset the index to the first instance of the
                 // duplicated position
-                unsigned int remappedNormalIndex =
-                  values[*inputs[NORMAL].begin()];
-                if (normalDupMap.find(remappedNormalIndex)
-                    != normalDupMap.end())
-                 {
-                  remappedNormalIndex = normalDupMap[remappedNormalIndex];
-                 }
+                unsigned int remappedNormalIndex = FirstDuplicate(
+                    normalDupMap, values[*inputs[NORMAL].begin()]);
 
                 if (iv.normalIndex == remappedNormalIndex)
                   normEqual = true;
@@ -1736,11 +1814,8 @@ void ColladaLoader::LoadPolylist(TiXmlElement *_polylistXml,
                 // Get the vertex texcoord index value. If the texcoord is a
                 // duplicate then reset the index to the first instance of the
                 // duplicated texcoord
-                unsigned int remappedTexcoordIndex =
-                  values[*inputs[TEXCOORD].begin()];
-
-                if (texDupMap.find(remappedTexcoordIndex) != texDupMap.end())
-                  remappedTexcoordIndex = texDupMap[remappedTexcoordIndex];
+                unsigned int remappedTexcoordIndex = FirstDuplicate(
+                    texDupMap, values[*inputs[TEXCOORD].begin()]);
 
                 texEqual = iv.texcoordIndex == remappedTexcoordIndex;
               }
@@ -1793,11 +1868,8 @@ void ColladaLoader::LoadPolylist(TiXmlElement *_polylistXml,
           }
           if (!inputs[NORMAL].empty())
           {
-            unsigned int inputRemappedNormalIndex =
-              values[*inputs[NORMAL].begin()];
-            if (normalDupMap.find(inputRemappedNormalIndex)
-                != normalDupMap.end())
-              inputRemappedNormalIndex = normalDupMap[inputRemappedNormalIndex];
+            unsigned int inputRemappedNormalIndex = FirstDuplicate(
+                normalDupMap, values[*inputs[NORMAL].begin()]);
             subMesh->AddNormal(norms[inputRemappedNormalIndex]);
             input.normalIndex = inputRemappedNormalIndex;
           }
@@ -1807,14 +1879,8 @@ void ColladaLoader::LoadPolylist(TiXmlElement *_polylistXml,
             // \todo: Add support for multiple texture maps to SubMesh.
             // Here we are only using the first texture coordinates, when
             // multiple could have been specified.
-            unsigned int inputRemappedTexcoordIndex =
-              values[*inputs[TEXCOORD].begin()];
-
-            if (texDupMap.find(inputRemappedTexcoordIndex) != texDupMap.end())
-            {
-              inputRemappedTexcoordIndex =
-                  texDupMap[inputRemappedTexcoordIndex];
-            }
+            unsigned int inputRemappedTexcoordIndex = FirstDuplicate(
+                texDupMap, values[*inputs[TEXCOORD].begin()]);
             subMesh->AddTexCoord(texcoords[inputRemappedTexcoordIndex].X(),
                 texcoords[inputRemappedTexcoordIndex].Y());
             input.texcoordIndex = inputRemappedTexcoordIndex;
@@ -1888,9 +1954,9 @@ void ColladaLoader::LoadTriangles(TiXmlElement *_trianglesXml,
   std::map<const unsigned int, std::set<int>> inputs;
 
   // look up table of position/normal/texcoord duplicate indices
-  std::map<unsigned int, unsigned int> texDupMap;
-  std::map<unsigned int, unsigned int> normalDupMap;
-  std::map<unsigned int, unsigned int> positionDupMap;
+  std::vector<unsigned int> texDupMap;
+  std::vector<unsigned int> normalDupMap;
+  std::vector<unsigned int> positionDupMap;
 
   while (trianglesInputXml)
   {
@@ -1965,7 +2031,9 @@ void ColladaLoader::LoadTriangles(TiXmlElement *_trianglesXml,
 
     return;
   }
-  std::string pStr = pXml->GetText();
+  std::vector<unsigned int> indices;
+  indices.reserve(CountAttribute(_trianglesXml) * 3 * offsetSize);
+  ParseIndices(pXml->GetText(), indices);
 
   // Collada format allows normals and texcoords to have their own set of
   // indices for more efficient storage of data but opengl only supports one
@@ -1975,17 +2043,16 @@ void ColladaLoader::LoadTriangles(TiXmlElement *_trianglesXml,
 
   // vertexIndexMap is a map of collada vertex index to Gazebo submesh vertex
   // indices, used for identifying vertices that can be shared.
-  std::map<unsigned int, std::vector<GeometryIndices> > vertexIndexMap;
+  std::unordered_map<unsigned int, std::vector<GeometryIndices> >
+      vertexIndexMap;
+  vertexIndexMap.reserve(verts.size());
 
   std::vector<unsigned int> values(offsetSize);
-  std::vector<std::string> strs;
-
-  boost::split(strs, pStr, boost::is_any_of(" \t"));
 
-  for (unsigned int j = 0; j < strs.size(); j += offsetSize)
+  for (size_t j = 0; j + offsetSize <= indices.size(); j += offsetSize)
   {
     for (unsigned int i = 0; i < offsetSize; ++i)
-      values.at(i) = ignition::math::parseInt(strs[j+i]);
+      values.at(i) = indices[j+i];
 
     unsigned int daeVertIndex = 0;
     bool addIndex = !hasVertices;
@@ -1996,9 +2063,8 @@ void ColladaLoader::LoadTriangles(TiXmlElement *_trianglesXml,
     {
       // Get the vertex position index value. If the position is a duplicate
       // then reset the index to the first instance of the duplicated position
-      daeVertIndex = values.at(*inputs[VERTEX].begin());
-      if (positionDupMap.find(daeVertIndex) != positionDupMap.end())
-        daeVertIndex = positionDupMap[daeVertIndex];
+      daeVertIndex = FirstDuplicate(positionDupMap,
+          values.at(*inputs[VERTEX].begin()));
 
       // if the vertex index has not been previously added then just add it.
       if (vertexIndexMap.find(daeVertIndex) == vertexIndexMap.end())
@@ -2011,7 +2077,8 @@ void ColladaLoader::LoadTriangles(TiXmlElement *_trianglesXml,
         // same normal and texcoord index values
         bool toDuplicate = true;
         unsigned int reuseIndex = 0;
-        std::vector<GeometryIndices> inputValues = vertexIndexMap[daeVertIndex];
+        const std::vector<GeometryIndices> &inputValues =
+            vertexIndexMap[daeVertIndex];
 
         for (unsigned int i = 0; i < inputValues.size(); ++i)
         {
@@ -2023,10 +2090,8 @@ void ColladaLoader::LoadTriangles(TiXmlElement *_trianglesXml,
             // Get the vertex normal index value. If the normal is a duplicate
             // then reset the index to the first instance of the duplicated
             // position
-            unsigned int remappedNormalIndex =
-              values.at(*inputs[NORMAL].begin());
-            if (normalDupMap.find(remappedNormalIndex) != normalDupMap.end())
-              remappedNormalIndex = normalDupMap[remappedNormalIndex];
+            unsigned int remappedNormalIndex = FirstDuplicate(normalDupMap,
+                values.at(*inputs[NORMAL].begin()));
 
             if (iv.normalIndex == remappedNormalIndex)
               normEqual = true;
@@ -2036,10 +2101,8 @@ void ColladaLoader::LoadTriangles(TiXmlElement *_trianglesXml,
             // Get the vertex texcoord index value. If the texcoord is a
             // duplicate then reset the index to the first instance of the
             // duplicated texcoord
-            unsigned int remappedTexcoordIndex =
-                values.at(*inputs[TEXCOORD].begin());
-            if (texDupMap.find(remappedTexcoordIndex) != texDupMap.end())
-              remappedTexcoordIndex = texDupMap[remappedTexcoordIndex];
+            unsigned int remappedTexcoordIndex = FirstDuplicate(texDupMap,
+                values.at(*inputs[TEXCOORD].begin()));
 
             if (iv.texcoordIndex == remappedTexcoordIndex)
               texEqual = true;
@@ -2091,19 +2154,15 @@ void ColladaLoader::LoadTriangles(TiXmlElement *_trianglesXml,
       }
       if (hasNormals)
       {
-        unsigned int inputRemappedNormalIndex =
-          values.at(*inputs[NORMAL].begin());
-        if (normalDupMap.find(inputRemappedNormalIndex) != normalDupMap.end())
-          inputRemappedNormalIndex = normalDupMap[inputRemappedNormalIndex];
+        unsigned int inputRemappedNormalIndex = FirstDuplicate(normalDupMap,
+            values.at(*inputs[NORMAL].begin()));
         subMesh->AddNormal(norms[inputRemappedNormalIndex]);
         input.normalIndex = inputRemappedNormalIndex;
       }
       if (hasTexcoords)
       {
-        unsigned int inputRemappedTexcoordIndex =
-            values.at(*inputs[TEXCOORD].begin());
-        if (texDupMap.find(inputRemappedTexcoordIndex) != texDupMap.end())
-          inputRemappedTexcoordIndex = texDupMap[inputRemappedTexcoordIndex];
+        unsigned int inputRemappedTexcoordIndex = FirstDuplicate(texDupMap,
+            values.at(*inputs[TEXCOORD].begin()));
         subMesh->AddTexCoord(texcoords[inputRemappedTexcoordIndex].X(),
             texcoords[inputRemappedTexcoordIndex].Y());
         input.texcoordIndex = inputRemappedTexcoordIndex;
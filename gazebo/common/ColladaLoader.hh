@@ -141,42 +141,47 @@ namespace gazebo
       /// \param[in] _transform Transform to apply to all vertices
       /// \param[out] _verts Holds the resulting vertices
       /// \param[out] _norms Holds the resulting normals
-      /// \param[out] _vertDup Holds a map of duplicate position indices
-      /// \param[out] _normDup Holds a map of duplicate normal indices
+      /// \param[out] _vertDup Holds the index of the first equal position
+      /// of each position
+      /// \param[out] _normDup Holds the index of the first equal normal of
+      /// each normal
       private: void LoadVertices(const std::string &_id,
          const ignition::math::Matrix4d &_transform,
          std::vector<ignition::math::Vector3d> &_verts,
          std::vector<ignition::math::Vector3d> &_norms,
-         std::map<unsigned int, unsigned int> &_vertDup,
-         std::map<unsigned int, unsigned int> &_normDup);
+         std::vector<unsigned int> &_vertDup,
+         std::vector<unsigned int> &_normDup);
 
       /// \brief Load positions
       /// \param[in] _id String id of the XML node
       /// \param[in] _transform Transform to apply to all positions
       /// \param[out] _values Holds the resulting position values
-      /// \param[out] _values Holds a map of duplicate position indices
+      /// \param[out] _duplicates Holds the index of the first equal
+      /// position of each position
       private: void LoadPositions(const std::string &_id,
           const ignition::math::Matrix4d &_transform,
           std::vector<ignition::math::Vector3d> &_values,
-          std::map<unsigned int, unsigned int> &_duplicates);
+          std::vector<unsigned int> &_duplicates);
 
       /// \brief Load normals
       /// \param[in] _id String id of the XML node
       /// \param[in] _transform Transform to apply to all normals
       /// \param[out] _values Holds the resulting normal values
-      /// \param[out] _values Holds a map of duplicate normal indices
+      /// \param[out] _duplicates Holds the index of the first equal normal
+      /// of each normal
       private: void LoadNormals(const std::string &_id,
           const ignition::math::Matrix4d &_transform,
           std::vector<ignition::math::Vector3d> &_values,
-          std::map<unsigned int, unsigned int> &_duplicates);
+          std::vector<unsigned int> &_duplicates);
 
       /// \brief Load texture coordinates
       /// \param[in] _id String id of the XML node
       /// \param[out] _values Holds the resulting uv values
-      /// \param[out] _values Holds a map of duplicate uv indices
+      /// \param[out] _duplicates Holds the index of the first equal uv of
+      /// each uv
       private: void LoadTexCoords(const std::string &_id,
           std::vector<ignition::math::Vector2d> &_values,
-          std::map<unsigned int, unsigned int> &_duplicates);
+          std::vector<unsigned int> &_duplicates);
 
       /// \brief Load a material
       /// \param _name Name of the material XML element
@@ -71,19 +71,19 @@ namespace gazebo
       /// \brief Map of collada Material ids to Gazebo materials.
       public: std::map<std::string, Material *> materialIds;
 
-      /// \brief Map of collada POSITION ids to a map of
-      /// duplicate positions.
-      public: std::map<std::string, std::map<unsigned int, unsigned int> >
+      /// \brief Map of collada POSITION ids to the index of the first
+      /// equal position of each position.
+      public: std::map<std::string, std::vector<unsigned int> >
           positionDuplicateMap;
 
-      /// \brief Map of collada NORMAL ids to a map of
-      /// duplicate normals.
-      public: std::map<std::string, std::map<unsigned int, unsigned int> >
+      /// \brief Map of collada NORMAL ids to the index of the first equal
+      /// normal of each normal.
+      public: std::map<std::string, std::vector<unsigned int> >
           normalDuplicateMap;
 
-      /// \brief Map of collada TEXCOORD ids to a map of
-      /// duplicate texture coordinates.
-      public: std::map<std::string, std::map<unsigned int, unsigned int> >
+      /// \brief Map of collada TEXCOORD ids to the index of the first equal
+      /// texture coordinate of each texture coordinate.
+      public: std::map<std::string, std::vector<unsigned int> >
           texcoordDuplicateMap;
     };
 
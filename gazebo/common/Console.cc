@@ -14,7 +14,17 @@
  * limitations under the License.
  *
  */
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/algorithm/string/regex.hpp>
@@ -23,6 +33,7 @@
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Time.hh"
 #include "gazebo/common/Console.hh"
+#include "gazebo/common/SamplingProfiler.hh"
 
 #include "gazebo/gazebo_config.h"
 
@@ -37,6 +48,322 @@ Logger Console::warn("[Wrn] ", 33, Logger::STDERR);
 
 bool Console::quiet = true;
 
+/// \brief Set while a Logger forwards a warning or error to the log file,
+/// so the file copy is kept under pressure like the terminal copy.
+static thread_local bool importantLine = false;
+
+/// \internal
+/// \brief Writes log output on a background thread.
+///
+/// Enabled by setting the GAZEBO_ASYNC_LOG environment variable. Each
+/// thread that logs owns a single producer, single consumer ring of
+/// complete lines, so the logging thread never takes a lock or touches a
+/// file. One writer thread drains all the rings and flushes the streams
+/// once per batch. When a ring is half full, messages, debug output and
+/// gzlog lines are dropped so that room is left for warnings and errors.
+class ConsoleWriter
+{
+  /// \brief Destination of a line.
+  public: enum Target
+  {
+    /// \brief The log file.
+    LOG_FILE,
+    /// \brief Standard output.
+    TERMINAL_OUT,
+    /// \brief Standard error.
+    TERMINAL_ERR
+  };
+
+  /// \brief A line waiting to be written.
+  private: class Record
+  {
+    /// \brief Text to write.
+    public: std::string text;
+
+    /// \brief File to write into when the target is FILE.
+    public: std::ofstream *file = nullptr;
+
+    /// \brief Where the text goes.
+    public: Target target = LOG_FILE;
+
+    /// \brief ANSI color of terminal output.
+    public: int color = 0;
+  };
+
+  /// \brief Lines written by one thread.
+  private: class Ring
+  {
+    /// \brief Number of records, a power of two.
+    public: static const size_t kSize = 4096;
+
+    /// \brief Storage of the records.
+    public: std::vector<Record> records = std::vector<Record>(kSize);
+
+    /// \brief Index of the next record to fill, advanced by the owner.
+    public: std::atomic<size_t> head{0};
+
+    /// \brief Index of the next record to write, advanced by the writer.
+    public: std::atomic<size_t> tail{0};
+
+    /// \brief Number of lines dropped since the writer last looked.
+    public: std::atomic<uint64_t> dropped{0};
+  };
+
+  /// \brief Get the writer.
+  /// \return The writer, or null if asynchronous logging is disabled or
+  /// has been stopped.
+  public: static ConsoleWriter *Instance()
+  {
+    // Never destroyed, logging may happen during static destruction
+    static ConsoleWriter *instance = Enabled() ? new ConsoleWriter : nullptr;
+    return instance && !instance->stopped ? instance : nullptr;
+  }
+
+  /// \brief Queue a line without blocking.
+  /// \param[in] _text Text to write.
+  /// \param[in] _target Where the text goes.
+  /// \param[in] _file File to write into when _target is FILE.
+  /// \param[in] _color ANSI color of terminal output.
+  /// \param[in] _important True for warnings and errors.
+  public: void Push(std::string &&_text, const Target _target,
+              std::ofstream *_file, const int _color, const bool _important)
+  {
+    static thread_local std::shared_ptr<Ring> ring;
+    if (!ring)
+    {
+      ring = std::make_shared<Ring>();
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->rings.push_back(ring);
+    }
+
+    const size_t head = ring->head.load(std::memory_order_relaxed);
+    const size_t used = head - ring->tail.load(std::memory_order_acquire);
+    if (used >= Ring::kSize || (!_important && used >= Ring::kSize / 2))
+    {
+      ring->dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+
+    Record &record = ring->records[head & (Ring::kSize - 1)];
+    record.text = std::move(_text);
+    record.file = _file;
+    record.target = _target;
+    record.color = _color;
+    ring->head.store(head + 1, std::memory_order_release);
+
+    // Wake the writer early when a burst builds up
+    if (used == Ring::kSize / 4)
+      this->wake.notify_one();
+  }
+
+  /// \brief Block until every line queued before the call is written and
+  /// flushed.
+  public: void Flush()
+  {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    const uint64_t request = ++this->flushRequested;
+    this->wake.notify_one();
+    this->flushedCond.wait(lock, [this, request]
+        {
+          return this->flushed >= request || this->stopped;
+        });
+  }
+
+  /// \brief Constructor. Starts the writer thread.
+  private: ConsoleWriter()
+  {
+    this->thread = std::thread(&ConsoleWriter::Run, this);
+    std::atexit(&ConsoleWriter::Stop);
+  }
+
+  /// \brief Check the GAZEBO_ASYNC_LOG environment variable.
+  /// \return True if logging should be asynchronous.
+  private: static bool Enabled()
+  {
+    const char *env = std::getenv("GAZEBO_ASYNC_LOG");
+    return env && std::string(env) != "0";
+  }
+
+  /// \brief Write the remaining lines and stop the writer thread. Lines
+  /// logged afterwards are written synchronously.
+  private: static void Stop()
+  {
+    ConsoleWriter *writer = Instance();
+    if (!writer)
+      return;
+
+    {
+      std::lock_guard<std::mutex> lock(writer->mutex);
+      writer->stop = true;
+    }
+    writer->wake.notify_one();
+    writer->thread.join();
+
+    std::lock_guard<std::mutex> lock(writer->mutex);
+    writer->stopped = true;
+    writer->flushedCond.notify_all();
+  }
+
+  /// \brief Writer thread.
+  private: void Run()
+  {
+    common::SetThreadName("ConsoleWriter");
+    std::vector<std::shared_ptr<Ring>> current;
+    std::unordered_set<std::ofstream *> files;
+    std::ofstream *lastFile = nullptr;
+
+    while (true)
+    {
+      uint64_t request;
+      bool stopping;
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        request = this->flushRequested;
+        stopping = this->stop;
+
+        // Forget rings of threads that are gone once they are empty
+        for (auto iter = this->rings.begin(); iter != this->rings.end();)
+        {
+          if (iter->use_count() == 1 &&
+              (*iter)->tail.load() == (*iter)->head.load())
+          {
+            iter = this->rings.erase(iter);
+          }
+          else
+            ++iter;
+        }
+        current = this->rings;
+      }
+
+      bool wrote = false;
+      bool wroteOut = false;
+      bool wroteErr = false;
+      for (auto &ring : current)
+      {
+        const size_t head = ring->head.load(std::memory_order_acquire);
+        size_t tail = ring->tail.load(std::memory_order_relaxed);
+        for (; tail != head; ++tail)
+        {
+          Record &record = ring->records[tail & (Ring::kSize - 1)];
+          switch (record.target)
+          {
+            case LOG_FILE:
+              if (record.file)
+              {
+                *record.file << record.text;
+                files.insert(record.file);
+                lastFile = record.file;
+              }
+              break;
+            case TERMINAL_OUT:
+              Write(std::cout, record);
+              wroteOut = true;
+              break;
+            case TERMINAL_ERR:
+              Write(std::cerr, record);
+              wroteErr = true;
+              break;
+          }
+          // Release the memory on this thread rather than the logging one
+          std::string().swap(record.text);
+          wrote = true;
+        }
+        ring->tail.store(tail, std::memory_order_release);
+
+        const uint64_t dropped = ring->dropped.exchange(0);
+        if (dropped > 0 && lastFile)
+        {
+          *lastFile << "(" << Time::GetWallTime() << ") [Wrn] " << dropped
+                    << " log lines dropped\n";
+          files.insert(lastFile);
+          wrote = true;
+        }
+      }
+
+      if (wrote)
+      {
+        for (auto file : files)
+          file->flush();
+        files.clear();
+        if (wroteOut)
+          std::cout.flush();
+        if (wroteErr)
+          std::cerr.flush();
+        continue;
+      }
+
+      // Everything queued before the request was read is now written
+      std::unique_lock<std::mutex> lock(this->mutex);
+      if (request > this->flushed)
+      {
+        this->flushed = request;
+        this->flushedCond.notify_all();
+      }
+      if (stopping)
+        break;
+      this->wake.wait_for(lock, std::chrono::milliseconds(10), [this, request]
+          {
+            return this->stop || this->flushRequested != request;
+          });
+    }
+  }
+
+  /// \brief Write a line to the terminal.
+  /// \param[in] _stream Stream to write into.
+  /// \param[in] _record Line to write.
+  private: static void Write(std::ostream &_stream, const Record &_record)
+  {
+#ifndef _WIN32
+    _stream << "\033[1;" << _record.color << "m" << _record.text << "\033[0m";
+#else
+    _stream << _record.text;
+#endif
+  }
+
+  /// \brief Rings of all threads that logged.
+  private: std::vector<std::shared_ptr<Ring>> rings;
+
+  /// \brief Protects rings and the flush and stop requests.
+  private: std::mutex mutex;
+
+  /// \brief Wakes the writer thread.
+  private: std::condition_variable wake;
+
+  /// \brief Signaled when a flush request completes.
+  private: std::condition_variable flushedCond;
+
+  /// \brief Number of flushes requested.
+  private: uint64_t flushRequested = 0;
+
+  /// \brief Number of flush requests completed.
+  private: uint64_t flushed = 0;
+
+  /// \brief Set to ask the writer thread to finish.
+  private: bool stop = false;
+
+  /// \brief Set once the writer thread has finished.
+  private: std::atomic<bool> stopped{false};
+
+  /// \brief Writer thread.
+  private: std::thread thread;
+};
+
+/// \brief Split the complete lines off a log buffer.
+/// \param[in,out] _buffer Buffer to take the lines from. Keeps the text
+/// after the last newline.
+/// \return The complete lines, empty if there are none.
+static std::string TakeLines(std::stringbuf &_buffer)
+{
+  std::string text = _buffer.str();
+  const size_t end = text.find_last_of('\n');
+  if (end == std::string::npos)
+    return std::string();
+
+  _buffer.str(text.substr(end + 1));
+  text.resize(end + 1);
+  return text;
+}
+
 //////////////////////////////////////////////////
 void Console::SetQuiet(bool _quiet)
 {
@@ -49,6 +376,14 @@ bool Console::GetQuiet()
   return quiet;
 }
 
+//////////////////////////////////////////////////
+void Console::Flush()
+{
+  ConsoleWriter *writer = ConsoleWriter::Instance();
+  if (writer)
+    writer->Flush();
+}
+
 /////////////////////////////////////////////////
 Logger::Logger(const std::string &_prefix, int _color, LogType _type)
   : std::ostream(new Buffer(_type, _color)), color(_color), prefix(_prefix)
@@ -109,6 +444,29 @@ Logger::Buffer::~Buffer()
 /////////////////////////////////////////////////
 int Logger::Buffer::sync()
 {
+  ConsoleWriter *writer = ConsoleWriter::Instance();
+  if (writer)
+  {
+    // Only queue whole lines, so that dropping one under pressure never
+    // leaves half of it behind
+    std::string lines = TakeLines(*this);
+    if (lines.empty())
+      return 0;
+
+    importantLine = this->type == Logger::STDERR;
+    Console::log << lines;
+    Console::log.flush();
+    importantLine = false;
+
+    if (!Console::GetQuiet())
+    {
+      writer->Push(std::move(lines), this->type == Logger::STDOUT ?
+          ConsoleWriter::TERMINAL_OUT : ConsoleWriter::TERMINAL_ERR, nullptr,
+          this->color, this->type == Logger::STDERR);
+    }
+    return 0;
+  }
+
   // Log messages to disk
   Console::log << this->str();
   Console::log.flush();
@@ -182,6 +540,7 @@ void FileLogger::Init(const std::string &_prefix, const std::string &_filename)
 
   // Check if the Init method has been already called, and if so
   // remove current buffer.
+  Console::Flush();
   if (buf->stream && buf->stream->is_open())
   {
     buf->stream->flush();
@@ -294,6 +653,18 @@ int FileLogger::Buffer::sync()
   if (!this->stream)
     return -1;
 
+  ConsoleWriter *writer = ConsoleWriter::Instance();
+  if (writer)
+  {
+    std::string lines = TakeLines(*this);
+    if (!lines.empty())
+    {
+      writer->Push(std::move(lines), ConsoleWriter::LOG_FILE, this->stream, 0,
+          importantLine);
+    }
+    return 0;
+  }
+
   *this->stream << this->str();
 
   this->stream->flush();
@@ -202,6 +202,11 @@ namespace gazebo
     /// \class Console Console.hh common/common.hh
     /// \brief Container for loggers, and global logging options
     /// (such as verbose vs. quiet output).
+    ///
+    /// If the GAZEBO_ASYNC_LOG environment variable is set, complete lines
+    /// are handed to a background thread instead of being written on the
+    /// calling thread. Under pressure, messages, debug output and gzlog
+    /// lines are dropped before warnings and errors.
     class GZ_COMMON_VISIBLE Console
     {
       /// \brief Set quiet output.
@@ -212,6 +217,10 @@ namespace gazebo
       /// \return True to if quiet output is set.
       public: static bool GetQuiet();
 
+      /// \brief Wait until all the lines logged so far are written. Does
+      /// nothing unless logging is asynchronous.
+      public: static void Flush();
+
       /// \brief Global instance of the message logger.
       public: static Logger msg;
 
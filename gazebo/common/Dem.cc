@@ -16,6 +16,10 @@
 */
 
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
 #include <boost/filesystem.hpp>
 #include <gazebo/gazebo_config.h>
 
@@ -38,6 +42,151 @@ using namespace common;
 
 #ifdef HAVE_GDAL
 
+/// \brief Largest padded DEM, in samples, held in memory. Larger files are
+/// read region by region.
+static const uint64_t kMaxPreloadedSamples = 4097 * 4097;
+
+/// \brief Number of rows read at once when scanning a file that is not
+/// held in memory.
+static const unsigned int kScanRows = 256;
+
+//////////////////////////////////////////////////
+/// \brief Scale a height of the DEM for the lookup table.
+/// \param[in] _h Height of the DEM.
+/// \param[in] _min Minimum elevation of the DEM.
+/// \param[in] _size Real dimmensions of the terrain in meters.
+/// \param[in] _scale Vector3 used to scale the height.
+/// \return Height of the lookup table.
+static float ScaleHeight(const double _h, const double _min,
+    const ignition::math::Vector3d &_size,
+    const ignition::math::Vector3d &_scale)
+{
+  float h = _min + (_h - _min) * _scale.Z();
+
+  // Invert pixel definition so 1=ground, 0=full height,
+  // if the terrain size has a negative z component
+  // this is mainly for backward compatibility
+  if (_size.Z() < 0)
+    h *= -1;
+
+  // Convert to minElevation if a NODATA value is found
+  if (_size.Z() >= 0 && h < _min)
+    h = _min;
+
+  return h;
+}
+
+//////////////////////////////////////////////////
+bool DemPrivate::Read(const unsigned int _x, const unsigned int _y,
+    const unsigned int _width, const unsigned int _height,
+    const unsigned int _step, float *_dst) const
+{
+  if (!this->windowed)
+  {
+    for (unsigned int row = 0; row < _height; ++row)
+    {
+      for (unsigned int col = 0; col < _width; ++col)
+      {
+        *_dst++ = this->demData[(_y + row * _step) * this->side +
+            _x + col * _step];
+      }
+    }
+    return true;
+  }
+
+  // Samples past the data are padding
+  std::fill(_dst, _dst + _width * _height, 0.0f);
+  const unsigned int cols = _x >= this->dataWidth ? 0 :
+      std::min(_width, (this->dataWidth - _x - 1) / _step + 1);
+  const unsigned int rows = _y >= this->dataHeight ? 0 :
+      std::min(_height, (this->dataHeight - _y - 1) / _step + 1);
+  if (cols == 0 || rows == 0)
+    return true;
+
+  if (_step == 1)
+    return this->ReadWindow(_x, _y, cols, rows, cols, rows, _width, _dst);
+
+  // Center each destination pixel on its sample so every region reads
+  // the same value for a shared vertex. Reading less pixels than the
+  // window covers lets GDAL use the overviews of the file.
+  const double x = _x + 0.5 - 0.5 * _step;
+  const double y = _y + 0.5 - 0.5 * _step;
+  if (x >= 0 && y >= 0 && x + cols * _step <= this->dataWidth &&
+      y + rows * _step <= this->dataHeight)
+  {
+    return this->ReadWindow(x, y, cols * _step, rows * _step, cols, rows,
+        _width, _dst);
+  }
+
+  // The window would leave the data, read it at full resolution instead
+  const unsigned int fillWidth = (cols - 1) * _step + 1;
+  const unsigned int fillHeight = (rows - 1) * _step + 1;
+  std::vector<float> fill(fillWidth * fillHeight);
+  if (!this->ReadWindow(_x, _y, fillWidth, fillHeight, fillWidth,
+        fillHeight, fillWidth, fill.data()))
+  {
+    return false;
+  }
+
+  for (unsigned int row = 0; row < rows; ++row)
+  {
+    for (unsigned int col = 0; col < cols; ++col)
+      _dst[row * _width + col] = fill[row * _step * fillWidth + col * _step];
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool DemPrivate::ReadWindow(const double _x, const double _y,
+    const double _width, const double _height,
+    const unsigned int _dstWidth, const unsigned int _dstHeight,
+    const unsigned int _dstStride, float *_dst) const
+{
+#if GDAL_VERSION_MAJOR >= 2
+  // A floating point window resamples exactly like reading the whole
+  // raster at the padded size does
+  GDALRasterIOExtraArg extraArg;
+  INIT_RASTERIO_EXTRA_ARG(extraArg);
+  extraArg.bFloatingPointWindowValidity = TRUE;
+  extraArg.dfXOff = _x * this->ratioX;
+  extraArg.dfYOff = _y * this->ratioY;
+  extraArg.dfXSize = _width * this->ratioX;
+  extraArg.dfYSize = _height * this->ratioY;
+
+  const int rasterXSize = this->dataSet->GetRasterXSize();
+  const int rasterYSize = this->dataSet->GetRasterYSize();
+  const int xOff = std::min(rasterXSize - 1,
+      static_cast<int>(std::floor(extraArg.dfXOff)));
+  const int yOff = std::min(rasterYSize - 1,
+      static_cast<int>(std::floor(extraArg.dfYOff)));
+  const int xEnd = std::min(rasterXSize,
+      static_cast<int>(std::ceil(extraArg.dfXOff + extraArg.dfXSize)));
+  const int yEnd = std::min(rasterYSize,
+      static_cast<int>(std::ceil(extraArg.dfYOff + extraArg.dfYSize)));
+
+  if (this->band->RasterIO(GF_Read, xOff, yOff,
+        std::max(1, xEnd - xOff), std::max(1, yEnd - yOff),
+        _dst, _dstWidth, _dstHeight, GDT_Float32, sizeof(float),
+        static_cast<GSpacing>(_dstStride) * sizeof(float),
+        &extraArg) != CE_None)
+  {
+    gzerr << "Failure calling RasterIO while reading a DEM file\n";
+    return false;
+  }
+  return true;
+#else
+  (void)_x;
+  (void)_y;
+  (void)_width;
+  (void)_height;
+  (void)_dstWidth;
+  (void)_dstHeight;
+  (void)_dstStride;
+  (void)_dst;
+  return false;
+#endif
+}
+
 //////////////////////////////////////////////////
 Dem::Dem()
   : dataPtr(new DemPrivate)
@@ -165,12 +314,39 @@ int Dem::Load(const std::string &_filename)
 
   double min = ignition::math::MAX_D;
   double max = -ignition::math::MAX_D;
-  for (auto d : this->dataPtr->demData)
+  auto addSample = [&](const float _d)
+  {
+    if (_d < min && _d > noDataValue)
+      min = _d;
+    if (_d > max && _d > noDataValue)
+      max = _d;
+  };
+
+  if (!this->dataPtr->windowed)
   {
-    if (d < min && d > noDataValue)
-      min = d;
-    if (d > max && d > noDataValue)
-      max = d;
+    for (auto d : this->dataPtr->demData)
+      addSample(d);
+  }
+  else
+  {
+    // Scan the file a few rows at a time
+    const unsigned int dataWidth = this->dataPtr->dataWidth;
+    std::vector<float> rows;
+    for (unsigned int y = 0; y < this->dataPtr->dataHeight; y += kScanRows)
+    {
+      unsigned int count = std::min(kScanRows, this->dataPtr->dataHeight - y);
+      rows.resize(dataWidth * count);
+      if (!this->dataPtr->Read(0, y, dataWidth, count, 1, rows.data()))
+        return -1;
+      for (auto d : rows)
+        addSample(d);
+    }
+
+    if (this->dataPtr->dataWidth < this->dataPtr->side ||
+        this->dataPtr->dataHeight < this->dataPtr->side)
+    {
+      addSample(0.0f);
+    }
   }
   if (ignition::math::equal(min, ignition::math::MAX_D) ||
       ignition::math::equal(max, -ignition::math::MAX_D))
@@ -194,7 +370,10 @@ double Dem::GetElevation(double _x, double _y)
            " x " << this->GetHeight() << "]\n");
   }
 
-  return this->dataPtr->demData.at(_y * this->GetWidth() + _x);
+  float elevation = 0;
+  this->dataPtr->Read(static_cast<unsigned int>(_x),
+      static_cast<unsigned int>(_y), 1, 1, 1, &elevation);
+  return elevation;
 }
 
 //////////////////////////////////////////////////
@@ -290,6 +469,17 @@ void Dem::FillHeightMap(int _subSampling, unsigned int _vertSize,
     const ignition::math::Vector3d &_size,
     const ignition::math::Vector3d &_scale,
     bool _flipY, std::vector<float> &_heights)
+{
+  this->FillHeightMapRegion(_subSampling, _vertSize, _size, _scale, _flipY,
+      0, 0, _vertSize, _vertSize, _heights);
+}
+
+//////////////////////////////////////////////////
+void Dem::FillHeightMapRegion(int _subSampling, unsigned int _vertSize,
+    const ignition::math::Vector3d &_size,
+    const ignition::math::Vector3d &_scale,
+    bool _flipY, unsigned int _x, unsigned int _y,
+    unsigned int _width, unsigned int _height, std::vector<float> &_heights)
 {
   if (_subSampling <= 0)
   {
@@ -297,56 +487,126 @@ void Dem::FillHeightMap(int _subSampling, unsigned int _vertSize,
     return;
   }
 
-  // Resize the vector to match the size of the vertices.
-  _heights.resize(_vertSize * _vertSize);
+  // Resize the vector to match the size of the region.
+  _heights.resize(_width * _height);
+  if (_width == 0 || _height == 0)
+    return;
 
-  // Iterate over all the vertices
-  for (unsigned int y = 0; y < _vertSize; ++y)
+  const unsigned int side = this->dataPtr->side;
+  auto dataRow = [&](const unsigned int _row)
+  {
+    unsigned int y = _flipY ? _vertSize - (_y + _row) - 1 : _y + _row;
+    return y / static_cast<double>(_subSampling);
+  };
+
+  // Data the region interpolates between
+  const double firstRow = dataRow(0);
+  const double lastRow = dataRow(_height - 1);
+  const unsigned int x0 = floor(_x / static_cast<double>(_subSampling));
+  const unsigned int y0 = floor(std::min(firstRow, lastRow));
+  const unsigned int xEnd = std::min(side - 1, static_cast<unsigned int>(
+      ceil((_x + _width - 1) / static_cast<double>(_subSampling))));
+  const unsigned int yEnd = std::min(side - 1,
+      static_cast<unsigned int>(ceil(std::max(firstRow, lastRow))));
+
+  // Address the data held in memory directly, read the window otherwise
+  const float *data = this->dataPtr->demData.data();
+  unsigned int stride = side;
+  unsigned int originX = 0;
+  unsigned int originY = 0;
+  std::vector<float> window;
+  if (this->dataPtr->windowed)
   {
-    double yf = y / static_cast<double>(_subSampling);
+    stride = xEnd - x0 + 1;
+    originX = x0;
+    originY = y0;
+    window.resize(stride * (yEnd - y0 + 1));
+    if (!this->dataPtr->Read(x0, y0, stride, yEnd - y0 + 1, 1,
+          window.data()))
+    {
+      return;
+    }
+    data = window.data();
+  }
+
+  // Iterate over the vertices of the region
+  for (unsigned int row = 0; row < _height; ++row)
+  {
+    double yf = dataRow(row);
     unsigned int y1 = floor(yf);
     unsigned int y2 = ceil(yf);
-    if (y2 >= this->dataPtr->side)
-      y2 = this->dataPtr->side - 1;
+    if (y2 >= side)
+      y2 = side - 1;
     double dy = yf - y1;
+    y1 -= originY;
+    y2 -= originY;
 
-    for (unsigned int x = 0; x < _vertSize; ++x)
+    for (unsigned int col = 0; col < _width; ++col)
     {
-      double xf = x / static_cast<double>(_subSampling);
+      double xf = (_x + col) / static_cast<double>(_subSampling);
       unsigned int x1 = floor(xf);
       unsigned int x2 = ceil(xf);
-      if (x2 >= this->dataPtr->side)
-        x2 = this->dataPtr->side - 1;
+      if (x2 >= side)
+        x2 = side - 1;
       double dx = xf - x1;
+      x1 -= originX;
+      x2 -= originX;
 
-      double px1 = this->dataPtr->demData[y1 * this->dataPtr->side + x1];
-      double px2 = this->dataPtr->demData[y1 * this->dataPtr->side + x2];
+      double px1 = data[y1 * stride + x1];
+      double px2 = data[y1 * stride + x2];
       float h1 = (px1 - ((px1 - px2) * dx));
 
-      double px3 = this->dataPtr->demData[y2 * this->dataPtr->side + x1];
-      double px4 = this->dataPtr->demData[y2 * this->dataPtr->side + x2];
+      double px3 = data[y2 * stride + x1];
+      double px4 = data[y2 * stride + x2];
       float h2 = (px3 - ((px3 - px4) * dx));
 
-      float h = this->dataPtr->minElevation +
-          (h1 - ((h1 - h2) * dy) - this->dataPtr->minElevation) * _scale.Z();
+      // Store the height for future use
+      _heights[row * _width + col] = ScaleHeight(h1 - ((h1 - h2) * dy),
+          this->dataPtr->minElevation, _size, _scale);
+    }
+  }
+}
 
-      // Invert pixel definition so 1=ground, 0=full height,
-      // if the terrain size has a negative z component
-      // this is mainly for backward compatibility
-      if (_size.Z() < 0)
-        h *= -1;
+//////////////////////////////////////////////////
+void Dem::FillDecimatedHeightMapRegion(int _subSampling,
+    unsigned int _vertSize, const ignition::math::Vector3d &_size,
+    const ignition::math::Vector3d &_scale, bool _flipY,
+    unsigned int _x, unsigned int _y, unsigned int _width,
+    unsigned int _height, unsigned int _step, std::vector<float> &_heights)
+{
+  // Only vertices that fall on data samples are read directly
+  const unsigned int side = this->dataPtr->side;
+  if (_subSampling != 1 || _step <= 1 || _width == 0 || _height == 0 ||
+      _vertSize > side || _x + (_width - 1) * _step >= side ||
+      _y + (_height - 1) * _step >= _vertSize)
+  {
+    HeightmapData::FillDecimatedHeightMapRegion(_subSampling, _vertSize,
+        _size, _scale, _flipY, _x, _y, _width, _height, _step, _heights);
+    return;
+  }
 
-      // Convert to minElevation if a NODATA value is found
-      if (_size.Z() >= 0 && h < this->dataPtr->minElevation)
-        h = this->dataPtr->minElevation;
+  // Read the rows in increasing order, then flip them if needed
+  const unsigned int firstRow = _flipY ?
+      _vertSize - 1 - (_y + (_height - 1) * _step) : _y;
+  _heights.resize(_width * _height);
+  if (!this->dataPtr->Read(_x, firstRow, _width, _height, _step,
+        _heights.data()))
+  {
+    return;
+  }
 
-      // Store the height for future use
-      if (!_flipY)
-        _heights[y * _vertSize + x] = h;
-      else
-        _heights[(_vertSize - y - 1) * _vertSize + x] = h;
+  if (_flipY)
+  {
+    for (unsigned int row = 0; row < _height / 2; ++row)
+    {
+      std::swap_ranges(_heights.begin() + row * _width,
+          _heights.begin() + (row + 1) * _width,
+          _heights.begin() + (_height - row - 1) * _width);
     }
   }
+
+  for (auto &h : _heights)
+    h = ScaleHeight(h, this->dataPtr->minElevation, _size, _scale);
 }
 
 //////////////////////////////////////////////////
@@ -382,6 +642,28 @@ int Dem::LoadData()
       destWidth = static_cast<float>(destHeight) / static_cast<float>(ratio);
     }
 
+    this->dataPtr->dataWidth = destWidth;
+    this->dataPtr->dataHeight = destHeight;
+    this->dataPtr->ratioX = static_cast<double>(nXSize) / destWidth;
+    this->dataPtr->ratioY = static_cast<double>(nYSize) / destHeight;
+
+#if GDAL_VERSION_MAJOR >= 2
+    // Keep large files on disk and read the regions asked for
+    const char *env = std::getenv("GAZEBO_DEM_WINDOWED");
+    if (env)
+    {
+      this->dataPtr->windowed = std::string(env) != "0";
+    }
+    else
+    {
+      this->dataPtr->windowed = static_cast<uint64_t>(this->GetWidth()) *
+          this->GetHeight() > kMaxPreloadedSamples;
+    }
+
+    if (this->dataPtr->windowed)
+      return 0;
+#endif
+
     // Read the whole raster data and convert it to a GDT_Float32 array.
     // In this step the DEM is scaled to destWidth x destHeight
     buffer.resize(destWidth * destHeight);
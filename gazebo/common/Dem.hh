@@ -118,6 +118,27 @@ namespace gazebo
                   const bool _flipY,
                   std::vector<float> &_heights);
 
+      // Documentation inherited.
+      public: void FillHeightMapRegion(const int _subSampling,
+                  const unsigned int _vertSize,
+                  const ignition::math::Vector3d &_size,
+                  const ignition::math::Vector3d &_scale,
+                  const bool _flipY,
+                  const unsigned int _x, const unsigned int _y,
+                  const unsigned int _width, const unsigned int _height,
+                  std::vector<float> &_heights);
+
+      // Documentation inherited.
+      public: void FillDecimatedHeightMapRegion(const int _subSampling,
+                  const unsigned int _vertSize,
+                  const ignition::math::Vector3d &_size,
+                  const ignition::math::Vector3d &_scale,
+                  const bool _flipY,
+                  const unsigned int _x, const unsigned int _y,
+                  const unsigned int _width, const unsigned int _height,
+                  const unsigned int _step,
+                  std::vector<float> &_heights);
+
       /// \brief Get the georeferenced coordinates (lat, long) of a terrain's
       /// pixel in WGS84.
       /// \param[in] _x X coordinate of the terrain.
@@ -130,7 +151,9 @@ namespace gazebo
 
       /// \brief Get the terrain file as a data array. Due to the Ogre
       /// constrains, the data might be stored in a bigger vector representing
-      /// a squared terrain with padding.
+      /// a squared terrain with padding. Large files, or any file when the
+      /// GAZEBO_DEM_WINDOWED environment variable is set to 1, are not
+      /// loaded but read region by region when heights are requested.
       /// \return 0 when the operation succeeds to open a file.
       private: int LoadData();
 
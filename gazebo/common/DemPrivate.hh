@@ -57,8 +57,55 @@ namespace gazebo
       /// \brief Maximum elevation in meters.
       public: double maxElevation;
 
-      /// \brief DEM data converted to be OGRE-compatible.
+      /// \brief DEM data converted to be OGRE-compatible. Empty when the
+      /// data is read from the file on demand.
       public: std::vector<float> demData;
+
+      /// \brief True if the data is read from the file on demand instead
+      /// of being held in demData.
+      public: bool windowed = false;
+
+      /// \brief Number of columns holding data, the rest is padding.
+      public: unsigned int dataWidth = 0;
+
+      /// \brief Number of rows holding data, the rest is padding.
+      public: unsigned int dataHeight = 0;
+
+      /// \brief Raster columns per data column.
+      public: double ratioX = 1.0;
+
+      /// \brief Raster rows per data row.
+      public: double ratioY = 1.0;
+
+      /// \brief Read a grid of samples of the padded data.
+      /// \param[in] _x Column of the first sample.
+      /// \param[in] _y Row of the first sample.
+      /// \param[in] _width Number of samples per row.
+      /// \param[in] _height Number of rows.
+      /// \param[in] _step Distance between samples, in data columns and
+      /// rows. With a step above one, coarser overviews of the file are used
+      /// when it has them.
+      /// \param[out] _dst _width * _height samples, row by row.
+      /// \return False if the file could not be read.
+      public: bool Read(const unsigned int _x, const unsigned int _y,
+                  const unsigned int _width, const unsigned int _height,
+                  const unsigned int _step, float *_dst) const;
+
+      /// \brief Read a window of the data from the file, resampled to the
+      /// size of the destination.
+      /// \param[in] _x First column of the window.
+      /// \param[in] _y First row of the window.
+      /// \param[in] _width Width of the window, in data columns.
+      /// \param[in] _height Height of the window, in data rows.
+      /// \param[in] _dstWidth Number of samples per row to read.
+      /// \param[in] _dstHeight Number of rows to read.
+      /// \param[in] _dstStride Distance between rows in _dst.
+      /// \param[out] _dst Samples read.
+      /// \return False if the file could not be read.
+      public: bool ReadWindow(const double _x, const double _y,
+                  const double _width, const double _height,
+                  const unsigned int _dstWidth, const unsigned int _dstHeight,
+                  const unsigned int _dstStride, float *_dst) const;
     };
     /// \}
   }
@@ -167,6 +167,58 @@ TEST_F(DemTest, FillHeightmap)
   EXPECT_FLOAT_EQ(213.42966, elevations.at(elevations.size() / 2));
 }
 
+/////////////////////////////////////////////////
+// Heights read from the file on demand match the ones held in memory.
+TEST_F(DemTest, Windowed)
+{
+  boost::filesystem::path path = TEST_PATH;
+  path /= "data/dem_portrait.tif";
+
+  common::Dem loaded;
+  setenv("GAZEBO_DEM_WINDOWED", "0", 1);
+  EXPECT_EQ(loaded.Load(path.string()), 0);
+
+  common::Dem windowed;
+  setenv("GAZEBO_DEM_WINDOWED", "1", 1);
+  EXPECT_EQ(windowed.Load(path.string()), 0);
+  unsetenv("GAZEBO_DEM_WINDOWED");
+
+  EXPECT_EQ(loaded.GetWidth(), windowed.GetWidth());
+  EXPECT_FLOAT_EQ(loaded.GetMinElevation(), windowed.GetMinElevation());
+  EXPECT_FLOAT_EQ(loaded.GetMaxElevation(), windowed.GetMaxElevation());
+  EXPECT_FLOAT_EQ(loaded.GetElevation(3, 5), windowed.GetElevation(3, 5));
+
+  unsigned int vertSize = loaded.GetWidth();
+  ignition::math::Vector3d size(100, 100,
+      loaded.GetMaxElevation() - loaded.GetMinElevation());
+  ignition::math::Vector3d scale(1, 1, 1);
+
+  std::vector<float> expected;
+  std::vector<float> actual;
+  loaded.FillHeightMap(1, vertSize, size, scale, true, expected);
+  windowed.FillHeightMap(1, vertSize, size, scale, true, actual);
+  ASSERT_EQ(expected.size(), actual.size());
+  for (unsigned int i = 0; i < expected.size(); ++i)
+    EXPECT_FLOAT_EQ(expected[i], actual[i]);
+
+  // Every other vertex of a region, from the middle and the border
+  std::vector<float> decimated;
+  std::vector<float> full;
+  for (unsigned int x : {0u, 8u})
+  {
+    windowed.FillDecimatedHeightMapRegion(1, vertSize, size, scale, true,
+        x, 8, 5, 5, 2, decimated);
+    loaded.FillHeightMapRegion(1, vertSize, size, scale, true,
+        x, 8, 9, 9, full);
+    ASSERT_EQ(25u, decimated.size());
+    for (unsigned int y = 0; y < 5; ++y)
+    {
+      for (unsigned int i = 0; i < 5; ++i)
+        EXPECT_FLOAT_EQ(decimated[y * 5 + i], full[y * 2 * 9 + i * 2]);
+    }
+  }
+}
+
 /////////////////////////////////////////////////
 TEST_F(DemTest, NegDem)
 {
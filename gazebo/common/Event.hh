@@ -23,10 +23,12 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 #include "gazebo/gazebo_config.h"
 #include "gazebo/common/Time.hh"
 #include "gazebo/common/CommonTypes.hh"
+#include "gazebo/common/PluginTiming.hh"
 #include "gazebo/util/system.hh"
 
 #include "ignition/common/Profiler.hh"
@@ -272,15 +274,16 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
+        auto conns = this->Snapshot();
 
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        for (const auto &conn : *conns)
         {
-          if ((iter.second != NULL) && iter.second->on)
+          if (conn->on)
           {
+            common::CallbackTimer timer(conn->timing.get());
             IGN_PROFILE_BEGIN("callback0");
-            iter.second->callback();
+            conn->callback();
             IGN_PROFILE_END();
           }
         }
@@ -293,15 +296,16 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
+        auto conns = this->Snapshot();
 
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        for (const auto &conn : *conns)
         {
-          if ((iter.second != NULL) && iter.second->on)
+          if (conn->on)
           {
+            common::CallbackTimer timer(conn->timing.get());
             IGN_PROFILE_BEGIN("callback1");
-            iter.second->callback(_p);
+            conn->callback(_p);
             IGN_PROFILE_END();
           }
         }
@@ -315,15 +319,16 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
+        auto conns = this->Snapshot();
 
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        for (const auto &conn : *conns)
         {
-          if ((iter.second != NULL) && iter.second->on)
+          if (conn->on)
           {
+            common::CallbackTimer timer(conn->timing.get());
             IGN_PROFILE_BEGIN("callback2");
-            iter.second->callback(_p1, _p2);
+            conn->callback(_p1, _p2);
             IGN_PROFILE_END();
           }
         }
@@ -338,15 +343,16 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
+        auto conns = this->Snapshot();
 
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        for (const auto &conn : *conns)
         {
-          if ((iter.second != NULL) && iter.second->on)
+          if (conn->on)
           {
+            common::CallbackTimer timer(conn->timing.get());
             IGN_PROFILE_BEGIN("callback3");
-            iter.second->callback(_p1, _p2, _p3);
+            conn->callback(_p1, _p2, _p3);
             IGN_PROFILE_END();
           }
         }
@@ -363,15 +369,16 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
+        auto conns = this->Snapshot();
 
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        for (const auto &conn : *conns)
         {
-          if ((iter.second != NULL) && iter.second->on)
+          if (conn->on)
           {
+            common::CallbackTimer timer(conn->timing.get());
             IGN_PROFILE_BEGIN("callback4");
-            iter.second->callback(_p1, _p2, _p3, _p4);
+            conn->callback(_p1, _p2, _p3, _p4);
             IGN_PROFILE_END();
           }
         }
@@ -390,15 +397,16 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
+        auto conns = this->Snapshot();
 
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        for (const auto &conn : *conns)
         {
-          if ((iter.second != NULL) && iter.second->on)
+          if (conn->on)
           {
+            common::CallbackTimer timer(conn->timing.get());
             IGN_PROFILE_BEGIN("callback5");
-            iter.second->callback(_p1, _p2, _p3, _p4, _p5);
+            conn->callback(_p1, _p2, _p3, _p4, _p5);
             IGN_PROFILE_END();
           }
         }
@@ -418,15 +426,16 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
+        auto conns = this->Snapshot();
 
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        for (const auto &conn : *conns)
         {
-          if ((iter.second != NULL) && iter.second->on)
+          if (conn->on)
           {
+            common::CallbackTimer timer(conn->timing.get());
             IGN_PROFILE_BEGIN("callback6");
-            iter.second->callback(_p1, _p2, _p3, _p4, _p5, _p6);
+            conn->callback(_p1, _p2, _p3, _p4, _p5, _p6);
             IGN_PROFILE_END();
           }
         }
@@ -447,15 +456,16 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
+        auto conns = this->Snapshot();
 
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        for (const auto &conn : *conns)
         {
-          if ((iter.second != NULL) && iter.second->on)
+          if (conn->on)
           {
+            common::CallbackTimer timer(conn->timing.get());
             IGN_PROFILE_BEGIN("callback7");
-            iter.second->callback(_p1, _p2, _p3, _p4, _p5, _p6, _p7);
+            conn->callback(_p1, _p2, _p3, _p4, _p5, _p6, _p7);
             IGN_PROFILE_END();
           }
         }
@@ -478,15 +488,16 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
+        auto conns = this->Snapshot();
 
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        for (const auto &conn : *conns)
         {
-          if ((iter.second != NULL) && iter.second->on)
+          if (conn->on)
           {
+            common::CallbackTimer timer(conn->timing.get());
             IGN_PROFILE_BEGIN("callback8");
-            iter.second->callback(_p1, _p2, _p3, _p4, _p5, _p6, _p7, _p8);
+            conn->callback(_p1, _p2, _p3, _p4, _p5, _p6, _p7, _p8);
             IGN_PROFILE_END();
           }
         }
@@ -511,15 +522,16 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
+        auto conns = this->Snapshot();
 
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        for (const auto &conn : *conns)
         {
-          if ((iter.second != NULL) && iter.second->on)
+          if (conn->on)
           {
+            common::CallbackTimer timer(conn->timing.get());
             IGN_PROFILE_BEGIN("callback9");
-            iter.second->callback(
+            conn->callback(
                 _p1, _p2, _p3, _p4, _p5, _p6, _p7, _p8, _p9);
             IGN_PROFILE_END();
           }
@@ -546,15 +558,16 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
+        auto conns = this->Snapshot();
 
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        for (const auto &conn : *conns)
         {
-          if ((iter.second != NULL) && iter.second->on)
+          if (conn->on)
           {
+            common::CallbackTimer timer(conn->timing.get());
             IGN_PROFILE_BEGIN("callback10");
-            iter.second->callback(
+            conn->callback(
                 _p1, _p2, _p3, _p4, _p5, _p6, _p7, _p8, _p9, _p10);
             IGN_PROFILE_END();
           }
@@ -562,16 +575,28 @@ namespace gazebo
       }
 
       /// \internal
-      /// \brief Removes queued connections.
-      /// We assume that this function is called from a Signal function.
-      private: void Cleanup();
+      /// \brief A private helper class used in maintaining connections.
+      private: class EventConnection;
+
+      /// \def EvtConnectionVector
+      /// \brief Connections called by a Signal, in the order they connected.
+      typedef std::vector<std::shared_ptr<EventConnection>>
+          EvtConnectionVector;
+
+      /// \internal
+      /// \brief Get the connections to call, rebuilding the list if
+      /// connections were added or removed since the last call. The list is
+      /// never modified once built, so it is iterated without a lock and a
+      /// callback can connect or disconnect while it is in use.
+      /// \return The connections to call.
+      private: std::shared_ptr<const EvtConnectionVector> Snapshot();
 
       /// \brief A private helper class used in maintaining connections.
       private: class EventConnection
       {
         /// \brief Constructor
         public: EventConnection(const bool _on, const std::function<T> &_cb)
-                : callback(_cb)
+                : callback(_cb), timing(common::PluginTiming::Current())
         {
           // Windows Visual Studio 2012 does not have atomic_bool constructor,
           // so we have to set "on" using operator=
@@ -583,28 +608,40 @@ namespace gazebo
 
         /// \brief Callback function
         public: std::function<T> callback;
+
+        /// \brief Plugin the callback is accounted to, null if the
+        /// connection was not made by a plugin.
+        public: std::shared_ptr<common::PluginTiming> timing;
       };
 
       /// \def EvtConnectionMap
       /// \brief Event Connection map typedef.
-      typedef std::map<int, std::unique_ptr<EventConnection>> EvtConnectionMap;
+      typedef std::map<int, std::shared_ptr<EventConnection>> EvtConnectionMap;
 
       /// \brief Array of connection callbacks.
       private: EvtConnectionMap connections;
 
+      /// \brief Connections called by Signal. Replaced, never modified,
+      /// when connections change. A disconnected callback is destroyed once
+      /// the last Signal using an older list returns.
+      private: std::shared_ptr<const EvtConnectionVector> snapshot;
+
+      /// \brief True if connections changed since the snapshot was built.
+      private: std::atomic_bool stale;
+
+      /// \brief Id of the next connection. Ids are never reused.
+      private: int nextId = 0;
+
       /// \brief A thread lock.
       private: mutable std::mutex mutex;
-
-      /// \brief List of connections to remove
-      private: std::list<typename EvtConnectionMap::const_iterator>
-              connectionsToRemove;
     };
 
     /// \brief Constructor.
     template<typename T>
     EventT<T>::EventT()
-    : Event()
+    : Event(), snapshot(std::make_shared<const EvtConnectionVector>())
     {
+      this->stale = false;
     }
 
     /// \brief Destructor. Deletes all the associated connections.
@@ -613,6 +650,8 @@ namespace gazebo
     {
       std::lock_guard<std::mutex> lock(this->mutex);
       this->connections.clear();
+      std::atomic_store(&this->snapshot,
+          std::make_shared<const EvtConnectionVector>());
     }
 
     /// \brief Adds a connection.
@@ -621,13 +660,9 @@ namespace gazebo
     ConnectionPtr EventT<T>::Connect(const std::function<T> &_subscriber)
     {
       std::lock_guard<std::mutex> lock(this->mutex);
-      int index = 0;
-      if (!this->connections.empty())
-      {
-        auto const &iter = this->connections.rbegin();
-        index = iter->first + 1;
-      }
+      int index = this->nextId++;
       this->connections[index].reset(new EventConnection(true, _subscriber));
+      this->stale = true;
       return ConnectionPtr(new Connection(this, index));
     }
 
@@ -651,21 +686,36 @@ namespace gazebo
 
       if (it != this->connections.end())
       {
+        // A Signal in progress skips it, the next one drops it
         it->second->on = false;
-        this->connectionsToRemove.push_back(it);
+        this->connections.erase(it);
+        this->stale = true;
       }
     }
 
     /////////////////////////////////////////////
-    /// \brief Erases all connections from connectionsToRemove.
+    /// \brief Get the connections to call.
     template<typename T>
-    void EventT<T>::Cleanup()
+    std::shared_ptr<const typename EventT<T>::EvtConnectionVector>
+    EventT<T>::Snapshot()
     {
-      std::lock_guard<std::mutex> lock(this->mutex);
-      // Remove all queue connections.
-      for (auto &conn : this->connectionsToRemove)
-        this->connections.erase(conn);
-      this->connectionsToRemove.clear();
+      if (this->stale)
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (this->stale)
+        {
+          auto conns = std::make_shared<EvtConnectionVector>();
+          conns->reserve(this->connections.size());
+          for (const auto &iter : this->connections)
+            conns->push_back(iter.second);
+
+          std::atomic_store(&this->snapshot,
+              std::shared_ptr<const EvtConnectionVector>(std::move(conns)));
+          this->stale = false;
+        }
+      }
+
+      return std::atomic_load(&this->snapshot);
     }
     /// \}
   }
@@ -223,6 +223,36 @@ TEST_F(EventTest, ManyChanges)
 }
 
 
+/////////////////////////////////////////////////
+// Connections made or removed by a callback take effect right away for
+// removals and on the next signal for additions.
+TEST_F(EventTest, ChangeDuringSignal)
+{
+  g_callback = 0;
+  g_callback1 = 0;
+  event::EventT<void ()> evt;
+  event::ConnectionPtr conn1;
+  event::ConnectionPtr added;
+
+  event::ConnectionPtr conn = evt.Connect([&]()
+      {
+        conn1.reset();
+        if (!added)
+          added = evt.Connect(std::bind(&callback));
+      });
+  conn1 = evt.Connect(std::bind(&callback1));
+  EXPECT_EQ(2u, evt.ConnectionCount());
+
+  evt();
+  EXPECT_EQ(0, g_callback);
+  EXPECT_EQ(0, g_callback1);
+  EXPECT_EQ(2u, evt.ConnectionCount());
+
+  evt();
+  EXPECT_EQ(1, g_callback);
+  EXPECT_EQ(0, g_callback1);
+}
+
 /////////////////////////////////////////////////
 // Race condition helper functions
 void create_connections(event::EventT<void ()> & evt,
@@ -15,6 +15,9 @@
  *
 */
 
+#include <algorithm>
+#include <vector>
+
 #include <gazebo/gazebo_config.h>
 
 #ifdef HAVE_GDAL
@@ -34,6 +37,54 @@
 using namespace gazebo;
 using namespace common;
 
+//////////////////////////////////////////////////
+void HeightmapData::FillHeightMapRegion(int _subSampling,
+    unsigned int _vertSize, const ignition::math::Vector3d &_size,
+    const ignition::math::Vector3d &_scale, bool _flipY,
+    unsigned int _x, unsigned int _y, unsigned int _width,
+    unsigned int _height, std::vector<float> &_heights)
+{
+  std::vector<float> all;
+  this->FillHeightMap(_subSampling, _vertSize, _size, _scale, _flipY, all);
+
+  _heights.resize(_width * _height);
+  for (unsigned int y = 0; y < _height; ++y)
+  {
+    std::copy(all.begin() + (_y + y) * _vertSize + _x,
+              all.begin() + (_y + y) * _vertSize + _x + _width,
+              _heights.begin() + y * _width);
+  }
+}
+
+//////////////////////////////////////////////////
+void HeightmapData::FillDecimatedHeightMapRegion(int _subSampling,
+    unsigned int _vertSize, const ignition::math::Vector3d &_size,
+    const ignition::math::Vector3d &_scale, bool _flipY,
+    unsigned int _x, unsigned int _y, unsigned int _width,
+    unsigned int _height, unsigned int _step, std::vector<float> &_heights)
+{
+  if (_step <= 1 || _width == 0 || _height == 0)
+  {
+    this->FillHeightMapRegion(_subSampling, _vertSize, _size, _scale, _flipY,
+        _x, _y, _width, _height, _heights);
+    return;
+  }
+
+  // Fill the region at full resolution, then keep every n-th vertex.
+  const unsigned int fillWidth = (_width - 1) * _step + 1;
+  const unsigned int fillHeight = (_height - 1) * _step + 1;
+  std::vector<float> fill;
+  this->FillHeightMapRegion(_subSampling, _vertSize, _size, _scale, _flipY,
+      _x, _y, fillWidth, fillHeight, fill);
+
+  _heights.resize(_width * _height);
+  for (unsigned int y = 0; y < _height; ++y)
+  {
+    for (unsigned int x = 0; x < _width; ++x)
+      _heights[y * _width + x] = fill[(y * _step) * fillWidth + x * _step];
+  }
+}
+
 //////////////////////////////////////////////////
 HeightmapData *HeightmapDataLoader::LoadImageAsTerrain(
     const std::string &_filename)
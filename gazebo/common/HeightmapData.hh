@@ -56,6 +56,55 @@ namespace gazebo
           const ignition::math::Vector3d &_scale, bool _flipY,
           std::vector<float> &_heights) = 0;
 
+      /// \brief Fill a rectangular region of the lookup table created by
+      /// FillHeightMap. The default implementation creates the whole table
+      /// and copies the region out of it, derived classes fill the region
+      /// directly.
+      /// \param[in] _subsampling Multiplier used to increase the resolution.
+      /// \param[in] _vertSize Number of points per row of the whole table.
+      /// \param[in] _size Real dimmensions of the terrain.
+      /// \param[in] _scale Vector3 used to scale the height.
+      /// \param[in] _flipY If true, it inverts the order in which the vector
+      /// is filled.
+      /// \param[in] _x First column of the region.
+      /// \param[in] _y First row of the region.
+      /// \param[in] _width Number of columns of the region.
+      /// \param[in] _height Number of rows of the region.
+      /// \param[out] _heights Heights of the region, row by row. The height
+      /// at column x and row y of the table is at
+      /// (y - _y) * _width + (x - _x).
+      public: virtual void FillHeightMapRegion(int _subSampling,
+          unsigned int _vertSize, const ignition::math::Vector3d &_size,
+          const ignition::math::Vector3d &_scale, bool _flipY,
+          unsigned int _x, unsigned int _y, unsigned int _width,
+          unsigned int _height, std::vector<float> &_heights);
+
+      /// \brief Fill every _step-th vertex of a rectangular region of the
+      /// lookup table created by FillHeightMap, for coarse levels of detail.
+      /// The default implementation fills the whole region and keeps the
+      /// vertices asked for, derived classes may read coarser data instead.
+      /// \param[in] _subsampling Multiplier used to increase the resolution.
+      /// \param[in] _vertSize Number of points per row of the whole table.
+      /// \param[in] _size Real dimmensions of the terrain.
+      /// \param[in] _scale Vector3 used to scale the height.
+      /// \param[in] _flipY If true, it inverts the order in which the vector
+      /// is filled.
+      /// \param[in] _x First column of the region.
+      /// \param[in] _y First row of the region.
+      /// \param[in] _width Number of columns to fill.
+      /// \param[in] _height Number of rows to fill.
+      /// \param[in] _step Distance between filled vertices, in vertices of
+      /// the table.
+      /// \param[out] _heights Heights of the region, row by row. The height
+      /// at column x and row y of the table is at
+      /// ((y - _y) / _step) * _width + (x - _x) / _step.
+      public: virtual void FillDecimatedHeightMapRegion(int _subSampling,
+          unsigned int _vertSize, const ignition::math::Vector3d &_size,
+          const ignition::math::Vector3d &_scale, bool _flipY,
+          unsigned int _x, unsigned int _y, unsigned int _width,
+          unsigned int _height, unsigned int _step,
+          std::vector<float> &_heights);
+
       /// \brief Get the terrain's height.
       /// \return The terrain's height.
       public: virtual unsigned int GetHeight() const = 0;
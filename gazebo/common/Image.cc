@@ -20,8 +20,13 @@
  */
 
 #include <FreeImage.h>
+#include <algorithm>
 #include <boost/filesystem.hpp>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
 #include <string>
+#include <vector>
 
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/CommonIface.hh"
@@ -33,6 +38,237 @@ using namespace common;
 
 int Image::count = 0;
 
+// The kernels below are plain loops over tightly packed pixels, written so
+// that the compiler turns them into SIMD code without platform intrinsics.
+
+//////////////////////////////////////////////////
+/// \brief Swap the first and third channel of 3 byte pixels.
+/// \param[in] _src Source pixels.
+/// \param[out] _dst Destination pixels, may be _src.
+/// \param[in] _count Number of pixels.
+static void SwapRedBlue(const unsigned char *_src, unsigned char *_dst,
+    const size_t _count)
+{
+  for (size_t i = 0; i < _count; ++i)
+  {
+    const unsigned char c0 = _src[i * 3];
+    const unsigned char c1 = _src[i * 3 + 1];
+    const unsigned char c2 = _src[i * 3 + 2];
+    _dst[i * 3] = c2;
+    _dst[i * 3 + 1] = c1;
+    _dst[i * 3 + 2] = c0;
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Convert 3 byte pixels to luma, with the Rec. 601 weights in 8
+/// bit fixed point.
+/// \param[in] _src Source pixels.
+/// \param[out] _dst Destination pixels.
+/// \param[in] _count Number of pixels.
+/// \param[in] _rgb True if _src is RGB, false if it is BGR.
+static void ColorToGray(const unsigned char *_src, unsigned char *_dst,
+    const size_t _count, const bool _rgb)
+{
+  const unsigned int wr = _rgb ? 77 : 29;
+  const unsigned int wb = _rgb ? 29 : 77;
+  for (size_t i = 0; i < _count; ++i)
+  {
+    _dst[i] = static_cast<unsigned char>((wr * _src[i * 3] +
+        150 * _src[i * 3 + 1] + wb * _src[i * 3 + 2] + 128) >> 8);
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Replicate 1 byte pixels into 3 byte pixels.
+/// \param[in] _src Source pixels.
+/// \param[out] _dst Destination pixels.
+/// \param[in] _count Number of pixels.
+static void GrayToColor(const unsigned char *_src, unsigned char *_dst,
+    const size_t _count)
+{
+  for (size_t i = 0; i < _count; ++i)
+  {
+    const unsigned char v = _src[i];
+    _dst[i * 3] = v;
+    _dst[i * 3 + 1] = v;
+    _dst[i * 3 + 2] = v;
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Convert depth to 1 or 3 byte pixels, near points bright.
+/// \param[in] _src Source depth.
+/// \param[out] _dst Destination pixels.
+/// \param[in] _count Number of pixels.
+/// \param[in] _channels Number of bytes per destination pixel.
+static void DepthToGray(const float *_src, unsigned char *_dst,
+    const size_t _count, const unsigned int _channels)
+{
+  float maxDepth = 0.0f;
+  for (size_t i = 0; i < _count; ++i)
+  {
+    const float d = _src[i];
+    maxDepth = (d > maxDepth && d <= FLT_MAX) ? d : maxDepth;
+  }
+
+  const float scale = maxDepth > 0.0f ? 255.0f / maxDepth : 0.0f;
+  for (size_t i = 0; i < _count; ++i)
+  {
+    float v = 255.0f - _src[i] * scale;
+    // Also maps NaN, and infinity through -infinity, to 0
+    v = v > 0.0f ? v : 0.0f;
+    v = v < 255.0f ? v : 255.0f;
+    const unsigned char g = static_cast<unsigned char>(v);
+    for (unsigned int c = 0; c < _channels; ++c)
+      _dst[i * _channels + c] = g;
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Taps of a resampling filter along one axis.
+class ResampleTaps
+{
+  /// \brief Compute the taps of a triangle filter, as wide as one
+  /// destination pixel when shrinking and as one source pixel otherwise.
+  /// \param[in] _srcSize Number of source pixels.
+  /// \param[in] _dstSize Number of destination pixels.
+  public: ResampleTaps(const unsigned int _srcSize,
+              const unsigned int _dstSize)
+  {
+    const double scale = static_cast<double>(_srcSize) / _dstSize;
+    const double support = std::max(1.0, scale);
+
+    this->first.resize(_dstSize);
+    this->count.resize(_dstSize);
+    this->stride = static_cast<unsigned int>(std::ceil(support)) * 2 + 1;
+    this->weights.assign(_dstSize * this->stride, 0.0f);
+
+    for (unsigned int d = 0; d < _dstSize; ++d)
+    {
+      const double center = (d + 0.5) * scale - 0.5;
+      const int lo = std::max(0,
+          static_cast<int>(std::floor(center - support)) + 1);
+      const int hi = std::min(static_cast<int>(_srcSize) - 1,
+          static_cast<int>(std::ceil(center + support)) - 1);
+
+      float *w = &this->weights[d * this->stride];
+      double sum = 0;
+      unsigned int n = 0;
+      for (int i = lo; i <= hi && n < this->stride; ++i, ++n)
+      {
+        w[n] = static_cast<float>(1.0 - std::abs(i - center) / support);
+        sum += w[n];
+      }
+
+      // Taps past the edges are dropped, the others still add up to 1.
+      // The center is never more than half a pixel outside the image, so
+      // there is at least one tap with a positive weight.
+      for (unsigned int k = 0; k < n; ++k)
+        w[k] = static_cast<float>(w[k] / sum);
+
+      this->first[d] = lo;
+      this->count[d] = n;
+    }
+  }
+
+  /// \brief First source pixel of each destination pixel.
+  public: std::vector<int> first;
+
+  /// \brief Number of source pixels of each destination pixel.
+  public: std::vector<unsigned int> count;
+
+  /// \brief Weights of each destination pixel, stride apart.
+  public: std::vector<float> weights;
+
+  /// \brief Distance between the weights of two destination pixels.
+  public: unsigned int stride = 0;
+};
+
+//////////////////////////////////////////////////
+/// \brief Convert a filtered value back to a pixel channel.
+/// \param[in] _v Filtered value.
+/// \return Channel value.
+template<typename T>
+static T ResampleOutput(const float _v);
+
+template<>
+unsigned char ResampleOutput<unsigned char>(const float _v)
+{
+  const float v = _v + 0.5f;
+  return static_cast<unsigned char>(v > 0.0f ? (v < 255.0f ? v : 255.0f) :
+      0.0f);
+}
+
+template<>
+float ResampleOutput<float>(const float _v)
+{
+  return _v;
+}
+
+//////////////////////////////////////////////////
+/// \brief Resize pixels with a separable triangle filter, first along
+/// rows, then along columns.
+/// \param[in] _src Source pixels.
+/// \param[in] _srcPitch Bytes between two source rows.
+/// \param[in] _width Source width.
+/// \param[in] _height Source height.
+/// \param[in] _channels Number of channels per pixel.
+/// \param[out] _dst Destination pixels.
+/// \param[in] _dstPitch Bytes between two destination rows.
+/// \param[in] _newWidth Destination width.
+/// \param[in] _newHeight Destination height.
+template<typename T>
+static void Resample(const unsigned char *_src, const size_t _srcPitch,
+    const unsigned int _width, const unsigned int _height,
+    const unsigned int _channels, unsigned char *_dst,
+    const size_t _dstPitch, const unsigned int _newWidth,
+    const unsigned int _newHeight)
+{
+  const ResampleTaps xTaps(_width, _newWidth);
+  const ResampleTaps yTaps(_height, _newHeight);
+  const size_t rowSize = static_cast<size_t>(_newWidth) * _channels;
+
+  // Filter every source row horizontally
+  std::vector<float> rows(rowSize * _height);
+  for (unsigned int y = 0; y < _height; ++y)
+  {
+    const T *src = reinterpret_cast<const T *>(_src + y * _srcPitch);
+    float *row = &rows[y * rowSize];
+    for (unsigned int x = 0; x < _newWidth; ++x)
+    {
+      const float *w = &xTaps.weights[x * xTaps.stride];
+      const T *in = src + xTaps.first[x] * _channels;
+      for (unsigned int c = 0; c < _channels; ++c)
+      {
+        float acc = 0;
+        for (unsigned int k = 0; k < xTaps.count[x]; ++k)
+          acc += w[k] * in[k * _channels + c];
+        row[x * _channels + c] = acc;
+      }
+    }
+  }
+
+  // Then combine whole rows vertically
+  std::vector<float> acc(rowSize);
+  for (unsigned int y = 0; y < _newHeight; ++y)
+  {
+    const float *w = &yTaps.weights[y * yTaps.stride];
+    std::fill(acc.begin(), acc.end(), 0.0f);
+    for (unsigned int k = 0; k < yTaps.count[y]; ++k)
+    {
+      const float *row = &rows[(yTaps.first[y] + k) * rowSize];
+      const float wk = w[k];
+      for (size_t i = 0; i < rowSize; ++i)
+        acc[i] += wk * row[i];
+    }
+
+    T *dst = reinterpret_cast<T *>(_dst + y * _dstPitch);
+    for (size_t i = 0; i < rowSize; ++i)
+      dst[i] = ResampleOutput<T>(acc[i]);
+  }
+}
+
 //////////////////////////////////////////////////
 Image::Image(const std::string &_filename)
 {
@@ -108,6 +344,83 @@ void Image::SavePNG(const std::string &_filename)
   FreeImage_Save(FIF_PNG, this->bitmap, _filename.c_str(), 0);
 }
 
+//////////////////////////////////////////////////
+bool Image::SaveToBuffer(const std::string &_format, std::string &_buffer,
+    const int _quality) const
+{
+  if (!this->bitmap)
+    return false;
+
+  FREE_IMAGE_FORMAT fifmt;
+  int flags;
+  if (_format == "jpeg" || _format == "jpg")
+  {
+    fifmt = FIF_JPEG;
+    flags = std::min(std::max(_quality, 1), 100);
+  }
+  else if (_format == "png")
+  {
+    fifmt = FIF_PNG;
+    flags = PNG_Z_BEST_SPEED;
+  }
+  else
+  {
+    gzerr << "Unable to encode an image to format[" << _format << "]\n";
+    return false;
+  }
+
+  // JPEG only takes 8 and 24 bit images
+  FIBITMAP *img = this->bitmap;
+  if (fifmt == FIF_JPEG && FreeImage_GetBPP(img) != 8 &&
+      FreeImage_GetBPP(img) != 24)
+  {
+    img = FreeImage_ConvertTo24Bits(this->bitmap);
+  }
+
+  FIMEMORY *stream = FreeImage_OpenMemory();
+  bool result = img && FreeImage_SaveToMemory(fifmt, img, stream, flags);
+  if (result)
+  {
+    BYTE *data = nullptr;
+    DWORD size = 0;
+    result = FreeImage_AcquireMemory(stream, &data, &size);
+    if (result)
+      _buffer.assign(reinterpret_cast<char *>(data), size);
+  }
+  FreeImage_CloseMemory(stream);
+
+  if (img != this->bitmap)
+    FreeImage_Unload(img);
+
+  return result;
+}
+
+//////////////////////////////////////////////////
+bool Image::LoadFromBuffer(const std::string &_buffer)
+{
+  FIMEMORY *stream = FreeImage_OpenMemory(
+      reinterpret_cast<BYTE *>(const_cast<char *>(_buffer.data())),
+      _buffer.size());
+
+  FIBITMAP *img = nullptr;
+  FREE_IMAGE_FORMAT fifmt = FreeImage_GetFileTypeFromMemory(stream, 0);
+  if (fifmt != FIF_UNKNOWN)
+    img = FreeImage_LoadFromMemory(fifmt, stream, 0);
+  FreeImage_CloseMemory(stream);
+
+  if (!img)
+  {
+    gzerr << "Unable to decode an image of " << _buffer.size() << " bytes\n";
+    return false;
+  }
+
+  if (this->bitmap)
+    FreeImage_Unload(this->bitmap);
+  this->bitmap = img;
+  this->fullName.clear();
+  return true;
+}
+
 //////////////////////////////////////////////////
 void Image::SetFromData(const unsigned char *_data, unsigned int _width,
     unsigned int _height, PixelFormat _format)
@@ -369,12 +682,115 @@ ignition::math::Color Image::MaxColor() const
 //////////////////////////////////////////////////
 void Image::Rescale(int _width, int _height)
 {
+  if (!this->bitmap || _width <= 0 || _height <= 0)
+    return;
+
+  const unsigned int bpp = FreeImage_GetBPP(this->bitmap);
+  const FREE_IMAGE_COLOR_TYPE type = FreeImage_GetColorType(this->bitmap);
+  FIBITMAP *scaled = nullptr;
+
+  if (FreeImage_GetImageType(this->bitmap) == FIT_BITMAP &&
+      ((bpp == 8 && type == FIC_MINISBLACK) ||
+       (bpp == 24 && type == FIC_RGB) ||
+       (bpp == 32 && (type == FIC_RGB || type == FIC_RGBALPHA))))
+  {
+    scaled = FreeImage_Allocate(_width, _height, bpp,
+        FreeImage_GetRedMask(this->bitmap),
+        FreeImage_GetGreenMask(this->bitmap),
+        FreeImage_GetBlueMask(this->bitmap));
+    if (scaled)
+    {
+      Resample<unsigned char>(FreeImage_GetBits(this->bitmap),
+          FreeImage_GetPitch(this->bitmap), FreeImage_GetWidth(this->bitmap),
+          FreeImage_GetHeight(this->bitmap), bpp / 8,
+          FreeImage_GetBits(scaled), FreeImage_GetPitch(scaled),
+          _width, _height);
+    }
+  }
+  else
+  {
 #ifndef _WIN32
-  this->bitmap = FreeImage_Rescale(this->bitmap, _width, _height,
-      FILTER_LANCZOS3);
+    scaled = FreeImage_Rescale(this->bitmap, _width, _height,
+        FILTER_LANCZOS3);
 #else
-  gzerr << "Image::Rescale is not implemented on Windows.\n";
+    gzerr << "Image::Rescale is not implemented on Windows for this "
+          << "pixel format.\n";
 #endif
+  }
+
+  if (scaled)
+  {
+    FreeImage_Unload(this->bitmap);
+    this->bitmap = scaled;
+  }
+}
+
+//////////////////////////////////////////////////
+bool Image::ConvertData(const unsigned char *_src,
+    const PixelFormat _srcFormat, unsigned char *_dst,
+    const PixelFormat _dstFormat, const unsigned int _width,
+    const unsigned int _height)
+{
+  const size_t count = static_cast<size_t>(_width) * _height;
+  const bool srcColor = _srcFormat == RGB_INT8 || _srcFormat == BGR_INT8;
+  const bool dstColor = _dstFormat == RGB_INT8 || _dstFormat == BGR_INT8;
+
+  if (_srcFormat == _dstFormat && (srcColor || _srcFormat == L_INT8))
+  {
+    if (_src != _dst)
+      std::memmove(_dst, _src, count * (srcColor ? 3 : 1));
+  }
+  else if (srcColor && dstColor)
+    SwapRedBlue(_src, _dst, count);
+  else if (srcColor && _dstFormat == L_INT8)
+    ColorToGray(_src, _dst, count, _srcFormat == RGB_INT8);
+  else if (_srcFormat == L_INT8 && dstColor)
+    GrayToColor(_src, _dst, count);
+  else if (_srcFormat == R_FLOAT32 && (dstColor || _dstFormat == L_INT8))
+  {
+    DepthToGray(reinterpret_cast<const float *>(_src), _dst, count,
+        dstColor ? 3 : 1);
+  }
+  else
+    return false;
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool Image::ResizeData(const unsigned char *_src, const unsigned int _width,
+    const unsigned int _height, const PixelFormat _format,
+    unsigned char *_dst, const unsigned int _newWidth,
+    const unsigned int _newHeight)
+{
+  if (_width == 0 || _height == 0 || _newWidth == 0 || _newHeight == 0)
+    return false;
+
+  unsigned int channels;
+  switch (_format)
+  {
+    case L_INT8:
+      channels = 1;
+      break;
+    case RGB_INT8:
+    case BGR_INT8:
+      channels = 3;
+      break;
+    case RGBA_INT8:
+    case BGRA_INT8:
+      channels = 4;
+      break;
+    case R_FLOAT32:
+      Resample<float>(_src, _width * sizeof(float), _width, _height, 1,
+          _dst, _newWidth * sizeof(float), _newWidth, _newHeight);
+      return true;
+    default:
+      return false;
+  }
+
+  Resample<unsigned char>(_src, _width * channels, _width, _height,
+      channels, _dst, _newWidth * channels, _newWidth, _newHeight);
+  return true;
 }
 
 //////////////////////////////////////////////////
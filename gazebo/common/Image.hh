@@ -112,6 +112,22 @@ namespace gazebo
       /// \param[in] _filename The name of the saved image
       public: void SavePNG(const std::string &_filename);
 
+      /// \brief Encode the image to memory.
+      /// \param[in] _format "jpeg" or "png".
+      /// \param[out] _buffer The encoded image.
+      /// \param[in] _quality JPEG quality from 1 to 100. PNG is lossless and
+      /// uses the fastest compression level.
+      /// \return True on success.
+      public: bool SaveToBuffer(const std::string &_format,
+                                std::string &_buffer,
+                                const int _quality = 80) const;
+
+      /// \brief Decode an image encoded in memory, in any format that
+      /// FreeImage can read.
+      /// \param[in] _buffer The encoded image.
+      /// \return True on success.
+      public: bool LoadFromBuffer(const std::string &_buffer);
+
       /// \brief Set the image from raw data
       /// \param[in] _data Pointer to the raw image data
       /// \param[in] _width Width in pixels
@@ -174,11 +190,48 @@ namespace gazebo
       /// \return The max color
       public: ignition::math::Color MaxColor() const;
 
-      /// \brief Rescale the image
+      /// \brief Rescale the image. 8 bit greyscale, RGB and RGBA images
+      /// are resampled with a triangle filter, bilinear when enlarging and
+      /// averaging the covered pixels when shrinking. Other images use
+      /// FreeImage's Lanczos filter, which is not available on Windows.
       /// \param[in] _width New image width
       /// \param[in] _height New image height
       public: void Rescale(int _width, int _height);
 
+      /// \brief Convert raw pixel data between the formats published by
+      /// camera sensors. Supported conversions are between RGB_INT8,
+      /// BGR_INT8 and L_INT8, and from R_FLOAT32 to any of them. Depth in
+      /// R_FLOAT32 maps from 0 to the largest finite value onto 255 to 0,
+      /// so near points are bright; infinite and NaN values are black.
+      /// \param[in] _src Tightly packed source pixels.
+      /// \param[in] _srcFormat Pixel format of _src.
+      /// \param[out] _dst Tightly packed destination pixels. May be the same
+      /// as _src when both formats have the same pixel size.
+      /// \param[in] _dstFormat Pixel format of _dst.
+      /// \param[in] _width Width in pixels.
+      /// \param[in] _height Height in pixels.
+      /// \return False if the conversion is not supported.
+      public: static bool ConvertData(const unsigned char *_src,
+                  const PixelFormat _srcFormat, unsigned char *_dst,
+                  const PixelFormat _dstFormat, const unsigned int _width,
+                  const unsigned int _height);
+
+      /// \brief Resize raw pixel data with the filter used by Rescale.
+      /// \param[in] _src Tightly packed source pixels.
+      /// \param[in] _width Width of _src in pixels.
+      /// \param[in] _height Height of _src in pixels.
+      /// \param[in] _format Pixel format of both buffers: L_INT8, RGB_INT8,
+      /// BGR_INT8, RGBA_INT8, BGRA_INT8 or R_FLOAT32.
+      /// \param[out] _dst Tightly packed destination pixels.
+      /// \param[in] _newWidth Width of _dst in pixels.
+      /// \param[in] _newHeight Height of _dst in pixels.
+      /// \return False if the format is not supported or a size is 0.
+      public: static bool ResizeData(const unsigned char *_src,
+                  const unsigned int _width, const unsigned int _height,
+                  const PixelFormat _format, unsigned char *_dst,
+                  const unsigned int _newWidth,
+                  const unsigned int _newHeight);
+
       /// \brief Returns whether this is a valid image
       /// \return true if image has a bitmap
       public: bool Valid() const;
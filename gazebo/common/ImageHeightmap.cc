@@ -45,8 +45,19 @@ void ImageHeightmap::FillHeightMap(int _subSampling,
     const ignition::math::Vector3d &_scale, bool _flipY,
     std::vector<float> &_heights)
 {
-  // Resize the vector to match the size of the vertices.
-  _heights.resize(_vertSize * _vertSize);
+  this->FillHeightMapRegion(_subSampling, _vertSize, _size, _scale, _flipY,
+      0, 0, _vertSize, _vertSize, _heights);
+}
+
+//////////////////////////////////////////////////
+void ImageHeightmap::FillHeightMapRegion(int _subSampling,
+    unsigned int _vertSize, const ignition::math::Vector3d &_size,
+    const ignition::math::Vector3d &_scale, bool _flipY,
+    unsigned int _x, unsigned int _y, unsigned int _width,
+    unsigned int _height, std::vector<float> &_heights)
+{
+  // Resize the vector to match the size of the region.
+  _heights.resize(_width * _height);
 
   int imgHeight = this->GetHeight();
   int imgWidth = this->GetWidth();
@@ -63,9 +74,12 @@ void ImageHeightmap::FillHeightMap(int _subSampling,
   unsigned int count;
   this->img.GetData(&data, count);
 
-  // Iterate over all the vertices
-  for (unsigned int y = 0; y < _vertSize; ++y)
+  // Iterate over the vertices of the region
+  for (unsigned int row = 0; row < _height; ++row)
   {
+    // Row of the image the vertex comes from
+    unsigned int y = _flipY ? _vertSize - (_y + row) - 1 : _y + row;
+
     // yf ranges between 0 and 4
     double yf = y / static_cast<double>(_subSampling);
     int y1 = floor(yf);
@@ -74,9 +88,9 @@ void ImageHeightmap::FillHeightMap(int _subSampling,
       y2 = imgHeight-1;
     double dy = yf - y1;
 
-    for (unsigned int x = 0; x < _vertSize; ++x)
+    for (unsigned int col = 0; col < _width; ++col)
     {
-      double xf = x / static_cast<double>(_subSampling);
+      double xf = (_x + col) / static_cast<double>(_subSampling);
       int x1 = floor(xf);
       int x2 = ceil(xf);
       if (x2 >= imgWidth)
@@ -100,10 +114,7 @@ void ImageHeightmap::FillHeightMap(int _subSampling,
         h = 1.0 - h;
 
       // Store the height for future use
-      if (!_flipY)
-        _heights[y * _vertSize + x] = h;
-      else
-        _heights[(_vertSize - y - 1) * _vertSize + x] = h;
+      _heights[row * _width + col] = h;
     }
   }
 
@@ -15,6 +15,8 @@
  *
 */
 
+#include <vector>
+
 #include <boost/filesystem.hpp>
 #include <gtest/gtest.h>
 
@@ -103,6 +105,44 @@ TEST_F(ImageHeightmapTest, FillHeightmap)
   EXPECT_NEAR(5.0, elevations.at(elevations.size() / 2), ELEVATION_TOL);
 }
 
+/////////////////////////////////////////////////
+TEST_F(ImageHeightmapTest, FillHeightMapRegion)
+{
+  common::ImageHeightmap img;
+  EXPECT_EQ(0, img.Load("file://media/materials/textures/heightmap_bowl.png"));
+
+  const int subsampling = 2;
+  const unsigned int vertSize = (img.GetWidth() * subsampling) - 1;
+  ignition::math::Vector3d size(129, 129, 10);
+  ignition::math::Vector3d scale(size.X() / vertSize, size.Y() / vertSize,
+      size.Z() / img.GetMaxElevation());
+
+  for (const bool flipY : {false, true})
+  {
+    std::vector<float> elevations;
+    img.FillHeightMap(subsampling, vertSize, size, scale, flipY, elevations);
+
+    // A region touching the last row and column
+    const unsigned int x = 100;
+    const unsigned int y = 200;
+    const unsigned int width = vertSize - x;
+    const unsigned int height = vertSize - y;
+    std::vector<float> region;
+    img.FillHeightMapRegion(subsampling, vertSize, size, scale, flipY,
+        x, y, width, height, region);
+    ASSERT_EQ(width * height, region.size());
+
+    for (unsigned int row = 0; row < height; ++row)
+    {
+      for (unsigned int col = 0; col < width; ++col)
+      {
+        EXPECT_FLOAT_EQ(elevations[(y + row) * vertSize + x + col],
+            region[row * width + col]);
+      }
+    }
+  }
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -16,6 +16,9 @@
 */
 
 #include <gtest/gtest.h>
+#include <cmath>
+#include <cstring>
+#include <vector>
 #include <ignition/math/Color.hh>
 
 #include "gazebo/common/Image.hh"
@@ -52,6 +55,39 @@ TEST_F(ImageTest, Image)
                   common::Image::RGB_INT8);
 }
 
+/////////////////////////////////////////////////
+TEST_F(ImageTest, Buffer)
+{
+  common::Image img;
+  EXPECT_EQ(0, img.Load("file://media/materials/textures/wood.jpg"));
+
+  std::string buffer;
+  EXPECT_FALSE(img.SaveToBuffer("tiff", buffer));
+
+  // PNG is lossless
+  EXPECT_TRUE(img.SaveToBuffer("png", buffer));
+  common::Image png;
+  EXPECT_TRUE(png.LoadFromBuffer(buffer));
+  EXPECT_EQ(img.GetWidth(), png.GetWidth());
+  EXPECT_EQ(img.GetHeight(), png.GetHeight());
+  EXPECT_TRUE(img.Pixel(10, 10) == png.Pixel(10, 10));
+
+  // JPEG gets smaller with the quality
+  std::string low, high;
+  EXPECT_TRUE(img.SaveToBuffer("jpeg", low, 10));
+  EXPECT_TRUE(img.SaveToBuffer("jpeg", high, 95));
+  EXPECT_LT(low.size(), high.size());
+  EXPECT_LT(high.size(), img.GetWidth() * img.GetHeight() * 3u);
+
+  common::Image jpeg;
+  EXPECT_TRUE(jpeg.LoadFromBuffer(high));
+  EXPECT_EQ(img.GetWidth(), jpeg.GetWidth());
+  EXPECT_EQ(img.GetHeight(), jpeg.GetHeight());
+
+  EXPECT_FALSE(jpeg.LoadFromBuffer("not an image"));
+  EXPECT_TRUE(jpeg.Valid());
+}
+
 /////////////////////////////////////////////////
 TEST_F(ImageTest, ConvertPixelFormat)
 {
@@ -100,6 +136,77 @@ TEST_F(ImageTest, ConvertPixelFormat)
      Image::ConvertPixelFormat("BAYER_BGGR8"));
 }
 
+/////////////////////////////////////////////////
+TEST_F(ImageTest, ConvertData)
+{
+  using Image = gazebo::common::Image;
+
+  const unsigned char rgb[6] = {10, 20, 30, 255, 255, 255};
+  unsigned char bgr[6];
+  EXPECT_TRUE(Image::ConvertData(rgb, Image::RGB_INT8, bgr, Image::BGR_INT8,
+      2, 1));
+  EXPECT_EQ(30, bgr[0]);
+  EXPECT_EQ(20, bgr[1]);
+  EXPECT_EQ(10, bgr[2]);
+
+  // In place
+  EXPECT_TRUE(Image::ConvertData(bgr, Image::BGR_INT8, bgr, Image::RGB_INT8,
+      2, 1));
+  EXPECT_EQ(0, memcmp(rgb, bgr, sizeof(rgb)));
+
+  unsigned char gray[2];
+  EXPECT_TRUE(Image::ConvertData(rgb, Image::RGB_INT8, gray, Image::L_INT8,
+      2, 1));
+  EXPECT_EQ(18, gray[0]);
+  EXPECT_EQ(255, gray[1]);
+
+  const float depth[4] = {0.0f, 1.0f, 2.0f, INFINITY};
+  unsigned char depthGray[4];
+  EXPECT_TRUE(Image::ConvertData(
+      reinterpret_cast<const unsigned char *>(depth), Image::R_FLOAT32,
+      depthGray, Image::L_INT8, 2, 2));
+  EXPECT_EQ(255, depthGray[0]);
+  EXPECT_EQ(127, depthGray[1]);
+  EXPECT_EQ(0, depthGray[2]);
+  EXPECT_EQ(0, depthGray[3]);
+
+  EXPECT_FALSE(Image::ConvertData(rgb, Image::RGB_INT8, bgr,
+      Image::RGB_INT16, 2, 1));
+}
+
+/////////////////////////////////////////////////
+TEST_F(ImageTest, Resize)
+{
+  using Image = gazebo::common::Image;
+
+  // A flat image stays flat
+  std::vector<unsigned char> flat(37 * 23 * 3, 100);
+  std::vector<unsigned char> flatOut(100 * 7 * 3, 0);
+  EXPECT_TRUE(Image::ResizeData(flat.data(), 37, 23, Image::RGB_INT8,
+      flatOut.data(), 100, 7));
+  for (auto v : flatOut)
+    EXPECT_EQ(100, v);
+
+  // Shrinking by 2 averages pairs of pixels
+  const float ramp[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+  float half[4];
+  EXPECT_TRUE(Image::ResizeData(reinterpret_cast<const unsigned char *>(ramp),
+      8, 1, Image::R_FLOAT32, reinterpret_cast<unsigned char *>(half), 4, 1));
+  EXPECT_FLOAT_EQ(2.5f, half[1]);
+  EXPECT_FLOAT_EQ(4.5f, half[2]);
+
+  EXPECT_FALSE(Image::ResizeData(flat.data(), 37, 23, Image::RGB_INT16,
+      flatOut.data(), 100, 7));
+  EXPECT_FALSE(Image::ResizeData(flat.data(), 37, 23, Image::RGB_INT8,
+      flatOut.data(), 0, 7));
+
+  common::Image img;
+  EXPECT_EQ(0, img.Load("file://media/materials/textures/wood.jpg"));
+  img.Rescale(124, 82);
+  EXPECT_EQ(124u, img.GetWidth());
+  EXPECT_EQ(82u, img.GetHeight());
+  EXPECT_EQ(24u, img.GetBPP());
+}
 
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
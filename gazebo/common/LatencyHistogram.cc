@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+#include "gazebo/common/LatencyHistogram.hh"
+
+using namespace gazebo;
+using namespace common;
+
+/// \brief Sub-buckets in the second half of every power of two.
+static const unsigned int kHalfSubBuckets = 16;
+
+/// \brief Bits needed to index the sub-buckets of the first power of two.
+static const unsigned int kSubBucketBits = 5;
+
+/// \brief Enough buckets for any 64 bit value.
+static const unsigned int kBucketCount =
+    (64 - kSubBucketBits + 1) * kHalfSubBuckets + kHalfSubBuckets;
+
+namespace gazebo
+{
+  namespace common
+  {
+    class LatencyHistogramPrivate
+    {
+      /// \brief Number of durations in each bucket.
+      public: std::array<uint64_t, kBucketCount> counts;
+
+      /// \brief Number of recorded durations.
+      public: uint64_t total = 0;
+
+      /// \brief Sum of the recorded durations, in nanoseconds.
+      public: double sum = 0;
+
+      /// \brief Shortest recorded duration.
+      public: uint64_t min = std::numeric_limits<uint64_t>::max();
+
+      /// \brief Longest recorded duration.
+      public: uint64_t max = 0;
+    };
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the bucket of a value.
+/// \param[in] _value The value.
+/// \return Index of its bucket.
+static unsigned int BucketIndex(const uint64_t _value)
+{
+  if (_value < 2 * kHalfSubBuckets)
+    return static_cast<unsigned int>(_value);
+
+  // Position of the highest set bit
+  unsigned int msb = 0;
+  for (uint64_t v = _value; v > 1; v >>= 1)
+    ++msb;
+
+  const unsigned int shift = msb - (kSubBucketBits - 1);
+  return shift * kHalfSubBuckets + static_cast<unsigned int>(_value >> shift);
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the highest value of a bucket.
+/// \param[in] _index Index of the bucket.
+/// \return Highest value counted in the bucket.
+static uint64_t BucketMax(const unsigned int _index)
+{
+  if (_index < 2 * kHalfSubBuckets)
+    return _index;
+
+  const unsigned int shift = _index / kHalfSubBuckets - 1;
+  const uint64_t sub = _index - shift * kHalfSubBuckets;
+  return ((sub + 1) << shift) - 1;
+}
+
+/////////////////////////////////////////////////
+LatencyHistogram::LatencyHistogram()
+  : dataPtr(new LatencyHistogramPrivate)
+{
+  this->Reset();
+}
+
+/////////////////////////////////////////////////
+LatencyHistogram::LatencyHistogram(const LatencyHistogram &_other)
+  : dataPtr(new LatencyHistogramPrivate(*_other.dataPtr))
+{
+}
+
+/////////////////////////////////////////////////
+LatencyHistogram::~LatencyHistogram()
+{
+}
+
+/////////////////////////////////////////////////
+LatencyHistogram &LatencyHistogram::operator=(const LatencyHistogram &_other)
+{
+  *this->dataPtr = *_other.dataPtr;
+  return *this;
+}
+
+/////////////////////////////////////////////////
+void LatencyHistogram::Record(const uint64_t _nsec)
+{
+  ++this->dataPtr->counts[BucketIndex(_nsec)];
+  ++this->dataPtr->total;
+  this->dataPtr->sum += static_cast<double>(_nsec);
+  this->dataPtr->min = std::min(this->dataPtr->min, _nsec);
+  this->dataPtr->max = std::max(this->dataPtr->max, _nsec);
+}
+
+/////////////////////////////////////////////////
+void LatencyHistogram::Reset()
+{
+  this->dataPtr->counts.fill(0);
+  this->dataPtr->total = 0;
+  this->dataPtr->sum = 0;
+  this->dataPtr->min = std::numeric_limits<uint64_t>::max();
+  this->dataPtr->max = 0;
+}
+
+/////////////////////////////////////////////////
+uint64_t LatencyHistogram::Count() const
+{
+  return this->dataPtr->total;
+}
+
+/////////////////////////////////////////////////
+uint64_t LatencyHistogram::Min() const
+{
+  return this->dataPtr->total > 0 ? this->dataPtr->min : 0;
+}
+
+/////////////////////////////////////////////////
+uint64_t LatencyHistogram::Max() const
+{
+  return this->dataPtr->max;
+}
+
+/////////////////////////////////////////////////
+double LatencyHistogram::Mean() const
+{
+  if (this->dataPtr->total == 0)
+    return 0;
+  return this->dataPtr->sum / this->dataPtr->total;
+}
+
+/////////////////////////////////////////////////
+uint64_t LatencyHistogram::Percentile(const double _percent) const
+{
+  if (this->dataPtr->total == 0)
+    return 0;
+
+  const double percent = std::min(std::max(_percent, 0.0), 100.0);
+  const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(
+      std::ceil(percent / 100.0 * this->dataPtr->total)));
+
+  uint64_t seen = 0;
+  for (unsigned int i = 0; i < kBucketCount; ++i)
+  {
+    seen += this->dataPtr->counts[i];
+    if (seen >= rank)
+    {
+      // The bucket bounds are approximate, the extremes are exact
+      return std::min(std::max(BucketMax(i), this->dataPtr->min),
+          this->dataPtr->max);
+    }
+  }
+  return this->dataPtr->max;
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GAZEBO_COMMON_LATENCYHISTOGRAM_HH_
+#define GAZEBO_COMMON_LATENCYHISTOGRAM_HH_
+
+#include <cstdint>
+#include <memory>
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    // Forward declare private data class
+    class LatencyHistogramPrivate;
+
+    /// \addtogroup gazebo_common
+    /// \{
+
+    /// \brief Histogram of durations with a fixed relative precision, in
+    /// the manner of HdrHistogram. Values are counted in buckets whose
+    /// width doubles with every power of two, each split in 16 sub-buckets,
+    /// so a percentile is within about 6% of the recorded value whatever
+    /// its magnitude. Recording is a few integer operations and never
+    /// allocates, so it is cheap enough to leave on in every step.
+    class GZ_COMMON_VISIBLE LatencyHistogram
+    {
+      /// \brief Constructor.
+      public: LatencyHistogram();
+
+      /// \brief Copy constructor.
+      /// \param[in] _other Histogram to copy.
+      public: LatencyHistogram(const LatencyHistogram &_other);
+
+      /// \brief Destructor.
+      public: virtual ~LatencyHistogram();
+
+      /// \brief Assignment operator.
+      /// \param[in] _other Histogram to copy.
+      /// \return Reference to this histogram.
+      public: LatencyHistogram &operator=(const LatencyHistogram &_other);
+
+      /// \brief Count a duration.
+      /// \param[in] _nsec Duration in nanoseconds.
+      public: void Record(const uint64_t _nsec);
+
+      /// \brief Forget every recorded duration.
+      public: void Reset();
+
+      /// \brief Get the number of recorded durations.
+      /// \return Number of durations since the last reset.
+      public: uint64_t Count() const;
+
+      /// \brief Get the shortest recorded duration.
+      /// \return Shortest duration in nanoseconds, 0 if none.
+      public: uint64_t Min() const;
+
+      /// \brief Get the longest recorded duration.
+      /// \return Longest duration in nanoseconds, 0 if none.
+      public: uint64_t Max() const;
+
+      /// \brief Get the mean of the recorded durations.
+      /// \return Mean duration in nanoseconds, 0 if none.
+      public: double Mean() const;
+
+      /// \brief Get a percentile of the recorded durations.
+      /// \param[in] _percent Percentile, between 0 and 100.
+      /// \return Duration in nanoseconds that _percent of the recorded
+      /// durations do not exceed, 0 if none.
+      public: uint64_t Percentile(const double _percent) const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<LatencyHistogramPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "gazebo/common/LatencyHistogram.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+using namespace common;
+
+class LatencyHistogramTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(LatencyHistogramTest, Empty)
+{
+  LatencyHistogram histogram;
+  EXPECT_EQ(histogram.Count(), 0u);
+  EXPECT_EQ(histogram.Min(), 0u);
+  EXPECT_EQ(histogram.Max(), 0u);
+  EXPECT_DOUBLE_EQ(histogram.Mean(), 0.0);
+  EXPECT_EQ(histogram.Percentile(50), 0u);
+}
+
+/////////////////////////////////////////////////
+TEST_F(LatencyHistogramTest, Percentiles)
+{
+  LatencyHistogram histogram;
+  for (uint64_t i = 1; i <= 100000; ++i)
+    histogram.Record(i * 1000);
+
+  EXPECT_EQ(histogram.Count(), 100000u);
+  EXPECT_EQ(histogram.Min(), 1000u);
+  EXPECT_EQ(histogram.Max(), 100000000u);
+  EXPECT_NEAR(histogram.Mean(), 50000500.0, 1.0);
+
+  // Within the relative precision of the buckets
+  EXPECT_NEAR(histogram.Percentile(50), 50000000.0, 50000000.0 * 0.07);
+  EXPECT_NEAR(histogram.Percentile(90), 90000000.0, 90000000.0 * 0.07);
+  EXPECT_NEAR(histogram.Percentile(99), 99000000.0, 99000000.0 * 0.07);
+  EXPECT_EQ(histogram.Percentile(100), 100000000u);
+  EXPECT_EQ(histogram.Percentile(0), 1000u);
+}
+
+/////////////////////////////////////////////////
+TEST_F(LatencyHistogramTest, SmallValuesAreExact)
+{
+  LatencyHistogram histogram;
+  for (uint64_t i = 0; i < 32; ++i)
+    histogram.Record(i);
+
+  EXPECT_EQ(histogram.Percentile(50), 15u);
+  EXPECT_EQ(histogram.Percentile(100), 31u);
+}
+
+/////////////////////////////////////////////////
+TEST_F(LatencyHistogramTest, ExtremesAndReset)
+{
+  LatencyHistogram histogram;
+  histogram.Record(0);
+  histogram.Record(UINT64_MAX);
+  EXPECT_EQ(histogram.Percentile(100), UINT64_MAX);
+
+  LatencyHistogram copy(histogram);
+  histogram.Reset();
+  EXPECT_EQ(histogram.Count(), 0u);
+  EXPECT_EQ(copy.Count(), 2u);
+  EXPECT_EQ(copy.Max(), UINT64_MAX);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
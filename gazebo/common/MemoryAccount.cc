@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <map>
+
+#include "gazebo/common/MemoryAccount.hh"
+
+using namespace gazebo;
+using namespace common;
+
+namespace
+{
+  /// \brief Protects g_accounts.
+  std::mutex g_accountsMutex;
+
+  /// \brief Every account, by name.
+  std::map<std::string, std::shared_ptr<MemoryAccount>> g_accounts;
+}
+
+//////////////////////////////////////////////////
+MemoryAccount::MemoryAccount(const std::string &_name)
+  : name(_name)
+{
+}
+
+//////////////////////////////////////////////////
+const std::string &MemoryAccount::Name() const
+{
+  return this->name;
+}
+
+//////////////////////////////////////////////////
+void MemoryAccount::Add(const int64_t _bytes)
+{
+  this->UpdatePeak(
+      this->bytes.fetch_add(_bytes, std::memory_order_relaxed) + _bytes);
+}
+
+//////////////////////////////////////////////////
+void MemoryAccount::Set(const int64_t _bytes)
+{
+  this->bytes.store(_bytes, std::memory_order_relaxed);
+  this->UpdatePeak(_bytes);
+}
+
+//////////////////////////////////////////////////
+void MemoryAccount::SetSource(const std::function<int64_t()> &_source)
+{
+  std::lock_guard<std::mutex> lock(this->sourceMutex);
+  this->source = _source;
+}
+
+//////////////////////////////////////////////////
+int64_t MemoryAccount::Bytes() const
+{
+  {
+    std::lock_guard<std::mutex> lock(this->sourceMutex);
+    if (this->source)
+    {
+      int64_t value = this->source();
+      this->UpdatePeak(value);
+      return value;
+    }
+  }
+
+  return this->bytes.load(std::memory_order_relaxed);
+}
+
+//////////////////////////////////////////////////
+int64_t MemoryAccount::Peak() const
+{
+  return this->peak.load(std::memory_order_relaxed);
+}
+
+//////////////////////////////////////////////////
+void MemoryAccount::UpdatePeak(const int64_t _bytes) const
+{
+  int64_t prev = this->peak.load(std::memory_order_relaxed);
+  while (prev < _bytes && !this->peak.compare_exchange_weak(prev, _bytes,
+      std::memory_order_relaxed))
+  {
+  }
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<MemoryAccount> MemoryAccount::Get(const std::string &_name)
+{
+  std::lock_guard<std::mutex> lock(g_accountsMutex);
+  auto &account = g_accounts[_name];
+  if (!account)
+    account = std::make_shared<MemoryAccount>(_name);
+  return account;
+}
+
+//////////////////////////////////////////////////
+std::vector<std::shared_ptr<MemoryAccount>> MemoryAccount::All()
+{
+  std::vector<std::shared_ptr<MemoryAccount>> all;
+  std::lock_guard<std::mutex> lock(g_accountsMutex);
+  all.reserve(g_accounts.size());
+  for (auto const &account : g_accounts)
+    all.push_back(account.second);
+  return all;
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_MEMORYACCOUNT_HH_
+#define GAZEBO_COMMON_MEMORYACCOUNT_HH_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \addtogroup gazebo_common
+    /// \{
+
+    /// \class MemoryAccount MemoryAccount.hh common/common.hh
+    /// \brief Bytes held by one subsystem, such as the loaded meshes or the
+    /// queues of the publishers.
+    ///
+    /// A subsystem either keeps the count up to date with Add and Set, or
+    /// installs a source that computes it when it is read. Accounts are
+    /// shared by name, see Get, and are an estimate of the payload of the
+    /// containers: allocator overhead is not included.
+    class GZ_COMMON_VISIBLE MemoryAccount
+    {
+      /// \brief Constructor.
+      /// \param[in] _name Name of the account.
+      public: explicit MemoryAccount(const std::string &_name);
+
+      /// \brief Get the name of the account.
+      /// \return The name.
+      public: const std::string &Name() const;
+
+      /// \brief Account for memory allocated or released.
+      /// \param[in] _bytes Bytes allocated, negative when released.
+      public: void Add(const int64_t _bytes);
+
+      /// \brief Set the number of bytes held.
+      /// \param[in] _bytes Bytes held.
+      public: void Set(const int64_t _bytes);
+
+      /// \brief Compute the bytes held with a function instead of a count.
+      /// The function is called by Bytes, from any thread.
+      /// \param[in] _source Function returning the bytes held, or null to
+      /// go back to the count.
+      public: void SetSource(const std::function<int64_t()> &_source);
+
+      /// \brief Get the number of bytes held.
+      /// \return Bytes held.
+      public: int64_t Bytes() const;
+
+      /// \brief Get the largest number of bytes held so far. Accounts
+      /// with a source only see the values read through Bytes.
+      /// \return Bytes.
+      public: int64_t Peak() const;
+
+      /// \brief Get an account, creating it if needed.
+      /// \param[in] _name Name of the account, by convention the subsystem
+      /// followed by what it holds, e.g. "common/meshes".
+      /// \return The account, shared by everything using that name.
+      public: static std::shared_ptr<MemoryAccount> Get(
+                  const std::string &_name);
+
+      /// \brief Get every account, sorted by name.
+      /// \return All the accounts.
+      public: static std::vector<std::shared_ptr<MemoryAccount>> All();
+
+      /// \brief Record a new value and update the peak.
+      /// \param[in] _bytes Bytes held.
+      private: void UpdatePeak(const int64_t _bytes) const;
+
+      /// \brief Name of the account.
+      private: std::string name;
+
+      /// \brief Bytes held, when there is no source.
+      private: std::atomic<int64_t> bytes{0};
+
+      /// \brief Largest value seen.
+      private: mutable std::atomic<int64_t> peak{0};
+
+      /// \brief Protects the source.
+      private: mutable std::mutex sourceMutex;
+
+      /// \brief Function computing the bytes held, may be empty.
+      private: std::function<int64_t()> source;
+    };
+
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "gazebo/common/MemoryAccount.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+using namespace common;
+
+class MemoryAccountTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(MemoryAccountTest, AddSet)
+{
+  MemoryAccount account("test/buffers");
+  EXPECT_EQ(account.Name(), "test/buffers");
+  EXPECT_EQ(account.Bytes(), 0);
+
+  account.Add(300);
+  account.Add(-100);
+  EXPECT_EQ(account.Bytes(), 200);
+  EXPECT_EQ(account.Peak(), 300);
+
+  account.Set(1000);
+  EXPECT_EQ(account.Bytes(), 1000);
+  EXPECT_EQ(account.Peak(), 1000);
+
+  account.Set(0);
+  EXPECT_EQ(account.Bytes(), 0);
+  EXPECT_EQ(account.Peak(), 1000);
+}
+
+/////////////////////////////////////////////////
+TEST_F(MemoryAccountTest, Source)
+{
+  MemoryAccount account("test/source");
+  account.Add(10);
+
+  int64_t held = 42;
+  account.SetSource([&held]() { return held; });
+  EXPECT_EQ(account.Bytes(), 42);
+  held = 64;
+  EXPECT_EQ(account.Bytes(), 64);
+  EXPECT_EQ(account.Peak(), 64);
+
+  // Without a source the count is used again
+  account.SetSource(nullptr);
+  EXPECT_EQ(account.Bytes(), 10);
+}
+
+/////////////////////////////////////////////////
+TEST_F(MemoryAccountTest, Registry)
+{
+  auto a = MemoryAccount::Get("test/b");
+  auto b = MemoryAccount::Get("test/a");
+  EXPECT_EQ(a, MemoryAccount::Get("test/b"));
+  EXPECT_NE(a, b);
+
+  auto all = MemoryAccount::All();
+  ASSERT_GE(all.size(), 2u);
+  for (size_t i = 1; i < all.size(); ++i)
+    EXPECT_LT(all[i-1]->Name(), all[i]->Name());
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
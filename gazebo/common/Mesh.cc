@@ -749,7 +749,6 @@ void SubMesh::FillArrays(float **_vertArr, int **_indArr) const
   if (this->vertices.empty() || this->indices.empty())
     gzerr << "No vertices or indices\n";
 
-  std::vector<ignition::math::Vector3d>::const_iterator viter;
   std::vector<unsigned int>::const_iterator iiter;
   unsigned int i;
 
@@ -762,13 +761,7 @@ void SubMesh::FillArrays(float **_vertArr, int **_indArr) const
   *_vertArr = new float[this->vertices.size() * 3];
   *_indArr = new int[this->indices.size()];
 
-  for (viter = this->vertices.begin(), i = 0; viter != this->vertices.end();
-      ++viter)
-  {
-    (*_vertArr)[i++] = static_cast<float>((*viter).X());
-    (*_vertArr)[i++] = static_cast<float>((*viter).Y());
-    (*_vertArr)[i++] = static_cast<float>((*viter).Z());
-  }
+  this->FillVertexBuffer(*_vertArr, false);
 
   for (iiter = this->indices.begin(), i = 0;
       iiter != this->indices.end(); ++iiter)
@@ -777,6 +770,60 @@ void SubMesh::FillArrays(float **_vertArr, int **_indArr) const
   }
 }
 
+//////////////////////////////////////////////////
+void SubMesh::FillVertexBuffer(float *_dst, const bool _withNormals,
+    const ignition::math::Vector3d &_offset) const
+{
+  for (size_t i = 0; i < this->vertices.size(); ++i)
+  {
+    const ignition::math::Vector3d &v = this->vertices[i];
+    *_dst++ = static_cast<float>(v.X() + _offset.X());
+    *_dst++ = static_cast<float>(v.Y() + _offset.Y());
+    *_dst++ = static_cast<float>(v.Z() + _offset.Z());
+
+    if (_withNormals)
+    {
+      const ignition::math::Vector3d n = i < this->normals.size() ?
+          this->normals[i] : ignition::math::Vector3d::Zero;
+      *_dst++ = static_cast<float>(n.X());
+      *_dst++ = static_cast<float>(n.Y());
+      *_dst++ = static_cast<float>(n.Z());
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void SubMesh::FillTexCoordBuffer(float *_dst) const
+{
+  for (size_t i = 0; i < this->vertices.size(); ++i)
+  {
+    const ignition::math::Vector2d t = i < this->texCoords.size() ?
+        this->texCoords[i] : ignition::math::Vector2d::Zero;
+    *_dst++ = static_cast<float>(t.X());
+    *_dst++ = static_cast<float>(t.Y());
+  }
+}
+
+//////////////////////////////////////////////////
+bool SubMesh::IndicesFit16Bit() const
+{
+  // 0xFFFF is kept free, it restarts strips on some render systems
+  return this->GetMaxIndex() < 0xFFFF;
+}
+
+//////////////////////////////////////////////////
+void SubMesh::FillIndexBuffer(uint16_t *_dst) const
+{
+  for (const auto index : this->indices)
+    *_dst++ = static_cast<uint16_t>(index);
+}
+
+//////////////////////////////////////////////////
+void SubMesh::FillIndexBuffer(uint32_t *_dst) const
+{
+  std::copy(this->indices.begin(), this->indices.end(), _dst);
+}
+
 //////////////////////////////////////////////////
 void SubMesh::RecalculateNormals()
 {
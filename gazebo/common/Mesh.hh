@@ -17,6 +17,7 @@
 #ifndef _GAZEBO_MESH_HH_
 #define _GAZEBO_MESH_HH_
 
+#include <cstdint>
 #include <vector>
 #include <string>
 
@@ -396,6 +397,37 @@ namespace gazebo
       /// \param[in] _indArr
       public: void FillArrays(float **_vertArr, int **_indArr) const;
 
+      /// \brief Write the vertices to a single precision buffer, such as a
+      /// locked hardware buffer or a trimesh vertex array, without going
+      /// through a temporary copy.
+      /// \param[out] _dst Buffer of GetVertexCount() * 3 floats, or
+      /// GetVertexCount() * 6 floats with normals.
+      /// \param[in] _withNormals True to follow each position with its
+      /// normal. Vertices without a normal get a zero normal.
+      /// \param[in] _offset Offset added to every position.
+      public: void FillVertexBuffer(float *_dst, const bool _withNormals,
+                  const ignition::math::Vector3d &_offset =
+                  ignition::math::Vector3d::Zero) const;
+
+      /// \brief Write one texture coordinate per vertex to a single
+      /// precision buffer. Vertices without a texture coordinate get (0, 0).
+      /// \param[out] _dst Buffer of GetVertexCount() * 2 floats.
+      public: void FillTexCoordBuffer(float *_dst) const;
+
+      /// \brief Check if every index fits in 16 bits.
+      /// \return True if the indices can be written with
+      /// FillIndexBuffer(uint16_t *).
+      public: bool IndicesFit16Bit() const;
+
+      /// \brief Write the indices to a 16 bit buffer. Only valid when
+      /// IndicesFit16Bit() is true.
+      /// \param[out] _dst Buffer of GetIndexCount() values.
+      public: void FillIndexBuffer(uint16_t *_dst) const;
+
+      /// \brief Write the indices to a 32 bit buffer.
+      /// \param[out] _dst Buffer of GetIndexCount() values.
+      public: void FillIndexBuffer(uint32_t *_dst) const;
+
       /// \brief Recalculate all the normals.
       public: void RecalculateNormals();
 
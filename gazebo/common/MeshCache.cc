@@ -0,0 +1,504 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/Material.hh"
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/common/MeshCache.hh"
+
+using namespace gazebo;
+using namespace common;
+
+/// \brief Identifies a mesh cache blob.
+static const char kMeshCacheMagic[8] = {'G', 'Z', 'M', 'E', 'S', 'H', 0, 0};
+
+/// \brief Version of the blob layout, bumped whenever it changes.
+static const uint32_t kMeshCacheVersion = 1;
+
+/// \brief Start of a blob, followed by the source path and the mesh path.
+class MeshCacheHeader
+{
+  /// \brief Always kMeshCacheMagic.
+  public: char magic[8];
+
+  /// \brief Always kMeshCacheVersion.
+  public: uint32_t version;
+
+  /// \brief Length of the source path.
+  public: uint32_t sourceSize;
+
+  /// \brief Modification time of the source file.
+  public: int64_t mtime;
+
+  /// \brief Size of the source file in bytes.
+  public: uint64_t size;
+
+  /// \brief Length of the mesh path.
+  public: uint32_t pathSize;
+
+  /// \brief Number of material records that follow.
+  public: uint32_t materialCount;
+
+  /// \brief Number of submesh records that follow the materials.
+  public: uint32_t subMeshCount;
+
+  /// \brief Padding.
+  public: uint32_t reserved;
+};
+
+/// \brief A material, followed by its texture path.
+class MeshCacheMaterial
+{
+  /// \brief Length of the texture path.
+  public: uint32_t textureSize;
+
+  /// \brief Material::BlendMode.
+  public: uint32_t blendMode;
+
+  /// \brief Material::ShadeMode.
+  public: uint32_t shadeMode;
+
+  /// \brief Bit 0 is depth write, bit 1 is lighting.
+  public: uint32_t flags;
+
+  /// \brief Ambient, diffuse, specular and emissive colors.
+  public: float colors[4][4];
+
+  /// \brief Transparency.
+  public: double transparency;
+
+  /// \brief Shininess.
+  public: double shininess;
+
+  /// \brief Source and destination blend factors.
+  public: double blendFactors[2];
+
+  /// \brief Point size.
+  public: double pointSize;
+};
+
+/// \brief A submesh, followed by its name, vertices, normals, texture
+/// coordinates and indices.
+class MeshCacheSubMesh
+{
+  /// \brief Length of the name.
+  public: uint32_t nameSize;
+
+  /// \brief SubMesh::PrimitiveType.
+  public: uint32_t primitiveType;
+
+  /// \brief Index of the material in the mesh.
+  public: uint32_t materialIndex;
+
+  /// \brief Number of vertices, as three doubles each.
+  public: uint32_t vertexCount;
+
+  /// \brief Number of normals, as three doubles each.
+  public: uint32_t normalCount;
+
+  /// \brief Number of texture coordinates, as two doubles each.
+  public: uint32_t texCoordCount;
+
+  /// \brief Number of indices.
+  public: uint32_t indexCount;
+
+  /// \brief Padding.
+  public: uint32_t reserved;
+};
+
+static_assert(sizeof(MeshCacheHeader) % 8 == 0, "Header must be aligned");
+static_assert(sizeof(MeshCacheMaterial) % 8 == 0,
+    "Material record must be aligned");
+static_assert(sizeof(MeshCacheSubMesh) % 8 == 0,
+    "Submesh record must be aligned");
+
+/////////////////////////////////////////////////
+/// \brief Append data to a blob, padded to 8 bytes.
+/// \param[in,out] _blob Blob to append to.
+/// \param[in] _data Data to append.
+/// \param[in] _size Size of the data in bytes.
+static void Append(std::string &_blob, const void *_data, const size_t _size)
+{
+  _blob.append(static_cast<const char *>(_data), _size);
+  _blob.append((8 - _size % 8) % 8, '\0');
+}
+
+/////////////////////////////////////////////////
+/// \brief Take data from a mapped blob, skipping the padding after it.
+/// \param[in,out] _cur Read position, moved past the data.
+/// \param[in] _end End of the blob.
+/// \param[in] _size Size of the data in bytes.
+/// \return Start of the data, null if the blob is too short.
+static const char *Take(const char *&_cur, const char *_end,
+    const uint64_t _size)
+{
+  const uint64_t padded = _size + (8 - _size % 8) % 8;
+  if (padded > static_cast<uint64_t>(_end - _cur))
+    return nullptr;
+
+  const char *result = _cur;
+  _cur += padded;
+  return result;
+}
+
+/////////////////////////////////////////////////
+MeshCache::MeshCache(const std::string &_dir)
+  : dir(_dir)
+{
+}
+
+/////////////////////////////////////////////////
+std::string MeshCache::Directory()
+{
+  const char *env = std::getenv("GAZEBO_MESH_CACHE");
+  if (!env || std::string(env).empty() || std::string(env) == "0")
+    return "";
+
+  if (std::string(env) != "1")
+    return env;
+
+  const char *home = std::getenv("HOME");
+  if (!home)
+    return "";
+
+  return std::string(home) + "/.gazebo/mesh_cache";
+}
+
+/////////////////////////////////////////////////
+std::string MeshCache::BlobPath(const std::string &_filename,
+    int64_t &_mtime, uint64_t &_size) const
+{
+  // Generated meshes are named after a hash of what they're made of and
+  // have no file, they're stored with a zero time and size
+  _mtime = 0;
+  _size = 0;
+  boost::system::error_code ec;
+  if (boost::filesystem::exists(_filename, ec))
+  {
+    _mtime = boost::filesystem::last_write_time(_filename, ec);
+    if (ec)
+      return "";
+    _size = boost::filesystem::file_size(_filename, ec);
+    if (ec)
+      return "";
+  }
+
+  // FNV-1a
+  uint64_t hash = 14695981039346656037ULL;
+  auto mix = [&hash](const void *_data, const size_t _len)
+  {
+    for (size_t i = 0; i < _len; ++i)
+    {
+      hash ^= static_cast<const unsigned char *>(_data)[i];
+      hash *= 1099511628211ULL;
+    }
+  };
+  mix(_filename.data(), _filename.size());
+  mix(&_mtime, sizeof(_mtime));
+  mix(&_size, sizeof(_size));
+
+  std::ostringstream stream;
+  stream << this->dir << "/" << std::hex << hash << ".gzmesh";
+  return stream.str();
+}
+
+/////////////////////////////////////////////////
+Mesh *MeshCache::Load(const std::string &_filename) const
+{
+  int64_t mtime = 0;
+  uint64_t size = 0;
+  const std::string blobPath = this->BlobPath(_filename, mtime, size);
+  if (blobPath.empty() || !boost::filesystem::exists(blobPath))
+    return nullptr;
+
+  boost::iostreams::mapped_file_source file;
+  try
+  {
+    file.open(blobPath);
+  }
+  catch(const std::exception &_e)
+  {
+    gzwarn << "Unable to open mesh cache file[" << blobPath << "]: "
+           << _e.what() << "\n";
+    return nullptr;
+  }
+
+  const char *cur = file.data();
+  const char *end = file.data() + file.size();
+
+  auto header = reinterpret_cast<const MeshCacheHeader *>(
+      Take(cur, end, sizeof(MeshCacheHeader)));
+
+  // A hash collision or a file changed within the same second with the
+  // same size shows up here.
+  if (!header ||
+      std::memcmp(header->magic, kMeshCacheMagic, sizeof(kMeshCacheMagic)) ||
+      header->version != kMeshCacheVersion || header->mtime != mtime ||
+      header->size != size || header->sourceSize != _filename.size())
+  {
+    return nullptr;
+  }
+
+  const char *source = Take(cur, end, header->sourceSize);
+  if (!source || _filename.compare(0, std::string::npos, source,
+        header->sourceSize) != 0)
+  {
+    return nullptr;
+  }
+
+  const char *path = Take(cur, end, header->pathSize);
+  if (!path)
+    return nullptr;
+
+  std::unique_ptr<Mesh> mesh(new Mesh());
+  mesh->SetPath(std::string(path, header->pathSize));
+
+  for (uint32_t i = 0; i < header->materialCount; ++i)
+  {
+    auto record = reinterpret_cast<const MeshCacheMaterial *>(
+        Take(cur, end, sizeof(MeshCacheMaterial)));
+    const char *texture = record ?
+        Take(cur, end, record->textureSize) : nullptr;
+    if (!texture)
+      return nullptr;
+
+    Material *mat = new Material();
+    mat->SetTextureImage(std::string(texture, record->textureSize));
+    mat->SetBlendMode(static_cast<Material::BlendMode>(record->blendMode));
+    mat->SetShadeMode(static_cast<Material::ShadeMode>(record->shadeMode));
+    mat->SetDepthWrite((record->flags & 1u) != 0);
+    mat->SetLighting((record->flags & 2u) != 0);
+
+    const float (&c)[4][4] = record->colors;
+    mat->SetAmbient(ignition::math::Color(c[0][0], c[0][1], c[0][2], c[0][3]));
+    mat->SetDiffuse(ignition::math::Color(c[1][0], c[1][1], c[1][2], c[1][3]));
+    mat->SetSpecular(
+        ignition::math::Color(c[2][0], c[2][1], c[2][2], c[2][3]));
+    mat->SetEmissive(
+        ignition::math::Color(c[3][0], c[3][1], c[3][2], c[3][3]));
+
+    mat->SetTransparency(record->transparency);
+    mat->SetShininess(record->shininess);
+    mat->SetBlendFactors(record->blendFactors[0], record->blendFactors[1]);
+    mat->SetPointSize(record->pointSize);
+    mesh->AddMaterial(mat);
+  }
+
+  for (uint32_t i = 0; i < header->subMeshCount; ++i)
+  {
+    auto record = reinterpret_cast<const MeshCacheSubMesh *>(
+        Take(cur, end, sizeof(MeshCacheSubMesh)));
+    if (!record)
+      return nullptr;
+
+    const char *name = Take(cur, end, record->nameSize);
+    auto vertices = reinterpret_cast<const double *>(
+        Take(cur, end, uint64_t(record->vertexCount) * 3 * sizeof(double)));
+    auto normals = reinterpret_cast<const double *>(
+        Take(cur, end, uint64_t(record->normalCount) * 3 * sizeof(double)));
+    auto texCoords = reinterpret_cast<const double *>(
+        Take(cur, end, uint64_t(record->texCoordCount) * 2 * sizeof(double)));
+    auto indices = reinterpret_cast<const uint32_t *>(
+        Take(cur, end, uint64_t(record->indexCount) * sizeof(uint32_t)));
+    if (!name || !vertices || !normals || !texCoords || !indices)
+      return nullptr;
+
+    SubMesh *subMesh = new SubMesh();
+    mesh->AddSubMesh(subMesh);
+    subMesh->SetName(std::string(name, record->nameSize));
+    subMesh->SetPrimitiveType(
+        static_cast<SubMesh::PrimitiveType>(record->primitiveType));
+    subMesh->SetMaterialIndex(record->materialIndex);
+
+    subMesh->SetVertexCount(record->vertexCount);
+    for (uint32_t v = 0; v < record->vertexCount; ++v)
+    {
+      subMesh->SetVertex(v, ignition::math::Vector3d(
+          vertices[v * 3], vertices[v * 3 + 1], vertices[v * 3 + 2]));
+    }
+
+    subMesh->SetNormalCount(record->normalCount);
+    for (uint32_t n = 0; n < record->normalCount; ++n)
+    {
+      subMesh->SetNormal(n, ignition::math::Vector3d(
+          normals[n * 3], normals[n * 3 + 1], normals[n * 3 + 2]));
+    }
+
+    subMesh->SetTexCoordCount(record->texCoordCount);
+    for (uint32_t t = 0; t < record->texCoordCount; ++t)
+    {
+      subMesh->SetTexCoord(t, ignition::math::Vector2d(
+          texCoords[t * 2], texCoords[t * 2 + 1]));
+    }
+
+    for (uint32_t n = 0; n < record->indexCount; ++n)
+      subMesh->AddIndex(indices[n]);
+  }
+
+  return mesh.release();
+}
+
+/////////////////////////////////////////////////
+bool MeshCache::Save(const std::string &_filename, const Mesh *_mesh) const
+{
+  // Skeletons and their animations are left to the loaders
+  if (!_mesh || _mesh->HasSkeleton())
+    return false;
+
+  MeshCacheHeader header;
+  std::memset(&header, 0, sizeof(header));
+  const std::string blobPath =
+      this->BlobPath(_filename, header.mtime, header.size);
+  if (blobPath.empty())
+    return false;
+
+  const std::string path = _mesh->GetPath();
+  std::memcpy(header.magic, kMeshCacheMagic, sizeof(kMeshCacheMagic));
+  header.version = kMeshCacheVersion;
+  header.sourceSize = _filename.size();
+  header.pathSize = path.size();
+  header.materialCount = _mesh->GetMaterialCount();
+  header.subMeshCount = _mesh->GetSubMeshCount();
+
+  std::string blob;
+  Append(blob, &header, sizeof(header));
+  Append(blob, _filename.data(), _filename.size());
+  Append(blob, path.data(), path.size());
+
+  for (unsigned int i = 0; i < _mesh->GetMaterialCount(); ++i)
+  {
+    const Material *mat = _mesh->GetMaterial(i);
+    const std::string texture = mat->GetTextureImage();
+
+    MeshCacheMaterial record;
+    std::memset(&record, 0, sizeof(record));
+    record.textureSize = texture.size();
+    record.blendMode = mat->GetBlendMode();
+    record.shadeMode = mat->GetShadeMode();
+    record.flags = (mat->GetDepthWrite() ? 1u : 0u) |
+                   (mat->GetLighting() ? 2u : 0u);
+
+    const ignition::math::Color colors[4] = {mat->Ambient(), mat->Diffuse(),
+        mat->Specular(), mat->Emissive()};
+    for (int c = 0; c < 4; ++c)
+    {
+      record.colors[c][0] = colors[c].R();
+      record.colors[c][1] = colors[c].G();
+      record.colors[c][2] = colors[c].B();
+      record.colors[c][3] = colors[c].A();
+    }
+
+    record.transparency = mat->GetTransparency();
+    record.shininess = mat->GetShininess();
+    mat->GetBlendFactors(record.blendFactors[0], record.blendFactors[1]);
+    record.pointSize = mat->GetPointSize();
+
+    Append(blob, &record, sizeof(record));
+    Append(blob, texture.data(), texture.size());
+  }
+
+  std::vector<double> values;
+  std::vector<uint32_t> indices;
+  for (unsigned int i = 0; i < _mesh->GetSubMeshCount(); ++i)
+  {
+    const SubMesh *subMesh = _mesh->GetSubMesh(i);
+    const std::string name = subMesh->GetName();
+
+    MeshCacheSubMesh record;
+    std::memset(&record, 0, sizeof(record));
+    record.nameSize = name.size();
+    record.primitiveType = subMesh->GetPrimitiveType();
+    record.materialIndex = subMesh->GetMaterialIndex();
+    record.vertexCount = subMesh->GetVertexCount();
+    record.normalCount = subMesh->GetNormalCount();
+    record.texCoordCount = subMesh->GetTexCoordCount();
+    record.indexCount = subMesh->GetIndexCount();
+
+    Append(blob, &record, sizeof(record));
+    Append(blob, name.data(), name.size());
+
+    values.clear();
+    for (unsigned int v = 0; v < record.vertexCount; ++v)
+    {
+      const ignition::math::Vector3d vertex = subMesh->Vertex(v);
+      values.insert(values.end(), {vertex.X(), vertex.Y(), vertex.Z()});
+    }
+    Append(blob, values.data(), values.size() * sizeof(double));
+
+    values.clear();
+    for (unsigned int n = 0; n < record.normalCount; ++n)
+    {
+      const ignition::math::Vector3d normal = subMesh->Normal(n);
+      values.insert(values.end(), {normal.X(), normal.Y(), normal.Z()});
+    }
+    Append(blob, values.data(), values.size() * sizeof(double));
+
+    values.clear();
+    for (unsigned int t = 0; t < record.texCoordCount; ++t)
+    {
+      const ignition::math::Vector2d texCoord = subMesh->TexCoord(t);
+      values.insert(values.end(), {texCoord.X(), texCoord.Y()});
+    }
+    Append(blob, values.data(), values.size() * sizeof(double));
+
+    indices.resize(record.indexCount);
+    for (unsigned int n = 0; n < record.indexCount; ++n)
+      indices[n] = subMesh->GetIndex(n);
+    Append(blob, indices.data(), indices.size() * sizeof(uint32_t));
+  }
+
+  // Write next to the blob and rename, so that readers in other processes
+  // never see a partial file.
+  boost::system::error_code ec;
+  boost::filesystem::create_directories(this->dir, ec);
+  const boost::filesystem::path tmpPath = blobPath + "." +
+      boost::filesystem::unique_path("%%%%%%").string();
+  {
+    std::ofstream out(tmpPath.string(), std::ios::binary);
+    out.write(blob.data(), blob.size());
+    if (!out)
+    {
+      gzwarn << "Unable to write mesh cache file[" << tmpPath << "]\n";
+      out.close();
+      boost::filesystem::remove(tmpPath, ec);
+      return false;
+    }
+  }
+
+  boost::filesystem::rename(tmpPath, blobPath, ec);
+  if (ec)
+  {
+    gzwarn << "Unable to write mesh cache file[" << blobPath << "]: "
+           << ec.message() << "\n";
+    boost::filesystem::remove(tmpPath, ec);
+    return false;
+  }
+
+  return true;
+}
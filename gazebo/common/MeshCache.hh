@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef _GAZEBO_COMMON_MESHCACHE_HH_
+#define _GAZEBO_COMMON_MESHCACHE_HH_
+
+#include <cstdint>
+#include <string>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    class Mesh;
+
+    /// \internal
+    /// \brief On-disk cache of parsed meshes.
+    ///
+    /// Each mesh file is stored in a binary blob named after a hash of its
+    /// path, modification time and size, so an edited file misses the
+    /// cache. Every record in a blob is 8 byte aligned and the blob is
+    /// memory mapped when read, so loading is a handful of bulk copies
+    /// instead of parsing. Blobs are written to a temporary file and
+    /// renamed into place, which lets several processes, such as gzserver
+    /// and gzclient, share a directory. Meshes with a skeleton are not
+    /// cached. Generated meshes, such as extruded polylines, are cached
+    /// under a name which hashes their definition instead of a path.
+    class GZ_COMMON_VISIBLE MeshCache
+    {
+      /// \brief Constructor.
+      /// \param[in] _dir Directory holding the blobs. Created on the first
+      /// save if needed.
+      public: explicit MeshCache(const std::string &_dir);
+
+      /// \brief Get the cache directory from the GAZEBO_MESH_CACHE
+      /// environment variable. A value of 1 selects ~/.gazebo/mesh_cache,
+      /// any other value except 0 is used as the directory.
+      /// \return Cache directory, empty if the cache is disabled.
+      public: static std::string Directory();
+
+      /// \brief Load a mesh from the cache.
+      /// \param[in] _filename Full path of the mesh file, or name of a
+      /// generated mesh.
+      /// \return New mesh owned by the caller, null if the file is not
+      /// cached or changed since it was.
+      public: Mesh *Load(const std::string &_filename) const;
+
+      /// \brief Store a mesh in the cache.
+      /// \param[in] _filename Full path of the file the mesh was loaded
+      /// from.
+      /// \param[in] _mesh Mesh to store.
+      /// \return False if the mesh can not be cached or writing failed.
+      public: bool Save(const std::string &_filename,
+                        const Mesh *_mesh) const;
+
+      /// \brief Get the blob path of a mesh file.
+      /// \param[in] _filename Full path of the mesh file.
+      /// \param[out] _mtime Modification time of the file.
+      /// \param[out] _size Size of the file in bytes.
+      /// \return Blob path, empty if the file can not be read.
+      private: std::string BlobPath(const std::string &_filename,
+                                    int64_t &_mtime, uint64_t &_size) const;
+
+      /// \brief Directory holding the blobs.
+      private: std::string dir;
+    };
+  }
+}
+#endif
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+
+#include <boost/filesystem.hpp>
+
+#include "test_config.h"
+#include "gazebo/common/ColladaLoader.hh"
+#include "gazebo/common/Material.hh"
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/common/MeshCache.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class MeshCacheTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(MeshCacheTest, SaveAndLoad)
+{
+  const boost::filesystem::path dir =
+      boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path("gazebo-mesh-cache-%%%%%%");
+  const std::string filename =
+      std::string(PROJECT_SOURCE_PATH) + "/test/data/box.dae";
+
+  common::MeshCache cache(dir.string());
+  EXPECT_TRUE(cache.Load(filename) == nullptr);
+
+  common::ColladaLoader loader;
+  std::unique_ptr<common::Mesh> mesh(loader.Load(filename));
+  ASSERT_TRUE(mesh != nullptr);
+  EXPECT_TRUE(cache.Save(filename, mesh.get()));
+
+  std::unique_ptr<common::Mesh> cached(cache.Load(filename));
+  ASSERT_TRUE(cached != nullptr);
+  EXPECT_EQ(cached->GetPath(), mesh->GetPath());
+  EXPECT_EQ(cached->Min(), mesh->Min());
+  EXPECT_EQ(cached->Max(), mesh->Max());
+  ASSERT_EQ(cached->GetMaterialCount(), mesh->GetMaterialCount());
+  for (unsigned int i = 0; i < mesh->GetMaterialCount(); ++i)
+  {
+    EXPECT_EQ(cached->GetMaterial(i)->Diffuse(),
+              mesh->GetMaterial(i)->Diffuse());
+    EXPECT_EQ(cached->GetMaterial(i)->GetTextureImage(),
+              mesh->GetMaterial(i)->GetTextureImage());
+  }
+
+  ASSERT_EQ(cached->GetSubMeshCount(), mesh->GetSubMeshCount());
+  for (unsigned int i = 0; i < mesh->GetSubMeshCount(); ++i)
+  {
+    const common::SubMesh *a = mesh->GetSubMesh(i);
+    const common::SubMesh *b = cached->GetSubMesh(i);
+    EXPECT_EQ(b->GetName(), a->GetName());
+    EXPECT_EQ(b->GetPrimitiveType(), a->GetPrimitiveType());
+    EXPECT_EQ(b->GetMaterialIndex(), a->GetMaterialIndex());
+    ASSERT_EQ(b->GetVertexCount(), a->GetVertexCount());
+    ASSERT_EQ(b->GetNormalCount(), a->GetNormalCount());
+    ASSERT_EQ(b->GetTexCoordCount(), a->GetTexCoordCount());
+    ASSERT_EQ(b->GetIndexCount(), a->GetIndexCount());
+    for (unsigned int v = 0; v < a->GetVertexCount(); ++v)
+      EXPECT_EQ(b->Vertex(v), a->Vertex(v));
+    for (unsigned int n = 0; n < a->GetNormalCount(); ++n)
+      EXPECT_EQ(b->Normal(n), a->Normal(n));
+    for (unsigned int t = 0; t < a->GetTexCoordCount(); ++t)
+      EXPECT_EQ(b->TexCoord(t), a->TexCoord(t));
+    for (unsigned int n = 0; n < a->GetIndexCount(); ++n)
+      EXPECT_EQ(b->GetIndex(n), a->GetIndex(n));
+  }
+
+  // A blob for another file is never returned
+  const std::string other =
+      std::string(PROJECT_SOURCE_PATH) + "/test/data/zero_count.dae";
+  EXPECT_TRUE(cache.Load(other) == nullptr);
+
+  boost::filesystem::remove_all(dir);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
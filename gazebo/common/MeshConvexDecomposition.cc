@@ -0,0 +1,536 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/common/MeshConvexDecomposition.hh"
+
+using namespace gazebo;
+using namespace common;
+
+namespace
+{
+  /// \brief Triangle of a hull under construction.
+  struct HullFace
+  {
+    /// \brief Vertex indices, counter clockwise seen from outside.
+    unsigned int v[3];
+
+    /// \brief Outward unit normal.
+    ignition::math::Vector3d normal;
+
+    /// \brief Dot product of the normal and the face vertices.
+    double offset;
+
+    /// \brief False once a new point made the face part of the inside.
+    bool alive;
+  };
+
+  /// \brief Part of the mesh being decomposed.
+  struct Part
+  {
+    /// \brief Vertices of the part.
+    std::vector<ignition::math::Vector3d> vertices;
+
+    /// \brief Three vertex indices per triangle.
+    std::vector<unsigned int> indices;
+
+    /// \brief Vertices of the hull of the part.
+    std::vector<ignition::math::Vector3d> hullVertices;
+
+    /// \brief Triangles of the hull of the part.
+    std::vector<unsigned int> hullIndices;
+
+    /// \brief Deepest point of the part below its hull.
+    double concavity = 0;
+
+    /// \brief Volume of the hull.
+    double volume = 0;
+
+    /// \brief True if no plane splits the part.
+    bool final = false;
+  };
+
+  /// \brief Make a hull face.
+  /// \param[in] _points Points of the hull.
+  /// \param[in] _a First vertex.
+  /// \param[in] _b Second vertex.
+  /// \param[in] _c Third vertex.
+  /// \return The face.
+  HullFace MakeFace(const std::vector<ignition::math::Vector3d> &_points,
+      const unsigned int _a, const unsigned int _b, const unsigned int _c)
+  {
+    HullFace face;
+    face.v[0] = _a;
+    face.v[1] = _b;
+    face.v[2] = _c;
+    face.normal = (_points[_b] - _points[_a]).Cross(_points[_c] - _points[_a]);
+    const double length = face.normal.Length();
+    if (length > 0)
+      face.normal /= length;
+    face.offset = face.normal.Dot(_points[_a]);
+    face.alive = true;
+    return face;
+  }
+
+  /// \brief Compute the hull of a part, its volume and how deep the part
+  /// sinks below it.
+  /// \param[in] _thickness Thickness given to flat parts.
+  /// \param[in,out] _part Part whose triangles are set.
+  /// \return False if the triangles of the part have no area.
+  bool BuildPart(const double _thickness, Part &_part)
+  {
+    if (!MeshConvexDecomposition::ConvexHull(_part.vertices,
+          _part.hullVertices, _part.hullIndices))
+    {
+      // A flat part is given a thin slab around its plane
+      ignition::math::Vector3d normal;
+      for (size_t t = 0; t + 2 < _part.indices.size(); t += 3)
+      {
+        const auto &a = _part.vertices[_part.indices[t]];
+        normal = (_part.vertices[_part.indices[t + 1]] - a).Cross(
+            _part.vertices[_part.indices[t + 2]] - a);
+        if (normal.Length() > 0)
+          break;
+      }
+      if (!(normal.Length() > 0))
+        return false;
+
+      normal = normal.Normalize() * (0.5 * _thickness);
+      std::vector<ignition::math::Vector3d> points;
+      points.reserve(_part.vertices.size() * 2);
+      for (const auto &v : _part.vertices)
+      {
+        points.push_back(v + normal);
+        points.push_back(v - normal);
+      }
+      if (!MeshConvexDecomposition::ConvexHull(points, _part.hullVertices,
+            _part.hullIndices))
+      {
+        return false;
+      }
+    }
+
+    std::vector<std::pair<ignition::math::Vector3d, double>> planes;
+    _part.volume = 0;
+    for (size_t i = 0; i + 2 < _part.hullIndices.size(); i += 3)
+    {
+      const auto &a = _part.hullVertices[_part.hullIndices[i]];
+      const auto &b = _part.hullVertices[_part.hullIndices[i + 1]];
+      const auto &c = _part.hullVertices[_part.hullIndices[i + 2]];
+      _part.volume += a.Dot(b.Cross(c)) / 6.0;
+
+      auto normal = (b - a).Cross(c - a);
+      const double length = normal.Length();
+      if (length <= 0)
+        continue;
+      normal /= length;
+      planes.emplace_back(normal, normal.Dot(a));
+    }
+
+    // Depth of a point inside the hull is its distance to the nearest face
+    auto depth = [&planes](const ignition::math::Vector3d &_p)
+    {
+      double result = std::numeric_limits<double>::max();
+      for (const auto &plane : planes)
+        result = std::min(result, plane.second - plane.first.Dot(_p));
+      return std::max(0.0, result);
+    };
+
+    // Triangle centers catch concave folds whose corners are all on the
+    // hull
+    _part.concavity = 0;
+    for (const auto &v : _part.vertices)
+      _part.concavity = std::max(_part.concavity, depth(v));
+    for (size_t t = 0; t + 2 < _part.indices.size(); t += 3)
+    {
+      const ignition::math::Vector3d center =
+          (_part.vertices[_part.indices[t]] +
+           _part.vertices[_part.indices[t + 1]] +
+           _part.vertices[_part.indices[t + 2]]) / 3.0;
+      _part.concavity = std::max(_part.concavity, depth(center));
+    }
+
+    return true;
+  }
+
+  /// \brief Cut a part in two along an axis aligned plane. Triangles
+  /// crossing the plane are clipped, so the hull of each side stops at the
+  /// plane.
+  /// \param[in] _part Part to cut.
+  /// \param[in] _axis Axis normal to the plane.
+  /// \param[in] _value Position of the plane along the axis.
+  /// \param[out] _sides Triangles below and above the plane.
+  void Cut(const Part &_part, const int _axis, const double _value,
+      Part (&_sides)[2])
+  {
+    std::vector<unsigned int> remap[2];
+    for (int side = 0; side < 2; ++side)
+    {
+      remap[side].assign(_part.vertices.size(),
+          std::numeric_limits<unsigned int>::max());
+    }
+
+    auto addVertex = [&](const int _side, const unsigned int _v)
+    {
+      if (remap[_side][_v] == std::numeric_limits<unsigned int>::max())
+      {
+        remap[_side][_v] = _sides[_side].vertices.size();
+        _sides[_side].vertices.push_back(_part.vertices[_v]);
+      }
+      return remap[_side][_v];
+    };
+
+    for (size_t t = 0; t + 2 < _part.indices.size(); t += 3)
+    {
+      const unsigned int *tri = &_part.indices[t];
+      double d[3];
+      bool below = false;
+      bool above = false;
+      for (int k = 0; k < 3; ++k)
+      {
+        d[k] = _part.vertices[tri[k]][_axis] - _value;
+        below = below || d[k] < 0;
+        above = above || d[k] > 0;
+      }
+
+      if (!above || !below)
+      {
+        const int side = above ? 1 : 0;
+        for (int k = 0; k < 3; ++k)
+          _sides[side].indices.push_back(addVertex(side, tri[k]));
+        continue;
+      }
+
+      // Clip the triangle against each side and fan the polygon
+      for (int side = 0; side < 2; ++side)
+      {
+        const double sign = side == 0 ? -1.0 : 1.0;
+        unsigned int polygon[4];
+        int count = 0;
+        for (int k = 0; k < 3; ++k)
+        {
+          const int next = (k + 1) % 3;
+          if (sign * d[k] >= 0)
+            polygon[count++] = addVertex(side, tri[k]);
+          if ((d[k] < 0 && d[next] > 0) || (d[k] > 0 && d[next] < 0))
+          {
+            const auto &a = _part.vertices[tri[k]];
+            const auto &b = _part.vertices[tri[next]];
+            polygon[count++] = _sides[side].vertices.size();
+            _sides[side].vertices.push_back(
+                a + (b - a) * (d[k] / (d[k] - d[next])));
+          }
+        }
+        for (int k = 1; k + 1 < count; ++k)
+        {
+          _sides[side].indices.push_back(polygon[0]);
+          _sides[side].indices.push_back(polygon[k]);
+          _sides[side].indices.push_back(polygon[k + 1]);
+        }
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+bool MeshConvexDecomposition::ConvexHull(
+    const std::vector<ignition::math::Vector3d> &_points,
+    std::vector<ignition::math::Vector3d> &_vertices,
+    std::vector<unsigned int> &_indices)
+{
+  _vertices.clear();
+  _indices.clear();
+  if (_points.size() < 4)
+    return false;
+
+  ignition::math::Vector3d min = _points[0];
+  ignition::math::Vector3d max = _points[0];
+  unsigned int i0 = 0;
+  for (unsigned int i = 1; i < _points.size(); ++i)
+  {
+    min.Min(_points[i]);
+    max.Max(_points[i]);
+    if (_points[i].X() < _points[i0].X())
+      i0 = i;
+  }
+  const double eps = 1e-9 * (max - min).Length();
+  if (!(eps > 0))
+    return false;
+
+  // Start from a large tetrahedron
+  unsigned int i1 = i0;
+  double best = 0;
+  for (unsigned int i = 0; i < _points.size(); ++i)
+  {
+    const double d = (_points[i] - _points[i0]).SquaredLength();
+    if (d > best)
+    {
+      best = d;
+      i1 = i;
+    }
+  }
+  if (std::sqrt(best) <= eps)
+    return false;
+
+  const ignition::math::Vector3d dir =
+      (_points[i1] - _points[i0]).Normalize();
+  unsigned int i2 = i0;
+  best = 0;
+  for (unsigned int i = 0; i < _points.size(); ++i)
+  {
+    const double d = (_points[i] - _points[i0]).Cross(dir).Length();
+    if (d > best)
+    {
+      best = d;
+      i2 = i;
+    }
+  }
+  if (best <= eps)
+    return false;
+
+  const ignition::math::Vector3d normal =
+      (_points[i1] - _points[i0]).Cross(_points[i2] - _points[i0]).Normalize();
+  unsigned int i3 = i0;
+  best = 0;
+  for (unsigned int i = 0; i < _points.size(); ++i)
+  {
+    const double d = std::abs(normal.Dot(_points[i] - _points[i0]));
+    if (d > best)
+    {
+      best = d;
+      i3 = i;
+    }
+  }
+  if (best <= eps)
+    return false;
+
+  const ignition::math::Vector3d center =
+      (_points[i0] + _points[i1] + _points[i2] + _points[i3]) / 4.0;
+  std::vector<HullFace> faces;
+  const unsigned int tetrahedron[4][3] =
+      {{i0, i1, i2}, {i0, i1, i3}, {i0, i2, i3}, {i1, i2, i3}};
+  for (const auto &t : tetrahedron)
+  {
+    HullFace face = MakeFace(_points, t[0], t[1], t[2]);
+    if (face.normal.Dot(center) > face.offset)
+      face = MakeFace(_points, t[0], t[2], t[1]);
+    faces.push_back(face);
+  }
+
+  // Add the points one by one. The faces a point sees are replaced by a
+  // fan from the point to the horizon, the edges between seen and unseen
+  // faces.
+  std::vector<size_t> visible;
+  std::unordered_set<uint64_t> edges;
+  auto edgeKey = [](const unsigned int _a, const unsigned int _b)
+  {
+    return (static_cast<uint64_t>(_a) << 32) | _b;
+  };
+  size_t dead = 0;
+  for (unsigned int p = 0; p < _points.size(); ++p)
+  {
+    visible.clear();
+    for (size_t f = 0; f < faces.size(); ++f)
+    {
+      if (faces[f].alive &&
+          faces[f].normal.Dot(_points[p]) - faces[f].offset > eps)
+      {
+        visible.push_back(f);
+      }
+    }
+    if (visible.empty())
+      continue;
+
+    edges.clear();
+    for (auto f : visible)
+    {
+      for (int k = 0; k < 3; ++k)
+        edges.insert(edgeKey(faces[f].v[k], faces[f].v[(k + 1) % 3]));
+    }
+
+    for (auto f : visible)
+    {
+      faces[f].alive = false;
+      ++dead;
+      for (int k = 0; k < 3; ++k)
+      {
+        const unsigned int a = faces[f].v[k];
+        const unsigned int b = faces[f].v[(k + 1) % 3];
+        if (!edges.count(edgeKey(b, a)))
+          faces.push_back(MakeFace(_points, a, b, p));
+      }
+    }
+
+    if (dead > faces.size() / 2)
+    {
+      faces.erase(std::remove_if(faces.begin(), faces.end(),
+            [](const HullFace &_f) {return !_f.alive;}), faces.end());
+      dead = 0;
+    }
+  }
+
+  // Keep only the points on the hull
+  std::vector<unsigned int> remap(_points.size(),
+      std::numeric_limits<unsigned int>::max());
+  for (const auto &face : faces)
+  {
+    if (!face.alive)
+      continue;
+
+    for (int k = 0; k < 3; ++k)
+    {
+      if (remap[face.v[k]] == std::numeric_limits<unsigned int>::max())
+      {
+        remap[face.v[k]] = _vertices.size();
+        _vertices.push_back(_points[face.v[k]]);
+      }
+      _indices.push_back(remap[face.v[k]]);
+    }
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+Mesh *MeshConvexDecomposition::Decompose(
+    const std::vector<ignition::math::Vector3d> &_vertices,
+    const std::vector<unsigned int> &_indices,
+    const unsigned int _maxHulls, const double _maxConcavity)
+{
+  Part whole;
+  whole.vertices = _vertices;
+  for (size_t t = 0; t + 2 < _indices.size(); t += 3)
+  {
+    if (_indices[t] < _vertices.size() &&
+        _indices[t + 1] < _vertices.size() &&
+        _indices[t + 2] < _vertices.size())
+    {
+      whole.indices.insert(whole.indices.end(), &_indices[t],
+          &_indices[t] + 3);
+    }
+  }
+  if (whole.indices.empty())
+    return nullptr;
+
+  ignition::math::Vector3d min = _vertices[whole.indices[0]];
+  ignition::math::Vector3d max = min;
+  for (auto index : whole.indices)
+  {
+    min.Min(_vertices[index]);
+    max.Max(_vertices[index]);
+  }
+
+  const double diagonal = (max - min).Length();
+  const double thickness = 1e-3 * diagonal;
+  if (!BuildPart(thickness, whole))
+    return nullptr;
+
+  const double threshold = _maxConcavity * diagonal;
+  std::vector<Part> parts;
+  parts.push_back(std::move(whole));
+  while (parts.size() < std::max(1u, _maxHulls))
+  {
+    // Split the most concave part
+    size_t worst = parts.size();
+    for (size_t i = 0; i < parts.size(); ++i)
+    {
+      if (!parts[i].final && parts[i].concavity > threshold &&
+          (worst == parts.size() ||
+           parts[i].concavity > parts[worst].concavity))
+      {
+        worst = i;
+      }
+    }
+    if (worst == parts.size())
+      break;
+
+    const Part &part = parts[worst];
+    ignition::math::Vector3d partMin = part.vertices[part.indices[0]];
+    ignition::math::Vector3d partMax = partMin;
+    for (auto index : part.indices)
+    {
+      partMin.Min(part.vertices[index]);
+      partMax.Max(part.vertices[index]);
+    }
+
+    // Try planes across each axis and keep the cut whose hulls waste the
+    // least volume
+    std::vector<Part> best;
+    double bestVolume = std::numeric_limits<double>::max();
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      for (const double fraction : {0.25, 0.5, 0.75})
+      {
+        const double value = partMin[axis] +
+            fraction * (partMax[axis] - partMin[axis]);
+        Part sides[2];
+        Cut(part, axis, value, sides);
+        if (sides[0].indices.empty() || sides[1].indices.empty())
+          continue;
+
+        // Triangles without area need no hull
+        std::vector<Part> children;
+        double volume = 0;
+        for (auto &side : sides)
+        {
+          if (BuildPart(thickness, side))
+          {
+            volume += side.volume;
+            children.push_back(std::move(side));
+          }
+        }
+        if (!children.empty() && volume < bestVolume)
+        {
+          bestVolume = volume;
+          best = std::move(children);
+        }
+      }
+    }
+
+    if (best.empty())
+    {
+      parts[worst].final = true;
+      continue;
+    }
+
+    parts[worst] = std::move(best[0]);
+    for (size_t i = 1; i < best.size(); ++i)
+      parts.push_back(std::move(best[i]));
+  }
+
+  Mesh *mesh = new Mesh();
+  for (size_t i = 0; i < parts.size(); ++i)
+  {
+    SubMesh *subMesh = new SubMesh();
+    subMesh->SetName("hull_" + std::to_string(i));
+    for (const auto &v : parts[i].hullVertices)
+      subMesh->AddVertex(v);
+    for (auto index : parts[i].hullIndices)
+      subMesh->AddIndex(index);
+    mesh->AddSubMesh(subMesh);
+  }
+
+  return mesh;
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_MESHCONVEXDECOMPOSITION_HH_
+#define GAZEBO_COMMON_MESHCONVEXDECOMPOSITION_HH_
+
+#include <vector>
+
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    class Mesh;
+
+    /// \internal
+    /// \brief Approximate convex decomposition of triangle meshes, for
+    /// collisions that are faster and more stable than triangle meshes.
+    ///
+    /// The mesh is cut recursively by axis aligned planes. Each step cuts
+    /// the part whose triangles sink deepest below its convex hull, along
+    /// the plane whose children have the smallest hulls, until every part
+    /// is convex enough or the hull budget is spent. Triangles crossing a
+    /// plane are clipped, so the hulls of the two sides meet at the plane.
+    /// The result is the convex hulls of the parts, which together cover
+    /// the mesh.
+    class GZ_COMMON_VISIBLE MeshConvexDecomposition
+    {
+      /// \brief Decompose a triangle mesh.
+      /// \param[in] _vertices Vertices of the mesh.
+      /// \param[in] _indices Three vertex indices per triangle.
+      /// \param[in] _maxHulls Maximum number of hulls.
+      /// \param[in] _maxConcavity Depth below its hull at which a part is
+      /// split, as a fraction of the diagonal of the mesh bounding box.
+      /// \return New mesh owned by the caller with one closed triangle
+      /// submesh per hull, null if the mesh has no volume or area.
+      public: static Mesh *Decompose(
+                  const std::vector<ignition::math::Vector3d> &_vertices,
+                  const std::vector<unsigned int> &_indices,
+                  const unsigned int _maxHulls, const double _maxConcavity);
+
+      /// \brief Compute the convex hull of a set of points.
+      /// \param[in] _points Points to enclose.
+      /// \param[out] _vertices Vertices of the hull, a subset of the
+      /// points.
+      /// \param[out] _indices Three vertex indices per hull triangle,
+      /// counter clockwise seen from outside.
+      /// \return False if the points are all on a plane.
+      public: static bool ConvexHull(
+                  const std::vector<ignition::math::Vector3d> &_points,
+                  std::vector<ignition::math::Vector3d> &_vertices,
+                  std::vector<unsigned int> &_indices);
+    };
+  }
+}
+#endif
@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/common/MeshConvexDecomposition.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class MeshConvexDecompositionTest : public gazebo::testing::AutoLogFixture
+{
+};
+
+/////////////////////////////////////////////////
+/// \brief Add the triangles of a box.
+/// \param[in] _center Center of the box.
+/// \param[in] _half Half of the size of the box.
+/// \param[in,out] _vertices Vertices of the mesh.
+/// \param[in,out] _indices Triangles of the mesh.
+void AddBox(const ignition::math::Vector3d &_center,
+    const ignition::math::Vector3d &_half,
+    std::vector<ignition::math::Vector3d> &_vertices,
+    std::vector<unsigned int> &_indices)
+{
+  const unsigned int offset = _vertices.size();
+  for (int i = 0; i < 8; ++i)
+  {
+    _vertices.push_back(_center + ignition::math::Vector3d(
+        (i & 1) ? _half.X() : -_half.X(),
+        (i & 2) ? _half.Y() : -_half.Y(),
+        (i & 4) ? _half.Z() : -_half.Z()));
+  }
+
+  const unsigned int faces[12][3] =
+  {
+    {0, 2, 1}, {1, 2, 3}, {4, 5, 6}, {5, 7, 6}, {0, 1, 4}, {1, 5, 4},
+    {2, 6, 3}, {3, 6, 7}, {0, 4, 2}, {2, 4, 6}, {1, 3, 5}, {3, 7, 5}
+  };
+  for (const auto &face : faces)
+  {
+    for (auto index : face)
+      _indices.push_back(offset + index);
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the volume enclosed by outward facing triangles.
+/// \param[in] _subMesh Closed submesh.
+/// \return The volume.
+double Volume(const common::SubMesh *_subMesh)
+{
+  double volume = 0;
+  for (unsigned int i = 0; i + 2 < _subMesh->GetIndexCount(); i += 3)
+  {
+    volume += _subMesh->Vertex(_subMesh->GetIndex(i)).Dot(
+        _subMesh->Vertex(_subMesh->GetIndex(i + 1)).Cross(
+        _subMesh->Vertex(_subMesh->GetIndex(i + 2)))) / 6.0;
+  }
+  return volume;
+}
+
+/////////////////////////////////////////////////
+/// \brief Check whether a point is inside a convex submesh.
+/// \param[in] _subMesh Convex hull.
+/// \param[in] _point Point to check.
+/// \return True if the point is inside or on the hull.
+bool Inside(const common::SubMesh *_subMesh,
+    const ignition::math::Vector3d &_point)
+{
+  for (unsigned int i = 0; i + 2 < _subMesh->GetIndexCount(); i += 3)
+  {
+    const auto a = _subMesh->Vertex(_subMesh->GetIndex(i));
+    auto normal = (_subMesh->Vertex(_subMesh->GetIndex(i + 1)) - a).Cross(
+        _subMesh->Vertex(_subMesh->GetIndex(i + 2)) - a);
+    if (normal.Normalize().Dot(_point - a) > 1e-6)
+      return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshConvexDecompositionTest, ConvexHull)
+{
+  // Corners of a unit cube and points inside it
+  std::vector<ignition::math::Vector3d> points;
+  for (int i = 0; i < 8; ++i)
+    points.emplace_back(i & 1, (i >> 1) & 1, (i >> 2) & 1);
+  for (int i = 0; i < 20; ++i)
+    points.emplace_back(0.5, 0.5, i / 19.0);
+
+  std::vector<ignition::math::Vector3d> vertices;
+  std::vector<unsigned int> indices;
+  ASSERT_TRUE(common::MeshConvexDecomposition::ConvexHull(points, vertices,
+        indices));
+  EXPECT_EQ(vertices.size(), 8u);
+  EXPECT_EQ(indices.size(), 36u);
+
+  common::SubMesh hull;
+  for (const auto &v : vertices)
+    hull.AddVertex(v);
+  for (auto index : indices)
+    hull.AddIndex(index);
+  EXPECT_NEAR(Volume(&hull), 1.0, 1e-9);
+  for (const auto &p : points)
+    EXPECT_TRUE(Inside(&hull, p));
+
+  // Flat points have no hull
+  points = {{0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {1, 1, 0}};
+  EXPECT_FALSE(common::MeshConvexDecomposition::ConvexHull(points, vertices,
+        indices));
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshConvexDecompositionTest, Box)
+{
+  std::vector<ignition::math::Vector3d> vertices;
+  std::vector<unsigned int> indices;
+  AddBox(ignition::math::Vector3d::Zero, ignition::math::Vector3d(1, 2, 3),
+      vertices, indices);
+
+  std::unique_ptr<common::Mesh> mesh(
+      common::MeshConvexDecomposition::Decompose(vertices, indices, 16,
+        0.02));
+  ASSERT_TRUE(mesh != nullptr);
+  ASSERT_EQ(mesh->GetSubMeshCount(), 1u);
+  EXPECT_NEAR(Volume(mesh->GetSubMesh(0)), 48.0, 1e-9);
+
+  // Nothing to decompose
+  indices.clear();
+  EXPECT_TRUE(common::MeshConvexDecomposition::Decompose(vertices, indices,
+        16, 0.02) == nullptr);
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshConvexDecompositionTest, Concave)
+{
+  // L shape made of two boxes
+  std::vector<ignition::math::Vector3d> vertices;
+  std::vector<unsigned int> indices;
+  AddBox(ignition::math::Vector3d::Zero,
+      ignition::math::Vector3d(2, 0.25, 0.25), vertices, indices);
+  AddBox(ignition::math::Vector3d(-1.75, 1.25, 0),
+      ignition::math::Vector3d(0.25, 1, 0.25), vertices, indices);
+  const double volume = 1.5;
+
+  // A single hull fills the corner of the L
+  std::unique_ptr<common::Mesh> mesh(
+      common::MeshConvexDecomposition::Decompose(vertices, indices, 1,
+        0.02));
+  ASSERT_TRUE(mesh != nullptr);
+  ASSERT_EQ(mesh->GetSubMeshCount(), 1u);
+  EXPECT_GT(Volume(mesh->GetSubMesh(0)), 2 * volume);
+
+  // More hulls follow the shape closely and still cover all of it
+  mesh.reset(common::MeshConvexDecomposition::Decompose(vertices, indices,
+        8, 0.02));
+  ASSERT_TRUE(mesh != nullptr);
+  EXPECT_GT(mesh->GetSubMeshCount(), 1u);
+  EXPECT_LE(mesh->GetSubMeshCount(), 8u);
+
+  double total = 0;
+  for (unsigned int i = 0; i < mesh->GetSubMeshCount(); ++i)
+  {
+    EXPECT_GT(Volume(mesh->GetSubMesh(i)), 0.0);
+    total += Volume(mesh->GetSubMesh(i));
+  }
+  EXPECT_NEAR(total, volume, 0.1 * volume);
+
+  for (const auto &v : vertices)
+  {
+    bool inside = false;
+    for (unsigned int i = 0; i < mesh->GetSubMeshCount() && !inside; ++i)
+      inside = Inside(mesh->GetSubMesh(i), v);
+    EXPECT_TRUE(inside) << v;
+  }
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
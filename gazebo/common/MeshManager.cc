@@ -16,13 +16,34 @@
  */
 
 #include <sys/stat.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
 #include <string>
 #include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <vector>
+
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/thread.hpp>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <ignition/math/Helpers.hh>
 
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Console.hh"
+#include "gazebo/common/MemoryAccount.hh"
 #include "gazebo/common/Mesh.hh"
+#include "gazebo/common/MeshCache.hh"
+#include "gazebo/common/MeshConvexDecomposition.hh"
+#include "gazebo/common/StartupTrace.hh"
 #include "gazebo/common/ColladaLoader.hh"
 #include "gazebo/common/ColladaExporter.hh"
 #include "gazebo/common/STLLoader.hh"
@@ -43,41 +64,228 @@ namespace common
 //////////////////////////////////////////////////
 class MeshManagerPrivate
 {
-  /// \brief 3D mesh loader for COLLADA files
-  public: ColladaLoader *colladaLoader = nullptr;
+  /// \brief Load a mesh file, or wait for another thread loading it.
+  /// \param[in] _filename Name to store the mesh under.
+  /// \param[in] _fullname Full path of the mesh file.
+  /// \return The mesh, null if it could not be loaded.
+  public: Mesh *LoadFile(const std::string &_filename,
+                         const std::string &_fullname);
+
+  /// \brief Add a mesh unless one with the same name exists.
+  /// \param[in] _name Name of the mesh.
+  /// \param[in] _mesh Mesh to add.
+  public: void Insert(const std::string &_name, Mesh *_mesh);
+
+  /// \brief Remove the file meshes unreferenced for longer than the
+  /// retention time. The mutex must be locked.
+  /// \param[in] _all True to ignore the retention time.
+  /// \return Number of meshes removed.
+  public: unsigned int RemoveUnreferenced(const bool _all);
+
+  /// \brief Body of the thread that removes unreferenced meshes.
+  public: void RunCollector();
 
   /// \brief 3D mesh exporter for COLLADA files
   public: ColladaExporter *colladaExporter = nullptr;
 
-  /// \brief 3D mesh loader for STL files
-  public: STLLoader *stlLoader = nullptr;
-
   // \brief 3D mesh loader for FBX files
   // \todo The FBX loader needs to be implemented.
   // public: FBXLoader *fbxLoader = nullptr;
 
+  /// \brief On-disk cache of loaded mesh files, null if disabled.
+  public: std::unique_ptr<MeshCache> meshCache;
+
   /// \brief Dictionary of meshes, indexed by name
   public: std::map<std::string, Mesh*> meshes;
 
   /// \brief supported file extensions for meshes
   public: std::vector<std::string> fileExtensions;
 
-  /// \brief Mutex to protect from loading the same mesh in different threads
-  /// at the same time.
+  /// \brief Files being loaded, so that a mesh is only loaded once when
+  /// several threads ask for it.
+  public: std::set<std::string> loading;
+
+  /// \brief Notified when a file is done loading.
+  public: boost::condition_variable loadCondition;
+
+  /// \brief Names of the meshes loaded from a file.
+  public: std::set<std::string> files;
+
+  /// \brief Number of references to each mesh, see AddReference.
+  public: std::map<std::string, unsigned int> references;
+
+  /// \brief When the last reference to a mesh was removed.
+  public: std::map<std::string, std::chrono::steady_clock::time_point>
+          released;
+
+  /// \brief How long unreferenced meshes are kept, in seconds. Negative
+  /// to keep them forever.
+  public: double retention = 30;
+
+  /// \brief Thread that removes unreferenced meshes, started when the
+  /// first mesh loses its references.
+  public: boost::thread collector;
+
+  /// \brief Wakes the collector thread.
+  public: boost::condition_variable collectCondition;
+
+  /// \brief True to stop the collector thread.
+  public: bool stop = false;
+
+  /// \brief Protects the meshes and the files being loaded.
   public: boost::mutex mutex;
 };
 
-// added here for ABI compatibility
-// TODO move to header / private class when merging forward.
-static OBJLoader objLoader;
+//////////////////////////////////////////////////
+void MeshManagerPrivate::Insert(const std::string &_name, Mesh *_mesh)
+{
+  boost::mutex::scoped_lock lock(this->mutex);
+  this->meshes.insert(std::make_pair(_name, _mesh));
+}
+
+//////////////////////////////////////////////////
+unsigned int MeshManagerPrivate::RemoveUnreferenced(const bool _all)
+{
+  if (!_all && this->retention < 0)
+    return 0;
+
+  const auto now = std::chrono::steady_clock::now();
+  const auto retained = std::chrono::duration_cast<
+      std::chrono::steady_clock::duration>(
+      std::chrono::duration<double>(std::max(0.0, this->retention)));
+
+  unsigned int count = 0;
+  for (auto iter = this->released.begin(); iter != this->released.end();)
+  {
+    if (!_all && now - iter->second < retained)
+    {
+      ++iter;
+      continue;
+    }
+
+    // Generated meshes can't be loaded again
+    auto mesh = this->meshes.find(iter->first);
+    if (mesh != this->meshes.end() && this->files.count(iter->first) &&
+        !this->loading.count(iter->first))
+    {
+      delete mesh->second;
+      this->meshes.erase(mesh);
+      this->files.erase(iter->first);
+      ++count;
+    }
+    iter = this->released.erase(iter);
+  }
+
+  return count;
+}
+
+//////////////////////////////////////////////////
+void MeshManagerPrivate::RunCollector()
+{
+  boost::mutex::scoped_lock lock(this->mutex);
+  while (!this->stop)
+  {
+    this->RemoveUnreferenced(false);
+    if (this->released.empty() || this->retention < 0)
+      this->collectCondition.wait(lock);
+    else
+      this->collectCondition.timed_wait(lock, boost::posix_time::seconds(1));
+  }
+}
+
+//////////////////////////////////////////////////
+Mesh *MeshManagerPrivate::LoadFile(const std::string &_filename,
+    const std::string &_fullname)
+{
+  std::string extension =
+      _fullname.substr(_fullname.rfind(".")+1, _fullname.size());
+  std::transform(extension.begin(), extension.end(),
+      extension.begin(), ::tolower);
+
+  // Loaders keep the state of the file they parse, so every load gets its
+  // own and different files are parsed concurrently.
+  std::unique_ptr<MeshLoader> loader;
+  if (extension == "stl" || extension == "stlb" || extension == "stla")
+    loader.reset(new STLLoader());
+  else if (extension == "dae")
+    loader.reset(new ColladaLoader());
+  else if (extension == "obj")
+    loader.reset(new OBJLoader());
+  else
+  {
+    gzerr << "Unsupported mesh format for file[" << _filename << "]\n";
+    return nullptr;
+  }
+
+  {
+    boost::mutex::scoped_lock lock(this->mutex);
+    while (this->loading.count(_filename))
+      this->loadCondition.wait(lock);
+
+    auto iter = this->meshes.find(_filename);
+    if (iter != this->meshes.end())
+      return iter->second;
+
+    this->loading.insert(_filename);
+  }
+
+  Mesh *mesh = nullptr;
+  try
+  {
+    if (this->meshCache)
+      mesh = this->meshCache->Load(_fullname);
+
+    if (!mesh && (mesh = loader->Load(_fullname)) != nullptr &&
+        this->meshCache)
+    {
+      this->meshCache->Save(_fullname, mesh);
+    }
+  }
+  catch(gazebo::common::Exception &e)
+  {
+    {
+      boost::mutex::scoped_lock lock(this->mutex);
+      this->loading.erase(_filename);
+    }
+    this->loadCondition.notify_all();
+
+    gzerr << "Error loading mesh[" << _fullname << "]\n";
+    gzerr << e << "\n";
+    gzthrow(e);
+  }
+
+  if (mesh)
+    mesh->SetName(_filename);
+  else
+    gzerr << "Unable to load mesh[" << _fullname << "]\n";
+
+  {
+    boost::mutex::scoped_lock lock(this->mutex);
+    if (mesh)
+    {
+      this->meshes.insert(std::make_pair(_filename, mesh));
+      this->files.insert(_filename);
+    }
+    this->loading.erase(_filename);
+  }
+  this->loadCondition.notify_all();
+
+  return mesh;
+}
 
 //////////////////////////////////////////////////
 MeshManager::MeshManager()
   : dataPtr(new MeshManagerPrivate)
 {
-  this->dataPtr->colladaLoader = new ColladaLoader();
   this->dataPtr->colladaExporter = new ColladaExporter();
-  this->dataPtr->stlLoader = new STLLoader();
+
+  const std::string cacheDir = MeshCache::Directory();
+  if (!cacheDir.empty())
+    this->dataPtr->meshCache.reset(new MeshCache(cacheDir));
+
+  const char *retention = std::getenv("GAZEBO_RESOURCE_RETENTION");
+  if (retention && *retention)
+    this->dataPtr->retention = std::atof(retention);
 
   // Create some basic shapes
   this->CreatePlane("unit_plane",
@@ -111,14 +319,44 @@ MeshManager::MeshManager()
   this->dataPtr->fileExtensions.push_back("stlb");
   this->dataPtr->fileExtensions.push_back("dae");
   this->dataPtr->fileExtensions.push_back("obj");
+
+  // Meshes are filled after they are added, so measure them when asked
+  MeshManagerPrivate *data = this->dataPtr;
+  MemoryAccount::Get("common/meshes")->SetSource([data]()
+  {
+    boost::mutex::scoped_lock lock(data->mutex);
+    int64_t bytes = 0;
+    for (auto const &pairNameMesh : data->meshes)
+    {
+      const Mesh *mesh = pairNameMesh.second;
+      for (unsigned int i = 0; i < mesh->GetSubMeshCount(); ++i)
+      {
+        const SubMesh *subMesh = mesh->GetSubMesh(i);
+        bytes += (subMesh->GetVertexCount() + subMesh->GetNormalCount()) *
+            sizeof(ignition::math::Vector3d) +
+            subMesh->GetTexCoordCount() * sizeof(ignition::math::Vector2d) +
+            subMesh->GetIndexCount() * sizeof(unsigned int) +
+            subMesh->GetNodeAssignmentsCount() * sizeof(NodeAssignment);
+      }
+    }
+    return bytes;
+  });
 }
 
 //////////////////////////////////////////////////
 MeshManager::~MeshManager()
 {
-  delete this->dataPtr->colladaLoader;
+  MemoryAccount::Get("common/meshes")->SetSource(nullptr);
+
+  {
+    boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+    this->dataPtr->stop = true;
+  }
+  this->dataPtr->collectCondition.notify_all();
+  if (this->dataPtr->collector.joinable())
+    this->dataPtr->collector.join();
+
   delete this->dataPtr->colladaExporter;
-  delete this->dataPtr->stlLoader;
   for (auto &pairNameMesh : this->dataPtr->meshes)
   {
     delete pairNameMesh.second;
@@ -138,13 +376,10 @@ const Mesh *MeshManager::Load(const std::string &_filename)
     return nullptr;
   }
 
-  Mesh *mesh = nullptr;
-
-  std::string extension;
-
-  if (this->HasMesh(_filename))
+  const Mesh *mesh = this->GetMesh(_filename);
+  if (mesh)
   {
-    return this->dataPtr->meshes[_filename];
+    return mesh;
 
     // This breaks trimesh geom. Each new trimesh should have a unique name.
     /*
@@ -159,58 +394,52 @@ const Mesh *MeshManager::Load(const std::string &_filename)
     */
   }
 
+  StartupTraceScope trace("MeshManager::Load", "mesh", _filename);
   std::string fullname = common::find_file(_filename);
 
   if (!fullname.empty())
+    mesh = this->dataPtr->LoadFile(_filename, fullname);
+  else
+    gzerr << "Unable to find file[" << _filename << "]\n";
+
+  return mesh;
+}
+
+//////////////////////////////////////////////////
+void MeshManager::Prefetch(const std::vector<std::string> &_filenames)
+{
+  // Finding files goes through SystemPaths, which is not thread safe
+  std::vector<std::pair<std::string, std::string>> files;
+  std::set<std::string> seen;
+  for (const auto &filename : _filenames)
   {
-    extension = fullname.substr(fullname.rfind(".")+1, fullname.size());
-    std::transform(extension.begin(), extension.end(),
-        extension.begin(), ::tolower);
-    MeshLoader *loader = nullptr;
-
-    if (extension == "stl" || extension == "stlb" || extension == "stla")
-      loader = this->dataPtr->stlLoader;
-    else if (extension == "dae")
-      loader = this->dataPtr->colladaLoader;
-    else if (extension == "obj")
-      loader = &objLoader;
-    else
+    if (!seen.insert(filename).second || !this->IsValidFilename(filename) ||
+        this->HasMesh(filename))
     {
-      gzerr << "Unsupported mesh format for file[" << _filename << "]\n";
-      return nullptr;
+      continue;
     }
 
-    try
-    {
-      // This mutex prevents two threads from loading the same mesh at the
-      // same time.
-      boost::mutex::scoped_lock lock(this->dataPtr->mutex);
-      if (!this->HasMesh(_filename))
+    std::string fullname = common::find_file(filename);
+    if (!fullname.empty())
+      files.push_back(std::make_pair(filename, fullname));
+  }
+
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, files.size(), 1),
+      [&](const tbb::blocked_range<size_t> &_range)
       {
-        if ((mesh = loader->Load(fullname)) != nullptr)
+        for (size_t i = _range.begin(); i != _range.end(); ++i)
         {
-          mesh->SetName(_filename);
-          this->dataPtr->meshes.insert(std::make_pair(_filename, mesh));
+          // The error is printed, and Load tries again once the mesh is
+          // actually needed.
+          try
+          {
+            this->dataPtr->LoadFile(files[i].first, files[i].second);
+          }
+          catch(gazebo::common::Exception &)
+          {
+          }
         }
-        else
-          gzerr << "Unable to load mesh[" << fullname << "]\n";
-      }
-      else
-      {
-        mesh = this->dataPtr->meshes[_filename];
-      }
-    }
-    catch(gazebo::common::Exception &e)
-    {
-      gzerr << "Error loading mesh[" << fullname << "]\n";
-      gzerr << e << "\n";
-      gzthrow(e);
-    }
-  }
-  else
-    gzerr << "Unable to find file[" << _filename << "]\n";
-
-  return mesh;
+      });
 }
 
 //////////////////////////////////////////////////
@@ -249,28 +478,31 @@ void MeshManager::GetMeshAABB(const Mesh *_mesh,
     ignition::math::Vector3d &_center,
     ignition::math::Vector3d &_minXYZ, ignition::math::Vector3d &_maxXYZ)
 {
-  if (this->HasMesh(_mesh->GetName()))
-    this->dataPtr->meshes[_mesh->GetName()]->GetAABB(_center, _minXYZ, _maxXYZ);
+  const Mesh *mesh = this->GetMesh(_mesh->GetName());
+  if (mesh)
+    mesh->GetAABB(_center, _minXYZ, _maxXYZ);
 }
 
 //////////////////////////////////////////////////
 void MeshManager::GenSphericalTexCoord(const Mesh *_mesh,
     const ignition::math::Vector3d &_center)
 {
-  if (this->HasMesh(_mesh->GetName()))
-    this->dataPtr->meshes[_mesh->GetName()]->GenSphericalTexCoord(_center);
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+  auto iter = this->dataPtr->meshes.find(_mesh->GetName());
+  if (iter != this->dataPtr->meshes.end())
+    iter->second->GenSphericalTexCoord(_center);
 }
 
 //////////////////////////////////////////////////
 void MeshManager::AddMesh(Mesh *_mesh)
 {
-  if (!this->HasMesh(_mesh->GetName()))
-    this->dataPtr->meshes[_mesh->GetName()] = _mesh;
+  this->dataPtr->Insert(_mesh->GetName(), _mesh);
 }
 
 //////////////////////////////////////////////////
 const Mesh *MeshManager::GetMesh(const std::string &_name) const
 {
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
   std::map<std::string, Mesh*>::const_iterator iter;
 
   iter = this->dataPtr->meshes.find(_name);
@@ -287,12 +519,87 @@ bool MeshManager::HasMesh(const std::string &_name) const
   if (_name.empty())
     return false;
 
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
   std::map<std::string, Mesh*>::const_iterator iter;
   iter = this->dataPtr->meshes.find(_name);
 
   return iter != this->dataPtr->meshes.end();
 }
 
+//////////////////////////////////////////////////
+void MeshManager::AddReference(const std::string &_name)
+{
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+  ++this->dataPtr->references[_name];
+  this->dataPtr->released.erase(_name);
+}
+
+//////////////////////////////////////////////////
+void MeshManager::RemoveReference(const std::string &_name)
+{
+  {
+    boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+    auto iter = this->dataPtr->references.find(_name);
+    if (iter == this->dataPtr->references.end())
+      return;
+
+    if (--iter->second > 0)
+      return;
+
+    this->dataPtr->references.erase(iter);
+    this->dataPtr->released[_name] = std::chrono::steady_clock::now();
+
+    if (this->dataPtr->retention < 0 || this->dataPtr->stop)
+      return;
+
+    if (!this->dataPtr->collector.joinable())
+    {
+      this->dataPtr->collector = boost::thread(
+          &MeshManagerPrivate::RunCollector, this->dataPtr);
+      return;
+    }
+  }
+  this->dataPtr->collectCondition.notify_all();
+}
+
+//////////////////////////////////////////////////
+bool MeshManager::IsReloadable(const std::string &_name) const
+{
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+  return this->dataPtr->files.count(_name) > 0;
+}
+
+//////////////////////////////////////////////////
+void MeshManager::SetRetention(const double _seconds)
+{
+  {
+    boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+    this->dataPtr->retention = _seconds;
+    if (_seconds >= 0 && !this->dataPtr->released.empty() &&
+        !this->dataPtr->stop && !this->dataPtr->collector.joinable())
+    {
+      this->dataPtr->collector = boost::thread(
+          &MeshManagerPrivate::RunCollector, this->dataPtr);
+      return;
+    }
+  }
+  this->dataPtr->collectCondition.notify_all();
+}
+
+//////////////////////////////////////////////////
+double MeshManager::Retention() const
+{
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+  return this->dataPtr->retention;
+}
+
+//////////////////////////////////////////////////
+unsigned int MeshManager::RemoveUnreferenced(const bool _all)
+{
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+  return this->dataPtr->RemoveUnreferenced(_all);
+}
+
 //////////////////////////////////////////////////
 void MeshManager::CreateSphere(const std::string &name, float radius,
     int rings, int segments)
@@ -310,7 +617,7 @@ void MeshManager::CreateSphere(const std::string &name, float radius,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(name);
-  this->dataPtr->meshes.insert(std::make_pair(name, mesh));
+  this->dataPtr->Insert(name, mesh);
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -378,7 +685,7 @@ void MeshManager::CreatePlane(const std::string &_name,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  this->dataPtr->Insert(_name, mesh);
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -458,7 +765,7 @@ void MeshManager::CreateBox(const std::string &_name,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  this->dataPtr->Insert(_name, mesh);
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -581,6 +888,20 @@ void MeshManager::CreateExtrudedPolyline(const std::string &_name,
     return;
   }
 
+  // A mesh named after its polylines is the same in every process
+  const bool cacheable = this->dataPtr->meshCache &&
+      _name == ExtrudedPolylineMeshName(_polys, _height);
+  if (cacheable)
+  {
+    Mesh *cached = this->dataPtr->meshCache->Load(_name);
+    if (cached)
+    {
+      cached->SetName(_name);
+      this->dataPtr->Insert(_name, cached);
+      return;
+    }
+  }
+
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
 
@@ -759,10 +1080,239 @@ void MeshManager::CreateExtrudedPolyline(const std::string &_name,
     }
   }
 
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  if (cacheable)
+    this->dataPtr->meshCache->Save(_name, mesh);
+
+  this->dataPtr->Insert(_name, mesh);
   return;
 }
 
+//////////////////////////////////////////////////
+std::string MeshManager::ExtrudedPolylineMeshName(
+    const std::vector<std::vector<ignition::math::Vector2d> > &_vertices,
+    double _height)
+{
+  std::vector<double> definition;
+  definition.push_back(_height);
+  for (const auto &poly : _vertices)
+  {
+    definition.push_back(poly.size());
+    for (const auto &v : poly)
+    {
+      definition.push_back(v.X());
+      definition.push_back(v.Y());
+    }
+  }
+
+  return "extruded_polyline_" + get_sha1(definition);
+}
+
+//////////////////////////////////////////////////
+void MeshManager::CreateRoad(const std::string &_name,
+    const std::vector<ignition::math::Vector3d> &_points, double _width)
+{
+  if (this->HasMesh(_name))
+    return;
+
+  if (_points.size() < 2)
+  {
+    gzerr << "A road needs at least two points, unable to create mesh["
+          << _name << "]\n";
+    return;
+  }
+
+  Mesh *mesh = new Mesh();
+  mesh->SetName(_name);
+
+  SubMesh *subMesh = new SubMesh();
+  subMesh->SetPrimitiveType(SubMesh::TRISTRIPS);
+  mesh->AddSubMesh(subMesh);
+
+  // length for each texture tile, same as road width as texture is square
+  double texMaxLen = _width;
+
+  // current road length
+  double curLen = 0.0;
+
+  for (unsigned int i = 0; i < _points.size(); ++i)
+  {
+    double factor = 1.0;
+    ignition::math::Vector3d tangent;
+
+    if (i > 0)
+      curLen += _points[i].Distance(_points[i-1]);
+
+    // assign texture coordinate as percentage of texture tile size
+    // and let ogre/opengl handle the texture wrapping
+    double texCoord = curLen / texMaxLen;
+
+    // Start point is a special case
+    if (i == 0)
+    {
+      tangent = (_points[i+1] - _points[i]).Normalize();
+    }
+    // End point is a special case
+    else if (i == _points.size() - 1)
+    {
+      tangent = (_points[i] - _points[i-1]).Normalize();
+    }
+    // Every other point in the road
+    else
+    {
+      auto v1 = (_points[i+1] - _points[i]).Normalize();
+      auto v0 = (_points[i] - _points[i-1]).Normalize();
+      double dot = v0.Dot(v1 * -1);
+      tangent = (v1+v0).Normalize();
+
+      // Check to see if the points are not colinear
+      // If not colinear, then the road needs to be widended for the turns
+      if (!ignition::math::equal(fabs(dot), 1.0))
+        factor = 1.0 / sin(acos(dot) * 0.5);
+    }
+
+    // The tangent is used to calculate the two verteces to either side of
+    // the point. The vertices define the triangle mesh of the road
+    double theta = atan2(tangent.X(), -tangent.Y());
+    double w = (_width * factor) * 0.5;
+
+    ignition::math::Vector3d pA = _points[i];
+    ignition::math::Vector3d pB = _points[i];
+    pA.X() += cos(theta) * w;
+    pA.Y() += sin(theta) * w;
+    pB.X() -= cos(theta) * w;
+    pB.Y() -= sin(theta) * w;
+
+    subMesh->AddVertex(pA);
+    subMesh->AddNormal(ignition::math::Vector3d::UnitZ);
+    subMesh->AddTexCoord(0, texCoord);
+    subMesh->AddIndex(2 * i);
+
+    subMesh->AddVertex(pB);
+    subMesh->AddNormal(ignition::math::Vector3d::UnitZ);
+    subMesh->AddTexCoord(1, texCoord);
+    subMesh->AddIndex(2 * i + 1);
+  }
+
+  // Roads may be built from several threads, keep the first one
+  this->dataPtr->Insert(_name, mesh);
+  if (this->GetMesh(_name) != mesh)
+    delete mesh;
+}
+
+//////////////////////////////////////////////////
+std::string MeshManager::RoadMeshName(
+    const std::vector<ignition::math::Vector3d> &_points, double _width)
+{
+  std::vector<double> definition;
+  definition.push_back(_width);
+  for (const auto &p : _points)
+  {
+    definition.push_back(p.X());
+    definition.push_back(p.Y());
+    definition.push_back(p.Z());
+  }
+
+  return "road_" + get_sha1(definition);
+}
+
+//////////////////////////////////////////////////
+void MeshManager::CreateConvexDecomposition(const std::string &_name,
+    const Mesh *_mesh, const std::string &_subMesh, const bool _center,
+    const unsigned int _maxHulls, const double _maxConcavity)
+{
+  if (!_mesh)
+    return;
+
+  // Decompose once when several collisions ask for the same hulls
+  {
+    boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+    while (this->dataPtr->loading.count(_name))
+      this->dataPtr->loadCondition.wait(lock);
+
+    if (this->dataPtr->meshes.count(_name))
+      return;
+
+    this->dataPtr->loading.insert(_name);
+  }
+
+  const bool cacheable = this->dataPtr->meshCache &&
+      _name == ConvexDecompositionName(_mesh, _subMesh, _center, _maxHulls,
+          _maxConcavity);
+  Mesh *mesh = nullptr;
+  if (cacheable)
+    mesh = this->dataPtr->meshCache->Load(_name);
+
+  if (!mesh)
+  {
+    std::vector<ignition::math::Vector3d> vertices;
+    std::vector<unsigned int> indices;
+    auto addSubMesh = [&](const SubMesh *_s)
+    {
+      if (_s->GetPrimitiveType() != SubMesh::TRIANGLES)
+        return;
+
+      const unsigned int offset = vertices.size();
+      for (unsigned int i = 0; i < _s->GetVertexCount(); ++i)
+        vertices.push_back(_s->Vertex(i));
+      for (unsigned int i = 0; i < _s->GetIndexCount(); ++i)
+        indices.push_back(offset + _s->GetIndex(i));
+    };
+
+    if (_subMesh.empty())
+    {
+      for (unsigned int i = 0; i < _mesh->GetSubMeshCount(); ++i)
+        addSubMesh(_mesh->GetSubMesh(i));
+    }
+    else if (const SubMesh *subMesh = _mesh->GetSubMesh(_subMesh))
+    {
+      SubMesh copy(subMesh);
+      if (_center)
+        copy.Center(ignition::math::Vector3d::Zero);
+      addSubMesh(&copy);
+    }
+
+    mesh = MeshConvexDecomposition::Decompose(vertices, indices, _maxHulls,
+        _maxConcavity);
+    if (mesh && cacheable)
+      this->dataPtr->meshCache->Save(_name, mesh);
+  }
+
+  if (mesh)
+    mesh->SetName(_name);
+  else
+    gzerr << "Unable to decompose mesh[" << _mesh->GetName() << "]\n";
+
+  {
+    boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+    if (mesh)
+      this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+    this->dataPtr->loading.erase(_name);
+  }
+  this->dataPtr->loadCondition.notify_all();
+}
+
+//////////////////////////////////////////////////
+std::string MeshManager::ConvexDecompositionName(const Mesh *_mesh,
+    const std::string &_subMesh, const bool _center,
+    const unsigned int _maxHulls, const double _maxConcavity)
+{
+  std::ostringstream definition;
+  definition.precision(std::numeric_limits<double>::max_digits10);
+  definition << (_mesh ? _mesh->GetName() : std::string()) << "\n"
+             << _subMesh << "\n" << _center << " " << _maxHulls << " "
+             << _maxConcavity;
+
+  // An edited mesh file gets new hulls
+  struct stat info;
+  if (_mesh && stat(_mesh->GetName().c_str(), &info) == 0)
+  {
+    definition << " " << static_cast<int64_t>(info.st_mtime) << " "
+               << static_cast<int64_t>(info.st_size);
+  }
+
+  return "convex_" + get_sha1(definition.str());
+}
+
 //////////////////////////////////////////////////
 void MeshManager::CreateCamera(const std::string &_name, float _scale)
 {
@@ -775,7 +1325,7 @@ void MeshManager::CreateCamera(const std::string &_name, float _scale)
 
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  this->dataPtr->Insert(_name, mesh);
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -876,7 +1426,7 @@ void MeshManager::CreateCylinder(const std::string &name, float radius,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(name);
-  this->dataPtr->meshes.insert(std::make_pair(name, mesh));
+  this->dataPtr->Insert(name, mesh);
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -993,7 +1543,7 @@ void MeshManager::CreateCone(const std::string &name, float radius,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(name);
-  this->dataPtr->meshes.insert(std::make_pair(name, mesh));
+  this->dataPtr->Insert(name, mesh);
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -1110,7 +1660,7 @@ void MeshManager::CreateTube(const std::string &_name, float _innerRadius,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  this->dataPtr->Insert(_name, mesh);
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
 
@@ -1331,7 +1881,7 @@ void MeshManager::CreateBoolean(const std::string &_name, const Mesh *_m1,
   MeshCSG csg;
   Mesh *mesh = csg.CreateBoolean(_m1, _m2, _operation, _offset);
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  this->dataPtr->Insert(_name, mesh);
 }
 #endif
 
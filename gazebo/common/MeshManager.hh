@@ -54,7 +54,7 @@ namespace gazebo
 
       /// \brief Destructor.
       ///
-      /// Destroys the collada loader, the stl loader and all the meshes
+      /// Destroys the collada exporter and all the meshes
       private: virtual ~MeshManager();
 
       /// \brief Load a mesh from a file
@@ -62,6 +62,12 @@ namespace gazebo
       /// \return a pointer to the created mesh
       public: const Mesh *Load(const std::string &_filename);
 
+      /// \brief Load several mesh files concurrently, so that later calls
+      /// to Load return right away. Files that are already loaded, or that
+      /// can not be found, are skipped.
+      /// \param[in] _filenames Paths to the meshes, as passed to Load.
+      public: void Prefetch(const std::vector<std::string> &_filenames);
+
       /// \brief Export a mesh to a file
       /// \param[in] _mesh Pointer to the mesh to be exported
       /// \param[in] _filename Exported file's path and name
@@ -107,6 +113,46 @@ namespace gazebo
       /// \param[in] _name the name of the mesh
       public: bool HasMesh(const std::string &_name) const;
 
+      /// \brief Tell the manager a mesh is in use. Meshes loaded from a
+      /// file are removed once all their references are gone for longer
+      /// than the retention time, see SetRetention. Add the reference
+      /// before loading or getting the mesh, so it can't be removed in
+      /// between. Meshes that never had a reference are kept.
+      /// \param[in] _name Name of the mesh, it doesn't need to be loaded
+      /// yet.
+      public: void AddReference(const std::string &_name);
+
+      /// \brief Drop a reference added with AddReference. The mesh must
+      /// not be used after that.
+      /// \param[in] _name Name of the mesh.
+      public: void RemoveReference(const std::string &_name);
+
+      /// \brief Get whether a mesh was loaded from a file, so it can be
+      /// removed when unused and loaded again later.
+      /// \param[in] _name Name of the mesh.
+      /// \return True if the mesh was loaded from a file.
+      public: bool IsReloadable(const std::string &_name) const;
+
+      /// \brief Set how long unreferenced meshes are kept, so that models
+      /// deleted and spawned again quickly don't load their meshes again.
+      /// A background thread removes the meshes afterwards. Defaults to the
+      /// GAZEBO_RESOURCE_RETENTION environment variable, or 30 seconds.
+      /// \param[in] _seconds Retention time, negative to keep the meshes
+      /// forever.
+      public: void SetRetention(const double _seconds);
+
+      /// \brief Get how long unreferenced meshes are kept.
+      /// \return Retention time in seconds, negative if they are kept
+      /// forever.
+      public: double Retention() const;
+
+      /// \brief Remove the meshes loaded from a file whose references are
+      /// gone for longer than the retention time.
+      /// \param[in] _all True to remove them regardless of the retention
+      /// time.
+      /// \return Number of meshes removed.
+      public: unsigned int RemoveUnreferenced(const bool _all = false);
+
       /// \brief Create a sphere mesh.
       /// \param[in] _name the name of the mesh
       /// \param[in] _radius radius of the sphere in meter
@@ -139,6 +185,69 @@ namespace gazebo
                   const std::vector<std::vector<ignition::math::Vector2d> >
                   &_vertices, double _height);
 
+      /// \brief Get a mesh name for extruded polylines. Polylines with
+      /// the same vertices and height get the same name, so their mesh is
+      /// triangulated once and shared, and with GAZEBO_MESH_CACHE set it
+      /// is also shared between processes.
+      /// \param[in] _vertices Polylines, see CreateExtrudedPolyline.
+      /// \param[in] _height The height of extrusion.
+      /// \return Name made of a hash of the polylines.
+      public: static std::string ExtrudedPolylineMeshName(
+                  const std::vector<std::vector<ignition::math::Vector2d> >
+                  &_vertices, double _height);
+
+      /// \brief Create a flat strip along a road. The strip is widened at
+      /// turns to keep its width, and its texture repeats every width
+      /// along the road.
+      /// \param[in] _name The name of the new mesh, see RoadMeshName.
+      /// \param[in] _points Points along the middle of the road.
+      /// \param[in] _width Width of the road.
+      public: void CreateRoad(const std::string &_name,
+                  const std::vector<ignition::math::Vector3d> &_points,
+                  double _width);
+
+      /// \brief Get a mesh name for a road. Roads with the same points and
+      /// width get the same name, so their mesh is built once and shared.
+      /// \param[in] _points Points along the middle of the road.
+      /// \param[in] _width Width of the road.
+      /// \return Name made of a hash of the road.
+      public: static std::string RoadMeshName(
+                  const std::vector<ignition::math::Vector3d> &_points,
+                  double _width);
+
+      /// \brief Create an approximate convex decomposition of a mesh,
+      /// made of one closed triangle submesh per convex hull. Physics
+      /// engines collide with the hulls much faster than with the
+      /// triangles of the mesh. With GAZEBO_MESH_CACHE set, the hulls are
+      /// stored next to the cached meshes and computed only once.
+      /// \param[in] _name The name of the new mesh, see
+      /// ConvexDecompositionName.
+      /// \param[in] _mesh Mesh to decompose.
+      /// \param[in] _subMesh Name of the submesh to decompose, empty for
+      /// the whole mesh.
+      /// \param[in] _center True to center the submesh first.
+      /// \param[in] _maxHulls Maximum number of hulls.
+      /// \param[in] _maxConcavity How deep a part of the mesh may sink
+      /// below its hull, as a fraction of the diagonal of the mesh bounding
+      /// box.
+      public: void CreateConvexDecomposition(const std::string &_name,
+                  const Mesh *_mesh, const std::string &_subMesh,
+                  const bool _center, const unsigned int _maxHulls,
+                  const double _maxConcavity);
+
+      /// \brief Get a mesh name for a convex decomposition. It changes
+      /// with the parameters and, for meshes loaded from a file, with the
+      /// modification time and size of the file.
+      /// \param[in] _mesh Mesh to decompose.
+      /// \param[in] _subMesh Name of the submesh, empty for the whole mesh.
+      /// \param[in] _center True to center the submesh first.
+      /// \param[in] _maxHulls Maximum number of hulls.
+      /// \param[in] _maxConcavity Concavity threshold.
+      /// \return Name made of a hash of the definition.
+      public: static std::string ConvexDecompositionName(const Mesh *_mesh,
+                  const std::string &_subMesh, const bool _center,
+                  const unsigned int _maxHulls, const double _maxConcavity);
+
       /// \brief Create a cylinder mesh
       /// \param[in] _name the name of the new mesh
       /// \param[in] _radius the radius of the cylinder in the x y plane
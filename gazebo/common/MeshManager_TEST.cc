@@ -16,6 +16,9 @@
 */
 
 #include <gtest/gtest.h>
+#include <chrono>
+#include <cmath>
+#include <thread>
 
 #include "test_config.h"
 #include "gazebo/common/Mesh.hh"
@@ -266,6 +269,128 @@ TEST_F(MeshManager, CreateExtrudedPolylineInvalid)
   EXPECT_TRUE(!common::MeshManager::Instance()->HasMesh(meshName));
 }
 
+/////////////////////////////////////////////////
+TEST_F(MeshManager, Prefetch)
+{
+  common::MeshManager *mgr = common::MeshManager::Instance();
+  const std::string box =
+      std::string(PROJECT_SOURCE_PATH) + "/test/data/box.dae";
+  const std::string missing =
+      std::string(PROJECT_SOURCE_PATH) + "/test/data/no_such_mesh.dae";
+
+  // Duplicates are loaded once, missing files are skipped
+  std::vector<std::string> files = {box, box, missing};
+  mgr->Prefetch(files);
+  EXPECT_TRUE(mgr->HasMesh(box));
+  EXPECT_FALSE(mgr->HasMesh(missing));
+
+  // Load returns the prefetched mesh
+  const common::Mesh *mesh = mgr->GetMesh(box);
+  ASSERT_TRUE(mesh != nullptr);
+  EXPECT_EQ(mgr->Load(box), mesh);
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshManager, CreateRoad)
+{
+  common::MeshManager *mgr = common::MeshManager::Instance();
+
+  // An L shaped road, 2 m wide
+  std::vector<ignition::math::Vector3d> points = {
+      ignition::math::Vector3d(0, 0, 0),
+      ignition::math::Vector3d(10, 0, 0),
+      ignition::math::Vector3d(10, 10, 0)};
+  const std::string name = common::MeshManager::RoadMeshName(points, 2);
+
+  // The name only depends on the points and width
+  EXPECT_EQ(name, common::MeshManager::RoadMeshName(points, 2));
+  EXPECT_NE(name, common::MeshManager::RoadMeshName(points, 3));
+  points[1].Y() = 1;
+  EXPECT_NE(name, common::MeshManager::RoadMeshName(points, 2));
+  points[1].Y() = 0;
+
+  mgr->CreateRoad(name, points, 2);
+  const common::Mesh *mesh = mgr->GetMesh(name);
+  ASSERT_TRUE(mesh != nullptr);
+  ASSERT_EQ(1u, mesh->GetSubMeshCount());
+
+  // Two vertices per point, a strip with one triangle per vertex after
+  // the first two
+  const common::SubMesh *subMesh = mesh->GetSubMesh(0);
+  EXPECT_EQ(common::SubMesh::TRISTRIPS, subMesh->GetPrimitiveType());
+  EXPECT_EQ(6u, subMesh->GetVertexCount());
+  EXPECT_EQ(6u, subMesh->GetIndexCount());
+  EXPECT_EQ(6u, subMesh->GetNormalCount());
+  EXPECT_EQ(6u, subMesh->GetTexCoordCount());
+
+  // The ends are one width across, the corner is widened
+  EXPECT_NEAR(2.0, subMesh->Vertex(0).Distance(subMesh->Vertex(1)), 1e-6);
+  EXPECT_NEAR(2.0, subMesh->Vertex(4).Distance(subMesh->Vertex(5)), 1e-6);
+  EXPECT_NEAR(2.0 * sqrt(2.0),
+      subMesh->Vertex(2).Distance(subMesh->Vertex(3)), 1e-6);
+
+  // The texture repeats every width
+  EXPECT_DOUBLE_EQ(5.0, subMesh->TexCoord(2).Y());
+  EXPECT_DOUBLE_EQ(10.0, subMesh->TexCoord(4).Y());
+
+  // Building it again keeps the same mesh
+  mgr->CreateRoad(name, points, 2);
+  EXPECT_EQ(mesh, mgr->GetMesh(name));
+
+  // A road needs two points
+  std::vector<ignition::math::Vector3d> point = {points[0]};
+  const std::string pointName = common::MeshManager::RoadMeshName(point, 2);
+  mgr->CreateRoad(pointName, point, 2);
+  EXPECT_FALSE(mgr->HasMesh(pointName));
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshManager, RemoveUnreferenced)
+{
+  common::MeshManager *mgr = common::MeshManager::Instance();
+  const double retention = mgr->Retention();
+  mgr->SetRetention(-1);
+  EXPECT_DOUBLE_EQ(mgr->Retention(), -1);
+
+  const std::string filename =
+      std::string(PROJECT_SOURCE_PATH) + "/test/data/box.dae";
+  mgr->AddReference(filename);
+  ASSERT_TRUE(mgr->Load(filename) != nullptr);
+  EXPECT_TRUE(mgr->IsReloadable(filename));
+  EXPECT_FALSE(mgr->IsReloadable("unit_box"));
+
+  // Referenced meshes stay
+  mgr->AddReference(filename);
+  mgr->RemoveReference(filename);
+  EXPECT_EQ(mgr->RemoveUnreferenced(true), 0u);
+  EXPECT_TRUE(mgr->HasMesh(filename));
+
+  // Unreferenced meshes are kept forever with a negative retention
+  mgr->RemoveReference(filename);
+  EXPECT_EQ(mgr->RemoveUnreferenced(), 0u);
+  EXPECT_TRUE(mgr->HasMesh(filename));
+  EXPECT_EQ(mgr->RemoveUnreferenced(true), 1u);
+  EXPECT_FALSE(mgr->HasMesh(filename));
+  EXPECT_FALSE(mgr->IsReloadable(filename));
+
+  // Generated meshes can't be loaded again, so they stay
+  mgr->AddReference("unit_box");
+  mgr->RemoveReference("unit_box");
+  EXPECT_EQ(mgr->RemoveUnreferenced(true), 0u);
+  EXPECT_TRUE(mgr->HasMesh("unit_box"));
+
+  // The background thread removes meshes once the retention time is over
+  mgr->AddReference(filename);
+  ASSERT_TRUE(mgr->Load(filename) != nullptr);
+  mgr->RemoveReference(filename);
+  mgr->SetRetention(0);
+  for (int i = 0; i < 50 && mgr->HasMesh(filename); ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_FALSE(mgr->HasMesh(filename));
+
+  mgr->SetRetention(retention);
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
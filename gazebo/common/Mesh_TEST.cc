@@ -297,6 +297,51 @@ TEST_F(MeshTest, SubMeshCenter)
   EXPECT_EQ(ignition::math::Vector3d(3.46555, 0.180391, 2.8431), mesh->Min());
 }
 
+/////////////////////////////////////////////////
+// Test filling single precision vertex and index buffers.
+TEST_F(MeshTest, SubMeshFillBuffers)
+{
+  common::SubMesh submesh;
+  submesh.AddVertex(ignition::math::Vector3d(1, 2, 3));
+  submesh.AddVertex(ignition::math::Vector3d(4, 5, 6));
+  submesh.AddVertex(ignition::math::Vector3d(7, 8, 9));
+  submesh.AddNormal(ignition::math::Vector3d(0, 0, 1));
+  submesh.AddTexCoord(0.5, 0.25);
+  submesh.AddIndex(0);
+  submesh.AddIndex(1);
+  submesh.AddIndex(2);
+
+  float vertices[18];
+  submesh.FillVertexBuffer(vertices, true,
+      ignition::math::Vector3d(-1, -1, -1));
+  EXPECT_FLOAT_EQ(0.0f, vertices[0]);
+  EXPECT_FLOAT_EQ(1.0f, vertices[1]);
+  EXPECT_FLOAT_EQ(2.0f, vertices[2]);
+  EXPECT_FLOAT_EQ(1.0f, vertices[5]);
+  EXPECT_FLOAT_EQ(3.0f, vertices[6]);
+  // Missing normals are zero
+  EXPECT_FLOAT_EQ(0.0f, vertices[11]);
+  EXPECT_FLOAT_EQ(8.0f, vertices[14]);
+
+  float texCoords[6];
+  submesh.FillTexCoordBuffer(texCoords);
+  EXPECT_FLOAT_EQ(0.5f, texCoords[0]);
+  EXPECT_FLOAT_EQ(0.25f, texCoords[1]);
+  EXPECT_FLOAT_EQ(0.0f, texCoords[5]);
+
+  EXPECT_TRUE(submesh.IndicesFit16Bit());
+  uint16_t indices16[3];
+  submesh.FillIndexBuffer(indices16);
+  EXPECT_EQ(2u, indices16[2]);
+
+  submesh.AddIndex(70000);
+  EXPECT_FALSE(submesh.IndicesFit16Bit());
+  uint32_t indices32[4];
+  submesh.FillIndexBuffer(indices32);
+  EXPECT_EQ(1u, indices32[1]);
+  EXPECT_EQ(70000u, indices32[3]);
+}
+
 /////////////////////////////////////////////////
 // Test STL import
 TEST_F(MeshTest, STLRead)
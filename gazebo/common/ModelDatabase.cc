@@ -22,7 +22,14 @@
 #include <curl/curl.h>
 #include <fcntl.h>
 #include <sys/stat.h>
+#ifndef _WIN32
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+#include <cerrno>
 #include <iostream>
+#include <thread>
+#include <vector>
 
 #include <boost/algorithm/string/replace.hpp>
 #include <boost/bind/bind.hpp>
@@ -39,7 +46,9 @@
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/ModelDatabasePrivate.hh"
 #include "gazebo/common/ModelDatabase.hh"
+#include "gazebo/common/SamplingProfiler.hh"
 #include "gazebo/common/SemanticVersion.hh"
+#include "gazebo/common/StartupTrace.hh"
 
 using namespace gazebo;
 using namespace common;
@@ -65,6 +74,121 @@ size_t get_models_cb(void *_buffer, size_t _size, size_t _nmemb, void *_userp)
   return _size;
 }
 
+/////////////////////////////////////////////////
+/// \brief Exclusive lock on a file, held until destruction. The lock is
+/// shared between processes, and between threads that open the file
+/// separately, so concurrent servers can share the model cache.
+class ModelCacheLock
+{
+  /// \brief Constructor, blocks until the lock is acquired.
+  /// \param[in] _filename Lock file, created if needed.
+  public: explicit ModelCacheLock(const std::string &_filename)
+  {
+#ifndef _WIN32
+    this->fd = open(_filename.c_str(), O_RDWR | O_CREAT, 0644);
+    if (this->fd < 0)
+    {
+      gzwarn << "Unable to open lock file[" << _filename << "], "
+             << "the model cache isn't protected from other processes\n";
+      return;
+    }
+
+    while (flock(this->fd, LOCK_EX) != 0 && errno == EINTR)
+      continue;
+#endif
+  }
+
+  /// \brief Destructor, releases the lock.
+  public: ~ModelCacheLock()
+  {
+#ifndef _WIN32
+    if (this->fd >= 0)
+    {
+      flock(this->fd, LOCK_UN);
+      close(this->fd);
+    }
+#endif
+  }
+
+  /// \brief Descriptor of the lock file.
+  private: int fd = -1;
+};
+
+/////////////////////////////////////////////////
+/// \brief Get the curl handle of the calling thread. It is kept across
+/// downloads so that consecutive models reuse the connection to the
+/// database.
+/// \return The handle, null if curl failed to create it.
+static CURL *thread_curl()
+{
+  struct Handle
+  {
+    ~Handle()
+    {
+      if (this->curl)
+        curl_easy_cleanup(this->curl);
+    }
+    CURL *curl = curl_easy_init();
+  };
+  static thread_local Handle handle;
+  return handle.curl;
+}
+
+/////////////////////////////////////////////////
+/// \brief Download a URL to a file. If the file exists, only the rest of
+/// it is requested, so an interrupted download resumes where it stopped.
+/// \param[in] _url URL to download.
+/// \param[in] _filename Partial or new file.
+/// \return True if the file is complete.
+static bool download_resumable(const std::string &_url,
+    const std::string &_filename)
+{
+  CURL *curl = thread_curl();
+  if (!curl)
+  {
+    gzerr << "Unable to initialize libcurl\n";
+    return false;
+  }
+
+  boost::system::error_code ec;
+  curl_off_t offset = 0;
+  if (boost::filesystem::exists(_filename, ec))
+  {
+    auto size = boost::filesystem::file_size(_filename, ec);
+    if (!ec)
+      offset = static_cast<curl_off_t>(size);
+  }
+
+  FILE *fp = fopen(_filename.c_str(), offset > 0 ? "ab" : "wb");
+  if (!fp)
+  {
+    gzerr << "Unable to write to file[" << _filename << "]. "
+          << "Please fix file permissions.\n";
+    return false;
+  }
+
+  curl_easy_setopt(curl, CURLOPT_URL, _url.c_str());
+  curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_data);
+  curl_easy_setopt(curl, CURLOPT_WRITEDATA, fp);
+  curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+  curl_easy_setopt(curl, CURLOPT_FAILONERROR, 1L);
+  curl_easy_setopt(curl, CURLOPT_RESUME_FROM_LARGE, offset);
+  CURLcode success = curl_easy_perform(curl);
+
+  long status = 0;
+  curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &status);
+  fclose(fp);
+
+  if (success == CURLE_OK)
+    return true;
+
+  // The partial file can't be resumed, start over on the next attempt
+  if (offset > 0 && (success == CURLE_RANGE_ERROR || status == 416))
+    boost::filesystem::remove(_filename, ec);
+
+  return false;
+}
+
 /////////////////////////////////////////////////
 ModelDatabase::ModelDatabase()
   : dataPtr(new ModelDatabasePrivate)
@@ -274,6 +398,7 @@ bool ModelDatabase::UpdateModelCacheImpl()
 /////////////////////////////////////////////////
 void ModelDatabase::UpdateModelCache(bool _fetchImmediately)
 {
+  common::SetThreadName("ModelDatabase");
   boost::mutex::scoped_lock lock(this->dataPtr->updateMutex);
 
   // Continually update the model cache when requested.
@@ -409,6 +534,8 @@ std::string ModelDatabase::GetModelPath(const std::string &_uri,
 
   if (path.empty() || stat(path.c_str(), &st) != 0 )
   {
+    StartupTraceScope trace("ModelDatabase::GetModelPath", "model_db", _uri);
+
     if (!ModelDatabase::HasModel(_uri))
     {
       return std::string();
@@ -436,111 +563,156 @@ std::string ModelDatabase::GetModelPath(const std::string &_uri,
 
     modelName = modelName.substr(startIndex, modelNameLen);
 
-    // Store downloaded .tar.gz and intermediate .tar files in temp location
+    std::string outputPath = getenv("HOME");
+    outputPath += "/.gazebo/models";
+
+    boost::system::error_code ec;
+    boost::filesystem::create_directories(outputPath, ec);
+
+    // The intermediate .tar file is stored in a temp location
     boost::filesystem::path tmppath = boost::filesystem::temp_directory_path();
     tmppath /= boost::filesystem::unique_path("gz_model-%%%%-%%%%-%%%%-%%%%");
     std::string tarfilename = tmppath.string() + ".tar";
-    std::string tgzfilename = tarfilename + ".gz";
-
-    CURL *curl = curl_easy_init();
-    if (!curl)
-    {
-      gzerr << "Unable to initialize libcurl\n";
-      return std::string();
-    }
 
-    curl_easy_setopt(curl, CURLOPT_URL,
-        (ModelDatabase::GetURI() + "/" +
-         modelName + "/model.tar.gz").c_str());
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_data);
+    // The .tar.gz is kept next to the cache until it is complete, so an
+    // interrupted download resumes where it stopped
+    std::string tgzfilename = outputPath + "/." + modelName + ".tar.gz.part";
 
+    path = outputPath + "/" + modelName;
+    bool installed = false;
     bool retry = true;
-    int iterations = 0;
-    while (retry && iterations < 4)
     {
-      retry = false;
-      iterations++;
+      // Concurrent servers share the cache, only one of them installs a
+      // given model while the others wait for it
+      ModelCacheLock lock(outputPath + "/." + modelName + ".lock");
 
-      FILE *fp = fopen(tgzfilename.c_str(), "wb");
-      if (!fp)
+      if (!_forceDownload && boost::filesystem::exists(
+            boost::filesystem::path(path) / GZ_MODEL_MANIFEST_FILENAME))
       {
-        gzerr << "Could not download model[" << _uri << "] because we were"
-          << "unable to write to file[" << tgzfilename << "]."
-          << "Please fix file permissions.";
-        return std::string();
+        // Another process installed it while this one waited
+        retry = false;
       }
 
-      /// Download the model tarball
-      curl_easy_setopt(curl, CURLOPT_WRITEDATA, fp);
-      CURLcode success = curl_easy_perform(curl);
-
-      if (success != CURLE_OK)
+      int iterations = 0;
+      while (retry && iterations < 4)
       {
-        gzwarn << "Unable to connect to model database using ["
-               << _uri << "]\n";
-        retry = true;
-        continue;
-      }
+        retry = false;
+        iterations++;
 
-      fclose(fp);
+        /// Download the model tarball
+        if (!download_resumable(ModelDatabase::GetURI() + "/" +
+              modelName + "/model.tar.gz", tgzfilename))
+        {
+          gzwarn << "Unable to connect to model database using ["
+                 << _uri << "]\n";
+          retry = true;
+          continue;
+        }
 
-      try
-      {
-        // Unzip model tarball
-        std::ifstream file(tgzfilename.c_str(),
-            std::ios_base::in | std::ios_base::binary);
-        std::ofstream out(tarfilename.c_str(),
-            std::ios_base::out | std::ios_base::binary);
-        boost::iostreams::filtering_streambuf<boost::iostreams::input> in;
-        in.push(boost::iostreams::gzip_decompressor());
-        in.push(file);
-        boost::iostreams::copy(in, out);
-      }
-      catch(...)
-      {
-        gzerr << "Failed to unzip model tarball. Trying again...\n";
-        retry = true;
-        continue;
-      }
+        try
+        {
+          // Unzip model tarball
+          std::ifstream file(tgzfilename.c_str(),
+              std::ios_base::in | std::ios_base::binary);
+          std::ofstream out(tarfilename.c_str(),
+              std::ios_base::out | std::ios_base::binary);
+          boost::iostreams::filtering_streambuf<boost::iostreams::input> in;
+          in.push(boost::iostreams::gzip_decompressor());
+          in.push(file);
+          boost::iostreams::copy(in, out);
+        }
+        catch(...)
+        {
+          // The tarball is corrupt, download it again from the start
+          boost::filesystem::remove(tgzfilename, ec);
+          gzerr << "Failed to unzip model tarball. Trying again...\n";
+          retry = true;
+          continue;
+        }
 
-      std::string outputPath = getenv("HOME");
-      outputPath += "/.gazebo/models";
+        // Extract next to the cache and move the model in place once it is
+        // complete, so no process ever sees a partially extracted model
+        boost::filesystem::path staging = outputPath;
+        staging /= boost::filesystem::unique_path(".gz_extract-%%%%-%%%%");
+        boost::filesystem::create_directories(staging, ec);
 
 #ifndef _WIN32
-      TAR *tar;
-      tar_open(&tar, const_cast<char*>(tarfilename.c_str()),
-          nullptr, O_RDONLY, 0644, TAR_GNU);
-
-      tar_extract_all(tar, const_cast<char*>(outputPath.c_str()));
+        TAR *tar;
+        if (tar_open(&tar, const_cast<char*>(tarfilename.c_str()),
+            nullptr, O_RDONLY, 0644, TAR_GNU) == 0)
+        {
+          tar_extract_all(tar, const_cast<char*>(staging.string().c_str()));
+          tar_close(tar);
+        }
 #else
-      // Tar now is a built-in tool since Windows 10 build 17063.
-      std::string cmdline = "tar xzf \"";
-      cmdline += tarfilename + "\" -C \"";
-      cmdline += outputPath + "\"";
-      auto ret = system(cmdline.c_str());
-      if (ret != 0)
-      {
-        gzerr << "tar extract ret = " << ret << ", cmdline = " << cmdline
-              << std::endl;
-      }
+        // Tar now is a built-in tool since Windows 10 build 17063.
+        std::string cmdline = "tar xzf \"";
+        cmdline += tarfilename + "\" -C \"";
+        cmdline += staging.string() + "\"";
+        auto ret = system(cmdline.c_str());
+        if (ret != 0)
+        {
+          gzerr << "tar extract ret = " << ret << ", cmdline = " << cmdline
+                << std::endl;
+        }
 #endif
-      path = outputPath + "/" + modelName;
-      ModelDatabase::DownloadDependencies(path);
+
+        if (!boost::filesystem::exists(
+              staging / modelName / GZ_MODEL_MANIFEST_FILENAME))
+        {
+          boost::filesystem::remove_all(staging, ec);
+          boost::filesystem::remove(tgzfilename, ec);
+          gzerr << "Model tarball is missing " << GZ_MODEL_MANIFEST_FILENAME
+                << ". Trying again...\n";
+          retry = true;
+          continue;
+        }
+
+        boost::system::error_code renameEc;
+        boost::filesystem::remove_all(path, ec);
+        boost::filesystem::rename(staging / modelName, path, renameEc);
+        boost::filesystem::remove_all(staging, ec);
+        if (renameEc)
+        {
+          gzerr << "Unable to move model[" << modelName << "] into "
+                << outputPath << ": " << renameEc.message() << "\n";
+          break;
+        }
+
+        boost::filesystem::remove(tgzfilename, ec);
+        installed = true;
+      }
     }
 
-    curl_easy_cleanup(curl);
     if (retry)
     {
       gzerr << "Could not download model[" << _uri << "]."
         << "The model may be corrupt.\n";
       path.clear();
     }
+    else if (installed)
+    {
+      // The model directory is new, listings of the model path are stale
+      SystemPaths::Instance()->ClearFindFileCache();
+
+      // Outside of the lock, the dependencies may need other processes
+      ModelDatabase::DownloadDependencies(path);
+    }
+    else if (!boost::filesystem::exists(
+          boost::filesystem::path(path) / GZ_MODEL_MANIFEST_FILENAME))
+    {
+      path.clear();
+    }
+    else
+    {
+      // Installed by another process
+      SystemPaths::Instance()->ClearFindFileCache();
+    }
 
     // Clean up
     try
     {
       boost::filesystem::remove(tarfilename);
-      boost::filesystem::remove(tgzfilename);
     }
     catch(...)
     {
@@ -579,14 +751,14 @@ void ModelDatabase::DownloadDependencies(const std::string &_path)
     if (!dependXML)
       return;
 
+    std::vector<std::string> uris;
     for (TiXmlElement *depXML = dependXML->FirstChildElement("model");
          depXML; depXML = depXML->NextSiblingElement())
     {
       TiXmlElement *uriXML = depXML->FirstChildElement("uri");
-      if (uriXML)
+      if (uriXML && uriXML->GetText())
       {
-        // Download the model if it doesn't exist.
-        ModelDatabase::GetModelPath(uriXML->GetText());
+        uris.push_back(uriXML->GetText());
       }
       else
       {
@@ -594,6 +766,21 @@ void ModelDatabase::DownloadDependencies(const std::string &_path)
               << manifestPath << "]\n";
       }
     }
+
+    // Download the models that don't exist, each dependency on its own
+    // thread. Their own dependencies are fetched the same way.
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < uris.size(); ++i)
+    {
+      threads.emplace_back([this, &uris, i]
+      {
+        this->GetModelPath(uris[i]);
+      });
+    }
+    if (!uris.empty())
+      ModelDatabase::GetModelPath(uris[0]);
+    for (auto &thread : threads)
+      thread.join();
   }
   else
     gzerr << "Unable to load manifest file[" << manifestPath << "]\n";
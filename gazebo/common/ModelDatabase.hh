@@ -107,6 +107,9 @@ namespace gazebo
       ///
       /// Get the path to a model based on a URI. If the model is on
       /// a remote server, then the model fetched and installed locally.
+      /// Downloads resume where an interrupted one stopped, and servers
+      /// sharing ~/.gazebo/models wait for each other instead of
+      /// installing the same model twice.
       /// \param[in] _uri the model uri
       /// \param[in] _forceDownload True to skip searching local paths.
       /// \return path to a model directory
@@ -125,7 +128,7 @@ namespace gazebo
       ///
       /// Look's in the model's manifest file (_path/model.config)
       /// for all models listed in the <depend> block, and downloads the
-      /// models if necessary.
+      /// models if necessary, each on its own thread.
       /// \param[in] _path Path to a model.
       public: void DownloadDependencies(const std::string &_path);
 
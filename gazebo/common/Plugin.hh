@@ -27,6 +27,7 @@
 #include <gazebo/gazebo_config.h>
 #include <dlfcn.h>
 
+#include <chrono>
 #include <list>
 #include <string>
 
@@ -37,6 +38,7 @@
 #include "gazebo/common/SystemPaths.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Exception.hh"
+#include "gazebo/common/PluginLibrary.hh"
 
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/sensors/SensorTypes.hh"
@@ -117,44 +119,20 @@ namespace gazebo
               TPtr result;
               // PluginPtr result;
               std::string filename(_filename);
-              std::list<std::string> pluginPaths =
-                common::SystemPaths::Instance()->GetPluginPaths();
               std::ostringstream errorStream;
 
-              // helper function to find and dlopen a plugin file
+              // helper function to find and dlopen a plugin file, or get
+              // its handle if it is already loaded
               // returns void * dlHandle
               auto findAndDlopenPluginFile = [](
                   const std::string &_pluginFilename,
-                  const std::list<std::string> &_pluginPaths,
                   std::ostringstream &_errorStream) -> void *
               {
-                struct stat st;
-                bool found = false;
-                std::string fullname;
-                std::list<std::string>::const_iterator iter;
-
-                for (iter = _pluginPaths.begin();
-                     iter!= _pluginPaths.end(); ++iter)
-                {
-                  fullname = (*iter)+std::string("/")+_pluginFilename;
-                  fullname = boost::filesystem::path(fullname)
-                      .make_preferred().string();
-                  if (stat(fullname.c_str(), &st) == 0)
-                  {
-                    found = true;
-                    break;
-                  }
-                }
-
-                if (!found)
-                  fullname = _pluginFilename;
-
-                void *dlHandle = dlopen(fullname.c_str(), RTLD_LAZY|RTLD_GLOBAL);
+                std::string error;
+                void *dlHandle =
+                    common::PluginLibrary::Open(_pluginFilename, error);
                 if (!dlHandle)
-                {
-                  _errorStream << "Failed to load plugin " << fullname << ": "
-                    << dlerror() << "\n";
-                }
+                  _errorStream << error;
                 return dlHandle;
               };
 
@@ -190,8 +168,7 @@ namespace gazebo
               // Linux: lib*.so
               // macOS: lib*.so
               // Windows: *.dll
-              void *dlHandle = findAndDlopenPluginFile(filename, pluginPaths,
-                                                       errorStream);
+              void *dlHandle = findAndDlopenPluginFile(filename, errorStream);
 #ifdef __APPLE__
               if (!dlHandle)
               {
@@ -204,7 +181,7 @@ namespace gazebo
                 }
               }
               // macOS: lib*.dylib
-              dlHandle = findAndDlopenPluginFile(filename, pluginPaths, errorStream);
+              dlHandle = findAndDlopenPluginFile(filename, errorStream);
 #endif  // ifdef __APPLE__
 
               if (!dlHandle)
@@ -214,19 +191,22 @@ namespace gazebo
               }
 
               fptr_union_t registerFunc;
-              const char *registerName = "RegisterPlugin";
-
-              registerFunc.ptr = dlsym(dlHandle, registerName);
+              std::string error;
+              registerFunc.ptr = common::PluginLibrary::Symbol(filename,
+                  "RegisterPlugin", error);
 
               if (!registerFunc.ptr)
               {
-                gzerr << "Failed to resolve " << registerName
-                      << ": " << dlerror();
+                gzerr << error;
                 return result;
               }
 
               // Register the new controller.
+              auto start = std::chrono::steady_clock::now();
               result.reset(registerFunc.func());
+              common::PluginLibrary::AddInstance(filename,
+                  std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  std::chrono::steady_clock::now() - start).count());
               result->dlHandle = dlHandle;
 
               result->handleName = _name;
@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <dlfcn.h>
+
+#include <chrono>
+#include <list>
+#include <map>
+#include <mutex>
+
+#include <boost/filesystem.hpp>
+
+#include "gazebo/common/PluginLibrary.hh"
+#include "gazebo/common/SystemPaths.hh"
+
+using namespace gazebo;
+using namespace common;
+
+namespace
+{
+  /// \brief A loaded library.
+  class Library
+  {
+    /// \brief Handle returned by dlopen.
+    public: void *handle = nullptr;
+
+    /// \brief Plugin paths the library was searched for on.
+    public: std::list<std::string> pluginPaths;
+
+    /// \brief Resolved symbols, by name.
+    public: std::map<std::string, void *> symbols;
+
+    /// \brief Time spent loading the library and creating its plugins.
+    public: PluginLibraryTiming timing;
+  };
+
+  /// \brief Protects g_libraries.
+  std::mutex g_librariesMutex;
+
+  /// \brief Loaded libraries, by the file name they were requested with.
+  std::map<std::string, Library> g_libraries;
+
+  /// \brief Get the nanoseconds elapsed since a time point.
+  /// \param[in] _start The time point.
+  /// \return Elapsed time.
+  uint64_t Elapsed(const std::chrono::steady_clock::time_point &_start)
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - _start).count();
+  }
+}
+
+//////////////////////////////////////////////////
+void *PluginLibrary::Open(const std::string &_filename, std::string &_error)
+{
+  std::lock_guard<std::mutex> lock(g_librariesMutex);
+
+  const std::list<std::string> &pluginPaths =
+      SystemPaths::Instance()->GetPluginPaths();
+
+  auto iter = g_libraries.find(_filename);
+  if (iter != g_libraries.end() && iter->second.pluginPaths == pluginPaths)
+    return iter->second.handle;
+
+  auto start = std::chrono::steady_clock::now();
+  struct stat st;
+  bool found = false;
+  std::string fullname;
+  for (auto const &path : pluginPaths)
+  {
+    fullname = boost::filesystem::path(path + "/" + _filename)
+        .make_preferred().string();
+    if (stat(fullname.c_str(), &st) == 0)
+    {
+      found = true;
+      break;
+    }
+  }
+
+  if (!found)
+    fullname = _filename;
+  uint64_t resolveTime = Elapsed(start);
+
+  start = std::chrono::steady_clock::now();
+  void *handle = dlopen(fullname.c_str(), RTLD_LAZY|RTLD_GLOBAL);
+  uint64_t openTime = Elapsed(start);
+
+  // Failures are not cached, the library may show up later
+  if (!handle)
+  {
+    _error = "Failed to load plugin " + fullname + ": " + dlerror() + "\n";
+    return nullptr;
+  }
+
+  Library &library = g_libraries[_filename];
+  if (library.handle != handle)
+    library.symbols.clear();
+  library.handle = handle;
+  library.pluginPaths = pluginPaths;
+  library.timing.filename = _filename;
+  library.timing.path = fullname;
+  library.timing.resolveTime += resolveTime;
+  library.timing.openTime += openTime;
+  return handle;
+}
+
+//////////////////////////////////////////////////
+void *PluginLibrary::Symbol(const std::string &_filename,
+    const std::string &_symbol, std::string &_error)
+{
+  std::lock_guard<std::mutex> lock(g_librariesMutex);
+
+  auto iter = g_libraries.find(_filename);
+  if (iter == g_libraries.end())
+  {
+    _error = "Plugin library " + _filename + " is not loaded\n";
+    return nullptr;
+  }
+
+  Library &library = iter->second;
+  auto symbol = library.symbols.find(_symbol);
+  if (symbol != library.symbols.end())
+    return symbol->second;
+
+  auto start = std::chrono::steady_clock::now();
+  void *ptr = dlsym(library.handle, _symbol.c_str());
+  library.timing.symbolTime += Elapsed(start);
+
+  if (!ptr)
+  {
+    _error = "Failed to resolve " + _symbol + ": " + dlerror();
+    return nullptr;
+  }
+
+  library.symbols[_symbol] = ptr;
+  return ptr;
+}
+
+//////////////////////////////////////////////////
+void PluginLibrary::AddInstance(const std::string &_filename,
+    const uint64_t _nsec)
+{
+  std::lock_guard<std::mutex> lock(g_librariesMutex);
+
+  auto iter = g_libraries.find(_filename);
+  if (iter == g_libraries.end())
+    return;
+
+  ++iter->second.timing.instances;
+  iter->second.timing.createTime += _nsec;
+}
+
+//////////////////////////////////////////////////
+std::vector<PluginLibraryTiming> PluginLibrary::Timings()
+{
+  std::vector<PluginLibraryTiming> timings;
+  std::lock_guard<std::mutex> lock(g_librariesMutex);
+  timings.reserve(g_libraries.size());
+  for (auto const &library : g_libraries)
+    timings.push_back(library.second.timing);
+  return timings;
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_PLUGINLIBRARY_HH_
+#define GAZEBO_COMMON_PLUGINLIBRARY_HH_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \addtogroup gazebo_common
+    /// \{
+
+    /// \class PluginLibraryTiming PluginLibrary.hh common/common.hh
+    /// \brief Where the time went while creating the plugins of one
+    /// library. Times are in nanoseconds and cumulative.
+    class GZ_COMMON_VISIBLE PluginLibraryTiming
+    {
+      /// \brief File name the library was requested with.
+      public: std::string filename;
+
+      /// \brief Path the library was loaded from.
+      public: std::string path;
+
+      /// \brief Number of plugins created from the library.
+      public: uint64_t instances = 0;
+
+      /// \brief Time spent searching the plugin paths.
+      public: uint64_t resolveTime = 0;
+
+      /// \brief Time spent in dlopen.
+      public: uint64_t openTime = 0;
+
+      /// \brief Time spent in dlsym.
+      public: uint64_t symbolTime = 0;
+
+      /// \brief Time spent in the registration function, i.e. in the
+      /// constructors of the plugins.
+      public: uint64_t createTime = 0;
+    };
+
+    /// \class PluginLibrary PluginLibrary.hh common/common.hh
+    /// \brief Registry of the plugin libraries loaded by the process.
+    ///
+    /// A library is searched for on the plugin paths and opened the first
+    /// time it is requested, and its symbols are resolved once. Later
+    /// requests, e.g. from other instances of the same plugin or after the
+    /// world is reloaded, reuse the handle. The search is done again if
+    /// the plugin paths change. Libraries are never closed, see PluginT.
+    class GZ_COMMON_VISIBLE PluginLibrary
+    {
+      /// \brief Get the handle of a library, loading it if needed.
+      /// \param[in] _filename Name of the library, searched for on the
+      /// plugin paths, or a path.
+      /// \param[out] _error Reason of the failure, if any.
+      /// \return The handle, null on failure.
+      public: static void *Open(const std::string &_filename,
+                                std::string &_error);
+
+      /// \brief Get the address of a symbol of a library opened with
+      /// Open().
+      /// \param[in] _filename Name the library was opened with.
+      /// \param[in] _symbol Name of the symbol.
+      /// \param[out] _error Reason of the failure, if any.
+      /// \return The address, null on failure.
+      public: static void *Symbol(const std::string &_filename,
+                                  const std::string &_symbol,
+                                  std::string &_error);
+
+      /// \brief Account for the creation of a plugin.
+      /// \param[in] _filename Name the library was opened with.
+      /// \param[in] _nsec Time spent in the registration function.
+      public: static void AddInstance(const std::string &_filename,
+                                      const uint64_t _nsec);
+
+      /// \brief Get the timing of every library loaded, sorted by file
+      /// name.
+      /// \return The timings.
+      public: static std::vector<PluginLibraryTiming> Timings();
+    };
+
+    /// \}
+  }
+}
+#endif
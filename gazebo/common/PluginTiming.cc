@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstdlib>
+#include <map>
+#include <mutex>
+
+#include "gazebo/common/PluginTiming.hh"
+
+using namespace gazebo;
+using namespace common;
+
+namespace
+{
+  /// \brief Whether callbacks are timed.
+  std::atomic<bool> g_enabled(std::getenv("GAZEBO_PLUGIN_TIMING") != nullptr);
+
+  /// \brief Protects g_timings.
+  std::mutex g_timingsMutex;
+
+  /// \brief Timing of each plugin, by name.
+  std::map<std::string, std::shared_ptr<PluginTiming>> g_timings;
+
+  /// \brief Plugin of the innermost scope of the thread.
+  thread_local std::shared_ptr<PluginTiming> t_current;
+}
+
+//////////////////////////////////////////////////
+PluginTiming::PluginTiming(const std::string &_name)
+  : name(_name)
+{
+}
+
+//////////////////////////////////////////////////
+const std::string &PluginTiming::Name() const
+{
+  return this->name;
+}
+
+//////////////////////////////////////////////////
+void PluginTiming::Add(const uint64_t _nsec)
+{
+  this->calls.fetch_add(1, std::memory_order_relaxed);
+  this->total.fetch_add(_nsec, std::memory_order_relaxed);
+
+  uint64_t prev = this->max.load(std::memory_order_relaxed);
+  while (prev < _nsec && !this->max.compare_exchange_weak(prev, _nsec,
+      std::memory_order_relaxed))
+  {
+  }
+}
+
+//////////////////////////////////////////////////
+uint64_t PluginTiming::Calls() const
+{
+  return this->calls.load(std::memory_order_relaxed);
+}
+
+//////////////////////////////////////////////////
+uint64_t PluginTiming::TotalTime() const
+{
+  return this->total.load(std::memory_order_relaxed);
+}
+
+//////////////////////////////////////////////////
+uint64_t PluginTiming::MaxTime() const
+{
+  return this->max.load(std::memory_order_relaxed);
+}
+
+//////////////////////////////////////////////////
+bool PluginTiming::Enabled()
+{
+  return g_enabled.load(std::memory_order_relaxed);
+}
+
+//////////////////////////////////////////////////
+void PluginTiming::SetEnabled(const bool _enable)
+{
+  g_enabled = _enable;
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<PluginTiming> PluginTiming::Get(const std::string &_name)
+{
+  std::lock_guard<std::mutex> lock(g_timingsMutex);
+  auto &timing = g_timings[_name];
+  if (!timing)
+    timing = std::make_shared<PluginTiming>(_name);
+  return timing;
+}
+
+//////////////////////////////////////////////////
+std::vector<std::shared_ptr<PluginTiming>> PluginTiming::All()
+{
+  std::vector<std::shared_ptr<PluginTiming>> all;
+  std::lock_guard<std::mutex> lock(g_timingsMutex);
+  all.reserve(g_timings.size());
+  for (auto const &timing : g_timings)
+    all.push_back(timing.second);
+  return all;
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<PluginTiming> PluginTiming::Current()
+{
+  return t_current;
+}
+
+//////////////////////////////////////////////////
+PluginTimingScope::PluginTimingScope(const std::string &_name)
+  : previous(t_current)
+{
+  t_current = PluginTiming::Get(_name);
+}
+
+//////////////////////////////////////////////////
+PluginTimingScope::~PluginTimingScope()
+{
+  t_current = this->previous;
+}
@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_PLUGINTIMING_HH_
+#define GAZEBO_COMMON_PLUGINTIMING_HH_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \addtogroup gazebo_common
+    /// \{
+
+    /// \class PluginTiming PluginTiming.hh common/common.hh
+    /// \brief Wall time spent in the event callbacks of one plugin.
+    ///
+    /// Callbacks connected to an event while a PluginTimingScope is alive
+    /// on the connecting thread are attributed to the plugin of the scope.
+    /// World and model plugins are loaded inside such a scope. Timing is
+    /// off by default, turn it on with SetEnabled or by setting the
+    /// GAZEBO_PLUGIN_TIMING environment variable.
+    class GZ_COMMON_VISIBLE PluginTiming
+    {
+      /// \brief Constructor.
+      /// \param[in] _name Name of the plugin.
+      public: explicit PluginTiming(const std::string &_name);
+
+      /// \brief Get the name of the plugin.
+      /// \return The name.
+      public: const std::string &Name() const;
+
+      /// \brief Account for one callback.
+      /// \param[in] _nsec Duration of the callback in nanoseconds.
+      public: void Add(const uint64_t _nsec);
+
+      /// \brief Get the number of callbacks timed.
+      /// \return Callback count.
+      public: uint64_t Calls() const;
+
+      /// \brief Get the cumulative time of the callbacks.
+      /// \return Time in nanoseconds.
+      public: uint64_t TotalTime() const;
+
+      /// \brief Get the time of the longest callback.
+      /// \return Time in nanoseconds.
+      public: uint64_t MaxTime() const;
+
+      /// \brief Check whether callbacks are timed.
+      /// \return True if enabled.
+      public: static bool Enabled();
+
+      /// \brief Turn timing of the callbacks on or off.
+      /// \param[in] _enable True to time the callbacks.
+      public: static void SetEnabled(const bool _enable);
+
+      /// \brief Get the timing of a plugin, creating it if needed.
+      /// \param[in] _name Name of the plugin.
+      /// \return The timing, shared by every plugin of that name.
+      public: static std::shared_ptr<PluginTiming> Get(
+                  const std::string &_name);
+
+      /// \brief Get the timing of every plugin, sorted by name.
+      /// \return All the timings.
+      public: static std::vector<std::shared_ptr<PluginTiming>> All();
+
+      /// \brief Get the plugin that connections made by the calling thread
+      /// are attributed to.
+      /// \return The timing of the plugin of the innermost
+      /// PluginTimingScope, null outside of one.
+      public: static std::shared_ptr<PluginTiming> Current();
+
+      /// \brief Name of the plugin.
+      private: std::string name;
+
+      /// \brief Number of callbacks timed.
+      private: std::atomic<uint64_t> calls{0};
+
+      /// \brief Cumulative time in nanoseconds.
+      private: std::atomic<uint64_t> total{0};
+
+      /// \brief Longest callback in nanoseconds.
+      private: std::atomic<uint64_t> max{0};
+    };
+
+    /// \class PluginTimingScope PluginTiming.hh common/common.hh
+    /// \brief Attributes the event connections made by the calling thread
+    /// to a plugin while alive.
+    class GZ_COMMON_VISIBLE PluginTimingScope
+    {
+      /// \brief Constructor.
+      /// \param[in] _name Name of the plugin.
+      public: explicit PluginTimingScope(const std::string &_name);
+
+      /// \brief Destructor, restores the enclosing scope.
+      public: ~PluginTimingScope();
+
+      /// \brief Timing of the enclosing scope.
+      private: std::shared_ptr<PluginTiming> previous;
+    };
+
+    /// \class CallbackTimer PluginTiming.hh common/common.hh
+    /// \brief Times the callback that runs during its lifetime, if timing
+    /// is enabled.
+    class CallbackTimer
+    {
+      /// \brief Constructor.
+      /// \param[in] _timing Plugin to account the callback to, may be null.
+      public: explicit CallbackTimer(PluginTiming *_timing)
+              : timing(_timing && PluginTiming::Enabled() ? _timing : nullptr)
+      {
+        if (this->timing)
+          this->start = std::chrono::steady_clock::now();
+      }
+
+      /// \brief Destructor.
+      public: ~CallbackTimer()
+      {
+        if (this->timing)
+        {
+          this->timing->Add(std::chrono::duration_cast<
+              std::chrono::nanoseconds>(
+              std::chrono::steady_clock::now() - this->start).count());
+        }
+      }
+
+      /// \brief Plugin to account the callback to, null if not timed.
+      private: PluginTiming *timing;
+
+      /// \brief Start of the callback.
+      private: std::chrono::steady_clock::time_point start;
+    };
+
+    /// \}
+  }
+}
+#endif
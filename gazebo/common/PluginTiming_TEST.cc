@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "gazebo/common/Event.hh"
+#include "gazebo/common/PluginTiming.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+using namespace common;
+
+class PluginTimingTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(PluginTimingTest, Add)
+{
+  PluginTiming timing("plugin");
+  EXPECT_EQ(timing.Name(), "plugin");
+  EXPECT_EQ(timing.Calls(), 0u);
+
+  timing.Add(300);
+  timing.Add(100);
+  EXPECT_EQ(timing.Calls(), 2u);
+  EXPECT_EQ(timing.TotalTime(), 400u);
+  EXPECT_EQ(timing.MaxTime(), 300u);
+}
+
+/////////////////////////////////////////////////
+TEST_F(PluginTimingTest, Scope)
+{
+  EXPECT_EQ(PluginTiming::Current(), nullptr);
+  {
+    PluginTimingScope outer("outer");
+    ASSERT_NE(PluginTiming::Current(), nullptr);
+    EXPECT_EQ(PluginTiming::Current()->Name(), "outer");
+    {
+      PluginTimingScope inner("inner");
+      EXPECT_EQ(PluginTiming::Current()->Name(), "inner");
+    }
+    EXPECT_EQ(PluginTiming::Current()->Name(), "outer");
+  }
+  EXPECT_EQ(PluginTiming::Current(), nullptr);
+
+  // Plugins of the same name share their timing
+  EXPECT_EQ(PluginTiming::Get("outer"), PluginTiming::Get("outer"));
+}
+
+/////////////////////////////////////////////////
+TEST_F(PluginTimingTest, EventCallbacks)
+{
+  PluginTiming::SetEnabled(true);
+
+  event::EventT<void (int)> evt;
+  int sum = 0;
+  auto callback = [&sum](int _v) { sum += _v; };
+
+  event::ConnectionPtr timed;
+  {
+    PluginTimingScope scope("timed_plugin");
+    timed = evt.Connect(callback);
+  }
+  event::ConnectionPtr untimed = evt.Connect(callback);
+
+  evt(1);
+  evt(2);
+  EXPECT_EQ(sum, 6);
+
+  auto timing = PluginTiming::Get("timed_plugin");
+  EXPECT_EQ(timing->Calls(), 2u);
+  EXPECT_GE(timing->TotalTime(), timing->MaxTime());
+
+  // Disabled timing leaves the counters alone
+  PluginTiming::SetEnabled(false);
+  evt(3);
+  EXPECT_EQ(timing->Calls(), 2u);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
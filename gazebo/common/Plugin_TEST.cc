@@ -102,6 +102,33 @@ TEST_F(PluginTest, LoadVisualPlugin)
   EXPECT_EQ(plugin->GetHandle(), "pluginInterfaceTest");
 }
 
+TEST_F(PluginTest, LibraryLoadedOnce)
+{
+  ModelPluginPtr first = ModelPlugin::Create("libBuoyancyPlugin.so",
+                                             "first");
+  ModelPluginPtr second = ModelPlugin::Create("libBuoyancyPlugin.so",
+                                              "second");
+  ASSERT_TRUE(first != nullptr);
+  ASSERT_TRUE(second != nullptr);
+  EXPECT_NE(first, second);
+
+  // Both plugins come from the same library entry
+  bool found = false;
+  for (auto const &timing : common::PluginLibrary::Timings())
+  {
+    if (timing.filename != expectedFilename("BuoyancyPlugin"))
+      continue;
+    found = true;
+    EXPECT_GE(timing.instances, 2u);
+    EXPECT_FALSE(timing.path.empty());
+  }
+  EXPECT_TRUE(found);
+
+  std::string error;
+  EXPECT_EQ(common::PluginLibrary::Open("libDoesNotExist.so", error),
+      nullptr);
+  EXPECT_FALSE(error.empty());
+}
 
 // TODO: The following test actually fails due to current unsafe implementation
 // of plugin loading.
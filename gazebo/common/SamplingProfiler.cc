@@ -0,0 +1,439 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifdef __linux__
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/syscall.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <utility>
+
+#include "ignition/common/Profiler.hh"
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/SamplingProfiler.hh"
+
+using namespace gazebo;
+using namespace common;
+
+namespace
+{
+#ifdef __linux__
+  /// \brief Protects g_threadNames.
+  std::mutex g_namesMutex;
+
+  /// \brief Names given to SetThreadName, by kernel thread id.
+  std::map<int64_t, std::string> g_threadNames;
+
+  /// \brief Deepest call stack recorded.
+  const int kMaxFrames = 32;
+
+  /// \brief Frames of the signal handler at the top of every stack.
+  const int kHandlerFrames = 2;
+
+  /// \brief One call stack, written by the signal handler.
+  struct Sample
+  {
+    /// \brief True once the handler is done with the sample.
+    std::atomic<bool> ready;
+
+    /// \brief CLOCK_MONOTONIC time in nanoseconds.
+    int64_t time;
+
+    /// \brief Kernel id of the sampled thread.
+    int64_t tid;
+
+    /// \brief Number of frames.
+    int depth;
+
+    /// \brief Return addresses, innermost first.
+    void *frames[kMaxFrames];
+  };
+
+  /// \brief Serializes Start and Stop.
+  std::mutex g_controlMutex;
+
+  /// \brief Preallocated samples, the handler cannot allocate.
+  std::unique_ptr<Sample[]> g_samples;
+
+  /// \brief Size of g_samples.
+  unsigned int g_maxSamples = 0;
+
+  /// \brief Index of the next free sample, may exceed g_maxSamples.
+  std::atomic<unsigned int> g_nextSample(0);
+
+  /// \brief True while sampling.
+  std::atomic<bool> g_running(false);
+
+  /// \brief Number of signal handlers running.
+  std::atomic<int> g_inHandler(0);
+
+  /// \brief Output file.
+  std::string g_filename;
+
+  /// \brief Time sampling started, in nanoseconds.
+  int64_t g_startTime = 0;
+
+  /// \brief SIGPROF action in place before Start.
+  struct sigaction g_previousAction;
+
+  /// \brief Get the kernel id of the calling thread. Async-signal-safe.
+  /// \return Thread id.
+  int64_t currentTid()
+  {
+    return static_cast<int64_t>(syscall(SYS_gettid));
+  }
+
+  /// \brief Get CLOCK_MONOTONIC. Async-signal-safe.
+  /// \return Time in nanoseconds.
+  int64_t monotonicNsec()
+  {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+  }
+
+  /// \brief SIGPROF handler, records the stack of the interrupted thread.
+  void onSample(int, siginfo_t *, void *)
+  {
+    const int savedErrno = errno;
+    ++g_inHandler;
+    if (g_running)
+    {
+      const unsigned int index =
+          g_nextSample.fetch_add(1, std::memory_order_relaxed);
+      if (index < g_maxSamples)
+      {
+        Sample &sample = g_samples[index];
+        sample.time = monotonicNsec();
+        sample.tid = currentTid();
+        sample.depth = backtrace(sample.frames, kMaxFrames);
+        sample.ready.store(true, std::memory_order_release);
+      }
+    }
+    --g_inHandler;
+    errno = savedErrno;
+  }
+
+  /// \brief Escape a string for JSON.
+  /// \param[in] _str String to escape.
+  /// \return Escaped string, without quotes.
+  std::string jsonEscape(const std::string &_str)
+  {
+    std::string out;
+    out.reserve(_str.size());
+    for (const char c : _str)
+    {
+      if (c == '"' || c == '\\')
+      {
+        out += '\\';
+        out += c;
+      }
+      else if (static_cast<unsigned char>(c) < 0x20)
+        out += ' ';
+      else
+        out += c;
+    }
+    return out;
+  }
+
+  /// \brief Find the function and module of a return address.
+  /// \param[in] _addr The address.
+  /// \return Demangled function name and module file name.
+  std::pair<std::string, std::string> symbolize(void *_addr)
+  {
+    Dl_info info;
+    if (!dladdr(_addr, &info))
+    {
+      std::ostringstream stream;
+      stream << _addr;
+      return {stream.str(), "unknown"};
+    }
+
+    std::string module = info.dli_fname ? info.dli_fname : "unknown";
+    const size_t slash = module.rfind('/');
+    if (slash != std::string::npos)
+      module = module.substr(slash + 1);
+
+    if (!info.dli_sname)
+    {
+      std::ostringstream stream;
+      stream << module << "+0x" << std::hex <<
+        (reinterpret_cast<uintptr_t>(_addr) -
+         reinterpret_cast<uintptr_t>(info.dli_fbase));
+      return {stream.str(), module};
+    }
+
+    int status = 0;
+    char *demangled =
+        abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+    std::string name = (status == 0 && demangled) ? demangled : info.dli_sname;
+    std::free(demangled);
+    return {name, module};
+  }
+
+  /// \brief Get the name of a thread.
+  /// \param[in] _tid Kernel thread id.
+  /// \return Name given to SetThreadName, else the name known to the
+  /// kernel, else the id.
+  std::string threadName(const int64_t _tid)
+  {
+    {
+      std::lock_guard<std::mutex> lock(g_namesMutex);
+      auto iter = g_threadNames.find(_tid);
+      if (iter != g_threadNames.end())
+        return iter->second;
+    }
+
+    std::ifstream comm("/proc/self/task/" + std::to_string(_tid) + "/comm");
+    std::string name;
+    if (comm && std::getline(comm, name) && !name.empty())
+      return name;
+
+    return "thread " + std::to_string(_tid);
+  }
+
+  /// \brief Write the samples as a Chrome trace.
+  /// \param[in] _count Number of samples taken.
+  /// \return True on success.
+  bool writeTrace(const unsigned int _count)
+  {
+    std::ofstream out(g_filename);
+    if (!out)
+    {
+      gzerr << "Unable to write sampling profile [" << g_filename << "]\n";
+      return false;
+    }
+
+    // Stack frames form a tree, a node per distinct (parent, address)
+    std::map<std::pair<int, void *>, int> frameIds;
+    std::map<void *, std::pair<std::string, std::string>> symbols;
+    std::ostringstream frames;
+    std::ostringstream samples;
+    std::map<int64_t, bool> tids;
+    bool firstFrame = true;
+    bool firstSample = true;
+
+    for (unsigned int i = 0; i < _count; ++i)
+    {
+      const Sample &sample = g_samples[i];
+      if (!sample.ready.load(std::memory_order_acquire) ||
+          sample.depth <= kHandlerFrames)
+      {
+        continue;
+      }
+
+      int parent = 0;
+      for (int f = sample.depth - 1; f >= kHandlerFrames; --f)
+      {
+        void *addr = sample.frames[f];
+        auto key = std::make_pair(parent, addr);
+        auto iter = frameIds.find(key);
+        if (iter == frameIds.end())
+        {
+          const int id = static_cast<int>(frameIds.size()) + 1;
+          iter = frameIds.emplace(key, id).first;
+
+          auto sym = symbols.find(addr);
+          if (sym == symbols.end())
+            sym = symbols.emplace(addr, symbolize(addr)).first;
+
+          frames << (firstFrame ? "\n" : ",\n") << "\"" << id
+            << "\":{\"name\":\"" << jsonEscape(sym->second.first)
+            << "\",\"category\":\"" << jsonEscape(sym->second.second)
+            << "\"";
+          if (parent)
+            frames << ",\"parent\":\"" << parent << "\"";
+          frames << "}";
+          firstFrame = false;
+        }
+        parent = iter->second;
+      }
+
+      tids[sample.tid] = true;
+      samples << (firstSample ? "\n" : ",\n") << "{\"cpu\":0,\"tid\":"
+        << sample.tid << ",\"ts\":" << (sample.time - g_startTime) / 1000.0
+        << ",\"name\":\"cpu\",\"sf\":" << parent << ",\"weight\":1}";
+      firstSample = false;
+    }
+
+    const int pid = getpid();
+    out << "{\"traceEvents\":[";
+    bool firstEvent = true;
+    for (auto const &tid : tids)
+    {
+      out << (firstEvent ? "\n" : ",\n")
+        << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":" << pid
+        << ",\"tid\":" << tid.first << ",\"args\":{\"name\":\""
+        << jsonEscape(threadName(tid.first)) << "\"}}";
+      firstEvent = false;
+    }
+    out << "],\n\"samples\":[" << samples.str() << "],\n\"stackFrames\":{"
+      << frames.str() << "},\n\"displayTimeUnit\":\"ms\"}\n";
+
+    if (!out)
+    {
+      gzerr << "Unable to write sampling profile [" << g_filename << "]\n";
+      return false;
+    }
+    return true;
+  }
+#endif
+}
+
+//////////////////////////////////////////////////
+void common::SetThreadName(const std::string &_name)
+{
+  IGN_PROFILE_THREAD_NAME(_name.c_str());
+
+#ifdef __linux__
+  // The kernel keeps 15 characters
+  pthread_setname_np(pthread_self(), _name.substr(0, 15).c_str());
+
+  std::lock_guard<std::mutex> lock(g_namesMutex);
+  g_threadNames[currentTid()] = _name;
+#endif
+}
+
+//////////////////////////////////////////////////
+bool SamplingProfiler::Start(const std::string &_filename,
+    const unsigned int _frequency, const unsigned int _maxSamples)
+{
+#ifdef __linux__
+  std::lock_guard<std::mutex> lock(g_controlMutex);
+  if (g_running)
+  {
+    gzerr << "The sampling profiler is already running\n";
+    return false;
+  }
+
+  if (_frequency == 0 || _maxSamples == 0)
+  {
+    gzerr << "Invalid sampling frequency or sample count\n";
+    return false;
+  }
+
+  g_samples.reset(new Sample[_maxSamples]());
+  g_maxSamples = _maxSamples;
+  g_nextSample = 0;
+  g_filename = _filename;
+
+  // The first backtrace loads libgcc, which is not safe in a handler
+  void *frames[kMaxFrames];
+  backtrace(frames, kMaxFrames);
+
+  struct sigaction action;
+  action.sa_sigaction = onSample;
+  action.sa_flags = SA_SIGINFO | SA_RESTART;
+  sigemptyset(&action.sa_mask);
+  if (sigaction(SIGPROF, &action, &g_previousAction) != 0)
+  {
+    gzerr << "Unable to install the sampling profiler's signal handler\n";
+    g_samples.reset();
+    return false;
+  }
+
+  g_startTime = monotonicNsec();
+  g_running = true;
+
+  // SIGPROF is delivered to the thread consuming CPU when the timer fires
+  const int64_t period = std::max<int64_t>(1, 1000000 / _frequency);
+  struct itimerval timer;
+  timer.it_interval.tv_sec = period / 1000000;
+  timer.it_interval.tv_usec = period % 1000000;
+  timer.it_value = timer.it_interval;
+  if (setitimer(ITIMER_PROF, &timer, nullptr) != 0)
+  {
+    gzerr << "Unable to start the sampling profiler's timer\n";
+    g_running = false;
+    sigaction(SIGPROF, &g_previousAction, nullptr);
+    g_samples.reset();
+    return false;
+  }
+
+  gzmsg << "Sampling profiler started, writing to [" << _filename << "]\n";
+  return true;
+#else
+  gzerr << "The sampling profiler is only supported on Linux, not writing ["
+        << _filename << "]\n";
+  return false;
+#endif
+}
+
+//////////////////////////////////////////////////
+bool SamplingProfiler::Stop()
+{
+#ifdef __linux__
+  std::lock_guard<std::mutex> lock(g_controlMutex);
+  if (!g_running)
+    return false;
+
+  struct itimerval timer = {};
+  setitimer(ITIMER_PROF, &timer, nullptr);
+  g_running = false;
+
+  // A handler may still be writing its sample
+  while (g_inHandler > 0)
+    std::this_thread::yield();
+  sigaction(SIGPROF, &g_previousAction, nullptr);
+
+  const unsigned int taken = g_nextSample;
+  if (taken > g_maxSamples)
+  {
+    gzwarn << "The sampling profiler dropped " << taken - g_maxSamples
+           << " samples, the buffer holds " << g_maxSamples << "\n";
+  }
+
+  const bool result = writeTrace(std::min(taken, g_maxSamples));
+  g_samples.reset();
+  g_maxSamples = 0;
+
+  if (result)
+    gzmsg << "Sampling profile written to [" << g_filename << "]\n";
+  return result;
+#else
+  return false;
+#endif
+}
+
+//////////////////////////////////////////////////
+bool SamplingProfiler::Running()
+{
+#ifdef __linux__
+  return g_running;
+#else
+  return false;
+#endif
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_SAMPLINGPROFILER_HH_
+#define GAZEBO_COMMON_SAMPLINGPROFILER_HH_
+
+#include <string>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \addtogroup gazebo_common
+    /// \{
+
+    /// \brief Name the calling thread for every profiler: the ignition
+    /// profiler, the operating system (visible in perf, gdb and top, cut
+    /// to 15 characters on Linux) and the SamplingProfiler.
+    /// \param[in] _name Name of the thread.
+    GZ_COMMON_VISIBLE
+    void SetThreadName(const std::string &_name);
+
+    /// \class SamplingProfiler SamplingProfiler.hh common/common.hh
+    /// \brief A built-in sampling profiler. While running, it records the
+    /// call stack of whichever thread is on a CPU at a fixed rate of CPU
+    /// time, and Stop writes the samples as a Chrome trace (JSON stack
+    /// samples), which chrome://tracing, Perfetto and speedscope open.
+    /// Threads are shown with the names given to SetThreadName.
+    ///
+    /// gzserver starts it when the GAZEBO_SAMPLING_PROFILER environment
+    /// variable holds an output file name, and stops it on shutdown.
+    /// Only supported on Linux.
+    class GZ_COMMON_VISIBLE SamplingProfiler
+    {
+      /// \brief Start sampling.
+      /// \param[in] _filename File the trace is written to by Stop.
+      /// \param[in] _frequency Samples per second of CPU time.
+      /// \param[in] _maxSamples Samples kept, later ones are dropped. The
+      /// buffer takes about 280 bytes per sample.
+      /// \return False if already running or not supported.
+      public: static bool Start(const std::string &_filename,
+                                const unsigned int _frequency = 1000,
+                                const unsigned int _maxSamples = 100000);
+
+      /// \brief Stop sampling and write the trace.
+      /// \return False if not running or the trace could not be written.
+      public: static bool Stop();
+
+      /// \brief Check whether the profiler is sampling.
+      /// \return True between Start and Stop.
+      public: static bool Running();
+    };
+
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <boost/filesystem.hpp>
+
+#include "gazebo/common/SamplingProfiler.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+using namespace common;
+
+class SamplingProfilerTest : public gazebo::testing::AutoLogFixture { };
+
+#ifdef __linux__
+/////////////////////////////////////////////////
+TEST_F(SamplingProfilerTest, WritesTrace)
+{
+  const std::string filename = (boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path("gz_profile_%%%%.json")).string();
+
+  SetThreadName("profiled_test");
+  EXPECT_FALSE(SamplingProfiler::Running());
+  EXPECT_FALSE(SamplingProfiler::Stop());
+
+  ASSERT_TRUE(SamplingProfiler::Start(filename, 1000));
+  EXPECT_TRUE(SamplingProfiler::Running());
+  EXPECT_FALSE(SamplingProfiler::Start(filename));
+
+  // Burn CPU time so that the timer fires
+  volatile double sum = 0;
+  auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(300);
+  while (std::chrono::steady_clock::now() < end)
+  {
+    for (int i = 0; i < 1000; ++i)
+      sum = sum + std::sqrt(static_cast<double>(i));
+  }
+
+  EXPECT_TRUE(SamplingProfiler::Stop());
+  EXPECT_FALSE(SamplingProfiler::Running());
+
+  std::ifstream in(filename);
+  ASSERT_TRUE(in.good());
+  std::stringstream content;
+  content << in.rdbuf();
+  EXPECT_NE(content.str().find("\"samples\":["), std::string::npos);
+  EXPECT_NE(content.str().find("\"stackFrames\":{"), std::string::npos);
+  EXPECT_NE(content.str().find("profiled_test"), std::string::npos);
+
+  boost::filesystem::remove(filename);
+}
+#endif
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "gazebo/common/SimTimeScheduler.hh"
+
+using namespace gazebo;
+using namespace common;
+
+/// \brief Cancelled timers stay in the heap until they surface, rebuild it
+/// once they make up most of it past this size.
+static const size_t kCompactSize = 64;
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \brief A heap entry.
+    struct SimTimeTimer
+    {
+      /// \brief Time at which the timer expires.
+      Time time;
+
+      /// \brief Id of the timer, increasing so that equal times run in
+      /// the order they were scheduled.
+      uint64_t id;
+
+      /// \brief Order for a min-heap with std::push_heap and friends.
+      /// \param[in] _other Timer to compare to.
+      /// \return True if this timer expires after the other one.
+      bool operator>(const SimTimeTimer &_other) const
+      {
+        if (this->time != _other.time)
+          return this->time > _other.time;
+        return this->id > _other.id;
+      }
+    };
+
+    class SimTimeSchedulerPrivate
+    {
+      /// \brief Protects the members below.
+      public: mutable std::mutex mutex;
+
+      /// \brief Min-heap of the timers, may hold cancelled ones.
+      public: std::vector<SimTimeTimer> heap;
+
+      /// \brief Callbacks of the pending timers, by id.
+      public: std::unordered_map<uint64_t, SimTimeScheduler::Callback>
+              callbacks;
+
+      /// \brief Id of the next timer.
+      public: uint64_t nextId = 1;
+    };
+  }
+}
+
+/////////////////////////////////////////////////
+SimTimeScheduler::SimTimeScheduler()
+  : dataPtr(new SimTimeSchedulerPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+SimTimeScheduler::~SimTimeScheduler()
+{
+}
+
+/////////////////////////////////////////////////
+uint64_t SimTimeScheduler::Schedule(const Time &_time,
+    const Callback &_callback)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  const uint64_t id = this->dataPtr->nextId++;
+  this->dataPtr->callbacks.emplace(id, _callback);
+  this->dataPtr->heap.push_back({_time, id});
+  std::push_heap(this->dataPtr->heap.begin(), this->dataPtr->heap.end(),
+      std::greater<SimTimeTimer>());
+  return id;
+}
+
+/////////////////////////////////////////////////
+bool SimTimeScheduler::Cancel(const uint64_t _id)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (this->dataPtr->callbacks.erase(_id) == 0)
+    return false;
+
+  auto &heap = this->dataPtr->heap;
+  if (heap.size() > kCompactSize &&
+      heap.size() > 2 * this->dataPtr->callbacks.size())
+  {
+    heap.erase(std::remove_if(heap.begin(), heap.end(),
+        [this](const SimTimeTimer &_timer)
+        {
+          return this->dataPtr->callbacks.count(_timer.id) == 0;
+        }), heap.end());
+    std::make_heap(heap.begin(), heap.end(), std::greater<SimTimeTimer>());
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+void SimTimeScheduler::Clear()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->heap.clear();
+  this->dataPtr->callbacks.clear();
+}
+
+/////////////////////////////////////////////////
+size_t SimTimeScheduler::Pending() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->callbacks.size();
+}
+
+/////////////////////////////////////////////////
+size_t SimTimeScheduler::Update(const Time &_simTime)
+{
+  std::vector<Callback> due;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    auto &heap = this->dataPtr->heap;
+    while (!heap.empty() && heap.front().time <= _simTime)
+    {
+      std::pop_heap(heap.begin(), heap.end(), std::greater<SimTimeTimer>());
+      auto iter = this->dataPtr->callbacks.find(heap.back().id);
+      heap.pop_back();
+
+      // Skip cancelled timers
+      if (iter == this->dataPtr->callbacks.end())
+        continue;
+      due.push_back(std::move(iter->second));
+      this->dataPtr->callbacks.erase(iter);
+    }
+  }
+
+  // Run without the lock so that callbacks can schedule timers
+  for (auto &callback : due)
+    callback();
+
+  return due.size();
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_SIMTIMESCHEDULER_HH_
+#define GAZEBO_COMMON_SIMTIMESCHEDULER_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    // Forward declare private data class
+    class SimTimeSchedulerPrivate;
+
+    /// \addtogroup gazebo_common
+    /// \{
+
+    /// \brief Runs callbacks once a simulation time has been reached.
+    /// Timers are kept in a min-heap keyed by their time, so an update
+    /// only looks at the timers that expired and costs O(1) when none did,
+    /// whatever the number of pending timers.
+    ///
+    /// Every world owns one, updated at the start of each step, see
+    /// physics::World::Scheduler:
+    ///
+    ///     auto &scheduler = world->Scheduler();
+    ///     scheduler.Schedule(world->SimTime() + common::Time(2.5), [this]()
+    ///         {
+    ///           this->OpenDoor();
+    ///         });
+    ///
+    /// The class is thread safe. Callbacks run on the thread calling
+    /// Update, without the internal lock held, so they may schedule or
+    /// cancel timers.
+    class GZ_COMMON_VISIBLE SimTimeScheduler
+    {
+      /// \brief Callback of a timer.
+      public: using Callback = std::function<void()>;
+
+      /// \brief Constructor.
+      public: SimTimeScheduler();
+
+      /// \brief Destructor.
+      public: virtual ~SimTimeScheduler();
+
+      /// \brief Schedule a callback.
+      /// \param[in] _time Simulation time at which to run the callback.
+      /// A time already reached runs on the next update.
+      /// \param[in] _callback The callback.
+      /// \return Id of the timer, for Cancel. Never 0.
+      public: uint64_t Schedule(const Time &_time,
+                                const Callback &_callback);
+
+      /// \brief Cancel a timer that hasn't run yet.
+      /// \param[in] _id Id returned by Schedule.
+      /// \return True if the timer was pending.
+      public: bool Cancel(const uint64_t _id);
+
+      /// \brief Cancel all the pending timers.
+      public: void Clear();
+
+      /// \brief Get the number of pending timers.
+      /// \return Number of timers scheduled and not yet run or cancelled.
+      public: size_t Pending() const;
+
+      /// \brief Run the callbacks of the timers whose time is less than or
+      /// equal to a simulation time, earliest first and in the order they
+      /// were scheduled for equal times.
+      /// \param[in] _simTime Current simulation time.
+      /// \return Number of callbacks run.
+      public: size_t Update(const Time &_simTime);
+
+      /// \internal
+      /// \brief Pointer to private data.
+      private: std::unique_ptr<SimTimeSchedulerPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
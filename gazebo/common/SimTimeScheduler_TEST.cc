@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "gazebo/common/SimTimeScheduler.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+using namespace common;
+
+class SimTimeSchedulerTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(SimTimeSchedulerTest, Order)
+{
+  SimTimeScheduler scheduler;
+  std::vector<int> fired;
+  scheduler.Schedule(Time(3.0), [&fired]() {fired.push_back(3);});
+  scheduler.Schedule(Time(1.0), [&fired]() {fired.push_back(1);});
+  scheduler.Schedule(Time(2.0), [&fired]() {fired.push_back(2);});
+  scheduler.Schedule(Time(2.0), [&fired]() {fired.push_back(22);});
+  EXPECT_EQ(scheduler.Pending(), 4u);
+
+  EXPECT_EQ(scheduler.Update(Time(0.5)), 0u);
+  EXPECT_TRUE(fired.empty());
+
+  // Equal times run in the order they were scheduled
+  EXPECT_EQ(scheduler.Update(Time(2.0)), 3u);
+  EXPECT_EQ(fired, std::vector<int>({1, 2, 22}));
+  EXPECT_EQ(scheduler.Pending(), 1u);
+
+  EXPECT_EQ(scheduler.Update(Time(10.0)), 1u);
+  EXPECT_EQ(fired, std::vector<int>({1, 2, 22, 3}));
+  EXPECT_EQ(scheduler.Pending(), 0u);
+}
+
+/////////////////////////////////////////////////
+TEST_F(SimTimeSchedulerTest, Cancel)
+{
+  SimTimeScheduler scheduler;
+  int count = 0;
+  auto id = scheduler.Schedule(Time(1.0), [&count]() {++count;});
+  EXPECT_NE(id, 0u);
+  EXPECT_TRUE(scheduler.Cancel(id));
+  EXPECT_FALSE(scheduler.Cancel(id));
+  EXPECT_EQ(scheduler.Pending(), 0u);
+  EXPECT_EQ(scheduler.Update(Time(2.0)), 0u);
+  EXPECT_EQ(count, 0);
+
+  // Cancel enough timers to compact the heap, the rest must still run
+  std::vector<uint64_t> ids;
+  for (int i = 0; i < 200; ++i)
+    ids.push_back(scheduler.Schedule(Time(3.0 + i), [&count]() {++count;}));
+  for (int i = 0; i < 200; i += 2)
+    EXPECT_TRUE(scheduler.Cancel(ids[i]));
+  EXPECT_EQ(scheduler.Pending(), 100u);
+  EXPECT_EQ(scheduler.Update(Time(1000.0)), 100u);
+  EXPECT_EQ(count, 100);
+
+  scheduler.Schedule(Time(1.0), [&count]() {++count;});
+  scheduler.Clear();
+  EXPECT_EQ(scheduler.Update(Time(2000.0)), 0u);
+  EXPECT_EQ(count, 100);
+}
+
+/////////////////////////////////////////////////
+TEST_F(SimTimeSchedulerTest, Reschedule)
+{
+  // A callback can schedule a timer, due ones run on the next update
+  SimTimeScheduler scheduler;
+  int count = 0;
+  std::function<void()> tick = [&]()
+  {
+    if (++count < 3)
+      scheduler.Schedule(Time(0.0), tick);
+  };
+  scheduler.Schedule(Time(0.0), tick);
+
+  EXPECT_EQ(scheduler.Update(Time(1.0)), 1u);
+  EXPECT_EQ(scheduler.Update(Time(1.0)), 1u);
+  EXPECT_EQ(scheduler.Update(Time(1.0)), 1u);
+  EXPECT_EQ(scheduler.Update(Time(1.0)), 0u);
+  EXPECT_EQ(count, 3);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
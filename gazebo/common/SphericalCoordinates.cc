@@ -295,17 +295,6 @@ ignition::math::Vector3d SphericalCoordinates::PositionTransform(
 {
   ignition::math::Vector3d tmp = _pos;
 
-  // Cache trig results
-  double cosLat = cos(_pos.X());
-  double sinLat = sin(_pos.X());
-  double cosLon = cos(_pos.Y());
-  double sinLon = sin(_pos.Y());
-
-  // Radius of planet curvature (meters)
-  double curvature = 1.0 -
-    this->dataPtr->ellE * this->dataPtr->ellE * sinLat * sinLat;
-  curvature = this->dataPtr->ellA / sqrt(curvature);
-
   // Convert whatever arrives to a more flexible ECEF coordinate
   switch (_in)
   {
@@ -327,6 +316,17 @@ ignition::math::Vector3d SphericalCoordinates::PositionTransform(
 
     case SPHERICAL:
       {
+        // Only spherical input needs trigonometry
+        const double cosLat = cos(_pos.X());
+        const double sinLat = sin(_pos.X());
+        const double cosLon = cos(_pos.Y());
+        const double sinLon = sin(_pos.Y());
+
+        // Radius of planet curvature (meters)
+        double curvature = 1.0 -
+          this->dataPtr->ellE * this->dataPtr->ellE * sinLat * sinLat;
+        curvature = this->dataPtr->ellA / sqrt(curvature);
+
         tmp.X((_pos.Z() + curvature) * cosLat * cosLon);
         tmp.Y((_pos.Z() + curvature) * cosLat * sinLon);
         tmp.Z(((this->dataPtr->ellB * this->dataPtr->ellB)/
@@ -352,19 +352,23 @@ ignition::math::Vector3d SphericalCoordinates::PositionTransform(
         double p = sqrt(tmp.X() * tmp.X() + tmp.Y() * tmp.Y());
         double theta = atan((tmp.Z() * this->dataPtr->ellA) /
             (p * this->dataPtr->ellB));
+        const double sinTheta = sin(theta);
+        const double cosTheta = cos(theta);
+        const double ellP2 = this->dataPtr->ellP * this->dataPtr->ellP;
+        const double ellE2 = this->dataPtr->ellE * this->dataPtr->ellE;
 
         // Calculate latitude and longitude
         double lat = atan(
-            (tmp.Z() + std::pow(this->dataPtr->ellP, 2) * this->dataPtr->ellB *
-             std::pow(sin(theta), 3)) /
-            (p - std::pow(this->dataPtr->ellE, 2) *
-             this->dataPtr->ellA * std::pow(cos(theta), 3)));
+            (tmp.Z() + ellP2 * this->dataPtr->ellB *
+             sinTheta * sinTheta * sinTheta) /
+            (p - ellE2 * this->dataPtr->ellA *
+             cosTheta * cosTheta * cosTheta));
 
         double lon = atan2(tmp.Y(), tmp.X());
 
         // Recalculate radius of planet curvature at the current latitude.
-        double nCurvature = 1.0 - std::pow(this->dataPtr->ellE, 2) *
-          std::pow(sin(lat), 2);
+        const double sinLat = sin(lat);
+        double nCurvature = 1.0 - ellE2 * sinLat * sinLat;
         nCurvature = this->dataPtr->ellA / sqrt(nCurvature);
 
         tmp.X(lat);
@@ -402,6 +406,79 @@ ignition::math::Vector3d SphericalCoordinates::PositionTransform(
   return tmp;
 }
 
+//////////////////////////////////////////////////
+void SphericalCoordinates::PositionTransform(
+    const std::vector<ignition::math::Vector3d> &_pos,
+    const CoordinateType &_in, const CoordinateType &_out,
+    std::vector<ignition::math::Vector3d> &_result) const
+{
+  _result.resize(_pos.size());
+
+  // Spherical coordinates aren't linear, convert one point at a time
+  if (_in == SPHERICAL || _out == SPHERICAL)
+  {
+    for (size_t i = 0; i < _pos.size(); ++i)
+      _result[i] = this->PositionTransform(_pos[i], _in, _out);
+    return;
+  }
+
+  // Between the other frames a point moves by the same affine transform,
+  // ecef = toECEF * in + toOffset and out = fromECEF * (ecef - fromOffset),
+  // so build it once and apply it to every point.
+  const ignition::math::Matrix3d heading(
+      this->dataPtr->cosHea, -this->dataPtr->sinHea, 0,
+      this->dataPtr->sinHea, this->dataPtr->cosHea, 0,
+      0, 0, 1);
+
+  ignition::math::Matrix3d toECEF = ignition::math::Matrix3d::Identity;
+  ignition::math::Vector3d toOffset;
+  switch (_in)
+  {
+    case LOCAL:
+      toECEF = this->dataPtr->rotGlobalToECEF * ignition::math::Matrix3d(
+          -this->dataPtr->cosHea, this->dataPtr->sinHea, 0,
+          -this->dataPtr->sinHea, -this->dataPtr->cosHea, 0,
+          0, 0, 1);
+      toOffset = this->dataPtr->origin;
+      break;
+    case GLOBAL:
+      toECEF = this->dataPtr->rotGlobalToECEF;
+      toOffset = this->dataPtr->origin;
+      break;
+    case ECEF:
+      break;
+    default:
+      gzerr << "Invalid coordinate type[" << _in << "]\n";
+      _result = _pos;
+      return;
+  }
+
+  ignition::math::Matrix3d fromECEF = ignition::math::Matrix3d::Identity;
+  ignition::math::Vector3d fromOffset;
+  switch (_out)
+  {
+    case LOCAL:
+      fromECEF = heading * this->dataPtr->rotECEFToGlobal;
+      fromOffset = this->dataPtr->origin;
+      break;
+    case GLOBAL:
+      fromECEF = this->dataPtr->rotECEFToGlobal;
+      fromOffset = this->dataPtr->origin;
+      break;
+    case ECEF:
+      break;
+    default:
+      gzerr << "Unknown coordinate type[" << _out << "]\n";
+      _result = _pos;
+      return;
+  }
+
+  const ignition::math::Matrix3d rot = fromECEF * toECEF;
+  const ignition::math::Vector3d offset = fromECEF * (toOffset - fromOffset);
+  for (size_t i = 0; i < _pos.size(); ++i)
+    _result[i] = rot * _pos[i] + offset;
+}
+
 //////////////////////////////////////////////////
 ignition::math::Vector3d SphericalCoordinates::VelocityTransform(
     const ignition::math::Vector3d &_vel,
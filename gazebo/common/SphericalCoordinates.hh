@@ -18,6 +18,7 @@
 #define _GAZEBO_SPHERICALCOORDINATES_HH_
 
 #include <string>
+#include <vector>
 
 #include <ignition/math/Angle.hh>
 #include <ignition/math/Vector3.hh>
@@ -186,6 +187,19 @@ namespace gazebo
               PositionTransform(const ignition::math::Vector3d &_pos,
                   const CoordinateType &_in, const CoordinateType &_out) const;
 
+      /// \brief Convert many positions between SPHERICAL/ECEF/LOCAL/GLOBAL
+      /// frames. Between the ECEF, LOCAL and GLOBAL frames the transform is
+      /// composed once and applied to every position, which is much
+      /// cheaper than one PositionTransform call per position.
+      /// \param[in] _pos Position vectors in frame defined by parameter _in
+      /// \param[in] _in  CoordinateType for input
+      /// \param[in] _out CoordinateType for output
+      /// \param[out] _result Transformed positions, in the same order.
+      public: void PositionTransform(
+                  const std::vector<ignition::math::Vector3d> &_pos,
+                  const CoordinateType &_in, const CoordinateType &_out,
+                  std::vector<ignition::math::Vector3d> &_result) const;
+
       /// \brief Convert between velocity in SPHERICAL/ECEF/LOCAL/GLOBAL frame
       /// \param[in] _pos Velocity vector in frame defined by parameter _in
       /// \param[in] _in  CoordinateType for input
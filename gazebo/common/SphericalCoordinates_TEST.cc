@@ -16,6 +16,7 @@
 */
 
 #include <gtest/gtest.h>
+#include <vector>
 
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/SphericalCoordinates.hh"
@@ -266,6 +267,63 @@ TEST_F(SphericalCoordinatesTest, Distance)
   EXPECT_NEAR(14002, d, 20);
 }
 
+//////////////////////////////////////////////////
+// Test that batch conversions match single ones
+TEST_F(SphericalCoordinatesTest, BatchTransforms)
+{
+  common::SphericalCoordinates sc(common::SphericalCoordinates::EARTH_WGS84,
+      ignition::math::Angle(0.3), ignition::math::Angle(-1.2), 354.1,
+      ignition::math::Angle(0.4));
+
+  std::vector<ignition::math::Vector3d> points;
+  points.push_back(ignition::math::Vector3d::Zero);
+  points.push_back(ignition::math::Vector3d(1, 0, 0));
+  points.push_back(ignition::math::Vector3d(-120.5, 33.2, 7.25));
+  points.push_back(ignition::math::Vector3d(1000, -2000, -50));
+
+  const std::vector<common::SphericalCoordinates::CoordinateType> types =
+    {common::SphericalCoordinates::LOCAL,
+     common::SphericalCoordinates::GLOBAL,
+     common::SphericalCoordinates::ECEF};
+
+  std::vector<ignition::math::Vector3d> result;
+  for (auto in : types)
+  {
+    for (auto out : types)
+    {
+      // Work with positions near the reference in the input frame
+      std::vector<ignition::math::Vector3d> input;
+      for (auto const &p : points)
+      {
+        input.push_back(sc.PositionTransform(p,
+              common::SphericalCoordinates::LOCAL, in));
+      }
+
+      sc.PositionTransform(input, in, out, result);
+      ASSERT_EQ(input.size(), result.size());
+      for (size_t i = 0; i < input.size(); ++i)
+      {
+        auto expected = sc.PositionTransform(input[i], in, out);
+        EXPECT_NEAR(expected.X(), result[i].X(), 1e-6);
+        EXPECT_NEAR(expected.Y(), result[i].Y(), 1e-6);
+        EXPECT_NEAR(expected.Z(), result[i].Z(), 1e-6);
+      }
+    }
+  }
+
+  // Spherical output goes through the single conversion
+  sc.PositionTransform(points, common::SphericalCoordinates::LOCAL,
+      common::SphericalCoordinates::SPHERICAL, result);
+  ASSERT_EQ(points.size(), result.size());
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    auto expected = sc.PositionTransform(points[i],
+        common::SphericalCoordinates::LOCAL,
+        common::SphericalCoordinates::SPHERICAL);
+    EXPECT_EQ(expected, result[i]);
+  }
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
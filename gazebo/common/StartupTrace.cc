@@ -0,0 +1,254 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/StartupTrace.hh"
+
+using namespace gazebo;
+using namespace common;
+
+namespace
+{
+  /// \brief One phase, or an instant if the end is negative.
+  struct Event
+  {
+    /// \brief Name of the phase.
+    std::string name;
+
+    /// \brief Subsystem of the phase.
+    std::string category;
+
+    /// \brief What the phase worked on.
+    std::string detail;
+
+    /// \brief Thread that ran the phase.
+    int64_t tid;
+
+    /// \brief Start in microseconds.
+    int64_t start;
+
+    /// \brief End in microseconds, negative for an instant.
+    int64_t end;
+  };
+
+  /// \brief Whether events are recorded.
+  std::atomic<bool> g_enabled(std::getenv("GAZEBO_STARTUP_TRACE") != nullptr);
+
+  /// \brief Protects g_events.
+  std::mutex g_eventsMutex;
+
+  /// \brief Events recorded.
+  std::vector<Event> g_events;
+
+  /// \brief Get an id of the calling thread, the kernel one on Linux so
+  /// that traces line up with the SamplingProfiler's.
+  /// \return Thread id.
+  int64_t currentTid()
+  {
+#ifdef __linux__
+    return static_cast<int64_t>(syscall(SYS_gettid));
+#else
+    return static_cast<int64_t>(
+        std::hash<std::thread::id>()(std::this_thread::get_id()));
+#endif
+  }
+
+  /// \brief Get an id of the process.
+  /// \return Process id.
+  int64_t currentPid()
+  {
+#ifdef __linux__
+    return static_cast<int64_t>(getpid());
+#else
+    return 0;
+#endif
+  }
+
+  /// \brief Escape a string for JSON.
+  /// \param[in] _str String to escape.
+  /// \return Escaped string, without quotes.
+  std::string jsonEscape(const std::string &_str)
+  {
+    std::string out;
+    out.reserve(_str.size());
+    for (const char c : _str)
+    {
+      if (c == '"' || c == '\\')
+      {
+        out += '\\';
+        out += c;
+      }
+      else if (static_cast<unsigned char>(c) < 0x20)
+        out += ' ';
+      else
+        out += c;
+    }
+    return out;
+  }
+}
+
+//////////////////////////////////////////////////
+bool StartupTrace::Enabled()
+{
+  return g_enabled.load(std::memory_order_relaxed);
+}
+
+//////////////////////////////////////////////////
+void StartupTrace::SetEnabled(const bool _enable)
+{
+  g_enabled = _enable;
+}
+
+//////////////////////////////////////////////////
+void StartupTrace::Record(const std::string &_name,
+    const std::string &_category, const std::string &_detail,
+    const int64_t _start, const int64_t _end)
+{
+  if (!Enabled())
+    return;
+
+  Event event{_name, _category, _detail, currentTid(), _start, _end};
+  std::lock_guard<std::mutex> lock(g_eventsMutex);
+  g_events.push_back(std::move(event));
+}
+
+//////////////////////////////////////////////////
+void StartupTrace::Mark(const std::string &_name)
+{
+  Record(_name, "startup", "", Now(), -1);
+}
+
+//////////////////////////////////////////////////
+size_t StartupTrace::EventCount()
+{
+  std::lock_guard<std::mutex> lock(g_eventsMutex);
+  return g_events.size();
+}
+
+//////////////////////////////////////////////////
+void StartupTrace::Clear()
+{
+  std::lock_guard<std::mutex> lock(g_eventsMutex);
+  g_events.clear();
+}
+
+//////////////////////////////////////////////////
+bool StartupTrace::Write(const std::string &_filename)
+{
+  std::ofstream out(_filename);
+  if (!out)
+  {
+    gzerr << "Unable to write startup trace [" << _filename << "]\n";
+    return false;
+  }
+
+  const int64_t pid = currentPid();
+  out << "{\"traceEvents\":[";
+  {
+    std::lock_guard<std::mutex> lock(g_eventsMutex);
+    for (size_t i = 0; i < g_events.size(); ++i)
+    {
+      const Event &event = g_events[i];
+      out << (i == 0 ? "\n" : ",\n")
+        << "{\"name\":\"" << jsonEscape(event.name)
+        << "\",\"cat\":\"" << jsonEscape(event.category) << "\"";
+      if (event.end < 0)
+        out << ",\"ph\":\"i\",\"s\":\"p\"";
+      else
+        out << ",\"ph\":\"X\",\"dur\":" << event.end - event.start;
+      out << ",\"ts\":" << event.start << ",\"pid\":" << pid
+        << ",\"tid\":" << event.tid;
+      if (!event.detail.empty())
+        out << ",\"args\":{\"detail\":\"" << jsonEscape(event.detail) << "\"}";
+      out << "}";
+    }
+  }
+  out << "\n],\n\"displayTimeUnit\":\"ms\"}\n";
+
+  if (!out)
+  {
+    gzerr << "Unable to write startup trace [" << _filename << "]\n";
+    return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool StartupTrace::Finish(const std::string &_process)
+{
+  if (!Enabled())
+    return false;
+
+  Mark(_process + " startup complete");
+
+  bool written = false;
+  const char *dir = std::getenv("GAZEBO_STARTUP_TRACE");
+  if (dir && dir[0] != '\0')
+  {
+    const std::string filename = std::string(dir) + "/" + _process + ".json";
+    written = Write(filename);
+    if (written)
+      gzmsg << "Startup trace written to [" << filename << "]\n";
+  }
+
+  SetEnabled(false);
+  Clear();
+  return written;
+}
+
+//////////////////////////////////////////////////
+int64_t StartupTrace::Now()
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//////////////////////////////////////////////////
+StartupTraceScope::StartupTraceScope(const char *_name,
+    const char *_category, const std::string &_detail)
+  : name(StartupTrace::Enabled() ? _name : nullptr), category(_category)
+{
+  if (this->name)
+  {
+    this->detail = _detail;
+    this->start = StartupTrace::Now();
+  }
+}
+
+//////////////////////////////////////////////////
+StartupTraceScope::~StartupTraceScope()
+{
+  if (this->name)
+  {
+    StartupTrace::Record(this->name, this->category, this->detail,
+        this->start, StartupTrace::Now());
+  }
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_STARTUPTRACE_HH_
+#define GAZEBO_COMMON_STARTUPTRACE_HH_
+
+#include <cstdint>
+#include <string>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \addtogroup gazebo_common
+    /// \{
+
+    /// \class StartupTrace StartupTrace.hh common/common.hh
+    /// \brief Records the phases of the startup of a process, such as
+    /// parsing the SDF, loading meshes, initializing physics or loading
+    /// plugins, and writes them as a Chrome trace (JSON complete events),
+    /// which chrome://tracing, Perfetto and speedscope open.
+    ///
+    /// Recording is off by default. Setting the GAZEBO_STARTUP_TRACE
+    /// environment variable to a directory turns it on from the start of
+    /// the process, and gzserver and gzclient write <dir>/gzserver.json and
+    /// <dir>/gzclient.json once they are up. Timestamps are taken from the
+    /// monotonic clock, so the traces of both processes line up.
+    class GZ_COMMON_VISIBLE StartupTrace
+    {
+      /// \brief Check whether events are recorded.
+      /// \return True if enabled.
+      public: static bool Enabled();
+
+      /// \brief Turn recording on or off.
+      /// \param[in] _enable True to record events.
+      public: static void SetEnabled(const bool _enable);
+
+      /// \brief Record a phase, if enabled.
+      /// \param[in] _name Name of the phase.
+      /// \param[in] _category Subsystem of the phase, e.g. "sdf" or "mesh".
+      /// \param[in] _detail What the phase worked on, e.g. a file name.
+      /// May be empty.
+      /// \param[in] _start Start of the phase, see Now.
+      /// \param[in] _end End of the phase, see Now.
+      public: static void Record(const std::string &_name,
+                                 const std::string &_category,
+                                 const std::string &_detail,
+                                 const int64_t _start, const int64_t _end);
+
+      /// \brief Record an instant, if enabled.
+      /// \param[in] _name Name of the instant.
+      public: static void Mark(const std::string &_name);
+
+      /// \brief Get the number of events recorded.
+      /// \return Event count.
+      public: static size_t EventCount();
+
+      /// \brief Drop the events recorded.
+      public: static void Clear();
+
+      /// \brief Write the events recorded as a Chrome trace.
+      /// \param[in] _filename File to write.
+      /// \return False if the file could not be written.
+      public: static bool Write(const std::string &_filename);
+
+      /// \brief End the startup of a process: mark it complete, write
+      /// <dir>/<_process>.json if GAZEBO_STARTUP_TRACE names a directory,
+      /// then stop recording and drop the events.
+      /// \param[in] _process Name of the process, e.g. "gzserver".
+      /// \return True if a trace was written.
+      public: static bool Finish(const std::string &_process);
+
+      /// \brief Get the time used by the events.
+      /// \return Monotonic time in microseconds.
+      public: static int64_t Now();
+    };
+
+    /// \class StartupTraceScope StartupTrace.hh common/common.hh
+    /// \brief Records the phase that runs during its lifetime, if the
+    /// startup trace is enabled.
+    class GZ_COMMON_VISIBLE StartupTraceScope
+    {
+      /// \brief Constructor.
+      /// \param[in] _name Name of the phase.
+      /// \param[in] _category Subsystem of the phase.
+      /// \param[in] _detail What the phase works on, may be empty.
+      public: StartupTraceScope(const char *_name, const char *_category,
+                                const std::string &_detail = "");
+
+      /// \brief Destructor, records the phase.
+      public: ~StartupTraceScope();
+
+      /// \brief Name of the phase, null if not recorded.
+      private: const char *name;
+
+      /// \brief Subsystem of the phase.
+      private: const char *category;
+
+      /// \brief What the phase works on.
+      private: std::string detail;
+
+      /// \brief Start of the phase.
+      private: int64_t start = 0;
+    };
+
+    /// \}
+  }
+}
+#endif
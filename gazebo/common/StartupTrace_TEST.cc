@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <sstream>
+
+#include <boost/filesystem.hpp>
+
+#include "gazebo/common/StartupTrace.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+using namespace common;
+
+class StartupTraceTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(StartupTraceTest, Scope)
+{
+  StartupTrace::SetEnabled(false);
+  StartupTrace::Clear();
+  {
+    StartupTraceScope scope("ignored", "test");
+  }
+  EXPECT_EQ(StartupTrace::EventCount(), 0u);
+
+  StartupTrace::SetEnabled(true);
+  {
+    StartupTraceScope outer("outer", "test", "detail");
+    StartupTraceScope inner("inner", "test");
+  }
+  StartupTrace::Mark("done");
+  EXPECT_EQ(StartupTrace::EventCount(), 3u);
+
+  StartupTrace::SetEnabled(false);
+  StartupTrace::Clear();
+  EXPECT_EQ(StartupTrace::EventCount(), 0u);
+}
+
+/////////////////////////////////////////////////
+TEST_F(StartupTraceTest, Write)
+{
+  StartupTrace::SetEnabled(true);
+  StartupTrace::Clear();
+  const int64_t start = StartupTrace::Now();
+  StartupTrace::Record("Load \"world\"", "world", "default", start,
+      start + 250);
+
+  boost::filesystem::path file =
+      boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path("startup_trace_%%%%%%%%.json");
+  ASSERT_TRUE(StartupTrace::Write(file.string()));
+
+  std::ifstream in(file.string());
+  std::stringstream content;
+  content << in.rdbuf();
+  boost::filesystem::remove(file);
+
+  const std::string json = content.str();
+  EXPECT_NE(json.find("\"traceEvents\""), std::string::npos);
+  EXPECT_NE(json.find("\"name\":\"Load \\\"world\\\"\""), std::string::npos);
+  EXPECT_NE(json.find("\"ph\":\"X\",\"dur\":250"), std::string::npos);
+  EXPECT_NE(json.find("\"args\":{\"detail\":\"default\"}"),
+      std::string::npos);
+
+  StartupTrace::SetEnabled(false);
+  StartupTrace::Clear();
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -59,6 +59,9 @@ std::vector<std::function<std::string (const std::string &)>> g_findFileCbs;
 //////////////////////////////////////////////////
 SystemPaths::SystemPaths()
 {
+  const char *indexEnv = getenv("GAZEBO_PATH_INDEX");
+  this->indexPaths = indexEnv && std::string(indexEnv) != "0";
+
   this->gazeboPaths.clear();
   this->ogrePaths.clear();
   this->pluginPaths.clear();
@@ -315,14 +318,16 @@ std::string SystemPaths::FindFileURI(const std::string &_uri)
   // paths
   if (prefix == "model")
   {
+    filename = this->CachedPath(_uri);
+
     boost::filesystem::path path;
     for (std::list<std::string>::iterator iter = this->modelPaths.begin();
-         iter != this->modelPaths.end(); ++iter)
+         iter != this->modelPaths.end() && filename.empty(); ++iter)
     {
-      path = boost::filesystem::path(*iter) / suffix;
-      if (boost::filesystem::exists(path))
+      if (this->ProbePath(*iter, suffix, path))
       {
         filename = path.string();
+        this->CachePath(_uri, filename);
         break;
       }
     }
@@ -409,15 +414,14 @@ std::string SystemPaths::FindFile(const std::string &_filename,
     }
     else
     {
-      bool found = false;
       std::list<std::string> paths = this->GetGazeboPaths();
+      path = this->CachedPath(_filename);
+      bool found = !path.empty();
 
       for (std::list<std::string>::const_iterator iter = paths.begin();
           iter != paths.end() && !found; ++iter)
       {
-        path = boost::filesystem::path((*iter));
-        path = boost::filesystem::operator/(path, _filename);
-        if (boost::filesystem::exists(path))
+        if (this->ProbePath(*iter, _filename, path))
         {
           found = true;
           break;
@@ -427,10 +431,9 @@ std::string SystemPaths::FindFile(const std::string &_filename,
         for (suffixIter = this->suffixPaths.begin();
             suffixIter != this->suffixPaths.end(); ++suffixIter)
         {
-          path = boost::filesystem::path(*iter);
-          path = boost::filesystem::operator/(path, *suffixIter);
-          path = boost::filesystem::operator/(path, _filename);
-          if (boost::filesystem::exists(path))
+          std::string dir =
+              (boost::filesystem::path(*iter) / *suffixIter).string();
+          if (this->ProbePath(dir, _filename, path))
           {
             found = true;
             break;
@@ -438,8 +441,10 @@ std::string SystemPaths::FindFile(const std::string &_filename,
         }
       }
 
-    if (!found)
-      path = std::string();
+      if (!found)
+        path = std::string();
+      else
+        this->CachePath(_filename, path.string());
     }
   }
 
@@ -464,6 +469,79 @@ std::string SystemPaths::FindFile(const std::string &_filename,
   return path.string();
 }
 
+/////////////////////////////////////////////////
+bool SystemPaths::ProbePath(const std::string &_dir,
+    const std::string &_filename, boost::filesystem::path &_path)
+{
+  _path = boost::filesystem::path(_dir) / _filename;
+
+  // Relative components can't be looked up in a listing
+  std::string first = _filename.substr(0, _filename.find('/'));
+  if (this->indexPaths && !first.empty() && first != "." && first != "..")
+  {
+    std::lock_guard<std::mutex> lock(this->findFileMutex);
+    auto iter = this->pathIndex.find(_dir);
+    if (iter == this->pathIndex.end())
+    {
+      iter = this->pathIndex.insert(
+          std::make_pair(_dir, std::set<std::string>())).first;
+
+      boost::system::error_code ec;
+      for (boost::filesystem::directory_iterator dirIter(_dir, ec), end;
+           !ec && dirIter != end; dirIter.increment(ec))
+      {
+        iter->second.insert(dirIter->path().filename().string());
+      }
+    }
+
+    if (iter->second.find(first) == iter->second.end())
+      return false;
+
+    if (first.size() == _filename.size())
+      return true;
+  }
+
+  return boost::filesystem::exists(_path);
+}
+
+/////////////////////////////////////////////////
+std::string SystemPaths::CachedPath(const std::string &_key)
+{
+  std::string result;
+  {
+    std::lock_guard<std::mutex> lock(this->findFileMutex);
+    auto iter = this->findFileCache.find(_key);
+    if (iter == this->findFileCache.end())
+      return result;
+    result = iter->second;
+  }
+
+  // One check is still far cheaper than searching every path again
+  if (!boost::filesystem::exists(result))
+  {
+    std::lock_guard<std::mutex> lock(this->findFileMutex);
+    this->findFileCache.erase(_key);
+    return std::string();
+  }
+
+  return result;
+}
+
+/////////////////////////////////////////////////
+void SystemPaths::CachePath(const std::string &_key, const std::string &_path)
+{
+  std::lock_guard<std::mutex> lock(this->findFileMutex);
+  this->findFileCache[_key] = _path;
+}
+
+/////////////////////////////////////////////////
+void SystemPaths::ClearFindFileCache()
+{
+  std::lock_guard<std::mutex> lock(this->findFileMutex);
+  this->findFileCache.clear();
+  this->pathIndex.clear();
+}
+
 /////////////////////////////////////////////////
 void SystemPaths::AddFindFileCallback(
     std::function<std::string (const std::string &)> _cb)
@@ -475,24 +553,28 @@ void SystemPaths::AddFindFileCallback(
 void SystemPaths::ClearGazeboPaths()
 {
   this->gazeboPaths.clear();
+  this->ClearFindFileCache();
 }
 
 /////////////////////////////////////////////////
 void SystemPaths::ClearOgrePaths()
 {
   this->ogrePaths.clear();
+  this->ClearFindFileCache();
 }
 
 /////////////////////////////////////////////////
 void SystemPaths::ClearPluginPaths()
 {
   this->pluginPaths.clear();
+  this->ClearFindFileCache();
 }
 
 /////////////////////////////////////////////////
 void SystemPaths::ClearModelPaths()
 {
   this->modelPaths.clear();
+  this->ClearFindFileCache();
 }
 
 /////////////////////////////////////////////////
@@ -559,7 +641,10 @@ void SystemPaths::InsertUnique(const std::string &_path,
                                std::list<std::string> &_list)
 {
   if (std::find(_list.begin(), _list.end(), _path) == _list.end())
+  {
     _list.push_back(_path);
+    this->ClearFindFileCache();
+  }
 }
 
 /////////////////////////////////////////////////
@@ -576,4 +661,5 @@ void SystemPaths::AddSearchPathSuffix(const std::string &_suffix)
     s += "/";
 
   this->suffixPaths.push_back(s);
+  this->ClearFindFileCache();
 }
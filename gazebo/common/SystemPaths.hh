@@ -30,6 +30,9 @@
 
 #include <boost/filesystem.hpp>
 #include <list>
+#include <map>
+#include <mutex>
+#include <set>
 #include <string>
 
 #include "gazebo/common/CommonTypes.hh"
@@ -163,6 +166,12 @@ namespace gazebo
       /// \param[in] _suffix The suffix to add
       public: void AddSearchPathSuffix(const std::string &_suffix);
 
+      /// \brief Forget the files found so far in the search paths, and the
+      /// directory listings read when GAZEBO_PATH_INDEX is set. Call after
+      /// adding files to a search path while Gazebo runs. Adding or
+      /// clearing paths does this automatically.
+      public: void ClearFindFileCache();
+
       /// \brief re-read SystemPaths#gazeboPaths from environment variable
       private: void UpdateModelPaths();
 
@@ -175,6 +184,30 @@ namespace gazebo
       /// \brief re-read SystemPaths#ogrePaths from environment variable
       private: void UpdateOgrePaths();
 
+      /// \brief Check if a file exists in a search path directory. When
+      /// GAZEBO_PATH_INDEX is set, the directory is listed once and names
+      /// missing from the listing are rejected without touching the
+      /// filesystem.
+      /// \param[in] _dir Search path directory.
+      /// \param[in] _filename Path of the file relative to _dir.
+      /// \param[out] _path Full path of the file.
+      /// \return True if the file exists.
+      private: bool ProbePath(const std::string &_dir,
+                              const std::string &_filename,
+                              boost::filesystem::path &_path);
+
+      /// \brief Get a file found by an earlier search.
+      /// \param[in] _key Filename or URI searched for.
+      /// \return Full path of the file, or an empty string if it was not
+      /// found before or no longer exists.
+      private: std::string CachedPath(const std::string &_key);
+
+      /// \brief Remember where a file was found.
+      /// \param[in] _key Filename or URI searched for.
+      /// \param[in] _path Full path of the file.
+      private: void CachePath(const std::string &_key,
+                              const std::string &_path);
+
       /// \brief adds a path to the list if not already present
       /// \param[in]_path the path
       /// \param[in]_list the list
@@ -219,6 +252,20 @@ namespace gazebo
 
       /// \brief Path to the instance temporary directory
       private: boost::filesystem::path tmpInstancePath;
+
+      /// \brief Full path of the files found in the search paths, by
+      /// filename or URI.
+      private: std::map<std::string, std::string> findFileCache;
+
+      /// \brief Names of the entries of each search path directory.
+      private: std::map<std::string, std::set<std::string>> pathIndex;
+
+      /// \brief True to list search path directories, from the
+      /// GAZEBO_PATH_INDEX environment variable.
+      private: bool indexPaths = false;
+
+      /// \brief Protects findFileCache and pathIndex.
+      private: std::mutex findFileMutex;
     };
     /// \}
   }
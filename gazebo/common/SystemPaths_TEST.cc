@@ -16,6 +16,8 @@
 */
 #include <gtest/gtest.h>
 
+#include <boost/filesystem.hpp>
+#include <fstream>
 #include <string>
 #include <vector>
 
@@ -90,6 +92,36 @@ TEST_F(SystemPathsTest, FindFile)
   }
 }
 
+//////////////////////////////////////////////////
+TEST_F(SystemPathsTest, FindFileCache)
+{
+  auto sysPaths = common::SystemPaths::Instance();
+
+  boost::filesystem::path dir =
+      boost::filesystem::path(sysPaths->TmpPath()) /
+      boost::filesystem::unique_path("gazebo_find_file_%%%%%%");
+  boost::filesystem::create_directories(dir / "media");
+  boost::filesystem::path file = dir / "media" / "find_file_cache.txt";
+  std::ofstream(file.string()) << "test";
+
+  sysPaths->AddGazeboPaths(dir.string());
+  EXPECT_EQ(file.string(), sysPaths->FindFile("media/find_file_cache.txt",
+      false));
+
+  // A cached file that is removed is not returned
+  boost::filesystem::remove(file);
+  EXPECT_EQ("", sysPaths->FindFile("media/find_file_cache.txt", false));
+
+  // Files added to a search path are found after clearing the cache
+  std::ofstream(file.string()) << "test";
+  sysPaths->ClearFindFileCache();
+  EXPECT_EQ(file.string(), sysPaths->FindFile("media/find_file_cache.txt",
+      false));
+
+  boost::filesystem::remove_all(dir);
+  sysPaths->ClearGazeboPaths();
+}
+
 //////////////////////////////////////////////////
 TEST_F(SystemPathsTest, SystemPaths)
 {
@@ -14,8 +14,14 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
 #include <mutex>
 #include <stdio.h>
+#include <thread>
+#include <vector>
 #include <gazebo/gazebo_config.h>
 
 #include <sys/types.h>
@@ -40,15 +46,20 @@ extern "C"
 #include <libavutil/opt.h>
 #include <libavutil/error.h>
 #include <libavutil/imgutils.h>
+#include <libavutil/pixdesc.h>
 
 #if defined(__linux__) && defined(HAVE_AVDEVICE)
 #include <libavdevice/avdevice.h>
 #endif
 }
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
 #endif
 
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Console.hh"
+#include "gazebo/common/SamplingProfiler.hh"
 #include "gazebo/common/VideoEncoder.hh"
 
 using namespace gazebo;
@@ -58,6 +69,14 @@ using namespace common;
 #define AV_ERROR_MAX_STRING_SIZE 64
 #endif
 
+/// \brief Maximum number of frames waiting to be encoded. Frames added
+/// while the queue is full are dropped.
+static const size_t kMaxQueuedFrames = 8;
+
+/// \brief Minimum number of rows converted by each color conversion
+/// thread.
+static const unsigned int kMinBandRows = 64;
+
 // Private data class
 class gazebo::common::VideoEncoderPrivate
 {
@@ -78,15 +97,73 @@ class gazebo::common::VideoEncoderPrivate
   /// \brief libav output video frame
   public: AVFrame *avOutFrame = nullptr;
 
-  /// \brief libav input image data
-#if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(57, 24, 1)
-  public: AVPicture *avInFrame = nullptr;
-#else
-  public: AVFrame *avInFrame = nullptr;
-#endif
-
   /// \brief Software scaling context
   public: SwsContext *swsCtx = nullptr;
+
+  /// \brief Color conversion contexts, one per band of rows, used instead
+  /// of swsCtx when the frame is not resized.
+  public: std::vector<SwsContext *> swsBands;
+
+  /// \brief Number of rows of each band.
+  public: unsigned int bandRows = 0;
+
+  /// \brief A frame waiting to be encoded.
+  public: class Frame
+  {
+    /// \brief RGB24 pixels.
+    public: std::vector<unsigned char> data;
+
+    /// \brief Width in pixels.
+    public: unsigned int width = 0;
+
+    /// \brief Height in pixels.
+    public: unsigned int height = 0;
+  };
+
+  /// \brief Encode the frames of the queue until it is empty and the
+  /// encoder is stopped. Runs in the encoding thread.
+  public: void Run();
+
+  /// \brief Convert and encode a frame.
+  /// \param[in] _frame Frame to encode.
+  /// \return True on success.
+  public: bool Encode(const Frame &_frame);
+
+  /// \brief Set up the color conversion for a size of frame.
+  /// \param[in] _width Width of the frames.
+  /// \param[in] _height Height of the frames.
+  /// \return True on success.
+  public: bool InitConversion(const unsigned int _width,
+              const unsigned int _height);
+
+  /// \brief Free the color conversion contexts.
+  public: void FiniConversion();
+
+  /// \brief Send a frame to the codec and write the packets it returns.
+  /// \param[in] _frame Frame to encode, nullptr to drain the codec.
+  /// \return True on success.
+  public: bool WritePackets(AVFrame *_frame);
+
+  /// \brief Thread encoding the queued frames.
+  public: std::thread worker;
+
+  /// \brief Frames waiting to be encoded.
+  public: std::deque<Frame> queue;
+
+  /// \brief Buffers of encoded frames, reused for new frames.
+  public: std::vector<std::vector<unsigned char>> spare;
+
+  /// \brief True to make the encoding thread exit once the queue is empty.
+  public: bool stopWorker = false;
+
+  /// \brief Number of frames dropped because the queue was full.
+  public: uint64_t dropped = 0;
+
+  /// \brief Protects the queue, spare buffers and stopWorker.
+  public: std::mutex queueMutex;
+
+  /// \brief Signaled when a frame is queued or the encoder stops.
+  public: std::condition_variable queueCond;
 #endif
 
   /// \brief True if the encoder is running
@@ -159,8 +236,7 @@ bool VideoEncoder::Start(const std::string &_format,
 
   // This will be true if Stop has been called, but not reset. We will reset
   // automatically to prevent any errors.
-  if (this->dataPtr->formatCtx || this->dataPtr->avInFrame ||
-      this->dataPtr->avOutFrame || this->dataPtr->swsCtx)
+  if (this->dataPtr->formatCtx || this->dataPtr->avOutFrame)
   {
     this->Reset();
   }
@@ -294,7 +370,7 @@ bool VideoEncoder::Start(const std::string &_format,
   }
 
   // find the video encoder
-  AVCodec *encoder = avcodec_find_encoder(
+  const AVCodec *encoder = avcodec_find_encoder(
       this->dataPtr->formatCtx->oformat->video_codec);
   if (!encoder)
   {
@@ -309,6 +385,36 @@ bool VideoEncoder::Start(const std::string &_format,
     return false;
   }
 
+  // Encoders to try, in order. Hardware encoders come first when asked
+  // for, the software encoder is the fallback.
+  std::vector<const AVCodec *> encoders;
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(57, 24, 1)
+  const char *hwEnv = std::getenv("GAZEBO_VIDEO_HW_ENCODER");
+  if (hwEnv && std::string(hwEnv) != "0")
+  {
+    std::vector<std::string> names;
+    if (std::string(hwEnv) == "1" || std::string(hwEnv) == "auto")
+    {
+      // Hardware encoders that take frames from system memory
+      std::string codecName = avcodec_get_name(encoder->id);
+      for (auto suffix : {"_nvenc", "_qsv", "_v4l2m2m"})
+        names.push_back(codecName + suffix);
+    }
+    else
+    {
+      names.push_back(hwEnv);
+    }
+
+    for (const auto &name : names)
+    {
+      const AVCodec *hw = avcodec_find_encoder_by_name(name.c_str());
+      if (hw && hw->id == encoder->id)
+        encoders.push_back(hw);
+    }
+  }
+#endif
+  encoders.push_back(encoder);
+
   // Create a new video stream
 #if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(57, 24, 1)
   this->dataPtr->videoStream = avformat_new_stream(this->dataPtr->formatCtx,
@@ -326,78 +432,113 @@ bool VideoEncoder::Start(const std::string &_format,
   }
   this->dataPtr->videoStream->id = this->dataPtr->formatCtx->nb_streams-1;
 
-  // Allocate a new video context
+  int ret = -1;
+  for (auto candidate : encoders)
+  {
+    // Allocate a new video context
 #if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(57, 24, 1)
-  this->dataPtr->codecCtx = this->dataPtr->videoStream->codec;
+    this->dataPtr->codecCtx = this->dataPtr->videoStream->codec;
 #else
-  this->dataPtr->codecCtx = avcodec_alloc_context3(encoder);
+    this->dataPtr->codecCtx = avcodec_alloc_context3(candidate);
 #endif
 
-  if (!this->dataPtr->codecCtx)
-  {
-    gzerr << "Could not allocate an encoding context."
-          << "Video encoding is not started\n";
-    this->Reset();
-    return false;
-  }
+    if (!this->dataPtr->codecCtx)
+    {
+      gzerr << "Could not allocate an encoding context."
+            << "Video encoding is not started\n";
+      this->Reset();
+      return false;
+    }
 
-  // some formats want stream headers to be separate
-  if (this->dataPtr->formatCtx->oformat->flags & AVFMT_GLOBALHEADER)
-  {
+    // some formats want stream headers to be separate
+    if (this->dataPtr->formatCtx->oformat->flags & AVFMT_GLOBALHEADER)
+    {
 #if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(57, 24, 1)
-    this->dataPtr->codecCtx->flags |= CODEC_FLAG_GLOBAL_HEADER;
+      this->dataPtr->codecCtx->flags |= CODEC_FLAG_GLOBAL_HEADER;
 #else
-    this->dataPtr->codecCtx->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
+      this->dataPtr->codecCtx->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
 #endif
-  }
+    }
 
-  // Frames per second
-  this->dataPtr->codecCtx->time_base.den = this->dataPtr->fps;
-  this->dataPtr->codecCtx->time_base.num = 1;
+    // Frames per second
+    this->dataPtr->codecCtx->time_base.den = this->dataPtr->fps;
+    this->dataPtr->codecCtx->time_base.num = 1;
 
-  // The video stream must have the same time base as the context
-  this->dataPtr->videoStream->time_base.den = this->dataPtr->fps;
-  this->dataPtr->videoStream->time_base.num = 1;
+    // The video stream must have the same time base as the context
+    this->dataPtr->videoStream->time_base.den = this->dataPtr->fps;
+    this->dataPtr->videoStream->time_base.num = 1;
 
-  // Bitrate
-  this->dataPtr->codecCtx->bit_rate = this->dataPtr->bitRate;
+    // Bitrate
+    this->dataPtr->codecCtx->bit_rate = this->dataPtr->bitRate;
 
-  // The resolution must be divisible by two
-  this->dataPtr->codecCtx->width = _width % 2 == 0 ? _width : _width + 1;
-  this->dataPtr->codecCtx->height = _height % 2 == 0 ? _height : _height + 1;
+    // The resolution must be divisible by two
+    this->dataPtr->codecCtx->width = _width % 2 == 0 ? _width : _width + 1;
+    this->dataPtr->codecCtx->height =
+      _height % 2 == 0 ? _height : _height + 1;
 
-  // Emit one intra-frame every 10 frames
-  this->dataPtr->codecCtx->gop_size = 10;
-  this->dataPtr->codecCtx->max_b_frames = 1;
-  this->dataPtr->codecCtx->pix_fmt = AV_PIX_FMT_YUV420P;
-  this->dataPtr->codecCtx->thread_count = 5;
+    // Emit one intra-frame every 10 frames
+    this->dataPtr->codecCtx->gop_size = 10;
+    this->dataPtr->codecCtx->max_b_frames = 1;
+    this->dataPtr->codecCtx->pix_fmt = AV_PIX_FMT_YUV420P;
+    this->dataPtr->codecCtx->thread_count = 5;
 
-  // Set the codec id
-  this->dataPtr->codecCtx->codec_id =
-    this->dataPtr->formatCtx->oformat->video_codec;
+    // Some hardware encoders only take semi-planar frames
+    if (candidate->pix_fmts)
+    {
+      bool planar = false;
+      bool semiPlanar = false;
+      for (auto fmt = candidate->pix_fmts; *fmt != AV_PIX_FMT_NONE; ++fmt)
+      {
+        planar = planar || *fmt == AV_PIX_FMT_YUV420P;
+        semiPlanar = semiPlanar || *fmt == AV_PIX_FMT_NV12;
+      }
+      if (!planar && semiPlanar)
+        this->dataPtr->codecCtx->pix_fmt = AV_PIX_FMT_NV12;
+    }
 
-  if (this->dataPtr->codecCtx->codec_id == AV_CODEC_ID_MPEG1VIDEO)
-  {
-    // Needed to avoid using macroblocks in which some coeffs overflow.
-    // This does not happen with normal video, it just happens here as
-    // the motion of the chroma plane does not match the luma plane.
-    this->dataPtr->codecCtx->mb_decision = 2;
-  }
+    // Set the codec id
+    this->dataPtr->codecCtx->codec_id =
+      this->dataPtr->formatCtx->oformat->video_codec;
 
-  if (this->dataPtr->codecCtx->codec_id == AV_CODEC_ID_H264)
-  {
-    av_opt_set(this->dataPtr->codecCtx->priv_data, "preset", "slow", 0);
+    if (this->dataPtr->codecCtx->codec_id == AV_CODEC_ID_MPEG1VIDEO)
+    {
+      // Needed to avoid using macroblocks in which some coeffs overflow.
+      // This does not happen with normal video, it just happens here as
+      // the motion of the chroma plane does not match the luma plane.
+      this->dataPtr->codecCtx->mb_decision = 2;
+    }
+
+    if (this->dataPtr->codecCtx->codec_id == AV_CODEC_ID_H264)
+    {
+      av_opt_set(this->dataPtr->codecCtx->priv_data, "preset", "slow", 0);
 
 #if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(57, 24, 1)
-    av_opt_set(this->dataPtr->videoStream->codec->priv_data,
-        "preset", "slow", 0);
+      av_opt_set(this->dataPtr->videoStream->codec->priv_data,
+          "preset", "slow", 0);
 #else
-    av_opt_set(this->dataPtr->videoStream->priv_data, "preset", "slow", 0);
+      av_opt_set(this->dataPtr->videoStream->priv_data, "preset", "slow", 0);
+#endif
+    }
+
+    // Open the video context
+    ret = avcodec_open2(this->dataPtr->codecCtx, candidate, 0);
+    if (ret >= 0)
+    {
+      if (candidate != encoder)
+        gzmsg << "Encoding video with [" << candidate->name << "]\n";
+      break;
+    }
+
+    if (candidate != encoder)
+    {
+      gzwarn << "Unable to open encoder [" << candidate->name
+             << "], trying the next one\n";
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(57, 24, 1)
+      avcodec_free_context(&this->dataPtr->codecCtx);
 #endif
+    }
   }
 
-  // Open the video context
-  int ret = avcodec_open2(this->dataPtr->codecCtx, encoder, 0);
   if (ret < 0)
   {
     char errBuff[AV_ERROR_MAX_STRING_SIZE];
@@ -496,6 +637,12 @@ bool VideoEncoder::Start(const std::string &_format,
     return false;
   }
 
+  // Frames are converted and encoded in their own thread
+  this->dataPtr->stopWorker = false;
+  this->dataPtr->dropped = 0;
+  this->dataPtr->worker =
+    std::thread(&VideoEncoderPrivate::Run, this->dataPtr.get());
+
   this->dataPtr->encoding = true;
   return true;
 }
@@ -532,7 +679,6 @@ bool VideoEncoder::AddFrame(const unsigned char *_frame,
 
 #ifdef HAVE_FFMPEG
 /////////////////////////////////////////////////
-// This function supports ffmpeg2
 bool VideoEncoder::AddFrame(const unsigned char *_frame,
     const unsigned int _width,
     const unsigned int _height,
@@ -554,163 +700,289 @@ bool VideoEncoder::AddFrame(const unsigned char *_frame,
 
   this->dataPtr->timePrev = _timestamp;
 
-  // Cause the sws to be recreated on image resize
-  if (this->dataPtr->swsCtx &&
-      (this->dataPtr->inWidth != _width || this->dataPtr->inHeight != _height))
+  // Take a buffer of an encoded frame, or drop this one if the encoding
+  // thread is too far behind. Only this function adds to the queue.
+  VideoEncoderPrivate::Frame frame;
   {
-    sws_freeContext(this->dataPtr->swsCtx);
-    this->dataPtr->swsCtx = nullptr;
+    std::lock_guard<std::mutex> queueLock(this->dataPtr->queueMutex);
+    if (this->dataPtr->queue.size() >= kMaxQueuedFrames)
+    {
+      ++this->dataPtr->dropped;
+      return false;
+    }
 
-    if (this->dataPtr->avInFrame)
-#if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(57, 24, 1)
-      av_free(this->dataPtr->avInFrame);
-#else
-      av_frame_free(&this->dataPtr->avInFrame);
-#endif
-    this->dataPtr->avInFrame = nullptr;
+    if (!this->dataPtr->spare.empty())
+    {
+      frame.data = std::move(this->dataPtr->spare.back());
+      this->dataPtr->spare.pop_back();
+    }
   }
 
-  if (!this->dataPtr->swsCtx)
+  frame.data.assign(_frame, _frame + _width * _height * 3);
+  frame.width = _width;
+  frame.height = _height;
+
   {
-    this->dataPtr->inWidth = _width;
-    this->dataPtr->inHeight = _height;
+    std::lock_guard<std::mutex> queueLock(this->dataPtr->queueMutex);
+    this->dataPtr->queue.push_back(std::move(frame));
+  }
+  this->dataPtr->queueCond.notify_one();
 
-    if (!this->dataPtr->avInFrame)
-    {
-#if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(57, 24, 1)
-      this->dataPtr->avInFrame = new AVPicture;
-      avpicture_alloc(this->dataPtr->avInFrame,
-          AV_PIX_FMT_RGB24, this->dataPtr->inWidth,
-          this->dataPtr->inHeight);
-#else
-      this->dataPtr->avInFrame = av_frame_alloc();
+  return true;
+}
 
-      av_image_alloc(this->dataPtr->avInFrame->data,
-          this->dataPtr->avInFrame->linesize,
-          this->dataPtr->inWidth, this->dataPtr->inHeight,
-          AV_PIX_FMT_RGB24, 1);
-#endif
-    }
+/////////////////////////////////////////////////
+void VideoEncoderPrivate::Run()
+{
+  common::SetThreadName("VideoEncoder");
+  std::unique_lock<std::mutex> lock(this->queueMutex);
+  while (true)
+  {
+    this->queueCond.wait(lock, [this]
+        {
+          return this->stopWorker || !this->queue.empty();
+        });
+
+    // Stopped, and every queued frame was encoded
+    if (this->queue.empty())
+      break;
+
+    Frame frame = std::move(this->queue.front());
+    this->queue.pop_front();
+    lock.unlock();
+
+    this->Encode(frame);
+
+    lock.lock();
+    this->spare.push_back(std::move(frame.data));
+  }
+}
+
+/////////////////////////////////////////////////
+bool VideoEncoderPrivate::Encode(const Frame &_frame)
+{
+  // Recreate the conversion on image resize
+  if ((this->swsCtx || !this->swsBands.empty()) &&
+      (this->inWidth != _frame.width || this->inHeight != _frame.height))
+  {
+    this->FiniConversion();
+  }
+
+  if (!this->swsCtx && this->swsBands.empty() &&
+      !this->InitConversion(_frame.width, _frame.height))
+  {
+    return false;
+  }
 
-    this->dataPtr->swsCtx = sws_getContext(
-        this->dataPtr->inWidth,
-        this->dataPtr->inHeight,
-        AV_PIX_FMT_RGB24,
-        this->dataPtr->codecCtx->width,
-        this->dataPtr->codecCtx->height,
-        this->dataPtr->codecCtx->pix_fmt,
-        SWS_BICUBIC, nullptr, nullptr, nullptr);
+  const uint8_t *srcData[4] = {_frame.data.data(), nullptr, nullptr, nullptr};
+  int srcLinesize[4] = {static_cast<int>(_frame.width * 3), 0, 0, 0};
 
-    if (this->dataPtr->swsCtx == nullptr)
+  if (this->swsCtx)
+  {
+    sws_scale(this->swsCtx, srcData, srcLinesize, 0, this->inHeight,
+        this->avOutFrame->data, this->avOutFrame->linesize);
+  }
+  else
+  {
+    // Convert the bands in parallel, each one into its rows of every plane
+    const AVPixFmtDescriptor *desc =
+      av_pix_fmt_desc_get(this->codecCtx->pix_fmt);
+    const int planes = av_pix_fmt_count_planes(this->codecCtx->pix_fmt);
+
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, this->swsBands.size(), 1),
+        [&](const tbb::blocked_range<size_t> &_range)
+        {
+          for (size_t i = _range.begin(); i != _range.end(); ++i)
+          {
+            const unsigned int row = i * this->bandRows;
+            const unsigned int rows =
+              std::min(this->bandRows, this->inHeight - row);
+
+            const uint8_t *src[4] = {
+              srcData[0] + row * srcLinesize[0], nullptr, nullptr, nullptr};
+            uint8_t *dst[4] = {nullptr, nullptr, nullptr, nullptr};
+            for (int p = 0; p < planes; ++p)
+            {
+              const unsigned int planeRow =
+                (p == 1 || p == 2) ? row >> desc->log2_chroma_h : row;
+              dst[p] = this->avOutFrame->data[p] +
+                planeRow * this->avOutFrame->linesize[p];
+            }
+
+            sws_scale(this->swsBands[i], src, srcLinesize, 0, rows, dst,
+                this->avOutFrame->linesize);
+          }
+        });
+  }
+
+  this->avOutFrame->pts = this->frameCount++;
+
+  return this->WritePackets(this->avOutFrame);
+}
+
+/////////////////////////////////////////////////
+bool VideoEncoderPrivate::InitConversion(const unsigned int _width,
+    const unsigned int _height)
+{
+  this->inWidth = _width;
+  this->inHeight = _height;
+
+  // Frames that keep their size are converted by several contexts, one
+  // per band of rows. Bands hold an even number of rows so they start on
+  // a row of the subsampled chroma planes.
+  const unsigned int threads = std::thread::hardware_concurrency();
+  if (threads > 1 &&
+      static_cast<int>(_width) == this->codecCtx->width &&
+      static_cast<int>(_height) == this->codecCtx->height &&
+      _height >= 2 * kMinBandRows)
+  {
+    unsigned int bands = std::min(threads, _height / kMinBandRows);
+    this->bandRows = ((_height + bands - 1) / bands + 1) & ~1u;
+    bands = (_height + this->bandRows - 1) / this->bandRows;
+
+    for (unsigned int i = 0; i < bands; ++i)
     {
-      gzerr << "Error while calling sws_getContext\n";
-      return false;
+      const unsigned int rows =
+        std::min(this->bandRows, _height - i * this->bandRows);
+      SwsContext *ctx = sws_getContext(_width, rows, AV_PIX_FMT_RGB24,
+          _width, rows, this->codecCtx->pix_fmt,
+          SWS_BICUBIC, nullptr, nullptr, nullptr);
+      if (!ctx)
+      {
+        this->FiniConversion();
+        break;
+      }
+      this->swsBands.push_back(ctx);
     }
+
+    if (!this->swsBands.empty())
+      return true;
   }
 
-  // encode
-  memcpy(this->dataPtr->avInFrame->data[0], _frame,
-         this->dataPtr->inWidth * this->dataPtr->inHeight * 3);
+  this->swsCtx = sws_getContext(
+      this->inWidth,
+      this->inHeight,
+      AV_PIX_FMT_RGB24,
+      this->codecCtx->width,
+      this->codecCtx->height,
+      this->codecCtx->pix_fmt,
+      SWS_BICUBIC, nullptr, nullptr, nullptr);
 
-  sws_scale(this->dataPtr->swsCtx,
-      this->dataPtr->avInFrame->data,
-      this->dataPtr->avInFrame->linesize,
-      0, this->dataPtr->inHeight,
-      this->dataPtr->avOutFrame->data,
-      this->dataPtr->avOutFrame->linesize);
+  if (this->swsCtx == nullptr)
+  {
+    gzerr << "Error while calling sws_getContext\n";
+    return false;
+  }
 
-  this->dataPtr->avOutFrame->pts = this->dataPtr->frameCount++;
+  return true;
+}
 
-#if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(57, 40, 101)
-  int gotOutput = 0;
-  AVPacket avPacket;
-  av_init_packet(&avPacket);
-  avPacket.data = nullptr;
-  avPacket.size = 0;
+/////////////////////////////////////////////////
+void VideoEncoderPrivate::FiniConversion()
+{
+  if (this->swsCtx)
+    sws_freeContext(this->swsCtx);
+  this->swsCtx = nullptr;
 
-  int ret = avcodec_encode_video2(this->dataPtr->codecCtx, &avPacket,
-      this->dataPtr->avOutFrame, &gotOutput);
+  for (auto ctx : this->swsBands)
+    sws_freeContext(ctx);
+  this->swsBands.clear();
+}
 
-  if (ret >= 0 && gotOutput == 1)
+/////////////////////////////////////////////////
+bool VideoEncoderPrivate::WritePackets(AVFrame *_frame)
+{
+#if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(57, 40, 101)
+  // Without a frame, keep asking until the codec has no packet left
+  while (true)
   {
-    avPacket.stream_index = this->dataPtr->videoStream->index;
+    int gotOutput = 0;
+    AVPacket avPacket;
+    av_init_packet(&avPacket);
+    avPacket.data = nullptr;
+    avPacket.size = 0;
+
+    int ret = avcodec_encode_video2(this->codecCtx, &avPacket,
+        _frame, &gotOutput);
+
+    if (ret < 0 || gotOutput != 1)
+      return ret >= 0;
+
+    avPacket.stream_index = this->videoStream->index;
 
     // Scale timestamp appropriately.
     if (avPacket.pts != static_cast<int64_t>(AV_NOPTS_VALUE))
     {
       avPacket.pts = av_rescale_q(avPacket.pts,
-          this->dataPtr->codecCtx->time_base,
-          this->dataPtr->videoStream->time_base);
+          this->codecCtx->time_base,
+          this->videoStream->time_base);
     }
 
     if (avPacket.dts != static_cast<int64_t>(AV_NOPTS_VALUE))
     {
       avPacket.dts = av_rescale_q(
           avPacket.dts,
-          this->dataPtr->codecCtx->time_base,
-          this->dataPtr->videoStream->time_base);
+          this->codecCtx->time_base,
+          this->videoStream->time_base);
     }
 
     // Write frame to disk
-    ret = av_interleaved_write_frame(this->dataPtr->formatCtx, &avPacket);
+    ret = av_interleaved_write_frame(this->formatCtx, &avPacket);
+    av_packet_unref(&avPacket);
 
     if (ret < 0)
     {
       gzerr << "Error writing frame" << std::endl;
       return false;
     }
-  }
 
-  av_packet_unref(&avPacket);
+    if (_frame)
+      return true;
+  }
 
 // #else for libavcodec version check
 #else
 
   AVPacket *avPacket = av_packet_alloc();
-  av_init_packet(avPacket);
-
-  avPacket->data = nullptr;
-  avPacket->size = 0;
 
-  int ret = avcodec_send_frame(this->dataPtr->codecCtx,
-                               this->dataPtr->avOutFrame);
+  int ret = avcodec_send_frame(this->codecCtx, _frame);
 
   // This loop will retrieve and write available packets
   while (ret >= 0)
   {
-    ret = avcodec_receive_packet(this->dataPtr->codecCtx, avPacket);
+    ret = avcodec_receive_packet(this->codecCtx, avPacket);
 
-    // Potential performance improvement: Queue the packets and write in
-    // a separate thread.
     if (ret >= 0)
     {
-      avPacket->stream_index = this->dataPtr->videoStream->index;
+      avPacket->stream_index = this->videoStream->index;
 
       // Scale timestamp appropriately.
       if (avPacket->pts != static_cast<int64_t>(AV_NOPTS_VALUE))
       {
         avPacket->pts = av_rescale_q(avPacket->pts,
-            this->dataPtr->codecCtx->time_base,
-            this->dataPtr->videoStream->time_base);
+            this->codecCtx->time_base,
+            this->videoStream->time_base);
       }
 
       if (avPacket->dts != static_cast<int64_t>(AV_NOPTS_VALUE))
       {
         avPacket->dts = av_rescale_q(
             avPacket->dts,
-            this->dataPtr->codecCtx->time_base,
-            this->dataPtr->videoStream->time_base);
+            this->codecCtx->time_base,
+            this->videoStream->time_base);
       }
 
       // Write frame to disk
-      if (av_interleaved_write_frame(this->dataPtr->formatCtx, avPacket) < 0)
+      if (av_interleaved_write_frame(this->formatCtx, avPacket) < 0)
         gzerr << "Error writing frame" << std::endl;
+
+      av_packet_unref(avPacket);
     }
   }
 
-  av_packet_unref(avPacket);
-#endif
+  av_packet_free(&avPacket);
   return true;
+#endif
 }
 // #else for HAVE_FFMPEG check
 #else
@@ -730,8 +1002,38 @@ bool VideoEncoder::AddFrame(const unsigned char */*_frame*/,
 bool VideoEncoder::Stop()
 {
 #ifdef HAVE_FFMPEG
-  if (this->dataPtr->encoding && this->dataPtr->formatCtx)
+  // No frame can be added once this is false
+  bool wasEncoding;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    wasEncoding = this->dataPtr->encoding;
+    this->dataPtr->encoding = false;
+  }
+
+  // Let the encoding thread finish the queued frames
+  if (this->dataPtr->worker.joinable())
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->queueMutex);
+      this->dataPtr->stopWorker = true;
+    }
+    this->dataPtr->queueCond.notify_all();
+    this->dataPtr->worker.join();
+    this->dataPtr->spare.clear();
+
+    if (this->dataPtr->dropped > 0)
+    {
+      gzwarn << "Dropped " << this->dataPtr->dropped << " video frames "
+             << "because the encoder could not keep up\n";
+    }
+  }
+
+  if (wasEncoding && this->dataPtr->formatCtx)
+  {
+    // Write the frames the codec still holds
+    this->dataPtr->WritePackets(nullptr);
     av_write_trailer(this->dataPtr->formatCtx);
+  }
 
 #if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(57, 24, 1)
   if (this->dataPtr->codecCtx)
@@ -739,14 +1041,6 @@ bool VideoEncoder::Stop()
 #endif
   this->dataPtr->codecCtx = nullptr;
 
-  if (this->dataPtr->avInFrame)
-#if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(57, 24, 1)
-    av_free(this->dataPtr->avInFrame);
-#else
-    av_frame_free(&this->dataPtr->avInFrame);
-#endif
-  this->dataPtr->avInFrame = nullptr;
-
   if (this->dataPtr->avOutFrame)
 #if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(57, 24, 1)
     av_free(this->dataPtr->avOutFrame);
@@ -755,9 +1049,7 @@ bool VideoEncoder::Stop()
 #endif
   this->dataPtr->avOutFrame = nullptr;
 
-  if (this->dataPtr->swsCtx)
-    sws_freeContext(this->dataPtr->swsCtx);
-  this->dataPtr->swsCtx = nullptr;
+  this->dataPtr->FiniConversion();
 
   // This frees the context and all the streams
   if (this->dataPtr->formatCtx)
@@ -67,6 +67,10 @@ namespace gazebo
       /// the _format is "v4l2". If blank, a default temporary file is used.
       /// However, the "v4l2" _format must be accompanied with a video
       /// loopback device filename.
+      /// Set the GAZEBO_VIDEO_HW_ENCODER environment variable to 1 to try
+      /// the NVENC, Quick Sync and V4L2 memory-to-memory encoders of the
+      /// format's codec first, or to the name of an ffmpeg encoder to try
+      /// that one first. The software encoder is used if none of them opens.
       /// \return True on success
       public: bool Start(
                 const std::string &_format = VIDEO_ENCODER_FORMAT_DEFAULT,
@@ -76,8 +80,8 @@ namespace gazebo
                 const unsigned int _fps = VIDEO_ENCODER_FPS_DEFAULT,
                 const unsigned int _bitRate = VIDEO_ENCODER_BITRATE_DEFAULT);
 
-      /// \brief Stop the encoder. The SaveToFile function also calls this
-      /// function.
+      /// \brief Stop the encoder, after encoding the frames still queued.
+      /// The SaveToFile function also calls this function.
       /// \return True on success.
       public: bool Stop();
 
@@ -85,7 +89,8 @@ namespace gazebo
       /// \return True if Start has been called.
       public: bool IsEncoding() const;
 
-      /// \brief Add a single frame to be encoded
+      /// \brief Add a single frame to be encoded. The frame is copied and
+      /// encoded in a separate thread.
       /// \param[in] _frame Image buffer to be encoded
       /// \param[in] _width Input frame width
       /// \param[in] _height Input frame height
@@ -94,12 +99,15 @@ namespace gazebo
                             const unsigned int _width,
                             const unsigned int _height);
 
-      /// \brief Add a single timestamped frame to be encoded
+      /// \brief Add a single timestamped frame to be encoded. The frame is
+      /// copied and encoded in a separate thread.
       /// \param[in] _frame Image buffer to be encoded
       /// \param[in] _width Input frame width
       /// \param[in] _height Input frame height
       /// \param[in] _timestamp Timestamp of the image frame
-      /// \return True on success.
+      /// \return True if the frame was queued, false if it was skipped
+      /// to keep the video's frame rate or because the encoding thread is
+      /// too far behind.
       public: bool AddFrame(const unsigned char *_frame,
                   const unsigned int _width,
                   const unsigned int _height,
@@ -15,6 +15,10 @@
 */
 #include <gtest/gtest.h>
 
+#include <cstdio>
+#include <string>
+#include <vector>
+
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/VideoEncoder.hh"
 #include "test/util.hh"
@@ -57,6 +61,32 @@ TEST_F(VideoEncoderTest, StartStop)
 #endif
 }
 
+/////////////////////////////////////////////////
+TEST_F(VideoEncoderTest, AddFrame)
+{
+#ifdef HAVE_FFMPEG
+  VideoEncoder video;
+  EXPECT_TRUE(video.Start("mp4", "", 320, 240, 10));
+
+  std::vector<unsigned char> frame(320 * 240 * 3, 128);
+  auto stamp = std::chrono::steady_clock::now();
+  for (unsigned int i = 0; i < 5; ++i)
+  {
+    stamp += std::chrono::milliseconds(100);
+    EXPECT_TRUE(video.AddFrame(frame.data(), 320, 240, stamp));
+  }
+
+  // Too close to the previous frame
+  EXPECT_FALSE(video.AddFrame(frame.data(), 320, 240, stamp));
+
+  // Stopping encodes the queued frames
+  std::string filename = common::cwd() + "/add_frame_test.mp4";
+  EXPECT_TRUE(video.SaveToFile(filename));
+  EXPECT_TRUE(common::exists(filename));
+  std::remove(filename.c_str());
+#endif
+}
+
 /////////////////////////////////////////////////
 TEST_F(VideoEncoderTest, Exists)
 {
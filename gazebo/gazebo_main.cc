@@ -47,15 +47,32 @@ void help()
   << "  -e [ --physics ] arg          Specify a physics engine "
   << "(ode|bullet|dart|simbody).\n"
   << "  -p [ --play ] arg             Play a log file.\n"
+  << "  --play_max_speed              Play the log file as fast as sensors\n"
+  << "                                consume it. Implies --lockstep and\n"
+  << "                                decodes chunks ahead of playback.\n"
   << "  -r [ --record ]               Record state data.\n"
   << "  --record_encoding arg (=zlib) Compression encoding format for log "
   << "data \n"
-  << "                                (zlib|bz2|txt).\n"
+  << "                                (zlib|bz2|zstd|txt|binary).\n"
   << "  --record_path arg             Absolute path in which to store "
   << "state data.\n"
   << "  --record_period arg (=-1)     Recording period (seconds).\n"
   << "  --record_filter arg           Recording filter (supports wildcard and "
   << "regular expression).\n"
+  << "  --record_topic arg            Record the messages of a topic next to "
+  << "the\n"
+  << "                                state data. May be repeated.\n"
+  << "  --record_keyframe_period arg (=-1)\n"
+  << "                                Sim time between full states "
+  << "(seconds).\n"
+  << "  --record_position_tolerance arg (=0.001)\n"
+  << "                                Distance a model moves before it is "
+  << "recorded\n"
+  << "                                again (meters).\n"
+  << "  --record_orientation_tolerance arg (=0.001)\n"
+  << "                                Angle a model turns before it is "
+  << "recorded\n"
+  << "                                again (radians).\n"
   << "  --record_resources           Recording with model meshes and "
   << "materials.\n"
   << "  --seed arg                    Start with a given random number seed.\n"
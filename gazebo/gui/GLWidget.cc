@@ -14,7 +14,11 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
 #include <functional>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
 #include <boost/algorithm/string.hpp>
 #include <boost/lexical_cast.hpp>
 #include <math.h>
@@ -71,6 +75,16 @@ GLWidget::GLWidget(QWidget *_parent)
 
   this->dataPtr->windowId = -1;
 
+  this->dataPtr->statsLabel = new QLabel(this);
+  this->dataPtr->statsLabel->setObjectName("GLWidgetStatsLabel");
+  this->dataPtr->statsLabel->setStyleSheet(
+      "QLabel { background-color : rgba(0, 0, 0, 160); color : white; "
+      "font-family : monospace; padding : 4px; }");
+  this->dataPtr->statsLabel->setAttribute(Qt::WA_TransparentForMouseEvents);
+  this->dataPtr->statsLabel->setVisible(false);
+  this->SetStatsOverlayVisible(
+      gazebo::gui::getINIProperty<int>("rendering.stats_overlay", 0) != 0);
+
   this->setAttribute(Qt::WA_OpaquePaintEvent, true);
   this->setAttribute(Qt::WA_PaintOnScreen, true);
   this->setAttribute(Qt::WA_NoSystemBackground, true);
@@ -281,6 +295,10 @@ void GLWidget::moveEvent(QMoveEvent *_e)
 /////////////////////////////////////////////////
 void GLWidget::paintEvent(QPaintEvent *_e)
 {
+  auto start = std::chrono::steady_clock::now();
+  auto preRenderEnd = start;
+  auto renderEnd = start;
+
   rendering::UserCameraPtr cam = gui::get_active_camera();
   if (cam && cam->Initialized())
   {
@@ -288,12 +306,14 @@ void GLWidget::paintEvent(QPaintEvent *_e)
       IGN_PROFILE("gui::GLWidget::paintEvent pre-render");
       event::Events::preRender();
     }
+    preRenderEnd = std::chrono::steady_clock::now();
 
     // Tell all the cameras to render
     {
       IGN_PROFILE("gui::GLWidget::paintEvent render");
       event::Events::render();
     }
+    renderEnd = std::chrono::steady_clock::now();
 
     {
       IGN_PROFILE("gui::GLWidget::paintEvent post-render");
@@ -306,6 +326,14 @@ void GLWidget::paintEvent(QPaintEvent *_e)
       IGN_PROFILE("gui::GLWidget::paintEvent pre-render");
       event::Events::preRender();
     }
+    preRenderEnd = std::chrono::steady_clock::now();
+    renderEnd = preRenderEnd;
+  }
+
+  if (!this->dataPtr->statsLabel->isHidden())
+  {
+    this->UpdateStatsOverlay(start, preRenderEnd, renderEnd,
+        std::chrono::steady_clock::now());
   }
 
   _e->accept();
@@ -349,6 +377,10 @@ void GLWidget::keyPressEvent(QKeyEvent *_event)
     gui::Events::fullScreen(g_fullscreen);
   }
 
+  // Toggle the render statistics overlay
+  if (_event->key() == Qt::Key_F10)
+    this->SetStatsOverlayVisible(!this->StatsOverlayVisible());
+
   // Trigger a model delete if the Delete key was pressed, and a model
   // is currently selected.
   if (_event->key() == Qt::Key_Delete &&
@@ -921,12 +953,110 @@ void GLWidget::ViewScene(rendering::ScenePtr _scene)
   // client side heightmap configuration
   _scene->SetHeightmapLOD(gazebo::gui::getINIProperty<int>("heightmap.lod", 0));
 
+  // client side pose smoothing, in seconds behind the latest poses
+  _scene->SetPoseInterpolationDelay(gazebo::gui::getINIProperty<double>(
+      "rendering.pose_interpolation_delay", 0.0));
+
   // Update at the camera's update rate
   this->dataPtr->updateTimer->start(
       static_cast<int>(
         std::round(1000.0 / this->dataPtr->userCamera->RenderRate())));
 }
 
+/////////////////////////////////////////////////
+void GLWidget::SetStatsOverlayVisible(const bool _visible)
+{
+  if (_visible == this->StatsOverlayVisible())
+    return;
+
+  // Start counting afresh, the time spent hidden is not a frame
+  auto now = std::chrono::steady_clock::now();
+  this->dataPtr->statsLastStart = now;
+  this->dataPtr->statsLastEnd = now;
+  this->dataPtr->statsLastReport = now;
+  std::fill(std::begin(this->dataPtr->statsStages),
+      std::end(this->dataPtr->statsStages), 0.0);
+  this->dataPtr->statsMaxFrame = 0;
+  this->dataPtr->statsFrames = 0;
+
+  this->dataPtr->statsLabel->setText(tr("Collecting render statistics..."));
+  this->dataPtr->statsLabel->adjustSize();
+  this->dataPtr->statsLabel->move(
+      std::max(0, this->width() - this->dataPtr->statsLabel->width() - 5), 5);
+  this->dataPtr->statsLabel->setVisible(_visible);
+}
+
+/////////////////////////////////////////////////
+bool GLWidget::StatsOverlayVisible() const
+{
+  // Not isVisible(), which is false until the widget itself is shown
+  return !this->dataPtr->statsLabel->isHidden();
+}
+
+/////////////////////////////////////////////////
+void GLWidget::UpdateStatsOverlay(
+    const std::chrono::steady_clock::time_point &_start,
+    const std::chrono::steady_clock::time_point &_preRenderEnd,
+    const std::chrono::steady_clock::time_point &_renderEnd,
+    const std::chrono::steady_clock::time_point &_end)
+{
+  auto ms = [](const std::chrono::steady_clock::time_point &_from,
+      const std::chrono::steady_clock::time_point &_to)
+  {
+    return std::chrono::duration<double, std::milli>(_to - _from).count();
+  };
+
+  // The stages match the profiler scopes in paintEvent. Time between
+  // frames is spent in Qt event processing, including queued callbacks,
+  // and waiting for the update timer.
+  this->dataPtr->statsStages[0] += ms(_start, _preRenderEnd);
+  this->dataPtr->statsStages[1] += ms(_preRenderEnd, _renderEnd);
+  this->dataPtr->statsStages[2] += ms(_renderEnd, _end);
+  this->dataPtr->statsStages[3] += ms(this->dataPtr->statsLastEnd, _start);
+  this->dataPtr->statsMaxFrame = std::max(this->dataPtr->statsMaxFrame,
+      ms(this->dataPtr->statsLastStart, _start));
+  this->dataPtr->statsLastStart = _start;
+  this->dataPtr->statsLastEnd = _end;
+  ++this->dataPtr->statsFrames;
+
+  double elapsed = ms(this->dataPtr->statsLastReport, _end);
+  if (elapsed < 500.0)
+    return;
+
+  double frames = this->dataPtr->statsFrames;
+  std::ostringstream stream;
+  stream << std::fixed << std::setprecision(2)
+    << "Frame        " << std::setw(7) << elapsed / frames << " ms"
+    << " (max " << this->dataPtr->statsMaxFrame << ")\n"
+    << "  Pre-render " << std::setw(7)
+    << this->dataPtr->statsStages[0] / frames << " ms\n"
+    << "  Render     " << std::setw(7)
+    << this->dataPtr->statsStages[1] / frames << " ms\n"
+    << "  Post-render" << std::setw(7)
+    << this->dataPtr->statsStages[2] / frames << " ms\n"
+    << "  Qt / idle  " << std::setw(7)
+    << this->dataPtr->statsStages[3] / frames << " ms";
+
+  rendering::UserCameraPtr cam = gui::get_active_camera();
+  if (cam && cam->Initialized())
+  {
+    stream << "\n"
+      << "Batches      " << std::setw(7) << cam->BatchCount() << "\n"
+      << "Triangles    " << std::setw(7) << cam->TriangleCount();
+  }
+
+  this->dataPtr->statsLabel->setText(QString::fromStdString(stream.str()));
+  this->dataPtr->statsLabel->adjustSize();
+  this->dataPtr->statsLabel->move(
+      std::max(0, this->width() - this->dataPtr->statsLabel->width() - 5), 5);
+
+  this->dataPtr->statsLastReport = _end;
+  std::fill(std::begin(this->dataPtr->statsStages),
+      std::end(this->dataPtr->statsStages), 0.0);
+  this->dataPtr->statsMaxFrame = 0;
+  this->dataPtr->statsFrames = 0;
+}
+
 /////////////////////////////////////////////////
 void GLWidget::SetRenderRate(double _renderRate)
 {
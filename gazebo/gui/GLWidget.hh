@@ -17,6 +17,7 @@
 #ifndef GAZEBO_GUI_GLWIDGET_HH_
 #define GAZEBO_GUI_GLWIDGET_HH_
 
+#include <chrono>
 #include <memory>
 #include <string>
 #include <vector>
@@ -78,6 +79,15 @@ namespace gazebo
       /// \param[in] _renderRate Updated render rate
       public: void SetRenderRate(double _renderRate);
 
+      /// \brief Show or hide the overlay with frame timings and render
+      /// statistics. F10 toggles it as well.
+      /// \param[in] _visible True to show the overlay.
+      public: void SetStatsOverlayVisible(const bool _visible);
+
+      /// \brief Get whether the render statistics overlay is shown.
+      /// \return True if the overlay is visible.
+      public: bool StatsOverlayVisible() const;
+
       signals: void clicked();
 
       /// \brief QT signal to notify when we received a selection msg.
@@ -224,6 +234,18 @@ namespace gazebo
       /// \param[in] _button The QT mouse buttons
       private: void SetMouseEventButtons(const Qt::MouseButtons &_buttons);
 
+      /// \brief Accumulate the timings of a frame and refresh the
+      /// statistics overlay periodically.
+      /// \param[in] _start Time paintEvent started.
+      /// \param[in] _preRenderEnd Time the pre-render stage finished.
+      /// \param[in] _renderEnd Time the render stage finished.
+      /// \param[in] _end Time the post-render stage finished.
+      private: void UpdateStatsOverlay(
+                   const std::chrono::steady_clock::time_point &_start,
+                   const std::chrono::steady_clock::time_point &_preRenderEnd,
+                   const std::chrono::steady_clock::time_point &_renderEnd,
+                   const std::chrono::steady_clock::time_point &_end);
+
       /// \internal
       /// \brief Pointer to private data.
       private: std::unique_ptr<GLWidgetPrivate> dataPtr;
@@ -17,6 +17,7 @@
 #ifndef _GAZEBO_GUI_GLWIDGET_PRIVATE_HH_
 #define _GAZEBO_GUI_GLWIDGET_PRIVATE_HH_
 
+#include <chrono>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -117,6 +118,28 @@ namespace gazebo
 
       /// \brief Time when the last wheel event was processed
       public: common::Time lastWheelEventTime;
+
+      /// \brief Overlay showing frame timings and render statistics.
+      public: QLabel *statsLabel = nullptr;
+
+      /// \brief Start of the previous frame.
+      public: std::chrono::steady_clock::time_point statsLastStart;
+
+      /// \brief End of the previous frame.
+      public: std::chrono::steady_clock::time_point statsLastEnd;
+
+      /// \brief Last time the overlay text was refreshed.
+      public: std::chrono::steady_clock::time_point statsLastReport;
+
+      /// \brief Milliseconds spent since the last refresh in pre-render,
+      /// render, post-render and between frames, in that order.
+      public: double statsStages[4] = {0, 0, 0, 0};
+
+      /// \brief Longest frame since the last refresh, in milliseconds.
+      public: double statsMaxFrame = 0;
+
+      /// \brief Number of frames since the last refresh.
+      public: unsigned int statsFrames = 0;
     };
   }
 }
@@ -25,7 +25,6 @@
 #include <boost/program_options.hpp>
 #include <boost/property_tree/ini_parser.hpp>
 
-#include <ignition/common/Profiler.hh>
 #include <ignition/math/SemanticVersion.hh>
 
 #include "gazebo/gui/qt.h"
@@ -35,6 +34,8 @@
 #include "gazebo/common/ModelDatabase.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Plugin.hh"
+#include "gazebo/common/SamplingProfiler.hh"
+#include "gazebo/common/StartupTrace.hh"
 #include "gazebo/common/CommonTypes.hh"
 #include "gazebo/gui/SplashScreen.hh"
 #include "gazebo/gui/MainWindow.hh"
@@ -317,6 +318,8 @@ bool gui::loadINI(boost::filesystem::path _file)
 /////////////////////////////////////////////////
 bool gui::load()
 {
+  common::StartupTraceScope trace("gui::load", "gui");
+
   gui::loadINI();
 
   g_modelRightMenu = new gui::ModelRightMenu();
@@ -365,7 +368,10 @@ bool gui::load()
 
   g_main_win = new gui::MainWindow();
 
-  g_main_win->Load();
+  {
+    common::StartupTraceScope mainWindowTrace("MainWindow::Load", "gui");
+    g_main_win->Load();
+  }
 
   return true;
 }
@@ -383,7 +389,7 @@ unsigned int gui::get_entity_id(const std::string &_name)
 /////////////////////////////////////////////////
 bool gui::run(int _argc, char **_argv)
 {
-  IGN_PROFILE_THREAD_NAME("gzclient");
+  common::SetThreadName("gzclient");
 
   // Initialize the informational logger. This will log warnings, and errors.
   gzLogInit("client-", "gzclient.log");
@@ -439,6 +445,8 @@ bool gui::run(int _argc, char **_argv)
   // }
 #endif
 
+  common::StartupTrace::Finish("gzclient");
+
   g_app->exec();
 
   gazebo::gui::fini();
@@ -17,6 +17,7 @@
 #include <functional>
 #include <fstream>
 #include <cstdlib>
+#include <sstream>
 
 #include <boost/bind/bind.hpp>
 #include <boost/filesystem.hpp>
@@ -87,6 +88,19 @@ InsertModelWidget::InsertModelWidget(QWidget *_parent)
   // Create a system path watcher
   this->dataPtr->watcher = new QFileSystemWatcher();
 
+  // Also insert additional paths from gui.ini
+  std::string additionalPaths =
+      gui::getINIProperty<std::string>("model_paths.filenames", "");
+  if (!additionalPaths.empty())
+    common::SystemPaths::Instance()->AddModelPaths(additionalPaths);
+
+  const char *home = std::getenv("HOME");
+  if (home)
+  {
+    this->dataPtr->indexFile =
+        (boost::filesystem::path(home) / ".gazebo" / "model_index").string();
+  }
+
   // Update the list of models on the local system.
   this->UpdateAllLocalPaths();
 
@@ -100,27 +114,6 @@ InsertModelWidget::InsertModelWidget(QWidget *_parent)
   this->dataPtr->fileTreeWidget->addTopLevelItem(
       this->dataPtr->modelDatabaseItem);
 
-  // Also insert additional paths from gui.ini
-  std::string additionalPaths =
-      gui::getINIProperty<std::string>("model_paths.filenames", "");
-  if (!additionalPaths.empty())
-  {
-    common::SystemPaths::Instance()->AddModelPaths(additionalPaths);
-
-    // Get each path in the : separated list
-    std::string delim(":");
-    size_t pos1 = 0;
-    size_t pos2 = additionalPaths.find(delim);
-    while (pos2 != std::string::npos)
-    {
-      this->UpdateLocalPath(additionalPaths.substr(pos1, pos2-pos1));
-      pos1 = pos2+1;
-      pos2 = additionalPaths.find(delim, pos2+1);
-    }
-    this->UpdateLocalPath(additionalPaths.substr(pos1,
-          additionalPaths.size()-pos1));
-  }
-
   // Connect callbacks now that everything else is initialized
 
   // Connect a callback that is triggered whenever a directory is changed.
@@ -178,6 +171,11 @@ void InsertModelWidget::HandleButton()
 InsertModelWidget::~InsertModelWidget()
 {
   gInsertModelWidgetDeleted = true;
+
+  this->dataPtr->stopScan = true;
+  if (this->dataPtr->scanThread.joinable())
+    this->dataPtr->scanThread.join();
+
   delete this->dataPtr->watcher;
   delete this->dataPtr;
   this->dataPtr = NULL;
@@ -326,130 +324,328 @@ void InsertModelWidget::UpdateLocalPath(const std::string &_path)
   if (_path.empty())
     return;
 
+  LocalPathScan scan;
+  this->ScanLocalPath(_path, scan);
+  this->ShowLocalPath(scan);
+}
+
+/////////////////////////////////////////////////
+void InsertModelWidget::ScanLocalPath(const std::string &_path,
+    LocalPathScan &_scan)
+{
+  _scan.path = _path;
+
   boost::filesystem::path dir(_path);
-  bool pathExists = this->IsPathAccessible(dir);
+  if (!this->IsPathAccessible(dir) || !boost::filesystem::is_directory(dir))
+    return;
 
-  QString qpath = QString::fromStdString(_path);
-  QTreeWidgetItem *topItem = NULL;
+  std::vector<boost::filesystem::path> paths;
 
-  QList<QTreeWidgetItem *> matchList =
-    this->dataPtr->fileTreeWidget->findItems(qpath, Qt::MatchExactly);
+  // Get all the paths in alphabetical order
+  try
+  {
+    std::copy(boost::filesystem::directory_iterator(dir),
+        boost::filesystem::directory_iterator(),
+        std::back_inserter(paths));
+  }
+  catch(boost::filesystem::filesystem_error & e)
+  {
+    gzerr << "Not loading models in: " << _path << " ("
+          << e.what() << ")" << std::endl;
+    return;
+  }
 
-  // Create a top-level tree item for the path
-  if (matchList.empty())
+  std::sort(paths.begin(), paths.end());
+
+  // Iterate over all the models in the current gazebo path
+  for (std::vector<boost::filesystem::path>::iterator dIter = paths.begin();
+      dIter != paths.end(); ++dIter)
   {
-    topItem = new QTreeWidgetItem(
-        static_cast<QTreeWidgetItem*>(0), QStringList(qpath));
-    this->dataPtr->fileTreeWidget->addTopLevelItem(topItem);
-    this->dataPtr->localFilenameCache.insert(_path);
+    std::string modelName;
+    boost::filesystem::path fullPath = _path / dIter->filename();
+    boost::filesystem::path manifest = fullPath;
 
-    // Add the new path to the directory watcher
-    if (pathExists)
+    if (!boost::filesystem::is_directory(fullPath))
     {
-      this->dataPtr->watcher->addPath(qpath);
+      if (dIter->filename() != "database.config")
+      {
+        gzlog << "Invalid filename or directory[" << fullPath
+          << "] in GAZEBO_MODEL_PATH. It's not a good idea to put extra "
+          << "files in a GAZEBO_MODEL_PATH because the file structure may"
+          << " be modified by Gazebo.\n";
+      }
+      continue;
     }
-  }
-  else
-    topItem = matchList.first();
 
-  // Remove current items.
-  topItem->takeChildren();
+    manifest /= GZ_MODEL_MANIFEST_FILENAME;
 
-  if (pathExists && boost::filesystem::is_directory(dir))
-  {
-    std::vector<boost::filesystem::path> paths;
+    // Check if the manifest does not exists
+    if (!this->IsPathAccessible(manifest))
+    {
+      gzerr << "Missing " << GZ_MODEL_MANIFEST_FILENAME << " for model "
+        << (*dIter) << "\n";
+
+      manifest = manifest / "manifest.xml";
+    }
+
+    if (!this->IsPathAccessible(manifest) || manifest == fullPath)
+    {
+      gzlog << "model.config file is missing in directory["
+            << fullPath << "]\n";
+      continue;
+    }
 
-    // Get all the paths in alphabetical order
+    // Only parse manifests that changed since they were indexed
+    ModelIndexEntry entry;
     try
     {
-      std::copy(boost::filesystem::directory_iterator(dir),
-          boost::filesystem::directory_iterator(),
-          std::back_inserter(paths));
+      entry.modified = boost::filesystem::last_write_time(manifest);
+      entry.size = boost::filesystem::file_size(manifest);
     }
-    catch(boost::filesystem::filesystem_error & e)
+    catch(boost::filesystem::filesystem_error &)
     {
-      gzerr << "Not loading models in: " << _path << " ("
-            << e.what() << ")" << std::endl;
-      return;
     }
+    entry.seen = true;
 
-    std::sort(paths.begin(), paths.end());
-
-    // Iterate over all the models in the current gazebo path
-    for (std::vector<boost::filesystem::path>::iterator dIter = paths.begin();
-        dIter != paths.end(); ++dIter)
+    bool indexed = false;
     {
-      std::string modelName;
-      boost::filesystem::path fullPath = _path / dIter->filename();
-      boost::filesystem::path manifest = fullPath;
-
-      if (!boost::filesystem::is_directory(fullPath))
+      std::lock_guard<std::mutex> lock(this->dataPtr->modelIndexMutex);
+      auto iter = this->dataPtr->modelIndex.find(manifest.string());
+      if (iter != this->dataPtr->modelIndex.end() &&
+          iter->second.modified == entry.modified &&
+          iter->second.size == entry.size)
       {
-        if (dIter->filename() != "database.config")
-        {
-          gzlog << "Invalid filename or directory[" << fullPath
-            << "] in GAZEBO_MODEL_PATH. It's not a good idea to put extra "
-            << "files in a GAZEBO_MODEL_PATH because the file structure may"
-            << " be modified by Gazebo.\n";
-        }
-        continue;
+        iter->second.seen = true;
+        modelName = iter->second.name;
+        indexed = true;
       }
+    }
+
+    if (!indexed)
+    {
+      TiXmlDocument xmlDoc;
+      if (!xmlDoc.LoadFile(manifest.string()))
+        continue;
 
-      manifest /= GZ_MODEL_MANIFEST_FILENAME;
+      TiXmlElement *modelXML = xmlDoc.FirstChildElement("model");
+      if (!modelXML || !modelXML->FirstChildElement("name"))
+        gzerr << "No model name in manifest[" << manifest << "]\n";
+      else if (modelXML->FirstChildElement("name")->GetText())
+        modelName = modelXML->FirstChildElement("name")->GetText();
 
-      // Check if the manifest does not exists
-      if (!this->IsPathAccessible(manifest))
-      {
-        gzerr << "Missing " << GZ_MODEL_MANIFEST_FILENAME << " for model "
-          << (*dIter) << "\n";
+      entry.name = modelName;
+      std::lock_guard<std::mutex> lock(this->dataPtr->modelIndexMutex);
+      this->dataPtr->modelIndex[manifest.string()] = entry;
+      this->dataPtr->modelIndexDirty = true;
+    }
 
-        manifest = manifest / "manifest.xml";
-      }
+    _scan.models.push_back(std::make_pair(fullPath.string(), modelName));
+  }
+}
 
-       if (!this->IsPathAccessible(manifest) || manifest == fullPath)
-      {
-        gzlog << "model.config file is missing in directory["
-              << fullPath << "]\n";
-        continue;
-      }
+/////////////////////////////////////////////////
+void InsertModelWidget::ShowLocalPath(const LocalPathScan &_scan)
+{
+  QTreeWidgetItem *topItem = this->LocalPathItem(_scan.path);
 
-      TiXmlDocument xmlDoc;
-      if (xmlDoc.LoadFile(manifest.string()))
-      {
-        TiXmlElement *modelXML = xmlDoc.FirstChildElement("model");
-        if (!modelXML || !modelXML->FirstChildElement("name"))
-          gzerr << "No model name in manifest[" << manifest << "]\n";
-        else
-          modelName = modelXML->FirstChildElement("name")->GetText();
-        // Add a child item for the model
-        QTreeWidgetItem *childItem = new QTreeWidgetItem(topItem,
-            QStringList(QString::fromStdString(modelName)));
+  // Remove current items.
+  qDeleteAll(topItem->takeChildren());
 
-        childItem->setData(0, Qt::UserRole,
-            QVariant((std::string("file://") + fullPath.string()).c_str()));
+  for (const auto &model : _scan.models)
+  {
+    // Add a child item for the model
+    QTreeWidgetItem *childItem = new QTreeWidgetItem(topItem,
+        QStringList(QString::fromStdString(model.second)));
 
-        this->dataPtr->fileTreeWidget->addTopLevelItem(childItem);
-        this->dataPtr->localFilenameCache.insert(fullPath.string());
-      }
-    }
+    childItem->setData(0, Qt::UserRole,
+        QVariant((std::string("file://") + model.first).c_str()));
+
+    this->dataPtr->localFilenameCache.insert(model.first);
   }
 
   // Make all top-level items expanded. Trying to reduce mouse clicks.
   this->dataPtr->fileTreeWidget->expandItem(topItem);
 }
 
+/////////////////////////////////////////////////
+QTreeWidgetItem *InsertModelWidget::LocalPathItem(const std::string &_path)
+{
+  QString qpath = QString::fromStdString(_path);
+
+  QList<QTreeWidgetItem *> matchList =
+    this->dataPtr->fileTreeWidget->findItems(qpath, Qt::MatchExactly);
+  if (!matchList.empty())
+    return matchList.first();
+
+  // Create a top-level tree item for the path
+  QTreeWidgetItem *topItem = new QTreeWidgetItem(
+      static_cast<QTreeWidgetItem*>(0), QStringList(qpath));
+  this->dataPtr->fileTreeWidget->addTopLevelItem(topItem);
+  this->dataPtr->localFilenameCache.insert(_path);
+
+  // Add the new path to the directory watcher
+  if (this->IsPathAccessible(boost::filesystem::path(_path)))
+    this->dataPtr->watcher->addPath(qpath);
+
+  return topItem;
+}
+
 /////////////////////////////////////////////////
 void InsertModelWidget::UpdateAllLocalPaths()
 {
   std::list<std::string> gazeboPaths =
     common::SystemPaths::Instance()->GetModelPaths();
 
-  // Iterate over all the gazebo paths
-  for (std::list<std::string>::iterator iter = gazeboPaths.begin();
-      iter != gazeboPaths.end(); ++iter)
+  // List every path straight away, the models in them are found on the
+  // scan thread so that large model libraries don't block the GUI
+  std::vector<std::string> paths;
+  for (const auto &path : gazeboPaths)
+  {
+    if (path.empty())
+      continue;
+    this->LocalPathItem(path);
+    paths.push_back(path);
+  }
+
+  this->dataPtr->scanThread = std::thread(
+      &InsertModelWidget::ScanLocalPaths, this, paths);
+}
+
+/////////////////////////////////////////////////
+void InsertModelWidget::ScanLocalPaths(const std::vector<std::string> &_paths)
+{
+  this->LoadModelIndex();
+
+  for (const auto &path : _paths)
+  {
+    if (this->dataPtr->stopScan)
+      return;
+
+    LocalPathScan scan;
+    this->ScanLocalPath(path, scan);
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->scanMutex);
+      this->dataPtr->scanResults.push_back(scan);
+    }
+    QMetaObject::invokeMethod(this, "OnScanResults", Qt::QueuedConnection);
+  }
+
+  this->SaveModelIndex();
+}
+
+/////////////////////////////////////////////////
+void InsertModelWidget::OnScanResults()
+{
+  std::vector<LocalPathScan> results;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->scanMutex);
+    std::swap(results, this->dataPtr->scanResults);
+  }
+
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+  for (const auto &scan : results)
+    this->ShowLocalPath(scan);
+}
+
+/////////////////////////////////////////////////
+void InsertModelWidget::LoadModelIndex()
+{
+  if (this->dataPtr->indexFile.empty())
+    return;
+
+  std::ifstream ifs(this->dataPtr->indexFile.c_str());
+  if (!ifs.is_open())
+    return;
+
+  // One manifest per line: modification time, size, path and model name,
+  // separated by tabs
+  std::map<std::string, ModelIndexEntry> index;
+  std::string line;
+  while (std::getline(ifs, line))
+  {
+    std::istringstream stream(line);
+    std::string modified, size, manifest;
+    ModelIndexEntry entry;
+    if (!std::getline(stream, modified, '\t') ||
+        !std::getline(stream, size, '\t') ||
+        !std::getline(stream, manifest, '\t'))
+    {
+      continue;
+    }
+    std::getline(stream, entry.name);
+
+    try
+    {
+      entry.modified = boost::lexical_cast<std::time_t>(modified);
+      entry.size = boost::lexical_cast<uintmax_t>(size);
+    }
+    catch(boost::bad_lexical_cast &)
+    {
+      continue;
+    }
+    index[manifest] = entry;
+  }
+
+  // Manifests parsed in the meantime are more recent
+  std::lock_guard<std::mutex> lock(this->dataPtr->modelIndexMutex);
+  for (const auto &entry : this->dataPtr->modelIndex)
+    index[entry.first] = entry.second;
+  std::swap(index, this->dataPtr->modelIndex);
+}
+
+/////////////////////////////////////////////////
+void InsertModelWidget::SaveModelIndex()
+{
+  if (this->dataPtr->indexFile.empty())
+    return;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->modelIndexMutex);
+
+  // Drop the manifests that are no longer in any model path
+  bool changed = this->dataPtr->modelIndexDirty;
+  for (auto iter = this->dataPtr->modelIndex.begin();
+       iter != this->dataPtr->modelIndex.end();)
+  {
+    if (!iter->second.seen)
+    {
+      iter = this->dataPtr->modelIndex.erase(iter);
+      changed = true;
+    }
+    else
+      ++iter;
+  }
+
+  if (!changed)
+    return;
+
+  boost::filesystem::path file(this->dataPtr->indexFile);
+  boost::filesystem::path tmpFile(this->dataPtr->indexFile + ".tmp");
+  try
+  {
+    boost::filesystem::create_directories(file.parent_path());
+
+    {
+      std::ofstream ofs(tmpFile.string().c_str());
+      for (const auto &entry : this->dataPtr->modelIndex)
+      {
+        ofs << entry.second.modified << "\t" << entry.second.size << "\t"
+            << entry.first << "\t" << entry.second.name << "\n";
+      }
+      if (!ofs.good())
+      {
+        gzwarn << "Unable to write model index [" << tmpFile << "]\n";
+        return;
+      }
+    }
+
+    // Replace the index in one step, so a reader never sees half of it
+    boost::filesystem::rename(tmpFile, file);
+    this->dataPtr->modelIndexDirty = false;
+  }
+  catch(boost::filesystem::filesystem_error &_e)
   {
-    // This is the full model path
-    this->UpdateLocalPath((*iter));
+    gzwarn << "Unable to save model index [" << file << "]: "
+           << _e.what() << "\n";
   }
 }
 
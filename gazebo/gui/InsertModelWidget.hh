@@ -42,6 +42,7 @@ namespace gazebo
   {
     // Forward declaration.
     class InsertModelWidgetPrivate;
+    class LocalPathScan;
 
     class GZ_GUI_VISIBLE InsertModelWidget : public QWidget
     {
@@ -91,6 +92,9 @@ namespace gazebo
       /// \brief QT callback when addPathButton is clicked.
       private slots: void HandleButton();
 
+      /// \brief Add the local paths scanned by the scan thread to the tree.
+      private slots: void OnScanResults();
+
       /// \brief check if path exists with special care to filesystem
       /// permissions
       /// \param[in] _path The path to check.
@@ -104,6 +108,34 @@ namespace gazebo
       /// \param[in] _path The path to update.
       private: void UpdateLocalPath(const std::string &_path);
 
+      /// \brief Find the models in a local path. Safe to call from any
+      /// thread.
+      /// \param[in] _path The path to scan.
+      /// \param[out] _scan The models found.
+      private: void ScanLocalPath(const std::string &_path,
+                                  LocalPathScan &_scan);
+
+      /// \brief Add a local path and its models to the tree, replacing the
+      /// models already listed under it.
+      /// \param[in] _scan Result of ScanLocalPath.
+      private: void ShowLocalPath(const LocalPathScan &_scan);
+
+      /// \brief Get the tree item of a local path, creating it if needed.
+      /// \param[in] _path The path.
+      /// \return The tree item.
+      private: QTreeWidgetItem *LocalPathItem(const std::string &_path);
+
+      /// \brief Scan local paths on the scan thread, showing each one as
+      /// soon as it is done.
+      /// \param[in] _paths Paths to scan.
+      private: void ScanLocalPaths(const std::vector<std::string> &_paths);
+
+      /// \brief Load the model index from disk.
+      private: void LoadModelIndex();
+
+      /// \brief Save the model index to disk if it changed.
+      private: void SaveModelIndex();
+
       /// \brief Populate the model tree widget with the list of all available
       /// Ignition Fuel servers providing models.
       private: void InitializeFuelServers();
@@ -17,10 +17,16 @@
 #ifndef GAZEBO_GUI_INSERTMODELWIDGETPRIVATE_HH_
 #define GAZEBO_GUI_INSERTMODELWIDGETPRIVATE_HH_
 
+#include <atomic>
+#include <cstdint>
+#include <ctime>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 #include <boost/thread/mutex.hpp>
 
@@ -54,6 +60,33 @@ namespace gazebo
       public: std::vector<ignition::fuel_tools::ModelIdentifier> modelBuffer;
     };
 
+    /// \brief Models found in a local model path.
+    class LocalPathScan
+    {
+      /// \brief The model path.
+      public: std::string path;
+
+      /// \brief Directory and name of each model, sorted by directory.
+      public: std::vector<std::pair<std::string, std::string>> models;
+    };
+
+    /// \brief Model name read from a manifest file, kept in the model
+    /// index so the manifest is only parsed again once it changes.
+    class ModelIndexEntry
+    {
+      /// \brief Modification time of the manifest.
+      public: std::time_t modified = 0;
+
+      /// \brief Size of the manifest in bytes.
+      public: uintmax_t size = 0;
+
+      /// \brief Name of the model.
+      public: std::string name;
+
+      /// \brief True if the manifest was found during this run.
+      public: bool seen = false;
+    };
+
     /// \brief Private class attributes for InsertModelWidget.
     class InsertModelWidgetPrivate
     {
@@ -85,6 +118,32 @@ namespace gazebo
 
       /// \brief A client for using Ignition Fuel services.
       public: std::unique_ptr<ignition::fuel_tools::FuelClient> fuelClient;
+
+      /// \brief Thread scanning the local model paths found at startup.
+      public: std::thread scanThread;
+
+      /// \brief Set to stop the scan thread early.
+      public: std::atomic<bool> stopScan{false};
+
+      /// \brief Scans done by the scan thread and not yet shown.
+      public: std::vector<LocalPathScan> scanResults;
+
+      /// \brief Protects scanResults.
+      public: std::mutex scanMutex;
+
+      /// \brief Model names indexed by manifest path, loaded from and saved
+      /// to indexFile.
+      public: std::map<std::string, ModelIndexEntry> modelIndex;
+
+      /// \brief True if modelIndex changed since it was loaded.
+      public: bool modelIndexDirty = false;
+
+      /// \brief Protects modelIndex and modelIndexDirty.
+      public: std::mutex modelIndexMutex;
+
+      /// \brief File the model index is kept in between runs, empty if
+      /// there is no home directory.
+      public: std::string indexFile;
     };
   }
 }
@@ -15,6 +15,9 @@
  *
  */
 
+#include <cmath>
+#include <mutex>
+
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Time.hh"
 
@@ -134,6 +137,8 @@ LogPlayWidget::LogPlayWidget(QWidget *_parent)
   this->dataPtr->view = new LogPlayView(this);
   connect(this, SIGNAL(SetCurrentTime(common::Time)), this->dataPtr->view,
       SLOT(SetCurrentTime(common::Time)));
+  connect(this, SIGNAL(SetSeeking(bool)), this->dataPtr->view,
+      SLOT(SetSeeking(bool)));
   connect(this, SIGNAL(SetStartTime(common::Time)), this->dataPtr->view,
       SLOT(SetStartTime(common::Time)));
   connect(this, SIGNAL(SetEndTime(common::Time)), this->dataPtr->view,
@@ -398,6 +403,17 @@ void LogPlayWidget::OnSeek(const common::Time &_time)
   msgs::LogPlaybackControl msg;
   msgs::Set(msg.mutable_seek(), _time);
   this->dataPtr->logPlaybackControlPub->Publish(msg);
+
+  // Seeking a large log can take a while on the server. Show the target
+  // right away, and ignore the old times still being reported meanwhile.
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->seekMutex);
+    this->dataPtr->seeking = true;
+    this->dataPtr->seekTarget = _time;
+    this->dataPtr->seekWallTime = common::Time::GetWallTime();
+  }
+  this->SetSeeking(true);
+  this->SetCurrentTime(_time);
 }
 
 /////////////////////////////////////////////////
@@ -434,6 +450,24 @@ void LogPlayWidget::EmitSetCurrentTime(const common::Time &_time)
   if (this->dataPtr->endTime != common::Time::Zero)
     time = std::min(time, this->dataPtr->endTime);
 
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->seekMutex);
+    if (this->dataPtr->seeking)
+    {
+      // The server lands on the last frame before the target, which is
+      // close unless the log was recorded sparsely, hence the timeout
+      auto offset = time - this->dataPtr->seekTarget;
+      if (std::abs(offset.Double()) > 1.0 &&
+          common::Time::GetWallTime() - this->dataPtr->seekWallTime <
+          common::Time(5.0))
+      {
+        return;
+      }
+      this->dataPtr->seeking = false;
+      this->SetSeeking(false);
+    }
+  }
+
   this->dataPtr->currentTime = time;
 
   // Enable/disable buttons
@@ -798,6 +832,12 @@ void LogPlayView::mouseReleaseEvent(QMouseEvent */*_event*/)
   QApplication::setOverrideCursor(QCursor(Qt::ArrowCursor));
 }
 
+/////////////////////////////////////////////////
+void LogPlayView::SetSeeking(const bool _seeking)
+{
+  this->dataPtr->currentTimeItem->SetPending(_seeking);
+}
+
 /////////////////////////////////////////////////
 CurrentTimeItem::CurrentTimeItem()
 {
@@ -812,6 +852,16 @@ CurrentTimeItem::CurrentTimeItem()
   this->setCursor(Qt::SizeAllCursor);
 }
 
+/////////////////////////////////////////////////
+void CurrentTimeItem::SetPending(const bool _pending)
+{
+  if (this->pending == _pending)
+    return;
+
+  this->pending = _pending;
+  this->update();
+}
+
 /////////////////////////////////////////////////
 void CurrentTimeItem::paint(QPainter *_painter,
     const QStyleOptionGraphicsItem */*_option*/, QWidget */*_widget*/)
@@ -842,11 +892,19 @@ void CurrentTimeItem::paint(QPainter *_painter,
   QBrush whiteBrush(Qt::white);
   QBrush orangeBrush(QColor(245, 129, 19, 255));
 
+  QPen greyPen(QColor(150, 150, 150, 255), 0);
+  QBrush greyBrush(QColor(150, 150, 150, 255));
+
   if (this->isSelected())
   {
     _painter->setPen(whitePen);
     _painter->setBrush(whiteBrush);
   }
+  else if (this->pending)
+  {
+    _painter->setPen(greyPen);
+    _painter->setBrush(greyBrush);
+  }
   else
   {
     _painter->setPen(orangePen);
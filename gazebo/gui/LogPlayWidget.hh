@@ -137,6 +137,10 @@ namespace gazebo
       /// \param[in] _time End time.
       signals: void SetEndTime(const common::Time &_time);
 
+      /// \brief Qt signal used to show whether a seek is in progress.
+      /// \param[in] _seeking True while the server seeks.
+      signals: void SetSeeking(const bool _seeking);
+
       /// \brief Publish a multistep message.
       /// \param[in] _step Number of steps.
       private: void PublishMultistep(const int _step);
@@ -178,6 +182,10 @@ namespace gazebo
       /// \brief Draw the timeline.
       public slots: void DrawTimeline();
 
+      /// \brief Show whether a seek is in progress.
+      /// \param[in] _seeking True while the server seeks.
+      public slots: void SetSeeking(const bool _seeking);
+
       /// \brief Qt signal used to seek.
       /// \param[in] _time Time to jump to.
       signals: void Seek(const common::Time &_time);
@@ -206,9 +214,17 @@ namespace gazebo
       /// \brief Constructor;
       public: CurrentTimeItem();
 
+      /// \brief Draw the item greyed out while the time it shows has not
+      /// been reached yet.
+      /// \param[in] _pending True if the time is pending.
+      public: void SetPending(const bool _pending);
+
       // Documentation inherited
       private: virtual void paint(QPainter *_painter,
           const QStyleOptionGraphicsItem *_option, QWidget *_widget);
+
+      /// \brief True if the time shown is pending.
+      private: bool pending = false;
     };
   }
 }
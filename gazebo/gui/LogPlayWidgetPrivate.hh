@@ -17,6 +17,8 @@
 #ifndef _GAZEBO_LOG_PLAY_WIDGET_PRIVATE_HH_
 #define _GAZEBO_LOG_PLAY_WIDGET_PRIVATE_HH_
 
+#include <mutex>
+
 #include "gazebo/gui/qt.h"
 
 namespace gazebo
@@ -99,6 +101,19 @@ namespace gazebo
       /// \brief Number of steps pending to be published once the simulation
       /// is paused.
       public: int pendingStep = 0;
+
+      /// \brief Protects the seek state, which is read when world
+      /// statistics arrive.
+      public: std::mutex seekMutex;
+
+      /// \brief True from sending a seek until the server reaches it.
+      public: bool seeking = false;
+
+      /// \brief Time of the last seek sent.
+      public: common::Time seekTarget;
+
+      /// \brief Wall time the last seek was sent at.
+      public: common::Time seekWallTime;
     };
 
     /// \class LogPlayViewPrivate LogPlayViewPrivate.hh
@@ -58,6 +58,27 @@
 using namespace gazebo;
 using namespace gui;
 
+/////////////////////////////////////////////////
+/// \brief Name stored in the tree item of a model plugin.
+/// \param[in] _model Name of the model.
+/// \param[in] _plugin Name of the plugin.
+/// \return Data URI of the plugin.
+static std::string PluginUri(const std::string &_model,
+    const std::string &_plugin)
+{
+  common::URI pluginUri;
+  pluginUri.SetScheme("data");
+
+  pluginUri.Path().PushBack("world");
+  pluginUri.Path().PushBack(gui::get_world());
+  pluginUri.Path().PushBack("model");
+  pluginUri.Path().PushBack(_model);
+  pluginUri.Path().PushBack("plugin");
+  pluginUri.Path().PushBack(_plugin);
+
+  return pluginUri.Str();
+}
+
 extern ModelRightMenu *g_modelRightMenu;
 
 /////////////////////////////////////////////////
@@ -90,6 +111,9 @@ ModelListWidget::ModelListWidget(QWidget *_parent)
   connect(this->dataPtr->modelTreeWidget,
       SIGNAL(customContextMenuRequested(const QPoint &)),
       this, SLOT(OnCustomContextMenu(const QPoint &)));
+  connect(this->dataPtr->modelTreeWidget,
+      SIGNAL(itemExpanded(QTreeWidgetItem *)),
+      this, SLOT(OnItemExpanded(QTreeWidgetItem *)));
 
   this->dataPtr->variantManager = new QtVariantPropertyManager();
   this->dataPtr->propTreeBrowser = new QtTreePropertyBrowser();
@@ -313,28 +337,32 @@ void ModelListWidget::Update()
     this->dataPtr->fillingPropertyTree = true;
     this->dataPtr->propTreeBrowser->clear();
 
-    if (this->dataPtr->fillTypes[0] == "Model")
+    // Each fill replaces the previous one, so only the latest is drawn and
+    // the property tree is rebuilt at most once per update.
+    std::string fillType = this->dataPtr->fillTypes.back();
+    this->dataPtr->fillTypes.clear();
+
+    if (fillType == "Model")
       this->FillPropertyTree(this->dataPtr->modelMsg, nullptr);
-    else if (this->dataPtr->fillTypes[0] == "Link")
+    else if (fillType == "Link")
       this->FillPropertyTree(this->dataPtr->linkMsg, nullptr);
-    else if (this->dataPtr->fillTypes[0] == "Joint")
+    else if (fillType == "Joint")
       this->FillPropertyTree(this->dataPtr->jointMsg, nullptr);
-    else if (this->dataPtr->fillTypes[0] == "Plugin")
+    else if (fillType == "Plugin")
       this->FillPropertyTree(this->dataPtr->pluginMsg, nullptr);
-    else if (this->dataPtr->fillTypes[0] == "Scene")
+    else if (fillType == "Scene")
       this->FillPropertyTree(this->dataPtr->sceneMsg, nullptr);
-    else if (this->dataPtr->fillTypes[0] == "Physics")
+    else if (fillType == "Physics")
       this->FillPropertyTree(this->dataPtr->physicsMsg, nullptr);
-    else if (this->dataPtr->fillTypes[0] == "Atmosphere")
+    else if (fillType == "Atmosphere")
       this->FillPropertyTree(this->dataPtr->atmosphereMsg, nullptr);
-    else if (this->dataPtr->fillTypes[0] == "Wind")
+    else if (fillType == "Wind")
       this->FillPropertyTree(this->dataPtr->windMsg, nullptr);
-    else if (this->dataPtr->fillTypes[0] == "Light")
+    else if (fillType == "Light")
       this->FillPropertyTree(this->dataPtr->lightMsg, nullptr);
-    else if (this->dataPtr->fillTypes[0] == "Spherical Coordinates")
+    else if (fillType == "Spherical Coordinates")
       this->FillPropertyTree(this->dataPtr->sphericalCoordMsg, nullptr);
     this->dataPtr->fillingPropertyTree = false;
-    this->dataPtr->fillTypes.pop_front();
   }
 
   if (!this->dataPtr->modelTreeWidget->currentItem())
@@ -371,138 +399,229 @@ void ModelListWidget::OnLightUpdate(const msgs::Light &_msg)
 void ModelListWidget::ProcessModelMsgs()
 {
   std::lock_guard<std::mutex> lock(*this->dataPtr->receiveMutex);
-  QFont subheaderFont;
-  subheaderFont.setBold(true);
+  if (this->dataPtr->modelMsgs.empty())
+    return;
+
+  // Apply the whole batch before the tree is drawn again
+  this->dataPtr->modelTreeWidget->setUpdatesEnabled(false);
 
-  for (auto iter = this->dataPtr->modelMsgs.begin();
-       iter != this->dataPtr->modelMsgs.end(); ++iter)
+  for (const auto &msg : this->dataPtr->modelMsgs)
   {
-    std::string name = (*iter).name();
+    const std::string &name = msg.name();
+    bool deleted = msg.has_deleted() && msg.deleted();
 
-    QTreeWidgetItem *listItem = this->ListItem((*iter).name(),
-                                                  this->dataPtr->modelsItem);
+    auto iter = this->dataPtr->modelItems.find(name);
+    if (iter == this->dataPtr->modelItems.end())
+    {
+      if (deleted)
+        continue;
 
-    if (!listItem)
+      // Create an item for the model name, its children are created when
+      // it is expanded.
+      QTreeWidgetItem *topItem = new QTreeWidgetItem(
+          this->dataPtr->modelsItem,
+          QStringList(QString("%1").arg(QString::fromStdString(name))));
+      topItem->setData(0, Qt::UserRole, QVariant(name.c_str()));
+
+      this->dataPtr->modelItems[name] = topItem;
+      this->SetModelChildren(topItem, msg);
+    }
+    else if (deleted)
+    {
+      this->RemoveModelItem(iter->second);
+    }
+    else
     {
-      if (!(*iter).has_deleted() || !(*iter).deleted())
+      iter->second->setText(0, name.c_str());
+      iter->second->setData(1, Qt::UserRole, QVariant(name.c_str()));
+
+      // Messages without children leave the existing ones untouched
+      if (msg.link_size() > 0 || msg.joint_size() > 0 ||
+          msg.plugin_size() > 0)
       {
-        // Create an item for the model name
-        QTreeWidgetItem *topItem = new QTreeWidgetItem(
-            this->dataPtr->modelsItem,
-            QStringList(QString("%1").arg(QString::fromStdString(name))));
+        this->SetModelChildren(iter->second, msg);
+      }
+    }
+  }
+  this->dataPtr->modelMsgs.clear();
 
-        topItem->setData(0, Qt::UserRole, QVariant((*iter).name().c_str()));
-        this->dataPtr->modelTreeWidget->addTopLevelItem(topItem);
+  this->dataPtr->modelTreeWidget->setUpdatesEnabled(true);
+}
 
-        if ((*iter).link_size() > 0)
-        {
-          // Create subheader for links
-          QTreeWidgetItem *linkHeaderItem = new QTreeWidgetItem(topItem,
-          QStringList(QString("%1").arg(QString::fromStdString("LINKS"))));
-          linkHeaderItem->setFont(0, subheaderFont);
-          linkHeaderItem->setFlags(Qt::NoItemFlags);
-          this->dataPtr->modelTreeWidget->addTopLevelItem(linkHeaderItem);
-        }
+/////////////////////////////////////////////////
+void ModelListWidget::SetModelChildren(QTreeWidgetItem *_item,
+    const msgs::Model &_msg)
+{
+  const std::string &name = _msg.name();
 
-        for (int i = 0; i < (*iter).link_size(); ++i)
-        {
-          std::string linkName = (*iter).link(i).name();
-
-          // get unscoped name by stripping parent
-          int index = linkName.find(name) + name.length() + 2;
-          std::string linkNameShort = linkName.substr(index,
-                                                      linkName.size() - index);
-
-          QTreeWidgetItem *linkItem = new QTreeWidgetItem(topItem,
-              QStringList(QString("%1").arg(
-                  QString::fromStdString(linkNameShort))));
-
-          linkItem->setData(0, Qt::UserRole, QVariant(linkName.c_str()));
-          linkItem->setData(1, Qt::UserRole, QVariant((*iter).name().c_str()));
-          linkItem->setData(2, Qt::UserRole, QVariant((*iter).id()));
-          linkItem->setData(3, Qt::UserRole, QVariant("Link"));
-          this->dataPtr->modelTreeWidget->addTopLevelItem(linkItem);
-        }
+  ModelListChildren children;
+  children.id = _msg.id();
+  for (int i = 0; i < _msg.link_size(); ++i)
+    children.links.push_back(_msg.link(i).name());
+  for (int i = 0; i < _msg.joint_size(); ++i)
+    children.joints.push_back(_msg.joint(i).name());
+  for (int i = 0; i < _msg.plugin_size(); ++i)
+    children.plugins.push_back(_msg.plugin(i).name());
 
-        if ((*iter).joint_size() > 0)
-        {
-          // Create subheader for joints
-          QTreeWidgetItem *jointHeaderItem = new QTreeWidgetItem(topItem,
-          QStringList(QString("%1").arg(QString::fromStdString("JOINTS"))));
-          jointHeaderItem->setFont(0, subheaderFont);
-          jointHeaderItem->setFlags(Qt::NoItemFlags);
-          this->dataPtr->modelTreeWidget->addTopLevelItem(jointHeaderItem);
-        }
+  auto iter = this->dataPtr->modelChildren.find(name);
+  if (iter != this->dataPtr->modelChildren.end())
+  {
+    ModelListChildren &old = iter->second;
+    if (old.id == children.id && old.links == children.links &&
+        old.joints == children.joints && old.plugins == children.plugins)
+    {
+      return;
+    }
 
-        for (int i = 0; i < (*iter).joint_size(); ++i)
-        {
-          std::string jointName = (*iter).joint(i).name();
+    for (const auto &link : old.links)
+      this->dataPtr->childOwners.erase(link);
+    for (const auto &joint : old.joints)
+      this->dataPtr->childOwners.erase(joint);
+    for (const auto &plugin : old.plugins)
+      this->dataPtr->childOwners.erase(PluginUri(name, plugin));
 
-          // get unscoped name by stripping parent
-          int index = jointName.find(name) + name.length() + 2;
-          std::string jointNameShort = jointName.substr(
-              index, jointName.size() - index);
+    // Recreate the child items of an expanded model straight away
+    if (old.populated)
+    {
+      qDeleteAll(_item->takeChildren());
+    }
+  }
 
-          QTreeWidgetItem *jointItem = new QTreeWidgetItem(topItem,
-              QStringList(QString("%1").arg(
-                  QString::fromStdString(jointNameShort))));
+  for (const auto &link : children.links)
+    this->dataPtr->childOwners[link] = name;
+  for (const auto &joint : children.joints)
+    this->dataPtr->childOwners[joint] = name;
+  for (const auto &plugin : children.plugins)
+    this->dataPtr->childOwners[PluginUri(name, plugin)] = name;
 
-          jointItem->setData(0, Qt::UserRole, QVariant(jointName.c_str()));
-          jointItem->setData(3, Qt::UserRole, QVariant("Joint"));
-          this->dataPtr->modelTreeWidget->addTopLevelItem(jointItem);
-        }
+  bool hasChildren = !children.links.empty() || !children.joints.empty() ||
+      !children.plugins.empty();
+  this->dataPtr->modelChildren[name] = children;
 
-        if ((*iter).plugin_size() > 0)
-        {
-          // Create subheader for plugins
-          QTreeWidgetItem *pluginHeaderItem = new QTreeWidgetItem(topItem,
-          QStringList(QString("%1").arg("PLUGINS")));
-          pluginHeaderItem->setFont(0, subheaderFont);
-          pluginHeaderItem->setFlags(Qt::NoItemFlags);
-          this->dataPtr->modelTreeWidget->addTopLevelItem(pluginHeaderItem);
-        }
+  _item->setChildIndicatorPolicy(hasChildren ?
+      QTreeWidgetItem::ShowIndicator :
+      QTreeWidgetItem::DontShowIndicatorWhenChildless);
 
-        for (int i = 0; i < (*iter).plugin_size(); ++i)
-        {
-          std::string pluginName = (*iter).plugin(i).name();
+  if (_item->isExpanded())
+    this->PopulateModelItem(_item);
+}
 
-          QTreeWidgetItem *pluginItem = new QTreeWidgetItem(topItem,
-              QStringList(QString("%1").arg(
-                  QString::fromStdString(pluginName))));
+/////////////////////////////////////////////////
+void ModelListWidget::PopulateModelItem(QTreeWidgetItem *_item)
+{
+  std::string name = _item->data(0, Qt::UserRole).toString().toStdString();
 
-          common::URI pluginUri;
-          pluginUri.SetScheme("data");
+  auto iter = this->dataPtr->modelChildren.find(name);
+  if (iter == this->dataPtr->modelChildren.end() || iter->second.populated)
+    return;
 
-          pluginUri.Path().PushBack("world");
-          pluginUri.Path().PushBack(gui::get_world());
-          pluginUri.Path().PushBack("model");
-          pluginUri.Path().PushBack((*iter).name());
-          pluginUri.Path().PushBack("plugin");
-          pluginUri.Path().PushBack(pluginName);
+  ModelListChildren &children = iter->second;
+  children.populated = true;
 
-          pluginItem->setData(0, Qt::UserRole,
-              QVariant(pluginUri.Str().c_str()));
-          pluginItem->setData(3, Qt::UserRole, QVariant("Plugin"));
+  QFont subheaderFont;
+  subheaderFont.setBold(true);
 
-          this->dataPtr->modelTreeWidget->addTopLevelItem(pluginItem);
-        }
-      }
-    }
-    else
-    {
-      if ((*iter).has_deleted() && (*iter).deleted())
-      {
-        int i = this->dataPtr->modelsItem->indexOfChild(listItem);
-        this->dataPtr->modelsItem->takeChild(i);
-      }
-      else
-      {
-        listItem->setText(0, (*iter).name().c_str());
-        listItem->setData(1, Qt::UserRole, QVariant((*iter).name().c_str()));
-      }
-    }
+  if (!children.links.empty())
+  {
+    // Create subheader for links
+    QTreeWidgetItem *linkHeaderItem = new QTreeWidgetItem(_item,
+    QStringList(QString("%1").arg(QString::fromStdString("LINKS"))));
+    linkHeaderItem->setFont(0, subheaderFont);
+    linkHeaderItem->setFlags(Qt::NoItemFlags);
   }
-  this->dataPtr->modelMsgs.clear();
+
+  for (const auto &linkName : children.links)
+  {
+    // get unscoped name by stripping parent
+    int index = linkName.find(name) + name.length() + 2;
+    std::string linkNameShort = linkName.substr(index,
+                                                linkName.size() - index);
+
+    QTreeWidgetItem *linkItem = new QTreeWidgetItem(_item,
+        QStringList(QString("%1").arg(
+            QString::fromStdString(linkNameShort))));
+
+    linkItem->setData(0, Qt::UserRole, QVariant(linkName.c_str()));
+    linkItem->setData(1, Qt::UserRole, QVariant(name.c_str()));
+    linkItem->setData(2, Qt::UserRole, QVariant(children.id));
+    linkItem->setData(3, Qt::UserRole, QVariant("Link"));
+  }
+
+  if (!children.joints.empty())
+  {
+    // Create subheader for joints
+    QTreeWidgetItem *jointHeaderItem = new QTreeWidgetItem(_item,
+    QStringList(QString("%1").arg(QString::fromStdString("JOINTS"))));
+    jointHeaderItem->setFont(0, subheaderFont);
+    jointHeaderItem->setFlags(Qt::NoItemFlags);
+  }
+
+  for (const auto &jointName : children.joints)
+  {
+    // get unscoped name by stripping parent
+    int index = jointName.find(name) + name.length() + 2;
+    std::string jointNameShort = jointName.substr(
+        index, jointName.size() - index);
+
+    QTreeWidgetItem *jointItem = new QTreeWidgetItem(_item,
+        QStringList(QString("%1").arg(
+            QString::fromStdString(jointNameShort))));
+
+    jointItem->setData(0, Qt::UserRole, QVariant(jointName.c_str()));
+    jointItem->setData(3, Qt::UserRole, QVariant("Joint"));
+  }
+
+  if (!children.plugins.empty())
+  {
+    // Create subheader for plugins
+    QTreeWidgetItem *pluginHeaderItem = new QTreeWidgetItem(_item,
+    QStringList(QString("%1").arg("PLUGINS")));
+    pluginHeaderItem->setFont(0, subheaderFont);
+    pluginHeaderItem->setFlags(Qt::NoItemFlags);
+  }
+
+  for (const auto &pluginName : children.plugins)
+  {
+    QTreeWidgetItem *pluginItem = new QTreeWidgetItem(_item,
+        QStringList(QString("%1").arg(
+            QString::fromStdString(pluginName))));
+
+    pluginItem->setData(0, Qt::UserRole,
+        QVariant(PluginUri(name, pluginName).c_str()));
+    pluginItem->setData(3, Qt::UserRole, QVariant("Plugin"));
+  }
+
+  _item->setChildIndicatorPolicy(
+      QTreeWidgetItem::DontShowIndicatorWhenChildless);
+}
+
+/////////////////////////////////////////////////
+void ModelListWidget::RemoveModelItem(QTreeWidgetItem *_item)
+{
+  std::string name = _item->data(0, Qt::UserRole).toString().toStdString();
+
+  auto iter = this->dataPtr->modelChildren.find(name);
+  if (iter != this->dataPtr->modelChildren.end())
+  {
+    for (const auto &link : iter->second.links)
+      this->dataPtr->childOwners.erase(link);
+    for (const auto &joint : iter->second.joints)
+      this->dataPtr->childOwners.erase(joint);
+    for (const auto &plugin : iter->second.plugins)
+      this->dataPtr->childOwners.erase(PluginUri(name, plugin));
+    this->dataPtr->modelChildren.erase(iter);
+  }
+  this->dataPtr->modelItems.erase(name);
+
+  delete this->dataPtr->modelsItem->takeChild(
+      this->dataPtr->modelsItem->indexOfChild(_item));
+}
+
+/////////////////////////////////////////////////
+void ModelListWidget::OnItemExpanded(QTreeWidgetItem *_item)
+{
+  if (_item && _item->parent() == this->dataPtr->modelsItem)
+    this->PopulateModelItem(_item);
 }
 
 /////////////////////////////////////////////////
@@ -613,7 +732,10 @@ void ModelListWidget::RemoveEntity(const std::string &_name)
     QTreeWidgetItem *listItem = this->ListItem(_name, items[i]);
     if (listItem)
     {
-      items[i]->takeChild(items[i]->indexOfChild(listItem));
+      if (listItem->parent() == this->dataPtr->modelsItem)
+        this->RemoveModelItem(listItem);
+      else
+        delete items[i]->takeChild(items[i]->indexOfChild(listItem));
       this->dataPtr->propTreeBrowser->clear();
       this->dataPtr->selectedEntityName.clear();
       this->dataPtr->sdfElement.reset();
@@ -627,6 +749,32 @@ void ModelListWidget::RemoveEntity(const std::string &_name)
 QTreeWidgetItem *ModelListWidget::ListItem(const std::string &_name,
                                               QTreeWidgetItem *_parent)
 {
+  // Models and their children are looked up by name
+  if (_parent == this->dataPtr->modelsItem)
+  {
+    auto model = this->dataPtr->modelItems.find(_name);
+    if (model != this->dataPtr->modelItems.end())
+      return model->second;
+
+    auto owner = this->dataPtr->childOwners.find(_name);
+    if (owner == this->dataPtr->childOwners.end())
+      return nullptr;
+
+    model = this->dataPtr->modelItems.find(owner->second);
+    if (model == this->dataPtr->modelItems.end())
+      return nullptr;
+
+    this->PopulateModelItem(model->second);
+    _parent = model->second;
+    for (int i = 0; i < _parent->childCount(); ++i)
+    {
+      QTreeWidgetItem *item = _parent->child(i);
+      if (item->data(0, Qt::UserRole).toString().toStdString() == _name)
+        return item;
+    }
+    return nullptr;
+  }
+
   QTreeWidgetItem *listItem = nullptr;
 
   // Find an existing element with the name from the message
@@ -2904,6 +3052,9 @@ void ModelListWidget::InitTransport(const std::string &_name)
 void ModelListWidget::ResetTree()
 {
   this->dataPtr->modelTreeWidget->clear();
+  this->dataPtr->modelItems.clear();
+  this->dataPtr->modelChildren.clear();
+  this->dataPtr->childOwners.clear();
 
   // Create the top level of items in the tree widget
   {
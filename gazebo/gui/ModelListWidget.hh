@@ -49,6 +49,10 @@ namespace gazebo
       private slots: void OnPropertyChanged(QtProperty *_item);
       private slots: void OnCustomContextMenu(const QPoint &_pt);
       private slots: void OnCurrentPropertyChanged(QtBrowserItem *_item);
+
+      /// \brief Create the children of a model item when it is expanded.
+      /// \param[in] _item Item that was expanded.
+      private slots: void OnItemExpanded(QTreeWidgetItem *_item);
       private: void OnSetSelectedEntity(const std::string &_name,
                                         const std::string &_mode);
       private: void OnResponse(ConstResponsePtr &_msg);
@@ -115,6 +119,22 @@ namespace gazebo
       private: QTreeWidgetItem *ListItem(const std::string &_name,
                                          QTreeWidgetItem *_parent);
 
+      /// \brief Update the children kept for a model item from a model
+      /// message, recreating the child items if they already exist.
+      /// \param[in] _item Model item.
+      /// \param[in] _msg Model message.
+      private: void SetModelChildren(QTreeWidgetItem *_item,
+                                     const msgs::Model &_msg);
+
+      /// \brief Create the link, joint and plugin items of a model item
+      /// if they have not been created yet.
+      /// \param[in] _item Model item.
+      private: void PopulateModelItem(QTreeWidgetItem *_item);
+
+      /// \brief Remove a model item and its children from the tree.
+      /// \param[in] _item Model item.
+      private: void RemoveModelItem(QTreeWidgetItem *_item);
+
       private: void FillPropertyTree(const msgs::Model &_msg,
                                      QtProperty *_parent);
 
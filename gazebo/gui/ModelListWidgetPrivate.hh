@@ -19,6 +19,7 @@
 
 #include <string>
 #include <list>
+#include <map>
 #include <vector>
 #include <deque>
 #include <sdf/sdf.hh>
@@ -37,6 +38,27 @@ namespace gazebo
 {
   namespace gui
   {
+    /// \internal
+    /// \brief Children of a model item, kept so that their tree items are
+    /// only created once the model item is expanded.
+    class ModelListChildren
+    {
+      /// \brief Id of the model.
+      public: unsigned int id = 0;
+
+      /// \brief Scoped names of the links.
+      public: std::vector<std::string> links;
+
+      /// \brief Scoped names of the joints.
+      public: std::vector<std::string> joints;
+
+      /// \brief Names of the plugins.
+      public: std::vector<std::string> plugins;
+
+      /// \brief True once the tree items have been created.
+      public: bool populated = false;
+    };
+
     class ModelListWidgetPrivate
     {
       public: QTreeWidget *modelTreeWidget;
@@ -81,6 +103,16 @@ namespace gazebo
       /// \brief Spherical coordinates tree item.
       public: QTreeWidgetItem *sphericalCoordItem;
 
+      /// \brief Model tree items indexed by model name.
+      public: std::map<std::string, QTreeWidgetItem *> modelItems;
+
+      /// \brief Children of each model, indexed by model name.
+      public: std::map<std::string, ModelListChildren> modelChildren;
+
+      /// \brief Name of the model owning each link, joint and plugin item,
+      /// indexed by the name stored in the item.
+      public: std::map<std::string, std::string> childOwners;
+
       public: QtVariantPropertyManager *variantManager;
       public: QtVariantEditorFactory *variantFactory;
       public: std::mutex *propMutex, *receiveMutex;
@@ -371,6 +371,15 @@ void ModelListWidget_TEST::ModelsTree()
   QVERIFY(sphereItem != nullptr);
   QVERIFY(cylinderItem != nullptr);
 
+  // link items are only created once the model is expanded
+  QCOMPARE(boxItem->childCount(), 0);
+  QCOMPARE(boxItem->childIndicatorPolicy(), QTreeWidgetItem::ShowIndicator);
+  boxItem->setExpanded(true);
+  QCoreApplication::processEvents();
+  QVERIFY(boxItem->childCount() > 0);
+  QCOMPARE(boxItem->child(1)->data(3, Qt::UserRole).toString(),
+      QString("Link"));
+
   node.reset();
   delete requestMsg;
   delete modelListWidget;
@@ -14,6 +14,9 @@
  * limitations under the License.
  *
  */
+#include <algorithm>
+#include <set>
+
 #include <boost/thread/recursive_mutex.hpp>
 #include <ignition/math/AxisAlignedBox.hh>
 #include <ignition/math/Helpers.hh>
@@ -428,6 +431,10 @@ void LinkData::SetScales(
   this->UpdateInspectorScale();
 
   this->scales = _scales;
+
+  // The visuals were resized directly, the msgs no longer describe them
+  this->appliedVisuals.clear();
+  this->appliedCollisions.clear();
 }
 
 /////////////////////////////////////////////////
@@ -1083,6 +1090,8 @@ bool LinkData::Apply()
 
   std::vector<msgs::Visual *> visualUpdateMsgsTemp;
   std::vector<msgs::Collision *> collisionUpdateMsgsTemp;
+  std::map<std::string, std::string> appliedVisualsTemp;
+  std::map<std::string, std::string> appliedCollisionsTemp;
 
   // update visuals
   if (!this->visuals.empty())
@@ -1216,7 +1225,16 @@ bool LinkData::Apply()
         visualMsg.CopyFrom(*updateMsg);
         it.second = visualMsg;
 
-        visualUpdateMsgsTemp.push_back(updateMsg);
+        // Rebuilding a visual can be expensive, e.g. extruding a
+        // polyline, only do it for the ones that were edited
+        std::string serialized = updateMsg->SerializeAsString();
+        auto applied = this->appliedVisuals.find(updateMsg->name());
+        if (applied == this->appliedVisuals.end() ||
+            applied->second != serialized)
+        {
+          appliedVisualsTemp[updateMsg->name()] = serialized;
+          visualUpdateMsgsTemp.push_back(updateMsg);
+        }
       }
     }
   }
@@ -1312,7 +1330,14 @@ bool LinkData::Apply()
         collisionMsg.CopyFrom(*updateMsg);
         it.second = collisionMsg;
 
-        collisionUpdateMsgsTemp.push_back(updateMsg);
+        std::string serialized = updateMsg->SerializeAsString();
+        auto applied = this->appliedCollisions.find(updateMsg->name());
+        if (applied == this->appliedCollisions.end() ||
+            applied->second != serialized)
+        {
+          appliedCollisionsTemp[updateMsg->name()] = serialized;
+          collisionUpdateMsgsTemp.push_back(updateMsg);
+        }
       }
     }
   }
@@ -1322,6 +1347,10 @@ bool LinkData::Apply()
       visualUpdateMsgsTemp.begin(), visualUpdateMsgsTemp.end());
   this->collisionUpdateMsgs.insert(this->collisionUpdateMsgs.end(),
       collisionUpdateMsgsTemp.begin(), collisionUpdateMsgsTemp.end());
+  for (auto &applied : appliedVisualsTemp)
+    this->appliedVisuals[applied.first] = applied.second;
+  for (auto &applied : appliedCollisionsTemp)
+    this->appliedCollisions[applied.first] = applied.second;
   return true;
 }
 
@@ -1702,6 +1731,7 @@ void LinkData::OnRemoveVisual(const std::string &_name)
 
       this->deletedVisuals[it->first] = it->second;
       this->scales.erase(visualName);
+      this->appliedVisuals.erase(it->second.name());
 
       this->visuals.erase(it);
       break;
@@ -1728,6 +1758,7 @@ void LinkData::OnRemoveCollision(const std::string &_name)
 
       this->deletedCollisions[it->first] = it->second;
       this->scales.erase(collisionName);
+      this->appliedCollisions.erase(it->second.name());
 
       this->collisions.erase(it);
       break;
@@ -1740,6 +1771,29 @@ void LinkData::Update()
 {
   boost::recursive_mutex::scoped_lock lock(*this->updateMutex);
 
+  // Several applies within a frame only need the latest msg of each visual
+  // and collision
+  std::set<std::string> queued;
+  for (auto it = this->visualUpdateMsgs.rbegin();
+      it != this->visualUpdateMsgs.rend(); ++it)
+  {
+    if (!queued.insert((*it)->name()).second)
+      *it = nullptr;
+  }
+  this->visualUpdateMsgs.erase(std::remove(this->visualUpdateMsgs.begin(),
+      this->visualUpdateMsgs.end(), nullptr), this->visualUpdateMsgs.end());
+
+  queued.clear();
+  for (auto it = this->collisionUpdateMsgs.rbegin();
+      it != this->collisionUpdateMsgs.rend(); ++it)
+  {
+    if (!queued.insert((*it)->name()).second)
+      *it = nullptr;
+  }
+  this->collisionUpdateMsgs.erase(std::remove(
+      this->collisionUpdateMsgs.begin(), this->collisionUpdateMsgs.end(),
+      nullptr), this->collisionUpdateMsgs.end());
+
   while (!this->visualUpdateMsgs.empty())
   {
     boost::shared_ptr<gazebo::msgs::Visual> updateMsgPtr;
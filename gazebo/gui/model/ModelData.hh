@@ -283,6 +283,15 @@ namespace gazebo
       /// \brief Msgs for updating collision visuals.
       public: std::vector<msgs::Collision *> collisionUpdateMsgs;
 
+      /// \brief Serialized msg last queued for each visual, indexed by msg
+      /// name. Applying the inspector only updates the visuals that changed
+      /// since.
+      private: std::map<std::string, std::string> appliedVisuals;
+
+      /// \brief Serialized msg last queued for each collision, indexed by
+      /// msg name.
+      private: std::map<std::string, std::string> appliedCollisions;
+
       /// \brief Collisions of the link.
       public: std::map<rendering::VisualPtr, msgs::Collision> collisions;
 
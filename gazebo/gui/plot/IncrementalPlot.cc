@@ -363,8 +363,10 @@ void IncrementalPlot::Update()
     ignition::math::Vector2d minPt = curve.second->Min();
     ignition::math::Vector2d maxPt = curve.second->Max();
 
+    // Qwt may be handed fewer points than the curve holds
+    int lastIndex = static_cast<int>(curve.second->Curve()->dataSize()) - 1;
     this->dataPtr->directPainter->drawSeries(curve.second->Curve(),
-      pointCount - 1, pointCount - 1);
+      lastIndex, lastIndex);
   }
 
   // get x axis lower and upper bounds
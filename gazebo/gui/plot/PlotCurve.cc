@@ -14,7 +14,9 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
 #include <map>
+#include <vector>
 #include <ignition/math/Color.hh>
 
 #include "gazebo/common/Assert.hh"
@@ -24,11 +26,6 @@
 #include "gazebo/gui/plot/IncrementalPlot.hh"
 #include "gazebo/gui/plot/PlotCurve.hh"
 
-// member variables in qwt_series_data were renamed in 6.2.0
-#if QWT_VERSION < 0x060200
-#define QWT_VERSION_LT_620
-#endif
-
 using namespace gazebo;
 using namespace gui;
 
@@ -50,138 +47,320 @@ namespace gazebo
           Colors[ColorGroupCount][ColorCount];
     };
 
-    /// \brief A class that manages curve data
-    class CurveData: public QwtArraySeriesData<QPointF>
+    /// \brief Curve data kept in a ring of fixed capacity. Qwt is handed
+    /// at most four points per pixel column of the canvas: the first, last,
+    /// lowest and highest sample of each column, so redrawing does not
+    /// depend on how many samples are in view. Samples are summarized in
+    /// blocks as they arrive, so decimating long histories mostly reads
+    /// block summaries instead of samples.
+    class CurveData: public QwtSeriesData<QPointF>
     {
-      public: CurveData()
-              {}
+      /// \brief Maximum number of samples kept, older ones are dropped.
+      public: static const int kCapacity = 1 << 17;
 
-      private: inline const QRectF& BoundingRect() const
-               {
-#ifdef QWT_VERSION_LT_620
-                 return this->d_boundingRect;
-#else
-                 return this->cachedBoundingRect;
-#endif
-               }
+      /// \brief Number of consecutive ring slots summarized together.
+      public: static const int kBlockSize = 64;
 
-      private: inline QRectF& BoundingRect()
-               {
-#ifdef QWT_VERSION_LT_620
-                 return this->d_boundingRect;
-#else
-                 return this->cachedBoundingRect;
-#endif
-               }
+      /// \brief Constructor.
+      /// \param[in] _item Curve drawing the data, used to get the width of
+      /// the canvas.
+      public: explicit CurveData(const QwtPlotItem *_item)
+              : item(_item), blocks(kCapacity / kBlockSize)
+              {}
 
-      private: inline const QVector<QPointF>& SamplesRef() const
-               {
-#ifdef QWT_VERSION_LT_620
-                 return this->d_samples;
-#else
-                 return this->m_samples;
-#endif
-               }
+      /// \brief Number of points handed to Qwt.
+      /// \return Number of decimated points, or of samples if the data
+      /// is not decimated.
+      public: virtual size_t size() const
+              {
+                this->Refresh();
+                return this->decimated ? this->view.size() :
+                    this->RawSize();
+              }
 
-      private: inline QVector<QPointF>& SamplesRef()
-               {
-#ifdef QWT_VERSION_LT_620
-                 return this->d_samples;
-#else
-                 return this->m_samples;
-#endif
-               }
+      /// \brief Point handed to Qwt.
+      /// \param[in] _i Index of the point.
+      /// \return The point.
+      public: virtual QPointF sample(size_t _i) const
+              {
+                this->Refresh();
+                return this->decimated ? this->view[_i] :
+                    this->RawSample(_i);
+              }
 
-      /// \brief Bounding rectangle accessor. This create the object
-      /// if it does not already exist or is too small.
-      /// \return Bounding box of the sample.
+      /// \brief Bounding rectangle of all the samples added since the
+      /// last Clear.
+      /// \return Bounding box of the samples.
       public: virtual QRectF boundingRect() const
               {
-                if (this->BoundingRect().width() < 0.0)
-                {
-#ifdef QWT_VERSION_LT_620
-                  this->d_boundingRect = qwtBoundingRect(*this);
-#else
-                  this->cachedBoundingRect = qwtBoundingRect(*this);
-#endif
-                }
+                QRectF rect = this->bounds;
 
                 // set a minimum bounding box height
                 // this prevents plot's auto scale to zoom in on near-zero
                 // floating point noise.
                 double minHeight = 1e-3;
-                double absHeight = std::fabs(this->BoundingRect().height());
-                if (absHeight < minHeight)
+                double absHeight = std::fabs(rect.height());
+                if (rect.width() >= 0.0 && absHeight < minHeight)
                 {
                   double halfMinHeight = minHeight * 0.5;
-                  double mid = this->BoundingRect().top() +
-                      (absHeight * 0.5);
-#ifdef QWT_VERSION_LT_620
-                  this->d_boundingRect.setTop(mid - halfMinHeight);
-                  this->d_boundingRect.setBottom(mid + halfMinHeight);
-#else
-                  this->cachedBoundingRect.setTop(mid - halfMinHeight);
-                  this->cachedBoundingRect.setBottom(mid + halfMinHeight);
-#endif
+                  double mid = rect.top() + (absHeight * 0.5);
+                  rect.setTop(mid - halfMinHeight);
+                  rect.setBottom(mid + halfMinHeight);
                 }
 
-                return this->BoundingRect();
+                return rect;
+              }
+
+      /// \brief Called by Qwt with the area of the plot in view.
+      /// \param[in] _rect Area in plot coordinates.
+      public: virtual void setRectOfInterest(const QRectF &_rect)
+              {
+                this->interest = _rect;
+                this->dirty = true;
               }
 
       /// \brief Add a point to the sample.
       /// \param[in] _point Point to add.
-      public: inline void Add(const QPointF &_point)
+      public: void Add(const QPointF &_point)
               {
-                this->SamplesRef() += _point;
+                const int count = this->RawSize();
+                if (count > 0 && _point.x() < this->RawSample(count - 1).x())
+                  this->monotonic = false;
 
-                if (this->SamplesRef().size() > maxSampleSize)
+                int slot;
+                if (count < kCapacity)
+                {
+                  slot = count;
+                  this->ring.push_back(_point);
+                }
+                else
                 {
-                  // remove sample window
-                  // update bounding rect?
-                  this->SamplesRef().remove(0, windowSize);
+                  slot = this->start;
+                  this->ring[slot] = _point;
+                  this->start = (this->start + 1) % kCapacity;
                 }
 
-                if (this->SamplesRef().size() == 1)
+                Block &block = this->blocks[slot / kBlockSize];
+                if (slot % kBlockSize == 0)
+                  block.count = 0;
+                if (block.count == 0 || _point.y() < block.min.y())
+                  block.min = _point;
+                if (block.count == 0 || _point.y() > block.max.y())
+                  block.max = _point;
+                ++block.count;
+
+                if (this->bounds.width() < 0.0)
                 {
                   // init bounding rect
-                  this->BoundingRect().setTopLeft(_point);
-                  this->BoundingRect().setBottomRight(_point);
-                  return;
+                  this->bounds.setTopLeft(_point);
+                  this->bounds.setBottomRight(_point);
+                }
+                else
+                {
+                  // expand bounding rect
+                  if (_point.x() < this->bounds.left())
+                    this->bounds.setLeft(_point.x());
+                  else if (_point.x() > this->bounds.right())
+                    this->bounds.setRight(_point.x());
+                  if (_point.y() < this->bounds.top())
+                    this->bounds.setTop(_point.y());
+                  else if (_point.y() > this->bounds.bottom())
+                    this->bounds.setBottom(_point.y());
                 }
 
-                // expand bounding rect
-                if (_point.x() < this->BoundingRect().left())
-                  this->BoundingRect().setLeft(_point.x());
-                else if (_point.x() > this->BoundingRect().right())
-                  this->BoundingRect().setRight(_point.x());
-                if (_point.y() < this->BoundingRect().top())
-                  this->BoundingRect().setTop(_point.y());
-                else if (_point.y() > this->BoundingRect().bottom())
-                  this->BoundingRect().setBottom(_point.y());
+                this->dirty = true;
               }
 
       /// \brief Clear the sample data.
       public: void Clear()
               {
-                this->SamplesRef().clear();
-                this->SamplesRef().squeeze();
-                this->BoundingRect() = QRectF(0.0, 0.0, -1.0, -1.0);
+                std::vector<QPointF>().swap(this->ring);
+                std::vector<QPointF>().swap(this->view);
+                this->start = 0;
+                this->monotonic = true;
+                this->decimated = false;
+                this->dirty = true;
+                this->bounds = QRectF(0.0, 0.0, -1.0, -1.0);
               }
 
-      /// \brief Get the sample data.
-      /// \return A vector of same points.
-      public: QVector<QPointF> Samples() const
+      /// \brief Number of samples kept.
+      /// \return Number of samples.
+      public: int RawSize() const
               {
-                return this->SamplesRef();
+                return static_cast<int>(this->ring.size());
               }
 
-      /// \brief maxium sample size of this curve.
-      private: int maxSampleSize = 11000;
+      /// \brief Get a sample, oldest first.
+      /// \param[in] _i Index of the sample, below RawSize().
+      /// \return The sample.
+      public: const QPointF &RawSample(const size_t _i) const
+              {
+                return this->ring[(this->start + _i) % kCapacity];
+              }
 
-      /// \brief Size of samples to remove when maxSampleSize is reached.
-      private: int windowSize = 1000;
-    };
+      /// \brief Summary of the samples in a block of ring slots.
+      private: class Block
+      {
+        /// \brief Sample with the lowest value.
+        public: QPointF min;
+
+        /// \brief Sample with the highest value.
+        public: QPointF max;
+
+        /// \brief Number of samples written to the block since its first
+        /// slot was last written. The summary covers the whole block once
+        /// this reaches kBlockSize.
+        public: int count = 0;
+      };
+
+      /// \brief Index of the first sample at or after an x value.
+      /// \param[in] _x Value to look for.
+      /// \param[in] _lo First index to consider.
+      /// \param[in] _hi One past the last index to consider.
+      /// \return Index of the sample, _hi if there is none.
+      private: int LowerBound(const double _x, int _lo, int _hi) const
+               {
+                 while (_lo < _hi)
+                 {
+                   const int mid = _lo + (_hi - _lo) / 2;
+                   if (this->RawSample(mid).x() < _x)
+                     _lo = mid + 1;
+                   else
+                     _hi = mid;
+                 }
+                 return _lo;
+               }
+
+      /// \brief Rebuild the decimated points if samples were added or the
+      /// view changed.
+      private: void Refresh() const
+               {
+                 const int columns = this->item && this->item->plot() ?
+                     this->item->plot()->canvas()->width() : 0;
+                 if (!this->dirty && columns == this->columns)
+                   return;
+
+                 this->dirty = false;
+                 this->columns = columns;
+                 this->decimated = false;
+
+                 // Decimating needs samples sorted along x
+                 const int count = this->RawSize();
+                 if (!this->monotonic || columns <= 0 ||
+                     !(this->interest.width() > 0.0))
+                 {
+                   return;
+                 }
+
+                 // Keep one sample on each side so lines reach the edges
+                 const int lo = std::max(0,
+                     this->LowerBound(this->interest.left(), 0, count) - 1);
+                 const int hi = std::min(count, this->LowerBound(
+                     this->interest.right(), lo, count) + 1);
+                 if (hi - lo <= 4 * columns)
+                   return;
+
+                 this->view.clear();
+                 const double dx = this->interest.width() / columns;
+                 int i = lo;
+                 for (int c = 1; c <= columns + 1 && i < hi; ++c)
+                 {
+                   const int j = c > columns ? hi : this->LowerBound(
+                       this->interest.left() + c * dx, i, hi);
+                   this->AddColumn(i, j);
+                   i = j;
+                 }
+                 this->decimated = true;
+               }
+
+      /// \brief Append the first, lowest, highest and last samples of a
+      /// range to the decimated points, in x order.
+      /// \param[in] _lo Index of the first sample.
+      /// \param[in] _hi One past the index of the last sample.
+      private: void AddColumn(int _lo, const int _hi) const
+               {
+                 if (_hi - _lo <= 4)
+                 {
+                   for (; _lo < _hi; ++_lo)
+                     this->view.push_back(this->RawSample(_lo));
+                   return;
+                 }
+
+                 const QPointF first = this->RawSample(_lo);
+                 const QPointF last = this->RawSample(_hi - 1);
+                 QPointF min = first;
+                 QPointF max = first;
+                 for (int i = _lo; i < _hi;)
+                 {
+                   const int slot = (this->start + i) % kCapacity;
+                   const Block &block = this->blocks[slot / kBlockSize];
+                   if (slot % kBlockSize == 0 && i + kBlockSize <= _hi &&
+                       block.count == kBlockSize)
+                   {
+                     if (block.min.y() < min.y())
+                       min = block.min;
+                     if (block.max.y() > max.y())
+                       max = block.max;
+                     i += kBlockSize;
+                   }
+                   else
+                   {
+                     const QPointF &pt = this->ring[slot];
+                     if (pt.y() < min.y())
+                       min = pt;
+                     if (pt.y() > max.y())
+                       max = pt;
+                     ++i;
+                   }
+                 }
+
+                 QPointF extremes[2] = {min, max};
+                 if (max.x() < min.x())
+                   std::swap(extremes[0], extremes[1]);
+
+                 this->view.push_back(first);
+                 for (const auto &pt : extremes)
+                 {
+                   if (pt != this->view.back() && pt != last)
+                     this->view.push_back(pt);
+                 }
+                 this->view.push_back(last);
+               }
+
+      /// \brief Curve drawing the data.
+      private: const QwtPlotItem *item;
+
+      /// \brief Samples, oldest at start once the ring is full.
+      private: std::vector<QPointF> ring;
+
+      /// \brief Summaries of kBlockSize ring slots each.
+      private: std::vector<Block> blocks;
+
+      /// \brief Index of the oldest sample in the ring.
+      private: int start = 0;
+
+      /// \brief False once a sample was added with a lower x than the one
+      /// before it. Such data is never decimated.
+      private: bool monotonic = true;
 
+      /// \brief Bounding rectangle of the samples.
+      private: QRectF bounds = QRectF(0.0, 0.0, -1.0, -1.0);
+
+      /// \brief Area of the plot in view.
+      private: QRectF interest;
+
+      /// \brief Decimated points.
+      private: mutable std::vector<QPointF> view;
+
+      /// \brief Width of the canvas the points were decimated for.
+      private: mutable int columns = 0;
+
+      /// \brief True if the view holds the points handed to Qwt.
+      private: mutable bool decimated = false;
+
+      /// \brief True if the decimated points need rebuilding.
+      private: mutable bool dirty = true;
+    };
 
     /// \internal
     /// \brief PlotCurve private data
@@ -270,7 +449,7 @@ PlotCurve::PlotCurve(const std::string &_label)
 
   curve->setYAxis(QwtPlot::yLeft);
   curve->setStyle(QwtPlotCurve::Lines);
-  curve->setData(new CurveData());
+  curve->setData(new CurveData(curve));
 
   int colorGroup = this->dataPtr->colorCounter % ColorPalette::ColorGroupCount;
   int color = static_cast<int>(
@@ -395,7 +574,7 @@ void PlotCurve::SetAge(const unsigned int _age)
 /////////////////////////////////////////////////
 unsigned int PlotCurve::Size() const
 {
-  return static_cast<unsigned int>(this->dataPtr->curveData->samples().size());
+  return static_cast<unsigned int>(this->dataPtr->curveData->RawSize());
 }
 
 /////////////////////////////////////////////////
@@ -416,13 +595,13 @@ ignition::math::Vector2d PlotCurve::Max()
 ignition::math::Vector2d PlotCurve::Point(const unsigned int _index) const
 {
   if (_index >= static_cast<unsigned int>(
-      this->dataPtr->curveData->samples().size()))
+      this->dataPtr->curveData->RawSize()))
   {
     return ignition::math::Vector2d(ignition::math::NAN_D,
         ignition::math::NAN_D);
   }
 
-  const QPointF &pt = this->dataPtr->curveData->samples()[_index];
+  const QPointF &pt = this->dataPtr->curveData->RawSample(_index);
   return ignition::math::Vector2d(pt.x(), pt.y());
 }
 
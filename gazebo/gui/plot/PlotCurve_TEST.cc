@@ -15,7 +15,9 @@
  *
 */
 
+#include "gazebo/gui/plot/qwt_gazebo.h"
 #include "gazebo/gui/plot/PlottingTypes.hh"
+#include "gazebo/gui/plot/IncrementalPlot.hh"
 #include "gazebo/gui/plot/PlotCurve.hh"
 #include "gazebo/gui/plot/PlotCurve_TEST.hh"
 
@@ -133,5 +135,62 @@ void PlotCurve_TEST::AddPoint()
   delete plotCurve;
 }
 
+/////////////////////////////////////////////////
+void PlotCurve_TEST::Decimate()
+{
+  this->resMaxPercentChange = 5.0;
+  this->shareMaxPercentChange = 2.0;
+
+  this->Load("worlds/empty.world");
+
+  gazebo::gui::IncrementalPlot *plot =
+      new gazebo::gui::IncrementalPlot(nullptr);
+  plot->resize(400, 300);
+  plot->show();
+  QCoreApplication::processEvents();
+
+  auto plotCurve = plot->AddCurve("curve01").lock();
+  QVERIFY(plotCurve != nullptr);
+
+  // More samples than the curve keeps, 1 kHz over a few minutes
+  const unsigned int count = 200000;
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    plotCurve->AddPoint(ignition::math::Vector2d(i * 0.001,
+        (i % 2) ? 1.0 : -1.0));
+  }
+
+  // The oldest samples are dropped
+  const unsigned int kept = plotCurve->Size();
+  QVERIFY(kept < count);
+  QCOMPARE(plotCurve->Point(kept - 1),
+      ignition::math::Vector2d((count - 1) * 0.001, 1.0));
+
+  // Qwt is handed a few points per pixel column, which still reach the
+  // extremes of the signal
+  plot->setAxisScale(QwtPlot::xBottom, 0.0, count * 0.001);
+  plot->replot();
+  QCoreApplication::processEvents();
+
+  const int columns = plot->canvas()->width();
+  QwtPlotCurve *curve = plotCurve->Curve();
+  QVERIFY(curve->dataSize() > 0u);
+  QVERIFY(curve->dataSize() <= static_cast<size_t>(4 * columns + 4));
+  QCOMPARE(curve->minYValue(), -1.0);
+  QCOMPARE(curve->maxYValue(), 1.0);
+
+  bool low = false;
+  bool high = false;
+  for (size_t i = 0; i < curve->dataSize(); ++i)
+  {
+    low = low || curve->sample(i).y() < 0;
+    high = high || curve->sample(i).y() > 0;
+  }
+  QVERIFY(low);
+  QVERIFY(high);
+
+  delete plot;
+}
+
 // Generate a main function for the test
 QTEST_MAIN(PlotCurve_TEST)
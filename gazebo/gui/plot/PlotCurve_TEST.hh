@@ -32,5 +32,8 @@ class PlotCurve_TEST : public QTestFixture
 
   /// \brief Test adding points to the curve
   private slots: void AddPoint();
+
+  /// \brief Test the ring capacity and the points drawn for long curves
+  private slots: void Decimate();
 };
 #endif
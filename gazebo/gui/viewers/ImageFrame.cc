@@ -143,26 +143,20 @@ void ImageFrame::OnImage(const msgs::Image &_msg)
       }
     }
 
-    float maxDepth = 0;
-    for (unsigned int i = 0; i < _msg.height() * _msg.width(); ++i)
-    {
-      if (this->dataPtr->depthBuffer[i] > maxDepth &&
-          !std::isinf(this->dataPtr->depthBuffer[i]))
-      {
-        maxDepth = this->dataPtr->depthBuffer[i];
-      }
-    }
-    unsigned int idx = 0;
-    double factor = 255 / maxDepth;
+    if (!this->dataPtr->imageBuffer)
+      this->dataPtr->imageBuffer = new unsigned char[depthSamples * 3];
+
+    common::Image::ConvertData(
+        reinterpret_cast<unsigned char *>(this->dataPtr->depthBuffer),
+        common::Image::R_FLOAT32, this->dataPtr->imageBuffer,
+        common::Image::RGB_INT8, _msg.width(), _msg.height());
+
+    // Scan lines of the image are padded to 4 bytes
     for (unsigned int j = 0; j < _msg.height(); ++j)
     {
-      for (unsigned int i = 0; i < _msg.width(); ++i)
-      {
-        float d = this->dataPtr->depthBuffer[idx++];
-        d = 255 - (d * factor);
-        QRgb value = qRgb(d, d, d);
-        this->dataPtr->image.setPixel(i, j, value);
-      }
+      memcpy(this->dataPtr->image.scanLine(j),
+          this->dataPtr->imageBuffer + j * _msg.width() * 3,
+          _msg.width() * 3);
     }
   }
   // convert 16 bit camera images to rgb image format for display
@@ -202,6 +196,17 @@ void ImageFrame::OnImage(const msgs::Image &_msg)
       }
     }
   }
+  else if (_msg.pixel_format() == common::Image::PixelFormat::BGR_INT8)
+  {
+    const unsigned char *buffer =
+        reinterpret_cast<const unsigned char *>(_msg.data().c_str());
+    for (int i = 0; i < this->dataPtr->image.height(); ++i)
+    {
+      common::Image::ConvertData(buffer + i * _msg.step(),
+          common::Image::BGR_INT8, this->dataPtr->image.scanLine(i),
+          common::Image::RGB_INT8, _msg.width(), 1);
+    }
+  }
   else
   {
     const char *buffer = _msg.data().c_str();
@@ -29,9 +29,30 @@ using namespace gui;
 
 GZ_REGISTER_STATIC_VIEWER("gazebo.msgs.ImageStamped", ImageView)
 
+/// \brief Type of the compressed image messages.
+static const char kCompressedImageType[] = "gazebo.msgs.CompressedImageStamped";
+
+/////////////////////////////////////////////////
+GZ_GUI_VISIBLE TopicView *NewCompressedImageView(QWidget *_parent)
+{
+  return new ImageView(_parent, kCompressedImageType);
+}
+
+/////////////////////////////////////////////////
+GZ_GUI_VISIBLE void RegisterCompressedImageView()
+{
+  ViewFactory::RegisterView(kCompressedImageType, NewCompressedImageView);
+}
+
 /////////////////////////////////////////////////
 ImageView::ImageView(QWidget *_parent)
-: TopicView(_parent, "gazebo.msgs.ImageStamped", "image", 60),
+: ImageView(_parent, "gazebo.msgs.ImageStamped")
+{
+}
+
+/////////////////////////////////////////////////
+ImageView::ImageView(QWidget *_parent, const std::string &_msgType)
+: TopicView(_parent, _msgType, "image", 60),
   dataPtr(new ImageViewPrivate())
 {
   this->setWindowTitle(tr("Gazebo: Image View"));
@@ -62,7 +83,15 @@ void ImageView::SetTopic(const std::string &_topicName)
   TopicView::SetTopic(_topicName);
 
   // Subscribe to the new topic.
-  this->sub = this->node->Subscribe(_topicName, &ImageView::OnImage, this);
+  if (this->msgTypeName == kCompressedImageType)
+  {
+    this->sub = this->node->Subscribe(_topicName,
+        &ImageView::OnCompressedImage, this);
+  }
+  else
+  {
+    this->sub = this->node->Subscribe(_topicName, &ImageView::OnImage, this);
+  }
 }
 
 /////////////////////////////////////////////////
@@ -73,3 +102,31 @@ void ImageView::OnImage(ConstImageStampedPtr &_msg)
 
   this->dataPtr->imageFrame->OnImage(_msg->image());
 }
+
+/////////////////////////////////////////////////
+void ImageView::OnCompressedImage(ConstCompressedImageStampedPtr &_msg)
+{
+  // Update the Hz and Bandwidth info
+  this->OnMsg(msgs::Convert(_msg->time()), _msg->data().size());
+
+  QImage decoded = QImage::fromData(
+      reinterpret_cast<const uchar *>(_msg->data().data()),
+      _msg->data().size()).convertToFormat(QImage::Format_RGB888);
+  if (decoded.isNull())
+    return;
+
+  msgs::Image image;
+  image.set_width(decoded.width());
+  image.set_height(decoded.height());
+  image.set_pixel_format(common::Image::RGB_INT8);
+  image.set_step(decoded.width() * 3);
+  std::string *data = image.mutable_data();
+  data->reserve(image.step() * image.height());
+  for (int y = 0; y < decoded.height(); ++y)
+  {
+    data->append(reinterpret_cast<const char *>(decoded.constScanLine(y)),
+        image.step());
+  }
+
+  this->dataPtr->imageFrame->OnImage(image);
+}
@@ -43,6 +43,12 @@ namespace gazebo
       /// \param[in] _parent Pointer to the parent widget.
       public: explicit ImageView(QWidget *_parent = NULL);
 
+      /// \brief Constructor
+      /// \param[in] _parent Pointer to the parent widget.
+      /// \param[in] _msgType "gazebo.msgs.ImageStamped" or
+      /// "gazebo.msgs.CompressedImageStamped".
+      public: ImageView(QWidget *_parent, const std::string &_msgType);
+
       /// \brief Destructor
       public: virtual ~ImageView();
 
@@ -53,6 +59,10 @@ namespace gazebo
       /// \param[in] _msg New image message.
       public: void OnImage(ConstImageStampedPtr &_msg);
 
+      /// \brief Receives incoming compressed image messages.
+      /// \param[in] _msg New compressed image message.
+      public: void OnCompressedImage(ConstCompressedImageStampedPtr &_msg);
+
       /// \brief Private data.
       private: ImageViewPrivate *dataPtr;
     };
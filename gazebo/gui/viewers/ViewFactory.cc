@@ -24,6 +24,7 @@
 #include "gazebo/gui/viewers/LaserView.hh"
 #include "gazebo/gui/viewers/TextView.hh"
 
+void RegisterCompressedImageView();
 void RegisterImageView();
 void RegisterImagesView();
 void RegisterLaserView();
@@ -38,6 +39,7 @@ void ViewFactory::RegisterAll()
 {
   RegisterLaserView();
   RegisterImageView();
+  RegisterCompressedImageView();
   RegisterImagesView();
 }
 
@@ -0,0 +1,447 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <random>
+#include <utility>
+
+#include "gazebo/msgs/PoseStream.hh"
+
+namespace gazebo
+{
+  namespace msgs
+  {
+    /// \brief Number of frames kept to code or decode deltas against.
+    static const size_t kPoseStreamHistory = 64;
+
+    /// \brief Time after which a client that stopped acknowledging frames
+    /// is ignored.
+    static const std::chrono::seconds kPoseStreamClientTimeout(5);
+
+    /// \brief Largest value of the three smallest quaternion components.
+    static const double kSmallestThreeMax = M_SQRT1_2;
+
+    /// \brief Largest value of a packed quaternion component.
+    static const uint32_t kSmallestThreeSteps = 1023;
+
+    /// \internal
+    /// \brief Quantized pose of an entity.
+    struct QuantizedPose
+    {
+      /// \brief Position in resolution steps.
+      int64_t position[3];
+
+      /// \brief Packed orientation.
+      uint32_t rotation;
+
+      /// \brief Equality operator.
+      /// \param[in] _other Pose to compare to.
+      /// \return True if both are the same.
+      bool operator==(const QuantizedPose &_other) const
+      {
+        return this->rotation == _other.rotation &&
+            std::equal(this->position, this->position + 3, _other.position);
+      }
+    };
+
+    /// \brief Quantized poses by entity id.
+    typedef std::map<uint32_t, QuantizedPose> PoseTable;
+
+    /// \brief Frames kept for deltas, oldest first.
+    typedef std::deque<std::pair<uint32_t, PoseTable>> PoseHistory;
+
+    /// \internal
+    /// \brief Find a frame in a history.
+    /// \param[in] _history The history.
+    /// \param[in] _frame Frame number.
+    /// \return The frame's poses, null if it is not in the history.
+    static const PoseTable *FindFrame(const PoseHistory &_history,
+        const uint32_t _frame)
+    {
+      for (auto const &entry : _history)
+      {
+        if (entry.first == _frame)
+          return &entry.second;
+      }
+      return nullptr;
+    }
+
+    /// \internal
+    /// \brief Acknowledgements of a client.
+    struct PoseStreamClient
+    {
+      /// \brief Last frame acknowledged, 0 if it asked for a key frame.
+      uint32_t frame = 0;
+
+      /// \brief First frame acknowledged since the client last asked for
+      /// a key frame. The client has no frame before it.
+      uint32_t first = 0;
+
+      /// \brief Time of the last acknowledgement.
+      std::chrono::steady_clock::time_point time;
+    };
+
+    /// \internal
+    /// \brief Private data for PoseStreamEncoder.
+    class PoseStreamEncoderPrivate
+    {
+      /// \brief Choose the frame to code the next frame against.
+      /// \return Base frame, 0 for a key frame.
+      public: uint32_t BaseFrame();
+
+      /// \brief Size of a position step.
+      public: double resolution;
+
+      /// \brief Protects the members below.
+      public: mutable std::mutex mutex;
+
+      /// \brief Latest pose of every entity.
+      public: PoseTable current;
+
+      /// \brief True if a pose changed since the last frame.
+      public: bool dirty = false;
+
+      /// \brief Number of the last frame.
+      public: uint32_t frame = 0;
+
+      /// \brief Frames sent recently.
+      public: PoseHistory history;
+
+      /// \brief Clients by id.
+      public: std::map<uint32_t, PoseStreamClient> clients;
+    };
+
+    /// \internal
+    /// \brief Private data for PoseStreamDecoder.
+    class PoseStreamDecoderPrivate
+    {
+      /// \brief Id of this client.
+      public: uint32_t client;
+
+      /// \brief Frames decoded recently.
+      public: PoseHistory history;
+    };
+  }
+}
+
+using namespace gazebo;
+using namespace msgs;
+
+/////////////////////////////////////////////////
+uint32_t msgs::PackQuaternion(const ignition::math::Quaterniond &_q)
+{
+  ignition::math::Quaterniond q = _q;
+  q.Normalize();
+  const double c[4] = {q.W(), q.X(), q.Y(), q.Z()};
+
+  uint32_t largest = 0;
+  for (uint32_t i = 1; i < 4; ++i)
+  {
+    if (std::abs(c[i]) > std::abs(c[largest]))
+      largest = i;
+  }
+
+  // q and -q are the same rotation, make the dropped component positive
+  const double sign = c[largest] < 0 ? -1.0 : 1.0;
+
+  uint32_t packed = largest << 30;
+  int shift = 20;
+  for (uint32_t i = 0; i < 4; ++i)
+  {
+    if (i == largest)
+      continue;
+
+    const double v = std::max(-1.0, std::min(1.0,
+        sign * c[i] / kSmallestThreeMax));
+    packed |= static_cast<uint32_t>(
+        std::lround((v + 1.0) * 0.5 * kSmallestThreeSteps)) << shift;
+    shift -= 10;
+  }
+  return packed;
+}
+
+/////////////////////////////////////////////////
+ignition::math::Quaterniond msgs::UnpackQuaternion(const uint32_t _packed)
+{
+  const uint32_t largest = _packed >> 30;
+  double c[4];
+  double sum = 0;
+  int shift = 20;
+  for (uint32_t i = 0; i < 4; ++i)
+  {
+    if (i == largest)
+      continue;
+
+    const uint32_t step = (_packed >> shift) & kSmallestThreeSteps;
+    c[i] = (step * 2.0 / kSmallestThreeSteps - 1.0) * kSmallestThreeMax;
+    sum += c[i] * c[i];
+    shift -= 10;
+  }
+  c[largest] = std::sqrt(std::max(0.0, 1.0 - sum));
+
+  ignition::math::Quaterniond q(c[0], c[1], c[2], c[3]);
+  q.Normalize();
+  return q;
+}
+
+/////////////////////////////////////////////////
+PoseStreamEncoder::PoseStreamEncoder(const double _resolution)
+  : dataPtr(new PoseStreamEncoderPrivate)
+{
+  this->dataPtr->resolution = _resolution;
+}
+
+/////////////////////////////////////////////////
+PoseStreamEncoder::~PoseStreamEncoder()
+{
+}
+
+/////////////////////////////////////////////////
+uint32_t PoseStreamEncoderPrivate::BaseFrame()
+{
+  const auto now = std::chrono::steady_clock::now();
+  uint32_t base = 0;
+  uint32_t first = 0;
+  for (auto iter = this->clients.begin(); iter != this->clients.end();)
+  {
+    if (now - iter->second.time > kPoseStreamClientTimeout)
+    {
+      iter = this->clients.erase(iter);
+      continue;
+    }
+
+    if (iter->second.frame == 0)
+      return 0;
+
+    base = base == 0 ? iter->second.frame :
+        std::min(base, iter->second.frame);
+    first = std::max(first, iter->second.first);
+    ++iter;
+  }
+
+  // Every client must have the base frame
+  if (base == 0 || base < first || !FindFrame(this->history, base))
+    return 0;
+  return base;
+}
+
+/////////////////////////////////////////////////
+void PoseStreamEncoder::Update(const PosesStamped &_poses)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  const double resolution = this->dataPtr->resolution;
+
+  for (int i = 0; i < _poses.pose_size(); ++i)
+  {
+    const Pose &pose = _poses.pose(i);
+    QuantizedPose q;
+    q.position[0] = std::llround(pose.position().x() / resolution);
+    q.position[1] = std::llround(pose.position().y() / resolution);
+    q.position[2] = std::llround(pose.position().z() / resolution);
+    q.rotation = PackQuaternion(ignition::math::Quaterniond(
+        pose.orientation().w(), pose.orientation().x(),
+        pose.orientation().y(), pose.orientation().z()));
+
+    // Motion below the resolution doesn't need a frame
+    auto inserted = this->dataPtr->current.emplace(pose.id(), q);
+    if (inserted.second)
+    {
+      this->dataPtr->dirty = true;
+    }
+    else if (!(inserted.first->second == q))
+    {
+      inserted.first->second = q;
+      this->dataPtr->dirty = true;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void PoseStreamEncoder::Encode(const Time &_time, CompactPoses &_msg)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  const uint32_t baseFrame = this->dataPtr->BaseFrame();
+  const PoseTable *base = baseFrame ?
+      FindFrame(this->dataPtr->history, baseFrame) : nullptr;
+
+  if (++this->dataPtr->frame == 0)
+    this->dataPtr->frame = 1;
+
+  _msg.Clear();
+  _msg.mutable_time()->CopyFrom(_time);
+  _msg.set_frame(this->dataPtr->frame);
+  _msg.set_base_frame(baseFrame);
+  _msg.set_resolution(this->dataPtr->resolution);
+
+  uint32_t prevId = 0;
+  for (auto const &entry : this->dataPtr->current)
+  {
+    const QuantizedPose *prev = nullptr;
+    if (base)
+    {
+      auto iter = base->find(entry.first);
+      if (iter != base->end())
+      {
+        if (iter->second == entry.second)
+          continue;
+        prev = &iter->second;
+      }
+    }
+
+    _msg.add_id(entry.first - prevId);
+    prevId = entry.first;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      _msg.add_position(entry.second.position[axis] -
+          (prev ? prev->position[axis] : 0));
+    }
+    _msg.add_rotation(entry.second.rotation);
+  }
+
+  this->dataPtr->history.emplace_back(this->dataPtr->frame,
+      this->dataPtr->current);
+  if (this->dataPtr->history.size() > kPoseStreamHistory)
+    this->dataPtr->history.pop_front();
+  this->dataPtr->dirty = false;
+}
+
+/////////////////////////////////////////////////
+void PoseStreamEncoder::Ack(const CompactPosesAck &_msg)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  PoseStreamClient &client = this->dataPtr->clients[_msg.client()];
+  if (_msg.frame() == 0)
+  {
+    client.frame = 0;
+    client.first = 0;
+  }
+  else
+  {
+    if (client.frame == 0)
+      client.first = _msg.frame();
+    client.frame = std::max(client.frame, _msg.frame());
+  }
+  client.time = std::chrono::steady_clock::now();
+}
+
+/////////////////////////////////////////////////
+bool PoseStreamEncoder::FramePending() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (this->dataPtr->dirty)
+    return true;
+
+  for (auto const &client : this->dataPtr->clients)
+  {
+    if (client.second.frame == 0)
+      return true;
+  }
+  return false;
+}
+
+/////////////////////////////////////////////////
+void PoseStreamEncoder::Remove(const uint32_t _id)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->current.erase(_id);
+}
+
+/////////////////////////////////////////////////
+PoseStreamDecoder::PoseStreamDecoder()
+  : dataPtr(new PoseStreamDecoderPrivate)
+{
+  std::random_device device;
+  std::uniform_int_distribution<uint32_t> dist(1);
+  this->dataPtr->client = dist(device);
+}
+
+/////////////////////////////////////////////////
+PoseStreamDecoder::~PoseStreamDecoder()
+{
+}
+
+/////////////////////////////////////////////////
+bool PoseStreamDecoder::Decode(const CompactPoses &_msg,
+    PosesStamped &_poses, CompactPosesAck &_ack)
+{
+  _ack.set_client(this->dataPtr->client);
+  _ack.set_frame(0);
+  _poses.Clear();
+
+  const PoseTable *base = nullptr;
+  if (_msg.base_frame() != 0)
+  {
+    base = FindFrame(this->dataPtr->history, _msg.base_frame());
+    if (!base)
+      return false;
+  }
+
+  const int count = _msg.id_size();
+  if (_msg.position_size() != 3 * count || _msg.rotation_size() != count)
+    return false;
+
+  PoseTable table;
+  if (base)
+    table = *base;
+
+  const double resolution = _msg.resolution();
+  uint32_t id = 0;
+  for (int i = 0; i < count; ++i)
+  {
+    id += _msg.id(i);
+
+    QuantizedPose q;
+    const QuantizedPose *prev = nullptr;
+    if (base)
+    {
+      auto iter = base->find(id);
+      if (iter != base->end())
+        prev = &iter->second;
+    }
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      q.position[axis] = _msg.position(3 * i + axis) +
+          (prev ? prev->position[axis] : 0);
+    }
+    q.rotation = _msg.rotation(i);
+    table[id] = q;
+
+    Pose *pose = _poses.add_pose();
+    pose->set_id(id);
+    pose->mutable_position()->set_x(q.position[0] * resolution);
+    pose->mutable_position()->set_y(q.position[1] * resolution);
+    pose->mutable_position()->set_z(q.position[2] * resolution);
+    const ignition::math::Quaterniond rot = UnpackQuaternion(q.rotation);
+    pose->mutable_orientation()->set_w(rot.W());
+    pose->mutable_orientation()->set_x(rot.X());
+    pose->mutable_orientation()->set_y(rot.Y());
+    pose->mutable_orientation()->set_z(rot.Z());
+  }
+  _poses.mutable_time()->CopyFrom(_msg.time());
+
+  this->dataPtr->history.emplace_back(_msg.frame(), std::move(table));
+  if (this->dataPtr->history.size() > kPoseStreamHistory)
+    this->dataPtr->history.pop_front();
+
+  _ack.set_frame(_msg.frame());
+  return true;
+}
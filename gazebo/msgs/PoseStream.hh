@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_MSGS_POSESTREAM_HH_
+#define GAZEBO_MSGS_POSESTREAM_HH_
+
+#include <cstdint>
+#include <memory>
+
+#include <ignition/math/Quaternion.hh>
+
+#include "gazebo/msgs/MessageTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace msgs
+  {
+    // Forward declare private data classes
+    class PoseStreamEncoderPrivate;
+    class PoseStreamDecoderPrivate;
+
+    /// \addtogroup gazebo_msgs Messages
+    /// \{
+
+    /// \class PoseStreamEncoder PoseStream.hh msgs/PoseStream.hh
+    /// \brief Turns the pose stream of a world into CompactPoses frames.
+    ///
+    /// The encoder keeps the latest quantized pose of every entity and the
+    /// frames it sent recently. Clients acknowledge the frames they decode,
+    /// and each frame is coded relative to the oldest frame acknowledged by
+    /// the clients, so only the entities that changed since then are sent.
+    /// A key frame with every entity is sent while a client asks for one or
+    /// no usable frame was acknowledged. Safe to use from several threads.
+    class GAZEBO_VISIBLE PoseStreamEncoder
+    {
+      /// \brief Constructor.
+      /// \param[in] _resolution Size of a position step, in meters.
+      public: explicit PoseStreamEncoder(const double _resolution = 1e-4);
+
+      /// \brief Destructor.
+      public: ~PoseStreamEncoder();
+
+      /// \brief Record poses that changed. Call it for every update,
+      /// including those that are not sent, so that the next frame is
+      /// current.
+      /// \param[in] _poses Poses that changed. Only their ids are used,
+      /// not their names.
+      public: void Update(const PosesStamped &_poses);
+
+      /// \brief Code the next frame.
+      /// \param[in] _time Simulation time of the frame.
+      /// \param[out] _msg The frame to send.
+      public: void Encode(const Time &_time, CompactPoses &_msg);
+
+      /// \brief Record the acknowledgement of a client.
+      /// \param[in] _msg Client id and frame.
+      public: void Ack(const CompactPosesAck &_msg);
+
+      /// \brief Check whether there is a frame to send: an entity moved
+      /// since the last frame, or a client waits for a key frame.
+      /// \return True if a frame is due.
+      public: bool FramePending() const;
+
+      /// \brief Forget an entity that was deleted.
+      /// \param[in] _id Id of the entity.
+      public: void Remove(const uint32_t _id);
+
+      /// \internal
+      /// \brief Pointer to private data.
+      private: std::unique_ptr<PoseStreamEncoderPrivate> dataPtr;
+    };
+
+    /// \class PoseStreamDecoder PoseStream.hh msgs/PoseStream.hh
+    /// \brief Turns CompactPoses frames back into poses, see
+    /// PoseStreamEncoder. The caller sends the acknowledgement returned by
+    /// Decode to the encoder.
+    class GAZEBO_VISIBLE PoseStreamDecoder
+    {
+      /// \brief Constructor. Picks a random client id.
+      public: PoseStreamDecoder();
+
+      /// \brief Destructor.
+      public: ~PoseStreamDecoder();
+
+      /// \brief Decode a frame.
+      /// \param[in] _msg The frame.
+      /// \param[out] _poses The poses carried by the frame, by id.
+      /// \param[out] _ack Acknowledgement to send back. It asks for a key
+      /// frame if this frame could not be decoded.
+      /// \return False if the frame is relative to a frame this decoder
+      /// does not have, or is malformed.
+      public: bool Decode(const CompactPoses &_msg, PosesStamped &_poses,
+                          CompactPosesAck &_ack);
+
+      /// \internal
+      /// \brief Pointer to private data.
+      private: std::unique_ptr<PoseStreamDecoderPrivate> dataPtr;
+    };
+
+    /// \brief Pack a unit quaternion in 32 bits, in smallest three form.
+    /// \param[in] _q The quaternion.
+    /// \return Packed quaternion.
+    GAZEBO_VISIBLE
+    uint32_t PackQuaternion(const ignition::math::Quaterniond &_q);
+
+    /// \brief Unpack a quaternion packed by PackQuaternion.
+    /// \param[in] _packed Packed quaternion.
+    /// \return The unit quaternion.
+    GAZEBO_VISIBLE
+    ignition::math::Quaterniond UnpackQuaternion(const uint32_t _packed);
+    /// \}
+  }
+}
+#endif
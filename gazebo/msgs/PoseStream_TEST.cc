@@ -0,0 +1,240 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+#include <ignition/math/Pose3.hh>
+
+#include "gazebo/msgs/PoseStream.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class PoseStreamTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Add a pose to a message.
+/// \param[in] _msg The message.
+/// \param[in] _id Entity id.
+/// \param[in] _pose The pose.
+static void AddPose(msgs::PosesStamped &_msg, const uint32_t _id,
+    const ignition::math::Pose3d &_pose)
+{
+  msgs::Pose *pose = _msg.add_pose();
+  pose->set_id(_id);
+  pose->mutable_position()->set_x(_pose.Pos().X());
+  pose->mutable_position()->set_y(_pose.Pos().Y());
+  pose->mutable_position()->set_z(_pose.Pos().Z());
+  pose->mutable_orientation()->set_w(_pose.Rot().W());
+  pose->mutable_orientation()->set_x(_pose.Rot().X());
+  pose->mutable_orientation()->set_y(_pose.Rot().Y());
+  pose->mutable_orientation()->set_z(_pose.Rot().Z());
+}
+
+/////////////////////////////////////////////////
+/// \brief Check a decoded pose.
+/// \param[in] _pose Decoded pose.
+/// \param[in] _id Expected id.
+/// \param[in] _expected Expected pose.
+static void ExpectPose(const msgs::Pose &_pose, const uint32_t _id,
+    const ignition::math::Pose3d &_expected)
+{
+  EXPECT_EQ(_id, _pose.id());
+  EXPECT_NEAR(_expected.Pos().X(), _pose.position().x(), 1e-4);
+  EXPECT_NEAR(_expected.Pos().Y(), _pose.position().y(), 1e-4);
+  EXPECT_NEAR(_expected.Pos().Z(), _pose.position().z(), 1e-4);
+
+  ignition::math::Quaterniond rot(_pose.orientation().w(),
+      _pose.orientation().x(), _pose.orientation().y(),
+      _pose.orientation().z());
+  EXPECT_LT((rot.Inverse() * _expected.Rot()).Euler().Length(), 5e-3);
+}
+
+/////////////////////////////////////////////////
+TEST_F(PoseStreamTest, PackQuaternion)
+{
+  for (double roll = -3.0; roll < 3.1; roll += 0.7)
+  {
+    for (double pitch = -1.5; pitch < 1.6; pitch += 0.5)
+    {
+      for (double yaw = -3.0; yaw < 3.1; yaw += 0.9)
+      {
+        ignition::math::Quaterniond q(roll, pitch, yaw);
+        auto unpacked = msgs::UnpackQuaternion(msgs::PackQuaternion(q));
+        EXPECT_LT((unpacked.Inverse() * q).Euler().Length(), 5e-3);
+
+        // Both signs of a rotation pack the same
+        ignition::math::Quaterniond neg(-q.W(), -q.X(), -q.Y(), -q.Z());
+        EXPECT_EQ(msgs::PackQuaternion(q), msgs::PackQuaternion(neg));
+      }
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(PoseStreamTest, KeyAndDeltaFrames)
+{
+  msgs::PoseStreamEncoder encoder;
+  msgs::PoseStreamDecoder decoder;
+
+  const ignition::math::Pose3d a(1, 2, 3, 0.1, 0.2, 0.3);
+  const ignition::math::Pose3d b(-40.5, 0.25, 7, 0, 0, 1.5);
+  const ignition::math::Pose3d c(100, 200, 0.5, 0, 0, 0);
+
+  msgs::PosesStamped poses;
+  poses.mutable_time()->set_sec(1);
+  poses.mutable_time()->set_nsec(0);
+  AddPose(poses, 5, a);
+  AddPose(poses, 12, b);
+  AddPose(poses, 1000, c);
+
+  // Without an acknowledged frame, frames are key frames
+  msgs::CompactPoses frame;
+  encoder.Update(poses);
+  encoder.Encode(poses.time(), frame);
+  EXPECT_EQ(1u, frame.frame());
+  EXPECT_EQ(0u, frame.base_frame());
+  ASSERT_EQ(3, frame.id_size());
+
+  msgs::PosesStamped decoded;
+  msgs::CompactPosesAck ack;
+  ASSERT_TRUE(decoder.Decode(frame, decoded, ack));
+  EXPECT_EQ(1u, ack.frame());
+  EXPECT_NE(0u, ack.client());
+  EXPECT_EQ(1, decoded.time().sec());
+  ASSERT_EQ(3, decoded.pose_size());
+  ExpectPose(decoded.pose(0), 5, a);
+  ExpectPose(decoded.pose(1), 12, b);
+  ExpectPose(decoded.pose(2), 1000, c);
+  encoder.Ack(ack);
+  EXPECT_FALSE(encoder.FramePending());
+
+  // Only the entity that moved is sent, relative to the acked frame
+  const ignition::math::Pose3d b2(-40.4, 0.25, 7, 0, 0, 1.6);
+  poses.clear_pose();
+  AddPose(poses, 12, b2);
+  AddPose(poses, 1000, c);
+  encoder.Update(poses);
+  encoder.Encode(poses.time(), frame);
+  EXPECT_EQ(2u, frame.frame());
+  EXPECT_EQ(1u, frame.base_frame());
+  ASSERT_EQ(1, frame.id_size());
+  EXPECT_EQ(12u, frame.id(0));
+  EXPECT_EQ(1000, frame.position(0));
+  EXPECT_EQ(0, frame.position(1));
+
+  ASSERT_TRUE(decoder.Decode(frame, decoded, ack));
+  ASSERT_EQ(1, decoded.pose_size());
+  ExpectPose(decoded.pose(0), 12, b2);
+
+  // Without a newer ack, the next frame is still relative to frame 1
+  poses.clear_pose();
+  encoder.Update(poses);
+  encoder.Encode(poses.time(), frame);
+  EXPECT_EQ(1u, frame.base_frame());
+  EXPECT_EQ(1, frame.id_size());
+  encoder.Ack(ack);
+  encoder.Update(poses);
+  encoder.Encode(poses.time(), frame);
+  EXPECT_EQ(2u, frame.base_frame());
+  EXPECT_EQ(0, frame.id_size());
+  EXPECT_FALSE(encoder.FramePending());
+
+  // Motion below the resolution does not need a frame
+  AddPose(poses, 5, ignition::math::Pose3d(1 + 1e-6, 2, 3, 0.1, 0.2, 0.3));
+  encoder.Update(poses);
+  EXPECT_FALSE(encoder.FramePending());
+  AddPose(poses, 5, ignition::math::Pose3d(1.01, 2, 3, 0.1, 0.2, 0.3));
+  encoder.Update(poses);
+  EXPECT_TRUE(encoder.FramePending());
+}
+
+/////////////////////////////////////////////////
+TEST_F(PoseStreamTest, LateClient)
+{
+  msgs::PoseStreamEncoder encoder;
+  msgs::PoseStreamDecoder first;
+  msgs::PoseStreamDecoder late;
+
+  msgs::PosesStamped poses;
+  poses.mutable_time()->set_sec(0);
+  poses.mutable_time()->set_nsec(0);
+  AddPose(poses, 1, ignition::math::Pose3d(1, 0, 0, 0, 0, 0));
+  AddPose(poses, 2, ignition::math::Pose3d(2, 0, 0, 0, 0, 0));
+
+  msgs::CompactPoses frame;
+  msgs::PosesStamped decoded;
+  msgs::CompactPosesAck ack;
+  encoder.Update(poses);
+  encoder.Encode(poses.time(), frame);
+  ASSERT_TRUE(first.Decode(frame, decoded, ack));
+  encoder.Ack(ack);
+
+  // A client that joins during a delta frame asks for a key frame
+  poses.clear_pose();
+  AddPose(poses, 1, ignition::math::Pose3d(1, 1, 0, 0, 0, 0));
+  encoder.Update(poses);
+  encoder.Encode(poses.time(), frame);
+  EXPECT_NE(0u, frame.base_frame());
+  ASSERT_TRUE(first.Decode(frame, decoded, ack));
+  EXPECT_FALSE(late.Decode(frame, decoded, ack));
+  EXPECT_EQ(0u, ack.frame());
+  encoder.Ack(ack);
+  EXPECT_TRUE(encoder.FramePending());
+
+  poses.clear_pose();
+  encoder.Update(poses);
+  encoder.Encode(poses.time(), frame);
+  EXPECT_EQ(0u, frame.base_frame());
+  EXPECT_EQ(2, frame.id_size());
+  ASSERT_TRUE(first.Decode(frame, decoded, ack));
+  ASSERT_TRUE(late.Decode(frame, decoded, ack));
+  ExpectPose(decoded.pose(0), 1, ignition::math::Pose3d(1, 1, 0, 0, 0, 0));
+  encoder.Ack(ack);
+  EXPECT_FALSE(encoder.FramePending());
+
+  // The first client only acked frame 1, which the late one lacks. Every
+  // client receives every frame, acks are just late.
+  encoder.Update(poses);
+  encoder.Encode(poses.time(), frame);
+  EXPECT_EQ(0u, frame.base_frame());
+  ASSERT_TRUE(first.Decode(frame, decoded, ack));
+  encoder.Ack(ack);
+  ASSERT_TRUE(late.Decode(frame, decoded, ack));
+
+  // Once both acked a frame they share, deltas resume
+  encoder.Update(poses);
+  encoder.Encode(poses.time(), frame);
+  EXPECT_NE(0u, frame.base_frame());
+  ASSERT_TRUE(first.Decode(frame, decoded, ack));
+  ASSERT_TRUE(late.Decode(frame, decoded, ack));
+
+  // Removed entities are left out of key frames
+  encoder.Remove(2);
+  msgs::PoseStreamDecoder third;
+  EXPECT_FALSE(third.Decode(frame, decoded, ack));
+  encoder.Ack(ack);
+  encoder.Update(poses);
+  encoder.Encode(poses.time(), frame);
+  EXPECT_EQ(0u, frame.base_frame());
+  EXPECT_EQ(1, frame.id_size());
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -17,6 +17,8 @@
 #include <sstream>
 #include <limits>
 #include <algorithm>
+#include <utility>
+#include <vector>
 
 #include "gazebo/common/BVHLoader.hh"
 #include "gazebo/common/Console.hh"
@@ -54,6 +56,18 @@ class gazebo::physics::ActorPrivate
 
   /// \brief Last map associating skeleton nodes from skin and animation
   public: std::map<std::string, std::string> lastSkelMap;
+
+  /// \brief Link of each skeleton node, indexed by node handle. Filled on
+  /// the first SetPose to avoid looking the links up by name every frame.
+  public: std::vector<LinkPtr> boneLinks;
+
+  /// \brief Link of the parent of each skeleton node, null for the root,
+  /// indexed by node handle.
+  public: std::vector<LinkPtr> parentLinks;
+
+  /// \brief Mesh files the actor holds a reference to, see
+  /// common::MeshManager::AddReference. The skeletons come from them.
+  public: std::vector<std::string> meshReferences;
 };
 
 using namespace gazebo;
@@ -84,6 +98,9 @@ Actor::~Actor()
 
   this->mainLink.reset();
 
+  for (auto const &name : this->dataPtr->meshReferences)
+    MeshManager::Instance()->RemoveReference(name);
+
   // mesh and skeleton should be deleted by the MeshManager
 }
 
@@ -171,6 +188,8 @@ bool Actor::LoadSkin(sdf::ElementPtr _skinSdf)
   this->skinFile = _skinSdf->Get<std::string>("filename");
   this->skinScale = _skinSdf->Get<double>("scale");
 
+  MeshManager::Instance()->AddReference(this->skinFile);
+  this->dataPtr->meshReferences.push_back(this->skinFile);
   MeshManager::Instance()->Load(this->skinFile);
   if (!MeshManager::Instance()->HasMesh(this->skinFile))
   {
@@ -437,6 +456,8 @@ void Actor::LoadAnimation(sdf::ElementPtr _sdf)
   }
   else if (extension == "dae")
   {
+    MeshManager::Instance()->AddReference(animFile);
+    this->dataPtr->meshReferences.push_back(animFile);
     MeshManager::Instance()->Load(animFile);
 
     const class Mesh *animMesh = nullptr;
@@ -783,7 +804,11 @@ void Actor::Update()
     return;
   }
 
-  auto skelMap = this->skelNodesMap[tinfo->type];
+  const auto &skelMap = this->skelNodesMap[tinfo->type];
+  std::string rootName;
+  auto rootIter = skelMap.find(this->skeleton->GetRootNode()->GetName());
+  if (rootIter != skelMap.end())
+    rootName = rootIter->second;
 
   std::map<std::string, ignition::math::Matrix4d> frame;
   if (!this->customTrajectoryInfo)
@@ -791,8 +816,7 @@ void Actor::Update()
     if (this->interpolateX[tinfo->type] &&
           this->trajectories.find(tinfo->id) != this->trajectories.end())
     {
-      frame = skelAnim->PoseAtX(this->pathLength,
-                skelMap[this->skeleton->GetRootNode()->GetName()]);
+      frame = skelAnim->PoseAtX(this->pathLength, rootName);
     }
     else
     {
@@ -807,10 +831,10 @@ void Actor::Update()
   this->lastTraj = tinfo->id;
 
   ignition::math::Matrix4d rootTrans = ignition::math::Matrix4d::Identity;
-  auto iter = frame.find(skelMap[this->skeleton->GetRootNode()->GetName()]);
+  auto iter = frame.find(rootName);
   if (iter != frame.end())
   {
-    rootTrans = frame[skelMap[this->skeleton->GetRootNode()->GetName()]];
+    rootTrans = iter->second;
   }
 
   ignition::math::Vector3d rootPos = rootTrans.Translation();
@@ -852,21 +876,48 @@ void Actor::Update()
   // workaround for rotation bug
   rootM.SetTranslation(rootM.Translation() * this->skinScale);
 
-  frame[skelMap[this->skeleton->GetRootNode()->GetName()]] = rootM;
+  frame[rootName] = rootM;
 
-  this->dataPtr->lastFrame = frame;
-  this->dataPtr->lastSkelMap = skelMap;
+  this->dataPtr->lastFrame = std::move(frame);
+  if (this->dataPtr->lastSkelMap != skelMap)
+    this->dataPtr->lastSkelMap = skelMap;
 
-  this->SetPose(frame, skelMap, currentTime.Double());
+  this->SetPose(this->dataPtr->lastFrame, skelMap, currentTime.Double());
 }
 
 //////////////////////////////////////////////////
-void Actor::SetPose(std::map<std::string, ignition::math::Matrix4d> _frame,
-    std::map<std::string, std::string> _skelMap, const double _time)
+void Actor::SetPose(
+    const std::map<std::string, ignition::math::Matrix4d> &_frame,
+    const std::map<std::string, std::string> &_skelMap, const double _time)
 {
+  // Only build the bone message when someone listens, the links are
+  // moved either way
+  bool publish = this->bonePosePub && this->bonePosePub->HasConnections();
+
   msgs::PoseAnimation msg;
-  msg.set_model_name(this->visualName);
-  msg.set_model_id(this->visualId);
+  if (publish)
+  {
+    msg.set_model_name(this->visualName);
+    msg.set_model_id(this->visualId);
+  }
+
+  unsigned int nodeCount = this->skeleton->GetNumNodes();
+  if (this->dataPtr->boneLinks.size() != nodeCount)
+  {
+    this->dataPtr->boneLinks.resize(nodeCount);
+    this->dataPtr->parentLinks.resize(nodeCount);
+    for (unsigned int i = 0; i < nodeCount; ++i)
+    {
+      SkeletonNode *bone = this->skeleton->GetNodeByHandle(i);
+      this->dataPtr->boneLinks[i] = this->GetChildLink(bone->GetName());
+      if (bone->GetParent())
+      {
+        this->dataPtr->parentLinks[i] =
+            this->GetChildLink(bone->GetParent()->GetName());
+      }
+    }
+  }
+  const std::string &rootName = this->skeleton->GetRootNode()->GetName();
 
   ignition::math::Matrix4d modelTrans(ignition::math::Matrix4d::Identity);
   ignition::math::Pose3d mainLinkPose;
@@ -877,20 +928,25 @@ void Actor::SetPose(std::map<std::string, ignition::math::Matrix4d> _frame,
     mainLinkPose.Rot() = this->worldPose.Rot();
   }
 
-  for (unsigned int i = 0; i < this->skeleton->GetNumNodes(); ++i)
+  for (unsigned int i = 0; i < nodeCount; ++i)
   {
     SkeletonNode *bone = this->skeleton->GetNodeByHandle(i);
     SkeletonNode *parentBone = bone->GetParent();
     ignition::math::Matrix4d transform(ignition::math::Matrix4d::Identity);
 
-    if (_frame.find(_skelMap[bone->GetName()]) != _frame.end())
+    // Bones missing from the map are looked up with an empty name, as
+    // before, which normally finds no frame
+    auto skelIter = _skelMap.find(bone->GetName());
+    auto frameIter = _frame.find(
+        skelIter != _skelMap.end() ? skelIter->second : std::string());
+    if (frameIter != _frame.end())
     {
       if (this->dataPtr->bvhFile)
       {
-        std::string tempStr(_skelMap[bone->GetName()]);
-        transform = _frame[tempStr];
+        const std::string &tempStr = frameIter->first;
+        transform = frameIter->second;
 
-        if (bone->GetName() != this->skeleton->GetRootNode()->GetName())
+        if (bone->GetName() != rootName)
         {
           ignition::math::Vector3d bvhOffset = transform.Translation();
           ignition::math::Vector3d daeOffset = bone->Transform().Translation();
@@ -903,7 +959,7 @@ void Actor::SetPose(std::map<std::string, ignition::math::Matrix4d> _frame,
       }
       else
       {
-        transform = _frame[_skelMap[bone->GetName()]];
+        transform = frameIter->second;
       }
     }
     else
@@ -911,7 +967,7 @@ void Actor::SetPose(std::map<std::string, ignition::math::Matrix4d> _frame,
       transform = bone->Transform();
     }
 
-    LinkPtr currentLink = this->GetChildLink(bone->GetName());
+    const LinkPtr &currentLink = this->dataPtr->boneLinks[i];
     ignition::math::Pose3d bonePose = transform.Pose();
     if (!bonePose.IsFinite())
     {
@@ -920,59 +976,77 @@ void Actor::SetPose(std::map<std::string, ignition::math::Matrix4d> _frame,
       bonePose.Correct();
     }
 
-    msgs::Pose *bone_pose = msg.add_pose();
-    bone_pose->set_name(bone->GetName());
+    msgs::Pose *bone_pose = nullptr;
+    if (publish)
+    {
+      bone_pose = msg.add_pose();
+      bone_pose->set_name(bone->GetName());
+    }
 
     if (!parentBone)
     {
-      bone_pose->mutable_position()->CopyFrom(
-          msgs::Convert(ignition::math::Vector3d()));
-      bone_pose->mutable_orientation()->CopyFrom(msgs::Convert(
-          ignition::math::Quaterniond()));
+      if (publish)
+      {
+        bone_pose->mutable_position()->CopyFrom(
+            msgs::Convert(ignition::math::Vector3d()));
+        bone_pose->mutable_orientation()->CopyFrom(msgs::Convert(
+            ignition::math::Quaterniond()));
+      }
       if (!this->customTrajectoryInfo)
         mainLinkPose = bonePose;
     }
     else
     {
-      bone_pose->mutable_position()->CopyFrom(msgs::Convert(bonePose.Pos()));
-      bone_pose->mutable_orientation()->CopyFrom(msgs::Convert(bonePose.Rot()));
-      LinkPtr parentLink = this->GetChildLink(parentBone->GetName());
-      auto parentPose = parentLink->WorldPose();
+      if (publish)
+      {
+        bone_pose->mutable_position()->CopyFrom(
+            msgs::Convert(bonePose.Pos()));
+        bone_pose->mutable_orientation()->CopyFrom(
+            msgs::Convert(bonePose.Rot()));
+      }
+      auto parentPose = this->dataPtr->parentLinks[i]->WorldPose();
       ignition::math::Matrix4d parentTrans(parentPose);
       transform = parentTrans * transform;
     }
 
-    msgs::Pose *link_pose = msg.add_pose();
-    link_pose->set_name(currentLink->GetScopedName());
-    link_pose->set_id(currentLink->GetId());
-    ignition::math::Pose3d linkPose = transform.Pose() - mainLinkPose;
-    link_pose->mutable_position()->CopyFrom(msgs::Convert(linkPose.Pos()));
-    link_pose->mutable_orientation()->CopyFrom(msgs::Convert(linkPose.Rot()));
+    if (publish)
+    {
+      msgs::Pose *link_pose = msg.add_pose();
+      link_pose->set_name(currentLink->GetScopedName());
+      link_pose->set_id(currentLink->GetId());
+      ignition::math::Pose3d linkPose = transform.Pose() - mainLinkPose;
+      link_pose->mutable_position()->CopyFrom(msgs::Convert(linkPose.Pos()));
+      link_pose->mutable_orientation()->CopyFrom(
+          msgs::Convert(linkPose.Rot()));
+    }
     currentLink->SetWorldPose(transform.Pose(), true, false);
   }
 
-  msgs::Time *stamp = msg.add_time();
-  stamp->CopyFrom(msgs::Convert(_time));
-
-  msgs::Pose *model_pose = msg.add_pose();
-  model_pose->set_name(this->GetScopedName());
-  model_pose->set_id(this->GetId());
-  if (!this->customTrajectoryInfo)
-  {
-    model_pose->mutable_position()->CopyFrom(msgs::Convert(mainLinkPose.Pos()));
-    model_pose->mutable_orientation()->CopyFrom(
-        msgs::Convert(mainLinkPose.Rot()));
-  }
-  else
+  if (publish)
   {
-    model_pose->mutable_position()->CopyFrom(
-        msgs::Convert(this->worldPose.Pos()));
-    model_pose->mutable_orientation()->CopyFrom(
-        msgs::Convert(this->worldPose.Rot()));
-  }
+    msgs::Time *stamp = msg.add_time();
+    stamp->CopyFrom(msgs::Convert(_time));
+
+    msgs::Pose *model_pose = msg.add_pose();
+    model_pose->set_name(this->GetScopedName());
+    model_pose->set_id(this->GetId());
+    if (!this->customTrajectoryInfo)
+    {
+      model_pose->mutable_position()->CopyFrom(
+          msgs::Convert(mainLinkPose.Pos()));
+      model_pose->mutable_orientation()->CopyFrom(
+          msgs::Convert(mainLinkPose.Rot()));
+    }
+    else
+    {
+      model_pose->mutable_position()->CopyFrom(
+          msgs::Convert(this->worldPose.Pos()));
+      model_pose->mutable_orientation()->CopyFrom(
+          msgs::Convert(this->worldPose.Rot()));
+    }
 
-  if (this->bonePosePub && this->bonePosePub->HasConnections())
     this->bonePosePub->Publish(msg);
+  }
   if (!this->customTrajectoryInfo)
     this->SetWorldPose(mainLinkPose, true, false);
 }
@@ -980,6 +1054,8 @@ void Actor::SetPose(std::map<std::string, ignition::math::Matrix4d> _frame,
 //////////////////////////////////////////////////
 void Actor::Fini()
 {
+  this->dataPtr->boneLinks.clear();
+  this->dataPtr->parentLinks.clear();
   this->ResetCustomTrajectory();
   Model::Fini();
 }
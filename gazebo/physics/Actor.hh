@@ -282,9 +282,9 @@ namespace gazebo
       /// \param[in] _frame Each frame name and transform.
       /// \param[in] _skelMap Map of bone relationships.
       /// \param[in] _time Time over which to animate the set pose.
-      private: void SetPose(
-                   std::map<std::string, ignition::math::Matrix4d> _frame,
-                   std::map<std::string, std::string> _skelMap,
+      private: void SetPose(const std::map<std::string,
+                   ignition::math::Matrix4d> &_frame,
+                   const std::map<std::string, std::string> &_skelMap,
                    const double _time);
 
       /// \brief Pointer to the actor's mesh.
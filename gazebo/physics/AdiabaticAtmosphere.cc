@@ -16,6 +16,10 @@
 */
 #include <sdf/sdf.hh>
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 #include "gazebo/physics/AdiabaticAtmosphere.hh"
 #include "gazebo/physics/AtmosphereFactory.hh"
 #include "gazebo/physics/PhysicsEngine.hh"
@@ -35,6 +39,15 @@ namespace gazebo
       /// pressure and density of air.
       /// See https://en.wikipedia.org/wiki/Density_of_air#Altitude
       public: double adiabaticPower;
+
+      /// \brief Altitude step of the tables in meters, 0 if disabled.
+      public: double tableResolution = 0;
+
+      /// \brief Pressure at TABLE_MIN_ALTITUDE + i * tableResolution.
+      public: std::vector<double> pressureTable;
+
+      /// \brief Mass density at the same altitudes as the pressures.
+      public: std::vector<double> densityTable;
     };
   }
 }
@@ -44,6 +57,33 @@ using namespace physics;
 
 GZ_REGISTER_ATMOSPHERE_MODEL("adiabatic", AdiabaticAtmosphere)
 
+// Sea level down to the Dead Sea shore, up to the top of the troposphere
+const double AdiabaticAtmosphere::TABLE_MIN_ALTITUDE = -500.0;
+const double AdiabaticAtmosphere::TABLE_MAX_ALTITUDE = 11000.0;
+
+/// \brief Find the table cell of an altitude.
+/// \param[in] _altitude Altitude in meters.
+/// \param[in] _resolution Altitude step of the table.
+/// \param[in] _size Number of values in the table.
+/// \param[out] _index Index of the value below the altitude.
+/// \param[out] _t Position of the altitude in the cell, from 0 to 1.
+/// \return False if the altitude is outside the table.
+static bool TableCell(const double _altitude, const double _resolution,
+    const size_t _size, size_t &_index, double &_t)
+{
+  if (_size < 2)
+    return false;
+
+  const double x = (_altitude - AdiabaticAtmosphere::TABLE_MIN_ALTITUDE) /
+      _resolution;
+  if (!(x >= 0) || x > static_cast<double>(_size - 1))
+    return false;
+
+  _index = std::min(static_cast<size_t>(x), _size - 2);
+  _t = x - _index;
+  return true;
+}
+
 //////////////////////////////////////////////////
 AdiabaticAtmosphere::AdiabaticAtmosphere(physics::World &_world)
   : Atmosphere(_world), dataPtr(new AdiabaticAtmospherePrivate)
@@ -61,6 +101,7 @@ void AdiabaticAtmosphere::Load(sdf::ElementPtr _sdf)
 {
   Atmosphere::Load(_sdf);
   this->ComputeAdiabaticPower();
+  this->BuildTable();
 }
 
 //////////////////////////////////////////////////
@@ -102,11 +143,26 @@ void AdiabaticAtmosphere::OnAtmosphereMsg(ConstAtmospherePtr &_msg)
   Atmosphere::OnAtmosphereMsg(_msg);
 }
 
+//////////////////////////////////////////////////
+void AdiabaticAtmosphere::SetTemperature(const double _temperature)
+{
+  Atmosphere::SetTemperature(_temperature);
+  this->BuildTable();
+}
+
+//////////////////////////////////////////////////
+void AdiabaticAtmosphere::SetPressure(const double _pressure)
+{
+  Atmosphere::SetPressure(_pressure);
+  this->BuildTable();
+}
+
 //////////////////////////////////////////////////
 void AdiabaticAtmosphere::SetTemperatureGradient(const double _gradient)
 {
   Atmosphere::SetTemperatureGradient(_gradient);
   this->ComputeAdiabaticPower();
+  this->BuildTable();
 }
 
 //////////////////////////////////////////////////
@@ -120,6 +176,15 @@ double AdiabaticAtmosphere::Temperature(const double _altitude) const
 //////////////////////////////////////////////////
 double AdiabaticAtmosphere::Pressure(const double _altitude) const
 {
+  size_t index;
+  double t;
+  if (TableCell(_altitude, this->dataPtr->tableResolution,
+        this->dataPtr->pressureTable.size(), index, t))
+  {
+    const auto &table = this->dataPtr->pressureTable;
+    return table[index] + t * (table[index + 1] - table[index]);
+  }
+
   if (!ignition::math::equal(Atmosphere::Temperature(), 0.0, 1e-6))
   {
     // See https://en.wikipedia.org/wiki/Density_of_air#Altitude
@@ -138,6 +203,15 @@ double AdiabaticAtmosphere::Pressure(const double _altitude) const
 //////////////////////////////////////////////////
 double AdiabaticAtmosphere::MassDensity(const double _altitude) const
 {
+  size_t index;
+  double t;
+  if (TableCell(_altitude, this->dataPtr->tableResolution,
+        this->dataPtr->densityTable.size(), index, t))
+  {
+    const auto &table = this->dataPtr->densityTable;
+    return table[index] + t * (table[index + 1] - table[index]);
+  }
+
   if (!ignition::math::equal(Atmosphere::Temperature(), 0.0, 1e-6))
   {
     // See https://en.wikipedia.org/wiki/Density_of_air#Altitude
@@ -162,3 +236,101 @@ void AdiabaticAtmosphere::ComputeAdiabaticPower()
       this->World().Gravity().Length() /
       (-Atmosphere::TemperatureGradient() * Atmosphere::IDEAL_GAS_CONSTANT_R);
 }
+
+//////////////////////////////////////////////////
+void AdiabaticAtmosphere::Sample(const std::vector<double> &_altitudes,
+    std::vector<double> &_temperatures, std::vector<double> &_pressures,
+    std::vector<double> &_densities) const
+{
+  _temperatures.resize(_altitudes.size());
+  _pressures.resize(_altitudes.size());
+  _densities.resize(_altitudes.size());
+
+  const double temperature = Atmosphere::Temperature();
+  const double gradient = Atmosphere::TemperatureGradient();
+  const double pressure = Atmosphere::Pressure();
+  const double density = Atmosphere::MassDensity();
+  const bool zeroTemperature = ignition::math::equal(temperature, 0.0, 1e-6);
+  const auto &pressureTable = this->dataPtr->pressureTable;
+  const auto &densityTable = this->dataPtr->densityTable;
+
+  for (size_t i = 0; i < _altitudes.size(); ++i)
+  {
+    const double altitude = _altitudes[i];
+    _temperatures[i] = temperature + gradient * altitude;
+
+    size_t index;
+    double t;
+    if (TableCell(altitude, this->dataPtr->tableResolution,
+          pressureTable.size(), index, t))
+    {
+      _pressures[i] = pressureTable[index] +
+          t * (pressureTable[index + 1] - pressureTable[index]);
+      _densities[i] = densityTable[index] +
+          t * (densityTable[index + 1] - densityTable[index]);
+    }
+    else if (zeroTemperature)
+    {
+      _pressures[i] = 0;
+      _densities[i] = 0;
+    }
+    else
+    {
+      // Density follows the same power law with one less power, so a
+      // single pow gives both
+      const double base = 1 + gradient * altitude / temperature;
+      const double ratio = pow(base, this->dataPtr->adiabaticPower);
+      _pressures[i] = pressure * ratio;
+      _densities[i] = base > 0 ? density * ratio / base :
+          density * pow(base, this->dataPtr->adiabaticPower - 1);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void AdiabaticAtmosphere::SetTableResolution(const double _resolution)
+{
+  this->dataPtr->tableResolution = std::max(0.0, _resolution);
+  this->BuildTable();
+}
+
+//////////////////////////////////////////////////
+double AdiabaticAtmosphere::TableResolution() const
+{
+  return this->dataPtr->tableResolution;
+}
+
+//////////////////////////////////////////////////
+void AdiabaticAtmosphere::BuildTable()
+{
+  this->dataPtr->pressureTable.clear();
+  this->dataPtr->densityTable.clear();
+
+  const double resolution = this->dataPtr->tableResolution;
+  const double temperature = Atmosphere::Temperature();
+  if (resolution <= 0 || ignition::math::equal(temperature, 0.0, 1e-6))
+    return;
+
+  const size_t size = static_cast<size_t>(std::ceil(
+      (TABLE_MAX_ALTITUDE - TABLE_MIN_ALTITUDE) / resolution)) + 1;
+  const double gradient = Atmosphere::TemperatureGradient();
+  std::vector<double> pressures(size);
+  std::vector<double> densities(size);
+  for (size_t i = 0; i < size; ++i)
+  {
+    const double base = 1 + gradient *
+        (TABLE_MIN_ALTITUDE + i * resolution) / temperature;
+
+    // Interpolating across the point where the model breaks down would
+    // spread it over a whole cell, keep exact queries instead
+    if (base <= 0)
+      return;
+
+    const double ratio = pow(base, this->dataPtr->adiabaticPower);
+    pressures[i] = Atmosphere::Pressure() * ratio;
+    densities[i] = Atmosphere::MassDensity() * ratio / base;
+  }
+
+  this->dataPtr->pressureTable.swap(pressures);
+  this->dataPtr->densityTable.swap(densities);
+}
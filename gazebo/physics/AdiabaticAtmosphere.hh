@@ -19,6 +19,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "gazebo/physics/Atmosphere.hh"
 
@@ -43,6 +44,12 @@ namespace gazebo
     /// constant gradients of gravity and temperature
     /// with respect to altitude.
     /// The troposphere model is recommended for altitudes below 11 km.
+    ///
+    /// Pressure and mass density take a pow per query. With
+    /// SetTableResolution, or <ignition:atmosphere_table_resolution> in the
+    /// world SDF, they are tabulated between TABLE_MIN_ALTITUDE and
+    /// TABLE_MAX_ALTITUDE and interpolated linearly instead. Altitudes
+    /// outside the table are still computed exactly.
     class GZ_PHYSICS_VISIBLE AdiabaticAtmosphere : public Atmosphere
     {
       /// \brief Constructor.
@@ -64,6 +71,12 @@ namespace gazebo
       // Documentation inherited
       protected: virtual void OnAtmosphereMsg(ConstAtmospherePtr &_msg);
 
+      // Documentation inherited
+      public: virtual void SetTemperature(const double _temperature);
+
+      // Documentation inherited
+      public: virtual void SetPressure(const double _pressure);
+
       // Documentation inherited
       public: virtual void SetTemperatureGradient(const double _gradient);
 
@@ -76,9 +89,35 @@ namespace gazebo
       // Documentation inherited
       public: double MassDensity(const double _altitude = 0.0) const;
 
+      // Documentation inherited
+      public: virtual void Sample(const std::vector<double> &_altitudes,
+                  std::vector<double> &_temperatures,
+                  std::vector<double> &_pressures,
+                  std::vector<double> &_densities) const;
+
+      /// \brief Tabulate pressure and mass density. Set it before sensors
+      /// and plugins start querying the atmosphere, the table is not
+      /// guarded against concurrent queries.
+      /// \param[in] _resolution Altitude step of the table in meters, 0
+      /// to compute every query exactly.
+      public: void SetTableResolution(const double _resolution);
+
+      /// \brief Get the altitude step of the table.
+      /// \return Step in meters, 0 if the model is not tabulated.
+      public: double TableResolution() const;
+
+      /// \brief Lowest altitude covered by the table, in meters.
+      public: static const double TABLE_MIN_ALTITUDE;
+
+      /// \brief Highest altitude covered by the table, in meters.
+      public: static const double TABLE_MAX_ALTITUDE;
+
       // \brief Compute the adiabatic power used internally.
       private: void ComputeAdiabaticPower();
 
+      /// \brief Fill the table after a parameter changed.
+      private: void BuildTable();
+
       /// \internal
       /// \brief Private data pointer.
       protected: std::unique_ptr<AdiabaticAtmospherePrivate> dataPtr;
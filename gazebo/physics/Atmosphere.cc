@@ -201,6 +201,22 @@ double Atmosphere::MassDensity(const double /*_altitude*/) const
   return this->dataPtr->massDensity;
 }
 
+//////////////////////////////////////////////////
+void Atmosphere::Sample(const std::vector<double> &_altitudes,
+    std::vector<double> &_temperatures, std::vector<double> &_pressures,
+    std::vector<double> &_densities) const
+{
+  _temperatures.resize(_altitudes.size());
+  _pressures.resize(_altitudes.size());
+  _densities.resize(_altitudes.size());
+  for (size_t i = 0; i < _altitudes.size(); ++i)
+  {
+    _temperatures[i] = this->Temperature(_altitudes[i]);
+    _pressures[i] = this->Pressure(_altitudes[i]);
+    _densities[i] = this->MassDensity(_altitudes[i]);
+  }
+}
+
 //////////////////////////////////////////////////
 double Atmosphere::TemperatureGradient() const
 {
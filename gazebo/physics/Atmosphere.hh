@@ -19,6 +19,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "gazebo/msgs/msgs.hh"
 
@@ -95,6 +96,19 @@ namespace gazebo
       /// \return Density in kg/m^3 at the specified altitude.
       public: virtual double MassDensity(const double _altitude = 0.0) const;
 
+      /// \brief Get the temperature, pressure and mass density at many
+      /// altitudes at once, for sensors and plugins that query the
+      /// atmosphere every update. Models override it to share work between
+      /// the three quantities.
+      /// \param[in] _altitudes Altitudes above sea level in meters.
+      /// \param[out] _temperatures Temperatures in kelvin, one per altitude.
+      /// \param[out] _pressures Pressures in pascals, one per altitude.
+      /// \param[out] _densities Mass densities in kg/m^3, one per altitude.
+      public: virtual void Sample(const std::vector<double> &_altitudes,
+                  std::vector<double> &_temperatures,
+                  std::vector<double> &_pressures,
+                  std::vector<double> &_densities) const;
+
       /// \brief Set the temperature gradient dT/dZ with respect to increasing
       /// altitude around sea level.
       /// \param[in] _gradient Value of the temperature gradient dT/dZ around
@@ -15,6 +15,10 @@
  *
 */
 
+#include <string>
+#include <vector>
+
+#include "gazebo/physics/AdiabaticAtmosphere.hh"
 #include "gazebo/test/ServerFixture.hh"
 #include "gazebo/msgs/msgs.hh"
 
@@ -167,6 +171,66 @@ TEST_P(AtmosphereTest, AtmosphereParamBool)
   AtmosphereParamBool(this->GetParam());
 }
 
+/////////////////////////////////////////////////
+TEST_P(AtmosphereTest, Sample)
+{
+  Load("worlds/empty.world", false);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  physics::Atmosphere &atmosphere = world->Atmosphere();
+  const std::vector<double> altitudes = {-600, -500, 0, 3.7, 1000, 2345.6,
+      10999.9, 11000, 20000};
+
+  // Batched queries match one query per altitude
+  std::vector<double> temperatures;
+  std::vector<double> pressures;
+  std::vector<double> densities;
+  atmosphere.Sample(altitudes, temperatures, pressures, densities);
+  ASSERT_EQ(altitudes.size(), temperatures.size());
+  ASSERT_EQ(altitudes.size(), pressures.size());
+  ASSERT_EQ(altitudes.size(), densities.size());
+  for (size_t i = 0; i < altitudes.size(); ++i)
+  {
+    EXPECT_NEAR(atmosphere.Temperature(altitudes[i]), temperatures[i], 1e-9);
+    EXPECT_NEAR(atmosphere.Pressure(altitudes[i]), pressures[i], 1e-6);
+    EXPECT_NEAR(atmosphere.MassDensity(altitudes[i]), densities[i], 1e-12);
+  }
+
+  if (this->GetParam() != std::string("adiabatic"))
+    return;
+
+  // A tabulated model stays close to the exact one
+  auto &adiabatic = dynamic_cast<physics::AdiabaticAtmosphere &>(atmosphere);
+  EXPECT_DOUBLE_EQ(0.0, adiabatic.TableResolution());
+  adiabatic.SetTableResolution(10.0);
+  EXPECT_DOUBLE_EQ(10.0, adiabatic.TableResolution());
+
+  std::vector<double> tabTemperatures;
+  std::vector<double> tabPressures;
+  std::vector<double> tabDensities;
+  adiabatic.Sample(altitudes, tabTemperatures, tabPressures, tabDensities);
+  for (size_t i = 0; i < altitudes.size(); ++i)
+  {
+    EXPECT_NEAR(temperatures[i], tabTemperatures[i], 1e-9);
+    EXPECT_NEAR(pressures[i], tabPressures[i], 1e-6 * pressures[i]);
+    EXPECT_NEAR(densities[i], tabDensities[i], 1e-6 * densities[i]);
+    EXPECT_DOUBLE_EQ(tabPressures[i], adiabatic.Pressure(altitudes[i]));
+    EXPECT_DOUBLE_EQ(tabDensities[i], adiabatic.MassDensity(altitudes[i]));
+  }
+
+  // On the table nodes the values are exact
+  EXPECT_NEAR(89882.063292207444, adiabatic.Pressure(1000), 1e-6);
+  EXPECT_NEAR(1.1117154882870524, adiabatic.MassDensity(1000), 1e-9);
+
+  // The table follows parameter changes
+  adiabatic.SetTemperature(300);
+  adiabatic.SetTableResolution(0);
+  const double exact = adiabatic.Pressure(2345.6);
+  adiabatic.SetTableResolution(10.0);
+  EXPECT_NEAR(exact, adiabatic.Pressure(2345.6), 1e-6 * exact);
+}
+
 INSTANTIATE_TEST_CASE_P(Atmospheres, AtmosphereTest,
                         ::testing::Values("adiabatic"),);  // NOLINT
 
@@ -74,6 +74,9 @@ void Base::Load(sdf::ElementPtr _sdf)
 
   this->ComputeScopedName();
 
+  if (this->world)
+    this->world->_AddToIndex(shared_from_this());
+
   this->RegisterIntrospectionItems();
 }
 
@@ -90,6 +93,9 @@ void Base::Fini()
 {
   this->UnregisterIntrospectionItems();
 
+  if (this->world)
+    this->world->_RemoveFromIndex(this);
+
   // Remove self as a child of the parent
   if (this->parent)
   {
@@ -136,8 +142,16 @@ void Base::SetName(const std::string &_name)
   GZ_ASSERT(this->sdf != NULL, "Base sdf member is NULL");
   GZ_ASSERT(this->sdf->GetAttribute("name"), "Base sdf missing name attribute");
   this->sdf->GetAttribute("name")->Set(_name);
+
+  // Only entities that have been loaded are in the world's index. This may
+  // be called from a constructor, where shared_from_this is not available.
+  const bool indexed = this->world && this->world->_RemoveFromIndex(this);
+
   this->name = _name;
   this->ComputeScopedName();
+
+  if (indexed)
+    this->world->_AddToIndex(shared_from_this());
 }
 
 //////////////////////////////////////////////////
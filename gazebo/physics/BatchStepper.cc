@@ -0,0 +1,274 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/physics/BatchStepper.hh"
+#include "gazebo/physics/Joint.hh"
+#include "gazebo/physics/JointController.hh"
+#include "gazebo/physics/Link.hh"
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/World.hh"
+#include "gazebo/physics/WorldSnapshot.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief One world of a batch.
+    class BatchWorld
+    {
+      /// \brief The world.
+      public: WorldPtr world;
+
+      /// \brief Driven and observed joints.
+      public: std::vector<JointPtr> joints;
+
+      /// \brief Controller of the model of each joint.
+      public: std::vector<JointControllerPtr> controllers;
+
+      /// \brief Observed links.
+      public: std::vector<LinkPtr> links;
+
+      /// \brief State restored by resets.
+      public: WorldSnapshot snapshot;
+    };
+
+    /// \internal
+    /// \brief Private data for BatchStepper.
+    class BatchStepperPrivate
+    {
+      /// \brief Worlds of the batch.
+      public: std::vector<std::unique_ptr<BatchWorld>> worlds;
+
+      /// \brief Number of joints.
+      public: size_t jointCount = 0;
+
+      /// \brief Number of links.
+      public: size_t linkCount = 0;
+
+      /// \brief True if every name was found.
+      public: bool valid = true;
+    };
+  }
+}
+
+using namespace gazebo;
+using namespace physics;
+
+const size_t BatchStepper::kLinkObservationSize;
+
+/// \brief Get the model holding a scoped joint or link name.
+/// \param[in] _world World to search.
+/// \param[in] _name Scoped name, model::entity.
+/// \param[out] _entityName Name of the entity within the model.
+/// \return The model, null if not found.
+static ModelPtr ScopedModel(const WorldPtr &_world, const std::string &_name,
+    std::string &_entityName)
+{
+  const size_t pos = _name.rfind("::");
+  if (pos == std::string::npos)
+    return ModelPtr();
+  _entityName = _name.substr(pos + 2);
+  return _world->ModelByName(_name.substr(0, pos));
+}
+
+/////////////////////////////////////////////////
+BatchStepper::BatchStepper(const std::vector<WorldPtr> &_worlds,
+    const std::vector<std::string> &_joints,
+    const std::vector<std::string> &_links)
+  : dataPtr(new BatchStepperPrivate)
+{
+  this->dataPtr->jointCount = _joints.size();
+  this->dataPtr->linkCount = _links.size();
+
+  for (auto const &world : _worlds)
+  {
+    std::unique_ptr<BatchWorld> batchWorld(new BatchWorld);
+    batchWorld->world = world;
+
+    for (auto const &name : _joints)
+    {
+      std::string jointName;
+      ModelPtr model = ScopedModel(world, name, jointName);
+      JointPtr joint = model ? model->GetJoint(jointName) : JointPtr();
+      if (!joint)
+      {
+        gzerr << "Joint [" << name << "] not found in world ["
+              << world->Name() << "]\n";
+        this->dataPtr->valid = false;
+        return;
+      }
+      batchWorld->joints.push_back(joint);
+      batchWorld->controllers.push_back(model->GetJointController());
+    }
+
+    for (auto const &name : _links)
+    {
+      std::string linkName;
+      ModelPtr model = ScopedModel(world, name, linkName);
+      LinkPtr link = model ? model->GetLink(linkName) : LinkPtr();
+      if (!link)
+      {
+        gzerr << "Link [" << name << "] not found in world ["
+              << world->Name() << "]\n";
+        this->dataPtr->valid = false;
+        return;
+      }
+      batchWorld->links.push_back(link);
+    }
+
+    world->SaveSnapshot(batchWorld->snapshot);
+    this->dataPtr->worlds.push_back(std::move(batchWorld));
+  }
+}
+
+/////////////////////////////////////////////////
+BatchStepper::~BatchStepper()
+{
+}
+
+/////////////////////////////////////////////////
+bool BatchStepper::Valid() const
+{
+  return this->dataPtr->valid;
+}
+
+/////////////////////////////////////////////////
+size_t BatchStepper::WorldCount() const
+{
+  return this->dataPtr->worlds.size();
+}
+
+/////////////////////////////////////////////////
+size_t BatchStepper::ActionSize() const
+{
+  return this->dataPtr->jointCount;
+}
+
+/////////////////////////////////////////////////
+size_t BatchStepper::ObservationSize() const
+{
+  return 2 * this->dataPtr->jointCount +
+      kLinkObservationSize * this->dataPtr->linkCount;
+}
+
+/////////////////////////////////////////////////
+bool BatchStepper::Step(const double *_actions, const unsigned int _steps,
+    double *_observations, const uint8_t *_resets, const unsigned int _flags)
+{
+  if (!this->dataPtr->valid)
+    return false;
+
+  auto &worlds = this->dataPtr->worlds;
+  const size_t actionSize = this->ActionSize();
+
+  // The worlds are paused, their threads don't touch them meanwhile
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, worlds.size()),
+      [&](const tbb::blocked_range<size_t> &_r)
+  {
+    for (size_t w = _r.begin(); w != _r.end(); ++w)
+    {
+      BatchWorld &batchWorld = *worlds[w];
+      if (_resets && _resets[w] &&
+          !batchWorld.world->RestoreSnapshot(batchWorld.snapshot))
+      {
+        gzwarn << "Unable to reset world [" << batchWorld.world->Name()
+               << "], its models changed\n";
+      }
+
+      if (!_actions)
+        continue;
+
+      const double *action = _actions + w * actionSize;
+      for (size_t j = 0; j < batchWorld.joints.size(); ++j)
+      {
+        batchWorld.controllers[j]->SetForce(
+            batchWorld.joints[j]->GetScopedName(), action[j]);
+      }
+    }
+  });
+
+  // Each world runs its batch on its own thread
+  for (auto const &batchWorld : worlds)
+    batchWorld->world->StartStepBatch(_steps, _flags);
+  for (auto const &batchWorld : worlds)
+    batchWorld->world->WaitStepBatch();
+
+  if (_observations)
+    this->Observe(_observations);
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool BatchStepper::Observe(double *_observations) const
+{
+  if (!this->dataPtr->valid)
+    return false;
+
+  auto const &worlds = this->dataPtr->worlds;
+  const size_t observationSize = this->ObservationSize();
+
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, worlds.size()),
+      [&](const tbb::blocked_range<size_t> &_r)
+  {
+    for (size_t w = _r.begin(); w != _r.end(); ++w)
+    {
+      const BatchWorld &batchWorld = *worlds[w];
+      double *out = _observations + w * observationSize;
+
+      for (auto const &joint : batchWorld.joints)
+      {
+        *out++ = joint->Position(0);
+        *out++ = joint->GetVelocity(0);
+      }
+
+      for (auto const &link : batchWorld.links)
+      {
+        const ignition::math::Pose3d pose = link->WorldPose();
+        const ignition::math::Vector3d linear = link->WorldLinearVel();
+        const ignition::math::Vector3d angular = link->WorldAngularVel();
+        *out++ = pose.Pos().X();
+        *out++ = pose.Pos().Y();
+        *out++ = pose.Pos().Z();
+        *out++ = pose.Rot().W();
+        *out++ = pose.Rot().X();
+        *out++ = pose.Rot().Y();
+        *out++ = pose.Rot().Z();
+        *out++ = linear.X();
+        *out++ = linear.Y();
+        *out++ = linear.Z();
+        *out++ = angular.X();
+        *out++ = angular.Y();
+        *out++ = angular.Z();
+      }
+    }
+  });
+
+  return true;
+}
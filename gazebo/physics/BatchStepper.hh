@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_BATCHSTEPPER_HH_
+#define GAZEBO_PHYSICS_BATCHSTEPPER_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/physics/World.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    // Forward declare private data class
+    class BatchStepperPrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class BatchStepper BatchStepper.hh physics/physics.hh
+    /// \brief Steps several worlds with one call, e.g. the copies made by
+    /// gzserver --world_copies, for vectorized reinforcement learning.
+    ///
+    /// The worlds must hold the same joints and links, named alike, and be
+    /// running and paused. Each call applies an action per world, runs a
+    /// World::StepBatch in all the worlds at once, each on its own world
+    /// thread, and reads an observation per world. Actions and
+    /// observations are contiguous arrays of doubles, world major:
+    ///
+    ///     action of a world: effort of each joint
+    ///     observation of a world: for each joint, position and velocity,
+    ///       then for each link, world pose (x y z qw qx qy qz), linear
+    ///       velocity (x y z) and angular velocity (x y z)
+    ///
+    /// Efforts go through the JointController of the model, so they hold
+    /// for every iteration of the batch and until the next call.
+    class GZ_PHYSICS_VISIBLE BatchStepper
+    {
+      /// \brief Number of values observed per link.
+      public: static const size_t kLinkObservationSize = 13;
+
+      /// \brief Constructor. Saves a snapshot of each world, restored by
+      /// the resets of Step.
+      /// \param[in] _worlds Worlds to step.
+      /// \param[in] _joints Scoped names of the joints driven by the
+      /// actions and observed.
+      /// \param[in] _links Scoped names of the observed links.
+      public: BatchStepper(const std::vector<WorldPtr> &_worlds,
+                           const std::vector<std::string> &_joints,
+                           const std::vector<std::string> &_links);
+
+      /// \brief Destructor.
+      public: ~BatchStepper();
+
+      /// \brief Whether every joint and link was found in every world.
+      /// \return False if a name is missing, Step fails then.
+      public: bool Valid() const;
+
+      /// \brief Get the number of worlds.
+      /// \return Number of worlds.
+      public: size_t WorldCount() const;
+
+      /// \brief Get the size of the action of one world.
+      /// \return Number of joints.
+      public: size_t ActionSize() const;
+
+      /// \brief Get the size of the observation of one world.
+      /// \return 2 per joint plus kLinkObservationSize per link.
+      public: size_t ObservationSize() const;
+
+      /// \brief Apply the actions, step every world and observe them.
+      /// \param[in] _actions WorldCount() * ActionSize() efforts, or null
+      /// to keep the current ones.
+      /// \param[in] _steps Iterations to run in each world.
+      /// \param[out] _observations WorldCount() * ObservationSize()
+      /// values, or null.
+      /// \param[in] _resets One flag per world, or null. Worlds with a non
+      /// zero flag are restored to their snapshot before the actions.
+      /// \param[in] _flags Bitwise or of World::StepBatchFlag values.
+      /// \return False if the stepper isn't valid.
+      public: bool Step(const double *_actions, const unsigned int _steps,
+                        double *_observations,
+                        const uint8_t *_resets = nullptr,
+                        const unsigned int _flags = World::STEP_BATCH_NONE);
+
+      /// \brief Observe every world without stepping.
+      /// \param[out] _observations WorldCount() * ObservationSize()
+      /// values.
+      /// \return False if the stepper isn't valid.
+      public: bool Observe(double *_observations) const;
+
+      /// \internal
+      /// \brief Pointer to private data.
+      private: std::unique_ptr<BatchStepperPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
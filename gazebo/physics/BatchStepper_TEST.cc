@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <vector>
+
+#include "gazebo/physics/BatchStepper.hh"
+#include "gazebo/physics/PhysicsIface.hh"
+#include "gazebo/physics/World.hh"
+#include "gazebo/test/ServerFixture.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class BatchStepperTest : public ServerFixture {};
+
+//////////////////////////////////////////////////
+TEST_F(BatchStepperTest, UnknownNames)
+{
+  this->LoadArgs("-u --world_copies 2 test/worlds/single_revolute_test.world");
+  auto worlds = physics::get_worlds();
+  ASSERT_EQ(2u, worlds.size());
+
+  physics::BatchStepper badJoint(worlds, {"model::nope"}, {});
+  EXPECT_FALSE(badJoint.Valid());
+  EXPECT_FALSE(badJoint.Step(nullptr, 1, nullptr));
+
+  physics::BatchStepper badLink(worlds, {}, {"link_1"});
+  EXPECT_FALSE(badLink.Valid());
+}
+
+//////////////////////////////////////////////////
+TEST_F(BatchStepperTest, Step)
+{
+  this->LoadArgs("-u --world_copies 2 test/worlds/single_revolute_test.world");
+  auto worlds = physics::get_worlds();
+  ASSERT_EQ(2u, worlds.size());
+
+  physics::BatchStepper stepper(worlds, {"model::joint"},
+      {"model::link_1"});
+  ASSERT_TRUE(stepper.Valid());
+  EXPECT_EQ(2u, stepper.WorldCount());
+  EXPECT_EQ(1u, stepper.ActionSize());
+  EXPECT_EQ(2u + physics::BatchStepper::kLinkObservationSize,
+      stepper.ObservationSize());
+
+  std::vector<double> initial(2 * stepper.ObservationSize());
+  EXPECT_TRUE(stepper.Observe(initial.data()));
+
+  // Only the second world is driven
+  std::vector<double> actions = {0.0, 100.0};
+  std::vector<double> observations(initial.size());
+  EXPECT_TRUE(stepper.Step(actions.data(), 50, observations.data()));
+  for (auto const &world : worlds)
+  {
+    EXPECT_EQ(50u, world->Iterations());
+    EXPECT_TRUE(world->IsPaused());
+  }
+
+  const size_t size = stepper.ObservationSize();
+  EXPECT_DOUBLE_EQ(initial[0], observations[0]);
+  EXPECT_GT(observations[size], initial[size] + 1e-3);
+  EXPECT_GT(observations[size + 1], 0.0);
+
+  // Resetting the second world takes it back to the first observation
+  std::vector<uint8_t> resets = {0, 1};
+  actions = {0.0, 0.0};
+  EXPECT_TRUE(stepper.Step(actions.data(), 0, observations.data(),
+      resets.data()));
+  EXPECT_EQ(50u, worlds[0]->Iterations());
+  EXPECT_EQ(0u, worlds[1]->Iterations());
+  for (size_t i = 0; i < size; ++i)
+    EXPECT_NEAR(initial[size + i], observations[size + i], 1e-9) << i;
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
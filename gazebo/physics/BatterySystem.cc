@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include "gazebo/common/Battery.hh"
+#include "gazebo/physics/BatterySystem.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+/////////////////////////////////////////////////
+void BatterySystem::Add(const common::BatteryPtr &_battery,
+    const std::string &_name)
+{
+  if (!_battery)
+    return;
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+  for (const auto &battery : this->batteries)
+  {
+    if (battery == _battery)
+      return;
+  }
+
+  this->batteries.push_back(_battery);
+  this->names.push_back(_name);
+}
+
+/////////////////////////////////////////////////
+bool BatterySystem::Remove(const common::BatteryPtr &_battery)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  for (size_t i = 0; i < this->batteries.size(); ++i)
+  {
+    if (this->batteries[i] == _battery)
+    {
+      this->batteries.erase(this->batteries.begin() + i);
+      this->names.erase(this->names.begin() + i);
+      return true;
+    }
+  }
+  return false;
+}
+
+/////////////////////////////////////////////////
+size_t BatterySystem::Count() const
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  return this->batteries.size();
+}
+
+/////////////////////////////////////////////////
+void BatterySystem::Update()
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  for (const auto &battery : this->batteries)
+    battery->Update();
+}
+
+/////////////////////////////////////////////////
+void BatterySystem::FillMsg(msgs::BatteryStates &_msg) const
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  for (size_t i = 0; i < this->batteries.size(); ++i)
+  {
+    _msg.add_name(this->names[i]);
+    _msg.add_voltage(this->batteries[i]->Voltage());
+    _msg.add_power_load(this->batteries[i]->TotalPowerLoad());
+  }
+}
+
+/////////////////////////////////////////////////
+void BatterySystem::Clear()
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->batteries.clear();
+  this->names.clear();
+}
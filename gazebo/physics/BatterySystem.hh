@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_BATTERYSYSTEM_HH_
+#define GAZEBO_PHYSICS_BATTERYSYSTEM_HH_
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "gazebo/common/CommonTypes.hh"
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class BatterySystem BatterySystem.hh physics/physics.hh
+    /// \brief Updates the batteries of every link of a world in one pass.
+    ///
+    /// Links register their batteries when they are initialized and remove
+    /// them when they are destroyed. The world updates all of them once per
+    /// iteration, right after the world update begin event, and publishes
+    /// their states together on ~/battery_states at the rate set with
+    /// <ignition:battery_states_rate>.
+    class GZ_PHYSICS_VISIBLE BatterySystem
+    {
+      /// \brief Constructor.
+      public: BatterySystem() = default;
+
+      /// \brief Add a battery. Adding a battery twice has no effect.
+      /// \param[in] _battery Battery to update.
+      /// \param[in] _name Scoped name of the battery, used in the
+      /// battery states.
+      public: void Add(const common::BatteryPtr &_battery,
+                       const std::string &_name);
+
+      /// \brief Remove a battery.
+      /// \param[in] _battery Battery to remove.
+      /// \return True if the battery was found.
+      public: bool Remove(const common::BatteryPtr &_battery);
+
+      /// \brief Get the number of batteries.
+      /// \return Number of batteries.
+      public: size_t Count() const;
+
+      /// \brief Update every battery, see common::Battery::Update.
+      public: void Update();
+
+      /// \brief Add the name, voltage and total power load of every battery
+      /// to a message.
+      /// \param[out] _msg Message to fill.
+      public: void FillMsg(msgs::BatteryStates &_msg) const;
+
+      /// \brief Forget all batteries.
+      public: void Clear();
+
+      /// \brief Batteries to update.
+      private: std::vector<common::BatteryPtr> batteries;
+
+      /// \brief Scoped name of each battery.
+      private: std::vector<std::string> names;
+
+      /// \brief Protects the arrays, links come and go from other threads.
+      private: mutable std::mutex mutex;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <mutex>
+#include <sstream>
+#include <string>
+
+#include "gazebo/common/Battery.hh"
+#include "gazebo/physics/BatterySystem.hh"
+#include "gazebo/physics/Link.hh"
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/World.hh"
+#include "gazebo/test/ServerFixture.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class BatterySystemTest : public ServerFixture {};
+
+/// \brief Protects g_batteryStatesMsg.
+static std::mutex g_batteryStatesMutex;
+
+/// \brief Last message received on ~/battery_states.
+static msgs::BatteryStates g_batteryStatesMsg;
+
+/// \brief Number of messages received on ~/battery_states.
+static int g_batteryStatesCount = 0;
+
+//////////////////////////////////////////////////
+void OnBatteryStates(ConstBatteryStatesPtr &_msg)
+{
+  std::lock_guard<std::mutex> lock(g_batteryStatesMutex);
+  g_batteryStatesMsg.CopyFrom(*_msg);
+  ++g_batteryStatesCount;
+}
+
+//////////////////////////////////////////////////
+TEST_F(BatterySystemTest, AddRemove)
+{
+  physics::BatterySystem system;
+  EXPECT_EQ(0u, system.Count());
+
+  common::BatteryPtr battery1(new common::Battery());
+  common::BatteryPtr battery2(new common::Battery());
+  system.Add(battery1, "a");
+  system.Add(battery1, "a");
+  system.Add(battery2, "b");
+  system.Add(nullptr, "c");
+  EXPECT_EQ(2u, system.Count());
+
+  battery2->SetPowerLoad(battery2->AddConsumer(), 4.0);
+  msgs::BatteryStates msg;
+  system.FillMsg(msg);
+  ASSERT_EQ(2, msg.name_size());
+  EXPECT_EQ("a", msg.name(0));
+  EXPECT_EQ("b", msg.name(1));
+  ASSERT_EQ(2, msg.power_load_size());
+  EXPECT_DOUBLE_EQ(0.0, msg.power_load(0));
+  EXPECT_DOUBLE_EQ(4.0, msg.power_load(1));
+
+  EXPECT_TRUE(system.Remove(battery1));
+  EXPECT_FALSE(system.Remove(battery1));
+  EXPECT_EQ(1u, system.Count());
+
+  system.Clear();
+  EXPECT_EQ(0u, system.Count());
+}
+
+//////////////////////////////////////////////////
+TEST_F(BatterySystemTest, World)
+{
+  this->Load("worlds/empty.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+  auto batteries = world->Batteries();
+  ASSERT_NE(nullptr, batteries);
+  EXPECT_EQ(0u, batteries->Count());
+
+  std::ostringstream sdfStr;
+  sdfStr << "<sdf version='" << SDF_VERSION << "'>"
+    << "<model name='robot'>"
+    << "  <static>true</static>"
+    << "  <link name='body'>"
+    << "    <battery name='battery'>"
+    << "      <voltage>12.0</voltage>"
+    << "    </battery>"
+    << "  </link>"
+    << "</model>"
+    << "</sdf>";
+  world->InsertModelString(sdfStr.str());
+
+  int sleep = 0;
+  while (!world->ModelByName("robot") && sleep++ < 100)
+  {
+    world->Step(1);
+    common::Time::MSleep(10);
+  }
+  auto model = world->ModelByName("robot");
+  ASSERT_NE(nullptr, model);
+  EXPECT_EQ(1u, batteries->Count());
+
+  auto battery = model->GetLink("body")->Battery("battery");
+  ASSERT_NE(nullptr, battery);
+  EXPECT_DOUBLE_EQ(12.0, battery->Voltage());
+  battery->SetPowerLoad(battery->AddConsumer(), 2.5);
+
+  // The world updates the battery once per iteration
+  battery->SetUpdateFunc([](const common::BatteryPtr &_battery)
+      {
+        return _battery->Voltage() - 0.1;
+      });
+  world->Step(10);
+  EXPECT_NEAR(11.0, battery->Voltage(), 1e-9);
+
+  transport::NodePtr node(new transport::Node());
+  node->Init();
+  auto sub = node->Subscribe("~/battery_states", &OnBatteryStates);
+
+  // The topic is throttled on wall time, keep stepping until a message
+  // arrives
+  sleep = 0;
+  while (sleep++ < 100)
+  {
+    world->Step(1);
+    common::Time::MSleep(20);
+    std::lock_guard<std::mutex> lock(g_batteryStatesMutex);
+    if (g_batteryStatesCount > 0)
+      break;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(g_batteryStatesMutex);
+    ASSERT_GT(g_batteryStatesCount, 0);
+    ASSERT_EQ(1, g_batteryStatesMsg.name_size());
+    EXPECT_EQ("robot::body::battery", g_batteryStatesMsg.name(0));
+    ASSERT_EQ(1, g_batteryStatesMsg.voltage_size());
+    EXPECT_LT(g_batteryStatesMsg.voltage(0), 11.0);
+    ASSERT_EQ(1, g_batteryStatesMsg.power_load_size());
+    EXPECT_DOUBLE_EQ(2.5, g_batteryStatesMsg.power_load(0));
+  }
+
+  // Removing the model removes its batteries
+  world->RemoveModel("robot");
+  world->Step(1);
+  EXPECT_EQ(0u, batteries->Count());
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -207,6 +207,8 @@ ShapePtr Collision::GetShape() const
 void Collision::SetScale(const ignition::math::Vector3d &_scale)
 {
   this->shape->SetScale(_scale);
+  if (this->link)
+    this->link->InvalidateBoundingBox();
 }
 
 //////////////////////////////////////////////////
@@ -285,6 +287,8 @@ ignition::math::Vector3d Collision::WorldAngularAccel() const
 void Collision::UpdateParameters(sdf::ElementPtr _sdf)
 {
   Entity::UpdateParameters(_sdf);
+  if (this->link)
+    this->link->InvalidateBoundingBox();
 }
 
 //////////////////////////////////////////////////
@@ -334,6 +338,9 @@ void Collision::ProcessMsg(const msgs::Collision &_msg)
     this->shape->ProcessMsg(_msg.geometry());
   }
 
+  if (_msg.has_pose() || _msg.has_geometry())
+    this->link->InvalidateBoundingBox();
+
   if (_msg.has_surface())
   {
     this->link->SetEnabled(true);
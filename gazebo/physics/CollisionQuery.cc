@@ -0,0 +1,1148 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <fcl/BVH_model.h>
+#include <fcl/collision.h>
+#include <fcl/collision_node.h>
+#include <fcl/conservative_advancement.h>
+#include <fcl/geometric_shape_to_BVH_model.h>
+#include <fcl/motion.h>
+#include <fcl/simple_setup.h>
+#include <fcl/traversal_node_bvhs.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include <ignition/math/Helpers.hh>
+#include <ignition/math/Matrix3.hh>
+#include <ignition/math/Quaternion.hh>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/SamplingProfiler.hh"
+#include "gazebo/physics/Collision.hh"
+#include "gazebo/physics/CollisionQuery.hh"
+#include "gazebo/physics/Link.hh"
+#include "gazebo/physics/MeshShape.hh"
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/Shape.hh"
+#include "gazebo/physics/World.hh"
+
+/// \brief Queries keep snapshots coming for this long after the last one.
+static const std::chrono::seconds kIdleTime(1);
+
+/// \brief Longest wait of a query for a snapshot taken after it was made,
+/// after which it's answered from the latest snapshot.
+static const std::chrono::seconds kSnapshotWait(1);
+
+/// \brief Width of the thin triangle that stands for a ray in FCL.
+static const double kRayWidth = 1e-4;
+
+/// \brief Edge length of the boxes that stand for planes.
+static const double kPlaneSize = 1e4;
+
+/// \brief Depth of the boxes that stand for planes.
+static const double kPlaneDepth = 1.0;
+
+/// \brief Number of segments of tessellated spheres and cylinders.
+static const unsigned int kSegments = 32;
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief A collision or query shape, as an FCL triangle model.
+    class CollisionQueryShape
+    {
+      /// \brief Constructor.
+      /// \param[in] _geom Box, cylinder, plane or sphere.
+      public: explicit CollisionQueryShape(const msgs::Geometry &_geom);
+
+      /// \brief Constructor for a triangle mesh.
+      /// \param[in] _vertices Vertices in the frame of the collision.
+      /// \param[in] _indices Vertex indices, three per triangle.
+      public: CollisionQueryShape(
+                  const std::vector<ignition::math::Vector3d> &_vertices,
+                  const std::vector<unsigned int> &_indices);
+
+      /// \brief Get the triangle model, building it on first use. Only
+      /// called from the query thread.
+      /// \return The model.
+      public: fcl::BVHModel<fcl::RSS> &Model();
+
+      /// \brief Check if a point is inside the shape. Always false for
+      /// meshes, which need not be closed.
+      /// \param[in] _p Point in the frame of the shape.
+      /// \return True if the point is inside.
+      public: bool Contains(const ignition::math::Vector3d &_p) const;
+
+      /// \brief Type of the shape, msgs::Geometry::MESH for meshes.
+      public: msgs::Geometry::Type type = msgs::Geometry::MESH;
+
+      /// \brief Size of a box, radius and length of a cylinder in X and Z,
+      /// or radius of a sphere in X.
+      public: ignition::math::Vector3d size;
+
+      /// \brief Pose of the primitive in the frame of the shape. Only
+      /// used to place the box of a plane.
+      public: ignition::math::Pose3d offset;
+
+      /// \brief Mesh vertices.
+      public: std::vector<fcl::Vec3f> vertices;
+
+      /// \brief Mesh triangles.
+      public: std::vector<fcl::Triangle> triangles;
+
+      /// \brief Center of a sphere bounding the shape, in its frame.
+      public: ignition::math::Vector3d center;
+
+      /// \brief Radius of the bounding sphere.
+      public: double radius = 0;
+
+      /// \brief The triangle model.
+      private: fcl::BVHModel<fcl::RSS> model;
+
+      /// \brief True once the model is built.
+      private: bool built = false;
+    };
+
+    /// \internal
+    /// \brief Poses of the collisions at one time step.
+    class CollisionQuerySnapshot
+    {
+      /// \brief Simulation time of the snapshot.
+      public: common::Time time;
+
+      /// \brief Number of the snapshot, increasing by one each time.
+      public: uint64_t stamp = 0;
+
+      /// \brief Scoped names of the collisions.
+      public: std::shared_ptr<const std::vector<std::string>> names;
+
+      /// \brief Shapes of the collisions.
+      public: std::shared_ptr<const std::vector<
+              std::shared_ptr<CollisionQueryShape>>> shapes;
+
+      /// \brief World poses of the collisions.
+      public: std::vector<ignition::math::Pose3d> poses;
+    };
+
+    /// \internal
+    /// \brief A query waiting for its answer.
+    class CollisionQueryJob
+    {
+      /// \brief The query.
+      public: msgs::CollisionQueryRequest request;
+
+      /// \brief Stamp of the first snapshot that may answer the query.
+      public: uint64_t minStamp = 0;
+
+      /// \brief Promise of the answer.
+      public: std::promise<CollisionQueryResult> promise;
+    };
+
+    /// \internal
+    /// \brief Private data for the CollisionQuery class.
+    class CollisionQueryPrivate
+    {
+      /// \brief Answer queries until stopped. Body of the query thread.
+      public: void Run();
+
+      /// \brief Answer a query.
+      /// \param[in] _req The query.
+      /// \param[in] _snapshot Snapshot to answer from.
+      /// \return The answer.
+      public: CollisionQueryResult Answer(
+                  const msgs::CollisionQueryRequest &_req,
+                  const CollisionQuerySnapshot &_snapshot);
+
+      /// \brief Find the first collision crossed by a segment.
+      /// \param[in] _start Start of the segment.
+      /// \param[in] _end End of the segment.
+      /// \param[in] _ignore Scoped name of a model or link to skip.
+      /// \param[in] _snapshot Snapshot to search.
+      /// \param[out] _result Hit found, if any.
+      public: void Ray(const ignition::math::Vector3d &_start,
+                       const ignition::math::Vector3d &_end,
+                       const std::string &_ignore,
+                       const CollisionQuerySnapshot &_snapshot,
+                       CollisionQueryResult &_result);
+
+      /// \brief Find the first collision touched by a moving shape.
+      /// \param[in] _shape The query shape.
+      /// \param[in] _start Start pose of the shape.
+      /// \param[in] _end End pose of the shape.
+      /// \param[in] _ignore Scoped name of a model or link to skip.
+      /// \param[in] _snapshot Snapshot to search.
+      /// \param[out] _result Hit found, if any.
+      public: void Sweep(CollisionQueryShape &_shape,
+                         const ignition::math::Pose3d &_start,
+                         const ignition::math::Pose3d &_end,
+                         const std::string &_ignore,
+                         const CollisionQuerySnapshot &_snapshot,
+                         CollisionQueryResult &_result);
+
+      /// \brief Find all collisions touching a shape.
+      /// \param[in] _shape The query shape.
+      /// \param[in] _pose Pose of the shape.
+      /// \param[in] _ignore Scoped name of a model or link to skip.
+      /// \param[in] _snapshot Snapshot to search.
+      /// \param[out] _result Hits found.
+      public: void Overlap(CollisionQueryShape &_shape,
+                           const ignition::math::Pose3d &_pose,
+                           const std::string &_ignore,
+                           const CollisionQuerySnapshot &_snapshot,
+                           CollisionQueryResult &_result);
+
+      /// \brief Find the collision closest to a shape.
+      /// \param[in] _shape The query shape.
+      /// \param[in] _pose Pose of the shape.
+      /// \param[in] _maxDistance Largest distance searched.
+      /// \param[in] _ignore Scoped name of a model or link to skip.
+      /// \param[in] _snapshot Snapshot to search.
+      /// \param[out] _result Hit found, if any.
+      public: void Closest(CollisionQueryShape &_shape,
+                           const ignition::math::Pose3d &_pose,
+                           const double _maxDistance,
+                           const std::string &_ignore,
+                           const CollisionQuerySnapshot &_snapshot,
+                           CollisionQueryResult &_result);
+
+      /// \brief Stop the query thread and answer the pending queries
+      /// without hits.
+      public: void Stop();
+
+      /// \brief Protects the snapshot and the queue.
+      public: std::mutex mutex;
+
+      /// \brief Signals new queries, new snapshots and stop requests.
+      public: std::condition_variable cond;
+
+      /// \brief Latest snapshot.
+      public: std::shared_ptr<const CollisionQuerySnapshot> snapshot;
+
+      /// \brief Stamp of the latest snapshot.
+      public: uint64_t stamp = 0;
+
+      /// \brief Queries waiting for an answer.
+      public: std::deque<CollisionQueryJob> jobs;
+
+      /// \brief Query thread, started by the first query.
+      public: std::thread thread;
+
+      /// \brief True to stop the query thread.
+      public: bool stop = false;
+
+      /// \brief Steady clock time of the last query, in nanoseconds.
+      public: std::atomic<int64_t> lastQuery{
+              std::numeric_limits<int64_t>::min() / 2};
+
+      /// \brief Protects the state below, used by Update and Clear.
+      public: std::mutex updateMutex;
+
+      /// \brief Collisions of the snapshots, in the order of the shapes.
+      public: std::vector<Collision *> collisions;
+
+      /// \brief Scoped names of the collisions.
+      public: std::shared_ptr<const std::vector<std::string>> names;
+
+      /// \brief Shapes of the collisions.
+      public: std::shared_ptr<const std::vector<
+              std::shared_ptr<CollisionQueryShape>>> shapes;
+
+      /// \brief Shapes by serialized geometry message, kept between
+      /// rebuilds so that unchanged shapes keep their triangle models.
+      public: std::map<std::string, std::shared_ptr<CollisionQueryShape>>
+              shapeCache;
+
+      /// \brief Entity version the collisions were read at.
+      public: uint64_t version = 0;
+
+      /// \brief True once the collisions have been read.
+      public: bool built = false;
+    };
+  }
+}
+
+using namespace gazebo;
+using namespace physics;
+
+/////////////////////////////////////////////////
+/// \brief Get the current steady clock time.
+/// \return Time in nanoseconds.
+static int64_t SteadyNow()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/////////////////////////////////////////////////
+/// \brief Convert a vector to FCL.
+/// \param[in] _v The vector.
+/// \return The FCL vector.
+static fcl::Vec3f ToFcl(const ignition::math::Vector3d &_v)
+{
+  return fcl::Vec3f(_v.X(), _v.Y(), _v.Z());
+}
+
+/////////////////////////////////////////////////
+/// \brief Convert a vector from FCL.
+/// \param[in] _v The FCL vector.
+/// \return The vector.
+static ignition::math::Vector3d FromFcl(const fcl::Vec3f &_v)
+{
+  return ignition::math::Vector3d(_v[0], _v[1], _v[2]);
+}
+
+/////////////////////////////////////////////////
+/// \brief Convert a rotation to the rows of an FCL rotation matrix.
+/// \param[in] _rot The rotation.
+/// \param[out] _r Rows of the matrix.
+static void ToFcl(const ignition::math::Quaterniond &_rot, fcl::Vec3f _r[3])
+{
+  ignition::math::Matrix3d m(_rot);
+  for (int i = 0; i < 3; ++i)
+    _r[i] = fcl::Vec3f(m(i, 0), m(i, 1), m(i, 2));
+}
+
+/////////////////////////////////////////////////
+/// \brief Place an FCL object.
+/// \param[in] _object The object.
+/// \param[in] _pose World pose of the object.
+static void SetPose(fcl::CollisionObject &_object,
+    const ignition::math::Pose3d &_pose)
+{
+  fcl::Vec3f r[3];
+  ToFcl(_pose.Rot(), r);
+  _object.setTransform(r, ToFcl(_pose.Pos()));
+}
+
+/////////////////////////////////////////////////
+/// \brief Check if a collision is skipped by a query.
+/// \param[in] _name Scoped name of the collision.
+/// \param[in] _ignore Scoped name of a model or link, may be empty.
+/// \return True if the collision belongs to the ignored entity.
+static bool Ignored(const std::string &_name, const std::string &_ignore)
+{
+  return !_ignore.empty() && _name.compare(0, _ignore.size(), _ignore) == 0 &&
+      _name.compare(_ignore.size(), 2, "::") == 0;
+}
+
+/////////////////////////////////////////////////
+/// \brief Distance from a point to a segment.
+/// \param[in] _p The point.
+/// \param[in] _a Start of the segment.
+/// \param[in] _b End of the segment.
+/// \return The distance.
+static double SegmentDistance(const ignition::math::Vector3d &_p,
+    const ignition::math::Vector3d &_a, const ignition::math::Vector3d &_b)
+{
+  auto ab = _b - _a;
+  double len2 = ab.SquaredLength();
+  double t = len2 > 0 ? (_p - _a).Dot(ab) / len2 : 0;
+  t = std::max(0.0, std::min(1.0, t));
+  return _p.Distance(_a + ab * t);
+}
+
+/////////////////////////////////////////////////
+/// \brief Intersect a ray with a triangle, Moller-Trumbore.
+/// \param[in] _origin Origin of the ray.
+/// \param[in] _dir Unit direction of the ray.
+/// \param[in] _v0 First vertex.
+/// \param[in] _v1 Second vertex.
+/// \param[in] _v2 Third vertex.
+/// \param[out] _t Distance to the intersection.
+/// \return True if the ray crosses the triangle ahead of its origin.
+static bool RayTriangle(const ignition::math::Vector3d &_origin,
+    const ignition::math::Vector3d &_dir, const ignition::math::Vector3d &_v0,
+    const ignition::math::Vector3d &_v1, const ignition::math::Vector3d &_v2,
+    double &_t)
+{
+  auto e1 = _v1 - _v0;
+  auto e2 = _v2 - _v0;
+  auto p = _dir.Cross(e2);
+  double det = e1.Dot(p);
+  if (std::abs(det) < 1e-12)
+    return false;
+
+  double inv = 1.0 / det;
+  auto s = _origin - _v0;
+  double u = s.Dot(p) * inv;
+  if (u < 0 || u > 1)
+    return false;
+
+  auto q = s.Cross(e1);
+  double v = _dir.Dot(q) * inv;
+  if (v < 0 || u + v > 1)
+    return false;
+
+  _t = e2.Dot(q) * inv;
+  return _t >= 0;
+}
+
+/////////////////////////////////////////////////
+/// \brief Check if two placed shapes touch, including when one is inside
+/// the other.
+/// \param[in] _a First shape.
+/// \param[in] _poseA Pose of the first shape.
+/// \param[in] _b Second shape.
+/// \param[in] _poseB Pose of the second shape.
+/// \return True if the shapes touch.
+static bool Touch(CollisionQueryShape &_a, const ignition::math::Pose3d &_poseA,
+    CollisionQueryShape &_b, const ignition::math::Pose3d &_poseB)
+{
+  auto &modelA = _a.Model();
+  auto &modelB = _b.Model();
+  if (modelA.num_vertices == 0 || modelB.num_vertices == 0)
+    return false;
+
+  SetPose(modelA, _poseA);
+  SetPose(modelB, _poseB);
+  std::vector<fcl::Contact> contacts;
+  if (fcl::collide(&modelA, &modelB, 1, false, false, contacts) > 0)
+    return true;
+
+  // Without crossing surfaces, the shapes touch if one is inside the other
+  auto inA = _poseA.Rot().RotateVectorReverse(
+      _poseB.CoordPositionAdd(FromFcl(modelB.vertices[0])) - _poseA.Pos());
+  auto inB = _poseB.Rot().RotateVectorReverse(
+      _poseA.CoordPositionAdd(FromFcl(modelA.vertices[0])) - _poseB.Pos());
+  return _a.Contains(inA) || _b.Contains(inB);
+}
+
+/////////////////////////////////////////////////
+/// \brief Find the closest points of two placed shapes that don't touch.
+/// \param[in] _a First shape.
+/// \param[in] _poseA Pose of the first shape.
+/// \param[in] _b Second shape.
+/// \param[in] _poseB Pose of the second shape.
+/// \param[out] _pointA Closest point on the first shape, in world
+/// coordinates.
+/// \param[out] _pointB Closest point on the second shape, in world
+/// coordinates.
+/// \return Distance between the shapes.
+static double ClosestPoints(CollisionQueryShape &_a,
+    const ignition::math::Pose3d &_poseA, CollisionQueryShape &_b,
+    const ignition::math::Pose3d &_poseB, ignition::math::Vector3d &_pointA,
+    ignition::math::Vector3d &_pointB)
+{
+  auto &modelA = _a.Model();
+  auto &modelB = _b.Model();
+  SetPose(modelA, _poseA);
+  SetPose(modelB, _poseB);
+
+  fcl::MeshDistanceTraversalNodeRSS node;
+  if (!fcl::initialize(node, modelA, modelB))
+    return std::numeric_limits<double>::max();
+  fcl::distance(&node);
+
+  // The points are given in the frame of each model
+  _pointA = _poseA.CoordPositionAdd(FromFcl(node.p1));
+  _pointB = _poseB.CoordPositionAdd(FromFcl(node.p2));
+  return node.min_distance;
+}
+
+/////////////////////////////////////////////////
+CollisionQueryShape::CollisionQueryShape(const msgs::Geometry &_geom)
+  : type(_geom.type())
+{
+  switch (this->type)
+  {
+    case msgs::Geometry::BOX:
+      this->size = msgs::ConvertIgn(_geom.box().size());
+      this->radius = this->size.Length() * 0.5;
+      break;
+    case msgs::Geometry::CYLINDER:
+      this->size.Set(_geom.cylinder().radius(), 0, _geom.cylinder().length());
+      this->radius = std::hypot(this->size.X(), this->size.Z() * 0.5);
+      break;
+    case msgs::Geometry::SPHERE:
+      this->size.Set(_geom.sphere().radius(), 0, 0);
+      this->radius = this->size.X();
+      break;
+    case msgs::Geometry::PLANE:
+    {
+      // A box whose top face lies on the plane
+      auto normal = msgs::ConvertIgn(_geom.plane().normal()).Normalize();
+      this->type = msgs::Geometry::BOX;
+      this->size.Set(kPlaneSize, kPlaneSize, kPlaneDepth);
+      this->offset.Pos() = -normal * kPlaneDepth * 0.5;
+      this->offset.Rot().From2Axes(ignition::math::Vector3d::UnitZ, normal);
+      this->center = this->offset.Pos();
+      this->radius = this->size.Length() * 0.5;
+      break;
+    }
+    default:
+      // Not supported, leave the model empty
+      this->radius = -1;
+      break;
+  }
+}
+
+/////////////////////////////////////////////////
+CollisionQueryShape::CollisionQueryShape(
+    const std::vector<ignition::math::Vector3d> &_vertices,
+    const std::vector<unsigned int> &_indices)
+{
+  ignition::math::Vector3d min(ignition::math::MAX_D, ignition::math::MAX_D,
+      ignition::math::MAX_D);
+  ignition::math::Vector3d max = -min;
+  this->vertices.reserve(_vertices.size());
+  for (auto const &v : _vertices)
+  {
+    this->vertices.push_back(ToFcl(v));
+    min.Min(v);
+    max.Max(v);
+  }
+
+  this->triangles.reserve(_indices.size() / 3);
+  for (size_t i = 0; i + 2 < _indices.size(); i += 3)
+  {
+    this->triangles.push_back(
+        fcl::Triangle(_indices[i], _indices[i + 1], _indices[i + 2]));
+  }
+
+  if (this->triangles.empty())
+  {
+    this->radius = -1;
+    return;
+  }
+
+  this->center = (min + max) * 0.5;
+  for (auto const &v : _vertices)
+    this->radius = std::max(this->radius, v.Distance(this->center));
+}
+
+/////////////////////////////////////////////////
+fcl::BVHModel<fcl::RSS> &CollisionQueryShape::Model()
+{
+  if (this->built)
+    return this->model;
+  this->built = true;
+
+  switch (this->type)
+  {
+    case msgs::Geometry::BOX:
+    {
+      fcl::Box box(this->size.X(), this->size.Y(), this->size.Z());
+      fcl::Vec3f r[3];
+      ToFcl(this->offset.Rot(), r);
+      box.setLocalTransform(r, ToFcl(this->offset.Pos()));
+      fcl::generateBVHModel(this->model, box);
+      break;
+    }
+    case msgs::Geometry::CYLINDER:
+      fcl::generateBVHModel(this->model,
+          fcl::Cylinder(this->size.X(), this->size.Z()), kSegments);
+      break;
+    case msgs::Geometry::SPHERE:
+      fcl::generateBVHModel(this->model, fcl::Sphere(this->size.X()),
+          kSegments, kSegments);
+      break;
+    case msgs::Geometry::MESH:
+      if (!this->triangles.empty())
+      {
+        this->model.beginModel(this->triangles.size(),
+            this->vertices.size());
+        this->model.addSubModel(this->vertices, this->triangles);
+        this->model.endModel();
+      }
+      break;
+    default:
+      break;
+  }
+
+  return this->model;
+}
+
+/////////////////////////////////////////////////
+bool CollisionQueryShape::Contains(const ignition::math::Vector3d &_p) const
+{
+  auto p = this->offset.Rot().RotateVectorReverse(_p - this->offset.Pos());
+  switch (this->type)
+  {
+    case msgs::Geometry::BOX:
+      return std::abs(p.X()) <= this->size.X() * 0.5 &&
+          std::abs(p.Y()) <= this->size.Y() * 0.5 &&
+          std::abs(p.Z()) <= this->size.Z() * 0.5;
+    case msgs::Geometry::CYLINDER:
+      return std::hypot(p.X(), p.Y()) <= this->size.X() &&
+          std::abs(p.Z()) <= this->size.Z() * 0.5;
+    case msgs::Geometry::SPHERE:
+      return p.Length() <= this->size.X();
+    default:
+      return false;
+  }
+}
+
+/////////////////////////////////////////////////
+void CollisionQueryPrivate::Run()
+{
+  common::SetThreadName("CollisionQuery");
+
+  std::unique_lock<std::mutex> lock(this->mutex);
+  while (true)
+  {
+    this->cond.wait(lock, [this]
+        {
+          return this->stop || !this->jobs.empty();
+        });
+    if (this->stop)
+      break;
+
+    // Wait for a snapshot taken after the query was made
+    const uint64_t minStamp = this->jobs.front().minStamp;
+    this->cond.wait_for(lock, kSnapshotWait, [this, minStamp]
+        {
+          return this->stop || this->stamp >= minStamp;
+        });
+    if (this->stop)
+      break;
+
+    auto snap = this->snapshot;
+    auto job = std::move(this->jobs.front());
+    this->jobs.pop_front();
+    lock.unlock();
+
+    CollisionQueryResult result;
+    if (snap)
+      result = this->Answer(job.request, *snap);
+    job.promise.set_value(result);
+
+    lock.lock();
+  }
+}
+
+/////////////////////////////////////////////////
+CollisionQueryResult CollisionQueryPrivate::Answer(
+    const msgs::CollisionQueryRequest &_req,
+    const CollisionQuerySnapshot &_snapshot)
+{
+  CollisionQueryResult result;
+  result.time = _snapshot.time;
+
+  if (_req.type() == msgs::CollisionQueryRequest::RAY)
+  {
+    if (!_req.has_start() || !_req.has_end())
+    {
+      gzerr << "Ray query without a start and an end\n";
+      return result;
+    }
+    this->Ray(msgs::ConvertIgn(_req.start()), msgs::ConvertIgn(_req.end()),
+        _req.ignore(), _snapshot, result);
+    return result;
+  }
+
+  if (!_req.has_shape() || !_req.has_pose())
+  {
+    gzerr << "Collision query without a shape and a pose\n";
+    return result;
+  }
+
+  auto const type = _req.shape().type();
+  if (type != msgs::Geometry::BOX && type != msgs::Geometry::CYLINDER &&
+      type != msgs::Geometry::SPHERE)
+  {
+    gzerr << "Collision queries only take boxes, cylinders and spheres\n";
+    return result;
+  }
+
+  CollisionQueryShape shape(_req.shape());
+  auto pose = msgs::ConvertIgn(_req.pose());
+  switch (_req.type())
+  {
+    case msgs::CollisionQueryRequest::SWEEP:
+      if (!_req.has_end_pose())
+      {
+        gzerr << "Sweep query without an end pose\n";
+        break;
+      }
+      this->Sweep(shape, pose, msgs::ConvertIgn(_req.end_pose()),
+          _req.ignore(), _snapshot, result);
+      break;
+    case msgs::CollisionQueryRequest::OVERLAP:
+      this->Overlap(shape, pose, _req.ignore(), _snapshot, result);
+      break;
+    case msgs::CollisionQueryRequest::CLOSEST:
+      this->Closest(shape, pose, _req.max_distance(), _req.ignore(),
+          _snapshot, result);
+      break;
+    default:
+      break;
+  }
+
+  return result;
+}
+
+/////////////////////////////////////////////////
+void CollisionQueryPrivate::Ray(const ignition::math::Vector3d &_start,
+    const ignition::math::Vector3d &_end, const std::string &_ignore,
+    const CollisionQuerySnapshot &_snapshot, CollisionQueryResult &_result)
+{
+  auto dir = _end - _start;
+  const double length = dir.Length();
+  if (length <= 0)
+    return;
+  dir /= length;
+
+  // FCL has no rays, a thin triangle along the ray finds the candidate
+  // triangles of each model, which are then intersected exactly.
+  auto side = dir.Cross(ignition::math::Vector3d::UnitZ);
+  if (side.SquaredLength() < 1e-6)
+    side = dir.Cross(ignition::math::Vector3d::UnitX);
+  side = side.Normalize() * kRayWidth;
+
+  fcl::BVHModel<fcl::RSS> ray;
+  std::vector<fcl::Vec3f> points = {ToFcl(_start), ToFcl(_end),
+      ToFcl(_end + side)};
+  std::vector<fcl::Triangle> triangles = {fcl::Triangle(0, 1, 2)};
+  ray.beginModel(1, 3);
+  ray.addSubModel(points, triangles);
+  ray.endModel();
+  SetPose(ray, ignition::math::Pose3d::Zero);
+
+  const auto &names = *_snapshot.names;
+  const auto &shapes = *_snapshot.shapes;
+  double best = length;
+  std::vector<fcl::Contact> contacts;
+  for (size_t i = 0; i < shapes.size(); ++i)
+  {
+    auto &shape = *shapes[i];
+    const auto &pose = _snapshot.poses[i];
+    if (shape.radius < 0 || Ignored(names[i], _ignore) ||
+        SegmentDistance(pose.CoordPositionAdd(shape.center), _start, _end) >
+        shape.radius)
+    {
+      continue;
+    }
+
+    auto &model = shape.Model();
+    SetPose(model, pose);
+    contacts.clear();
+    if (fcl::collide(&ray, &model, 1, true, false, contacts) == 0)
+      continue;
+
+    for (auto const &contact : contacts)
+    {
+      const fcl::Triangle &tri = model.tri_indices[contact.b2];
+      auto v0 = pose.CoordPositionAdd(FromFcl(model.vertices[tri[0]]));
+      auto v1 = pose.CoordPositionAdd(FromFcl(model.vertices[tri[1]]));
+      auto v2 = pose.CoordPositionAdd(FromFcl(model.vertices[tri[2]]));
+      double t;
+      if (!RayTriangle(_start, dir, v0, v1, v2, t) || t > best)
+        continue;
+
+      auto normal = (v1 - v0).Cross(v2 - v0).Normalize();
+      if (normal.Dot(dir) > 0)
+        normal = -normal;
+
+      best = t;
+      _result.hits.resize(1);
+      _result.hits[0].collision = names[i];
+      _result.hits[0].point = _start + dir * t;
+      _result.hits[0].normal = normal;
+      _result.hits[0].distance = t;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void CollisionQueryPrivate::Sweep(CollisionQueryShape &_shape,
+    const ignition::math::Pose3d &_start, const ignition::math::Pose3d &_end,
+    const std::string &_ignore, const CollisionQuerySnapshot &_snapshot,
+    CollisionQueryResult &_result)
+{
+  const auto &names = *_snapshot.names;
+  const auto &shapes = *_snapshot.shapes;
+  auto &query = _shape.Model();
+
+  fcl::Vec3f startRot[3];
+  fcl::Vec3f endRot[3];
+  ToFcl(_start.Rot(), startRot);
+  ToFcl(_end.Rot(), endRot);
+
+  double bestToc = 2;
+  size_t best = 0;
+  std::vector<fcl::Contact> contacts;
+  for (size_t i = 0; i < shapes.size() && bestToc > 0; ++i)
+  {
+    auto &shape = *shapes[i];
+    const auto &pose = _snapshot.poses[i];
+    if (shape.radius < 0 || Ignored(names[i], _ignore) ||
+        SegmentDistance(pose.CoordPositionAdd(shape.center),
+          _start.CoordPositionAdd(_shape.center),
+          _end.CoordPositionAdd(_shape.center)) >
+        shape.radius + _shape.radius)
+    {
+      continue;
+    }
+
+    if (Touch(_shape, _start, shape, pose))
+    {
+      bestToc = 0;
+      best = i;
+      break;
+    }
+
+    auto &model = shape.Model();
+    fcl::Vec3f rot[3];
+    ToFcl(pose.Rot(), rot);
+    fcl::InterpMotion<fcl::RSS> queryMotion(startRot, ToFcl(_start.Pos()),
+        endRot, ToFcl(_end.Pos()));
+    fcl::InterpMotion<fcl::RSS> motion(rot, ToFcl(pose.Pos()), rot,
+        ToFcl(pose.Pos()));
+
+    fcl::BVH_REAL toc = 1;
+    contacts.clear();
+    if (fcl::conservativeAdvancement<fcl::RSS>(&query, &queryMotion, &model,
+          &motion, 1, false, false, contacts, toc) > 0 && toc < bestToc)
+    {
+      bestToc = toc;
+      best = i;
+    }
+  }
+
+  if (bestToc > 1)
+    return;
+
+  ignition::math::Pose3d pose(
+      _start.Pos() + (_end.Pos() - _start.Pos()) * bestToc,
+      ignition::math::Quaterniond::Slerp(bestToc, _start.Rot(), _end.Rot(),
+        true));
+
+  CollisionQueryHit hit;
+  hit.collision = names[best];
+  hit.distance = _start.Pos().Distance(pose.Pos());
+
+  ignition::math::Vector3d queryPoint;
+  ClosestPoints(_shape, pose, *shapes[best], _snapshot.poses[best],
+      queryPoint, hit.point);
+  hit.normal = queryPoint - hit.point;
+  if (hit.normal.SquaredLength() < 1e-12)
+    hit.normal = _start.Pos() - _end.Pos();
+  hit.normal.Normalize();
+  _result.hits.push_back(hit);
+}
+
+/////////////////////////////////////////////////
+void CollisionQueryPrivate::Overlap(CollisionQueryShape &_shape,
+    const ignition::math::Pose3d &_pose, const std::string &_ignore,
+    const CollisionQuerySnapshot &_snapshot, CollisionQueryResult &_result)
+{
+  const auto &names = *_snapshot.names;
+  const auto &shapes = *_snapshot.shapes;
+  auto center = _pose.CoordPositionAdd(_shape.center);
+  for (size_t i = 0; i < shapes.size(); ++i)
+  {
+    auto &shape = *shapes[i];
+    const auto &pose = _snapshot.poses[i];
+    if (shape.radius < 0 || Ignored(names[i], _ignore) ||
+        center.Distance(pose.CoordPositionAdd(shape.center)) >
+        shape.radius + _shape.radius)
+    {
+      continue;
+    }
+
+    if (Touch(_shape, _pose, shape, pose))
+    {
+      CollisionQueryHit hit;
+      hit.collision = names[i];
+      _result.hits.push_back(hit);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void CollisionQueryPrivate::Closest(CollisionQueryShape &_shape,
+    const ignition::math::Pose3d &_pose, const double _maxDistance,
+    const std::string &_ignore, const CollisionQuerySnapshot &_snapshot,
+    CollisionQueryResult &_result)
+{
+  const auto &names = *_snapshot.names;
+  const auto &shapes = *_snapshot.shapes;
+  auto center = _pose.CoordPositionAdd(_shape.center);
+  double best = _maxDistance;
+  for (size_t i = 0; i < shapes.size(); ++i)
+  {
+    auto &shape = *shapes[i];
+    const auto &pose = _snapshot.poses[i];
+    if (shape.radius < 0 || Ignored(names[i], _ignore) ||
+        center.Distance(pose.CoordPositionAdd(shape.center)) -
+        shape.radius - _shape.radius > best)
+    {
+      continue;
+    }
+
+    CollisionQueryHit hit;
+    hit.collision = names[i];
+    if (Touch(_shape, _pose, shape, pose))
+    {
+      hit.point = center;
+      hit.normal = center - pose.CoordPositionAdd(shape.center);
+      if (hit.normal.SquaredLength() < 1e-12)
+        hit.normal = ignition::math::Vector3d::UnitZ;
+      hit.normal.Normalize();
+    }
+    else
+    {
+      ignition::math::Vector3d queryPoint;
+      hit.distance = ClosestPoints(_shape, _pose, shape, pose, queryPoint,
+          hit.point);
+      if (hit.distance > best)
+        continue;
+      hit.normal = (queryPoint - hit.point).Normalize();
+    }
+
+    best = hit.distance;
+    _result.hits.assign(1, hit);
+    if (best <= 0)
+      break;
+  }
+}
+
+/////////////////////////////////////////////////
+void CollisionQueryPrivate::Stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->stop = true;
+  }
+  this->cond.notify_all();
+  if (this->thread.joinable())
+    this->thread.join();
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+  for (auto &job : this->jobs)
+    job.promise.set_value(CollisionQueryResult());
+  this->jobs.clear();
+  this->snapshot.reset();
+  this->stop = false;
+}
+
+/////////////////////////////////////////////////
+CollisionQuery::CollisionQuery()
+  : dataPtr(new CollisionQueryPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+CollisionQuery::~CollisionQuery()
+{
+  this->dataPtr->Stop();
+}
+
+/////////////////////////////////////////////////
+std::future<CollisionQueryResult> CollisionQuery::Query(
+    const msgs::CollisionQueryRequest &_req)
+{
+  CollisionQueryJob job;
+  job.request = _req;
+  auto future = job.promise.get_future();
+
+  this->dataPtr->lastQuery = SteadyNow();
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (!this->dataPtr->thread.joinable())
+    {
+      this->dataPtr->thread =
+          std::thread(&CollisionQueryPrivate::Run, this->dataPtr.get());
+    }
+    job.minStamp = this->dataPtr->stamp + 1;
+    this->dataPtr->jobs.push_back(std::move(job));
+  }
+  this->dataPtr->cond.notify_all();
+
+  return future;
+}
+
+/////////////////////////////////////////////////
+std::future<CollisionQueryResult> CollisionQuery::Ray(
+    const ignition::math::Vector3d &_start,
+    const ignition::math::Vector3d &_end, const std::string &_ignore)
+{
+  msgs::CollisionQueryRequest req;
+  req.set_type(msgs::CollisionQueryRequest::RAY);
+  msgs::Set(req.mutable_start(), _start);
+  msgs::Set(req.mutable_end(), _end);
+  req.set_ignore(_ignore);
+  return this->Query(req);
+}
+
+/////////////////////////////////////////////////
+std::future<CollisionQueryResult> CollisionQuery::Sweep(
+    const msgs::Geometry &_shape, const ignition::math::Pose3d &_start,
+    const ignition::math::Pose3d &_end, const std::string &_ignore)
+{
+  msgs::CollisionQueryRequest req;
+  req.set_type(msgs::CollisionQueryRequest::SWEEP);
+  req.mutable_shape()->CopyFrom(_shape);
+  msgs::Set(req.mutable_pose(), _start);
+  msgs::Set(req.mutable_end_pose(), _end);
+  req.set_ignore(_ignore);
+  return this->Query(req);
+}
+
+/////////////////////////////////////////////////
+std::future<CollisionQueryResult> CollisionQuery::Overlap(
+    const msgs::Geometry &_shape, const ignition::math::Pose3d &_pose,
+    const std::string &_ignore)
+{
+  msgs::CollisionQueryRequest req;
+  req.set_type(msgs::CollisionQueryRequest::OVERLAP);
+  req.mutable_shape()->CopyFrom(_shape);
+  msgs::Set(req.mutable_pose(), _pose);
+  req.set_ignore(_ignore);
+  return this->Query(req);
+}
+
+/////////////////////////////////////////////////
+std::future<CollisionQueryResult> CollisionQuery::Closest(
+    const msgs::Geometry &_shape, const ignition::math::Pose3d &_pose,
+    const double _maxDistance, const std::string &_ignore)
+{
+  msgs::CollisionQueryRequest req;
+  req.set_type(msgs::CollisionQueryRequest::CLOSEST);
+  req.mutable_shape()->CopyFrom(_shape);
+  msgs::Set(req.mutable_pose(), _pose);
+  req.set_max_distance(_maxDistance);
+  req.set_ignore(_ignore);
+  return this->Query(req);
+}
+
+/////////////////////////////////////////////////
+bool CollisionQuery::Active() const
+{
+  return SteadyNow() - this->dataPtr->lastQuery <
+      std::chrono::duration_cast<std::chrono::nanoseconds>(kIdleTime).count();
+}
+
+/////////////////////////////////////////////////
+void CollisionQuery::Update(const WorldPtr &_world,
+    const uint64_t _entityVersion)
+{
+  if (!this->Active())
+    return;
+
+  std::lock_guard<std::mutex> updateLock(this->dataPtr->updateMutex);
+
+  // Read the collisions and their shapes again when entities changed.
+  // Shapes are shared by collisions with the same geometry.
+  if (!this->dataPtr->built || this->dataPtr->version != _entityVersion)
+  {
+    std::map<std::string, std::shared_ptr<CollisionQueryShape>> cache;
+    auto names = std::make_shared<std::vector<std::string>>();
+    auto shapes = std::make_shared<
+        std::vector<std::shared_ptr<CollisionQueryShape>>>();
+    this->dataPtr->collisions.clear();
+
+    std::vector<ModelPtr> models = _world->Models();
+    while (!models.empty())
+    {
+      ModelPtr model = models.back();
+      models.pop_back();
+      for (auto const &nested : model->NestedModels())
+        models.push_back(nested);
+
+      for (auto const &link : model->GetLinks())
+      {
+        for (auto const &collision : link->GetCollisions())
+        {
+          ShapePtr shapePtr = collision->GetShape();
+          if (!shapePtr || !(shapePtr->HasType(Base::BOX_SHAPE) ||
+              shapePtr->HasType(Base::CYLINDER_SHAPE) ||
+              shapePtr->HasType(Base::MESH_SHAPE) ||
+              shapePtr->HasType(Base::PLANE_SHAPE) ||
+              shapePtr->HasType(Base::SPHERE_SHAPE)))
+          {
+            continue;
+          }
+
+          msgs::Geometry geom;
+          shapePtr->FillMsg(geom);
+          std::string key = geom.SerializeAsString();
+
+          auto &shape = cache[key];
+          auto cached = this->dataPtr->shapeCache.find(key);
+          if (!shape && cached != this->dataPtr->shapeCache.end())
+            shape = cached->second;
+          if (!shape)
+          {
+            auto mesh = boost::dynamic_pointer_cast<MeshShape>(shapePtr);
+            if (mesh)
+            {
+              std::vector<ignition::math::Vector3d> vertices;
+              std::vector<unsigned int> indices;
+              mesh->Triangles(vertices, indices);
+              shape = std::make_shared<CollisionQueryShape>(vertices,
+                  indices);
+            }
+            else
+            {
+              shape = std::make_shared<CollisionQueryShape>(geom);
+            }
+          }
+
+          this->dataPtr->collisions.push_back(collision.get());
+          names->push_back(collision->GetScopedName());
+          shapes->push_back(shape);
+        }
+      }
+    }
+
+    this->dataPtr->shapeCache.swap(cache);
+    this->dataPtr->names = names;
+    this->dataPtr->shapes = shapes;
+    this->dataPtr->version = _entityVersion;
+    this->dataPtr->built = true;
+  }
+
+  auto snap = std::make_shared<CollisionQuerySnapshot>();
+  snap->time = _world->SimTime();
+  snap->names = this->dataPtr->names;
+  snap->shapes = this->dataPtr->shapes;
+  snap->poses.reserve(this->dataPtr->collisions.size());
+  for (auto const &collision : this->dataPtr->collisions)
+    snap->poses.push_back(collision->WorldPose());
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    snap->stamp = ++this->dataPtr->stamp;
+    this->dataPtr->snapshot = snap;
+  }
+  this->dataPtr->cond.notify_all();
+}
+
+/////////////////////////////////////////////////
+void CollisionQuery::Clear()
+{
+  this->dataPtr->Stop();
+
+  std::lock_guard<std::mutex> updateLock(this->dataPtr->updateMutex);
+  this->dataPtr->collisions.clear();
+  this->dataPtr->names.reset();
+  this->dataPtr->shapes.reset();
+  this->dataPtr->shapeCache.clear();
+  this->dataPtr->built = false;
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_COLLISIONQUERY_HH_
+#define GAZEBO_PHYSICS_COLLISIONQUERY_HH_
+
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    // Forward declare private data class
+    class CollisionQueryPrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \brief A collision found by a CollisionQuery.
+    struct CollisionQueryHit
+    {
+      /// \brief Scoped name of the collision.
+      std::string collision;
+
+      /// \brief Point on the collision, in world coordinates. Zero for
+      /// overlap queries.
+      ignition::math::Vector3d point;
+
+      /// \brief Unit normal of the collision at the point, pointing
+      /// towards the ray or the query shape. Zero for overlap queries.
+      ignition::math::Vector3d normal;
+
+      /// \brief Distance along the ray or the sweep, or separation of a
+      /// closest query.
+      double distance = 0;
+    };
+
+    /// \brief Answer to a CollisionQuery.
+    struct CollisionQueryResult
+    {
+      /// \brief Simulation time of the snapshot the query was answered
+      /// from. Zero if there was no snapshot.
+      common::Time time;
+
+      /// \brief Collisions found. At most one, except for overlap queries.
+      std::vector<CollisionQueryHit> hits;
+    };
+
+    /// \class CollisionQuery CollisionQuery.hh physics/physics.hh
+    /// \brief Read only ray, sweep, overlap and closest point queries
+    /// against the collisions of a world, answered on a thread of their
+    /// own so that planners and AI agents don't stall the world update.
+    ///
+    /// The world update thread copies the pose of every collision into a
+    /// snapshot from World::ProcessMessages, but only while queries are
+    /// being made. A query is answered from the first snapshot taken after
+    /// it was made, so its answer is consistent with a single time step.
+    ///
+    /// Collision shapes are turned into FCL triangle models: spheres and
+    /// cylinders are tessellated, planes are large boxes, and heightmaps
+    /// and polylines are skipped. Shapes are only read again when entities
+    /// are added to or removed from the world. Query shapes can be boxes,
+    /// spheres or cylinders.
+    class GZ_PHYSICS_VISIBLE CollisionQuery
+    {
+      /// \brief Constructor.
+      public: CollisionQuery();
+
+      /// \brief Destructor. Stops the query thread.
+      public: ~CollisionQuery();
+
+      /// \brief Answer a query given as a message. The other queries are
+      /// shortcuts for this one.
+      /// \param[in] _req The query.
+      /// \return Future answer. Malformed queries are answered without
+      /// hits.
+      public: std::future<CollisionQueryResult> Query(
+                  const msgs::CollisionQueryRequest &_req);
+
+      /// \brief Find the first collision crossed by a line segment.
+      /// \param[in] _start Start of the segment in world coordinates.
+      /// \param[in] _end End of the segment in world coordinates.
+      /// \param[in] _ignore Scoped name of a model or link to skip.
+      /// \return Future answer.
+      public: std::future<CollisionQueryResult> Ray(
+                  const ignition::math::Vector3d &_start,
+                  const ignition::math::Vector3d &_end,
+                  const std::string &_ignore = "");
+
+      /// \brief Find the first collision touched by a shape moving in a
+      /// straight line, while its orientation is interpolated.
+      /// \param[in] _shape Box, sphere or cylinder.
+      /// \param[in] _start Start pose of the shape.
+      /// \param[in] _end End pose of the shape.
+      /// \param[in] _ignore Scoped name of a model or link to skip.
+      /// \return Future answer.
+      public: std::future<CollisionQueryResult> Sweep(
+                  const msgs::Geometry &_shape,
+                  const ignition::math::Pose3d &_start,
+                  const ignition::math::Pose3d &_end,
+                  const std::string &_ignore = "");
+
+      /// \brief Find all collisions touching a shape.
+      /// \param[in] _shape Box, sphere or cylinder.
+      /// \param[in] _pose Pose of the shape.
+      /// \param[in] _ignore Scoped name of a model or link to skip.
+      /// \return Future answer.
+      public: std::future<CollisionQueryResult> Overlap(
+                  const msgs::Geometry &_shape,
+                  const ignition::math::Pose3d &_pose,
+                  const std::string &_ignore = "");
+
+      /// \brief Find the collision closest to a shape.
+      /// \param[in] _shape Box, sphere or cylinder.
+      /// \param[in] _pose Pose of the shape.
+      /// \param[in] _maxDistance Largest distance searched.
+      /// \param[in] _ignore Scoped name of a model or link to skip.
+      /// \return Future answer.
+      public: std::future<CollisionQueryResult> Closest(
+                  const msgs::Geometry &_shape,
+                  const ignition::math::Pose3d &_pose,
+                  const double _maxDistance,
+                  const std::string &_ignore = "");
+
+      /// \brief Check if queries were made recently, in which case Update
+      /// takes snapshots.
+      /// \return True if queries are pending or were made in the last
+      /// second.
+      public: bool Active() const;
+
+      /// \brief Take a snapshot of the collision poses if the queries are
+      /// active. Must be called from the world update thread.
+      /// \param[in] _world World the collisions belong to.
+      /// \param[in] _entityVersion Counter that changes whenever an entity
+      /// is added to or removed from the world. The collisions and their
+      /// shapes are read again when it differs from the value of the last
+      /// snapshot.
+      public: void Update(const WorldPtr &_world,
+                          const uint64_t _entityVersion);
+
+      /// \brief Drop the snapshot and answer the pending queries without
+      /// hits.
+      public: void Clear();
+
+      /// \internal
+      /// \brief Pointer to private data.
+      private: std::unique_ptr<CollisionQueryPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -147,6 +147,12 @@ std::string Contact::DebugString() const
 
 //////////////////////////////////////////////////
 void Contact::FillMsg(msgs::Contact &_msg) const
+{
+  this->FillMsg(_msg, true);
+}
+
+/////////////////////////////////////////////////
+void Contact::FillMsg(msgs::Contact &_msg, const bool _wrenches) const
 {
   _msg.set_world(this->world->Name());
   _msg.set_collision1(this->collision1->GetScopedName());
@@ -160,6 +166,9 @@ void Contact::FillMsg(msgs::Contact &_msg) const
     msgs::Set(_msg.add_position(), this->positions[j]);
     msgs::Set(_msg.add_normal(), this->normals[j]);
 
+    if (!_wrenches)
+      continue;
+
     msgs::JointWrench *jntWrench = _msg.add_wrench();
     jntWrench->set_body_1_name(this->collision1->GetScopedName());
     jntWrench->set_body_1_id(this->collision1->GetId());
@@ -71,6 +71,12 @@ namespace gazebo
       /// \param[out] _msg Contact message the will hold the data.
       public: void FillMsg(msgs::Contact &_msg) const;
 
+      /// \brief Populate a msgs::Contact with data from this.
+      /// \param[out] _msg Contact message the will hold the data.
+      /// \param[in] _wrenches False to leave out the wrenches, which are
+      /// the largest part of the message.
+      public: void FillMsg(msgs::Contact &_msg, const bool _wrenches) const;
+
       /// \brief Produce a debug string.
       /// \return A string that contains the values of the contact.
       public: std::string DebugString() const;
@@ -14,6 +14,8 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+
 #include <boost/algorithm/string.hpp>
 
 #include "gazebo/transport/Node.hh"
@@ -62,6 +64,8 @@ ContactManager::~ContactManager()
     }
   }
   this->customContactPublishers.clear();
+  this->collisionPublishers.clear();
+  this->unresolvedPublishers.clear();
   delete this->customMutex;
   this->customMutex = NULL;
 
@@ -76,8 +80,34 @@ void ContactManager::Init(WorldPtr _world)
   this->node = transport::NodePtr(new transport::Node());
   this->node->Init(this->world->Name());
 
-  this->contactPub =
-    this->node->Advertise<msgs::Contacts>("~/physics/contacts", 50);
+  this->contactPub = this->node->Advertise<msgs::Contacts>(
+      "~/physics/contacts", 50, this->publishRate);
+}
+
+/////////////////////////////////////////////////
+void ContactManager::SetPublishRate(const double _hz)
+{
+  this->publishRate = std::max(_hz, 0.0);
+  if (this->contactPub)
+    this->contactPub->SetUpdateRate(this->publishRate);
+}
+
+/////////////////////////////////////////////////
+double ContactManager::PublishRate() const
+{
+  return this->publishRate;
+}
+
+/////////////////////////////////////////////////
+void ContactManager::SetPublishWrenches(const bool _wrenches)
+{
+  this->publishWrenches = _wrenches;
+}
+
+/////////////////////////////////////////////////
+bool ContactManager::PublishWrenches() const
+{
+  return this->publishWrenches;
 }
 
 /////////////////////////////////////////////////
@@ -99,41 +129,31 @@ bool ContactManager::SubscribersConnected(Collision *_collision1,
   if (this->contactPub->HasConnections()) return true;
 
   boost::recursive_mutex::scoped_lock lock(*this->customMutex);
-  boost::unordered_map<std::string, ContactPublisher *>::const_iterator iter;
-  for (iter = this->customContactPublishers.begin();
-       iter != this->customContactPublishers.end(); ++iter)
+
+  // A model can simply be loaded later, so check the collisionNames as well.
+  for (auto const publisher : this->unresolvedPublishers)
   {
-    // A model can simply be loaded later, so check the collisionNames as well.
-    if (!iter->second->collisionNames.empty())
+    for (auto const &name : publisher->collisionNames)
     {
-      std::vector<std::string>::const_iterator it;
-      for (it = iter->second->collisionNames.begin();
-           it != iter->second->collisionNames.end(); ++it)
+      BasePtr b = this->world->BaseByName(name);
+      if (b)
       {
-        BasePtr b = this->world->BaseByName(*it);
-        if (b)
-        {
-          return true;
-        }
-        // We could do the same transformation which is done in
-        // GetCustomPublishers() here (insert collisions which now have been
-        // loaded), but this would remove the const qualifier of this function.
-        // It would however speed up repeated calls of this function without
-        // a call of NewContact() or GetCustomPublishers() in between.
+        return true;
       }
-    }
-
-    // only reason _collision1 or _collision1 cannot be const parameters
-    // is that compiler can't find const pointers in unordered set
-    if (iter->second->collisions.find(_collision1) !=
-        iter->second->collisions.end() ||
-        iter->second->collisions.find(_collision2) !=
-        iter->second->collisions.end())
-    {
-      return true;
+      // We could do the same transformation which is done in
+      // GetCustomPublishers() here (insert collisions which now have been
+      // loaded), but this would remove the const qualifier of this function.
+      // It would however speed up repeated calls of this function without
+      // a call of NewContact() or GetCustomPublishers() in between.
     }
   }
-  return false;
+
+  // only reason _collision1 or _collision1 cannot be const parameters
+  // is that compiler can't find const pointers in unordered map
+  return this->collisionPublishers.find(_collision1) !=
+      this->collisionPublishers.end() ||
+      this->collisionPublishers.find(_collision2) !=
+      this->collisionPublishers.end();
 }
 
 /////////////////////////////////////////////////
@@ -142,47 +162,95 @@ void ContactManager::GetCustomPublishers(Collision *_collision1,
                      std::vector<ContactPublisher*> &_publishers)
 {
   boost::recursive_mutex::scoped_lock lock(*this->customMutex);
-  boost::unordered_map<std::string, ContactPublisher *>::iterator iter;
-  for (iter = this->customContactPublishers.begin();
-       iter != this->customContactPublishers.end(); ++iter)
+
+  // A model can simply be loaded later, so convert ones that are not yet
+  // found
+  for (auto pubIter = this->unresolvedPublishers.begin();
+       pubIter != this->unresolvedPublishers.end();)
   {
-    // A model can simply be loaded later, so convert ones that are not yet
-    // found
-    if (!iter->second->collisionNames.empty())
+    ContactPublisher *publisher = *pubIter;
+    for (auto it = publisher->collisionNames.begin();
+        it != publisher->collisionNames.end();)
     {
-      std::vector<std::string>::iterator it;
-      for (it = iter->second->collisionNames.begin();
-          it != iter->second->collisionNames.end();)
+      Collision *col = boost::dynamic_pointer_cast<Collision>(
+          this->world->BaseByName(*it)).get();
+      if (!col)
       {
-        Collision *col = boost::dynamic_pointer_cast<Collision>(
-            this->world->BaseByName(*it)).get();
-        if (!col)
-        {
-          ++it;
-          continue;
-        }
-        it = iter->second->collisionNames.erase(it);
-        iter->second->collisions.insert(col);
+        ++it;
+        continue;
       }
+      it = publisher->collisionNames.erase(it);
+      this->AddCollisionPublisher(col, publisher);
     }
 
-    // only reason _collision1 or _collision1 cannot be const parameters
-    // is that compiler can't find const pointers in unordered set
-    if (iter->second->collisions.find(_collision1) !=
-        iter->second->collisions.end() ||
-        iter->second->collisions.find(_collision2) !=
-        iter->second->collisions.end())
+    if (publisher->collisionNames.empty())
+      pubIter = this->unresolvedPublishers.erase(pubIter);
+    else
+      ++pubIter;
+  }
+
+  // Each collision leads straight to the publishers monitoring it
+  auto iter1 = this->collisionPublishers.find(_collision1);
+  auto iter2 = _collision2 == _collision1 ? this->collisionPublishers.end() :
+      this->collisionPublishers.find(_collision2);
+  const size_t first = _publishers.size();
+  for (auto iter : {iter1, iter2})
+  {
+    if (iter == this->collisionPublishers.end())
+      continue;
+
+    for (auto const publisher : iter->second)
     {
-      GZ_ASSERT(iter->second->publisher != NULL,
+      GZ_ASSERT(publisher->publisher != NULL,
                 "ContactPublisher must have a valid publisher");
-      if (!_getOnlyConnected || iter->second->publisher->HasConnections())
+      if (_getOnlyConnected && !publisher->publisher->HasConnections())
+        continue;
+
+      // A publisher monitoring both collisions only gets the contact once
+      if (iter == iter2 && iter1 != this->collisionPublishers.end() &&
+          std::find(_publishers.begin() + first, _publishers.end(),
+            publisher) != _publishers.end())
       {
-        _publishers.push_back(iter->second);
+        continue;
       }
+      _publishers.push_back(publisher);
     }
   }
 }
 
+/////////////////////////////////////////////////
+void ContactManager::AddCollisionPublisher(Collision *_collision,
+    ContactPublisher *_publisher)
+{
+  if (!_publisher->collisions.insert(_collision).second)
+    return;
+
+  this->collisionPublishers[_collision].push_back(_publisher);
+}
+
+/////////////////////////////////////////////////
+void ContactManager::RemoveCollisionPublisher(ContactPublisher *_publisher)
+{
+  for (auto const col : _publisher->collisions)
+  {
+    auto iter = this->collisionPublishers.find(col);
+    if (iter == this->collisionPublishers.end())
+      continue;
+
+    auto &publishers = iter->second;
+    publishers.erase(
+        std::remove(publishers.begin(), publishers.end(), _publisher),
+        publishers.end());
+    if (publishers.empty())
+      this->collisionPublishers.erase(iter);
+  }
+
+  this->unresolvedPublishers.erase(
+      std::remove(this->unresolvedPublishers.begin(),
+        this->unresolvedPublishers.end(), _publisher),
+      this->unresolvedPublishers.end());
+}
+
 /////////////////////////////////////////////////
 Contact *ContactManager::NewContact(Collision *_collision1,
                                     Collision *_collision2,
@@ -198,7 +266,8 @@ Contact *ContactManager::NewContact(Collision *_collision1,
   // This is a signal to the Physics engine that it can skip the extra
   // processing necessary to get back contact information.
 
-  std::vector<ContactPublisher *> publishers;
+  std::vector<ContactPublisher *> &publishers = this->publishersScratch;
+  publishers.clear();
   bool getOnlyConnected = false;
   // TODO check: getOnlyConnected set to false to keep same behaviour as before.
   // But should we not only add publishers which are connected, as is done
@@ -298,18 +367,20 @@ void ContactManager::PublishContacts()
   // publish to default topic, ~/physics/contacts
   if (!transport::getMinimalComms())
   {
-    msgs::Contacts msg;
-    for (unsigned int i = 0; i < this->contactIndex; ++i)
-    {
-      if (this->contacts[i]->count == 0)
-        continue;
+    this->contactPub->PublishIfSubscribed(this->contactsMsg,
+        [this](msgs::Contacts &_msg)
+        {
+          for (unsigned int i = 0; i < this->contactIndex; ++i)
+          {
+            if (this->contacts[i]->count == 0)
+              continue;
 
-      msgs::Contact *contactMsg = msg.add_contact();
-      this->contacts[i]->FillMsg(*contactMsg);
-    }
+            msgs::Contact *contactMsg = _msg.add_contact();
+            this->contacts[i]->FillMsg(*contactMsg, this->publishWrenches);
+          }
 
-    msgs::Set(msg.mutable_time(), this->world->SimTime());
-    this->contactPub->Publish(msg);
+          msgs::Set(_msg.mutable_time(), this->world->SimTime());
+        });
   }
 
   // publish to other custom topics
@@ -319,18 +390,20 @@ void ContactManager::PublishContacts()
       iter != this->customContactPublishers.end(); ++iter)
   {
     ContactPublisher *contactPublisher = iter->second;
-    msgs::Contacts msg2;
-    for (unsigned int j = 0;
-        j < contactPublisher->contacts.size(); ++j)
-    {
-      if (contactPublisher->contacts[j]->count == 0)
-        continue;
-
-      msgs::Contact *contactMsg = msg2.add_contact();
-      contactPublisher->contacts[j]->FillMsg(*contactMsg);
-    }
-    msgs::Set(msg2.mutable_time(), this->world->SimTime());
-    contactPublisher->publisher->Publish(msg2);
+    contactPublisher->publisher->PublishIfSubscribed(contactPublisher->msg,
+        [this, contactPublisher](msgs::Contacts &_msg)
+        {
+          for (unsigned int j = 0;
+              j < contactPublisher->contacts.size(); ++j)
+          {
+            if (contactPublisher->contacts[j]->count == 0)
+              continue;
+
+            msgs::Contact *contactMsg = _msg.add_contact();
+            contactPublisher->contacts[j]->FillMsg(*contactMsg);
+          }
+          msgs::Set(_msg.mutable_time(), this->world->SimTime());
+        });
     contactPublisher->contacts.clear();
   }
 }
@@ -364,16 +437,17 @@ std::string ContactManager::CreateFilter(const std::string &_name,
   ContactPublisher *contactPublisher = new ContactPublisher;
   contactPublisher->publisher = this->node->Advertise<msgs::Contacts>(topic);
 
-  std::map<std::string, physics::CollisionPtr>::const_iterator iter;
-  for (iter = _collisions.begin(); iter != _collisions.end(); ++iter)
-  {
-    Collision *col = iter->second.get();
-    if (col)
-      contactPublisher->collisions.insert(col);
-  }
-
   {
     boost::recursive_mutex::scoped_lock lock(*this->customMutex);
+
+    std::map<std::string, physics::CollisionPtr>::const_iterator iter;
+    for (iter = _collisions.begin(); iter != _collisions.end(); ++iter)
+    {
+      Collision *col = iter->second.get();
+      if (col)
+        this->AddCollisionPublisher(col, contactPublisher);
+    }
+
     this->customContactPublishers[name] = contactPublisher;
   }
 
@@ -418,7 +492,10 @@ std::string ContactManager::CreateFilter(const std::string &_name,
         "Failed to create a custom filter");
 
     // Let it know about collisions not yet found.
-    this->customContactPublishers[name]->collisionNames = collisionNames;
+    ContactPublisher *contactPublisher = this->customContactPublishers[name];
+    contactPublisher->collisionNames = collisionNames;
+    if (!collisionNames.empty())
+      this->unresolvedPublishers.push_back(contactPublisher);
   }
 
   return topic;
@@ -436,6 +513,7 @@ void ContactManager::RemoveFilter(const std::string &_name)
   if (iter != customContactPublishers.end())
   {
     ContactPublisher *contactPublisher = iter->second;
+    this->RemoveCollisionPublisher(contactPublisher);
     contactPublisher->contacts.clear();
     contactPublisher->collisionNames.clear();
     contactPublisher->collisions.clear();
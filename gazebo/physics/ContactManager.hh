@@ -44,6 +44,9 @@ namespace gazebo
       /// \brief Contact message publisher
       public: transport::PublisherPtr publisher;
 
+      /// \brief Message reused from one publication to the next.
+      public: msgs::Contacts msg;
+
       /// \brief Pointers of collisions monitored by contact manager for
       /// contacts.
       public: boost::unordered_set<Collision *> collisions;
@@ -117,6 +120,28 @@ namespace gazebo
       /// If SetNeverDropContacts() was never called, this will return false.
       public: bool NeverDropContacts() const;
 
+      /// \brief Set the maximum rate of ~/physics/contacts. Contact
+      /// messages are not built at all between two publications, which
+      /// helps with large contact sets. The topics of filters are not
+      /// affected.
+      /// \param[in] _hz Rate in Hz, zero for no limit (default).
+      public: void SetPublishRate(const double _hz);
+
+      /// \brief Get the maximum rate of ~/physics/contacts.
+      /// \return Rate in Hz, zero for no limit.
+      public: double PublishRate() const;
+
+      /// \brief Set whether ~/physics/contacts carries the contact
+      /// wrenches. Subscribers such as the contact visualization only
+      /// need positions, normals and depths. The topics of filters always
+      /// carry the wrenches.
+      /// \param[in] _wrenches True to publish the wrenches (default).
+      public: void SetPublishWrenches(const bool _wrenches);
+
+      /// \brief Get whether ~/physics/contacts carries the wrenches.
+      /// \return True if the wrenches are published.
+      public: bool PublishWrenches() const;
+
       /// \brief Returns true if any subscribers are connected
       /// which would be interested in contact details of either collision
       /// \e _collision1 or \e collision2, given that they have been loaded
@@ -215,16 +240,40 @@ namespace gazebo
                        Collision *_collision2, const bool _getOnlyConnected,
                        std::vector<ContactPublisher*> &_publishers);
 
+      /// \brief Route contacts of a collision to a custom publisher.
+      /// \param[in] _collision Collision monitored by the publisher.
+      /// \param[in] _publisher The custom publisher.
+      private: void AddCollisionPublisher(Collision *_collision,
+                   ContactPublisher *_publisher);
+
+      /// \brief Stop routing contacts to a custom publisher.
+      /// \param[in] _publisher The custom publisher.
+      private: void RemoveCollisionPublisher(ContactPublisher *_publisher);
+
       private: std::vector<Contact*> contacts;
 
       private: unsigned int contactIndex;
 
+      /// \brief Scratch list of publishers used by NewContact, kept to
+      /// avoid an allocation per contact.
+      private: std::vector<ContactPublisher *> publishersScratch;
+
       /// \brief Node for communication.
       private: transport::NodePtr node;
 
       /// \brief Contact publisher.
       private: transport::PublisherPtr contactPub;
 
+      /// \brief Message of contactPub, reused from one publication to the
+      /// next.
+      private: msgs::Contacts contactsMsg;
+
+      /// \brief Maximum rate of contactPub, zero for no limit.
+      private: double publishRate = 0;
+
+      /// \brief True if contactPub carries the wrenches.
+      private: bool publishWrenches = true;
+
       /// \brief Pointer to the world.
       private: WorldPtr world;
 
@@ -233,6 +282,15 @@ namespace gazebo
       private: boost::unordered_map<std::string, ContactPublisher *>
           customContactPublishers;
 
+      /// \brief Custom publishers monitoring each collision, so that a new
+      /// contact is routed without visiting every filter.
+      private: boost::unordered_map<Collision *,
+          std::vector<ContactPublisher *>> collisionPublishers;
+
+      /// \brief Custom publishers with collision names that were not
+      /// loaded yet when their filter was created.
+      private: std::vector<ContactPublisher *> unresolvedPublishers;
+
       /// \brief Mutex to protect the list of custom publishers.
       private: boost::recursive_mutex *customMutex;
 
@@ -194,6 +194,91 @@ TEST_F(ContactManagerTest, NeverDropContacts)
   }
 }
 
+/////////////////////////////////////////////////
+TEST_F(ContactManagerTest, FilterRouting)
+{
+  Load("test/worlds/box.world", true);
+
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  physics::PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != nullptr);
+
+  physics::ContactManager *manager = physics->GetContactManager();
+  ASSERT_TRUE(manager != nullptr);
+
+  // Without a filter on the box contacts are dropped
+  world->Step(1);
+  EXPECT_EQ(manager->GetContactCount(), 0u);
+
+  // A filter on the box collision, plus one on a collision that is not
+  // loaded, is enough to keep the contacts between box and ground
+  std::vector<std::string> collisions;
+  collisions.push_back("box::link::collision");
+  collisions.push_back("not_loaded::link::collision");
+  EXPECT_FALSE(manager->CreateFilter("box_filter", collisions).empty());
+
+  world->Step(1);
+  unsigned int numContacts = manager->GetContactCount();
+  ASSERT_GT(numContacts, 0u);
+  for (unsigned int i = 0; i < numContacts; ++i)
+  {
+    physics::Contact *contact = manager->GetContact(i);
+    ASSERT_TRUE(contact != nullptr);
+    EXPECT_TRUE(manager->SubscribersConnected(
+          contact->collision1, contact->collision2));
+    EXPECT_TRUE(manager->SubscribersConnected(
+          contact->collision2, contact->collision1));
+  }
+
+  // Removing the filter drops the contacts again
+  manager->RemoveFilter("box_filter");
+  world->Step(1);
+  EXPECT_EQ(manager->GetContactCount(), 0u);
+}
+
+/////////////////////////////////////////////////
+TEST_F(ContactManagerTest, PublishOptions)
+{
+  Load("test/worlds/box.world", true);
+
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  physics::ContactManager *manager = world->Physics()->GetContactManager();
+  ASSERT_TRUE(manager != nullptr);
+
+  EXPECT_DOUBLE_EQ(0.0, manager->PublishRate());
+  manager->SetPublishRate(30);
+  EXPECT_DOUBLE_EQ(30.0, manager->PublishRate());
+  manager->SetPublishRate(-1);
+  EXPECT_DOUBLE_EQ(0.0, manager->PublishRate());
+
+  EXPECT_TRUE(manager->PublishWrenches());
+  manager->SetPublishWrenches(false);
+  EXPECT_FALSE(manager->PublishWrenches());
+
+  manager->SetNeverDropContacts(true);
+  world->Step(1);
+  ASSERT_GT(manager->GetContactCount(), 0u);
+  physics::Contact *contact = manager->GetContact(0);
+  ASSERT_TRUE(contact != nullptr);
+  ASSERT_GT(contact->count, 0);
+
+  // Wrenches are only filled on request
+  msgs::Contact msg;
+  contact->FillMsg(msg, false);
+  EXPECT_EQ(contact->count, msg.position_size());
+  EXPECT_EQ(contact->count, msg.depth_size());
+  EXPECT_EQ(0, msg.wrench_size());
+
+  msg.Clear();
+  contact->FillMsg(msg);
+  EXPECT_EQ(contact->count, msg.wrench_size());
+}
+
+/////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -37,6 +37,7 @@
 #include "gazebo/physics/Link.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/PhysicsEngine.hh"
+#include "gazebo/physics/SleepManager.hh"
 #include "gazebo/physics/Entity.hh"
 
 using namespace gazebo;
@@ -232,7 +233,13 @@ void Entity::PublishPose()
   GZ_ASSERT(this->GetParentModel() != NULL,
       "An entity without a parent model should not happen");
 
-  this->world->PublishModelPose(this->GetParentModel());
+  // The pose of a non-canonical link relative to its model is independent of
+  // its siblings, so only the link itself needs to be published. Any other
+  // entity moves the whole model.
+  if (this->HasType(LINK) && !this->IsCanonicalLink())
+    this->world->_AddDirtyPoseLink(this);
+  else
+    this->world->PublishModelPose(this->GetParentModel());
 }
 
 //////////////////////////////////////////////////
@@ -490,6 +497,14 @@ void Entity::SetWorldPose(const ignition::math::Pose3d &_pose,
   }
   if (_publish)
     this->PublishPose();
+
+  // Poses set from outside of the physics update wake the model up.
+  if (_notify)
+  {
+    SleepManagerPtr sleepManager = this->world->SleepMgr();
+    if (sleepManager && sleepManager->Enabled())
+      sleepManager->Wake(this);
+  }
 }
 
 //////////////////////////////////////////////////
@@ -617,6 +632,10 @@ void Entity::Fini()
     delete this->visualMsg;
   this->visualMsg = NULL;
 
+  // Make sure the world doesn't publish the pose of a deleted link.
+  if (this->world && this->HasType(LINK))
+    this->world->_RemoveDirtyPoseLink(this);
+
   this->parentEntity.reset();
 
   Base::Fini();
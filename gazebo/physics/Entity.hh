@@ -51,6 +51,9 @@ namespace gazebo
     /// \brief Base class for all physics objects in Gazebo.
     class GZ_PHYSICS_VISIBLE Entity : public Base
     {
+      /// \brief World::SetModelPoses moves many models under one lock.
+      friend class World;
+
       /// \brief Constructor.
       /// \param[in] _parent Parent of the entity.
       public: explicit Entity(BasePtr _parent);
@@ -16,13 +16,16 @@
 */
 #include <algorithm>
 #include <cmath>
+#include <limits>
 #include <string>
+#include <vector>
 #include <ignition/math/Helpers.hh>
 #include <gazebo/gazebo_config.h>
 
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Image.hh"
+#include "gazebo/common/MemoryAccount.hh"
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/SphericalCoordinates.hh"
 #include "gazebo/physics/HeightmapShape.hh"
@@ -42,12 +45,18 @@ HeightmapShape::HeightmapShape(CollisionPtr _parent)
       std::is_same<HeightType, double>::value,
       "Height field needs to be double or float");
   this->vertSize = 0;
+  this->collisionSubSampling = 2;
+  this->collisionDecimation = 1;
+  this->tilingSupported = false;
   this->AddType(Base::HEIGHTMAP_SHAPE);
 }
 
 //////////////////////////////////////////////////
 HeightmapShape::~HeightmapShape()
 {
+  common::MemoryAccount::Get("physics/heightmaps")->Add(
+      -this->accountedBytes);
+
   this->requestSub.reset();
   this->responsePub.reset();
   if (this->node)
@@ -192,6 +201,67 @@ void HeightmapShape::Load(sdf::ElementPtr _sdf)
     }
   }
 
+  // The collision lookup table uses the visual sampling unless told
+  // otherwise. Values below one keep one vertex out of 1/s.
+  this->collisionSubSampling = this->subSampling;
+  this->collisionDecimation = 1;
+  {
+    const std::string kElementName = "ignition:collision_sampling";
+    if (this->sdf->HasElement(kElementName))
+    {
+      const double s = this->sdf->Get<double>(kElementName);
+      const double level = s >= 1.0 ? s : (s > 0.0 ? 1.0 / s : 0.0);
+      const unsigned int n =
+          static_cast<unsigned int>(std::round(level));
+      if (n == 0u || n & (n - 1u) ||
+          !ignition::math::equal(level, static_cast<double>(n), 1e-6))
+      {
+        gzerr << "Heightmap collision sampling value must be a power of 2. "
+              << "The visual sampling will be used instead." << std::endl;
+      }
+      else if (s >= 1.0)
+      {
+        this->collisionSubSampling = static_cast<int>(n);
+      }
+      else
+      {
+        this->collisionSubSampling = 1;
+        this->collisionDecimation = static_cast<int>(n);
+      }
+    }
+  }
+
+  this->tileSize = 0;
+  {
+    const std::string kElementName = "ignition:collision_tile_size";
+    if (this->sdf->HasElement(kElementName))
+    {
+      const int t = this->sdf->Get<int>(kElementName);
+      if (t < 0 || (t & (t - 1)))
+      {
+        gzerr << "Heightmap collision tile size must be a power of 2. "
+              << "The heights will not be tiled." << std::endl;
+      }
+      else if (t > 0 && !this->tilingSupported)
+      {
+        gzwarn << "The physics engine does not support tiled heightmaps. "
+               << "The heights will not be tiled." << std::endl;
+      }
+      else
+      {
+        this->tileSize = static_cast<unsigned int>(t);
+      }
+    }
+  }
+  {
+    const std::string kElementName = "ignition:collision_tile_cache";
+    if (this->sdf->HasElement(kElementName))
+    {
+      this->tileCacheSize = static_cast<unsigned int>(
+          std::max(1, this->sdf->Get<int>(kElementName)));
+    }
+  }
+
   // Check if the geometry of the terrain data matches Ogre constrains
   if (this->heightmapData->GetWidth() != this->heightmapData->GetHeight() ||
       !ignition::math::isPowerOfTwo(this->heightmapData->GetWidth() - 1))
@@ -207,19 +277,114 @@ int HeightmapShape::GetSubSampling() const
   return this->subSampling;
 }
 
+//////////////////////////////////////////////////
+double HeightmapShape::CollisionSampling() const
+{
+  return static_cast<double>(this->collisionSubSampling) /
+      this->collisionDecimation;
+}
+
+//////////////////////////////////////////////////
+bool HeightmapShape::Tiled() const
+{
+  return this->tileSize > 0;
+}
+
+//////////////////////////////////////////////////
+unsigned int HeightmapShape::TileSize() const
+{
+  return this->tileSize;
+}
+
+//////////////////////////////////////////////////
+unsigned int HeightmapShape::ResidentTileCount() const
+{
+  std::lock_guard<std::mutex> lock(this->tileMutex);
+  return static_cast<unsigned int>(this->tiles.size());
+}
+
+//////////////////////////////////////////////////
+void HeightmapShape::FillRegion(const unsigned int _x, const unsigned int _y,
+    const unsigned int _width, const unsigned int _height,
+    std::vector<float> &_heights) const
+{
+  if (this->collisionDecimation <= 1)
+  {
+    this->heightmapData->FillHeightMapRegion(this->collisionSubSampling,
+        this->vertSize, this->Size(), this->scale, this->flipY,
+        _x, _y, _width, _height, _heights);
+    return;
+  }
+
+  // Keep every n-th vertex of the data, the heightmap data may read it
+  // from a coarser level of detail.
+  const unsigned int step = this->collisionDecimation;
+  this->heightmapData->FillDecimatedHeightMapRegion(1,
+      this->heightmapData->GetWidth(), this->Size(), this->scale,
+      this->flipY, _x * step, _y * step, _width, _height, step, _heights);
+}
+
+//////////////////////////////////////////////////
+std::vector<HeightmapShape::HeightType> &HeightmapShape::Tile(
+    const unsigned int _tx, const unsigned int _ty) const
+{
+  const int64_t key = static_cast<int64_t>(_ty) * this->tileCount + _tx;
+  if (key == this->lastTileKey)
+    return *this->lastTile;
+
+  auto iter = this->tiles.find(key);
+  if (iter != this->tiles.end())
+  {
+    this->tileLru.splice(this->tileLru.begin(), this->tileLru,
+        iter->second.lru);
+  }
+  else
+  {
+    // Drop the least recently used tile
+    if (this->tiles.size() >= this->tileCacheSize)
+    {
+      this->tiles.erase(this->tileLru.back());
+      this->tileLru.pop_back();
+    }
+
+    const unsigned int x = _tx * this->tileSize;
+    const unsigned int y = _ty * this->tileSize;
+    iter = this->tiles.emplace(key, TileData()).first;
+    this->FillRegion(x, y, std::min(this->tileSize, this->vertSize - x),
+        std::min(this->tileSize, this->vertSize - y), iter->second.heights);
+    this->tileLru.push_front(key);
+    iter->second.lru = this->tileLru.begin();
+    this->AccountMemory();
+  }
+
+  this->lastTileKey = key;
+  this->lastTile = &iter->second.heights;
+  return iter->second.heights;
+}
+
+//////////////////////////////////////////////////
+void HeightmapShape::AccountMemory() const
+{
+  int64_t bytes = this->heights.capacity() * sizeof(HeightType);
+  for (auto const &tile : this->tiles)
+    bytes += tile.second.heights.capacity() * sizeof(HeightType);
+
+  common::MemoryAccount::Get("physics/heightmaps")->Add(
+      bytes - this->accountedBytes);
+  this->accountedBytes = bytes;
+}
+
 //////////////////////////////////////////////////
 void HeightmapShape::FillHeightfield(std::vector<float>& _heights)
 {
-  this->heightmapData->FillHeightMap(this->subSampling, this->vertSize,
-      this->Size(), this->scale, this->flipY, _heights);
+  this->FillRegion(0, 0, this->vertSize, this->vertSize, _heights);
 }
 
 //////////////////////////////////////////////////
 void HeightmapShape::FillHeightfield(std::vector<double>& _heights)
 {
   std::vector<float> fHeights;
-  this->heightmapData->FillHeightMap(this->subSampling, this->vertSize,
-      this->Size(), this->scale, this->flipY, fHeights);
+  this->FillHeightfield(fHeights);
   _heights = std::vector<double>(fHeights.begin(), fHeights.end());
 }
 
@@ -235,9 +400,14 @@ void HeightmapShape::Init()
 
   ignition::math::Vector3d terrainSize = this->Size();
 
+  // Keep at least two vertices along each side
+  this->collisionDecimation = std::min(this->collisionDecimation,
+      static_cast<int>(this->heightmapData->GetWidth()) - 1);
+
   // sampling size along image width and height
-  this->vertSize = (this->heightmapData->GetWidth() * this->subSampling)
-      - this->subSampling + 1;
+  this->vertSize = (this->heightmapData->GetWidth() *
+      this->collisionSubSampling) - this->collisionSubSampling + 1;
+  this->vertSize = (this->vertSize - 1) / this->collisionDecimation + 1;
   this->scale.X() = terrainSize.X() / this->vertSize;
   this->scale.Y() = terrainSize.Y() / this->vertSize;
 
@@ -256,8 +426,38 @@ void HeightmapShape::Init()
   else
     this->scale.Z() = fabs(terrainSize.Z()) / heightmapSizeZ;
 
-  // Construct the heightmap lookup table
-  this->FillHeightfield(this->heights);
+  if (this->tileSize >= this->vertSize)
+    this->tileSize = 0;
+
+  if (!this->Tiled())
+  {
+    // Construct the heightmap lookup table
+    this->FillHeightfield(this->heights);
+    this->AccountMemory();
+    return;
+  }
+
+  // Only the extreme heights are kept, the tiles are filled when the
+  // physics engine reads them.
+  this->heights.clear();
+  this->tileCount = (this->vertSize + this->tileSize - 1) / this->tileSize;
+  this->tiledMinHeight = std::numeric_limits<HeightType>::max();
+  this->tiledMaxHeight = -std::numeric_limits<HeightType>::max();
+  std::vector<float> region;
+  for (unsigned int y = 0; y < this->vertSize; y += this->tileSize)
+  {
+    for (unsigned int x = 0; x < this->vertSize; x += this->tileSize)
+    {
+      this->FillRegion(x, y, std::min(this->tileSize, this->vertSize - x),
+          std::min(this->tileSize, this->vertSize - y), region);
+      for (const auto h : region)
+      {
+        this->tiledMinHeight = std::min(this->tiledMinHeight, h);
+        this->tiledMaxHeight = std::max(this->tiledMaxHeight, h);
+      }
+    }
+  }
+  this->AccountMemory();
 }
 
 //////////////////////////////////////////////////
@@ -309,8 +509,8 @@ void HeightmapShape::FillHeights(msgs::Geometry &_msg) const
   {
     for (unsigned int x = 0; x < this->vertSize; ++x)
     {
-      int index = (this->vertSize - y - 1) * this->vertSize + x;
-      _msg.mutable_heightmap()->add_heights(this->heights[index]);
+      _msg.mutable_heightmap()->add_heights(
+          this->GetHeight(x, this->vertSize - y - 1));
     }
   }
 }
@@ -330,6 +530,24 @@ ignition::math::Vector2i HeightmapShape::VertexCount() const
 /////////////////////////////////////////////////
 HeightmapShape::HeightType HeightmapShape::GetHeight(int _x, int _y) const
 {
+  if (this->Tiled())
+  {
+    if (_x < 0 || _y < 0 || _x >= static_cast<int>(this->vertSize) ||
+        _y >= static_cast<int>(this->vertSize))
+    {
+      return 0.0;
+    }
+
+    const unsigned int tx = _x / this->tileSize;
+    const unsigned int ty = _y / this->tileSize;
+    const unsigned int width =
+        std::min(this->tileSize, this->vertSize - tx * this->tileSize);
+
+    std::lock_guard<std::mutex> lock(this->tileMutex);
+    return this->Tile(tx, ty)[(_y - ty * this->tileSize) * width +
+        (_x - tx * this->tileSize)];
+  }
+
   int index =  _y * this->vertSize + _x;
   if (_x < 0 || _y < 0 || index >= static_cast<int>(this->heights.size()))
     return 0.0;
@@ -340,6 +558,28 @@ HeightmapShape::HeightType HeightmapShape::GetHeight(int _x, int _y) const
 /////////////////////////////////////////////////
 void HeightmapShape::SetHeight(int _x, int _y, HeightmapShape::HeightType _h)
 {
+  if (this->Tiled())
+  {
+    if (_x < 0 || _y < 0 || _x >= static_cast<int>(this->vertSize) ||
+        _y >= static_cast<int>(this->vertSize))
+    {
+      gzerr << "SetHeight position (" << _x << ", " << _y << ")"
+            << " is out of bounds" << std::endl;
+      return;
+    }
+
+    // The height only lasts as long as its tile stays in memory
+    const unsigned int tx = _x / this->tileSize;
+    const unsigned int ty = _y / this->tileSize;
+    const unsigned int width =
+        std::min(this->tileSize, this->vertSize - tx * this->tileSize);
+
+    std::lock_guard<std::mutex> lock(this->tileMutex);
+    this->Tile(tx, ty)[(_y - ty * this->tileSize) * width +
+        (_x - tx * this->tileSize)] = _h;
+    return;
+  }
+
   int index =  _y * this->vertSize + _x;
   if (_x < 0 || _y < 0 || index >= static_cast<int>(this->heights.size()))
   {
@@ -354,6 +594,9 @@ void HeightmapShape::SetHeight(int _x, int _y, HeightmapShape::HeightType _h)
 /////////////////////////////////////////////////
 HeightmapShape::HeightType HeightmapShape::GetMaxHeight() const
 {
+  if (this->Tiled())
+    return this->tiledMaxHeight;
+
   HeightType max = -std::numeric_limits<HeightType>::max();
   for (unsigned int i = 0; i < this->heights.size(); ++i)
   {
@@ -367,6 +610,9 @@ HeightmapShape::HeightType HeightmapShape::GetMaxHeight() const
 /////////////////////////////////////////////////
 HeightmapShape::HeightType HeightmapShape::GetMinHeight() const
 {
+  if (this->Tiled())
+    return this->tiledMinHeight;
+
   HeightType min = std::numeric_limits<HeightType>::max();
   for (unsigned int i = 0; i < this->heights.size(); ++i)
   {
@@ -387,7 +633,7 @@ common::Image HeightmapShape::GetImage() const
   double minHeight = this->GetMinHeight();
   double maxHeight = this->GetMaxHeight() - minHeight;
 
-  int size = (this->vertSize+1) / this->subSampling;
+  int size = (this->vertSize - 1) / this->collisionSubSampling + 1;
 
   // Create the image data buffer
   imageData = new unsigned char[size * size];
@@ -397,13 +643,13 @@ common::Image HeightmapShape::GetImage() const
   {
     for (uint16_t x = 0; x < size; ++x)
     {
-      int sx = static_cast<int>(x * this->subSampling);
+      int sx = static_cast<int>(x * this->collisionSubSampling);
       int sy;
 
       if (!this->flipY)
-        sy = static_cast<int>(y * this->subSampling);
+        sy = static_cast<int>(y * this->collisionSubSampling);
       else
-        sy = static_cast<int>(size - 1 -y) * this->subSampling;
+        sy = static_cast<int>(size - 1 -y) * this->collisionSubSampling;
 
       // Normalize height value
       height = (this->GetHeight(sx, sy) - minHeight) / maxHeight;
@@ -17,7 +17,11 @@
 #ifndef GAZEBO_PHYSICS_HEIGHTMAPSHAPE_HH_
 #define GAZEBO_PHYSICS_HEIGHTMAPSHAPE_HH_
 
+#include <cstdint>
+#include <list>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <ignition/transport/Node.hh>
 
@@ -42,6 +46,14 @@ namespace gazebo
     /// \brief HeightmapShape collision shape builds a heightmap from
     /// an image.  The supplied image must be square with
     /// N*N+1 pixels per side, where N is an integer.
+    ///
+    /// Physics engines that read the heights through GetHeight can keep
+    /// the lookup table in tiles, set with <ignition:collision_tile_size>.
+    /// Tiles are filled from the terrain data the first time one of their
+    /// heights is read, and the least recently used ones are dropped once
+    /// there are more than <ignition:collision_tile_cache> of them. Memory
+    /// then depends on the area that bodies and rays touch rather than on
+    /// the size of the terrain.
     class GZ_PHYSICS_VISIBLE HeightmapShape : public Shape
     {
       /// \brief height field type, float or double
@@ -124,6 +136,26 @@ namespace gazebo
       /// \return Amount of subsampling.
       public: int GetSubSampling() const;
 
+      /// \brief Get the sampling of the collision height lookup table. It
+      /// is the visual sampling unless the
+      /// <ignition:collision_sampling> element is set. Values below one
+      /// mean that only one data point out of 1/sampling is kept along
+      /// each side.
+      /// \return Collision sampling, a power of 2.
+      public: double CollisionSampling() const;
+
+      /// \brief Get whether the lookup table is kept in tiles.
+      /// \return True if the heights are streamed in tiles.
+      public: bool Tiled() const;
+
+      /// \brief Get the number of vertices along the side of a tile.
+      /// \return Side of a tile, or 0 if the lookup table isn't tiled.
+      public: unsigned int TileSize() const;
+
+      /// \brief Get the number of tiles currently in memory.
+      /// \return Number of tiles.
+      public: unsigned int ResidentTileCount() const;
+
       /// \brief Return an image representation of the heightmap.
       /// \return Image where white pixels represents the highest locations,
       /// and black pixels the lowest.
@@ -149,6 +181,28 @@ namespace gazebo
       /// \brief Version of FillHeightfield() for double vectors.
       public: void FillHeightfield(std::vector<double>& heights);
 
+      /// \brief Fill a rectangular region of the lookup table.
+      /// \param[in] _x First column of the region.
+      /// \param[in] _y First row of the region.
+      /// \param[in] _width Number of columns of the region.
+      /// \param[in] _height Number of rows of the region.
+      /// \param[out] _heights Heights of the region, row by row.
+      private: void FillRegion(const unsigned int _x, const unsigned int _y,
+                   const unsigned int _width, const unsigned int _height,
+                   std::vector<float> &_heights) const;
+
+      /// \brief Get a tile of the lookup table, filling it if needed. The
+      /// tile mutex must be locked.
+      /// \param[in] _tx Column of the tile.
+      /// \param[in] _ty Row of the tile.
+      /// \return Heights of the tile, row by row.
+      private: std::vector<HeightType> &Tile(const unsigned int _tx,
+                   const unsigned int _ty) const;
+
+      /// \brief Update the "physics/heightmaps" memory account with the
+      /// size of the lookup table and of the tiles in memory.
+      private: void AccountMemory() const;
+
       /// \brief Lookup table of heights.
       protected: std::vector<HeightType> heights;
 
@@ -167,6 +221,57 @@ namespace gazebo
       /// \brief The amount of subsampling. Default is 2.
       protected: int subSampling;
 
+      /// \brief Subsampling of the height lookup table.
+      protected: int collisionSubSampling;
+
+      /// \brief Number of data points per vertex of the height lookup
+      /// table, along each side.
+      protected: int collisionDecimation;
+
+      /// \brief True if the physics engine only reads the heights through
+      /// GetHeight, which allows the lookup table to be tiled.
+      protected: bool tilingSupported;
+
+      /// \brief A tile of the lookup table.
+      private: struct TileData
+               {
+                 /// \brief Heights of the tile, row by row.
+                 std::vector<HeightType> heights;
+
+                 /// \brief Position of the tile in tileLru.
+                 std::list<int64_t>::iterator lru;
+               };
+
+      /// \brief Number of vertices along the side of a tile, 0 if the
+      /// lookup table isn't tiled.
+      private: unsigned int tileSize = 0;
+
+      /// \brief Maximum number of tiles kept in memory.
+      private: unsigned int tileCacheSize = 64;
+
+      /// \brief Number of tiles along each side of the lookup table.
+      private: unsigned int tileCount = 0;
+
+      /// \brief Extreme heights of a tiled lookup table.
+      private: HeightType tiledMinHeight = 0;
+      private: HeightType tiledMaxHeight = 0;
+
+      /// \brief Tiles in memory, by row * tileCount + column.
+      private: mutable std::unordered_map<int64_t, TileData> tiles;
+
+      /// \brief Keys of the tiles in memory, most recently used first.
+      private: mutable std::list<int64_t> tileLru;
+
+      /// \brief Key and heights of the last tile that was read.
+      private: mutable int64_t lastTileKey = -1;
+      private: mutable std::vector<HeightType> *lastTile = nullptr;
+
+      /// \brief Protects the tiles, which can be read from sensor threads.
+      private: mutable std::mutex tileMutex;
+
+      /// \brief Bytes added to the memory account by this shape.
+      private: mutable int64_t accountedBytes = 0;
+
       /// \brief Transportation node.
       private: transport::NodePtr node;
 
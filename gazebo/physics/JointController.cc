@@ -15,6 +15,8 @@
  *
 */
 
+#include <unordered_map>
+
 #include <boost/algorithm/string.hpp>
 
 #include "gazebo/transport/Node.hh"
@@ -31,6 +33,85 @@
 using namespace gazebo;
 using namespace physics;
 
+/////////////////////////////////////////////////
+/// \brief Resolve the commands of a JointController to slots.
+/// \param[in] _data Private data of the controller.
+static void BuildCommandSlots(JointControllerPrivate &_data)
+{
+  _data.forceSlots.clear();
+  _data.positionSlots.clear();
+  _data.velocitySlots.clear();
+
+  // Where each of the model's joints starts in Model::JointStates
+  std::unordered_map<const Joint *, int> stateIndices;
+  _data.stateCount = 0;
+  for (const auto &joint : _data.model->GetJoints())
+  {
+    stateIndices[joint.get()] = _data.stateCount;
+    _data.stateCount += joint->DOF();
+  }
+
+  auto makeSlot = [&](const std::string &_name, const double &_target,
+      std::map<std::string, common::PID> *_pids, JointCommandSlot &_slot)
+  {
+    auto joint = _data.joints.find(_name);
+    if (joint == _data.joints.end() || !joint->second)
+      return false;
+
+    if (_pids)
+    {
+      auto pid = _pids->find(_name);
+      if (pid == _pids->end())
+        return false;
+      _slot.pid = &pid->second;
+    }
+
+    _slot.joint = joint->second.get();
+    _slot.target = &_target;
+    auto index = stateIndices.find(_slot.joint);
+    if (index != stateIndices.end())
+      _slot.stateIndex = index->second;
+    return true;
+  };
+
+  JointCommandSlot slot;
+  for (const auto &force : _data.forces)
+  {
+    slot = JointCommandSlot();
+    if (makeSlot(force.first, force.second, nullptr, slot))
+      _data.forceSlots.push_back(slot);
+  }
+
+  bool allIndexed = true;
+  for (const auto &position : _data.positions)
+  {
+    slot = JointCommandSlot();
+    if (makeSlot(position.first, position.second, &_data.posPids, slot))
+    {
+      _data.positionSlots.push_back(slot);
+      allIndexed = allIndexed && slot.stateIndex >= 0;
+    }
+  }
+  for (const auto &velocity : _data.velocities)
+  {
+    slot = JointCommandSlot();
+    if (makeSlot(velocity.first, velocity.second, &_data.velPids, slot))
+    {
+      _data.velocitySlots.push_back(slot);
+      allIndexed = allIndexed && slot.stateIndex >= 0;
+    }
+  }
+
+  // Reading all states at once only pays off when a good part of them is
+  // used. Model::JointStates reads both positions and velocities.
+  const size_t pidCount =
+      _data.positionSlots.size() + _data.velocitySlots.size();
+  _data.bulkRead = allIndexed && pidCount > 0 &&
+      2 * pidCount >= _data.stateCount;
+
+  _data.slotsDirty = false;
+}
+
 /////////////////////////////////////////////////
 JointController::JointController(ModelPtr _model)
   : dataPtr(new JointControllerPrivate)
@@ -74,6 +155,7 @@ void JointController::AddJoint(JointPtr _joint)
       1, 0.1, 0.01, 1, -1, 1000, -1000);
   this->dataPtr->velPids[_joint->GetScopedName()].Init(
       1, 0.1, 0.01, 1, -1, 1000, -1000);
+  this->dataPtr->slotsDirty = true;
 }
 
 /////////////////////////////////////////////////
@@ -84,6 +166,10 @@ void JointController::RemoveJoint(Joint *_joint)
     this->dataPtr->joints.erase(_joint->GetScopedName());
     this->dataPtr->posPids.erase(_joint->GetScopedName());
     this->dataPtr->velPids.erase(_joint->GetScopedName());
+    this->dataPtr->forces.erase(_joint->GetScopedName());
+    this->dataPtr->positions.erase(_joint->GetScopedName());
+    this->dataPtr->velocities.erase(_joint->GetScopedName());
+    this->dataPtr->slotsDirty = true;
   }
 }
 
@@ -94,6 +180,7 @@ void JointController::Reset()
   this->dataPtr->positions.clear();
   this->dataPtr->velocities.clear();
   this->dataPtr->forces.clear();
+  this->dataPtr->slotsDirty = true;
 
   std::map<std::string, common::PID>::iterator iter;
 
@@ -124,47 +211,45 @@ void JointController::Update()
   // TODO: fix this when World::ResetTime is improved
   if (stepTime > 0)
   {
+    if (this->dataPtr->slotsDirty)
+      BuildCommandSlots(*this->dataPtr);
+
     IGN_PROFILE_BEGIN("forces");
-    if (!this->dataPtr->forces.empty())
+    for (const auto &slot : this->dataPtr->forceSlots)
+      slot.joint->SetForce(0, *slot.target);
+    IGN_PROFILE_END();
+
+    // Read the states of all joints at once, see BuildCommandSlots
+    bool bulk = false;
+    if (this->dataPtr->bulkRead)
     {
-      std::map<std::string, double>::iterator iter;
-      for (iter = this->dataPtr->forces.begin();
-          iter != this->dataPtr->forces.end(); ++iter)
-      {
-        this->dataPtr->joints[iter->first]->SetForce(0, iter->second);
-      }
+      IGN_PROFILE_BEGIN("joint states");
+      this->dataPtr->model->JointStates(this->dataPtr->statePositions,
+          this->dataPtr->stateVelocities);
+      bulk = this->dataPtr->statePositions.size() ==
+          this->dataPtr->stateCount;
+      IGN_PROFILE_END();
     }
-    IGN_PROFILE_END();
 
     IGN_PROFILE_BEGIN("positions");
-    if (!this->dataPtr->positions.empty())
+    for (const auto &slot : this->dataPtr->positionSlots)
     {
-      std::map<std::string, double>::iterator iter;
-
-      for (iter = this->dataPtr->positions.begin();
-           iter != this->dataPtr->positions.end(); ++iter)
-      {
-        double cmd = this->dataPtr->posPids[iter->first].Update(
-            this->dataPtr->joints[iter->first]->Position(0) -
-            iter->second, stepTime);
-        this->dataPtr->joints[iter->first]->SetForce(0, cmd);
-      }
+      const double position = bulk ?
+          this->dataPtr->statePositions[slot.stateIndex] :
+          slot.joint->Position(0);
+      slot.joint->SetForce(0,
+          slot.pid->Update(position - *slot.target, stepTime));
     }
     IGN_PROFILE_END();
 
     IGN_PROFILE_BEGIN("velocities");
-    if (!this->dataPtr->velocities.empty())
+    for (const auto &slot : this->dataPtr->velocitySlots)
     {
-      std::map<std::string, double>::iterator iter;
-
-      for (iter = this->dataPtr->velocities.begin();
-           iter != this->dataPtr->velocities.end(); ++iter)
-      {
-        double cmd = this->dataPtr->velPids[iter->first].Update(
-            this->dataPtr->joints[iter->first]->GetVelocity(0) - iter->second,
-            stepTime);
-        this->dataPtr->joints[iter->first]->SetForce(0, cmd);
-      }
+      const double velocity = bulk ?
+          this->dataPtr->stateVelocities[slot.stateIndex] :
+          slot.joint->GetVelocity(0);
+      slot.joint->SetForce(0,
+          slot.pid->Update(velocity - *slot.target, stepTime));
     }
     IGN_PROFILE_END();
   }
@@ -248,6 +333,8 @@ void JointController::OnJointCommand(const ignition::msgs::JointCmd &_msg)
   iter = this->dataPtr->joints.find(_msg.name());
   if (iter != this->dataPtr->joints.end())
   {
+    this->dataPtr->slotsDirty = true;
+
     if (_msg.reset())
     {
       if (this->dataPtr->forces.find(_msg.name()) !=
@@ -477,7 +564,10 @@ void JointController::SetPositionPID(const std::string &_jointName,
   iter = this->dataPtr->joints.find(_jointName);
 
   if (iter != this->dataPtr->joints.end())
+  {
     this->dataPtr->posPids[_jointName] = _pid;
+    this->dataPtr->slotsDirty = true;
+  }
   else
     gzerr << "Unable to find joint with name[" << _jointName << "]\n";
 }
@@ -491,6 +581,9 @@ bool JointController::SetPositionTarget(const std::string &_jointName,
   if (this->dataPtr->posPids.find(_jointName) !=
       this->dataPtr->posPids.end())
   {
+    this->dataPtr->slotsDirty = this->dataPtr->slotsDirty ||
+        this->dataPtr->positions.find(_jointName) ==
+        this->dataPtr->positions.end();
     this->dataPtr->positions[_jointName] = _target;
     result = true;
   }
@@ -506,7 +599,10 @@ void JointController::SetVelocityPID(const std::string &_jointName,
   iter = this->dataPtr->joints.find(_jointName);
 
   if (iter != this->dataPtr->joints.end())
+  {
     this->dataPtr->velPids[_jointName] = _pid;
+    this->dataPtr->slotsDirty = true;
+  }
   else
     gzerr << "Unable to find joint with name[" << _jointName << "]\n";
 }
@@ -520,6 +616,9 @@ bool JointController::SetVelocityTarget(const std::string &_jointName,
   if (this->dataPtr->velPids.find(_jointName) !=
       this->dataPtr->velPids.end())
   {
+    this->dataPtr->slotsDirty = this->dataPtr->slotsDirty ||
+        this->dataPtr->velocities.find(_jointName) ==
+        this->dataPtr->velocities.end();
     this->dataPtr->velocities[_jointName] = _target;
     result = true;
   }
@@ -536,6 +635,9 @@ bool JointController::SetForce(const std::string &_jointName,
   if (this->dataPtr->joints.find(_jointName) !=
       this->dataPtr->joints.end())
   {
+    this->dataPtr->slotsDirty = this->dataPtr->slotsDirty ||
+        this->dataPtr->forces.find(_jointName) ==
+        this->dataPtr->forces.end();
     this->dataPtr->forces[_jointName] = _force;
     result = true;
   }
@@ -19,6 +19,7 @@
 
 #include <string>
 #include <map>
+#include <vector>
 #include <ignition/transport.hh>
 
 #include "gazebo/transport/TransportTypes.hh"
@@ -30,6 +31,25 @@ namespace gazebo
 {
   namespace physics
   {
+    /// \brief A joint command with its joint, PID and target resolved, so
+    /// that JointController::Update doesn't look them up by name.
+    class JointCommandSlot
+    {
+      /// \brief Joint to command.
+      public: Joint *joint = nullptr;
+
+      /// \brief PID controller, null for force commands.
+      public: common::PID *pid = nullptr;
+
+      /// \brief Target position or velocity, or force to apply. Points
+      /// into one of the command maps.
+      public: const double *target = nullptr;
+
+      /// \brief Index of the joint's first axis in Model::JointStates,
+      /// -1 if the joint isn't one of the model's joints.
+      public: int stateIndex = -1;
+    };
+
     class JointControllerPrivate
     {
       /// \brief Model to control.
@@ -68,6 +88,33 @@ namespace gazebo
 
       /// \brief Last time the controller was updated.
       public: common::Time prevUpdateTime;
+
+      /// \brief Force commands, in the order of the forces map.
+      public: std::vector<JointCommandSlot> forceSlots;
+
+      /// \brief Position commands, in the order of the positions map.
+      public: std::vector<JointCommandSlot> positionSlots;
+
+      /// \brief Velocity commands, in the order of the velocities map.
+      public: std::vector<JointCommandSlot> velocitySlots;
+
+      /// \brief True when the command maps changed since the slots were
+      /// built.
+      public: bool slotsDirty = true;
+
+      /// \brief True to read the joint states with one
+      /// Model::JointStates call instead of one call per joint.
+      public: bool bulkRead = false;
+
+      /// \brief Number of joint states of the model when the slots were
+      /// built.
+      public: unsigned int stateCount = 0;
+
+      /// \brief Joint positions read by Model::JointStates.
+      public: std::vector<double> statePositions;
+
+      /// \brief Joint velocities read by Model::JointStates.
+      public: std::vector<double> stateVelocities;
     };
   }
 }
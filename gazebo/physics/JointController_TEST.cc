@@ -248,6 +248,31 @@ TEST_F(JointControllerTest, AddJoint)
   EXPECT_EQ(velocities.size(), 0u);
 }
 
+/////////////////////////////////////////////////
+TEST_F(JointControllerTest, RemoveJoint)
+{
+  physics::ModelPtr model(new physics::Model(physics::BasePtr()));
+  physics::JointControllerPtr jointController(
+      new physics::JointController(model));
+
+  physics::JointPtr joint(new FakeJoint(model));
+  joint->SetName("joint");
+  jointController->AddJoint(joint);
+
+  EXPECT_TRUE(jointController->SetPositionTarget(joint->GetScopedName(), 1));
+  EXPECT_TRUE(jointController->SetVelocityTarget(joint->GetScopedName(), 2));
+  EXPECT_TRUE(jointController->SetForce(joint->GetScopedName(), 3));
+
+  // Removing the joint drops its commands too
+  jointController->RemoveJoint(joint.get());
+  EXPECT_TRUE(jointController->GetJoints().empty());
+  EXPECT_TRUE(jointController->GetPositionPIDs().empty());
+  EXPECT_TRUE(jointController->GetVelocityPIDs().empty());
+  EXPECT_TRUE(jointController->GetPositions().empty());
+  EXPECT_TRUE(jointController->GetVelocities().empty());
+  EXPECT_TRUE(jointController->GetForces().empty());
+}
+
 /////////////////////////////////////////////////
 TEST_F(JointControllerTest, SetJointPositions)
 {
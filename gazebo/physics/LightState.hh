@@ -127,6 +127,9 @@ namespace gazebo
 
       /// \brief Pose of the light.
       private: ignition::math::Pose3d pose;
+
+      /// Friend WorldStateBuffer so that it can fill states from snapshots
+      private: friend class WorldStateBuffer;
     };
 
     /// \}
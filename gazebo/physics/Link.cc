@@ -16,6 +16,8 @@
 */
 
 #include <boost/algorithm/string.hpp>
+#include <algorithm>
+#include <cstdint>
 #include <functional>
 #include <mutex>
 #include <sstream>
@@ -36,6 +38,7 @@
 #include "gazebo/physics/Light.hh"
 #include "gazebo/physics/Model.hh"
 #include "gazebo/physics/World.hh"
+#include "gazebo/physics/BatterySystem.hh"
 #include "gazebo/physics/ContactManager.hh"
 #include "gazebo/physics/PhysicsEngine.hh"
 #include "gazebo/physics/Collision.hh"
@@ -85,6 +88,23 @@ class gazebo::physics::LinkPrivate
   /// \brief Cached list of collisions. This is here for performance.
   public: Collision_V collisions;
 
+  /// \brief Protects the cached bounding box.
+  public: std::mutex boundingBoxMutex;
+
+  /// \brief Union of the collision boxes, as of boundingBoxPose.
+  public: ignition::math::AxisAlignedBox boundingBox;
+
+  /// \brief World pose of the link when boundingBox was computed.
+  public: ignition::math::Pose3d boundingBoxPose;
+
+  /// \brief Incremented when the collisions change, so that a box
+  /// computed concurrently with the change isn't kept.
+  public: uint64_t boundingBoxVersion = 0;
+
+  /// \brief True if boundingBox holds a box computed at
+  /// boundingBoxVersion.
+  public: bool boundingBoxValid = false;
+
   /// \brief Wrench subscriber.
   public: transport::SubscriberPtr wrenchSub;
 
@@ -97,12 +117,19 @@ class gazebo::physics::LinkPrivate
   /// \brief Wind velocity.
   public: ignition::math::Vector3d windLinearVel;
 
+  /// \brief Copy of the enable_wind SDF parameter, which is too slow to
+  /// read in a loop over every link.
+  public: bool windMode = false;
+
   /// \brief Update connection to calculate wind velocity.
   public: event::ConnectionPtr updateConnection;
 
   /// \brief All the attached batteries.
   public: std::vector<common::BatteryPtr> batteries;
 
+  /// \brief True if continuous collision detection is enabled.
+  public: bool ccd = false;
+
 #ifdef HAVE_OPENAL
       /// \brief All the audio sources
       public: std::vector<util::OpenALSourcePtr> audioSources;
@@ -167,6 +194,12 @@ void Link::Load(sdf::ElementPtr _sdf)
   this->sdf->GetElement("self_collide")->GetValue()->SetUpdateFunc(
       std::bind(&Link::GetSelfCollide, this));
 
+  {
+    const std::string kElementName = "ignition:ccd";
+    if (this->sdf->HasElement(kElementName))
+      this->SetCCD(this->sdf->Get<bool>(kElementName));
+  }
+
   // Parse visuals from SDF
   this->ParseVisuals();
 
@@ -321,6 +354,7 @@ void Link::Init()
       CollisionPtr collision = boost::static_pointer_cast<Collision>(*iter);
       this->dataPtr->collisions.push_back(collision);
       collision->Init();
+      this->InvalidateBoundingBox();
     }
     if ((*iter)->HasType(Base::LIGHT))
     {
@@ -329,10 +363,12 @@ void Link::Init()
     }
   }
 
-  // Initialize all the batteries
+  // Initialize all the batteries, the world updates them
   for (auto &battery : this->dataPtr->batteries)
   {
     battery->Init();
+    this->world->Batteries()->Add(battery,
+        this->GetScopedName() + "::" + battery->Name());
   }
 
   if (this->WindMode() && this->world->WindEnabled())
@@ -350,7 +386,13 @@ void Link::Fini()
   this->dataPtr->parentJoints.clear();
   this->dataPtr->childJoints.clear();
   this->dataPtr->collisions.clear();
+  this->InvalidateBoundingBox();
   this->inertial.reset();
+  if (this->world)
+  {
+    for (auto &battery : this->dataPtr->batteries)
+      this->world->Batteries()->Remove(battery);
+  }
   this->dataPtr->batteries.clear();
 
   // Remove all the sensors attached to the link
@@ -629,14 +671,6 @@ void Link::Update(const common::UpdateInfo & /*_info*/)
     }
   }
   IGN_PROFILE_END();
-
-  // Update the batteries.
-  IGN_PROFILE_BEGIN("batteries");
-  for (auto &battery : this->dataPtr->batteries)
-  {
-    battery->Update();
-  }
-  IGN_PROFILE_END();
 }
 
 //////////////////////////////////////////////////
@@ -728,7 +762,7 @@ CollisionPtr Link::GetCollision(const std::string &_name)
 }
 
 //////////////////////////////////////////////////
-Collision_V Link::GetCollisions() const
+const Collision_V &Link::GetCollisions() const
 {
   return this->dataPtr->collisions;
 }
@@ -828,6 +862,28 @@ ModelPtr Link::GetModel() const
 //////////////////////////////////////////////////
 ignition::math::AxisAlignedBox Link::BoundingBox() const
 {
+  // Asking the engine for every collision box is the expensive part, so
+  // reuse the last box for as long as the link hasn't moved. The poses are
+  // compared exactly, Pose3d::operator== is too tolerant for this.
+  const ignition::math::Pose3d pose = this->WorldPose();
+  uint64_t version;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->boundingBoxMutex);
+    const auto &cached = this->dataPtr->boundingBoxPose;
+    if (this->dataPtr->boundingBoxValid &&
+        cached.Pos().X() == pose.Pos().X() &&
+        cached.Pos().Y() == pose.Pos().Y() &&
+        cached.Pos().Z() == pose.Pos().Z() &&
+        cached.Rot().W() == pose.Rot().W() &&
+        cached.Rot().X() == pose.Rot().X() &&
+        cached.Rot().Y() == pose.Rot().Y() &&
+        cached.Rot().Z() == pose.Rot().Z())
+    {
+      return this->dataPtr->boundingBox;
+    }
+    version = this->dataPtr->boundingBoxVersion;
+  }
+
   ignition::math::AxisAlignedBox box;
 
   box.Min().Set(ignition::math::MAX_D, ignition::math::MAX_D,
@@ -841,13 +897,30 @@ ignition::math::AxisAlignedBox Link::BoundingBox() const
     box += (*iter)->BoundingBox();
   }
 
+  std::lock_guard<std::mutex> lock(this->dataPtr->boundingBoxMutex);
+  if (version == this->dataPtr->boundingBoxVersion)
+  {
+    this->dataPtr->boundingBox = box;
+    this->dataPtr->boundingBoxPose = pose;
+    this->dataPtr->boundingBoxValid = true;
+  }
+
   return box;
 }
 
+//////////////////////////////////////////////////
+void Link::InvalidateBoundingBox()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->boundingBoxMutex);
+  ++this->dataPtr->boundingBoxVersion;
+  this->dataPtr->boundingBoxValid = false;
+}
+
 //////////////////////////////////////////////////
 void Link::SetWindMode(const bool _mode)
 {
   this->sdf->GetElement("enable_wind")->Set(_mode);
+  this->dataPtr->windMode = _mode;
 
   if (!this->WindMode() && this->dataPtr->updateConnection)
     this->SetWindEnabled(false);
@@ -880,7 +953,7 @@ const ignition::math::Vector3d Link::WorldWindLinearVel() const
 //////////////////////////////////////////////////
 bool Link::WindMode() const
 {
-  return this->sdf->Get<bool>("enable_wind");
+  return this->dataPtr->windMode;
 }
 
 //////////////////////////////////////////////////
@@ -1223,6 +1296,29 @@ void Link::SetKinematic(const bool &/*_kinematic*/)
 {
 }
 
+/////////////////////////////////////////////////
+void Link::SetCCD(const bool _enable)
+{
+  this->dataPtr->ccd = _enable;
+}
+
+/////////////////////////////////////////////////
+bool Link::CCD() const
+{
+  return this->dataPtr->ccd;
+}
+
+/////////////////////////////////////////////////
+double Link::CCDRadius() const
+{
+  const ignition::math::AxisAlignedBox box = this->BoundingBox();
+  if (box.Min().X() > box.Max().X())
+    return 0.0;
+
+  const ignition::math::Vector3d size = box.Size();
+  return 0.5 * std::min(size.X(), std::min(size.Y(), size.Z()));
+}
+
 /////////////////////////////////////////////////
 void Link::SetPublishData(bool _enable)
 {
@@ -1452,6 +1548,7 @@ void Link::RemoveCollision(const std::string &_name)
     if ((*iter)->GetName() == _name || (*iter)->GetScopedName() == _name)
     {
       this->dataPtr->collisions.erase(iter);
+      this->InvalidateBoundingBox();
       break;
     }
   }
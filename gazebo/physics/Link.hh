@@ -351,15 +351,21 @@ namespace gazebo
       public: CollisionPtr GetCollision(unsigned int _index) const;
 
       /// \brief Get all the child collisions.
-      /// \return A std::vector of all the child collisions.
-      public: Collision_V GetCollisions() const;
+      /// \return A std::vector of all the child collisions. The reference
+      /// is invalidated when collisions are added or removed.
+      public: const Collision_V &GetCollisions() const;
 
       /// \brief Get the bounding box for the link and all the child
-      /// elements.
+      /// elements. The box is cached until the link moves or
+      /// InvalidateBoundingBox is called.
       /// \return The link's bounding box.
       public: virtual ignition::math::AxisAlignedBox BoundingBox() const
           override;
 
+      /// \brief Drop the cached bounding box. Called when a collision is
+      /// added, removed, moved relative to the link or resized.
+      public: void InvalidateBoundingBox();
+
       /// \brief Set the linear damping factor.
       /// \param[in] _damping Linear damping factor.
       public: virtual void SetLinearDamping(double _damping) = 0;
@@ -386,6 +392,25 @@ namespace gazebo
       /// \return True if the link is kinematic only.
       public: virtual bool GetKinematic() const {return false;}
 
+      /// \brief Enable continuous collision detection for the link, so
+      /// that it doesn't go through thin or small objects when moving fast.
+      /// Only Bullet and ODE support it, other engines ignore the setting.
+      /// It can also be set with the <ignition:ccd> element of the link.
+      /// \param[in] _enable True to enable continuous collision detection.
+      public: virtual void SetCCD(const bool _enable);
+
+      /// \brief Get whether continuous collision detection is enabled.
+      /// \return True if enabled.
+      /// \sa SetCCD
+      public: bool CCD() const;
+
+      /// \brief Get the radius of the sphere used to sweep the link for
+      /// continuous collision detection: half the smallest size of the
+      /// link's bounding box.
+      /// \return Radius of the swept sphere, 0 if the link has no
+      /// collision.
+      public: double CCDRadius() const;
+
       /// \brief Get sensor count
       ///
       /// This will return the number of sensors created by the link when it
@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include "gazebo/common/Assert.hh"
+#include "gazebo/physics/Link.hh"
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/World.hh"
+#include "gazebo/physics/LinkKinematicsCache.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+/////////////////////////////////////////////////
+void LinkKinematicsCache::Rebuild(const WorldPtr &_world)
+{
+  this->links.clear();
+  this->indices.clear();
+  this->ids.clear();
+
+  std::vector<Model *> stack;
+  for (const auto &model : _world->Models())
+    stack.push_back(model.get());
+
+  while (!stack.empty())
+  {
+    Model *model = stack.back();
+    stack.pop_back();
+
+    for (const auto &link : model->GetLinks())
+    {
+      this->indices[link->GetId()] = this->links.size();
+      this->links.push_back(link.get());
+      this->ids.push_back(link->GetId());
+    }
+
+    for (const auto &nested : model->NestedModels())
+      stack.push_back(nested.get());
+  }
+
+  this->poses.resize(this->links.size());
+  this->linearVels.resize(this->links.size());
+  this->angularVels.resize(this->links.size());
+  this->linearAccels.resize(this->links.size());
+  this->angularAccels.resize(this->links.size());
+}
+
+/////////////////////////////////////////////////
+void LinkKinematicsCache::Update(const WorldPtr &_world,
+    const uint64_t _entityVersion)
+{
+  GZ_ASSERT(_world, "World pointer is invalid");
+
+  if (!this->built || this->version != _entityVersion)
+  {
+    this->Rebuild(_world);
+    this->version = _entityVersion;
+    this->built = true;
+  }
+
+  for (size_t i = 0; i < this->links.size(); ++i)
+  {
+    const Link *link = this->links[i];
+    this->poses[i] = link->WorldPose();
+    this->linearVels[i] = link->WorldLinearVel();
+    this->angularVels[i] = link->WorldAngularVel();
+    this->linearAccels[i] = link->WorldLinearAccel();
+    this->angularAccels[i] = link->WorldAngularAccel();
+  }
+}
+
+/////////////////////////////////////////////////
+void LinkKinematicsCache::Clear()
+{
+  this->links.clear();
+  this->indices.clear();
+  this->ids.clear();
+  this->poses.clear();
+  this->linearVels.clear();
+  this->angularVels.clear();
+  this->linearAccels.clear();
+  this->angularAccels.clear();
+  this->built = false;
+}
+
+/////////////////////////////////////////////////
+size_t LinkKinematicsCache::Size() const
+{
+  return this->ids.size();
+}
+
+/////////////////////////////////////////////////
+bool LinkKinematicsCache::Index(const uint32_t _id, size_t &_index) const
+{
+  auto iter = this->indices.find(_id);
+  if (iter == this->indices.end())
+    return false;
+
+  _index = iter->second;
+  return true;
+}
+
+/////////////////////////////////////////////////
+LinkKinematicsCache::ConstIterator LinkKinematicsCache::begin() const
+{
+  return ConstIterator(*this, 0);
+}
+
+/////////////////////////////////////////////////
+LinkKinematicsCache::ConstIterator LinkKinematicsCache::end() const
+{
+  return ConstIterator(*this, this->ids.size());
+}
+
+/////////////////////////////////////////////////
+uint64_t LinkKinematicsCache::Version() const
+{
+  return this->version;
+}
+
+/////////////////////////////////////////////////
+const std::vector<Link *> &LinkKinematicsCache::Links() const
+{
+  return this->links;
+}
+
+/////////////////////////////////////////////////
+const std::vector<uint32_t> &LinkKinematicsCache::Ids() const
+{
+  return this->ids;
+}
+
+/////////////////////////////////////////////////
+const std::vector<ignition::math::Pose3d> &LinkKinematicsCache::Poses() const
+{
+  return this->poses;
+}
+
+/////////////////////////////////////////////////
+const std::vector<ignition::math::Vector3d> &
+LinkKinematicsCache::LinearVels() const
+{
+  return this->linearVels;
+}
+
+/////////////////////////////////////////////////
+const std::vector<ignition::math::Vector3d> &
+LinkKinematicsCache::AngularVels() const
+{
+  return this->angularVels;
+}
+
+/////////////////////////////////////////////////
+const std::vector<ignition::math::Vector3d> &
+LinkKinematicsCache::LinearAccels() const
+{
+  return this->linearAccels;
+}
+
+/////////////////////////////////////////////////
+const std::vector<ignition::math::Vector3d> &
+LinkKinematicsCache::AngularAccels() const
+{
+  return this->angularAccels;
+}
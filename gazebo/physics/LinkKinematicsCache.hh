@@ -0,0 +1,246 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_LINKKINEMATICSCACHE_HH_
+#define GAZEBO_PHYSICS_LINKKINEMATICSCACHE_HH_
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class LinkKinematicsCache LinkKinematicsCache.hh physics/physics.hh
+    /// \brief Contiguous arrays holding the world pose, velocity and
+    /// acceleration of every link in a world.
+    ///
+    /// When enabled with World::SetLinkKinematicsCacheEnabled, the world
+    /// refreshes the cache once per iteration, right after
+    /// PhysicsEngine::UpdatePhysics. Consumers can then read the kinematics
+    /// of all links in bulk instead of calling Link::WorldPose and friends
+    /// on each link. The cache is only safe to read from the world update
+    /// thread, for example from a worldUpdateEnd callback.
+    class GZ_PHYSICS_VISIBLE LinkKinematicsCache
+    {
+      /// \brief Read only view of a single link in the cache.
+      public: class Entry
+      {
+        /// \brief Constructor.
+        /// \param[in] _cache Cache the entry belongs to.
+        /// \param[in] _index Index of the link in the cache.
+        public: Entry(const LinkKinematicsCache &_cache, const size_t _index)
+                : cache(_cache), index(_index) {}
+
+        /// \brief Id of the link.
+        /// \return Link id.
+        public: uint32_t Id() const
+                {return this->cache.ids[this->index];}
+
+        /// \brief World pose of the link.
+        /// \return Link pose.
+        public: const ignition::math::Pose3d &Pose() const
+                {return this->cache.poses[this->index];}
+
+        /// \brief World linear velocity of the link.
+        /// \return Linear velocity.
+        public: const ignition::math::Vector3d &LinearVel() const
+                {return this->cache.linearVels[this->index];}
+
+        /// \brief World angular velocity of the link.
+        /// \return Angular velocity.
+        public: const ignition::math::Vector3d &AngularVel() const
+                {return this->cache.angularVels[this->index];}
+
+        /// \brief World linear acceleration of the link.
+        /// \return Linear acceleration.
+        public: const ignition::math::Vector3d &LinearAccel() const
+                {return this->cache.linearAccels[this->index];}
+
+        /// \brief World angular acceleration of the link.
+        /// \return Angular acceleration.
+        public: const ignition::math::Vector3d &AngularAccel() const
+                {return this->cache.angularAccels[this->index];}
+
+        /// \brief Cache the entry belongs to.
+        private: const LinkKinematicsCache &cache;
+
+        /// \brief Index of the link in the cache.
+        private: size_t index;
+      };
+
+      /// \brief Forward iterator over the entries of the cache.
+      public: class ConstIterator
+      {
+        /// \brief Constructor.
+        /// \param[in] _cache Cache to iterate over.
+        /// \param[in] _index Starting index.
+        public: ConstIterator(const LinkKinematicsCache &_cache,
+                              const size_t _index)
+                : cache(&_cache), index(_index) {}
+
+        /// \brief Get the entry the iterator points at.
+        /// \return Entry view.
+        public: Entry operator*() const
+                {return Entry(*this->cache, this->index);}
+
+        /// \brief Pre-increment.
+        /// \return Reference to this iterator.
+        public: ConstIterator &operator++()
+                {
+                  ++this->index;
+                  return *this;
+                }
+
+        /// \brief Equality operator.
+        /// \param[in] _other Iterator to compare with.
+        /// \return True if both point at the same entry.
+        public: bool operator==(const ConstIterator &_other) const
+                {
+                  return this->cache == _other.cache &&
+                         this->index == _other.index;
+                }
+
+        /// \brief Inequality operator.
+        /// \param[in] _other Iterator to compare with.
+        /// \return True if the iterators point at different entries.
+        public: bool operator!=(const ConstIterator &_other) const
+                {return !(*this == _other);}
+
+        /// \brief Cache being iterated over.
+        private: const LinkKinematicsCache *cache;
+
+        /// \brief Current index.
+        private: size_t index;
+      };
+
+      /// \brief Constructor.
+      public: LinkKinematicsCache() = default;
+
+      /// \brief Refresh the cache from the links of a world.
+      /// \param[in] _world World to read from.
+      /// \param[in] _entityVersion Counter that changes whenever an entity
+      /// is added to or removed from the world. The list of links is only
+      /// rebuilt when it differs from the value of the last update.
+      public: void Update(const WorldPtr &_world,
+                          const uint64_t _entityVersion);
+
+      /// \brief Remove all links from the cache.
+      public: void Clear();
+
+      /// \brief Number of links in the cache.
+      /// \return Number of links.
+      public: size_t Size() const;
+
+      /// \brief Find the index of a link.
+      /// \param[in] _id Id of the link.
+      /// \param[out] _index Index of the link in the cache arrays.
+      /// \return True if the link is in the cache.
+      public: bool Index(const uint32_t _id, size_t &_index) const;
+
+      /// \brief Iterator to the first entry.
+      /// \return Begin iterator.
+      public: ConstIterator begin() const;
+
+      /// \brief Iterator past the last entry.
+      /// \return End iterator.
+      public: ConstIterator end() const;
+
+      /// \brief Counter that changes whenever the list of links changes.
+      /// \return Entity version the list of links was built from.
+      public: uint64_t Version() const;
+
+      /// \brief Each link. The pointers are only valid until the version
+      /// changes.
+      /// \return Array of links, indexed like Ids().
+      public: const std::vector<Link *> &Links() const;
+
+      /// \brief Id of each link.
+      /// \return Array of link ids.
+      public: const std::vector<uint32_t> &Ids() const;
+
+      /// \brief World pose of each link.
+      /// \return Array of poses, indexed like Ids().
+      public: const std::vector<ignition::math::Pose3d> &Poses() const;
+
+      /// \brief World linear velocity of each link.
+      /// \return Array of velocities, indexed like Ids().
+      public: const std::vector<ignition::math::Vector3d> &LinearVels() const;
+
+      /// \brief World angular velocity of each link.
+      /// \return Array of velocities, indexed like Ids().
+      public: const std::vector<ignition::math::Vector3d> &AngularVels()
+              const;
+
+      /// \brief World linear acceleration of each link.
+      /// \return Array of accelerations, indexed like Ids().
+      public: const std::vector<ignition::math::Vector3d> &LinearAccels()
+              const;
+
+      /// \brief World angular acceleration of each link.
+      /// \return Array of accelerations, indexed like Ids().
+      public: const std::vector<ignition::math::Vector3d> &AngularAccels()
+              const;
+
+      /// \brief Rebuild the list of links.
+      /// \param[in] _world World to walk.
+      private: void Rebuild(const WorldPtr &_world);
+
+      /// \brief Links in cache order. Only dereferenced in Update, after
+      /// checking the entity version, or by users of Links().
+      private: std::vector<Link *> links;
+
+      /// \brief Map from link id to index in the arrays.
+      private: std::unordered_map<uint32_t, size_t> indices;
+
+      /// \brief Entity version the link list was built from.
+      private: uint64_t version = 0;
+
+      /// \brief True once the link list has been built.
+      private: bool built = false;
+
+      /// \brief Id of each link.
+      private: std::vector<uint32_t> ids;
+
+      /// \brief World pose of each link.
+      private: std::vector<ignition::math::Pose3d> poses;
+
+      /// \brief World linear velocity of each link.
+      private: std::vector<ignition::math::Vector3d> linearVels;
+
+      /// \brief World angular velocity of each link.
+      private: std::vector<ignition::math::Vector3d> angularVels;
+
+      /// \brief World linear acceleration of each link.
+      private: std::vector<ignition::math::Vector3d> linearAccels;
+
+      /// \brief World angular acceleration of each link.
+      private: std::vector<ignition::math::Vector3d> angularAccels;
+    };
+    /// \}
+  }
+}
+#endif
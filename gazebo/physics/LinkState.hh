@@ -256,6 +256,9 @@ namespace gazebo
 
       /// \brief State of all the child Collision objects.
       private: std::vector<CollisionState> collisionStates;
+
+      /// Friend WorldStateBuffer so that it can fill states from snapshots
+      private: friend class WorldStateBuffer;
     };
     /// \}
   }
@@ -14,6 +14,9 @@
  * limitations under the License.
  *
 */
+#include <limits>
+#include <sstream>
+
 #include <boost/thread/recursive_mutex.hpp>
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Console.hh"
@@ -41,6 +44,8 @@ MeshShape::MeshShape(CollisionPtr _parent)
 //////////////////////////////////////////////////
 MeshShape::~MeshShape()
 {
+  if (!this->meshReference.empty())
+    common::MeshManager::Instance()->RemoveReference(this->meshReference);
 }
 
 //////////////////////////////////////////////////
@@ -53,10 +58,18 @@ void MeshShape::Init()
 
   std::string meshStr = uri;
   common::MeshManager *meshManager = common::MeshManager::Instance();
+
+  // Keep the mesh loaded while the shape uses it
+  if (!this->meshReference.empty())
+    meshManager->RemoveReference(this->meshReference);
+  this->meshReference.clear();
+
+  meshManager->AddReference(meshStr);
   this->mesh = meshManager->GetMesh(meshStr);
 
   if (!this->mesh)
   {
+    meshManager->RemoveReference(meshStr);
     meshStr = common::find_file(uri);
 
     if (meshStr == "__default__" || meshStr.empty())
@@ -65,9 +78,11 @@ void MeshShape::Init()
       return;
     }
 
+    meshManager->AddReference(meshStr);
     if ((this->mesh = meshManager->Load(meshStr)) == NULL)
       gzerr << "Unable to load mesh from file[" << meshStr << "]\n";
   }
+  this->meshReference = meshStr;
 
   if (this->submesh)
     delete this->submesh;
@@ -98,6 +113,54 @@ void MeshShape::Init()
       }
     }
   }
+
+  // Collide with convex hulls of the mesh instead of its triangles
+  this->convexDecomposition = false;
+  if (this->mesh && this->sdf->HasElement("ignition:convex_decomposition") &&
+      this->sdf->Get<bool>("ignition:convex_decomposition"))
+  {
+    unsigned int maxHulls = 16;
+    {
+      const std::string kElementName = "ignition:convex_max_hulls";
+      if (this->sdf->HasElement(kElementName))
+        maxHulls = this->sdf->Get<unsigned int>(kElementName);
+    }
+
+    double maxConcavity = 0.02;
+    {
+      const std::string kElementName = "ignition:convex_max_concavity";
+      if (this->sdf->HasElement(kElementName))
+        maxConcavity = this->sdf->Get<double>(kElementName);
+    }
+
+    std::string submeshName;
+    bool center = false;
+    if (this->submesh)
+    {
+      sdf::ElementPtr submeshElem = this->sdf->GetElement("submesh");
+      submeshName = submeshElem->Get<std::string>("name");
+      center = submeshElem->Get<bool>("center");
+    }
+
+    std::string name = common::MeshManager::ConvexDecompositionName(
+        this->mesh, submeshName, center, maxHulls, maxConcavity);
+    meshManager->CreateConvexDecomposition(name, this->mesh, submeshName,
+        center, maxHulls, maxConcavity);
+
+    if (const common::Mesh *hulls = meshManager->GetMesh(name))
+    {
+      this->mesh = hulls;
+      delete this->submesh;
+      this->submesh = NULL;
+      this->convexDecomposition = true;
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+bool MeshShape::IsConvexDecomposition() const
+{
+  return this->convexDecomposition;
 }
 
 //////////////////////////////////////////////////
@@ -118,6 +181,62 @@ std::string MeshShape::GetMeshURI() const
   return this->sdf->Get<std::string>("uri");
 }
 
+//////////////////////////////////////////////////
+std::string MeshShape::CollisionDataKey() const
+{
+  if (!this->mesh)
+    return std::string();
+
+  std::ostringstream key;
+  key.precision(std::numeric_limits<double>::max_digits10);
+  key << this->mesh->GetName();
+  if (this->submesh)
+  {
+    sdf::ElementPtr submeshElem = this->sdf->GetElement("submesh");
+    key << "::" << this->submesh->GetName()
+        << (submeshElem->Get<bool>("center") ? "::centered" : "");
+  }
+  auto scale = this->sdf->Get<ignition::math::Vector3d>("scale");
+  key << "@" << scale.X() << " " << scale.Y() << " " << scale.Z();
+
+  return key.str();
+}
+
+//////////////////////////////////////////////////
+bool MeshShape::Triangles(std::vector<ignition::math::Vector3d> &_vertices,
+    std::vector<unsigned int> &_indices) const
+{
+  _vertices.clear();
+  _indices.clear();
+  if (!this->mesh)
+    return false;
+
+  auto scale = this->sdf->Get<ignition::math::Vector3d>("scale");
+  auto addSubMesh = [&](const common::SubMesh *_subMesh)
+  {
+    if (_subMesh->GetPrimitiveType() != common::SubMesh::TRIANGLES)
+      return;
+
+    unsigned int offset = _vertices.size();
+    for (unsigned int i = 0; i < _subMesh->GetVertexCount(); ++i)
+      _vertices.push_back(_subMesh->Vertex(i) * scale);
+    for (unsigned int i = 0; i < _subMesh->GetIndexCount(); ++i)
+      _indices.push_back(offset + _subMesh->GetIndex(i));
+  };
+
+  if (this->submesh)
+  {
+    addSubMesh(this->submesh);
+  }
+  else
+  {
+    for (unsigned int i = 0; i < this->mesh->GetSubMeshCount(); ++i)
+      addSubMesh(this->mesh->GetSubMesh(i));
+  }
+
+  return true;
+}
+
 //////////////////////////////////////////////////
 void MeshShape::SetMesh(const std::string &_uri,
     const std::string &_submesh, bool _center)
@@ -18,6 +18,7 @@
 #define GAZEBO_PHYSICS_MESHSHAPE_HH_
 
 #include <string>
+#include <vector>
 
 #include "gazebo/common/CommonTypes.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
@@ -78,11 +79,40 @@ namespace gazebo
       /// \param[in] _msg Message that contains triangle mesh info.
       public: virtual void ProcessMsg(const msgs::Geometry &_msg);
 
+      /// \brief Get the triangles of the mesh, or of the submesh if one is
+      /// used, with the scale applied.
+      /// \param[out] _vertices Vertices in the frame of the collision.
+      /// \param[out] _indices Vertex indices, three per triangle.
+      /// \return False if no mesh is loaded.
+      public: bool Triangles(std::vector<ignition::math::Vector3d> &_vertices,
+                             std::vector<unsigned int> &_indices) const;
+
+      /// \brief Get whether the mesh was replaced by its convex
+      /// decomposition, which <ignition:convex_decomposition> asks for.
+      /// Each submesh of the mesh is then a closed convex hull, see
+      /// common::MeshManager::CreateConvexDecomposition.
+      /// \return True if the mesh is made of convex hulls.
+      public: bool IsConvexDecomposition() const;
+
+      /// \brief Get a key that identifies the collision data of this
+      /// shape: the mesh, the submesh and whether it's centered, and the
+      /// scale. Engines use it to share their collision data between
+      /// shapes with the same key.
+      /// \return The key, or an empty string if no mesh is loaded.
+      protected: std::string CollisionDataKey() const;
+
       /// \brief Pointer to the mesh data.
       protected: const common::Mesh *mesh;
 
       /// \brief The submesh to use from within the parent mesh.
       protected: common::SubMesh *submesh;
+
+      /// \brief True if the mesh is a convex decomposition.
+      protected: bool convexDecomposition = false;
+
+      /// \brief Name of the mesh the shape holds a reference to, see
+      /// common::MeshManager::AddReference.
+      private: std::string meshReference;
     };
     /// \}
   }
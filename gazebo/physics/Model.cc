@@ -30,12 +30,14 @@
 #include "gazebo/common/KeyFrame.hh"
 #include "gazebo/common/Animation.hh"
 #include "gazebo/common/Plugin.hh"
+#include "gazebo/common/PluginTiming.hh"
 #include "gazebo/common/Events.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/CommonTypes.hh"
 #include "gazebo/common/SdfFrameSemantics.hh"
+#include "gazebo/common/StartupTrace.hh"
 #include "gazebo/common/URI.hh"
 
 #include "gazebo/physics/Gripper.hh"
@@ -430,6 +432,85 @@ void Model::SetJointPositions(
     this->jointController->SetJointPositions(_jointPositions);
 }
 
+//////////////////////////////////////////////////
+unsigned int Model::JointStateCount() const
+{
+  unsigned int count = 0;
+  for (const auto &joint : this->joints)
+    count += joint->DOF();
+  return count;
+}
+
+//////////////////////////////////////////////////
+void Model::JointStates(std::vector<double> &_positions,
+    std::vector<double> &_velocities)
+{
+  const unsigned int count = this->JointStateCount();
+  _positions.resize(count);
+  _velocities.resize(count);
+
+  boost::recursive_mutex::scoped_lock lock(
+      *this->world->Physics()->GetPhysicsUpdateMutex());
+
+  unsigned int index = 0;
+  for (const auto &joint : this->joints)
+  {
+    for (unsigned int i = 0; i < joint->DOF(); ++i, ++index)
+    {
+      _positions[index] = joint->Position(i);
+      _velocities[index] = joint->GetVelocity(i);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+bool Model::SetJointStates(const std::vector<double> &_positions,
+    const std::vector<double> &_velocities)
+{
+  const unsigned int count = this->JointStateCount();
+  if ((!_positions.empty() && _positions.size() != count) ||
+      (!_velocities.empty() && _velocities.size() != count))
+  {
+    gzerr << "Model [" << this->GetScopedName() << "] has " << count
+          << " joint states, got " << _positions.size() << " positions and "
+          << _velocities.size() << " velocities\n";
+    return false;
+  }
+
+  boost::recursive_mutex::scoped_lock lock(
+      *this->world->Physics()->GetPhysicsUpdateMutex());
+
+  unsigned int index = 0;
+  for (const auto &joint : this->joints)
+  {
+    for (unsigned int i = 0; i < joint->DOF(); ++i, ++index)
+    {
+      if (!_positions.empty())
+        joint->SetPosition(i, _positions[index]);
+      if (!_velocities.empty())
+        joint->SetVelocity(i, _velocities[index]);
+    }
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+void Model::JointEfforts(std::vector<double> &_efforts)
+{
+  _efforts.resize(this->JointStateCount());
+
+  boost::recursive_mutex::scoped_lock lock(
+      *this->world->Physics()->GetPhysicsUpdateMutex());
+
+  unsigned int index = 0;
+  for (const auto &joint : this->joints)
+  {
+    for (unsigned int i = 0; i < joint->DOF(); ++i, ++index)
+      _efforts[index] = joint->GetForce(i);
+  }
+}
+
 //////////////////////////////////////////////////
 void Model::RemoveChild(EntityPtr _child)
 {
@@ -881,6 +962,10 @@ const Joint_V &Model::GetJoints() const
 //////////////////////////////////////////////////
 JointPtr Model::GetJoint(const std::string &_name)
 {
+  BasePtr indexed = this->IndexedChild(_name, JOINT);
+  if (indexed)
+    return boost::static_pointer_cast<Joint>(indexed);
+
   JointPtr result;
   Joint_V::iterator iter;
 
@@ -905,6 +990,10 @@ const Model_V &Model::NestedModels() const
 //////////////////////////////////////////////////
 ModelPtr Model::NestedModel(const std::string &_name) const
 {
+  BasePtr indexed = this->IndexedChild(_name, MODEL);
+  if (indexed)
+    return boost::static_pointer_cast<Model>(indexed);
+
   ModelPtr result;
 
   for (auto &m : this->models)
@@ -925,6 +1014,27 @@ LinkPtr Model::GetLinkById(unsigned int _id) const
   return boost::dynamic_pointer_cast<Link>(this->GetById(_id));
 }
 
+//////////////////////////////////////////////////
+BasePtr Model::IndexedChild(const std::string &_name,
+    const EntityType _type) const
+{
+  if (!this->world)
+    return BasePtr();
+
+  // _name may either be a scoped name or a name relative to this model.
+  BasePtr result = this->world->_BaseByScopedName(_name);
+  if (!result || result->GetParent().get() != this)
+  {
+    result = this->world->_BaseByScopedName(
+        this->GetScopedName() + "::" + _name);
+  }
+
+  if (result && result->HasType(_type) && result->GetParent().get() == this)
+    return result;
+
+  return BasePtr();
+}
+
 //////////////////////////////////////////////////
 const Link_V &Model::GetLinks() const
 {
@@ -941,6 +1051,10 @@ LinkPtr Model::GetLink(const std::string &_name) const
   {
     result = this->canonicalLink;
   }
+  else if (BasePtr indexed = this->IndexedChild(_name, LINK))
+  {
+    result = boost::static_pointer_cast<Link>(indexed);
+  }
   else
   {
     for (iter = this->links.begin(); iter != this->links.end(); ++iter)
@@ -1118,6 +1232,8 @@ void Model::LoadPlugin(sdf::ElementPtr _sdf)
   std::string pluginName = _sdf->Get<std::string>("name");
   std::string filename = _sdf->Get<std::string>("filename");
 
+  common::StartupTraceScope trace("Model::LoadPlugin", "plugin", filename);
+
   gazebo::ModelPluginPtr plugin;
 
   try
@@ -1151,6 +1267,10 @@ void Model::LoadPlugin(sdf::ElementPtr _sdf)
 
     ModelPtr myself = boost::static_pointer_cast<Model>(shared_from_this());
 
+    // Attribute the event callbacks connected by the plugin to it
+    const std::string timingName = this->GetScopedName() + "::" + pluginName;
+    common::PluginTimingScope timingScope(timingName);
+
     try
     {
       plugin->Load(myself, _sdf);
@@ -1188,6 +1308,20 @@ void Model::LoadPlugin(sdf::ElementPtr _sdf)
     }
 
     this->plugins.push_back(plugin);
+
+    // Cumulative and longest callback times, in seconds
+    auto timing = common::PluginTiming::Get(timingName);
+    common::URI timeURI(this->URI());
+    timeURI.Query().Insert("p", "double/plugin_" + pluginName + "_time");
+    this->introspectionItems.push_back(timeURI);
+    util::IntrospectionManager::Instance()->Register<double>(timeURI.Str(),
+        [timing]() {return timing->TotalTime() * 1e-9;});
+
+    common::URI maxURI(this->URI());
+    maxURI.Query().Insert("p", "double/plugin_" + pluginName + "_max_time");
+    this->introspectionItems.push_back(maxURI);
+    util::IntrospectionManager::Instance()->Register<double>(maxURI.Str(),
+        [timing]() {return timing->MaxTime() * 1e-9;});
   }
 }
 
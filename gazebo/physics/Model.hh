@@ -262,6 +262,40 @@ namespace gazebo
       public: void SetJointPositions(
                   const std::map<std::string, double> &_jointPositions);
 
+      /// \brief Get the number of joint states of the model, which is the
+      /// sum of the DOF of its joints.
+      /// \return Number of joint states.
+      /// \sa JointStates
+      public: unsigned int JointStateCount() const;
+
+      /// \brief Get the positions and velocities of all joints in one
+      /// call. The states are ordered like GetJoints(), with the axes of
+      /// each joint next to each other. The physics engine is locked once
+      /// for the whole read.
+      /// \param[out] _positions Joint positions, resized to
+      /// JointStateCount().
+      /// \param[out] _velocities Joint velocities, resized to
+      /// JointStateCount().
+      public: virtual void JointStates(std::vector<double> &_positions,
+                  std::vector<double> &_velocities);
+
+      /// \brief Set the positions and velocities of all joints in one
+      /// call. The states are ordered like in JointStates. The physics
+      /// engine is locked once for the whole write.
+      /// \param[in] _positions Joint positions. Can be empty to only set
+      /// the velocities.
+      /// \param[in] _velocities Joint velocities. Can be empty to only set
+      /// the positions.
+      /// \return False if a vector isn't empty and its size is not
+      /// JointStateCount().
+      public: virtual bool SetJointStates(const std::vector<double> &_positions,
+                  const std::vector<double> &_velocities);
+
+      /// \brief Get the efforts applied to all joints through
+      /// Joint::SetForce in one call, ordered like in JointStates.
+      /// \param[out] _efforts Joint efforts, resized to JointStateCount().
+      public: void JointEfforts(std::vector<double> &_efforts);
+
       /// \brief Joint Animation.
       /// \param[in] _anim Map of joint names to their position animation.
       /// \param[in] _onComplete Callback function for when the animation
@@ -514,6 +548,14 @@ namespace gazebo
       /// \param[in] _name Name of the link to remove.
       private: void RemoveLink(const std::string &_name);
 
+      /// \brief Find a direct child of this model using the world's scoped
+      /// name index.
+      /// \param[in] _name Scoped name, or name relative to this model.
+      /// \param[in] _type Type the child must have.
+      /// \return The child, or nullptr if it isn't in the index.
+      private: BasePtr IndexedChild(const std::string &_name,
+                                    const EntityType _type) const;
+
       /// \brief Publish the scale.
       private: virtual void PublishScale();
 
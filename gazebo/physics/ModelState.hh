@@ -299,6 +299,9 @@ namespace gazebo
 
       /// \brief All the model states.
       private: ModelState_M modelStates;
+
+      /// Friend WorldStateBuffer so that it can fill states from snapshots
+      private: friend class WorldStateBuffer;
     };
     /// \}
   }
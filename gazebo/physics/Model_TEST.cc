@@ -15,6 +15,9 @@
  *
 */
 
+#include <sstream>
+#include <vector>
+
 #include <ignition/msgs/plugin_v.pb.h>
 
 #include "gazebo/test/ServerFixture.hh"
@@ -240,6 +243,16 @@ TEST_F(ModelTest, BoundingBox)
   EXPECT_EQ(
       ignition::math::AxisAlignedBox(-10.5, -20.5, -30.5, -9.5, -19.5, -29.5),
       model->BoundingBox());
+
+  // The cached link boxes follow the model when it moves
+  model->SetWorldPose(ignition::math::Pose3d(1, 2, 3, 0, 0, 0));
+  EXPECT_EQ(ignition::math::AxisAlignedBox(0.5, 1.5, 2.5, 1.5, 2.5, 3.5),
+      model->BoundingBox());
+
+  // and when it is scaled
+  model->SetScale(ignition::math::Vector3d(2, 2, 2));
+  EXPECT_EQ(ignition::math::AxisAlignedBox(0, 1, 2, 2, 3, 4),
+      model->BoundingBox());
 }
 
 //////////////////////////////////////////////////
@@ -279,6 +292,70 @@ TEST_F(ModelTest, StripScopedName)
   EXPECT_EQ(model->GetName(), model->StripScopedName(model->GetName()));
 }
 
+//////////////////////////////////////////////////
+TEST_F(ModelTest, JointStates)
+{
+  this->Load("worlds/empty.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+  world->SetGravity(ignition::math::Vector3d::Zero);
+
+  // Floating chain of three links and two hinges
+  std::ostringstream sdfStr;
+  sdfStr << "<sdf version='" << SDF_VERSION << "'>"
+    << "<model name='chain'>"
+    << "  <pose>0 0 2 0 0 0</pose>";
+  for (int i = 0; i < 3; ++i)
+  {
+    sdfStr << "<link name='link_" << i << "'>"
+      << "  <pose>" << 0.5 * i << " 0 0 0 0 0</pose>"
+      << "  <collision name='collision'>"
+      << "    <geometry><sphere><radius>0.1</radius></sphere></geometry>"
+      << "  </collision>"
+      << "</link>";
+  }
+  for (int i = 0; i < 2; ++i)
+  {
+    sdfStr << "<joint name='joint_" << i << "' type='revolute'>"
+      << "  <parent>link_" << i << "</parent>"
+      << "  <child>link_" << i + 1 << "</child>"
+      << "  <axis><xyz>0 0 1</xyz></axis>"
+      << "</joint>";
+  }
+  sdfStr << "</model>"
+    << "</sdf>";
+  world->InsertModelString(sdfStr.str());
+
+  int sleep = 0;
+  while (!world->ModelByName("chain") && sleep++ < 100)
+  {
+    world->Step(1);
+    common::Time::MSleep(10);
+  }
+  auto model = world->ModelByName("chain");
+  ASSERT_TRUE(model != nullptr);
+  ASSERT_EQ(model->JointStateCount(), 2u);
+
+  std::vector<double> positions;
+  std::vector<double> velocities;
+  model->JointStates(positions, velocities);
+  ASSERT_EQ(positions.size(), 2u);
+  ASSERT_EQ(velocities.size(), 2u);
+  EXPECT_NEAR(positions[0], 0.0, 1e-6);
+  EXPECT_NEAR(positions[1], 0.0, 1e-6);
+
+  // Wrong sizes are rejected
+  EXPECT_FALSE(model->SetJointStates({1.0}, {}));
+
+  // Positions only
+  EXPECT_TRUE(model->SetJointStates({0.3, -0.2}, {}));
+  model->JointStates(positions, velocities);
+  EXPECT_NEAR(positions[0], 0.3, 1e-6);
+  EXPECT_NEAR(positions[1], -0.2, 1e-6);
+  EXPECT_NEAR(positions[0], model->GetJoint("joint_0")->Position(0), 1e-9);
+  EXPECT_NEAR(positions[1], model->GetJoint("joint_1")->Position(0), 1e-9);
+}
+
 //////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -15,11 +15,15 @@
  *
 */
 
+#include <algorithm>
+#include <limits>
+
 #include <boost/lexical_cast.hpp>
 
 #include <sdf/sdf.hh>
 
 #include "gazebo/msgs/msgs.hh"
+#include "gazebo/common/Assert.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Events.hh"
@@ -33,6 +37,7 @@
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/PhysicsEngine.hh"
 #include "gazebo/physics/PresetManager.hh"
+#include "gazebo/physics/RayShape.hh"
 
 using namespace gazebo;
 using namespace physics;
@@ -305,6 +310,49 @@ bool PhysicsEngine::GetParam(const std::string &_key,
   return true;
 }
 
+//////////////////////////////////////////////////
+void PhysicsEngine::CastRays(
+    const std::vector<ignition::math::Vector3d> &_origins,
+    const std::vector<ignition::math::Vector3d> &_directions,
+    const double _length, std::vector<double> &_distances,
+    std::vector<uint32_t> &_entityIds)
+{
+  GZ_ASSERT(_origins.size() == _directions.size(),
+      "Origins and directions must have the same size");
+
+  const size_t count = std::min(_origins.size(), _directions.size());
+  _distances.assign(count, std::numeric_limits<double>::infinity());
+  _entityIds.assign(count, 0);
+  if (count == 0)
+    return;
+
+  RayShapePtr ray = boost::dynamic_pointer_cast<RayShape>(
+      this->CreateShape("ray", CollisionPtr()));
+  if (!ray)
+  {
+    gzerr << "Unable to create a ray shape, rays not cast\n";
+    return;
+  }
+
+  double dist;
+  std::string entity;
+  for (size_t i = 0; i < count; ++i)
+  {
+    ray->SetPoints(_origins[i], _origins[i] + _directions[i] * _length);
+    entity.clear();
+    ray->GetIntersection(dist, entity);
+    if (entity.empty() || dist > _length)
+      continue;
+
+    BasePtr hit = this->world->BaseByName(entity);
+    if (!hit)
+      continue;
+
+    _distances[i] = dist;
+    _entityIds[i] = hit->GetId();
+  }
+}
+
 //////////////////////////////////////////////////
 ContactManager *PhysicsEngine::GetContactManager() const
 {
@@ -19,7 +19,10 @@
 
 #include <boost/thread/recursive_mutex.hpp>
 #include <boost/any.hpp>
+#include <cstdint>
 #include <string>
+#include <vector>
+#include <ignition/math/Vector3.hh>
 #include <ignition/transport/Node.hh>
 
 #include "gazebo/transport/TransportTypes.hh"
@@ -235,6 +238,24 @@ namespace gazebo
       public: virtual bool GetParam(const std::string &_key,
                   boost::any &_value) const;
 
+      /// \brief Cast a batch of rays against the collisions of the world.
+      /// Engines may override it to cast the rays in parallel; the default
+      /// implementation casts them one at a time with a stand alone ray
+      /// shape.
+      /// \param[in] _origins Start point of each ray, in world frame.
+      /// \param[in] _directions Unit direction of each ray, in world frame.
+      /// Must have the same size as _origins.
+      /// \param[in] _length Length of the rays.
+      /// \param[out] _distances Distance from the origin to the closest hit
+      /// of each ray, or infinity if the ray hit nothing.
+      /// \param[out] _entityIds Id of the collision hit by each ray, or 0 if
+      /// the ray hit nothing.
+      public: virtual void CastRays(
+                  const std::vector<ignition::math::Vector3d> &_origins,
+                  const std::vector<ignition::math::Vector3d> &_directions,
+                  const double _length, std::vector<double> &_distances,
+                  std::vector<uint32_t> &_entityIds);
+
       /// \brief Debug print out of the physic engine state.
       public: virtual void DebugPrint() const = 0;
 
@@ -16,6 +16,7 @@
 */
 
 #include <boost/thread/mutex.hpp>
+#include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/physics/World.hh"
@@ -78,6 +79,12 @@ physics::WorldPtr physics::get_world(const std::string &_name)
   gzthrow("Unable to find world by name in physics::get_world(world_name)");
 }
 
+/////////////////////////////////////////////////
+std::vector<physics::WorldPtr> physics::get_worlds()
+{
+  return g_worlds;
+}
+
 /////////////////////////////////////////////////
 bool physics::has_world(const std::string &_name)
 {
@@ -203,3 +210,51 @@ uint32_t physics::getUniqueId()
   boost::mutex::scoped_lock lock(g_uniqueIdMutex);
   return ++g_uniqueId;
 }
+
+/////////////////////////////////////////////////
+void physics::collect_mesh_files(sdf::ElementPtr _elem,
+    std::vector<std::string> &_files)
+{
+  if (_elem->GetName() == "actor")
+  {
+    if (_elem->HasElement("skin"))
+    {
+      _files.push_back(
+          _elem->GetElement("skin")->Get<std::string>("filename"));
+    }
+
+    for (sdf::ElementPtr anim = _elem->HasElement("animation") ?
+         _elem->GetElement("animation") : sdf::ElementPtr(); anim;
+         anim = anim->GetNextElement("animation"))
+    {
+      // BVH animations aren't meshes, MeshManager skips them
+      _files.push_back(anim->Get<std::string>("filename"));
+    }
+  }
+
+  if (_elem->GetName() == "collision")
+  {
+    if (!_elem->HasElement("geometry"))
+      return;
+
+    sdf::ElementPtr geomElem = _elem->GetElement("geometry");
+    if (!geomElem->HasElement("mesh"))
+      return;
+
+    sdf::ElementPtr meshElem = geomElem->GetElement("mesh");
+    if (!meshElem->HasElement("uri"))
+      return;
+
+    std::string filename = common::find_file(common::asFullPath(
+        meshElem->Get<std::string>("uri"), meshElem->FilePath()));
+    if (!filename.empty() && filename != "__default__")
+      _files.push_back(filename);
+    return;
+  }
+
+  for (sdf::ElementPtr child = _elem->GetFirstElement(); child;
+       child = child->GetNextElement())
+  {
+    collect_mesh_files(child, _files);
+  }
+}
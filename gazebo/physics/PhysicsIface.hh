@@ -18,6 +18,7 @@
 #define _PHYSICSIFACE_HH_
 
 #include <string>
+#include <vector>
 #include <sdf/sdf.hh>
 
 #include "gazebo/physics/PhysicsTypes.hh"
@@ -52,6 +53,11 @@ namespace gazebo
     GZ_PHYSICS_VISIBLE
     WorldPtr get_world(const std::string &_name = "");
 
+    /// \brief Get all the worlds.
+    /// \return Pointers to the worlds, in the order they were created.
+    GZ_PHYSICS_VISIBLE
+    std::vector<WorldPtr> get_worlds();
+
     /// \brief checks if the world with this name exists.
     /// Can be used to check if get_world(const std::string&)
     /// will succeed or throw an exception.
@@ -142,6 +148,17 @@ namespace gazebo
     GZ_PHYSICS_VISIBLE
     bool worlds_running();
 
+    /// \brief Collect the mesh files the server parses when it loads an
+    /// SDF tree: collision meshes, named the way MeshShape looks them up,
+    /// and actor skins and animations, named the way Actor looks them up.
+    /// Passing them to common::MeshManager first lets them be parsed
+    /// together, or once before the server forks.
+    /// \param[in] _elem Element to search.
+    /// \param[out] _files Mesh files found are appended to this list.
+    GZ_PHYSICS_VISIBLE
+    void collect_mesh_files(sdf::ElementPtr _elem,
+                            std::vector<std::string> &_files);
+
     /// \brief Get a unique ID
     /// \return A unique integer
     GZ_PHYSICS_VISIBLE
@@ -48,6 +48,8 @@ namespace gazebo
     class JointController;
     class Contact;
     class PresetManager;
+    class BatterySystem;
+    class SleepManager;
     class UserCmd;
     class UserCmdManager;
     class PhysicsEngine;
@@ -70,6 +72,10 @@ namespace gazebo
     class ModelState;
     class LightState;
     class LinkState;
+    class LinkKinematicsCache;
+    class SpatialIndex;
+    class ProximityIndex;
+    class CollisionQuery;
     class JointState;
     class TrajectoryInfo;
 
@@ -129,6 +135,14 @@ namespace gazebo
     /// \brief Shared pointer to a PresetManager object
     typedef boost::shared_ptr<PresetManager> PresetManagerPtr;
 
+    /// \def  BatterySystemPtr
+    /// \brief Shared pointer to a BatterySystem object
+    typedef boost::shared_ptr<BatterySystem> BatterySystemPtr;
+
+    /// \def  SleepManagerPtr
+    /// \brief Shared pointer to a SleepManager object
+    typedef boost::shared_ptr<SleepManager> SleepManagerPtr;
+
     /// \def  UserCmdPtr
     /// \brief Shared pointer to a UserCmd object
     typedef std::shared_ptr<UserCmd> UserCmdPtr;
@@ -15,10 +15,9 @@
  *
  */
 
-#include <boost/lexical_cast.hpp>
+#include <string>
 
 #include "gazebo/physics/PolylineShape.hh"
-#include "gazebo/physics/PhysicsIface.hh"
 #include "gazebo/common/MeshManager.hh"
 #include "gazebo/common/Console.hh"
 
@@ -42,9 +41,10 @@ void PolylineShape::Init()
 {
   this->SetPolylineShape(this->GetHeight(), this->Vertices());
 
-  std::string meshName =
-      boost::lexical_cast<std::string>(physics::getUniqueId()) +
-      "_extruded_polyline";
+  // Identical polylines, such as the visual of this collision, share one
+  // triangulation
+  std::string meshName = common::MeshManager::ExtrudedPolylineMeshName(
+      this->Vertices(), this->GetHeight());
 
   common::MeshManager::Instance()->CreateExtrudedPolyline(
       meshName, this->Vertices(), this->GetHeight());
@@ -0,0 +1,459 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include <ann/ANN.h>
+#include <boost/weak_ptr.hpp>
+#include <ignition/math/Helpers.hh>
+
+#include "gazebo/common/Assert.hh"
+#include "gazebo/physics/Link.hh"
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/World.hh"
+#include "gazebo/physics/ProximityIndex.hh"
+
+/// \brief Models whose bounding sphere is larger than this, such as
+/// ground planes, are kept out of the tree. Radius queries check them all.
+static const double kMaxTreeRadius = 50.0;
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \brief A model in the index.
+    class ProximityIndexItem
+    {
+      /// \brief The model, only used to hand it out to callers.
+      public: boost::weak_ptr<Model> model;
+
+      /// \brief Origin of the model in world coordinates.
+      public: ignition::math::Vector3d center;
+
+      /// \brief Radius of the bounding sphere around the origin.
+      public: double radius = 0.0;
+    };
+
+    /// \brief Private data for the ProximityIndex class
+    class ProximityIndexPrivate
+    {
+      /// \brief Walk the world and read every model.
+      /// \param[in] _world World to walk.
+      public: void Rebuild(const WorldPtr &_world);
+
+      /// \brief Read the position and bounding sphere of a model.
+      /// \param[in] _index Index of the item.
+      /// \param[in] _model Model of the item.
+      public: void Read(const size_t _index, const Model *_model);
+
+      /// \brief Rebuild the kd-tree if positions changed since it was
+      /// built. The mutex must be held.
+      public: void BuildTree();
+
+      /// \brief Models in the index.
+      public: std::vector<ProximityIndexItem> items;
+
+      /// \brief Map from model to index in items.
+      public: std::unordered_map<const Model *, size_t> indices;
+
+      /// \brief Top level models flagged with MarkDirty. Only used as keys
+      /// into indices.
+      public: std::unordered_set<const Model *> dirty;
+
+      /// \brief Coordinates of the tree points, three per point.
+      public: std::vector<ANNcoord> coords;
+
+      /// \brief Points of the tree, pointing into coords.
+      public: std::vector<ANNpoint> points;
+
+      /// \brief Index in items of each tree point.
+      public: std::vector<size_t> treeItems;
+
+      /// \brief Items too large for the tree.
+      public: std::vector<size_t> oversized;
+
+      /// \brief Tree over the item centers, null when it has no points.
+      public: std::unique_ptr<ANNkd_tree> tree;
+
+      /// \brief Largest radius of an item in the tree.
+      public: double maxRadius = 0.0;
+
+      /// \brief True if items changed since the tree was built.
+      public: bool stale = true;
+
+      /// \brief Entity version the index was built from.
+      public: uint64_t version = 0;
+
+      /// \brief True once the index has been built.
+      public: bool built = false;
+
+      /// \brief Protects the index against queries from other threads.
+      public: std::mutex mutex;
+    };
+  }
+}
+
+using namespace gazebo;
+using namespace physics;
+
+/// \brief ANN keeps the state of a search in globals, so searches of all
+/// the trees must be serialized.
+/// \return Mutex held while searching.
+static std::mutex &AnnMutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+/// \brief Get the top level model of an entity.
+/// \param[in] _entity A model or a link.
+/// \return The top level model, or nullptr.
+static const Model *TopModel(const Entity *_entity)
+{
+  const Base *base = _entity;
+  if (base && base->HasType(Base::LINK))
+    base = base->GetParent().get();
+
+  if (!base || !base->HasType(Base::MODEL))
+    return nullptr;
+
+  BasePtr parent = base->GetParent();
+  while (parent && parent->HasType(Base::MODEL))
+  {
+    base = parent.get();
+    parent = base->GetParent();
+  }
+  return static_cast<const Model *>(base);
+}
+
+/////////////////////////////////////////////////
+void ProximityIndexPrivate::Read(const size_t _index, const Model *_model)
+{
+  ProximityIndexItem &item = this->items[_index];
+  item.center = _model->WorldPose().Pos();
+  item.radius = 0.0;
+
+  std::vector<const Model *> stack = {_model};
+  while (!stack.empty())
+  {
+    const Model *model = stack.back();
+    stack.pop_back();
+    item.radius = std::max(item.radius,
+        item.center.Distance(model->WorldPose().Pos()));
+
+    // Farthest corner of the collision box, skipping empty boxes
+    const auto box = model->BoundingBox();
+    if (box.Min().X() <= box.Max().X() && box.Min().Y() <= box.Max().Y() &&
+        box.Min().Z() <= box.Max().Z())
+    {
+      ignition::math::Vector3d corner;
+      for (unsigned int i = 0; i < 3; ++i)
+      {
+        corner[i] = std::max(std::abs(box.Min()[i] - item.center[i]),
+                             std::abs(box.Max()[i] - item.center[i]));
+      }
+      item.radius = std::max(item.radius, corner.Length());
+    }
+
+    for (const auto &link : model->GetLinks())
+    {
+      item.radius = std::max(item.radius,
+          item.center.Distance(link->WorldPose().Pos()));
+    }
+    for (const auto &nested : model->NestedModels())
+      stack.push_back(nested.get());
+  }
+
+  if (!std::isfinite(item.radius))
+    item.radius = ignition::math::INF_D;
+}
+
+/////////////////////////////////////////////////
+void ProximityIndexPrivate::Rebuild(const WorldPtr &_world)
+{
+  this->items.clear();
+  this->indices.clear();
+  this->dirty.clear();
+
+  for (const auto &model : _world->Models())
+  {
+    this->indices[model.get()] = this->items.size();
+    ProximityIndexItem item;
+    item.model = model;
+    this->items.push_back(item);
+    this->Read(this->items.size() - 1, model.get());
+  }
+  this->stale = true;
+}
+
+/////////////////////////////////////////////////
+void ProximityIndexPrivate::BuildTree()
+{
+  if (!this->stale)
+    return;
+  this->stale = false;
+
+  // The tree sorts the point pointers in place, so it's rebuilt from
+  // scratch rather than updated.
+  std::lock_guard<std::mutex> annLock(AnnMutex());
+  this->tree.reset();
+  this->coords.clear();
+  this->points.clear();
+  this->treeItems.clear();
+  this->oversized.clear();
+  this->maxRadius = 0.0;
+
+  for (size_t i = 0; i < this->items.size(); ++i)
+  {
+    const ProximityIndexItem &item = this->items[i];
+    if (item.radius > kMaxTreeRadius || !item.center.IsFinite())
+    {
+      this->oversized.push_back(i);
+      continue;
+    }
+
+    this->treeItems.push_back(i);
+    this->coords.push_back(item.center.X());
+    this->coords.push_back(item.center.Y());
+    this->coords.push_back(item.center.Z());
+    this->maxRadius = std::max(this->maxRadius, item.radius);
+  }
+
+  if (this->treeItems.empty())
+    return;
+
+  for (size_t i = 0; i < this->treeItems.size(); ++i)
+    this->points.push_back(&this->coords[i * 3]);
+
+  this->tree.reset(new ANNkd_tree(this->points.data(),
+      static_cast<int>(this->points.size()), 3));
+}
+
+/////////////////////////////////////////////////
+ProximityIndex::ProximityIndex()
+  : dataPtr(new ProximityIndexPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+ProximityIndex::~ProximityIndex()
+{
+}
+
+/////////////////////////////////////////////////
+void ProximityIndex::MarkDirty(const Entity *_entity)
+{
+  const Model *model = TopModel(_entity);
+  if (!model)
+    return;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (this->dataPtr->built)
+    this->dataPtr->dirty.insert(model);
+}
+
+/////////////////////////////////////////////////
+void ProximityIndex::Update(const WorldPtr &_world,
+    const uint64_t _entityVersion)
+{
+  GZ_ASSERT(_world, "World pointer is invalid");
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  if (!this->dataPtr->built || this->dataPtr->version != _entityVersion)
+  {
+    this->dataPtr->Rebuild(_world);
+    this->dataPtr->version = _entityVersion;
+    this->dataPtr->built = true;
+    return;
+  }
+
+  // Models are only dereferenced after checking that they are still in
+  // the index, which is the case as long as the entity version is
+  // unchanged.
+  for (const auto model : this->dataPtr->dirty)
+  {
+    auto iter = this->dataPtr->indices.find(model);
+    if (iter == this->dataPtr->indices.end())
+      continue;
+
+    this->dataPtr->Read(iter->second, model);
+    this->dataPtr->stale = true;
+  }
+  this->dataPtr->dirty.clear();
+}
+
+/////////////////////////////////////////////////
+void ProximityIndex::Clear()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->items.clear();
+  this->dataPtr->indices.clear();
+  this->dataPtr->dirty.clear();
+  this->dataPtr->built = false;
+  this->dataPtr->stale = true;
+  this->dataPtr->BuildTree();
+}
+
+/////////////////////////////////////////////////
+bool ProximityIndex::Built() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->built;
+}
+
+/////////////////////////////////////////////////
+size_t ProximityIndex::Size() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->items.size();
+}
+
+/////////////////////////////////////////////////
+std::vector<ModelPtr> ProximityIndex::NearestModels(
+    const ignition::math::Vector3d &_pt, const unsigned int _k) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->BuildTree();
+
+  // Candidates from the tree, then the oversized items
+  std::vector<std::pair<double, size_t>> found;
+  const int k = static_cast<int>(std::min(static_cast<size_t>(_k),
+      this->dataPtr->treeItems.size()));
+  if (k > 0)
+  {
+    std::vector<ANNidx> idx(k);
+    std::vector<ANNdist> dist(k);
+    ANNcoord query[3] = {_pt.X(), _pt.Y(), _pt.Z()};
+    {
+      std::lock_guard<std::mutex> annLock(AnnMutex());
+      this->dataPtr->tree->annkSearch(query, k, idx.data(), dist.data());
+    }
+    for (int i = 0; i < k; ++i)
+    {
+      if (idx[i] != ANN_NULL_IDX)
+      {
+        found.push_back(std::make_pair(std::sqrt(dist[i]),
+            this->dataPtr->treeItems[idx[i]]));
+      }
+    }
+  }
+  for (const auto index : this->dataPtr->oversized)
+  {
+    found.push_back(std::make_pair(
+        _pt.Distance(this->dataPtr->items[index].center), index));
+  }
+  std::stable_sort(found.begin(), found.end(),
+      [](const std::pair<double, size_t> &_a,
+         const std::pair<double, size_t> &_b)
+      {
+        return _a.first < _b.first;
+      });
+
+  std::vector<ModelPtr> result;
+  for (const auto &candidate : found)
+  {
+    if (result.size() >= _k)
+      break;
+
+    ModelPtr model = this->dataPtr->items[candidate.second].model.lock();
+    if (model)
+      result.push_back(model);
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////
+std::vector<ModelPtr> ProximityIndex::ModelsInRadius(
+    const ignition::math::Vector3d &_pt, const double _radius) const
+{
+  std::vector<ModelPtr> result;
+  if (_radius < 0.0)
+    return result;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->BuildTree();
+
+  // The tree holds centers, so widen the search by the largest sphere and
+  // check each sphere afterwards.
+  std::vector<std::pair<double, size_t>> found;
+  if (this->dataPtr->tree)
+  {
+    const double reach = _radius + this->dataPtr->maxRadius;
+    ANNcoord query[3] = {_pt.X(), _pt.Y(), _pt.Z()};
+
+    std::lock_guard<std::mutex> annLock(AnnMutex());
+    const int count = this->dataPtr->tree->annkFRSearch(query,
+        reach * reach, 0);
+    if (count > 0)
+    {
+      std::vector<ANNidx> idx(count);
+      std::vector<ANNdist> dist(count);
+      this->dataPtr->tree->annkFRSearch(query, reach * reach, count,
+          idx.data(), dist.data());
+      for (int i = 0; i < count; ++i)
+      {
+        if (idx[i] != ANN_NULL_IDX)
+        {
+          found.push_back(std::make_pair(std::sqrt(dist[i]),
+              this->dataPtr->treeItems[idx[i]]));
+        }
+      }
+    }
+  }
+  for (const auto index : this->dataPtr->oversized)
+  {
+    found.push_back(std::make_pair(
+        _pt.Distance(this->dataPtr->items[index].center), index));
+  }
+  std::stable_sort(found.begin(), found.end(),
+      [](const std::pair<double, size_t> &_a,
+         const std::pair<double, size_t> &_b)
+      {
+        return _a.first < _b.first;
+      });
+
+  for (const auto &candidate : found)
+  {
+    const ProximityIndexItem &item = this->dataPtr->items[candidate.second];
+    if (candidate.first - item.radius > _radius)
+      continue;
+
+    ModelPtr model = item.model.lock();
+    if (model)
+      result.push_back(model);
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////
+bool ProximityIndex::BoundingSphere(const Model *_model,
+    ignition::math::Vector3d &_center, double &_radius) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto iter = this->dataPtr->indices.find(_model);
+  if (iter == this->dataPtr->indices.end())
+    return false;
+
+  _center = this->dataPtr->items[iter->second].center;
+  _radius = this->dataPtr->items[iter->second].radius;
+  return true;
+}
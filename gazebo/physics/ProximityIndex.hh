@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_PROXIMITYINDEX_HH_
+#define GAZEBO_PHYSICS_PROXIMITYINDEX_HH_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    // Forward declare private data class
+    class ProximityIndexPrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class ProximityIndex ProximityIndex.hh physics/physics.hh
+    /// \brief Kd-tree over the positions of the top level models of a
+    /// world, for nearest neighbor and radius queries.
+    ///
+    /// Each model is a point at the origin of its world pose, with a
+    /// bounding sphere around it that covers its collisions, links and
+    /// nested models. Radius queries use the spheres, so that a model is
+    /// found as soon as any part of it may be within range.
+    ///
+    /// When enabled with World::SetProximityIndexEnabled, the world
+    /// refreshes the positions from World::ProcessMessages, only for the
+    /// models whose pose changed. The tree itself is rebuilt by the first
+    /// query after a change. Queries can be made from any thread and
+    /// return the models as of the last refresh.
+    class GZ_PHYSICS_VISIBLE ProximityIndex
+    {
+      /// \brief Constructor.
+      public: ProximityIndex();
+
+      /// \brief Destructor.
+      public: ~ProximityIndex();
+
+      /// \brief Flag a model whose pose changed. Nested models and links
+      /// flag their top level model.
+      /// \param[in] _entity A model or a link.
+      public: void MarkDirty(const Entity *_entity);
+
+      /// \brief Refresh the positions. Must be called from the world
+      /// update thread.
+      /// \param[in] _world World the models belong to.
+      /// \param[in] _entityVersion Counter that changes whenever an entity
+      /// is added to or removed from the world. All models are read again
+      /// when it differs from the value of the last update, otherwise only
+      /// the models flagged with MarkDirty are.
+      public: void Update(const WorldPtr &_world,
+                          const uint64_t _entityVersion);
+
+      /// \brief Remove all models from the index.
+      public: void Clear();
+
+      /// \brief Check if the index was built since it was last cleared.
+      /// \return True once Update has been called.
+      public: bool Built() const;
+
+      /// \brief Number of models in the index.
+      /// \return Number of models.
+      public: size_t Size() const;
+
+      /// \brief Get the models whose origin is nearest to a point.
+      /// \param[in] _pt Point in world coordinates.
+      /// \param[in] _k Largest number of models returned.
+      /// \return Up to _k models, nearest first.
+      public: std::vector<ModelPtr> NearestModels(
+                  const ignition::math::Vector3d &_pt,
+                  const unsigned int _k) const;
+
+      /// \brief Get the models whose bounding sphere is within a distance
+      /// of a point.
+      /// \param[in] _pt Point in world coordinates.
+      /// \param[in] _radius Search radius in meters.
+      /// \return Models in range, sorted by the distance to their origin.
+      public: std::vector<ModelPtr> ModelsInRadius(
+                  const ignition::math::Vector3d &_pt,
+                  const double _radius) const;
+
+      /// \brief Get the bounding sphere of a model, as stored in the index.
+      /// \param[in] _model A top level model.
+      /// \param[out] _center Origin of the model in world coordinates.
+      /// \param[out] _radius Radius of the sphere around the origin.
+      /// \return True if the model is in the index.
+      public: bool BoundingSphere(const Model *_model,
+                  ignition::math::Vector3d &_center, double &_radius) const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<ProximityIndexPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -19,6 +19,7 @@
 #include <string>
 #include <vector>
 
+#include "gazebo/common/MeshManager.hh"
 #include "gazebo/transport/transport.hh"
 #include "gazebo/physics/Road.hh"
 #include "gazebo/msgs/msgs.hh"
@@ -99,12 +100,14 @@ void Road::Init()
       }
     }
   }
+  this->points.clear();
   sdf::ElementPtr pointElem = this->sdf->GetElement("point");
   while (pointElem)
   {
     ignition::math::Vector3d point = pointElem->Get<ignition::math::Vector3d>();
     pointElem = pointElem->GetNextElement("point");
 
+    this->points.push_back(point);
     msgs::Vector3d *ptMsg = msg.add_point();
     msgs::Set(ptMsg, point);
   }
@@ -123,3 +126,13 @@ double Road::GetWidth() const
 {
   return this->width;
 }
+
+/////////////////////////////////////////////////
+const common::Mesh *Road::Mesh() const
+{
+  common::MeshManager *meshManager = common::MeshManager::Instance();
+  std::string meshName =
+      common::MeshManager::RoadMeshName(this->points, this->width);
+  meshManager->CreateRoad(meshName, this->points, this->width);
+  return meshManager->GetMesh(meshName);
+}
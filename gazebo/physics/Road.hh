@@ -24,6 +24,7 @@
 #include <ignition/math/Vector3.hh>
 #include <ignition/transport/Node.hh>
 
+#include "gazebo/common/CommonTypes.hh"
 #include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/physics/Base.hh"
 #include "gazebo/util/system.hh"
@@ -64,6 +65,13 @@ namespace gazebo
       /// \return Road width in meters.
       public: double GetWidth() const;
 
+      /// \brief Get the mesh of the road, built on the first call. It is
+      /// the mesh rendering::Road2d shows, shared through
+      /// common::MeshManager, so it can be exported or used by sensors in
+      /// the same process without building it again.
+      /// \return The mesh, null if the road has fewer than two points.
+      public: const common::Mesh *Mesh() const;
+
       /// \brief Width of the road.
       private: double width;
 
@@ -0,0 +1,341 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include "gazebo/common/Assert.hh"
+#include "gazebo/physics/Collision.hh"
+#include "gazebo/physics/Contact.hh"
+#include "gazebo/physics/ContactManager.hh"
+#include "gazebo/physics/Link.hh"
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/PhysicsEngine.hh"
+#include "gazebo/physics/World.hh"
+#include "gazebo/physics/SleepManager.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+/// \brief Get the model that owns an entity.
+/// \param[in] _entity A model, link or collision.
+/// \return The model, or nullptr for other entity types.
+static const Model *OwnerModel(const Entity *_entity)
+{
+  if (!_entity)
+    return nullptr;
+
+  if (_entity->HasType(Base::MODEL))
+    return static_cast<const Model *>(_entity);
+  if (_entity->HasType(Base::LINK))
+    return static_cast<const Link *>(_entity)->GetModel().get();
+  if (_entity->HasType(Base::COLLISION))
+    return static_cast<const Collision *>(_entity)->GetModel().get();
+
+  return nullptr;
+}
+
+/////////////////////////////////////////////////
+void SleepManager::SetEnabled(const bool _enable)
+{
+  this->enabled = _enable;
+}
+
+/////////////////////////////////////////////////
+bool SleepManager::Enabled() const
+{
+  return this->enabled;
+}
+
+/////////////////////////////////////////////////
+void SleepManager::SetLinearVelocityThreshold(const double _threshold)
+{
+  this->linearThreshold = _threshold;
+}
+
+/////////////////////////////////////////////////
+double SleepManager::LinearVelocityThreshold() const
+{
+  return this->linearThreshold;
+}
+
+/////////////////////////////////////////////////
+void SleepManager::SetAngularVelocityThreshold(const double _threshold)
+{
+  this->angularThreshold = _threshold;
+}
+
+/////////////////////////////////////////////////
+double SleepManager::AngularVelocityThreshold() const
+{
+  return this->angularThreshold;
+}
+
+/////////////////////////////////////////////////
+void SleepManager::SetTimeThreshold(const double _time)
+{
+  this->timeThreshold = _time;
+}
+
+/////////////////////////////////////////////////
+double SleepManager::TimeThreshold() const
+{
+  return this->timeThreshold;
+}
+
+/////////////////////////////////////////////////
+void SleepManager::Rebuild(const WorldPtr &_world)
+{
+  std::vector<Model *> newModels;
+  std::vector<Model *> stack;
+  for (const auto &model : _world->Models())
+    stack.push_back(model.get());
+
+  while (!stack.empty())
+  {
+    Model *model = stack.back();
+    stack.pop_back();
+
+    for (const auto &nested : model->NestedModels())
+      stack.push_back(nested.get());
+
+    if (model->IsStatic() || model->GetLinks().empty())
+      continue;
+
+    newModels.push_back(model);
+  }
+
+  // Keep the state of the models that are still around. Models are only
+  // dereferenced if they are part of the new list.
+  std::unordered_map<const Model *, size_t> newIndices;
+  std::vector<double> newRestTimes(newModels.size(), 0.0);
+  std::vector<bool> newSleeping(newModels.size(), false);
+  unsigned int count = 0;
+  for (size_t i = 0; i < newModels.size(); ++i)
+  {
+    newIndices[newModels[i]] = i;
+    auto iter = this->indices.find(newModels[i]);
+    if (iter != this->indices.end())
+    {
+      newRestTimes[i] = this->restTimes[iter->second];
+      newSleeping[i] = this->sleeping[iter->second];
+      if (newSleeping[i])
+        ++count;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->models.swap(newModels);
+  this->indices.swap(newIndices);
+  this->restTimes.swap(newRestTimes);
+  this->sleeping.swap(newSleeping);
+  this->sleepingCount = count;
+}
+
+/////////////////////////////////////////////////
+void SleepManager::WakeIndex(const size_t _index, const bool _resetTimer)
+{
+  if (_resetTimer)
+    this->restTimes[_index] = 0.0;
+  if (!this->sleeping[_index])
+    return;
+
+  this->models[_index]->SetEnabled(true);
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->sleeping[_index] = false;
+  }
+  --this->sleepingCount;
+}
+
+/////////////////////////////////////////////////
+void SleepManager::Update(const WorldPtr &_world, const double _dt,
+    const uint64_t _entityVersion)
+{
+  GZ_ASSERT(_world, "World pointer is invalid");
+
+  if (!this->enabled)
+  {
+    if (!this->built)
+      return;
+
+    // Wake up everything that was put to sleep before being disabled.
+    if (this->version != _entityVersion)
+      this->Rebuild(_world);
+    for (size_t i = 0; i < this->models.size(); ++i)
+      this->WakeIndex(i, true);
+    this->Clear();
+    return;
+  }
+
+  if (!this->built || this->version != _entityVersion)
+  {
+    this->Rebuild(_world);
+    this->version = _entityVersion;
+    this->built = true;
+  }
+
+  // Explicit wake up requests, e.g. from Entity::SetWorldPose.
+  {
+    std::lock_guard<std::mutex> lock(this->wakeMutex);
+    this->pendingWakes.swap(this->wakeRequests);
+  }
+  for (const auto model : this->pendingWakes)
+  {
+    auto iter = this->indices.find(model);
+    if (iter != this->indices.end())
+      this->WakeIndex(iter->second, true);
+  }
+  this->pendingWakes.clear();
+
+  // Wake up sleeping models touched by moving ones. A model is moving if
+  // its rest timer was reset by the last update. Contacts are only
+  // available when someone subscribes to them, so this relies on the
+  // physics engine re-enabling touched bodies otherwise, which is checked
+  // below.
+  if (this->sleepingCount > 0)
+  {
+    ContactManager *contactManager =
+        _world->Physics()->GetContactManager();
+    for (unsigned int i = 0; i < contactManager->GetContactCount(); ++i)
+    {
+      Contact *contact = contactManager->GetContact(i);
+      if (!contact || !contact->collision1 || !contact->collision2)
+        continue;
+
+      auto iter1 = this->indices.find(OwnerModel(contact->collision1));
+      auto iter2 = this->indices.find(OwnerModel(contact->collision2));
+      if (iter1 == this->indices.end() || iter2 == this->indices.end())
+        continue;
+
+      size_t index1 = iter1->second;
+      size_t index2 = iter2->second;
+      if (this->sleeping[index1] && !this->sleeping[index2] &&
+          this->restTimes[index2] <= 0.0)
+      {
+        this->WakeIndex(index1, true);
+      }
+      else if (this->sleeping[index2] && !this->sleeping[index1] &&
+               this->restTimes[index1] <= 0.0)
+      {
+        this->WakeIndex(index2, true);
+      }
+    }
+  }
+
+  const double linearSq = this->linearThreshold * this->linearThreshold;
+  const double angularSq = this->angularThreshold * this->angularThreshold;
+
+  for (size_t i = 0; i < this->models.size(); ++i)
+  {
+    Model *model = this->models[i];
+    const Link_V &links = model->GetLinks();
+
+    if (this->sleeping[i])
+    {
+      // The physics engine may enable bodies itself, for example ODE
+      // enables disabled bodies that are connected to enabled ones. The
+      // rest timer is kept, so the model falls asleep again right away
+      // unless it started moving. Otherwise two touching models could keep
+      // waking each other up.
+      bool engineEnabled = false;
+      for (const auto &link : links)
+      {
+        if (link->GetEnabled())
+        {
+          engineEnabled = true;
+          break;
+        }
+      }
+      if (!engineEnabled)
+        continue;
+      this->WakeIndex(i, false);
+    }
+
+    bool resting = true;
+    for (const auto &link : links)
+    {
+      if (link->WorldLinearVel().SquaredLength() > linearSq ||
+          link->WorldAngularVel().SquaredLength() > angularSq)
+      {
+        resting = false;
+        break;
+      }
+    }
+
+    if (!resting)
+    {
+      this->restTimes[i] = 0.0;
+      continue;
+    }
+
+    this->restTimes[i] += _dt;
+    if (this->restTimes[i] >= this->timeThreshold)
+    {
+      // Clear the residual motion so that the model doesn't creep when
+      // it's woken up.
+      model->ResetPhysicsStates();
+      model->SetEnabled(false);
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->sleeping[i] = true;
+      }
+      ++this->sleepingCount;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void SleepManager::Wake(const Entity *_entity)
+{
+  if (!this->enabled)
+    return;
+
+  const Model *model = OwnerModel(_entity);
+  if (!model)
+    return;
+
+  std::lock_guard<std::mutex> lock(this->wakeMutex);
+  this->wakeRequests.push_back(model);
+}
+
+/////////////////////////////////////////////////
+unsigned int SleepManager::SleepingModelCount() const
+{
+  return this->sleepingCount;
+}
+
+/////////////////////////////////////////////////
+bool SleepManager::IsSleeping(const Model *_model) const
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  auto iter = this->indices.find(_model);
+  return iter != this->indices.end() && this->sleeping[iter->second];
+}
+
+/////////////////////////////////////////////////
+void SleepManager::Clear()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->models.clear();
+    this->indices.clear();
+    this->restTimes.clear();
+    this->sleeping.clear();
+    this->sleepingCount = 0;
+  }
+  this->built = false;
+
+  std::lock_guard<std::mutex> lock(this->wakeMutex);
+  this->wakeRequests.clear();
+}
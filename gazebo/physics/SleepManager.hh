@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_SLEEPMANAGER_HH_
+#define GAZEBO_PHYSICS_SLEEPMANAGER_HH_
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class SleepManager SleepManager.hh physics/physics.hh
+    /// \brief Puts models that have come to rest to sleep, independently of
+    /// the physics engine.
+    ///
+    /// A model falls asleep once the linear and angular velocities of all
+    /// of its links stay below the thresholds for the time threshold. A
+    /// sleeping model has its links disabled with Model::SetEnabled. It's
+    /// woken up when it comes into contact with an awake model, when the
+    /// physics engine enables one of its links again, or when its pose is
+    /// set with Entity::SetWorldPose.
+    ///
+    /// Enable it with World::SleepMgr()->SetEnabled(true), or with
+    /// <ignition:auto_sleep> in the world SDF.
+    class GZ_PHYSICS_VISIBLE SleepManager
+    {
+      /// \brief Constructor.
+      public: SleepManager() = default;
+
+      /// \brief Enable or disable automatic sleeping. Disabling wakes up
+      /// every model put to sleep by this manager.
+      /// \param[in] _enable True to enable.
+      public: void SetEnabled(const bool _enable);
+
+      /// \brief Check if automatic sleeping is enabled.
+      /// \return True if enabled.
+      public: bool Enabled() const;
+
+      /// \brief Set the linear velocity below which a link is at rest.
+      /// \param[in] _threshold Velocity in m/s.
+      public: void SetLinearVelocityThreshold(const double _threshold);
+
+      /// \brief Get the linear velocity below which a link is at rest.
+      /// \return Velocity in m/s.
+      public: double LinearVelocityThreshold() const;
+
+      /// \brief Set the angular velocity below which a link is at rest.
+      /// \param[in] _threshold Velocity in rad/s.
+      public: void SetAngularVelocityThreshold(const double _threshold);
+
+      /// \brief Get the angular velocity below which a link is at rest.
+      /// \return Velocity in rad/s.
+      public: double AngularVelocityThreshold() const;
+
+      /// \brief Set how long a model must be at rest before it falls asleep.
+      /// \param[in] _time Time in seconds of simulation time.
+      public: void SetTimeThreshold(const double _time);
+
+      /// \brief Get how long a model must be at rest before it falls asleep.
+      /// \return Time in seconds of simulation time.
+      public: double TimeThreshold() const;
+
+      /// \brief Update the rest timers, and put models to sleep or wake
+      /// them up. Called by the world after the physics update.
+      /// \param[in] _world World the models belong to.
+      /// \param[in] _dt Simulation time since the last update.
+      /// \param[in] _entityVersion Counter that changes whenever an entity
+      /// is added to or removed from the world.
+      public: void Update(const WorldPtr &_world, const double _dt,
+                          const uint64_t _entityVersion);
+
+      /// \brief Request that the model of an entity is woken up, and its
+      /// rest timer restarted. Can be called from any thread, the request
+      /// is handled on the next Update.
+      /// \param[in] _entity A model, link or collision.
+      public: void Wake(const Entity *_entity);
+
+      /// \brief Get the number of sleeping models.
+      /// \return Number of models that are asleep.
+      public: unsigned int SleepingModelCount() const;
+
+      /// \brief Check if a model is asleep.
+      /// \param[in] _model Model to check.
+      /// \return True if the model is asleep.
+      public: bool IsSleeping(const Model *_model) const;
+
+      /// \brief Forget all models, for example when the world is reset.
+      public: void Clear();
+
+      /// \brief Rebuild the list of models.
+      /// \param[in] _world World to walk.
+      private: void Rebuild(const WorldPtr &_world);
+
+      /// \brief Wake up a model.
+      /// \param[in] _index Index of the model.
+      /// \param[in] _resetTimer True to restart the rest timer.
+      private: void WakeIndex(const size_t _index, const bool _resetTimer);
+
+      /// \brief True if the manager is enabled.
+      private: std::atomic<bool> enabled{false};
+
+      /// \brief Linear velocity threshold.
+      private: double linearThreshold = 0.01;
+
+      /// \brief Angular velocity threshold.
+      private: double angularThreshold = 0.01;
+
+      /// \brief Rest time threshold.
+      private: double timeThreshold = 0.5;
+
+      /// \brief Models with dynamic links, including nested models.
+      private: std::vector<Model *> models;
+
+      /// \brief Map from model to index in the arrays.
+      private: std::unordered_map<const Model *, size_t> indices;
+
+      /// \brief Time each model has been at rest.
+      private: std::vector<double> restTimes;
+
+      /// \brief Whether each model is asleep.
+      private: std::vector<bool> sleeping;
+
+      /// \brief Number of sleeping models.
+      private: std::atomic<unsigned int> sleepingCount{0};
+
+      /// \brief Entity version the model list was built from.
+      private: uint64_t version = 0;
+
+      /// \brief True once the model list has been built.
+      private: bool built = false;
+
+      /// \brief Models that should be woken up. Only used as keys into
+      /// indices, so they are never dereferenced.
+      private: std::vector<const Model *> wakeRequests;
+
+      /// \brief Scratch copy of wakeRequests used by Update.
+      private: std::vector<const Model *> pendingWakes;
+
+      /// \brief Protects wakeRequests.
+      private: std::mutex wakeMutex;
+
+      /// \brief Protects the model arrays against IsSleeping calls from
+      /// other threads.
+      private: mutable std::mutex mutex;
+    };
+    /// \}
+  }
+}
+#endif
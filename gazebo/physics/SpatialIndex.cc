@@ -0,0 +1,417 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include "gazebo/common/Assert.hh"
+#include "gazebo/common/Console.hh"
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/World.hh"
+#include "gazebo/physics/SpatialIndex.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+/// \brief Boxes that span more cells than this along X or Y go in the
+/// oversized list.
+static const int64_t kMaxCellSpan = 64;
+
+/// \brief Check if a box is empty, e.g. the box of a model without
+/// collisions.
+/// \param[in] _box Box to check.
+/// \return True if the box is empty.
+static bool IsEmpty(const ignition::math::AxisAlignedBox &_box)
+{
+  return _box.Min().X() > _box.Max().X() ||
+         _box.Min().Y() > _box.Max().Y() ||
+         _box.Min().Z() > _box.Max().Z();
+}
+
+/// \brief Check if two boxes overlap.
+/// \param[in] _a First box.
+/// \param[in] _b Second box.
+/// \return True if the boxes overlap, touching counts as overlapping.
+static bool Overlaps(const ignition::math::AxisAlignedBox &_a,
+    const ignition::math::AxisAlignedBox &_b)
+{
+  return _a.Min().X() <= _b.Max().X() && _a.Max().X() >= _b.Min().X() &&
+         _a.Min().Y() <= _b.Max().Y() && _a.Max().Y() >= _b.Min().Y() &&
+         _a.Min().Z() <= _b.Max().Z() && _a.Max().Z() >= _b.Min().Z();
+}
+
+/// \brief Check if a segment crosses a box, with the slab method.
+/// \param[in] _box Box to check.
+/// \param[in] _start Start of the segment.
+/// \param[in] _end End of the segment.
+/// \return True if the segment crosses the box.
+static bool SegmentCrosses(const ignition::math::AxisAlignedBox &_box,
+    const ignition::math::Vector3d &_start,
+    const ignition::math::Vector3d &_end)
+{
+  const ignition::math::Vector3d dir = _end - _start;
+  double tMin = 0.0;
+  double tMax = 1.0;
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    if (std::abs(dir[i]) < 1e-12)
+    {
+      if (_start[i] < _box.Min()[i] || _start[i] > _box.Max()[i])
+        return false;
+      continue;
+    }
+
+    double t1 = (_box.Min()[i] - _start[i]) / dir[i];
+    double t2 = (_box.Max()[i] - _start[i]) / dir[i];
+    if (t1 > t2)
+      std::swap(t1, t2);
+    tMin = std::max(tMin, t1);
+    tMax = std::min(tMax, t2);
+    if (tMin > tMax)
+      return false;
+  }
+  return true;
+}
+
+/// \brief Get the top level model of an entity.
+/// \param[in] _entity A model or a link.
+/// \return The top level model, or nullptr.
+static const Model *TopModel(const Entity *_entity)
+{
+  const Base *base = _entity;
+  if (base && base->HasType(Base::LINK))
+    base = base->GetParent().get();
+
+  if (!base || !base->HasType(Base::MODEL))
+    return nullptr;
+
+  BasePtr parent = base->GetParent();
+  while (parent && parent->HasType(Base::MODEL))
+  {
+    base = parent.get();
+    parent = base->GetParent();
+  }
+  return static_cast<const Model *>(base);
+}
+
+/////////////////////////////////////////////////
+void SpatialIndex::SetCellSize(const double _size)
+{
+  if (_size <= 0.0)
+  {
+    gzerr << "Spatial index cell size must be positive, got "
+          << _size << std::endl;
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->cellSize = _size;
+  this->built = false;
+}
+
+/////////////////////////////////////////////////
+double SpatialIndex::CellSize() const
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  return this->cellSize;
+}
+
+/////////////////////////////////////////////////
+void SpatialIndex::MarkDirty(const Entity *_entity)
+{
+  const Model *model = TopModel(_entity);
+  if (!model)
+    return;
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+  if (this->built)
+    this->dirty.insert(model);
+}
+
+/////////////////////////////////////////////////
+int64_t SpatialIndex::Key(const int64_t _x, const int64_t _y)
+{
+  return static_cast<int64_t>((static_cast<uint64_t>(_x) << 32) ^
+      (static_cast<uint64_t>(_y) & 0xFFFFFFFF));
+}
+
+/////////////////////////////////////////////////
+void SpatialIndex::Insert(const size_t _index, const Model *_model)
+{
+  Item &item = this->items[_index];
+
+  item.box.Min().Set(FLT_MAX, FLT_MAX, FLT_MAX);
+  item.box.Max().Set(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+  std::vector<const Model *> stack = {_model};
+  while (!stack.empty())
+  {
+    const Model *model = stack.back();
+    stack.pop_back();
+    item.box += model->BoundingBox();
+    for (const auto &nested : model->NestedModels())
+      stack.push_back(nested.get());
+  }
+
+  item.oversized = false;
+  item.minX = 0;
+  item.minY = 0;
+  item.maxX = -1;
+  item.maxY = -1;
+
+  // Models without collisions can't be hit.
+  if (IsEmpty(item.box))
+    return;
+
+  const double minX = std::floor(item.box.Min().X() / this->gridCellSize);
+  const double minY = std::floor(item.box.Min().Y() / this->gridCellSize);
+  const double maxX = std::floor(item.box.Max().X() / this->gridCellSize);
+  const double maxY = std::floor(item.box.Max().Y() / this->gridCellSize);
+  if (!std::isfinite(minX) || !std::isfinite(minY) ||
+      !std::isfinite(maxX) || !std::isfinite(maxY) ||
+      maxX - minX >= kMaxCellSpan || maxY - minY >= kMaxCellSpan)
+  {
+    item.oversized = true;
+    this->oversized.push_back(_index);
+    return;
+  }
+
+  item.minX = static_cast<int64_t>(minX);
+  item.minY = static_cast<int64_t>(minY);
+  item.maxX = static_cast<int64_t>(maxX);
+  item.maxY = static_cast<int64_t>(maxY);
+  for (int64_t x = item.minX; x <= item.maxX; ++x)
+  {
+    for (int64_t y = item.minY; y <= item.maxY; ++y)
+      this->cells[Key(x, y)].push_back(_index);
+  }
+}
+
+/////////////////////////////////////////////////
+void SpatialIndex::Remove(const size_t _index)
+{
+  Item &item = this->items[_index];
+  if (item.oversized)
+  {
+    this->oversized.erase(std::remove(this->oversized.begin(),
+        this->oversized.end(), _index), this->oversized.end());
+    return;
+  }
+
+  for (int64_t x = item.minX; x <= item.maxX; ++x)
+  {
+    for (int64_t y = item.minY; y <= item.maxY; ++y)
+    {
+      auto iter = this->cells.find(Key(x, y));
+      if (iter == this->cells.end())
+        continue;
+
+      auto &cell = iter->second;
+      cell.erase(std::remove(cell.begin(), cell.end(), _index), cell.end());
+      if (cell.empty())
+        this->cells.erase(iter);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void SpatialIndex::Rebuild(const WorldPtr &_world)
+{
+  this->items.clear();
+  this->indices.clear();
+  this->cells.clear();
+  this->oversized.clear();
+  this->dirty.clear();
+  this->gridCellSize = this->cellSize;
+
+  for (const auto &model : _world->Models())
+  {
+    this->indices[model.get()] = this->items.size();
+    Item item;
+    item.model = model;
+    this->items.push_back(item);
+    this->Insert(this->items.size() - 1, model.get());
+  }
+}
+
+/////////////////////////////////////////////////
+void SpatialIndex::Update(const WorldPtr &_world,
+    const uint64_t _entityVersion)
+{
+  GZ_ASSERT(_world, "World pointer is invalid");
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+
+  if (!this->built || this->version != _entityVersion)
+  {
+    this->Rebuild(_world);
+    this->version = _entityVersion;
+    this->built = true;
+    return;
+  }
+
+  // Models are only dereferenced after checking that they are still in
+  // the index, which is the case as long as the entity version is
+  // unchanged.
+  for (const auto model : this->dirty)
+  {
+    auto iter = this->indices.find(model);
+    if (iter == this->indices.end())
+      continue;
+
+    this->Remove(iter->second);
+    this->Insert(iter->second, model);
+  }
+  this->dirty.clear();
+}
+
+/////////////////////////////////////////////////
+void SpatialIndex::Clear()
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->items.clear();
+  this->indices.clear();
+  this->cells.clear();
+  this->oversized.clear();
+  this->dirty.clear();
+  this->built = false;
+}
+
+/////////////////////////////////////////////////
+size_t SpatialIndex::Size() const
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  return this->items.size();
+}
+
+/////////////////////////////////////////////////
+template<typename F>
+void SpatialIndex::Visit(const ignition::math::AxisAlignedBox &_box,
+    F _func) const
+{
+  ++this->queryStamp;
+
+  for (const auto index : this->oversized)
+    _func(index);
+
+  const double minX = std::floor(_box.Min().X() / this->gridCellSize);
+  const double minY = std::floor(_box.Min().Y() / this->gridCellSize);
+  const double maxX = std::floor(_box.Max().X() / this->gridCellSize);
+  const double maxY = std::floor(_box.Max().Y() / this->gridCellSize);
+
+  // Walking a large range of cells is slower than checking every item.
+  if (!std::isfinite(minX) || !std::isfinite(minY) ||
+      !std::isfinite(maxX) || !std::isfinite(maxY) ||
+      (maxX - minX + 1) * (maxY - minY + 1) >
+      static_cast<double>(this->cells.size()))
+  {
+    for (size_t i = 0; i < this->items.size(); ++i)
+    {
+      if (!this->items[i].oversized)
+        _func(i);
+    }
+    return;
+  }
+
+  for (int64_t x = static_cast<int64_t>(minX);
+       x <= static_cast<int64_t>(maxX); ++x)
+  {
+    for (int64_t y = static_cast<int64_t>(minY);
+         y <= static_cast<int64_t>(maxY); ++y)
+    {
+      auto iter = this->cells.find(Key(x, y));
+      if (iter == this->cells.end())
+        continue;
+
+      for (const auto index : iter->second)
+      {
+        const Item &item = this->items[index];
+        if (item.queryStamp == this->queryStamp)
+          continue;
+        item.queryStamp = this->queryStamp;
+        _func(index);
+      }
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+std::vector<ModelPtr> SpatialIndex::ModelsAtPoint(
+    const ignition::math::Vector3d &_pt) const
+{
+  return this->ModelsInBox(ignition::math::AxisAlignedBox(_pt, _pt));
+}
+
+/////////////////////////////////////////////////
+std::vector<ModelPtr> SpatialIndex::ModelsInBox(
+    const ignition::math::AxisAlignedBox &_box) const
+{
+  std::vector<ModelPtr> result;
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->Visit(_box, [&](const size_t _index)
+  {
+    const Item &item = this->items[_index];
+    if (!Overlaps(item.box, _box))
+      return;
+
+    ModelPtr model = item.model.lock();
+    if (model)
+      result.push_back(model);
+  });
+
+  return result;
+}
+
+/////////////////////////////////////////////////
+std::vector<ModelPtr> SpatialIndex::ModelsOnRay(
+    const ignition::math::Vector3d &_start,
+    const ignition::math::Vector3d &_end) const
+{
+  std::vector<ModelPtr> result;
+
+  ignition::math::AxisAlignedBox bounds(_start, _end);
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->Visit(bounds, [&](const size_t _index)
+  {
+    const Item &item = this->items[_index];
+    if (!Overlaps(item.box, bounds) ||
+        !SegmentCrosses(item.box, _start, _end))
+    {
+      return;
+    }
+
+    ModelPtr model = item.model.lock();
+    if (model)
+      result.push_back(model);
+  });
+
+  return result;
+}
+
+/////////////////////////////////////////////////
+bool SpatialIndex::BoundingBox(const Model *_model,
+    ignition::math::AxisAlignedBox &_box) const
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  auto iter = this->indices.find(_model);
+  if (iter == this->indices.end())
+    return false;
+
+  _box = this->items[iter->second].box;
+  return true;
+}
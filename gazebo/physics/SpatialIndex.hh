@@ -0,0 +1,204 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_SPATIALINDEX_HH_
+#define GAZEBO_PHYSICS_SPATIALINDEX_HH_
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <boost/weak_ptr.hpp>
+#include <ignition/math/AxisAlignedBox.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class SpatialIndex SpatialIndex.hh physics/physics.hh
+    /// \brief Uniform grid over the collision bounding boxes of the top
+    /// level models of a world.
+    ///
+    /// The grid is two dimensional, in the XY plane, which suits the mostly
+    /// flat layout of outdoor worlds. Models that are too large for the
+    /// grid, such as ground planes, are kept in a separate list that every
+    /// query checks.
+    ///
+    /// When enabled with World::SetSpatialIndexEnabled, the world refreshes
+    /// the index from World::ProcessMessages, only recomputing the boxes
+    /// of models whose pose changed. Queries can be made from any thread
+    /// and return the models as of the last refresh.
+    class GZ_PHYSICS_VISIBLE SpatialIndex
+    {
+      /// \brief Constructor.
+      public: SpatialIndex() = default;
+
+      /// \brief Set the size of a grid cell. Takes effect on the next
+      /// rebuild.
+      /// \param[in] _size Edge length of a cell in meters.
+      public: void SetCellSize(const double _size);
+
+      /// \brief Get the size of a grid cell.
+      /// \return Edge length of a cell in meters.
+      public: double CellSize() const;
+
+      /// \brief Flag a model whose pose changed. Nested models and links
+      /// flag their top level model.
+      /// \param[in] _entity A model or a link.
+      public: void MarkDirty(const Entity *_entity);
+
+      /// \brief Refresh the index. Must be called from the world update
+      /// thread.
+      /// \param[in] _world World the models belong to.
+      /// \param[in] _entityVersion Counter that changes whenever an entity
+      /// is added to or removed from the world. The index is rebuilt when
+      /// it differs from the value of the last update, otherwise only the
+      /// models flagged with MarkDirty are updated.
+      public: void Update(const WorldPtr &_world,
+                          const uint64_t _entityVersion);
+
+      /// \brief Remove all models from the index.
+      public: void Clear();
+
+      /// \brief Number of models in the index.
+      /// \return Number of models.
+      public: size_t Size() const;
+
+      /// \brief Get the models whose bounding box contains a point.
+      /// \param[in] _pt Point in world coordinates.
+      /// \return Models containing the point.
+      public: std::vector<ModelPtr> ModelsAtPoint(
+                  const ignition::math::Vector3d &_pt) const;
+
+      /// \brief Get the models whose bounding box overlaps a box.
+      /// \param[in] _box Box in world coordinates.
+      /// \return Models overlapping the box.
+      public: std::vector<ModelPtr> ModelsInBox(
+                  const ignition::math::AxisAlignedBox &_box) const;
+
+      /// \brief Get the models whose bounding box is crossed by a line
+      /// segment.
+      /// \param[in] _start Start of the segment in world coordinates.
+      /// \param[in] _end End of the segment in world coordinates.
+      /// \return Models crossed by the segment.
+      public: std::vector<ModelPtr> ModelsOnRay(
+                  const ignition::math::Vector3d &_start,
+                  const ignition::math::Vector3d &_end) const;
+
+      /// \brief Get the bounding box of a model, as stored in the index.
+      /// \param[in] _model A top level model.
+      /// \param[out] _box Bounding box of the model and its nested models.
+      /// \return True if the model is in the index.
+      public: bool BoundingBox(const Model *_model,
+                  ignition::math::AxisAlignedBox &_box) const;
+
+      /// \brief A model in the index.
+      private: struct Item
+               {
+                 /// \brief The model, only used to hand it out to callers.
+                 boost::weak_ptr<Model> model;
+
+                 /// \brief Bounding box of the model and its nested models.
+                 ignition::math::AxisAlignedBox box;
+
+                 /// \brief Range of cells covered by the box, inclusive.
+                 int64_t minX = 0;
+                 int64_t minY = 0;
+                 int64_t maxX = -1;
+                 int64_t maxY = -1;
+
+                 /// \brief True if the item is in the oversized list
+                 /// instead of the grid.
+                 bool oversized = false;
+
+                 /// \brief Stamp of the last query that visited the item.
+                 mutable uint64_t queryStamp = 0;
+               };
+
+      /// \brief Rebuild the index from scratch.
+      /// \param[in] _world World to walk.
+      private: void Rebuild(const WorldPtr &_world);
+
+      /// \brief Compute the box of an item and insert it into the grid.
+      /// \param[in] _index Index of the item.
+      /// \param[in] _model Model of the item.
+      private: void Insert(const size_t _index, const Model *_model);
+
+      /// \brief Remove an item from the grid.
+      /// \param[in] _index Index of the item.
+      private: void Remove(const size_t _index);
+
+      /// \brief Visit the items overlapping a range of cells, and the
+      /// oversized items. Each item is visited once.
+      /// \param[in] _box Box used to select the cells.
+      /// \param[in] _func Called with the index of each item.
+      private: template<typename F>
+               void Visit(const ignition::math::AxisAlignedBox &_box,
+                          F _func) const;
+
+      /// \brief Key of a cell in the grid.
+      /// \param[in] _x Cell coordinate along X.
+      /// \param[in] _y Cell coordinate along Y.
+      /// \return Hash map key.
+      private: static int64_t Key(const int64_t _x, const int64_t _y);
+
+      /// \brief Edge length of a cell.
+      private: double cellSize = 4.0;
+
+      /// \brief Cell size used by the current grid.
+      private: double gridCellSize = 4.0;
+
+      /// \brief Models in the index.
+      private: std::vector<Item> items;
+
+      /// \brief Map from model to index in items.
+      private: std::unordered_map<const Model *, size_t> indices;
+
+      /// \brief Items in each non-empty cell.
+      private: std::unordered_map<int64_t, std::vector<size_t>> cells;
+
+      /// \brief Items too large for the grid.
+      private: std::vector<size_t> oversized;
+
+      /// \brief Top level models flagged with MarkDirty. Only used as keys
+      /// into indices.
+      private: std::unordered_set<const Model *> dirty;
+
+      /// \brief Counter used to visit each item once per query.
+      private: mutable uint64_t queryStamp = 0;
+
+      /// \brief Entity version the index was built from.
+      private: uint64_t version = 0;
+
+      /// \brief True once the index has been built.
+      private: bool built = false;
+
+      /// \brief Protects the index against queries from other threads.
+      private: mutable std::mutex mutex;
+    };
+    /// \}
+  }
+}
+#endif
@@ -17,6 +17,12 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/range/adaptor/reversed.hpp>
 
+#include <string>
+#include <vector>
+
+#include <ignition/math/Pose3.hh>
+
+#include "gazebo/common/Console.hh"
 #include "gazebo/transport/transport.hh"
 
 #include "gazebo/physics/World.hh"
@@ -28,6 +34,117 @@
 using namespace gazebo;
 using namespace physics;
 
+/////////////////////////////////////////////////
+/// \brief Check if two poses are exactly equal. Pose3d::operator== has a
+/// tolerance, which would let small moves be dropped from undo states.
+static bool SamePose(const ignition::math::Pose3d &_a,
+    const ignition::math::Pose3d &_b)
+{
+  return _a.Pos().X() == _b.Pos().X() && _a.Pos().Y() == _b.Pos().Y() &&
+    _a.Pos().Z() == _b.Pos().Z() && _a.Rot().W() == _b.Rot().W() &&
+    _a.Rot().X() == _b.Rot().X() && _a.Rot().Y() == _b.Rot().Y() &&
+    _a.Rot().Z() == _b.Rot().Z();
+}
+
+/////////////////////////////////////////////////
+/// \brief Check if two model states set the same values through
+/// Model::SetState. Joint states aren't applied, so they aren't compared.
+static bool SameModel(const ModelState &_a, const ModelState &_b)
+{
+  if (!SamePose(_a.Pose(), _b.Pose()) ||
+      _a.Scale().X() != _b.Scale().X() || _a.Scale().Y() != _b.Scale().Y() ||
+      _a.Scale().Z() != _b.Scale().Z())
+  {
+    return false;
+  }
+
+  const LinkState_M &links = _a.GetLinkStates();
+  const LinkState_M &otherLinks = _b.GetLinkStates();
+  if (links.size() != otherLinks.size())
+    return false;
+
+  for (const auto &link : links)
+  {
+    auto other = otherLinks.find(link.first);
+    if (other == otherLinks.end() ||
+        !SamePose(link.second.Pose(), other->second.Pose()) ||
+        !SamePose(link.second.Velocity(), other->second.Velocity()) ||
+        !SamePose(link.second.Acceleration(), other->second.Acceleration()) ||
+        !SamePose(link.second.Wrench(), other->second.Wrench()))
+    {
+      return false;
+    }
+  }
+
+  const ModelState_M &nested = _a.NestedModelStates();
+  const ModelState_M &otherNested = _b.NestedModelStates();
+  if (nested.size() != otherNested.size())
+    return false;
+
+  for (const auto &model : nested)
+  {
+    auto other = otherNested.find(model.first);
+    if (other == otherNested.end() || !SameModel(model.second, other->second))
+      return false;
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+void UserCmdPrivate::Reduce(WorldState &_state, const WorldState &_ref,
+    std::vector<std::string> &_missing)
+{
+  _missing.clear();
+  for (const auto &model : _ref.modelStates)
+  {
+    if (_state.modelStates.find(model.first) == _state.modelStates.end())
+      _missing.push_back(model.first);
+  }
+  for (const auto &light : _ref.lightStates)
+  {
+    if (_state.lightStates.find(light.first) == _state.lightStates.end())
+      _missing.push_back(light.first);
+  }
+
+  for (auto iter = _state.modelStates.begin();
+       iter != _state.modelStates.end();)
+  {
+    auto ref = _ref.modelStates.find(iter->first);
+    if (ref != _ref.modelStates.end() && SameModel(iter->second, ref->second))
+      iter = _state.modelStates.erase(iter);
+    else
+      ++iter;
+  }
+
+  for (auto iter = _state.lightStates.begin();
+       iter != _state.lightStates.end();)
+  {
+    auto ref = _ref.lightStates.find(iter->first);
+    if (ref != _ref.lightStates.end() &&
+        SamePose(iter->second.Pose(), ref->second.Pose()))
+    {
+      iter = _state.lightStates.erase(iter);
+    }
+    else
+      ++iter;
+  }
+}
+
+/////////////////////////////////////////////////
+void UserCmdPrivate::Restore(WorldState &_state, const WorldState &_ref,
+    const std::vector<std::string> &_missing)
+{
+  // Insert doesn't replace, so the values kept in the state win
+  _state.modelStates.insert(_ref.modelStates.begin(), _ref.modelStates.end());
+  _state.lightStates.insert(_ref.lightStates.begin(), _ref.lightStates.end());
+
+  for (const auto &name : _missing)
+  {
+    _state.modelStates.erase(name);
+    _state.lightStates.erase(name);
+  }
+}
 
 /////////////////////////////////////////////////
 UserCmd::UserCmd(const unsigned int _id,
@@ -59,6 +176,13 @@ UserCmd::~UserCmd()
 /////////////////////////////////////////////////
 void UserCmd::Undo()
 {
+  if (this->dataPtr->startReduced)
+  {
+    gzerr << "Command [" << this->dataPtr->description << "] must have its "
+          << "start state restored before it's undone." << std::endl;
+    return;
+  }
+
   // Record / override the state for redo
   this->dataPtr->endState = WorldState(this->dataPtr->world);
 
@@ -67,16 +191,60 @@ void UserCmd::Undo()
 
   // Set state to the moment the command was executed
   this->dataPtr->world->SetState(this->dataPtr->startState);
+
+  // Usually only the models touched since the command differ
+  UserCmdPrivate::Reduce(this->dataPtr->endState, this->dataPtr->startState,
+      this->dataPtr->endMissing);
 }
 
 /////////////////////////////////////////////////
 void UserCmd::Redo()
 {
+  if (this->dataPtr->startReduced)
+  {
+    gzerr << "Command [" << this->dataPtr->description << "] must have its "
+          << "start state restored before it's redone." << std::endl;
+    return;
+  }
+
+  WorldState endState = this->dataPtr->endState;
+  UserCmdPrivate::Restore(endState, this->dataPtr->startState,
+      this->dataPtr->endMissing);
+
   // Reset physics states for the whole world
   this->dataPtr->world->ResetPhysicsStates();
 
   // Set state to the moment undo was triggered
-  this->dataPtr->world->SetState(this->dataPtr->endState);
+  this->dataPtr->world->SetState(endState);
+}
+
+/////////////////////////////////////////////////
+void UserCmd::ReduceStartState(const UserCmd &_neighbour)
+{
+  if (this->dataPtr->startReduced || _neighbour.dataPtr->startReduced)
+    return;
+
+  UserCmdPrivate::Reduce(this->dataPtr->startState,
+      _neighbour.dataPtr->startState, this->dataPtr->startMissing);
+  this->dataPtr->startReduced = true;
+}
+
+/////////////////////////////////////////////////
+void UserCmd::RestoreStartState(const UserCmd &_neighbour)
+{
+  if (!this->dataPtr->startReduced || _neighbour.dataPtr->startReduced)
+    return;
+
+  UserCmdPrivate::Restore(this->dataPtr->startState,
+      _neighbour.dataPtr->startState, this->dataPtr->startMissing);
+  this->dataPtr->startMissing.clear();
+  this->dataPtr->startReduced = false;
+}
+
+/////////////////////////////////////////////////
+bool UserCmd::StartStateReduced() const
+{
+  return this->dataPtr->startReduced;
 }
 
 /////////////////////////////////////////////////
@@ -220,6 +388,11 @@ void UserCmdManager::OnUserCmdMsg(ConstUserCmdPtr &_msg)
     }
   }
 
+  // Only the newest command keeps a whole start state, older ones keep
+  // what differs from the next one
+  if (!this->dataPtr->undoCmds.empty())
+    this->dataPtr->undoCmds.back()->ReduceStartState(*cmd);
+
   // Add it to undo list
   this->dataPtr->undoCmds.push_back(cmd);
 
@@ -276,6 +449,13 @@ void UserCmdManager::OnUndoRedoMsg(ConstUndoRedoPtr &_msg)
       this->dataPtr->undoCmds.pop_back();
       this->dataPtr->redoCmds.push_back(cmdIt);
 
+      // The previous command becomes the one with a whole start state
+      if (!this->dataPtr->undoCmds.empty())
+      {
+        this->dataPtr->undoCmds.back()->RestoreStartState(*cmdIt);
+        cmdIt->ReduceStartState(*this->dataPtr->undoCmds.back());
+      }
+
       if (cmdIt == cmd)
         break;
     }
@@ -316,6 +496,13 @@ void UserCmdManager::OnUndoRedoMsg(ConstUndoRedoPtr &_msg)
     // Redo all commands up to the desired one
     for (auto cmdIt : boost::adaptors::reverse(this->dataPtr->redoCmds))
     {
+      // It becomes the one with a whole start state
+      if (!this->dataPtr->undoCmds.empty())
+      {
+        cmdIt->RestoreStartState(*this->dataPtr->undoCmds.back());
+        this->dataPtr->undoCmds.back()->ReduceStartState(*cmdIt);
+      }
+
       // Redo it
       cmdIt->Redo();
 
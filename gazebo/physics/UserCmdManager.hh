@@ -54,6 +54,22 @@ namespace gazebo
       /// \brief Redo this command.
       public: virtual void Redo();
 
+      /// \brief Keep only the parts of the start state which differ from
+      /// the start state of the command right before or after this one, so
+      /// a long undo history doesn't hold a whole world per command.
+      /// \param[in] _neighbour Neighbouring command, with a whole start
+      /// state.
+      public: void ReduceStartState(const UserCmd &_neighbour);
+
+      /// \brief Make the start state whole again.
+      /// \param[in] _neighbour The command the start state was reduced
+      /// against, with a whole start state.
+      public: void RestoreStartState(const UserCmd &_neighbour);
+
+      /// \brief Check if the start state is reduced.
+      /// \return True if ReduceStartState was called last.
+      public: bool StartStateReduced() const;
+
       /// \brief Return this command's unique ID.
       /// \return Unique ID
       public: unsigned int Id() const;
@@ -38,13 +38,41 @@ namespace gazebo
       /// \brief Pointer to the world.
       public: WorldPtr world;
 
-      /// \brief Whole world state the moment the user command was executed.
+      /// \brief Reduce a state to the models and lights which differ from
+      /// a reference state. The ones kept hold absolute values.
+      /// \param[in,out] _state State to reduce.
+      /// \param[in] _ref Whole reference state.
+      /// \param[out] _missing Models and lights of the reference state
+      /// which the state doesn't have.
+      public: static void Reduce(WorldState &_state, const WorldState &_ref,
+                  std::vector<std::string> &_missing);
+
+      /// \brief Make a reduced state whole again.
+      /// \param[in,out] _state State to restore.
+      /// \param[in] _ref Whole state it was reduced against.
+      /// \param[in] _missing Models and lights to leave out of it.
+      public: static void Restore(WorldState &_state, const WorldState &_ref,
+                  const std::vector<std::string> &_missing);
+
+      /// \brief World state the moment the user command was executed. It
+      /// is whole, or only holds what differs from the start state of a
+      /// neighbouring command if startReduced is true.
       public: WorldState startState;
 
-      /// \brief Whole world state for the most recent time the user has
-      /// triggered undo for this command.
+      /// \brief True if startState was reduced.
+      public: bool startReduced = false;
+
+      /// \brief Models and lights missing from the start state when it was
+      /// reduced.
+      public: std::vector<std::string> startMissing;
+
+      /// \brief World state for the most recent time the user has
+      /// triggered undo for this command, reduced against the start state.
       public: WorldState endState;
 
+      /// \brief Models and lights missing from the end state.
+      public: std::vector<std::string> endMissing;
+
       /// \brief Unique ID identifying this command in the server.
       public: unsigned int id;
 
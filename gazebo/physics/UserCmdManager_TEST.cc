@@ -61,6 +61,58 @@ TEST_F(UserCmdManagerTest, CreateCmd)
   manager = NULL;
 }
 
+/////////////////////////////////////////////////
+TEST_F(UserCmdManagerTest, ReducedStartState)
+{
+  Load("worlds/shapes.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  physics::ModelPtr box = world->ModelByName("box");
+  physics::ModelPtr sphere = world->ModelByName("sphere");
+  ASSERT_TRUE(box != NULL);
+  ASSERT_TRUE(sphere != NULL);
+
+  // Poses before each command, with offsets below Pose3d's tolerance
+  ignition::math::Pose3d boxPose(0.0001, 2, 0.5, 0, 0, 0.3);
+  ignition::math::Pose3d spherePose = sphere->WorldPose();
+  box->SetWorldPose(boxPose);
+
+  physics::UserCmd first(0, world, "Move box", msgs::UserCmd::MOVING);
+  box->SetWorldPose(boxPose + ignition::math::Pose3d(0.0002, 0, 0, 0, 0, 0));
+
+  physics::UserCmd second(1, world, "Move box", msgs::UserCmd::MOVING);
+  ignition::math::Pose3d boxPose2 = box->WorldPose();
+  box->SetWorldPose(ignition::math::Pose3d(3, 3, 0.5, 0, 0, 0));
+
+  // Only the box differs between the two start states
+  first.ReduceStartState(second);
+  EXPECT_TRUE(first.StartStateReduced());
+  EXPECT_FALSE(second.StartStateReduced());
+
+  // A reduced command can't be undone
+  first.Undo();
+  EXPECT_EQ(ignition::math::Pose3d(3, 3, 0.5, 0, 0, 0), box->WorldPose());
+
+  second.Undo();
+  EXPECT_EQ(boxPose2.Pos().X(), box->WorldPose().Pos().X());
+
+  first.RestoreStartState(second);
+  EXPECT_FALSE(first.StartStateReduced());
+  sphere->SetWorldPose(ignition::math::Pose3d(5, 5, 5, 0, 0, 0));
+
+  // The restored state is whole, it brings back the sphere too
+  first.Undo();
+  EXPECT_DOUBLE_EQ(boxPose.Pos().X(), box->WorldPose().Pos().X());
+  EXPECT_EQ(boxPose.Rot(), box->WorldPose().Rot());
+  EXPECT_EQ(spherePose, sphere->WorldPose());
+
+  // Redo goes back to the moment of the undo
+  first.Redo();
+  EXPECT_DOUBLE_EQ(boxPose2.Pos().X(), box->WorldPose().Pos().X());
+  EXPECT_EQ(ignition::math::Pose3d(5, 5, 5, 0, 0, 0), sphere->WorldPose());
+}
+
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
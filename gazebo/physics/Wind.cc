@@ -16,8 +16,11 @@
 */
 
 #include <functional>
+#include <vector>
 #include <boost/lexical_cast.hpp>
 #include <sdf/sdf.hh>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
 
 #include <ignition/math/Vector3.hh>
 
@@ -25,6 +28,11 @@
 #include "gazebo/transport/TransportTypes.hh"
 
 #include "gazebo/physics/Entity.hh"
+#include "gazebo/physics/Inertial.hh"
+#include "gazebo/physics/Link.hh"
+#include "gazebo/physics/LinkKinematicsCache.hh"
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/PhysicsEngine.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/physics/Wind.hh"
 #include "gazebo/physics/World.hh"
@@ -47,6 +55,10 @@ namespace gazebo
       /// \brief Reference to the world.
       public: World &world;
 
+      /// \brief Drag force of each link of the kinematics cache, reused
+      /// across calls to ApplyLinearDrag.
+      public: std::vector<ignition::math::Vector3d> dragForces;
+
       /// \brief Wind linear velocity.
       public: ignition::math::Vector3d linearVel;
 
@@ -133,6 +145,61 @@ void Wind::SetLinearVel(const ignition::math::Vector3d& _vel)
   this->dataPtr->linearVel = _vel;
 }
 
+/////////////////////////////////////////////////
+void Wind::ApplyLinearDrag(const double _scale)
+{
+  auto &world = this->dataPtr->world;
+  const LinkKinematicsCache &cache = world.LinkKinematics();
+
+  // The cache is filled after the first physics update
+  if (!world.LinkKinematicsCacheEnabled() || cache.Size() == 0)
+  {
+    for (auto const &model : world.Models())
+    {
+      for (auto const &link : model->GetLinks())
+      {
+        if (!link->WindMode())
+          continue;
+
+        link->AddForce(link->GetInertial()->Mass() * _scale *
+            (link->WorldWindLinearVel() - link->WorldLinearVel()));
+      }
+    }
+    return;
+  }
+
+  // Forces only depend on their own link, compute them in parallel
+  const std::vector<Link *> &links = cache.Links();
+  const std::vector<ignition::math::Vector3d> &linearVels =
+      cache.LinearVels();
+  auto &forces = this->dataPtr->dragForces;
+  forces.resize(links.size());
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, links.size(), 256),
+      [&](const tbb::blocked_range<size_t> &_r)
+      {
+        for (size_t i = _r.begin(); i != _r.end(); ++i)
+        {
+          const Link *link = links[i];
+          if (!link->WindMode())
+          {
+            forces[i] = ignition::math::Vector3d::Zero;
+            continue;
+          }
+          forces[i] = link->GetInertial()->Mass() * _scale *
+              (link->WorldWindLinearVel() - linearVels[i]);
+        }
+      });
+
+  // Engines don't support concurrent force accumulation, apply serially
+  boost::recursive_mutex::scoped_lock lock(
+      *world.Physics()->GetPhysicsUpdateMutex());
+  for (size_t i = 0; i < links.size(); ++i)
+  {
+    if (links[i]->WindMode())
+      links[i]->AddForce(forces[i]);
+  }
+}
+
 //////////////////////////////////////////////////
 const ignition::math::Vector3d& Wind::LinearVel(void) const
 {
@@ -105,6 +105,20 @@ namespace gazebo
       /// \param[in] _vel Global wind velocity.
       public: void SetLinearVel(const ignition::math::Vector3d& _vel);
 
+      /// \brief Push every link that has wind enabled towards its wind
+      /// velocity, with a force of _scale * mass * (wind velocity - link
+      /// velocity). This approximates drag on a mass.
+      ///
+      /// When the world's LinkKinematicsCache is enabled the links and
+      /// their velocities come from the cache, the forces are computed in
+      /// parallel and applied in a single pass under the physics update
+      /// mutex. Otherwise each model's links are visited in turn.
+      /// Call it from a worldUpdateEnd callback: the cache is only current
+      /// between its refresh after the physics update and the next removal
+      /// of an entity. The forces apply to the next step.
+      /// \param[in] _scale Force per unit of mass and of relative velocity.
+      public: void ApplyLinearDrag(const double _scale);
+
       /// \brief Setup function to compute the wind.
       /// \param[in] _linearVelFunc The function callback that is used
       /// to calculate the wind's velocity. The parameters to the
@@ -221,6 +221,41 @@ TEST_F(WindTest, WindSetLinearVelFunc)
   WindSetLinearVelFunc();
 }
 
+/////////////////////////////////////////////////
+TEST_F(WindTest, ApplyLinearDrag)
+{
+  Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+  world->SetGravity(ignition::math::Vector3d::Zero);
+  world->Wind().SetLinearVel(ignition::math::Vector3d(2, 0, 0));
+
+  SpawnBox("box", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(0, 0, 5));
+  physics::ModelPtr model = world->ModelByName("box");
+  ASSERT_TRUE(model != NULL);
+  physics::LinkPtr link = model->GetLink();
+  ASSERT_TRUE(link != NULL);
+  link->SetWindMode(true);
+
+  const double dt = world->Physics()->GetMaxStepSize();
+
+  // Link by link, then from the kinematics cache, which is filled by the
+  // first step
+  for (const bool cached : {false, true})
+  {
+    world->SetLinkKinematicsCacheEnabled(cached);
+    link->SetLinearVel(ignition::math::Vector3d::Zero);
+    world->Step(1);
+    EXPECT_NEAR(link->WorldLinearVel().X(), 0, 1e-9);
+
+    // A force of mass * 2 m/s * 1/s accelerates the box at 2 m/s^2
+    world->Wind().ApplyLinearDrag(1.0);
+    world->Step(1);
+    EXPECT_NEAR(link->WorldLinearVel().X(), 2 * dt, 1e-6);
+  }
+}
+
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
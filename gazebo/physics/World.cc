@@ -22,13 +22,22 @@
 
 #include <sdf/sdf.hh>
 
+#include <algorithm>
+#include <chrono>
 #include <deque>
+#include <functional>
+#include <future>
 #include <list>
 #include <set>
+#include <sstream>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include <boost/algorithm/string/predicate.hpp>
+#include <boost/filesystem.hpp>
 #include <ignition/math/Rand.hh>
 #include <ignition/math/SemanticVersion.hh>
 
@@ -52,9 +61,15 @@
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Events.hh"
 #include "gazebo/common/Exception.hh"
+#include "gazebo/common/AllocationCounter.hh"
 #include "gazebo/common/Console.hh"
+#include "gazebo/common/MemoryAccount.hh"
+#include "gazebo/common/MeshManager.hh"
 #include "gazebo/common/Plugin.hh"
+#include "gazebo/common/PluginTiming.hh"
+#include "gazebo/common/SamplingProfiler.hh"
 #include "gazebo/common/SdfFrameSemantics.hh"
+#include "gazebo/common/StartupTrace.hh"
 #include "gazebo/common/Time.hh"
 #include "gazebo/common/URI.hh"
 
@@ -71,14 +86,19 @@
 #include "gazebo/physics/Link.hh"
 #include "gazebo/physics/PhysicsEngine.hh"
 #include "gazebo/physics/PhysicsFactory.hh"
+#include "gazebo/physics/PhysicsIface.hh"
+#include "gazebo/physics/AdiabaticAtmosphere.hh"
 #include "gazebo/physics/Atmosphere.hh"
+#include "gazebo/physics/BatterySystem.hh"
 #include "gazebo/physics/AtmosphereFactory.hh"
 #include "gazebo/physics/PresetManager.hh"
+#include "gazebo/physics/SleepManager.hh"
 #include "gazebo/physics/UserCmdManager.hh"
 #include "gazebo/physics/Model.hh"
 #include "gazebo/physics/Light.hh"
 #include "gazebo/physics/Actor.hh"
 #include "gazebo/physics/Wind.hh"
+#include "gazebo/physics/WorldSnapshot.hh"
 #include "gazebo/physics/WorldPrivate.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/common/SphericalCoordinates.hh"
@@ -96,7 +116,7 @@ bool g_clearModels;
 
 class ModelUpdate_TBB
 {
-  public: explicit ModelUpdate_TBB(Model_V *_models) : models(_models) {}
+  public: explicit ModelUpdate_TBB(Base_V *_models) : models(_models) {}
   public: void operator() (const tbb::blocked_range<size_t> &_r) const
   {
     for (size_t i = _r.begin(); i != _r.end(); i++)
@@ -105,7 +125,51 @@ class ModelUpdate_TBB
     }
   }
 
-  private: Model_V *models;
+  private: Base_V *models;
+};
+
+/// \brief Names of the WorldStepStage values in msgs::StepTiming.
+static const char *kStepStageNames[STEP_STAGE_COUNT] =
+{
+  "update", "collision", "physics", "sensors_wait", "messages", "log"
+};
+
+/// \brief Records the wall time and heap allocations of a scope as a
+/// stage of the update loop.
+class StepStageTimer
+{
+  /// \brief Constructor.
+  /// \param[in] _data World data holding the stage statistics.
+  /// \param[in] _stage Stage the scope belongs to.
+  public: StepStageTimer(WorldPrivate &_data, const WorldStepStage _stage)
+    : histogram(_data.stepTimings[_stage]),
+      allocations(_data.stepAllocations[_stage]),
+      startAllocations(common::ThreadAllocationCount()),
+      start(std::chrono::steady_clock::now())
+  {
+  }
+
+  /// \brief Destructor. Records the time since construction.
+  public: ~StepStageTimer()
+  {
+    this->histogram.Record(std::chrono::duration_cast<
+        std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+        this->start).count());
+    this->allocations +=
+        common::ThreadAllocationCount() - this->startAllocations;
+  }
+
+  /// \brief Histogram to record into.
+  private: common::LatencyHistogram &histogram;
+
+  /// \brief Allocation total to add to.
+  private: uint64_t &allocations;
+
+  /// \brief Allocations of the thread at the start of the scope.
+  private: uint64_t startAllocations;
+
+  /// \brief Start of the scope.
+  private: std::chrono::steady_clock::time_point start;
 };
 
 //////////////////////////////////////////////////
@@ -150,6 +214,9 @@ World::World(const std::string &_name)
 
   this->dataPtr->sleepOffset = common::Time(0);
 
+  this->dataPtr->sleepManager.reset(new SleepManager());
+  this->dataPtr->batterySystem.reset(new BatterySystem());
+
   this->dataPtr->prevStatTime = common::Time::GetWallTime();
   this->dataPtr->prevProcessMsgsTime = common::Time::GetWallTime();
   this->dataPtr->logLastStatePlayedSimTime = common::Time(0);
@@ -178,6 +245,9 @@ World::~World()
 //////////////////////////////////////////////////
 void World::Load(sdf::ElementPtr _sdf)
 {
+  common::StartupTraceScope trace("World::Load", "world",
+      _sdf->Get<std::string>("name"));
+
   this->dataPtr->loaded = false;
   this->dataPtr->sdf = _sdf;
   common::convertToFullPaths(this->dataPtr->sdf);
@@ -233,6 +303,59 @@ void World::Load(sdf::ElementPtr _sdf)
         Get<bool>("ignition:shadow_caster_render_back_faces");
   }
 
+  {
+    const std::string kElementName = "ignition:world_stats_step_period";
+    if (this->dataPtr->sdf->HasElement(kElementName))
+    {
+      this->dataPtr->worldStatsStepPeriod =
+        this->dataPtr->sdf->Get<unsigned int>(kElementName);
+    }
+  }
+
+  {
+    const std::string kElementName = "ignition:world_stats_rate";
+    if (this->dataPtr->sdf->HasElement(kElementName))
+    {
+      this->dataPtr->worldStatsRate =
+        this->dataPtr->sdf->Get<double>(kElementName);
+    }
+  }
+
+  {
+    const std::string kElementName = "ignition:clock_rate";
+    if (this->dataPtr->sdf->HasElement(kElementName))
+    {
+      this->dataPtr->clockRate =
+        this->dataPtr->sdf->Get<double>(kElementName);
+    }
+  }
+
+  {
+    const std::string kElementName = "ignition:joint_states_rate";
+    if (this->dataPtr->sdf->HasElement(kElementName))
+    {
+      this->dataPtr->jointStatesRate =
+        this->dataPtr->sdf->Get<double>(kElementName);
+    }
+  }
+
+  {
+    const std::string kElementName = "ignition:joint_states_models";
+    if (this->dataPtr->sdf->HasElement(kElementName))
+    {
+      try
+      {
+        this->dataPtr->jointStatesFilter =
+          this->dataPtr->sdf->Get<std::string>(kElementName);
+      }
+      catch(const boost::regex_error &_e)
+      {
+        gzerr << "Invalid <" << kElementName << "> regular expression: "
+              << _e.what() << "\n";
+      }
+    }
+  }
+
   {
     const std::string kElementName = "ignition:model_plugin_loading_timeout";
     if (this->dataPtr->sdf->HasElement(kElementName))
@@ -259,6 +382,13 @@ void World::Load(sdf::ElementPtr _sdf)
   this->dataPtr->posePub = this->dataPtr->node->Advertise<msgs::PosesStamped>(
     "~/pose/info", 10, 60);
 
+  // compact pose stream for clients on slow links
+  this->dataPtr->compactPosePub =
+    this->dataPtr->node->Advertise<msgs::CompactPoses>(
+        "~/pose/compact/info", 10, 60);
+  this->dataPtr->compactPoseAckSub = this->dataPtr->node->Subscribe(
+      "~/pose/compact/ack", &World::OnCompactPosesAck, this);
+
   this->dataPtr->guiPub = this->dataPtr->node->Advertise<msgs::GUI>("~/gui", 5);
   if (this->dataPtr->sdf->HasElement("gui"))
   {
@@ -288,11 +418,35 @@ void World::Load(sdf::ElementPtr _sdf)
   this->dataPtr->modelSub = this->dataPtr->node->Subscribe<msgs::Model>(
       "~/model/modify", &World::OnModelMsg, this);
 
+  {
+    const std::string kElementName = "ignition:battery_states_rate";
+    if (this->dataPtr->sdf->HasElement(kElementName))
+    {
+      this->dataPtr->batteryStatesRate =
+        this->dataPtr->sdf->Get<double>(kElementName);
+    }
+  }
+
   this->dataPtr->responsePub = this->dataPtr->node->Advertise<msgs::Response>(
       "~/response");
   this->dataPtr->statPub =
     this->dataPtr->node->Advertise<msgs::WorldStatistics>(
-        "~/world_stats", 100, 5);
+        "~/world_stats", 100, this->dataPtr->worldStatsRate);
+  this->dataPtr->clockPub = this->dataPtr->node->Advertise<msgs::Time>(
+      "~/clock", 100, this->dataPtr->clockRate);
+  this->dataPtr->jointStatesPub =
+    this->dataPtr->node->Advertise<msgs::JointStates>(
+        "~/joint_states", 100, this->dataPtr->jointStatesRate);
+  this->dataPtr->batteryStatesPub =
+    this->dataPtr->node->Advertise<msgs::BatteryStates>(
+        "~/battery_states", 100, this->dataPtr->batteryStatesRate);
+  if (transport::ShmClock::Enabled())
+  {
+    this->dataPtr->shmClock.Create(
+        transport::ShmClock::SegmentName(this->Name()));
+  }
+  this->dataPtr->performancePub =
+    this->dataPtr->node->Advertise<msgs::StepTiming>("~/performance");
   this->dataPtr->modelPub = this->dataPtr->node->Advertise<msgs::Model>(
       "~/model/info");
   this->dataPtr->lightPub = this->dataPtr->node->Advertise<msgs::Light>(
@@ -317,6 +471,23 @@ void World::Load(sdf::ElementPtr _sdf)
         << std::endl;
   }
 
+  std::string collisionQueryService(
+      "/world/" + this->Name() + "/collision_query");
+  if (!this->dataPtr->ignNode.Advertise(collisionQueryService,
+      &World::CollisionQueryService, this))
+  {
+    gzerr << "Error advertising service [" << collisionQueryService << "]"
+        << std::endl;
+  }
+
+  std::string proximityService("/world/" + this->Name() + "/proximity");
+  if (!this->dataPtr->ignNode.Advertise(proximityService,
+      &World::ProximityService, this))
+  {
+    gzerr << "Error advertising service [" << proximityService << "]"
+        << std::endl;
+  }
+
   std::string shadowCasterMaterialNameService("/shadow_caster_material_name");
   if (!this->dataPtr->ignNode.Advertise(shadowCasterMaterialNameService,
       &World::ShadowCasterMaterialNameService, this))
@@ -368,6 +539,25 @@ void World::Load(sdf::ElementPtr _sdf)
 
   this->dataPtr->atmosphere->Load(atmosphereElem);
 
+  {
+    const std::string kElementName = "ignition:atmosphere_table_resolution";
+    if (this->dataPtr->sdf->HasElement(kElementName))
+    {
+      auto adiabatic = dynamic_cast<AdiabaticAtmosphere *>(
+          this->dataPtr->atmosphere.get());
+      if (adiabatic)
+      {
+        adiabatic->SetTableResolution(
+            this->dataPtr->sdf->Get<double>(kElementName));
+      }
+      else
+      {
+        gzwarn << "<" << kElementName << "> only applies to the adiabatic "
+               << "atmosphere model\n";
+      }
+    }
+  }
+
   // This should also come before loading of entities
   {
     sdf::ElementPtr spherical = this->dataPtr->sdf->GetElement(
@@ -391,11 +581,18 @@ void World::Load(sdf::ElementPtr _sdf)
   this->dataPtr->rootElement.reset(new Base(BasePtr()));
   this->dataPtr->rootElement->SetName(this->Name());
   this->dataPtr->rootElement->SetWorld(shared_from_this());
+  this->_AddToIndex(this->dataPtr->rootElement);
 
   // A special order is necessary when loading a world that contains state
   // information. The joints must be created last, otherwise they get
   // initialized improperly.
   {
+    // Parse the meshes in parallel up front, instead of one at a time as
+    // each collision and actor is loaded
+    std::vector<std::string> meshFiles;
+    collect_mesh_files(this->dataPtr->sdf, meshFiles);
+    common::MeshManager::Instance()->Prefetch(meshFiles);
+
     // Create all the entities
     this->LoadEntities(this->dataPtr->sdf, this->dataPtr->rootElement);
 
@@ -403,13 +600,102 @@ void World::Load(sdf::ElementPtr _sdf)
       this->ModelByIndex(i)->LoadJoints();
   }
 
-  // TODO: Performance test to see if TBB model updating is necessary
-  // Choose threaded or unthreaded model updating depending on the number of
-  // models in the scene
-  // if (this->ModelCount() < 20)
+  // Models are updated serially unless the world opts in to parallel
+  // updates. Model::Update of different models must not depend on each
+  // other when the parallel mode is enabled.
   this->dataPtr->modelUpdateFunc = &World::ModelUpdateSingleLoop;
-  // else
-  // this->dataPtr->modelUpdateFunc = &World::ModelUpdateTBB;
+  {
+    const std::string kElementName = "ignition:parallel_model_update";
+    if (this->dataPtr->sdf->HasElement(kElementName) &&
+        this->dataPtr->sdf->Get<bool>(kElementName))
+    {
+      this->dataPtr->modelUpdateFunc = &World::ModelUpdateTBB;
+    }
+  }
+
+  // Automatic sleeping of resting models.
+  {
+    const std::string kElementName = "ignition:auto_sleep";
+    if (this->dataPtr->sdf->HasElement(kElementName))
+    {
+      this->dataPtr->sleepManager->SetEnabled(
+          this->dataPtr->sdf->Get<bool>(kElementName));
+    }
+  }
+  {
+    const std::string kElementName = "ignition:auto_sleep_linear_velocity";
+    if (this->dataPtr->sdf->HasElement(kElementName))
+    {
+      this->dataPtr->sleepManager->SetLinearVelocityThreshold(
+          this->dataPtr->sdf->Get<double>(kElementName));
+    }
+  }
+  {
+    const std::string kElementName = "ignition:auto_sleep_angular_velocity";
+    if (this->dataPtr->sdf->HasElement(kElementName))
+    {
+      this->dataPtr->sleepManager->SetAngularVelocityThreshold(
+          this->dataPtr->sdf->Get<double>(kElementName));
+    }
+  }
+  {
+    const std::string kElementName = "ignition:auto_sleep_time";
+    if (this->dataPtr->sdf->HasElement(kElementName))
+    {
+      this->dataPtr->sleepManager->SetTimeThreshold(
+          this->dataPtr->sdf->Get<double>(kElementName));
+    }
+  }
+
+  {
+    const std::string kElementName = "ignition:contacts_rate";
+    if (this->dataPtr->sdf->HasElement(kElementName))
+    {
+      this->dataPtr->physicsEngine->GetContactManager()->SetPublishRate(
+          this->dataPtr->sdf->Get<double>(kElementName));
+    }
+  }
+  {
+    const std::string kElementName = "ignition:contacts_wrenches";
+    if (this->dataPtr->sdf->HasElement(kElementName))
+    {
+      this->dataPtr->physicsEngine->GetContactManager()->SetPublishWrenches(
+          this->dataPtr->sdf->Get<bool>(kElementName));
+    }
+  }
+
+  {
+    const std::string kElementName = "ignition:link_kinematics_cache";
+    if (this->dataPtr->sdf->HasElement(kElementName))
+    {
+      this->SetLinkKinematicsCacheEnabled(
+          this->dataPtr->sdf->Get<bool>(kElementName));
+    }
+  }
+  {
+    const std::string kElementName = "ignition:spatial_index_cell_size";
+    if (this->dataPtr->sdf->HasElement(kElementName))
+    {
+      this->dataPtr->spatialIndex.SetCellSize(
+          this->dataPtr->sdf->Get<double>(kElementName));
+    }
+  }
+  {
+    const std::string kElementName = "ignition:spatial_index";
+    if (this->dataPtr->sdf->HasElement(kElementName))
+    {
+      this->SetSpatialIndexEnabled(
+          this->dataPtr->sdf->Get<bool>(kElementName));
+    }
+  }
+  {
+    const std::string kElementName = "ignition:proximity_index";
+    if (this->dataPtr->sdf->HasElement(kElementName))
+    {
+      this->SetProximityIndexEnabled(
+          this->dataPtr->sdf->Get<bool>(kElementName));
+    }
+  }
 
   event::Events::worldCreated(this->Name());
 
@@ -473,12 +759,18 @@ void World::Init(UpdateScenePosesFunc _func)
     return;
   }
 
+  common::StartupTraceScope trace("World::Init", "world", this->Name());
+
   // Initialize all the entities (i.e. Model)
   for (unsigned int i = 0; i < this->dataPtr->rootElement->GetChildCount(); ++i)
     this->dataPtr->rootElement->GetChild(i)->Init();
 
   // Initialize the physics engine
-  this->dataPtr->physicsEngine->Init();
+  {
+    common::StartupTraceScope physicsTrace("PhysicsEngine::Init", "physics",
+        this->dataPtr->physicsEngine->GetType());
+    this->dataPtr->physicsEngine->Init();
+  }
 
   this->dataPtr->presetManager = PresetManagerPtr(
       new PresetManager(this->dataPtr->physicsEngine, this->dataPtr->sdf));
@@ -495,7 +787,6 @@ void World::Init(UpdateScenePosesFunc _func)
   this->dataPtr->updateInfo.worldName = this->Name();
 
   this->dataPtr->iterations = 0;
-  this->dataPtr->logPrevIteration = 0;
 
   util::DiagnosticManager::Instance()->Init(this->Name());
 
@@ -570,6 +861,7 @@ bool World::Running() const
 void World::Stop()
 {
   this->dataPtr->stop = true;
+  this->dataPtr->stepIncCondition.notify_all();
 
   // Make sure that the thread does not try to join with itself
   if (this->dataPtr->thread &&
@@ -642,6 +934,14 @@ void World::RunLoop()
 //////////////////////////////////////////////////
 void World::LogStep()
 {
+  // Sensors with a strict rate are done with the current state before it
+  // is replaced. Waiting holds no lock, as in Step().
+  if (this->dataPtr->waitForSensors)
+  {
+    this->dataPtr->waitForSensors(this->dataPtr->simTime.Double(),
+        this->dataPtr->logPlayStepSize.Double());
+  }
+
   {
     std::lock_guard<std::recursive_mutex> lk(this->dataPtr->worldUpdateMutex);
 
@@ -666,9 +966,19 @@ void World::LogStep()
 
         this->dataPtr->logPlayState.Load(this->dataPtr->logPlayStateSDF);
 
-        // If it's the first step, we're going back in time or
-        // rt factor is close to zero, don't sleep.
-        if ((this->dataPtr->logPlayRealTimeFactor > 1e-5) &&
+        if (this->dataPtr->logLastStatePlayedSimTime != common::Time(0) &&
+            this->dataPtr->logLastStatePlayedSimTime <
+              this->dataPtr->logPlayState.GetSimTime())
+        {
+          this->dataPtr->logPlayStepSize =
+              this->dataPtr->logPlayState.GetSimTime() -
+              this->dataPtr->logLastStatePlayedSimTime;
+        }
+
+        // If it's the first step, we're going back in time, playing at
+        // maximum speed or rt factor is close to zero, don't sleep.
+        if (!this->dataPtr->logPlayMaxSpeed &&
+            (this->dataPtr->logPlayRealTimeFactor > 1e-5) &&
             (this->dataPtr->logLastStatePlayedRealTime != common::Time(0)) &&
             (this->dataPtr->logLastStatePlayedSimTime != common::Time(0)) &&
             (this->dataPtr->logLastStatePlayedSimTime <
@@ -706,9 +1016,18 @@ void World::LogStep()
       if (this->dataPtr->stepInc > 0)
         this->dataPtr->stepInc--;
     }
+
+    if (this->dataPtr->stepInc == 0)
+      this->dataPtr->stepIncCondition.notify_all();
   }
 
-  this->PublishWorldStats();
+  if (!this->dataPtr->logPlayMaxSpeed || this->IsPaused() ||
+      this->dataPtr->worldStatsStepPeriod <= 1 ||
+      this->dataPtr->iterations % this->dataPtr->worldStatsStepPeriod == 0)
+  {
+    this->PublishWorldStats();
+  }
+  this->PublishClock();
 
   this->ProcessMessages();
 }
@@ -731,6 +1050,12 @@ void World::SetSensorWaitFunc(std::function<void(double, double)> _func)
   this->dataPtr->waitForSensors = _func;
 }
 
+/////////////////////////////////////////////////
+void World::SetLogPlayMaxSpeed(const bool _enable)
+{
+  this->dataPtr->logPlayMaxSpeed = _enable;
+}
+
 //////////////////////////////////////////////////
 void World::Step()
 {
@@ -756,68 +1081,113 @@ void World::Step()
   IGN_PROFILE_END();
   DIAG_TIMER_LAP("World::Step", "loadPlugins");
 
+  double updatePeriod = this->dataPtr->physicsEngine->GetUpdatePeriod();
+
+  // A zero update period means "as fast as possible". In that mode the
+  // throttling below is skipped and world statistics are only published
+  // every worldStatsStepPeriod iterations.
+  const bool fastStep = updatePeriod <= 0.0;
+
   IGN_PROFILE_BEGIN("publishWorldStats");
   // Send statistics about the world simulation
-  this->PublishWorldStats();
+  if (!fastStep || this->IsPaused() ||
+      this->dataPtr->worldStatsStepPeriod <= 1 ||
+      this->dataPtr->iterations % this->dataPtr->worldStatsStepPeriod == 0)
+  {
+    this->PublishWorldStats();
+  }
   IGN_PROFILE_END();
 
   DIAG_TIMER_LAP("World::Step", "publishWorldStats");
 
   IGN_PROFILE_BEGIN("waitForSensors");
   if (this->dataPtr->waitForSensors)
+  {
+    StepStageTimer timer(*this->dataPtr, STEP_STAGE_SENSORS_WAIT);
     this->dataPtr->waitForSensors(this->dataPtr->simTime.Double(),
         this->dataPtr->physicsEngine->GetMaxStepSize());
+  }
   IGN_PROFILE_END();
 
   IGN_PROFILE_BEGIN("sleepOffset");
-  double updatePeriod = this->dataPtr->physicsEngine->GetUpdatePeriod();
-  // sleep here to get the correct update rate
-  common::Time tmpTime = common::Time::GetWallTime();
-  common::Time sleepTime = this->dataPtr->prevStepWallTime +
-    common::Time(updatePeriod) - tmpTime - this->dataPtr->sleepOffset;
-
-  common::Time actualSleep;
-  if (sleepTime > 0)
+  if (!fastStep)
   {
-    common::Time::Sleep(sleepTime);
-    actualSleep = common::Time::GetWallTime() - tmpTime;
+    // sleep here to get the correct update rate
+    common::Time tmpTime = common::Time::GetWallTime();
+    common::Time sleepTime = this->dataPtr->prevStepWallTime +
+      common::Time(updatePeriod) - tmpTime - this->dataPtr->sleepOffset;
+
+    common::Time actualSleep;
+    if (sleepTime > 0)
+    {
+      common::Time::Sleep(sleepTime);
+      actualSleep = common::Time::GetWallTime() - tmpTime;
+    }
+    else
+      sleepTime = 0;
+
+    // exponentially avg out
+    this->dataPtr->sleepOffset = (actualSleep - sleepTime) * 0.01 +
+                        this->dataPtr->sleepOffset * 0.99;
   }
   else
-    sleepTime = 0;
-
-  // exponentially avg out
-  this->dataPtr->sleepOffset = (actualSleep - sleepTime) * 0.01 +
-                      this->dataPtr->sleepOffset * 0.99;
+  {
+    this->dataPtr->sleepOffset = common::Time::Zero;
+  }
 
   IGN_PROFILE_END();
   DIAG_TIMER_LAP("World::Step", "sleepOffset");
 
+  // True if this call did not advance the simulation.
+  bool idle = false;
+
+  // True if this call finished a World::StepBatch.
+  bool batchDone = false;
+
   IGN_PROFILE_BEGIN("worldUpdateMutex");
   // throttling update rate, with sleepOffset as tolerance
   // the tolerance is needed as the sleep time is not exact
-  if (common::Time::GetWallTime() - this->dataPtr->prevStepWallTime +
+  if (fastStep ||
+      common::Time::GetWallTime() - this->dataPtr->prevStepWallTime +
       this->dataPtr->sleepOffset >= common::Time(updatePeriod))
   {
     std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
 
     DIAG_TIMER_LAP("World::Step", "worldUpdateMutex");
 
-    this->dataPtr->prevStepWallTime = common::Time::GetWallTime();
+    if (!fastStep)
+      this->dataPtr->prevStepWallTime = common::Time::GetWallTime();
 
     double stepTime = this->dataPtr->physicsEngine->GetMaxStepSize();
 
     if (!this->IsPaused() || this->dataPtr->stepInc > 0
         || this->dataPtr->needsReset)
     {
-      // query timestep to allow dynamic time step size updates
-      this->dataPtr->simTime += stepTime;
-      this->dataPtr->iterations++;
-      this->Update();
+      // A batch runs all of its iterations here, back to back. Messages are
+      // processed once afterwards.
+      const bool batch = this->dataPtr->stepBatch;
+      do
+      {
+        // query timestep to allow dynamic time step size updates
+        stepTime = this->dataPtr->physicsEngine->GetMaxStepSize();
+        this->dataPtr->simTime += stepTime;
+        this->dataPtr->iterations++;
+        this->Update();
 
-      DIAG_TIMER_LAP("World::Step", "update");
+        DIAG_TIMER_LAP("World::Step", "update");
 
-      if (this->IsPaused() && this->dataPtr->stepInc > 0)
-        this->dataPtr->stepInc--;
+        if (this->IsPaused() && this->dataPtr->stepInc > 0)
+        {
+          this->dataPtr->stepInc--;
+          if (this->dataPtr->stepInc == 0 && !batch)
+            this->dataPtr->stepIncCondition.notify_all();
+        }
+      } while (batch && this->IsPaused() && this->dataPtr->stepInc > 0 &&
+          !this->dataPtr->stop &&
+          (!this->dataPtr->stopIterations ||
+           this->dataPtr->iterations < this->dataPtr->stopIterations));
+
+      batchDone = batch;
     }
     else
     {
@@ -825,18 +1195,43 @@ void World::Step()
       if (util::LogRecord::Instance()->BufferSize() > 0)
         util::LogRecord::Instance()->Notify();
       this->dataPtr->pauseTime += stepTime;
+      idle = true;
     }
   }
   IGN_PROFILE_END();
 
+  // Without throttling nothing else sleeps, so give up the time slice while
+  // paused instead of spinning on worldUpdateMutex.
+  if (fastStep && idle)
+    std::this_thread::yield();
+
   IGN_PROFILE_BEGIN("IntrospectionManager->NotifyUpdates");
   gazebo::util::IntrospectionManager::Instance()->NotifyUpdates();
   IGN_PROFILE_END();
 
   IGN_PROFILE_BEGIN("ProcessMessages");
-  this->ProcessMessages();
+  {
+    StepStageTimer timer(*this->dataPtr, STEP_STAGE_MESSAGES);
+    this->ProcessMessages();
+  }
   IGN_PROFILE_END();
 
+  this->PublishStepTimings();
+  this->PublishClock();
+  this->PublishJointStates();
+  this->PublishBatteryStates();
+
+  // Release World::StepBatch only once the messages of the batch have been
+  // processed.
+  if (batchDone)
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
+    this->dataPtr->stepInc = 0;
+    this->dataPtr->stepBatch = false;
+    this->dataPtr->stepBatchFlags = STEP_BATCH_NONE;
+    this->dataPtr->stepIncCondition.notify_all();
+  }
+
   DIAG_TIMER_STOP("World::Step");
 
   IGN_PROFILE_BEGIN("ClearModels");
@@ -854,19 +1249,59 @@ void World::Step(const unsigned int _steps)
     this->SetPaused(true);
   }
 
+  std::unique_lock<std::recursive_mutex> lock(
+      this->dataPtr->worldUpdateMutex);
+  this->dataPtr->stepInc = _steps;
+
+  // block on completion. The update thread signals stepIncCondition when
+  // stepInc reaches zero; the timeout guards against a stop request that
+  // was issued without notifying.
+  while (this->dataPtr->stepInc != 0 && !this->dataPtr->stop)
+  {
+    this->dataPtr->stepIncCondition.wait_for(lock,
+        std::chrono::milliseconds(10));
+  }
+}
+
+//////////////////////////////////////////////////
+void World::StepBatch(const unsigned int _steps, const unsigned int _flags)
+{
+  this->StartStepBatch(_steps, _flags);
+  this->WaitStepBatch();
+}
+
+//////////////////////////////////////////////////
+void World::StartStepBatch(const unsigned int _steps,
+    const unsigned int _flags)
+{
+  if (!this->IsPaused())
   {
-    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
-    this->dataPtr->stepInc = _steps;
+    gzwarn << "Calling World::StepBatch(steps) while world is not paused\n";
+    this->SetPaused(true);
   }
 
-  // block on completion
-  bool wait = true;
-  while (wait)
+  if (_steps == 0)
+    return;
+
+  std::unique_lock<std::recursive_mutex> lock(
+      this->dataPtr->worldUpdateMutex);
+  this->dataPtr->stepBatch = true;
+  this->dataPtr->stepBatchFlags = _flags;
+  this->dataPtr->stepInc = _steps;
+}
+
+//////////////////////////////////////////////////
+void World::WaitStepBatch()
+{
+  std::unique_lock<std::recursive_mutex> lock(
+      this->dataPtr->worldUpdateMutex);
+
+  // block on completion, see World::Step(unsigned int).
+  while ((this->dataPtr->stepInc != 0 || this->dataPtr->stepBatch) &&
+         !this->dataPtr->stop)
   {
-    common::Time::NSleep(1);
-    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
-    if (this->dataPtr->stepInc == 0 || this->dataPtr->stop)
-      wait = false;
+    this->dataPtr->stepIncCondition.wait_for(lock,
+        std::chrono::milliseconds(10));
   }
 }
 
@@ -876,6 +1311,7 @@ void World::Update()
   DIAG_TIMER_START("World::Update");
 
   IGN_PROFILE("World::Update");
+  StepStageTimer updateTimer(*this->dataPtr, STEP_STAGE_UPDATE);
   IGN_PROFILE_BEGIN("needsReset");
   if (this->dataPtr->needsReset)
   {
@@ -891,13 +1327,25 @@ void World::Update()
   IGN_PROFILE_END();
   DIAG_TIMER_LAP("World::Update", "needsReset");
 
+  const unsigned int batchFlags = this->dataPtr->stepBatchFlags;
+  const bool fireEvents = !(batchFlags & STEP_BATCH_NO_EVENTS);
+
+  IGN_PROFILE_BEGIN("SimTimeScheduler");
+  this->dataPtr->scheduler.Update(this->dataPtr->simTime);
+  IGN_PROFILE_END();
+
   IGN_PROFILE_BEGIN("worldUpdateBegin");
   this->dataPtr->updateInfo.simTime = this->SimTime();
   this->dataPtr->updateInfo.realTime = this->RealTime();
-  event::Events::worldUpdateBegin(this->dataPtr->updateInfo);
+  if (fireEvents)
+    event::Events::worldUpdateBegin(this->dataPtr->updateInfo);
   IGN_PROFILE_END();
   DIAG_TIMER_LAP("World::Update", "Events::worldUpdateBegin");
 
+  IGN_PROFILE_BEGIN("BatterySystem::Update");
+  this->dataPtr->batterySystem->Update();
+  IGN_PROFILE_END();
+
   IGN_PROFILE_BEGIN("Update");
   // Update all the models
   (*this.*dataPtr->modelUpdateFunc)();
@@ -906,30 +1354,19 @@ void World::Update()
 
   IGN_PROFILE_BEGIN("UpdateCollision");
   // This must be called before PhysicsEngine::UpdatePhysics for ODE.
-  this->dataPtr->physicsEngine->UpdateCollision();
+  {
+    StepStageTimer timer(*this->dataPtr, STEP_STAGE_COLLISION);
+    this->dataPtr->physicsEngine->UpdateCollision();
+  }
   IGN_PROFILE_END();
   DIAG_TIMER_LAP("World::Update", "PhysicsEngine::UpdateCollision");
 
   IGN_PROFILE_BEGIN("beforePhysicsUpdate");
-  // Wait for logging to finish, if it's running.
-  if (util::LogRecord::Instance()->Running())
-  {
-    std::unique_lock<std::mutex> lock(this->dataPtr->logMutex);
-
-    // It's possible the logWorker thread never processed the previous
-    // state. This checks to make sure that we don't continute until the log
-    // worker catchs up.
-    if (this->dataPtr->iterations - this->dataPtr->logPrevIteration > 1)
-    {
-      this->dataPtr->logCondition.notify_one();
-      this->dataPtr->logContinueCondition.wait(lock);
-    }
-  }
-
   // Give clients a possibility to react to collisions before the physics
   // gets updated.
   this->dataPtr->updateInfo.realTime = this->RealTime();
-  event::Events::beforePhysicsUpdate(this->dataPtr->updateInfo);
+  if (fireEvents)
+    event::Events::beforePhysicsUpdate(this->dataPtr->updateInfo);
 
   IGN_PROFILE_END();
   DIAG_TIMER_LAP("World::Update", "Events::beforePhysicsUpdate");
@@ -939,7 +1376,10 @@ void World::Update()
   {
     IGN_PROFILE_BEGIN("UpdatePhysics");
     // This must be called directly after PhysicsEngine::UpdateCollision.
-    this->dataPtr->physicsEngine->UpdatePhysics();
+    {
+      StepStageTimer timer(*this->dataPtr, STEP_STAGE_PHYSICS);
+      this->dataPtr->physicsEngine->UpdatePhysics();
+    }
 
     IGN_PROFILE_END();
     DIAG_TIMER_LAP("World::Update", "PhysicsEngine::UpdatePhysics");
@@ -963,25 +1403,60 @@ void World::Update()
     }
 
     DIAG_TIMER_LAP("World::Update", "SetWorldPose(dirtyPoses)");
+
+    if (this->dataPtr->linkKinematicsEnabled)
+    {
+      IGN_PROFILE_BEGIN("LinkKinematicsCache::Update");
+      uint64_t entityVersion;
+      {
+        std::lock_guard<std::mutex> lock(this->dataPtr->indexMutex);
+        entityVersion = this->dataPtr->entityVersion;
+      }
+      this->dataPtr->linkKinematics.Update(shared_from_this(), entityVersion);
+      IGN_PROFILE_END();
+      DIAG_TIMER_LAP("World::Update", "LinkKinematicsCache::Update");
+    }
+
+    IGN_PROFILE_BEGIN("SleepManager::Update");
+    // Keep updating while disabled until every model is awake again.
+    if (this->dataPtr->sleepManager->Enabled() ||
+        this->dataPtr->sleepManager->SleepingModelCount() > 0)
+    {
+      uint64_t entityVersion;
+      {
+        std::lock_guard<std::mutex> lock(this->dataPtr->indexMutex);
+        entityVersion = this->dataPtr->entityVersion;
+      }
+      this->dataPtr->sleepManager->Update(shared_from_this(),
+          this->dataPtr->physicsEngine->GetMaxStepSize(), entityVersion);
+    }
+    IGN_PROFILE_END();
+    DIAG_TIMER_LAP("World::Update", "SleepManager::Update");
   }
 
   IGN_PROFILE_BEGIN("LogRecordNotify");
   // Only update state information if logging data.
   if (util::LogRecord::Instance()->Running())
-    this->dataPtr->logCondition.notify_one();
+  {
+    StepStageTimer timer(*this->dataPtr, STEP_STAGE_LOG);
+    this->LogCapture();
+  }
   IGN_PROFILE_END();
   DIAG_TIMER_LAP("World::Update", "LogRecordNotify");
 
   IGN_PROFILE_BEGIN("PublishContacts");
   // Output the contact information
-  this->dataPtr->physicsEngine->GetContactManager()->PublishContacts();
+  if (!(batchFlags & STEP_BATCH_NO_PUBLISH))
+    this->dataPtr->physicsEngine->GetContactManager()->PublishContacts();
 
   IGN_PROFILE_END();
   DIAG_TIMER_LAP("World::Update", "ContactManager::PublishContacts");
 
-  event::Events::worldUpdateEnd();
+  if (fireEvents)
+    event::Events::worldUpdateEnd();
 
-  gazebo::util::IntrospectionManager::Instance()->Update();
+  if (!(batchFlags & STEP_BATCH_NO_INTROSPECTION))
+    gazebo::util::IntrospectionManager::Instance()->Update();
 
   DIAG_TIMER_STOP("World::Update");
 }
@@ -990,8 +1465,21 @@ void World::Update()
 void World::Fini()
 {
   this->dataPtr->stop = true;
+  this->dataPtr->stepIncCondition.notify_all();
   this->dataPtr->enablePhysicsEngine = false;
 
+  if (this->dataPtr->factoryThread)
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->factoryMutex);
+      this->dataPtr->factoryStop = true;
+    }
+    this->dataPtr->factoryCondition.notify_all();
+    this->dataPtr->factoryThread->join();
+    delete this->dataPtr->factoryThread;
+    this->dataPtr->factoryThread = nullptr;
+  }
+
   // wait until World::Step has completed before proceeding
   std::lock_guard<std::mutex> lock(this->dataPtr->stepMutex);
 
@@ -1015,6 +1503,7 @@ void World::Fini()
     this->dataPtr->deleteEntity.clear();
     this->dataPtr->requestMsgs.clear();
     this->dataPtr->factoryMsgs.clear();
+    this->dataPtr->insertedModels.clear();
     this->dataPtr->modelMsgs.clear();
     this->dataPtr->lightFactoryMsgs.clear();
     this->dataPtr->lightModifyMsgs.clear();
@@ -1022,9 +1511,17 @@ void World::Fini()
 
     this->dataPtr->poseLocalPub.reset();
     this->dataPtr->posePub.reset();
+    this->dataPtr->compactPosePub.reset();
+    this->dataPtr->compactPoseAckSub.reset();
     this->dataPtr->guiPub.reset();
     this->dataPtr->responsePub.reset();
     this->dataPtr->statPub.reset();
+    this->dataPtr->clockPub.reset();
+    this->dataPtr->jointStatesPub.reset();
+    this->dataPtr->jointStatesModels.clear();
+    this->dataPtr->batteryStatesPub.reset();
+    this->dataPtr->shmClock.Close();
+    this->dataPtr->performancePub.reset();
     this->dataPtr->modelPub.reset();
     this->dataPtr->lightPub.reset();
     this->dataPtr->lightFactoryPub.reset();
@@ -1072,9 +1569,20 @@ void World::Fini()
     this->dataPtr->rootElement->Fini();
     this->dataPtr->rootElement.reset();
   }
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->indexMutex);
+    this->dataPtr->nameIndex.clear();
+    this->dataPtr->idIndex.clear();
+    ++this->dataPtr->entityVersion;
+  }
+  this->dataPtr->linkKinematics.Clear();
+  this->dataPtr->spatialIndex.Clear();
+  this->dataPtr->proximityIndex.Clear();
+  this->dataPtr->collisionQuery.Clear();
+  this->dataPtr->sleepManager->Clear();
+  this->dataPtr->batterySystem->Clear();
   this->dataPtr->prevStates[0].SetWorld(WorldPtr());
   this->dataPtr->prevStates[1].SetWorld(WorldPtr());
-  this->dataPtr->prevUnfilteredState.SetWorld(WorldPtr());
   this->dataPtr->logPlayState.SetWorld(WorldPtr());
   this->dataPtr->states[0].clear();
   this->dataPtr->states[1].clear();
@@ -1166,19 +1674,31 @@ PresetManagerPtr World::PresetMgr() const
 }
 
 //////////////////////////////////////////////////
-common::SphericalCoordinatesPtr World::SphericalCoords() const
+SleepManagerPtr World::SleepMgr() const
 {
-  return this->dataPtr->sphericalCoordinates;
+  return this->dataPtr->sleepManager;
 }
 
 //////////////////////////////////////////////////
-ignition::math::Vector3d World::Gravity() const
+BatterySystemPtr World::Batteries() const
 {
-  return this->dataPtr->sdf->Get<ignition::math::Vector3d>("gravity");
+  return this->dataPtr->batterySystem;
 }
 
 //////////////////////////////////////////////////
-void World::SetGravity(const ignition::math::Vector3d &_gravity)
+common::SphericalCoordinatesPtr World::SphericalCoords() const
+{
+  return this->dataPtr->sphericalCoordinates;
+}
+
+//////////////////////////////////////////////////
+ignition::math::Vector3d World::Gravity() const
+{
+  return this->dataPtr->sdf->Get<ignition::math::Vector3d>("gravity");
+}
+
+//////////////////////////////////////////////////
+void World::SetGravity(const ignition::math::Vector3d &_gravity)
 {
   // This function calls `PhysicsEngine::SetGravity`,
   // which in turn should call `World::SetGravitySDF`.
@@ -1206,19 +1726,103 @@ void World::SetMagneticField(const ignition::math::Vector3d &_mag)
 //////////////////////////////////////////////////
 BasePtr World::BaseByName(const std::string &_name) const
 {
-  if (this->dataPtr->rootElement)
-    return this->dataPtr->rootElement->GetByName(_name);
-  else
+  if (!this->dataPtr->rootElement)
     return BasePtr();
+
+  BasePtr result = this->_BaseByScopedName(_name);
+  if (result)
+    return result;
+
+  // Names that are not fully scoped require a search of the entity tree.
+  return this->dataPtr->rootElement->GetByName(_name);
+}
+
+/////////////////////////////////////////////////
+BasePtr World::_BaseByScopedName(const std::string &_scopedName) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->indexMutex);
+  auto iter = this->dataPtr->nameIndex.find(_scopedName);
+  if (iter != this->dataPtr->nameIndex.end())
+    return iter->second.lock();
+  return BasePtr();
 }
 
 /////////////////////////////////////////////////
 ModelPtr World::ModelById(unsigned int _id) const
 {
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->indexMutex);
+    auto iter = this->dataPtr->idIndex.find(_id);
+    if (iter != this->dataPtr->idIndex.end())
+    {
+      BasePtr base = iter->second.lock();
+      if (base)
+        return boost::dynamic_pointer_cast<Model>(base);
+    }
+  }
+
   return boost::dynamic_pointer_cast<Model>(
       this->dataPtr->rootElement->GetByIdRecursive(_id));
 }
 
+/////////////////////////////////////////////////
+void World::_AddToIndex(const BasePtr &_base)
+{
+  if (!_base)
+    return;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->indexMutex);
+
+  // Keep the first entity registered with a given scoped name, which
+  // matches the order of a depth first search of the entity tree.
+  auto &entry = this->dataPtr->nameIndex[_base->GetScopedName()];
+  if (entry.expired())
+    entry = _base;
+
+  this->dataPtr->idIndex[_base->GetId()] = _base;
+  ++this->dataPtr->entityVersion;
+}
+
+/////////////////////////////////////////////////
+bool World::_RemoveFromIndex(const Base *_base)
+{
+  if (!_base)
+    return false;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->indexMutex);
+  bool removed = false;
+
+  // Only erase entries that refer to _base, or to entities that no longer
+  // exist. In the latter case lock() fails, which is also what happens when
+  // this is called from the destructor of _base.
+  auto nameIter = this->dataPtr->nameIndex.find(_base->GetScopedName());
+  if (nameIter != this->dataPtr->nameIndex.end())
+  {
+    BasePtr indexed = nameIter->second.lock();
+    if (!indexed || indexed.get() == _base)
+    {
+      this->dataPtr->nameIndex.erase(nameIter);
+      removed = true;
+    }
+  }
+
+  auto idIter = this->dataPtr->idIndex.find(_base->GetId());
+  if (idIter != this->dataPtr->idIndex.end())
+  {
+    BasePtr indexed = idIter->second.lock();
+    if (!indexed || indexed.get() == _base)
+    {
+      this->dataPtr->idIndex.erase(idIter);
+      removed = true;
+    }
+  }
+
+  if (removed)
+    ++this->dataPtr->entityVersion;
+
+  return removed;
+}
+
 //////////////////////////////////////////////////
 ModelPtr World::ModelByName(const std::string &_name) const
 {
@@ -1248,17 +1852,31 @@ ModelPtr World::LoadModel(sdf::ElementPtr _sdf , BasePtr _parent)
   if (_sdf->GetName() == "model")
   {
     std::string modelName = _sdf->Get<std::string>("name");
-    for (auto const &m : this->dataPtr->models)
+    bool exists = false;
+    if (this->dataPtr->batchLoading)
+    {
+      exists = !this->dataPtr->batchModelNames.insert(modelName).second;
+    }
+    else
     {
-      if (m->GetName() == modelName)
+      for (auto const &m : this->dataPtr->models)
       {
-        gzwarn << "Model with name [" << modelName << "] already exists. "
-          << "Not inserting model. This warning can be ignored in certain "
-          << "situations such as rewind during log playback.\n";
-        return model;
+        if (m->GetName() == modelName)
+        {
+          exists = true;
+          break;
+        }
       }
     }
 
+    if (exists)
+    {
+      gzwarn << "Model with name [" << modelName << "] already exists. "
+        << "Not inserting model. This warning can be ignored in certain "
+        << "situations such as rewind during log playback.\n";
+      return model;
+    }
+
     model = this->dataPtr->physicsEngine->CreateModel(_parent);
     model->SetWorld(shared_from_this());
     model->Load(_sdf);
@@ -1269,7 +1887,8 @@ ModelPtr World::LoadModel(sdf::ElementPtr _sdf , BasePtr _parent)
     model->FillMsg(msg);
     this->dataPtr->modelPub->Publish(msg);
 
-    this->EnableAllModels();
+    if (!this->dataPtr->batchLoading)
+      this->EnableAllModels();
   }
   else
   {
@@ -1364,6 +1983,13 @@ void World::LoadEntities(sdf::ElementPtr _sdf, BasePtr _parent)
   {
     sdf::ElementPtr childElem = _sdf->GetElement("model");
 
+    // Check the names against a set and enable the models once at the
+    // end, instead of walking all the models loaded so far for each one
+    this->dataPtr->batchLoading = true;
+    this->dataPtr->batchModelNames.clear();
+    for (auto const &m : this->dataPtr->models)
+      this->dataPtr->batchModelNames.insert(m->GetName());
+
     while (childElem)
     {
       this->LoadModel(childElem, _parent);
@@ -1373,6 +1999,10 @@ void World::LoadEntities(sdf::ElementPtr _sdf, BasePtr _parent)
 
       childElem = childElem->GetNextElement("model");
     }
+
+    this->dataPtr->batchLoading = false;
+    this->dataPtr->batchModelNames.clear();
+    this->EnableAllModels();
   }
 
   if (_sdf->HasElement("actor"))
@@ -1424,7 +2054,7 @@ ModelPtr World::ModelByIndex(const unsigned int _index) const
 }
 
 //////////////////////////////////////////////////
-Model_V World::Models() const
+const Model_V &World::Models() const
 {
   return this->dataPtr->models;
 }
@@ -1505,6 +2135,12 @@ gazebo::common::Time World::SimTime() const
   return this->dataPtr->simTime;
 }
 
+//////////////////////////////////////////////////
+common::SimTimeScheduler &World::Scheduler()
+{
+  return this->dataPtr->scheduler;
+}
+
 //////////////////////////////////////////////////
 void World::SetSimTime(const common::Time &_t)
 {
@@ -1640,6 +2276,18 @@ void World::ProcessPlaybackControlMsgs()
 {
   std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
 
+  // Seeking a large log is slow. When the timeline is dragged around, only
+  // the last of several seeks received together matters.
+  const msgs::LogPlaybackControl *lastJump = nullptr;
+  for (auto const &msg : this->dataPtr->playbackControlMsgs)
+  {
+    if (msg.has_seek() || (msg.has_rewind() && msg.rewind()) ||
+        (msg.has_forward() && msg.forward()))
+    {
+      lastJump = &msg;
+    }
+  }
+
   for (auto const &msg : this->dataPtr->playbackControlMsgs)
   {
     if (msg.has_pause())
@@ -1653,7 +2301,7 @@ void World::ProcessPlaybackControlMsgs()
       this->dataPtr->stepInc += msg.multi_step();
     }
 
-    if (msg.has_seek())
+    if (msg.has_seek() && &msg == lastJump)
     {
       common::Time targetSimTime = msgs::Convert(msg.seek());
       util::LogPlay::Instance()->Seek(targetSimTime);
@@ -1721,14 +2369,22 @@ void World::OnModelMsg(ConstModelPtr &_msg)
 }
 
 //////////////////////////////////////////////////
-void World::BuildSceneMsg(msgs::Scene &_scene, BasePtr _entity)
+void World::BuildSceneMsg(msgs::Scene &_scene, BasePtr _entity,
+    Model_V *_models)
 {
   if (_entity)
   {
     if (_entity->HasType(Entity::MODEL))
     {
-      msgs::Model *modelMsg = _scene.add_model();
-      boost::static_pointer_cast<Model>(_entity)->FillMsg(*modelMsg);
+      if (_models)
+      {
+        _models->push_back(boost::static_pointer_cast<Model>(_entity));
+      }
+      else
+      {
+        msgs::Model *modelMsg = _scene.add_model();
+        boost::static_pointer_cast<Model>(_entity)->FillMsg(*modelMsg);
+      }
     }
     else if (_entity->HasType(Entity::LIGHT) &&
         _entity->GetParent() == this->dataPtr->rootElement)
@@ -1739,19 +2395,71 @@ void World::BuildSceneMsg(msgs::Scene &_scene, BasePtr _entity)
 
     for (unsigned int i = 0; i < _entity->GetChildCount(); ++i)
     {
-      this->BuildSceneMsg(_scene, _entity->GetChild(i));
+      this->BuildSceneMsg(_scene, _entity->GetChild(i), _models);
     }
   }
 }
 
+//////////////////////////////////////////////////
+void World::PublishSceneStream()
+{
+  if (this->dataPtr->sceneStreamQueue.empty() || !this->dataPtr->modelPub)
+    return;
+
+  IGN_PROFILE("World::PublishSceneStream");
+
+  // Spread large scenes over several steps, so that a connecting client
+  // doesn't stall the physics loop
+  const auto budget = std::chrono::milliseconds(2);
+  auto start = std::chrono::steady_clock::now();
+  msgs::Model msg;
+  std::string data;
+  do
+  {
+    SceneStreamEntry entry = this->dataPtr->sceneStreamQueue.front();
+    this->dataPtr->sceneStreamQueue.pop_front();
+
+    ModelPtr model = entry.model.lock();
+    if (!model)
+      continue;
+
+    msg.Clear();
+    model->FillMsg(msg);
+
+    // Skip the models the client already has in this exact state
+    if (entry.knownVersion != 0)
+    {
+      msg.SerializeToString(&data);
+      if (std::hash<std::string>()(data) == entry.knownVersion)
+        continue;
+    }
+
+    this->dataPtr->modelPub->Publish(msg);
+  } while (!this->dataPtr->sceneStreamQueue.empty() &&
+      std::chrono::steady_clock::now() - start < budget);
+}
+
 
 //////////////////////////////////////////////////
-// void World::ModelUpdateTBB()
-// {
-//   tbb::parallel_for (tbb::blocked_range<size_t>(0,
-//   this->dataPtr->models.size(), 10),
-//       ModelUpdate_TBB(&this->dataPtr->models));
-// }
+void World::ModelUpdateTBB()
+{
+  IGN_PROFILE("World::ModelUpdateTBB");
+
+  // Take a snapshot of the root children so that the worker threads iterate
+  // over a stable container. The vector is reused to avoid reallocating
+  // every iteration.
+  Base_V &children = this->dataPtr->modelUpdateChildren;
+  children.clear();
+  for (unsigned int i = 0; i < this->dataPtr->rootElement->GetChildCount(); ++i)
+    children.push_back(this->dataPtr->rootElement->GetChild(i));
+
+  // parallel_for returns only once every model has been updated, which
+  // gives a deterministic join before PhysicsEngine::UpdateCollision.
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, children.size(),
+        this->dataPtr->modelUpdateGrainSize), ModelUpdate_TBB(&children));
+
+  children.clear();
+}
 
 //////////////////////////////////////////////////
 void World::ModelUpdateSingleLoop()
@@ -1765,6 +2473,9 @@ void World::ModelUpdateSingleLoop()
 //////////////////////////////////////////////////
 void World::LoadPlugins()
 {
+  common::StartupTraceScope trace("World::LoadPlugins", "plugin",
+      this->Name());
+
   // Load the plugins
   if (this->dataPtr->sdf->HasElement("plugin"))
   {
@@ -1805,11 +2516,29 @@ void World::LoadPlugin(const std::string &_filename,
             << "Plugin filename[" << _filename << "] name[" << _name << "]\n";
       return;
     }
-    plugin->Load(shared_from_this(), _sdf);
-    this->dataPtr->plugins.push_back(plugin);
+    {
+      // Attribute the event callbacks connected by the plugin to it
+      common::PluginTimingScope timingScope(_name);
+      plugin->Load(shared_from_this(), _sdf);
+      this->dataPtr->plugins.push_back(plugin);
+
+      if (this->dataPtr->initialized)
+        plugin->Init();
+    }
 
-    if (this->dataPtr->initialized)
-      plugin->Init();
+    // Cumulative and longest callback times, in seconds
+    auto timing = common::PluginTiming::Get(_name);
+    common::URI timeURI(this->URI());
+    timeURI.Query().Insert("p", "double/plugin_" + _name + "_time");
+    this->dataPtr->introspectionItems.push_back(timeURI);
+    util::IntrospectionManager::Instance()->Register<double>(timeURI.Str(),
+        [timing]() {return timing->TotalTime() * 1e-9;});
+
+    common::URI maxURI(this->URI());
+    maxURI.Query().Insert("p", "double/plugin_" + _name + "_max_time");
+    this->dataPtr->introspectionItems.push_back(maxURI);
+    util::IntrospectionManager::Instance()->Register<double>(maxURI.Str(),
+        [timing]() {return timing->MaxTime() * 1e-9;});
   }
 }
 
@@ -2003,6 +2732,45 @@ void World::ProcessRequestMsgs()
         road->Init();
       }
     }
+    else if (requestMsg.request() == "scene_info_stream")
+    {
+      // Everything but the models goes in the response. The models follow
+      // one by one on ~/model/info, see PublishSceneStream.
+      Model_V models;
+      this->dataPtr->sceneMsg.clear_model();
+      this->dataPtr->sceneMsg.clear_light();
+      this->BuildSceneMsg(this->dataPtr->sceneMsg, this->dataPtr->rootElement,
+          &models);
+
+      std::string *serializedData = response.mutable_serialized_data();
+      this->dataPtr->sceneMsg.SerializeToString(serializedData);
+      response.set_type(this->dataPtr->sceneMsg.GetTypeName());
+
+      // The request data lists the models the client has, one
+      // "<name> <version>" per line
+      std::unordered_map<std::string, std::size_t> known;
+      std::istringstream lines(requestMsg.data());
+      std::string name;
+      std::size_t version;
+      while (lines >> name >> version)
+        known[name] = version;
+
+      for (auto const &model : models)
+      {
+        SceneStreamEntry entry;
+        entry.model = model;
+        auto iter = known.find(model->GetScopedName());
+        if (iter != known.end())
+          entry.knownVersion = iter->second;
+        this->dataPtr->sceneStreamQueue.push_back(entry);
+      }
+
+      for (auto road : this->dataPtr->roads)
+      {
+        // this causes the roads to publish road msgs.
+        road->Init();
+      }
+    }
     else if (requestMsg.request() == "spherical_coordinates_info")
     {
       msgs::SphericalCoordinates sphereCoordMsg;
@@ -2148,62 +2916,149 @@ void World::ProcessLightFactoryMsgs()
 }
 
 //////////////////////////////////////////////////
-void World::ProcessFactoryMsgs()
+void World::FactoryWorker()
 {
-  IGN_PROFILE("World::ProcessFactoryMsgs");
-  std::list<sdf::ElementPtr> modelsToLoad, lightsToLoad;
+  common::SetThreadName("WorldFactory");
+
+  // The physics thread keeps WorldPrivate::factorySDF for itself
+  sdf::SDFPtr factorySDF(new sdf::SDF);
+  sdf::initFile("root.sdf", factorySDF);
 
-  std::list<msgs::Factory> factoryMsgsCopy;
+  std::unique_lock<std::mutex> lock(this->dataPtr->factoryMutex);
+  while (true)
   {
-    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
+    this->dataPtr->factoryCondition.wait(lock, [this]
+    {
+      return this->dataPtr->factoryStop ||
+          !this->dataPtr->factoryPending.empty();
+    });
 
-    std::copy(this->dataPtr->factoryMsgs.begin(),
-      this->dataPtr->factoryMsgs.end(),
-      std::back_inserter(factoryMsgsCopy));
-    this->dataPtr->factoryMsgs.clear();
-  }
+    if (this->dataPtr->factoryStop)
+      break;
 
-  for (auto const &factoryMsg : factoryMsgsCopy)
-  {
+    msgs::Factory factoryMsg =
+        std::move(this->dataPtr->factoryPending.front());
+    this->dataPtr->factoryPending.pop_front();
+    lock.unlock();
 
-    this->dataPtr->factorySDF->Clear();
+    PreparedFactoryMsg prepared;
+    bool valid = true;
+    factorySDF->Clear();
 
     if (factoryMsg.has_sdf() && !factoryMsg.sdf().empty())
     {
       // SDF Parsing happens here
-      if (!sdf::readString(factoryMsg.sdf(), this->dataPtr->factorySDF))
+      if (!sdf::readString(factoryMsg.sdf(), factorySDF))
       {
         gzerr << "Unable to read sdf string[" << factoryMsg.sdf() << "]\n";
-        continue;
+        valid = false;
       }
+      else
+        prepared.root = factorySDF->Root()->Clone();
     }
     else if (factoryMsg.has_sdf_filename() &&
             !factoryMsg.sdf_filename().empty())
     {
-      std::string filename;
-      // If http(s), look at Fuel
-      auto uri = ignition::common::URI(factoryMsg.sdf_filename());
-      if (uri.Valid() && (uri.Scheme() == "https" || uri.Scheme() == "http"))
+      // Reuse the parsed file as long as it didn't change on disk
+      auto &parsed =
+          this->dataPtr->parsedModelFiles[factoryMsg.sdf_filename()];
+      boost::system::error_code ec;
+      if (parsed.root && boost::filesystem::last_write_time(
+            parsed.filename, ec) == parsed.modified && !ec)
       {
-        filename = common::FuelModelDatabase::Instance()->ModelFile(
-            factoryMsg.sdf_filename());
+        prepared.root = parsed.root->Clone();
       }
-      // Otherwise, look at database
       else
       {
-        filename = common::ModelDatabase::Instance()->GetModelFile(
-            factoryMsg.sdf_filename());
+        std::string filename;
+        // If http(s), look at Fuel
+        auto uri = ignition::common::URI(factoryMsg.sdf_filename());
+        if (uri.Valid() &&
+            (uri.Scheme() == "https" || uri.Scheme() == "http"))
+        {
+          filename = common::FuelModelDatabase::Instance()->ModelFile(
+              factoryMsg.sdf_filename());
+        }
+        // Otherwise, look at database
+        else
+        {
+          filename = common::ModelDatabase::Instance()->GetModelFile(
+              factoryMsg.sdf_filename());
+        }
+
+        if (!sdf::readFile(filename, factorySDF))
+        {
+          gzerr << "Unable to read sdf file [" << filename << "]\n";
+          this->dataPtr->parsedModelFiles.erase(factoryMsg.sdf_filename());
+          valid = false;
+        }
+        else
+        {
+          common::convertToFullPaths(factorySDF->Root());
+
+          parsed.filename = filename;
+          parsed.modified = boost::filesystem::last_write_time(filename, ec);
+          parsed.root = factorySDF->Root()->Clone();
+          prepared.root = parsed.root->Clone();
+        }
       }
+    }
+
+    // Parse the meshes here too, so that loading the model only finds
+    // them in the MeshManager
+    if (prepared.root)
+    {
+      std::vector<std::string> meshFiles;
+      collect_mesh_files(prepared.root, meshFiles);
+      common::MeshManager::Instance()->Prefetch(meshFiles);
+    }
+
+    prepared.msg = std::move(factoryMsg);
+
+    lock.lock();
+    if (valid)
+      this->dataPtr->factoryPrepared.push_back(std::move(prepared));
+  }
+}
+
+//////////////////////////////////////////////////
+void World::ProcessFactoryMsgs()
+{
+  IGN_PROFILE("World::ProcessFactoryMsgs");
+  std::list<sdf::ElementPtr> modelsToLoad, lightsToLoad;
+
+  // Hand the new messages to the factory worker, and take the ones it
+  // has prepared. Only the insertion itself happens on this thread.
+  std::deque<PreparedFactoryMsg> prepared;
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
+    std::lock_guard<std::mutex> factoryLock(this->dataPtr->factoryMutex);
+
+    if (!this->dataPtr->factoryMsgs.empty())
+    {
+      std::move(this->dataPtr->factoryMsgs.begin(),
+          this->dataPtr->factoryMsgs.end(),
+          std::back_inserter(this->dataPtr->factoryPending));
+      this->dataPtr->factoryMsgs.clear();
 
-      if (!sdf::readFile(filename, this->dataPtr->factorySDF))
+      if (!this->dataPtr->factoryThread && !this->dataPtr->stop)
       {
-        gzerr << "Unable to read sdf file [" << filename << "]\n";
-        continue;
+        this->dataPtr->factoryStop = false;
+        this->dataPtr->factoryThread =
+            new std::thread(std::bind(&World::FactoryWorker, this));
       }
-
-      common::convertToFullPaths(this->dataPtr->factorySDF->Root());
+      this->dataPtr->factoryCondition.notify_one();
     }
-    else if (factoryMsg.has_clone_model_name())
+
+    prepared.swap(this->dataPtr->factoryPrepared);
+  }
+
+  for (auto &preparedMsg : prepared)
+  {
+    auto const &factoryMsg = preparedMsg.msg;
+    sdf::ElementPtr root = preparedMsg.root;
+
+    if (factoryMsg.has_clone_model_name() && !root)
     {
       ModelPtr model = this->ModelByName(factoryMsg.clone_model_name());
       if (!model)
@@ -2213,16 +3068,16 @@ void World::ProcessFactoryMsgs()
         continue;
       }
 
-      this->dataPtr->factorySDF->Root()->InsertElement(
-          model->GetSDF()->Clone());
+      this->dataPtr->factorySDF->Clear();
+      root = this->dataPtr->factorySDF->Root();
+      root->InsertElement(model->GetSDF()->Clone());
 
       std::string newName = model->GetName() + "_clone";
       newName = this->UniqueModelName(newName);
 
-      this->dataPtr->factorySDF->Root()->GetElement("model")->GetAttribute(
-          "name")->Set(newName);
+      root->GetElement("model")->GetAttribute("name")->Set(newName);
     }
-    else
+    else if (!root)
     {
       gzerr << "Unable to load sdf from factory message."
         << "No SDF or SDF filename specified.\n";
@@ -2236,10 +3091,10 @@ void World::ProcessFactoryMsgs()
       if (base)
       {
         sdf::ElementPtr elem;
-        if (this->dataPtr->factorySDF->Root()->GetName() == "sdf")
-          elem = this->dataPtr->factorySDF->Root()->GetFirstElement();
+        if (root->GetName() == "sdf")
+          elem = root->GetFirstElement();
         else
-          elem = this->dataPtr->factorySDF->Root();
+          elem = root;
 
         base->UpdateParameters(elem);
       }
@@ -2250,12 +3105,12 @@ void World::ProcessFactoryMsgs()
       bool isModel = false;
       bool isLight = false;
 
-      sdf::ElementPtr elem = this->dataPtr->factorySDF->Root()->Clone();
+      sdf::ElementPtr elem = root->Clone();
 
       if (!elem)
       {
         gzerr << "Invalid SDF:";
-        this->dataPtr->factorySDF->Root()->PrintValues("");
+        root->PrintValues("");
         continue;
       }
 
@@ -2280,7 +3135,7 @@ void World::ProcessFactoryMsgs()
       else
       {
         gzerr << "Unable to find a model, light, or actor in:\n";
-        this->dataPtr->factorySDF->Root()->PrintValues("");
+        root->PrintValues("");
         continue;
       }
 
@@ -2369,6 +3224,107 @@ void World::ProcessFactoryMsgs()
   }
 }
 
+//////////////////////////////////////////////////
+void World::ProcessInsertedModels()
+{
+  std::vector<sdf::ElementPtr> elems;
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
+    elems.swap(this->dataPtr->insertedModels);
+  }
+
+  if (elems.empty())
+    return;
+
+  IGN_PROFILE("World::ProcessInsertedModels");
+
+  // Parse the meshes of the whole batch in parallel first
+  {
+    std::vector<std::string> meshFiles;
+    for (auto const &elem : elems)
+    {
+      if (elem)
+        collect_mesh_files(elem, meshFiles);
+    }
+    common::MeshManager::Instance()->Prefetch(meshFiles);
+  }
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->factoryDeleteMutex);
+
+  // Check the names against a set instead of looking each one up in the
+  // list of models, as LoadModel and UniqueModelName do
+  std::unordered_set<std::string> names;
+  for (auto const &m : this->dataPtr->models)
+    names.insert(m->GetName());
+
+  std::vector<ModelPtr> loaded;
+  loaded.reserve(elems.size());
+  {
+    std::lock_guard<std::mutex> loadLock(this->dataPtr->loadModelMutex);
+    for (auto const &elem : elems)
+    {
+      if (!elem || elem->GetName() != "model")
+      {
+        gzerr << "InsertModels expects <model> elements\n";
+        continue;
+      }
+
+      std::string name = elem->Get<std::string>("name");
+      if (name.empty())
+      {
+        gzerr << "Can't load model with empty name" << std::endl;
+        continue;
+      }
+
+      if (!names.insert(name).second)
+      {
+        int i = 0;
+        std::string unique;
+        do
+        {
+          unique = name + "_" + std::to_string(i++);
+        } while (!names.insert(unique).second);
+        elem->GetAttribute("name")->Set(unique);
+      }
+
+      elem->SetParent(this->dataPtr->sdf);
+      elem->GetParent()->InsertElement(elem);
+
+      try
+      {
+        ModelPtr model = this->dataPtr->physicsEngine->CreateModel(
+            this->dataPtr->rootElement);
+        model->SetWorld(shared_from_this());
+        model->Load(elem);
+
+        event::Events::addEntity(model->GetScopedName());
+
+        msgs::Model msg;
+        model->FillMsg(msg);
+        this->dataPtr->modelPub->Publish(msg);
+
+        this->dataPtr->models.push_back(model);
+        loaded.push_back(model);
+      }
+      catch(...)
+      {
+        gzerr << "Loading model [" << elem->Get<std::string>("name")
+              << "] failed\n";
+      }
+    }
+  }
+
+  // Done once for the batch instead of once per model
+  this->EnableAllModels();
+
+  for (auto const &model : loaded)
+  {
+    this->PublishModelPose(model);
+    model->Init();
+    model->LoadPlugins(this->dataPtr->modelPluginLoadingTimeout);
+  }
+}
+
 //////////////////////////////////////////////////
 ModelPtr World::ModelBelowPoint(const ignition::math::Vector3d &_pt) const
 {
@@ -2391,6 +3347,26 @@ EntityPtr World::EntityBelowPoint(const ignition::math::Vector3d &_pt) const
   end = _pt;
   end.Z() -= 1000;
 
+  if (this->dataPtr->spatialIndexEnabled)
+  {
+    // Nothing can be hit if the ray doesn't cross any bounding box, and
+    // the ray doesn't need to go further down than the lowest box it
+    // crosses.
+    std::vector<ModelPtr> candidates =
+        this->dataPtr->spatialIndex.ModelsOnRay(_pt, end);
+    if (candidates.empty())
+      return EntityPtr();
+
+    double minZ = _pt.Z();
+    for (auto const &model : candidates)
+    {
+      ignition::math::AxisAlignedBox box;
+      if (this->dataPtr->spatialIndex.BoundingBox(model.get(), box))
+        minZ = std::min(minZ, box.Min().Z());
+    }
+    end.Z() = std::max(end.Z(), minZ - 1e-3);
+  }
+
   this->dataPtr->physicsEngine->InitForThread();
   this->dataPtr->testRay->SetPoints(_pt, end);
   this->dataPtr->testRay->GetIntersection(dist, entityName);
@@ -2398,22 +3374,57 @@ EntityPtr World::EntityBelowPoint(const ignition::math::Vector3d &_pt) const
 }
 
 //////////////////////////////////////////////////
-void World::SetState(const WorldState &_state)
+void World::SaveSnapshot(WorldSnapshot &_snapshot)
 {
-  this->SetSimTime(_state.GetSimTime());
-  this->dataPtr->logRealTime = _state.GetRealTime();
-  this->dataPtr->iterations = _state.GetIterations();
+  std::lock_guard<std::recursive_mutex> lk(this->dataPtr->worldUpdateMutex);
+  boost::recursive_mutex::scoped_lock plock(
+      *this->dataPtr->physicsEngine->GetPhysicsUpdateMutex());
 
-  // Insertions (adapted from ProcessFactoryMsgs)
-  auto insertions = _state.Insertions();
-  for (auto const &insertion : insertions)
+  uint64_t entityVersion;
   {
-    this->dataPtr->factorySDF->Clear();
-
-    std::stringstream sdfStr;
-    sdfStr << "<sdf version='" << SDF_VERSION << "'>"
-           << insertion
-           << "</sdf>";
+    std::lock_guard<std::mutex> lock(this->dataPtr->indexMutex);
+    entityVersion = this->dataPtr->entityVersion;
+  }
+  _snapshot.Capture(*this, entityVersion);
+}
+
+//////////////////////////////////////////////////
+bool World::RestoreSnapshot(const WorldSnapshot &_snapshot)
+{
+  std::lock_guard<std::recursive_mutex> lk(this->dataPtr->worldUpdateMutex);
+  boost::recursive_mutex::scoped_lock plock(
+      *this->dataPtr->physicsEngine->GetPhysicsUpdateMutex());
+
+  uint64_t entityVersion;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->indexMutex);
+    entityVersion = this->dataPtr->entityVersion;
+  }
+  if (!_snapshot.Apply(*this, entityVersion))
+    return false;
+
+  this->dataPtr->simTime = _snapshot.SimTime();
+  this->dataPtr->iterations = _snapshot.Iterations();
+  return true;
+}
+
+//////////////////////////////////////////////////
+void World::SetState(const WorldState &_state)
+{
+  this->SetSimTime(_state.GetSimTime());
+  this->dataPtr->logRealTime = _state.GetRealTime();
+  this->dataPtr->iterations = _state.GetIterations();
+
+  // Insertions (adapted from ProcessFactoryMsgs)
+  auto insertions = _state.Insertions();
+  for (auto const &insertion : insertions)
+  {
+    this->dataPtr->factorySDF->Clear();
+
+    std::stringstream sdfStr;
+    sdfStr << "<sdf version='" << SDF_VERSION << "'>"
+           << insertion
+           << "</sdf>";
 
     // SDF Parsing happens here
     if (!sdf::readString(sdfStr.str(), this->dataPtr->factorySDF))
@@ -2556,6 +3567,14 @@ void World::InsertModelString(const std::string &_sdfString)
   this->dataPtr->factoryMsgs.push_back(msg);
 }
 
+//////////////////////////////////////////////////
+void World::InsertModels(const std::vector<sdf::ElementPtr> &_models)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
+  this->dataPtr->insertedModels.insert(this->dataPtr->insertedModels.end(),
+      _models.begin(), _models.end());
+}
+
 //////////////////////////////////////////////////
 std::string World::StripWorldName(const std::string &_name) const
 {
@@ -2754,6 +3773,7 @@ bool World::OnLog(std::ostringstream &_stream)
     this->dataPtr->stateToggle = 0;
     this->dataPtr->prevStates[0] = WorldState();
     this->dataPtr->prevStates[1] = WorldState();
+    this->dataPtr->logDeltaReset = true;
   }
 
   this->LogModelResources();
@@ -2767,29 +3787,86 @@ void World::ProcessMessages()
   {
     std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
 
+    // Refresh the spatial index before the pose queues are cleared below.
+    if (this->dataPtr->spatialIndexEnabled)
+    {
+      IGN_PROFILE_BEGIN("SpatialIndex::Update");
+      for (auto const &model : this->dataPtr->publishModelPoses)
+        this->dataPtr->spatialIndex.MarkDirty(model.get());
+      for (auto const &link : this->dataPtr->dirtyPoseLinks)
+        this->dataPtr->spatialIndex.MarkDirty(link);
+
+      uint64_t entityVersion;
+      {
+        std::lock_guard<std::mutex> indexLock(this->dataPtr->indexMutex);
+        entityVersion = this->dataPtr->entityVersion;
+      }
+      this->dataPtr->spatialIndex.Update(shared_from_this(), entityVersion);
+      IGN_PROFILE_END();
+    }
+
+    if (this->dataPtr->proximityIndexEnabled)
+    {
+      IGN_PROFILE_BEGIN("ProximityIndex::Update");
+      for (auto const &model : this->dataPtr->publishModelPoses)
+        this->dataPtr->proximityIndex.MarkDirty(model.get());
+      for (auto const &link : this->dataPtr->dirtyPoseLinks)
+        this->dataPtr->proximityIndex.MarkDirty(link);
+
+      uint64_t entityVersion;
+      {
+        std::lock_guard<std::mutex> indexLock(this->dataPtr->indexMutex);
+        entityVersion = this->dataPtr->entityVersion;
+      }
+      this->dataPtr->proximityIndex.Update(shared_from_this(),
+          entityVersion);
+      IGN_PROFILE_END();
+    }
+
+    // Only snapshot the collisions while someone is asking about them.
+    if (this->dataPtr->collisionQuery.Active())
+    {
+      IGN_PROFILE_BEGIN("CollisionQuery::Update");
+      uint64_t entityVersion;
+      {
+        std::lock_guard<std::mutex> indexLock(this->dataPtr->indexMutex);
+        entityVersion = this->dataPtr->entityVersion;
+      }
+      this->dataPtr->collisionQuery.Update(shared_from_this(),
+          entityVersion);
+      IGN_PROFILE_END();
+    }
+
+    const bool compactPoses = this->dataPtr->compactPosePub &&
+        this->dataPtr->compactPosePub->HasConnections();
     if ((this->dataPtr->posePub && this->dataPtr->posePub->HasConnections()) ||
+        compactPoses ||
       // When ready to use the direct API for updating scene poses from server,
       // uncomment the following line:
          this->dataPtr->updateScenePoses ||
         (this->dataPtr->poseLocalPub &&
          this->dataPtr->poseLocalPub->HasConnections()))
     {
-      msgs::PosesStamped msg;
+      msgs::PosesStamped &msg = this->dataPtr->posesStampedMsg;
+      msg.Clear();
 
       // Time stamp this PosesStamped message
       msgs::Set(msg.mutable_time(), this->SimTime());
 
       if (!this->dataPtr->publishModelPoses.empty() ||
+          !this->dataPtr->dirtyPoseLinks.empty() ||
           !this->dataPtr->publishLightPoses.empty())
       {
+        auto &dirtyLinks = this->dataPtr->dirtyPoseLinkSet;
+        auto &modelStack = this->dataPtr->poseModelStack;
+
         for (auto const &model : this->dataPtr->publishModelPoses)
         {
-          std::list<ModelPtr> modelList;
-          modelList.push_back(model);
-          while (!modelList.empty())
+          modelStack.clear();
+          modelStack.push_back(model.get());
+          for (size_t i = 0; i < modelStack.size(); ++i)
           {
-            ModelPtr m = modelList.front();
-            modelList.pop_front();
+            const Model *m = modelStack[i];
             msgs::Pose *poseMsg = msg.add_pose();
 
             // Publish the model's relative pose
@@ -2798,22 +3875,36 @@ void World::ProcessMessages()
             msgs::Set(poseMsg, m->RelativePose());
 
             // Publish each of the model's child links relative poses
-            Link_V links = m->GetLinks();
-            for (auto const &link : links)
+            for (auto const &link : m->GetLinks())
             {
               poseMsg = msg.add_pose();
               poseMsg->set_name(link->GetScopedName());
               poseMsg->set_id(link->GetId());
               msgs::Set(poseMsg, link->RelativePose());
+
+              // Already published, don't add it a second time below.
+              if (!dirtyLinks.empty())
+                dirtyLinks.erase(link.get());
             }
 
             // add all nested models to the queue
-            Model_V models = m->NestedModels();
-            for (auto const &n : models)
-              modelList.push_back(n);
+            for (auto const &n : m->NestedModels())
+              modelStack.push_back(n.get());
           }
         }
 
+        // Links that moved relative to a model that did not move.
+        for (auto const &link : this->dataPtr->dirtyPoseLinks)
+        {
+          if (dirtyLinks.find(link) == dirtyLinks.end())
+            continue;
+
+          msgs::Pose *poseMsg = msg.add_pose();
+          poseMsg->set_name(link->GetScopedName());
+          poseMsg->set_id(link->GetId());
+          msgs::Set(poseMsg, link->RelativePose());
+        }
+
         for (auto const &light : this->dataPtr->publishLightPoses)
         {
           msgs::Pose *poseMsg = msg.add_pose();
@@ -2828,6 +3919,21 @@ void World::ProcessMessages()
           this->dataPtr->posePub->Publish(msg);
       }
 
+      // Every update goes into the encoder, even those the rate drops
+      if (compactPoses)
+      {
+        msgs::PoseStreamEncoder &encoder = this->dataPtr->poseStreamEncoder;
+        encoder.Update(msg);
+        if (encoder.FramePending())
+        {
+          this->dataPtr->compactPosePub->PublishIfSubscribed<
+              msgs::CompactPoses>([&msg, &encoder](msgs::CompactPoses &_msg)
+              {
+                encoder.Encode(msg.time(), _msg);
+              });
+        }
+      }
+
       if (this->dataPtr->poseLocalPub &&
           this->dataPtr->poseLocalPub->HasConnections())
       {
@@ -2846,6 +3952,8 @@ void World::ProcessMessages()
     }
 
     this->dataPtr->publishModelPoses.clear();
+    this->dataPtr->dirtyPoseLinks.clear();
+    this->dataPtr->dirtyPoseLinkSet.clear();
     this->dataPtr->publishLightPoses.clear();
   }
 
@@ -2866,8 +3974,7 @@ void World::ProcessMessages()
             modelList.pop_front();
 
             // add all nested models to the queue
-            Model_V models = m->NestedModels();
-            for (auto const &n : models)
+            for (auto const &n : m->NestedModels())
               modelList.push_back(n);
 
             // Publish the model's scale and visual geometry data at the same
@@ -2876,8 +3983,7 @@ void World::ProcessMessages()
             msgs::Model msg;
             msg.set_name(m->GetScopedName());
             msg.set_id(m->GetId());
-            Link_V links = m->GetLinks();
-            for (auto l : links)
+            for (auto const &l : m->GetLinks())
             {
               msgs::Link *linkMsg = msg.add_link();
               linkMsg->set_id(l->GetId());
@@ -2923,7 +4029,9 @@ void World::ProcessMessages()
     this->ProcessPlaybackControlMsgs();
     this->ProcessEntityMsgs();
     this->ProcessRequestMsgs();
+    this->PublishSceneStream();
     this->ProcessFactoryMsgs();
+    this->ProcessInsertedModels();
     this->ProcessModelMsgs();
     this->ProcessLightFactoryMsgs();
     this->ProcessLightModifyMsgs();
@@ -2932,37 +4040,185 @@ void World::ProcessMessages()
 }
 
 //////////////////////////////////////////////////
-void World::PublishWorldStats()
+void World::PublishStepTimings()
 {
-  this->dataPtr->worldStatsMsg.Clear();
+  auto now = std::chrono::steady_clock::now();
+  auto window = now - this->dataPtr->stepTimingsStart;
+  if (window < std::chrono::seconds(1))
+    return;
+
+  if (this->dataPtr->performancePub)
+  {
+    this->dataPtr->performancePub->PublishIfSubscribed<msgs::StepTiming>(
+        [this, &window](msgs::StepTiming &_msg)
+        {
+          msgs::Set(_msg.mutable_sim_time(), this->SimTime());
+          msgs::Set(_msg.mutable_window(), common::Time(
+              std::chrono::duration<double>(window).count()));
+
+          for (int i = 0; i < STEP_STAGE_COUNT; ++i)
+          {
+            auto const &histogram = this->dataPtr->stepTimings[i];
+            auto stage = _msg.add_stage();
+            stage->set_name(kStepStageNames[i]);
+            stage->set_count(histogram.Count());
+            stage->set_min(histogram.Min() * 1e-3);
+            stage->set_mean(histogram.Mean() * 1e-3);
+            stage->set_p50(histogram.Percentile(50) * 1e-3);
+            stage->set_p90(histogram.Percentile(90) * 1e-3);
+            stage->set_p99(histogram.Percentile(99) * 1e-3);
+            stage->set_p999(histogram.Percentile(99.9) * 1e-3);
+            stage->set_max(histogram.Max() * 1e-3);
+            if (common::AllocationTrackingEnabled() && histogram.Count() > 0)
+            {
+              stage->set_allocations(
+                  static_cast<double>(this->dataPtr->stepAllocations[i]) /
+                  histogram.Count());
+            }
+          }
 
-  msgs::Set(this->dataPtr->worldStatsMsg.mutable_sim_time(),
-      this->SimTime());
-  msgs::Set(this->dataPtr->worldStatsMsg.mutable_real_time(),
-      this->RealTime());
-  msgs::Set(this->dataPtr->worldStatsMsg.mutable_pause_time(),
-      this->PauseTime());
+          if (common::PluginTiming::Enabled())
+          {
+            for (auto const &timing : common::PluginTiming::All())
+            {
+              auto plugin = _msg.add_plugin();
+              plugin->set_name(timing->Name());
+              plugin->set_calls(timing->Calls());
+              plugin->set_total(timing->TotalTime() * 1e-6);
+              plugin->set_max(timing->MaxTime() * 1e-3);
+            }
+          }
+        });
+  }
 
-  this->dataPtr->worldStatsMsg.set_iterations(this->dataPtr->iterations);
-  this->dataPtr->worldStatsMsg.set_paused(this->IsPaused());
+  for (auto &histogram : this->dataPtr->stepTimings)
+    histogram.Reset();
+  this->dataPtr->stepAllocations.fill(0);
+  this->dataPtr->stepTimingsStart = now;
+}
 
-  if (util::LogPlay::Instance()->IsOpen())
+//////////////////////////////////////////////////
+void World::PublishWorldStats()
+{
+  if (this->dataPtr->statPub)
   {
-    msgs::LogPlaybackStatistics logStats;
-    msgs::Set(logStats.mutable_start_time(),
-        util::LogPlay::Instance()->LogStartTime());
-    msgs::Set(logStats.mutable_end_time(),
-        util::LogPlay::Instance()->LogEndTime());
+    this->dataPtr->statPub->PublishIfSubscribed(this->dataPtr->worldStatsMsg,
+        [this](msgs::WorldStatistics &_msg)
+        {
+          msgs::Set(_msg.mutable_sim_time(), this->SimTime());
+          msgs::Set(_msg.mutable_real_time(), this->RealTime());
+          msgs::Set(_msg.mutable_pause_time(), this->PauseTime());
 
-    this->dataPtr->worldStatsMsg.mutable_log_playback_stats()->CopyFrom(
-        logStats);
-  }
+          _msg.set_iterations(this->dataPtr->iterations);
+          _msg.set_paused(this->IsPaused());
 
-  if (this->dataPtr->statPub && this->dataPtr->statPub->HasConnections())
-    this->dataPtr->statPub->Publish(this->dataPtr->worldStatsMsg);
+          if (this->dataPtr->sleepManager->Enabled())
+          {
+            _msg.set_sleeping_model_count(
+                this->dataPtr->sleepManager->SleepingModelCount());
+          }
+
+          if (util::LogPlay::Instance()->IsOpen())
+          {
+            msgs::LogPlaybackStatistics *logStats =
+                _msg.mutable_log_playback_stats();
+            msgs::Set(logStats->mutable_start_time(),
+                util::LogPlay::Instance()->LogStartTime());
+            msgs::Set(logStats->mutable_end_time(),
+                util::LogPlay::Instance()->LogEndTime());
+          }
+        });
+  }
   this->dataPtr->prevStatTime = common::Time::GetWallTime();
 }
 
+//////////////////////////////////////////////////
+void World::PublishClock()
+{
+  this->dataPtr->shmClock.Write(this->dataPtr->simTime,
+      this->dataPtr->iterations, this->IsPaused());
+
+  if (this->dataPtr->clockPub)
+  {
+    this->dataPtr->clockPub->PublishIfSubscribed<msgs::Time>(
+        [this](msgs::Time &_msg)
+        {
+          msgs::Set(&_msg, this->dataPtr->simTime);
+        });
+  }
+}
+
+//////////////////////////////////////////////////
+void World::PublishJointStates()
+{
+  if (!this->dataPtr->jointStatesPub)
+    return;
+
+  this->dataPtr->jointStatesPub->PublishIfSubscribed<msgs::JointStates>(
+      [this](msgs::JointStates &_msg)
+      {
+        // Select the models again only after models were added or removed
+        uint64_t entityVersion;
+        {
+          std::lock_guard<std::mutex> lock(this->dataPtr->indexMutex);
+          entityVersion = this->dataPtr->entityVersion;
+        }
+        if (entityVersion != this->dataPtr->jointStatesVersion)
+        {
+          this->dataPtr->jointStatesVersion = entityVersion;
+          this->dataPtr->jointStatesModels.clear();
+
+          std::function<void(const Model_V &)> select =
+              [&](const Model_V &_models)
+              {
+                for (const auto &model : _models)
+                {
+                  if (model->JointStateCount() > 0 &&
+                      boost::regex_match(model->GetScopedName(),
+                          this->dataPtr->jointStatesFilter))
+                  {
+                    this->dataPtr->jointStatesModels.push_back(model);
+                  }
+                  select(model->NestedModels());
+                }
+              };
+          select(this->dataPtr->models);
+        }
+
+        msgs::Set(_msg.mutable_time(), this->dataPtr->simTime);
+        for (const auto &model : this->dataPtr->jointStatesModels)
+        {
+          model->JointStates(this->dataPtr->jointPositions,
+              this->dataPtr->jointVelocities);
+          model->JointEfforts(this->dataPtr->jointEfforts);
+
+          _msg.add_model(model->GetScopedName());
+          _msg.add_count(this->dataPtr->jointPositions.size());
+          for (unsigned int i = 0; i < this->dataPtr->jointPositions.size();
+               ++i)
+          {
+            _msg.add_position(this->dataPtr->jointPositions[i]);
+            _msg.add_velocity(this->dataPtr->jointVelocities[i]);
+            _msg.add_effort(this->dataPtr->jointEfforts[i]);
+          }
+        }
+      });
+}
+
+//////////////////////////////////////////////////
+void World::PublishBatteryStates()
+{
+  if (!this->dataPtr->batteryStatesPub)
+    return;
+
+  this->dataPtr->batteryStatesPub->PublishIfSubscribed<msgs::BatteryStates>(
+      [this](msgs::BatteryStates &_msg)
+      {
+        msgs::Set(_msg.mutable_time(), this->dataPtr->simTime);
+        this->dataPtr->batterySystem->FillMsg(_msg);
+      });
+}
+
 //////////////////////////////////////////////////
 bool World::IsLoaded() const
 {
@@ -2996,74 +4252,139 @@ void World::PublishLightPose(const physics::LightPtr _light)
   this->dataPtr->publishLightPoses.insert(_light);
 }
 
+//////////////////////////////////////////////////
+void World::LogCapture()
+{
+  // Recorded topics share the time base of the states
+  util::LogRecord::Instance()->SetSimTime(this->dataPtr->simTime);
+
+  uint64_t entityVersion;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->indexMutex);
+    entityVersion = this->dataPtr->entityVersion;
+  }
+
+  // Throttle state capture based on log recording frequency. Changes to the
+  // entity tree are always captured, so that insertions and deletions are
+  // recorded.
+  if (entityVersion == this->dataPtr->logCaptureVersion &&
+      this->dataPtr->simTime - this->dataPtr->logLastStateTime <
+      util::LogRecord::Instance()->Period())
+  {
+    return;
+  }
+
+  WorldPtr self = shared_from_this();
+  const std::string filter = util::LogRecord::Instance()->Filter();
+  std::unique_lock<std::mutex> lock(this->dataPtr->logMutex);
+
+  // Only wait if the log worker hasn't consumed any of the buffered states.
+  while (true)
+  {
+    {
+      std::lock_guard<std::mutex> dLock(this->dataPtr->entityDeleteMutex);
+      if (this->dataPtr->logStateBuffer.Capture(self, entityVersion,
+            filter))
+        break;
+    }
+
+    if (this->dataPtr->stop)
+      return;
+
+    this->dataPtr->logCondition.notify_one();
+    this->dataPtr->logContinueCondition.wait(lock);
+  }
+
+  this->dataPtr->logCaptureVersion = entityVersion;
+  this->dataPtr->logLastStateTime = this->dataPtr->simTime;
+  this->dataPtr->logCondition.notify_one();
+}
+
 //////////////////////////////////////////////////
 void World::LogWorker()
 {
+  common::SetThreadName("WorldLog");
   std::unique_lock<std::mutex> lock(this->dataPtr->logMutex);
 
   WorldPtr self = shared_from_this();
-  this->dataPtr->logPrevIteration = this->dataPtr->iterations;
 
   GZ_ASSERT(self, "Self pointer to World is invalid");
 
-  // Init the prevUnfilteredState
-  this->dataPtr->prevUnfilteredState.Load(self);
+  std::vector<std::string> insertedNames;
+  std::vector<std::string> deletions;
 
   while (!this->dataPtr->stop)
   {
-    // get unfiltered world state
-    WorldState unfilteredState;
-    {
-      std::lock_guard<std::mutex> dLock(this->dataPtr->entityDeleteMutex);
-      unfilteredState.Load(self);
-    }
+    // Wait until there is work to be done.
+    this->dataPtr->logCondition.wait(lock, [this]
+        {
+          return this->dataPtr->stop ||
+                 !this->dataPtr->logStateBuffer.Empty();
+        });
 
-    // compute world state diff and find out about insertions and deletions
-    std::vector<std::string> insertions;
-    std::vector<std::string> deletions;
-    bool insertDelete = false;
+    // The states are built from the snapshots alone, so the physics thread
+    // is free to keep stepping while they are diffed and stored.
+    lock.unlock();
 
+    int currState = (this->dataPtr->stateToggle + 1) % 2;
+
+    if (this->dataPtr->logDeltaReset.exchange(false))
     {
-      WorldState unfilteredDiffState = unfilteredState -
-          this->dataPtr->prevUnfilteredState;
-      if (!unfilteredDiffState.IsZero())
-      {
-        insertions = unfilteredDiffState.Insertions();
-        deletions = unfilteredDiffState.Deletions();
-        insertDelete = !insertions.empty() || !deletions.empty();
-      }
+      this->dataPtr->logDelta.Reset();
+      this->dataPtr->logDelta.SetParameters(
+          util::LogRecord::Instance()->KeyframePeriod(),
+          util::LogRecord::Instance()->PositionTolerance(),
+          util::LogRecord::Instance()->OrientationTolerance());
     }
-    this->dataPtr->prevUnfilteredState = unfilteredState;
 
-    // Throttle state capture based on log recording frequency.
-    auto simTime = this->SimTime();
-    if ((simTime - this->dataPtr->logLastStateTime >=
-        util::LogRecord::Instance()->Period()) || insertDelete)
+    while (this->dataPtr->logStateBuffer.Pop(
+          this->dataPtr->prevStates[currState], insertedNames, deletions))
     {
-      int currState = (this->dataPtr->stateToggle + 1) % 2;
-
-      std::string filterStr = util::LogRecord::Instance()->Filter();
-      // compute diff for filtered states
+      std::vector<std::string> insertions;
+      for (const auto &name : insertedNames)
       {
-        std::lock_guard<std::mutex> dLock(this->dataPtr->entityDeleteMutex);
-        this->dataPtr->prevStates[currState].LoadWithFilter(self, filterStr);
+        ModelPtr model = self->ModelByName(name);
+        if (model)
+        {
+          insertions.push_back(model->UnscaledSDF()->ToString(""));
+          continue;
+        }
+
+        LightPtr light = self->LightByName(name);
+        if (light)
+          insertions.push_back(light->GetSDF()->ToString(""));
       }
+      bool insertDelete = !insertions.empty() || !deletions.empty();
+
       WorldState diffState = this->dataPtr->prevStates[currState] -
           this->dataPtr->prevStates[this->dataPtr->stateToggle];
-      this->dataPtr->logPrevIteration = this->dataPtr->iterations;
 
       if (!diffState.IsZero() || insertDelete)
       {
         this->dataPtr->stateToggle = currState;
+
+        // Store the entire current state (instead of the diffState). A slow
+        // moving link may never be captured if only diff state is recorded.
+        // Between keyframes it is reduced to the entities that moved past
+        // the tolerances since they were last stored.
+        WorldState &state = this->dataPtr->prevStates[currState];
+        state.SetInsertions(insertions);
+        state.SetDeletions(deletions);
+
+        WorldState reduced;
+        bool store = true;
+        if (this->dataPtr->logDelta.Enabled())
+        {
+          reduced = state;
+          store = this->dataPtr->logDelta.Reduce(reduced);
+        }
+
+        if (store)
         {
-          // Store the entire current state (instead of the diffState). A slow
-          // moving link may never be captured if only diff state is recorded.
           std::lock_guard<std::mutex> bLock(this->dataPtr->logBufferMutex);
 
-          this->dataPtr->prevStates[currState].SetInsertions(insertions);
-          this->dataPtr->prevStates[currState].SetDeletions(deletions);
           this->dataPtr->states[this->dataPtr->currentStateBuffer].push_back(
-              this->dataPtr->prevStates[currState]);
+              this->dataPtr->logDelta.Enabled() ? reduced : state);
 
           // Tell the logger to update, once the number of states exceeds 1000
           if (this->dataPtr->states[this->dataPtr->currentStateBuffer].size() >
@@ -3072,15 +4393,14 @@ void World::LogWorker()
             util::LogRecord::Instance()->Notify();
           }
         }
+        currState = (this->dataPtr->stateToggle + 1) % 2;
       }
-
-      this->dataPtr->logLastStateTime = simTime;
     }
 
+    // Notify while holding the lock, so that the physics thread can't miss
+    // the wake up between a failed capture and its wait.
+    lock.lock();
     this->dataPtr->logContinueCondition.notify_all();
-
-    // Wait until there is work to be done.
-    this->dataPtr->logCondition.wait(lock);
   }
 
   // Make sure nothing is blocked by this thread.
@@ -3150,6 +4470,19 @@ void World::RemoveModel(const std::string &_name)
     {
       if ((*model)->GetName() == _name || (*model)->GetScopedName() == _name)
       {
+        // Keep deleted entities out of the key frames of the pose stream
+        std::vector<ModelPtr> stack = {*model};
+        while (!stack.empty())
+        {
+          ModelPtr m = stack.back();
+          stack.pop_back();
+          this->dataPtr->poseStreamEncoder.Remove(m->GetId());
+          for (auto const &link : m->GetLinks())
+            this->dataPtr->poseStreamEncoder.Remove(link->GetId());
+          for (auto const &nested : m->NestedModels())
+            stack.push_back(nested);
+        }
+
         this->dataPtr->models.erase(model);
         this->dataPtr->rootElement->RemoveChild(_name);
         break;
@@ -3218,6 +4551,12 @@ void World::RemoveModel(const std::string &_name)
   }
 }
 
+/////////////////////////////////////////////////
+void World::OnCompactPosesAck(ConstCompactPosesAckPtr &_msg)
+{
+  this->dataPtr->poseStreamEncoder.Ack(*_msg);
+}
+
 /////////////////////////////////////////////////
 void World::OnLightModifyMsg(ConstLightPtr &_msg)
 {
@@ -3244,6 +4583,46 @@ std::mutex &World::WorldPoseMutex() const
   return this->dataPtr->setWorldPoseMutex;
 }
 
+/////////////////////////////////////////////////
+void World::SetModelPoses(
+    const std::vector<std::pair<ModelPtr, ignition::math::Pose3d>> &_poses)
+{
+  if (_poses.empty())
+    return;
+
+  // Same lock order as the physics update, which sets link poses while it
+  // holds the physics mutex.
+  {
+    boost::recursive_mutex::scoped_lock physicsLock(
+        *this->dataPtr->physicsEngine->GetPhysicsUpdateMutex());
+    std::lock_guard<std::mutex> lock(this->dataPtr->setWorldPoseMutex);
+    for (auto const &modelPose : _poses)
+    {
+      // Publish below, once per model instead of once per link
+      if (modelPose.first)
+        modelPose.first->SetWorldPoseModel(modelPose.second, true, false);
+    }
+  }
+
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
+    for (auto const &modelPose : _poses)
+    {
+      if (modelPose.first)
+        this->dataPtr->publishModelPoses.insert(modelPose.first);
+    }
+  }
+
+  if (this->dataPtr->sleepManager->Enabled())
+  {
+    for (auto const &modelPose : _poses)
+    {
+      if (modelPose.first)
+        this->dataPtr->sleepManager->Wake(modelPose.first.get());
+    }
+  }
+}
+
 /////////////////////////////////////////////////
 bool World::PhysicsEnabled() const
 {
@@ -3256,6 +4635,75 @@ void World::SetPhysicsEnabled(const bool _enable)
   this->dataPtr->enablePhysicsEngine = _enable;
 }
 
+/////////////////////////////////////////////////
+bool World::LinkKinematicsCacheEnabled() const
+{
+  return this->dataPtr->linkKinematicsEnabled;
+}
+
+/////////////////////////////////////////////////
+void World::SetLinkKinematicsCacheEnabled(const bool _enable)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
+  this->dataPtr->linkKinematicsEnabled = _enable;
+  if (!_enable)
+    this->dataPtr->linkKinematics.Clear();
+}
+
+/////////////////////////////////////////////////
+const LinkKinematicsCache &World::LinkKinematics() const
+{
+  return this->dataPtr->linkKinematics;
+}
+
+/////////////////////////////////////////////////
+bool World::SpatialIndexEnabled() const
+{
+  return this->dataPtr->spatialIndexEnabled;
+}
+
+/////////////////////////////////////////////////
+void World::SetSpatialIndexEnabled(const bool _enable)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
+  this->dataPtr->spatialIndexEnabled = _enable;
+  if (!_enable)
+    this->dataPtr->spatialIndex.Clear();
+}
+
+/////////////////////////////////////////////////
+const SpatialIndex &World::ModelSpatialIndex() const
+{
+  return this->dataPtr->spatialIndex;
+}
+
+/////////////////////////////////////////////////
+bool World::ProximityIndexEnabled() const
+{
+  return this->dataPtr->proximityIndexEnabled;
+}
+
+/////////////////////////////////////////////////
+void World::SetProximityIndexEnabled(const bool _enable)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
+  this->dataPtr->proximityIndexEnabled = _enable;
+  if (!_enable)
+    this->dataPtr->proximityIndex.Clear();
+}
+
+/////////////////////////////////////////////////
+const ProximityIndex &World::ModelProximityIndex() const
+{
+  return this->dataPtr->proximityIndex;
+}
+
+/////////////////////////////////////////////////
+CollisionQuery &World::CollisionQueries()
+{
+  return this->dataPtr->collisionQuery;
+}
+
 /////////////////////////////////////////////////
 bool World::WindEnabled() const
 {
@@ -3272,8 +4720,7 @@ void World::SetWindEnabled(const bool _enable)
 
   for (auto const &model : this->dataPtr->models)
   {
-    Link_V links = model->GetLinks();
-    for (auto const &link : links)
+    for (auto const &link : model->GetLinks())
     {
       if (link->WindMode())
         link->SetWindEnabled(this->dataPtr->enableWind);
@@ -3300,6 +4747,28 @@ void World::_AddDirty(Entity *_entity)
   this->dataPtr->dirtyPoses.push_back(_entity);
 }
 
+/////////////////////////////////////////////////
+void World::_AddDirtyPoseLink(Entity *_link)
+{
+  GZ_ASSERT(_link != nullptr, "_link is nullptr");
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
+
+  if (this->dataPtr->dirtyPoseLinkSet.insert(_link).second)
+    this->dataPtr->dirtyPoseLinks.push_back(_link);
+}
+
+/////////////////////////////////////////////////
+void World::_RemoveDirtyPoseLink(Entity *_link)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
+
+  if (this->dataPtr->dirtyPoseLinkSet.erase(_link) > 0)
+  {
+    auto &links = this->dataPtr->dirtyPoseLinks;
+    links.erase(std::remove(links.begin(), links.end(), _link), links.end());
+  }
+}
+
 /////////////////////////////////////////////////
 void World::ResetPhysicsStates()
 {
@@ -3324,6 +4793,57 @@ void World::RegisterIntrospectionItems()
   // Add here all the items that might be introspected.
   gazebo::util::IntrospectionManager::Instance()->Register<common::Time>(
       timeURI.Str(), std::bind(&World::SimTime, this));
+
+  // Load of the transport IO threads, shared by every world of the process
+  const size_t ioThreads = transport::io_thread_stats().size();
+  for (size_t i = 0; i < ioThreads; ++i)
+  {
+    auto fBusy = [i]()
+    {
+      auto stats = transport::io_thread_stats();
+      return i < stats.size() ? stats[i].busyTime : 0.0;
+    };
+    auto fHandlers = [i]()
+    {
+      auto stats = transport::io_thread_stats();
+      return i < stats.size() ? static_cast<int>(stats[i].handlerCount) : 0;
+    };
+
+    const std::string prefix = "transport_io_thread_" + std::to_string(i);
+
+    common::URI busyURI(uri);
+    busyURI.Query().Insert("p", "double/" + prefix + "_busy_time");
+    this->dataPtr->introspectionItems.push_back(busyURI);
+    gazebo::util::IntrospectionManager::Instance()->Register<double>(
+        busyURI.Str(), fBusy);
+
+    common::URI handlersURI(uri);
+    handlersURI.Query().Insert("p", "int/" + prefix + "_handlers");
+    this->dataPtr->introspectionItems.push_back(handlersURI);
+    gazebo::util::IntrospectionManager::Instance()->Register<int>(
+        handlersURI.Str(), fHandlers);
+  }
+
+  // Memory held by each subsystem of the process. The rendering accounts
+  // only get a value once the render engine is initialized.
+  for (auto const &name : {"common/meshes", "physics/heightmaps",
+      "transport/publisher_queues", "util/log_record_buffers",
+      "rendering/textures", "rendering/meshes", "rendering/materials",
+      "rendering/gpu_programs"})
+  {
+    auto account = common::MemoryAccount::Get(name);
+    std::string item = name;
+    std::replace(item.begin(), item.end(), '/', '_');
+
+    common::URI memoryURI(uri);
+    memoryURI.Query().Insert("p", "double/memory_" + item + "_bytes");
+    this->dataPtr->introspectionItems.push_back(memoryURI);
+    gazebo::util::IntrospectionManager::Instance()->Register<double>(
+        memoryURI.Str(), [account]()
+        {
+          return static_cast<double>(account->Bytes());
+        });
+  }
 }
 
 /////////////////////////////////////////////////
@@ -3424,6 +4944,78 @@ bool World::SceneInfoService(msgs::Scene &_res)
   return true;
 }
 
+//////////////////////////////////////////////////
+bool World::CollisionQueryService(const msgs::CollisionQueryRequest &_req,
+    msgs::CollisionQueryResponse &_res)
+{
+  // Don't wait forever on a paused or stalled world
+  auto future = this->dataPtr->collisionQuery.Query(_req);
+  if (future.wait_for(std::chrono::seconds(5)) != std::future_status::ready)
+  {
+    gzwarn << "Collision query timed out" << std::endl;
+    return false;
+  }
+
+  auto result = future.get();
+  msgs::Set(_res.mutable_time(), result.time);
+  for (auto const &hit : result.hits)
+  {
+    auto *hitMsg = _res.add_hit();
+    hitMsg->set_collision(hit.collision);
+    // Overlaps only report which collisions are touched
+    if (_req.type() == msgs::CollisionQueryRequest::OVERLAP)
+      continue;
+    msgs::Set(hitMsg->mutable_point(), hit.point);
+    msgs::Set(hitMsg->mutable_normal(), hit.normal);
+    hitMsg->set_distance(hit.distance);
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool World::ProximityService(const msgs::ProximityRequest &_req,
+    msgs::ProximityResponse &_res)
+{
+  // The first request turns the index on, and waits for it to be built
+  if (!this->dataPtr->proximityIndexEnabled)
+    this->SetProximityIndexEnabled(true);
+
+  const ProximityIndex &index = this->dataPtr->proximityIndex;
+  for (int i = 0; i < 1000 && !index.Built(); ++i)
+    common::Time::MSleep(1);
+  if (!index.Built())
+  {
+    gzwarn << "Proximity index not ready" << std::endl;
+    return false;
+  }
+
+  const auto point = msgs::ConvertIgn(_req.point());
+  std::vector<ModelPtr> models;
+  if (_req.radius() > 0)
+  {
+    models = index.ModelsInRadius(point, _req.radius());
+    if (_req.k() > 0 && models.size() > _req.k())
+      models.resize(_req.k());
+  }
+  else if (_req.k() > 0)
+  {
+    models = index.NearestModels(point, _req.k());
+  }
+
+  // Distances use the positions stored in the index, which are
+  // consistent with the search
+  for (auto const &model : models)
+  {
+    ignition::math::Vector3d center;
+    double radius;
+    if (!index.BoundingSphere(model.get(), center, radius))
+      continue;
+    _res.add_model(model->GetName());
+    _res.add_distance(point.Distance(center));
+  }
+  return true;
+}
+
 //////////////////////////////////////////////////
 bool World::ShadowCasterMaterialNameService(ignition::msgs::StringMsg &_res)
 {
@@ -23,6 +23,7 @@
 #include <deque>
 #include <string>
 #include <memory>
+#include <utility>
 
 #include <boost/enable_shared_from_this.hpp>
 
@@ -35,6 +36,7 @@
 #include "gazebo/common/CommonTypes.hh"
 #include "gazebo/common/UpdateInfo.hh"
 #include "gazebo/common/Event.hh"
+#include "gazebo/common/SimTimeScheduler.hh"
 #include "gazebo/common/URI.hh"
 
 #include "gazebo/physics/Base.hh"
@@ -60,6 +62,7 @@ namespace gazebo
   {
     /// Forward declare private data class.
     class WorldPrivate;
+    class WorldSnapshot;
 
     /// \addtogroup gazebo_physics
     /// \{
@@ -75,6 +78,28 @@ namespace gazebo
     class GZ_PHYSICS_VISIBLE World :
       public boost::enable_shared_from_this<World>
     {
+      /// \enum StepBatchFlag
+      /// \brief Per-iteration work that World::StepBatch can skip. Values
+      /// can be combined with bitwise or.
+      public: enum StepBatchFlag
+              {
+                /// \brief Run every iteration normally.
+                STEP_BATCH_NONE = 0x0,
+
+                /// \brief Don't fire the worldUpdateBegin,
+                /// beforePhysicsUpdate and worldUpdateEnd events.
+                STEP_BATCH_NO_EVENTS = 0x1,
+
+                /// \brief Don't publish contacts.
+                STEP_BATCH_NO_PUBLISH = 0x2,
+
+                /// \brief Don't update the introspection manager.
+                STEP_BATCH_NO_INTROSPECTION = 0x4,
+
+                /// \brief Skip all of the above.
+                STEP_BATCH_NO_CALLBACKS = 0x7
+              };
+
       /// \brief Constructor.
       /// Constructor for the World. Must specify a unique name.
       /// \param[in] _name Name of the world.
@@ -152,6 +177,14 @@ namespace gazebo
       /// \return Pointer to the preset manager.
       public: PresetManagerPtr PresetMgr() const;
 
+      /// \brief Return the manager that puts resting models to sleep.
+      /// \return Pointer to the sleep manager.
+      public: SleepManagerPtr SleepMgr() const;
+
+      /// \brief Return the system that updates the batteries of all links.
+      /// \return Pointer to the battery system.
+      public: BatterySystemPtr Batteries() const;
+
       /// \brief Get a reference to the wind used by the world.
       /// \return Reference to the wind.
       public: physics::Wind &Wind() const;
@@ -192,8 +225,10 @@ namespace gazebo
       public: ModelPtr ModelByIndex(const unsigned int _index) const;
 
       /// \brief Get a list of all the models.
-      /// \return A list of all the Models in the world.
-      public: Model_V Models() const;
+      /// \return A list of all the Models in the world. The reference is
+      /// only invalidated when models are inserted or removed, which the
+      /// world does between steps. Copy the list to keep it longer.
+      public: const Model_V &Models() const;
 
       /// \brief Get the number of lights.
       /// \return The number of lights in the World.
@@ -228,6 +263,13 @@ namespace gazebo
       /// \param[in] _t The new simulation time
       public: void SetSimTime(const common::Time &_t);
 
+      /// \brief Get the scheduler of simulation time timers. Its timers
+      /// run on the world thread at the start of each update, before the
+      /// world update begin event. Timers keep their absolute time when
+      /// the time is reset.
+      /// \return The scheduler.
+      public: common::SimTimeScheduler &Scheduler();
+
       /// \brief Get the amount of time simulation has been paused.
       /// \return The pause time.
       public: common::Time PauseTime() const;
@@ -249,8 +291,9 @@ namespace gazebo
       public: void SetPaused(const bool _p);
 
       /// \brief Get an element by name.
-      /// Searches the list of entities, and return a pointer to the model
-      /// with a matching _name.
+      /// Scoped names are resolved through a hash index maintained by the
+      /// world. Other names are matched by searching the list of entities,
+      /// and return a pointer to the model with a matching _name.
       /// \param[in] _name The name of the Model to find.
       /// \return A pointer to the entity, or NULL if no entity was found.
       public: BasePtr BaseByName(const std::string &_name) const;
@@ -298,6 +341,21 @@ namespace gazebo
       /// \param _state The state to set the World to.
       public: void SetState(const WorldState &_state);
 
+      /// \brief Copy the dynamic state of the world into a snapshot, see
+      /// WorldSnapshot. Reusing the same snapshot object avoids allocating.
+      /// \param[out] _snapshot Snapshot to fill.
+      public: void SaveSnapshot(WorldSnapshot &_snapshot);
+
+      /// \brief Put the world back in the state of a snapshot: link poses
+      /// and velocities, joint states, sim time, iterations and random
+      /// seeds. Unlike Reset, plugins are not reset and no reset event is
+      /// sent, which makes it cheap enough to start every episode of a
+      /// training run from the same state.
+      /// \param[in] _snapshot Snapshot taken from this world.
+      /// \return False if the snapshot is empty, is from another world, or
+      /// models were added or removed since it was taken.
+      public: bool RestoreSnapshot(const WorldSnapshot &_snapshot);
+
       /// \brief Insert a model from an SDF file.
       /// Spawns a model into the world based on an SDF file.
       /// \param[in] _sdfFilename The name of the SDF file (including path).
@@ -313,6 +371,15 @@ namespace gazebo
       /// \param[in] _sdf A reference to an SDF object.
       public: void InsertModelSDF(const sdf::SDF &_sdf);
 
+      /// \brief Insert many models at once. The models are loaded
+      /// together on the next world update, without the SDF parsing of
+      /// InsertModelString or a scan of the world's models per insertion,
+      /// which makes spawning thousands of models practical. Names that
+      /// are taken get a numeric suffix, as with the factory.
+      /// \param[in] _models <model> elements, for example clones of one
+      /// parsed template. The world takes ownership of them.
+      public: void InsertModels(const std::vector<sdf::ElementPtr> &_models);
+
       /// \brief Return a version of the name with "<world_name>::" removed
       /// \param[in] _name Usually the name of an entity.
       /// \return The stripped world name.
@@ -332,6 +399,28 @@ namespace gazebo
       /// \param[in] _steps The number of steps the World should take.
       public: void Step(const unsigned int _steps);
 
+      /// \brief Step the world forward in time, running all the iterations
+      /// back to back in the world update thread. Messages are processed
+      /// and world statistics are published once, after the last
+      /// iteration. Blocks until the batch is done.
+      /// \param[in] _steps The number of steps the World should take.
+      /// \param[in] _flags Bitwise or of StepBatchFlag values selecting the
+      /// work to skip on each iteration.
+      public: void StepBatch(const unsigned int _steps,
+                             const unsigned int _flags = STEP_BATCH_NONE);
+
+      /// \brief Start a batch like StepBatch, without waiting for it. This
+      /// lets several worlds run their batches at the same time.
+      /// \param[in] _steps The number of steps the World should take.
+      /// \param[in] _flags Bitwise or of StepBatchFlag values selecting the
+      /// work to skip on each iteration.
+      /// \sa WaitStepBatch
+      public: void StartStepBatch(const unsigned int _steps,
+                                  const unsigned int _flags = STEP_BATCH_NONE);
+
+      /// \brief Wait for the batch started by StartStepBatch to be done.
+      public: void WaitStepBatch();
+
       /// \brief Load a plugin
       /// \param[in] _filename The filename of the plugin.
       /// \param[in] _name A unique name for the plugin.
@@ -348,6 +437,17 @@ namespace gazebo
       /// \return Reference to the mutex.
       public: std::mutex &WorldPoseMutex() const;
 
+      /// \brief Set the world poses of many models at once. This is
+      /// equivalent to calling Model::SetWorldPose on each model, but the
+      /// pose and physics mutexes are taken once for the whole batch and
+      /// each model is queued for publication once, which matters for
+      /// plugins that teleport many models every step.
+      /// \param[in] _poses Models and their new world poses. Null models
+      /// are skipped.
+      public: void SetModelPoses(
+                  const std::vector<std::pair<ModelPtr,
+                      ignition::math::Pose3d>> &_poses);
+
       /// \brief check if physics engine is enabled/disabled.
       /// \param True if the physics engine is enabled.
       public: bool PhysicsEnabled() const;
@@ -356,6 +456,70 @@ namespace gazebo
       /// \param[in] _enable True to enable the physics engine.
       public: void SetPhysicsEnabled(const bool _enable);
 
+      /// \brief Check if the link kinematics cache is refreshed every
+      /// iteration.
+      /// \return True if the cache is enabled.
+      public: bool LinkKinematicsCacheEnabled() const;
+
+      /// \brief Enable or disable the link kinematics cache. When enabled,
+      /// the pose, velocity and acceleration of every link are copied into
+      /// contiguous arrays once per iteration, right after the physics
+      /// update. This can also be enabled by setting
+      /// <ignition:link_kinematics_cache> to true in the world SDF.
+      /// \param[in] _enable True to enable the cache.
+      public: void SetLinkKinematicsCacheEnabled(const bool _enable);
+
+      /// \brief Get the link kinematics cache. The cache is empty unless
+      /// it's enabled, and it must only be read from the world update
+      /// thread.
+      /// \return Reference to the cache.
+      public: const LinkKinematicsCache &LinkKinematics() const;
+
+      /// \brief Check if the spatial index over model bounding boxes is
+      /// maintained.
+      /// \return True if the index is enabled.
+      public: bool SpatialIndexEnabled() const;
+
+      /// \brief Enable or disable the spatial index over the bounding
+      /// boxes of the top level models. When enabled, EntityBelowPoint and
+      /// ModelBelowPoint use it to skip or shorten their ray test. This can
+      /// also be enabled by setting <ignition:spatial_index> to true in the
+      /// world SDF, and the cell size set with
+      /// <ignition:spatial_index_cell_size>.
+      /// \param[in] _enable True to enable the index.
+      public: void SetSpatialIndexEnabled(const bool _enable);
+
+      /// \brief Get the spatial index over model bounding boxes. The index
+      /// is empty unless it's enabled. It's safe to query from any thread.
+      /// \return Reference to the index.
+      public: const SpatialIndex &ModelSpatialIndex() const;
+
+      /// \brief Check if the proximity index over model positions is
+      /// maintained.
+      /// \return True if the index is enabled.
+      public: bool ProximityIndexEnabled() const;
+
+      /// \brief Enable or disable the proximity index over the positions
+      /// of the top level models. It answers nearest neighbor and radius
+      /// queries, also served on "/world/<name>/proximity". This can also be
+      /// enabled by setting <ignition:proximity_index> to true in the world
+      /// SDF.
+      /// \param[in] _enable True to enable the index.
+      public: void SetProximityIndexEnabled(const bool _enable);
+
+      /// \brief Get the proximity index over model positions. The index is
+      /// empty unless it's enabled. It's safe to query from any thread.
+      /// \return Reference to the index.
+      public: const ProximityIndex &ModelProximityIndex() const;
+
+      /// \brief Get the collision queries of this world. Queries are
+      /// answered on a worker thread from a snapshot of the collision poses
+      /// taken at the end of a world update, so they can be made from any
+      /// thread without holding up the simulation. The same queries are
+      /// served on "/world/<name>/collision_query".
+      /// \return Reference to the queries.
+      public: CollisionQuery &CollisionQueries();
+
       /// \brief check if wind is enabled/disabled.
       /// \param True if the wind is enabled.
       public: bool WindEnabled() const;
@@ -439,6 +603,40 @@ namespace gazebo
       /// \param[in] _entity Entity that has moved.
       public: void _AddDirty(Entity *_entity);
 
+      /// \internal
+      /// \brief Queue a link whose pose relative to its model changed, so
+      /// that only that link is added to the next pose message. This is
+      /// used by Entity::PublishPose.
+      /// \param[in] _link Pointer to the link.
+      public: void _AddDirtyPoseLink(Entity *_link);
+
+      /// \internal
+      /// \brief Remove a link from the queue filled by _AddDirtyPoseLink.
+      /// Called when the link is finalized.
+      /// \param[in] _link Pointer to the link.
+      public: void _RemoveDirtyPoseLink(Entity *_link);
+
+      /// \internal
+      /// \brief Add an entity to the world's scoped name and id index.
+      /// Called by Base::Load once the scoped name is known.
+      /// \param[in] _base Entity to add.
+      public: void _AddToIndex(const BasePtr &_base);
+
+      /// \internal
+      /// \brief Remove an entity from the world's scoped name and id index.
+      /// Called by Base::Fini and Base::SetName.
+      /// \param[in] _base Entity to remove.
+      /// \return True if the entity was in the index.
+      public: bool _RemoveFromIndex(const Base *_base);
+
+      /// \internal
+      /// \brief Look up an entity in the world's scoped name index only,
+      /// without falling back to a search of the entity tree.
+      /// \param[in] _scopedName Scoped name of the entity, without the
+      /// world name.
+      /// \return The entity, or nullptr if it isn't in the index.
+      public: BasePtr _BaseByScopedName(const std::string &_scopedName) const;
+
       /// \brief Get whether sensors have been initialized.
       /// \return True if sensors have been initialized.
       public: bool SensorsInitialized() const;
@@ -464,6 +662,14 @@ namespace gazebo
       /// \param[in] function to be called
       public: void SetSensorWaitFunc(std::function<void(double, double)> _func);
 
+      /// \brief Play a log back as fast as possible. The real time factor
+      /// requested through playback control is ignored and world
+      /// statistics are published every ignition:world_stats_step_period
+      /// iterations. Sensors with a strict rate still render every state
+      /// they need, as they are waited for before each state is applied.
+      /// \param[in] _enable True to play at maximum speed.
+      public: void SetLogPlayMaxSpeed(const bool _enable);
+
       /// \cond
       /// This is an internal function.
       /// \brief Get a model by id.
@@ -544,7 +750,15 @@ namespace gazebo
       /// \param[out] _scene Scene message to build.
       /// \param[in] _entity Pointer to entity from which to build the scene
       /// message.
-      private: void BuildSceneMsg(msgs::Scene &_scene, BasePtr _entity);
+      /// \param[out] _models If not null, the models are appended to it
+      /// instead of being added to the message.
+      private: void BuildSceneMsg(msgs::Scene &_scene, BasePtr _entity,
+                                  Model_V *_models = nullptr);
+
+      /// \brief Publish the next models of the scenes streamed to clients
+      /// that sent a "scene_info_stream" request, within a small time
+      /// budget.
+      private: void PublishSceneStream();
 
       /// \brief Logs joint information.
       /// \param[in] _msg Incoming joint message.
@@ -558,7 +772,12 @@ namespace gazebo
       /// \param[in] _msg The model message.
       private: void OnModelMsg(ConstModelPtr &_msg);
 
-      /// \brief TBB version of model updating.
+      /// \brief Called when a client acknowledges a compact pose frame.
+      /// \param[in] _msg The acknowledgement.
+      private: void OnCompactPosesAck(ConstCompactPosesAckPtr &_msg);
+
+      /// \brief TBB version of model updating. Enabled by setting
+      /// <ignition:parallel_model_update> to true in the world SDF.
       private: void ModelUpdateTBB();
 
       /// \brief Single loop version of model updating.
@@ -581,10 +800,21 @@ namespace gazebo
       /// Must only be called from the World::ProcessMessages function.
       private: void ProcessRequestMsgs();
 
-      /// \brief Process all received factory messages.
+      /// \brief Process all received factory messages. The messages are
+      /// parsed by the factory worker, the entities they describe are
+      /// inserted by a later call, once the worker is done with them.
       /// Must only be called from the World::ProcessMessages function.
       private: void ProcessFactoryMsgs();
 
+      /// \brief Thread function that resolves and parses factory messages
+      /// and the meshes they use, so that the physics thread only inserts
+      /// the entities.
+      private: void FactoryWorker();
+
+      /// \brief Load the models queued by InsertModels.
+      /// Must only be called from the World::ProcessMessages function.
+      private: void ProcessInsertedModels();
+
       /// \brief Process all received model messages.
       /// Must only be called from the World::ProcessMessages function.
       private: void ProcessModelMsgs();
@@ -614,9 +844,30 @@ namespace gazebo
       /// \brief Publish the world stats message.
       private: void PublishWorldStats();
 
+      /// \brief Update the shared memory clock and publish the sim time on
+      /// ~/clock, rate limited by ignition:clock_rate.
+      private: void PublishClock();
+
+      /// \brief Publish the joint states of the models selected by
+      /// ignition:joint_states_models on ~/joint_states, rate limited by
+      /// ignition:joint_states_rate.
+      private: void PublishJointStates();
+
+      /// \brief Publish the states of all batteries on ~/battery_states,
+      /// rate limited by ignition:battery_states_rate.
+      private: void PublishBatteryStates();
+
+      /// \brief Publish the step timings once per second of wall time.
+      private: void PublishStepTimings();
+
       /// \brief Thread function for logging state data.
       private: void LogWorker();
 
+      /// \brief Copy the current state into the log state buffer, if it's
+      /// due according to the log record period. Blocks only when the log
+      /// worker has fallen a full buffer behind.
+      private: void LogCapture();
+
       /// \brief Register items in the introspection service.
       private: void RegisterIntrospectionItems();
 
@@ -657,6 +908,21 @@ namespace gazebo
       /// \return True if the info was successfully obtained.
       private: bool SceneInfoService(msgs::Scene &_response);
 
+      /// \brief Callback for "/world/<name>/collision_query" service.
+      /// \param[in] _req The query.
+      /// \param[out] _res The hits.
+      /// \return True if the query was answered in time.
+      private: bool CollisionQueryService(
+          const msgs::CollisionQueryRequest &_req,
+          msgs::CollisionQueryResponse &_res);
+
+      /// \brief Callback for "/world/<name>/proximity" service.
+      /// \param[in] _req The point and the search limits.
+      /// \param[out] _res The models found.
+      /// \return True if the index was ready.
+      private: bool ProximityService(const msgs::ProximityRequest &_req,
+          msgs::ProximityResponse &_res);
+
       /// \brief Callback for "<this_name>/shadow_caster_material_name" service.
       /// \param[out] _response Message containing shadow caster material name
       /// \return True if the info was successfully obtained.
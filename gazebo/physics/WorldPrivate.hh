@@ -17,8 +17,12 @@
 #ifndef GAZEBO_PHYSICS_WORLDPRIVATE_HH_
 #define GAZEBO_PHYSICS_WORLDPRIVATE_HH_
 
+#include <array>
 #include <atomic>
+#include <chrono>
+#include <ctime>
 #include <deque>
+#include <limits>
 #include <vector>
 #include <list>
 #include <memory>
@@ -27,25 +31,102 @@
 #include <string>
 #include <mutex>
 #include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <condition_variable>
 
+#include <boost/regex.hpp>
+#include <boost/weak_ptr.hpp>
 #include <ignition/transport.hh>
 
 #include "gazebo/common/Event.hh"
+#include "gazebo/common/LatencyHistogram.hh"
+#include "gazebo/common/SimTimeScheduler.hh"
 #include "gazebo/common/Time.hh"
 #include "gazebo/common/URI.hh"
 
 #include "gazebo/msgs/msgs.hh"
+#include "gazebo/msgs/PoseStream.hh"
 
+#include "gazebo/transport/ShmClock.hh"
 #include "gazebo/transport/TransportTypes.hh"
 
+#include "gazebo/physics/CollisionQuery.hh"
+#include "gazebo/physics/LinkKinematicsCache.hh"
+#include "gazebo/physics/SpatialIndex.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/physics/ProximityIndex.hh"
 #include "gazebo/physics/WorldState.hh"
+#include "gazebo/physics/WorldStateBuffer.hh"
+#include "gazebo/physics/WorldStateDelta.hh"
 
 namespace gazebo
 {
   namespace physics
   {
+    /// \brief Stages of the update loop timed on every step, see
+    /// WorldPrivate::stepTimings.
+    enum WorldStepStage
+    {
+      /// \brief World::Update as a whole.
+      STEP_STAGE_UPDATE,
+
+      /// \brief PhysicsEngine::UpdateCollision.
+      STEP_STAGE_COLLISION,
+
+      /// \brief PhysicsEngine::UpdatePhysics.
+      STEP_STAGE_PHYSICS,
+
+      /// \brief Waiting for sensors done with the previous step.
+      STEP_STAGE_SENSORS_WAIT,
+
+      /// \brief World::ProcessMessages.
+      STEP_STAGE_MESSAGES,
+
+      /// \brief Capturing the state for the log.
+      STEP_STAGE_LOG,
+
+      /// \brief Number of stages.
+      STEP_STAGE_COUNT
+    };
+
+    /// \brief A model file parsed for a factory message, see
+    /// WorldPrivate::parsedModelFiles.
+    class ParsedModelFile
+    {
+      /// \brief Model file the URI resolved to.
+      public: std::string filename;
+
+      /// \brief Modification time of the file when it was parsed.
+      public: std::time_t modified = 0;
+
+      /// \brief Parsed SDF root, with its URIs converted to full paths.
+      public: sdf::ElementPtr root;
+    };
+
+    /// \brief A factory message prepared by the factory worker, see
+    /// World::FactoryWorker.
+    class PreparedFactoryMsg
+    {
+      /// \brief The message.
+      public: msgs::Factory msg;
+
+      /// \brief SDF root parsed from the message, null if the message
+      /// carries no SDF, such as a clone request.
+      public: sdf::ElementPtr root;
+    };
+
+    /// \brief A model of a scene streamed to a client, see
+    /// World::PublishSceneStream.
+    class SceneStreamEntry
+    {
+      /// \brief The model.
+      public: boost::weak_ptr<Model> model;
+
+      /// \brief Version of the model the client already has, 0 if none.
+      public: std::size_t knownVersion = 0;
+    };
+
     /// \brief Private data class for World.
     class WorldPrivate
     {
@@ -80,6 +161,9 @@ namespace gazebo
       /// \brief Current simulation time.
       public: common::Time simTime;
 
+      /// \brief Simulation time timers, see World::Scheduler.
+      public: common::SimTimeScheduler scheduler;
+
       /// \brief Amount of time simulation has been paused.
       public: common::Time pauseTime;
 
@@ -92,6 +176,38 @@ namespace gazebo
       /// \brief Number of steps in increment by.
       public: int stepInc;
 
+      /// \brief Notified when stepInc is decremented to zero so that
+      /// World::Step(unsigned int) does not need to poll.
+      public: std::condition_variable_any stepIncCondition;
+
+      /// \brief True while the steps in stepInc belong to World::StepBatch.
+      public: bool stepBatch = false;
+
+      /// \brief World::StepBatchFlag values of the current batch.
+      public: unsigned int stepBatchFlags = 0;
+
+      /// \brief When running as fast as possible (zero real time update
+      /// rate), world statistics are only published every this many
+      /// iterations.
+      public: unsigned int worldStatsStepPeriod = 1;
+
+      /// \brief Maximum rate of the world statistics, in Hz.
+      public: double worldStatsRate = 5;
+
+      /// \brief Maximum rate of the ~/clock topic, in Hz. Local processes
+      /// read the shared memory clock instead, which is always current.
+      public: double clockRate = 50;
+
+      /// \brief Maximum rate of the ~/joint_states topic, in Hz.
+      public: double jointStatesRate = 100;
+
+      /// \brief Models whose scoped name matches are published on
+      /// ~/joint_states.
+      public: boost::regex jointStatesFilter{".*"};
+
+      /// \brief Maximum rate of the ~/battery_states topic, in Hz.
+      public: double batteryStatesRate = 10;
+
       /// \brief All the event connections.
       public: event::Connection_V connections;
 
@@ -101,6 +217,38 @@ namespace gazebo
       /// \brief Publisher for world statistics messages.
       public: transport::PublisherPtr statPub;
 
+      /// \brief World statistics message, reused so that its time
+      /// submessages are not allocated on every publish.
+      public: msgs::WorldStatistics worldStatsMsg;
+
+      /// \brief Publisher of the sim time.
+      public: transport::PublisherPtr clockPub;
+
+      /// \brief Sim time shared with local processes.
+      public: transport::ShmClock shmClock;
+
+      /// \brief Publisher of the joint states of many models.
+      public: transport::PublisherPtr jointStatesPub;
+
+      /// \brief Models published on ~/joint_states.
+      public: Model_V jointStatesModels;
+
+      /// \brief Entity version the models were selected at.
+      public: uint64_t jointStatesVersion =
+          std::numeric_limits<uint64_t>::max();
+
+      /// \brief Joint positions of one model, reused between messages.
+      public: std::vector<double> jointPositions;
+
+      /// \brief Joint velocities of one model.
+      public: std::vector<double> jointVelocities;
+
+      /// \brief Joint efforts of one model.
+      public: std::vector<double> jointEfforts;
+
+      /// \brief Publisher of the states of all batteries.
+      public: transport::PublisherPtr batteryStatesPub;
+
       /// \brief Publisher for request response messages.
       public: transport::PublisherPtr responsePub;
 
@@ -122,6 +270,15 @@ namespace gazebo
       /// \brief Publisher for local pose messages.
       public: transport::PublisherPtr poseLocalPub;
 
+      /// \brief Publisher of the compact pose stream.
+      public: transport::PublisherPtr compactPosePub;
+
+      /// \brief Subscriber to acknowledgements of the compact pose stream.
+      public: transport::SubscriberPtr compactPoseAckSub;
+
+      /// \brief Codes the compact pose stream.
+      public: msgs::PoseStreamEncoder poseStreamEncoder;
+
       /// \brief Subscriber to world control messages.
       public: transport::SubscriberPtr controlSub;
 
@@ -149,15 +306,51 @@ namespace gazebo
       /// \brief Subscriber to request messages.
       public: transport::SubscriberPtr requestSub;
 
-      /// \brief Outgoing world statistics message.
-      public: msgs::WorldStatistics worldStatsMsg;
-
       /// \brief Outgoing scene message.
       public: msgs::Scene sceneMsg;
 
+      /// \brief Models of streamed scenes, waiting to be published on
+      /// ~/model/info.
+      public: std::deque<SceneStreamEntry> sceneStreamQueue;
+
       /// \brief Function pointer to the model update function.
       public: void (World::*modelUpdateFunc)();
 
+      /// \brief Root children updated by World::ModelUpdateTBB. Kept as a
+      /// member so the storage is reused between iterations.
+      public: Base_V modelUpdateChildren;
+
+      /// \brief Number of models handed to a worker at a time by
+      /// World::ModelUpdateTBB.
+      public: size_t modelUpdateGrainSize = 4;
+
+      /// \brief True to refresh linkKinematics every iteration.
+      public: bool linkKinematicsEnabled = false;
+
+      /// \brief Contiguous copy of the kinematics of every link.
+      public: LinkKinematicsCache linkKinematics;
+
+      /// \brief True to maintain spatialIndex.
+      public: std::atomic<bool> spatialIndexEnabled{false};
+
+      /// \brief Grid over the bounding boxes of the top level models.
+      public: SpatialIndex spatialIndex;
+
+      /// \brief True to maintain proximityIndex.
+      public: std::atomic<bool> proximityIndexEnabled{false};
+
+      /// \brief Kd-tree over the positions of the top level models.
+      public: ProximityIndex proximityIndex;
+
+      /// \brief Answers collision queries from a snapshot of the world.
+      public: CollisionQuery collisionQuery;
+
+      /// \brief Puts resting models to sleep.
+      public: SleepManagerPtr sleepManager;
+
+      /// \brief Updates the batteries of all links.
+      public: BatterySystemPtr batterySystem;
+
       /// \brief Last time a world statistics message was sent.
       public: common::Time prevStatTime;
 
@@ -173,6 +366,14 @@ namespace gazebo
       /// \brief Mutex to protext loading of models.
       public: std::mutex loadModelMutex;
 
+      /// \brief True while LoadEntities loads the models of the world.
+      /// LoadModel then checks names against batchModelNames and leaves
+      /// EnableAllModels to the end of the batch.
+      public: bool batchLoading = false;
+
+      /// \brief Names of the models loaded so far, while batchLoading.
+      public: std::unordered_set<std::string> batchModelNames;
+
       /// \brief Mutex to protext loading of lights.
       public: std::mutex loadLightMutex;
 
@@ -211,6 +412,30 @@ namespace gazebo
       /// \brief Factory message buffer.
       public: std::list<msgs::Factory> factoryMsgs;
 
+      /// \brief Thread that parses factory messages and their meshes
+      /// outside of the physics loop.
+      public: std::thread *factoryThread = nullptr;
+
+      /// \brief Protects factoryPending, factoryPrepared and factoryStop.
+      public: std::mutex factoryMutex;
+
+      /// \brief Wakes the factory worker.
+      public: std::condition_variable factoryCondition;
+
+      /// \brief Factory messages waiting for the factory worker, in the
+      /// order they were received.
+      public: std::deque<msgs::Factory> factoryPending;
+
+      /// \brief Factory messages ready to be inserted by the physics
+      /// thread, in the order they were received.
+      public: std::deque<PreparedFactoryMsg> factoryPrepared;
+
+      /// \brief True to stop the factory worker.
+      public: bool factoryStop = false;
+
+      /// \brief Models queued by World::InsertModels.
+      public: std::vector<sdf::ElementPtr> insertedModels;
+
       /// \brief Model message buffer.
       public: std::list<msgs::Model> modelMsgs;
 
@@ -274,10 +499,6 @@ namespace gazebo
       /// \brief Buffer of prev states
       public: WorldState prevStates[2];
 
-      /// \brief Previous unfiltered state. Used for determining insertions
-      /// and deletions
-      public: WorldState prevUnfilteredState;
-
       /// \brief Int used to toggle between prevStates
       public: int stateToggle;
 
@@ -291,9 +512,32 @@ namespace gazebo
       /// objects are inserted via the factory.
       public: sdf::SDFPtr factorySDF;
 
+      /// \brief Model files inserted through factory messages, keyed by
+      /// the sdf_filename of the message. A model inserted many times is
+      /// resolved and parsed once. Only used by the factory worker.
+      public: std::unordered_map<std::string, ParsedModelFile>
+              parsedModelFiles;
+
       /// \brief The list of models that need to publish their pose.
       public: std::set<ModelPtr> publishModelPoses;
 
+      /// \brief Non-canonical links that need to publish their pose, in the
+      /// order in which they were queued. Links whose model is in
+      /// publishModelPoses are published with the model instead.
+      public: std::vector<Entity *> dirtyPoseLinks;
+
+      /// \brief Set of the links in dirtyPoseLinks, used to avoid queuing a
+      /// link twice and to skip links already published with their model.
+      public: std::unordered_set<Entity *> dirtyPoseLinkSet;
+
+      /// \brief Pose message reused by ProcessMessages so that its repeated
+      /// fields keep their allocations between iterations.
+      public: msgs::PosesStamped posesStampedMsg;
+
+      /// \brief Scratch stack of models used by ProcessMessages to walk
+      /// nested models.
+      public: std::vector<Model *> poseModelStack;
+
       /// \brief The list of models that need to publish their scale.
       public: std::set<ModelPtr> publishModelScales;
 
@@ -312,12 +556,23 @@ namespace gazebo
       /// \brief Condition used for log worker.
       public: std::condition_variable logCondition;
 
-      /// \brief Condition used to guarantee the log worker thread doesn't
-      /// skip an interation.
+      /// \brief Condition used to wake the physics thread when the log
+      /// worker frees up space in logStateBuffer.
       public: std::condition_variable logContinueCondition;
 
-      /// \brief Last iteration recorded by the log worker thread.
-      public: uint64_t logPrevIteration;
+      /// \brief Snapshots captured by the physics thread for the log worker.
+      public: WorldStateBuffer logStateBuffer;
+
+      /// \brief Value of entityVersion at the last log state capture.
+      public: uint64_t logCaptureVersion = 0;
+
+      /// \brief Reduces the states recorded between full states. Only
+      /// used by the log worker.
+      public: WorldStateDelta logDelta;
+
+      /// \brief Set when logging stops, so the log worker starts the next
+      /// log from a full state.
+      public: std::atomic<bool> logDeltaReset{true};
 
       /// \brief Real time value set from a log file.
       public: common::Time logRealTime;
@@ -334,6 +589,21 @@ namespace gazebo
       /// \brief Worker thread for logging.
       public: std::thread *logThread;
 
+      /// \brief Index from scoped name (without the world name) to every
+      /// loaded entity in the world.
+      public: std::unordered_map<std::string, boost::weak_ptr<Base>>
+              nameIndex;
+
+      /// \brief Index from entity id to every loaded entity in the world.
+      public: std::unordered_map<uint32_t, boost::weak_ptr<Base>> idIndex;
+
+      /// \brief Incremented whenever an entity is added to or removed from
+      /// the index, so that caches of the entity tree can be invalidated.
+      public: uint64_t entityVersion = 0;
+
+      /// \brief Protects nameIndex, idIndex and entityVersion.
+      public: mutable std::mutex indexMutex;
+
       /// \brief A cached list of models. This is here for performance.
       public: Model_V models;
 
@@ -371,6 +641,13 @@ namespace gazebo
       /// \brief Log play real time factor
       public: double logPlayRealTimeFactor;
 
+      /// \brief True to play logs back without pacing.
+      public: std::atomic<bool> logPlayMaxSpeed{false};
+
+      /// \brief Sim time between the last two log states played forward,
+      /// the step sensors are waited for during playback.
+      public: gazebo::common::Time logPlayStepSize;
+
       /// \brief URI of this world.
       public: common::URI uri;
 
@@ -397,6 +674,23 @@ namespace gazebo
 
       /// \brief Shadow caster render back faces from scene SDF
       public: bool shadowCasterRenderBackFaces = true;
+
+      /// \brief Wall time spent in each stage of the update loop since
+      /// stepTimingsStart, published on ~/performance.
+      public: std::array<common::LatencyHistogram, STEP_STAGE_COUNT>
+              stepTimings;
+
+      /// \brief Heap allocations made in each stage of the update loop
+      /// since stepTimingsStart. Stays zero unless gazebo is built with
+      /// ENABLE_ALLOCATION_TRACKING.
+      public: std::array<uint64_t, STEP_STAGE_COUNT> stepAllocations{};
+
+      /// \brief Start of the current step timing window.
+      public: std::chrono::steady_clock::time_point stepTimingsStart =
+              std::chrono::steady_clock::now();
+
+      /// \brief Publisher of the step timings.
+      public: transport::PublisherPtr performancePub;
     };
   }
 }
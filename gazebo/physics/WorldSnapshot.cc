@@ -0,0 +1,212 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <vector>
+
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Rand.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/physics/ContactManager.hh"
+#include "gazebo/physics/Link.hh"
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/PhysicsEngine.hh"
+#include "gazebo/physics/World.hh"
+#include "gazebo/physics/WorldSnapshot.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief Private data for WorldSnapshot.
+    class WorldSnapshotPrivate
+    {
+      /// \brief World the snapshot was taken from, null if empty.
+      public: const World *world = nullptr;
+
+      /// \brief Entity version of the world when it was taken.
+      public: uint64_t entityVersion = 0;
+
+      /// \brief Sim time.
+      public: common::Time simTime;
+
+      /// \brief Iteration count.
+      public: uint64_t iterations = 0;
+
+      /// \brief Random seed.
+      public: unsigned int seed = 0;
+
+      /// \brief All models, including nested ones, parents first.
+      public: std::vector<Model *> models;
+
+      /// \brief All links, grouped by model.
+      public: std::vector<Link *> links;
+
+      /// \brief World pose of each link.
+      public: std::vector<ignition::math::Pose3d> linkPoses;
+
+      /// \brief World linear velocity of each link.
+      public: std::vector<ignition::math::Vector3d> linkLinearVels;
+
+      /// \brief World angular velocity of each link.
+      public: std::vector<ignition::math::Vector3d> linkAngularVels;
+
+      /// \brief Whether each link was enabled, it may have been put to
+      /// sleep by the engine.
+      public: std::vector<char> linkEnabled;
+
+      /// \brief Joint positions of each model, see Model::JointStates.
+      public: std::vector<std::vector<double>> jointPositions;
+
+      /// \brief Joint velocities of each model, see Model::JointStates.
+      public: std::vector<std::vector<double>> jointVelocities;
+    };
+  }
+}
+
+using namespace gazebo;
+using namespace physics;
+
+/////////////////////////////////////////////////
+/// \brief Append a model and its nested models to a list, parents first.
+/// \param[in] _model Model to add.
+/// \param[out] _models List to append to.
+static void AddModel(const ModelPtr &_model, std::vector<Model *> &_models)
+{
+  _models.push_back(_model.get());
+  for (const auto &nested : _model->NestedModels())
+    AddModel(nested, _models);
+}
+
+/////////////////////////////////////////////////
+WorldSnapshot::WorldSnapshot()
+  : dataPtr(new WorldSnapshotPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+WorldSnapshot::~WorldSnapshot()
+{
+}
+
+/////////////////////////////////////////////////
+bool WorldSnapshot::Valid() const
+{
+  return this->dataPtr->world != nullptr;
+}
+
+/////////////////////////////////////////////////
+common::Time WorldSnapshot::SimTime() const
+{
+  return this->dataPtr->simTime;
+}
+
+/////////////////////////////////////////////////
+uint64_t WorldSnapshot::Iterations() const
+{
+  return this->dataPtr->iterations;
+}
+
+/////////////////////////////////////////////////
+void WorldSnapshot::Capture(World &_world, const uint64_t _entityVersion)
+{
+  WorldSnapshotPrivate &d = *this->dataPtr;
+
+  // The entity lists are only rebuilt when the world changed
+  if (d.world != &_world || d.entityVersion != _entityVersion)
+  {
+    d.models.clear();
+    for (const auto &model : _world.Models())
+      AddModel(model, d.models);
+
+    d.links.clear();
+    for (const auto model : d.models)
+    {
+      for (const auto &link : model->GetLinks())
+        d.links.push_back(link.get());
+    }
+
+    d.world = &_world;
+    d.entityVersion = _entityVersion;
+  }
+
+  d.simTime = _world.SimTime();
+  d.iterations = _world.Iterations();
+  d.seed = ignition::math::Rand::Seed();
+
+  const size_t linkCount = d.links.size();
+  d.linkPoses.resize(linkCount);
+  d.linkLinearVels.resize(linkCount);
+  d.linkAngularVels.resize(linkCount);
+  d.linkEnabled.resize(linkCount);
+  for (size_t i = 0; i < linkCount; ++i)
+  {
+    const Link *link = d.links[i];
+    d.linkPoses[i] = link->WorldPose();
+    d.linkLinearVels[i] = link->WorldLinearVel();
+    d.linkAngularVels[i] = link->WorldAngularVel();
+    d.linkEnabled[i] = link->GetEnabled();
+  }
+
+  d.jointPositions.resize(d.models.size());
+  d.jointVelocities.resize(d.models.size());
+  for (size_t i = 0; i < d.models.size(); ++i)
+  {
+    if (d.models[i]->GetJointCount() > 0)
+      d.models[i]->JointStates(d.jointPositions[i], d.jointVelocities[i]);
+  }
+}
+
+/////////////////////////////////////////////////
+bool WorldSnapshot::Apply(World &_world, const uint64_t _entityVersion) const
+{
+  const WorldSnapshotPrivate &d = *this->dataPtr;
+  if (d.world != &_world || d.entityVersion != _entityVersion)
+    return false;
+
+  // Links first, this is the whole state of maximal coordinate engines
+  // such as ODE and Bullet
+  for (size_t i = 0; i < d.links.size(); ++i)
+  {
+    Link *link = d.links[i];
+    link->SetWorldPose(d.linkPoses[i]);
+    link->SetLinearVel(d.linkLinearVels[i]);
+    link->SetAngularVel(d.linkAngularVels[i]);
+    link->SetForce(ignition::math::Vector3d::Zero);
+    link->SetTorque(ignition::math::Vector3d::Zero);
+    link->SetEnabled(d.linkEnabled[i] != 0);
+  }
+
+  // Then the joints, which is how DART and Simbody store the state of
+  // links that aren't free floating
+  for (size_t i = 0; i < d.models.size(); ++i)
+  {
+    if (!d.jointPositions[i].empty())
+    {
+      d.models[i]->SetJointStates(d.jointPositions[i],
+          d.jointVelocities[i]);
+    }
+  }
+
+  // Contacts are regenerated by the next step, don't report stale ones
+  _world.Physics()->GetContactManager()->Clear();
+
+  ignition::math::Rand::Seed(d.seed);
+  _world.Physics()->SetSeed(d.seed);
+  return true;
+}
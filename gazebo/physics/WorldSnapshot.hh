@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_WORLDSNAPSHOT_HH_
+#define GAZEBO_PHYSICS_WORLDSNAPSHOT_HH_
+
+#include <memory>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    // Forward declare private data class
+    class WorldSnapshotPrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class WorldSnapshot WorldSnapshot.hh physics/physics.hh
+    /// \brief In memory copy of the dynamic state of a world, taken with
+    /// World::SaveSnapshot and applied with World::RestoreSnapshot.
+    ///
+    /// A snapshot holds the pose, velocity and enabled flag of every link,
+    /// the joint states of every model, the sim time, the iteration count
+    /// and the random seed, in flat arrays indexed by entity. It doesn't
+    /// hold names, so restoring it is a pass over those arrays instead of
+    /// the name lookups of World::SetState. It can be restored any number
+    /// of times, as long as no model was added or removed in between.
+    /// Taking a new snapshot into the same object reuses its arrays.
+    class GZ_PHYSICS_VISIBLE WorldSnapshot
+    {
+      /// \brief Constructor. The snapshot is empty until it's saved.
+      public: WorldSnapshot();
+
+      /// \brief Destructor.
+      public: ~WorldSnapshot();
+
+      /// \brief Whether the snapshot holds a state.
+      /// \return True once World::SaveSnapshot filled it.
+      public: bool Valid() const;
+
+      /// \brief Sim time of the snapshot.
+      /// \return Sim time when the snapshot was taken.
+      public: common::Time SimTime() const;
+
+      /// \brief Iteration count of the snapshot.
+      /// \return Number of iterations when the snapshot was taken.
+      public: uint64_t Iterations() const;
+
+      /// \brief Copy the state of a world. Called by World::SaveSnapshot.
+      /// \param[in] _world World to copy.
+      /// \param[in] _entityVersion Counter that changes whenever an entity
+      /// is added to or removed from the world.
+      public: void Capture(World &_world, const uint64_t _entityVersion);
+
+      /// \brief Apply the state of the links and joints to a world. Called
+      /// by World::RestoreSnapshot, which restores the times.
+      /// \param[in] _world World to restore.
+      /// \param[in] _entityVersion Current entity counter of the world.
+      /// \return False if the snapshot is empty, was taken from another
+      /// world or the world's entities changed since it was taken.
+      public: bool Apply(World &_world, const uint64_t _entityVersion) const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<WorldSnapshotPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
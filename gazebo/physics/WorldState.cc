@@ -48,7 +48,7 @@ WorldState::WorldState(const WorldPtr _world)
   this->world = _world;
 
   // Add a state for all the models
-  Model_V models = _world->Models();
+  const Model_V &models = _world->Models();
   for (Model_V::const_iterator iter = models.begin();
        iter != models.end(); ++iter)
   {
@@ -113,7 +113,7 @@ void WorldState::Load(const WorldPtr _world)
   std::list<std::string>::iterator partIter = parts.begin();
 
   // Add a state for all the models that match the filter
-  Model_V models = _world->Models();
+  const Model_V &models = _world->Models();
   for (Model_V::const_iterator iter = models.begin();
        iter != models.end(); ++iter)
   {
@@ -276,6 +276,15 @@ namespace gazebo
 
       /// \brief Pointer to the world.
       private: WorldPtr world;
+
+      /// Friend WorldStateBuffer so that it can fill states from snapshots
+      private: friend class WorldStateBuffer;
+
+      /// Friend WorldStateDelta so that it can drop unchanged states
+      private: friend class WorldStateDelta;
+
+      /// Friend UserCmdPrivate so that it can reduce undo states
+      private: friend class UserCmdPrivate;
     };
     /// \}
   }
@@ -0,0 +1,334 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <limits>
+#include <list>
+#include <unordered_set>
+
+#include <boost/algorithm/string.hpp>
+
+#include "gazebo/common/Assert.hh"
+#include "gazebo/physics/Light.hh"
+#include "gazebo/physics/Link.hh"
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/World.hh"
+#include "gazebo/physics/WorldState.hh"
+#include "gazebo/physics/WorldStateBuffer.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+/////////////////////////////////////////////////
+WorldStateBuffer::WorldStateBuffer(const size_t _capacity)
+  : slots(std::max(_capacity, static_cast<size_t>(1))), head(0), tail(0)
+{
+}
+
+/////////////////////////////////////////////////
+bool WorldStateBuffer::Empty() const
+{
+  return this->tail.load(std::memory_order_acquire) ==
+         this->head.load(std::memory_order_acquire);
+}
+
+/////////////////////////////////////////////////
+bool WorldStateBuffer::Full() const
+{
+  return this->head.load(std::memory_order_acquire) -
+         this->tail.load(std::memory_order_acquire) >= this->slots.size();
+}
+
+/////////////////////////////////////////////////
+void WorldStateBuffer::RebuildLayout(const WorldPtr &_world)
+{
+  auto newLayout = std::make_shared<Layout>();
+  newLayout->worldName = _world->Name();
+  this->models.clear();
+  this->links.clear();
+  this->lights.clear();
+
+  // Walk the models depth first, so that parents come before children.
+  std::vector<std::pair<Model *, size_t>> stack;
+  const size_t noParent = std::numeric_limits<size_t>::max();
+  const Model_V &topModels = _world->Models();
+  for (auto iter = topModels.rbegin(); iter != topModels.rend(); ++iter)
+  {
+    // Models left out by the filter are never walked again until the next
+    // rebuild, so captures only cost as much as the recorded models
+    if (!this->filterModels ||
+        boost::regex_match((*iter)->GetName(), this->filterRegex))
+    {
+      stack.push_back(std::make_pair(iter->get(), noParent));
+    }
+  }
+
+  for (const auto &model : topModels)
+    newLayout->topModelNames.push_back(model->GetName());
+
+  while (!stack.empty())
+  {
+    Model *model = stack.back().first;
+    size_t parent = stack.back().second;
+    stack.pop_back();
+
+    size_t index = this->models.size();
+    this->models.push_back(model);
+    newLayout->modelNames.push_back(model->GetName());
+    newLayout->modelChildren.emplace_back();
+    newLayout->modelLinkStart.push_back(this->links.size());
+    newLayout->modelLinkCount.push_back(model->GetLinks().size());
+
+    if (parent == noParent)
+      newLayout->topModels.push_back(index);
+    else
+      newLayout->modelChildren[parent].push_back(index);
+
+    for (const auto &link : model->GetLinks())
+    {
+      this->links.push_back(link.get());
+      newLayout->linkNames.push_back(link->GetName());
+    }
+
+    const Model_V &nested = model->NestedModels();
+    for (auto iter = nested.rbegin(); iter != nested.rend(); ++iter)
+      stack.push_back(std::make_pair(iter->get(), index));
+  }
+
+  for (const auto &light : _world->Lights())
+  {
+    this->lights.push_back(light.get());
+    newLayout->lightNames.push_back(light->GetName());
+  }
+
+  this->layout = newLayout;
+}
+
+/////////////////////////////////////////////////
+bool WorldStateBuffer::Capture(const WorldPtr &_world,
+    const uint64_t _entityVersion, const std::string &_filter)
+{
+  GZ_ASSERT(_world, "World pointer is invalid");
+
+  if (this->Full())
+    return false;
+
+  bool filterChanged = _filter != this->filter;
+  if (filterChanged)
+  {
+    // Only the first part of the filter, up to the first '.' or '/',
+    // applies to models. This matches WorldState::LoadWithFilter.
+    this->filter = _filter;
+    std::list<std::string> mainParts, parts;
+    boost::split(mainParts, this->filter, boost::is_any_of("/"));
+    if (!mainParts.empty())
+      boost::split(parts, mainParts.front(), boost::is_any_of("."));
+
+    this->filterModels = !parts.empty() && !parts.front().empty() &&
+                         parts.front() != "*";
+    if (this->filterModels)
+    {
+      std::string regexStr = parts.front();
+      boost::replace_all(regexStr, "*", ".*");
+      this->filterRegex = boost::regex(regexStr);
+    }
+  }
+
+  if (!this->layout || this->layoutVersion != _entityVersion ||
+      filterChanged)
+  {
+    this->RebuildLayout(_world);
+    this->layoutVersion = _entityVersion;
+  }
+
+  uint64_t index = this->head.load(std::memory_order_relaxed);
+  Slot &slot = this->slots[index % this->slots.size()];
+
+  slot.layout = this->layout;
+  slot.wallTime = common::Time::GetWallTime();
+  slot.realTime = _world->RealTime();
+  slot.simTime = _world->SimTime();
+  slot.iterations = _world->Iterations();
+
+  // The arrays keep their capacity between captures, so nothing is
+  // allocated once every slot has seen the current layout.
+  slot.modelPoses.resize(this->models.size());
+  slot.modelScales.resize(this->models.size());
+  for (size_t i = 0; i < this->models.size(); ++i)
+  {
+    slot.modelPoses[i] = this->models[i]->WorldPose();
+    slot.modelScales[i] = this->models[i]->Scale();
+  }
+
+  slot.linkPoses.resize(this->links.size());
+  slot.linkLinearVels.resize(this->links.size());
+  slot.linkAngularVels.resize(this->links.size());
+  slot.linkLinearAccels.resize(this->links.size());
+  slot.linkAngularAccels.resize(this->links.size());
+  slot.linkForces.resize(this->links.size());
+  for (size_t i = 0; i < this->links.size(); ++i)
+  {
+    const Link *link = this->links[i];
+    slot.linkPoses[i] = link->WorldPose();
+    slot.linkLinearVels[i] = link->WorldLinearVel();
+    slot.linkAngularVels[i] = link->WorldAngularVel();
+    slot.linkLinearAccels[i] = link->WorldLinearAccel();
+    slot.linkAngularAccels[i] = link->WorldAngularAccel();
+    slot.linkForces[i] = link->WorldForce();
+  }
+
+  slot.lightPoses.resize(this->lights.size());
+  for (size_t i = 0; i < this->lights.size(); ++i)
+    slot.lightPoses[i] = this->lights[i]->WorldPose();
+
+  this->head.store(index + 1, std::memory_order_release);
+  return true;
+}
+
+/////////////////////////////////////////////////
+void WorldStateBuffer::FillModelState(const Slot &_slot, const size_t _index,
+    ModelState &_state) const
+{
+  const Layout &lay = *_slot.layout;
+
+  _state.name = lay.modelNames[_index];
+  _state.wallTime = _slot.wallTime;
+  _state.realTime = _slot.realTime;
+  _state.simTime = _slot.simTime;
+  _state.iterations = _slot.iterations;
+  _state.pose = _slot.modelPoses[_index];
+  _state.scale = _slot.modelScales[_index];
+
+  _state.linkStates.clear();
+  size_t start = lay.modelLinkStart[_index];
+  for (size_t i = start; i < start + lay.modelLinkCount[_index]; ++i)
+  {
+    LinkState &linkState = _state.linkStates[lay.linkNames[i]];
+    linkState.name = lay.linkNames[i];
+    linkState.wallTime = _slot.wallTime;
+    linkState.realTime = _slot.realTime;
+    linkState.simTime = _slot.simTime;
+    linkState.iterations = _slot.iterations;
+    linkState.pose = _slot.linkPoses[i];
+    linkState.velocity.Set(_slot.linkLinearVels[i],
+                           _slot.linkAngularVels[i]);
+    linkState.acceleration.Set(_slot.linkLinearAccels[i],
+                               _slot.linkAngularAccels[i]);
+    linkState.wrench.Set(_slot.linkForces[i],
+                         ignition::math::Quaterniond::Identity);
+  }
+
+  _state.modelStates.clear();
+  for (const auto child : lay.modelChildren[_index])
+  {
+    this->FillModelState(_slot, child,
+        _state.modelStates[lay.modelNames[child]]);
+  }
+}
+
+/////////////////////////////////////////////////
+bool WorldStateBuffer::Pop(WorldState &_state,
+    std::vector<std::string> &_insertions,
+    std::vector<std::string> &_deletions)
+{
+  _insertions.clear();
+  _deletions.clear();
+
+  uint64_t index = this->tail.load(std::memory_order_relaxed);
+  if (index == this->head.load(std::memory_order_acquire))
+    return false;
+
+  Slot &slot = this->slots[index % this->slots.size()];
+  const Layout &lay = *slot.layout;
+
+  _state.name = lay.worldName;
+  _state.wallTime = slot.wallTime;
+  _state.realTime = slot.realTime;
+  _state.simTime = slot.simTime;
+  _state.iterations = slot.iterations;
+  _state.insertions.clear();
+  _state.deletions.clear();
+
+  for (const auto model : lay.topModels)
+  {
+    this->FillModelState(slot, model,
+        _state.modelStates[lay.modelNames[model]]);
+  }
+
+  // Remove models that are not part of this snapshot.
+  for (auto iter = _state.modelStates.begin();
+       iter != _state.modelStates.end();)
+  {
+    if (iter->second.GetIterations() != slot.iterations)
+      _state.modelStates.erase(iter++);
+    else
+      ++iter;
+  }
+
+  _state.lightStates.clear();
+  for (size_t i = 0; i < lay.lightNames.size(); ++i)
+  {
+    LightState &lightState = _state.lightStates[lay.lightNames[i]];
+    lightState.name = lay.lightNames[i];
+    lightState.wallTime = slot.wallTime;
+    lightState.realTime = slot.realTime;
+    lightState.simTime = slot.simTime;
+    lightState.iterations = slot.iterations;
+    lightState.pose = slot.lightPoses[i];
+  }
+
+  // Insertions and deletions can only happen when the layout changes.
+  if (this->prevLayout && this->prevLayout != slot.layout)
+  {
+    std::unordered_set<std::string> prevNames, names;
+    prevNames.insert(this->prevLayout->topModelNames.begin(),
+                     this->prevLayout->topModelNames.end());
+    prevNames.insert(this->prevLayout->lightNames.begin(),
+                     this->prevLayout->lightNames.end());
+
+    names.insert(lay.topModelNames.begin(), lay.topModelNames.end());
+    names.insert(lay.lightNames.begin(), lay.lightNames.end());
+
+    for (const auto &name : this->prevLayout->topModelNames)
+    {
+      if (!names.count(name))
+        _deletions.push_back(name);
+    }
+    for (const auto &name : this->prevLayout->lightNames)
+    {
+      if (!names.count(name))
+        _deletions.push_back(name);
+    }
+
+    for (const auto &name : lay.topModelNames)
+    {
+      if (!prevNames.count(name))
+        _insertions.push_back(name);
+    }
+    for (const auto &name : lay.lightNames)
+    {
+      if (!prevNames.count(name))
+        _insertions.push_back(name);
+    }
+  }
+  this->prevLayout = slot.layout;
+
+  // Release the slot. The layout reference is kept by prevLayout, so the
+  // producer never frees it while it's in use here.
+  slot.layout.reset();
+  this->tail.store(index + 1, std::memory_order_release);
+  return true;
+}
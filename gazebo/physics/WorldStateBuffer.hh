@@ -0,0 +1,220 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_WORLDSTATEBUFFER_HH_
+#define GAZEBO_PHYSICS_WORLDSTATEBUFFER_HH_
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/regex.hpp>
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    class ModelState;
+    class WorldState;
+
+    /// \brief Single producer, single consumer ring of world snapshots.
+    ///
+    /// The physics thread copies model, link and light state into
+    /// preallocated structure of arrays slots with Capture(). The log thread
+    /// turns the oldest slot into a WorldState with Pop(), without touching
+    /// any entity. Names and the model hierarchy live in a separate layout
+    /// that is only rebuilt when the set of entities changes.
+    class GZ_PHYSICS_VISIBLE WorldStateBuffer
+    {
+      /// \brief Constructor.
+      /// \param[in] _capacity Number of snapshots that can be queued.
+      public: explicit WorldStateBuffer(const size_t _capacity = 16);
+
+      /// \brief Copy the current state of the world into the next free slot.
+      /// Must only be called from the physics thread.
+      /// \param[in] _world World to capture.
+      /// \param[in] _entityVersion Counter that changes whenever an entity
+      /// is added to or removed from the world. The layout is rebuilt when
+      /// it differs from the value used by the last capture.
+      /// \param[in] _filter Log record filter, see util::LogRecord::Filter.
+      /// It is matched against model names only when the layout is rebuilt
+      /// or the filter changes, and models that do not pass it are not
+      /// copied at all.
+      /// \return False if the buffer is full, in which case nothing was
+      /// captured.
+      public: bool Capture(const WorldPtr &_world,
+                           const uint64_t _entityVersion,
+                           const std::string &_filter = "");
+
+      /// \brief Fill a world state from the oldest snapshot and release its
+      /// slot. Must only be called from the log thread.
+      /// \param[out] _state State to fill, with the models that passed the
+      /// filter of the capture.
+      /// \param[out] _insertions Names of the top level models and lights
+      /// added since the previous snapshot.
+      /// \param[out] _deletions Names of the top level models and lights
+      /// removed since the previous snapshot.
+      /// \return False if the buffer is empty.
+      public: bool Pop(WorldState &_state,
+                       std::vector<std::string> &_insertions,
+                       std::vector<std::string> &_deletions);
+
+      /// \brief Whether there are no snapshots waiting to be popped.
+      /// \return True if empty.
+      public: bool Empty() const;
+
+      /// \brief Whether every slot holds a snapshot.
+      /// \return True if full.
+      public: bool Full() const;
+
+      /// \brief Names and hierarchy of captured entities. Shared between
+      /// every snapshot taken while the entity set doesn't change.
+      private: class Layout
+      {
+        /// \brief Name of the world.
+        public: std::string worldName;
+
+        /// \brief Names of all models, parents before children.
+        public: std::vector<std::string> modelNames;
+
+        /// \brief Index of the nested models of each model.
+        public: std::vector<std::vector<size_t>> modelChildren;
+
+        /// \brief Index of the first link of each model in the link arrays.
+        public: std::vector<size_t> modelLinkStart;
+
+        /// \brief Number of links of each model.
+        public: std::vector<size_t> modelLinkCount;
+
+        /// \brief Index of the top level models that pass the filter.
+        public: std::vector<size_t> topModels;
+
+        /// \brief Names of all top level models, including the ones left
+        /// out by the filter.
+        public: std::vector<std::string> topModelNames;
+
+        /// \brief Names of all links, grouped by model.
+        public: std::vector<std::string> linkNames;
+
+        /// \brief Names of all lights.
+        public: std::vector<std::string> lightNames;
+      };
+
+      /// \brief One snapshot of the world, stored as one array per field.
+      private: class Slot
+      {
+        /// \brief Layout the arrays are indexed by.
+        public: std::shared_ptr<const Layout> layout;
+
+        /// \brief Wall time of the capture.
+        public: common::Time wallTime;
+
+        /// \brief Real time of the capture.
+        public: common::Time realTime;
+
+        /// \brief Sim time of the capture.
+        public: common::Time simTime;
+
+        /// \brief Iterations of the capture.
+        public: uint64_t iterations = 0;
+
+        /// \brief World pose of each model.
+        public: std::vector<ignition::math::Pose3d> modelPoses;
+
+        /// \brief Scale of each model.
+        public: std::vector<ignition::math::Vector3d> modelScales;
+
+        /// \brief World pose of each link.
+        public: std::vector<ignition::math::Pose3d> linkPoses;
+
+        /// \brief World linear velocity of each link.
+        public: std::vector<ignition::math::Vector3d> linkLinearVels;
+
+        /// \brief World angular velocity of each link.
+        public: std::vector<ignition::math::Vector3d> linkAngularVels;
+
+        /// \brief World linear acceleration of each link.
+        public: std::vector<ignition::math::Vector3d> linkLinearAccels;
+
+        /// \brief World angular acceleration of each link.
+        public: std::vector<ignition::math::Vector3d> linkAngularAccels;
+
+        /// \brief World force on each link.
+        public: std::vector<ignition::math::Vector3d> linkForces;
+
+        /// \brief World pose of each light.
+        public: std::vector<ignition::math::Pose3d> lightPoses;
+      };
+
+      /// \brief Rebuild the layout and the entity lists from the world,
+      /// keeping the models that pass the filter.
+      /// \param[in] _world World to walk.
+      private: void RebuildLayout(const WorldPtr &_world);
+
+      /// \brief Fill a model state, and those of its nested models.
+      /// \param[in] _slot Snapshot to read from.
+      /// \param[in] _index Index of the model in the layout.
+      /// \param[out] _state State to fill.
+      private: void FillModelState(const Slot &_slot, const size_t _index,
+                                   ModelState &_state) const;
+
+      /// \brief Snapshot slots, allocated once.
+      private: std::vector<Slot> slots;
+
+      /// \brief Number of snapshots ever captured. Written by the producer.
+      private: std::atomic<uint64_t> head;
+
+      /// \brief Number of snapshots ever popped. Written by the consumer.
+      private: std::atomic<uint64_t> tail;
+
+      /// \brief Layout used by the next capture. Producer only.
+      private: std::shared_ptr<const Layout> layout;
+
+      /// \brief Entity version the layout was built from. Producer only.
+      private: uint64_t layoutVersion = 0;
+
+      /// \brief Models in layout order. Producer only.
+      private: std::vector<Model *> models;
+
+      /// \brief Links in layout order. Producer only.
+      private: std::vector<Link *> links;
+
+      /// \brief Lights in layout order. Producer only.
+      private: std::vector<Light *> lights;
+
+      /// \brief Filter string the model regex was compiled from. Producer
+      /// only.
+      private: std::string filter;
+
+      /// \brief Whether the filter restricts models. Producer only.
+      private: bool filterModels = false;
+
+      /// \brief Regex for model names built from the filter. Producer only.
+      private: boost::regex filterRegex;
+
+      /// \brief Layout of the last popped snapshot. Consumer only.
+      private: std::shared_ptr<const Layout> prevLayout;
+    };
+  }
+}
+#endif
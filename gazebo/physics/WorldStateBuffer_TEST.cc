@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <string>
+#include <vector>
+
+#include "gazebo/test/ServerFixture.hh"
+#include "test/util.hh"
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/physics/World.hh"
+#include "gazebo/physics/WorldState.hh"
+#include "gazebo/physics/WorldStateBuffer.hh"
+
+using namespace gazebo;
+
+class WorldStateBufferTest : public ServerFixture { };
+
+//////////////////////////////////////////////////
+TEST_F(WorldStateBufferTest, CaptureAndPop)
+{
+  this->Load("worlds/shapes.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  physics::WorldStateBuffer buffer(2);
+  EXPECT_TRUE(buffer.Empty());
+  EXPECT_FALSE(buffer.Full());
+
+  std::vector<std::string> insertions;
+  std::vector<std::string> deletions;
+  physics::WorldState state;
+  EXPECT_FALSE(buffer.Pop(state, insertions, deletions));
+
+  // Fill the buffer
+  EXPECT_TRUE(buffer.Capture(world, 0));
+  world->Step(1);
+  EXPECT_TRUE(buffer.Capture(world, 0));
+  EXPECT_TRUE(buffer.Full());
+  EXPECT_FALSE(buffer.Capture(world, 0));
+
+  // Snapshots come out in capture order, and match a state loaded directly
+  // from the world.
+  physics::WorldState expected(world);
+  EXPECT_TRUE(buffer.Pop(state, insertions, deletions));
+  EXPECT_EQ(state.GetIterations(), expected.GetIterations() - 1);
+  EXPECT_TRUE(insertions.empty());
+  EXPECT_TRUE(deletions.empty());
+
+  EXPECT_TRUE(buffer.Pop(state, insertions, deletions));
+  EXPECT_TRUE(buffer.Empty());
+  EXPECT_EQ(state.GetIterations(), expected.GetIterations());
+  EXPECT_EQ(state.GetModelStateCount(), expected.GetModelStateCount());
+  EXPECT_EQ(state.LightStateCount(), expected.LightStateCount());
+  EXPECT_TRUE((state - expected).IsZero());
+
+  // Only models that match the filter are captured. Changing the filter
+  // rebuilds the layout, but is not reported as an insertion or deletion.
+  EXPECT_TRUE(buffer.Capture(world, 0, "box"));
+  EXPECT_TRUE(buffer.Pop(state, insertions, deletions));
+  EXPECT_EQ(state.GetModelStateCount(), 1u);
+  EXPECT_TRUE(state.HasModelState("box"));
+  EXPECT_TRUE(insertions.empty());
+  EXPECT_TRUE(deletions.empty());
+
+  EXPECT_TRUE(buffer.Capture(world, 0));
+  EXPECT_TRUE(buffer.Pop(state, insertions, deletions));
+  EXPECT_EQ(state.GetModelStateCount(), expected.GetModelStateCount());
+  EXPECT_TRUE(insertions.empty());
+  EXPECT_TRUE(deletions.empty());
+
+  // Removed models are reported once the entity version changes.
+  world->RemoveModel("sphere");
+  EXPECT_TRUE(buffer.Capture(world, 1));
+  EXPECT_TRUE(buffer.Pop(state, insertions, deletions));
+  EXPECT_TRUE(insertions.empty());
+  ASSERT_EQ(deletions.size(), 1u);
+  EXPECT_EQ(deletions[0], "sphere");
+  EXPECT_FALSE(state.HasModelState("sphere"));
+  EXPECT_TRUE(state.HasModelState("box"));
+}
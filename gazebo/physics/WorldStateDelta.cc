@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include "gazebo/physics/WorldState.hh"
+#include "gazebo/physics/WorldStateDelta.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+/////////////////////////////////////////////////
+void WorldStateDelta::SetParameters(const double _keyframePeriod,
+    const double _positionTolerance, const double _orientationTolerance)
+{
+  this->keyframePeriod = _keyframePeriod;
+  this->positionTolerance = _positionTolerance;
+  this->orientationTolerance = _orientationTolerance;
+}
+
+/////////////////////////////////////////////////
+bool WorldStateDelta::Enabled() const
+{
+  return this->keyframePeriod > 0;
+}
+
+/////////////////////////////////////////////////
+void WorldStateDelta::Reset()
+{
+  this->hasKeyframe = false;
+  this->models.clear();
+  this->lights.clear();
+}
+
+/////////////////////////////////////////////////
+bool WorldStateDelta::Reduce(WorldState &_state)
+{
+  if (!this->Enabled())
+    return true;
+
+  const common::Time simTime = _state.GetSimTime();
+
+  // A reset world goes back in time, start over from a full state
+  bool keyframe = !this->hasKeyframe ||
+    simTime < this->keyframeTime ||
+    (simTime - this->keyframeTime).Double() >= this->keyframePeriod;
+
+  if (keyframe)
+  {
+    this->hasKeyframe = true;
+    this->keyframeTime = simTime;
+    this->models.clear();
+    this->lights.clear();
+    for (const auto &model : _state.modelStates)
+      this->models[model.first] = model.second;
+    for (const auto &light : _state.lightStates)
+      this->lights[light.first] = light.second;
+    return true;
+  }
+
+  for (auto iter = _state.modelStates.begin();
+       iter != _state.modelStates.end();)
+  {
+    auto last = this->models.find(iter->first);
+    if (last != this->models.end() && !this->Moved(iter->second, last->second))
+    {
+      iter = _state.modelStates.erase(iter);
+      continue;
+    }
+
+    this->models[iter->first] = iter->second;
+    ++iter;
+  }
+
+  for (auto iter = _state.lightStates.begin();
+       iter != _state.lightStates.end();)
+  {
+    auto last = this->lights.find(iter->first);
+    if (last != this->lights.end() &&
+        !this->Moved(iter->second.Pose(), last->second.Pose()))
+    {
+      iter = _state.lightStates.erase(iter);
+      continue;
+    }
+
+    this->lights[iter->first] = iter->second;
+    ++iter;
+  }
+
+  for (const auto &name : _state.Deletions())
+  {
+    this->models.erase(name);
+    this->lights.erase(name);
+  }
+
+  return !_state.modelStates.empty() || !_state.lightStates.empty() ||
+    !_state.Insertions().empty() || !_state.Deletions().empty();
+}
+
+/////////////////////////////////////////////////
+bool WorldStateDelta::Moved(const ModelState &_state,
+    const ModelState &_last) const
+{
+  if (this->Moved(_state.Pose(), _last.Pose()) ||
+      _state.Scale() != _last.Scale())
+  {
+    return true;
+  }
+
+  const LinkState_M &links = _state.GetLinkStates();
+  const LinkState_M &lastLinks = _last.GetLinkStates();
+  if (links.size() != lastLinks.size())
+    return true;
+
+  for (const auto &link : links)
+  {
+    auto last = lastLinks.find(link.first);
+    if (last == lastLinks.end() ||
+        this->Moved(link.second.Pose(), last->second.Pose()))
+    {
+      return true;
+    }
+  }
+
+  const ModelState_M &nested = _state.NestedModelStates();
+  const ModelState_M &lastNested = _last.NestedModelStates();
+  if (nested.size() != lastNested.size())
+    return true;
+
+  for (const auto &model : nested)
+  {
+    auto last = lastNested.find(model.first);
+    if (last == lastNested.end() || this->Moved(model.second, last->second))
+      return true;
+  }
+
+  return false;
+}
+
+/////////////////////////////////////////////////
+bool WorldStateDelta::Moved(const ignition::math::Pose3d &_pose,
+    const ignition::math::Pose3d &_last) const
+{
+  if (_pose.Pos().Distance(_last.Pos()) > this->positionTolerance)
+    return true;
+
+  // Angle of the rotation between the two orientations
+  const ignition::math::Quaterniond &q1 = _pose.Rot();
+  const ignition::math::Quaterniond &q2 = _last.Rot();
+  double dot = std::abs(q1.W() * q2.W() + q1.X() * q2.X() +
+      q1.Y() * q2.Y() + q1.Z() * q2.Z());
+  double angle = 2.0 * std::acos(std::min(1.0, dot));
+  return angle > this->orientationTolerance;
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GAZEBO_PHYSICS_WORLDSTATEDELTA_HH_
+#define GAZEBO_PHYSICS_WORLDSTATEDELTA_HH_
+
+#include <map>
+#include <string>
+
+#include <ignition/math/Pose3.hh>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/physics/LightState.hh"
+#include "gazebo/physics/ModelState.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    class WorldState;
+
+    /// \brief Reduces recorded world states to what changed.
+    ///
+    /// A full state is kept every keyframe period of sim time. In between,
+    /// a state only keeps the models and lights that moved past the
+    /// position or orientation tolerance since they were last kept. They
+    /// are compared with the last kept value rather than the previous
+    /// state, so a slow drift is still recorded once it adds up. Kept
+    /// models hold absolute values, so playback applies them as is.
+    class GZ_PHYSICS_VISIBLE WorldStateDelta
+    {
+      /// \brief Set the reduction parameters.
+      /// \param[in] _keyframePeriod Sim time in seconds between two full
+      /// states.
+      /// \param[in] _positionTolerance Distance in meters.
+      /// \param[in] _orientationTolerance Angle in radians.
+      public: void SetParameters(const double _keyframePeriod,
+                  const double _positionTolerance,
+                  const double _orientationTolerance);
+
+      /// \brief Check if states are reduced at all.
+      /// \return True if the keyframe period is positive.
+      public: bool Enabled() const;
+
+      /// \brief Forget the last kept values, so the next state is kept in
+      /// full.
+      public: void Reset();
+
+      /// \brief Reduce a state to the models and lights that changed.
+      /// \param[in,out] _state State to reduce.
+      /// \return False if nothing is left to record.
+      public: bool Reduce(WorldState &_state);
+
+      /// \brief Check if a model moved past the tolerances.
+      /// \param[in] _state Current model state.
+      /// \param[in] _last Last kept model state.
+      /// \return True if the model, one of its links or one of its nested
+      /// models moved, or its structure changed.
+      private: bool Moved(const ModelState &_state,
+                   const ModelState &_last) const;
+
+      /// \brief Check if a pose moved past the tolerances.
+      /// \param[in] _pose Current pose.
+      /// \param[in] _last Last kept pose.
+      /// \return True if it moved.
+      private: bool Moved(const ignition::math::Pose3d &_pose,
+                   const ignition::math::Pose3d &_last) const;
+
+      /// \brief Sim time between two full states.
+      private: double keyframePeriod = -1;
+
+      /// \brief Position tolerance.
+      private: double positionTolerance = 0;
+
+      /// \brief Orientation tolerance.
+      private: double orientationTolerance = 0;
+
+      /// \brief True once a full state was kept.
+      private: bool hasKeyframe = false;
+
+      /// \brief Sim time of the last full state.
+      private: common::Time keyframeTime;
+
+      /// \brief Last kept state of each model.
+      private: std::map<std::string, ModelState> models;
+
+      /// \brief Last kept state of each light.
+      private: std::map<std::string, LightState> lights;
+    };
+  }
+}
+#endif
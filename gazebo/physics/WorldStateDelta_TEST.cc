@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+
+#include <sdf/sdf.hh>
+
+#include "test/util.hh"
+#include "gazebo/physics/WorldState.hh"
+#include "gazebo/physics/WorldStateDelta.hh"
+
+using namespace gazebo;
+
+class WorldStateDeltaTest : public gazebo::testing::AutoLogFixture { };
+
+//////////////////////////////////////////////////
+/// \brief Make a world state with two models and a light.
+/// \param[in] _sec Sim time seconds.
+/// \param[in] _x X position of the box link.
+/// \param[in] _yaw Yaw of the sphere model.
+/// \return The state.
+static physics::WorldState State(const int _sec, const double _x,
+    const double _yaw)
+{
+  std::ostringstream sdfStr;
+  sdfStr << "<sdf version ='" << SDF_VERSION << "'>"
+    << "<world name='default'>"
+    << "<state world_name='default'>"
+    << "<sim_time>" << _sec << " 0</sim_time>"
+    << "<model name='box'>"
+    << "  <pose>0 0 0 0 0 0</pose>"
+    << "  <link name='link'>"
+    << "    <pose>" << _x << " 0 0.5 0 0 0</pose>"
+    << "  </link>"
+    << "</model>"
+    << "<model name='sphere'>"
+    << "  <pose>1 0 0 0 0 " << _yaw << "</pose>"
+    << "</model>"
+    << "<light name='sun'>"
+    << "  <pose>0 0 10 0 0 0</pose>"
+    << "</light>"
+    << "</state>"
+    << "</world>"
+    << "</sdf>";
+
+  sdf::SDFPtr worldSDF(new sdf::SDF);
+  worldSDF->SetFromString(sdfStr.str());
+  return physics::WorldState(
+      worldSDF->Root()->GetElement("world")->GetElement("state"));
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldStateDeltaTest, Reduce)
+{
+  physics::WorldStateDelta delta;
+  delta.SetParameters(10, 0.01, 0.01);
+
+  // The first state is kept in full
+  physics::WorldState state = State(1, 0, 0);
+  EXPECT_TRUE(delta.Reduce(state));
+  EXPECT_EQ(2u, state.GetModelStateCount());
+  EXPECT_EQ(1u, state.LightStateCount());
+
+  // Nothing moved past the tolerances
+  state = State(2, 0.005, 0.005);
+  EXPECT_FALSE(delta.Reduce(state));
+  EXPECT_EQ(0u, state.GetModelStateCount());
+  EXPECT_EQ(0u, state.LightStateCount());
+
+  // Small moves add up against the last kept value
+  state = State(3, 0.011, 0.005);
+  EXPECT_TRUE(delta.Reduce(state));
+  EXPECT_EQ(1u, state.GetModelStateCount());
+  EXPECT_TRUE(state.HasModelState("box"));
+  EXPECT_DOUBLE_EQ(0.011,
+      state.GetModelState("box").GetLinkState("link").Pose().Pos().X());
+
+  state = State(4, 0.011, 0.02);
+  EXPECT_TRUE(delta.Reduce(state));
+  EXPECT_EQ(1u, state.GetModelStateCount());
+  EXPECT_TRUE(state.HasModelState("sphere"));
+
+  // A full state every keyframe period
+  state = State(14, 0.011, 0.02);
+  EXPECT_TRUE(delta.Reduce(state));
+  EXPECT_EQ(2u, state.GetModelStateCount());
+  EXPECT_EQ(1u, state.LightStateCount());
+
+  // Going back in time starts over from a full state
+  state = State(1, 0.011, 0.02);
+  EXPECT_TRUE(delta.Reduce(state));
+  EXPECT_EQ(2u, state.GetModelStateCount());
+
+  // And so does a reset
+  delta.Reset();
+  state = State(2, 0.011, 0.02);
+  EXPECT_TRUE(delta.Reduce(state));
+  EXPECT_EQ(2u, state.GetModelStateCount());
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldStateDeltaTest, Disabled)
+{
+  // Without a keyframe period every state is kept in full
+  physics::WorldStateDelta delta;
+  physics::WorldState state = State(1, 0, 0);
+  EXPECT_TRUE(delta.Reduce(state));
+  state = State(2, 0, 0);
+  EXPECT_TRUE(delta.Reduce(state));
+  EXPECT_EQ(2u, state.GetModelStateCount());
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -15,9 +15,29 @@
  *
 */
 
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string>
+
+#include <ignition/transport.hh>
+
+#include "gazebo/common/Events.hh"
+#include "gazebo/physics/CollisionQuery.hh"
+#include "gazebo/physics/Link.hh"
+#include "gazebo/physics/LinkKinematicsCache.hh"
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/PhysicsEngine.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/physics/ProximityIndex.hh"
+#include "gazebo/physics/SleepManager.hh"
+#include "gazebo/physics/SpatialIndex.hh"
 #include "gazebo/physics/World.hh"
+#include "gazebo/physics/WorldSnapshot.hh"
 #include "gazebo/test/ServerFixture.hh"
+#include "gazebo/transport/ShmClock.hh"
 #include "test/util.hh"
 
 using namespace gazebo;
@@ -100,6 +120,80 @@ TEST_F(WorldTest, UniqueModelName)
   EXPECT_EQ(world->UniqueModelName(modelName), modelName + "_1");
 }
 
+//////////////////////////////////////////////////
+TEST_F(WorldTest, InsertModels)
+{
+  this->Load("worlds/blank.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  msgs::Model msg;
+  msg.set_name("box");
+  msg.add_link();
+  msg.mutable_link(0)->set_name("l");
+  sdf::ElementPtr modelTemplate = msgs::ModelToSDF(msg);
+
+  // Clones of one template, two of them with the same name
+  std::vector<sdf::ElementPtr> models;
+  for (int i = 0; i < 3; ++i)
+  {
+    sdf::ElementPtr clone = modelTemplate->Clone();
+    clone->GetAttribute("name")->Set("box_" + std::to_string(i / 2));
+    clone->GetElement("pose")->Set(ignition::math::Pose3d(i, 0, 0, 0, 0, 0));
+    models.push_back(clone);
+  }
+  world->InsertModels(models);
+
+  int sleep = 0;
+  int maxSleep = 10;
+  while (sleep < maxSleep && world->ModelCount() < 3u)
+  {
+    world->Step(1);
+    common::Time::MSleep(100);
+    sleep++;
+  }
+  EXPECT_EQ(3u, world->ModelCount());
+  ASSERT_TRUE(world->ModelByName("box_0") != nullptr);
+  ASSERT_TRUE(world->ModelByName("box_0_0") != nullptr);
+  ASSERT_TRUE(world->ModelByName("box_1") != nullptr);
+  EXPECT_DOUBLE_EQ(2.0, world->ModelByName("box_1")->WorldPose().Pos().X());
+}
+
+//////////////////////////////////////////////////
+/// \brief Test that factory messages parsed in the background are still
+/// applied in the order they were sent.
+TEST_F(WorldTest, FactoryOrder)
+{
+  this->Load("worlds/blank.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  msgs::Model msg;
+  msg.set_name("box");
+  msgs::AddBoxLink(msg, 1.0, ignition::math::Vector3d::One);
+
+  msgs::Factory spawnMsg;
+  spawnMsg.set_sdf("<sdf version='" + std::string(SDF_VERSION) + "'>"
+      + msgs::ModelToSDF(msg)->ToString("") + "</sdf>");
+  this->factoryPub->Publish(spawnMsg);
+
+  // Needs no parsing, but must wait for the box
+  msgs::Factory cloneMsg;
+  cloneMsg.set_clone_model_name("box");
+  this->factoryPub->Publish(cloneMsg);
+
+  int sleep = 0;
+  int maxSleep = 30;
+  while (sleep < maxSleep && !world->ModelByName("box_clone"))
+  {
+    common::Time::MSleep(100);
+    sleep++;
+  }
+  EXPECT_TRUE(world->ModelByName("box") != nullptr);
+  EXPECT_TRUE(world->ModelByName("box_clone") != nullptr);
+  EXPECT_EQ(world->ModelCount(), 2u);
+}
+
 //////////////////////////////////////////////////
 /// \brief Test publishing a factory message to edit a model.
 TEST_F(WorldTest, EditName)
@@ -216,6 +310,652 @@ TEST_F(WorldTest, Stop)
   EXPECT_TRUE(world->Running());
 }
 
+//////////////////////////////////////////////////
+/// \brief Check that models updated in parallel still settle on the ground.
+TEST_F(WorldTest, ParallelModelUpdate)
+{
+  this->Load("test/worlds/parallel_model_update.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  // 4 boxes plus the ground plane
+  EXPECT_EQ(5u, world->ModelCount());
+
+  world->Step(2000);
+
+  for (unsigned int i = 0; i < 4; ++i)
+  {
+    auto model = world->ModelByName("box_" + std::to_string(i));
+    ASSERT_NE(nullptr, model);
+    EXPECT_NEAR(0.5, model->WorldPose().Pos().Z(), 1e-2);
+    EXPECT_NEAR(2.0 * i, model->WorldPose().Pos().X(), 1e-2);
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Step a world running as fast as possible and check that
+/// World::Step(unsigned int) returns once all steps have been taken.
+TEST_F(WorldTest, FastStep)
+{
+  this->Load("worlds/blank.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  auto physics = world->Physics();
+  ASSERT_NE(nullptr, physics);
+  physics->SetRealTimeUpdateRate(0.0);
+
+  const uint32_t start = world->Iterations();
+  world->Step(500);
+  EXPECT_EQ(start + 500u, world->Iterations());
+
+  world->Step(1);
+  EXPECT_EQ(start + 501u, world->Iterations());
+  EXPECT_TRUE(world->IsPaused());
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldTest, StepBatch)
+{
+  this->Load("worlds/shapes.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  int beginCount = 0;
+  int endCount = 0;
+  event::ConnectionPtr beginConn = event::Events::ConnectWorldUpdateBegin(
+      [&beginCount](const common::UpdateInfo &)
+      {
+        ++beginCount;
+      });
+  event::ConnectionPtr endConn = event::Events::ConnectWorldUpdateEnd(
+      [&endCount]()
+      {
+        ++endCount;
+      });
+
+  // Without flags every iteration fires the update events
+  uint32_t start = world->Iterations();
+  world->StepBatch(100);
+  EXPECT_EQ(start + 100u, world->Iterations());
+  EXPECT_EQ(100, beginCount);
+  EXPECT_EQ(100, endCount);
+  EXPECT_TRUE(world->IsPaused());
+
+  // Suppressed events are not fired, but physics still runs
+  auto box = world->ModelByName("box");
+  ASSERT_NE(nullptr, box);
+  box->SetWorldPose(ignition::math::Pose3d(0, 0, 5, 0, 0, 0));
+
+  start = world->Iterations();
+  world->StepBatch(100, physics::World::STEP_BATCH_NO_CALLBACKS);
+  EXPECT_EQ(start + 100u, world->Iterations());
+  EXPECT_EQ(100, beginCount);
+  EXPECT_EQ(100, endCount);
+  EXPECT_LT(box->WorldPose().Pos().Z(), 5.0);
+
+  // Regular stepping is not affected by the previous batch
+  world->Step(1);
+  EXPECT_EQ(start + 101u, world->Iterations());
+  EXPECT_EQ(101, beginCount);
+  EXPECT_EQ(101, endCount);
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldTest, ShmClock)
+{
+  this->Load("worlds/shapes.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  if (!transport::ShmClock::Enabled())
+    return;
+
+  transport::ShmClock clock;
+  ASSERT_TRUE(clock.Open(transport::ShmClock::SegmentName(world->Name())));
+
+  world->Step(100);
+  common::Time simTime;
+  uint64_t iterations = 0;
+  bool paused = false;
+  EXPECT_TRUE(clock.Read(simTime, iterations, paused));
+  EXPECT_EQ(world->SimTime(), simTime);
+  EXPECT_EQ(world->Iterations(), iterations);
+  EXPECT_TRUE(paused);
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldTest, Snapshot)
+{
+  this->Load("worlds/shapes.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  physics::WorldSnapshot snapshot;
+  EXPECT_FALSE(snapshot.Valid());
+  EXPECT_FALSE(world->RestoreSnapshot(snapshot));
+
+  auto box = world->ModelByName("box");
+  ASSERT_NE(nullptr, box);
+  box->SetWorldPose(ignition::math::Pose3d(0, 0, 5, 0, 0, 0));
+  world->Step(10);
+
+  world->SaveSnapshot(snapshot);
+  EXPECT_TRUE(snapshot.Valid());
+  EXPECT_EQ(world->SimTime(), snapshot.SimTime());
+  const auto pose = box->WorldPose();
+  const auto vel = box->WorldLinearVel();
+  const uint32_t iterations = world->Iterations();
+
+  // The box keeps falling, then goes back to where it was
+  for (int episode = 0; episode < 2; ++episode)
+  {
+    world->Step(50);
+    EXPECT_LT(box->WorldPose().Pos().Z(), pose.Pos().Z());
+
+    EXPECT_TRUE(world->RestoreSnapshot(snapshot));
+    EXPECT_EQ(snapshot.SimTime(), world->SimTime());
+    EXPECT_EQ(iterations, world->Iterations());
+    EXPECT_EQ(pose, box->WorldPose());
+    EXPECT_EQ(vel, box->WorldLinearVel());
+  }
+
+  // Adding a model invalidates the snapshot
+  msgs::Model msg;
+  msg.set_name("extra");
+  msgs::AddBoxLink(msg, 1.0, ignition::math::Vector3d::One);
+  world->InsertModels({msgs::ModelToSDF(msg)});
+  for (int sleep = 0; sleep < 10 && !world->ModelByName("extra"); ++sleep)
+  {
+    world->Step(1);
+    common::Time::MSleep(100);
+  }
+  ASSERT_NE(nullptr, world->ModelByName("extra"));
+  EXPECT_FALSE(world->RestoreSnapshot(snapshot));
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldTest, SpatialIndex)
+{
+  this->Load("worlds/shapes.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  // The index is disabled by default
+  EXPECT_FALSE(world->SpatialIndexEnabled());
+  const physics::SpatialIndex &index = world->ModelSpatialIndex();
+  world->Step(1);
+  EXPECT_EQ(0u, index.Size());
+
+  world->SetSpatialIndexEnabled(true);
+  EXPECT_TRUE(world->SpatialIndexEnabled());
+  world->Step(1);
+  EXPECT_EQ(world->ModelCount(), index.Size());
+
+  auto box = world->ModelByName("box");
+  ASSERT_NE(nullptr, box);
+  ignition::math::AxisAlignedBox aabb;
+  EXPECT_TRUE(index.BoundingBox(box.get(), aabb));
+  EXPECT_EQ(box->BoundingBox(), aabb);
+
+  // Point query on top of the box also finds the ground plane
+  auto models = index.ModelsAtPoint(ignition::math::Vector3d(0, 0, 0.5));
+  EXPECT_NE(models.end(), std::find(models.begin(), models.end(), box));
+  EXPECT_EQ(models.end(), std::find(models.begin(), models.end(),
+      world->ModelByName("sphere")));
+
+  // Box query around the sphere and the box
+  models = index.ModelsInBox(ignition::math::AxisAlignedBox(
+      ignition::math::Vector3d(-0.1, 0.1, 0.1),
+      ignition::math::Vector3d(0.1, 1.6, 0.9)));
+  EXPECT_NE(models.end(), std::find(models.begin(), models.end(), box));
+  EXPECT_NE(models.end(), std::find(models.begin(), models.end(),
+      world->ModelByName("sphere")));
+  EXPECT_EQ(models.end(), std::find(models.begin(), models.end(),
+      world->ModelByName("cylinder")));
+
+  // Ray query far away from every model only hits the ground plane
+  models = index.ModelsOnRay(ignition::math::Vector3d(50, 50, 10),
+      ignition::math::Vector3d(50, 50, -10));
+  ASSERT_EQ(1u, models.size());
+  EXPECT_EQ("ground_plane", models[0]->GetName());
+
+  // The index matches the ray test below a point
+  EXPECT_EQ(box, world->ModelBelowPoint(ignition::math::Vector3d(0, 0, 5)));
+  EXPECT_EQ("ground_plane",
+      world->ModelBelowPoint(ignition::math::Vector3d(50, 50, 5))->GetName());
+
+  // Moving a model updates its cells
+  box->SetWorldPose(ignition::math::Pose3d(50, 50, 0.5, 0, 0, 0));
+  world->Step(1);
+  models = index.ModelsAtPoint(ignition::math::Vector3d(50, 50, 0.5));
+  EXPECT_NE(models.end(), std::find(models.begin(), models.end(), box));
+  models = index.ModelsAtPoint(ignition::math::Vector3d(0, 0, 0.5));
+  EXPECT_EQ(models.end(), std::find(models.begin(), models.end(), box));
+  EXPECT_EQ(box, world->ModelBelowPoint(ignition::math::Vector3d(50, 50, 5)));
+
+  // Removed models are dropped
+  world->RemoveModel("box");
+  world->Step(1);
+  EXPECT_EQ(world->ModelCount(), index.Size());
+  EXPECT_FALSE(index.BoundingBox(box.get(), aabb));
+
+  world->SetSpatialIndexEnabled(false);
+  EXPECT_EQ(0u, index.Size());
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldTest, ProximityIndex)
+{
+  this->Load("worlds/shapes.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  // The index is disabled by default
+  EXPECT_FALSE(world->ProximityIndexEnabled());
+  const physics::ProximityIndex &index = world->ModelProximityIndex();
+  world->Step(1);
+  EXPECT_FALSE(index.Built());
+  EXPECT_EQ(0u, index.Size());
+
+  world->SetProximityIndexEnabled(true);
+  EXPECT_TRUE(world->ProximityIndexEnabled());
+  world->Step(1);
+  EXPECT_TRUE(index.Built());
+  EXPECT_EQ(world->ModelCount(), index.Size());
+
+  auto box = world->ModelByName("box");
+  ASSERT_NE(nullptr, box);
+  ignition::math::Vector3d center;
+  double radius;
+  EXPECT_TRUE(index.BoundingSphere(box.get(), center, radius));
+  EXPECT_EQ(box->WorldPose().Pos(), center);
+  EXPECT_NEAR(std::sqrt(0.75), radius, 1e-2);
+
+  // Nearest models to a point beside the sphere
+  auto models = index.NearestModels(ignition::math::Vector3d(0, 2, 0.5), 2);
+  ASSERT_EQ(2u, models.size());
+  EXPECT_EQ("sphere", models[0]->GetName());
+  EXPECT_EQ("box", models[1]->GetName());
+
+  // Radius query reaching the surface of the sphere, the ground plane is
+  // always in range
+  models = index.ModelsInRadius(ignition::math::Vector3d(0, 3, 0.5), 1.2);
+  ASSERT_EQ(2u, models.size());
+  EXPECT_EQ("sphere", models[0]->GetName());
+  EXPECT_EQ("ground_plane", models[1]->GetName());
+
+  // Same nearest query through the service
+  ignition::transport::Node node;
+  msgs::ProximityRequest req;
+  msgs::Set(req.mutable_point(), ignition::math::Vector3d(0, 2, 0.5));
+  req.set_k(1);
+  msgs::ProximityResponse rep;
+  bool ok = false;
+  EXPECT_TRUE(node.Request("/world/default/proximity", req, 5000u, rep, ok));
+  EXPECT_TRUE(ok);
+  ASSERT_EQ(1, rep.model_size());
+  EXPECT_EQ("sphere", rep.model(0));
+  EXPECT_NEAR(0.5, rep.distance(0), 1e-2);
+
+  // Moving a model updates its position
+  box->SetWorldPose(ignition::math::Pose3d(50, 50, 0.5, 0, 0, 0));
+  world->Step(1);
+  models = index.NearestModels(ignition::math::Vector3d(50, 50, 0), 1);
+  ASSERT_EQ(1u, models.size());
+  EXPECT_EQ(box, models[0]);
+
+  // Removed models are dropped
+  world->RemoveModel("box");
+  world->Step(1);
+  EXPECT_EQ(world->ModelCount(), index.Size());
+  EXPECT_FALSE(index.BoundingSphere(box.get(), center, radius));
+
+  world->SetProximityIndexEnabled(false);
+  EXPECT_EQ(0u, index.Size());
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldTest, AutoSleep)
+{
+  this->Load("test/worlds/parallel_model_update.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  physics::SleepManagerPtr sleepManager = world->SleepMgr();
+  ASSERT_NE(nullptr, sleepManager);
+  EXPECT_FALSE(sleepManager->Enabled());
+
+  sleepManager->SetEnabled(true);
+  sleepManager->SetTimeThreshold(0.2);
+  EXPECT_TRUE(sleepManager->Enabled());
+  EXPECT_DOUBLE_EQ(0.2, sleepManager->TimeThreshold());
+
+  // The boxes fall onto the ground plane and come to rest
+  world->Step(2000);
+  EXPECT_EQ(4u, sleepManager->SleepingModelCount());
+
+  auto box = world->ModelByName("box_0");
+  ASSERT_NE(nullptr, box);
+  EXPECT_TRUE(sleepManager->IsSleeping(box.get()));
+
+  // Setting the pose wakes the model up, and it falls asleep again once it
+  // has landed
+  box->SetWorldPose(ignition::math::Pose3d(0, 0, 2, 0, 0, 0));
+  world->Step(1);
+  EXPECT_FALSE(sleepManager->IsSleeping(box.get()));
+  EXPECT_EQ(3u, sleepManager->SleepingModelCount());
+  world->Step(100);
+  EXPECT_LT(box->WorldPose().Pos().Z(), 2.0);
+
+  world->Step(2000);
+  EXPECT_TRUE(sleepManager->IsSleeping(box.get()));
+  EXPECT_NEAR(0.5, box->WorldPose().Pos().Z(), 1e-2);
+
+  // Disabling the manager wakes everything up
+  sleepManager->SetEnabled(false);
+  world->Step(1);
+  EXPECT_EQ(0u, sleepManager->SleepingModelCount());
+  EXPECT_FALSE(sleepManager->IsSleeping(box.get()));
+}
+
+//////////////////////////////////////////////////
+/// \brief Check lookups that go through the world's scoped name index.
+TEST_F(WorldTest, ScopedNameIndex)
+{
+  this->Load("test/worlds/deeply_nested_models.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  // Scoped names are resolved through the index
+  const std::string linkName = "model_00::model_01::link_01";
+  auto base = world->BaseByName(linkName);
+  ASSERT_NE(nullptr, base);
+  EXPECT_EQ(linkName, base->GetScopedName());
+  EXPECT_EQ(base, world->_BaseByScopedName(linkName));
+
+  // Plain names fall back to searching the tree
+  auto nested = world->ModelByName("model_01");
+  ASSERT_NE(nullptr, nested);
+  EXPECT_EQ("model_00::model_01", nested->GetScopedName());
+
+  // Model lookups accept both relative and scoped names
+  auto link = nested->GetLink("link_01");
+  ASSERT_NE(nullptr, link);
+  EXPECT_EQ(base, link);
+  EXPECT_EQ(link, nested->GetLink(linkName));
+  EXPECT_EQ(nullptr, nested->GetLink("link_00"));
+  EXPECT_EQ(nested, world->ModelByName("model_00")->NestedModel("model_01"));
+
+  // Removing a model removes its entities from the index
+  world->RemoveModel("model_00");
+  EXPECT_EQ(nullptr, world->_BaseByScopedName(linkName));
+  EXPECT_EQ(nullptr, world->BaseByName(linkName));
+  EXPECT_EQ(nullptr, world->ModelByName("model_00"));
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldTest, LinkKinematicsCache)
+{
+  this->Load("worlds/shapes.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  // The cache is disabled by default
+  EXPECT_FALSE(world->LinkKinematicsCacheEnabled());
+  world->Step(1);
+  EXPECT_EQ(0u, world->LinkKinematics().Size());
+
+  world->SetLinkKinematicsCacheEnabled(true);
+  EXPECT_TRUE(world->LinkKinematicsCacheEnabled());
+  world->Step(10);
+
+  const physics::LinkKinematicsCache &cache = world->LinkKinematics();
+  size_t linkCount = 0;
+  for (const auto &model : world->Models())
+  {
+    for (const auto &link : model->GetLinks())
+    {
+      size_t index;
+      ASSERT_TRUE(cache.Index(link->GetId(), index));
+      EXPECT_EQ(link->GetId(), cache.Ids()[index]);
+      EXPECT_EQ(link->WorldPose(), cache.Poses()[index]);
+      EXPECT_EQ(link->WorldLinearVel(), cache.LinearVels()[index]);
+      EXPECT_EQ(link->WorldAngularVel(), cache.AngularVels()[index]);
+      ++linkCount;
+    }
+  }
+  EXPECT_EQ(linkCount, cache.Size());
+
+  size_t iterCount = 0;
+  for (const auto &entry : cache)
+  {
+    size_t index;
+    EXPECT_TRUE(cache.Index(entry.Id(), index));
+    EXPECT_EQ(index, iterCount);
+    ++iterCount;
+  }
+  EXPECT_EQ(linkCount, iterCount);
+
+  // Removed links are dropped on the next update
+  world->RemoveModel("box");
+  world->Step(1);
+  EXPECT_EQ(linkCount - 1, cache.Size());
+
+  world->SetLinkKinematicsCacheEnabled(false);
+  EXPECT_EQ(0u, cache.Size());
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldTest, CollisionQuery)
+{
+  this->Load("worlds/shapes.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  physics::CollisionQuery &query = world->CollisionQueries();
+
+  // Ray through the side of the box
+  auto future = query.Ray(ignition::math::Vector3d(-5, 0, 0.5),
+      ignition::math::Vector3d(5, 0, 0.5));
+  world->Step(1);
+  auto result = future.get();
+  ASSERT_EQ(1u, result.hits.size());
+  EXPECT_EQ("box::link::collision", result.hits[0].collision);
+  EXPECT_NEAR(4.5, result.hits[0].distance, 1e-3);
+  EXPECT_NEAR(-0.5, result.hits[0].point.X(), 1e-3);
+  EXPECT_NEAR(-1.0, result.hits[0].normal.X(), 1e-3);
+
+  // Ray down through the sphere, skipping it, hits the ground
+  result = query.Ray(ignition::math::Vector3d(0, 1.5, 5),
+      ignition::math::Vector3d(0, 1.5, -1), "sphere").get();
+  ASSERT_EQ(1u, result.hits.size());
+  EXPECT_EQ("ground_plane::link::collision", result.hits[0].collision);
+  EXPECT_NEAR(5.0, result.hits[0].distance, 1e-3);
+
+  msgs::Geometry sphere;
+  sphere.set_type(msgs::Geometry::SPHERE);
+  sphere.mutable_sphere()->set_radius(0.3);
+
+  // Sphere between the box and the sphere model touches both
+  result = query.Overlap(sphere, ignition::math::Pose3d(0, 0.75, 0.5, 0, 0, 0),
+      "ground_plane").get();
+  std::set<std::string> names;
+  for (auto const &hit : result.hits)
+    names.insert(hit.collision);
+  EXPECT_EQ(2u, names.size());
+  EXPECT_EQ(1u, names.count("box::link::collision"));
+  EXPECT_EQ(1u, names.count("sphere::link::collision"));
+
+  // Closest collision to a sphere above the box
+  result = query.Closest(sphere, ignition::math::Pose3d(0, 0, 2, 0, 0, 0),
+      5, "ground_plane").get();
+  ASSERT_EQ(1u, result.hits.size());
+  EXPECT_EQ("box::link::collision", result.hits[0].collision);
+  EXPECT_NEAR(0.7, result.hits[0].distance, 1e-2);
+  EXPECT_NEAR(1.0, result.hits[0].point.Z(), 1e-2);
+
+  // Sphere dropped onto the box
+  result = query.Sweep(sphere, ignition::math::Pose3d(0, 0, 3, 0, 0, 0),
+      ignition::math::Pose3d(0, 0, 0.5, 0, 0, 0)).get();
+  ASSERT_EQ(1u, result.hits.size());
+  EXPECT_EQ("box::link::collision", result.hits[0].collision);
+  EXPECT_NEAR(1.7, result.hits[0].distance, 1e-2);
+  EXPECT_EQ(world->SimTime(), result.time);
+
+  // Same ray through the service
+  ignition::transport::Node node;
+  msgs::CollisionQueryRequest req;
+  req.set_type(msgs::CollisionQueryRequest::RAY);
+  msgs::Set(req.mutable_start(), ignition::math::Vector3d(-5, 0, 0.5));
+  msgs::Set(req.mutable_end(), ignition::math::Vector3d(5, 0, 0.5));
+  msgs::CollisionQueryResponse rep;
+  bool ok = false;
+  EXPECT_TRUE(node.Request("/world/default/collision_query", req, 5000u,
+      rep, ok));
+  EXPECT_TRUE(ok);
+  ASSERT_EQ(1, rep.hit_size());
+  EXPECT_EQ("box::link::collision", rep.hit(0).collision());
+  EXPECT_NEAR(4.5, rep.hit(0).distance(), 1e-3);
+
+  // Moving the box is seen by the next query
+  auto box = world->ModelByName("box");
+  ASSERT_NE(nullptr, box);
+  box->SetWorldPose(ignition::math::Pose3d(0, 0, 5, 0, 0, 0));
+  result = query.Ray(ignition::math::Vector3d(-5, 0, 0.5),
+      ignition::math::Vector3d(5, 0, 0.5)).get();
+  EXPECT_TRUE(result.hits.empty());
+}
+
+//////////////////////////////////////////////////
+/// \brief Protects g_jointStatesMsg.
+static std::mutex g_jointStatesMutex;
+
+/// \brief Last message received on ~/joint_states.
+static msgs::JointStates g_jointStatesMsg;
+
+/// \brief Number of messages received on ~/joint_states.
+static int g_jointStatesCount = 0;
+
+//////////////////////////////////////////////////
+void OnJointStates(ConstJointStatesPtr &_msg)
+{
+  std::lock_guard<std::mutex> lock(g_jointStatesMutex);
+  g_jointStatesMsg.CopyFrom(*_msg);
+  ++g_jointStatesCount;
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldTest, JointStates)
+{
+  this->Load("worlds/empty.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+  world->SetGravity(ignition::math::Vector3d::Zero);
+
+  // Floating chain of three links and two hinges
+  std::ostringstream sdfStr;
+  sdfStr << "<sdf version='" << SDF_VERSION << "'>"
+    << "<model name='chain'>"
+    << "  <pose>0 0 2 0 0 0</pose>";
+  for (int i = 0; i < 3; ++i)
+  {
+    sdfStr << "<link name='link_" << i << "'>"
+      << "  <pose>" << 0.5 * i << " 0 0 0 0 0</pose>"
+      << "  <collision name='collision'>"
+      << "    <geometry><sphere><radius>0.1</radius></sphere></geometry>"
+      << "  </collision>"
+      << "</link>";
+  }
+  for (int i = 0; i < 2; ++i)
+  {
+    sdfStr << "<joint name='joint_" << i << "' type='revolute'>"
+      << "  <parent>link_" << i << "</parent>"
+      << "  <child>link_" << i + 1 << "</child>"
+      << "  <axis><xyz>0 0 1</xyz></axis>"
+      << "</joint>";
+  }
+  sdfStr << "</model>"
+    << "</sdf>";
+  world->InsertModelString(sdfStr.str());
+
+  int sleep = 0;
+  while (!world->ModelByName("chain") && sleep++ < 100)
+  {
+    world->Step(1);
+    common::Time::MSleep(10);
+  }
+  auto model = world->ModelByName("chain");
+  ASSERT_NE(nullptr, model);
+  EXPECT_TRUE(model->SetJointStates({0.3, -0.2}, {}));
+
+  transport::NodePtr node(new transport::Node());
+  node->Init();
+  auto sub = node->Subscribe("~/joint_states", &OnJointStates);
+
+  // The topic is throttled on wall time, keep stepping until a message
+  // with the chain arrives
+  sleep = 0;
+  while (sleep++ < 100)
+  {
+    world->Step(1);
+    common::Time::MSleep(20);
+    std::lock_guard<std::mutex> lock(g_jointStatesMutex);
+    if (g_jointStatesCount > 0 && g_jointStatesMsg.model_size() > 0)
+      break;
+  }
+
+  std::lock_guard<std::mutex> lock(g_jointStatesMutex);
+  ASSERT_GT(g_jointStatesCount, 0);
+
+  // Only models with joints are sent, the ground plane has none
+  ASSERT_EQ(1, g_jointStatesMsg.model_size());
+  EXPECT_EQ("chain", g_jointStatesMsg.model(0));
+  ASSERT_EQ(1, g_jointStatesMsg.count_size());
+  EXPECT_EQ(2u, g_jointStatesMsg.count(0));
+  ASSERT_EQ(2, g_jointStatesMsg.position_size());
+  ASSERT_EQ(2, g_jointStatesMsg.velocity_size());
+  ASSERT_EQ(2, g_jointStatesMsg.effort_size());
+  EXPECT_NEAR(0.3, g_jointStatesMsg.position(0), 1e-2);
+  EXPECT_NEAR(-0.2, g_jointStatesMsg.position(1), 1e-2);
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldTest, SetModelPoses)
+{
+  this->Load("worlds/shapes.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  auto box = world->ModelByName("box");
+  auto sphere = world->ModelByName("sphere");
+  ASSERT_NE(nullptr, box);
+  ASSERT_NE(nullptr, sphere);
+
+  const ignition::math::Pose3d boxPose(1, 2, 3, 0, 0, 0.5);
+  const ignition::math::Pose3d spherePose(-4, 5, 6, 0, 0.2, 0);
+  world->SetModelPoses({{box, boxPose}, {nullptr, boxPose},
+      {sphere, spherePose}});
+
+  // Same result as setting the poses one at a time
+  EXPECT_EQ(boxPose, box->WorldPose());
+  EXPECT_EQ(spherePose, sphere->WorldPose());
+  auto link = box->GetLink("link");
+  ASSERT_NE(nullptr, link);
+  EXPECT_EQ(link->RelativePose() + boxPose, link->WorldPose());
+  auto collision = link->GetCollision("collision");
+  ASSERT_NE(nullptr, collision);
+  EXPECT_EQ(collision->RelativePose() + link->WorldPose(),
+      collision->WorldPose());
+
+  // The physics engine was told about the new poses
+  world->Step(1);
+  EXPECT_NEAR(boxPose.Pos().X(), box->WorldPose().Pos().X(), 1e-3);
+  EXPECT_NEAR(boxPose.Pos().Y(), box->WorldPose().Pos().Y(), 1e-3);
+  EXPECT_NEAR(spherePose.Pos().X(), sphere->WorldPose().Pos().X(), 1e-3);
+  EXPECT_NEAR(spherePose.Pos().Y(), sphere->WorldPose().Pos().Y(), 1e-3);
+}
+
 //////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -164,9 +164,8 @@ void BulletLink::Init()
   this->rigidLink->setFriction(0.5*(hackMu1 + hackMu2));  // Hack
 
   // Setup motion clamping to prevent objects from moving too fast.
-  // this->rigidLink->setCcdMotionThreshold(1);
-  // auto size = this->BoundingBox().Size();
-  // this->rigidLink->setCcdSweptSphereRadius(size.GetMax()*0.8);
+  if (this->CCD())
+    this->SetCCD(true);
 
   if (this->inertial->Mass() <= 0.0)
     this->rigidLink->setCollisionFlags(btCollisionObject::CF_KINEMATIC_OBJECT);
@@ -663,6 +662,20 @@ void BulletLink::SetAutoDisable(bool /*_disable*/)
   gzlog << "BulletLink::SetAutoDisable not yet implemented." << std::endl;
 }
 
+/////////////////////////////////////////////////
+void BulletLink::SetCCD(const bool _enable)
+{
+  Link::SetCCD(_enable);
+  if (!this->rigidLink)
+    return;
+
+  // Bullet sweeps a sphere inscribed in the link whenever the link moves
+  // by more than the radius in a step. A threshold of zero disables it.
+  const double radius = _enable ? this->CCDRadius() : 0.0;
+  this->rigidLink->setCcdMotionThreshold(radius);
+  this->rigidLink->setCcdSweptSphereRadius(radius);
+}
+
 //////////////////////////////////////////////////
 void BulletLink::SetLinkStatic(bool /*_static*/)
 {
@@ -156,6 +156,9 @@ namespace gazebo
       // Documentation inherited.
       public: virtual void SetAutoDisable(bool _disable);
 
+      // Documentation inherited.
+      public: virtual void SetCCD(const bool _enable);
+
       // Documentation inherited
       public: virtual void SetLinkStatic(bool _static);
 
@@ -15,6 +15,11 @@
  *
 */
 
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include "gazebo/common/Mesh.hh"
 
 #include "gazebo/physics/bullet/BulletTypes.hh"
@@ -25,6 +30,14 @@
 using namespace gazebo;
 using namespace physics;
 
+/// \brief Protects shapeCache.
+static std::mutex shapeCacheMutex;
+
+/// \brief Collision shapes by cache key. Only weak references are kept, so
+/// a shape is deleted along with the last mesh that uses it.
+static std::unordered_map<std::string, std::weak_ptr<btCollisionShape>>
+    shapeCache;
+
 //////////////////////////////////////////////////
 BulletMesh::BulletMesh()
 {
@@ -35,11 +48,46 @@ BulletMesh::~BulletMesh()
 {
 }
 
+//////////////////////////////////////////////////
+void BulletMesh::SetCacheKey(const std::string &_key)
+{
+  this->cacheKey = _key;
+}
+
+//////////////////////////////////////////////////
+bool BulletMesh::UseCachedShape(BulletCollisionPtr _collision)
+{
+  if (this->cacheKey.empty())
+    return false;
+
+  std::lock_guard<std::mutex> lock(shapeCacheMutex);
+  auto iter = shapeCache.find(this->cacheKey);
+  if (iter == shapeCache.end())
+    return false;
+
+  std::shared_ptr<btCollisionShape> cached = iter->second.lock();
+  if (!cached)
+  {
+    shapeCache.erase(iter);
+    return false;
+  }
+
+  if (this->shape && this->shape != cached)
+    this->oldShapes.push_back(this->shape);
+  this->shape = cached;
+
+  _collision->SetCollisionShape(this->shape.get());
+  return true;
+}
+
 //////////////////////////////////////////////////
 void BulletMesh::Init(const common::SubMesh *_subMesh,
                       BulletCollisionPtr _collision,
                       const ignition::math::Vector3d &_scale)
 {
+  if (this->UseCachedShape(_collision))
+    return;
+
   float *vertices = nullptr;
   int *indices = nullptr;
 
@@ -61,6 +109,9 @@ void BulletMesh::Init(const common::Mesh *_mesh,
                       BulletCollisionPtr _collision,
                       const ignition::math::Vector3d &_scale)
 {
+  if (this->UseCachedShape(_collision))
+    return;
+
   float *vertices = nullptr;
   int *indices = nullptr;
 
@@ -77,6 +128,59 @@ void BulletMesh::Init(const common::Mesh *_mesh,
   delete [] indices;
 }
 
+//////////////////////////////////////////////////
+void BulletMesh::InitConvex(const common::Mesh *_mesh,
+                            BulletCollisionPtr _collision,
+                            const ignition::math::Vector3d &_scale)
+{
+  if (this->UseCachedShape(_collision))
+    return;
+
+  // One convex hull per submesh. The hull shapes only keep their points,
+  // the triangles aren't needed.
+  btCompoundShape *compoundShape = new btCompoundShape();
+  std::vector<btConvexHullShape *> hulls;
+  for (unsigned int i = 0; i < _mesh->GetSubMeshCount(); ++i)
+  {
+    const common::SubMesh *subMesh = _mesh->GetSubMesh(i);
+    if (subMesh->GetVertexCount() < 4)
+      continue;
+
+    btConvexHullShape *hull = new btConvexHullShape();
+    for (unsigned int j = 0; j < subMesh->GetVertexCount(); ++j)
+    {
+      ignition::math::Vector3d v = subMesh->Vertex(j) * _scale;
+      hull->addPoint(btVector3(v.X(), v.Y(), v.Z()), false);
+    }
+    hull->recalcLocalAabb();
+    hulls.push_back(hull);
+
+    btTransform identity;
+    identity.setIdentity();
+    compoundShape->addChildShape(identity, hull);
+  }
+
+  if (this->shape)
+    this->oldShapes.push_back(this->shape);
+
+  // The compound shape doesn't own its children
+  this->shape.reset(compoundShape,
+      [hulls](btCollisionShape *_shape)
+      {
+        delete _shape;
+        for (auto hull : hulls)
+          delete hull;
+      });
+
+  if (!this->cacheKey.empty())
+  {
+    std::lock_guard<std::mutex> lock(shapeCacheMutex);
+    shapeCache[this->cacheKey] = this->shape;
+  }
+
+  _collision->SetCollisionShape(compoundShape);
+}
+
 /////////////////////////////////////////////////
 void BulletMesh::CreateMesh(float *_vertices, int *_indices,
     unsigned int _numVertices, unsigned int _numIndices,
@@ -114,5 +218,22 @@ void BulletMesh::CreateMesh(float *_vertices, int *_indices,
     new btGImpactMeshShape(mTriMesh);
   gimpactMeshShape->updateBound();
 
+  if (this->shape)
+    this->oldShapes.push_back(this->shape);
+
+  // The shape doesn't own the triangles
+  this->shape.reset(gimpactMeshShape,
+      [mTriMesh](btCollisionShape *_shape)
+      {
+        delete _shape;
+        delete mTriMesh;
+      });
+
+  if (!this->cacheKey.empty())
+  {
+    std::lock_guard<std::mutex> lock(shapeCacheMutex);
+    shapeCache[this->cacheKey] = this->shape;
+  }
+
   _collision->SetCollisionShape(gimpactMeshShape);
 }
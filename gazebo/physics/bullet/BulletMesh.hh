@@ -18,11 +18,17 @@
 #ifndef GAZEBO_PHYSICS_BULLET_BULLETMESH_HH_
 #define GAZEBO_PHYSICS_BULLET_BULLETMESH_HH_
 
+#include <memory>
+#include <string>
+#include <vector>
+
 #include <ignition/math/Vector3.hh>
 
 #include "gazebo/physics/bullet/BulletTypes.hh"
 #include "gazebo/util/system.hh"
 
+class btCollisionShape;
+
 namespace gazebo
 {
   namespace physics
@@ -40,6 +46,13 @@ namespace gazebo
       /// \brief Destructor
       public: virtual ~BulletMesh();
 
+      /// \brief Share the collision shape with the other meshes that have
+      /// the same key, so that the shape is only built once. Must be called
+      /// before Init.
+      /// \param[in] _key Key that identifies the mesh data and the scale,
+      /// see MeshShape::CollisionDataKey. An empty key disables sharing.
+      public: void SetCacheKey(const std::string &_key);
+
       /// \brief Create a mesh collision shape using a submesh.
       /// \param[in] _subMesh Pointer to the submesh.
       /// \param[in] _collision Pointer to the collision object.
@@ -56,6 +69,22 @@ namespace gazebo
                       BulletCollisionPtr _collision,
                       const ignition::math::Vector3d &_scale);
 
+      /// \brief Create a compound of convex hull shapes, one per submesh
+      /// of a convex decomposition, see MeshShape::IsConvexDecomposition.
+      /// Unlike GImpact shapes, the hull shapes are read only while
+      /// colliding.
+      /// \param[in] _mesh Pointer to the mesh made of convex hulls.
+      /// \param[in] _collision Pointer to the collision object.
+      /// \param[in] _scale Scaling factor.
+      public: void InitConvex(const common::Mesh *_mesh,
+                              BulletCollisionPtr _collision,
+                              const ignition::math::Vector3d &_scale);
+
+      /// \brief Use the shape of another mesh with the same cache key.
+      /// \param[in] _collision Pointer to the collision object.
+      /// \return True if a shape was found.
+      private: bool UseCachedShape(BulletCollisionPtr _collision);
+
       /// \brief Helper function to create the collision shape.
       /// \param[in] _vertices Array of vertices.
       /// \param[in] _indices Array of indices.
@@ -67,6 +96,18 @@ namespace gazebo
                    unsigned int _numVertices, unsigned int _numIndices,
                    BulletCollisionPtr _collision,
                    const ignition::math::Vector3d &_scale);
+
+      /// \brief Key used to share the collision shape, empty if the shape
+      /// isn't shared.
+      private: std::string cacheKey;
+
+      /// \brief The collision shape, which may be shared with other meshes.
+      private: std::shared_ptr<btCollisionShape> shape;
+
+      /// \brief Shapes replaced by a later call to Init. They're kept alive
+      /// because the compound shape of the link, which is only rebuilt by
+      /// BulletLink::Init, may still refer to them.
+      private: std::vector<std::shared_ptr<btCollisionShape>> oldShapes;
     };
     /// \}
   }
@@ -23,6 +23,7 @@
 #include "gazebo/physics/bullet/BulletPhysics.hh"
 #include "gazebo/physics/bullet/BulletMeshShape.hh"
 #include "gazebo/common/Console.hh"
+#include "gazebo/physics/World.hh"
 
 using namespace gazebo;
 using namespace physics;
@@ -60,7 +61,24 @@ void BulletMeshShape::Init()
   BulletCollisionPtr bParent =
     boost::static_pointer_cast<BulletCollision>(this->collisionParent);
 
-  if (this->submesh)
+  // Identical mesh collisions share one shape. GImpact shapes lock their
+  // triangles while colliding, which isn't thread safe, so shapes aren't
+  // shared in the multithreaded world. Convex hulls are always shared.
+  boost::any multithreaded;
+  if (this->IsConvexDecomposition() ||
+      (this->collisionParent->GetWorld()->Physics()->GetParam(
+        "multithreaded", multithreaded) &&
+      !boost::any_cast<bool>(multithreaded)))
+  {
+    this->bulletMesh->SetCacheKey(this->CollisionDataKey());
+  }
+
+  if (this->IsConvexDecomposition())
+  {
+    this->bulletMesh->InitConvex(this->mesh, bParent,
+        this->sdf->Get<ignition::math::Vector3d>("scale"));
+  }
+  else if (this->submesh)
   {
     this->bulletMesh->Init(this->submesh, bParent,
         this->sdf->Get<ignition::math::Vector3d>("scale"));
@@ -17,6 +17,7 @@
 
 #include <algorithm>
 #include <string>
+#include <vector>
 
 #include <ignition/common/Profiler.hh>
 #include <ignition/math/Rand.hh>
@@ -58,6 +59,7 @@
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Exception.hh"
+#include "gazebo/common/SamplingProfiler.hh"
 
 #include "gazebo/physics/bullet/BulletPhysics.hh"
 #include "gazebo/physics/bullet/BulletSurfaceParams.hh"
@@ -267,9 +269,6 @@ BulletPhysics::BulletPhysics(WorldPtr _world)
   // Default setup for memory and collisions
   this->collisionConfig = new btDefaultCollisionConfiguration();
 
-  // Default collision dispatcher, a multi-threaded dispatcher may be available
-  this->dispatcher = new btCollisionDispatcher(this->collisionConfig);
-
   // Broadphase collision detection uses axis-aligned bounding boxes (AABB)
   // to detect pairs of objects that may be in contact.
   // The narrow-phase collision detection evaluates each pair generated by the
@@ -282,34 +281,27 @@ BulletPhysics::BulletPhysics(WorldPtr _world)
   // Here we are using btDbvtBroadphase.
   this->broadPhase = new btDbvtBroadphase();
 
-  // Create btSequentialImpulseConstraintSolver, the default constraint solver.
-  // Note that a multi-threaded solver may be available.
-  this->solver = new btSequentialImpulseConstraintSolver;
-
-  // Create a btDiscreteDynamicsWorld, which is used for discrete rigid bodies.
-  // An alternative is btSoftRigidDynamicsWorld, which handles both soft and
-  // rigid bodies.
-  this->dynamicsWorld = new btDiscreteDynamicsWorld(this->dispatcher,
-      this->broadPhase, this->solver, this->collisionConfig);
-
   btOverlapFilterCallback *filterCallback = new CollisionFilter();
-  btOverlappingPairCache* pairCache = this->dynamicsWorld->getPairCache();
+  btOverlappingPairCache* pairCache =
+      this->broadPhase->getOverlappingPairCache();
   GZ_ASSERT(pairCache != nullptr,
       "Bullet broadphase overlapping pair cache is null");
   pairCache->setOverlapFilterCallback(filterCallback);
 
+  // The single threaded world, Load switches to the multithreaded one if
+  // it's requested.
+  this->dispatcher = nullptr;
+  this->solver = nullptr;
+  this->dynamicsWorld = nullptr;
+  this->CreateDynamicsWorld(false);
+
   // TODO: Enable this to do custom contact setting
   gContactAddedCallback = ContactCallback;
   gContactProcessedCallback = ContactProcessed;
 
-  this->dynamicsWorld->setInternalTickCallback(
-      InternalTickCallback, static_cast<void *>(this));
-
   // Set random seed for physics engine based on gazebo's random seed.
   // Note: this was moved from physics::PhysicsEngine constructor.
   this->SetSeed(ignition::math::Rand::Seed());
-
-  btGImpactCollisionAlgorithm::registerAlgorithm(dispatcher);
 }
 
 //////////////////////////////////////////////////
@@ -325,6 +317,27 @@ void BulletPhysics::Load(sdf::ElementPtr _sdf)
 
   sdf::ElementPtr bulletElem = this->sdf->GetElement("bullet");
 
+  {
+    const std::string kElementName = "ignition:task_scheduler";
+    if (bulletElem->HasElement(kElementName))
+      this->taskScheduler = bulletElem->Get<std::string>(kElementName);
+  }
+  {
+    const std::string kElementName = "ignition:threads";
+    if (bulletElem->HasElement(kElementName))
+      this->threads = bulletElem->Get<int>(kElementName);
+  }
+  {
+    // The world is still empty, so this only swaps the Bullet objects.
+    const std::string kElementName = "ignition:multithreaded";
+    if (bulletElem->HasElement(kElementName) &&
+        bulletElem->Get<bool>(kElementName))
+    {
+      this->SetTaskScheduler(this->taskScheduler, this->threads);
+      this->CreateDynamicsWorld(true);
+    }
+  }
+
   auto g = this->world->Gravity();
   // ODEPhysics checks this, so we will too.
   if (g == ignition::math::Vector3d::Zero)
@@ -385,7 +398,7 @@ void BulletPhysics::Init()
 //////////////////////////////////////////////////
 void BulletPhysics::InitForThread()
 {
-  IGN_PROFILE_THREAD_NAME("BullerPhysics");
+  common::SetThreadName("BulletPhysics");
 }
 
 /////////////////////////////////////////////////
@@ -542,6 +555,20 @@ void BulletPhysics::Fini()
     delete this->solver;
   this->solver = nullptr;
 
+  if (this->solverPool)
+    delete this->solverPool;
+  this->solverPool = nullptr;
+
+#ifdef LIBBULLET_VERSION_GE_288
+  if (this->ownedTaskScheduler)
+  {
+    if (btGetTaskScheduler() == this->ownedTaskScheduler)
+      btSetTaskScheduler(btGetSequentialTaskScheduler());
+    delete this->ownedTaskScheduler;
+  }
+#endif
+  this->ownedTaskScheduler = nullptr;
+
   if (this->broadPhase)
     delete this->broadPhase;
   this->broadPhase = nullptr;
@@ -580,6 +607,184 @@ void BulletPhysics::SetSORPGSIters(unsigned int _iters)
       "solver")->GetElement("iters")->Set(_iters);
 }
 
+//////////////////////////////////////////////////
+bool BulletPhysics::CreateDynamicsWorld(const bool _multithreaded)
+{
+#ifndef LIBBULLET_VERSION_GE_288
+  if (_multithreaded)
+  {
+    gzwarn << "The multithreaded Bullet world requires Bullet 2.88 or newer,"
+           << " keeping the single threaded world.\n";
+    return false;
+  }
+#endif
+
+  btDiscreteDynamicsWorld *oldWorld = this->dynamicsWorld;
+  if (oldWorld && oldWorld->getNumConstraints() > 0)
+  {
+    gzwarn << "Unable to replace the Bullet dynamics world after joints "
+           << "have been created.\n";
+    return false;
+  }
+
+  // Take the collision objects out of the current world, along with their
+  // collision filters.
+  struct FilteredObject
+  {
+    btCollisionObject *object;
+    int group;
+    int mask;
+  };
+  std::vector<FilteredObject> objects;
+  btVector3 gravity(0, 0, 0);
+  btContactSolverInfo info;
+  if (oldWorld)
+  {
+    gravity = oldWorld->getGravity();
+    info = oldWorld->getSolverInfo();
+
+    for (int i = oldWorld->getNumCollisionObjects() - 1; i >= 0; --i)
+    {
+      btCollisionObject *object = oldWorld->getCollisionObjectArray()[i];
+      btBroadphaseProxy *proxy = object->getBroadphaseHandle();
+      FilteredObject filtered = {object, btBroadphaseProxy::DefaultFilter,
+                                 btBroadphaseProxy::AllFilter};
+      if (proxy)
+      {
+        filtered.group = proxy->m_collisionFilterGroup;
+        filtered.mask = proxy->m_collisionFilterMask;
+      }
+      objects.push_back(filtered);
+      oldWorld->removeCollisionObject(object);
+    }
+    delete oldWorld;
+  }
+  this->dynamicsWorld = nullptr;
+
+  delete this->solverPool;
+  this->solverPool = nullptr;
+  delete this->solver;
+  this->solver = nullptr;
+  delete this->dispatcher;
+  this->dispatcher = nullptr;
+
+#ifdef LIBBULLET_VERSION_GE_288
+  if (_multithreaded)
+  {
+    // Narrow phase pairs are processed with parallel loops of the task
+    // scheduler.
+    this->dispatcher = new btCollisionDispatcherMt(this->collisionConfig);
+
+    // Islands are solved in parallel, each with a solver of the pool. The
+    // islands that are too large to be worth splitting are merged and
+    // given to btSequentialImpulseConstraintSolverMt, which runs its own
+    // loops in parallel.
+    btITaskScheduler *scheduler = btGetTaskScheduler();
+    const int poolSize =
+        std::max(1, scheduler ? scheduler->getMaxNumThreads() : 1);
+    btConstraintSolverPoolMt *pool = new btConstraintSolverPoolMt(poolSize);
+    this->solverPool = pool;
+    this->solver = new btSequentialImpulseConstraintSolverMt;
+
+    this->dynamicsWorld = new btDiscreteDynamicsWorldMt(this->dispatcher,
+        this->broadPhase, pool, this->solver, this->collisionConfig);
+  }
+  else
+#endif
+  {
+    // Default collision dispatcher
+    this->dispatcher = new btCollisionDispatcher(this->collisionConfig);
+
+    // Create btSequentialImpulseConstraintSolver, the default constraint
+    // solver.
+    this->solver = new btSequentialImpulseConstraintSolver;
+
+    // Create a btDiscreteDynamicsWorld, which is used for discrete rigid
+    // bodies. An alternative is btSoftRigidDynamicsWorld, which handles both
+    // soft and rigid bodies.
+    this->dynamicsWorld = new btDiscreteDynamicsWorld(this->dispatcher,
+        this->broadPhase, this->solver, this->collisionConfig);
+  }
+
+  btGImpactCollisionAlgorithm::registerAlgorithm(this->dispatcher);
+
+  this->dynamicsWorld->setInternalTickCallback(
+      InternalTickCallback, static_cast<void *>(this));
+
+  if (oldWorld)
+  {
+    this->dynamicsWorld->setGravity(gravity);
+    this->dynamicsWorld->getSolverInfo() = info;
+  }
+
+  for (auto iter = objects.rbegin(); iter != objects.rend(); ++iter)
+  {
+    btRigidBody *body = btRigidBody::upcast(iter->object);
+    if (body)
+      this->dynamicsWorld->addRigidBody(body, iter->group, iter->mask);
+    else
+    {
+      this->dynamicsWorld->addCollisionObject(iter->object, iter->group,
+          iter->mask);
+    }
+  }
+
+  this->multithreaded = _multithreaded;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool BulletPhysics::SetTaskScheduler(const std::string &_name,
+    const int _threads)
+{
+#ifdef LIBBULLET_VERSION_GE_288
+  btITaskScheduler *scheduler = nullptr;
+  if (_name == "default")
+  {
+    // Bullet's own thread pool, only available when Bullet is built with
+    // BT_THREADSAFE.
+    if (!this->ownedTaskScheduler)
+      this->ownedTaskScheduler = btCreateDefaultTaskScheduler();
+    scheduler = this->ownedTaskScheduler;
+  }
+  else if (_name == "openmp")
+    scheduler = btGetOpenMPTaskScheduler();
+  else if (_name == "tbb")
+    scheduler = btGetTBBTaskScheduler();
+  else if (_name == "ppl")
+    scheduler = btGetPPLTaskScheduler();
+  else if (_name == "sequential")
+    scheduler = btGetSequentialTaskScheduler();
+  else
+  {
+    gzerr << "Unknown Bullet task scheduler[" << _name << "]\n";
+    return false;
+  }
+
+  bool result = true;
+  if (!scheduler)
+  {
+    gzwarn << "Bullet was built without the [" << _name << "] task "
+           << "scheduler, using the sequential scheduler.\n";
+    scheduler = btGetSequentialTaskScheduler();
+    result = false;
+  }
+
+  if (btGetTaskScheduler() != scheduler)
+    btSetTaskScheduler(scheduler);
+
+  const int maxThreads = scheduler->getMaxNumThreads();
+  scheduler->setNumThreads(
+      _threads > 0 ? std::min(_threads, maxThreads) : maxThreads);
+
+  return result;
+#else
+  gzwarn << "Bullet task schedulers require Bullet 2.88 or newer, unable "
+         << "to use [" << _name << "] with [" << _threads << "] threads.\n";
+  return false;
+#endif
+}
+
 //////////////////////////////////////////////////
 bool BulletPhysics::SetParam(const std::string &_key, const boost::any &_value)
 {
@@ -647,6 +852,45 @@ bool BulletPhysics::SetParam(const std::string &_key, const boost::any &_value)
       bulletElem->GetElement("constraints")->GetElement(
           "split_impulse_penetration_threshold")->Set(value);
     }
+    else if (_key == "multithreaded")
+    {
+      bool value = any_cast<bool>(_value);
+      boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+      if (value != this->multithreaded)
+      {
+        if (value)
+          this->SetTaskScheduler(this->taskScheduler, this->threads);
+        if (!this->CreateDynamicsWorld(value))
+          return false;
+      }
+    }
+    else if (_key == "threads")
+    {
+      int value = any_cast<int>(_value);
+      if (value < 0)
+      {
+        gzerr << "Number of threads must be positive, or 0 for all.\n";
+        return false;
+      }
+      boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+      this->threads = value;
+      if (this->multithreaded)
+        return this->SetTaskScheduler(this->taskScheduler, this->threads);
+    }
+    else if (_key == "task_scheduler")
+    {
+      std::string value = any_cast<std::string>(_value);
+      if (value != "default" && value != "openmp" && value != "tbb" &&
+          value != "ppl" && value != "sequential")
+      {
+        gzerr << "Unknown Bullet task scheduler[" << value << "]\n";
+        return false;
+      }
+      boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+      this->taskScheduler = value;
+      if (this->multithreaded)
+        return this->SetTaskScheduler(this->taskScheduler, this->threads);
+    }
     else if (_key == "max_contacts")
     {
       /// TODO: Implement max contacts param
@@ -717,6 +961,12 @@ bool BulletPhysics::GetParam(const std::string &_key, boost::any &_value) const
     _value = bulletElem->GetElement("constraints")->Get<double>(
       "split_impulse_penetration_threshold");
   }
+  else if (_key == "multithreaded")
+    _value = this->multithreaded;
+  else if (_key == "threads")
+    _value = this->threads;
+  else if (_key == "task_scheduler")
+    _value = this->taskScheduler;
   else if (_key == "max_contacts")
     _value = this->sdf->GetElement("max_contacts")->Get<int>();
   else if (_key == "min_step_size")
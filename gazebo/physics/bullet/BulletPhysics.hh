@@ -32,6 +32,9 @@
 #include "gazebo/physics/Shape.hh"
 #include "gazebo/util/system.hh"
 
+// Declared by LinearMath/btThreads.h in Bullet 2.88 and newer.
+class btITaskScheduler;
+
 namespace gazebo
 {
   namespace physics
@@ -172,16 +175,54 @@ namespace gazebo
       // Documentation inherited
       public: virtual void SetSORPGSIters(unsigned int iters);
 
+      /// \brief Create the collision dispatcher, constraint solver and
+      /// dynamics world. Collision objects of the current world are moved to
+      /// the new one, which is only possible while there are no constraints,
+      /// since joints keep a pointer to the world.
+      /// \param[in] _multithreaded True to create a btDiscreteDynamicsWorldMt
+      /// with a pool of constraint solvers, false for a
+      /// btDiscreteDynamicsWorld.
+      /// \return True if the world was created.
+      private: bool CreateDynamicsWorld(const bool _multithreaded);
+
+      /// \brief Select the task scheduler used by the multithreaded world.
+      /// The scheduler is global to the process, and Bullet only allows it
+      /// to be changed from the thread that first used it.
+      /// \param[in] _name One of "default", "openmp", "tbb", "ppl" or
+      /// "sequential".
+      /// \param[in] _threads Number of threads, 0 to use all the threads of
+      /// the scheduler.
+      /// \return False if the scheduler is unknown, or if Bullet was built
+      /// without it, in which case the sequential scheduler is used.
+      private: bool SetTaskScheduler(const std::string &_name,
+                                     const int _threads);
+
       private: btBroadphaseInterface *broadPhase;
       private: btDefaultCollisionConfiguration *collisionConfig;
       private: btCollisionDispatcher *dispatcher;
       private: btSequentialImpulseConstraintSolver *solver;
+
+      /// \brief Pool of constraint solvers used by the islands of the
+      /// multithreaded world, null for the single threaded world.
+      private: btConstraintSolver *solverPool = nullptr;
+
+      /// \brief Task scheduler created by this engine, if any.
+      private: btITaskScheduler *ownedTaskScheduler = nullptr;
       private: btDiscreteDynamicsWorld *dynamicsWorld;
 
       private: common::Time lastUpdateTime;
 
       /// \brief The type of the solver.
       private: std::string solverType;
+
+      /// \brief True if the multithreaded world is in use.
+      private: bool multithreaded = false;
+
+      /// \brief Number of threads of the task scheduler, 0 for all.
+      private: int threads = 0;
+
+      /// \brief Name of the task scheduler.
+      private: std::string taskScheduler = "default";
     };
 
   /// \}
@@ -16,10 +16,13 @@
 */
 
 #include <gtest/gtest.h>
+#include <sstream>
 #include <string>
+#include <vector>
 
 #include "gazebo/physics/physics.hh"
 #include "gazebo/physics/PhysicsEngine.hh"
+#include "gazebo/physics/bullet/BulletCollision.hh"
 #include "gazebo/physics/bullet/BulletPhysics.hh"
 #include "gazebo/physics/bullet/BulletTypes.hh"
 #include "gazebo/msgs/msgs.hh"
@@ -180,6 +183,110 @@ TEST_F(BulletPhysics_TEST, PhysicsParam)
   EXPECT_DOUBLE_EQ(maxStepSize, maxStepSizeRet);
 }
 
+/////////////////////////////////////////////////
+/// Test switching to the multithreaded dynamics world
+TEST_F(BulletPhysics_TEST, Multithreaded)
+{
+  Load("worlds/empty.world", true, "bullet");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  BulletPhysicsPtr bulletPhysics =
+      boost::dynamic_pointer_cast<BulletPhysics>(world->Physics());
+  ASSERT_TRUE(bulletPhysics != nullptr);
+
+  EXPECT_FALSE(boost::any_cast<bool>(
+      bulletPhysics->GetParam("multithreaded")));
+  EXPECT_EQ(boost::any_cast<int>(bulletPhysics->GetParam("threads")), 0);
+  EXPECT_EQ(boost::any_cast<std::string>(
+      bulletPhysics->GetParam("task_scheduler")), "default");
+
+  EXPECT_FALSE(bulletPhysics->SetParam("task_scheduler",
+      std::string("invalid")));
+  EXPECT_FALSE(bulletPhysics->SetParam("threads", -1));
+  EXPECT_TRUE(bulletPhysics->SetParam("task_scheduler",
+      std::string("sequential")));
+  EXPECT_TRUE(bulletPhysics->SetParam("threads", 2));
+  EXPECT_EQ(boost::any_cast<std::string>(
+      bulletPhysics->GetParam("task_scheduler")), "sequential");
+  EXPECT_EQ(boost::any_cast<int>(bulletPhysics->GetParam("threads")), 2);
+
+  // The ground plane is moved to the new world
+#ifdef LIBBULLET_VERSION_GE_288
+  EXPECT_TRUE(bulletPhysics->SetParam("multithreaded", true));
+  EXPECT_TRUE(boost::any_cast<bool>(
+      bulletPhysics->GetParam("multithreaded")));
+#else
+  EXPECT_FALSE(bulletPhysics->SetParam("multithreaded", true));
+  EXPECT_FALSE(boost::any_cast<bool>(
+      bulletPhysics->GetParam("multithreaded")));
+#endif
+  EXPECT_EQ(bulletPhysics->GetDynamicsWorld()->getNumCollisionObjects(), 1);
+
+  SpawnBox("box", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(0, 0, 1));
+  ModelPtr model = world->ModelByName("box");
+  ASSERT_TRUE(model != nullptr);
+
+  // The box comes to rest on the ground plane
+  world->Step(1000);
+  EXPECT_NEAR(model->WorldPose().Pos().Z(), 0.5, 1e-2);
+}
+
+/////////////////////////////////////////////////
+/// Test that identical mesh collisions share their shape
+TEST_F(BulletPhysics_TEST, SharedMeshShape)
+{
+  Load("worlds/empty.world", true, "bullet");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  // Two identical meshes, and one with another scale
+  const std::vector<double> scales = {0.5, 0.5, 0.25};
+  for (unsigned int i = 0; i < scales.size(); ++i)
+  {
+    std::ostringstream sdfStr;
+    sdfStr << "<sdf version='" << SDF_VERSION << "'>"
+      << "<model name='mesh_" << i << "'>"
+      << "  <pose>" << 2.0 * i << " 0 1 0 0 0</pose>"
+      << "  <link name='link'>"
+      << "    <collision name='collision'>"
+      << "      <geometry><mesh>"
+      << "        <uri>" << PROJECT_SOURCE_PATH << "/test/data/box.dae</uri>"
+      << "        <scale>" << scales[i] << " " << scales[i] << " "
+      << scales[i] << "</scale>"
+      << "      </mesh></geometry>"
+      << "    </collision>"
+      << "  </link>"
+      << "</model>"
+      << "</sdf>";
+    world->InsertModelString(sdfStr.str());
+  }
+
+  int sleep = 0;
+  while (world->ModelCount() < 1 + scales.size() && sleep++ < 100)
+  {
+    world->Step(1);
+    common::Time::MSleep(10);
+  }
+  ASSERT_EQ(world->ModelCount(), 1 + scales.size());
+
+  std::vector<btCollisionShape *> shapes;
+  for (unsigned int i = 0; i < scales.size(); ++i)
+  {
+    ModelPtr model = world->ModelByName("mesh_" + std::to_string(i));
+    ASSERT_TRUE(model != nullptr);
+    BulletCollisionPtr collision =
+        boost::dynamic_pointer_cast<BulletCollision>(
+        model->GetLink("link")->GetCollision("collision"));
+    ASSERT_TRUE(collision != nullptr);
+    ASSERT_TRUE(collision->GetCollisionShape() != nullptr);
+    shapes.push_back(collision->GetCollisionShape());
+  }
+  EXPECT_EQ(shapes[0], shapes[1]);
+  EXPECT_NE(shapes[0], shapes[2]);
+}
+
 /////////////////////////////////////////////////
 void BulletPhysics_TEST::OnPhysicsMsgResponse(ConstResponsePtr &_msg)
 {
@@ -255,6 +255,10 @@ void DARTModel::Init()
 
   // Add the skeleton to the world
   this->DARTWorld()->addSkeleton(this->dataPtr->dtSkeleton);
+
+  this->dataPtr->dartLinks.clear();
+  this->dataPtr->linksByBodyNode.clear();
+  this->dataPtr->jointDofIndices.clear();
 }
 
 
@@ -271,6 +275,9 @@ void DARTModel::Fini()
   // calling Base::Fini()) will reset the world pointer
   dart::simulation::WorldPtr _world = this->DARTWorld();
   // remove all links and joints properly
+  this->dataPtr->dartLinks.clear();
+  this->dataPtr->linksByBodyNode.clear();
+  this->dataPtr->jointDofIndices.clear();
   Model::Fini();
   // remove the skeleton from the world
   if (_world && this->dataPtr->dtSkeleton)
@@ -279,6 +286,200 @@ void DARTModel::Fini()
   }
 }
 
+//////////////////////////////////////////////////
+void DARTModel::UpdateLinkCache()
+{
+  const Link_V &links = this->GetLinks();
+  if (this->dataPtr->dartLinks.size() == links.size())
+    return;
+
+  this->dataPtr->dartLinks.clear();
+  this->dataPtr->linksByBodyNode.clear();
+  this->dataPtr->linksByBodyNode.resize(
+      this->dataPtr->dtSkeleton->getNumBodyNodes());
+
+  for (const auto &link : links)
+  {
+    DARTLinkPtr dartLink = boost::static_pointer_cast<DARTLink>(link);
+    this->dataPtr->dartLinks.push_back(dartLink);
+
+    const dart::dynamics::BodyNode *dtBodyNode = dartLink->DARTBodyNode();
+    if (!dtBodyNode ||
+        dtBodyNode->getSkeleton() != this->dataPtr->dtSkeleton)
+    {
+      continue;
+    }
+
+    const size_t index = dtBodyNode->getIndexInSkeleton();
+    if (index < this->dataPtr->linksByBodyNode.size())
+      this->dataPtr->linksByBodyNode[index] = dartLink;
+  }
+}
+
+//////////////////////////////////////////////////
+void DARTModel::UpdateLinkPoses()
+{
+  if (!this->dataPtr->dtSkeleton || !this->dataPtr->dtSkeleton->isMobile())
+    return;
+
+  this->UpdateLinkCache();
+  for (const auto &dartLink : this->dataPtr->dartLinks)
+    dartLink->updateDirtyPoseFromDARTTransformation();
+}
+
+//////////////////////////////////////////////////
+void DARTModel::UpdateJointCache()
+{
+  const Joint_V &joints = this->GetJoints();
+  if (this->dataPtr->jointDofIndices.size() == joints.size())
+    return;
+
+  this->dataPtr->jointDofIndices.assign(joints.size(), -1);
+  for (size_t j = 0; j < joints.size(); ++j)
+  {
+    DARTJointPtr dartJoint =
+        boost::dynamic_pointer_cast<DARTJoint>(joints[j]);
+    if (!dartJoint)
+      continue;
+
+    const dart::dynamics::Joint *dtJoint = dartJoint->GetDARTJoint();
+    const unsigned int dofs = joints[j]->DOF();
+    if (!dtJoint || dofs == 0 ||
+        dtJoint->getSkeleton() != this->dataPtr->dtSkeleton ||
+        dtJoint->getNumDofs() != dofs)
+    {
+      continue;
+    }
+
+    // Only use the skeleton vectors if the DOFs are next to each other
+    const size_t first = dtJoint->getIndexInSkeleton(0);
+    bool contiguous = true;
+    for (unsigned int i = 1; i < dofs; ++i)
+      contiguous = contiguous && dtJoint->getIndexInSkeleton(i) == first + i;
+
+    if (contiguous)
+      this->dataPtr->jointDofIndices[j] = static_cast<int>(first);
+  }
+}
+
+//////////////////////////////////////////////////
+void DARTModel::JointStates(std::vector<double> &_positions,
+    std::vector<double> &_velocities)
+{
+  if (this->IsStatic() || !this->dataPtr->dtSkeleton)
+  {
+    Model::JointStates(_positions, _velocities);
+    return;
+  }
+
+  const unsigned int count = this->JointStateCount();
+  _positions.resize(count);
+  _velocities.resize(count);
+
+  boost::recursive_mutex::scoped_lock lock(
+      *this->GetWorld()->Physics()->GetPhysicsUpdateMutex());
+
+  this->UpdateJointCache();
+  const Eigen::VectorXd q = this->dataPtr->dtSkeleton->getPositions();
+  const Eigen::VectorXd dq = this->dataPtr->dtSkeleton->getVelocities();
+
+  const Joint_V &joints = this->GetJoints();
+  unsigned int index = 0;
+  for (size_t j = 0; j < joints.size(); ++j)
+  {
+    const int first = this->dataPtr->jointDofIndices[j];
+    for (unsigned int i = 0; i < joints[j]->DOF(); ++i, ++index)
+    {
+      if (first >= 0)
+      {
+        _positions[index] = q[first + i];
+        _velocities[index] = dq[first + i];
+      }
+      else
+      {
+        _positions[index] = joints[j]->Position(i);
+        _velocities[index] = joints[j]->GetVelocity(i);
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+bool DARTModel::SetJointStates(const std::vector<double> &_positions,
+    const std::vector<double> &_velocities)
+{
+  if (this->IsStatic() || !this->dataPtr->dtSkeleton)
+    return Model::SetJointStates(_positions, _velocities);
+
+  const unsigned int count = this->JointStateCount();
+  if ((!_positions.empty() && _positions.size() != count) ||
+      (!_velocities.empty() && _velocities.size() != count))
+  {
+    gzerr << "Model [" << this->GetScopedName() << "] has " << count
+          << " joint states, got " << _positions.size() << " positions and "
+          << _velocities.size() << " velocities\n";
+    return false;
+  }
+
+  boost::recursive_mutex::scoped_lock lock(
+      *this->GetWorld()->Physics()->GetPhysicsUpdateMutex());
+
+  this->UpdateJointCache();
+  Eigen::VectorXd q = this->dataPtr->dtSkeleton->getPositions();
+  Eigen::VectorXd dq = this->dataPtr->dtSkeleton->getVelocities();
+
+  const Joint_V &joints = this->GetJoints();
+  unsigned int index = 0;
+  for (size_t j = 0; j < joints.size(); ++j)
+  {
+    const int first = this->dataPtr->jointDofIndices[j];
+    for (unsigned int i = 0; i < joints[j]->DOF(); ++i, ++index)
+    {
+      if (first >= 0)
+      {
+        if (!_positions.empty())
+          q[first + i] = _positions[index];
+        if (!_velocities.empty())
+          dq[first + i] = _velocities[index];
+      }
+      else
+      {
+        if (!_positions.empty())
+          joints[j]->SetPosition(i, _positions[index]);
+        if (!_velocities.empty())
+          joints[j]->SetVelocity(i, _velocities[index]);
+      }
+    }
+  }
+
+  // One write per vector, which updates the kinematics once
+  if (!_positions.empty())
+    this->dataPtr->dtSkeleton->setPositions(q);
+  if (!_velocities.empty())
+    this->dataPtr->dtSkeleton->setVelocities(dq);
+
+  this->UpdateLinkPoses();
+  return true;
+}
+
+//////////////////////////////////////////////////
+DARTLinkPtr DARTModel::LinkByBodyNode(
+    const dart::dynamics::BodyNode *_bodyNode)
+{
+  if (!_bodyNode || !this->dataPtr->dtSkeleton)
+    return DARTLinkPtr();
+
+  this->UpdateLinkCache();
+  const size_t index = _bodyNode->getIndexInSkeleton();
+  if (_bodyNode->getSkeleton() != this->dataPtr->dtSkeleton ||
+      index >= this->dataPtr->linksByBodyNode.size())
+  {
+    return DARTLinkPtr();
+  }
+
+  return this->dataPtr->linksByBodyNode[index];
+}
+
 //////////////////////////////////////////////////
 void DARTModel::BackupState()
 {
@@ -416,5 +617,8 @@ bool DARTModel::RemoveJoint(const std::string &_name)
     return false;
   }
 
+  this->dataPtr->dartLinks.clear();
+  this->dataPtr->linksByBodyNode.clear();
+  this->dataPtr->jointDofIndices.clear();
   return Model::RemoveJoint(_name);
 }
@@ -19,6 +19,7 @@
 #define _GAZEBO_DARTMODEL_HH_
 
 #include <string>
+#include <vector>
 
 #include "gazebo/physics/dart/dart_inc.h"
 #include "gazebo/physics/dart/DARTTypes.hh"
@@ -80,6 +81,37 @@ namespace gazebo
       /// \brief
       public: void RestoreState();
 
+      /// \brief Copy the poses of all links from the DART skeleton, in one
+      /// pass over a cached list of links. Called by DARTPhysics after each
+      /// step. Does nothing for static models, which DART never moves.
+      public: void UpdateLinkPoses();
+
+      /// \brief Get the link that owns a body node of the skeleton.
+      /// \param[in] _bodyNode A body node of this model's skeleton.
+      /// \return The link, or null if the body node belongs to another
+      /// skeleton or is not the main body node of a link.
+      public: DARTLinkPtr LinkByBodyNode(
+          const dart::dynamics::BodyNode *_bodyNode);
+
+      /// \brief Get the joint states from the skeleton's generalized
+      /// positions and velocities, falling back to the Joint API for
+      /// joints that are not part of the skeleton.
+      /// \param[out] _positions Joint positions.
+      /// \param[out] _velocities Joint velocities.
+      /// \sa Model::JointStates
+      public: virtual void JointStates(std::vector<double> &_positions,
+                  std::vector<double> &_velocities);
+
+      /// \brief Set the joint states with a single write of the skeleton's
+      /// generalized positions and velocities.
+      /// \param[in] _positions Joint positions.
+      /// \param[in] _velocities Joint velocities.
+      /// \return False if the sizes don't match.
+      /// \sa Model::SetJointStates
+      public: virtual bool SetJointStates(
+                  const std::vector<double> &_positions,
+                  const std::vector<double> &_velocities);
+
       /// \brief Get pointer to DART Skeleton.
       /// \return The pointer to DART Skeleton.
       public: dart::dynamics::SkeletonPtr DARTSkeleton();
@@ -92,6 +124,13 @@ namespace gazebo
       /// \return The pointer to DART World.
       public: dart::simulation::WorldPtr DARTWorld(void) const;
 
+      /// \brief Fill the cached list of DART links if it is out of date.
+      private: void UpdateLinkCache();
+
+      /// \brief Fill the cached skeleton indices of the joint DOFs if they
+      /// are out of date.
+      private: void UpdateJointCache();
+
       /// \internal
       /// \brief Pointer to private data
       private: DARTModelPrivate *dataPtr;
@@ -21,8 +21,10 @@
 #include <string>
 #include <utility>
 #include <memory>
+#include <vector>
 
 #include "gazebo/physics/dart/dart_inc.h"
+#include "gazebo/physics/dart/DARTTypes.hh"
 
 namespace gazebo
 {
@@ -280,6 +282,20 @@ namespace gazebo
       /// \brief Generalized velocities
       public: Eigen::VectorXd genVelocities;
 
+      /// \brief DART links of the model, in the order of Model::GetLinks.
+      /// Filled on first use and cleared whenever the skeleton changes.
+      public: std::vector<DARTLinkPtr> dartLinks;
+
+      /// \brief DART links indexed by the index of their body node in the
+      /// skeleton. Filled along with dartLinks.
+      public: std::vector<DARTLinkPtr> linksByBodyNode;
+
+      /// \brief Index in the skeleton of the first DOF of each joint, in
+      /// the order of Model::GetJoints, or -1 for joints that must go
+      /// through the Joint API. Filled on first use and cleared whenever
+      /// the skeleton changes.
+      public: std::vector<int> jointDofIndices;
+
       // To get byte-aligned Eigen vectors
       public: EIGEN_MAKE_ALIGNED_OPERATOR_NEW
     };
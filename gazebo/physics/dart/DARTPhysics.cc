@@ -15,6 +15,8 @@
  *
 */
 
+#include <unordered_map>
+
 // required for HAVE_DART_BULLET define
 #include <gazebo/gazebo_config.h>
 
@@ -30,6 +32,7 @@
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Exception.hh"
+#include "gazebo/common/SamplingProfiler.hh"
 
 #include "gazebo/transport/Publisher.hh"
 
@@ -97,6 +100,25 @@ void DARTPhysics::Load(sdf::ElementPtr _sdf)
   if (g == ignition::math::Vector3d::Zero)
     gzwarn << "Gravity vector is (0, 0, 0). Objects will float.\n";
   this->dataPtr->dtWorld->setGravity(Eigen::Vector3d(g.X(), g.Y(), g.Z()));
+
+  if (!this->sdf->HasElement("dart"))
+    return;
+  sdf::ElementPtr dartElem = this->sdf->GetElement("dart");
+
+  // Collision detector, DART uses FCL by default
+  if (dartElem->HasElement("collision_detector"))
+  {
+    this->SetParam("collision_detector",
+        dartElem->Get<std::string>("collision_detector"));
+  }
+
+  // Boxed LCP solver, DART uses Dantzig by default
+  if (dartElem->HasElement("solver") &&
+      dartElem->GetElement("solver")->HasElement("solver_type"))
+  {
+    this->SetSolverType(
+        dartElem->GetElement("solver")->Get<std::string>("solver_type"));
+  }
 }
 
 //////////////////////////////////////////////////
@@ -127,7 +149,7 @@ void DARTPhysics::Reset()
 //////////////////////////////////////////////////
 void DARTPhysics::InitForThread()
 {
-  IGN_PROFILE_THREAD_NAME("DARTPhysics");
+  common::SetThreadName("DARTPhysics");
 }
 
 
@@ -250,6 +272,44 @@ static DARTLinkPtr StaticFindDARTLink(
   return res;
 }
 
+/// \brief Map from DART skeleton to the model that owns it.
+typedef std::unordered_map<const dart::dynamics::Skeleton *, DARTModelPtr>
+    SkeletonModelMap;
+
+//////////////////////////////////////////////////
+/// \brief Find the link of a body node, using a map from skeletons to
+/// models that is built on first use.
+/// \param[in] _dtPhysics DART physics engine.
+/// \param[in] _dtBodyNode Body node to look for.
+/// \param[in,out] _models Map from skeleton to model.
+/// \return The link, or null if it wasn't found.
+static DARTLinkPtr StaticFindDARTLink(
+    DARTPhysics *_dtPhysics,
+    const dart::dynamics::BodyNode *_dtBodyNode,
+    SkeletonModelMap &_models)
+{
+  if (_models.empty())
+  {
+    for (const auto &model : _dtPhysics->World()->Models())
+    {
+      DARTModelPtr dartModel = boost::static_pointer_cast<DARTModel>(model);
+      _models[dartModel->DARTSkeleton().get()] = dartModel;
+    }
+  }
+
+  auto iter = _models.find(_dtBodyNode->getSkeleton().get());
+  if (iter != _models.end())
+  {
+    DARTLinkPtr dartLink = iter->second->LinkByBodyNode(_dtBodyNode);
+    if (dartLink)
+      return dartLink;
+  }
+
+  // Body nodes that aren't the main body node of a link of a top level
+  // model, fall back to the exhaustive search.
+  return StaticFindDARTLink(_dtPhysics, _dtBodyNode);
+}
+
 //////////////////////////////////////////////////
 static void RetrieveDARTCollisions(
     DARTPhysics* _dtPhysics,
@@ -275,6 +335,10 @@ static void RetrieveDARTCollisions(
   // so it will be safe to use within the scope of this function.
   PairedContactsMap pairedContacts;
 
+  // Skeleton to model map, so that finding the links of a contact doesn't
+  // require a search over all the links of the world.
+  SkeletonModelMap models;
+
   // insert all the contacts
   for (int i = 0; i < numContacts; ++i)
   {
@@ -308,8 +372,10 @@ static void RetrieveDARTCollisions(
     GZ_ASSERT(dtBodyNode1, "body node 1 is null!");
     GZ_ASSERT(dtBodyNode2, "body node 2 is null!");
 
-    DARTLinkPtr dartLink1 = StaticFindDARTLink(_dtPhysics, dtBodyNode1);
-    DARTLinkPtr dartLink2 = StaticFindDARTLink(_dtPhysics, dtBodyNode2);
+    DARTLinkPtr dartLink1 =
+        StaticFindDARTLink(_dtPhysics, dtBodyNode1.get(), models);
+    DARTLinkPtr dartLink2 =
+        StaticFindDARTLink(_dtPhysics, dtBodyNode2.get(), models);
 
     GZ_ASSERT(dartLink1, "dartLink1 in collision pair is null");
     GZ_ASSERT(dartLink2, "dartLink2 in collision pair is null");
@@ -451,26 +517,10 @@ void DARTPhysics::UpdatePhysics()
   this->dataPtr->dtWorld->step(
         this->dataPtr->resetAllForcesAfterSimulationStep);
 
-  // Update all the transformation of DART's links to gazebo's links
-  // TODO: How to visit all the links in the world?
-  unsigned int modelCount = this->world->ModelCount();
-  ModelPtr modelItr;
-
-  for (unsigned int i = 0; i < modelCount; ++i)
-  {
-    modelItr = this->world->ModelByIndex(i);
-    // TODO: need to improve speed
-    Link_V links = modelItr->GetLinks();
-    unsigned int linkCount = links.size();
-    DARTLinkPtr dartLinkItr;
-
-    for (unsigned int j = 0; j < linkCount; ++j)
-    {
-      dartLinkItr
-          = boost::dynamic_pointer_cast<DARTLink>(links.at(j));
-      dartLinkItr->updateDirtyPoseFromDARTTransformation();
-    }
-  }
+  // Update all the transformation of DART's links to gazebo's links, one
+  // skeleton at a time.
+  for (const auto &model : this->world->Models())
+    boost::static_pointer_cast<DARTModel>(model)->UpdateLinkPoses();
 
   RetrieveDARTCollisions(
         this,
@@ -649,15 +699,10 @@ void DARTPhysics::SetSolverType(const std::string &_type)
     return;
   }
 
-  if (this->sdf->HasElement("dart"))
-  {
-    sdf::ElementPtr dartElem = this->sdf->GetElement("dart");
-    if (dartElem->HasElement("solver") &&
-        dartElem->GetElement("solver")->HasElement("solver_type"))
-    {
-      dartElem->GetElement("solver")->GetElement("solver_type")->Set(_type);
-    }
-  }
+  // GetElement adds the elements that are missing, so that GetSolverType
+  // reports the new type even if the world didn't set one.
+  this->sdf->GetElement("dart")->GetElement("solver")->GetElement(
+      "solver_type")->Set(_type);
 }
 
 //////////////////////////////////////////////////
@@ -698,6 +743,10 @@ bool DARTPhysics::GetParam(const std::string &_key, boost::any &_value) const
   {
     _value = this->GetSolverType();
   }
+  else if (_key == "collision_detector")
+  {
+    _value = this->CollisionDetectorInUse();
+  }
   else if (_key == "max_contacts")
   {
     _value = dartElem->GetElement("max_contacts")->Get<int>();
@@ -722,7 +771,14 @@ bool DARTPhysics::SetParam(const std::string &_key, const boost::any &_value)
   {
     if (_key == "solver_type")
     {
-      this->SetSolverType(any_cast<std::string>(_value));
+      std::string value = any_cast<std::string>(_value);
+      if (value != "dantzig" && value != "pgs")
+      {
+        gzerr << "Invalid solver type[" << value << "], "
+              << "must be dantzig or pgs\n";
+        return false;
+      }
+      this->SetSolverType(value);
     }
     else if (_key == "max_contacts")
     {
@@ -787,6 +843,7 @@ bool DARTPhysics::SetParam(const std::string &_key, const boost::any &_value)
         gzwarn << "collision_detector element set in SDF, but no valid "
                << "collision detector specified (" << useCollisionDetector
                << " not supported. Using default." << std::endl;
+        return false;
       }
     }
     else
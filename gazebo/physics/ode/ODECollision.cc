@@ -19,6 +19,7 @@
  * Date: 13 Feb 2006
  */
 
+#include <algorithm>
 #include <sstream>
 
 #include "gazebo/common/Assert.hh"
@@ -44,6 +45,7 @@ ODECollision::ODECollision(LinkPtr _link)
       boost::static_pointer_cast<ODELink>(this->link)->GetSpaceId());
 
   this->surface.reset(new ODESurfaceParams());
+  this->UpdateFilter();
 }
 
 //////////////////////////////////////////////////
@@ -73,6 +75,8 @@ void ODECollision::Load(sdf::ElementPtr _sdf)
   {
     this->GetODESurface()->maxVel = 0.0;
   }
+
+  this->UpdateFilter();
 }
 
 //////////////////////////////////////////////////
@@ -130,6 +134,8 @@ void ODECollision::SetCollision(dGeomID _collisionId, bool _placeable)
   }
 
   dGeomSetData(this->collisionId, this);
+
+  this->UpdateFilter();
 }
 
 //////////////////////////////////////////////////
@@ -197,6 +203,30 @@ void ODECollision::SetSpaceId(dSpaceID _spaceid)
   this->spaceId = _spaceid;
 }
 
+/////////////////////////////////////////////////
+void ODECollision::SetMaxContacts(unsigned int _maxContacts)
+{
+  Collision::SetMaxContacts(_maxContacts);
+  this->UpdateFilter();
+}
+
+/////////////////////////////////////////////////
+void ODECollision::UpdateFilter()
+{
+  const SurfaceParamsPtr &params = this->GetSurface();
+  this->filterMask = static_cast<uint64_t>(params->collideBitmask) |
+      (static_cast<uint64_t>(params->collideWithoutContactBitmask) << 32);
+
+  this->filterWord =
+      std::min(this->GetMaxContacts(), kFilterMaxContacts + 0u) |
+      (static_cast<uint32_t>(this->GetCollisionClass() & 0xff) <<
+       kFilterClassShift);
+  if (params->collideWithoutContact)
+    this->filterWord |= kFilterNoContact;
+  if (this->HasType(Base::MESH_SHAPE))
+    this->filterWord |= kFilterMesh;
+}
+
 /////////////////////////////////////////////////
 ODESurfaceParamsPtr ODECollision::GetODESurface() const
 {
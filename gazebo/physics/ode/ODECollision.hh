@@ -22,6 +22,8 @@
 #ifndef _ODECOLLISION_HH_
 #define _ODECOLLISION_HH_
 
+#include <cstdint>
+
 #include "gazebo/physics/ode/ode_inc.h"
 
 #include "gazebo/physics/PhysicsTypes.hh"
@@ -90,6 +92,56 @@ namespace gazebo
       /// \return Dynamically casted pointer to ODESurfaceParams.
       public: ODESurfaceParamsPtr GetODESurface() const;
 
+      // Documentation inherited.
+      public: virtual void SetMaxContacts(unsigned int _maxContacts);
+
+      /// \brief Flag of FilterWord set when collide without contact is on.
+      public: static constexpr uint32_t kFilterNoContact = 1u << 31;
+
+      /// \brief Flag of FilterWord set for mesh shapes.
+      public: static constexpr uint32_t kFilterMesh = 1u << 30;
+
+      /// \brief Bits of FilterWord holding the max contacts.
+      public: static constexpr uint32_t kFilterMaxContacts = 0xffffu;
+
+      /// \brief Shift of the ODE geom class in FilterWord.
+      public: static constexpr uint32_t kFilterClassShift = 16u;
+
+      /// \brief Refresh the filtering data of the narrow phase from the
+      /// surface parameters, the max contacts and the geom class. The
+      /// surface parameters are public fields, so ODEPhysics refreshes it
+      /// once per collision pass.
+      public: void UpdateFilter();
+
+      /// \brief Refresh the filtering data unless it was already done for
+      /// a stamp.
+      /// \param[in] _stamp Stamp of the current collision pass.
+      public: inline void UpdateFilter(const uint64_t _stamp)
+              {
+                if (_stamp != this->filterStamp)
+                {
+                  this->filterStamp = _stamp;
+                  this->UpdateFilter();
+                }
+              }
+
+      /// \brief Get the packed bitmasks of the surface.
+      /// \return Collide bitmask in the lower 32 bits, collide without
+      /// contact bitmask in the upper 32 bits.
+      public: inline uint64_t FilterMask() const
+              {
+                return this->filterMask;
+              }
+
+      /// \brief Get the packed max contacts and flags.
+      /// \return Max contacts in the kFilterMaxContacts bits, the geom
+      /// class from kFilterClassShift, and the kFilterNoContact and
+      /// kFilterMesh flags.
+      public: inline uint32_t FilterWord() const
+              {
+                return this->filterWord;
+              }
+
       /// \brief Used when this is static to set the posse.
       private: void OnPoseChangeGlobal();
 
@@ -107,6 +159,16 @@ namespace gazebo
 
       /// \brief Function used to set the pose of the ODE object.
       private: void (ODECollision::*onPoseChangeFunc)();
+
+      /// \brief Packed bitmasks, see FilterMask.
+      private: uint64_t filterMask = 0;
+
+      /// \brief Packed max contacts and flags, see FilterWord.
+      private: uint32_t filterWord = 0;
+
+      /// \brief Stamp of the last collision pass that refreshed the
+      /// filtering data.
+      private: uint64_t filterStamp = 0;
     };
     /// \}
   }
@@ -89,6 +89,9 @@ void ODELink::Init()
 
   Link::Init();
 
+  if (this->linkId && this->CCD())
+    this->odePhysics->SetLinkCCD(this, true);
+
   if (this->linkId)
   {
     GZ_ASSERT(this->inertial != nullptr, "Inertial pointer is null");
@@ -177,6 +180,9 @@ void ODELink::MoveCallback(dBodyID _id)
 //////////////////////////////////////////////////
 void ODELink::Fini()
 {
+  if (this->odePhysics)
+    this->odePhysics->SetLinkCCD(this, false);
+
   if (this->linkId)
     dBodyDestroy(this->linkId);
   this->linkId = nullptr;
@@ -763,6 +769,14 @@ bool ODELink::GetKinematic() const
   return result;
 }
 
+//////////////////////////////////////////////////
+void ODELink::SetCCD(const bool _enable)
+{
+  Link::SetCCD(_enable);
+  if (this->odePhysics && this->linkId)
+    this->odePhysics->SetLinkCCD(this, _enable);
+}
+
 //////////////////////////////////////////////////
 void ODELink::SetAutoDisable(bool _disable)
 {
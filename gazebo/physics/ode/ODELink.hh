@@ -155,6 +155,13 @@ namespace gazebo
       // Documentation inherited
       public: virtual bool GetKinematic() const;
 
+      /// \brief Enable continuous collision detection. ODE has no native
+      /// support, so ODEPhysics sweeps the center of the link with a ray
+      /// before each step, and slows the link down for that step if it
+      /// would go through something.
+      /// \param[in] _enable True to enable continuous collision detection.
+      public: virtual void SetCCD(const bool _enable);
+
       // Documentation inherited
       public: virtual void SetAutoDisable(bool _disable);
 
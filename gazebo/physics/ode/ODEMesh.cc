@@ -14,6 +14,11 @@
  * limitations under the License.
  *
 */
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
 #include "gazebo/common/Mesh.hh"
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
@@ -25,20 +30,51 @@
 using namespace gazebo;
 using namespace physics;
 
+/// \brief Vertex and index arrays of a trimesh, and the ODE data that
+/// refers to them.
+class gazebo::physics::ODETriMeshData
+{
+  /// \brief Constructor.
+  public: ODETriMeshData() = default;
+
+  /// \brief Destructor.
+  public: ~ODETriMeshData()
+  {
+    if (this->odeData)
+      dGeomTriMeshDataDestroy(this->odeData);
+    delete [] this->vertices;
+    delete [] this->indices;
+  }
+
+  /// \brief Array of vertex values.
+  public: float *vertices = nullptr;
+
+  /// \brief Array of index values.
+  public: int *indices = nullptr;
+
+  /// \brief ODE trimesh data.
+  public: dTriMeshDataID odeData = nullptr;
+};
+
+/// \brief Protects dataCache.
+static std::mutex dataCacheMutex;
+
+/// \brief Trimesh data by cache key. Only weak references are kept, so the
+/// data is deleted along with the last mesh that uses it.
+static std::unordered_map<std::string,
+    std::weak_ptr<ODETriMeshData>> dataCache;
+
 //////////////////////////////////////////////////
 ODEMesh::ODEMesh()
 {
-  this->odeData = nullptr;
-  this->vertices = nullptr;
-  this->indices = nullptr;
+  this->collisionId = nullptr;
+  memset(this->transform, 0, 32*sizeof(dReal));
+  this->transformIndex = 0;
 }
 
 //////////////////////////////////////////////////
 ODEMesh::~ODEMesh()
 {
-  delete [] this->vertices;
-  delete [] this->indices;
-  dGeomTriMeshDataDestroy(this->odeData);
 }
 
 //////////////////////////////////////////////////
@@ -79,6 +115,40 @@ void ODEMesh::Update()
                                    this->transformIndex * 16));
 }
 
+//////////////////////////////////////////////////
+void ODEMesh::SetCacheKey(const std::string &_key)
+{
+  this->cacheKey = _key;
+}
+
+//////////////////////////////////////////////////
+bool ODEMesh::UseCachedData(ODECollisionPtr _collision)
+{
+  if (this->cacheKey.empty())
+    return false;
+
+  std::shared_ptr<ODETriMeshData> cached;
+  {
+    std::lock_guard<std::mutex> lock(dataCacheMutex);
+    auto iter = dataCache.find(this->cacheKey);
+    if (iter == dataCache.end())
+      return false;
+
+    cached = iter->second.lock();
+    if (!cached)
+    {
+      dataCache.erase(iter);
+      return false;
+    }
+  }
+
+  // Keep the previous data alive until the geom stops using it
+  std::shared_ptr<ODETriMeshData> previous = this->data;
+  this->data = cached;
+  this->AttachData(_collision);
+  return true;
+}
+
 //////////////////////////////////////////////////
 void ODEMesh::Init(const common::SubMesh *_subMesh, ODECollisionPtr _collision,
     const ignition::math::Vector3d &_scale)
@@ -86,18 +156,17 @@ void ODEMesh::Init(const common::SubMesh *_subMesh, ODECollisionPtr _collision,
   if (!_subMesh)
     return;
 
+  if (this->UseCachedData(_collision))
+    return;
+
   unsigned int numVertices = _subMesh->GetVertexCount();
   unsigned int numIndices = _subMesh->GetIndexCount();
 
-  this->vertices = nullptr;
-  this->indices = nullptr;
-
   // Get all the vertex and index data
-  _subMesh->FillArrays(&this->vertices, &this->indices);
-
-  this->collisionId = _collision->GetCollisionId();
+  std::shared_ptr<ODETriMeshData> newData(new ODETriMeshData);
+  _subMesh->FillArrays(&newData->vertices, &newData->indices);
 
-  this->CreateMesh(numVertices, numIndices, _collision, _scale);
+  this->CreateMesh(newData, numVertices, numIndices, _collision, _scale);
 }
 
 //////////////////////////////////////////////////
@@ -107,50 +176,67 @@ void ODEMesh::Init(const common::Mesh *_mesh, ODECollisionPtr _collision,
   if (!_mesh)
     return;
 
+  if (this->UseCachedData(_collision))
+    return;
+
   unsigned int numVertices = _mesh->GetVertexCount();
   unsigned int numIndices = _mesh->GetIndexCount();
 
-  this->vertices = nullptr;
-  this->indices = nullptr;
-
   // Get all the vertex and index data
-  _mesh->FillArrays(&this->vertices, &this->indices);
+  std::shared_ptr<ODETriMeshData> newData(new ODETriMeshData);
+  _mesh->FillArrays(&newData->vertices, &newData->indices);
 
-  this->collisionId = _collision->GetCollisionId();
-  this->CreateMesh(numVertices, numIndices, _collision, _scale);
+  this->CreateMesh(newData, numVertices, numIndices, _collision, _scale);
 }
 
 //////////////////////////////////////////////////
-void ODEMesh::CreateMesh(unsigned int _numVertices, unsigned int _numIndices,
+void ODEMesh::CreateMesh(std::shared_ptr<ODETriMeshData> _data,
+    unsigned int _numVertices, unsigned int _numIndices,
     ODECollisionPtr _collision, const ignition::math::Vector3d &_scale)
 {
   /// This will hold the vertex data of the triangle mesh
-  if (this->odeData == nullptr)
-    this->odeData = dGeomTriMeshDataCreate();
+  _data->odeData = dGeomTriMeshDataCreate();
 
   // Scale the vertex data
+  float *vertices = _data->vertices;
   for (unsigned int j = 0;  j < _numVertices; j++)
   {
-    this->vertices[j*3+0] = this->vertices[j*3+0] * _scale.X();
-    this->vertices[j*3+1] = this->vertices[j*3+1] * _scale.Y();
-    this->vertices[j*3+2] = this->vertices[j*3+2] * _scale.Z();
+    vertices[j*3+0] = vertices[j*3+0] * _scale.X();
+    vertices[j*3+1] = vertices[j*3+1] * _scale.Y();
+    vertices[j*3+2] = vertices[j*3+2] * _scale.Z();
   }
 
   // Build the ODE triangle mesh
-  dGeomTriMeshDataBuildSingle(this->odeData,
-      this->vertices, 3*sizeof(this->vertices[0]), _numVertices,
-      this->indices, _numIndices, 3*sizeof(this->indices[0]));
+  dGeomTriMeshDataBuildSingle(_data->odeData,
+      _data->vertices, 3*sizeof(_data->vertices[0]), _numVertices,
+      _data->indices, _numIndices, 3*sizeof(_data->indices[0]));
+
+  if (!this->cacheKey.empty())
+  {
+    std::lock_guard<std::mutex> lock(dataCacheMutex);
+    dataCache[this->cacheKey] = _data;
+  }
 
+  // Keep the previous data alive until the geom stops using it
+  std::shared_ptr<ODETriMeshData> previous = this->data;
+  this->data = _data;
+  this->AttachData(_collision);
+}
+
+//////////////////////////////////////////////////
+void ODEMesh::AttachData(ODECollisionPtr _collision)
+{
   if (_collision->GetCollisionId() == nullptr)
   {
     _collision->SetSpaceId(dSimpleSpaceCreate(_collision->GetSpaceId()));
     _collision->SetCollision(dCreateTriMesh(_collision->GetSpaceId(),
-          this->odeData, 0, 0, 0), true);
+          this->data->odeData, 0, 0, 0), true);
   }
   else
   {
-    dGeomTriMeshSetData(_collision->GetCollisionId(), this->odeData);
+    dGeomTriMeshSetData(_collision->GetCollisionId(), this->data->odeData);
   }
+  this->collisionId = _collision->GetCollisionId();
 
   memset(this->transform, 0, 32*sizeof(dReal));
   this->transformIndex = 0;
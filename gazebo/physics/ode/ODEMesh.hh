@@ -18,6 +18,9 @@
 #ifndef GAZEBO_PHYSICS_ODE_ODEMESH_HH_
 #define GAZEBO_PHYSICS_ODE_ODEMESH_HH_
 
+#include <memory>
+#include <string>
+
 #include <ignition/math/Vector3.hh>
 
 #include "gazebo/physics/ode/ODETypes.hh"
@@ -29,6 +32,8 @@ namespace gazebo
 {
   namespace physics
   {
+    class ODETriMeshData;
+
     /// \addtogroup gazebo_physics_ode
     /// \{
 
@@ -41,6 +46,13 @@ namespace gazebo
       /// \brief Destructor.
       public: virtual ~ODEMesh();
 
+      /// \brief Share the trimesh data with the other meshes that have the
+      /// same key, so that it's only built once. Must be called before
+      /// Init.
+      /// \param[in] _key Key that identifies the mesh data and the scale,
+      /// see MeshShape::CollisionDataKey. An empty key disables sharing.
+      public: void SetCacheKey(const std::string &_key);
+
       /// \brief Create a mesh collision shape using a submesh.
       /// \param[in] _subMesh Pointer to the submesh.
       /// \param[in] _collision Pointer to the collision object.
@@ -60,28 +72,39 @@ namespace gazebo
       /// \brief Update the collision mesh.
       public: virtual void Update();
 
+      /// \brief Use the data of another mesh with the same cache key.
+      /// \param[in] _collision Pointer to the collision object.
+      /// \return True if data was found.
+      private: bool UseCachedData(ODECollisionPtr _collision);
+
       /// \brief Helper function to create the collision shape.
+      /// \param[in] _data Vertex and index arrays to build the data from.
       /// \param[in] _numVertices Number of vertices.
       /// \param[in] _numIndices Number of indices.
       /// \param[in] _collision Pointer to the collision object.
-      private: void CreateMesh(unsigned int _numVertices,
-                   unsigned int _numIndices, ODECollisionPtr _collision,
+      /// \param[in] _scale Scaling factor.
+      private: void CreateMesh(std::shared_ptr<ODETriMeshData> _data,
+                   unsigned int _numVertices, unsigned int _numIndices,
+                   ODECollisionPtr _collision,
                    const ignition::math::Vector3d &_scale);
 
+      /// \brief Attach the trimesh data to the collision, creating the
+      /// trimesh geom if needed.
+      /// \param[in] _collision Pointer to the collision object.
+      private: void AttachData(ODECollisionPtr _collision);
+
       /// \brief Transform matrix.
       private: dReal transform[16*2];
 
       /// \brief Transform matrix index.
       private: int transformIndex;
 
-      /// \brief Array of vertex values.
-      private: float *vertices;
-
-      /// \brief Array of index values.
-      private: int *indices;
+      /// \brief Key used to share the trimesh data, empty if the data isn't
+      /// shared.
+      private: std::string cacheKey;
 
-      /// \brief ODE trimesh data.
-      private: dTriMeshDataID odeData;
+      /// \brief The trimesh data, which may be shared with other meshes.
+      private: std::shared_ptr<ODETriMeshData> data;
 
       /// \brief The collision id that this mesh is attached to.
       private: dGeomID collisionId;
@@ -57,6 +57,9 @@ void ODEMeshShape::Init()
   if (!this->mesh)
     return;
 
+  // Identical mesh collisions share one trimesh data
+  this->odeMesh->SetCacheKey(this->CollisionDataKey());
+
   if (this->submesh)
   {
     this->odeMesh->Init(this->submesh,
@@ -14,6 +14,8 @@
  * limitations under the License.
  *
  */
+#include <vector>
+
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Exception.hh"
 
@@ -88,6 +90,38 @@ void ODEMultiRayShape::UpdateRays()
   if (ode == nullptr)
     gzthrow("Invalid physics engine. Must use ODE.");
 
+  // Rays of a sensor are cast as one batch, which ODEPhysics spreads over
+  // several threads.
+  if (this->defaultUpdate)
+  {
+    const size_t count = this->rays.size();
+    std::vector<ignition::math::Vector3d> origins(count);
+    std::vector<ignition::math::Vector3d> directions(count);
+    std::vector<double> lengths(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+      const RayShapePtr &ray = this->rays[i];
+      origins[i] = ray->globalStartPos;
+      directions[i] = (ray->globalEndPos - ray->globalStartPos).Normalized();
+      lengths[i] = ray->GetLength();
+    }
+
+    std::vector<double> distances;
+    std::vector<ODECollision *> collisions;
+    ode->CastODERays(origins, directions, lengths, distances, collisions);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+      if (collisions[i] && distances[i] < this->rays[i]->GetLength())
+      {
+        this->rays[i]->SetLength(distances[i]);
+        this->rays[i]->SetRetro(collisions[i]->GetLaserRetro());
+        this->rays[i]->SetCollisionName(collisions[i]->GetScopedName());
+      }
+    }
+    return;
+  }
+
   // Do we need to lock the physics engine here? YES!
   // especially when spawning models with sensors
   {
@@ -97,6 +131,9 @@ void ODEMultiRayShape::UpdateRays()
     dSpaceCollide2((dGeomID) (this->superSpaceId),
         (dGeomID) (ode->GetSpaceId()),
         this, &UpdateCallback);
+    dSpaceCollide2((dGeomID) (this->superSpaceId),
+        (dGeomID) (ode->StaticSpaceId()),
+        this, &UpdateCallback);
   }
 }
 
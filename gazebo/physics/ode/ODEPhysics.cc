@@ -17,23 +17,31 @@
 
 #include <tbb/parallel_for.h>
 #include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
 
 #include <sdf/sdf.hh>
 
 #include <algorithm>
+#include <limits>
 #include <map>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include <ignition/math/Helpers.hh>
+#include <ignition/math/Matrix3.hh>
 #include <ignition/math/Rand.hh>
 #include <ignition/math/Vector3.hh>
 #include <ignition/common/Profiler.hh>
 
+#include "gazebo/gazebo_config.h"
 #include "gazebo/util/Diagnostics.hh"
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Exception.hh"
+#include "gazebo/common/SamplingProfiler.hh"
 #include "gazebo/common/Time.hh"
 #include "gazebo/common/Timer.hh"
 
@@ -49,6 +57,10 @@
 #include "gazebo/physics/MapShape.hh"
 #include "gazebo/physics/ContactManager.hh"
 
+#ifdef HAVE_PARALLEL_QUICKSTEP
+#include <parallel_quickstep/parallel_quickstep.h>
+#endif
+
 #include "gazebo/physics/ode/ODECollision.hh"
 #include "gazebo/physics/ode/ODELink.hh"
 #include "gazebo/physics/ode/ODEScrewJoint.hh"
@@ -98,31 +110,396 @@ class ContactUpdate_TBB
 };
 */
 
-class Colliders_TBB
+/// \brief Runs the narrow phase of a range of colliders. Each worker
+/// thread collides into its own scratch buffer, and the selected contacts
+/// of each collider are copied out so that contact joints can be created
+/// afterwards in collider order.
+///
+/// When groups are given, the range is over the groups instead, and the
+/// colliders of a group are collided one after the other by the same
+/// worker.
+class Narrowphase_TBB
 {
-  public: Colliders_TBB(
+  public: Narrowphase_TBB(ODEPhysics *_engine,
               std::vector<std::pair<ODECollision*, ODECollision*> > *_colliders,
-              ODEPhysics *_engine,
-              dContactGeom* _contactCollisions) :
-    colliders(_colliders),
-              engine(_engine), contactCollisions(_contactCollisions)
+              std::vector<std::vector<dContactGeom> > *_contacts,
+              std::vector<bool> *_serial,
+              tbb::enumerable_thread_specific<std::vector<dContactGeom> >
+                *_scratch,
+              const std::vector<size_t> *_order = nullptr,
+              const std::vector<size_t> *_groups = nullptr)
+    : engine(_engine), colliders(_colliders), contacts(_contacts),
+      serial(_serial), scratch(_scratch), order(_order), groups(_groups)
   {
-    // dAllocateODEDataForThread(dAllocateMaskAll);
   }
 
   public: void operator() (const tbb::blocked_range<size_t> &_r) const
   {
+    // Collision detection needs ODE's per-thread data.
+    dAllocateODEDataForThread(dAllocateMaskAll);
+
+    std::vector<dContactGeom> &buffer = this->scratch->local();
+    buffer.resize(MAX_COLLIDE_RETURNS);
+    int indices[MAX_CONTACT_JOINTS];
+
     for (size_t i = _r.begin(); i != _r.end(); i++)
     {
-      ODECollision *collision1 = (*this->colliders)[i].first;
-      ODECollision *collision2 = (*this->colliders)[i].second;
-      this->engine->Collide(collision1, collision2, contactCollisions);
+      if (!this->groups)
+      {
+        this->Collide(i, buffer, indices);
+        continue;
+      }
+
+      for (size_t j = (*this->groups)[i]; j < (*this->groups)[i+1]; ++j)
+        this->Collide((*this->order)[j], buffer, indices);
     }
   }
 
-  private: std::vector< std::pair<ODECollision*, ODECollision*> > *colliders;
+  /// \brief Collide one collider.
+  /// \param[in] _index Index of the collider.
+  /// \param[in] _buffer Scratch buffer of the worker.
+  /// \param[in] _indices Scratch indices of the worker.
+  private: void Collide(const size_t _index,
+               std::vector<dContactGeom> &_buffer, int *_indices) const
+  {
+    std::vector<dContactGeom> &out = (*this->contacts)[_index];
+    out.clear();
+    if ((*this->serial)[_index])
+      return;
+
+    unsigned int numc = this->engine->Narrowphase(
+        (*this->colliders)[_index].first, (*this->colliders)[_index].second,
+        _buffer.data(), _indices);
+    for (unsigned int j = 0; j < numc; ++j)
+      out.push_back(_buffer[_indices[j]]);
+  }
+
   private: ODEPhysics *engine;
-  private: dContactGeom* contactCollisions;
+  private: std::vector<std::pair<ODECollision*, ODECollision*> > *colliders;
+  private: std::vector<std::vector<dContactGeom> > *contacts;
+  private: std::vector<bool> *serial;
+  private: tbb::enumerable_thread_specific<std::vector<dContactGeom> >
+             *scratch;
+  private: const std::vector<size_t> *order;
+  private: const std::vector<size_t> *groups;
+};
+
+/// \brief Kind of narrow phase of a pair of geom classes.
+enum PairKind : uint8_t
+{
+  /// \brief The pair must be collided from a single thread.
+  /// Transforms and heightfields write to per-geom temporary data while
+  /// colliding. Trimeshes write to their temporal coherence caches, so all
+  /// the colliders of a trimesh must be collided by the same thread.
+  kPairSerial = 1,
+
+  /// \brief ODE has no collider for the pair, dCollide never returns
+  /// contacts.
+  kPairNoCollider = 2
+};
+
+/// \brief Table of the narrow phase kind of every pair of geom classes,
+/// built at compile time so the hot path is a single lookup.
+/// \tparam N Number of geom classes.
+template <int N>
+struct GeomPairTable
+{
+  /// \brief Build the table.
+  constexpr GeomPairTable() : serial(), kind()
+  {
+    for (int i = 0; i < N; ++i)
+    {
+      serial[i] = i == dGeomTransformClass || i == dHeightfieldClass ||
+                  i == dTriMeshClass;
+    }
+
+    for (int i = 0; i < N; ++i)
+    {
+      for (int j = 0; j < N; ++j)
+      {
+        if (serial[i] || serial[j])
+          kind[i][j] |= kPairSerial;
+        if (Pair(i, j, dPlaneClass, dPlaneClass) ||
+            Pair(i, j, dRayClass, dRayClass) ||
+            Pair(i, j, dHeightfieldClass, dHeightfieldClass) ||
+            Pair(i, j, dHeightfieldClass, dPlaneClass))
+        {
+          kind[i][j] |= kPairNoCollider;
+        }
+      }
+    }
+  }
+
+  /// \brief Check if two classes are a given pair, in any order.
+  /// \param[in] _i First class.
+  /// \param[in] _j Second class.
+  /// \param[in] _a First class of the pair.
+  /// \param[in] _b Second class of the pair.
+  /// \return True if {_i, _j} is {_a, _b}.
+  static constexpr bool Pair(const int _i, const int _j,
+                             const int _a, const int _b)
+  {
+    return (_i == _a && _j == _b) || (_i == _b && _j == _a);
+  }
+
+  /// \brief True for the classes that make a pair kPairSerial.
+  bool serial[N];
+
+  /// \brief PairKind bits of each pair of classes.
+  uint8_t kind[N][N];
+};
+
+/// \brief Narrow phase kind of the pairs of geom classes.
+static constexpr GeomPairTable<dGeomNumClasses> kGeomPairs;
+
+/// \brief Get the geom class cached in the filter word of a collision.
+/// \param[in] _collision The collision.
+/// \return Geom class of the collision.
+static inline int FilterClass(const ODECollision *_collision)
+{
+  return (_collision->FilterWord() >> ODECollision::kFilterClassShift) & 0xff;
+}
+
+/// \brief Check if a geom can be collided from several threads at once.
+/// \param[in] _collision Collision to check.
+/// \return True if the narrow phase of the collision is thread safe.
+static bool NarrowphaseThreadSafe(const ODECollision *_collision)
+{
+  return !kGeomPairs.serial[FilterClass(_collision)];
+}
+
+/// \brief A collision that the rays of a batch are cast against.
+class RayTarget
+{
+  /// \brief Geom of the collision, in one of the world's spaces.
+  public: dGeomID geom;
+
+  /// \brief The collision.
+  public: ODECollision *collision;
+
+  /// \brief Bounding box of the geom: min x, max x, min y, max y, min z,
+  /// max z.
+  public: dReal aabb[6];
+
+  /// \brief True if the geom must not be collided from several threads
+  /// at once.
+  public: bool serial;
+};
+
+/// \brief Collect the geoms of a space that sensor rays collide with.
+/// \param[in] _space Space to walk, recursively.
+/// \param[out] _targets Geoms of the space.
+static void GatherRayTargets(dSpaceID _space, std::vector<RayTarget> &_targets)
+{
+  const int count = dSpaceGetNumGeoms(_space);
+  for (int i = 0; i < count; ++i)
+  {
+    dGeomID geom = dSpaceGetGeom(_space, i);
+    if (dGeomIsSpace(geom))
+    {
+      GatherRayTargets(reinterpret_cast<dSpaceID>(geom), _targets);
+      continue;
+    }
+
+    const int geomClass = dGeomGetClass(geom);
+    if (geomClass == dRayClass || !dGeomIsEnabled(geom))
+      continue;
+
+    // Same filter as dSpaceCollide2 with a ray of the GZ_SENSOR_COLLIDE
+    // category that collides with everything else.
+    if ((dGeomGetCollideBits(geom) & GZ_SENSOR_COLLIDE) == 0 &&
+        (dGeomGetCategoryBits(geom) & ~GZ_SENSOR_COLLIDE) == 0)
+    {
+      continue;
+    }
+
+    dGeomID dataGeom = geomClass == dGeomTransformClass ?
+        dGeomTransformGetGeom(geom) : geom;
+    ODECollision *collision =
+        static_cast<ODECollision *>(dGeomGetData(dataGeom));
+    if (!collision)
+      continue;
+
+    RayTarget target;
+    target.geom = geom;
+    target.collision = collision;
+    dGeomGetAABB(geom, target.aabb);
+    target.serial = geomClass == dGeomTransformClass ||
+                    geomClass == dHeightfieldClass;
+    _targets.push_back(target);
+  }
+}
+
+/// \brief State of the sweep of a CCD link.
+class CCDSweep
+{
+  /// \brief Ray cast from the center of the link along its velocity.
+  public: dGeomID ray;
+
+  /// \brief The link being swept.
+  public: const Link *link;
+
+  /// \brief Collide bitmasks of the link's collisions.
+  public: uint32_t mask;
+
+  /// \brief Stamp of the current collision pass.
+  public: uint64_t stamp;
+
+  /// \brief Distance to the closest hit along the ray.
+  public: double distance;
+};
+
+/// \brief Collision callback of the CCD ray, keeps the closest hit that
+/// would generate contacts with the link.
+/// \param[in] _data The CCDSweep.
+/// \param[in] _o1 First geom.
+/// \param[in] _o2 Second geom.
+static void CCDRayCallback(void *_data, dGeomID _o1, dGeomID _o2)
+{
+  CCDSweep *sweep = static_cast<CCDSweep *>(_data);
+  if (dGeomIsSpace(_o1) || dGeomIsSpace(_o2))
+  {
+    dSpaceCollide2(_o1, _o2, _data, &CCDRayCallback);
+    return;
+  }
+
+  dGeomID geom = _o1 == sweep->ray ? _o2 : _o1;
+  const int geomClass = dGeomGetClass(geom);
+  if (geomClass == dRayClass || !dGeomIsEnabled(geom) ||
+      (dGeomGetCategoryBits(geom) & ~GZ_SENSOR_COLLIDE) == 0)
+  {
+    return;
+  }
+
+  dGeomID dataGeom = geomClass == dGeomTransformClass ?
+      dGeomTransformGetGeom(geom) : geom;
+  ODECollision *collision =
+      static_cast<ODECollision *>(dGeomGetData(dataGeom));
+  if (!collision || collision->GetLink().get() == sweep->link)
+    return;
+
+  collision->UpdateFilter(sweep->stamp);
+  if ((collision->FilterWord() & ODECollision::kFilterNoContact) ||
+      (collision->FilterMask() & sweep->mask) == 0)
+  {
+    return;
+  }
+
+  dContactGeom contact;
+  if (dCollide(sweep->ray, geom, 1, &contact, sizeof(contact)) > 0 &&
+      contact.depth < sweep->distance)
+  {
+    sweep->distance = contact.depth;
+  }
+}
+
+/// \brief Spread the lower 10 bits of a value so that there are two zero
+/// bits between each of them.
+/// \param[in] _v Value to spread.
+/// \return Spread value.
+static uint32_t SpreadBits(uint32_t _v)
+{
+  _v &= 0x3ff;
+  _v = (_v | (_v << 16)) & 0x030000ff;
+  _v = (_v | (_v << 8)) & 0x0300f00f;
+  _v = (_v | (_v << 4)) & 0x030c30c3;
+  _v = (_v | (_v << 2)) & 0x09249249;
+  return _v;
+}
+
+/// \brief Casts a range of rays of a batch. Each worker uses its own ray
+/// geom, and collides it directly against the gathered targets, so the
+/// world's spaces are only read.
+class CastRays_TBB
+{
+  public: CastRays_TBB(const std::vector<RayTarget> *_targets,
+              const std::vector<uint32_t> *_order,
+              const std::vector<ignition::math::Vector3d> *_origins,
+              const std::vector<ignition::math::Vector3d> *_directions,
+              const std::vector<double> *_lengths,
+              std::vector<double> *_distances,
+              std::vector<ODECollision *> *_collisions,
+              std::mutex *_serialMutex)
+    : targets(_targets), order(_order), origins(_origins),
+      directions(_directions), lengths(_lengths), distances(_distances),
+      collisions(_collisions), serialMutex(_serialMutex)
+  {
+  }
+
+  public: void operator() (const tbb::blocked_range<size_t> &_r) const
+  {
+    // Collision detection needs ODE's per-thread data.
+    dAllocateODEDataForThread(dAllocateMaskAll);
+
+    dGeomID ray = dCreateRay(0, 1.0);
+    dGeomRaySetParams(ray, 0, 0);
+    dGeomRaySetClosestHit(ray, 1);
+
+    dContactGeom contact;
+    for (size_t k = _r.begin(); k != _r.end(); ++k)
+    {
+      const uint32_t i = (*this->order)[k];
+      const ignition::math::Vector3d &origin = (*this->origins)[i];
+      const ignition::math::Vector3d dir = (*this->directions)[i].Normalized();
+      const double length = (*this->lengths)[i];
+      const ignition::math::Vector3d end = origin + dir * length;
+
+      ignition::math::Vector3d min = origin;
+      ignition::math::Vector3d max = origin;
+      min.Min(end);
+      max.Max(end);
+
+      dGeomRaySet(ray, origin.X(), origin.Y(), origin.Z(),
+          dir.X(), dir.Y(), dir.Z());
+      dGeomRaySetLength(ray, length);
+
+      double best = length;
+      ODECollision *hit = nullptr;
+      for (const auto &target : *this->targets)
+      {
+        if (target.aabb[0] > max.X() || target.aabb[1] < min.X() ||
+            target.aabb[2] > max.Y() || target.aabb[3] < min.Y() ||
+            target.aabb[4] > max.Z() || target.aabb[5] < min.Z())
+        {
+          continue;
+        }
+
+        int n;
+        if (target.serial)
+        {
+          std::lock_guard<std::mutex> lock(*this->serialMutex);
+          n = dCollide(ray, target.geom, 1, &contact, sizeof(contact));
+        }
+        else
+        {
+          n = dCollide(ray, target.geom, 1, &contact, sizeof(contact));
+        }
+
+        if (n > 0 && contact.depth < best)
+        {
+          best = contact.depth;
+          hit = target.collision;
+        }
+      }
+
+      if (hit)
+      {
+        (*this->distances)[i] = best;
+        (*this->collisions)[i] = hit;
+      }
+    }
+
+    dGeomDestroy(ray);
+  }
+
+  private: const std::vector<RayTarget> *targets;
+  private: const std::vector<uint32_t> *order;
+  private: const std::vector<ignition::math::Vector3d> *origins;
+  private: const std::vector<ignition::math::Vector3d> *directions;
+  private: const std::vector<double> *lengths;
+  private: std::vector<double> *distances;
+  private: std::vector<ODECollision *> *collisions;
+  private: std::mutex *serialMutex;
 };
 
 //////////////////////////////////////////////////
@@ -130,6 +507,29 @@ extern "C" void dMessageQuiet(int, const char *, va_list)
 {
 }
 
+//////////////////////////////////////////////////
+/// \brief Start a profiler sample for an island, called by ODE from the
+/// thread that steps it.
+static void IslandBegin(void *, int, int)
+{
+  // The island threads belong to ODE's pool, name them the first time
+  // they step an island.
+  static thread_local bool named = false;
+  if (!named)
+  {
+    common::SetThreadName("ODEIsland");
+    named = true;
+  }
+  IGN_PROFILE_BEGIN("dxProcessOneIsland");
+}
+
+//////////////////////////////////////////////////
+/// \brief End the profiler sample of an island.
+static void IslandEnd(void *, int, int)
+{
+  IGN_PROFILE_END();
+}
+
 //////////////////////////////////////////////////
 ODEPhysics::ODEPhysics(WorldPtr _world)
     : PhysicsEngine(_world), dataPtr(new ODEPhysicsPrivate)
@@ -143,14 +543,23 @@ ODEPhysics::ODEPhysics(WorldPtr _world)
   dAllocateODEDataForThread(dAllocateMaskAll);
 
   this->dataPtr->worldId = dWorldCreate();
+  dWorldSetIslandCallbacks(this->dataPtr->worldId, &IslandBegin, &IslandEnd,
+      nullptr);
 
   this->dataPtr->spaceId = dHashSpaceCreate(0);
-  dHashSpaceSetLevels(this->dataPtr->spaceId, -2, 8);
+  dHashSpaceSetLevels(this->dataPtr->spaceId, this->dataPtr->hashMinLevel,
+      this->dataPtr->hashMaxLevel);
+  this->dataPtr->staticSpaceId = dHashSpaceCreate(0);
+  dHashSpaceSetLevels(this->dataPtr->staticSpaceId,
+      this->dataPtr->hashMinLevel, this->dataPtr->hashMaxLevel);
 
   this->dataPtr->contactGroup = dJointGroupCreate(0);
 
   this->dataPtr->colliders.resize(100);
 
+  for (int i = 0; i < MAX_CONTACT_JOINTS; ++i)
+    this->dataPtr->identityIndices[i] = i;
+
   // Set random seed for physics engine based on gazebo's random seed.
   // Note: this was moved from physics::PhysicsEngine constructor.
   this->SetSeed(ignition::math::Rand::Seed());
@@ -230,6 +639,103 @@ void ODEPhysics::Load(sdf::ElementPtr _sdf)
     this->GetSORPGSIters());
   dWorldSetQuickStepW(this->dataPtr->worldId, this->GetSORPGSW());
 
+  // With a tolerance, quickstep stops once the residual is small enough,
+  // but not before this many iterations.
+  {
+    sdf::ElementPtr solverElem = odeElem->GetElement("solver");
+    const std::string kElementName = "ignition:min_iters";
+    if (solverElem->HasElement(kElementName))
+    {
+      dWorldSetQuickStepMinIterations(this->dataPtr->worldId,
+          solverElem->Get<int>(kElementName));
+    }
+  }
+
+  this->dataPtr->diagnosticsPub =
+      this->node->Advertise<msgs::Param_V>("~/physics/diagnostics");
+
+  {
+    const std::string kElementName = "ignition:parallel_collision";
+    if (odeElem->HasElement(kElementName))
+      this->dataPtr->parallelCollision = odeElem->Get<bool>(kElementName);
+  }
+  {
+    const std::string kElementName = "ignition:trimesh_temporal_coherence";
+    if (odeElem->HasElement(kElementName))
+    {
+      this->dataPtr->trimeshTemporalCoherence =
+          odeElem->Get<bool>(kElementName);
+    }
+  }
+
+  {
+    const std::string kElementName = "ignition:contact_warm_start";
+    if (odeElem->HasElement(kElementName))
+      this->dataPtr->contactWarmStart = odeElem->Get<bool>(kElementName);
+  }
+  {
+    const std::string kElementName = "ignition:contact_warm_start_distance";
+    if (odeElem->HasElement(kElementName))
+    {
+      this->dataPtr->contactWarmStartDistance =
+          odeElem->Get<double>(kElementName);
+    }
+  }
+
+  // Broadphase space. The parameters are read before the type, so that the
+  // space is only created once.
+  {
+    const std::string kElementName = "ignition:space_hash_min_level";
+    if (odeElem->HasElement(kElementName))
+      this->dataPtr->hashMinLevel = odeElem->Get<int>(kElementName);
+  }
+  {
+    const std::string kElementName = "ignition:space_hash_max_level";
+    if (odeElem->HasElement(kElementName))
+      this->dataPtr->hashMaxLevel = odeElem->Get<int>(kElementName);
+  }
+  {
+    const std::string kElementName = "ignition:space_quadtree_center";
+    if (odeElem->HasElement(kElementName))
+    {
+      this->dataPtr->quadTreeCenter =
+          odeElem->Get<ignition::math::Vector3d>(kElementName);
+    }
+  }
+  {
+    const std::string kElementName = "ignition:space_quadtree_extents";
+    if (odeElem->HasElement(kElementName))
+    {
+      this->dataPtr->quadTreeExtents =
+          odeElem->Get<ignition::math::Vector3d>(kElementName);
+    }
+  }
+  {
+    const std::string kElementName = "ignition:space_quadtree_depth";
+    if (odeElem->HasElement(kElementName))
+      this->dataPtr->quadTreeDepth = odeElem->Get<int>(kElementName);
+  }
+  {
+    std::string spaceType = "hash";
+    const std::string kElementName = "ignition:space_type";
+    if (odeElem->HasElement(kElementName))
+      spaceType = odeElem->Get<std::string>(kElementName);
+    if (spaceType != "hash")
+      this->SetSpaceType(spaceType);
+    else
+    {
+      dHashSpaceSetLevels(this->dataPtr->spaceId, this->dataPtr->hashMinLevel,
+          this->dataPtr->hashMaxLevel);
+    }
+  }
+  dHashSpaceSetLevels(this->dataPtr->staticSpaceId,
+      this->dataPtr->hashMinLevel, this->dataPtr->hashMaxLevel);
+  {
+    const std::string kElementName = "ignition:static_space";
+    if (odeElem->HasElement(kElementName))
+      this->dataPtr->staticSpace = odeElem->Get<bool>(kElementName);
+  }
+
   // Set the physics update function
   this->SetStepType(this->dataPtr->stepType);
   if (this->dataPtr->physicsStepFunc == nullptr)
@@ -353,7 +859,7 @@ void ODEPhysics::Init()
 //////////////////////////////////////////////////
 void ODEPhysics::InitForThread()
 {
-  IGN_PROFILE_THREAD_NAME("ODEPhysics");
+  common::SetThreadName("ODEPhysics");
   dAllocateODEDataForThread(dAllocateMaskAll);
 }
 
@@ -367,6 +873,13 @@ void ODEPhysics::UpdateCollision()
   boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
   dJointGroupEmpty(this->dataPtr->contactGroup);
 
+  // The joints of the last collision pass are gone. If the world was
+  // stepped since, their impulses are already in prevContactImpulses.
+  this->dataPtr->contactImpulses.clear();
+
+  // Collisions refresh their cached filter data on first use in this pass
+  ++this->dataPtr->filterStamp;
+
   unsigned int i = 0;
   this->dataPtr->collidersCount = 0;
   this->dataPtr->trimeshCollidersCount = 0;
@@ -377,15 +890,64 @@ void ODEPhysics::UpdateCollision()
 
   // Do collision detection; this will add contacts to the contact group
   dSpaceCollide(this->dataPtr->spaceId, this, CollisionCallback);
+  // Static collisions are only tested against the others
+  dSpaceCollide2(reinterpret_cast<dGeomID>(this->dataPtr->staticSpaceId),
+      reinterpret_cast<dGeomID>(this->dataPtr->spaceId), this,
+      CollisionCallback);
   DIAG_TIMER_LAP("ODEPhysics::UpdateCollision", "dSpaceCollide");
   IGN_PROFILE_END();
 
   IGN_PROFILE_BEGIN("collideShapes");
   // Generate non-trimesh collisions.
-  for (i = 0; i < this->dataPtr->collidersCount; ++i)
+  if (this->dataPtr->parallelCollision && this->dataPtr->collidersCount > 1)
+  {
+    const unsigned int count = this->dataPtr->collidersCount;
+    this->dataPtr->colliderContacts.resize(count);
+    this->dataPtr->serialColliders.resize(count);
+    for (i = 0; i < count; ++i)
+    {
+      this->dataPtr->serialColliders[i] = (kGeomPairs.kind
+          [FilterClass(this->dataPtr->colliders[i].first)]
+          [FilterClass(this->dataPtr->colliders[i].second)] &
+          kPairSerial) != 0;
+    }
+
+    // Narrow phase on the TBB pool
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, count,
+          this->dataPtr->collisionGrainSize),
+        Narrowphase_TBB(this, &this->dataPtr->colliders,
+          &this->dataPtr->colliderContacts, &this->dataPtr->serialColliders,
+          &this->dataPtr->narrowphaseScratch));
+    DIAG_TIMER_LAP("ODEPhysics::UpdateCollision", "narrowphase");
+
+    // Create the contact joints in collider order, so the result doesn't
+    // depend on the scheduling of the threads.
+    for (i = 0; i < count; ++i)
+    {
+      ODECollision *collision1 = this->dataPtr->colliders[i].first;
+      ODECollision *collision2 = this->dataPtr->colliders[i].second;
+      if (this->dataPtr->serialColliders[i])
+      {
+        this->Collide(collision1, collision2,
+            this->dataPtr->contactCollisions);
+      }
+      else if (!this->dataPtr->colliderContacts[i].empty())
+      {
+        this->AddContactJoints(collision1, collision2,
+            this->dataPtr->colliderContacts[i].data(),
+            this->dataPtr->identityIndices,
+            this->dataPtr->colliderContacts[i].size());
+      }
+    }
+  }
+  else
   {
-    this->Collide(this->dataPtr->colliders[i].first,
-        this->dataPtr->colliders[i].second, this->dataPtr->contactCollisions);
+    for (i = 0; i < this->dataPtr->collidersCount; ++i)
+    {
+      this->Collide(this->dataPtr->colliders[i].first,
+          this->dataPtr->colliders[i].second,
+          this->dataPtr->contactCollisions);
+    }
   }
   DIAG_TIMER_LAP("ODEPhysics::UpdateCollision", "collideShapes");
   IGN_PROFILE_END();
@@ -393,12 +955,63 @@ void ODEPhysics::UpdateCollision()
 
   IGN_PROFILE_BEGIN("collideTrimeshes");
   // Generate trimesh collision.
-  // This must happen in this thread sequentially
-  for (i = 0; i < this->dataPtr->trimeshCollidersCount; ++i)
+  const unsigned int trimeshCount = this->dataPtr->trimeshCollidersCount;
+  const int tc = this->dataPtr->trimeshTemporalCoherence ? 1 : 0;
+  for (i = 0; i < trimeshCount; ++i)
   {
-    ODECollision *collision1 = this->dataPtr->trimeshColliders[i].first;
-    ODECollision *collision2 = this->dataPtr->trimeshColliders[i].second;
-    this->Collide(collision1, collision2, this->dataPtr->contactCollisions);
+    for (ODECollision *collision : {this->dataPtr->trimeshColliders[i].first,
+                                    this->dataPtr->trimeshColliders[i].second})
+    {
+      dGeomID id = collision->GetCollisionId();
+      if (dGeomGetClass(id) != dTriMeshClass)
+        continue;
+      dGeomTriMeshEnableTC(id, dSphereClass, tc);
+      dGeomTriMeshEnableTC(id, dBoxClass, tc);
+      dGeomTriMeshEnableTC(id, dCapsuleClass, tc);
+    }
+  }
+
+  if (this->dataPtr->parallelCollision && trimeshCount > 1)
+  {
+    this->GroupTrimeshColliders();
+
+    // Each worker collides whole groups, so that the caches of a mesh are
+    // only used by one thread at a time.
+    tbb::parallel_for(tbb::blocked_range<size_t>(0,
+          this->dataPtr->trimeshGroups.size() - 1),
+        Narrowphase_TBB(this, &this->dataPtr->trimeshColliders,
+          &this->dataPtr->trimeshContacts,
+          &this->dataPtr->serialTrimeshColliders,
+          &this->dataPtr->narrowphaseScratch, &this->dataPtr->trimeshOrder,
+          &this->dataPtr->trimeshGroups));
+    DIAG_TIMER_LAP("ODEPhysics::UpdateCollision", "trimeshNarrowphase");
+
+    for (i = 0; i < trimeshCount; ++i)
+    {
+      ODECollision *collision1 = this->dataPtr->trimeshColliders[i].first;
+      ODECollision *collision2 = this->dataPtr->trimeshColliders[i].second;
+      if (this->dataPtr->serialTrimeshColliders[i])
+      {
+        this->Collide(collision1, collision2,
+            this->dataPtr->contactCollisions);
+      }
+      else if (!this->dataPtr->trimeshContacts[i].empty())
+      {
+        this->AddContactJoints(collision1, collision2,
+            this->dataPtr->trimeshContacts[i].data(),
+            this->dataPtr->identityIndices,
+            this->dataPtr->trimeshContacts[i].size());
+      }
+    }
+  }
+  else
+  {
+    for (i = 0; i < trimeshCount; ++i)
+    {
+      ODECollision *collision1 = this->dataPtr->trimeshColliders[i].first;
+      ODECollision *collision2 = this->dataPtr->trimeshColliders[i].second;
+      this->Collide(collision1, collision2, this->dataPtr->contactCollisions);
+    }
   }
   DIAG_TIMER_LAP("UpdateCollision", "collideTrimeshes");
   IGN_PROFILE_END();
@@ -416,39 +1029,68 @@ void ODEPhysics::UpdatePhysics()
   {
     boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
 
+    this->SweepCCDLinks(this->maxStepSize);
+
     // Update the dynamical model
     (*(this->dataPtr->physicsStepFunc))
       (this->dataPtr->worldId, this->maxStepSize);
 
+    this->RestoreCCDVelocities();
+
+    if (this->dataPtr->contactWarmStart)
+      this->StoreContactImpulses();
+
+    if (this->dataPtr->diagnosticsPub &&
+        this->dataPtr->diagnosticsPub->HasConnections())
+    {
+      this->PublishDiagnostics();
+    }
+
     ignition::math::Vector3d f1, f2, t1, t2;
 
+    // Rotations from world to link frame. Consecutive feedbacks are often
+    // between the same links, so the last ones are kept.
+    const Link *link1 = nullptr;
+    const Link *link2 = nullptr;
+    ignition::math::Matrix3d rot1;
+    ignition::math::Matrix3d rot2;
+
     // Set the joint contact feedback for each contact.
     for (unsigned int i = 0; i < this->dataPtr->jointFeedbackIndex; ++i)
     {
-      Contact *contactFeedback = this->dataPtr->jointFeedbacks[i]->contact;
+      ODEJointFeedback &jointFeedback = this->dataPtr->jointFeedbacks[i];
+      Contact *contactFeedback = jointFeedback.contact;
       Collision *col1 = contactFeedback->collision1;
       Collision *col2 = contactFeedback->collision2;
 
       GZ_ASSERT(col1 != nullptr, "Collision 1 is null");
       GZ_ASSERT(col2 != nullptr, "Collision 2 is null");
 
-      for (int j = 0; j < this->dataPtr->jointFeedbacks[i]->count; ++j)
+      if (col1->GetLink().get() != link1)
       {
-        dJointFeedback fb = this->dataPtr->jointFeedbacks[i]->feedbacks[j];
+        link1 = col1->GetLink().get();
+        rot1 = ignition::math::Matrix3d(link1->WorldPose().Rot()).Transposed();
+      }
+      if (col2->GetLink().get() != link2)
+      {
+        link2 = col2->GetLink().get();
+        rot2 = ignition::math::Matrix3d(link2->WorldPose().Rot()).Transposed();
+      }
+
+      for (int j = 0; j < jointFeedback.count; ++j)
+      {
+        const dJointFeedback &fb = jointFeedback.feedbacks[j];
         f1.Set(fb.f1[0], fb.f1[1], fb.f1[2]);
         f2.Set(fb.f2[0], fb.f2[1], fb.f2[2]);
         t1.Set(fb.t1[0], fb.t1[1], fb.t1[2]);
         t2.Set(fb.t2[0], fb.t2[1], fb.t2[2]);
 
         // set force torque in link frame
-        this->dataPtr->jointFeedbacks[i]->contact->wrench[j].body1Force =
-             col1->GetLink()->WorldPose().Rot().RotateVectorReverse(f1);
-        this->dataPtr->jointFeedbacks[i]->contact->wrench[j].body2Force =
-             col2->GetLink()->WorldPose().Rot().RotateVectorReverse(f2);
-        this->dataPtr->jointFeedbacks[i]->contact->wrench[j].body1Torque =
-             col1->GetLink()->WorldPose().Rot().RotateVectorReverse(t1);
-        this->dataPtr->jointFeedbacks[i]->contact->wrench[j].body2Torque =
-             col2->GetLink()->WorldPose().Rot().RotateVectorReverse(t2);
+        JointWrench &wrench = contactFeedback->wrench[j];
+        wrench.body1Force = rot1 * f1;
+        wrench.body2Force = rot2 * f2;
+        wrench.body1Torque = rot1 * t1;
+        wrench.body2Torque = rot2 * t2;
       }
     }
   }
@@ -456,6 +1098,36 @@ void ODEPhysics::UpdatePhysics()
   DIAG_TIMER_STOP("ODEPhysics::UpdatePhysics");
 }
 
+//////////////////////////////////////////////////
+void ODEPhysics::PublishDiagnostics()
+{
+  // Only quickstep iterates.
+  if (this->dataPtr->stepType != "quick")
+    return;
+
+  msgs::Param_V msg;
+  auto addParam = [&msg](const std::string &_name, const msgs::Any &_value)
+  {
+    msgs::Param *param = msg.add_param();
+    param->set_name(_name);
+    param->mutable_value()->CopyFrom(_value);
+  };
+
+  addParam("sim_time", msgs::ConvertAny(this->world->SimTime().Double()));
+  addParam("iterations", msgs::ConvertAny(
+      dWorldGetQuickStepIterationsUsed(this->dataPtr->worldId)));
+  addParam("min_iterations", msgs::ConvertAny(
+      dWorldGetQuickStepMinIterations(this->dataPtr->worldId)));
+  addParam("max_iterations", msgs::ConvertAny(
+      dWorldGetQuickStepNumIterations(this->dataPtr->worldId)));
+  addParam("constraint_residual", msgs::ConvertAny(static_cast<double>(
+      dWorldGetQuickStepRMSConstraintResidual(this->dataPtr->worldId)[3])));
+  addParam("num_contacts", msgs::ConvertAny(
+      dWorldGetQuickStepNumContacts(this->dataPtr->worldId)));
+
+  this->dataPtr->diagnosticsPub->Publish(msg);
+}
+
 //////////////////////////////////////////////////
 void ODEPhysics::Fini()
 {
@@ -466,19 +1138,29 @@ void ODEPhysics::Fini()
   this->dataPtr->contactGroup = nullptr;
 
   // Delete all the joint feedbacks.
-  for (auto iter = this->dataPtr->jointFeedbacks.begin();
-      iter != this->dataPtr->jointFeedbacks.end(); ++iter)
-  {
-    delete *iter;
-  }
   this->dataPtr->jointFeedbacks.clear();
 
+  this->dataPtr->diagnosticsPub.reset();
+
+  this->dataPtr->ccdLinks.clear();
+  this->dataPtr->ccdCorrections.clear();
+  if (this->dataPtr->ccdRay)
+    dGeomDestroy(this->dataPtr->ccdRay);
+  this->dataPtr->ccdRay = nullptr;
+
   if (this->dataPtr->spaceId)
   {
     dSpaceSetCleanup(this->dataPtr->spaceId, 0);
     dSpaceDestroy(this->dataPtr->spaceId);
   }
 
+  if (this->dataPtr->staticSpaceId)
+  {
+    dSpaceSetCleanup(this->dataPtr->staticSpaceId, 0);
+    dSpaceDestroy(this->dataPtr->staticSpaceId);
+  }
+  this->dataPtr->staticSpaceId = nullptr;
+
   if (this->dataPtr->worldId)
     dWorldDestroy(this->dataPtr->worldId);
   this->dataPtr->worldId = nullptr;
@@ -494,6 +1176,26 @@ void ODEPhysics::Reset()
   boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
   // Very important to clear out the contact group
   dJointGroupEmpty(this->dataPtr->contactGroup);
+  this->dataPtr->contactImpulses.clear();
+  this->dataPtr->prevContactImpulses.clear();
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::StoreContactImpulses()
+{
+  for (auto &pair : this->dataPtr->contactImpulses)
+  {
+    for (auto &impulse : pair.second)
+    {
+      dJointGetLambda(impulse.joint, impulse.lambda, impulse.lambdaErp);
+      impulse.joint = nullptr;
+      impulse.matched = false;
+    }
+  }
+
+  // Contact pairs that are no longer in contact are dropped.
+  this->dataPtr->prevContactImpulses.swap(this->dataPtr->contactImpulses);
+  this->dataPtr->contactImpulses.clear();
 }
 
 //////////////////////////////////////////////////
@@ -506,8 +1208,11 @@ LinkPtr ODEPhysics::CreateLink(ModelPtr _parent)
   iter = this->dataPtr->spaces.find(_parent->GetName());
 
   if (iter == this->dataPtr->spaces.end())
+  {
     this->dataPtr->spaces[_parent->GetName()] =
-      dSimpleSpaceCreate(this->dataPtr->spaceId);
+      dSimpleSpaceCreate(this->dataPtr->staticSpace && _parent->IsStatic() ?
+          this->dataPtr->staticSpaceId : this->dataPtr->spaceId);
+  }
 
   ODELinkPtr link(new ODELink(_parent));
 
@@ -912,6 +1617,41 @@ dSpaceID ODEPhysics::GetSpaceId() const
   return this->dataPtr->spaceId;
 }
 
+//////////////////////////////////////////////////
+dSpaceID ODEPhysics::StaticSpaceId() const
+{
+  return this->dataPtr->staticSpaceId;
+}
+
+//////////////////////////////////////////////////
+bool ODEPhysics::StaticSpaceEnabled() const
+{
+  return this->dataPtr->staticSpace;
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::SetStaticSpaceEnabled(const bool _enable)
+{
+  boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+  this->dataPtr->staticSpace = _enable;
+
+  // Move the per-model spaces of static models
+  for (auto const &space : this->dataPtr->spaces)
+  {
+    ModelPtr model = this->world->ModelByName(space.first);
+    dSpaceID target = _enable && model && model->IsStatic() ?
+        this->dataPtr->staticSpaceId : this->dataPtr->spaceId;
+    dGeomID geom = reinterpret_cast<dGeomID>(space.second);
+    dSpaceID current = dGeomGetSpace(geom);
+    if (current != target)
+    {
+      if (current)
+        dSpaceRemove(current, geom);
+      dSpaceAdd(target, geom);
+    }
+  }
+}
+
 //////////////////////////////////////////////////
 std::string ODEPhysics::GetStepType() const
 {
@@ -931,11 +1671,84 @@ void ODEPhysics::SetStepType(const std::string &_type)
     this->dataPtr->physicsStepFunc = &dWorldQuickStep;
   else if (this->dataPtr->stepType == "world")
     this->dataPtr->physicsStepFunc = &dWorldStep;
+  else if (this->dataPtr->stepType == "parallel_quick")
+  {
+#ifdef HAVE_PARALLEL_QUICKSTEP
+    this->dataPtr->physicsStepFunc = &dWorldParallelQuickStep;
+#else
+    gzwarn << "Gazebo was built without the parallel quickstep solver, "
+           << "using quick instead" << std::endl;
+    this->dataPtr->physicsStepFunc = &dWorldQuickStep;
+#endif
+  }
   else
     gzerr << "Invalid step type[" << this->dataPtr->stepType
           << "]" << std::endl;
 }
 
+//////////////////////////////////////////////////
+std::string ODEPhysics::SpaceType() const
+{
+  return this->dataPtr->spaceType;
+}
+
+//////////////////////////////////////////////////
+bool ODEPhysics::SetSpaceType(const std::string &_type)
+{
+  dSpaceID space = nullptr;
+  if (_type == "hash")
+  {
+    space = dHashSpaceCreate(0);
+    dHashSpaceSetLevels(space, this->dataPtr->hashMinLevel,
+        this->dataPtr->hashMaxLevel);
+  }
+  else if (_type == "sap")
+  {
+    // Worlds are mostly laid out in the XY plane, sort along those first.
+    space = dSweepAndPruneSpaceCreate(0, dSAP_AXES_XYZ);
+  }
+  else if (_type == "quadtree")
+  {
+    const auto &center = this->dataPtr->quadTreeCenter;
+    const auto &extents = this->dataPtr->quadTreeExtents;
+    dVector3 c, e;
+    c[0] = center.X();
+    c[1] = center.Y();
+    c[2] = center.Z();
+    e[0] = extents.X();
+    e[1] = extents.Y();
+    e[2] = extents.Z();
+    space = dQuadTreeSpaceCreate(0, c, e, this->dataPtr->quadTreeDepth);
+  }
+  else
+  {
+    gzerr << "Invalid space type[" << _type << "], "
+          << "expected hash, sap or quadtree" << std::endl;
+    return false;
+  }
+
+  boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+
+  // Move the per-model spaces, and any geom that is directly in the top
+  // level space, to the new space.
+  dSpaceID oldSpace = this->dataPtr->spaceId;
+  if (oldSpace)
+  {
+    while (dSpaceGetNumGeoms(oldSpace) > 0)
+    {
+      dGeomID geom = dSpaceGetGeom(oldSpace, 0);
+      dSpaceRemove(oldSpace, geom);
+      dSpaceAdd(space, geom);
+    }
+    dSpaceSetCleanup(oldSpace, 0);
+    dSpaceDestroy(oldSpace);
+  }
+
+  this->dataPtr->spaceId = space;
+  this->dataPtr->spaceType = _type;
+  return true;
+}
+
 //////////////////////////////////////////////////
 void ODEPhysics::SetGravity(const ignition::math::Vector3d &_gravity)
 {
@@ -996,9 +1809,12 @@ void ODEPhysics::CollisionCallback(void *_data, dGeomID _o1, dGeomID _o2)
     // Make sure both collision pointers are valid.
     if (collision1 && collision2)
     {
+      collision1->UpdateFilter(self->dataPtr->filterStamp);
+      collision2->UpdateFilter(self->dataPtr->filterStamp);
+
       // Add either a tri-mesh collider or a regular collider.
-      if (collision1->HasType(Base::MESH_SHAPE) ||
-          collision2->HasType(Base::MESH_SHAPE))
+      if ((collision1->FilterWord() | collision2->FilterWord()) &
+          ODECollision::kFilterMesh)
         self->AddTrimeshCollider(collision1, collision2);
       else
       {
@@ -1013,24 +1829,228 @@ void ODEPhysics::CollisionCallback(void *_data, dGeomID _o1, dGeomID _o2)
 void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
                          dContactGeom *_contactCollisions)
 {
-  // Filter collisions based on collide bitmask.
-  if ((_collision1->GetSurface()->collideBitmask &
-        _collision2->GetSurface()->collideBitmask) == 0)
+  unsigned int numc = this->Narrowphase(_collision1, _collision2,
+      _contactCollisions, this->dataPtr->indices);
+
+  // Return if no contacts.
+  if (numc == 0)
     return;
 
-  // Filter collisions based on contact bitmask if collide_without_contact is
-  // on.The bitmask is set mainly for speed improvements otherwise a collision
-  // with collide_without_contact may potentially generate a large number of
-  // contacts.
-  if (_collision1->GetSurface()->collideWithoutContact ||
-      _collision2->GetSurface()->collideWithoutContact)
+  this->AddContactJoints(_collision1, _collision2, _contactCollisions,
+      this->dataPtr->indices, numc);
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::CastRays(
+    const std::vector<ignition::math::Vector3d> &_origins,
+    const std::vector<ignition::math::Vector3d> &_directions,
+    const double _length, std::vector<double> &_distances,
+    std::vector<uint32_t> &_entityIds)
+{
+  GZ_ASSERT(_origins.size() == _directions.size(),
+      "Origins and directions must have the same size");
+
+  std::vector<ODECollision *> collisions;
+  this->CastODERays(_origins, _directions,
+      std::vector<double>(_origins.size(), _length), _distances, collisions);
+
+  _entityIds.resize(collisions.size());
+  for (size_t i = 0; i < collisions.size(); ++i)
+    _entityIds[i] = collisions[i] ? collisions[i]->GetId() : 0;
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::CastODERays(
+    const std::vector<ignition::math::Vector3d> &_origins,
+    const std::vector<ignition::math::Vector3d> &_directions,
+    const std::vector<double> &_lengths,
+    std::vector<double> &_distances,
+    std::vector<ODECollision *> &_collisions)
+{
+  IGN_PROFILE("ODEPhysics::CastODERays");
+
+  const size_t count = std::min(_origins.size(),
+      std::min(_directions.size(), _lengths.size()));
+  _distances.assign(count, std::numeric_limits<double>::infinity());
+  _collisions.assign(count, nullptr);
+  if (count == 0)
+    return;
+
+  // Sort the rays along a Morton curve of their midpoints.
+  std::vector<std::pair<uint32_t, uint32_t> > codes(count);
+  ignition::math::Vector3d min(ignition::math::MAX_D,
+      ignition::math::MAX_D, ignition::math::MAX_D);
+  ignition::math::Vector3d max(ignition::math::LOW_D,
+      ignition::math::LOW_D, ignition::math::LOW_D);
+  std::vector<ignition::math::Vector3d> midpoints(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    midpoints[i] = _origins[i] + _directions[i] * (_lengths[i] * 0.5);
+    min.Min(midpoints[i]);
+    max.Max(midpoints[i]);
+  }
+  const ignition::math::Vector3d extent = max - min;
+  for (size_t i = 0; i < count; ++i)
   {
-    if ((_collision1->GetSurface()->collideWithoutContactBitmask &
-         _collision2->GetSurface()->collideWithoutContactBitmask) == 0)
+    uint32_t cell[3];
+    for (unsigned int j = 0; j < 3; ++j)
     {
-      return;
+      cell[j] = extent[j] > 0 ?
+          static_cast<uint32_t>((midpoints[i][j] - min[j]) / extent[j] * 1023)
+          : 0;
     }
+    codes[i].first = SpreadBits(cell[0]) | (SpreadBits(cell[1]) << 1) |
+        (SpreadBits(cell[2]) << 2);
+    codes[i].second = static_cast<uint32_t>(i);
   }
+  std::sort(codes.begin(), codes.end());
+
+  std::vector<uint32_t> order(count);
+  for (size_t i = 0; i < count; ++i)
+    order[i] = codes[i].second;
+
+  std::mutex serialMutex;
+  boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+
+  // Bring the bounding boxes up to date, so that the workers only read the
+  // spaces and their geoms.
+  dSpaceClean(this->dataPtr->spaceId);
+  dSpaceClean(this->dataPtr->staticSpaceId);
+
+  std::vector<RayTarget> targets;
+  GatherRayTargets(this->dataPtr->spaceId, targets);
+  GatherRayTargets(this->dataPtr->staticSpaceId, targets);
+
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, count, 64),
+      CastRays_TBB(&targets, &order, &_origins, &_directions, &_lengths,
+        &_distances, &_collisions, &serialMutex));
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::SetLinkCCD(ODELink *_link, const bool _enable)
+{
+  boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+
+  auto iter = std::find(this->dataPtr->ccdLinks.begin(),
+      this->dataPtr->ccdLinks.end(), _link);
+  if (_enable && iter == this->dataPtr->ccdLinks.end())
+    this->dataPtr->ccdLinks.push_back(_link);
+  else if (!_enable && iter != this->dataPtr->ccdLinks.end())
+    this->dataPtr->ccdLinks.erase(iter);
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::SweepCCDLinks(const double _dt)
+{
+  this->dataPtr->ccdCorrections.clear();
+  if (this->dataPtr->ccdLinks.empty() || _dt <= 0)
+    return;
+
+  IGN_PROFILE("ODEPhysics::SweepCCDLinks");
+
+  if (!this->dataPtr->ccdRay)
+  {
+    this->dataPtr->ccdRay = dCreateRay(nullptr, 1.0);
+    dGeomSetCategoryBits(this->dataPtr->ccdRay, GZ_SENSOR_COLLIDE);
+    dGeomSetCollideBits(this->dataPtr->ccdRay, ~GZ_SENSOR_COLLIDE);
+  }
+
+  for (auto const link : this->dataPtr->ccdLinks)
+  {
+    dBodyID body = link->GetODEId();
+    if (!body || !dBodyIsEnabled(body) || dBodyIsKinematic(body))
+      continue;
+
+    const dReal *v = dBodyGetLinearVel(body);
+    const ignition::math::Vector3d vel(v[0], v[1], v[2]);
+    const double speed = vel.Length();
+    const double travel = speed * _dt;
+    const double radius = link->CCDRadius();
+
+    // Slow links can't go through anything in one step
+    if (radius <= 0 || travel <= radius)
+      continue;
+
+    CCDSweep sweep;
+    sweep.ray = this->dataPtr->ccdRay;
+    sweep.link = link;
+    sweep.mask = 0;
+    for (auto const &collision : link->GetCollisions())
+      sweep.mask |= collision->GetSurface()->collideBitmask;
+    sweep.stamp = this->dataPtr->filterStamp;
+    sweep.distance = travel + radius;
+
+    const dReal *pos = dBodyGetPosition(body);
+    const ignition::math::Vector3d dir = vel / speed;
+    dGeomRaySet(this->dataPtr->ccdRay, pos[0], pos[1], pos[2],
+        dir.X(), dir.Y(), dir.Z());
+    dGeomRaySetLength(this->dataPtr->ccdRay, sweep.distance);
+
+    dSpaceCollide2(this->dataPtr->ccdRay,
+        reinterpret_cast<dGeomID>(this->dataPtr->spaceId), &sweep,
+        &CCDRayCallback);
+    dSpaceCollide2(this->dataPtr->ccdRay,
+        reinterpret_cast<dGeomID>(this->dataPtr->staticSpaceId), &sweep,
+        &CCDRayCallback);
+
+    // Stop with the center half a radius short of the hit. The link then
+    // overlaps what it hit, so that the next collision pass creates the
+    // contacts, and its center never crosses the surface.
+    const double allowed = std::max(sweep.distance - 0.5 * radius, 0.0);
+    if (allowed >= travel)
+      continue;
+
+    const ignition::math::Vector3d slowed = vel * (allowed / travel);
+    dBodySetLinearVel(body, slowed.X(), slowed.Y(), slowed.Z());
+    this->dataPtr->ccdCorrections.push_back(
+        std::make_pair(link, vel - slowed));
+  }
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::RestoreCCDVelocities()
+{
+  // The contacts of the next step deal with the full momentum
+  for (auto const &correction : this->dataPtr->ccdCorrections)
+  {
+    dBodyID body = correction.first->GetODEId();
+    if (!body)
+      continue;
+
+    const dReal *v = dBodyGetLinearVel(body);
+    dBodySetLinearVel(body, v[0] + correction.second.X(),
+        v[1] + correction.second.Y(), v[2] + correction.second.Z());
+  }
+  this->dataPtr->ccdCorrections.clear();
+}
+
+//////////////////////////////////////////////////
+unsigned int ODEPhysics::Narrowphase(ODECollision *_collision1,
+    ODECollision *_collision2, dContactGeom *_contactCollisions,
+    int *_indices)
+{
+  const uint32_t word1 = _collision1->FilterWord();
+  const uint32_t word2 = _collision2->FilterWord();
+
+  // Skip the pairs that ODE has no collider for.
+  if (kGeomPairs.kind[FilterClass(_collision1)][FilterClass(_collision2)] &
+      kPairNoCollider)
+  {
+    return 0;
+  }
+
+  const uint64_t mask = _collision1->FilterMask() & _collision2->FilterMask();
+
+  // Filter collisions based on collide bitmask.
+  if ((mask & 0xffffffffu) == 0)
+    return 0;
+
+  // Filter collisions based on contact bitmask if collide_without_contact is
+  // on.The bitmask is set mainly for speed improvements otherwise a collision
+  // with collide_without_contact may potentially generate a large number of
+  // contacts.
+  if (((word1 | word2) & ODECollision::kFilterNoContact) && (mask >> 32) == 0)
+    return 0;
 
   /*
   if (_collision1->GetCollisionId() && _collision2->GetCollisionId())
@@ -1045,7 +2065,6 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
   }*/
 
   unsigned int numc = 0;
-  dContact contact;
 
   // maxCollide must less than the size of this->dataPtr->indices
   // Check the header
@@ -1056,11 +2075,9 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
     maxCollide = this->GetMaxContacts();
 
   // over-ride with minimum of max_contacts from both collisions
-  if (_collision1->GetMaxContacts() < maxCollide)
-    maxCollide = _collision1->GetMaxContacts();
-
-  if (_collision2->GetMaxContacts() < maxCollide)
-    maxCollide = _collision2->GetMaxContacts();
+  maxCollide = std::min(maxCollide,
+      std::min(word1 & ODECollision::kFilterMaxContacts,
+               word2 & ODECollision::kFilterMaxContacts));
 
   // Generate the contacts
   numc = dCollide(_collision1->GetCollisionId(), _collision2->GetCollisionId(),
@@ -1068,11 +2085,11 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
 
   // Return if no contacts.
   if (numc == 0)
-    return;
+    return 0;
 
   // Store the indices of the contacts.
   for (int i = 0; i < MAX_CONTACT_JOINTS; i++)
-    this->dataPtr->indices[i] = i;
+    _indices[i] = i;
 
   // Choose only the best contacts if too many were generated.
   if (maxCollide > 0 && numc > maxCollide)
@@ -1083,7 +2100,7 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
       if (_contactCollisions[i].depth > max)
       {
         max = _contactCollisions[i].depth;
-        this->dataPtr->indices[maxCollide-1] = i;
+        _indices[maxCollide-1] = i;
       }
     }
 
@@ -1091,6 +2108,65 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
     numc = maxCollide;
   }
 
+  return numc;
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::WarmStartContact(dJointID _joint, const dContactGeom &_geom)
+{
+  ODEContactImpulse impulse;
+  impulse.pos.Set(_geom.pos[0], _geom.pos[1], _geom.pos[2]);
+  impulse.side1 = _geom.side1;
+  impulse.side2 = _geom.side2;
+  impulse.joint = _joint;
+
+  // The geoms are always reported in the same order by the space, so the
+  // pair isn't sorted. A swapped pair would have its normal flipped.
+  const auto key = std::make_pair(_geom.g1, _geom.g2);
+
+  // Reuse the impulses of the closest contact of the previous step on the
+  // same features.
+  auto iter = this->dataPtr->prevContactImpulses.find(key);
+  if (iter != this->dataPtr->prevContactImpulses.end())
+  {
+    const double maxDistSq = this->dataPtr->contactWarmStartDistance *
+        this->dataPtr->contactWarmStartDistance;
+    ODEContactImpulse *best = nullptr;
+    double bestDistSq = maxDistSq;
+    for (auto &prev : iter->second)
+    {
+      if (prev.matched || prev.side1 != impulse.side1 ||
+          prev.side2 != impulse.side2)
+      {
+        continue;
+      }
+
+      const double distSq = (prev.pos - impulse.pos).SquaredLength();
+      if (distSq <= bestDistSq)
+      {
+        best = &prev;
+        bestDistSq = distSq;
+      }
+    }
+
+    if (best)
+    {
+      best->matched = true;
+      dJointSetLambda(_joint, best->lambda, best->lambdaErp);
+    }
+  }
+
+  this->dataPtr->contactImpulses[key].push_back(impulse);
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::AddContactJoints(ODECollision *_collision1,
+    ODECollision *_collision2, const dContactGeom *_contactCollisions,
+    const int *_indices, const unsigned int _count)
+{
+  const unsigned int numc = _count;
+  dContact contact;
+
   // Set the contact surface parameter flags.
   contact.surface.mode = dContactBounce |
                          dContactMu2 |
@@ -1272,15 +2348,13 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
   // Create a joint feedback mechanism
   if (contactFeedback)
   {
-    if (this->dataPtr->jointFeedbackIndex <
+    if (this->dataPtr->jointFeedbackIndex >=
         this->dataPtr->jointFeedbacks.size())
-      jointFeedback =
-          this->dataPtr->jointFeedbacks[this->dataPtr->jointFeedbackIndex];
-    else
     {
-      jointFeedback = new ODEJointFeedback();
-      this->dataPtr->jointFeedbacks.push_back(jointFeedback);
+      this->dataPtr->jointFeedbacks.emplace_back();
     }
+    jointFeedback =
+        &this->dataPtr->jointFeedbacks[this->dataPtr->jointFeedbackIndex];
 
     this->dataPtr->jointFeedbackIndex++;
     jointFeedback->count = 0;
@@ -1290,31 +2364,34 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
   // Create a joint for each contact
   for (unsigned int j = 0; j < numc; ++j)
   {
-    contact.geom = _contactCollisions[this->dataPtr->indices[j]];
+    contact.geom = _contactCollisions[_indices[j]];
 
     // Create the contact joint. This introduces the contact constraint to
     // ODE
     dJointID contactJoint = dJointCreateContact(this->dataPtr->worldId,
       this->dataPtr->contactGroup, &contact);
 
+    if (this->dataPtr->contactWarmStart)
+      this->WarmStartContact(contactJoint, contact.geom);
+
     // Store contact information.
     if (contactFeedback && jointFeedback)
     {
       // Store the contact depth
       contactFeedback->depths[j] =
-        _contactCollisions[this->dataPtr->indices[j]].depth;
+        _contactCollisions[_indices[j]].depth;
 
       // Store the contact position
       contactFeedback->positions[j].Set(
-          _contactCollisions[this->dataPtr->indices[j]].pos[0],
-          _contactCollisions[this->dataPtr->indices[j]].pos[1],
-          _contactCollisions[this->dataPtr->indices[j]].pos[2]);
+          _contactCollisions[_indices[j]].pos[0],
+          _contactCollisions[_indices[j]].pos[1],
+          _contactCollisions[_indices[j]].pos[2]);
 
       // Store the contact normal
       contactFeedback->normals[j].Set(
-          _contactCollisions[this->dataPtr->indices[j]].normal[0],
-          _contactCollisions[this->dataPtr->indices[j]].normal[1],
-          _contactCollisions[this->dataPtr->indices[j]].normal[2]);
+          _contactCollisions[_indices[j]].normal[0],
+          _contactCollisions[_indices[j]].normal[1],
+          _contactCollisions[_indices[j]].normal[2]);
 
       // Set the joint feedback.
       dJointSetFeedback(contactJoint, &(jointFeedback->feedbacks[j]));
@@ -1347,6 +2424,97 @@ void ODEPhysics::AddTrimeshCollider(ODECollision *_collision1,
   this->dataPtr->trimeshCollidersCount++;
 }
 
+/////////////////////////////////////////////////
+void ODEPhysics::GroupTrimeshColliders()
+{
+  const unsigned int count = this->dataPtr->trimeshCollidersCount;
+  std::vector<size_t> &parents = this->dataPtr->trimeshGroupParents;
+  std::unordered_map<ODECollision *, size_t> &meshGroups =
+      this->dataPtr->trimeshMeshGroups;
+  std::vector<size_t> &colliderGroups = this->dataPtr->trimeshColliderGroups;
+  parents.clear();
+  meshGroups.clear();
+  colliderGroups.resize(count);
+  this->dataPtr->serialTrimeshColliders.resize(count);
+  this->dataPtr->trimeshContacts.resize(count);
+
+  auto root = [&parents](size_t _group)
+  {
+    while (parents[_group] != _group)
+    {
+      parents[_group] = parents[parents[_group]];
+      _group = parents[_group];
+    }
+    return _group;
+  };
+
+  // Group of a mesh, created the first time the mesh is seen
+  auto meshGroup = [&](ODECollision *_collision)
+  {
+    auto iter = meshGroups.emplace(_collision, parents.size());
+    if (iter.second)
+      parents.push_back(parents.size());
+    return root(iter.first->second);
+  };
+
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    ODECollision *collision1 = this->dataPtr->trimeshColliders[i].first;
+    ODECollision *collision2 = this->dataPtr->trimeshColliders[i].second;
+    const bool mesh1 =
+        dGeomGetClass(collision1->GetCollisionId()) == dTriMeshClass;
+    const bool mesh2 =
+        dGeomGetClass(collision2->GetCollisionId()) == dTriMeshClass;
+
+    this->dataPtr->serialTrimeshColliders[i] = (!mesh1 && !mesh2) ||
+        (!mesh1 && !NarrowphaseThreadSafe(collision1)) ||
+        (!mesh2 && !NarrowphaseThreadSafe(collision2));
+
+    // Two meshes that collide with each other end up in the same group
+    if (mesh1 && mesh2)
+    {
+      const size_t group1 = meshGroup(collision1);
+      const size_t group2 = meshGroup(collision2);
+      if (group1 != group2)
+        parents[group2] = group1;
+      colliderGroups[i] = group1;
+    }
+    else if (mesh1 || mesh2)
+      colliderGroups[i] = meshGroup(mesh1 ? collision1 : collision2);
+    else
+    {
+      // Collided serially, give it a group of its own
+      parents.push_back(parents.size());
+      colliderGroups[i] = parents.back();
+    }
+  }
+
+  // Sort the colliders by group, keeping the collider order within a
+  // group. Groups are numbered in order of their first collider.
+  std::vector<size_t> dense(parents.size(), count);
+  size_t groupCount = 0;
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    size_t &id = dense[root(colliderGroups[i])];
+    if (id == count)
+      id = groupCount++;
+    colliderGroups[i] = id;
+  }
+
+  std::vector<size_t> &groups = this->dataPtr->trimeshGroups;
+  groups.assign(groupCount + 1, 0);
+  for (unsigned int i = 0; i < count; ++i)
+    ++groups[colliderGroups[i] + 1];
+  for (size_t g = 0; g < groupCount; ++g)
+    groups[g + 1] += groups[g];
+
+  std::vector<size_t> &order = this->dataPtr->trimeshOrder;
+  order.resize(count);
+  std::vector<size_t> next(groups.begin(), groups.end() - 1);
+  for (unsigned int i = 0; i < count; ++i)
+    order[next[colliderGroups[i]]++] = i;
+}
+
 /////////////////////////////////////////////////
 void ODEPhysics::AddCollider(ODECollision *_collision1,
                              ODECollision *_collision2)
@@ -1488,6 +2656,11 @@ bool ODEPhysics::SetParam(const std::string &_key, const boost::any &_value)
       double value = any_cast<double>(_value);
       odeElem->GetElement("solver")->GetElement("min_step_size")->Set(value);
     }
+    else if (_key == "min_iters")
+    {
+      dWorldSetQuickStepMinIterations(this->dataPtr->worldId,
+          any_cast<int>(_value));
+    }
     else if (_key == "sor_lcp_tolerance")
     {
       dWorldSetQuickStepTolerance(this->dataPtr->worldId,
@@ -1536,6 +2709,18 @@ bool ODEPhysics::SetParam(const std::string &_key, const boost::any &_value)
       dWorldSetQuickStepWarmStartFactor(this->dataPtr->worldId,
         any_cast<double>(_value));
     }
+    else if (_key == "contact_warm_start")
+    {
+      bool value = any_cast<bool>(_value);
+      boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+      this->dataPtr->contactWarmStart = value;
+      this->dataPtr->prevContactImpulses.clear();
+      this->dataPtr->contactImpulses.clear();
+    }
+    else if (_key == "contact_warm_start_distance")
+    {
+      this->dataPtr->contactWarmStartDistance = any_cast<double>(_value);
+    }
     else if (_key == "extra_friction_iterations")
     {
       dWorldSetQuickStepExtraFrictionIterations(this->dataPtr->worldId,
@@ -1555,6 +2740,64 @@ bool ODEPhysics::SetParam(const std::string &_key, const boost::any &_value)
       }
       dWorldSetIslandThreads(this->dataPtr->worldId, value);
     }
+    else if (_key == "space_type")
+    {
+      return this->SetSpaceType(any_cast<std::string>(_value));
+    }
+    else if (_key == "static_space")
+    {
+      this->SetStaticSpaceEnabled(any_cast<bool>(_value));
+    }
+    else if (_key == "space_hash_min_level" ||
+             _key == "space_hash_max_level")
+    {
+      int value = any_cast<int>(_value);
+      boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+      if (_key == "space_hash_min_level")
+        this->dataPtr->hashMinLevel = value;
+      else
+        this->dataPtr->hashMaxLevel = value;
+      if (this->dataPtr->spaceType == "hash")
+      {
+        dHashSpaceSetLevels(this->dataPtr->spaceId,
+            this->dataPtr->hashMinLevel, this->dataPtr->hashMaxLevel);
+      }
+      dHashSpaceSetLevels(this->dataPtr->staticSpaceId,
+          this->dataPtr->hashMinLevel, this->dataPtr->hashMaxLevel);
+    }
+    else if (_key == "space_quadtree_center" ||
+             _key == "space_quadtree_extents" ||
+             _key == "space_quadtree_depth")
+    {
+      if (_key == "space_quadtree_depth")
+        this->dataPtr->quadTreeDepth = any_cast<int>(_value);
+      else if (_key == "space_quadtree_center")
+      {
+        this->dataPtr->quadTreeCenter =
+            any_cast<ignition::math::Vector3d>(_value);
+      }
+      else
+      {
+        this->dataPtr->quadTreeExtents =
+            any_cast<ignition::math::Vector3d>(_value);
+      }
+
+      // A quadtree can't be resized, build a new one.
+      if (this->dataPtr->spaceType == "quadtree")
+        return this->SetSpaceType("quadtree");
+    }
+    else if (_key == "parallel_collision")
+    {
+      bool value = any_cast<bool>(_value);
+      boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+      this->dataPtr->parallelCollision = value;
+    }
+    else if (_key == "trimesh_temporal_coherence")
+    {
+      bool value = any_cast<bool>(_value);
+      boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+      this->dataPtr->trimeshTemporalCoherence = value;
+    }
     else if (_key == "ode_quiet")
     {
       bool odeQuiet = any_cast<bool>(_value);
@@ -1627,6 +2870,10 @@ bool ODEPhysics::GetParam(const std::string &_key, boost::any &_value) const
     _value = this->sdf->Get<int>("max_contacts");
   else if (_key == "min_step_size")
     _value = odeElem->GetElement("solver")->Get<double>("min_step_size");
+  else if (_key == "min_iters")
+    _value = dWorldGetQuickStepMinIterations(this->dataPtr->worldId);
+  else if (_key == "iters_used")
+    _value = dWorldGetQuickStepIterationsUsed(this->dataPtr->worldId);
   else if (_key == "sor_lcp_tolerance")
     _value = dWorldGetQuickStepTolerance(this->dataPtr->worldId);
   else if (_key == "rms_error_tolerance")
@@ -1656,12 +2903,34 @@ bool ODEPhysics::GetParam(const std::string &_key, boost::any &_value) const
   }
   else if (_key == "warm_start_factor")
     _value = dWorldGetQuickStepWarmStartFactor(this->dataPtr->worldId);
+  else if (_key == "contact_warm_start")
+    _value = this->dataPtr->contactWarmStart;
+  else if (_key == "contact_warm_start_distance")
+    _value = this->dataPtr->contactWarmStartDistance;
   else if (_key == "extra_friction_iterations")
     _value = dWorldGetQuickStepExtraFrictionIterations(this->dataPtr->worldId);
   else if (_key == "friction_model")
     _value = this->GetFrictionModel();
   else if (_key == "island_threads")
     _value = dWorldGetIslandThreads(this->dataPtr->worldId);
+  else if (_key == "parallel_collision")
+    _value = this->dataPtr->parallelCollision;
+  else if (_key == "trimesh_temporal_coherence")
+    _value = this->dataPtr->trimeshTemporalCoherence;
+  else if (_key == "static_space")
+    _value = this->dataPtr->staticSpace;
+  else if (_key == "space_type")
+    _value = this->dataPtr->spaceType;
+  else if (_key == "space_hash_min_level")
+    _value = this->dataPtr->hashMinLevel;
+  else if (_key == "space_hash_max_level")
+    _value = this->dataPtr->hashMaxLevel;
+  else if (_key == "space_quadtree_center")
+    _value = this->dataPtr->quadTreeCenter;
+  else if (_key == "space_quadtree_extents")
+    _value = this->dataPtr->quadTreeExtents;
+  else if (_key == "space_quadtree_depth")
+    _value = this->dataPtr->quadTreeDepth;
   else if (_key == "ode_quiet")
     _value = dGetMessageHandler() != 0;
   else if (_key == "world_step_solver")
@@ -21,6 +21,7 @@
 #include <tbb/concurrent_vector.h>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <boost/thread/thread.hpp>
 
@@ -271,14 +272,44 @@ namespace gazebo
       public: static World_Solver_Type
               ConvertWorldStepSolverType(const std::string &_solverType);
 
-      /// \brief Get the step type (quick, world).
+      /// \brief Get the step type (quick, world, parallel_quick).
       /// \return The step type.
       public: virtual std::string GetStepType() const;
 
-      /// \brief Set the step type (quick, world).
-      /// \param[in] _type The step type (quick or world).
+      /// \brief Set the step type (quick, world, parallel_quick).
+      /// parallel_quick uses the solver in deps/parallel_quickstep, on the
+      /// GPU when built with CUDA or OpenCL. It falls back to quick when
+      /// gazebo was built without it.
+      /// \param[in] _type The step type (quick, world or parallel_quick).
       public: virtual void SetStepType(const std::string &_type);
 
+      /// \brief Get the type of the top level collision space.
+      /// \return "hash", "sap" or "quadtree".
+      public: std::string SpaceType() const;
+
+      /// \brief Set the type of the top level collision space used by the
+      /// broadphase. The per-model spaces stay simple spaces. Every geom of
+      /// the current space is moved to the new one.
+      /// \param[in] _type "hash", "sap" (sweep and prune along X, Y then
+      /// Z) or "quadtree".
+      /// \return True if the space was created.
+      public: bool SetSpaceType(const std::string &_type);
+
+      /// \brief Return the space that holds the collisions of static
+      /// models. It's collided against the world space, but not against
+      /// itself.
+      /// \return The space id for static collisions.
+      public: dSpaceID StaticSpaceId() const;
+
+      /// \brief Get whether static models have their own space.
+      /// \return True if static models are in StaticSpaceId().
+      public: bool StaticSpaceEnabled() const;
+
+      /// \brief Put the collisions of static models in their own space,
+      /// or back in the world space. Contacts between two static models
+      /// aren't generated while it's enabled.
+      /// \param[in] _enable True to use the static space.
+      public: void SetStaticSpaceEnabled(const bool _enable);
 
       /// \brief Collide two collision objects.
       /// \param[in] _collision1 First collision object.
@@ -287,6 +318,51 @@ namespace gazebo
       public: void Collide(ODECollision *_collision1, ODECollision *_collision2,
                            dContactGeom *_contactCollisions);
 
+      /// \brief Generate the contacts between two collision objects,
+      /// without creating contact joints. Safe to call from several threads
+      /// at once for geoms that aren't trimeshes, heightfields or
+      /// transforms.
+      /// \param[in] _collision1 First collision object.
+      /// \param[in] _collision2 Second collision object.
+      /// \param[out] _contactCollisions Array of at least
+      /// MAX_COLLIDE_RETURNS contacts.
+      /// \param[out] _indices Array of MAX_CONTACT_JOINTS indices into
+      /// _contactCollisions of the contacts to keep.
+      /// \return Number of contacts to keep.
+      public: unsigned int Narrowphase(ODECollision *_collision1,
+                  ODECollision *_collision2, dContactGeom *_contactCollisions,
+                  int *_indices);
+
+      // Documentation inherited
+      public: virtual void CastRays(
+                  const std::vector<ignition::math::Vector3d> &_origins,
+                  const std::vector<ignition::math::Vector3d> &_directions,
+                  const double _length, std::vector<double> &_distances,
+                  std::vector<uint32_t> &_entityIds);
+
+      /// \brief Cast a batch of rays against the collisions of the world
+      /// on the TBB pool. The rays are sorted along a Morton curve of their
+      /// midpoints, so that each worker casts neighboring rays, which tend
+      /// to test the same collisions.
+      /// \param[in] _origins Start point of each ray, in world frame.
+      /// \param[in] _directions Unit direction of each ray, in world frame.
+      /// \param[in] _lengths Length of each ray.
+      /// \param[out] _distances Distance to the closest hit of each ray, or
+      /// infinity if the ray hit nothing.
+      /// \param[out] _collisions Collision hit by each ray, or null.
+      public: void CastODERays(
+                  const std::vector<ignition::math::Vector3d> &_origins,
+                  const std::vector<ignition::math::Vector3d> &_directions,
+                  const std::vector<double> &_lengths,
+                  std::vector<double> &_distances,
+                  std::vector<ODECollision *> &_collisions);
+
+      /// \brief Enable or disable continuous collision detection for a
+      /// link. Called by ODELink.
+      /// \param[in] _link The link.
+      /// \param[in] _enable True to sweep the link before each step.
+      public: void SetLinkCCD(ODELink *_link, const bool _enable);
+
       /// \brief process joint feedbacks.
       /// \param[in] _feedback ODE Joint Contact feedback information.
       public: void ProcessJointFeedback(ODEJointFeedback *_feedback);
@@ -295,6 +371,16 @@ namespace gazebo
 
       protected: virtual void OnPhysicsMsg(ConstPhysicsPtr &_msg);
 
+      /// \brief Sweep the CCD links along their velocity, and slow down
+      /// the ones that would go through something during the step, so that
+      /// they end the step touching it.
+      /// \param[in] _dt Duration of the step.
+      private: void SweepCCDLinks(const double _dt);
+
+      /// \brief Give back to the CCD links the velocity taken away by
+      /// SweepCCDLinks.
+      private: void RestoreCCDVelocities();
+
       /// \brief Primary collision callback.
       /// \param[in] _data Pointer to user data.
       /// \param[in] _o1 First geom to check for collisions.
@@ -309,12 +395,43 @@ namespace gazebo
       private: void AddTrimeshCollider(ODECollision *_collision1,
                                        ODECollision *_collision2);
 
+      /// \brief Group the triangle mesh colliders by mesh for the parallel
+      /// narrow phase, and find the ones that must be collided serially.
+      private: void GroupTrimeshColliders();
+
       /// \brief Create a normal object collider.
       /// \param[in] _collision1 The first collision object.
       /// \param[in] _collision2 The second collision object.
       private: void AddCollider(ODECollision *_collision1,
                                 ODECollision *_collision2);
 
+      /// \brief Create the contact joints between two collision objects.
+      /// \param[in] _collision1 First collision object.
+      /// \param[in] _collision2 Second collision object.
+      /// \param[in] _contactCollisions Contacts from Narrowphase.
+      /// \param[in] _indices Indices of the contacts to use.
+      /// \param[in] _count Number of contacts to use.
+      private: void AddContactJoints(ODECollision *_collision1,
+                   ODECollision *_collision2,
+                   const dContactGeom *_contactCollisions,
+                   const int *_indices, const unsigned int _count);
+
+      /// \brief Give a new contact joint the impulses of the matching
+      /// contact of the previous step, and remember it so that its own
+      /// impulses are kept after the world step.
+      /// \param[in] _joint The new contact joint.
+      /// \param[in] _geom Contact the joint was created from.
+      private: void WarmStartContact(dJointID _joint,
+                                     const dContactGeom &_geom);
+
+      /// \brief Copy the impulses computed by the world step out of the
+      /// contact joints, before the joints are destroyed.
+      private: void StoreContactImpulses();
+
+      /// \brief Publish the iterations and residual of the last quickstep
+      /// on ~/physics/diagnostics.
+      private: void PublishDiagnostics();
+
       /// \internal
       /// \brief Private data pointer.
       private: ODEPhysicsPrivate *dataPtr;
@@ -18,11 +18,19 @@
 #ifndef _ODEPHYSICS_PRIVATE_HH_
 #define _ODEPHYSICS_PRIVATE_HH_
 
+#include <tbb/enumerable_thread_specific.h>
+
+#include <cstdint>
+#include <deque>
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <utility>
 
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/physics/Contact.hh"
 #include "gazebo/physics/ode/ODETypes.hh"
 
@@ -45,6 +53,35 @@ namespace gazebo
       public: dJointFeedback feedbacks[MAX_CONTACT_JOINTS];
     };
 
+    /// \brief Impulses of a contact joint, kept from one step to the next
+    /// to warm start the solver.
+    class ODEContactImpulse
+    {
+      /// \brief Contact point in world coordinates.
+      public: ignition::math::Vector3d pos;
+
+      /// \brief Features of the two geoms that are in contact.
+      public: int side1 = -1;
+      public: int side2 = -1;
+
+      /// \brief Contact joint created this step. Only valid until the
+      /// contact group is emptied.
+      public: dJointID joint = nullptr;
+
+      /// \brief True once a contact of the next step reused the impulses.
+      public: bool matched = false;
+
+      /// \brief Impulses computed by the solver.
+      public: dReal lambda[6] = {0, 0, 0, 0, 0, 0};
+
+      /// \brief Position correction impulses computed by the solver.
+      public: dReal lambdaErp[6] = {0, 0, 0, 0, 0, 0};
+    };
+
+    /// \brief Contact impulses for each pair of geoms in contact.
+    typedef std::map<std::pair<dGeomID, dGeomID>,
+            std::vector<ODEContactImpulse> > ODEContactImpulseMap;
+
     class ODEPhysicsPrivate
     {
       /// \brief Top-level world for all bodies
@@ -53,14 +90,44 @@ namespace gazebo
       /// \brief Top-level space for all sub-spaces/collisions
       public: dSpaceID spaceId;
 
+      /// \brief Top-level hash space for the collisions of static models.
+      /// It's only collided against spaceId, and since its geoms don't
+      /// move the hash space keeps its table between steps.
+      public: dSpaceID staticSpaceId = nullptr;
+
+      /// \brief True if static models are put in staticSpaceId.
+      public: bool staticSpace = true;
+
+      /// \brief Type of spaceId: hash, sap or quadtree.
+      public: std::string spaceType = "hash";
+
+      /// \brief Smallest cell size of the hash space, as a power of two.
+      public: int hashMinLevel = -2;
+
+      /// \brief Largest cell size of the hash space, as a power of two.
+      public: int hashMaxLevel = 8;
+
+      /// \brief Center of the region covered by the quadtree space.
+      public: ignition::math::Vector3d quadTreeCenter =
+              ignition::math::Vector3d::Zero;
+
+      /// \brief Half size of the region covered by the quadtree space.
+      public: ignition::math::Vector3d quadTreeExtents =
+              ignition::math::Vector3d(1000, 1000, 100);
+
+      /// \brief Number of levels of the quadtree space.
+      public: int quadTreeDepth = 6;
+
       /// \brief Collision attributes
       public: dJointGroupID contactGroup;
 
       /// \brief The type of the solver.
       public: std::string stepType;
 
-      /// \brief Buffer of contact feedback information.
-      public: std::vector<ODEJointFeedback*> jointFeedbacks;
+      /// \brief Buffer of contact feedback information. It only grows, and
+      /// a deque keeps the addresses given to dJointSetFeedback valid as it
+      /// does.
+      public: std::deque<ODEJointFeedback> jointFeedbacks;
 
       /// \brief Physics step function.
       public: int (*physicsStepFunc)(dxWorld*, dReal);
@@ -81,9 +148,85 @@ namespace gazebo
       /// \brief Indices used during creation of contact joints.
       public: int indices[MAX_CONTACT_JOINTS];
 
+      /// \brief Indices 0 to MAX_CONTACT_JOINTS-1, used with contacts that
+      /// were already selected by the parallel narrow phase.
+      public: int identityIndices[MAX_CONTACT_JOINTS];
+
+      /// \brief True to run the narrow phase of the normal colliders on the
+      /// TBB pool.
+      public: bool parallelCollision = false;
+
+      /// \brief Number of colliders handed to a worker at a time by the
+      /// parallel narrow phase.
+      public: size_t collisionGrainSize = 8;
+
+      /// \brief Contacts selected for each normal collider by the parallel
+      /// narrow phase.
+      public: std::vector<std::vector<dContactGeom> > colliderContacts;
+
+      /// \brief True for the normal colliders that are not thread safe,
+      /// and are collided serially.
+      public: std::vector<bool> serialColliders;
+
+      /// \brief Contacts selected for each triangle mesh collider by the
+      /// parallel narrow phase.
+      public: std::vector<std::vector<dContactGeom> > trimeshContacts;
+
+      /// \brief True for the triangle mesh colliders that are not thread
+      /// safe, and are collided serially.
+      public: std::vector<bool> serialTrimeshColliders;
+
+      /// \brief Indices of the triangle mesh colliders, sorted by group. A
+      /// group holds the colliders that share a mesh, and is collided by a
+      /// single worker.
+      public: std::vector<size_t> trimeshOrder;
+
+      /// \brief Start of each group in trimeshOrder, followed by the end of
+      /// the last group.
+      public: std::vector<size_t> trimeshGroups;
+
+      /// \brief Group of each triangle mesh collider.
+      public: std::vector<size_t> trimeshColliderGroups;
+
+      /// \brief Union-find parent of each group, used to merge the groups
+      /// of two meshes that collide with each other.
+      public: std::vector<size_t> trimeshGroupParents;
+
+      /// \brief Group of each mesh collision of the current step.
+      public: std::unordered_map<ODECollision *, size_t> trimeshMeshGroups;
+
+      /// \brief True to enable the temporal coherence caches of the meshes
+      /// for spheres, boxes and capsules.
+      public: bool trimeshTemporalCoherence = false;
+
+      /// \brief Per-thread buffers that dCollide writes into.
+      public: tbb::enumerable_thread_specific<std::vector<dContactGeom> >
+              narrowphaseScratch;
+
       /// \brief Current index into the contactFeedbacks buffer
       public: unsigned int jointFeedbackIndex;
 
+      /// \brief Publisher of the solver statistics of each step.
+      public: transport::PublisherPtr diagnosticsPub;
+
+      /// \brief True to carry the contact impulses over to the next step.
+      public: bool contactWarmStart = false;
+
+      /// \brief Largest distance between two contact points of successive
+      /// steps that are considered to be the same contact.
+      public: double contactWarmStartDistance = 0.01;
+
+      /// \brief Contact joints created by this step, with their impulses
+      /// filled in after the world step.
+      public: ODEContactImpulseMap contactImpulses;
+
+      /// \brief Contact impulses of the previous step.
+      public: ODEContactImpulseMap prevContactImpulses;
+
+      /// \brief Stamp of the current collision pass, used to refresh the
+      /// filter data of the collisions once per pass.
+      public: uint64_t filterStamp = 0;
+
       /// \brief Number of normal colliders.
       public: unsigned int collidersCount;
 
@@ -92,6 +235,17 @@ namespace gazebo
 
       /// \brief Maximum number of contact points per collision pair.
       public: unsigned int maxContacts;
+
+      /// \brief Links with continuous collision detection enabled.
+      public: std::vector<ODELink *> ccdLinks;
+
+      /// \brief Ray used to sweep the CCD links, created on first use.
+      public: dGeomID ccdRay = nullptr;
+
+      /// \brief Linear velocity taken away from the CCD links for the
+      /// current step, given back after it.
+      public: std::vector<std::pair<ODELink *, ignition::math::Vector3d> >
+              ccdCorrections;
     };
   }
 }
@@ -15,10 +15,15 @@
  *
 */
 
+#include <cmath>
+#include <mutex>
+#include <sstream>
+#include <vector>
 #include <gtest/gtest.h>
 
 #include "gazebo/physics/physics.hh"
 #include "gazebo/physics/PhysicsEngine.hh"
+#include "gazebo/physics/ode/ODECollision.hh"
 #include "gazebo/physics/ode/ODEPhysics.hh"
 #include "gazebo/physics/ode/ODETypes.hh"
 #include "gazebo/test/ServerFixture.hh"
@@ -320,6 +325,117 @@ TEST_F(ODEPhysics_TEST, PhysicsParam)
     }
   }
 
+  // Test parallel_collision
+  {
+    // parallel_collision should be off by default
+    bool parallelCollision = true;
+    EXPECT_NO_THROW(parallelCollision =
+      boost::any_cast<bool>(odePhysics->GetParam("parallel_collision")));
+    EXPECT_FALSE(parallelCollision);
+
+    EXPECT_TRUE(odePhysics->SetParam("parallel_collision", true));
+    EXPECT_NO_THROW(parallelCollision =
+      boost::any_cast<bool>(odePhysics->GetParam("parallel_collision")));
+    EXPECT_TRUE(parallelCollision);
+    EXPECT_TRUE(odePhysics->SetParam("parallel_collision", false));
+  }
+
+  // Test trimesh_temporal_coherence
+  {
+    // trimesh_temporal_coherence should be off by default
+    bool trimeshTC = true;
+    EXPECT_NO_THROW(trimeshTC = boost::any_cast<bool>(
+        odePhysics->GetParam("trimesh_temporal_coherence")));
+    EXPECT_FALSE(trimeshTC);
+
+    EXPECT_TRUE(odePhysics->SetParam("trimesh_temporal_coherence", true));
+    EXPECT_NO_THROW(trimeshTC = boost::any_cast<bool>(
+        odePhysics->GetParam("trimesh_temporal_coherence")));
+    EXPECT_TRUE(trimeshTC);
+    EXPECT_TRUE(odePhysics->SetParam("trimesh_temporal_coherence", false));
+  }
+
+  // Test min_iters
+  {
+    int minIters = -1;
+    EXPECT_NO_THROW(minIters =
+      boost::any_cast<int>(odePhysics->GetParam("min_iters")));
+    EXPECT_EQ(minIters, 0);
+
+    EXPECT_TRUE(odePhysics->SetParam("min_iters", 5));
+    EXPECT_NO_THROW(minIters =
+      boost::any_cast<int>(odePhysics->GetParam("min_iters")));
+    EXPECT_EQ(minIters, 5);
+    EXPECT_TRUE(odePhysics->SetParam("min_iters", 0));
+  }
+
+  // Test contact_warm_start
+  {
+    bool warmStart = true;
+    EXPECT_NO_THROW(warmStart =
+      boost::any_cast<bool>(odePhysics->GetParam("contact_warm_start")));
+    EXPECT_FALSE(warmStart);
+
+    EXPECT_TRUE(odePhysics->SetParam("contact_warm_start", true));
+    EXPECT_NO_THROW(warmStart =
+      boost::any_cast<bool>(odePhysics->GetParam("contact_warm_start")));
+    EXPECT_TRUE(warmStart);
+    EXPECT_TRUE(odePhysics->SetParam("contact_warm_start", false));
+
+    double distance = 0;
+    EXPECT_TRUE(odePhysics->SetParam("contact_warm_start_distance", 0.02));
+    EXPECT_NO_THROW(distance = boost::any_cast<double>(
+        odePhysics->GetParam("contact_warm_start_distance")));
+    EXPECT_DOUBLE_EQ(distance, 0.02);
+  }
+
+  // Test static_space
+  {
+    bool staticSpace = false;
+    EXPECT_NO_THROW(staticSpace =
+      boost::any_cast<bool>(odePhysics->GetParam("static_space")));
+    EXPECT_TRUE(staticSpace);
+
+    EXPECT_TRUE(odePhysics->SetParam("static_space", false));
+    EXPECT_NO_THROW(staticSpace =
+      boost::any_cast<bool>(odePhysics->GetParam("static_space")));
+    EXPECT_FALSE(staticSpace);
+    EXPECT_TRUE(odePhysics->SetParam("static_space", true));
+  }
+
+  // Test space_type
+  {
+    std::string spaceType;
+    EXPECT_NO_THROW(spaceType =
+      boost::any_cast<std::string>(odePhysics->GetParam("space_type")));
+    EXPECT_EQ(spaceType, "hash");
+
+    for (const std::string type : {"sap", "quadtree", "hash"})
+    {
+      EXPECT_TRUE(odePhysics->SetParam("space_type", type));
+      EXPECT_NO_THROW(spaceType =
+        boost::any_cast<std::string>(odePhysics->GetParam("space_type")));
+      EXPECT_EQ(spaceType, type);
+    }
+
+    // Unknown types leave the space as it is
+    EXPECT_FALSE(odePhysics->SetParam("space_type", std::string("octree")));
+    EXPECT_EQ(odePhysics->SpaceType(), "hash");
+
+    int level = 0;
+    EXPECT_TRUE(odePhysics->SetParam("space_hash_max_level", 6));
+    EXPECT_NO_THROW(level =
+      boost::any_cast<int>(odePhysics->GetParam("space_hash_max_level")));
+    EXPECT_EQ(level, 6);
+
+    const ignition::math::Vector3d extents(50, 50, 10);
+    ignition::math::Vector3d value;
+    EXPECT_TRUE(odePhysics->SetParam("space_quadtree_extents", extents));
+    EXPECT_NO_THROW(value = boost::any_cast<ignition::math::Vector3d>(
+        odePhysics->GetParam("space_quadtree_extents")));
+    EXPECT_EQ(value, extents);
+  }
+
   // Test ode_quiet
   // convenient for disabling LCP internal error messages from world solver
   {
@@ -490,6 +606,513 @@ TEST_F(ODEPhysics_TEST, PhysicsMsgParam)
   PhysicsMsgParam();
 }
 
+/////////////////////////////////////////////////
+/// Check that the parallel narrow phase gives the same result as the
+/// serial one.
+TEST_F(ODEPhysics_TEST, ParallelCollision)
+{
+  Load("worlds/shapes.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  ODEPhysicsPtr odePhysics =
+      boost::dynamic_pointer_cast<ODEPhysics>(world->Physics());
+  ASSERT_TRUE(odePhysics != nullptr);
+
+  // Drop the shapes onto each other so that there are several colliding
+  // pairs.
+  auto run = [&](const bool _parallel)
+  {
+    world->Reset();
+    odePhysics->SetSeed(1);
+    EXPECT_TRUE(odePhysics->SetParam("parallel_collision", _parallel));
+    world->ModelByName("box")->SetWorldPose(
+        ignition::math::Pose3d(0, 0, 0.5, 0, 0, 0));
+    world->ModelByName("sphere")->SetWorldPose(
+        ignition::math::Pose3d(0.2, 0, 1.6, 0, 0, 0));
+    world->ModelByName("cylinder")->SetWorldPose(
+        ignition::math::Pose3d(-0.1, 0.1, 2.8, 0.3, 0.2, 0));
+
+    std::vector<ignition::math::Pose3d> poses;
+    for (unsigned int i = 0; i < 10; ++i)
+    {
+      world->Step(50);
+      for (const auto &model : world->Models())
+        poses.push_back(model->WorldPose());
+    }
+    return poses;
+  };
+
+  const std::vector<ignition::math::Pose3d> serialPoses = run(false);
+  const std::vector<ignition::math::Pose3d> parallelPoses = run(true);
+  ASSERT_EQ(serialPoses.size(), parallelPoses.size());
+  for (size_t i = 0; i < serialPoses.size(); ++i)
+    EXPECT_EQ(serialPoses[i], parallelPoses[i]) << i;
+}
+
+/////////////////////////////////////////////////
+/// Check that the parallel narrow phase of triangle meshes gives the same
+/// result as the serial one.
+TEST_F(ODEPhysics_TEST, ParallelTrimeshCollision)
+{
+  Load("worlds/shapes.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  ODEPhysicsPtr odePhysics =
+      boost::dynamic_pointer_cast<ODEPhysics>(world->Physics());
+  ASSERT_TRUE(odePhysics != nullptr);
+
+  // A stack of mesh boxes next to the shapes, so that there are mesh-mesh,
+  // mesh-shape and mesh-ground pairs.
+  const unsigned int meshCount = 4;
+  for (unsigned int i = 0; i < meshCount; ++i)
+  {
+    std::ostringstream sdfStr;
+    sdfStr << "<sdf version='" << SDF_VERSION << "'>"
+      << "<model name='mesh_" << i << "'>"
+      << "  <pose>" << 0.9 + 0.1 * i << " " << 0.05 * i << " "
+      << 0.5 + 1.1 * i << " 0 0 " << 0.2 * i << "</pose>"
+      << "  <link name='link'>"
+      << "    <collision name='collision'>"
+      << "      <geometry><mesh>"
+      << "        <uri>" << PROJECT_SOURCE_PATH << "/test/data/box.dae</uri>"
+      << "        <scale>0.5 0.5 0.5</scale>"
+      << "      </mesh></geometry>"
+      << "    </collision>"
+      << "  </link>"
+      << "</model>"
+      << "</sdf>";
+    world->InsertModelString(sdfStr.str());
+  }
+
+  int sleep = 0;
+  while (world->ModelCount() < 4 + meshCount && sleep++ < 100)
+  {
+    world->Step(1);
+    common::Time::MSleep(10);
+  }
+  ASSERT_EQ(world->ModelCount(), 4 + meshCount);
+
+  auto run = [&](const bool _parallel, const bool _tc)
+  {
+    world->Reset();
+    odePhysics->SetSeed(1);
+    EXPECT_TRUE(odePhysics->SetParam("parallel_collision", _parallel));
+    EXPECT_TRUE(odePhysics->SetParam("trimesh_temporal_coherence", _tc));
+
+    std::vector<ignition::math::Pose3d> poses;
+    for (unsigned int i = 0; i < 10; ++i)
+    {
+      world->Step(50);
+      for (const auto &model : world->Models())
+        poses.push_back(model->WorldPose());
+    }
+    return poses;
+  };
+
+  for (const bool tc : {false, true})
+  {
+    const std::vector<ignition::math::Pose3d> serialPoses = run(false, tc);
+    const std::vector<ignition::math::Pose3d> parallelPoses = run(true, tc);
+    ASSERT_EQ(serialPoses.size(), parallelPoses.size());
+    for (size_t i = 0; i < serialPoses.size(); ++i)
+      EXPECT_EQ(serialPoses[i], parallelPoses[i]) << i;
+  }
+
+  // The bottom mesh rests on the ground
+  ModelPtr mesh = world->ModelByName("mesh_0");
+  ASSERT_TRUE(mesh != nullptr);
+  EXPECT_NEAR(mesh->WorldPose().Pos().Z(), 0.5, 0.05);
+}
+
+/////////////////////////////////////////////////
+TEST_F(ODEPhysics_TEST, SharedTrimeshData)
+{
+  Load("worlds/empty.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  // Two identical meshes, and one with another scale
+  const std::vector<double> scales = {0.5, 0.5, 0.25};
+  for (unsigned int i = 0; i < scales.size(); ++i)
+  {
+    std::ostringstream sdfStr;
+    sdfStr << "<sdf version='" << SDF_VERSION << "'>"
+      << "<model name='mesh_" << i << "'>"
+      << "  <pose>" << 2.0 * i << " 0 1 0 0 0</pose>"
+      << "  <link name='link'>"
+      << "    <collision name='collision'>"
+      << "      <geometry><mesh>"
+      << "        <uri>" << PROJECT_SOURCE_PATH << "/test/data/box.dae</uri>"
+      << "        <scale>" << scales[i] << " " << scales[i] << " "
+      << scales[i] << "</scale>"
+      << "      </mesh></geometry>"
+      << "    </collision>"
+      << "  </link>"
+      << "</model>"
+      << "</sdf>";
+    world->InsertModelString(sdfStr.str());
+  }
+
+  int sleep = 0;
+  while (world->ModelCount() < 1 + scales.size() && sleep++ < 100)
+  {
+    world->Step(1);
+    common::Time::MSleep(10);
+  }
+  ASSERT_EQ(world->ModelCount(), 1 + scales.size());
+
+  std::vector<dTriMeshDataID> data;
+  for (unsigned int i = 0; i < scales.size(); ++i)
+  {
+    ModelPtr model = world->ModelByName("mesh_" + std::to_string(i));
+    ASSERT_TRUE(model != nullptr);
+    ODECollisionPtr collision = boost::dynamic_pointer_cast<ODECollision>(
+        model->GetLink("link")->GetCollision("collision"));
+    ASSERT_TRUE(collision != nullptr);
+    ASSERT_EQ(dGeomGetClass(collision->GetCollisionId()), dTriMeshClass);
+    data.push_back(dGeomTriMeshGetData(collision->GetCollisionId()));
+  }
+  EXPECT_EQ(data[0], data[1]);
+  EXPECT_NE(data[0], data[2]);
+
+  // The meshes are 2 m boxes, which land on their faces
+  world->Step(1000);
+  for (unsigned int i = 0; i < scales.size(); ++i)
+  {
+    ModelPtr model = world->ModelByName("mesh_" + std::to_string(i));
+    EXPECT_NEAR(model->WorldPose().Pos().Z(), scales[i], 0.05);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(ODEPhysics_TEST, IslandThreads)
+{
+  Load("worlds/shapes.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  ODEPhysicsPtr odePhysics =
+      boost::dynamic_pointer_cast<ODEPhysics>(world->Physics());
+  ASSERT_TRUE(odePhysics != nullptr);
+
+  // The shapes fall separately, so each is its own island. Islands are
+  // independent, so the order in which the pool steps them must not change
+  // the result.
+  auto run = [&](const int _threads)
+  {
+    world->Reset();
+    odePhysics->SetSeed(1);
+    EXPECT_TRUE(odePhysics->SetParam("island_threads", _threads));
+    world->ModelByName("box")->SetWorldPose(
+        ignition::math::Pose3d(0, 0, 1.5, 0, 0.2, 0));
+    world->ModelByName("sphere")->SetWorldPose(
+        ignition::math::Pose3d(0, 1.5, 2, 0, 0, 0));
+    world->ModelByName("cylinder")->SetWorldPose(
+        ignition::math::Pose3d(0, -1.5, 2.5, 0.3, 0, 0));
+
+    std::vector<ignition::math::Pose3d> poses;
+    for (unsigned int i = 0; i < 10; ++i)
+    {
+      world->Step(50);
+      for (const auto &model : world->Models())
+        poses.push_back(model->WorldPose());
+    }
+    return poses;
+  };
+
+  const std::vector<ignition::math::Pose3d> serialPoses = run(0);
+  const std::vector<ignition::math::Pose3d> threadedPoses = run(2);
+  EXPECT_TRUE(odePhysics->SetParam("island_threads", 0));
+  ASSERT_EQ(serialPoses.size(), threadedPoses.size());
+  for (size_t i = 0; i < serialPoses.size(); ++i)
+    EXPECT_EQ(serialPoses[i], threadedPoses[i]) << i;
+}
+
+std::mutex g_diagnosticsMutex;
+int g_diagnosticsIterations = -1;
+
+/////////////////////////////////////////////////
+void OnDiagnostics(ConstParam_VPtr &_msg)
+{
+  std::lock_guard<std::mutex> lock(g_diagnosticsMutex);
+  for (int i = 0; i < _msg->param_size(); ++i)
+  {
+    if (_msg->param(i).name() == "iterations")
+      g_diagnosticsIterations = _msg->param(i).value().int_value();
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(ODEPhysics_TEST, AdaptiveIterations)
+{
+  Load("worlds/shapes.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  ODEPhysicsPtr odePhysics =
+      boost::dynamic_pointer_cast<ODEPhysics>(world->Physics());
+  ASSERT_TRUE(odePhysics != nullptr);
+
+  const int iters = 100;
+  const int minIters = 7;
+  EXPECT_TRUE(odePhysics->SetParam("iters", iters));
+  EXPECT_TRUE(odePhysics->SetParam("precon_iters", 0));
+  EXPECT_TRUE(odePhysics->SetParam("extra_friction_iterations", 0));
+  EXPECT_TRUE(odePhysics->SetParam("min_iters", minIters));
+
+  // Let the shapes come to rest, so that there are contacts to solve
+  world->Step(500);
+
+  // Without a tolerance every iteration is done
+  EXPECT_TRUE(odePhysics->SetParam("sor_lcp_tolerance", -1.0));
+  world->Step(1);
+  EXPECT_EQ(boost::any_cast<int>(odePhysics->GetParam("iters_used")), iters);
+
+  // Any residual is below a huge tolerance, so the solver stops as soon as
+  // it's allowed to
+  EXPECT_TRUE(odePhysics->SetParam("sor_lcp_tolerance", 1e10));
+  world->Step(1);
+  EXPECT_EQ(boost::any_cast<int>(odePhysics->GetParam("iters_used")),
+      minIters);
+
+  // The iteration counts are published when someone listens
+  transport::NodePtr node(new transport::Node());
+  node->Init();
+  {
+    std::lock_guard<std::mutex> lock(g_diagnosticsMutex);
+    g_diagnosticsIterations = -1;
+  }
+  transport::SubscriberPtr sub =
+      node->Subscribe("~/physics/diagnostics", &OnDiagnostics);
+
+  for (int i = 0; i < 100; ++i)
+  {
+    world->Step(1);
+    common::Time::MSleep(10);
+    std::lock_guard<std::mutex> lock(g_diagnosticsMutex);
+    if (g_diagnosticsIterations >= 0)
+      break;
+  }
+  std::lock_guard<std::mutex> lock(g_diagnosticsMutex);
+  EXPECT_EQ(g_diagnosticsIterations, minIters);
+}
+
+/////////////////////////////////////////////////
+TEST_F(ODEPhysics_TEST, ContactWarmStart)
+{
+  Load("worlds/shapes.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  ODEPhysicsPtr odePhysics =
+      boost::dynamic_pointer_cast<ODEPhysics>(world->Physics());
+  ASSERT_TRUE(odePhysics != nullptr);
+
+  // With few iterations, a box resting on the ground keeps sinking and
+  // bouncing unless the contact impulses carry over between steps.
+  EXPECT_TRUE(odePhysics->SetParam("iters", 5));
+  EXPECT_TRUE(odePhysics->SetParam("contact_warm_start", true));
+
+  ModelPtr box = world->ModelByName("box");
+  ASSERT_TRUE(box != nullptr);
+
+  world->Step(500);
+  for (unsigned int i = 0; i < 100; ++i)
+  {
+    world->Step(1);
+    EXPECT_NEAR(box->WorldPose().Pos().Z(), 0.5, 1e-2);
+    EXPECT_LT(box->WorldLinearVel().Length(), 1e-2);
+  }
+
+  // Reset drops the cached impulses along with the contacts
+  world->Reset();
+  world->Step(500);
+  EXPECT_NEAR(box->WorldPose().Pos().Z(), 0.5, 1e-2);
+}
+
+/////////////////////////////////////////////////
+TEST_F(ODEPhysics_TEST, StaticSpace)
+{
+  Load("worlds/shapes.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  ODEPhysicsPtr odePhysics =
+      boost::dynamic_pointer_cast<ODEPhysics>(world->Physics());
+  ASSERT_TRUE(odePhysics != nullptr);
+  ASSERT_TRUE(odePhysics->StaticSpaceEnabled());
+
+  ModelPtr box = world->ModelByName("box");
+  ASSERT_TRUE(box != nullptr);
+  ModelPtr ground = world->ModelByName("ground_plane");
+  ASSERT_TRUE(ground != nullptr);
+  ASSERT_TRUE(ground->IsStatic());
+
+  // Only the ground plane is static
+  EXPECT_EQ(dSpaceGetNumGeoms(odePhysics->StaticSpaceId()), 1);
+
+  // The shapes still land on the ground
+  world->Step(500);
+  EXPECT_NEAR(box->WorldPose().Pos().Z(), 0.5, 1e-2);
+
+  // Rays hit static geometry
+  RayShapePtr ray = boost::dynamic_pointer_cast<RayShape>(
+      world->Physics()->CreateShape("ray", CollisionPtr()));
+  ASSERT_TRUE(ray != nullptr);
+  double dist = 0;
+  std::string entity;
+  ray->SetPoints(ignition::math::Vector3d(5, 5, 2),
+                 ignition::math::Vector3d(5, 5, -2));
+  ray->GetIntersection(dist, entity);
+  EXPECT_NEAR(dist, 2.0, 1e-3);
+  EXPECT_NE(entity.find("ground_plane"), std::string::npos);
+
+  // Moving the static model back to the world space keeps the contacts
+  odePhysics->SetStaticSpaceEnabled(false);
+  EXPECT_EQ(dSpaceGetNumGeoms(odePhysics->StaticSpaceId()), 0);
+  world->Step(100);
+  EXPECT_NEAR(box->WorldPose().Pos().Z(), 0.5, 1e-2);
+
+  odePhysics->SetStaticSpaceEnabled(true);
+  EXPECT_EQ(dSpaceGetNumGeoms(odePhysics->StaticSpaceId()), 1);
+  world->Step(100);
+  EXPECT_NEAR(box->WorldPose().Pos().Z(), 0.5, 1e-2);
+}
+
+/////////////////////////////////////////////////
+TEST_F(ODEPhysics_TEST, ParallelQuickStep)
+{
+  Load("worlds/shapes.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != nullptr);
+
+  // Without the parallel solver this falls back to quickstep, either way
+  // the shapes should come to rest on the ground.
+  const std::string type = "parallel_quick";
+  EXPECT_TRUE(physics->SetParam("solver_type", type));
+  EXPECT_EQ(boost::any_cast<std::string>(physics->GetParam("solver_type")),
+      type);
+
+  ModelPtr box = world->ModelByName("box");
+  ASSERT_TRUE(box != nullptr);
+  ModelPtr sphere = world->ModelByName("sphere");
+  ASSERT_TRUE(sphere != nullptr);
+
+  world->Step(1000);
+  EXPECT_NEAR(box->WorldPose().Pos().Z(), 0.5, 1e-2);
+  EXPECT_NEAR(sphere->WorldPose().Pos().Z(), 0.5, 1e-2);
+  EXPECT_NEAR(box->WorldLinearVel().Length(), 0.0, 1e-2);
+}
+
+/////////////////////////////////////////////////
+TEST_F(ODEPhysics_TEST, CastRays)
+{
+  Load("worlds/shapes.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != nullptr);
+
+  ModelPtr box = world->ModelByName("box");
+  ASSERT_TRUE(box != nullptr);
+  CollisionPtr boxCollision = box->GetLink()->GetCollision("collision");
+  ASSERT_TRUE(boxCollision != nullptr);
+
+  world->Step(100);
+
+  std::vector<ignition::math::Vector3d> origins;
+  std::vector<ignition::math::Vector3d> directions;
+
+  // Into the side of the box
+  origins.push_back(ignition::math::Vector3d(-5, 0, 0.5));
+  directions.push_back(ignition::math::Vector3d::UnitX);
+  // Down to the ground
+  origins.push_back(ignition::math::Vector3d(5, 5, 2));
+  directions.push_back(-ignition::math::Vector3d::UnitZ);
+  // Up into the sky
+  origins.push_back(ignition::math::Vector3d(5, 5, 2));
+  directions.push_back(ignition::math::Vector3d::UnitZ);
+  // A fan going through the other shapes
+  for (int i = 0; i < 100; ++i)
+  {
+    origins.push_back(ignition::math::Vector3d(0, 0, 3));
+    directions.push_back(ignition::math::Vector3d(
+        std::cos(i * 0.0628), std::sin(i * 0.0628), -1).Normalized());
+  }
+
+  std::vector<double> distances;
+  std::vector<uint32_t> ids;
+  physics->CastRays(origins, directions, 10, distances, ids);
+  ASSERT_EQ(distances.size(), origins.size());
+  ASSERT_EQ(ids.size(), origins.size());
+
+  EXPECT_NEAR(distances[0], 4.5, 1e-3);
+  EXPECT_EQ(ids[0], boxCollision->GetId());
+
+  EXPECT_NEAR(distances[1], 2.0, 1e-3);
+  BasePtr hit = world->BaseByName(
+      "ground_plane::link::collision");
+  ASSERT_TRUE(hit != nullptr);
+  EXPECT_EQ(ids[1], hit->GetId());
+
+  EXPECT_TRUE(std::isinf(distances[2]));
+  EXPECT_EQ(ids[2], 0u);
+
+  // The batch matches casting one ray at a time
+  std::vector<double> serialDistances;
+  std::vector<uint32_t> serialIds;
+  physics->PhysicsEngine::CastRays(origins, directions, 10,
+      serialDistances, serialIds);
+  ASSERT_EQ(serialDistances.size(), origins.size());
+  for (size_t i = 0; i < origins.size(); ++i)
+  {
+    EXPECT_EQ(ids[i], serialIds[i]) << i;
+    if (ids[i] != 0)
+      EXPECT_NEAR(distances[i], serialDistances[i], 1e-6) << i;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(ODEPhysics_TEST, CollisionFilter)
+{
+  Load("worlds/shapes.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  ModelPtr box = world->ModelByName("box");
+  ASSERT_TRUE(box != nullptr);
+  ODECollisionPtr boxCollision = boost::dynamic_pointer_cast<ODECollision>(
+      box->GetLink()->GetCollision("collision"));
+  ASSERT_TRUE(boxCollision != nullptr);
+
+  // The filter data is set up when the collision is loaded
+  EXPECT_EQ(boxCollision->FilterWord() & ODECollision::kFilterMaxContacts,
+      boxCollision->GetMaxContacts());
+  EXPECT_EQ(boxCollision->FilterMask() & 0xffffffffu,
+      boxCollision->GetSurface()->collideBitmask);
+  EXPECT_EQ((boxCollision->FilterWord() >> ODECollision::kFilterClassShift) &
+      0xff, static_cast<unsigned int>(boxCollision->GetCollisionClass()));
+
+  boxCollision->SetMaxContacts(2);
+  EXPECT_EQ(boxCollision->FilterWord() & ODECollision::kFilterMaxContacts,
+      2u);
+
+  world->Step(100);
+  EXPECT_NEAR(box->WorldPose().Pos().Z(), 0.5, 1e-2);
+
+  // Surface parameters written directly are picked up on the next step
+  boxCollision->GetSurface()->collideBitmask = 0;
+  world->Step(100);
+  EXPECT_EQ(boxCollision->FilterMask() & 0xffffffffu, 0u);
+  EXPECT_LT(box->WorldPose().Pos().Z(), 0.0);
+}
+
 /////////////////////////////////////////////////
 /// Main
 int main(int argc, char **argv)
@@ -138,6 +138,9 @@ void ODERayShape::GetIntersection(double &_dist, std::string &_entity)
       dSpaceCollide2(this->geomId,
           (dGeomID)(this->physicsEngine->GetSpaceId()),
           &intersection, &UpdateCallback);
+      dSpaceCollide2(this->geomId,
+          (dGeomID)(this->physicsEngine->StaticSpaceId()),
+          &intersection, &UpdateCallback);
     }
 
     _dist = intersection.depth;
@@ -19,6 +19,7 @@
 #include "gazebo/physics/Link.hh"
 #include "gazebo/physics/Gripper.hh"
 #include "gazebo/transport/Publisher.hh"
+#include "gazebo/physics/simbody/SimbodyJoint.hh"
 #include "gazebo/physics/simbody/SimbodyModel.hh"
 #include "gazebo/physics/simbody/SimbodyPhysics.hh"
 #include "gazebo/physics/simbody/SimbodyTypes.hh"
@@ -121,6 +122,134 @@ void SimbodyModel::Init()
   }
 }
 
+/// \brief Get a Simbody joint whose coordinates are its joint axes.
+/// \param[in] _joint The joint.
+/// \param[in] _state Simbody state.
+/// \return The joint, or nullptr if its states must go through the Joint
+/// API.
+static SimbodyJoint *NativeJoint(const JointPtr &_joint,
+    const SimTK::State &_state)
+{
+  SimbodyJoint *joint = dynamic_cast<SimbodyJoint *>(_joint.get());
+  if (!joint || !joint->physicsInitialized || joint->mobod.isEmptyHandle())
+    return nullptr;
+
+  // Ball joints use quaternions, and fixed joints have no coordinates
+  const int dofs = static_cast<int>(_joint->DOF());
+  if (dofs == 0 || joint->mobod.getNumQ(_state) != dofs ||
+      joint->mobod.getNumU(_state) != dofs)
+  {
+    return nullptr;
+  }
+
+  return joint;
+}
+
+//////////////////////////////////////////////////
+void SimbodyModel::JointStates(std::vector<double> &_positions,
+    std::vector<double> &_velocities)
+{
+  physics::SimbodyPhysicsPtr simbodyPhysics =
+    boost::dynamic_pointer_cast<physics::SimbodyPhysics>(
+        this->GetWorld()->Physics());
+  if (this->IsStatic() || !simbodyPhysics ||
+      !simbodyPhysics->simbodyPhysicsInitialized)
+  {
+    Model::JointStates(_positions, _velocities);
+    return;
+  }
+
+  const unsigned int count = this->JointStateCount();
+  _positions.resize(count);
+  _velocities.resize(count);
+
+  boost::recursive_mutex::scoped_lock lock(
+      *simbodyPhysics->GetPhysicsUpdateMutex());
+
+  const SimTK::State &state = simbodyPhysics->integ->getState();
+  unsigned int index = 0;
+  for (const auto &joint : this->GetJoints())
+  {
+    SimbodyJoint *simbodyJoint = NativeJoint(joint, state);
+    for (unsigned int i = 0; i < joint->DOF(); ++i, ++index)
+    {
+      if (simbodyJoint)
+      {
+        _positions[index] = simbodyJoint->mobod.getOneQ(state,
+            SimTK::MobilizerQIndex(i));
+        _velocities[index] = simbodyJoint->mobod.getOneU(state,
+            SimTK::MobilizerUIndex(i));
+      }
+      else
+      {
+        _positions[index] = joint->Position(i);
+        _velocities[index] = joint->GetVelocity(i);
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+bool SimbodyModel::SetJointStates(const std::vector<double> &_positions,
+    const std::vector<double> &_velocities)
+{
+  physics::SimbodyPhysicsPtr simbodyPhysics =
+    boost::dynamic_pointer_cast<physics::SimbodyPhysics>(
+        this->GetWorld()->Physics());
+  if (this->IsStatic() || !simbodyPhysics ||
+      !simbodyPhysics->simbodyPhysicsInitialized)
+  {
+    return Model::SetJointStates(_positions, _velocities);
+  }
+
+  const unsigned int count = this->JointStateCount();
+  if ((!_positions.empty() && _positions.size() != count) ||
+      (!_velocities.empty() && _velocities.size() != count))
+  {
+    gzerr << "Model [" << this->GetScopedName() << "] has " << count
+          << " joint states, got " << _positions.size() << " positions and "
+          << _velocities.size() << " velocities\n";
+    return false;
+  }
+
+  boost::recursive_mutex::scoped_lock lock(
+      *simbodyPhysics->GetPhysicsUpdateMutex());
+
+  SimTK::State &state = simbodyPhysics->integ->updAdvancedState();
+  unsigned int index = 0;
+  for (const auto &joint : this->GetJoints())
+  {
+    SimbodyJoint *simbodyJoint = NativeJoint(joint, state);
+    for (unsigned int i = 0; i < joint->DOF(); ++i, ++index)
+    {
+      if (simbodyJoint)
+      {
+        if (!_positions.empty())
+        {
+          simbodyJoint->mobod.setOneQ(state, SimTK::MobilizerQIndex(i),
+              _positions[index]);
+        }
+        if (!_velocities.empty())
+        {
+          simbodyJoint->mobod.setOneU(state, SimTK::MobilizerUIndex(i),
+              _velocities[index]);
+        }
+      }
+      else if (!_velocities.empty())
+      {
+        // Simbody joints don't support Joint::SetPosition
+        joint->SetVelocity(i, _velocities[index]);
+      }
+    }
+  }
+
+  // Realize once for all the joints
+  simbodyPhysics->system.realize(simbodyPhysics->integ->getAdvancedState(),
+      SimTK::Stage::Velocity);
+
+  return true;
+}
+
 //////////////////////////////////////////////////
 // void SimbodyModel::FillMsg(msgs::Model &_msg)
 // {
@@ -18,6 +18,8 @@
 #ifndef _SIMBODY_MODEL_HH_
 #define _SIMBODY_MODEL_HH_
 
+#include <vector>
+
 #include "gazebo/physics/Model.hh"
 #include "gazebo/util/system.hh"
 
@@ -44,6 +46,24 @@ namespace gazebo
 
       // Documentation inherited
       public: virtual void Init();
+
+      /// \brief Get the joint states straight from the Simbody state.
+      /// \param[out] _positions Joint positions.
+      /// \param[out] _velocities Joint velocities.
+      /// \sa Model::JointStates
+      public: virtual void JointStates(std::vector<double> &_positions,
+                  std::vector<double> &_velocities);
+
+      /// \brief Set the joint states in the Simbody state, and realize it
+      /// once for all the joints. Simbody joints don't support
+      /// Joint::SetPosition, so this is the only way to set positions.
+      /// \param[in] _positions Joint positions.
+      /// \param[in] _velocities Joint velocities.
+      /// \return False if the sizes don't match.
+      /// \sa Model::SetJointStates
+      public: virtual bool SetJointStates(
+                  const std::vector<double> &_positions,
+                  const std::vector<double> &_velocities);
     };
     /// \}
   }
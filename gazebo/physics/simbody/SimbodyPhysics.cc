@@ -15,6 +15,7 @@
  *
 */
 
+#include <algorithm>
 #include <string>
 
 #include <ignition/common/Profiler.hh>
@@ -56,9 +57,12 @@
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Exception.hh"
+#include "gazebo/common/SamplingProfiler.hh"
 
 #include "gazebo/transport/Publisher.hh"
 
+#include "gazebo/util/IntrospectionManager.hh"
+
 #include "gazebo/physics/simbody/SimbodyPhysics.hh"
 
 typedef boost::shared_ptr<gazebo::physics::SimbodyJoint> SimbodyJointPtr;
@@ -173,6 +177,15 @@ void SimbodyPhysics::Load(sdf::ElementPtr _sdf)
     simbodyContactElem->Get<double>("override_impact_capture_velocity");
   this->contactStictionTransitionVelocity =
     simbodyContactElem->Get<double>("override_stiction_transition_velocity");
+
+  {
+    const std::string kElementName = "ignition:topology_batch_size";
+    if (simbodyElem->HasElement(kElementName))
+    {
+      this->topologyBatchSize = static_cast<unsigned int>(
+          std::max(0, simbodyElem->Get<int>(kElementName)));
+    }
+  }
 }
 
 /////////////////////////////////////////////////
@@ -251,6 +264,7 @@ void SimbodyPhysics::OnPhysicsMsg(ConstPhysicsPtr &_msg)
 //////////////////////////////////////////////////
 void SimbodyPhysics::Reset()
 {
+  this->RealizePendingTopology();
   this->integ->initialize(this->system.getDefaultState());
 
   // restore potentially user run-time modified gravity
@@ -261,46 +275,31 @@ void SimbodyPhysics::Reset()
 void SimbodyPhysics::Init()
 {
   this->simbodyPhysicsInitialized = true;
+
+  common::URI latencyURI(this->world->URI());
+  latencyURI.Query().Insert("p", "physics/simbody/spawn_latency");
+  this->introspectionItems.push_back(latencyURI);
+  gazebo::util::IntrospectionManager::Instance()->Register<double>(
+      latencyURI.Str(), [this]() { return this->spawnLatency; });
 }
 
 //////////////////////////////////////////////////
 void SimbodyPhysics::InitModel(const physics::ModelPtr _model)
 {
   // Before building a new system, transfer all joints in existing
-  // models, save Simbody joint states in Gazebo Model.
-  const SimTK::State& currentState = this->integ->getState();
-  double stateTime = 0;
-  bool simbodyStateSaved = false;
-
-  if (currentState.getSystemStage() != SimTK::Stage::Empty)
+  // models, save Simbody joint states in Gazebo Model. This is only needed
+  // once per batch, the pending models have no state yet.
+  if (this->pendingModels.empty())
   {
-    stateTime = currentState.getTime();
-    physics::Model_V models = this->world->Models();
-    for (physics::Model_V::iterator mi = models.begin();
-         mi != models.end(); ++mi)
-    {
-      if ((*mi) != _model)
-      {
-        physics::Joint_V joints = (*mi)->GetJoints();
-        for (physics::Joint_V::iterator jx = joints.begin();
-             jx != joints.end(); ++jx)
-        {
-          SimbodyJointPtr simbodyJoint =
-            boost::dynamic_pointer_cast<physics::SimbodyJoint>(*jx);
-          simbodyJoint->SaveSimbodyState(currentState);
-        }
+    this->pendingStartTime = common::Time::GetWallTime();
 
-        physics::Link_V links = (*mi)->GetLinks();
-        for (physics::Link_V::iterator lx = links.begin();
-             lx != links.end(); ++lx)
-        {
-          SimbodyLinkPtr simbodyLink =
-            boost::dynamic_pointer_cast<physics::SimbodyLink>(*lx);
-          simbodyLink->SaveSimbodyState(currentState);
-        }
-      }
+    const SimTK::State& currentState = this->integ->getState();
+    if (currentState.getSystemStage() != SimTK::Stage::Empty)
+    {
+      this->pendingStateTime = currentState.getTime();
+      this->SaveSimbodyState(currentState);
+      this->pendingStateSaved = true;
     }
-    simbodyStateSaved = true;
   }
 
   try
@@ -338,75 +337,135 @@ void SimbodyPhysics::InitModel(const physics::ModelPtr _model)
     gzthrow(std::string("Simbody init EXCEPTION: ") + e.what());
   }
 
+  this->pendingModels.push_back(_model);
+
+  // Realizing the topology is the expensive part, so it can be deferred
+  // until several models were added or the next step.
+  if (this->topologyBatchSize > 0 &&
+      this->pendingModels.size() >= this->topologyBatchSize)
+  {
+    this->RealizePendingTopology();
+  }
+}
+
+//////////////////////////////////////////////////
+void SimbodyPhysics::RealizePendingTopology()
+{
+  if (this->pendingModels.empty())
+    return;
+
+  IGN_PROFILE("SimbodyPhysics::RealizePendingTopology");
+  IGN_PROFILE_BEGIN("realizeTopology");
   SimTK::State state = this->system.realizeTopology();
+  IGN_PROFILE_END();
 
   // Restore Gazebo saved Joint states
   // back into Simbody state.
-  if (simbodyStateSaved)
+  if (this->pendingStateSaved)
   {
     // set/retsore state time.
-    state.setTime(stateTime);
-
-    physics::Model_V models = this->world->Models();
-    for (physics::Model_V::iterator mi = models.begin();
-         mi != models.end(); ++mi)
-    {
-      physics::Joint_V joints = (*mi)->GetJoints();
-      for (physics::Joint_V::iterator jx = joints.begin();
-           jx != joints.end(); ++jx)
-      {
-        SimbodyJointPtr simbodyJoint =
-          boost::dynamic_pointer_cast<physics::SimbodyJoint>(*jx);
-        simbodyJoint->RestoreSimbodyState(state);
-      }
-      physics::Link_V links = (*mi)->GetLinks();
-      for (physics::Link_V::iterator lx = links.begin();
-           lx != links.end(); ++lx)
-      {
-        SimbodyLinkPtr simbodyLink =
-          boost::dynamic_pointer_cast<physics::SimbodyLink>(*lx);
-        simbodyLink->RestoreSimbodyState(state);
-      }
-    }
+    state.setTime(this->pendingStateTime);
+    this->RestoreSimbodyState(state);
   }
 
   // initialize integrator from state
   this->integ->initialize(state);
 
-  // mark links as initialized
-  Link_V links = _model->GetLinks();
-  for (Link_V::iterator li = links.begin(); li != links.end(); ++li)
+  for (const auto &model : this->pendingModels)
   {
-    physics::SimbodyLinkPtr simbodyLink =
-      boost::dynamic_pointer_cast<physics::SimbodyLink>(*li);
-    if (simbodyLink)
-      simbodyLink->physicsInitialized = true;
-    else
-      gzerr << "failed to cast link [" << (*li)->GetName()
-            << "] as simbody link\n";
+    // mark links as initialized
+    Link_V links = model->GetLinks();
+    for (Link_V::iterator li = links.begin(); li != links.end(); ++li)
+    {
+      physics::SimbodyLinkPtr simbodyLink =
+        boost::dynamic_pointer_cast<physics::SimbodyLink>(*li);
+      if (simbodyLink)
+        simbodyLink->physicsInitialized = true;
+      else
+        gzerr << "failed to cast link [" << (*li)->GetName()
+              << "] as simbody link\n";
+    }
+
+    // mark joints as initialized
+    physics::Joint_V joints = model->GetJoints();
+    for (physics::Joint_V::iterator ji = joints.begin();
+         ji != joints.end(); ++ji)
+    {
+      SimbodyJointPtr simbodyJoint =
+        boost::dynamic_pointer_cast<SimbodyJoint>(*ji);
+      if (simbodyJoint)
+        simbodyJoint->physicsInitialized = true;
+      else
+        gzerr << "simbodyJoint [" << (*ji)->GetName()
+              << "]is not a SimbodyJointPtr\n";
+    }
   }
 
-  // mark joints as initialized
-  physics::Joint_V joints = _model->GetJoints();
-  for (physics::Joint_V::iterator ji = joints.begin();
-       ji != joints.end(); ++ji)
+  this->pendingModels.clear();
+  this->pendingStateSaved = false;
+  this->spawnLatency =
+      (common::Time::GetWallTime() - this->pendingStartTime).Double();
+
+  this->simbodyPhysicsInitialized = true;
+}
+
+//////////////////////////////////////////////////
+void SimbodyPhysics::SaveSimbodyState(const SimTK::State &_state)
+{
+  physics::Model_V models = this->world->Models();
+  for (physics::Model_V::iterator mi = models.begin();
+       mi != models.end(); ++mi)
   {
-    SimbodyJointPtr simbodyJoint =
-      boost::dynamic_pointer_cast<SimbodyJoint>(*ji);
-    if (simbodyJoint)
-      simbodyJoint->physicsInitialized = true;
-    else
-      gzerr << "simbodyJoint [" << (*ji)->GetName()
-            << "]is not a SimbodyJointPtr\n";
+    physics::Joint_V joints = (*mi)->GetJoints();
+    for (physics::Joint_V::iterator jx = joints.begin();
+         jx != joints.end(); ++jx)
+    {
+      SimbodyJointPtr simbodyJoint =
+        boost::dynamic_pointer_cast<physics::SimbodyJoint>(*jx);
+      simbodyJoint->SaveSimbodyState(_state);
+    }
+
+    physics::Link_V links = (*mi)->GetLinks();
+    for (physics::Link_V::iterator lx = links.begin();
+         lx != links.end(); ++lx)
+    {
+      SimbodyLinkPtr simbodyLink =
+        boost::dynamic_pointer_cast<physics::SimbodyLink>(*lx);
+      simbodyLink->SaveSimbodyState(_state);
+    }
   }
+}
 
-  this->simbodyPhysicsInitialized = true;
+//////////////////////////////////////////////////
+void SimbodyPhysics::RestoreSimbodyState(SimTK::State &_state)
+{
+  physics::Model_V models = this->world->Models();
+  for (physics::Model_V::iterator mi = models.begin();
+       mi != models.end(); ++mi)
+  {
+    physics::Joint_V joints = (*mi)->GetJoints();
+    for (physics::Joint_V::iterator jx = joints.begin();
+         jx != joints.end(); ++jx)
+    {
+      SimbodyJointPtr simbodyJoint =
+        boost::dynamic_pointer_cast<physics::SimbodyJoint>(*jx);
+      simbodyJoint->RestoreSimbodyState(_state);
+    }
+    physics::Link_V links = (*mi)->GetLinks();
+    for (physics::Link_V::iterator lx = links.begin();
+         lx != links.end(); ++lx)
+    {
+      SimbodyLinkPtr simbodyLink =
+        boost::dynamic_pointer_cast<physics::SimbodyLink>(*lx);
+      simbodyLink->RestoreSimbodyState(_state);
+    }
+  }
 }
 
 //////////////////////////////////////////////////
 void SimbodyPhysics::InitForThread()
 {
-  IGN_PROFILE_THREAD_NAME("SimbodyPhysics");
+  common::SetThreadName("SimbodyPhysics");
 }
 
 //////////////////////////////////////////////////
@@ -416,6 +475,9 @@ void SimbodyPhysics::UpdateCollision()
   IGN_PROFILE_BEGIN("UpdateCollision");
   boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
 
+  // Models added since the last step
+  this->RealizePendingTopology();
+
   this->contactManager->ResetCount();
 
   // Get all contacts from Simbody
@@ -458,15 +520,16 @@ void SimbodyPhysics::UpdateCollision()
       /// this is going to be very very slow, we'll need
       /// something with a void* pointer in simbody
       /// to support something like this.
-      physics::Model_V models = this->world->Models();
-      for (physics::Model_V::iterator mi = models.begin();
+      const physics::Model_V &models = this->world->Models();
+      for (physics::Model_V::const_iterator mi = models.begin();
            mi != models.end(); ++mi)
       {
-        physics::Link_V links = (*mi)->GetLinks();
-        for (Link_V::iterator li = links.begin(); li != links.end(); ++li)
+        const physics::Link_V &links = (*mi)->GetLinks();
+        for (Link_V::const_iterator li = links.begin(); li != links.end();
+             ++li)
         {
-          Collision_V collisions = (*li)->GetCollisions();
-          for (Collision_V::iterator ci = collisions.begin();
+          const Collision_V &collisions = (*li)->GetCollisions();
+          for (Collision_V::const_iterator ci = collisions.begin();
                ci != collisions.end(); ++ci)
           {
             /// compare SimbodyCollision::GetCollisionShape() to
@@ -651,6 +714,8 @@ void SimbodyPhysics::UpdatePhysics()
 
   common::Time currTime =  this->world->RealTime();
 
+  this->RealizePendingTopology();
+
   // Simbody cannot step the integrator without a subsystem
   const SimTK::State &s = this->integ->getState();
   if (s.getNumSubsystems() == 0)
@@ -720,6 +785,11 @@ void SimbodyPhysics::UpdatePhysics()
 //////////////////////////////////////////////////
 void SimbodyPhysics::Fini()
 {
+  for (auto &item : this->introspectionItems)
+    util::IntrospectionManager::Instance()->Unregister(item.Str());
+  this->introspectionItems.clear();
+  this->pendingModels.clear();
+
   PhysicsEngine::Fini();
 }
 
@@ -1652,6 +1722,14 @@ bool SimbodyPhysics::GetParam(const std::string &_key, boost::any &_value) const
   {
     _value = this->contact.getTransitionVelocity();
   }
+  else if (_key == "topology_batch_size")
+  {
+    _value = static_cast<int>(this->topologyBatchSize);
+  }
+  else if (_key == "spawn_latency")
+  {
+    _value = this->spawnLatency;
+  }
   else
   {
     return PhysicsEngine::GetParam(_key, _value);
@@ -1711,6 +1789,23 @@ bool SimbodyPhysics::SetParam(const std::string &_key, const boost::any &_value)
     {
       this->contactImpactCaptureVelocity = any_cast<double>(_value);
     }
+    else if (_key == "topology_batch_size")
+    {
+      int value = any_cast<int>(_value);
+      if (value < 0)
+      {
+        gzerr << "Topology batch size must be positive, or 0 to realize "
+              << "the topology before the next step only.\n";
+        return false;
+      }
+      boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+      this->topologyBatchSize = static_cast<unsigned int>(value);
+      if (this->topologyBatchSize > 0 &&
+          this->pendingModels.size() >= this->topologyBatchSize)
+      {
+        this->RealizePendingTopology();
+      }
+    }
     else
     {
       return PhysicsEngine::SetParam(_key, _value);
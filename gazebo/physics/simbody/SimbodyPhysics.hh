@@ -18,10 +18,12 @@
 #ifndef GAZEBO_PHYSICS_SIMBODY_SIMBODYPHYSICS_HH
 #define GAZEBO_PHYSICS_SIMBODY_SIMBODYPHYSICS_HH
 #include <string>
+#include <vector>
 
 #include <boost/thread/thread.hpp>
 #include <boost/thread/mutex.hpp>
 
+#include "gazebo/common/URI.hh"
 #include "gazebo/physics/PhysicsEngine.hh"
 #include "gazebo/physics/Collision.hh"
 #include "gazebo/physics/Shape.hh"
@@ -56,10 +58,18 @@ namespace gazebo
       // Documentation inherited
       public: virtual void Reset();
 
-      /// \brief Add a Model to the Simbody system.
+      /// \brief Add a Model to the Simbody system. The topology of the
+      /// system is realized right away, or once enough models are pending
+      /// when the "topology_batch_size" parameter is not 1. The models are
+      /// only simulated once the topology is realized.
       /// \param[in] _model Pointer to the model to add into Simbody.
       public: void InitModel(const physics::ModelPtr _model);
 
+      /// \brief Realize the topology of the Simbody system if models were
+      /// added since the last realization, and restore the state of the
+      /// existing models. Called before each step.
+      public: void RealizePendingTopology();
+
       // Documentation inherited
       public: virtual void InitForThread();
 
@@ -203,6 +213,16 @@ namespace gazebo
         const SimTK::MultibodyGraphMaker &_mbgraph,
         const physics::ModelPtr _model);
 
+      /// \brief Save the Simbody state of all links and joints in the
+      /// world, before the system is modified.
+      /// \param[in] _state Current state of the integrator.
+      private: void SaveSimbodyState(const SimTK::State &_state);
+
+      /// \brief Restore the Simbody state of all links and joints in the
+      /// world, after the system topology was realized.
+      /// \param[in,out] _state New state of the system.
+      private: void RestoreSimbodyState(SimTK::State &_state);
+
       /// \brief helper function for building SimbodySystem
       private: void AddCollisionsToLink(const physics::SimbodyLink *_link,
         SimTK::MobilizedBody &_mobod, SimTK::ContactCliqueId _modelClique);
@@ -282,6 +302,32 @@ namespace gazebo
       ///   SimTK::RungeKutta2Integrator(system)
       ///   SimTK::SemiExplicitEuler2Integrator(system)
       private: std::string integratorType;
+
+      /// \brief Number of models to add before realizing the topology of
+      /// the system. 1 realizes it for each model, 0 only before the next
+      /// step.
+      private: unsigned int topologyBatchSize = 1;
+
+      /// \brief Models added to the system since the last realization.
+      private: std::vector<ModelPtr> pendingModels;
+
+      /// \brief True if the state of the existing models was saved before
+      /// the pending models were added.
+      private: bool pendingStateSaved = false;
+
+      /// \brief Time of the state saved before the pending models were
+      /// added.
+      private: double pendingStateTime = 0;
+
+      /// \brief Wall time at which the first pending model was added.
+      private: common::Time pendingStartTime;
+
+      /// \brief Wall time between the addition of the first model of the
+      /// last batch and the realization of its topology, in seconds.
+      private: double spawnLatency = 0;
+
+      /// \brief Introspection items registered by the engine.
+      private: std::vector<common::URI> introspectionItems;
     };
   /// \}
   }
@@ -15,6 +15,7 @@
  *
 */
 
+#include <set>
 #include <sstream>
 
 #include <boost/algorithm/string.hpp>
@@ -56,6 +57,27 @@ using namespace rendering;
 
 unsigned int CameraPrivate::cameraCounter = 0;
 
+/// \brief Longest time a static view is republished without rendering.
+static const common::Time kMaxStaticViewAge(1, 0);
+
+//////////////////////////////////////////////////
+/// \brief Check if a visual or one of its descendants changed.
+/// \param[in] _vis Visual to check.
+/// \param[in] _stamp Stamp to compare with, see Visual::ChangeStamp().
+/// \return True if a change is more recent than the stamp.
+static bool ChangedSince(const VisualPtr &_vis, const uint64_t _stamp)
+{
+  if (_vis->ChangeStamp() > _stamp)
+    return true;
+
+  for (unsigned int i = 0; i < _vis->GetChildCount(); ++i)
+  {
+    if (ChangedSince(_vis->GetChild(i), _stamp))
+      return true;
+  }
+  return false;
+}
+
 //////////////////////////////////////////////////
 Camera::Camera(const std::string &_name, ScenePtr _scene,
                bool _autoRender)
@@ -353,6 +375,7 @@ void Camera::Init()
 void Camera::Fini()
 {
   this->dataPtr->videoEncoder.Reset();
+  this->dataPtr->readback.reset();
 
   if (this->saveFrameBuffer)
     delete [] this->saveFrameBuffer;
@@ -560,6 +583,19 @@ void Camera::Render(const bool _force)
         this->dataPtr->renderPeriod))
   {
     this->newData = true;
+    this->dataPtr->renderSimTime = this->scene->SimTime();
+
+    // Frames in flight may predate the view becoming static, so only
+    // synchronous readback can republish the last image
+    this->dataPtr->reuseFrame = this->dataPtr->skipStaticViews &&
+        !this->ViewChanged() && this->saveFrameBuffer &&
+        !this->dataPtr->readback &&
+        this->dataPtr->renderSimTime - this->dataPtr->fullRenderSimTime <
+        kMaxStaticViewAge;
+    if (this->dataPtr->reuseFrame)
+      return;
+
+    this->dataPtr->fullRenderSimTime = this->dataPtr->renderSimTime;
     this->RenderImpl();
   }
 }
@@ -587,6 +623,16 @@ void Camera::RenderImpl()
 //////////////////////////////////////////////////
 void Camera::ReadPixelBuffer()
 {
+  // The texture still holds the last image, stamp it with the new time
+  if (this->newData && this->dataPtr->reuseFrame)
+  {
+    this->dataPtr->imageTime = this->dataPtr->renderSimTime;
+    this->dataPtr->frameRead = true;
+    return;
+  }
+
+  this->dataPtr->frameRead = false;
+
   if (this->newData && (this->captureData || this->captureDataOnce ||
       this->dataPtr->videoEncoder.IsEncoding()))
   {
@@ -598,6 +644,34 @@ void Camera::ReadPixelBuffer()
     size = Ogre::PixelUtil::getMemorySize(width, height, 1,
         static_cast<Ogre::PixelFormat>(this->imageFormat));
 
+    // Read the texture through pixel buffers so the GPU does not stall,
+    // the image then comes from an earlier render, see ImageTime().
+    // Windows (UserCamera) are read synchronously.
+    unsigned int buffers = PixelBufferReadback::BufferCount();
+    if (buffers > 0 && this->renderTexture &&
+        this->renderTexture->getBuffer()->getRenderTarget() ==
+        this->renderTarget)
+    {
+      if (!this->dataPtr->readback)
+        this->dataPtr->readback.reset(new PixelBufferReadback);
+
+      if (this->dataPtr->readback->Init(this->renderTexture,
+            this->imageFormat, width, height, buffers))
+      {
+        this->dataPtr->readback->Request(this->dataPtr->renderSimTime);
+        if (this->dataPtr->readback->Ready())
+        {
+          if (!this->saveFrameBuffer)
+            this->saveFrameBuffer = new unsigned char[size];
+
+          this->dataPtr->frameRead = this->dataPtr->readback->Read(
+              this->saveFrameBuffer, this->dataPtr->imageTime);
+        }
+        return;
+      }
+    }
+    this->dataPtr->readback.reset();
+
     // Allocate buffer
     if (!this->saveFrameBuffer)
       this->saveFrameBuffer = new unsigned char[size];
@@ -651,6 +725,9 @@ void Camera::ReadPixelBuffer()
     // pixels from buffer into memory.
     this->viewport->getTarget()->copyContentsToMemory(box);
 #endif
+
+    this->dataPtr->imageTime = this->dataPtr->renderSimTime;
+    this->dataPtr->frameRead = true;
   }
 }
 
@@ -660,6 +737,81 @@ common::Time Camera::LastRenderWallTime() const
   return this->lastRenderWallTime;
 }
 
+//////////////////////////////////////////////////
+common::Time Camera::LastRenderSimTime() const
+{
+  return this->dataPtr->renderSimTime;
+}
+
+//////////////////////////////////////////////////
+common::Time Camera::ImageTime() const
+{
+  return this->dataPtr->imageTime;
+}
+
+//////////////////////////////////////////////////
+void Camera::SetSkipStaticViews(const bool _skip)
+{
+  this->dataPtr->skipStaticViews = _skip;
+  this->dataPtr->viewRecorded = false;
+}
+
+//////////////////////////////////////////////////
+bool Camera::SkipStaticViews() const
+{
+  return this->dataPtr->skipStaticViews;
+}
+
+//////////////////////////////////////////////////
+bool Camera::ViewChanged()
+{
+  IGN_PROFILE("rendering::Camera::ViewChanged");
+
+  const uint64_t stamp = Visual::LatestChangeStamp();
+  const ignition::math::Pose3d pose = this->WorldPose();
+
+  bool changed = !this->dataPtr->viewRecorded ||
+      pose != this->dataPtr->viewPose;
+
+  std::set<uint32_t> inView;
+  size_t stillThere = 0;
+  VisualPtr world = this->scene->WorldVisual();
+  for (unsigned int i = 0; world && i < world->GetChildCount(); ++i)
+  {
+    VisualPtr vis = world->GetChild(i);
+    Ogre::SceneNode *node = vis->GetSceneNode();
+    if (!node)
+      continue;
+
+    const bool wasInView = this->dataPtr->viewVisuals.count(vis->GetId()) > 0;
+    if (wasInView)
+      ++stillThere;
+
+    // Bounds of moved nodes are only refreshed when the scene renders
+    const bool visChanged = ChangedSince(vis, this->dataPtr->viewStamp);
+    if (visChanged)
+      node->_update(true, false);
+
+    const bool isInView = this->camera->isVisible(node->_getWorldAABB());
+    if (isInView)
+      inView.insert(vis->GetId());
+
+    if (visChanged && (isInView || wasInView))
+      changed = true;
+  }
+
+  // A visual that was in view is gone
+  if (stillThere != this->dataPtr->viewVisuals.size())
+    changed = true;
+
+  this->dataPtr->viewVisuals.swap(inView);
+  this->dataPtr->viewStamp = stamp;
+  this->dataPtr->viewPose = pose;
+  this->dataPtr->viewRecorded = true;
+
+  return changed;
+}
+
 //////////////////////////////////////////////////
 void Camera::PostRender()
 {
@@ -671,8 +823,8 @@ void Camera::PostRender()
   if (this->newData)
     this->lastRenderWallTime = common::Time::GetWallTime();
 
-  if (this->newData && (this->captureData || this->captureDataOnce ||
-      this->dataPtr->videoEncoder.IsEncoding()))
+  // With asynchronous readback the first renders have no image yet
+  if (this->newData && this->dataPtr->frameRead)
   {
     unsigned int width = this->ImageWidth();
     unsigned int height = this->ImageHeight();
@@ -2064,6 +2216,16 @@ unsigned int Camera::TriangleCount() const
 #endif
 }
 
+//////////////////////////////////////////////////
+unsigned int Camera::BatchCount() const
+{
+#if OGRE_VERSION_MAJOR == 1 && OGRE_VERSION_MINOR >= 11
+  return this->renderTarget->getStatistics().batchCount;
+#else
+  return this->renderTarget->getBatchCount();
+#endif
+}
+
 //////////////////////////////////////////////////
 bool Camera::SetProjectionType(const std::string &_type)
 {
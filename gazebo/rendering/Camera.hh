@@ -442,6 +442,11 @@ namespace gazebo
       /// \return The current triangle count
       public: virtual unsigned int TriangleCount() const;
 
+      /// \brief Get the number of batches, i.e. draw calls, issued by the
+      /// last update of the render target.
+      /// \return The current batch count
+      public: unsigned int BatchCount() const;
+
       /// \brief Set the aspect ratio
       /// \param[in] _ratio The aspect ratio (width / height) in pixels
       public: void SetAspectRatio(float _ratio);
@@ -624,6 +629,37 @@ namespace gazebo
       /// \return Time the camera was last rendered
       public: common::Time LastRenderWallTime() const;
 
+      /// \brief Get the simulation time of the last render.
+      /// \return Scene simulation time when the camera was last rendered.
+      public: common::Time LastRenderSimTime() const;
+
+      /// \brief Get the simulation time at which the image returned by
+      /// ImageData() was rendered. With asynchronous readback enabled
+      /// (GAZEBO_CAMERA_ASYNC_READBACK) the image lags the last render by
+      /// one frame, or two with three buffers, and this time says which
+      /// render it came from.
+      /// \return Simulation time of the current image.
+      public: common::Time ImageTime() const;
+
+      /// \brief Republish the last image instead of rendering when nothing
+      /// in view changed: the camera pose and every visual whose bounds
+      /// are or were in the frustum are the same as at the previous
+      /// render, see Visual::ChangeStamp(). The camera still renders at
+      /// least once per second of simulation time, and always renders
+      /// when reading frames back asynchronously.
+      /// \param[in] _skip True to skip renders of static views.
+      public: void SetSkipStaticViews(const bool _skip);
+
+      /// \brief Check if renders of static views are skipped.
+      /// \return True if SetSkipStaticViews(true) was called.
+      public: bool SkipStaticViews() const;
+
+      /// \brief Compare the view of the camera with the one recorded by the
+      /// previous call, then record the current view.
+      /// \return True if the camera or a visual in view changed, or on the
+      /// first call.
+      public: bool ViewChanged();
+
       /// \brief Return true if the visual is within the camera's view
       /// frustum
       /// \param[in] _visual The visual to check for visibility
@@ -19,13 +19,17 @@
 
 #include <deque>
 #include <mutex>
+#include <set>
 #include <utility>
 #include <list>
+#include <memory>
 #include <ignition/math/Pose3.hh>
 
 #include "gazebo/common/PID.hh"
+#include "gazebo/common/Time.hh"
 #include "gazebo/common/VideoEncoder.hh"
 #include "gazebo/msgs/msgs.hh"
+#include "gazebo/rendering/PixelBufferReadback.hh"
 #include "gazebo/util/system.hh"
 
 namespace Ogre
@@ -117,6 +121,40 @@ namespace gazebo
 
       /// \brief Fixed axis to yaw around.
       public: ignition::math::Vector3d yawFixedAxis;
+
+      /// \brief Asynchronous readback of the render texture, null when
+      /// frames are read synchronously.
+      public: std::unique_ptr<PixelBufferReadback> readback;
+
+      /// \brief Simulation time of the last render.
+      public: common::Time renderSimTime;
+
+      /// \brief Simulation time the image in saveFrameBuffer was rendered.
+      public: common::Time imageTime;
+
+      /// \brief True if ReadPixelBuffer produced an image this frame.
+      public: bool frameRead = false;
+
+      /// \brief True to republish the last image when the view is static.
+      public: bool skipStaticViews = false;
+
+      /// \brief True if the current frame reuses the last image.
+      public: bool reuseFrame = false;
+
+      /// \brief Simulation time of the last render that was not skipped.
+      public: common::Time fullRenderSimTime;
+
+      /// \brief True once ViewChanged() recorded a view.
+      public: bool viewRecorded = false;
+
+      /// \brief Camera pose of the recorded view.
+      public: ignition::math::Pose3d viewPose;
+
+      /// \brief Visual::LatestChangeStamp() when the view was recorded.
+      public: uint64_t viewStamp = 0;
+
+      /// \brief Ids of the top level visuals in view when recorded.
+      public: std::set<uint32_t> viewVisuals;
     };
   }
 }
@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <ignition/common/Profiler.hh>
+
+#include "gazebo/rendering/ogre_gazebo.h"
+
+#include "gazebo/rendering/Camera.hh"
+#include "gazebo/rendering/Scene.hh"
+#include "gazebo/rendering/CameraRigPrivate.hh"
+#include "gazebo/rendering/CameraRig.hh"
+
+using namespace gazebo;
+using namespace rendering;
+
+/// \brief Largest difference in orientation and field of view, in radians,
+/// between two cameras of a group.
+static const double kGroupAngleTolerance = 1e-3;
+
+//////////////////////////////////////////////////
+CameraRig::CameraRig(ScenePtr _scene)
+  : dataPtr(new CameraRigPrivate)
+{
+  this->dataPtr->scene = _scene;
+}
+
+//////////////////////////////////////////////////
+CameraRig::~CameraRig()
+{
+  this->Clear();
+
+  if (this->dataPtr->cullingNode)
+  {
+    this->dataPtr->cullingNode->detachObject(this->dataPtr->cullingFrustum);
+    this->dataPtr->scene->OgreSceneManager()->destroySceneNode(
+        this->dataPtr->cullingNode);
+  }
+  delete this->dataPtr->cullingFrustum;
+}
+
+//////////////////////////////////////////////////
+bool CameraRig::Enabled()
+{
+  const char *env = std::getenv("GAZEBO_CAMERA_RIG");
+  return env && std::string(env) != "0";
+}
+
+//////////////////////////////////////////////////
+void CameraRig::AddCamera(CameraPtr _camera)
+{
+  if (_camera)
+    this->dataPtr->cameras.push_back(_camera);
+}
+
+//////////////////////////////////////////////////
+void CameraRig::Clear()
+{
+  this->dataPtr->cameras.clear();
+}
+
+//////////////////////////////////////////////////
+unsigned int CameraRig::SharedCount() const
+{
+  return this->dataPtr->sharedCount;
+}
+
+//////////////////////////////////////////////////
+void CameraRig::Render()
+{
+  IGN_PROFILE("rendering::CameraRig::Render");
+
+  this->dataPtr->sharedCount = 0;
+
+  const std::vector<CameraPtr> &cameras = this->dataPtr->cameras;
+  std::vector<bool> rendered(cameras.size(), false);
+  Ogre::SceneManager *sceneMgr = this->dataPtr->scene->OgreSceneManager();
+
+  for (size_t i = 0; i < cameras.size(); ++i)
+  {
+    if (rendered[i])
+      continue;
+    rendered[i] = true;
+
+    CameraPtr leader = cameras[i];
+    Ogre::Camera *leaderCam = leader->OgreCamera();
+    if (!leader->Initialized() || !leaderCam ||
+        leaderCam->getProjectionType() != Ogre::PT_PERSPECTIVE)
+    {
+      leader->Render(true);
+      continue;
+    }
+
+    // Cameras looking the same way through the same lens
+    std::vector<CameraPtr> group;
+    group.push_back(leader);
+    for (size_t j = i + 1; j < cameras.size(); ++j)
+    {
+      Ogre::Camera *cam = cameras[j]->OgreCamera();
+      if (rendered[j] || !cameras[j]->Initialized() || !cam ||
+          cam->getProjectionType() != Ogre::PT_PERSPECTIVE ||
+          std::abs(cam->getFOVy().valueRadians() -
+            leaderCam->getFOVy().valueRadians()) > kGroupAngleTolerance ||
+          std::abs(cam->getAspectRatio() - leaderCam->getAspectRatio()) >
+            kGroupAngleTolerance ||
+          !cam->getDerivedOrientation().equals(
+            leaderCam->getDerivedOrientation(),
+            Ogre::Radian(kGroupAngleTolerance)))
+      {
+        continue;
+      }
+      rendered[j] = true;
+      group.push_back(cameras[j]);
+    }
+
+    if (group.size() == 1)
+    {
+      leader->Render(true);
+      continue;
+    }
+
+    // Enclose the frusta of the group in one frustum with the same
+    // direction, moved back far enough to contain every camera
+    Ogre::Vector3 center = Ogre::Vector3::ZERO;
+    for (auto const &cam : group)
+      center += cam->OgreCamera()->getDerivedPosition();
+    center /= static_cast<Ogre::Real>(group.size());
+
+    Ogre::Real radius = 0;
+    Ogre::Real nearClip = leaderCam->getNearClipDistance();
+    Ogre::Real farClip = leaderCam->getFarClipDistance();
+    for (auto const &cam : group)
+    {
+      Ogre::Camera *ogreCam = cam->OgreCamera();
+      radius = std::max(radius,
+          ogreCam->getDerivedPosition().distance(center));
+      nearClip = std::min(nearClip, ogreCam->getNearClipDistance());
+      farClip = std::max(farClip, ogreCam->getFarClipDistance());
+    }
+
+    const Ogre::Radian fovY = leaderCam->getFOVy() +
+        Ogre::Radian(2.0 * kGroupAngleTolerance);
+    const double tanHalfFov = std::min(std::tan(fovY.valueRadians() * 0.5),
+        std::tan(fovY.valueRadians() * 0.5) * leaderCam->getAspectRatio());
+    const Ogre::Real offset = radius / tanHalfFov + radius;
+
+    if (!this->dataPtr->cullingFrustum)
+    {
+      this->dataPtr->cullingFrustum = new Ogre::Frustum();
+      this->dataPtr->cullingFrustum->setVisible(false);
+      this->dataPtr->cullingNode =
+          sceneMgr->getRootSceneNode()->createChildSceneNode();
+      this->dataPtr->cullingNode->attachObject(
+          this->dataPtr->cullingFrustum);
+    }
+
+    Ogre::Frustum *frustum = this->dataPtr->cullingFrustum;
+    frustum->setFOVy(fovY);
+    frustum->setAspectRatio(leaderCam->getAspectRatio());
+    frustum->setNearClipDistance(nearClip);
+    frustum->setFarClipDistance(farClip == 0 ? 0 : farClip + 2 * offset);
+    this->dataPtr->cullingNode->setPosition(
+        center - leaderCam->getDerivedDirection() * offset);
+    this->dataPtr->cullingNode->setOrientation(
+        leaderCam->getDerivedOrientation());
+    this->dataPtr->cullingNode->_update(true, false);
+
+    // The leader culls for the group and prepares the shadow textures
+    leaderCam->setCullingFrustum(frustum);
+    leader->Render(true);
+    leaderCam->setCullingFrustum(nullptr);
+
+    // The others render what the leader found, with its shadow textures
+    sceneMgr->setFindVisibleObjects(false);
+    for (size_t k = 1; k < group.size(); ++k)
+      group[k]->Render(true);
+    sceneMgr->setFindVisibleObjects(true);
+
+    this->dataPtr->sharedCount += group.size() - 1;
+  }
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GAZEBO_RENDERING_CAMERARIG_HH_
+#define GAZEBO_RENDERING_CAMERARIG_HH_
+
+#include <memory>
+
+#include "gazebo/rendering/RenderTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    // Forward declare private data class.
+    class CameraRigPrivate;
+
+    /// \addtogroup gazebo_rendering Rendering
+    /// \{
+
+    /// \class CameraRig CameraRig.hh rendering/rendering.hh
+    /// \brief Renders a group of rigidly mounted cameras, such as a stereo
+    /// pair, at the same time.
+    ///
+    /// Cameras of the rig that look the same way with the same perspective
+    /// projection are rendered as one group. The first camera of a group is
+    /// culled against a frustum enclosing the whole group and prepares the
+    /// shadow textures. The other cameras of the group then reuse its
+    /// visible objects and shadow textures instead of culling the scene
+    /// and rendering shadow maps again. Cameras that do not share a group
+    /// are rendered on their own.
+    class GZ_RENDERING_VISIBLE CameraRig
+    {
+      /// \brief Constructor.
+      /// \param[in] _scene Scene the cameras belong to.
+      public: explicit CameraRig(ScenePtr _scene);
+
+      /// \brief Destructor.
+      public: ~CameraRig();
+
+      /// \brief Check the GAZEBO_CAMERA_RIG environment variable.
+      /// \return True if rigs should share culling and shadows.
+      public: static bool Enabled();
+
+      /// \brief Add a camera to the rig.
+      /// \param[in] _camera Camera to add, rendered in insertion order.
+      public: void AddCamera(CameraPtr _camera);
+
+      /// \brief Remove all the cameras from the rig.
+      public: void Clear();
+
+      /// \brief Render all the cameras of the rig. Every camera is rendered,
+      /// regardless of its own update rate.
+      public: void Render();
+
+      /// \brief Get the number of cameras that reused the visible objects
+      /// of another camera during the last Render().
+      /// \return Number of cameras that were not culled.
+      public: unsigned int SharedCount() const;
+
+      /// \internal
+      /// \brief Private data pointer
+      private: std::unique_ptr<CameraRigPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
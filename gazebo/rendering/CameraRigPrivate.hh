@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GAZEBO_RENDERING_CAMERARIGPRIVATE_HH_
+#define GAZEBO_RENDERING_CAMERARIGPRIVATE_HH_
+
+#include <vector>
+
+#include "gazebo/rendering/RenderTypes.hh"
+
+namespace Ogre
+{
+  class Frustum;
+  class SceneNode;
+}
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    /// \internal
+    /// \brief Private data for the CameraRig class
+    class CameraRigPrivate
+    {
+      /// \brief Scene the cameras belong to.
+      public: ScenePtr scene;
+
+      /// \brief Cameras of the rig.
+      public: std::vector<CameraPtr> cameras;
+
+      /// \brief Frustum enclosing a group of cameras, used to cull the
+      /// scene for the whole group.
+      public: Ogre::Frustum *cullingFrustum = nullptr;
+
+      /// \brief Scene node placing the culling frustum.
+      public: Ogre::SceneNode *cullingNode = nullptr;
+
+      /// \brief Cameras that reused another camera's visible objects
+      /// during the last render.
+      public: unsigned int sharedCount = 0;
+    };
+  }
+}
+#endif
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include "gazebo/rendering/Camera.hh"
+#include "gazebo/rendering/CameraRig.hh"
+#include "gazebo/rendering/RenderingIface.hh"
+#include "gazebo/rendering/RenderTypes.hh"
+#include "gazebo/rendering/Scene.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+class CameraRig_TEST: public RenderingFixture
+{
+  /// \brief Create a camera rendering to a texture.
+  /// \param[in] _scene Scene to create the camera in.
+  /// \param[in] _name Name of the camera.
+  /// \param[in] _pose Pose of the camera.
+  /// \return The new camera.
+  public: rendering::CameraPtr CreateCamera(rendering::ScenePtr _scene,
+      const std::string &_name, const ignition::math::Pose3d &_pose)
+  {
+    rendering::CameraPtr camera = _scene->CreateCamera(_name, false);
+    camera->SetCaptureData(true);
+
+    std::stringstream ss;
+    ss << "<sdf version='" << SDF_VERSION << "'>"
+       << "  <camera>"
+       << "    <horizontal_fov>1.0</horizontal_fov>"
+       << "    <image>"
+       << "      <width>320</width>"
+       << "      <height>240</height>"
+       << "      <format>R8G8B8</format>"
+       << "    </image>"
+       << "    <clip>"
+       << "      <near>0.1</near><far>100</far>"
+       << "    </clip>"
+       << "  </camera>"
+       << "</sdf>";
+    sdf::ElementPtr cameraSDF(new sdf::Element);
+    sdf::initFile("camera.sdf", cameraSDF);
+    sdf::readString(ss.str(), cameraSDF);
+    camera->Load(cameraSDF);
+    camera->Init();
+    camera->CreateRenderTexture(_name + "_RttTex");
+    camera->SetWorldPose(_pose);
+    return camera;
+  }
+};
+
+/////////////////////////////////////////////////
+TEST_F(CameraRig_TEST, Groups)
+{
+  Load("worlds/shapes.world");
+
+  rendering::ScenePtr scene = rendering::get_scene("default");
+  if (!scene)
+    scene = rendering::create_scene("default", false);
+  ASSERT_TRUE(scene != nullptr);
+
+  // A stereo pair and a camera looking sideways
+  rendering::CameraPtr left = this->CreateCamera(scene, "rig_left",
+      ignition::math::Pose3d(-5, 0.05, 0.5, 0, 0, 0));
+  rendering::CameraPtr right = this->CreateCamera(scene, "rig_right",
+      ignition::math::Pose3d(-5, -0.05, 0.5, 0, 0, 0));
+  rendering::CameraPtr side = this->CreateCamera(scene, "rig_side",
+      ignition::math::Pose3d(-5, 0, 0.5, 0, 0, 1.57));
+  ASSERT_TRUE(left != nullptr);
+  ASSERT_TRUE(right != nullptr);
+  ASSERT_TRUE(side != nullptr);
+
+  rendering::CameraRig rig(scene);
+  EXPECT_EQ(rig.SharedCount(), 0u);
+
+  rig.AddCamera(left);
+  rig.AddCamera(side);
+  rig.AddCamera(right);
+
+  // Only the right camera reuses the culling of the left one
+  rig.Render();
+  EXPECT_EQ(rig.SharedCount(), 1u);
+
+  for (auto const &camera : {left, right, side})
+  {
+    camera->PostRender();
+    EXPECT_TRUE(camera->ImageData() != nullptr);
+  }
+
+  // Once apart the cameras are culled on their own
+  right->SetWorldRotation(ignition::math::Quaterniond(0, 0, -1.57));
+  rig.Render();
+  EXPECT_EQ(rig.SharedCount(), 0u);
+
+  rig.Clear();
+  rig.Render();
+  EXPECT_EQ(rig.SharedCount(), 0u);
+
+  scene->RemoveCamera(left->Name());
+  scene->RemoveCamera(right->Name());
+  scene->RemoveCamera(side->Name());
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
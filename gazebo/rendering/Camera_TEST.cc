@@ -281,6 +281,60 @@ TEST_F(Camera_TEST, Create)
   }
 }
 
+/////////////////////////////////////////////////
+TEST_F(Camera_TEST, ViewChanged)
+{
+  Load("worlds/shapes.world");
+
+  rendering::ScenePtr scene = rendering::get_scene("default");
+  if (!scene)
+    scene = rendering::create_scene("default", false);
+  ASSERT_TRUE(scene != nullptr);
+
+  // Wait for the model visuals
+  rendering::VisualPtr box;
+  for (int i = 0; i < 100 && !box; ++i)
+  {
+    scene->PreRender();
+    box = scene->GetVisual("box");
+    common::Time::MSleep(10);
+  }
+  ASSERT_TRUE(box != nullptr);
+
+  rendering::CameraPtr camera = scene->CreateCamera("view_camera", false);
+  ASSERT_TRUE(camera != nullptr);
+  camera->Load();
+  camera->Init();
+  camera->SetWorldPose(ignition::math::Pose3d(-5, 0, 0.5, 0, 0, 0));
+
+  EXPECT_FALSE(camera->SkipStaticViews());
+  camera->SetSkipStaticViews(true);
+  EXPECT_TRUE(camera->SkipStaticViews());
+
+  // Nothing recorded yet, then nothing moved
+  EXPECT_TRUE(camera->ViewChanged());
+  EXPECT_FALSE(camera->ViewChanged());
+
+  // A visual in view moves
+  ignition::math::Pose3d boxPose = box->WorldPose();
+  box->SetWorldPose(boxPose + ignition::math::Pose3d(0, 0, 0.1, 0, 0, 0));
+  EXPECT_TRUE(camera->ViewChanged());
+  EXPECT_FALSE(camera->ViewChanged());
+
+  // The visual leaves the view, then moves where it can't be seen
+  box->SetWorldPose(ignition::math::Pose3d(-50, 0, 0.5, 0, 0, 0));
+  EXPECT_TRUE(camera->ViewChanged());
+  box->SetWorldPose(ignition::math::Pose3d(-60, 0, 0.5, 0, 0, 0));
+  EXPECT_FALSE(camera->ViewChanged());
+
+  // The camera moves
+  camera->SetWorldPose(ignition::math::Pose3d(-5, 0, 1, 0, 0, 0));
+  EXPECT_TRUE(camera->ViewChanged());
+
+  box->SetWorldPose(boxPose);
+  scene->RemoveCamera(camera->Name());
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -52,6 +52,11 @@ ContactVisual::ContactVisual(const std::string &_name, VisualPtr _vis,
   dPtr->node->Init(dPtr->scene->Name());
 
   dPtr->topicName = _topicName;
+
+  // Frames are drawn at a fraction of the physics rate, so ask the server
+  // not to send more contacts than can be shown.
+  dPtr->node->SetQoS(dPtr->topicName,
+      transport::SubscriptionQoS::RateLimited(30));
   dPtr->contactsSub = dPtr->node->Subscribe(dPtr->topicName,
       &ContactVisual::OnContact, this);
 
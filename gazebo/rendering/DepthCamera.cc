@@ -202,6 +202,8 @@ void DepthCamera::Init()
 //////////////////////////////////////////////////
 void DepthCamera::Fini()
 {
+  this->dataPtr->depthReadback.reset();
+
   if (this->dataPtr->reflectanceViewport && this->scene)
     RTShaderSystem::DetachViewport(this->dataPtr->reflectanceViewport,
                                    this->scene);
@@ -420,19 +422,55 @@ void DepthCamera::PostRender()
       size_t size = Ogre::PixelUtil::getMemorySize(width, height, 1,
           Ogre::PF_FLOAT32_R);
 
-      // Blit the depth buffer if needed
-      if (!this->dataPtr->depthBuffer)
-        this->dataPtr->depthBuffer = new float[size];
+      bool depthRead = false;
+      unsigned int buffers = PixelBufferReadback::BufferCount();
+      if (buffers > 0)
+      {
+        // Same latency as the image, see Camera::ImageTime()
+        if (!this->dataPtr->depthReadback)
+          this->dataPtr->depthReadback.reset(new PixelBufferReadback);
+
+        if (this->dataPtr->depthReadback->Init(this->depthTexture,
+              Ogre::PF_FLOAT32_R, width, height, buffers))
+        {
+          this->dataPtr->depthReadback->Request(this->LastRenderSimTime());
+          if (this->dataPtr->depthReadback->Ready())
+          {
+            if (!this->dataPtr->depthBuffer)
+              this->dataPtr->depthBuffer = new float[size];
+
+            depthRead = this->dataPtr->depthReadback->Read(
+                this->dataPtr->depthBuffer, this->dataPtr->depthTime);
+          }
+        }
+        else
+        {
+          this->dataPtr->depthReadback.reset();
+        }
+      }
+
+      if (!this->dataPtr->depthReadback)
+      {
+        // Blit the depth buffer if needed
+        if (!this->dataPtr->depthBuffer)
+          this->dataPtr->depthBuffer = new float[size];
 
-      Ogre::PixelBox dstBox(width, height,
-          1, Ogre::PF_FLOAT32_R, this->dataPtr->depthBuffer);
+        Ogre::PixelBox dstBox(width, height,
+            1, Ogre::PF_FLOAT32_R, this->dataPtr->depthBuffer);
 
-      pixelBuffer->lock(Ogre::HardwarePixelBuffer::HBL_NORMAL);
-      pixelBuffer->blitToMemory(dstBox);
-      pixelBuffer->unlock();  // FIXME: do we need to lock/unlock still?
+        pixelBuffer->lock(Ogre::HardwarePixelBuffer::HBL_NORMAL);
+        pixelBuffer->blitToMemory(dstBox);
+        pixelBuffer->unlock();  // FIXME: do we need to lock/unlock still?
 
-      this->dataPtr->newDepthFrame(
-          this->dataPtr->depthBuffer, width, height, 1, "FLOAT32");
+        this->dataPtr->depthTime = this->LastRenderSimTime();
+        depthRead = true;
+      }
+
+      if (depthRead)
+      {
+        this->dataPtr->newDepthFrame(
+            this->dataPtr->depthBuffer, width, height, 1, "FLOAT32");
+      }
     }
     else
     {
@@ -654,6 +692,12 @@ const float* DepthCamera::DepthData() const
   return this->dataPtr->depthBuffer;
 }
 
+//////////////////////////////////////////////////
+common::Time DepthCamera::DepthTime() const
+{
+  return this->dataPtr->depthTime;
+}
+
 //////////////////////////////////////////////////
 void DepthCamera::SetDepthTarget(Ogre::RenderTarget *_target)
 {
@@ -92,6 +92,12 @@ namespace gazebo
       /// \return The z-buffer as a float array
       public: virtual const float *DepthData() const;
 
+      /// \brief Get the simulation time at which the data returned by
+      /// DepthData() was rendered. Lags the last render when asynchronous
+      /// readback is enabled, see Camera::ImageTime().
+      /// \return Simulation time of the current depth data.
+      public: common::Time DepthTime() const;
+
       /// \brief Set the render target, which renders the depth data
       /// \param[in] _target Pointer to the render target
       public: virtual void SetDepthTarget(Ogre::RenderTarget *_target);
@@ -18,11 +18,13 @@
 #ifndef _GAZEBO_RENDERING_DEPTHCAMERA_PRIVATE_HH_
 #define _GAZEBO_RENDERING_DEPTHCAMERA_PRIVATE_HH_
 
+#include <memory>
 #include <string>
 
 #include "gazebo/common/Event.hh"
 
 #include "gazebo/rendering/Camera.hh"
+#include "gazebo/rendering/PixelBufferReadback.hh"
 
 namespace Ogre
 {
@@ -57,6 +59,13 @@ namespace gazebo
       /// \brief The depth buffer
       public: float *depthBuffer = nullptr;
 
+      /// \brief Asynchronous readback of the depth texture, null when
+      /// depth frames are read synchronously.
+      public: std::unique_ptr<PixelBufferReadback> depthReadback;
+
+      /// \brief Simulation time the data in depthBuffer was rendered.
+      public: common::Time depthTime;
+
       /// \brief The depth material
       public: Ogre::Material *depthMaterial = nullptr;
 
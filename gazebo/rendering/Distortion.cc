@@ -14,6 +14,15 @@
  * limitations under the License.
  *
 */
+#include <array>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
 #include <sdf/sdf.hh>
 
 #include <ignition/math/Helpers.hh>
@@ -80,8 +89,10 @@ namespace gazebo
       /// \brief Connection for the pre render event.
       public: event::ConnectionPtr preRenderConnection;
 
-      /// \brief Mapping of distorted to undistorted normalized pixels
-      public: std::vector<ignition::math::Vector2d> distortionMap;
+      /// \brief Mapping of distorted to undistorted normalized pixels,
+      /// shared with cameras of the same intrinsics and resolution
+      public: std::shared_ptr<const std::vector<ignition::math::Vector2d>>
+          distortionMap;
 
       /// \brief Width of distortion texture map
       public: unsigned int distortionTexWidth;
@@ -113,6 +124,126 @@ namespace gazebo
     };
   }
 }
+/// \brief Distortion coefficients k1, k2, k3, p1, p2, lens center x and y,
+/// texture side, focal length in pixels and 1 for the legacy mode.
+using DistortionMapKey = std::array<double, 10>;
+
+/// \brief Compute the mapping of distorted to undistorted normalized pixels.
+/// \param[in] _key Parameters of the map.
+/// \return Map of texture side squared entries, (-1, -1) where no pixel
+/// maps to.
+static std::shared_ptr<const std::vector<ignition::math::Vector2d>>
+    ComputeDistortionMap(const DistortionMapKey &_key)
+{
+  const double k1 = _key[0];
+  const double k2 = _key[1];
+  const double k3 = _key[2];
+  const double p1 = _key[3];
+  const double p2 = _key[4];
+  const ignition::math::Vector2d lensCenter(_key[5], _key[6]);
+  const unsigned int texSide = static_cast<unsigned int>(_key[7]);
+  const double focalLength = _key[8];
+  const bool legacyMode = _key[9] > 0.5;
+
+  const double stepSize = 1.0 / texSide;
+
+  // Half step-size vector to add to the value being placed in distortion map.
+  // Necessary for compositor to correctly interpolate pixel values.
+  const auto halfTexelSize =
+      0.5 * ignition::math::Vector2d(stepSize, stepSize);
+
+  // Distorting every pixel is the expensive part and is independent per
+  // pixel, so it runs in parallel. Pixels mapping outside of the texture
+  // get an invalid index.
+  const unsigned int invalidIdx = texSide * texSide;
+  std::vector<unsigned int> distortedIdx(texSide * texSide);
+  tbb::parallel_for(tbb::blocked_range<unsigned int>(0, texSide, 16),
+      [&](const tbb::blocked_range<unsigned int> &_rows)
+  {
+    for (unsigned int mapRow = _rows.begin(); mapRow != _rows.end(); ++mapRow)
+    {
+      for (unsigned int mapCol = 0; mapCol < texSide; ++mapCol)
+      {
+        ignition::math::Vector2d normalizedLocation(
+            mapCol*stepSize, mapRow*stepSize);
+
+        ignition::math::Vector2d distortedLocation;
+        if (legacyMode)
+        {
+          distortedLocation = Distortion::Distort(normalizedLocation,
+              lensCenter, k1, k2, k3, p1, p2);
+        }
+        else
+        {
+          distortedLocation = Distortion::Distort(normalizedLocation,
+              lensCenter, k1, k2, k3, p1, p2, texSide, focalLength);
+        }
+
+        // compute the index in the distortion map
+        unsigned int distortedCol = round(distortedLocation.X() * texSide);
+        unsigned int distortedRow = round(distortedLocation.Y() * texSide);
+
+        distortedIdx[mapRow * texSide + mapCol] =
+            distortedCol < texSide && distortedRow < texSide ?
+            distortedRow * texSide + distortedCol : invalidIdx;
+      }
+    }
+  });
+
+  auto map = std::make_shared<std::vector<ignition::math::Vector2d>>(
+      texSide * texSide, ignition::math::Vector2d(-1, -1));
+
+  ignition::math::Vector2d distortionCenterCoordinates(
+      lensCenter.X() * texSide, lensCenter.Y() * texSide);
+
+  // Fill the distortion map in pixel order, so that the result matches a
+  // sequential fill.
+  const auto unsetPixelVector = ignition::math::Vector2d(-1, -1);
+  for (unsigned int mapRow = 0; mapRow < texSide; ++mapRow)
+  {
+    for (unsigned int mapCol = 0; mapCol < texSide; ++mapCol)
+    {
+      unsigned int idx = distortedIdx[mapRow * texSide + mapCol];
+
+      // mapping is outside of the image bounds. This is expected and normal
+      // to ensure no black borders; carry on
+      if (idx == invalidIdx)
+        continue;
+
+      ignition::math::Vector2d normalizedLocation(
+          mapCol*stepSize, mapRow*stepSize);
+
+      // Note that the following makes sure that, for significant
+      // distortions, there is not a problem where the distorted image seems
+      // to fold over itself. This is accomplished by favoring pixels closer
+      // to the center of distortion, and this change applies to both the
+      // legacy and nonlegacy distortion modes.
+      ignition::math::Vector2d &mapped = (*map)[idx];
+      if (mapped != unsetPixelVector)
+      {
+        // grab current coordinates that map to this destination
+        ignition::math::Vector2d currDistortedCoordinates = mapped * texSide;
+
+        // grab new coordinates to map to
+        ignition::math::Vector2d newDistortedCoordinates(mapCol, mapRow);
+
+        // use the new mapping if it is closer to the center of the distortion
+        if (newDistortedCoordinates.Distance(distortionCenterCoordinates) <
+            currDistortedCoordinates.Distance(distortionCenterCoordinates))
+        {
+          mapped = normalizedLocation + halfTexelSize;
+        }
+      }
+      else
+      {
+        mapped = normalizedLocation + halfTexelSize;
+      }
+    }
+  }
+
+  return map;
+}
+
 //////////////////////////////////////////////////
 Distortion::Distortion()
   : dataPtr(new DistortionPrivate)
@@ -163,7 +294,7 @@ ignition::math::Vector2d
     return ignition::math::Vector2d(-1, -1);
   }
   ignition::math::Vector2d res =
-      this->dataPtr->distortionMap[y*this->dataPtr->distortionTexWidth+x];
+      (*this->dataPtr->distortionMap)[y*this->dataPtr->distortionTexWidth+x];
   return res;
 }
 
@@ -195,118 +326,40 @@ void Distortion::SetCamera(CameraPtr _camera)
   const double focalLength = texSide/(2*tan(fov/2));
   this->dataPtr->distortionTexWidth = texSide;
   this->dataPtr->distortionTexHeight = texSide;
-  unsigned int imageSize =
-      this->dataPtr->distortionTexWidth * this->dataPtr->distortionTexHeight;
-  double colStepSize = 1.0 / this->dataPtr->distortionTexWidth;
-  double rowStepSize = 1.0 / this->dataPtr->distortionTexHeight;
 
-  // Half step-size vector to add to the value being placed in distortion map.
-  // Necessary for compositor to correctly interpolate pixel values.
-  const auto halfTexelSize =
-      0.5 * ignition::math::Vector2d(rowStepSize, colStepSize);
+  const DistortionMapKey key{{this->dataPtr->k1, this->dataPtr->k2,
+      this->dataPtr->k3, this->dataPtr->p1, this->dataPtr->p2,
+      this->dataPtr->lensCenter.X(), this->dataPtr->lensCenter.Y(),
+      static_cast<double>(texSide), focalLength,
+      this->dataPtr->legacyMode ? 1.0 : 0.0}};
 
-  // initialize distortion map
-  this->dataPtr->distortionMap.resize(imageSize);
-  for (unsigned int i = 0; i < this->dataPtr->distortionMap.size(); ++i)
+  // Cameras with the same intrinsics and resolution share one map
+  static std::mutex mapsMutex;
+  static std::map<DistortionMapKey,
+      std::weak_ptr<const std::vector<ignition::math::Vector2d>>> maps;
   {
-    this->dataPtr->distortionMap[i] = -1;
+    std::lock_guard<std::mutex> lock(mapsMutex);
+    this->dataPtr->distortionMap = maps[key].lock();
   }
 
-  ignition::math::Vector2d distortionCenterCoordinates(
-      this->dataPtr->lensCenter.X() * this->dataPtr->distortionTexWidth,
-      this->dataPtr->lensCenter.Y() * this->dataPtr->distortionTexWidth);
-
-  // declare variables before the loop
-  const auto unsetPixelVector =  ignition::math::Vector2d(-1, -1);
-  ignition::math::Vector2d normalizedLocation,
-      distortedLocation,
-      newDistortedCoordinates,
-      currDistortedCoordinates;
-  unsigned int distortedIdx,
-      distortedCol,
-      distortedRow;
-  double normalizedColLocation, normalizedRowLocation;
-
-  // fill the distortion map
-  for (unsigned int mapRow = 0; mapRow < this->dataPtr->distortionTexHeight;
-    ++mapRow)
+  if (!this->dataPtr->distortionMap)
   {
-    normalizedRowLocation = mapRow*rowStepSize;
-    for (unsigned int mapCol = 0; mapCol < this->dataPtr->distortionTexWidth;
-      ++mapCol)
+    auto map = ComputeDistortionMap(key);
+    std::lock_guard<std::mutex> lock(mapsMutex);
+    this->dataPtr->distortionMap = maps[key].lock();
+    if (!this->dataPtr->distortionMap)
     {
-      normalizedColLocation = mapCol*colStepSize;
-
-      normalizedLocation[0] = normalizedColLocation;
-      normalizedLocation[1] = normalizedRowLocation;
+      this->dataPtr->distortionMap = map;
+      maps[key] = map;
+    }
 
-      if (this->dataPtr->legacyMode)
-      {
-        distortedLocation = this->Distort(
-            normalizedLocation,
-            this->dataPtr->lensCenter,
-            this->dataPtr->k1, this->dataPtr->k2, this->dataPtr->k3,
-            this->dataPtr->p1, this->dataPtr->p2);
-      }
+    // Forget maps no camera uses anymore
+    for (auto iter = maps.begin(); iter != maps.end();)
+    {
+      if (iter->second.expired())
+        iter = maps.erase(iter);
       else
-      {
-        distortedLocation = this->Distort(
-            normalizedLocation,
-            this->dataPtr->lensCenter,
-            this->dataPtr->k1, this->dataPtr->k2, this->dataPtr->k3,
-            this->dataPtr->p1, this->dataPtr->p2,
-            this->dataPtr->distortionTexWidth,
-            focalLength);
-      }
-
-      // compute the index in the distortion map
-      distortedCol = round(distortedLocation.X() * 
-        this->dataPtr->distortionTexWidth);
-      distortedRow = round(distortedLocation.Y() *
-        this->dataPtr->distortionTexHeight);
-
-      // Note that the following makes sure that, for significant distortions,
-      // there is not a problem where the distorted image seems to fold over
-      // itself. This is accomplished by favoring pixels closer to the center
-      // of distortion, and this change applies to both the legacy and
-      // nonlegacy distortion modes.
-
-      // Make sure the distorted pixel is within the texture dimensions
-      if (distortedCol < this->dataPtr->distortionTexWidth &&
-          distortedRow < this->dataPtr->distortionTexHeight)
-      {
-        distortedIdx = distortedRow * this->dataPtr->distortionTexWidth +
-          distortedCol;
-
-        // check if the index has already been set
-        if (this->dataPtr->distortionMap[distortedIdx] != unsetPixelVector)
-        {
-          // grab current coordinates that map to this destination
-          currDistortedCoordinates =
-            this->dataPtr->distortionMap[distortedIdx] *
-            this->dataPtr->distortionTexWidth;
-
-          // grab new coordinates to map to
-          newDistortedCoordinates[0] = mapCol;
-          newDistortedCoordinates[1] = mapRow;
-
-          // use the new mapping if it is closer to the center of the distortion
-          if (newDistortedCoordinates.Distance(distortionCenterCoordinates) <
-              currDistortedCoordinates.Distance(distortionCenterCoordinates))
-          {
-            this->dataPtr->distortionMap[distortedIdx] = normalizedLocation +
-              halfTexelSize;
-          }
-        }
-        else
-        {
-          this->dataPtr->distortionMap[distortedIdx] = normalizedLocation +
-            halfTexelSize;
-        }
-      }
-      // else: mapping is outside of the image bounds.
-      // This is expected and normal to ensure
-      // no black borders; carry on
+        ++iter;
     }
   }
 
@@ -341,104 +394,112 @@ void Distortion::SetCamera(CameraPtr _camera)
   // reinterpret_cast is required here. static_cast is not allowed between
   // pointers of unrelated types (see, for instance, Standard § 3.9.1
   // Fundamental types)
-  float *pDest = reinterpret_cast<float *>(pixelBox.data);
+  float *pTex = reinterpret_cast<float *>(pixelBox.data);
 #else
-  float *pDest = static_cast<float *>(pixelBox.data);
+  float *pTex = static_cast<float *>(pixelBox.data);
 #endif
 
-  for (unsigned int i = 0; i < this->dataPtr->distortionTexHeight; ++i)
+  // Rows are independent, fill them in parallel
+  const unsigned int texWidth = this->dataPtr->distortionTexWidth;
+  tbb::parallel_for(tbb::blocked_range<unsigned int>(0,
+      this->dataPtr->distortionTexHeight, 16),
+      [&](const tbb::blocked_range<unsigned int> &_rows)
   {
-    for (unsigned int j = 0; j < this->dataPtr->distortionTexWidth; ++j)
+    for (unsigned int i = _rows.begin(); i != _rows.end(); ++i)
     {
-      ignition::math::Vector2d vec =
-          this->dataPtr->distortionMap[i*this->dataPtr->distortionTexWidth+j];
+      float *pDest = pTex + i * texWidth * 3;
+      for (unsigned int j = 0; j < texWidth; ++j)
+      {
+        ignition::math::Vector2d vec =
+            (*this->dataPtr->distortionMap)[i*texWidth+j];
 
-      // perform interpolation on-the-fly:
-      // check for empty mapping within the region and correct it by
-      // interpolating the eight neighboring distortion map values.
+        // perform interpolation on-the-fly:
+        // check for empty mapping within the region and correct it by
+        // interpolating the eight neighboring distortion map values.
 
-      if (vec.X() < -0.5 && vec.Y() < -0.5)
-      {
-        ignition::math::Vector2d left =
-            this->DistortionMapValueClamped(j-1, i);
-        ignition::math::Vector2d right =
-            this->DistortionMapValueClamped(j+1, i);
-        ignition::math::Vector2d bottom =
-            this->DistortionMapValueClamped(j, i+1);
-        ignition::math::Vector2d top =
-            this->DistortionMapValueClamped(j, i-1);
-
-        ignition::math::Vector2d topLeft =
-            this->DistortionMapValueClamped(j-1, i-1);
-        ignition::math::Vector2d topRight =
-            this->DistortionMapValueClamped(j+1, i-1);
-        ignition::math::Vector2d bottomLeft =
-            this->DistortionMapValueClamped(j-1, i+1);
-        ignition::math::Vector2d bottomRight =
-            this->DistortionMapValueClamped(j+1, i+1);
-
-
-        ignition::math::Vector2d interpolated;
-        double divisor = 0;
-        if (right.X() > -0.5)
-        {
-          divisor++;
-          interpolated += right;
-        }
-        if (left.X() > -0.5)
-        {
-          divisor++;
-          interpolated += left;
-        }
-        if (top.X() > -0.5)
+        if (vec.X() < -0.5 && vec.Y() < -0.5)
         {
-          divisor++;
-          interpolated += top;
-        }
-        if (bottom.X() > -0.5)
-        {
-          divisor++;
-          interpolated += bottom;
-        }
+          ignition::math::Vector2d left =
+              this->DistortionMapValueClamped(j-1, i);
+          ignition::math::Vector2d right =
+              this->DistortionMapValueClamped(j+1, i);
+          ignition::math::Vector2d bottom =
+              this->DistortionMapValueClamped(j, i+1);
+          ignition::math::Vector2d top =
+              this->DistortionMapValueClamped(j, i-1);
+
+          ignition::math::Vector2d topLeft =
+              this->DistortionMapValueClamped(j-1, i-1);
+          ignition::math::Vector2d topRight =
+              this->DistortionMapValueClamped(j+1, i-1);
+          ignition::math::Vector2d bottomLeft =
+              this->DistortionMapValueClamped(j-1, i+1);
+          ignition::math::Vector2d bottomRight =
+              this->DistortionMapValueClamped(j+1, i+1);
+
+
+          ignition::math::Vector2d interpolated;
+          double divisor = 0;
+          if (right.X() > -0.5)
+          {
+            divisor++;
+            interpolated += right;
+          }
+          if (left.X() > -0.5)
+          {
+            divisor++;
+            interpolated += left;
+          }
+          if (top.X() > -0.5)
+          {
+            divisor++;
+            interpolated += top;
+          }
+          if (bottom.X() > -0.5)
+          {
+            divisor++;
+            interpolated += bottom;
+          }
 
-        if (bottomRight.X() > -0.5)
-        {
-          divisor += 0.707;
-          interpolated += bottomRight * 0.707;
-        }
-        if (bottomLeft.X() > -0.5)
-        {
-          divisor += 0.707;
-          interpolated += bottomLeft * 0.707;
-        }
-        if (topRight.X() > -0.5)
-        {
-          divisor += 0.707;
-          interpolated += topRight * 0.707;
+          if (bottomRight.X() > -0.5)
+          {
+            divisor += 0.707;
+            interpolated += bottomRight * 0.707;
+          }
+          if (bottomLeft.X() > -0.5)
+          {
+            divisor += 0.707;
+            interpolated += bottomLeft * 0.707;
+          }
+          if (topRight.X() > -0.5)
+          {
+            divisor += 0.707;
+            interpolated += topRight * 0.707;
+          }
+          if (topLeft.X() > -0.5)
+          {
+            divisor += 0.707;
+            interpolated += topLeft * 0.707;
+          }
+
+          if (divisor > 0.5)
+          {
+            interpolated /= divisor;
+          }
+          *pDest++ = ignition::math::clamp(interpolated.X(), 0.0, 1.0);
+          *pDest++ = ignition::math::clamp(interpolated.Y(), 0.0, 1.0);
         }
-        if (topLeft.X() > -0.5)
+        else
         {
-          divisor += 0.707;
-          interpolated += topLeft * 0.707;
+          *pDest++ = vec.X();
+          *pDest++ = vec.Y();
         }
 
-        if (divisor > 0.5)
-        {
-          interpolated /= divisor;
-        }
-        *pDest++ = ignition::math::clamp(interpolated.X(), 0.0, 1.0);
-        *pDest++ = ignition::math::clamp(interpolated.Y(), 0.0, 1.0);
-      }
-      else
-      {
-        *pDest++ = vec.X();
-        *pDest++ = vec.Y();
+        // Z coordinate
+        *pDest++ = 0;
       }
-
-      // Z coordinate
-      *pDest++ = 0;
     }
-  }
+  });
   pixelBuffer->unlock();
 
   this->CalculateAndApplyDistortionScale();
@@ -16,7 +16,9 @@
 */
 #include <math.h>
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include <sstream>
 #include <ignition/common/Profiler.hh>
 #include <ignition/math/Color.hh>
@@ -35,8 +37,23 @@ enum {POSITION_BINDING, TEXCOORD_BINDING};
 /// \brief Private implementation
 class gazebo::rendering::DynamicLinesPrivate
 {
+  /// \brief Mark a range of points as changed since the last upload.
+  /// \param[in] _begin First changed point.
+  /// \param[in] _end One past the last changed point.
+  public: void MarkDirty(const size_t _begin, const size_t _end)
+  {
+    this->dirtyBegin = std::min(this->dirtyBegin, _begin);
+    this->dirtyEnd = std::max(this->dirtyEnd, _end);
+  }
+
   /// \brief list of colors at each point
   public: std::vector<ignition::math::Color> colors;
+
+  /// \brief First point changed since the last upload.
+  public: size_t dirtyBegin = 0;
+
+  /// \brief One past the last point changed since the last upload.
+  public: size_t dirtyEnd = std::numeric_limits<size_t>::max();
 };
 
 /////////////////////////////////////////////////
@@ -72,6 +89,7 @@ void DynamicLines::AddPoint(const ignition::math::Vector3d &_pt,
 {
   this->points.push_back(_pt);
   this->dataPtr->colors.push_back(_color);
+  this->dataPtr->MarkDirty(this->points.size() - 1, this->points.size());
   this->dirty = true;
 }
 
@@ -95,6 +113,7 @@ void DynamicLines::SetPoint(const unsigned int _index,
 
   this->points[_index] = _value;
 
+  this->dataPtr->MarkDirty(_index, _index + 1);
   this->dirty = true;
 }
 
@@ -103,6 +122,7 @@ void DynamicLines::SetColor(const unsigned int _index,
                             const ignition::math::Color &_color)
 {
   this->dataPtr->colors[_index] = _color;
+  this->dataPtr->MarkDirty(_index, _index + 1);
   this->dirty = true;
 }
 
@@ -129,10 +149,33 @@ unsigned int DynamicLines::GetPointCount() const
   return this->points.size();
 }
 
+/////////////////////////////////////////////////
+void DynamicLines::RemovePoints(const unsigned int _start,
+                                const unsigned int _count)
+{
+  if (_start + _count > this->points.size())
+  {
+    gzerr << "Point range[" << _start << "-" << _start + _count
+           << "] is out of bounds[0-" << this->points.size() << "]\n";
+    return;
+  }
+
+  this->points.erase(this->points.begin() + _start,
+      this->points.begin() + _start + _count);
+  this->dataPtr->colors.erase(this->dataPtr->colors.begin() + _start,
+      this->dataPtr->colors.begin() + _start + _count);
+
+  // Every point after the range moved
+  this->dataPtr->MarkDirty(_start, this->points.size());
+  this->dirty = true;
+}
+
 /////////////////////////////////////////////////
 void DynamicLines::Clear()
 {
   this->points.clear();
+  this->dataPtr->colors.clear();
+  this->dataPtr->MarkDirty(0, std::numeric_limits<size_t>::max());
   this->dirty = true;
 }
 
@@ -157,22 +200,47 @@ void DynamicLines::CreateVertexDeclaration()
 /////////////////////////////////////////////////
 void DynamicLines::FillHardwareBuffers()
 {
-  int size = this->points.size();
+  size_t size = this->points.size();
+  size_t oldCapacity = this->vertexBufferCapacity;
   this->PrepareHardwareBuffers(size, 0);
 
+  // Only the points changed since the last upload need to be written,
+  // unless the buffers were just created
+  size_t begin = 0;
+  size_t end = size;
+  if (this->vertexBufferCapacity == oldCapacity)
+  {
+    begin = std::min(this->dataPtr->dirtyBegin, size);
+    end = std::min(this->dataPtr->dirtyEnd, size);
+  }
+  this->dataPtr->dirtyBegin = std::numeric_limits<size_t>::max();
+  this->dataPtr->dirtyEnd = 0;
+
   if (!size)
   {
     this->mBox.setExtents(Ogre::Vector3::ZERO, Ogre::Vector3::ZERO);
+    this->getParentSceneNode()->needUpdate();
     this->dirty = false;
   }
 
+  if (begin >= end)
+  {
+    this->dirty = false;
+    return;
+  }
+
+  Ogre::HardwareBuffer::LockOptions lockOptions =
+    (begin == 0 && end == size) ? Ogre::HardwareBuffer::HBL_DISCARD :
+    Ogre::HardwareBuffer::HBL_NORMAL;
+
   Ogre::HardwareVertexBufferSharedPtr vbuf =
     this->mRenderOp.vertexData->vertexBufferBinding->getBuffer(0);
 
-  Ogre::Real *prPos =
-    static_cast<Ogre::Real*>(vbuf->lock(Ogre::HardwareBuffer::HBL_NORMAL));
+  Ogre::Real *prPos = static_cast<Ogre::Real*>(vbuf->lock(
+        begin * vbuf->getVertexSize(), (end - begin) * vbuf->getVertexSize(),
+        Ogre::HardwareBuffer::HBL_NORMAL));
   {
-    for (int i = 0; i < size; i++)
+    for (size_t i = begin; i < end; i++)
     {
       *prPos++ = this->points[i].X();
       *prPos++ = this->points[i].Y();
@@ -187,14 +255,16 @@ void DynamicLines::FillHardwareBuffers()
   Ogre::HardwareVertexBufferSharedPtr cbuf =
     this->mRenderOp.vertexData->vertexBufferBinding->getBuffer(1);
 
-  Ogre::RGBA *colorArrayBuffer =
-        static_cast<Ogre::RGBA*>(cbuf->lock(Ogre::HardwareBuffer::HBL_DISCARD));
+  Ogre::RGBA *colorArrayBuffer = static_cast<Ogre::RGBA*>(cbuf->lock(
+        begin * cbuf->getVertexSize(), (end - begin) * cbuf->getVertexSize(),
+        lockOptions));
   Ogre::RenderSystem *renderSystemForVertex =
         Ogre::Root::getSingleton().getRenderSystem();
-  for (int i = 0; i < size; ++i)
+  for (size_t i = begin; i < end; ++i)
   {
     Ogre::ColourValue color = Conversions::Convert(this->dataPtr->colors[i]);
-    renderSystemForVertex->convertColourValue(color, &colorArrayBuffer[i]);
+    renderSystemForVertex->convertColourValue(color,
+        &colorArrayBuffer[i - begin]);
   }
   cbuf->unlock();
 
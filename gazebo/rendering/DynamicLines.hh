@@ -96,6 +96,13 @@ namespace gazebo
       /// \return Number of points
       public: unsigned int GetPointCount() const;
 
+      /// \brief Remove a range of points from the point list. Only the
+      /// points from _start onwards are uploaded again by the next Update.
+      /// \param[in] _start Index of the first point to remove
+      /// \param[in] _count Number of points to remove
+      public: void RemovePoints(const unsigned int _start,
+                  const unsigned int _count);
+
       /// \brief Remove all points from the point list
       public: void Clear();
 
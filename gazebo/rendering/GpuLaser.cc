@@ -43,6 +43,7 @@
 #include "gazebo/rendering/Conversions.hh"
 #include "gazebo/rendering/Scene.hh"
 #include "gazebo/rendering/GpuLaser.hh"
+#include "gazebo/rendering/GpuLaserBatch.hh"
 #include "gazebo/rendering/GpuLaserPrivate.hh"
 
 using namespace gazebo;
@@ -100,6 +101,12 @@ void GpuLaser::Init()
 //////////////////////////////////////////////////
 void GpuLaser::Fini()
 {
+  if (this->dataPtr->batch)
+  {
+    this->dataPtr->batch->RemoveLaser(this);
+    this->dataPtr->batch.reset();
+  }
+
   for (unsigned int i = 0; i < this->dataPtr->textureCount; ++i)
   {
     if (this->dataPtr->firstPassTextures[i])
@@ -180,19 +187,31 @@ void GpuLaser::CreateLaserTexture(const std::string &_textureName)
   this->dataPtr->matFirstPass->load();
   this->dataPtr->matFirstPass->setCullingMode(Ogre::CULL_NONE);
 
-  this->dataPtr->secondPassTexture =
-      Ogre::TextureManager::getSingleton().createManual(
-      _textureName + "second_pass",
-      "General",
-      Ogre::TEX_TYPE_2D,
-      this->dataPtr->w2nd, this->dataPtr->h2nd, 0,
-      Ogre::PF_FLOAT32_RGB,
-      Ogre::TU_RENDERTARGET).getPointer();
-
-  this->Set2ndPassTarget(
-      this->dataPtr->secondPassTexture->getBuffer()->getRenderTarget());
-
-  this->dataPtr->secondPassTarget->setAutoUpdated(false);
+  if (GpuLaserBatch::Enabled())
+  {
+    // Render the second pass into a band of an atlas shared with the
+    // other lasers of the scene, see GpuLaserBatch.
+    this->dataPtr->batch = GpuLaserBatch::Get(this->scene.get());
+    this->dataPtr->secondPassViewport = this->dataPtr->batch->AddLaser(this,
+        this->dataPtr->w2nd, this->dataPtr->h2nd, this->dataPtr->orthoCam);
+    this->Set2ndPassTarget(this->dataPtr->secondPassViewport->getTarget());
+  }
+  else
+  {
+    this->dataPtr->secondPassTexture =
+        Ogre::TextureManager::getSingleton().createManual(
+        _textureName + "second_pass",
+        "General",
+        Ogre::TEX_TYPE_2D,
+        this->dataPtr->w2nd, this->dataPtr->h2nd, 0,
+        Ogre::PF_FLOAT32_RGB,
+        Ogre::TU_RENDERTARGET).getPointer();
+
+    this->Set2ndPassTarget(
+        this->dataPtr->secondPassTexture->getBuffer()->getRenderTarget());
+
+    this->dataPtr->secondPassTarget->setAutoUpdated(false);
+  }
 
   this->dataPtr->matSecondPass = (Ogre::Material*)(
   Ogre::MaterialManager::getSingleton().getByName("Gazebo/LaserScan2nd").get());
@@ -228,6 +247,15 @@ void GpuLaser::CreateLaserTexture(const std::string &_textureName)
 //////////////////////////////////////////////////
 void GpuLaser::PostRender()
 {
+  if (this->dataPtr->batch)
+  {
+    // Renders and reads back every queued laser of the scene, this one
+    // included. Later calls in the same frame find the queue empty.
+    this->dataPtr->batch->Flush();
+    this->newData = false;
+    return;
+  }
+
   for (unsigned int i = 0; i < this->dataPtr->textureCount; ++i)
   {
     this->dataPtr->firstPassTargets[i]->swapBuffers();
@@ -275,6 +303,28 @@ void GpuLaser::PostRender()
   this->newData = false;
 }
 
+//////////////////////////////////////////////////
+void GpuLaser::DeliverFrame(const float *_data)
+{
+  if (this->newData && this->captureData)
+  {
+    int len = this->dataPtr->w2nd * this->dataPtr->h2nd * 3;
+
+    if (!this->dataPtr->laserBuffer)
+      this->dataPtr->laserBuffer = new float[len];
+    memcpy(this->dataPtr->laserBuffer, _data, len * sizeof(_data[0]));
+
+    if (!this->dataPtr->laserScan)
+      this->dataPtr->laserScan = new float[len];
+    memcpy(this->dataPtr->laserScan, _data, len * sizeof(_data[0]));
+
+    this->dataPtr->newLaserFrame(this->dataPtr->laserScan, this->dataPtr->w2nd,
+        this->dataPtr->h2nd, 3, "BLABLA");
+  }
+
+  this->newData = false;
+}
+
 /////////////////////////////////////////////////
 void GpuLaser::UpdateRenderTarget(Ogre::RenderTarget *_target,
                    Ogre::Material *_material, Ogre::Camera *_cam,
@@ -297,7 +347,11 @@ void GpuLaser::UpdateRenderTarget(Ogre::RenderTarget *_target,
 
   Ogre::AutoParamDataSource autoParamDataSource;
 
-  vp = _target->getViewport(0);
+  // The second pass viewport may be one band of a shared atlas
+  if (_target == this->dataPtr->secondPassTarget)
+    vp = this->dataPtr->secondPassViewport;
+  else
+    vp = _target->getViewport(0);
 
   // Need this line to render the ground plane. No idea why it's necessary.
   renderSys->_setViewport(vp);
@@ -414,6 +468,14 @@ void GpuLaser::notifyRenderSingleObject(Ogre::Renderable *_rend,
 void GpuLaser::RenderImpl()
 {
   IGN_PROFILE("rendering::GpuLaser::RenderImpl");
+
+  if (this->dataPtr->batch)
+  {
+    // Rendered together with the other lasers of the scene on PostRender
+    this->dataPtr->batch->Queue(this);
+    return;
+  }
+
   common::Timer firstPassTimer, secondPassTimer;
 
   firstPassTimer.Start();
@@ -421,6 +483,24 @@ void GpuLaser::RenderImpl()
   Ogre::SceneManager *sceneMgr = this->scene->OgreSceneManager();
 
   sceneMgr->_suppressRenderStateChanges(true);
+
+  this->RenderFirstPass();
+
+  double firstPassDur = firstPassTimer.GetElapsed().Double();
+  secondPassTimer.Start();
+
+  this->RenderSecondPass();
+
+  sceneMgr->_suppressRenderStateChanges(false);
+
+  double secondPassDur = secondPassTimer.GetElapsed().Double();
+  this->dataPtr->lastRenderDuration = firstPassDur + secondPassDur;
+}
+
+//////////////////////////////////////////////////
+void GpuLaser::RenderFirstPass()
+{
+  Ogre::SceneManager *sceneMgr = this->scene->OgreSceneManager();
   sceneMgr->addRenderObjectListener(this);
 
   for (unsigned int i = 0; i < this->dataPtr->textureCount; ++i)
@@ -444,22 +524,30 @@ void GpuLaser::RenderImpl()
       this->sceneNode->roll(Ogre::Radian(this->dataPtr->cameraYaws[3]));
 
   sceneMgr->removeRenderObjectListener(this);
+}
 
-  double firstPassDur = firstPassTimer.GetElapsed().Double();
-  secondPassTimer.Start();
-
+//////////////////////////////////////////////////
+void GpuLaser::RenderSecondPass()
+{
   this->dataPtr->visual->SetVisible(true);
 
   this->UpdateRenderTarget(this->dataPtr->secondPassTarget,
                 this->dataPtr->matSecondPass, this->dataPtr->orthoCam, true);
-  this->dataPtr->secondPassTarget->update(false);
-
-  this->dataPtr->visual->SetVisible(false);
 
-  sceneMgr->_suppressRenderStateChanges(false);
+  if (this->dataPtr->batch)
+  {
+    // Only draw this laser's band of the shared atlas
+    this->dataPtr->secondPassTarget->_beginUpdate();
+    this->dataPtr->secondPassTarget->_updateViewport(
+        this->dataPtr->secondPassViewport, false);
+    this->dataPtr->secondPassTarget->_endUpdate();
+  }
+  else
+  {
+    this->dataPtr->secondPassTarget->update(false);
+  }
 
-  double secondPassDur = secondPassTimer.GetElapsed().Double();
-  this->dataPtr->lastRenderDuration = firstPassDur + secondPassDur;
+  this->dataPtr->visual->SetVisible(false);
 }
 
 //////////////////////////////////////////////////
@@ -577,9 +665,14 @@ void GpuLaser::Set2ndPassTarget(Ogre::RenderTarget *_target)
 
   if (this->dataPtr->secondPassTarget)
   {
-    // Setup the viewport to use the texture
-    this->dataPtr->secondPassViewport =
-        this->dataPtr->secondPassTarget->addViewport(this->dataPtr->orthoCam);
+    // Setup the viewport to use the texture. A batched laser already has
+    // its band of the shared atlas as viewport.
+    if (!this->dataPtr->batch)
+    {
+      this->dataPtr->secondPassViewport =
+          this->dataPtr->secondPassTarget->addViewport(
+          this->dataPtr->orthoCam);
+    }
     this->dataPtr->secondPassViewport->setClearEveryFrame(true);
     this->dataPtr->secondPassViewport->setOverlaysEnabled(false);
     this->dataPtr->secondPassViewport->setShadowsEnabled(false);
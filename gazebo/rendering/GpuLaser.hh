@@ -210,6 +210,20 @@ namespace gazebo
       // Documentation inherited.
       private: virtual void RenderImpl();
 
+      /// \brief Render the first pass textures. The caller must suppress
+      /// render state changes.
+      private: void RenderFirstPass();
+
+      /// \brief Render the second pass, which undistorts the first pass
+      /// textures into range data. The caller must suppress render state
+      /// changes.
+      private: void RenderSecondPass();
+
+      /// \brief Copy a rendered frame into the laser buffers and notify
+      /// the newLaserFrame subscribers.
+      /// \param[in] _data Second pass data, w2nd * h2nd RGB floats.
+      private: void DeliverFrame(const float *_data);
+
       /// \brief Update a render target.
       /// \param[in, out] _target Render target to update (render).
       /// \param[in, out] _material Material used during render.
@@ -287,6 +301,9 @@ namespace gazebo
       /// \internal
       /// \brief Pointer to private data.
       private: std::unique_ptr<GpuLaserPrivate> dataPtr;
+
+      /// \brief The batch renders queued lasers and hands back their data.
+      private: friend class GpuLaserBatch;
     };
     /// \}
   }
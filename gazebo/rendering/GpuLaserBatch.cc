@@ -0,0 +1,230 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cstdlib>
+#include <set>
+#include <sstream>
+#include <string>
+
+#include <ignition/common/Profiler.hh>
+
+#include "gazebo/rendering/ogre_gazebo.h"
+
+#include "gazebo/common/Timer.hh"
+
+#include "gazebo/rendering/GpuLaser.hh"
+#include "gazebo/rendering/GpuLaserBatch.hh"
+#include "gazebo/rendering/GpuLaserPrivate.hh"
+#include "gazebo/rendering/Scene.hh"
+
+using namespace gazebo;
+using namespace rendering;
+
+/// \brief Maximum number of lasers sharing an atlas.
+static const unsigned int kMaxAtlasBands = 16;
+
+/// \brief Maximum height of an atlas texture in pixels.
+static const unsigned int kMaxAtlasHeight = 8192;
+
+unsigned int GpuLaserBatch::atlasCount = 0;
+
+//////////////////////////////////////////////////
+GpuLaserBatch::GpuLaserBatch(Scene *_scene)
+  : scene(_scene)
+{
+}
+
+//////////////////////////////////////////////////
+GpuLaserBatch::~GpuLaserBatch()
+{
+  for (auto &atlas : this->atlases)
+  {
+    if (atlas->texture)
+    {
+      Ogre::TextureManager::getSingleton().remove(atlas->texture->getName());
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<GpuLaserBatch> GpuLaserBatch::Get(Scene *_scene)
+{
+  static std::mutex batchesMutex;
+  static std::map<Scene *, std::weak_ptr<GpuLaserBatch>> batches;
+
+  std::lock_guard<std::mutex> lock(batchesMutex);
+  std::shared_ptr<GpuLaserBatch> batch = batches[_scene].lock();
+  if (!batch)
+  {
+    batch.reset(new GpuLaserBatch(_scene));
+    batches[_scene] = batch;
+  }
+  return batch;
+}
+
+//////////////////////////////////////////////////
+bool GpuLaserBatch::Enabled()
+{
+  const char *env = std::getenv("GAZEBO_GPU_LASER_BATCH");
+  return env && std::string(env) != "0";
+}
+
+//////////////////////////////////////////////////
+Ogre::Viewport *GpuLaserBatch::AddLaser(GpuLaser *_laser,
+    const unsigned int _width, const unsigned int _height, Ogre::Camera *_cam)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+
+  // Look for a free band in an atlas of the right size
+  Atlas *atlas = nullptr;
+  unsigned int index = 0;
+  for (auto &a : this->atlases)
+  {
+    if (a->width != _width || a->height != _height)
+      continue;
+
+    auto free = std::find(a->lasers.begin(), a->lasers.end(), nullptr);
+    if (free != a->lasers.end())
+    {
+      atlas = a.get();
+      index = free - a->lasers.begin();
+      break;
+    }
+  }
+
+  if (!atlas)
+  {
+    unsigned int bands = std::max(1u,
+        std::min(kMaxAtlasBands, kMaxAtlasHeight / std::max(1u, _height)));
+
+    std::unique_ptr<Atlas> newAtlas(new Atlas);
+    newAtlas->width = _width;
+    newAtlas->height = _height;
+    newAtlas->lasers.resize(bands, nullptr);
+
+    std::stringstream texName;
+    texName << "GpuLaserBatch_" << this->scene->Name() << "_" <<
+        atlasCount++;
+    newAtlas->texture = Ogre::TextureManager::getSingleton().createManual(
+        texName.str(), "General", Ogre::TEX_TYPE_2D,
+        _width, _height * bands, 0,
+        Ogre::PF_FLOAT32_RGB, Ogre::TU_RENDERTARGET).getPointer();
+    newAtlas->target = newAtlas->texture->getBuffer()->getRenderTarget();
+    newAtlas->target->setAutoUpdated(false);
+
+    atlas = newAtlas.get();
+    index = 0;
+    this->atlases.push_back(std::move(newAtlas));
+  }
+
+  atlas->lasers[index] = _laser;
+  this->slots[_laser].atlas = atlas;
+  this->slots[_laser].index = index;
+
+  float bandHeight = 1.0f / atlas->lasers.size();
+  Ogre::Viewport *vp = atlas->target->addViewport(_cam, index,
+      0.0f, index * bandHeight, 1.0f, bandHeight);
+  vp->setAutoUpdated(false);
+  return vp;
+}
+
+//////////////////////////////////////////////////
+void GpuLaserBatch::RemoveLaser(GpuLaser *_laser)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+
+  this->pending.erase(
+      std::remove(this->pending.begin(), this->pending.end(), _laser),
+      this->pending.end());
+
+  auto iter = this->slots.find(_laser);
+  if (iter == this->slots.end())
+    return;
+
+  iter->second.atlas->target->removeViewport(iter->second.index);
+  iter->second.atlas->lasers[iter->second.index] = nullptr;
+  this->slots.erase(iter);
+}
+
+//////////////////////////////////////////////////
+void GpuLaserBatch::Queue(GpuLaser *_laser)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  if (this->slots.find(_laser) != this->slots.end() &&
+      std::find(this->pending.begin(), this->pending.end(), _laser) ==
+      this->pending.end())
+  {
+    this->pending.push_back(_laser);
+  }
+}
+
+//////////////////////////////////////////////////
+void GpuLaserBatch::Flush()
+{
+  IGN_PROFILE("rendering::GpuLaserBatch::Flush");
+
+  std::vector<GpuLaser *> lasers;
+  std::map<GpuLaser *, Slot> laserSlots;
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (this->pending.empty())
+      return;
+    std::swap(lasers, this->pending);
+    for (auto laser : lasers)
+      laserSlots[laser] = this->slots[laser];
+  }
+
+  common::Timer timer;
+  timer.Start();
+
+  Ogre::SceneManager *sceneMgr = this->scene->OgreSceneManager();
+  sceneMgr->_suppressRenderStateChanges(true);
+
+  for (auto laser : lasers)
+    laser->RenderFirstPass();
+
+  for (auto laser : lasers)
+    laser->RenderSecondPass();
+
+  sceneMgr->_suppressRenderStateChanges(false);
+
+  double duration = timer.GetElapsed().Double() / lasers.size();
+
+  // One readback per atlas, no matter how many of its bands were drawn
+  std::set<Atlas *> drawn;
+  for (auto laser : lasers)
+    drawn.insert(laserSlots[laser].atlas);
+
+  for (auto atlas : drawn)
+  {
+    unsigned int height = atlas->height * atlas->lasers.size();
+    atlas->buffer.resize(atlas->width * height * 3);
+
+    Ogre::PixelBox dstBox(atlas->width, height, 1, Ogre::PF_FLOAT32_RGB,
+        atlas->buffer.data());
+    atlas->texture->getBuffer()->blitToMemory(dstBox);
+  }
+
+  for (auto laser : lasers)
+  {
+    const Slot &slot = laserSlots[laser];
+    laser->dataPtr->lastRenderDuration = duration;
+    laser->DeliverFrame(slot.atlas->buffer.data() +
+        slot.index * slot.atlas->width * slot.atlas->height * 3);
+  }
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef _GAZEBO_RENDERING_GPULASERBATCH_HH_
+#define _GAZEBO_RENDERING_GPULASERBATCH_HH_
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Ogre
+{
+  class Camera;
+  class RenderTarget;
+  class Texture;
+  class Viewport;
+}
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    class GpuLaser;
+    class Scene;
+
+    /// \internal
+    /// \brief Renders the GPU lasers of one scene together.
+    ///
+    /// Lasers whose second pass has the same dimensions share an atlas
+    /// texture, each one drawing into its own horizontal band. Lasers
+    /// queued during a render event are rendered back to back with the
+    /// render state set up once, then every atlas that was drawn into is
+    /// read back with a single blit and split between its lasers.
+    class GpuLaserBatch
+    {
+      /// \brief Constructor.
+      /// \param[in] _scene Scene the lasers render.
+      private: explicit GpuLaserBatch(Scene *_scene);
+
+      /// \brief Destructor. Releases the atlas textures.
+      public: ~GpuLaserBatch();
+
+      /// \brief Get the batch of a scene, creating it if needed. The batch
+      /// lives as long as one of its lasers holds on to it.
+      /// \param[in] _scene Scene the lasers render.
+      /// \return The batch of the scene.
+      public: static std::shared_ptr<GpuLaserBatch> Get(Scene *_scene);
+
+      /// \brief Check the GAZEBO_GPU_LASER_BATCH environment variable.
+      /// \return True if GPU lasers should be batched.
+      public: static bool Enabled();
+
+      /// \brief Reserve a band of an atlas for a laser's second pass.
+      /// \param[in] _laser Laser to add.
+      /// \param[in] _width Width of the laser's second pass.
+      /// \param[in] _height Height of the laser's second pass.
+      /// \param[in] _cam Orthographic camera of the laser's second pass.
+      /// \return Viewport covering the band reserved for the laser.
+      public: Ogre::Viewport *AddLaser(GpuLaser *_laser,
+                  const unsigned int _width, const unsigned int _height,
+                  Ogre::Camera *_cam);
+
+      /// \brief Release the band of a laser and drop any pending render.
+      /// \param[in] _laser Laser to remove.
+      public: void RemoveLaser(GpuLaser *_laser);
+
+      /// \brief Queue a laser to be rendered by the next Flush.
+      /// \param[in] _laser Laser to render.
+      public: void Queue(GpuLaser *_laser);
+
+      /// \brief Render all queued lasers, read back their atlases and
+      /// hand each laser its part of the data. Does nothing if no laser
+      /// is queued.
+      public: void Flush();
+
+      /// \brief An atlas texture shared by lasers of the same dimensions.
+      private: class Atlas
+      {
+        /// \brief Texture holding the bands.
+        public: Ogre::Texture *texture = nullptr;
+
+        /// \brief Render target of the texture.
+        public: Ogre::RenderTarget *target = nullptr;
+
+        /// \brief Width of one band in pixels.
+        public: unsigned int width = 0;
+
+        /// \brief Height of one band in pixels.
+        public: unsigned int height = 0;
+
+        /// \brief Laser drawing into each band, null for a free band.
+        public: std::vector<GpuLaser *> lasers;
+
+        /// \brief Memory the whole atlas is read back into.
+        public: std::vector<float> buffer;
+      };
+
+      /// \brief Band reserved for a laser.
+      private: class Slot
+      {
+        /// \brief Atlas holding the band.
+        public: Atlas *atlas = nullptr;
+
+        /// \brief Index of the band in the atlas.
+        public: unsigned int index = 0;
+      };
+
+      /// \brief Scene the lasers render.
+      private: Scene *scene;
+
+      /// \brief All atlases of the scene.
+      private: std::vector<std::unique_ptr<Atlas>> atlases;
+
+      /// \brief Band of each laser.
+      private: std::map<GpuLaser *, Slot> slots;
+
+      /// \brief Lasers queued since the last Flush.
+      private: std::vector<GpuLaser *> pending;
+
+      /// \brief Protects the members above.
+      private: std::mutex mutex;
+
+      /// \brief Number of atlases created, used to name textures.
+      private: static unsigned int atlasCount;
+    };
+  }
+}
+#endif
@@ -18,6 +18,7 @@
 #ifndef _GAZEBO_RENDERING_GPULASER_PRIVATE_HH_
 #define _GAZEBO_RENDERING_GPULASER_PRIVATE_HH_
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -45,6 +46,8 @@ namespace gazebo
 
   namespace rendering
   {
+    class GpuLaserBatch;
+
     /// \internal
     /// \brief Private data for the GpuLaser class
     class GpuLaserPrivate
@@ -131,6 +134,10 @@ namespace gazebo
       /// rendering pass.
       public: std::vector<int> texIdx;
 
+      /// \brief Batch rendering this laser together with the other GPU
+      /// lasers of the scene, null when the laser renders on its own.
+      public: std::shared_ptr<GpuLaserBatch> batch;
+
       /// Number of second pass texture units created.
       public: static int texCount;
     };
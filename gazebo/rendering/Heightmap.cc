@@ -15,6 +15,7 @@
  *
 */
 
+#include <cstdlib>
 #include <memory>
 
 #include <string.h>
@@ -640,6 +641,31 @@ void Heightmap::Load()
   // use gazebo shaders
   this->CreateMaterial();
 
+  if (this->dataPtr->useTerrainPaging)
+  {
+    this->dataPtr->connections.push_back(
+        event::Events::ConnectPreRender(
+        std::bind(&Heightmap::OnPreRender, this)));
+  }
+
+  // Large terrains can take long to load, optionally load them in the
+  // background and finish in OnPreRender
+  const char *asyncEnv = std::getenv("GAZEBO_HEIGHTMAP_ASYNC_LOAD");
+  if (asyncEnv && std::string(asyncEnv) != "0")
+  {
+    this->dataPtr->loading = true;
+    this->dataPtr->loadStartTime = time;
+    this->dataPtr->terrainGroup->loadAllTerrains(false);
+
+    if (!this->dataPtr->useTerrainPaging)
+    {
+      this->dataPtr->connections.push_back(
+          event::Events::ConnectPreRender(
+          std::bind(&Heightmap::OnPreRender, this)));
+    }
+    return;
+  }
+
   // Sync load since we want everything in place when we start
   this->dataPtr->terrainGroup->loadAllTerrains(true);
 
@@ -647,6 +673,14 @@ void Heightmap::Load()
         <<  (common::Time::GetWallTime() - time).Double()
         << " seconds" << std::endl;
 
+  this->FinishLoading();
+}
+
+///////////////////////////////////////////////////
+void Heightmap::FinishLoading()
+{
+  this->dataPtr->loadProgress = 1.0;
+
   // Calculate blend maps
   if (this->dataPtr->terrainsImported)
   {
@@ -670,6 +704,75 @@ void Heightmap::Load()
   }
 }
 
+///////////////////////////////////////////////////
+void Heightmap::OnPreRender()
+{
+  // Page tiles in around cameras created after the heightmap too. The page
+  // manager forgets cameras on its own when they are destroyed.
+  if (this->dataPtr->pageManager && this->dataPtr->scene)
+  {
+    for (unsigned int i = 0; i < this->dataPtr->scene->CameraCount(); ++i)
+    {
+      Ogre::Camera *cam = this->dataPtr->scene->GetCamera(i)->OgreCamera();
+      if (cam && !this->dataPtr->pageManager->hasCamera(cam))
+        this->dataPtr->pageManager->addCamera(cam);
+    }
+    for (unsigned int i = 0; i < this->dataPtr->scene->UserCameraCount();
+        ++i)
+    {
+      Ogre::Camera *cam =
+          this->dataPtr->scene->GetUserCamera(i)->OgreCamera();
+      if (cam && !this->dataPtr->pageManager->hasCamera(cam))
+        this->dataPtr->pageManager->addCamera(cam);
+    }
+  }
+
+  if (!this->dataPtr->loading)
+    return;
+
+  unsigned int total = 0;
+  unsigned int loaded = 0;
+  Ogre::TerrainGroup::TerrainIterator ti =
+    this->dataPtr->terrainGroup->getTerrainIterator();
+  while (ti.hasMoreElements())
+  {
+    Ogre::Terrain *t = ti.getNext()->instance;
+    ++total;
+    if (t && t->isLoaded())
+      ++loaded;
+  }
+
+  this->dataPtr->loadProgress = total > 0 ?
+      static_cast<double>(loaded) / total : 1.0;
+
+  int percent = static_cast<int>(this->dataPtr->loadProgress * 100);
+  if (loaded < total)
+  {
+    if (percent >= this->dataPtr->reportedProgress + 10)
+    {
+      this->dataPtr->reportedProgress = percent;
+      gzmsg << "Loading heightmap: " << percent << "% of " << total
+            << " tiles" << std::endl;
+    }
+    return;
+  }
+
+  this->dataPtr->loading = false;
+
+  gzmsg << "Heightmap loaded. Process took: "
+        <<  (common::Time::GetWallTime() -
+            this->dataPtr->loadStartTime).Double()
+        << " seconds" << std::endl;
+
+  this->FinishLoading();
+}
+
+//////////////////////////////////////////////////
+double Heightmap::LoadProgress() const
+{
+  return this->dataPtr->loadProgress;
+}
+
 ///////////////////////////////////////////////////
 void Heightmap::SaveHeightmap()
 {
@@ -1038,7 +1141,8 @@ double Heightmap::AvgHeight(const ignition::math::Vector3d &_pos,
   GZ_ASSERT(this->dataPtr->terrainGroup, "TerrainGroup pointer is NULL");
   Ogre::Terrain *terrain = this->dataPtr->terrainGroup->getTerrain(0, 0);
 
-  if (!terrain)
+  // Tiles may still be loading in the background
+  if (!terrain || !terrain->isLoaded())
   {
     gzerr << "Invalid heightmap position [" << _pos << "]\n";
     return 0.0;
@@ -1081,7 +1185,8 @@ void Heightmap::ModifyTerrain(Ogre::Vector3 _pos, const double _outsideRadius,
   GZ_ASSERT(this->dataPtr->terrainGroup, "TerrainGroup pointer is NULL");
   Ogre::Terrain *terrain = this->dataPtr->terrainGroup->getTerrain(0, 0);
 
-  if (!terrain)
+  // Tiles may still be loading in the background
+  if (!terrain || !terrain->isLoaded())
   {
     gzerr << "Invalid heightmap position [" << _pos << "]\n";
     return;
@@ -219,6 +219,12 @@ namespace gazebo
       /// \return True if the heightmap terrain casts shadows
       public: bool CastShadows() const;
 
+      /// \brief Get the fraction of terrain tiles loaded. Tiles load in
+      /// the background when the GAZEBO_HEIGHTMAP_ASYNC_LOAD environment
+      /// variable is set, otherwise Load() returns with all of them loaded.
+      /// \return Value between 0 and 1, 1 once every tile is loaded.
+      public: double LoadProgress() const;
+
       /// \brief Create terrain material generator. There are two types:
       /// custom material generator that support user material scripts,
       /// and a default material generator that uses our own glsl shader
@@ -273,6 +279,15 @@ namespace gazebo
       /// \brief Save the heightmap tiles to disk
       private: void SaveHeightmap();
 
+      /// \brief Set up the blend maps and release the memory only needed
+      /// while loading, once every tile is loaded.
+      private: void FinishLoading();
+
+      /// \brief Called before each render. Reports the progress of tiles
+      /// loading in the background, and adds new cameras to the page manager
+      /// so that tiles are paged in around every camera.
+      private: void OnPreRender();
+
       /// \internal
       /// \brief Pointer to private data.
       private: std::unique_ptr<HeightmapPrivate> dataPtr;
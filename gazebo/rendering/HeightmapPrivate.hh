@@ -23,6 +23,7 @@
 
 #include <ignition/math/Vector3.hh>
 
+#include "gazebo/common/Time.hh"
 #include "gazebo/rendering/RenderTypes.hh"
 
 #if OGRE_VERSION_MAJOR == 1 && OGRE_VERSION_MINOR >= 11
@@ -485,6 +486,18 @@ namespace gazebo
 
       /// \brief Event connections
       public: std::vector<event::ConnectionPtr> connections;
+
+      /// \brief True while terrain tiles load in the background.
+      public: bool loading = false;
+
+      /// \brief Fraction of terrain tiles loaded.
+      public: double loadProgress = 0.0;
+
+      /// \brief Last progress reported, in percent.
+      public: int reportedProgress = 0;
+
+      /// \brief Wall time the tiles started loading.
+      public: common::Time loadStartTime;
     };
   }
 }
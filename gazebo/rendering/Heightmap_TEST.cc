@@ -147,6 +147,9 @@ TEST_F(Heightmap_TEST, LoadDEM)
   auto visMsg = new ConstVisualPtr(&msg);
   heightmap->LoadFromMsg(*visMsg);
 
+  // tiles are loaded synchronously by default
+  EXPECT_DOUBLE_EQ(1.0, heightmap->LoadProgress());
+
   // verify heightmap image size
   unsigned int subsampling = 2;
   unsigned int tifSize = 129;
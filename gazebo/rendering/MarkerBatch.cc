@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstdlib>
+#include <sstream>
+
+#include <ignition/common/Profiler.hh>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/rendering/DynamicLines.hh"
+#include "gazebo/rendering/RenderEvents.hh"
+#include "gazebo/rendering/MarkerBatch.hh"
+
+using namespace gazebo;
+using namespace rendering;
+
+/////////////////////////////////////////////////
+MarkerBatch::MarkerBatch(const std::string &_name, VisualPtr _parent)
+: Visual(_name, _parent, false)
+{
+}
+
+/////////////////////////////////////////////////
+MarkerBatch::~MarkerBatch()
+{
+  this->Fini();
+}
+
+/////////////////////////////////////////////////
+bool MarkerBatch::Enabled()
+{
+  const char *env = std::getenv("GAZEBO_MARKER_BATCH");
+  return env && std::string(env) != "0";
+}
+
+/////////////////////////////////////////////////
+bool MarkerBatch::Batchable(const ignition::msgs::Marker &_msg)
+{
+  // Strips and fans can not be joined into one draw call
+  return _msg.parent().empty() &&
+      (_msg.type() == ignition::msgs::Marker::POINTS ||
+       _msg.type() == ignition::msgs::Marker::LINE_LIST ||
+       _msg.type() == ignition::msgs::Marker::TRIANGLE_LIST);
+}
+
+/////////////////////////////////////////////////
+std::string MarkerBatch::Key(const std::string &_ns,
+    const ignition::msgs::Marker &_msg)
+{
+  std::stringstream key;
+  key << _ns << "|" << _msg.type() << "|" << _msg.layer() << "|" <<
+      _msg.material().SerializeAsString();
+  return key.str();
+}
+
+/////////////////////////////////////////////////
+std::vector<ignition::math::Vector3d> MarkerBatch::WorldPoints(
+    const ignition::msgs::Marker &_msg)
+{
+  ignition::math::Pose3d pose;
+  if (_msg.has_pose())
+    pose = ignition::msgs::Convert(_msg.pose());
+
+  ignition::math::Vector3d scale = ignition::math::Vector3d::One;
+  if (_msg.has_scale())
+    scale = ignition::msgs::Convert(_msg.scale());
+
+  std::vector<ignition::math::Vector3d> points;
+  points.reserve(_msg.point_size());
+  for (int i = 0; i < _msg.point_size(); ++i)
+  {
+    points.push_back(pose.Pos() + pose.Rot().RotateVector(
+        scale * ignition::msgs::Convert(_msg.point(i))));
+  }
+  return points;
+}
+
+/////////////////////////////////////////////////
+void MarkerBatch::Load(const ignition::msgs::Marker &_msg)
+{
+  Visual::Load();
+
+  switch (_msg.type())
+  {
+    case ignition::msgs::Marker::LINE_LIST:
+      this->lines = this->CreateDynamicLine(rendering::RENDERING_LINE_LIST);
+      break;
+    case ignition::msgs::Marker::TRIANGLE_LIST:
+      this->lines =
+          this->CreateDynamicLine(rendering::RENDERING_TRIANGLE_LIST);
+      break;
+    default:
+      this->lines = this->CreateDynamicLine(rendering::RENDERING_POINT_LIST);
+      break;
+  }
+
+  if (_msg.has_material())
+    this->ProcessMaterialMsg(_msg.material());
+
+  rendering::Events::newLayer(_msg.layer());
+  this->SetLayer(_msg.layer());
+  this->SetVisibilityFlags(GZ_VISIBILITY_GUI);
+}
+
+/////////////////////////////////////////////////
+void MarkerBatch::SetMarker(const uint64_t _id,
+    const std::vector<ignition::math::Vector3d> &_points)
+{
+  IGN_PROFILE("rendering::MarkerBatch::SetMarker");
+  if (!this->lines)
+    return;
+
+  auto iter = this->ranges.find(_id);
+
+  // Same number of points: overwrite the range in place, so only that
+  // part of the buffer is uploaded again
+  if (iter != this->ranges.end() && iter->second.count == _points.size())
+  {
+    for (unsigned int i = 0; i < _points.size(); ++i)
+      this->lines->SetPoint(iter->second.start + i, _points[i]);
+    return;
+  }
+
+  this->RemoveMarker(_id);
+
+  Range &range = this->ranges[_id];
+  range.start = this->lines->GetPointCount();
+  range.count = _points.size();
+  for (const auto &point : _points)
+    this->lines->AddPoint(point);
+}
+
+/////////////////////////////////////////////////
+void MarkerBatch::RemoveMarker(const uint64_t _id)
+{
+  auto iter = this->ranges.find(_id);
+  if (iter == this->ranges.end() || !this->lines)
+    return;
+
+  Range removed = iter->second;
+  this->ranges.erase(iter);
+  this->lines->RemovePoints(removed.start, removed.count);
+
+  for (auto &range : this->ranges)
+  {
+    if (range.second.start > removed.start)
+      range.second.start -= removed.count;
+  }
+}
+
+/////////////////////////////////////////////////
+size_t MarkerBatch::MarkerCount() const
+{
+  return this->ranges.size();
+}
+
+/////////////////////////////////////////////////
+unsigned int MarkerBatch::PointCount() const
+{
+  return this->lines ? this->lines->GetPointCount() : 0u;
+}
+
+/////////////////////////////////////////////////
+void MarkerBatch::Fini()
+{
+  if (this->lines)
+  {
+    this->DeleteDynamicLine(this->lines);
+    this->lines = nullptr;
+  }
+  this->ranges.clear();
+  Visual::Fini();
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef _GAZEBO_RENDERING_MARKERBATCH_HH_
+#define _GAZEBO_RENDERING_MARKERBATCH_HH_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ignition/math/Vector3.hh>
+#include <ignition/msgs.hh>
+
+#include "gazebo/rendering/Visual.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    class DynamicLines;
+
+    /// \internal
+    /// \brief Draws many markers of a namespace with one dynamic renderable.
+    ///
+    /// Markers of type POINTS, LINE_LIST and TRIANGLE_LIST that share a
+    /// namespace, type, material and layer are appended to a single vertex
+    /// buffer in world coordinates. Each marker owns a contiguous range of
+    /// the buffer, so changing the points of one marker only uploads its
+    /// range again, as long as the number of points stays the same.
+    class GZ_RENDERING_VISIBLE MarkerBatch : public Visual
+    {
+      /// \brief Constructor.
+      /// \param[in] _name Name of the visual.
+      /// \param[in] _parent Parent visual, usually the world visual.
+      public: MarkerBatch(const std::string &_name, VisualPtr _parent);
+
+      /// \brief Destructor.
+      public: virtual ~MarkerBatch();
+
+      /// \brief Check the GAZEBO_MARKER_BATCH environment variable.
+      /// \return True if markers should be batched.
+      public: static bool Enabled();
+
+      /// \brief Check if a marker can be drawn by a batch.
+      /// \param[in] _msg Marker message, with all fields set so far.
+      /// \return True for points, line lists and triangle lists without
+      /// a parent visual.
+      public: static bool Batchable(const ignition::msgs::Marker &_msg);
+
+      /// \brief Get the key of the batch a marker belongs to.
+      /// \param[in] _ns Namespace of the marker.
+      /// \param[in] _msg Marker message, with all fields set so far.
+      /// \return Key made of the namespace, type, material and layer.
+      public: static std::string Key(const std::string &_ns,
+                  const ignition::msgs::Marker &_msg);
+
+      /// \brief Get the points of a marker in world coordinates, with its
+      /// scale and pose applied.
+      /// \param[in] _msg Marker message, with all fields set so far.
+      /// \return Points of the marker.
+      public: static std::vector<ignition::math::Vector3d> WorldPoints(
+                  const ignition::msgs::Marker &_msg);
+
+      /// \brief Set up the batch from the first marker added to it.
+      /// \param[in] _msg Marker message providing type, material and layer.
+      public: void Load(const ignition::msgs::Marker &_msg);
+
+      /// \brief Add a marker, or replace the points of a marker.
+      /// \param[in] _id Id of the marker in its namespace.
+      /// \param[in] _points Points of the marker in world coordinates.
+      public: void SetMarker(const uint64_t _id,
+                  const std::vector<ignition::math::Vector3d> &_points);
+
+      /// \brief Remove a marker. Does nothing if the marker is unknown.
+      /// \param[in] _id Id of the marker in its namespace.
+      public: void RemoveMarker(const uint64_t _id);
+
+      /// \brief Number of markers in the batch.
+      /// \return Number of markers.
+      public: size_t MarkerCount() const;
+
+      /// \brief Number of points drawn by the batch.
+      /// \return Number of points of all markers.
+      public: unsigned int PointCount() const;
+
+      // Documentation inherited.
+      public: virtual void Fini();
+
+      /// \brief Range of the vertex buffer owned by a marker.
+      private: class Range
+      {
+        /// \brief Index of the first point.
+        public: unsigned int start = 0;
+
+        /// \brief Number of points.
+        public: unsigned int count = 0;
+      };
+
+      /// \brief Renders the points of all markers.
+      private: DynamicLines *lines = nullptr;
+
+      /// \brief Range of each marker, by id.
+      private: std::map<uint64_t, Range> ranges;
+    };
+
+    /// \def MarkerBatchPtr
+    /// \brief Shared pointer to MarkerBatch
+    typedef std::shared_ptr<MarkerBatch> MarkerBatchPtr;
+  }
+}
+#endif
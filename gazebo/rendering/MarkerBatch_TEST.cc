@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "gazebo/rendering/RenderingIface.hh"
+#include "gazebo/rendering/Scene.hh"
+#include "gazebo/rendering/MarkerBatch.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+class MarkerBatch_TEST : public RenderingFixture
+{
+};
+
+/////////////////////////////////////////////////
+TEST_F(MarkerBatch_TEST, Batchable)
+{
+  ignition::msgs::Marker msg;
+  msg.set_type(ignition::msgs::Marker::LINE_LIST);
+  EXPECT_TRUE(rendering::MarkerBatch::Batchable(msg));
+
+  msg.set_type(ignition::msgs::Marker::LINE_STRIP);
+  EXPECT_FALSE(rendering::MarkerBatch::Batchable(msg));
+
+  msg.set_type(ignition::msgs::Marker::POINTS);
+  msg.set_parent("box");
+  EXPECT_FALSE(rendering::MarkerBatch::Batchable(msg));
+
+  // Markers only share a batch with the same material
+  msg.clear_parent();
+  std::string key = rendering::MarkerBatch::Key("ns", msg);
+  EXPECT_EQ(key, rendering::MarkerBatch::Key("ns", msg));
+  EXPECT_NE(key, rendering::MarkerBatch::Key("other", msg));
+  msg.mutable_material()->mutable_script()->set_name("Gazebo/Red");
+  EXPECT_NE(key, rendering::MarkerBatch::Key("ns", msg));
+}
+
+/////////////////////////////////////////////////
+TEST_F(MarkerBatch_TEST, WorldPoints)
+{
+  ignition::msgs::Marker msg;
+  ignition::msgs::Set(msg.add_point(), ignition::math::Vector3d(1, 0, 0));
+  ignition::msgs::Set(msg.mutable_scale(), ignition::math::Vector3d(2, 1, 1));
+  ignition::msgs::Set(msg.mutable_pose(),
+      ignition::math::Pose3d(0, 0, 1, 0, 0, IGN_PI_2));
+
+  auto points = rendering::MarkerBatch::WorldPoints(msg);
+  ASSERT_EQ(1u, points.size());
+  EXPECT_EQ(ignition::math::Vector3d(0, 2, 1), points[0]);
+}
+
+/////////////////////////////////////////////////
+TEST_F(MarkerBatch_TEST, SetRemove)
+{
+  Load("worlds/empty.world");
+
+  rendering::ScenePtr scene = rendering::get_scene("default");
+  if (!scene)
+    scene = rendering::create_scene("default", false);
+  ASSERT_TRUE(scene != nullptr);
+
+  ignition::msgs::Marker msg;
+  msg.set_type(ignition::msgs::Marker::POINTS);
+
+  rendering::MarkerBatchPtr batch(new rendering::MarkerBatch(
+        "batch", scene->WorldVisual()));
+  batch->Load(msg);
+
+  std::vector<ignition::math::Vector3d> points(3);
+  batch->SetMarker(1, points);
+  batch->SetMarker(2, std::vector<ignition::math::Vector3d>(2));
+  EXPECT_EQ(2u, batch->MarkerCount());
+  EXPECT_EQ(5u, batch->PointCount());
+
+  // Same size, updated in place
+  points[0].Set(1, 2, 3);
+  batch->SetMarker(1, points);
+  EXPECT_EQ(5u, batch->PointCount());
+
+  // Different size
+  points.resize(4);
+  batch->SetMarker(1, points);
+  EXPECT_EQ(6u, batch->PointCount());
+
+  batch->RemoveMarker(2);
+  EXPECT_EQ(1u, batch->MarkerCount());
+  EXPECT_EQ(4u, batch->PointCount());
+
+  batch->RemoveMarker(3);
+  EXPECT_EQ(1u, batch->MarkerCount());
+
+  batch->RemoveMarker(1);
+  EXPECT_EQ(0u, batch->MarkerCount());
+  EXPECT_EQ(0u, batch->PointCount());
+
+  batch->Fini();
+  scene->RemoveVisual(batch);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
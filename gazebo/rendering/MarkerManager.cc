@@ -29,6 +29,7 @@
 #include "gazebo/transport/Node.hh"
 #include "gazebo/rendering/RenderingIface.hh"
 #include "gazebo/rendering/Scene.hh"
+#include "gazebo/rendering/MarkerBatch.hh"
 #include "gazebo/rendering/MarkerVisual.hh"
 #include "gazebo/rendering/MarkerManager.hh"
 
@@ -51,11 +52,46 @@ class gazebo::rendering::MarkerManagerPrivate
   /// \brief List of marker messages.
   typedef std::list<ignition::msgs::Marker> MarkerMsgs_L;
 
+  /// \brief A marker drawn by a batch.
+  public: class BatchedMarker
+  {
+    /// \brief Key of the batch drawing the marker.
+    public: std::string key;
+
+    /// \brief All fields received for the marker so far.
+    public: ignition::msgs::Marker msg;
+
+    /// \brief Lifetime of the marker.
+    public: common::Time lifetime;
+  };
+
   /// \brief Process a marker message.
   /// \param[in] _msg The message data.
   /// \return True if the marker was processed successfully.
   public: bool ProcessMarkerMsg(const ignition::msgs::Marker &_msg);
 
+  /// \brief Add or modify a batched marker.
+  /// \param[in] _ns Namespace of the marker.
+  /// \param[in] _id Id of the marker.
+  /// \param[in] _msg The message data.
+  /// \param[out] _merged All fields received for the marker so far.
+  /// \return False if the marker can not be batched, it is then removed
+  /// from its batch and should be loaded from _merged into a visual.
+  public: bool AddModifyBatched(const std::string &_ns, const uint64_t _id,
+              const ignition::msgs::Marker &_msg,
+              ignition::msgs::Marker &_merged);
+
+  /// \brief Remove a marker from its batch, and the batch if it is empty.
+  /// \param[in] _key Key of the batch.
+  /// \param[in] _id Id of the marker.
+  public: void RemoveFromBatch(const std::string &_key, const uint64_t _id);
+
+  /// \brief Check if a marker exists, batched or not.
+  /// \param[in] _ns Namespace of the marker.
+  /// \param[in] _id Id of the marker.
+  /// \return True if the marker exists.
+  public: bool Exists(const std::string &_ns, const uint64_t _id) const;
+
   /// \brief Update the markers. This function is called on
   /// the PreRender event.
   public: void OnPreRender();
@@ -82,6 +118,18 @@ class gazebo::rendering::MarkerManagerPrivate
   /// \brief Map of markers
   public: Marker_M markers;
 
+  /// \brief Batched markers, by namespace and id.
+  public: std::map<std::string, std::map<uint64_t, BatchedMarker>> batched;
+
+  /// \brief Batches, by key.
+  public: std::map<std::string, MarkerBatchPtr> batches;
+
+  /// \brief Number of batches created, used to name them.
+  public: unsigned int batchCount = 0;
+
+  /// \brief True if new markers should be batched when possible.
+  public: bool batching = MarkerBatch::Enabled();
+
   /// \brief List of marker message to process.
   public: MarkerMsgs_L markerMsgs;
 
@@ -195,6 +243,28 @@ void MarkerManagerPrivate::OnPreRender()
     else
       ++mit;
   }
+
+  // Same for batched markers
+  for (auto bit = this->batched.begin(); bit != this->batched.end();)
+  {
+    for (auto it = bit->second.begin(); it != bit->second.end();)
+    {
+      if (it->second.lifetime != common::Time::Zero &&
+          (it->second.lifetime <= this->simTime ||
+          this->simTime < this->lastSimTime))
+      {
+        this->RemoveFromBatch(it->second.key, it->first);
+        it = bit->second.erase(it);
+      }
+      else
+        ++it;
+    }
+
+    if (bit->second.empty())
+      bit = this->batched.erase(bit);
+    else
+      ++bit;
+  }
   this->lastSimTime = this->simTime;
 }
 
@@ -221,14 +291,17 @@ bool MarkerManagerPrivate::ProcessMarkerMsg(const ignition::msgs::Marker &_msg)
     id = ignition::math::Rand::IntUniform(0, ignition::math::MAX_I32);
 
     // Make sure it's unique if namespace is given
-    if (nsIter != this->markers.end())
+    while (this->Exists(ns, id))
     {
-      while (nsIter->second.find(id) != nsIter->second.end())
-        id = ignition::math::Rand::IntUniform(ignition::math::MIN_UI32,
-                                              ignition::math::MAX_UI32);
+      id = ignition::math::Rand::IntUniform(ignition::math::MIN_UI32,
+                                            ignition::math::MAX_UI32);
     }
   }
 
+  auto batchedNs = this->batched.find(ns);
+  bool isBatched = batchedNs != this->batched.end() &&
+      batchedNs->second.find(id) != batchedNs->second.end();
+
   // Get marker for this namespace and id
   std::map<uint64_t, MarkerVisualPtr>::iterator markerIter;
   if (nsIter != this->markers.end())
@@ -237,8 +310,21 @@ bool MarkerManagerPrivate::ProcessMarkerMsg(const ignition::msgs::Marker &_msg)
   // Add/modify a marker
   if (_msg.action() == ignition::msgs::Marker::ADD_MODIFY)
   {
+    bool isVisual =
+        nsIter != this->markers.end() && markerIter != nsIter->second.end();
+
+    // Markers that were batched stay batched while they can be, new
+    // markers are batched if enabled and possible
+    ignition::msgs::Marker merged = _msg;
+    if (isBatched || (this->batching && !isVisual &&
+        MarkerBatch::Batchable(_msg)))
+    {
+      if (this->AddModifyBatched(ns, id, _msg, merged))
+        return true;
+    }
+
     // Modify an existing marker, identified by namespace and id
-    if (nsIter != this->markers.end() && markerIter != nsIter->second.end())
+    if (isVisual)
     {
       markerIter->second->Load(_msg);
     }
@@ -254,7 +340,7 @@ bool MarkerManagerPrivate::ProcessMarkerMsg(const ignition::msgs::Marker &_msg)
             this->scene->WorldVisual()));
 
       // Load the marker
-      marker->Load(_msg);
+      marker->Load(merged);
 
       // Store the marker
       this->markers[ns][id] = marker;
@@ -264,7 +350,16 @@ bool MarkerManagerPrivate::ProcessMarkerMsg(const ignition::msgs::Marker &_msg)
   else if (_msg.action() == ignition::msgs::Marker::DELETE_MARKER)
   {
     // Remove the marker if it can be found.
-    if (nsIter != this->markers.end() && markerIter != nsIter->second.end())
+    if (isBatched)
+    {
+      auto it = batchedNs->second.find(id);
+      this->RemoveFromBatch(it->second.key, id);
+      batchedNs->second.erase(it);
+      if (batchedNs->second.empty())
+        this->batched.erase(batchedNs);
+    }
+    else if (nsIter != this->markers.end() &&
+             markerIter != nsIter->second.end())
     {
       markerIter->second->Fini();
       this->scene->RemoveVisual(markerIter->second);
@@ -284,8 +379,23 @@ bool MarkerManagerPrivate::ProcessMarkerMsg(const ignition::msgs::Marker &_msg)
   // Remove all markers, or all markers in a namespace
   else if (_msg.action() == ignition::msgs::Marker::DELETE_ALL)
   {
+    // Remove batched markers of the namespace, or all of them
+    bool hadBatched = batchedNs != this->batched.end();
+    for (auto bit = this->batched.begin(); bit != this->batched.end();)
+    {
+      if (!ns.empty() && bit->first != ns)
+      {
+        ++bit;
+        continue;
+      }
+
+      for (const auto &it : bit->second)
+        this->RemoveFromBatch(it.second.key, it.first);
+      bit = this->batched.erase(bit);
+    }
+
     // If given namespace doesn't exist
-    if (!ns.empty() && nsIter == this->markers.end())
+    if (!ns.empty() && nsIter == this->markers.end() && !hadBatched)
     {
       gzwarn << "Unable to delete all markers in namespace[" << ns <<
           "], namespace can't be found." << std::endl;
@@ -303,7 +413,7 @@ bool MarkerManagerPrivate::ProcessMarkerMsg(const ignition::msgs::Marker &_msg)
       this->markers.erase(nsIter);
     }
     // Remove all markers in all namespaces.
-    else
+    else if (ns.empty())
     {
       for (nsIter = this->markers.begin();
            nsIter != this->markers.end(); ++nsIter)
@@ -326,6 +436,101 @@ bool MarkerManagerPrivate::ProcessMarkerMsg(const ignition::msgs::Marker &_msg)
   return true;
 }
 
+//////////////////////////////////////////////////
+bool MarkerManagerPrivate::AddModifyBatched(const std::string &_ns,
+    const uint64_t _id, const ignition::msgs::Marker &_msg,
+    ignition::msgs::Marker &_merged)
+{
+  auto &nsMarkers = this->batched[_ns];
+  auto iter = nsMarkers.find(_id);
+
+  // Fields not in the message keep their previous value, except points
+  // which are replaced whenever some are given
+  _merged.Clear();
+  if (iter != nsMarkers.end())
+  {
+    _merged = iter->second.msg;
+    if (_msg.point_size() > 0)
+      _merged.clear_point();
+  }
+  _merged.MergeFrom(_msg);
+
+  common::Time lifetime;
+  if (iter != nsMarkers.end())
+    lifetime = iter->second.lifetime;
+  if (_msg.has_lifetime() &&
+      (_msg.lifetime().sec() > 0 ||
+      (_msg.lifetime().sec() == 0 && _msg.lifetime().nsec() > 0)))
+  {
+    lifetime = this->scene->SimTime() +
+      common::Time(_msg.lifetime().sec(), _msg.lifetime().nsec());
+  }
+
+  std::string key = MarkerBatch::Key(_ns, _merged);
+  if (iter != nsMarkers.end() &&
+      (iter->second.key != key || !MarkerBatch::Batchable(_merged)))
+  {
+    this->RemoveFromBatch(iter->second.key, _id);
+    nsMarkers.erase(iter);
+    iter = nsMarkers.end();
+  }
+
+  if (!MarkerBatch::Batchable(_merged))
+  {
+    if (nsMarkers.empty())
+      this->batched.erase(_ns);
+    return false;
+  }
+
+  MarkerBatchPtr &batch = this->batches[key];
+  if (!batch)
+  {
+    batch.reset(new MarkerBatch("__GZ_MARKER_BATCH_" + _ns + "_" +
+        std::to_string(this->batchCount++), this->scene->WorldVisual()));
+    batch->Load(_merged);
+  }
+  batch->SetMarker(_id, MarkerBatch::WorldPoints(_merged));
+
+  BatchedMarker &marker = nsMarkers[_id];
+  marker.key = key;
+  marker.msg = _merged;
+  marker.lifetime = lifetime;
+  return true;
+}
+
+//////////////////////////////////////////////////
+void MarkerManagerPrivate::RemoveFromBatch(const std::string &_key,
+    const uint64_t _id)
+{
+  auto iter = this->batches.find(_key);
+  if (iter == this->batches.end())
+    return;
+
+  iter->second->RemoveMarker(_id);
+  if (iter->second->MarkerCount() == 0)
+  {
+    iter->second->Fini();
+    this->scene->RemoveVisual(iter->second);
+    this->batches.erase(iter);
+  }
+}
+
+//////////////////////////////////////////////////
+bool MarkerManagerPrivate::Exists(const std::string &_ns,
+    const uint64_t _id) const
+{
+  auto nsIter = this->markers.find(_ns);
+  if (nsIter != this->markers.end() &&
+      nsIter->second.find(_id) != nsIter->second.end())
+  {
+    return true;
+  }
+
+  auto batchedNs = this->batched.find(_ns);
+  return batchedNs != this->batched.end() &&
+      batchedNs->second.find(_id) != batchedNs->second.end();
+}
+
 /////////////////////////////////////////////////
 void MarkerManagerPrivate::OnMarkerMsg(const ignition::msgs::Marker &_req)
 {
@@ -353,6 +558,19 @@ bool MarkerManagerPrivate::OnList(ignition::msgs::Marker_V &_rep)
     }
   }
 
+  for (const auto &nsMarkers : this->batched)
+  {
+    for (const auto &marker : nsMarkers.second)
+    {
+      ignition::msgs::Marker *markerMsg = _rep.add_marker();
+      *markerMsg = marker.second.msg;
+      markerMsg->set_ns(nsMarkers.first);
+      markerMsg->set_id(marker.first);
+      markerMsg->mutable_lifetime()->set_sec(marker.second.lifetime.sec);
+      markerMsg->mutable_lifetime()->set_nsec(marker.second.lifetime.nsec);
+    }
+  }
+
   return true;
 }
 
@@ -0,0 +1,221 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "gazebo/rendering/ogre_gazebo.h"
+#include <OGRE/OgreMeshSerializer.h>
+#include <OGRE/OgreDistanceLodStrategy.h>
+
+// Levels of detail are generated by Ogre's progressive mesh generator,
+// which is part of OgreMain in 1.9 only. Later versions moved it to the
+// MeshLodGenerator component, which is not linked. Cached levels load with
+// any version.
+#if OGRE_VERSION_MAJOR == 1 && OGRE_VERSION_MINOR == 9
+#define GAZEBO_MESH_LOD_GENERATOR
+#include <OGRE/OgreLodConfig.h>
+#include <OGRE/OgreProgressiveMeshGenerator.h>
+#endif
+
+#include "gazebo/common/CommonIface.hh"
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/common/SystemPaths.hh"
+
+#include "gazebo/rendering/Material.hh"
+#include "gazebo/rendering/MeshLod.hh"
+
+using namespace gazebo;
+using namespace rendering;
+
+/// \brief Triangle count used when GAZEBO_MESH_LOD holds no count.
+static const unsigned int kDefaultMinTriangles = 50000;
+
+/// \brief Distance of each level of detail, in bounding radii of the mesh,
+/// and the fraction of vertices it removes.
+static const double kLodLevels[][2] = {{10, 0.5}, {25, 0.75}, {60, 0.9}};
+
+/// \brief Suffix of the cache file written next to a mesh file.
+static const char kCacheSuffix[] = ".lod.mesh";
+
+//////////////////////////////////////////////////
+unsigned int MeshLod::MinTriangles()
+{
+  const char *env = std::getenv("GAZEBO_MESH_LOD");
+  if (!env || std::string(env) == "0")
+    return 0;
+
+  int count = std::atoi(env);
+  return count > 1 ? static_cast<unsigned int>(count) : kDefaultMinTriangles;
+}
+
+//////////////////////////////////////////////////
+bool MeshLod::Wanted(const common::Mesh *_mesh)
+{
+  unsigned int minTriangles = MinTriangles();
+  if (minTriangles == 0 || !_mesh || _mesh->HasSkeleton())
+    return false;
+
+  unsigned int triangles = 0;
+  for (unsigned int i = 0; i < _mesh->GetSubMeshCount(); ++i)
+  {
+    const common::SubMesh *subMesh = _mesh->GetSubMesh(i);
+    if (subMesh->GetPrimitiveType() != common::SubMesh::TRIANGLES)
+      return false;
+    triangles += subMesh->GetIndexCount() / 3;
+  }
+
+  return triangles >= minTriangles;
+}
+
+//////////////////////////////////////////////////
+std::vector<std::string> MeshLod::CachePaths(const common::Mesh *_mesh)
+{
+  std::vector<std::string> paths;
+
+  boost::filesystem::path source(_mesh->GetName());
+  boost::system::error_code ec;
+  if (!boost::filesystem::is_regular_file(source, ec))
+    return paths;
+
+  paths.push_back(source.string() + kCacheSuffix);
+
+  boost::filesystem::path cacheDir =
+      boost::filesystem::path(common::SystemPaths::Instance()->GetLogPath()) /
+      "mesh_lod";
+  paths.push_back((cacheDir /
+      (common::get_sha1(source.string()) + ".mesh")).string());
+
+  return paths;
+}
+
+//////////////////////////////////////////////////
+bool MeshLod::LoadCached(const common::Mesh *_mesh, Ogre::Mesh *_ogreMesh)
+{
+  boost::system::error_code ec;
+  std::time_t sourceTime =
+      boost::filesystem::last_write_time(_mesh->GetName(), ec);
+  if (ec)
+    return false;
+
+  for (auto const &path : CachePaths(_mesh))
+  {
+    std::time_t cacheTime = boost::filesystem::last_write_time(path, ec);
+    if (ec || cacheTime < sourceTime)
+      continue;
+
+    try
+    {
+      std::ifstream file(path.c_str(), std::ios::in | std::ios::binary);
+      Ogre::DataStreamPtr stream(
+          OGRE_NEW Ogre::FileStreamDataStream(&file, false));
+
+      Ogre::MeshSerializer serializer;
+      serializer.importMesh(stream, _ogreMesh);
+    }
+    catch(Ogre::Exception &_e)
+    {
+      gzwarn << "Unable to read mesh levels of detail [" << path << "]: "
+             << _e.getDescription() << std::endl;
+      continue;
+    }
+
+    // The cache only holds material names, create the materials
+    for (unsigned int i = 0; i < _mesh->GetSubMeshCount(); ++i)
+    {
+      const common::Material *material =
+          _mesh->GetMaterial(_mesh->GetSubMesh(i)->GetMaterialIndex());
+      if (material)
+        Material::Update(material);
+    }
+
+    return true;
+  }
+
+  return false;
+}
+
+//////////////////////////////////////////////////
+bool MeshLod::Generate(const common::Mesh *_mesh, Ogre::Mesh *_ogreMesh)
+{
+#ifdef GAZEBO_MESH_LOD_GENERATOR
+  Ogre::LodConfig config;
+  config.mesh = Ogre::MeshManager::getSingleton().getByName(
+      _ogreMesh->getName(), _ogreMesh->getGroup());
+  config.strategy = Ogre::DistanceLodSphereStrategy::getSingletonPtr();
+
+  const Ogre::Real radius =
+      std::max<Ogre::Real>(0.01, _ogreMesh->getBoundingSphereRadius());
+  for (auto const &level : kLodLevels)
+  {
+    config.createGeneratedLodLevel(level[0] * radius, level[1],
+        Ogre::LodLevel::VRM_PROPORTIONAL);
+  }
+
+  try
+  {
+    Ogre::ProgressiveMeshGenerator generator;
+    generator.generateLodLevels(config);
+  }
+  catch(Ogre::Exception &_e)
+  {
+    gzwarn << "Unable to generate levels of detail for mesh ["
+           << _mesh->GetName() << "]: " << _e.getDescription() << std::endl;
+    return false;
+  }
+
+  // Write the cache where possible, to a temporary file first so other
+  // processes never read a partial mesh
+  Ogre::MeshSerializer serializer;
+  for (auto const &path : CachePaths(_mesh))
+  {
+    boost::system::error_code ec;
+    boost::filesystem::create_directories(
+        boost::filesystem::path(path).parent_path(), ec);
+
+    const std::string tmpPath = path + ".tmp";
+    try
+    {
+      serializer.exportMesh(_ogreMesh, tmpPath);
+    }
+    catch(Ogre::Exception &)
+    {
+      boost::filesystem::remove(tmpPath, ec);
+      continue;
+    }
+
+    boost::filesystem::rename(tmpPath, path, ec);
+    if (!ec)
+      return true;
+    boost::filesystem::remove(tmpPath, ec);
+  }
+
+  gzwarn << "Unable to cache levels of detail for mesh ["
+         << _mesh->GetName() << "]" << std::endl;
+  return true;
+#else
+  (void)_mesh;
+  (void)_ogreMesh;
+  return false;
+#endif
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef _GAZEBO_RENDERING_MESHLOD_HH_
+#define _GAZEBO_RENDERING_MESHLOD_HH_
+
+#include <string>
+#include <vector>
+
+namespace Ogre
+{
+  class Mesh;
+}
+
+namespace gazebo
+{
+  namespace common
+  {
+    class Mesh;
+  }
+
+  namespace rendering
+  {
+    /// \internal
+    /// \brief Builds distance based levels of detail for large meshes.
+    ///
+    /// Enabled with the GAZEBO_MESH_LOD environment variable, which holds
+    /// the number of triangles a mesh needs before it gets levels of detail
+    /// (any value below 2 selects a default). The levels are generated once
+    /// and written as an Ogre mesh next to the mesh file, or in the gazebo
+    /// log path if that directory is not writable. Later loads read the
+    /// cached mesh as long as it is newer than the mesh file.
+    class MeshLod
+    {
+      /// \brief Minimum number of triangles of a mesh with levels of detail.
+      /// \return 0 if levels of detail are disabled.
+      public: static unsigned int MinTriangles();
+
+      /// \brief Check if a mesh should get levels of detail: it has to be
+      /// a triangle mesh without skeleton, large enough.
+      /// \param[in] _mesh Mesh to check.
+      /// \return True if levels of detail should be used.
+      public: static bool Wanted(const common::Mesh *_mesh);
+
+      /// \brief Fill a manual Ogre mesh from the cache of a mesh.
+      /// \param[in] _mesh Mesh the cache was generated from.
+      /// \param[in] _ogreMesh Empty Ogre mesh to fill.
+      /// \return False if there is no up to date cache.
+      public: static bool LoadCached(const common::Mesh *_mesh,
+                  Ogre::Mesh *_ogreMesh);
+
+      /// \brief Generate the levels of detail of a loaded Ogre mesh and
+      /// write them to the cache. The buffers of the Ogre mesh need shadow
+      /// copies to be read back.
+      /// \param[in] _mesh Mesh the Ogre mesh was built from.
+      /// \param[in] _ogreMesh Ogre mesh to add levels of detail to.
+      /// \return False if the levels could not be generated.
+      public: static bool Generate(const common::Mesh *_mesh,
+                  Ogre::Mesh *_ogreMesh);
+
+      /// \brief Files the levels of detail of a mesh may be cached in, in
+      /// order of preference.
+      /// \param[in] _mesh Mesh loaded from a file.
+      /// \return Cache files, empty if the mesh was not loaded from a file.
+      public: static std::vector<std::string> CachePaths(
+                  const common::Mesh *_mesh);
+    };
+  }
+}
+#endif
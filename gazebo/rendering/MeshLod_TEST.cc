@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstdlib>
+#include <memory>
+#include <gtest/gtest.h>
+
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/rendering/MeshLod.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class MeshLod_TEST : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Create a mesh made of separate triangles.
+/// \param[in] _triangles Number of triangles.
+/// \param[in] _type Primitive type of the submesh.
+/// \return The new mesh.
+common::Mesh *CreateMesh(const unsigned int _triangles,
+    const common::SubMesh::PrimitiveType _type = common::SubMesh::TRIANGLES)
+{
+  common::Mesh *mesh = new common::Mesh();
+  mesh->SetName("lod_test_mesh");
+  common::SubMesh *subMesh = new common::SubMesh();
+  subMesh->SetPrimitiveType(_type);
+  for (unsigned int i = 0; i < _triangles; ++i)
+  {
+    subMesh->AddVertex(ignition::math::Vector3d(i, 0, 0));
+    subMesh->AddVertex(ignition::math::Vector3d(i, 1, 0));
+    subMesh->AddVertex(ignition::math::Vector3d(i, 0, 1));
+    for (unsigned int j = 0; j < 3; ++j)
+      subMesh->AddIndex(i * 3 + j);
+  }
+  mesh->AddSubMesh(subMesh);
+  return mesh;
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshLod_TEST, MinTriangles)
+{
+  unsetenv("GAZEBO_MESH_LOD");
+  EXPECT_EQ(rendering::MeshLod::MinTriangles(), 0u);
+
+  setenv("GAZEBO_MESH_LOD", "0", 1);
+  EXPECT_EQ(rendering::MeshLod::MinTriangles(), 0u);
+
+  setenv("GAZEBO_MESH_LOD", "1", 1);
+  EXPECT_GT(rendering::MeshLod::MinTriangles(), 1u);
+
+  setenv("GAZEBO_MESH_LOD", "1000", 1);
+  EXPECT_EQ(rendering::MeshLod::MinTriangles(), 1000u);
+
+  unsetenv("GAZEBO_MESH_LOD");
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshLod_TEST, Wanted)
+{
+  std::unique_ptr<common::Mesh> small(CreateMesh(10));
+  std::unique_ptr<common::Mesh> large(CreateMesh(100));
+  std::unique_ptr<common::Mesh> lines(
+      CreateMesh(100, common::SubMesh::LINES));
+
+  // Disabled by default
+  unsetenv("GAZEBO_MESH_LOD");
+  EXPECT_FALSE(rendering::MeshLod::Wanted(large.get()));
+
+  setenv("GAZEBO_MESH_LOD", "50", 1);
+  EXPECT_FALSE(rendering::MeshLod::Wanted(small.get()));
+  EXPECT_TRUE(rendering::MeshLod::Wanted(large.get()));
+  EXPECT_FALSE(rendering::MeshLod::Wanted(lines.get()));
+  EXPECT_FALSE(rendering::MeshLod::Wanted(nullptr));
+
+  // Meshes not loaded from a file are never cached
+  EXPECT_TRUE(rendering::MeshLod::CachePaths(large.get()).empty());
+
+  unsetenv("GAZEBO_MESH_LOD");
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
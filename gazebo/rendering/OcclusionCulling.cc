@@ -0,0 +1,385 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstdlib>
+#include <string>
+
+#include "gazebo/rendering/OcclusionCulling.hh"
+#include "gazebo/rendering/Visual.hh"
+
+using namespace gazebo;
+using namespace rendering;
+
+/// \brief Consecutive occluded results before a candidate is skipped, so
+/// a single late result does not make a visible visual flicker.
+static const unsigned int kOccludedFrames = 3;
+
+/// \brief Frames between two refreshes of the movable objects listened
+/// to, to pick up objects attached to existing candidates.
+static const unsigned int kOwnersPeriod = 60;
+
+/// \brief Material of the query boxes.
+static const char kQueryMaterial[] = "Gazebo/OcclusionQuery";
+
+/// \brief A unit cube scaled to a bounding box. Unlike SimpleRenderable it
+/// needs no scene node.
+class OcclusionCulling::QueryBox : public Ogre::Renderable
+{
+  /// \brief Constructor.
+  /// \param[in] _material Material the box is drawn with.
+  public: explicit QueryBox(const Ogre::MaterialPtr &_material)
+    : material(_material)
+  {
+    this->vertexData.vertexCount = 8;
+    this->vertexData.vertexDeclaration->addElement(0, 0, Ogre::VET_FLOAT3,
+        Ogre::VES_POSITION);
+    Ogre::HardwareVertexBufferSharedPtr vertices =
+        Ogre::HardwareBufferManager::getSingleton().createVertexBuffer(
+        3 * sizeof(float), 8, Ogre::HardwareBuffer::HBU_STATIC_WRITE_ONLY);
+    float positions[24];
+    for (int i = 0; i < 8; ++i)
+    {
+      positions[i * 3 + 0] = (i & 1) ? 0.5f : -0.5f;
+      positions[i * 3 + 1] = (i & 2) ? 0.5f : -0.5f;
+      positions[i * 3 + 2] = (i & 4) ? 0.5f : -0.5f;
+    }
+    vertices->writeData(0, sizeof(positions), positions, true);
+    this->vertexData.vertexBufferBinding->setBinding(0, vertices);
+
+    // Two triangles per face, winding does not matter since the query
+    // pass does not cull
+    static const Ogre::uint16 faces[36] = {
+        0, 1, 3, 0, 3, 2,  4, 6, 7, 4, 7, 5,
+        0, 4, 5, 0, 5, 1,  2, 3, 7, 2, 7, 6,
+        0, 2, 6, 0, 6, 4,  1, 5, 7, 1, 7, 3};
+    this->indexData.indexCount = 36;
+    this->indexData.indexBuffer =
+        Ogre::HardwareBufferManager::getSingleton().createIndexBuffer(
+        Ogre::HardwareIndexBuffer::IT_16BIT, 36,
+        Ogre::HardwareBuffer::HBU_STATIC_WRITE_ONLY);
+    this->indexData.indexBuffer->writeData(0, sizeof(faces), faces, true);
+  }
+
+  /// \brief Fit the box to a bounding box.
+  /// \param[in] _box The bounding box, finite.
+  public: void SetBox(const Ogre::AxisAlignedBox &_box)
+  {
+    this->transform.makeTransform(_box.getCenter(), _box.getSize(),
+        Ogre::Quaternion::IDENTITY);
+  }
+
+  // Documentation inherited
+  public: virtual const Ogre::MaterialPtr &getMaterial() const
+  {
+    return this->material;
+  }
+
+  // Documentation inherited
+  public: virtual void getRenderOperation(Ogre::RenderOperation &_op)
+  {
+    _op.operationType = Ogre::RenderOperation::OT_TRIANGLE_LIST;
+    _op.vertexData = &this->vertexData;
+    _op.indexData = &this->indexData;
+    _op.useIndexes = true;
+  }
+
+  // Documentation inherited
+  public: virtual void getWorldTransforms(Ogre::Matrix4 *_xform) const
+  {
+    *_xform = this->transform;
+  }
+
+  // Documentation inherited
+  public: virtual Ogre::Real getSquaredViewDepth(
+              const Ogre::Camera *_cam) const
+  {
+    return (this->transform.getTrans() -
+        _cam->getDerivedPosition()).squaredLength();
+  }
+
+  // Documentation inherited
+  public: virtual const Ogre::LightList &getLights() const
+  {
+    return this->lights;
+  }
+
+  /// \brief Material the box is drawn with.
+  private: Ogre::MaterialPtr material;
+
+  /// \brief Vertices of the unit cube.
+  private: Ogre::VertexData vertexData;
+
+  /// \brief Triangles of the unit cube.
+  private: Ogre::IndexData indexData;
+
+  /// \brief Transform from the unit cube to the bounding box.
+  private: Ogre::Matrix4 transform = Ogre::Matrix4::IDENTITY;
+
+  /// \brief No lights, the box is not shaded.
+  private: Ogre::LightList lights;
+};
+
+//////////////////////////////////////////////////
+OcclusionCulling::OcclusionCulling(Ogre::SceneManager *_sceneMgr)
+  : sceneMgr(_sceneMgr)
+{
+  Ogre::MaterialPtr material =
+      Ogre::MaterialManager::getSingleton().getByName(kQueryMaterial);
+  if (material.isNull())
+  {
+    material = Ogre::MaterialManager::getSingleton().create(kQueryMaterial,
+        Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+    Ogre::Pass *pass = material->getTechnique(0)->getPass(0);
+    pass->setDepthCheckEnabled(true);
+    pass->setDepthWriteEnabled(false);
+    pass->setColourWriteEnabled(false);
+    pass->setCullingMode(Ogre::CULL_NONE);
+    pass->setLightingEnabled(false);
+    material->load();
+  }
+  this->queryPass = material->getTechnique(0)->getPass(0);
+  this->box.reset(new QueryBox(material));
+
+  this->sceneMgr->addRenderQueueListener(this);
+}
+
+//////////////////////////////////////////////////
+OcclusionCulling::~OcclusionCulling()
+{
+  this->sceneMgr->removeRenderQueueListener(this);
+  this->ClearOwners();
+
+  Ogre::RenderSystem *renderSys = this->sceneMgr->getDestinationRenderSystem();
+  for (auto &camera : this->queries)
+  {
+    for (auto &candidate : camera.second)
+    {
+      if (candidate.second.query)
+        renderSys->destroyHardwareOcclusionQuery(candidate.second.query);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+bool OcclusionCulling::Enabled()
+{
+  const char *env = std::getenv("GAZEBO_OCCLUSION_CULLING");
+  if (!env || std::string(env) == "0")
+    return false;
+
+  Ogre::RenderSystem *renderSys = Ogre::Root::getSingleton().getRenderSystem();
+  return renderSys && renderSys->getCapabilities() &&
+      renderSys->getCapabilities()->hasCapability(Ogre::RSC_HWOCCLUSION);
+}
+
+//////////////////////////////////////////////////
+void OcclusionCulling::Update(const VisualPtr &_worldVisual,
+    const std::vector<Ogre::Camera *> &_cameras)
+{
+  // Links of the models, nested models included
+  std::set<Ogre::SceneNode *> nodes;
+  std::vector<VisualPtr> models;
+  if (_worldVisual)
+    models.push_back(_worldVisual);
+  while (!models.empty())
+  {
+    VisualPtr parent = models.back();
+    models.pop_back();
+    for (unsigned int i = 0; i < parent->GetChildCount(); ++i)
+    {
+      VisualPtr child = parent->GetChild(i);
+      if (child->GetType() == Visual::VT_MODEL)
+        models.push_back(child);
+      else if (child->GetType() == Visual::VT_LINK && child->GetSceneNode())
+        nodes.insert(child->GetSceneNode());
+    }
+  }
+
+  Ogre::RenderSystem *renderSys = this->sceneMgr->getDestinationRenderSystem();
+  std::set<const Ogre::Camera *> cameras(_cameras.begin(), _cameras.end());
+  for (auto camera = this->queries.begin(); camera != this->queries.end();)
+  {
+    bool keepCamera = cameras.count(camera->first) > 0;
+    for (auto candidate = camera->second.begin();
+         candidate != camera->second.end();)
+    {
+      if (keepCamera && nodes.count(candidate->first))
+      {
+        ++candidate;
+        continue;
+      }
+      if (candidate->second.query)
+        renderSys->destroyHardwareOcclusionQuery(candidate->second.query);
+      candidate = camera->second.erase(candidate);
+    }
+
+    if (keepCamera)
+      ++camera;
+    else
+      camera = this->queries.erase(camera);
+  }
+  for (auto const camera : cameras)
+    this->queries[camera];
+
+  if (nodes != this->candidates || ++this->framesSinceOwners >= kOwnersPeriod)
+  {
+    this->candidates.swap(nodes);
+    this->UpdateOwners();
+  }
+}
+
+//////////////////////////////////////////////////
+size_t OcclusionCulling::OccludedCount(const Ogre::Camera *_camera) const
+{
+  auto camera = this->queries.find(_camera);
+  if (camera == this->queries.end())
+    return 0;
+
+  size_t count = 0;
+  for (auto const &candidate : camera->second)
+  {
+    if (candidate.second.occludedFrames >= kOccludedFrames)
+      ++count;
+  }
+  return count;
+}
+
+//////////////////////////////////////////////////
+void OcclusionCulling::renderQueueEnded(Ogre::uint8 _queueGroupId,
+    const Ogre::String &_invocation, bool &/*_repeatThisInvocation*/)
+{
+  // The opaque geometry is in the depth buffer once the main queue is done
+  if (_queueGroupId != Ogre::RENDER_QUEUE_MAIN || !_invocation.empty())
+    return;
+
+  Ogre::Viewport *viewport = this->sceneMgr->getCurrentViewport();
+  if (!viewport || !viewport->getCamera())
+    return;
+
+  Ogre::Camera *camera = viewport->getCamera();
+  auto states = this->queries.find(camera);
+  if (states == this->queries.end())
+    return;
+
+  Ogre::RenderSystem *renderSys = this->sceneMgr->getDestinationRenderSystem();
+  const Ogre::Vector3 eye = camera->getDerivedPosition();
+  for (auto const node : this->candidates)
+  {
+    Query &state = states->second[node];
+
+    const Ogre::AxisAlignedBox &bounds = node->_getWorldAABB();
+    if (!bounds.isFinite() || bounds.contains(eye))
+    {
+      state.occludedFrames = 0;
+      continue;
+    }
+
+    // Frustum culling already skips it
+    if (!camera->isVisible(bounds))
+      continue;
+
+    if (state.issued && !state.query->isStillOutstanding())
+    {
+      unsigned int fragments = 0;
+      state.query->pullOcclusionQuery(&fragments);
+      state.occludedFrames = fragments == 0 ? state.occludedFrames + 1 : 0;
+      state.issued = false;
+    }
+
+    if (state.issued)
+      continue;
+
+    if (!state.query)
+      state.query = renderSys->createHardwareOcclusionQuery();
+
+    this->box->SetBox(bounds);
+    state.query->beginOcclusionQuery();
+    this->sceneMgr->_injectRenderWithPass(this->queryPass, this->box.get(),
+        false);
+    state.query->endOcclusionQuery();
+    state.issued = true;
+  }
+}
+
+//////////////////////////////////////////////////
+bool OcclusionCulling::objectRendering(const Ogre::MovableObject *_object,
+    const Ogre::Camera *_camera)
+{
+  auto camera = this->queries.find(_camera);
+  if (camera == this->queries.end())
+    return true;
+
+  auto owner = this->owners.find(_object);
+  if (owner == this->owners.end())
+    return true;
+
+  auto state = camera->second.find(owner->second);
+  return state == camera->second.end() ||
+      state->second.occludedFrames < kOccludedFrames;
+}
+
+//////////////////////////////////////////////////
+void OcclusionCulling::objectDestroyed(Ogre::MovableObject *_object)
+{
+  this->owners.erase(_object);
+}
+
+//////////////////////////////////////////////////
+void OcclusionCulling::UpdateOwners()
+{
+  this->ClearOwners();
+  for (auto const node : this->candidates)
+    this->AddOwners(node, node);
+  this->framesSinceOwners = 0;
+}
+
+//////////////////////////////////////////////////
+void OcclusionCulling::AddOwners(Ogre::SceneNode *_node,
+    Ogre::SceneNode *_candidate)
+{
+  for (unsigned int i = 0; i < _node->numAttachedObjects(); ++i)
+  {
+    // Leave objects that already have a listener alone, an object only
+    // takes one
+    Ogre::MovableObject *obj = _node->getAttachedObject(i);
+    if (obj->getListener() && obj->getListener() != this)
+      continue;
+
+    obj->setListener(this);
+    this->owners[obj] = _candidate;
+  }
+
+  for (unsigned int i = 0; i < _node->numChildren(); ++i)
+  {
+    Ogre::SceneNode *child =
+        dynamic_cast<Ogre::SceneNode *>(_node->getChild(i));
+    if (child)
+      this->AddOwners(child, _candidate);
+  }
+}
+
+//////////////////////////////////////////////////
+void OcclusionCulling::ClearOwners()
+{
+  for (auto const &owner : this->owners)
+  {
+    Ogre::MovableObject *obj = const_cast<Ogre::MovableObject *>(owner.first);
+    if (obj->getListener() == this)
+      obj->setListener(nullptr);
+  }
+  this->owners.clear();
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GAZEBO_RENDERING_OCCLUSIONCULLING_HH_
+#define GAZEBO_RENDERING_OCCLUSIONCULLING_HH_
+
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "gazebo/rendering/ogre_gazebo.h"
+#include "gazebo/rendering/RenderTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    /// \internal
+    /// \brief Skips visuals hidden behind other geometry, using hardware
+    /// occlusion queries.
+    ///
+    /// The candidates are the links of the models in the scene. After the
+    /// main render queue of a registered camera, the bounding box of every
+    /// candidate in the view frustum is drawn into an occlusion query
+    /// against the depth buffer. A candidate is skipped by that camera once
+    /// its box passed no fragments for a few frames in a row, and drawn
+    /// again as soon as one passes. Results are read a frame later so the
+    /// queries never stall the pipeline, at the cost of a visual showing up
+    /// one frame late when it comes out from behind an occluder.
+    class GZ_RENDERING_VISIBLE OcclusionCulling
+      : public Ogre::RenderQueueListener, public Ogre::MovableObject::Listener
+    {
+      /// \brief Constructor.
+      /// \param[in] _sceneMgr Scene manager of the visuals.
+      public: explicit OcclusionCulling(Ogre::SceneManager *_sceneMgr);
+
+      /// \brief Destructor. Releases every query.
+      public: virtual ~OcclusionCulling();
+
+      /// \brief Check the GAZEBO_OCCLUSION_CULLING environment variable and
+      /// the render system capabilities.
+      /// \return True if visuals should be occlusion culled.
+      public: static bool Enabled();
+
+      /// \brief Refresh the candidates and the cameras to cull for. Call it
+      /// once per frame before rendering.
+      /// \param[in] _worldVisual Root visual of the scene.
+      /// \param[in] _cameras Cameras to cull for.
+      public: void Update(const VisualPtr &_worldVisual,
+                  const std::vector<Ogre::Camera *> &_cameras);
+
+      /// \brief Get the number of candidates a camera currently skips.
+      /// \param[in] _camera The camera.
+      /// \return Number of occluded candidates.
+      public: size_t OccludedCount(const Ogre::Camera *_camera) const;
+
+      // Documentation inherited
+      public: virtual void renderQueueEnded(Ogre::uint8 _queueGroupId,
+                  const Ogre::String &_invocation, bool &_repeatThisInvocation);
+
+      // Documentation inherited
+      public: virtual bool objectRendering(const Ogre::MovableObject *_object,
+                  const Ogre::Camera *_camera);
+
+      // Documentation inherited
+      public: virtual void objectDestroyed(Ogre::MovableObject *_object);
+
+      /// \brief Listen to every movable object below the candidates.
+      private: void UpdateOwners();
+
+      /// \brief Listen to the movable objects below a scene node.
+      /// \param[in] _node The scene node.
+      /// \param[in] _candidate Candidate the node belongs to.
+      private: void AddOwners(Ogre::SceneNode *_node,
+                   Ogre::SceneNode *_candidate);
+
+      /// \brief Stop listening to every movable object.
+      private: void ClearOwners();
+
+      /// \brief Occlusion state of a candidate seen by a camera.
+      private: class Query
+      {
+        /// \brief Hardware query, created on first use.
+        public: Ogre::HardwareOcclusionQuery *query = nullptr;
+
+        /// \brief True while a result is pending.
+        public: bool issued = false;
+
+        /// \brief Number of consecutive results without visible fragments.
+        public: unsigned int occludedFrames = 0;
+      };
+
+      /// \brief Bounding box drawn into the queries.
+      private: class QueryBox;
+
+      /// \brief Scene manager of the visuals.
+      private: Ogre::SceneManager *sceneMgr;
+
+      /// \brief Bounding box drawn into the queries.
+      private: std::unique_ptr<QueryBox> box;
+
+      /// \brief Pass drawing the box without writing color or depth.
+      private: Ogre::Pass *queryPass = nullptr;
+
+      /// \brief Scene nodes of the candidates.
+      private: std::set<Ogre::SceneNode *> candidates;
+
+      /// \brief Candidate of every movable object we listen to.
+      private: std::map<const Ogre::MovableObject *, Ogre::SceneNode *> owners;
+
+      /// \brief Query states by camera and candidate.
+      private: std::map<const Ogre::Camera *,
+                   std::map<Ogre::SceneNode *, Query>> queries;
+
+      /// \brief Frames since the owners were last refreshed.
+      private: unsigned int framesSinceOwners = 0;
+    };
+  }
+}
+#endif
@@ -0,0 +1,259 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+// Buffer object entry points are not exported by the Windows OpenGL
+// library, asynchronous readback is only available elsewhere.
+#if defined(HAVE_OPENGL) && !defined(_WIN32)
+#define GAZEBO_PBO_READBACK
+
+#if defined(__APPLE__)
+#include <OpenGL/gl.h>
+#include <OpenGL/glext.h>
+#else
+#define GL_GLEXT_PROTOTYPES
+#include <GL/gl.h>
+#include <GL/glext.h>
+#endif /* __APPLE__ */
+
+#endif
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "gazebo/rendering/ogre_gazebo.h"
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/rendering/PixelBufferReadback.hh"
+
+using namespace gazebo;
+using namespace rendering;
+
+//////////////////////////////////////////////////
+PixelBufferReadback::PixelBufferReadback()
+{
+}
+
+//////////////////////////////////////////////////
+PixelBufferReadback::~PixelBufferReadback()
+{
+  this->Fini();
+}
+
+//////////////////////////////////////////////////
+unsigned int PixelBufferReadback::BufferCount()
+{
+#ifdef GAZEBO_PBO_READBACK
+  const char *env = std::getenv("GAZEBO_CAMERA_ASYNC_READBACK");
+  if (!env)
+    return 0;
+
+  int count = std::atoi(env);
+  if (count <= 0)
+    return 0;
+
+  Ogre::RenderSystem *renderSys = Ogre::Root::getSingleton().getRenderSystem();
+  if (!renderSys ||
+      renderSys->getName().compare("OpenGL Rendering Subsystem") != 0)
+  {
+    return 0;
+  }
+
+  // A single buffer would wait on the GPU like a plain blit
+  return count < 2 ? 2 : (count > 3 ? 3 : count);
+#else
+  return 0;
+#endif
+}
+
+//////////////////////////////////////////////////
+bool PixelBufferReadback::Init(Ogre::Texture *_texture, const int _format,
+    const unsigned int _width, const unsigned int _height,
+    const unsigned int _count)
+{
+#ifdef GAZEBO_PBO_READBACK
+  if (this->texture == _texture && this->format == _format &&
+      this->width == _width && this->height == _height &&
+      this->buffers.size() == _count)
+  {
+    return true;
+  }
+
+  this->Fini();
+
+  // Formats match the ones Ogre's GL render system uses for the textures
+  switch (static_cast<Ogre::PixelFormat>(_format))
+  {
+    case Ogre::PF_BYTE_RGB:
+      this->glFormat = GL_RGB;
+      this->glType = GL_UNSIGNED_BYTE;
+      break;
+    case Ogre::PF_BYTE_BGR:
+      this->glFormat = GL_BGR;
+      this->glType = GL_UNSIGNED_BYTE;
+      break;
+    case Ogre::PF_L8:
+      this->glFormat = GL_LUMINANCE;
+      this->glType = GL_UNSIGNED_BYTE;
+      break;
+    case Ogre::PF_L16:
+      this->glFormat = GL_LUMINANCE;
+      this->glType = GL_UNSIGNED_SHORT;
+      break;
+    case Ogre::PF_FLOAT32_R:
+      this->glFormat = GL_LUMINANCE;
+      this->glType = GL_FLOAT;
+      break;
+    case Ogre::PF_SHORT_RGB:
+      this->glFormat = GL_RGB;
+      this->glType = GL_UNSIGNED_SHORT;
+      break;
+    default:
+      return false;
+  }
+
+  this->texture = _texture;
+  this->format = _format;
+  this->width = _width;
+  this->height = _height;
+  this->size = Ogre::PixelUtil::getMemorySize(_width, _height, 1,
+      static_cast<Ogre::PixelFormat>(_format));
+
+  this->buffers.resize(_count, 0);
+  this->stamps.resize(_count);
+  glGenBuffers(_count, &this->buffers[0]);
+  for (auto buffer : this->buffers)
+  {
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer);
+    glBufferData(GL_PIXEL_PACK_BUFFER, this->size, nullptr, GL_STREAM_READ);
+  }
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+  return true;
+#else
+  (void)_texture;
+  (void)_format;
+  (void)_width;
+  (void)_height;
+  (void)_count;
+  return false;
+#endif
+}
+
+//////////////////////////////////////////////////
+void PixelBufferReadback::Fini()
+{
+#ifdef GAZEBO_PBO_READBACK
+  if (!this->buffers.empty())
+    glDeleteBuffers(this->buffers.size(), &this->buffers[0]);
+#endif
+  this->buffers.clear();
+  this->stamps.clear();
+  this->head = 0;
+  this->inFlight = 0;
+  this->texture = nullptr;
+  this->size = 0;
+}
+
+//////////////////////////////////////////////////
+void PixelBufferReadback::Request(const common::Time &_stamp)
+{
+#ifdef GAZEBO_PBO_READBACK
+  if (this->buffers.empty())
+    return;
+
+  // Every buffer is in flight: the oldest frame was never read, drop it
+  if (this->inFlight == this->buffers.size())
+  {
+    this->head = (this->head + 1) % this->buffers.size();
+    --this->inFlight;
+  }
+
+  unsigned int index = (this->head + this->inFlight) % this->buffers.size();
+
+  GLuint texId = 0;
+  this->texture->getCustomAttribute("GLID", &texId);
+
+  // Restore the state Ogre expects once the copy is queued
+  GLint prevTex = 0;
+  GLint prevAlignment = 4;
+  glGetIntegerv(GL_TEXTURE_BINDING_2D, &prevTex);
+  glGetIntegerv(GL_PACK_ALIGNMENT, &prevAlignment);
+
+  glPixelStorei(GL_PACK_ALIGNMENT, 1);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, this->buffers[index]);
+  glBindTexture(GL_TEXTURE_2D, texId);
+
+  // With a pack buffer bound this only queues the copy
+  glGetTexImage(GL_TEXTURE_2D, 0, this->glFormat, this->glType, nullptr);
+
+  glBindTexture(GL_TEXTURE_2D, prevTex);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  glPixelStorei(GL_PACK_ALIGNMENT, prevAlignment);
+
+  this->stamps[index] = _stamp;
+  ++this->inFlight;
+#else
+  (void)_stamp;
+#endif
+}
+
+//////////////////////////////////////////////////
+bool PixelBufferReadback::Ready() const
+{
+  return !this->buffers.empty() && this->inFlight == this->buffers.size();
+}
+
+//////////////////////////////////////////////////
+bool PixelBufferReadback::Read(void *_dst, common::Time &_stamp)
+{
+#ifdef GAZEBO_PBO_READBACK
+  if (!this->Ready())
+    return false;
+
+  unsigned int index = this->head;
+  this->head = (this->head + 1) % this->buffers.size();
+  --this->inFlight;
+
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, this->buffers[index]);
+  const void *data = glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+  bool result = data != nullptr;
+  if (result)
+  {
+    memcpy(_dst, data, this->size);
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    _stamp = this->stamps[index];
+  }
+  else
+  {
+    gzerr << "Unable to map pixel buffer for readback\n";
+  }
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+  return result;
+#else
+  (void)_dst;
+  (void)_stamp;
+  return false;
+#endif
+}
+
+//////////////////////////////////////////////////
+size_t PixelBufferReadback::Size() const
+{
+  return this->size;
+}
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef _GAZEBO_RENDERING_PIXELBUFFERREADBACK_HH_
+#define _GAZEBO_RENDERING_PIXELBUFFERREADBACK_HH_
+
+#include <cstddef>
+#include <vector>
+
+#include "gazebo/common/Time.hh"
+
+namespace Ogre
+{
+  class Texture;
+}
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    /// \internal
+    /// \brief Reads a render texture back through a ring of OpenGL pixel
+    /// buffer objects.
+    ///
+    /// Request() starts copying the texture into the next buffer without
+    /// waiting for the GPU. Read() maps the oldest buffer once the ring is
+    /// full, so the data returned lags the latest request by
+    /// (buffer count - 1) frames. Each frame carries the time passed to
+    /// the Request() that produced it.
+    class PixelBufferReadback
+    {
+      /// \brief Constructor.
+      public: PixelBufferReadback();
+
+      /// \brief Destructor. Releases the buffers.
+      public: ~PixelBufferReadback();
+
+      /// \brief Number of buffers to use, from the
+      /// GAZEBO_CAMERA_ASYNC_READBACK environment variable (2 or 3).
+      /// \return 0 if asynchronous readback is disabled, not compiled in,
+      /// or the render system is not OpenGL.
+      public: static unsigned int BufferCount();
+
+      /// \brief Set up the buffers for a texture. Does nothing if already
+      /// set up for the same texture, size and format.
+      /// \param[in] _texture Texture to read back.
+      /// \param[in] _format Ogre::PixelFormat of the data to read.
+      /// \param[in] _width Width of the texture.
+      /// \param[in] _height Height of the texture.
+      /// \param[in] _count Number of buffers in the ring.
+      /// \return False if the format can not be read asynchronously.
+      public: bool Init(Ogre::Texture *_texture, const int _format,
+                  const unsigned int _width, const unsigned int _height,
+                  const unsigned int _count);
+
+      /// \brief Release the buffers and drop frames in flight.
+      public: void Fini();
+
+      /// \brief Start reading the current content of the texture.
+      /// \param[in] _stamp Time the content was rendered at.
+      public: void Request(const common::Time &_stamp);
+
+      /// \brief Check if Read() would return a frame.
+      /// \return True if the ring is full.
+      public: bool Ready() const;
+
+      /// \brief Copy the oldest frame in flight to memory.
+      /// \param[out] _dst Memory of at least Size() bytes.
+      /// \param[out] _stamp Time passed to the matching Request().
+      /// \return False if no frame is ready or mapping failed.
+      public: bool Read(void *_dst, common::Time &_stamp);
+
+      /// \brief Size of one frame in bytes.
+      /// \return Number of bytes copied by Read().
+      public: size_t Size() const;
+
+      /// \brief Buffer object names.
+      private: std::vector<unsigned int> buffers;
+
+      /// \brief Time of the frame in each buffer.
+      private: std::vector<common::Time> stamps;
+
+      /// \brief Index of the oldest buffer in flight.
+      private: unsigned int head = 0;
+
+      /// \brief Number of buffers in flight.
+      private: unsigned int inFlight = 0;
+
+      /// \brief Texture being read.
+      private: Ogre::Texture *texture = nullptr;
+
+      /// \brief Ogre::PixelFormat of the data read.
+      private: int format = 0;
+
+      /// \brief OpenGL format matching the pixel format.
+      private: unsigned int glFormat = 0;
+
+      /// \brief OpenGL type matching the pixel format.
+      private: unsigned int glType = 0;
+
+      /// \brief Width of the texture.
+      private: unsigned int width = 0;
+
+      /// \brief Height of the texture.
+      private: unsigned int height = 0;
+
+      /// \brief Size of one frame in bytes.
+      private: size_t size = 0;
+    };
+  }
+}
+#endif
@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include "gazebo/rendering/PoseInterpolator.hh"
+
+using namespace gazebo;
+using namespace rendering;
+
+/// \brief Fraction of the playback error corrected on each update.
+static const double kCorrectionGain = 0.1;
+
+/// \brief Playback jumps straight to its target past this error, in
+/// seconds.
+static const double kMaxPlaybackError = 1.0;
+
+//////////////////////////////////////////////////
+PoseInterpolator::PoseInterpolator(const common::Time &_delay)
+  : delay(_delay)
+{
+}
+
+//////////////////////////////////////////////////
+common::Time PoseInterpolator::Delay() const
+{
+  return this->delay;
+}
+
+//////////////////////////////////////////////////
+void PoseInterpolator::AddBatch(const common::Time &_simTime,
+    const common::Time &_wallTime)
+{
+  if (this->hasBatch && _simTime < this->latestTime)
+    this->Clear();
+
+  if (this->hasBatch && _simTime > this->latestTime &&
+      _wallTime > this->latestWallTime)
+  {
+    double rateNow = (_simTime - this->latestTime).Double() /
+        (_wallTime - this->latestWallTime).Double();
+    this->rate += kCorrectionGain * (std::min(rateNow, 100.0) - this->rate);
+  }
+
+  if (!this->hasBatch || _simTime > this->latestTime)
+  {
+    this->previousTime = this->hasBatch ? this->latestTime : _simTime;
+    this->latestTime = _simTime;
+    this->latestWallTime = _wallTime;
+  }
+  this->hasBatch = true;
+}
+
+//////////////////////////////////////////////////
+void PoseInterpolator::AddPose(const uint32_t _id,
+    const ignition::math::Pose3d &_pose)
+{
+  Track &track = this->tracks[_id];
+
+  if (!track.active)
+  {
+    // The entity was still up to the previous batch, which it was not in
+    if (!track.samples.empty())
+    {
+      Sample last = track.samples.back();
+      last.time = std::max(last.time, this->previousTime);
+      track.samples.clear();
+      track.samples.push_back(last);
+    }
+    track.active = true;
+    this->active.push_back(_id);
+  }
+
+  if (!track.samples.empty() && track.samples.back().time >= this->latestTime)
+  {
+    track.samples.back().pose = _pose;
+    return;
+  }
+
+  Sample sample;
+  sample.time = this->latestTime;
+  sample.pose = _pose;
+  track.samples.push_back(sample);
+
+  if (track.samples.size() > kMaxSamples)
+    track.samples.pop_front();
+}
+
+//////////////////////////////////////////////////
+common::Time PoseInterpolator::Update(const common::Time &_wallTime,
+    std::vector<std::pair<uint32_t, ignition::math::Pose3d>> &_poses)
+{
+  if (!this->hasBatch)
+    return common::Time::Zero;
+
+  common::Time target = this->latestTime - this->delay;
+  if (!this->playing)
+  {
+    this->playbackTime = target;
+    this->playing = true;
+  }
+  else
+  {
+    double dt = std::max(0.0, (_wallTime - this->updateWallTime).Double());
+    double next = this->playbackTime.Double() + dt * this->rate;
+    double error = target.Double() - next;
+    if (std::abs(error) > kMaxPlaybackError)
+      next = target.Double();
+    else
+      next += kCorrectionGain * error;
+
+    // Never go back in time, nor past the latest sample
+    next = std::min(next, this->latestTime.Double());
+    if (next > this->playbackTime.Double())
+      this->playbackTime = common::Time(next);
+  }
+  this->updateWallTime = _wallTime;
+
+  const common::Time &now = this->playbackTime;
+  for (const uint32_t id : this->active)
+  {
+    Track &track = this->tracks[id];
+    std::deque<Sample> &samples = track.samples;
+    while (samples.size() > 1 && samples[1].time <= now)
+      samples.pop_front();
+
+    if (samples.size() == 1 || samples[0].time >= now)
+    {
+      _poses.push_back(std::make_pair(id, samples[0].pose));
+      if (samples.size() == 1)
+        track.active = false;
+      continue;
+    }
+
+    const Sample &a = samples[0];
+    const Sample &b = samples[1];
+    double t = (now - a.time).Double() / (b.time - a.time).Double();
+
+    ignition::math::Pose3d pose;
+    pose.Pos() = a.pose.Pos() + (b.pose.Pos() - a.pose.Pos()) * t;
+    pose.Rot() = ignition::math::Quaterniond::Slerp(t, a.pose.Rot(),
+        b.pose.Rot(), true);
+    _poses.push_back(std::make_pair(id, pose));
+  }
+
+  this->active.erase(std::remove_if(this->active.begin(), this->active.end(),
+      [this](const uint32_t _id) { return !this->tracks[_id].active; }),
+      this->active.end());
+
+  return now;
+}
+
+//////////////////////////////////////////////////
+void PoseInterpolator::Clear()
+{
+  this->tracks.clear();
+  this->active.clear();
+  this->rate = 1.0;
+  this->hasBatch = false;
+  this->playing = false;
+}
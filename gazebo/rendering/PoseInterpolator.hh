@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GAZEBO_RENDERING_POSEINTERPOLATOR_HH_
+#define GAZEBO_RENDERING_POSEINTERPOLATOR_HH_
+
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <ignition/math/Pose3.hh>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    /// \internal
+    /// \brief Plays back timestamped poses a fixed delay behind the latest
+    /// simulation time received, interpolating between samples.
+    ///
+    /// Playback advances with the wall clock, scaled by the rate at which
+    /// simulation time arrives, and is nudged towards the latest time minus
+    /// the delay. This keeps motion smooth when poses arrive at a lower or
+    /// irregular rate compared to the rendering. Playback never goes past
+    /// the latest sample, so poses are held rather than extrapolated.
+    class GZ_RENDERING_VISIBLE PoseInterpolator
+    {
+      /// \brief Constructor.
+      /// \param[in] _delay Time playback stays behind the latest sample.
+      public: explicit PoseInterpolator(const common::Time &_delay);
+
+      /// \brief Get the playback delay.
+      /// \return Time playback stays behind the latest sample.
+      public: common::Time Delay() const;
+
+      /// \brief Start a batch of poses.
+      /// \param[in] _simTime Simulation time of the poses in the batch.
+      /// Going back in time drops every sample.
+      /// \param[in] _wallTime Wall time the batch was received.
+      public: void AddBatch(const common::Time &_simTime,
+                  const common::Time &_wallTime);
+
+      /// \brief Add a pose to the current batch.
+      /// \param[in] _id Id of the entity.
+      /// \param[in] _pose Pose of the entity at the batch time.
+      public: void AddPose(const uint32_t _id,
+                  const ignition::math::Pose3d &_pose);
+
+      /// \brief Advance playback and get the poses that changed.
+      /// \param[in] _wallTime Current wall time.
+      /// \param[out] _poses Id and pose of each entity that moved.
+      /// \return Simulation time of the poses.
+      public: common::Time Update(const common::Time &_wallTime,
+                  std::vector<std::pair<uint32_t, ignition::math::Pose3d>>
+                  &_poses);
+
+      /// \brief Drop every sample and restart playback.
+      public: void Clear();
+
+      /// \brief A pose at a simulation time.
+      private: class Sample
+      {
+        /// \brief Simulation time.
+        public: common::Time time;
+
+        /// \brief Pose at that time.
+        public: ignition::math::Pose3d pose;
+      };
+
+      /// \brief Samples of one entity.
+      private: class Track
+      {
+        /// \brief Samples in time order, the first one at or before
+        /// playback time once playback has reached it.
+        public: std::deque<Sample> samples;
+
+        /// \brief True while the entity is in the active list.
+        public: bool active = false;
+      };
+
+      /// \brief Most samples kept per entity.
+      private: static const size_t kMaxSamples = 64;
+
+      /// \brief Time playback stays behind the latest sample.
+      private: common::Time delay;
+
+      /// \brief Samples indexed by entity id.
+      private: std::unordered_map<uint32_t, Track> tracks;
+
+      /// \brief Ids of the entities that have samples left to play.
+      private: std::vector<uint32_t> active;
+
+      /// \brief Simulation time of the latest batch.
+      private: common::Time latestTime;
+
+      /// \brief Simulation time of the batch before the latest one.
+      private: common::Time previousTime;
+
+      /// \brief Wall time the latest batch was received.
+      private: common::Time latestWallTime;
+
+      /// \brief Wall time of the last update.
+      private: common::Time updateWallTime;
+
+      /// \brief Current playback time.
+      private: common::Time playbackTime;
+
+      /// \brief Simulation seconds per wall clock second, smoothed.
+      private: double rate = 1.0;
+
+      /// \brief True once a batch was added.
+      private: bool hasBatch = false;
+
+      /// \brief True once playback time was set.
+      private: bool playing = false;
+    };
+  }
+}
+#endif
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "gazebo/rendering/PoseInterpolator.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class PoseInterpolator_TEST : public gazebo::testing::AutoLogFixture { };
+
+typedef std::vector<std::pair<uint32_t, ignition::math::Pose3d>> Poses_V;
+
+/////////////////////////////////////////////////
+TEST_F(PoseInterpolator_TEST, Interpolate)
+{
+  rendering::PoseInterpolator interpolator(common::Time(0.1));
+  EXPECT_EQ(interpolator.Delay(), common::Time(0.1));
+
+  Poses_V poses;
+  EXPECT_EQ(interpolator.Update(common::Time(0.0), poses), common::Time::Zero);
+  EXPECT_TRUE(poses.empty());
+
+  // The first pose of an entity is shown straight away
+  interpolator.AddBatch(common::Time(1.0), common::Time(0.0));
+  interpolator.AddPose(3, ignition::math::Pose3d(0, 0, 0, 0, 0, 0));
+  EXPECT_EQ(interpolator.Update(common::Time(0.0), poses),
+      common::Time(0.9));
+  ASSERT_EQ(poses.size(), 1u);
+  EXPECT_EQ(poses[0].first, 3u);
+  EXPECT_EQ(poses[0].second, ignition::math::Pose3d::Zero);
+
+  // Nothing moves without new poses
+  poses.clear();
+  interpolator.Update(common::Time(0.05), poses);
+  EXPECT_TRUE(poses.empty());
+
+  interpolator.AddBatch(common::Time(1.1), common::Time(0.1));
+  interpolator.AddPose(3, ignition::math::Pose3d(1, 0, 0, 0, 0, 0));
+  interpolator.AddBatch(common::Time(1.2), common::Time(0.2));
+  interpolator.AddPose(3, ignition::math::Pose3d(2, 0, 0, 0, 0, 0));
+
+  // Playback moves between the samples, a delay behind the latest one
+  common::Time time = interpolator.Update(common::Time(0.2), poses);
+  EXPECT_GT(time, common::Time(1.0));
+  EXPECT_LT(time, common::Time(1.2));
+  ASSERT_EQ(poses.size(), 1u);
+  EXPECT_NEAR(poses[0].second.Pos().X(), (time.Double() - 1.0) * 10.0,
+      1e-6);
+  EXPECT_GT(poses[0].second.Pos().X(), 0.0);
+  EXPECT_LT(poses[0].second.Pos().X(), 2.0);
+
+  // Playback stops at the latest sample
+  for (int i = 0; i < 100; ++i)
+  {
+    poses.clear();
+    time = interpolator.Update(common::Time(0.3 + i * 0.1), poses);
+  }
+  EXPECT_EQ(time, common::Time(1.2));
+  EXPECT_TRUE(poses.empty());
+}
+
+/////////////////////////////////////////////////
+TEST_F(PoseInterpolator_TEST, Reset)
+{
+  rendering::PoseInterpolator interpolator(common::Time(0.1));
+
+  Poses_V poses;
+  interpolator.AddBatch(common::Time(5.0), common::Time(0.0));
+  interpolator.AddPose(1, ignition::math::Pose3d(5, 0, 0, 0, 0, 0));
+  interpolator.Update(common::Time(0.0), poses);
+
+  // Going back in time shows the new poses straight away
+  poses.clear();
+  interpolator.AddBatch(common::Time(0.0), common::Time(0.1));
+  interpolator.AddPose(1, ignition::math::Pose3d(0, 0, 0, 0, 0, 0));
+  EXPECT_EQ(interpolator.Update(common::Time(0.1), poses),
+      common::Time(-0.1));
+  ASSERT_EQ(poses.size(), 1u);
+  EXPECT_EQ(poses[0].second, ignition::math::Pose3d::Zero);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
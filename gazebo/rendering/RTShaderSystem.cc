@@ -44,6 +44,7 @@
 #include "gazebo/rendering/Light.hh"
 #include "gazebo/rendering/RenderEngine.hh"
 #include "gazebo/rendering/Scene.hh"
+#include "gazebo/rendering/ShadowMapCache.hh"
 #include "gazebo/rendering/Visual.hh"
 #include "gazebo/rendering/RTShaderSystemPrivate.hh"
 #include "gazebo/rendering/RTShaderSystem.hh"
@@ -157,6 +158,7 @@ void RTShaderSystem::Fini()
   }
 
   this->dataPtr->pssmSetup.setNull();
+  this->dataPtr->shadowCaches.clear();
   this->dataPtr->scenes.clear();
   this->dataPtr->shadowsApplied = false;
   this->dataPtr->initialized = false;
@@ -195,6 +197,7 @@ void RTShaderSystem::RemoveScene(ScenePtr _scene)
 
   if (iter != this->dataPtr->scenes.end())
   {
+    this->dataPtr->shadowCaches.erase(_scene->Name());
     this->dataPtr->scenes.erase(iter);
     this->dataPtr->shaderGenerator->invalidateScheme(_scene->Name() +
         Ogre::RTShader::ShaderGenerator::DEFAULT_SCHEME_NAME);
@@ -384,6 +387,16 @@ void RTShaderSystem::GenerateShaders(const VisualPtr &_vis)
   }
 }
 
+//////////////////////////////////////////////////
+void RTShaderSystem::RemoveShaders(const std::string &_materialName)
+{
+  if (!this->dataPtr->initialized)
+    return;
+
+  this->dataPtr->shaderGenerator->removeAllShaderBasedTechniques(
+      _materialName);
+}
+
 //////////////////////////////////////////////////
 bool RTShaderSystem::GetPaths(std::string &coreLibsPath, std::string &cachePath)
 {
@@ -492,6 +505,8 @@ void RTShaderSystem::RemoveShadows(ScenePtr _scene)
   if (!this->dataPtr->initialized || !this->dataPtr->shadowsApplied)
     return;
 
+  this->dataPtr->shadowCaches.erase(_scene->Name());
+
   _scene->OgreSceneManager()->setShadowTechnique(Ogre::SHADOWTYPE_NONE);
   _scene->OgreSceneManager()->setShadowCameraSetup(
       Ogre::ShadowCameraSetupPtr());
@@ -576,6 +591,12 @@ void RTShaderSystem::ApplyShadows(ScenePtr _scene)
 
   this->UpdateShaders();
 
+  if (ShadowMapCache::Enabled())
+  {
+    this->dataPtr->shadowCaches[_scene->Name()].reset(
+        new ShadowMapCache(sceneMgr));
+  }
+
   this->dataPtr->shadowsApplied = true;
 }
 
@@ -114,6 +114,11 @@ namespace gazebo
       /// \param[in] _vis The visual to generate shaders for.
       public: void GenerateShaders(const VisualPtr &_vis);
 
+      /// \brief Remove the shaders generated for a material, before the
+      /// material is removed.
+      /// \param[in] _materialName Name of the material.
+      public: void RemoveShaders(const std::string &_materialName);
+
       /// \brief Apply shadows to a scene.
       /// \param[in] _scene The scene to receive shadows.
       public: void ApplyShadows(ScenePtr _scene);
@@ -18,11 +18,14 @@
 #ifndef _GAZEBO_RTSHADERSYSTEM_PRIVATE_HH_
 #define _GAZEBO_RTSHADERSYSTEM_PRIVATE_HH_
 
+#include <map>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
 
 #include "gazebo/rendering/CustomPSSMShadowCameraSetup.hh"
+#include "gazebo/rendering/ShadowMapCache.hh"
 
 #include "gazebo/rendering/ogre_gazebo.h"
 #include "gazebo/gazebo_config.h"
@@ -84,6 +87,11 @@ namespace gazebo
       /// \brief Flag to indicate if normal map should be enabled
       public: bool enableNormalMap = true;
 
+      /// \brief Shadow texture caches by scene name, only used if
+      /// ShadowMapCache::Enabled().
+      public: std::map<std::string, std::unique_ptr<ShadowMapCache>>
+          shadowCaches;
+
       /// \brief Mutex to protect shaders and shadows update
       public: std::mutex updateMutex;
     };
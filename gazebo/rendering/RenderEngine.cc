@@ -41,6 +41,8 @@
 #include "gazebo/common/Events.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Console.hh"
+#include "gazebo/common/MemoryAccount.hh"
+#include "gazebo/common/StartupTrace.hh"
 #include "gazebo/common/SystemPaths.hh"
 
 #include "gazebo/rendering/ogre_gazebo.h"
@@ -53,6 +55,13 @@
 #include "gazebo/rendering/RenderEngine.hh"
 #include "gazebo/rendering/RenderEnginePrivate.hh"
 
+// Ogre built with headless EGL support creates its own context on a GPU
+// device through a pbuffer, without any window system
+#if defined(OGRE_GLSUPPORT_USE_EGL_HEADLESS) && \
+    not defined(__APPLE__) && not defined(_WIN32)
+# define GAZEBO_EGL_HEADLESS
+#endif
+
 using namespace gazebo;
 using namespace rendering;
 
@@ -84,6 +93,8 @@ RenderEngine::~RenderEngine()
 //////////////////////////////////////////////////
 void RenderEngine::Load()
 {
+  common::StartupTraceScope trace("RenderEngine::Load", "rendering");
+
   if (!this->CreateContext())
   {
     gzwarn << "Unable to create X window. Rendering will be disabled\n";
@@ -144,8 +155,13 @@ void RenderEngine::Load()
   // testing, this is a hard requirement by Apple. We also need it to
   // properly initialize GLWidget and UserCameras. See the GLWidget
   // constructor.
+#ifdef GAZEBO_EGL_HEADLESS
+  // Backed by a pbuffer, there is no native window to parent it to
+  this->dataPtr->windowManager->CreateWindow("", 1, 1);
+#else
   this->dataPtr->windowManager->CreateWindow(
       std::to_string(this->dummyWindowId), 1, 1);
+#endif
 
   this->CheckSystemCapabilities();
 }
@@ -295,6 +311,8 @@ void RenderEngine::Init()
     return;
   }
 
+  common::StartupTraceScope trace("RenderEngine::Init", "rendering");
+
   this->dataPtr->initialized = false;
 
   Ogre::ColourValue ambient;
@@ -318,6 +336,30 @@ void RenderEngine::Init()
   for (unsigned int i = 0; i < this->dataPtr->scenes.size(); i++)
     this->dataPtr->scenes[i]->Init();
 
+  // Ogre counts the memory of the loaded resources per resource manager
+  common::MemoryAccount::Get("rendering/textures")->SetSource([]()
+  {
+    return static_cast<int64_t>(
+        Ogre::TextureManager::getSingleton().getMemoryUsage());
+  });
+  common::MemoryAccount::Get("rendering/meshes")->SetSource([]()
+  {
+    return static_cast<int64_t>(
+        Ogre::MeshManager::getSingleton().getMemoryUsage() +
+        Ogre::SkeletonManager::getSingleton().getMemoryUsage());
+  });
+  common::MemoryAccount::Get("rendering/materials")->SetSource([]()
+  {
+    return static_cast<int64_t>(
+        Ogre::MaterialManager::getSingleton().getMemoryUsage());
+  });
+  common::MemoryAccount::Get("rendering/gpu_programs")->SetSource([]()
+  {
+    return static_cast<int64_t>(
+        Ogre::GpuProgramManager::getSingleton().getMemoryUsage() +
+        Ogre::HighLevelGpuProgramManager::getSingleton().getMemoryUsage());
+  });
+
   this->dataPtr->initialized = true;
 }
 
@@ -334,6 +376,12 @@ void RenderEngine::Fini()
 
   this->dataPtr->connections.clear();
 
+  for (auto const &name : {"rendering/textures", "rendering/meshes",
+      "rendering/materials", "rendering/gpu_programs"})
+  {
+    common::MemoryAccount::Get(name)->SetSource(nullptr);
+  }
+
   RTShaderSystem::Instance()->Fini();
 
   // Deallocate memory for every scene
@@ -740,6 +788,11 @@ bool RenderEngine::CreateContext()
 
 #if defined __APPLE__ || _WIN32
   this->dummyDisplay = 0;
+#elif defined(GAZEBO_EGL_HEADLESS)
+  // Ogre sets up its EGL context when the render system is initialized,
+  // sensors render into textures without an X server
+  this->dummyDisplay = 0;
+  gzmsg << "Rendering through headless EGL\n";
 #else
   try
   {
@@ -0,0 +1,230 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "gazebo/rendering/ogre_gazebo.h"
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/MeshManager.hh"
+
+#include "gazebo/rendering/RTShaderSystem.hh"
+#include "gazebo/rendering/ResourceCollector.hh"
+
+using namespace gazebo;
+using namespace rendering;
+
+namespace
+{
+  /// \brief Clock of the release times.
+  using Clock = std::chrono::steady_clock;
+
+  /// \brief References of one kind of resource.
+  struct References
+  {
+    /// \brief Number of references by resource name.
+    std::map<std::string, unsigned int> counts;
+
+    /// \brief When the last reference to a resource was dropped, for the
+    /// resources that may be removed.
+    std::map<std::string, Clock::time_point> released;
+  };
+
+  /// \brief Protects the references, which are added from any thread.
+  std::mutex referencesMutex;
+
+  /// \brief References to Ogre meshes.
+  References meshReferences;
+
+  /// \brief References to Ogre materials.
+  References materialReferences;
+
+  /// \brief Time of the last collection.
+  Clock::time_point lastCollect;
+
+  /// \brief Add a reference.
+  /// \param[in] _name Name of the resource.
+  /// \param[in,out] _references References of the resource kind.
+  void Acquire(const std::string &_name, References &_references)
+  {
+    std::lock_guard<std::mutex> lock(referencesMutex);
+    ++_references.counts[_name];
+    _references.released.erase(_name);
+  }
+
+  /// \brief Drop a reference.
+  /// \param[in] _name Name of the resource.
+  /// \param[in] _removable True if the resource may be removed.
+  /// \param[in,out] _references References of the resource kind.
+  void Release(const std::string &_name, const bool _removable,
+      References &_references)
+  {
+    std::lock_guard<std::mutex> lock(referencesMutex);
+    auto iter = _references.counts.find(_name);
+    if (iter == _references.counts.end() || --iter->second > 0)
+      return;
+
+    _references.counts.erase(iter);
+    if (_removable)
+      _references.released[_name] = Clock::now();
+  }
+
+  /// \brief Take the resources whose references expired.
+  /// \param[in] _all True to take all unreferenced resources.
+  /// \param[in] _now Current time.
+  /// \param[in] _retained Retention time.
+  /// \param[in,out] _references References of the resource kind.
+  /// \return Names of the resources to remove.
+  std::vector<std::string> Expired(const bool _all,
+      const Clock::time_point &_now, const Clock::duration &_retained,
+      References &_references)
+  {
+    std::vector<std::string> names;
+    for (auto iter = _references.released.begin();
+         iter != _references.released.end();)
+    {
+      if (_all || _now - iter->second >= _retained)
+      {
+        names.push_back(iter->first);
+        iter = _references.released.erase(iter);
+      }
+      else
+        ++iter;
+    }
+    return names;
+  }
+
+  /// \brief Check if an Ogre resource is used by something other than the
+  /// resource system, such as an entity.
+  /// \param[in] _resource The resource, including the caller's reference.
+  /// \return True if the resource is in use.
+  template<typename T>
+  bool InUse(const T &_resource)
+  {
+#if OGRE_VERSION_MAJOR == 1 && OGRE_VERSION_MINOR >= 11
+    const auto count = _resource.use_count();
+#else
+    const auto count = _resource.useCount();
+#endif
+    return count > static_cast<decltype(count)>(
+        Ogre::ResourceGroupManager::RESOURCE_SYSTEM_NUM_REFERENCE_COUNTS + 1);
+  }
+}
+
+//////////////////////////////////////////////////
+void ResourceCollector::AcquireMesh(const std::string &_meshName,
+    const std::string &_subMesh)
+{
+  // The common mesh has to stay while the Ogre mesh may be built from it
+  common::MeshManager::Instance()->AddReference(_meshName);
+  Acquire(_subMesh.empty() ? _meshName : _meshName + "::" + _subMesh,
+      meshReferences);
+}
+
+//////////////////////////////////////////////////
+void ResourceCollector::ReleaseMesh(const std::string &_meshName,
+    const std::string &_subMesh)
+{
+  // Generated meshes can't be built again once removed
+  common::MeshManager *meshManager = common::MeshManager::Instance();
+  Release(_subMesh.empty() ? _meshName : _meshName + "::" + _subMesh,
+      meshManager->IsReloadable(_meshName), meshReferences);
+  meshManager->RemoveReference(_meshName);
+}
+
+//////////////////////////////////////////////////
+void ResourceCollector::AcquireMaterial(const std::string &_name)
+{
+  Acquire(_name, materialReferences);
+}
+
+//////////////////////////////////////////////////
+void ResourceCollector::ReleaseMaterial(const std::string &_name)
+{
+  Release(_name, true, materialReferences);
+}
+
+//////////////////////////////////////////////////
+unsigned int ResourceCollector::Collect(const bool _all)
+{
+  const double retention = common::MeshManager::Instance()->Retention();
+  if (!_all && retention < 0)
+    return 0;
+
+  const Clock::time_point now = Clock::now();
+  std::vector<std::string> meshes;
+  std::vector<std::string> materials;
+  {
+    std::lock_guard<std::mutex> lock(referencesMutex);
+    if (!_all && now - lastCollect < std::chrono::seconds(1))
+      return 0;
+    lastCollect = now;
+
+    const auto retained = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(std::max(0.0, retention)));
+    meshes = Expired(_all, now, retained, meshReferences);
+    materials = Expired(_all, now, retained, materialReferences);
+  }
+
+  // Resources still used by an entity that doesn't reference them, such
+  // as a visual of another scene, are left alone
+  unsigned int count = 0;
+  for (auto const &name : meshes)
+  {
+    Ogre::MeshPtr mesh = Ogre::MeshManager::getSingleton().getByName(name);
+    if (mesh.isNull() || InUse(mesh))
+      continue;
+
+    const std::string skeleton = mesh->getSkeletonName();
+    mesh.setNull();
+    Ogre::MeshManager::getSingleton().remove(name);
+    if (!skeleton.empty() &&
+        Ogre::SkeletonManager::getSingleton().resourceExists(skeleton))
+    {
+      Ogre::SkeletonManager::getSingleton().remove(skeleton);
+    }
+    ++count;
+  }
+
+  for (auto const &name : materials)
+  {
+    Ogre::MaterialPtr material =
+        Ogre::MaterialManager::getSingleton().getByName(name);
+    if (material.isNull() || InUse(material))
+      continue;
+
+    material.setNull();
+    RTShaderSystem::Instance()->RemoveShaders(name);
+    Ogre::MaterialManager::getSingleton().remove(name);
+    ++count;
+  }
+
+  // Free the textures of the removed materials. They are loaded again
+  // from their files when a material uses them.
+  if (count > 0)
+  {
+    Ogre::TextureManager::getSingleton().unloadUnreferencedResources();
+    gzlog << "Removed " << count << " unused meshes and materials\n";
+  }
+
+  return count;
+}
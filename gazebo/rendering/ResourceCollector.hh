@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_RENDERING_RESOURCECOLLECTOR_HH_
+#define GAZEBO_RENDERING_RESOURCECOLLECTOR_HH_
+
+#include <string>
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    /// \internal
+    /// \brief Releases the Ogre meshes and materials of removed visuals.
+    ///
+    /// Visuals reference the meshes they attach and the materials they
+    /// clone. Once the references of a resource are gone for longer than
+    /// the retention time of common::MeshManager, Collect removes it, so a
+    /// model spawned again quickly reuses its resources. Only meshes loaded
+    /// from a file are removed, since the visual that needs them next loads
+    /// them again. Textures no longer used by a material are then unloaded.
+    ///
+    /// Ogre isn't thread safe, so Collect runs on the rendering thread, see
+    /// Scene::PreRender. The common meshes are removed by a background
+    /// thread of common::MeshManager.
+    class ResourceCollector
+    {
+      /// \brief Reference a mesh before attaching it.
+      /// \param[in] _meshName Name of the common mesh.
+      /// \param[in] _subMesh Name of the submesh, empty for the whole mesh.
+      public: static void AcquireMesh(const std::string &_meshName,
+                  const std::string &_subMesh);
+
+      /// \brief Drop a reference added with AcquireMesh.
+      /// \param[in] _meshName Name of the common mesh.
+      /// \param[in] _subMesh Name of the submesh, empty for the whole mesh.
+      public: static void ReleaseMesh(const std::string &_meshName,
+                  const std::string &_subMesh);
+
+      /// \brief Reference a material cloned for a single visual.
+      /// \param[in] _name Name of the material.
+      public: static void AcquireMaterial(const std::string &_name);
+
+      /// \brief Drop a reference added with AcquireMaterial.
+      /// \param[in] _name Name of the material.
+      public: static void ReleaseMaterial(const std::string &_name);
+
+      /// \brief Remove the resources unreferenced for longer than the
+      /// retention time. Must be called from the rendering thread. Runs
+      /// at most once a second unless _all is true.
+      /// \param[in] _all True to remove all unreferenced resources now.
+      /// \return Number of meshes and materials removed.
+      public: static unsigned int Collect(const bool _all = false);
+    };
+  }
+}
+#endif
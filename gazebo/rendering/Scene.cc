@@ -15,10 +15,18 @@
  *
 */
 
+#include <cmath>
+#include <cstdlib>
 #include <functional>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
 
 #include <boost/lexical_cast.hpp>
 #include <boost/make_shared.hpp>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
 #include <ignition/common/Profiler.hh>
 #include <ignition/math/Color.hh>
 #include <ignition/math/Helpers.hh>
@@ -30,11 +38,14 @@
 
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Assert.hh"
+#include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Console.hh"
+#include "gazebo/common/MeshManager.hh"
 #include "gazebo/rendering/Road2d.hh"
 #include "gazebo/rendering/Projector.hh"
 #include "gazebo/rendering/Heightmap.hh"
 #include "gazebo/rendering/RenderEvents.hh"
+#include "gazebo/rendering/ResourceCollector.hh"
 #include "gazebo/rendering/LaserVisual.hh"
 #include "gazebo/rendering/SonarVisual.hh"
 #include "gazebo/rendering/WrenchVisual.hh"
@@ -45,6 +56,7 @@
 #include "gazebo/rendering/InertiaVisual.hh"
 #include "gazebo/rendering/LinkFrameVisual.hh"
 #include "gazebo/rendering/MarkerVisual.hh"
+#include "gazebo/rendering/OcclusionCulling.hh"
 #include "gazebo/rendering/ContactVisual.hh"
 #include "gazebo/rendering/Conversions.hh"
 #include "gazebo/rendering/Light.hh"
@@ -64,6 +76,8 @@
 #include "gazebo/rendering/SelectionObj.hh"
 #include "gazebo/rendering/RayQuery.hh"
 #include "gazebo/rendering/RenderingIface.hh"
+#include "gazebo/rendering/PoseInterpolator.hh"
+#include "gazebo/rendering/VisualInstancer.hh"
 
 #if OGRE_VERSION_MAJOR >= 1 && OGRE_VERSION_MINOR >= 8
 #include "gazebo/rendering/deferred_shading/SSAOLogic.hh"
@@ -97,6 +111,38 @@ struct VisualMessageLess {
     }
 } VisualMessageLessOp;
 
+//////////////////////////////////////////////////
+/// \brief Collect the mesh files of the visuals in a model message, named
+/// the way Visual looks them up.
+/// \param[in] _msg Model message to search, nested models included.
+/// \param[out] _files Mesh files found.
+static void VisualMeshFiles(const msgs::Model &_msg,
+    std::vector<std::string> &_files)
+{
+  auto addVisual = [&_files](const msgs::Visual &_visual)
+  {
+    if (!_visual.has_geometry() || !_visual.geometry().has_mesh())
+      return;
+
+    std::string filename =
+        common::find_file(_visual.geometry().mesh().filename());
+    if (!filename.empty() && filename != "__default__")
+      _files.push_back(filename);
+  };
+
+  for (int i = 0; i < _msg.visual_size(); ++i)
+    addVisual(_msg.visual(i));
+
+  for (int i = 0; i < _msg.link_size(); ++i)
+  {
+    for (int j = 0; j < _msg.link(i).visual_size(); ++j)
+      addVisual(_msg.link(i).visual(j));
+  }
+
+  for (int i = 0; i < _msg.model_size(); ++i)
+    VisualMeshFiles(_msg.model(i), _files);
+}
+
 //////////////////////////////////////////////////
 Scene::Scene()
   : dataPtr(new ScenePrivate)
@@ -169,8 +215,21 @@ Scene::Scene(const std::string &_name, const bool _enableVisualizations,
   // uncomment the following line and delete the if and else directly above
   if (!_isServer)
   {
-    this->dataPtr->poseSub = this->dataPtr->node->Subscribe("~/pose/info",
-        &Scene::OnPoseMsg, this);
+    // Clients on slow links decode the quantized, delta coded stream
+    const char *compact = std::getenv("GAZEBO_COMPACT_POSES");
+    if (compact && std::string(compact) != "0")
+    {
+      this->dataPtr->compactPoseAckPub =
+          this->dataPtr->node->Advertise<msgs::CompactPosesAck>(
+          "~/pose/compact/ack");
+      this->dataPtr->poseSub = this->dataPtr->node->Subscribe(
+          "~/pose/compact/info", &Scene::OnCompactPosesMsg, this);
+    }
+    else
+    {
+      this->dataPtr->poseSub = this->dataPtr->node->Subscribe("~/pose/info",
+          &Scene::OnPoseMsg, this);
+    }
   }
 
   this->dataPtr->jointSub =
@@ -259,6 +318,7 @@ void Scene::Clear()
   this->dataPtr->connections.clear();
 
   this->dataPtr->poseSub.reset();
+  this->dataPtr->compactPoseAckPub.reset();
   this->dataPtr->jointSub.reset();
   this->dataPtr->sensorSub.reset();
   this->dataPtr->sceneSub.reset();
@@ -294,6 +354,13 @@ void Scene::Clear()
   {
     std::lock_guard<std::recursive_mutex> lock(this->dataPtr->poseMsgMutex);
     this->dataPtr->poseMsgs.clear();
+    if (this->dataPtr->poseInterpolator)
+      this->dataPtr->poseInterpolator->Clear();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->poseBatchMutex);
+    this->dataPtr->poseBatches.clear();
   }
 
   this->dataPtr->joints.clear();
@@ -306,6 +373,7 @@ void Scene::Clear()
     this->RemoveVisual(this->dataPtr->visuals.begin()->first);
 
   this->dataPtr->visuals.clear();
+  this->dataPtr->visualTable.clear();
 
   if (this->dataPtr->originVisual)
   {
@@ -319,6 +387,9 @@ void Scene::Clear()
     this->dataPtr->worldVisual.reset();
   }
 
+  this->dataPtr->instancer.reset();
+  this->dataPtr->occlusionCulling.reset();
+
   while (!this->dataPtr->lights.empty())
     if (this->dataPtr->lights.begin()->second)
       this->RemoveLight(this->dataPtr->lights.begin()->second);
@@ -404,12 +475,26 @@ void Scene::Init()
   this->dataPtr->worldVisual.reset(new Visual("__world_node__",
       shared_from_this()));
   this->dataPtr->worldVisual->SetId(0);
-  this->dataPtr->visuals[0] = this->dataPtr->worldVisual;
+  this->dataPtr->SetVisual(0, this->dataPtr->worldVisual);
 
   // RTShader system self-enables if the render path type is FORWARD,
   RTShaderSystem::Instance()->AddScene(shared_from_this());
   RTShaderSystem::Instance()->ApplyShadows(shared_from_this());
 
+  // Instanced visuals are drawn with simplified shading, keep it to the
+  // user's view of the scene
+  if (!this->dataPtr->isServer && VisualInstancer::Enabled())
+  {
+    this->dataPtr->instancer.reset(
+        new VisualInstancer(this->dataPtr->manager));
+  }
+
+  if (OcclusionCulling::Enabled())
+  {
+    this->dataPtr->occlusionCulling.reset(
+        new OcclusionCulling(this->dataPtr->manager));
+  }
+
   if (RenderEngine::Instance()->GetRenderPathType() == RenderEngine::DEFERRED)
     this->InitDeferredShading();
 
@@ -453,11 +538,26 @@ void Scene::Init()
       this->dataPtr->worldVisual));
   this->dataPtr->originVisual->Load();
 
-  // Get scene info from physics::World with ignition transport service
+  // Get scene info from physics::World with ignition transport service,
+  // or have the models streamed one by one if requested
   ignition::transport::Node node;
   const std::string serviceName = "/scene_info";
   std::vector<ignition::transport::ServicePublisher> publishers;
-  if (!node.ServiceInfo(serviceName, publishers) ||
+  const char *stream = std::getenv("GAZEBO_SCENE_STREAM");
+  if (stream && std::string(stream) != "0")
+  {
+    std::ostringstream known;
+    {
+      std::lock_guard<std::mutex> lock(*this->dataPtr->receiveMutex);
+      for (auto const &version : this->dataPtr->modelVersions)
+        known << version.first << " " << version.second << "\n";
+    }
+    this->dataPtr->requestPub->WaitForConnection();
+    this->dataPtr->requestMsg.reset(
+        msgs::CreateRequest("scene_info_stream", known.str()));
+    this->dataPtr->requestPub->Publish(*this->dataPtr->requestMsg);
+  }
+  else if (!node.ServiceInfo(serviceName, publishers) ||
       !node.Request(serviceName, &Scene::OnSceneInfo, this))
   {
     gzwarn << "Ignition transport [" << serviceName << "] service call failed,"
@@ -1586,6 +1686,15 @@ void Scene::MeshInformation(const Ogre::Mesh *_mesh,
 /////////////////////////////////////////////////
 bool Scene::ProcessSceneMsg(ConstScenePtr &_msg)
 {
+  // Parse the meshes in parallel up front, instead of one at a time as
+  // each visual is created
+  {
+    std::vector<std::string> meshFiles;
+    for (int i = 0; i < _msg->model_size(); ++i)
+      VisualMeshFiles(_msg->model(i), meshFiles);
+    common::MeshManager::Instance()->Prefetch(meshFiles);
+  }
+
   {
     std::lock_guard<std::recursive_mutex> lock(this->dataPtr->poseMsgMutex);
     for (int i = 0; i < _msg->model_size(); ++i)
@@ -2123,6 +2232,145 @@ void Scene::PreRender()
     std::lock_guard<std::recursive_mutex> lock(this->dataPtr->poseMsgMutex);
     IGN_PROFILE_END();
 
+    // Apply the poses received since the last frame in one sweep, keeping
+    // only the latest pose of each id and finding visuals by table index
+    IGN_PROFILE_BEGIN("poseBatches");
+    std::vector<ConstPosesStampedPtr> batches;
+    bool batchesLeft = false;
+    {
+      std::lock_guard<std::mutex> batchLock(this->dataPtr->poseBatchMutex);
+      auto &pending = this->dataPtr->poseBatches;
+      const double limit = this->dataPtr->poseTimeLimit;
+      if (std::isnan(limit))
+      {
+        std::swap(batches, pending);
+      }
+      else
+      {
+        // Stop at the batch closest to the limit, later ones are kept
+        double prev = this->dataPtr->sceneSimTimePosesReceived.Double();
+        size_t count = 0;
+        while (count < pending.size())
+        {
+          const double t = msgs::Convert(pending[count]->time()).Double();
+          if (count > 0 && t > limit && t - limit >= limit - prev)
+            break;
+          prev = t;
+          ++count;
+          if (t >= limit)
+            break;
+        }
+        batches.assign(pending.begin(), pending.begin() + count);
+        pending.erase(pending.begin(), pending.begin() + count);
+        batchesLeft = !pending.empty();
+      }
+    }
+
+    // Wake up the next WaitForRenderRequest for the batches kept back
+    if (batchesLeft)
+    {
+      std::lock_guard<std::mutex> lck(this->dataPtr->newPoseMutex);
+      this->dataPtr->newPoseAvailable = true;
+    }
+
+    const bool moving = this->dataPtr->selectedVis &&
+        this->dataPtr->selectionMode == "move";
+    auto applyPose = [&](const uint32_t _id,
+        const ignition::math::Pose3d &_pose, const msgs::Pose *_msg)
+    {
+      // If an object is selected, don't let the physics engine move it.
+      Visual *vis = this->dataPtr->VisualById(_id);
+      if (vis && (!moving || (_id != this->dataPtr->selectedVis->GetId() &&
+          !this->dataPtr->selectedVis->IsAncestorOf(vis->shared_from_this()))))
+      {
+        vis->SetPose(_pose);
+      }
+      else if (_msg)
+      {
+        // Handled below, or kept until the visual exists
+        this->dataPtr->poseMsgs[_id].CopyFrom(*_msg);
+      }
+      else
+      {
+        msgs::Pose &msg = this->dataPtr->poseMsgs[_id];
+        msgs::Set(&msg, _pose);
+        msg.set_id(_id);
+      }
+    };
+
+    common::Time appliedTime;
+    if (this->dataPtr->poseInterpolator)
+    {
+      PoseInterpolator &interpolator = *this->dataPtr->poseInterpolator;
+      common::Time wallTime = common::Time::GetWallTime();
+      for (const auto &batch : batches)
+      {
+        this->dataPtr->sceneSimTimePosesReceived =
+            common::Time(batch->time().sec(), batch->time().nsec());
+        interpolator.AddBatch(this->dataPtr->sceneSimTimePosesReceived,
+            wallTime);
+
+        for (int i = 0; i < batch->pose_size(); ++i)
+        {
+          const msgs::Pose &p = batch->pose(i);
+
+          // Poses left over from earlier frames are now out of date
+          if (!this->dataPtr->poseMsgs.empty())
+            this->dataPtr->poseMsgs.erase(p.id());
+
+          interpolator.AddPose(p.id(), msgs::ConvertIgn(p));
+        }
+      }
+
+      auto &poses = this->dataPtr->interpolatedPoses;
+      appliedTime = interpolator.Update(wallTime, poses);
+      for (const auto &pose : poses)
+        applyPose(pose.first, pose.second, nullptr);
+      poses.clear();
+    }
+    else
+    {
+      std::vector<const msgs::Pose *> &latest = this->dataPtr->latestPoses;
+      std::vector<uint32_t> &latestIds = this->dataPtr->latestPoseIds;
+      for (const auto &batch : batches)
+      {
+        this->dataPtr->sceneSimTimePosesReceived =
+            common::Time(batch->time().sec(), batch->time().nsec());
+
+        for (int i = 0; i < batch->pose_size(); ++i)
+        {
+          const msgs::Pose &p = batch->pose(i);
+          const uint32_t id = p.id();
+
+          // Poses left over from earlier frames are now out of date
+          if (!this->dataPtr->poseMsgs.empty())
+            this->dataPtr->poseMsgs.erase(id);
+
+          if (id >= ScenePrivate::kMaxVisualTableId)
+          {
+            this->dataPtr->poseMsgs[id].CopyFrom(p);
+            continue;
+          }
+
+          if (id >= latest.size())
+            latest.resize(id + 1, nullptr);
+          if (!latest[id])
+            latestIds.push_back(id);
+          latest[id] = &p;
+        }
+      }
+
+      for (const uint32_t id : latestIds)
+      {
+        const msgs::Pose &p = *latest[id];
+        latest[id] = nullptr;
+        applyPose(id, msgs::ConvertIgn(p), &p);
+      }
+      latestIds.clear();
+      appliedTime = this->dataPtr->sceneSimTimePosesReceived;
+    }
+    IGN_PROFILE_END();
+
     // Process all the model messages last. Remove pose message from the list
     // only when a corresponding visual exits. We may receive pose updates
     // over the wire before  we recieve the visual
@@ -2207,32 +2455,74 @@ void Scene::PreRender()
 
     // Process the road messages.
     IGN_PROFILE_BEGIN("roadMsgs");
-    for (const auto &msg : roadMsgsCopy)
+    if (!roadMsgsCopy.empty())
     {
       // do not add road if it already exists
-      bool addRoad = true;
+      std::set<std::string> roadNames;
       for (const auto &it : this->dataPtr->visuals)
       {
-        Road2dPtr road = std::dynamic_pointer_cast<Road2d>(it.second);
-        if (road && road->Name() == msg->name())
-        {
-          addRoad = false;
-          break;
-        }
+        if (std::dynamic_pointer_cast<Road2d>(it.second))
+          roadNames.insert(it.second->Name());
       }
-      if (addRoad)
+
+      std::vector<boost::shared_ptr<msgs::Road const>> newRoads;
+      for (const auto &msg : roadMsgsCopy)
+      {
+        if (roadNames.insert(msg->name()).second)
+          newRoads.push_back(msg);
+      }
+
+      // Build the road meshes in parallel, Road2d::Load then finds them
+      // and only creates the Ogre objects, which must happen here
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, newRoads.size(), 1),
+          [&](const tbb::blocked_range<size_t> &_range)
+          {
+            for (size_t i = _range.begin(); i != _range.end(); ++i)
+            {
+              std::vector<ignition::math::Vector3d> points;
+              for (int j = 0; j < newRoads[i]->point_size(); ++j)
+                points.push_back(msgs::ConvertIgn(newRoads[i]->point(j)));
+
+              common::MeshManager::Instance()->CreateRoad(
+                  common::MeshManager::RoadMeshName(points,
+                  newRoads[i]->width()), points, newRoads[i]->width());
+            }
+          });
+
+      for (const auto &msg : newRoads)
       {
         Road2dPtr road(new Road2d(msg->name(), this->dataPtr->worldVisual));
         road->Load(*msg);
-        this->dataPtr->visuals[road->GetId()] = road;
+        this->dataPtr->SetVisual(road->GetId(), road);
       }
     }
 
     // official time stamp of approval
-    this->dataPtr->sceneSimTimePosesApplied =
-        this->dataPtr->sceneSimTimePosesReceived;
+    this->dataPtr->sceneSimTimePosesApplied = appliedTime;
     IGN_PROFILE_END();
   }
+
+  if (this->dataPtr->occlusionCulling)
+  {
+    std::vector<Ogre::Camera *> ogreCameras;
+    for (auto const &camera : this->dataPtr->cameras)
+    {
+      if (camera->OgreCamera())
+        ogreCameras.push_back(camera->OgreCamera());
+    }
+    for (auto const &camera : this->dataPtr->userCameras)
+    {
+      if (camera->OgreCamera())
+        ogreCameras.push_back(camera->OgreCamera());
+    }
+    this->dataPtr->occlusionCulling->Update(this->dataPtr->worldVisual,
+        ogreCameras);
+  }
+
+  // Release the resources of visuals removed a while ago
+  IGN_PROFILE_BEGIN("ResourceCollector::Collect");
+  ResourceCollector::Collect();
+  IGN_PROFILE_END();
 }
 
 /////////////////////////////////////////////////
@@ -2263,7 +2553,7 @@ bool Scene::ProcessSensorMsg(ConstSensorPtr &_msg)
             rayVisualName+"_GUIONLY_laser_vis", parentVis, _msg->topic()));
       laserVis->Load();
       laserVis->SetId(_msg->id());
-      this->dataPtr->visuals[_msg->id()] = laserVis;
+      this->dataPtr->SetVisual(_msg->id(), laserVis);
     }
   }
   else if ((_msg->type() == "sonar") && _msg->visualize()
@@ -2280,7 +2570,7 @@ bool Scene::ProcessSensorMsg(ConstSensorPtr &_msg)
             sonarVisualName+"_GUIONLY_sonar_vis", parentVis, _msg->topic()));
       sonarVis->Load();
       sonarVis->SetId(_msg->id());
-      this->dataPtr->visuals[_msg->id()] = sonarVis;
+      this->dataPtr->SetVisual(_msg->id(), sonarVis);
     }
   }
   else if ((_msg->type() == "force_torque") && _msg->visualize()
@@ -2310,7 +2600,7 @@ bool Scene::ProcessSensorMsg(ConstSensorPtr &_msg)
             _msg->topic()));
       wrenchVis->Load(jointMsg);
       wrenchVis->SetId(_msg->id());
-      this->dataPtr->visuals[_msg->id()] = wrenchVis;
+      this->dataPtr->SetVisual(_msg->id(), wrenchVis);
     }
   }
   else if (_msg->type() == "camera" && _msg->visualize())
@@ -2336,7 +2626,7 @@ bool Scene::ProcessSensorMsg(ConstSensorPtr &_msg)
         cameraVis->SetPose(msgs::ConvertIgn(_msg->pose()));
         cameraVis->SetId(_msg->id());
         cameraVis->Load(_msg->camera());
-        this->dataPtr->visuals[cameraVis->GetId()] = cameraVis;
+        this->dataPtr->SetVisual(cameraVis->GetId(), cameraVis);
       }
     }
   }
@@ -2359,7 +2649,7 @@ bool Scene::ProcessSensorMsg(ConstSensorPtr &_msg)
       cameraVis->SetPose(msgs::ConvertIgn(_msg->pose()));
       cameraVis->SetId(_msg->id());
       cameraVis->Load(_msg->logical_camera());
-      this->dataPtr->visuals[cameraVis->GetId()] = cameraVis;
+      this->dataPtr->SetVisual(cameraVis->GetId(), cameraVis);
     }
     else if (_msg->has_pose())
     {
@@ -2375,7 +2665,7 @@ bool Scene::ProcessSensorMsg(ConstSensorPtr &_msg)
     contactVis->SetId(_msg->id());
 
     this->dataPtr->contactVisId = _msg->id();
-    this->dataPtr->visuals[contactVis->GetId()] = contactVis;
+    this->dataPtr->SetVisual(contactVis->GetId(), contactVis);
   }
   else if (_msg->type() == "rfidtag" && _msg->visualize() &&
            !_msg->topic().empty())
@@ -2388,7 +2678,7 @@ bool Scene::ProcessSensorMsg(ConstSensorPtr &_msg)
           _msg->name() + "_GUIONLY_rfidtag_vis", parentVis, _msg->topic()));
     rfidVis->SetId(_msg->id());
 
-    this->dataPtr->visuals[rfidVis->GetId()] = rfidVis;
+    this->dataPtr->SetVisual(rfidVis->GetId(), rfidVis);
   }
   else if (_msg->type() == "rfid" && _msg->visualize() &&
            !_msg->topic().empty())
@@ -2400,7 +2690,7 @@ bool Scene::ProcessSensorMsg(ConstSensorPtr &_msg)
     RFIDVisualPtr rfidVis(new RFIDVisual(
           _msg->name() + "_GUIONLY_rfid_vis", parentVis, _msg->topic()));
     rfidVis->SetId(_msg->id());
-    this->dataPtr->visuals[rfidVis->GetId()] = rfidVis;
+    this->dataPtr->SetVisual(rfidVis->GetId(), rfidVis);
   }
   else if (_msg->type() == "wireless_transmitter" && _msg->visualize() &&
            !_msg->topic().empty())
@@ -2411,7 +2701,7 @@ bool Scene::ProcessSensorMsg(ConstSensorPtr &_msg)
 
     VisualPtr transmitterVis(new TransmitterVisual(
           _msg->name() + "_GUIONLY_transmitter_vis", parentVis, _msg->topic()));
-    this->dataPtr->visuals[transmitterVis->GetId()] = transmitterVis;
+    this->dataPtr->SetVisual(transmitterVis->GetId(), transmitterVis);
     transmitterVis->Load();
   }
 
@@ -2580,7 +2870,13 @@ void Scene::ProcessRequestMsg(ConstRequestPtr &_msg)
       }
 
       if (visPtr)
+      {
+        {
+          std::lock_guard<std::mutex> lock(*this->dataPtr->receiveMutex);
+          this->dataPtr->modelVersions.erase(visPtr->Name());
+        }
         this->RemoveVisual(visPtr);
+      }
     }
   }
   else if (_msg->request() == "show_contact")
@@ -2812,7 +3108,7 @@ bool Scene::ProcessVisualMsg(ConstVisualPtr &_msg, Visual::VisualType _type)
   {
     if (iter != this->dataPtr->visuals.end())
     {
-      this->dataPtr->visuals.erase(iter);
+      this->dataPtr->EraseVisual(iter);
       return true;
     }
     else
@@ -2938,7 +3234,7 @@ bool Scene::ProcessVisualMsg(ConstVisualPtr &_msg, Visual::VisualType _type)
   }
   visual->SetType(_type);
 
-  this->dataPtr->visuals[visual->GetId()] = visual;
+  this->dataPtr->SetVisual(visual->GetId(), visual);
   if (visual->Name().find("__SKELETON_VISUAL__") != std::string::npos)
   {
     visual->SetVisible(false);
@@ -2962,19 +3258,28 @@ common::Time Scene::SimTime() const
 /////////////////////////////////////////////////
 void Scene::OnPoseMsg(ConstPosesStampedPtr &_msg)
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->poseMsgMutex);
-  this->dataPtr->sceneSimTimePosesReceived =
-    common::Time(_msg->time().sec(), _msg->time().nsec());
+  // Merged into the scene by PreRender, which may be busy applying the
+  // previous batch
+  std::lock_guard<std::mutex> lock(this->dataPtr->poseBatchMutex);
+  this->dataPtr->poseBatches.push_back(_msg);
+}
+
+/////////////////////////////////////////////////
+void Scene::OnCompactPosesMsg(ConstCompactPosesPtr &_msg)
+{
+  auto poses = boost::make_shared<msgs::PosesStamped>();
+  msgs::CompactPosesAck ack;
+  const bool decoded =
+      this->dataPtr->poseStreamDecoder.Decode(*_msg, *poses, ack);
+
+  // A frame that can't be decoded asks for a key frame
+  if (this->dataPtr->compactPoseAckPub)
+    this->dataPtr->compactPoseAckPub->Publish(ack);
 
-  for (int i = 0; i < _msg->pose_size(); ++i)
+  if (decoded)
   {
-    auto p = _msg->pose(i);
-    PoseMsgs_M::iterator iter =
-        this->dataPtr->poseMsgs.find(p.id());
-    if (iter != this->dataPtr->poseMsgs.end())
-      iter->second.CopyFrom(p);
-    else
-      this->dataPtr->poseMsgs.insert(std::make_pair(p.id(), p));
+    ConstPosesStampedPtr msg = poses;
+    this->OnPoseMsg(msg);
   }
 }
 
@@ -2989,6 +3294,13 @@ void Scene::UpdatePoses(const msgs::PosesStamped &_msg)
   this->dataPtr->newPoseCondition.notify_all();
 }
 
+/////////////////////////////////////////////////
+void Scene::SetPoseTimeLimit(const double _time)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->poseBatchMutex);
+  this->dataPtr->poseTimeLimit = _time;
+}
+
 /////////////////////////////////////////////////
 bool Scene::WaitForRenderRequest(double _timeoutsec)
 {
@@ -3105,8 +3417,13 @@ bool Scene::ProcessLightModifyMsg(ConstLightPtr &_msg)
 /////////////////////////////////////////////////
 void Scene::OnModelMsg(ConstModelPtr &_msg)
 {
+  std::string data;
+  _msg->SerializeToString(&data);
+
   std::lock_guard<std::mutex> lock(*this->dataPtr->receiveMutex);
   this->dataPtr->modelMsgs.push_back(_msg);
+  this->dataPtr->modelVersions[_msg->name()] =
+      std::hash<std::string>()(data);
 }
 
 /////////////////////////////////////////////////
@@ -3407,7 +3724,7 @@ void Scene::AddVisual(VisualPtr _vis)
     gzwarn << "Duplicate visuals detected[" << _vis->Name() << "]\n";
   }
 
-  this->dataPtr->visuals[_vis->GetId()] = _vis;
+  this->dataPtr->SetVisual(_vis->GetId(), _vis);
 }
 
 /////////////////////////////////////////////////
@@ -3441,7 +3758,7 @@ void Scene::RemoveVisual(uint32_t _id)
       else
         ++piter;
     }
-    this->dataPtr->visuals.erase(iter);
+    this->dataPtr->EraseVisual(iter);
 
     this->RemoveVisualizations(vis);
     vis->Fini();
@@ -3467,8 +3784,8 @@ void Scene::SetVisualId(VisualPtr _vis, uint32_t _id)
   auto iter = this->dataPtr->visuals.find(_vis->GetId());
   if (iter != this->dataPtr->visuals.end())
   {
-    this->dataPtr->visuals.erase(_vis->GetId());
-    this->dataPtr->visuals[_id] = _vis;
+    this->dataPtr->EraseVisual(iter);
+    this->dataPtr->SetVisual(_id, _vis);
     _vis->SetId(_id);
   }
 }
@@ -3551,6 +3868,25 @@ unsigned int Scene::HeightmapLOD() const
   return this->dataPtr->heightmapLOD;
 }
 
+/////////////////////////////////////////////////
+void Scene::SetPoseInterpolationDelay(const double _delay)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->poseMsgMutex);
+  if (_delay > 0)
+    this->dataPtr->poseInterpolator.reset(new PoseInterpolator(_delay));
+  else
+    this->dataPtr->poseInterpolator.reset();
+}
+
+/////////////////////////////////////////////////
+double Scene::PoseInterpolationDelay() const
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->poseMsgMutex);
+  if (this->dataPtr->poseInterpolator)
+    return this->dataPtr->poseInterpolator->Delay().Double();
+  return 0;
+}
+
 /////////////////////////////////////////////////
 void Scene::SetHeightmapSkirtLength(const double _value)
 {
@@ -3575,7 +3911,7 @@ void Scene::CreateCOMVisual(ConstLinkPtr &_msg, VisualPtr _linkVisual)
                                     _linkVisual));
   comVis->Load(_msg);
   comVis->SetVisible(this->dataPtr->showCOMs);
-  this->dataPtr->visuals[comVis->GetId()] = comVis;
+  this->dataPtr->SetVisual(comVis->GetId(), comVis);
 }
 
 /////////////////////////////////////////////////
@@ -3585,7 +3921,7 @@ void Scene::CreateCOMVisual(sdf::ElementPtr _elem, VisualPtr _linkVisual)
                                     _linkVisual));
   comVis->Load(_elem);
   comVis->SetVisible(false);
-  this->dataPtr->visuals[comVis->GetId()] = comVis;
+  this->dataPtr->SetVisual(comVis->GetId(), comVis);
 }
 
 /////////////////////////////////////////////////
@@ -3595,7 +3931,7 @@ void Scene::CreateInertiaVisual(ConstLinkPtr &_msg, VisualPtr _linkVisual)
       "_INERTIA_VISUAL__", _linkVisual));
   inertiaVis->Load(_msg);
   inertiaVis->SetVisible(this->dataPtr->showInertias);
-  this->dataPtr->visuals[inertiaVis->GetId()] = inertiaVis;
+  this->dataPtr->SetVisual(inertiaVis->GetId(), inertiaVis);
 }
 
 /////////////////////////////////////////////////
@@ -3605,7 +3941,7 @@ void Scene::CreateInertiaVisual(sdf::ElementPtr _elem, VisualPtr _linkVisual)
       "_INERTIA_VISUAL__", _linkVisual));
   inertiaVis->Load(_elem);
   inertiaVis->SetVisible(false);
-  this->dataPtr->visuals[inertiaVis->GetId()] = inertiaVis;
+  this->dataPtr->SetVisual(inertiaVis->GetId(), inertiaVis);
 }
 
 /////////////////////////////////////////////////
@@ -3615,7 +3951,7 @@ void Scene::CreateLinkFrameVisual(ConstLinkPtr &/*_msg*/, VisualPtr _linkVisual)
       "_LINK_FRAME_VISUAL__", _linkVisual));
   linkFrameVis->Load();
   linkFrameVis->SetVisible(this->dataPtr->showLinkFrames);
-  this->dataPtr->visuals[linkFrameVis->GetId()] = linkFrameVis;
+  this->dataPtr->SetVisual(linkFrameVis->GetId(), linkFrameVis);
 }
 
 /////////////////////////////////////////////////
@@ -3735,7 +4071,7 @@ void Scene::ShowContacts(const bool _show)
               this->dataPtr->worldVisual, "~/physics/contacts"));
     vis->SetEnabled(_show);
     this->dataPtr->contactVisId = vis->GetId();
-    this->dataPtr->visuals[this->dataPtr->contactVisId] = vis;
+    this->dataPtr->SetVisual(this->dataPtr->contactVisId, vis);
   }
   else
     vis = std::dynamic_pointer_cast<ContactVisual>(
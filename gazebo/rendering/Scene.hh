@@ -490,6 +490,18 @@ namespace gazebo
       /// \sa Heightmap::LOD
       public: unsigned int HeightmapLOD() const;
 
+      /// \brief Show poses a delay behind the latest ones received,
+      /// interpolating between them. This keeps motion smooth when poses
+      /// arrive at a lower rate than the scene is rendered.
+      /// \param[in] _delay Delay in seconds, zero to apply poses as soon as
+      /// they are received.
+      public: void SetPoseInterpolationDelay(const double _delay);
+
+      /// \brief Get the pose interpolation delay.
+      /// \return Delay in seconds, zero if poses are not interpolated.
+      /// \sa SetPoseInterpolationDelay
+      public: double PoseInterpolationDelay() const;
+
       /// \brief Set the skirt length value for the heightmap LOD tiles.
       /// \param[in] _value Length of skirts on LOD tiles
       /// \sa Heightmap::SetSkirtLength
@@ -582,6 +594,13 @@ namespace gazebo
       /// \param[in] _msg The message data.
       public: void UpdatePoses(const msgs::PosesStamped& _msg);
 
+      /// \brief Keep pose updates stamped after a sim time for a later
+      /// PreRender, so that the scene can show that time while newer poses
+      /// keep arriving. The batch closest to the limit is applied even if it
+      /// is slightly later, and at least one batch is applied per PreRender.
+      /// \param[in] _time Sim time in seconds, NaN to apply every update.
+      public: void SetPoseTimeLimit(const double _time);
+
       /// \brief Get the number of visuals.
       /// \return The number of visuals in the Scene.
       public: uint32_t VisualCount() const;
@@ -750,6 +769,10 @@ namespace gazebo
       /// \param[in] _msg The message data.
       private: void OnPoseMsg(ConstPosesStampedPtr &_msg);
 
+      /// \brief Compact pose stream callback, see msgs::PoseStreamDecoder.
+      /// \param[in] _msg The message data.
+      private: void OnCompactPosesMsg(ConstCompactPosesPtr &_msg);
+
       /// \brief Skeleton animation callback.
       /// \param[in] _msg The message data.
       private: void OnSkeletonPoseMsg(ConstPoseAnimationPtr &_msg);
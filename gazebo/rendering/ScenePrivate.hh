@@ -18,6 +18,7 @@
 #define GAZEBO_RENDERING_SCENE_PRIVATE_HH_
 
 #include <condition_variable>
+#include <limits>
 #include <list>
 #include <map>
 #include <memory>
@@ -33,6 +34,7 @@
 #include "gazebo/common/Events.hh"
 #include "gazebo/gazebo_config.h"
 #include "gazebo/msgs/msgs.hh"
+#include "gazebo/msgs/PoseStream.hh"
 #include "gazebo/rendering/MarkerManager.hh"
 #include "gazebo/rendering/RenderTypes.hh"
 #include "gazebo/transport/TransportTypes.hh"
@@ -57,6 +59,9 @@ namespace gazebo
     class Visual;
     class Grid;
     class Heightmap;
+    class OcclusionCulling;
+    class PoseInterpolator;
+    class VisualInstancer;
 
     /// \def Visual_M
     /// \brief Map of visuals and their names.
@@ -210,6 +215,53 @@ namespace gazebo
       /// \brief Map of all the visuals in this scene.
       public: Visual_M visuals;
 
+      /// \brief Visuals of the map above indexed by id, for ids below
+      /// kMaxVisualTableId. Physics entity ids are small and dense, so
+      /// poses can be matched to visuals without a map lookup.
+      public: std::vector<Visual *> visualTable;
+
+      /// \brief Ids at or above this are only kept in the visuals map.
+      /// Ids generated on the rendering side count down from the top of
+      /// the range and never land in the table.
+      public: static const uint32_t kMaxVisualTableId = 1u << 20;
+
+      /// \brief Add or replace a visual in the visuals map and table.
+      /// \param[in] _id Id to store the visual under.
+      /// \param[in] _vis The visual.
+      public: void SetVisual(const uint32_t _id, VisualPtr _vis)
+      {
+        this->visuals[_id] = _vis;
+        if (_id < kMaxVisualTableId)
+        {
+          if (_id >= this->visualTable.size())
+            this->visualTable.resize(_id + 1, nullptr);
+          this->visualTable[_id] = _vis.get();
+        }
+      }
+
+      /// \brief Remove a visual from the visuals map and table.
+      /// \param[in] _iter Entry of the visuals map to remove.
+      public: void EraseVisual(Visual_M::iterator _iter)
+      {
+        if (_iter->first < this->visualTable.size())
+          this->visualTable[_iter->first] = nullptr;
+        this->visuals.erase(_iter);
+      }
+
+      /// \brief Find a visual by id.
+      /// \param[in] _id Id of the visual.
+      /// \return The visual, null if there is none.
+      public: Visual *VisualById(const uint32_t _id) const
+      {
+        if (_id < kMaxVisualTableId)
+        {
+          return _id < this->visualTable.size() ?
+              this->visualTable[_id] : nullptr;
+        }
+        auto iter = this->visuals.find(_id);
+        return iter != this->visuals.end() ? iter->second.get() : nullptr;
+      }
+
       /// \brief Map of all the lights in this scene.
       public: Light_M lights;
 
@@ -234,6 +286,33 @@ namespace gazebo
       /// \brief Mutex to lock the pose message buffers.
       public: std::recursive_mutex poseMsgMutex;
 
+      /// \brief Pose messages received since the last PreRender, in
+      /// arrival order.
+      public: std::vector<ConstPosesStampedPtr> poseBatches;
+
+      /// \brief Protects poseBatches and poseTimeLimit. Only held to append
+      /// a message or to take them, never while poses are applied.
+      public: std::mutex poseBatchMutex;
+
+      /// \brief Batches stamped after this sim time are kept for a later
+      /// PreRender, see Scene::SetPoseTimeLimit. NaN applies them all.
+      public: double poseTimeLimit = std::numeric_limits<double>::quiet_NaN();
+
+      /// \brief Latest pose of each id in the batches being applied,
+      /// indexed by id. Entries are null outside of PreRender.
+      public: std::vector<const msgs::Pose *> latestPoses;
+
+      /// \brief Ids with an entry in latestPoses, in first arrival order.
+      public: std::vector<uint32_t> latestPoseIds;
+
+      /// \brief Plays received poses back with a delay, null unless set
+      /// with Scene::SetPoseInterpolationDelay.
+      public: std::unique_ptr<PoseInterpolator> poseInterpolator;
+
+      /// \brief Poses produced by poseInterpolator for the current frame.
+      public: std::vector<std::pair<uint32_t, ignition::math::Pose3d>>
+          interpolatedPoses;
+
       /// \brief Communication Node
       public: transport::NodePtr node;
 
@@ -258,6 +337,12 @@ namespace gazebo
       /// \brief Subscribe to pose updates
       public: transport::SubscriberPtr poseSub;
 
+      /// \brief Acknowledges the frames of the compact pose stream.
+      public: transport::PublisherPtr compactPoseAckPub;
+
+      /// \brief Decodes the compact pose stream.
+      public: msgs::PoseStreamDecoder poseStreamDecoder;
+
       /// \brief Subscribe to joint updates.
       public: transport::SubscriberPtr jointSub;
 
@@ -304,6 +389,12 @@ namespace gazebo
       /// \brief Keep around our request message.
       public: std::unique_ptr<msgs::Request> requestMsg;
 
+      /// \brief Hash of the last message received for each model, by
+      /// scoped name. Sent along a "scene_info_stream" request so the
+      /// server skips the models this scene already has. Protected by
+      /// receiveMutex.
+      public: std::map<std::string, std::size_t> modelVersions;
+
       /// \brief True if visualizations should be rendered.
       public: bool enableVisualizations;
 
@@ -387,6 +478,14 @@ namespace gazebo
 
       /// \brief Shadow caster render back faces
       public: bool shadowCasterRenderBackFaces = true;
+
+      /// \brief Draws visuals sharing a mesh with hardware instancing, null
+      /// unless enabled with GAZEBO_VISUAL_INSTANCING.
+      public: std::unique_ptr<VisualInstancer> instancer;
+
+      /// \brief Skips occluded visuals, null unless enabled with
+      /// GAZEBO_OCCLUSION_CULLING.
+      public: std::unique_ptr<OcclusionCulling> occlusionCulling;
     };
   }
 }
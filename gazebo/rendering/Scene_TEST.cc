@@ -100,6 +100,69 @@ TEST_F(Scene_TEST, AddRemoveVisuals)
   EXPECT_FALSE(scene->GetVisual("visual1"));
 }
 
+/////////////////////////////////////////////////
+TEST_F(Scene_TEST, UpdatePoses)
+{
+  Load("worlds/empty.world");
+
+  gazebo::rendering::ScenePtr scene = gazebo::rendering::get_scene();
+  ASSERT_TRUE(scene != nullptr);
+
+  // One visual with a physics-like id, one with its own id
+  rendering::VisualPtr visual1(new rendering::Visual("pose_visual1", scene));
+  visual1->Load();
+  scene->AddVisual(visual1);
+  scene->SetVisualId(visual1, 100000u);
+
+  rendering::VisualPtr visual2(new rendering::Visual("pose_visual2", scene));
+  visual2->Load();
+  scene->AddVisual(visual2);
+
+  const uint32_t missingId = 100001u;
+  const ignition::math::Pose3d pose1(1, 2, 3, 0, 0, 0);
+  const ignition::math::Pose3d pose2(4, 5, 6, 0, 0, 0);
+  const ignition::math::Pose3d pose3(7, 8, 9, 0, 0, 0);
+
+  // Two batches, only the latest pose of each visual is applied
+  msgs::PosesStamped msg;
+  msgs::Set(msg.mutable_time(), common::Time(1, 0));
+  msgs::Pose *p = msg.add_pose();
+  p->set_id(visual1->GetId());
+  msgs::Set(p, pose3);
+  p = msg.add_pose();
+  p->set_id(visual2->GetId());
+  msgs::Set(p, pose2);
+  scene->UpdatePoses(msg);
+
+  msg.Clear();
+  msgs::Set(msg.mutable_time(), common::Time(2, 0));
+  p = msg.add_pose();
+  p->set_id(visual1->GetId());
+  msgs::Set(p, pose1);
+  p = msg.add_pose();
+  p->set_id(missingId);
+  msgs::Set(p, pose3);
+  scene->UpdatePoses(msg);
+
+  scene->PreRender();
+  EXPECT_EQ(visual1->WorldPose(), pose1);
+  EXPECT_EQ(visual2->WorldPose(), pose2);
+  EXPECT_EQ(scene->SimTime(), common::Time(2, 0));
+
+  // A pose received before its visual is applied once the visual exists
+  rendering::VisualPtr visual3(new rendering::Visual("pose_visual3", scene));
+  visual3->Load();
+  scene->AddVisual(visual3);
+  scene->SetVisualId(visual3, missingId);
+  scene->PreRender();
+  EXPECT_EQ(visual3->WorldPose(), pose3);
+
+  scene->RemoveVisual(visual1);
+  scene->RemoveVisual(visual2);
+  scene->RemoveVisual(visual3);
+  EXPECT_TRUE(scene->GetVisual("pose_visual1") == nullptr);
+}
+
 /////////////////////////////////////////////////
 TEST_F(Scene_TEST, RemoveModelVisual)
 {
@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <utility>
+
+#include "gazebo/rendering/ShadowMapCache.hh"
+#include "gazebo/rendering/Visual.hh"
+
+using namespace gazebo;
+using namespace rendering;
+
+/// \brief Renders in a row that may reuse the shadow textures. Bounds how
+/// long changes the cache can not see, such as Ogre objects created outside
+/// of visuals, stay out of the shadows.
+static const unsigned int kMaxShadowReuse = 30;
+
+//////////////////////////////////////////////////
+ShadowMapCache::ShadowMapCache(Ogre::SceneManager *_sceneMgr)
+  : sceneMgr(_sceneMgr)
+{
+  this->sceneMgr->addListener(this);
+}
+
+//////////////////////////////////////////////////
+ShadowMapCache::~ShadowMapCache()
+{
+  this->sceneMgr->removeListener(this);
+  if (this->sceneMgr->isShadowTechniqueTextureBased())
+    this->SetShadowUpdates(true);
+}
+
+//////////////////////////////////////////////////
+bool ShadowMapCache::Enabled()
+{
+  const char *env = std::getenv("GAZEBO_SHADOW_CACHE");
+  return env && std::string(env) != "0";
+}
+
+//////////////////////////////////////////////////
+void ShadowMapCache::preUpdateSceneGraph(Ogre::SceneManager *_source,
+    Ogre::Camera *_camera)
+{
+  if (_source != this->sceneMgr || !_camera ||
+      !this->sceneMgr->isShadowTechniqueTextureBased())
+  {
+    return;
+  }
+
+  Ogre::Viewport *vp = _camera->getViewport();
+  if (!vp || !vp->getShadowsEnabled())
+    return;
+
+  // Shadow cameras come through here too, while the textures update
+  for (size_t i = 0; i < this->sceneMgr->getShadowTextureCount(); ++i)
+  {
+    Ogre::RenderTarget *target =
+        this->sceneMgr->getShadowTexture(i)->getBuffer()->getRenderTarget();
+    if (target->getNumViewports() > 0 &&
+        target->getViewport(0)->getCamera() == _camera)
+    {
+      return;
+    }
+  }
+
+  std::vector<double> newState = this->State(_camera);
+  const uint64_t newStamp = Visual::LatestChangeStamp();
+
+  this->reused = _camera == this->camera && newStamp == this->stamp &&
+      this->reuseCount < kMaxShadowReuse && newState == this->state;
+
+  if (this->reused)
+  {
+    ++this->reuseCount;
+  }
+  else
+  {
+    this->camera = _camera;
+    this->state = std::move(newState);
+    this->stamp = newStamp;
+    this->reuseCount = 0;
+  }
+
+  this->SetShadowUpdates(!this->reused);
+}
+
+//////////////////////////////////////////////////
+bool ShadowMapCache::Reused() const
+{
+  return this->reused;
+}
+
+//////////////////////////////////////////////////
+void ShadowMapCache::SetShadowUpdates(const bool _enabled)
+{
+  for (size_t i = 0; i < this->sceneMgr->getShadowTextureCount(); ++i)
+  {
+    Ogre::RenderTarget *target =
+        this->sceneMgr->getShadowTexture(i)->getBuffer()->getRenderTarget();
+    for (unsigned short v = 0; v < target->getNumViewports(); ++v)
+      target->getViewport(v)->setAutoUpdated(_enabled);
+  }
+}
+
+//////////////////////////////////////////////////
+std::vector<double> ShadowMapCache::State(Ogre::Camera *_camera) const
+{
+  std::vector<double> result;
+
+  const Ogre::Vector3 pos = _camera->getDerivedPosition();
+  const Ogre::Quaternion rot = _camera->getDerivedOrientation();
+  result.insert(result.end(), {pos.x, pos.y, pos.z,
+      rot.w, rot.x, rot.y, rot.z,
+      _camera->getFOVy().valueRadians(), _camera->getAspectRatio(),
+      _camera->getNearClipDistance(), _camera->getFarClipDistance(),
+      static_cast<double>(_camera->getProjectionType()),
+      _camera->getOrthoWindowHeight()});
+
+  // Recreated textures start out empty
+  for (size_t i = 0; i < this->sceneMgr->getShadowTextureCount(); ++i)
+  {
+    result.push_back(static_cast<double>(reinterpret_cast<uintptr_t>(
+        this->sceneMgr->getShadowTexture(i).get())));
+  }
+
+  Ogre::SceneManager::MovableObjectIterator iter =
+      this->sceneMgr->getMovableObjectIterator(
+      Ogre::LightFactory::FACTORY_TYPE_NAME);
+  while (iter.hasMoreElements())
+  {
+    const Ogre::Light *light = static_cast<Ogre::Light *>(iter.getNext());
+    const Ogre::Vector3 lightPos = light->getDerivedPosition();
+    const Ogre::Vector3 lightDir = light->getDerivedDirection();
+    result.insert(result.end(), {
+        static_cast<double>(light->getType()),
+        light->isVisible() ? 1.0 : 0.0,
+        light->getCastShadows() ? 1.0 : 0.0,
+        lightPos.x, lightPos.y, lightPos.z,
+        lightDir.x, lightDir.y, lightDir.z,
+        light->getSpotlightOuterAngle().valueRadians(),
+        light->getAttenuationRange()});
+  }
+
+  return result;
+}
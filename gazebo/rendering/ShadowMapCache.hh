@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GAZEBO_RENDERING_SHADOWMAPCACHE_HH_
+#define GAZEBO_RENDERING_SHADOWMAPCACHE_HH_
+
+#include <cstdint>
+#include <vector>
+
+#include "gazebo/rendering/ogre_gazebo.h"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    /// \internal
+    /// \brief Reuses the shadow textures of a scene while nothing that
+    /// casts into them changed.
+    ///
+    /// Ogre renders the shadow textures again for every camera that
+    /// renders with shadows. Before a camera renders, the cache compares
+    /// the camera, the lights and Visual::LatestChangeStamp() with the
+    /// last time the shadow textures were drawn. If the same camera
+    /// renders an unchanged scene again, the viewports of the shadow
+    /// textures are left out of the update, so receivers sample the
+    /// textures drawn before. The shadow cameras are still set up as
+    /// usual and come out the same, as do the texture matrices.
+    ///
+    /// The textures are shared by all cameras of the scene, so only the
+    /// camera that drew them last can reuse them.
+    class GZ_RENDERING_VISIBLE ShadowMapCache : public Ogre::SceneManager::Listener
+    {
+      /// \brief Constructor. Starts listening to the scene manager.
+      /// \param[in] _sceneMgr Scene manager whose shadows to cache.
+      public: explicit ShadowMapCache(Ogre::SceneManager *_sceneMgr);
+
+      /// \brief Destructor. Stops listening and lets the shadow textures
+      /// update again.
+      public: virtual ~ShadowMapCache();
+
+      /// \brief Check the GAZEBO_SHADOW_CACHE environment variable.
+      /// \return True if shadow textures should be reused.
+      public: static bool Enabled();
+
+      // Documentation inherited
+      public: void preUpdateSceneGraph(Ogre::SceneManager *_source,
+                  Ogre::Camera *_camera) override;
+
+      /// \brief Check if the last camera render reused the shadow textures.
+      /// \return True if the shadow textures were not drawn again.
+      public: bool Reused() const;
+
+      /// \brief Enable or disable updates of the shadow textures.
+      /// \param[in] _enabled False to keep the current content.
+      private: void SetShadowUpdates(const bool _enabled);
+
+      /// \brief Gather everything the shadow textures depend on.
+      /// \param[in] _camera Camera about to render.
+      /// \return Camera, light and shadow texture state.
+      private: std::vector<double> State(Ogre::Camera *_camera) const;
+
+      /// \brief Scene manager whose shadows are cached.
+      private: Ogre::SceneManager *sceneMgr;
+
+      /// \brief Camera that drew the shadow textures last.
+      private: Ogre::Camera *camera = nullptr;
+
+      /// \brief State when the shadow textures were drawn.
+      private: std::vector<double> state;
+
+      /// \brief Visual::LatestChangeStamp() when the shadow textures were
+      /// drawn.
+      private: uint64_t stamp = 0;
+
+      /// \brief Number of renders that reused the textures in a row.
+      private: unsigned int reuseCount = 0;
+
+      /// \brief True if the last camera render reused the textures.
+      private: bool reused = false;
+    };
+  }
+}
+#endif
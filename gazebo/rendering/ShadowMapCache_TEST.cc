@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "gazebo/rendering/RenderingIface.hh"
+#include "gazebo/rendering/Scene.hh"
+#include "gazebo/rendering/ShadowMapCache.hh"
+#include "gazebo/rendering/Visual.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+class ShadowMapCache_TEST : public RenderingFixture
+{
+};
+
+/////////////////////////////////////////////////
+TEST_F(ShadowMapCache_TEST, Reuse)
+{
+  Load("worlds/shapes.world");
+
+  rendering::ScenePtr scene = rendering::get_scene("default");
+  if (!scene)
+    scene = rendering::create_scene("default", false);
+  ASSERT_TRUE(scene != nullptr);
+
+  // Wait for the model visuals
+  rendering::VisualPtr box;
+  for (int i = 0; i < 100 && !box; ++i)
+  {
+    scene->PreRender();
+    box = scene->GetVisual("box");
+    common::Time::MSleep(10);
+  }
+  ASSERT_TRUE(box != nullptr);
+
+  scene->SetShadowsEnabled(true);
+
+  rendering::CameraPtr camera = scene->CreateCamera("shadow_camera", false);
+  ASSERT_TRUE(camera != nullptr);
+  camera->Load();
+  camera->Init();
+  camera->SetImageWidth(64);
+  camera->SetImageHeight(64);
+  camera->CreateRenderTexture("shadow_camera_rtt");
+  camera->SetWorldPose(ignition::math::Pose3d(-5, 0, 0.5, 0, 0, 0));
+
+  rendering::ShadowMapCache cache(scene->OgreSceneManager());
+
+  // The first render draws the shadows, the next one reuses them
+  camera->Render(true);
+  EXPECT_FALSE(cache.Reused());
+  camera->Render(true);
+  EXPECT_TRUE(cache.Reused());
+
+  // A visual moves
+  ignition::math::Pose3d boxPose = box->WorldPose();
+  box->SetWorldPose(boxPose + ignition::math::Pose3d(0, 0, 0.1, 0, 0, 0));
+  camera->Render(true);
+  EXPECT_FALSE(cache.Reused());
+  camera->Render(true);
+  EXPECT_TRUE(cache.Reused());
+
+  // The camera moves
+  camera->SetWorldPose(ignition::math::Pose3d(-5, 0, 1, 0, 0, 0));
+  camera->Render(true);
+  EXPECT_FALSE(cache.Reused());
+
+  box->SetWorldPose(boxPose);
+  scene->RemoveCamera(camera->Name());
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
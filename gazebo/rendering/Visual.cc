@@ -14,6 +14,9 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <utility>
+
 #include <boost/bind/bind.hpp>
 #include <boost/function.hpp>
 #include <boost/lexical_cast.hpp>
@@ -41,15 +44,18 @@
 #include "gazebo/rendering/JointVisual.hh"
 #include "gazebo/rendering/LinkFrameVisual.hh"
 #include "gazebo/rendering/Material.hh"
+#include "gazebo/rendering/MeshLod.hh"
 #include "gazebo/rendering/MovableText.hh"
 #include "gazebo/rendering/ogre_gazebo.h"
 #include "gazebo/rendering/RenderEngine.hh"
 #include "gazebo/rendering/RenderEvents.hh"
+#include "gazebo/rendering/ResourceCollector.hh"
 #include "gazebo/rendering/RTShaderSystem.hh"
 #include "gazebo/rendering/Scene.hh"
 #include "gazebo/rendering/SelectionObj.hh"
 #include "gazebo/rendering/Visual.hh"
 #include "gazebo/rendering/VisualPrivate.hh"
+#include "gazebo/rendering/VisualInstancer.hh"
 #include "gazebo/rendering/WireBox.hh"
 
 using namespace gazebo;
@@ -58,6 +64,8 @@ using namespace rendering;
 // Note: The value of ignition::math::MAX_UI32 is reserved as a flag.
 uint32_t VisualPrivate::visualIdCount = ignition::math::MAX_UI32 - 1;
 
+std::atomic<uint64_t> VisualPrivate::changeCounter(0);
+
 //////////////////////////////////////////////////
 Visual::Visual(const std::string &_name, VisualPtr _parent, bool _useRTShader)
   : dataPtr(new VisualPrivate)
@@ -193,6 +201,7 @@ Visual::~Visual()
 /////////////////////////////////////////////////
 void Visual::Fini()
 {
+  this->MarkChanged();
   // Terminate callbacks before clearing other pointers
   this->dataPtr->preRenderConnection.reset();
 
@@ -218,6 +227,9 @@ void Visual::Fini()
 
   this->dataPtr->lines.clear();
 
+  this->dataPtr->instanceable = false;
+  this->UpdateInstancing();
+
   if (this->dataPtr->sceneNode)
   {
     this->DestroyAllAttachedMovableObjects(this->dataPtr->sceneNode);
@@ -226,6 +238,14 @@ void Visual::Fini()
   }
   this->dataPtr->sceneNode = nullptr;
 
+  // The entities are gone, let the resources go once unused
+  for (auto const &mesh : this->dataPtr->meshReferences)
+    ResourceCollector::ReleaseMesh(mesh.first, mesh.second);
+  this->dataPtr->meshReferences.clear();
+  for (auto const &material : this->dataPtr->materialReferences)
+    ResourceCollector::ReleaseMaterial(material);
+  this->dataPtr->materialReferences.clear();
+
   if (this->dataPtr->scene &&
       this->dataPtr->scene->GetVisual(this->dataPtr->id))
   {
@@ -528,6 +548,9 @@ void Visual::Load()
   // Set invisible if this visual's layer is not active
   if (!this->dataPtr->scene->LayerState(this->dataPtr->layer))
     this->SetVisible(false);
+
+  this->dataPtr->instanceable = ent != nullptr;
+  this->UpdateInstancing();
 }
 
 //////////////////////////////////////////////////
@@ -589,6 +612,7 @@ std::string Visual::Name() const
 //////////////////////////////////////////////////
 void Visual::AttachVisual(VisualPtr _vis)
 {
+  this->MarkChanged();
   if (!_vis)
     gzerr << "Visual is null" << std::endl;
   else
@@ -607,6 +631,7 @@ void Visual::AttachVisual(VisualPtr _vis)
 //////////////////////////////////////////////////
 void Visual::DetachVisual(VisualPtr _vis)
 {
+  this->MarkChanged();
   this->DetachVisual(_vis->Name());
 }
 
@@ -630,6 +655,7 @@ void Visual::DetachVisual(const std::string &_name)
 //////////////////////////////////////////////////
 void Visual::AttachObject(Ogre::MovableObject *_obj)
 {
+  this->MarkChanged();
   // This code makes plane render before grids. This allows grids to overlay
   // planes, and then other elements to overlay both planes and grids.
   // if (this->dataPtr->sdf->HasElement("geometry"))
@@ -657,7 +683,20 @@ void Visual::AttachObject(Ogre::MovableObject *_obj)
           // to restore material state when setting transparency
           this->dataPtr->submeshMaterials[newMaterialName] = material;
 
-          material = material->clone(newMaterialName);
+          // A visual spawned again with the same name finds the material
+          // kept by the ResourceCollector
+          if (Ogre::MaterialManager::getSingleton().resourceExists(
+                newMaterialName))
+          {
+            material = Ogre::MaterialManager::getSingleton().getByName(
+                newMaterialName);
+          }
+          else
+          {
+            material = material->clone(newMaterialName);
+          }
+          if (this->dataPtr->materialReferences.insert(newMaterialName).second)
+            ResourceCollector::AcquireMaterial(newMaterialName);
           subEntity->setMaterial(material);
         }
       }
@@ -700,6 +739,10 @@ unsigned int Visual::GetAttachedObjectCount() const
 //////////////////////////////////////////////////
 void Visual::DetachObjects()
 {
+  this->MarkChanged();
+  this->dataPtr->instanceable = false;
+  this->UpdateInstancing();
+
   if (this->dataPtr->sceneNode)
     this->dataPtr->sceneNode->detachAllObjects();
   this->dataPtr->meshName = "";
@@ -762,6 +805,16 @@ Ogre::MovableObject *Visual::AttachMesh(const std::string &_meshName,
   if (objName.empty())
     objName = this->dataPtr->sceneNode->getName() + "_ENTITY_" + meshName;
 
+  // Reference the mesh first, so it isn't removed while being attached
+  auto reference = std::make_pair(_meshName, _subMesh);
+  if (std::find(this->dataPtr->meshReferences.begin(),
+        this->dataPtr->meshReferences.end(), reference) ==
+      this->dataPtr->meshReferences.end())
+  {
+    ResourceCollector::AcquireMesh(_meshName, _subMesh);
+    this->dataPtr->meshReferences.push_back(reference);
+  }
+
   this->InsertMesh(_meshName, _subMesh, _centerSubmesh);
 
   if (this->dataPtr->sceneNode->getCreator()->hasEntity(objName))
@@ -807,6 +860,7 @@ Ogre::MovableObject *Visual::AttachMesh(const std::string &_meshName,
 //////////////////////////////////////////////////
 void Visual::SetScale(const ignition::math::Vector3d &_scale)
 {
+  this->MarkChanged();
   if (this->dataPtr->scale == _scale)
     return;
 
@@ -933,6 +987,7 @@ ignition::math::Vector3d Visual::DerivedScale() const
 //////////////////////////////////////////////////
 void Visual::SetLighting(bool _lighting)
 {
+  this->MarkChanged();
   if (this->dataPtr->lighting == _lighting)
     return;
 
@@ -997,6 +1052,8 @@ void Visual::SetLighting(bool _lighting)
 
   this->dataPtr->sdf->GetElement("material")
       ->GetElement("lighting")->Set(this->dataPtr->lighting);
+
+  this->UpdateInstancing();
 }
 
 //////////////////////////////////////////////////
@@ -1009,6 +1066,7 @@ bool Visual::GetLighting() const
 void Visual::SetMaterial(const std::string &_materialName, bool _unique,
     const bool _cascade)
 {
+  this->MarkChanged();
   if (_materialName.empty() || _materialName == "__default__")
     return;
 
@@ -1074,6 +1132,12 @@ void Visual::SetMaterial(const std::string &_materialName, bool _unique,
     {
       myMaterial = origMaterial->clone(this->dataPtr->myMaterialName);
     }
+
+    if (this->dataPtr->materialReferences.insert(
+          this->dataPtr->myMaterialName).second)
+    {
+      ResourceCollector::AcquireMaterial(this->dataPtr->myMaterialName);
+    }
   }
   else
   {
@@ -1136,12 +1200,15 @@ void Visual::SetMaterial(const std::string &_materialName, bool _unique,
 
   this->dataPtr->sdf->GetElement("material")->GetElement("script")
       ->GetElement("name")->Set(_materialName);
+
+  this->UpdateInstancing();
 }
 
 /////////////////////////////////////////////////
 void Visual::SetMaterialShaderParam(const std::string &_paramName,
     const std::string &_shaderType, const std::string &_value)
 {
+  this->MarkChanged();
   // currently only vertex and fragment shaders are supported
   if (_shaderType != "vertex" && _shaderType != "fragment")
   {
@@ -1255,6 +1322,7 @@ void Visual::SetMaterialShaderParam(const std::string &_paramName,
 void Visual::SetAmbient(const ignition::math::Color &_color,
     const bool _cascade)
 {
+  this->MarkChanged();
   if (!this->dataPtr->lighting)
     return;
 
@@ -1314,12 +1382,15 @@ void Visual::SetAmbient(const ignition::math::Color &_color,
 
   this->dataPtr->sdf->GetElement("material")
       ->GetElement("ambient")->Set(_color);
+
+  this->UpdateInstancing();
 }
 
 /////////////////////////////////////////////////
 void Visual::SetDiffuse(const ignition::math::Color &_color,
     const bool _cascade)
 {
+  this->MarkChanged();
   if (!this->dataPtr->lighting)
     return;
 
@@ -1390,6 +1461,7 @@ void Visual::SetDiffuse(const ignition::math::Color &_color,
 void Visual::SetSpecular(const ignition::math::Color &_color,
     const bool _cascade)
 {
+  this->MarkChanged();
   if (!this->dataPtr->lighting)
     return;
 
@@ -1455,6 +1527,7 @@ void Visual::SetSpecular(const ignition::math::Color &_color,
 void Visual::SetEmissive(const ignition::math::Color &_color,
     const bool _cascade)
 {
+  this->MarkChanged();
   for (unsigned int i = 0; i < this->dataPtr->sceneNode->numAttachedObjects();
       i++)
   {
@@ -1504,6 +1577,8 @@ void Visual::SetEmissive(const ignition::math::Color &_color,
 
   this->dataPtr->sdf->GetElement("material")
       ->GetElement("emissive")->Set(_color);
+
+  this->UpdateInstancing();
 }
 
 /////////////////////////////////////////////////
@@ -1533,6 +1608,7 @@ ignition::math::Color Visual::Emissive() const
 //////////////////////////////////////////////////
 void Visual::SetWireframe(bool _show)
 {
+  this->MarkChanged();
   if (this->dataPtr->type == VT_GUI || this->dataPtr->type == VT_PHYSICS ||
       this->dataPtr->type == VT_SENSOR)
     return;
@@ -1585,6 +1661,8 @@ void Visual::SetWireframe(bool _show)
       }
     }
   }
+
+  this->UpdateInstancing();
 }
 
 //////////////////////////////////////////////////
@@ -1718,6 +1796,7 @@ void Visual::SetTransparencyInnerLoop(Ogre::SceneNode *_sceneNode)
 //////////////////////////////////////////////////
 void Visual::UpdateTransparency(const bool _cascade)
 {
+  this->MarkChanged();
   this->SetTransparencyInnerLoop(this->dataPtr->sceneNode);
 
   if (_cascade)
@@ -1740,6 +1819,8 @@ void Visual::UpdateTransparency(const bool _cascade)
 
   this->dataPtr->sdf->GetElement("transparency")->Set(
       this->dataPtr->transparency);
+
+  this->UpdateInstancing();
 }
 
 //////////////////////////////////////////////////
@@ -1769,6 +1850,7 @@ bool Visual::InheritTransparency() const
 //////////////////////////////////////////////////
 void Visual::SetHighlighted(bool _highlighted)
 {
+  this->MarkChanged();
   if (_highlighted)
   {
     auto bbox = this->BoundingBox();
@@ -1842,6 +1924,7 @@ float Visual::DerivedTransparency() const
 //////////////////////////////////////////////////
 void Visual::SetCastShadows(bool _shadows)
 {
+  this->MarkChanged();
   for (int i = 0; i < this->dataPtr->sceneNode->numAttachedObjects(); i++)
   {
     Ogre::MovableObject *obj = this->dataPtr->sceneNode->getAttachedObject(i);
@@ -1864,6 +1947,7 @@ bool Visual::GetCastShadows() const
 //////////////////////////////////////////////////
 void Visual::SetVisible(bool _visible, bool _cascade)
 {
+  this->MarkChanged();
   if (this->dataPtr->sceneNode)
     this->dataPtr->sceneNode->setVisible(_visible, _cascade);
 
@@ -1897,6 +1981,7 @@ bool Visual::GetVisible() const
 //////////////////////////////////////////////////
 void Visual::SetPosition(const ignition::math::Vector3d &_pos)
 {
+  this->MarkChanged();
   GZ_ASSERT(this->dataPtr->sceneNode, "Visual SceneNode is NULL");
   this->dataPtr->sceneNode->setPosition(_pos.X(), _pos.Y(), _pos.Z());
 
@@ -1906,6 +1991,7 @@ void Visual::SetPosition(const ignition::math::Vector3d &_pos)
 //////////////////////////////////////////////////
 void Visual::SetRotation(const ignition::math::Quaterniond &_rot)
 {
+  this->MarkChanged();
   GZ_ASSERT(this->dataPtr->sceneNode, "Visual SceneNode is null");
   this->dataPtr->sceneNode->setOrientation(
       Ogre::Quaternion(_rot.W(), _rot.X(), _rot.Y(), _rot.Z()));
@@ -1916,8 +2002,15 @@ void Visual::SetRotation(const ignition::math::Quaterniond &_rot)
 //////////////////////////////////////////////////
 void Visual::SetPose(const ignition::math::Pose3d &_pose)
 {
-  this->SetPosition(_pose.Pos());
-  this->SetRotation(_pose.Rot());
+  this->MarkChanged();
+  GZ_ASSERT(this->dataPtr->sceneNode, "Visual SceneNode is null");
+  this->dataPtr->sceneNode->setPosition(
+      _pose.Pos().X(), _pose.Pos().Y(), _pose.Pos().Z());
+  this->dataPtr->sceneNode->setOrientation(Ogre::Quaternion(
+      _pose.Rot().W(), _pose.Rot().X(), _pose.Rot().Y(), _pose.Rot().Z()));
+
+  // Called for every moving visual each frame, update the SDF only once
+  this->dataPtr->sdf->GetElement("pose")->Set(this->Pose());
 }
 
 //////////////////////////////////////////////////
@@ -1961,6 +2054,7 @@ void Visual::SetWorldPose(const ignition::math::Pose3d &_pose)
 //////////////////////////////////////////////////
 void Visual::SetWorldPosition(const ignition::math::Vector3d &_pos)
 {
+  this->MarkChanged();
   if (!this->dataPtr->sceneNode)
     return;
   this->dataPtr->sceneNode->_setDerivedPosition(Conversions::Convert(_pos));
@@ -1969,6 +2063,7 @@ void Visual::SetWorldPosition(const ignition::math::Vector3d &_pos)
 //////////////////////////////////////////////////
 void Visual::SetWorldRotation(const ignition::math::Quaterniond &_q)
 {
+  this->MarkChanged();
   if (!this->dataPtr->sceneNode)
     return;
   this->dataPtr->sceneNode->_setDerivedOrientation(Conversions::Convert(_q));
@@ -2035,6 +2130,7 @@ std::string Visual::GetNormalMap() const
 //////////////////////////////////////////////////
 void Visual::SetNormalMap(const std::string &_nmap)
 {
+  this->MarkChanged();
   this->dataPtr->sdf->GetElement("material")->GetElement(
       "shader")->GetElement("normal_map")->GetValue()->Set(_nmap);
   if (this->dataPtr->useRTShader && this->dataPtr->scene->Initialized())
@@ -2051,10 +2147,13 @@ std::string Visual::GetShaderType() const
 //////////////////////////////////////////////////
 void Visual::SetShaderType(const std::string &_type)
 {
+  this->MarkChanged();
   this->dataPtr->sdf->GetElement("material")->GetElement(
       "shader")->GetAttribute("type")->Set(_type);
   if (this->dataPtr->useRTShader && this->dataPtr->scene->Initialized())
     RTShaderSystem::Instance()->UpdateShaders();
+
+  this->UpdateInstancing();
 }
 
 
@@ -2293,6 +2392,14 @@ void Visual::InsertMesh(const common::Mesh *_mesh, const std::string &_subMesh,
           Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
     }
 
+    // Large meshes get levels of detail, built once and cached on disk
+    const bool lod = _subMesh.empty() && MeshLod::Wanted(_mesh);
+    if (lod && MeshLod::LoadCached(_mesh, ogreMesh.get()))
+    {
+      ogreMesh->load();
+      return;
+    }
+
     Ogre::SkeletonPtr ogreSkeleton;
 
     if (_mesh->HasSkeleton())
@@ -2334,37 +2441,36 @@ void Visual::InsertMesh(const common::Mesh *_mesh, const std::string &_subMesh,
       Ogre::HardwareVertexBufferSharedPtr vBuf;
       Ogre::HardwareIndexBufferSharedPtr iBuf;
       Ogre::HardwareVertexBufferSharedPtr texBuf;
-      float *vertices;
-      float *texMappings = nullptr;
-      uint32_t *indices;
 
       size_t currOffset = 0;
 
-      // Copy the original submesh. We may need to modify the vertices, and
-      // we don't want to change the original.
-      common::SubMesh subMesh(_mesh->GetSubMesh(i));
+      const common::SubMesh *subMesh = _mesh->GetSubMesh(i);
 
-      // Recenter the vertices if requested.
+      // Recenter the vertices if requested. The offset is applied while
+      // filling the vertex buffer so the submesh is not copied.
+      ignition::math::Vector3d offset;
       if (_centerSubmesh)
-        subMesh.Center(ignition::math::Vector3d::Zero);
+      {
+        offset = -(subMesh->Min() + (subMesh->Max() - subMesh->Min()) * 0.5);
+      }
 
       ogreSubMesh = ogreMesh->createSubMesh();
       ogreSubMesh->useSharedVertices = false;
-      if (subMesh.GetPrimitiveType() == common::SubMesh::TRIANGLES)
+      if (subMesh->GetPrimitiveType() == common::SubMesh::TRIANGLES)
         ogreSubMesh->operationType = Ogre::RenderOperation::OT_TRIANGLE_LIST;
-      else if (subMesh.GetPrimitiveType() == common::SubMesh::LINES)
+      else if (subMesh->GetPrimitiveType() == common::SubMesh::LINES)
         ogreSubMesh->operationType = Ogre::RenderOperation::OT_LINE_LIST;
-      else if (subMesh.GetPrimitiveType() == common::SubMesh::LINESTRIPS)
+      else if (subMesh->GetPrimitiveType() == common::SubMesh::LINESTRIPS)
         ogreSubMesh->operationType = Ogre::RenderOperation::OT_LINE_STRIP;
-      else if (subMesh.GetPrimitiveType() == common::SubMesh::TRIFANS)
+      else if (subMesh->GetPrimitiveType() == common::SubMesh::TRIFANS)
         ogreSubMesh->operationType = Ogre::RenderOperation::OT_TRIANGLE_FAN;
-      else if (subMesh.GetPrimitiveType() == common::SubMesh::TRISTRIPS)
+      else if (subMesh->GetPrimitiveType() == common::SubMesh::TRISTRIPS)
         ogreSubMesh->operationType = Ogre::RenderOperation::OT_TRIANGLE_STRIP;
-      else if (subMesh.GetPrimitiveType() == common::SubMesh::POINTS)
+      else if (subMesh->GetPrimitiveType() == common::SubMesh::POINTS)
         ogreSubMesh->operationType = Ogre::RenderOperation::OT_POINT_LIST;
       else
         gzerr << "Unknown primitive type["
-              << subMesh.GetPrimitiveType() << "]\n";
+              << subMesh->GetPrimitiveType() << "]\n";
 
       ogreSubMesh->vertexData = new Ogre::VertexData();
       vertexData = ogreSubMesh->vertexData;
@@ -2379,7 +2485,7 @@ void Visual::InsertMesh(const common::Mesh *_mesh, const std::string &_subMesh,
       // TODO: blending weights
 
       // normals
-      if (subMesh.GetNormalCount() > 0)
+      if (subMesh->GetNormalCount() > 0)
       {
         vertexDecl->addElement(0, currOffset, Ogre::VET_FLOAT3,
                                Ogre::VES_NORMAL);
@@ -2396,7 +2502,7 @@ void Visual::InsertMesh(const common::Mesh *_mesh, const std::string &_subMesh,
       // see `https://ogrecave.github.io/ogre/api/1.11/_animation.html` under,
       // `Vertex buffer arrangements`.
       currOffset = 0;
-      if (subMesh.GetTexCoordCount() > 0)
+      if (subMesh->GetTexCoordCount() > 0)
       {
         vertexDecl->addElement(1, currOffset, Ogre::VET_FLOAT2,
             Ogre::VES_TEXTURE_COORDINATES, 0);
@@ -2404,42 +2510,43 @@ void Visual::InsertMesh(const common::Mesh *_mesh, const std::string &_subMesh,
       }
 
       // allocate the vertex buffer
-      vertexData->vertexCount = subMesh.GetVertexCount();
+      vertexData->vertexCount = subMesh->GetVertexCount();
 
       vBuf = Ogre::HardwareBufferManager::getSingleton().createVertexBuffer(
                  vertexDecl->getVertexSize(0),
                  vertexData->vertexCount,
                  Ogre::HardwareBuffer::HBU_STATIC_WRITE_ONLY,
-                 false);
+                 lod);
 
-      if (subMesh.GetTexCoordCount() > 0)
+      if (subMesh->GetTexCoordCount() > 0)
       {
         texBuf = Ogre::HardwareBufferManager::getSingleton().createVertexBuffer(
             vertexDecl->getVertexSize(1),
             vertexData->vertexCount,
             Ogre::HardwareBuffer::HBU_STATIC_WRITE_ONLY,
-            false);
+            lod);
       }
 
       vertexData->vertexBufferBinding->setBinding(0, vBuf);
-      vertices = static_cast<float*>(vBuf->lock(
-                      Ogre::HardwareBuffer::HBL_DISCARD));
+      subMesh->FillVertexBuffer(static_cast<float *>(
+          vBuf->lock(Ogre::HardwareBuffer::HBL_DISCARD)),
+          subMesh->GetNormalCount() > 0, offset);
 
-      if (subMesh.GetTexCoordCount() > 0)
+      if (subMesh->GetTexCoordCount() > 0)
       {
         vertexData->vertexBufferBinding->setBinding(1, texBuf);
-        texMappings = static_cast<float*>(texBuf->lock(
-                        Ogre::HardwareBuffer::HBL_DISCARD));
+        subMesh->FillTexCoordBuffer(static_cast<float *>(
+            texBuf->lock(Ogre::HardwareBuffer::HBL_DISCARD)));
       }
 
       if (_mesh->HasSkeleton())
       {
-        if (subMesh.GetNodeAssignmentsCount() > 0)
+        if (subMesh->GetNodeAssignmentsCount() > 0)
         {
           common::Skeleton *skel = _mesh->GetSkeleton();
-          for (unsigned int j = 0; j < subMesh.GetNodeAssignmentsCount(); j++)
+          for (unsigned int j = 0; j < subMesh->GetNodeAssignmentsCount(); j++)
           {
-            common::NodeAssignment na = subMesh.GetNodeAssignment(j);
+            common::NodeAssignment na = subMesh->GetNodeAssignment(j);
             Ogre::VertexBoneAssignment vba;
             vba.vertexIndex = na.vertexIndex;
             vba.boneIndex = ogreSkeleton->getBone(skel->GetNodeByHandle(
@@ -2463,49 +2570,27 @@ void Visual::InsertMesh(const common::Mesh *_mesh, const std::string &_subMesh,
         }
       }
 
-      // allocate index buffer
-      ogreSubMesh->indexData->indexCount = subMesh.GetIndexCount();
+      // allocate index buffer, half the size when the indices allow it
+      ogreSubMesh->indexData->indexCount = subMesh->GetIndexCount();
+      const bool indices16 = subMesh->IndicesFit16Bit();
 
       ogreSubMesh->indexData->indexBuffer =
         Ogre::HardwareBufferManager::getSingleton().createIndexBuffer(
-            Ogre::HardwareIndexBuffer::IT_32BIT,
+            indices16 ? Ogre::HardwareIndexBuffer::IT_16BIT :
+                        Ogre::HardwareIndexBuffer::IT_32BIT,
             ogreSubMesh->indexData->indexCount,
             Ogre::HardwareBuffer::HBU_STATIC_WRITE_ONLY,
-            false);
+            lod);
 
       iBuf = ogreSubMesh->indexData->indexBuffer;
-      indices = static_cast<uint32_t*>(
-          iBuf->lock(Ogre::HardwareBuffer::HBL_DISCARD));
-
-      unsigned int j;
-
-      // Add all the vertices
-      for (j = 0; j < subMesh.GetVertexCount(); j++)
-      {
-        *vertices++ = subMesh.Vertex(j).X();
-        *vertices++ = subMesh.Vertex(j).Y();
-        *vertices++ = subMesh.Vertex(j).Z();
-
-        if (subMesh.GetNormalCount() > 0)
-        {
-          *vertices++ = subMesh.Normal(j).X();
-          *vertices++ = subMesh.Normal(j).Y();
-          *vertices++ = subMesh.Normal(j).Z();
-        }
-
-        if (subMesh.GetTexCoordCount() > 0)
-        {
-          *texMappings++ = subMesh.TexCoord(j).X();
-          *texMappings++ = subMesh.TexCoord(j).Y();
-        }
-      }
-
-      // Add all the indices
-      for (j = 0; j < subMesh.GetIndexCount(); j++)
-        *indices++ = subMesh.GetIndex(j);
+      void *indices = iBuf->lock(Ogre::HardwareBuffer::HBL_DISCARD);
+      if (indices16)
+        subMesh->FillIndexBuffer(static_cast<uint16_t *>(indices));
+      else
+        subMesh->FillIndexBuffer(static_cast<uint32_t *>(indices));
 
       const common::Material *material;
-      material = _mesh->GetMaterial(subMesh.GetMaterialIndex());
+      material = _mesh->GetMaterial(subMesh->GetMaterialIndex());
       if (material)
       {
         rendering::Material::Update(material);
@@ -2519,7 +2604,7 @@ void Visual::InsertMesh(const common::Mesh *_mesh, const std::string &_subMesh,
       // Unlock
       vBuf->unlock();
       iBuf->unlock();
-      if (subMesh.GetTexCoordCount() > 0)
+      if (subMesh->GetTexCoordCount() > 0)
       {
         texBuf->unlock();
       }
@@ -2547,6 +2632,10 @@ void Visual::InsertMesh(const common::Mesh *_mesh, const std::string &_subMesh,
 
     // this line makes clear the mesh is loaded (avoids memory leaks)
     ogreMesh->load();
+
+    // Shadow buffers are read by the generator
+    if (lod)
+      MeshLod::Generate(_mesh, ogreMesh.get());
   }
   catch(Ogre::Exception &e)
   {
@@ -2905,33 +2994,32 @@ std::string Visual::GetMeshName() const
       return "unit_plane";
     else if (geomElem->HasElement("polyline"))
     {
-      std::string polyLineName = this->Name();
       common::MeshManager *meshManager = common::MeshManager::Instance();
+      sdf::ElementPtr polylineElem = geomElem->GetElement("polyline");
+      double height = polylineElem->Get<double>("height");
 
-      if (!meshManager->IsValidFilename(polyLineName))
+      std::vector<std::vector<ignition::math::Vector2d> > polylines;
+      while (polylineElem)
       {
-        sdf::ElementPtr polylineElem = geomElem->GetElement("polyline");
-
-        std::vector<std::vector<ignition::math::Vector2d> > polylines;
-        while (polylineElem)
+        std::vector<ignition::math::Vector2d> vertices;
+        sdf::ElementPtr pointElem = polylineElem->GetElement("point");
+        while (pointElem)
         {
-          std::vector<ignition::math::Vector2d> vertices;
-          sdf::ElementPtr pointElem = polylineElem->GetElement("point");
-          while (pointElem)
-          {
-            ignition::math::Vector2d point =
-              pointElem->Get<ignition::math::Vector2d>();
-            vertices.push_back(point);
-            pointElem = pointElem->GetNextElement("point");
-          }
-          polylineElem = polylineElem->GetNextElement("polyline");
-          polylines.push_back(vertices);
+          ignition::math::Vector2d point =
+            pointElem->Get<ignition::math::Vector2d>();
+          vertices.push_back(point);
+          pointElem = pointElem->GetNextElement("point");
         }
-
-        meshManager->CreateExtrudedPolyline(polyLineName, polylines,
-            geomElem->GetElement("polyline")->Get<double>("height"));
+        polylineElem = polylineElem->GetNextElement("polyline");
+        polylines.push_back(vertices);
       }
 
+      // Identical polylines, such as the collision of this visual's link,
+      // share one triangulation
+      std::string polyLineName =
+          common::MeshManager::ExtrudedPolylineMeshName(polylines, height);
+      meshManager->CreateExtrudedPolyline(polyLineName, polylines, height);
+
       if (meshManager->HasMesh(polyLineName))
         return polyLineName;
       else
@@ -3200,6 +3288,7 @@ void Visual::ShowSkeleton(bool _show)
 //////////////////////////////////////////////////
 void Visual::SetVisibilityFlags(uint32_t _flags)
 {
+  this->MarkChanged();
   for (std::vector<VisualPtr>::iterator iter = this->dataPtr->children.begin();
        iter != this->dataPtr->children.end(); ++iter)
   {
@@ -3378,6 +3467,7 @@ void Visual::ShowLinkFrame(bool _show)
 //////////////////////////////////////////////////
 void Visual::SetSkeletonPose(const msgs::PoseAnimation &_pose)
 {
+  this->MarkChanged();
   if (!this->dataPtr->skeleton)
   {
     gzerr << "Visual " << this->Name() << " has no skeleton.\n";
@@ -3504,10 +3594,50 @@ Visual::VisualType Visual::GetType() const
   return this->dataPtr->type;
 }
 
+//////////////////////////////////////////////////
+void Visual::UpdateInstancing()
+{
+  if (!this->dataPtr->scene || !this->dataPtr->sceneNode)
+    return;
+
+  VisualInstancer *instancer =
+      VisualInstancer::Find(this->dataPtr->scene->OgreSceneManager());
+  if (!instancer)
+    return;
+
+  // Start over, the look of the visual may have changed
+  instancer->RemoveVisual(this);
+
+  if (!this->dataPtr->instanceable || this->dataPtr->type != VT_VISUAL ||
+      this->dataPtr->wireframe ||
+      this->DerivedTransparency() > 0 ||
+      (this->GetShaderType() != "pixel" && this->GetShaderType() != "vertex"))
+  {
+    return;
+  }
+
+  // Only visuals drawing a single mesh entity
+  Ogre::Entity *entity = nullptr;
+  for (unsigned int i = 0; i < this->dataPtr->sceneNode->numAttachedObjects();
+      ++i)
+  {
+    Ogre::Entity *ent = dynamic_cast<Ogre::Entity *>(
+        this->dataPtr->sceneNode->getAttachedObject(i));
+    if (!ent)
+      continue;
+    if (entity)
+      return;
+    entity = ent;
+  }
+
+  instancer->AddVisual(this, entity);
+}
+
 //////////////////////////////////////////////////
 void Visual::SetType(const Visual::VisualType _type)
 {
   this->dataPtr->type = _type;
+  this->UpdateInstancing();
 }
 
 //////////////////////////////////////////////////
@@ -3838,3 +3968,21 @@ void Visual::FillMaterialMsg(ignition::msgs::Material &_msg) const
   else if (!this->GetShaderType().empty())
     gzerr << "Unrecognized shader type[" << this->GetShaderType() << "]\n";
 }
+
+//////////////////////////////////////////////////
+void Visual::MarkChanged()
+{
+  this->dataPtr->changeStamp = ++VisualPrivate::changeCounter;
+}
+
+//////////////////////////////////////////////////
+uint64_t Visual::ChangeStamp() const
+{
+  return this->dataPtr->changeStamp;
+}
+
+//////////////////////////////////////////////////
+uint64_t Visual::LatestChangeStamp()
+{
+  return VisualPrivate::changeCounter;
+}
@@ -591,6 +591,16 @@ namespace gazebo
       /// \brief Set the id associated with this visual
       public: void SetId(uint32_t _id);
 
+      /// \brief Get the stamp of the last change to the pose, look or
+      /// attached objects of this visual. Changes of parent visuals are not
+      /// included.
+      /// \return Stamp comparable with LatestChangeStamp().
+      public: uint64_t ChangeStamp() const;
+
+      /// \brief Get the stamp of the latest change to any visual.
+      /// \return Stamp increasing with every change.
+      public: static uint64_t LatestChangeStamp();
+
       /// \brief Get the geometry type.
       /// \return Type of geometry in string.
       public: std::string GetGeometryType() const;
@@ -746,6 +756,14 @@ namespace gazebo
       /// \param[in] _cascade True to update the children's transparency too.
       private: void UpdateTransparency(const bool _cascade = true);
 
+      /// \brief Draw the mesh of the visual through hardware instancing if
+      /// the scene instances visuals and the visual's look allows it, or
+      /// go back to drawing it on its own.
+      private: void UpdateInstancing();
+
+      /// \brief Record that the visual changed, see ChangeStamp().
+      private: void MarkChanged();
+
       /// \internal
       /// \brief Pointer to private data.
       protected: VisualPrivate *dataPtr;
@@ -0,0 +1,350 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cstdlib>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/rendering/VisualInstancer.hh"
+
+using namespace gazebo;
+using namespace rendering;
+
+/// \brief Render queue group of entities drawn through instancing. It is
+/// only drawn into shadow textures and the selection buffer.
+static const Ogre::uint8 kEntityQueueGroup = Ogre::RENDER_QUEUE_6;
+
+/// \brief Number of instances per batch.
+static const size_t kInstancesPerBatch = 80;
+
+/// \brief Material cloned for every instanced appearance.
+static const char kBaseMaterial[] = "Gazebo/Instanced";
+
+/// \brief Instancers by scene manager.
+static std::map<Ogre::SceneManager *, VisualInstancer *> instancers;
+
+/// \brief Protects instancers.
+static std::mutex instancersMutex;
+
+//////////////////////////////////////////////////
+VisualInstancer::VisualInstancer(Ogre::SceneManager *_sceneMgr)
+  : sceneMgr(_sceneMgr)
+{
+  this->sceneMgr->addRenderQueueListener(this);
+
+  std::lock_guard<std::mutex> lock(instancersMutex);
+  instancers[this->sceneMgr] = this;
+}
+
+//////////////////////////////////////////////////
+VisualInstancer::~VisualInstancer()
+{
+  {
+    std::lock_guard<std::mutex> lock(instancersMutex);
+    instancers.erase(this->sceneMgr);
+  }
+
+  while (!this->visuals.empty())
+    this->RemoveVisual(this->visuals.begin()->first);
+
+  for (auto const &manager : this->managers)
+  {
+    if (manager.second)
+      this->sceneMgr->destroyInstanceManager(manager.second);
+  }
+
+  for (auto const &material : this->materials)
+  {
+    if (!material.second.empty())
+      Ogre::MaterialManager::getSingleton().remove(material.second);
+  }
+
+  this->sceneMgr->removeRenderQueueListener(this);
+}
+
+//////////////////////////////////////////////////
+bool VisualInstancer::Enabled()
+{
+  const char *env = std::getenv("GAZEBO_VISUAL_INSTANCING");
+  if (!env || std::string(env) == "0")
+    return false;
+
+  Ogre::RenderSystem *renderSys = Ogre::Root::getSingleton().getRenderSystem();
+  return renderSys && renderSys->getCapabilities() &&
+      renderSys->getCapabilities()->hasCapability(
+        Ogre::RSC_VERTEX_BUFFER_INSTANCE_DATA);
+}
+
+//////////////////////////////////////////////////
+VisualInstancer *VisualInstancer::Find(Ogre::SceneManager *_sceneMgr)
+{
+  std::lock_guard<std::mutex> lock(instancersMutex);
+  auto iter = instancers.find(_sceneMgr);
+  return iter == instancers.end() ? nullptr : iter->second;
+}
+
+//////////////////////////////////////////////////
+bool VisualInstancer::AddVisual(const Visual *_visual, Ogre::Entity *_entity)
+{
+  if (!_entity || !_entity->getParentSceneNode() ||
+      this->visuals.find(_visual) != this->visuals.end() ||
+      _entity->hasSkeleton() || _entity->getNumSubEntities() == 0)
+  {
+    return false;
+  }
+
+  const Ogre::MeshPtr &mesh = _entity->getMesh();
+  if (mesh.isNull() ||
+      mesh->getNumSubMeshes() != _entity->getNumSubEntities())
+  {
+    return false;
+  }
+
+  // Every submesh has to be instanced, or none
+  std::vector<std::pair<Ogre::InstanceManager *, std::string>> parts;
+  for (unsigned int i = 0; i < _entity->getNumSubEntities(); ++i)
+  {
+    Ogre::InstanceManager *manager = this->Manager(mesh, i);
+    if (!manager)
+      return false;
+
+    std::string material =
+        this->InstancedMaterial(_entity->getSubEntity(i)->getMaterial());
+    if (material.empty())
+      return false;
+
+    parts.push_back(std::make_pair(manager, material));
+  }
+
+  Instance &instance = this->visuals[_visual];
+  instance.entity = _entity;
+  instance.queueGroup = _entity->getRenderQueueGroup();
+
+  Ogre::SceneNode *node = _entity->getParentSceneNode();
+  for (auto const &part : parts)
+  {
+    Ogre::InstancedEntity *inst =
+        part.first->createInstancedEntity(part.second);
+
+    // Entities cast the shadows, see renderQueueStarted
+    part.first->setSetting(Ogre::InstanceManager::CAST_SHADOWS, false,
+        part.second);
+
+    inst->setVisibilityFlags(_entity->getVisibilityFlags());
+    inst->setVisible(_entity->getVisible());
+    node->attachObject(inst);
+    instance.parts.push_back(inst);
+  }
+
+  _entity->setRenderQueueGroup(kEntityQueueGroup);
+  return true;
+}
+
+//////////////////////////////////////////////////
+void VisualInstancer::RemoveVisual(const Visual *_visual)
+{
+  auto iter = this->visuals.find(_visual);
+  if (iter == this->visuals.end())
+    return;
+
+  for (auto inst : iter->second.parts)
+  {
+    this->selectionHidden.erase(std::remove(this->selectionHidden.begin(),
+          this->selectionHidden.end(), inst), this->selectionHidden.end());
+
+    if (inst->isAttached())
+      inst->detachFromParent();
+    this->sceneMgr->destroyInstancedEntity(inst);
+  }
+
+  iter->second.entity->setRenderQueueGroup(iter->second.queueGroup);
+  this->visuals.erase(iter);
+}
+
+//////////////////////////////////////////////////
+void VisualInstancer::SetSelectionMode(const bool _selection)
+{
+  if (this->selectionMode == _selection)
+    return;
+  this->selectionMode = _selection;
+
+  if (_selection)
+  {
+    for (auto const &visual : this->visuals)
+    {
+      for (auto inst : visual.second.parts)
+      {
+        if (inst->getVisible())
+        {
+          inst->setVisible(false);
+          this->selectionHidden.push_back(inst);
+        }
+      }
+    }
+  }
+  else
+  {
+    for (auto inst : this->selectionHidden)
+      inst->setVisible(true);
+    this->selectionHidden.clear();
+  }
+}
+
+//////////////////////////////////////////////////
+size_t VisualInstancer::VisualCount() const
+{
+  return this->visuals.size();
+}
+
+//////////////////////////////////////////////////
+void VisualInstancer::renderQueueStarted(Ogre::uint8 _queueGroupId,
+    const Ogre::String &_invocation, bool &_skipThisInvocation)
+{
+  // Instanced entities do not fit the shadow caster programs, so the
+  // regular entities still cast the shadows
+  if (_queueGroupId == kEntityQueueGroup && !this->selectionMode &&
+      _invocation !=
+      Ogre::RenderQueueInvocation::RENDER_QUEUE_INVOCATION_SHADOWS)
+  {
+    _skipThisInvocation = true;
+  }
+}
+
+//////////////////////////////////////////////////
+std::string VisualInstancer::InstancedMaterial(
+    const Ogre::MaterialPtr &_material)
+{
+  if (_material.isNull())
+    return "";
+
+  // Only a single lit pass with at most a plain diffuse texture
+  Ogre::Technique *technique = _material->getTechnique(0);
+  if (!technique || technique->getNumPasses() != 1)
+    return "";
+
+  Ogre::Pass *pass = technique->getPass(0);
+  if (pass->hasVertexProgram() || pass->hasFragmentProgram() ||
+      pass->isTransparent() || !pass->getLightingEnabled() ||
+      pass->getSelfIllumination() != Ogre::ColourValue::Black ||
+      pass->getPolygonMode() != Ogre::PM_SOLID ||
+      pass->getNumTextureUnitStates() > 1)
+  {
+    return "";
+  }
+
+  std::string texture;
+  if (pass->getNumTextureUnitStates() == 1)
+  {
+    Ogre::TextureUnitState *unit = pass->getTextureUnitState(0);
+    if (unit->getTextureCoordSet() != 0 || !unit->getEffects().empty() ||
+        unit->getNumFrames() != 1 || unit->getTextureName().empty())
+    {
+      return "";
+    }
+    texture = unit->getTextureName();
+  }
+
+  // Visuals get their own copy of every material, so group them by what
+  // they look like rather than by name
+  const Ogre::ColourValue diffuse = pass->getDiffuse();
+  const Ogre::ColourValue ambient = pass->getAmbient();
+  std::ostringstream key;
+  key << diffuse.r << " " << diffuse.g << " " << diffuse.b << " " <<
+      diffuse.a << " " << ambient.r << " " << ambient.g << " " <<
+      ambient.b << " " << texture;
+
+  auto iter = this->materials.find(key.str());
+  if (iter != this->materials.end())
+    return iter->second;
+
+  std::string &name = this->materials[key.str()];
+
+  Ogre::MaterialPtr base =
+      Ogre::MaterialManager::getSingleton().getByName(kBaseMaterial);
+  if (base.isNull())
+  {
+    gzwarn << "Material [" << kBaseMaterial << "] not found, "
+           << "visuals will not be instanced\n";
+    return name;
+  }
+
+  std::ostringstream materialName;
+  materialName << kBaseMaterial << "/" << this->sceneMgr->getName() << "/" <<
+      this->materials.size();
+
+  Ogre::MaterialPtr material = base->clone(materialName.str());
+  Ogre::Pass *instancedPass = material->getTechnique(0)->getPass(0);
+  Ogre::GpuProgramParametersSharedPtr params =
+      instancedPass->getFragmentProgramParameters();
+  params->setNamedConstant("diffuseColor", diffuse);
+  params->setNamedConstant("ambientColor", ambient);
+  params->setNamedConstant("useTexture",
+      static_cast<Ogre::Real>(texture.empty() ? 0 : 1));
+  if (!texture.empty())
+    instancedPass->createTextureUnitState(texture);
+  material->load();
+
+  name = materialName.str();
+  return name;
+}
+
+//////////////////////////////////////////////////
+Ogre::InstanceManager *VisualInstancer::Manager(const Ogre::MeshPtr &_mesh,
+    const unsigned int _index)
+{
+  std::ostringstream key;
+  key << _mesh->getName() << "::" << _index;
+
+  auto iter = this->managers.find(key.str());
+  if (iter != this->managers.end())
+    return iter->second;
+
+  Ogre::InstanceManager *&manager = this->managers[key.str()];
+
+  // The instancing program reads the mesh's texture coordinates from the
+  // first set and the instance transform from the next three
+  Ogre::SubMesh *subMesh = _mesh->getSubMesh(_index);
+  Ogre::VertexData *vertexData = subMesh->useSharedVertices ?
+      _mesh->sharedVertexData : subMesh->vertexData;
+  if (!vertexData ||
+      vertexData->vertexDeclaration->getNextFreeTextureCoordinate() != 1 ||
+      !vertexData->vertexDeclaration->findElementBySemantic(Ogre::VES_NORMAL))
+  {
+    return manager;
+  }
+
+  try
+  {
+    manager = this->sceneMgr->createInstanceManager(
+        "VisualInstancer_" + key.str(), _mesh->getName(), _mesh->getGroup(),
+        Ogre::InstanceManager::HWInstancingBasic, kInstancesPerBatch, 0,
+        _index);
+  }
+  catch(Ogre::Exception &_e)
+  {
+    gzwarn << "Unable to instance mesh [" << key.str() << "]: "
+           << _e.getDescription() << "\n";
+    manager = nullptr;
+  }
+
+  return manager;
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GAZEBO_RENDERING_VISUALINSTANCER_HH_
+#define GAZEBO_RENDERING_VISUALINSTANCER_HH_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "gazebo/rendering/ogre_gazebo.h"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    class Visual;
+
+    /// \internal
+    /// \brief Draws visuals that share a mesh with hardware instancing.
+    ///
+    /// Each submesh of an instanced visual is drawn by an instanced entity
+    /// attached to the visual's scene node, so it follows the node's pose
+    /// and visibility. Instanced entities are grouped in batches of one
+    /// Ogre::InstanceManager per submesh, with one material per
+    /// combination of colors and texture.
+    ///
+    /// The visual keeps its regular entity, moved to a render queue group
+    /// that is only drawn into shadow textures and the selection buffer.
+    /// Ray queries, bounding boxes and selection therefore keep working
+    /// on the entity.
+    class GZ_RENDERING_VISIBLE VisualInstancer : public Ogre::RenderQueueListener
+    {
+      /// \brief Constructor.
+      /// \param[in] _sceneMgr Scene manager of the visuals.
+      public: explicit VisualInstancer(Ogre::SceneManager *_sceneMgr);
+
+      /// \brief Destructor. Releases every instance and batch.
+      public: virtual ~VisualInstancer();
+
+      /// \brief Check the GAZEBO_VISUAL_INSTANCING environment variable and
+      /// the render system capabilities.
+      /// \return True if visuals should be instanced.
+      public: static bool Enabled();
+
+      /// \brief Get the instancer of a scene manager.
+      /// \param[in] _sceneMgr Scene manager of the visuals.
+      /// \return The instancer, null if the scene does not instance.
+      public: static VisualInstancer *Find(Ogre::SceneManager *_sceneMgr);
+
+      /// \brief Draw a visual's entity through instancing if its mesh and
+      /// materials allow it. Does nothing otherwise.
+      /// \param[in] _visual The visual.
+      /// \param[in] _entity Entity holding the visual's mesh.
+      /// \return True if the visual is now instanced.
+      public: bool AddVisual(const Visual *_visual, Ogre::Entity *_entity);
+
+      /// \brief Go back to drawing a visual with its entity.
+      /// \param[in] _visual The visual.
+      public: void RemoveVisual(const Visual *_visual);
+
+      /// \brief Draw entities instead of instances, for the selection
+      /// buffer to tell the visuals apart.
+      /// \param[in] _selection True while rendering the selection buffer.
+      public: void SetSelectionMode(const bool _selection);
+
+      /// \brief Get the number of instanced visuals.
+      /// \return Number of visuals drawn through instancing.
+      public: size_t VisualCount() const;
+
+      // Documentation inherited
+      public: virtual void renderQueueStarted(Ogre::uint8 _queueGroupId,
+                  const Ogre::String &_invocation, bool &_skipThisInvocation);
+
+      /// \brief Get or create the material drawing instances like a pass.
+      /// \param[in] _material Material of a submesh.
+      /// \return Name of the instanced material, empty if the material
+      /// can not be instanced.
+      private: std::string InstancedMaterial(
+                   const Ogre::MaterialPtr &_material);
+
+      /// \brief Get or create the instance manager of a submesh.
+      /// \param[in] _mesh The mesh.
+      /// \param[in] _index Index of the submesh.
+      /// \return The manager, null if the submesh can not be instanced.
+      private: Ogre::InstanceManager *Manager(const Ogre::MeshPtr &_mesh,
+                   const unsigned int _index);
+
+      /// \brief An instanced visual.
+      private: class Instance
+      {
+        /// \brief Entity of the visual.
+        public: Ogre::Entity *entity = nullptr;
+
+        /// \brief Render queue group of the entity before instancing.
+        public: Ogre::uint8 queueGroup = 0;
+
+        /// \brief One instanced entity per submesh.
+        public: std::vector<Ogre::InstancedEntity *> parts;
+      };
+
+      /// \brief Scene manager of the visuals.
+      private: Ogre::SceneManager *sceneMgr;
+
+      /// \brief Instanced visuals.
+      private: std::map<const Visual *, Instance> visuals;
+
+      /// \brief Instance managers by mesh and submesh, null for submeshes
+      /// that can not be instanced.
+      private: std::map<std::string, Ogre::InstanceManager *> managers;
+
+      /// \brief Instanced materials by source appearance, empty for
+      /// materials that can not be instanced.
+      private: std::map<std::string, std::string> materials;
+
+      /// \brief True while rendering the selection buffer.
+      private: bool selectionMode = false;
+
+      /// \brief Instanced entities hidden during selection.
+      private: std::vector<Ogre::InstancedEntity *> selectionHidden;
+    };
+  }
+}
+#endif
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include "gazebo/rendering/ogre_gazebo.h"
+#include "gazebo/rendering/RenderingIface.hh"
+#include "gazebo/rendering/Scene.hh"
+#include "gazebo/rendering/Visual.hh"
+#include "gazebo/rendering/VisualInstancer.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+class VisualInstancer_TEST : public RenderingFixture
+{
+  /// \brief Create a box visual in a scene.
+  /// \param[in] _scene Scene to create the visual in.
+  /// \param[in] _name Name of the visual.
+  /// \return The new visual and its entity.
+  public: std::pair<rendering::VisualPtr, Ogre::Entity *> CreateBox(
+      rendering::ScenePtr _scene, const std::string &_name)
+  {
+    rendering::VisualPtr vis(
+        new rendering::Visual(_name, _scene->WorldVisual()));
+    vis->Load();
+    vis->AttachMesh("unit_box");
+    vis->SetMaterial("Gazebo/Grey");
+
+    Ogre::Entity *ent = nullptr;
+    Ogre::SceneNode *node = vis->GetSceneNode();
+    for (unsigned int i = 0; i < node->numAttachedObjects() && !ent; ++i)
+      ent = dynamic_cast<Ogre::Entity *>(node->getAttachedObject(i));
+    return std::make_pair(vis, ent);
+  }
+};
+
+/////////////////////////////////////////////////
+TEST_F(VisualInstancer_TEST, AddRemove)
+{
+  Load("worlds/empty.world");
+
+  rendering::ScenePtr scene = rendering::get_scene("default");
+  if (!scene)
+    scene = rendering::create_scene("default", false);
+  ASSERT_TRUE(scene != nullptr);
+
+  Ogre::RenderSystem *renderSys = Ogre::Root::getSingleton().getRenderSystem();
+  if (!renderSys || !renderSys->getCapabilities()->hasCapability(
+      Ogre::RSC_VERTEX_BUFFER_INSTANCE_DATA))
+  {
+    gzwarn << "Hardware instancing not supported, skipping test\n";
+    return;
+  }
+
+  rendering::VisualInstancer instancer(scene->OgreSceneManager());
+  EXPECT_EQ(rendering::VisualInstancer::Find(scene->OgreSceneManager()),
+      &instancer);
+  EXPECT_EQ(instancer.VisualCount(), 0u);
+
+  auto box1 = this->CreateBox(scene, "instanced_box1");
+  auto box2 = this->CreateBox(scene, "instanced_box2");
+  ASSERT_TRUE(box1.second != nullptr);
+  ASSERT_TRUE(box2.second != nullptr);
+
+  // Each visual gets an instance attached next to its entity
+  unsigned int objects = box1.first->GetSceneNode()->numAttachedObjects();
+  EXPECT_TRUE(instancer.AddVisual(box1.first.get(), box1.second));
+  EXPECT_TRUE(instancer.AddVisual(box2.first.get(), box2.second));
+  EXPECT_EQ(instancer.VisualCount(), 2u);
+  EXPECT_GT(box1.first->GetSceneNode()->numAttachedObjects(), objects);
+
+  // Selection renders the entities instead of the instances
+  Ogre::MovableObject *instance =
+      box1.first->GetSceneNode()->getAttachedObject(objects);
+  EXPECT_TRUE(instance->getVisible());
+  instancer.SetSelectionMode(true);
+  EXPECT_FALSE(instance->getVisible());
+  instancer.SetSelectionMode(false);
+  EXPECT_TRUE(instance->getVisible());
+
+  instancer.RemoveVisual(box1.first.get());
+  EXPECT_EQ(instancer.VisualCount(), 1u);
+  EXPECT_EQ(box1.first->GetSceneNode()->numAttachedObjects(), objects);
+
+  // Transparent materials are not instanced
+  auto box3 = this->CreateBox(scene, "instanced_box3");
+  ASSERT_TRUE(box3.second != nullptr);
+  box3.first->SetTransparency(0.5);
+  EXPECT_FALSE(instancer.AddVisual(box3.first.get(), box3.second));
+  EXPECT_EQ(instancer.VisualCount(), 1u);
+
+  instancer.RemoveVisual(box2.first.get());
+  EXPECT_EQ(instancer.VisualCount(), 0u);
+
+  scene->RemoveVisual(box1.first);
+  scene->RemoveVisual(box2.first);
+  scene->RemoveVisual(box3.first);
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -18,7 +18,9 @@
 #ifndef GAZEBO_RENDERING_VISUALPRIVATE_HH_
 #define GAZEBO_RENDERING_VISUALPRIVATE_HH_
 
+#include <atomic>
 #include <map>
+#include <set>
 #include <string>
 #include <utility>
 #include <list>
@@ -122,6 +124,10 @@ namespace gazebo
       /// \brief The visual's skeleton, used only for person simulation.
       public: Ogre::SkeletonInstance *skeleton;
 
+      /// \brief True if the visual's mesh entity may be drawn through
+      /// hardware instancing, see VisualInstancer.
+      public: bool instanceable = false;
+
       /// \brief Connection for the pre render event.
       public: event::ConnectionPtr preRenderConnection;
 
@@ -161,6 +167,12 @@ namespace gazebo
       /// \brief Counter used to create unique ids.
       public: static uint32_t visualIdCount;
 
+      /// \brief Value of changeCounter at the last change of this visual.
+      public: uint64_t changeStamp = 0;
+
+      /// \brief Counter shared by all visuals, increased on every change.
+      public: static std::atomic<uint64_t> changeCounter;
+
       /// \brief Scale of visual.
       public: ignition::math::Vector3d scale;
 
@@ -222,6 +234,14 @@ namespace gazebo
 
       /// \brief Original ogre materials used by the submeshes in the visual
       public: std::map<std::string, Ogre::MaterialPtr> submeshMaterials;
+
+      /// \brief Meshes referenced by the visual, as mesh and submesh names,
+      /// see ResourceCollector.
+      public: std::vector<std::pair<std::string, std::string>>
+          meshReferences;
+
+      /// \brief Materials cloned for the visual and referenced by it.
+      public: std::set<std::string> materialReferences;
     };
     /// \}
   }
@@ -30,6 +30,10 @@
 
 #endif /* HAVE_OPENGL */
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+
 #include <ignition/math/Color.hh>
 
 #include "gazebo/rendering/ogre_gazebo.h"
@@ -46,6 +50,31 @@
 using namespace gazebo;
 using namespace rendering;
 
+/// \brief Number of steps across the image when looking for the cube map
+/// faces a lens samples from.
+static const int kFaceSamples = 64;
+
+/// \brief A direction also counts as seen by the neighbouring faces when its
+/// component along their axis is at least this fraction of the largest one.
+/// Covers the gaps between samples and the texels read by seamless cube map
+/// filtering across face edges.
+static const double kFaceMargin = 0.85;
+
+/// \brief Focal length used by a lens.
+/// \param[in] _lens Lens to get the focal length of.
+/// \param[in] _hfov Horizontal field of view of the camera in radians.
+/// \return Focal length, scaled to the field of view if the lens asks to.
+static double LensFocalLength(const CameraLens *_lens, const double _hfov)
+{
+  if (!_lens->ScaleToHFOV())
+    return _lens->F();
+
+  double param = (_hfov/2.0) / _lens->C2() + _lens->C3();
+  double funRes = CameraLensPrivate::MapFunctionEnum(_lens->Fun()).Apply(
+      static_cast<float>(param));
+  return 1.0/(_lens->C1()*funRes);
+}
+
 //////////////////////////////////////////////////
 CameraLens::CameraLens()
   : dataPtr(new CameraLensPrivate)
@@ -529,6 +558,20 @@ CameraLens *WideAngleCamera::Lens() const
   return this->dataPtr->lens;
 }
 
+//////////////////////////////////////////////////
+void WideAngleCamera::SetDualFisheye(const bool _dual)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->dataMutex);
+  this->dataPtr->dualFisheye = _dual;
+}
+
+//////////////////////////////////////////////////
+bool WideAngleCamera::DualFisheye() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->dataMutex);
+  return this->dataPtr->dualFisheye;
+}
+
 //////////////////////////////////////////////////
 void WideAngleCamera::SetRenderTarget(Ogre::RenderTarget *_target)
 {
@@ -709,8 +752,13 @@ void WideAngleCamera::RenderImpl()
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->renderMutex);
 
+  this->UpdateVisibleFaces();
+
   for (int i = 0; i < 6; ++i)
-    this->dataPtr->envRenderTargets[i]->update();
+  {
+    if (this->dataPtr->faceVisible[i])
+      this->dataPtr->envRenderTargets[i]->update();
+  }
 
   this->dataPtr->compMat->getTechnique(0)->getPass(0)->getTextureUnitState(0)->
       setTextureName(this->dataPtr->envCubeMapTexture->getName());
@@ -718,6 +766,93 @@ void WideAngleCamera::RenderImpl()
   this->renderTarget->update();
 }
 
+//////////////////////////////////////////////////
+void WideAngleCamera::UpdateVisibleFaces()
+{
+  const CameraLens *lens = this->Lens();
+  const bool dual = this->DualFisheye();
+  const double ratio = this->AspectRatio();
+  const ignition::math::Vector3d fun =
+      CameraLensPrivate::MapFunctionEnum(lens->Fun()).AsVector3d();
+
+  const double c1 = lens->C1();
+  const double c2 = lens->C2();
+  const double c3 = lens->C3();
+  const double f = LensFocalLength(lens, this->HFOV().Radian());
+  const double cutOffAngle = lens->CutOffAngle();
+
+  std::array<double, 10> key{{c1, c2, c3, f, fun.X(), fun.Y(), fun.Z(),
+      cutOffAngle, ratio, dual ? 1.0 : 0.0}};
+  if (key == this->dataPtr->faceVisibleKey)
+    return;
+  this->dataPtr->faceVisibleKey = key;
+
+  // Radius past which the lens shader leaves the image black
+  double cutParam = cutOffAngle/c2 + c3;
+  double cutRadius = c1*f*(fun.X()*std::sin(cutParam) +
+      fun.Y()*std::tan(cutParam) + fun.Z()*cutParam);
+
+  // Half of the image height in the same units as the lens radius. In dual
+  // mode each lens gets half of the image width.
+  double halfHeight = (dual ? 2.0 : 1.0) / ratio;
+
+  // Walk the image like the lens shader does and note the cube map face
+  // each pixel samples from
+  std::array<bool, 6> visible{{false, false, false, false, false, false}};
+  for (int i = 0; i <= kFaceSamples; ++i)
+  {
+    for (int j = 0; j <= kFaceSamples; ++j)
+    {
+      double x = -1.0 + 2.0*i/kFaceSamples;
+      double y = halfHeight * (-1.0 + 2.0*j/kFaceSamples);
+      double r = std::hypot(x, y);
+      if (r >= cutRadius)
+        continue;
+
+      double param = r/(c1*f);
+      double theta = param;
+      if (fun.X() > 0)
+      {
+        if (param > 1.0)
+          continue;
+        theta = std::asin(param);
+      }
+      else if (fun.Y() > 0)
+        theta = std::atan(param);
+      theta = (theta - c3)*c2;
+
+      ignition::math::Vector3d dir(0, 0, 1);
+      if (r > 0)
+      {
+        dir.Set(-std::sin(theta)*x/r, std::sin(theta)*y/r,
+            std::cos(theta));
+      }
+
+      for (int l = 0; l < (dual ? 2 : 1); ++l)
+      {
+        // The second lens looks backwards
+        if (l == 1)
+          dir.Set(-dir.X(), dir.Y(), -dir.Z());
+
+        ignition::math::Vector3d a = dir.Abs();
+        double major = a.Max();
+        for (int k = 0; k < 3; ++k)
+        {
+          // Faces are ordered +X, -X, +Y, -Y, +Z, -Z
+          if (a[k] >= major*kFaceMargin)
+            visible[2*k + (dir[k] < 0 ? 1 : 0)] = true;
+        }
+      }
+    }
+  }
+
+  // Should not happen with a sensible lens, but never leave the image empty
+  if (std::find(visible.begin(), visible.end(), true) == visible.end())
+    visible.fill(true);
+
+  this->dataPtr->faceVisible = visible;
+}
+
 //////////////////////////////////////////////////
 void WideAngleCamera::notifyMaterialRender(Ogre::uint32 /*_pass_id*/,
                                            Ogre::MaterialPtr &_material)
@@ -743,6 +878,9 @@ void WideAngleCamera::notifyMaterialRender(Ogre::uint32 /*_pass_id*/,
     this->AspectRatio(),
     this->HFOV().Radian());
 
+  pPass->getFragmentProgramParameters()->setNamedConstant("dual",
+      static_cast<Ogre::Real>(this->DualFisheye() ? 1.0 : 0.0));
+
 #if defined(HAVE_OPENGL)
   // XXX: OGRE doesn't allow to enable cubemap filtering extention thru its API
   // suppose that this function was invoked in a thread that has OpenGL context
@@ -796,6 +934,12 @@ ignition::math::Vector3d WideAngleCamera::Project3d(
       dir = rot * dir;
       dir.Normalize();
 
+      // in dual mode directions behind the camera go to the second lens,
+      // which looks backwards
+      bool backLens = this->dataPtr->dualFisheye && dir.Z() < 0;
+      if (backLens)
+        dir.Set(-dir.X(), dir.Y(), -dir.Z());
+
       // compute theta and phi from the dir vector
       // theta is angle to dir vector from z (forward)
       // phi is angle from x in x-y plane
@@ -810,17 +954,7 @@ ignition::math::Vector3d WideAngleCamera::Project3d(
       // double theta = std::acos(dir.Z());
       // double phi = std::asin(dir.Y() / std::sin(theta));
 
-      double f = this->Lens()->F();
-      double hfov = this->HFOV().Radian();
-      // recompute f if scale to HFOV is true
-      if (this->Lens()->ScaleToHFOV())
-      {
-        double param = (hfov/2.0) / this->Lens()->C2() + this->Lens()->C3();
-        double funRes =
-            CameraLensPrivate::MapFunctionEnum(this->Lens()->Fun()).Apply(
-            static_cast<float>(param));
-        f = 1.0/(this->Lens()->C1()*funRes);
-      }
+      double f = LensFocalLength(this->Lens(), this->HFOV().Radian());
 
       // Apply fisheye lens mapping function
       // r is distance of point from image center
@@ -838,6 +972,13 @@ ignition::math::Vector3d WideAngleCamera::Project3d(
         static_cast<double>(this->ViewportHeight());
       y *= aspect;
 
+      // each lens takes one half of the image in dual mode
+      if (this->dataPtr->dualFisheye)
+      {
+        x = (x + (backLens ? 1.0 : -1.0)) / 2.0;
+        y /= 2.0;
+      }
+
       // convert to screen space
       screenPos.X() = ((x / 2.0) + 0.5) * this->ViewportWidth();
       screenPos.Y() = (1 - ((y / 2.0) + 0.5)) * this->ViewportHeight();
@@ -213,6 +213,18 @@ namespace gazebo
       /// \param[in] _size Texture size
       public: void SetEnvTextureSize(const int _size);
 
+      /// \brief Show two back to back lenses side by side, the front lens
+      /// on the left half of the image and the lens looking backwards on
+      /// the right half. Each half uses the lens settings, with the
+      /// horizontal field of view spanning one half.
+      /// \param[in] _dual True for two lenses, false for a single one.
+      public: void SetDualFisheye(const bool _dual);
+
+      /// \brief Check if two back to back lenses are shown.
+      /// \return True if the image holds two lenses.
+      /// \sa SetDualFisheye
+      public: bool DualFisheye() const;
+
       /// \brief Creates a set of 6 cameras pointing in different directions
       protected: void CreateEnvCameras();
 
@@ -246,6 +258,11 @@ namespace gazebo
       // Documentation inherited
       protected: void UpdateFOV() override;
 
+      /// \brief Find the cube map faces the lens samples from, so that
+      /// RenderImpl only renders those. Does nothing if the lens, field of
+      /// view and aspect ratio are unchanged since the last call.
+      private: void UpdateVisibleFaces();
+
       /// \bried Callback that is used to set mapping material uniform values,
       ///   implements Ogre::CompositorInstance::Listener interface
       /// \param[in] _pass_id Pass identifier
@@ -17,6 +17,7 @@
 #ifndef _GAZEBO_RENDERING_WIDE_ANGLE_CAMERA_CAMERA_PRIVATE_HH_
 #define _GAZEBO_RENDERING_WIDE_ANGLE_CAMERA_CAMERA_PRIVATE_HH_
 
+#include <array>
 #include <mutex>
 
 #include "gazebo/msgs/msgs.hh"
@@ -72,6 +73,17 @@ namespace gazebo
       /// \brief Camera lens description
       public: CameraLens *lens;
 
+      /// \brief True to render two back to back lenses side by side
+      public: bool dualFisheye = false;
+
+      /// \brief Cube map faces the lens samples from, in the order of the
+      /// render targets. Faces that are not visible are not rendered.
+      public: std::array<bool, 6> faceVisible{
+          {true, true, true, true, true, true}};
+
+      /// \brief Lens parameters faceVisible was computed for.
+      public: std::array<double, 10> faceVisibleKey{};
+
       /// \brief Mutex to lock while rendering the world
       public: std::mutex renderMutex;
 
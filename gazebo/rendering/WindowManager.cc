@@ -96,12 +96,16 @@ int WindowManager::CreateWindow(const std::string &_ogreHandle,
   Ogre::NameValuePairList params;
   Ogre::RenderWindow *window = NULL;
 
-  // Mac and Windows *must* use externalWindow handle.
+  // Mac and Windows *must* use externalWindow handle. Headless windows have
+  // no handle.
+  if (!_ogreHandle.empty())
+  {
 #if defined(__APPLE__) || defined(_MSC_VER)
-  params["externalWindowHandle"] = _ogreHandle;
+    params["externalWindowHandle"] = _ogreHandle;
 #else
-  params["parentWindowHandle"] = _ogreHandle;
+    params["parentWindowHandle"] = _ogreHandle;
 #endif
+  }
   params["FSAA"] = "4";
   params["stereoMode"] = "Frame Sequential";
 
@@ -57,7 +57,8 @@ namespace gazebo
       public: void Fini();
 
       /// \brief Create a window.
-      /// \param[in] _ogreHandle String representing the ogre window handle.
+      /// \param[in] _ogreHandle String representing the ogre window handle,
+      /// empty for a window without native parent.
       /// \param[in] _width With of the window in pixels.
       /// \param[in] _height Height of the window in pixels.
       /// \param[in] _devicePixelRatio Screen point to pixel ratio
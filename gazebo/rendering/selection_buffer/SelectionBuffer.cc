@@ -15,12 +15,14 @@
  *
 */
 
+#include <algorithm>
 #include <memory>
 #include <ignition/math/Color.hh>
 
 #include "gazebo/common/Console.hh"
 #include "gazebo/rendering/ogre_gazebo.h"
 #include "gazebo/rendering/RenderTypes.hh"
+#include "gazebo/rendering/VisualInstancer.hh"
 #include "gazebo/rendering/selection_buffer/SelectionRenderListener.hh"
 #include "gazebo/rendering/selection_buffer/MaterialSwitcher.hh"
 #include "gazebo/rendering/selection_buffer/SelectionBuffer.hh"
@@ -28,6 +30,10 @@
 using namespace gazebo;
 using namespace rendering;
 
+/// \brief Width and height in pixels of the region rendered around the
+/// cursor. Later queries inside it are answered without rendering.
+static const int kTileSize = 16;
+
 namespace gazebo
 {
   namespace rendering
@@ -71,6 +77,33 @@ namespace gazebo
       /// \brief A 2D overlay used for debugging the selection buffer. It
       /// is hidden by default.
       Ogre::Overlay *selectionDebugOverlay;
+
+      /// \brief True if the buffer holds the tile described below.
+      bool tileValid = false;
+
+      /// \brief Position in pixels of the top left corner of the tile.
+      int tileX = 0;
+
+      /// \brief Position in pixels of the top left corner of the tile.
+      int tileY = 0;
+
+      /// \brief Size of the render target when the tile was rendered.
+      unsigned int tileTargetWidth = 0;
+
+      /// \brief Size of the render target when the tile was rendered.
+      unsigned int tileTargetHeight = 0;
+
+      /// \brief Frame the tile was rendered in.
+      unsigned long tileFrame = 0;
+
+      /// \brief Camera position the tile was rendered from.
+      Ogre::Vector3 tilePosition;
+
+      /// \brief Camera orientation the tile was rendered from.
+      Ogre::Quaternion tileOrientation;
+
+      /// \brief Camera projection the tile was rendered with.
+      Ogre::Matrix4 tileProjection;
     };
   }
 }
@@ -110,8 +143,15 @@ void SelectionBuffer::Update()
   if (!this->dataPtr->renderTexture)
     return;
 
+  this->dataPtr->tileValid = false;
   this->dataPtr->materialSwitchListener->Reset();
 
+  // Instanced visuals share batches, draw their own entities instead so
+  // that each gets a color
+  VisualInstancer *instancer = VisualInstancer::Find(this->dataPtr->sceneMgr);
+  if (instancer)
+    instancer->SetSelectionMode(true);
+
   // FIXME: added try-catch block to prevent crash in deferred rendering mode.
   // RTT does not like VPL.material as it references a texture in the compositor
   // pipeline. A possible workaround is to add the deferred rendering
@@ -124,6 +164,9 @@ void SelectionBuffer::Update()
   {
   }
 
+  if (instancer)
+    instancer->SetSelectionMode(false);
+
   this->dataPtr->renderTexture->copyContentsToMemory(*this->dataPtr->pixelBox,
       Ogre::RenderTarget::FB_FRONT);
 }
@@ -147,9 +190,9 @@ void SelectionBuffer::CreateRTTBuffer()
 {
   try
   {
-    // 1x1 pixel buffer
-    unsigned int width = 1;
-    unsigned int height = 1;
+    // Buffer for the region around the cursor
+    unsigned int width = kTileSize;
+    unsigned int height = kTileSize;
 
     this->dataPtr->texture = Ogre::TextureManager::getSingleton().createManual(
         "SelectionPassTex",
@@ -181,7 +224,8 @@ void SelectionBuffer::CreateRTTBuffer()
     this->dataPtr->texture->getBuffer();
   size_t bufferSize = pixelBuffer->getSizeInBytes();
 
-  this->dataPtr->buffer = new uint8_t[bufferSize];
+  // Pixels are read 4 bytes at a time, even if the format is 3 bytes wide
+  this->dataPtr->buffer = new uint8_t[bufferSize + 4];
   this->dataPtr->pixelBox = new Ogre::PixelBox(pixelBuffer->getWidth(),
       pixelBuffer->getHeight(), pixelBuffer->getDepth(),
       pixelBuffer->getFormat(), this->dataPtr->buffer);
@@ -200,37 +244,73 @@ Ogre::Entity *SelectionBuffer::OnSelectionClick(int _x, int _y)
       || _y >= static_cast<int>(targetHeight))
     return nullptr;
 
-  // 1x1 selection buffer, adapted from rviz
-  // http://docs.ros.org/indigo/api/rviz/html/c++/selection__manager_8cpp.html
-  unsigned int width = 1;
-  unsigned int height = 1;
-  float x1 = static_cast<float>(_x) /
-      static_cast<float>(targetWidth - 1) - 0.5f;
-  float y1 = static_cast<float>(_y) /
-      static_cast<float>(targetHeight - 1) - 0.5f;
-  float x2 = static_cast<float>(_x+width) /
-      static_cast<float>(targetWidth - 1) - 0.5f;
-  float y2 = static_cast<float>(_y+height) /
-      static_cast<float>(targetHeight - 1) - 0.5f;
-  Ogre::Matrix4 scaleMatrix = Ogre::Matrix4::IDENTITY;
-  Ogre::Matrix4 transMatrix = Ogre::Matrix4::IDENTITY;
-  scaleMatrix[0][0] = 1.0 / (x2-x1);
-  scaleMatrix[1][1] = 1.0 / (y2-y1);
-  transMatrix[0][3] -= x1+x2;
-  transMatrix[1][3] += y1+y2;
-  this->dataPtr->selectionCamera->setCustomProjectionMatrix(true,
-      scaleMatrix * transMatrix * this->dataPtr->camera->getProjectionMatrix());
-  this->dataPtr->selectionCamera->setPosition(
-      this->dataPtr->camera->getDerivedPosition());
-  this->dataPtr->selectionCamera->setOrientation(
-      this->dataPtr->camera->getDerivedOrientation());
-  Ogre::Viewport* renderViewport = this->dataPtr->renderTexture->getViewport(0);
-  renderViewport->setDimensions(0, 0, width, height);
-
-  // update render texture
-  this->Update();
-
-  size_t posInStream = 0;
+  Ogre::Camera *camera = this->dataPtr->camera;
+  const Ogre::Vector3 &position = camera->getDerivedPosition();
+  const Ogre::Quaternion &orientation = camera->getDerivedOrientation();
+  const Ogre::Matrix4 &projection = camera->getProjectionMatrix();
+  unsigned long frame = Ogre::Root::getSingleton().getNextFrameNumber();
+
+  // Render again only if the point is outside of the last tile, or the
+  // camera or the frame changed since
+  if (!this->dataPtr->tileValid ||
+      _x < this->dataPtr->tileX || _x >= this->dataPtr->tileX + kTileSize ||
+      _y < this->dataPtr->tileY || _y >= this->dataPtr->tileY + kTileSize ||
+      this->dataPtr->tileTargetWidth != targetWidth ||
+      this->dataPtr->tileTargetHeight != targetHeight ||
+      this->dataPtr->tileFrame != frame ||
+      this->dataPtr->tilePosition != position ||
+      this->dataPtr->tileOrientation != orientation ||
+      this->dataPtr->tileProjection != projection)
+  {
+    // Tile around the point, kept inside the target when it is large
+    // enough
+    int tileX = std::max(0, std::min(_x - kTileSize / 2,
+        static_cast<int>(targetWidth) - kTileSize));
+    int tileY = std::max(0, std::min(_y - kTileSize / 2,
+        static_cast<int>(targetHeight) - kTileSize));
+
+    // Crop the projection to the tile, adapted from rviz
+    // http://docs.ros.org/indigo/api/rviz/html/c++/selection__manager_8cpp.html
+    float x1 = static_cast<float>(tileX) /
+        static_cast<float>(targetWidth - 1) - 0.5f;
+    float y1 = static_cast<float>(tileY) /
+        static_cast<float>(targetHeight - 1) - 0.5f;
+    float x2 = static_cast<float>(tileX + kTileSize) /
+        static_cast<float>(targetWidth - 1) - 0.5f;
+    float y2 = static_cast<float>(tileY + kTileSize) /
+        static_cast<float>(targetHeight - 1) - 0.5f;
+    Ogre::Matrix4 scaleMatrix = Ogre::Matrix4::IDENTITY;
+    Ogre::Matrix4 transMatrix = Ogre::Matrix4::IDENTITY;
+    scaleMatrix[0][0] = 1.0 / (x2-x1);
+    scaleMatrix[1][1] = 1.0 / (y2-y1);
+    transMatrix[0][3] -= x1+x2;
+    transMatrix[1][3] += y1+y2;
+    this->dataPtr->selectionCamera->setCustomProjectionMatrix(true,
+        scaleMatrix * transMatrix * projection);
+    this->dataPtr->selectionCamera->setPosition(position);
+    this->dataPtr->selectionCamera->setOrientation(orientation);
+    Ogre::Viewport* renderViewport =
+        this->dataPtr->renderTexture->getViewport(0);
+    renderViewport->setDimensions(0, 0, 1, 1);
+
+    // update render texture
+    this->Update();
+
+    this->dataPtr->tileValid = true;
+    this->dataPtr->tileX = tileX;
+    this->dataPtr->tileY = tileY;
+    this->dataPtr->tileTargetWidth = targetWidth;
+    this->dataPtr->tileTargetHeight = targetHeight;
+    this->dataPtr->tileFrame = frame;
+    this->dataPtr->tilePosition = position;
+    this->dataPtr->tileOrientation = orientation;
+    this->dataPtr->tileProjection = projection;
+  }
+
+  const Ogre::PixelBox *pixelBox = this->dataPtr->pixelBox;
+  size_t posInStream = ((_y - this->dataPtr->tileY) * pixelBox->rowPitch +
+      (_x - this->dataPtr->tileX)) *
+      Ogre::PixelUtil::getNumElemBytes(pixelBox->format);
 
   ignition::math::Color::BGRA color(0);
   if (!this->dataPtr->buffer)
@@ -245,7 +325,8 @@ Ogre::Entity *SelectionBuffer::OnSelectionClick(int _x, int _y)
   const std::string &entName =
     this->dataPtr->materialSwitchListener->GetEntityName(cv);
 
-  if (entName.empty())
+  // The entity may have been removed since the tile was rendered
+  if (entName.empty() || !this->dataPtr->sceneMgr->hasEntity(entName))
     return 0;
   else
     return this->dataPtr->sceneMgr->getEntity(entName);
@@ -15,6 +15,8 @@
  *
 */
 #include <boost/algorithm/string.hpp>
+#include <algorithm>
+#include <cstdlib>
 #include <functional>
 #include <ignition/common/Profiler.hh>
 #include <ignition/msgs/Utility.hh>
@@ -23,6 +25,7 @@
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Image.hh"
 #include "gazebo/common/CommonIface.hh"
+#include "gazebo/common/SamplingProfiler.hh"
 
 #include "gazebo/msgs/msgs.hh"
 
@@ -96,6 +99,42 @@ std::string CameraSensor::TopicIgn() const
   return topicName;
 }
 
+//////////////////////////////////////////////////
+std::string CameraSensor::CompressedTopic() const
+{
+  return this->Topic() + "/compressed";
+}
+
+//////////////////////////////////////////////////
+void CameraSensor::SetCompression(const std::string &_format,
+    const int _quality)
+{
+  if (_format != "jpeg" && _format != "png")
+  {
+    gzerr << "Unsupported image compression[" << _format
+          << "], use jpeg or png\n";
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->compressMutex);
+  this->dataPtr->compressionFormat = _format;
+  this->dataPtr->compressionQuality = ignition::math::clamp(_quality, 1, 100);
+}
+
+//////////////////////////////////////////////////
+std::string CameraSensor::CompressionFormat() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->compressMutex);
+  return this->dataPtr->compressionFormat;
+}
+
+//////////////////////////////////////////////////
+int CameraSensor::CompressionQuality() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->compressMutex);
+  return this->dataPtr->compressionQuality;
+}
+
 //////////////////////////////////////////////////
 void CameraSensor::Load(const std::string &_worldName)
 {
@@ -109,6 +148,16 @@ void CameraSensor::Load(const std::string &_worldName)
   }
 
   this->imagePub = this->node->Advertise<msgs::ImageStamped>(this->Topic(), 50);
+  this->dataPtr->compressedPub =
+      this->node->Advertise<msgs::CompressedImageStamped>(
+      this->CompressedTopic(), 50);
+
+  if (!this->dataPtr->compressThread.joinable())
+  {
+    this->dataPtr->stopCompress = false;
+    this->dataPtr->compressThread =
+        std::thread(&CameraSensor::CompressLoop, this);
+  }
 
   ignition::transport::AdvertiseMessageOptions opts;
   opts.SetMsgsPerSec(50);
@@ -143,42 +192,25 @@ void CameraSensor::Init()
       }
     }
 
-    std::string scopedName = this->parentName + "::" + this->Name();
-    this->camera = this->scene->CreateCamera(scopedName, false);
-
-    if (!this->camera)
-    {
-      gzerr << "Unable to create camera sensor[mono_camera]\n";
-      return;
-    }
-    this->camera->SetCaptureData(true);
-
-    sdf::ElementPtr cameraSdf = this->sdf->GetElement("camera");
-    this->camera->Load(cameraSdf);
-
-    // Do some sanity checks
-    if (this->camera->ImageWidth() == 0 ||
-        this->camera->ImageHeight() == 0)
+    // Plugins expect the camera once they are loaded, so cameras with
+    // plugins are never created on demand
+    const char *onDemand = std::getenv("GAZEBO_CAMERA_ON_DEMAND");
+    if (onDemand && !this->sdf->HasElement("plugin"))
     {
-      gzthrow("image has zero size");
+      try
+      {
+        this->dataPtr->onDemandTimeout =
+            std::max(0.0, std::stod(onDemand));
+      }
+      catch(...)
+      {
+        gzerr << "Invalid GAZEBO_CAMERA_ON_DEMAND[" << onDemand << "], "
+              << "expected a number of seconds\n";
+      }
     }
 
-    this->camera->Init();
-    this->camera->CreateRenderTexture(scopedName + "_RttTex");
-    ignition::math::Pose3d cameraPose = this->pose;
-    if (cameraSdf->HasElement("pose"))
-      cameraPose = cameraSdf->Get<ignition::math::Pose3d>("pose") + cameraPose;
-
-    this->camera->SetWorldPose(cameraPose);
-    this->camera->AttachToVisual(this->ParentId(), true, 0, 0);
-
-    if (cameraSdf->HasElement("noise"))
-    {
-      this->noises[CAMERA_NOISE] =
-        NoiseFactory::NewNoiseModel(cameraSdf->GetElement("noise"),
-        this->Type());
-      this->noises[CAMERA_NOISE]->SetCamera(this->camera);
-    }
+    if (this->dataPtr->onDemandTimeout < 0 && !this->CreateCamera())
+      return;
   }
   else
     gzerr << "No world name\n";
@@ -192,9 +224,105 @@ void CameraSensor::Init()
   Sensor::Init();
 }
 
+//////////////////////////////////////////////////
+bool CameraSensor::CreateCamera()
+{
+  std::string scopedName = this->parentName + "::" + this->Name();
+  this->camera = this->scene->CreateCamera(scopedName, false);
+
+  if (!this->camera)
+  {
+    gzerr << "Unable to create camera sensor[mono_camera]\n";
+    return false;
+  }
+  this->camera->SetCaptureData(true);
+
+  sdf::ElementPtr cameraSdf = this->sdf->GetElement("camera");
+  this->camera->Load(cameraSdf);
+
+  // Do some sanity checks
+  if (this->camera->ImageWidth() == 0 ||
+      this->camera->ImageHeight() == 0)
+  {
+    gzthrow("image has zero size");
+  }
+
+  this->camera->Init();
+  this->camera->CreateRenderTexture(scopedName + "_RttTex");
+  ignition::math::Pose3d cameraPose = this->pose;
+  if (cameraSdf->HasElement("pose"))
+    cameraPose = cameraSdf->Get<ignition::math::Pose3d>("pose") + cameraPose;
+
+  this->camera->SetWorldPose(cameraPose);
+  this->camera->AttachToVisual(this->ParentId(), true, 0, 0);
+
+  if (cameraSdf->HasElement("noise"))
+  {
+    this->noises[CAMERA_NOISE] =
+      NoiseFactory::NewNoiseModel(cameraSdf->GetElement("noise"),
+      this->Type());
+    this->noises[CAMERA_NOISE]->SetCamera(this->camera);
+  }
+
+  // Noise has to change from frame to frame, so only noiseless cameras
+  // republish static views
+  const char *skipStatic = std::getenv("GAZEBO_CAMERA_SKIP_STATIC");
+  if (skipStatic && std::string(skipStatic) != "0" &&
+      this->noises.find(CAMERA_NOISE) == this->noises.end())
+  {
+    this->camera->SetSkipStaticViews(true);
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+void CameraSensor::ReleaseCamera()
+{
+  if (!this->camera)
+    return;
+
+  this->scene->RemoveCamera(this->camera->Name());
+  this->camera.reset();
+  this->noises.erase(CAMERA_NOISE);
+
+  this->dataPtr->rendered = false;
+  this->dataPtr->renderNeeded = false;
+  this->dataPtr->nextRenderingTime = std::numeric_limits<double>::quiet_NaN();
+}
+
+//////////////////////////////////////////////////
+void CameraSensor::UpdateOnDemand()
+{
+  if (this->HasSubscribers())
+  {
+    this->dataPtr->lastSubscribed = common::Time::GetWallTime();
+    if (!this->camera && this->CreateCamera())
+      gzlog << "Created on-demand camera[" << this->camera->Name() << "]\n";
+  }
+  else if (this->camera && (common::Time::GetWallTime() -
+        this->dataPtr->lastSubscribed).Double() >
+      this->dataPtr->onDemandTimeout)
+  {
+    gzlog << "Released on-demand camera[" << this->camera->Name() << "]\n";
+    this->ReleaseCamera();
+  }
+}
+
 //////////////////////////////////////////////////
 void CameraSensor::Fini()
 {
+  if (this->dataPtr->compressThread.joinable())
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->compressMutex);
+      this->dataPtr->stopCompress = true;
+    }
+    this->dataPtr->compressCondition.notify_all();
+    this->dataPtr->compressThread.join();
+  }
+  this->dataPtr->compressedPub.reset();
+
   this->imagePub.reset();
 
   if (this->camera)
@@ -301,13 +429,18 @@ void CameraSensor::PrerenderEnded()
 void CameraSensor::Render()
 {
   IGN_PROFILE("sensors::CameraSensor::Render");
+  if (this->dataPtr->onDemandTimeout >= 0)
+    this->UpdateOnDemand();
+
   if (this->useStrictRate)
   {
-    if (!this->dataPtr->renderNeeded)
+    if (!this->dataPtr->renderNeeded || !this->camera)
       return;
 
     // Update all the cameras
+    auto start = std::chrono::steady_clock::now();
     this->camera->Render();
+    this->AddRenderTime(start);
 
     this->dataPtr->rendered = true;
     this->dataPtr->renderNeeded = false;
@@ -318,7 +451,9 @@ void CameraSensor::Render()
       return;
 
     // Update all the cameras
+    auto start = std::chrono::steady_clock::now();
     this->camera->Render();
+    this->AddRenderTime(start);
 
     this->dataPtr->rendered = true;
     this->lastMeasurementTime = this->scene->SimTime();
@@ -337,16 +472,56 @@ bool CameraSensor::UpdateImpl(const bool /*_force*/)
   this->camera->PostRender();
   IGN_PROFILE_END();
 
+  // No image yet: with asynchronous readback the first frame arrives one
+  // render late
+  if (!this->camera->ImageData())
+  {
+    this->dataPtr->rendered = false;
+    return false;
+  }
+
   IGN_PROFILE_BEGIN("fillarray");
 
+  const bool compressed = this->dataPtr->compressedPub &&
+      this->dataPtr->compressedPub->HasConnections();
+
   if ((this->imagePub && this->imagePub->HasConnections()) ||
-      this->imagePubIgn.HasConnections())
+      this->imagePubIgn.HasConnections() || compressed)
   {
-    auto simTime = this->scene->SimTime();
+    // Time the image was rendered at, which trails the scene time when
+    // the camera reads its frames back asynchronously
+    auto simTime = this->camera->ImageTime();
+
+    // Only copy the frame here, it is encoded by CompressLoop
+    if (compressed)
+    {
+      {
+        std::lock_guard<std::mutex> lock(this->dataPtr->compressMutex);
+        const size_t capacity = this->dataPtr->pendingFrame.capacity();
+        this->dataPtr->pendingFrame.assign(
+            reinterpret_cast<const char *>(this->camera->ImageData()),
+            this->camera->ImageWidth() * this->camera->ImageHeight() *
+            this->camera->ImageDepth());
+        this->CountBufferAllocation(capacity,
+            this->dataPtr->pendingFrame.capacity());
+        this->dataPtr->pendingTime = simTime;
+        this->dataPtr->pendingWidth = this->camera->ImageWidth();
+        this->dataPtr->pendingHeight = this->camera->ImageHeight();
+        this->dataPtr->pendingFormat = common::Image::ConvertPixelFormat(
+            this->camera->ImageFormat());
+        this->dataPtr->framePending = true;
+      }
+      this->dataPtr->compressCondition.notify_one();
+    }
+
     if (this->imagePub && this->imagePub->HasConnections())
     {
-      msgs::ImageStamped msg;
+      // Filling the reused message copies into its existing buffer
+      msgs::ImageStamped &msg = this->dataPtr->imageMsg;
       msgs::Set(msg.mutable_time(), simTime);
+      msg.clear_trace();
+      if (transport::TraceStamps::Enabled())
+        transport::TraceStamps::Add(msg, msgs::TraceStamp::RENDER);
       msg.mutable_image()->set_width(this->camera->ImageWidth());
       msg.mutable_image()->set_height(this->camera->ImageHeight());
       msg.mutable_image()->set_pixel_format(common::Image::ConvertPixelFormat(
@@ -354,16 +529,18 @@ bool CameraSensor::UpdateImpl(const bool /*_force*/)
 
       msg.mutable_image()->set_step(this->camera->ImageWidth() *
           this->camera->ImageDepth());
+      const size_t capacity = msg.image().data().capacity();
       msg.mutable_image()->set_data(this->camera->ImageData(),
           msg.image().width() * this->camera->ImageDepth() *
           msg.image().height());
+      this->CountBufferAllocation(capacity, msg.image().data().capacity());
 
       this->imagePub->Publish(msg);
     }
 
     if (this->imagePubIgn.HasConnections())
     {
-      ignition::msgs::Image msg;
+      ignition::msgs::Image &msg = this->dataPtr->imageMsgIgn;
       msg.mutable_header()->mutable_stamp()->set_sec(simTime.sec);
       msg.mutable_header()->mutable_stamp()->set_nsec(simTime.nsec);
 
@@ -374,9 +551,11 @@ bool CameraSensor::UpdateImpl(const bool /*_force*/)
 
       msg.set_step(this->camera->ImageWidth() *
           this->camera->ImageDepth());
+      const size_t capacity = msg.data().capacity();
       msg.set_data(this->camera->ImageData(),
           msg.width() * this->camera->ImageDepth() *
           msg.height());
+      this->CountBufferAllocation(capacity, msg.data().capacity());
 
       this->imagePubIgn.Publish(msg);
     }
@@ -387,6 +566,74 @@ bool CameraSensor::UpdateImpl(const bool /*_force*/)
   return true;
 }
 
+//////////////////////////////////////////////////
+void CameraSensor::CompressLoop()
+{
+  common::SetThreadName("CameraCompress");
+  std::string frame;
+  bool warned = false;
+  while (true)
+  {
+    common::Time time;
+    unsigned int width;
+    unsigned int height;
+    common::Image::PixelFormat pixelFormat;
+    std::string format;
+    int quality;
+    {
+      std::unique_lock<std::mutex> lock(this->dataPtr->compressMutex);
+      this->dataPtr->compressCondition.wait(lock, [this]
+          {
+            return this->dataPtr->stopCompress || this->dataPtr->framePending;
+          });
+      if (this->dataPtr->stopCompress)
+        return;
+
+      // Swap so that both buffers keep their capacity
+      frame.swap(this->dataPtr->pendingFrame);
+      this->dataPtr->framePending = false;
+      time = this->dataPtr->pendingTime;
+      width = this->dataPtr->pendingWidth;
+      height = this->dataPtr->pendingHeight;
+      pixelFormat = this->dataPtr->pendingFormat;
+      format = this->dataPtr->compressionFormat;
+      quality = this->dataPtr->compressionQuality;
+    }
+
+    // Formats that common::Image can hold
+    if (pixelFormat != common::Image::L_INT8 &&
+        pixelFormat != common::Image::RGB_INT8 &&
+        pixelFormat != common::Image::RGBA_INT8 &&
+        pixelFormat != common::Image::BGR_INT8)
+    {
+      if (!warned)
+      {
+        gzwarn << "Unable to compress images of camera[" << this->Name()
+               << "] with pixel format[" << pixelFormat << "]\n";
+        warned = true;
+      }
+      continue;
+    }
+
+    IGN_PROFILE("CameraSensor::CompressLoop");
+    common::Image image;
+    image.SetFromData(reinterpret_cast<const unsigned char *>(frame.data()),
+        width, height, pixelFormat);
+
+    msgs::CompressedImageStamped msg;
+    if (!image.SaveToBuffer(format, *msg.mutable_data(), quality))
+      continue;
+    msgs::Set(msg.mutable_time(), time);
+    msg.set_format(format);
+    msg.set_width(width);
+    msg.set_height(height);
+
+    transport::PublisherPtr pub = this->dataPtr->compressedPub;
+    if (pub)
+      pub->Publish(msg);
+  }
+}
+
 //////////////////////////////////////////////////
 unsigned int CameraSensor::ImageWidth() const
 {
@@ -444,8 +691,15 @@ bool CameraSensor::SaveFrame(const std::string &_filename)
 //////////////////////////////////////////////////
 bool CameraSensor::IsActive() const
 {
-  return Sensor::IsActive() ||
-    (this->imagePub && this->imagePub->HasConnections()) ||
+  return Sensor::IsActive() || this->HasSubscribers();
+}
+
+//////////////////////////////////////////////////
+bool CameraSensor::HasSubscribers() const
+{
+  return (this->imagePub && this->imagePub->HasConnections()) ||
+    (this->dataPtr->compressedPub &&
+     this->dataPtr->compressedPub->HasConnections()) ||
     this->imagePubIgn.HasConnections();
 }
 
@@ -40,6 +40,11 @@ namespace gazebo
     /// \brief Basic camera sensor
     ///
     /// This sensor is used for simulating standard monocular cameras
+    ///
+    /// When GAZEBO_CAMERA_ON_DEMAND is set to a number of seconds, cameras
+    /// without plugins are created when their topics get a first
+    /// subscriber instead of at Init, and released again once they had no
+    /// subscriber for that long. Camera() is null in between.
     class GZ_SENSORS_VISIBLE CameraSensor : public Sensor
     {
       /// \brief Constructor
@@ -84,6 +89,25 @@ namespace gazebo
       /// \return Ignition topic name
       public: std::string TopicIgn() const;
 
+      /// \brief Gets the topic of the compressed images. Frames are only
+      /// encoded, on a worker thread, while this topic has subscribers.
+      /// \return Topic name, Topic() followed by "/compressed".
+      public: std::string CompressedTopic() const;
+
+      /// \brief Set the encoding of the compressed images.
+      /// \param[in] _format "jpeg" or "png".
+      /// \param[in] _quality JPEG quality from 1 to 100.
+      public: void SetCompression(const std::string &_format,
+                                  const int _quality);
+
+      /// \brief Get the encoding of the compressed images.
+      /// \return "jpeg" or "png", "jpeg" by default.
+      public: std::string CompressionFormat() const;
+
+      /// \brief Get the JPEG quality of the compressed images.
+      /// \return Quality from 1 to 100, 80 by default.
+      public: int CompressionQuality() const;
+
       /// \brief Set whether the sensor is active or not.
       /// \param[in] _value True if active, false if not.
       public: void SetActive(bool _value) override;
@@ -131,6 +155,25 @@ namespace gazebo
       /// \brief Handle the prerenderEnded event.
       protected: void PrerenderEnded();
 
+      /// \brief Encode and publish the frames queued by UpdateImpl on the
+      /// compressed image topic.
+      private: void CompressLoop();
+
+      /// \brief Create the rendering camera and its render texture.
+      /// \return True on success.
+      private: bool CreateCamera();
+
+      /// \brief Release the rendering camera of an on-demand sensor.
+      private: void ReleaseCamera();
+
+      /// \brief Create or release the camera of an on-demand sensor,
+      /// depending on its subscribers.
+      private: void UpdateOnDemand();
+
+      /// \brief Get whether any of the image topics has a subscriber.
+      /// \return True if there is a subscriber.
+      private: bool HasSubscribers() const;
+
       /// \brief Pointer to the camera.
       protected: rendering::CameraPtr camera;
 
@@ -17,7 +17,18 @@
 #ifndef GAZEBO_SENSORS_CAMERASENSOR_PRIVATE_HH_
 #define GAZEBO_SENSORS_CAMERASENSOR_PRIVATE_HH_
 
+#include <condition_variable>
 #include <limits>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <ignition/msgs/image.pb.h>
+
+#include "gazebo/common/Image.hh"
+#include "gazebo/common/Time.hh"
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/transport/TransportTypes.hh"
 
 namespace gazebo
 {
@@ -36,6 +47,62 @@ namespace gazebo
       /// \brief Timestamp of the forthcoming rendering
       public: double nextRenderingTime
                            = std::numeric_limits<double>::quiet_NaN();
+
+      /// \brief Publisher of compressed image messages.
+      public: transport::PublisherPtr compressedPub;
+
+      /// \brief Thread that encodes the compressed images.
+      public: std::thread compressThread;
+
+      /// \brief Protects the members below.
+      public: std::mutex compressMutex;
+
+      /// \brief Signaled when a frame is queued or the thread stops.
+      public: std::condition_variable compressCondition;
+
+      /// \brief Raw frame waiting to be encoded. A new frame replaces the
+      /// one waiting, so that a slow encoder drops frames instead of lagging.
+      public: std::string pendingFrame;
+
+      /// \brief Image message, reused across updates so its pixel buffer
+      /// is only allocated once.
+      public: msgs::ImageStamped imageMsg;
+
+      /// \brief Ignition image message, reused across updates.
+      public: ignition::msgs::Image imageMsgIgn;
+
+      /// \brief True if pendingFrame holds a frame.
+      public: bool framePending = false;
+
+      /// \brief Time of the pending frame.
+      public: common::Time pendingTime;
+
+      /// \brief Width of the pending frame.
+      public: unsigned int pendingWidth = 0;
+
+      /// \brief Height of the pending frame.
+      public: unsigned int pendingHeight = 0;
+
+      /// \brief Pixel format of the pending frame.
+      public: common::Image::PixelFormat pendingFormat =
+          common::Image::UNKNOWN_PIXEL_FORMAT;
+
+      /// \brief Encoding of the compressed images.
+      public: std::string compressionFormat = "jpeg";
+
+      /// \brief JPEG quality of the compressed images.
+      public: int compressionQuality = 80;
+
+      /// \brief True when the thread must stop.
+      public: bool stopCompress = false;
+
+      /// \brief Seconds without subscribers before the camera is released,
+      /// from GAZEBO_CAMERA_ON_DEMAND. Negative if the camera is created at
+      /// Init and kept.
+      public: double onDemandTimeout = -1;
+
+      /// \brief Wall time the on-demand camera last had a subscriber.
+      public: common::Time lastSubscribed;
     };
   }
 }
@@ -151,8 +151,8 @@ bool DepthCameraSensor::UpdateImpl(const bool /*_force*/)
       // generating point clouds instead
       this->dataPtr->depthCamera->DepthData())
   {
-    msgs::ImageStamped msg;
-    msgs::Set(msg.mutable_time(), this->scene->SimTime());
+    msgs::ImageStamped &msg = this->dataPtr->imageMsg;
+    msgs::Set(msg.mutable_time(), this->dataPtr->depthCamera->DepthTime());
     msg.mutable_image()->set_width(this->camera->ImageWidth());
     msg.mutable_image()->set_height(this->camera->ImageHeight());
     msg.mutable_image()->set_pixel_format(common::Image::R_FLOAT32);
@@ -184,7 +184,9 @@ bool DepthCameraSensor::UpdateImpl(const bool /*_force*/)
         this->dataPtr->depthBuffer[i] = -ignition::math::INF_D;
       }
     }
+    const size_t capacity = msg.image().data().capacity();
     msg.mutable_image()->set_data(this->dataPtr->depthBuffer, depthBufferSize);
+    this->CountBufferAllocation(capacity, msg.image().data().capacity());
     this->imagePub->Publish(msg);
   }
 
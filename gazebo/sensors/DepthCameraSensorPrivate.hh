@@ -17,6 +17,7 @@
 #ifndef _GAZEBO_SENSORS_DEPTHCAMERASENSOR_PRIVATE_HH_
 #define _GAZEBO_SENSORS_DEPTHCAMERASENSOR_PRIVATE_HH_
 
+#include "gazebo/msgs/msgs.hh"
 #include "gazebo/rendering/RenderTypes.hh"
 
 namespace gazebo
@@ -32,6 +33,10 @@ namespace gazebo
 
       /// \brief Local pointer to the depthCamera.
       public: rendering::DepthCameraPtr depthCamera;
+
+      /// \brief Depth image message, reused across updates so its data
+      /// buffer is only allocated once.
+      public: msgs::ImageStamped imageMsg;
     };
   }
 }
@@ -148,7 +148,7 @@ void GaussianNoiseModel::Fini()
 double GaussianNoiseModel::ApplyImpl(double _in, double _dt)
 {
   // Add independent (uncorrelated) Gaussian noise to each input value.
-  double whiteNoise = ignition::math::Rand::DblNormal(this->mean, this->stdDev);
+  double whiteNoise = this->Normal(this->mean, this->stdDev);
 
   // Generate varying (correlated) bias for each input value.
   // This implementation is based on the one available in Rotors:
@@ -168,8 +168,7 @@ double GaussianNoiseModel::ApplyImpl(double _in, double _dt)
         tau / 2 * expm1(-2 * _dt / tau));
 
     const double phiD = exp(-_dt / tau);
-    this->bias = phiD * this->bias +
-      ignition::math::Rand::DblNormal(0, sigmaBD);
+    this->bias = phiD * this->bias + this->Normal(0, sigmaBD);
   }
 
   double output = _in + this->bias + whiteNoise;
@@ -184,6 +183,58 @@ double GaussianNoiseModel::ApplyImpl(double _in, double _dt)
   return output;
 }
 
+//////////////////////////////////////////////////
+void GaussianNoiseModel::ApplyBatchImpl(double *_data, const size_t _count,
+    const double _dt)
+{
+  this->normals.resize(_count);
+
+  // Independent (uncorrelated) Gaussian noise for every value
+  if (this->stdDev > 0)
+  {
+    this->SampleNormal(this->normals.data(), _count);
+    for (size_t i = 0; i < _count; ++i)
+      _data[i] += this->mean + this->stdDev * this->normals[i];
+  }
+  else
+  {
+    for (size_t i = 0; i < _count; ++i)
+      _data[i] += this->mean;
+  }
+
+  // Correlated bias, advanced once per value as in ApplyImpl
+  if (this->dynamicBiasStdDev > 0 &&
+      this->dynamicBiasCorrTime > 0)
+  {
+    const double sigmaB = this->dynamicBiasStdDev;
+    const double tau = this->dynamicBiasCorrTime;
+
+    const double sigmaBD = sqrt(-sigmaB * sigmaB *
+        tau / 2 * expm1(-2 * _dt / tau));
+
+    const double phiD = exp(-_dt / tau);
+
+    this->SampleNormal(this->normals.data(), _count);
+    for (size_t i = 0; i < _count; ++i)
+    {
+      this->bias = phiD * this->bias + sigmaBD * this->normals[i];
+      _data[i] += this->bias;
+    }
+  }
+  else
+  {
+    for (size_t i = 0; i < _count; ++i)
+      _data[i] += this->bias;
+  }
+
+  if (this->quantized &&
+      !ignition::math::equal(this->precision, 0.0, 1e-6))
+  {
+    for (size_t i = 0; i < _count; ++i)
+      _data[i] = std::round(_data[i] / this->precision) * this->precision;
+  }
+}
+
 //////////////////////////////////////////////////
 double GaussianNoiseModel::GetMean() const
 {
@@ -221,16 +272,30 @@ void GaussianNoiseModel::SampleBias()
 {
   if(!ignition::math::equal(0.0, this->biasStdDev, 1e-6))
   {
-    this->bias =
-        ignition::math::Rand::DblNormal(this->biasMean, this->biasStdDev);
+    this->bias = this->Normal(this->biasMean, this->biasStdDev);
     // With equal probability, we pick a negative bias (by convention,
     // rateBiasMean should be positive, though it would work fine if
     // negative).
-    if (ignition::math::Rand::DblUniform() < 0.5)
+    if (std::uniform_real_distribution<double>(0, 1)(this->generator) < 0.5)
       this->bias = -this->bias;
   }
 }
 
+//////////////////////////////////////////////////
+void GaussianNoiseModel::SetSeed(const uint32_t _seed)
+{
+  Noise::SetSeed(_seed);
+  this->SampleBias();
+}
+
+//////////////////////////////////////////////////
+double GaussianNoiseModel::Normal(const double _mean, const double _stdDev)
+{
+  if (_stdDev <= 0)
+    return _mean;
+  return std::normal_distribution<double>(_mean, _stdDev)(this->generator);
+}
+
 //////////////////////////////////////////////////
 void GaussianNoiseModel::Print(std::ostream &_out) const
 {
@@ -57,6 +57,10 @@ namespace gazebo
         // Documentation inherited.
         public: double ApplyImpl(double _in, double _dt);
 
+        // Documentation inherited.
+        public: virtual void ApplyBatchImpl(double *_data,
+                    const size_t _count, const double _dt);
+
         /// \brief Accessor for mean.
         /// \return Mean of Gaussian noise.
         public: double GetMean() const;
@@ -96,9 +100,24 @@ namespace gazebo
         /// Documentation inherited
         public: virtual void Print(std::ostream &_out) const;
 
+        /// \brief Seed the random number stream and sample a new bias from
+        /// it.
+        /// \param[in] _seed The seed.
+        public: virtual void SetSeed(const uint32_t _seed);
+
         /// \brief Sample the bias.
         private: void SampleBias();
 
+        /// \brief Draw a normally distributed value from this model's
+        /// random number stream.
+        /// \param[in] _mean Mean of the distribution.
+        /// \param[in] _stdDev Standard deviation of the distribution.
+        /// \return The value, or _mean if _stdDev is not positive.
+        private: double Normal(const double _mean, const double _stdDev);
+
+        /// \brief Scratch space for the normal values of ApplyBatchImpl.
+        private: std::vector<double> normals;
+
         /// \brief If type starts with GAUSSIAN, the mean of the distribution
         /// from which we sample when adding noise.
         protected: double mean;
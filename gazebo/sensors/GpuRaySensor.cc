@@ -104,6 +104,9 @@ void GpuRaySensor::Load(const std::string &_worldName)
 
   this->dataPtr->scanPub =
     this->node->Advertise<msgs::LaserScanStamped>(this->Topic(), 50);
+  this->dataPtr->cloudPub =
+    this->node->Advertise<msgs::PointCloudPackedStamped>(
+        RayPointCloud::Topic(this->Topic()), 50);
 
   sdf::ElementPtr rayElem = this->sdf->GetElement("ray");
   this->dataPtr->scanElem = rayElem->GetElement("scan");
@@ -353,6 +356,7 @@ void GpuRaySensor::Init()
 void GpuRaySensor::Fini()
 {
   this->dataPtr->scanPub.reset();
+  this->dataPtr->cloudPub.reset();
 
   if (this->dataPtr->laserCam)
   {
@@ -684,7 +688,9 @@ void GpuRaySensor::Render()
     if (!this->dataPtr->renderNeeded)
       return;
 
+    auto start = std::chrono::steady_clock::now();
     this->dataPtr->laserCam->Render();
+    this->AddRenderTime(start);
     this->dataPtr->rendered = true;
     this->dataPtr->renderNeeded = false;
   }
@@ -695,7 +701,9 @@ void GpuRaySensor::Render()
 
     this->lastMeasurementTime = this->scene->SimTime();
 
+    auto start = std::chrono::steady_clock::now();
     this->dataPtr->laserCam->Render();
+    this->AddRenderTime(start);
     this->dataPtr->rendered = true;
   }
 }
@@ -741,6 +749,8 @@ bool GpuRaySensor::UpdateImpl(const bool /*_force*/)
   if (scan->ranges_size() != numRays)
   {
     // gzdbg << "Size mismatch; allocating memory\n";
+    const size_t capacity = scan->ranges().Capacity() +
+        scan->intensities().Capacity();
     scan->clear_ranges();
     scan->clear_intensities();
     for (int i = 0; i < numRays; ++i)
@@ -748,8 +758,15 @@ bool GpuRaySensor::UpdateImpl(const bool /*_force*/)
       scan->add_ranges(ignition::math::NAN_F);
       scan->add_intensities(ignition::math::NAN_F);
     }
+    this->CountBufferAllocation(capacity, scan->ranges().Capacity() +
+        scan->intensities().Capacity());
   }
 
+  // Ranges that need noise are collected and noised in one batch
+  const bool noisy = this->noises.find(GPU_RAY_NOISE) != this->noises.end();
+  this->dataPtr->noiseIndices.clear();
+  this->dataPtr->noiseRanges.clear();
+
   auto dataIter = this->dataPtr->laserCam->LaserDataBegin();
   auto dataEnd = this->dataPtr->laserCam->LaserDataEnd();
   for (int i = 0; dataIter != dataEnd; ++dataIter, ++i)
@@ -767,11 +784,10 @@ bool GpuRaySensor::UpdateImpl(const bool /*_force*/)
     {
       range = -ignition::math::INF_D;
     }
-    else if (this->noises.find(GPU_RAY_NOISE) != this->noises.end())
+    else if (noisy)
     {
-      range = this->noises[GPU_RAY_NOISE]->Apply(range);
-      range = ignition::math::clamp(range,
-          this->dataPtr->rangeMin, this->dataPtr->rangeMax);
+      this->dataPtr->noiseIndices.push_back(i);
+      this->dataPtr->noiseRanges.push_back(range);
     }
 
     range = ignition::math::isnan(range) ? this->dataPtr->rangeMax : range;
@@ -779,9 +795,30 @@ bool GpuRaySensor::UpdateImpl(const bool /*_force*/)
     scan->set_intensities(i, intensity);
   }
 
+  if (!this->dataPtr->noiseRanges.empty())
+  {
+    this->noises[GPU_RAY_NOISE]->Apply(this->dataPtr->noiseRanges.data(),
+        this->dataPtr->noiseRanges.size());
+    for (size_t k = 0; k < this->dataPtr->noiseRanges.size(); ++k)
+    {
+      double range = ignition::math::clamp(this->dataPtr->noiseRanges[k],
+          this->dataPtr->rangeMin, this->dataPtr->rangeMax);
+      range = ignition::math::isnan(range) ? this->dataPtr->rangeMax : range;
+      scan->set_ranges(this->dataPtr->noiseIndices[k], range);
+    }
+  }
+
   if (this->dataPtr->scanPub && this->dataPtr->scanPub->HasConnections())
     this->dataPtr->scanPub->Publish(this->dataPtr->laserMsg);
 
+  // Points are only computed for subscribers
+  if (this->dataPtr->cloudPub && this->dataPtr->cloudPub->HasConnections())
+  {
+    this->dataPtr->cloud.Fill(this->dataPtr->laserMsg,
+        this->dataPtr->cloudMsg);
+    this->dataPtr->cloudPub->Publish(this->dataPtr->cloudMsg);
+  }
+
   this->dataPtr->rendered = false;
   IGN_PROFILE_END();
   return true;
@@ -791,7 +828,8 @@ bool GpuRaySensor::UpdateImpl(const bool /*_force*/)
 bool GpuRaySensor::IsActive() const
 {
   return Sensor::IsActive() ||
-    (this->dataPtr->scanPub && this->dataPtr->scanPub->HasConnections());
+    (this->dataPtr->scanPub && this->dataPtr->scanPub->HasConnections()) ||
+    (this->dataPtr->cloudPub && this->dataPtr->cloudPub->HasConnections());
 }
 
 //////////////////////////////////////////////////
@@ -19,9 +19,11 @@
 
 #include <limits>
 #include <mutex>
+#include <vector>
 #include <sdf/sdf.hh>
 
 #include "gazebo/rendering/RenderTypes.hh"
+#include "gazebo/sensors/RayPointCloud.hh"
 #include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/msgs/msgs.hh"
@@ -85,12 +87,27 @@ namespace gazebo
       /// \brief Publisher to publish ray sensor data
       public: transport::PublisherPtr scanPub;
 
+      /// \brief Publisher for point clouds built from the scans.
+      public: transport::PublisherPtr cloudPub;
+
+      /// \brief Converts the scans to point clouds.
+      public: RayPointCloud cloud;
+
+      /// \brief Point cloud message, reused between updates.
+      public: msgs::PointCloudPackedStamped cloudMsg;
+
       /// \brief True if the sensor was rendered.
       public: bool rendered;
 
       /// \brief True if the sensor needs a rendering
       public: bool renderNeeded = false;
 
+      /// \brief Scan indices of the ranges that get noise this update.
+      public: std::vector<int> noiseIndices;
+
+      /// \brief Ranges that get noise this update, noised in one batch.
+      public: std::vector<double> noiseRanges;
+
       /// \brief Timestamp of the forthcoming rendering
       public: double nextRenderingTime
                            = std::numeric_limits<double>::quiet_NaN();
@@ -303,8 +303,9 @@ bool ImuSensor::UpdateImpl(const bool /*_force*/)
 {
   IGN_PROFILE("ImuSensor::UpdateImpl");
   IGN_PROFILE_BEGIN("Update");
-  msgs::LinkData msg;
-  int readIndex = 0;
+  // Incoming messages are never modified, so hold on to the latest one
+  // instead of copying it
+  ConstLinkDataPtr data;
 
   {
     std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
@@ -313,13 +314,13 @@ bool ImuSensor::UpdateImpl(const bool /*_force*/)
     if (!this->dataPtr->dataDirty)
       return false;
 
-    readIndex = this->dataPtr->dataIndex;
+    // toggle the index
+    data = this->dataPtr->incomingLinkData[this->dataPtr->dataIndex];
     this->dataPtr->dataIndex ^= 1;
     this->dataPtr->dataDirty = false;
   }
 
-  // toggle the index
-  msg.CopyFrom(*this->dataPtr->incomingLinkData[readIndex].get());
+  const msgs::LinkData &msg = *data;
 
   common::Time timestamp = msgs::Convert(msg.time());
 
@@ -14,12 +14,16 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <cmath>
+
 #include <boost/algorithm/string.hpp>
 #include <ignition/common/Profiler.hh>
 #include "gazebo/transport/transport.hh"
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/Model.hh"
+#include "gazebo/physics/SpatialIndex.hh"
 
 #include "gazebo/sensors/SensorFactory.hh"
 #include "gazebo/sensors/LogicalCameraSensorPrivate.hh"
@@ -102,6 +106,11 @@ void LogicalCameraSensor::Init()
   }
 
   Sensor::Init();
+
+  // Let the world maintain its spatial index, so that UpdateImpl only
+  // tests the models near the frustum
+  if (this->world)
+    this->world->SetSpatialIndexEnabled(true);
 }
 
 //////////////////////////////////////////////////
@@ -137,6 +146,31 @@ void LogicalCameraSensorPrivate::AddVisibleModels(
   }
 }
 
+//////////////////////////////////////////////////
+ignition::math::AxisAlignedBox LogicalCameraSensorPrivate::FrustumBox() const
+{
+  // The frustum looks down its +X axis
+  const double halfWidth = std::tan(this->frustum.FOV().Radian() * 0.5);
+  const double halfHeight = halfWidth / this->frustum.AspectRatio();
+  const ignition::math::Pose3d &pose = this->frustum.Pose();
+
+  ignition::math::AxisAlignedBox box;
+  for (double dist : {this->frustum.Near(), this->frustum.Far()})
+  {
+    for (double y : {-1.0, 1.0})
+    {
+      for (double z : {-1.0, 1.0})
+      {
+        const ignition::math::Vector3d corner = pose.CoordPositionAdd(
+            ignition::math::Vector3d(dist, y * dist * halfWidth,
+              z * dist * halfHeight));
+        box.Merge(ignition::math::AxisAlignedBox(corner, corner));
+      }
+    }
+  }
+  return box;
+}
+
 //////////////////////////////////////////////////
 bool LogicalCameraSensor::UpdateImpl(const bool _force)
 {
@@ -159,7 +193,27 @@ bool LogicalCameraSensor::UpdateImpl(const bool _force)
     msgs::Set(this->dataPtr->msg.mutable_pose(), myPose);
 
     // Recursively check if models and nested models are in the frustum.
-    this->dataPtr->AddVisibleModels(myPose, this->world->Models());
+    // The spatial index boxes cover nested models, so the top level models
+    // it returns are the only ones that can hold a visible model. It is
+    // refreshed once per world update and is empty until then.
+    const physics::SpatialIndex &index = this->world->ModelSpatialIndex();
+    if (this->world->SpatialIndexEnabled() && index.Size() > 0)
+    {
+      physics::Model_V candidates =
+          index.ModelsInBox(this->dataPtr->FrustumBox());
+
+      // Report models in the order they were created, as the world does
+      std::sort(candidates.begin(), candidates.end(),
+          [](const physics::ModelPtr &_a, const physics::ModelPtr &_b)
+          {
+            return _a->GetId() < _b->GetId();
+          });
+      this->dataPtr->AddVisibleModels(myPose, candidates);
+    }
+    else
+    {
+      this->dataPtr->AddVisibleModels(myPose, this->world->Models());
+    }
     IGN_PROFILE_END();
 
     IGN_PROFILE_BEGIN("Publish");
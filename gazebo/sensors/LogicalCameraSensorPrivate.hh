@@ -19,6 +19,7 @@
 
 #include <mutex>
 #include <string>
+#include <ignition/math/AxisAlignedBox.hh>
 #include <ignition/math/Frustum.hh>
 #include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/msgs/msgs.hh"
@@ -38,6 +39,10 @@ namespace gazebo
       public: void AddVisibleModels(ignition::math::Pose3d &_myPose,
         const physics::Model_V &_models);
 
+      /// \brief Get the world axis aligned box around the frustum.
+      /// \return Box containing the eight corners of the frustum.
+      public: ignition::math::AxisAlignedBox FrustumBox() const;
+
       /// \brief Publisher of msgs::LogicalCameraImage messages.
       public: transport::PublisherPtr pub;
 
@@ -31,6 +31,7 @@
 
 #include "gazebo/rendering/RenderEngine.hh"
 #include "gazebo/rendering/Camera.hh"
+#include "gazebo/rendering/CameraRig.hh"
 #include "gazebo/rendering/Scene.hh"
 #include "gazebo/rendering/RenderingIface.hh"
 
@@ -178,6 +179,15 @@ void MultiCameraSensor::Init()
     {
       std::lock_guard<std::mutex> lock(this->dataPtr->cameraMutex);
       this->dataPtr->cameras.push_back(camera);
+
+      // Cameras of the sensor are rendered at the same time from nearly
+      // the same place, so they can share culling and shadow maps
+      if (rendering::CameraRig::Enabled())
+      {
+        if (!this->dataPtr->rig)
+          this->dataPtr->rig.reset(new rendering::CameraRig(this->scene));
+        this->dataPtr->rig->AddCamera(camera);
+      }
     }
 
     msgs::Image *image = this->dataPtr->msg.add_image();
@@ -206,6 +216,7 @@ void MultiCameraSensor::Fini()
 
   std::lock_guard<std::mutex> lock(this->dataPtr->cameraMutex);
 
+  this->dataPtr->rig.reset();
   for (std::vector<rendering::CameraPtr>::iterator iter =
       this->dataPtr->cameras.begin();
       iter != this->dataPtr->cameras.end(); ++iter)
@@ -334,11 +345,7 @@ void MultiCameraSensor::Render()
       return;
     }
 
-    for (auto iter = this->dataPtr->cameras.begin();
-        iter != this->dataPtr->cameras.end(); ++iter)
-    {
-      (*iter)->Render();
-    }
+    this->RenderCameras();
 
     this->dataPtr->rendered = true;
     this->dataPtr->renderNeeded = false;
@@ -357,15 +364,30 @@ void MultiCameraSensor::Render()
       return;
     }
 
+    this->RenderCameras();
+
+    this->dataPtr->rendered = true;
+    this->lastMeasurementTime = this->scene->SimTime();
+  }
+}
+
+//////////////////////////////////////////////////
+void MultiCameraSensor::RenderCameras()
+{
+  auto start = std::chrono::steady_clock::now();
+  if (this->dataPtr->rig)
+  {
+    this->dataPtr->rig->Render();
+  }
+  else
+  {
     for (auto iter = this->dataPtr->cameras.begin();
         iter != this->dataPtr->cameras.end(); ++iter)
     {
       (*iter)->Render();
     }
-
-    this->dataPtr->rendered = true;
-    this->lastMeasurementTime = this->scene->SimTime();
   }
+  this->AddRenderTime(start);
 }
 
 //////////////////////////////////////////////////
@@ -123,6 +123,9 @@ namespace gazebo
       /// \brief Handle the prerenderEnded event.
       private: void PrerenderEnded();
 
+      /// \brief Render all the cameras, through the rig if there is one.
+      private: void RenderCameras();
+
       /// \internal
       /// \brief Private data pointer
       private: std::unique_ptr<MultiCameraSensorPrivate> dataPtr;
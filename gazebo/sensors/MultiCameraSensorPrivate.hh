@@ -18,10 +18,12 @@
 #define _GAZEBO_SENSORS_MULTICAMERA_SENSOR_PRIVATE_HH_
 
 #include <vector>
+#include <memory>
 #include <mutex>
 #include <limits>
 
 #include "gazebo/msgs/msgs.hh"
+#include "gazebo/rendering/CameraRig.hh"
 #include "gazebo/transport/TransportTypes.hh"
 
 namespace gazebo
@@ -35,6 +37,10 @@ namespace gazebo
       /// \brief All the cameras.
       public: std::vector<rendering::CameraPtr> cameras;
 
+      /// \brief Renders the cameras together when GAZEBO_CAMERA_RIG is
+      /// set, null otherwise.
+      public: std::unique_ptr<rendering::CameraRig> rig;
+
       /// \brief Mutex to protect the cameras list.
       public: mutable std::mutex cameraMutex;
 
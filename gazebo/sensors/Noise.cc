@@ -15,12 +15,19 @@
  *
 */
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <boost/function.hpp>
+#include <ignition/math/Helpers.hh>
+#include <ignition/math/Rand.hh>
+
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
 
 #include "gazebo/sensors/GaussianNoiseModel.hh"
 #include "gazebo/sensors/Noise.hh"
+#include "gazebo/sensors/NoisePrivate.hh"
 
 using namespace gazebo;
 using namespace sensors;
@@ -73,8 +80,19 @@ NoisePtr NoiseFactory::NewNoiseModel(sdf::ElementPtr _sdf,
 
 //////////////////////////////////////////////////
 Noise::Noise(NoiseType _type)
-  : type(_type)
+  : type(_type),
+    dataPtr(new NoisePrivate)
 {
+  this->generator.seed(ignition::math::Rand::IntUniform(0,
+        std::numeric_limits<int>::max()));
+  this->dataPtr->Seed(this->generator);
+}
+
+//////////////////////////////////////////////////
+void Noise::SetSeed(const uint32_t _seed)
+{
+  this->generator.seed(_seed);
+  this->dataPtr->Seed(this->generator);
 }
 
 //////////////////////////////////////////////////
@@ -118,12 +136,61 @@ double Noise::Apply(double _in, double _dt)
     return this->ApplyImpl(_in, _dt);
 }
 
+//////////////////////////////////////////////////
+void Noise::Apply(double *_data, const size_t _count, const double _dt)
+{
+  if (this->type == NONE || _count == 0)
+    return;
+  else if (this->type == CUSTOM)
+  {
+    for (size_t i = 0; i < _count; ++i)
+      _data[i] = this->Apply(_data[i], _dt);
+  }
+  else
+    this->ApplyBatchImpl(_data, _count, _dt);
+}
+
 //////////////////////////////////////////////////
 double Noise::ApplyImpl(double _in, double /*_dt*/)
 {
   return _in;
 }
 
+//////////////////////////////////////////////////
+void Noise::ApplyBatchImpl(double *_data, const size_t _count,
+    const double _dt)
+{
+  for (size_t i = 0; i < _count; ++i)
+    _data[i] = this->ApplyImpl(_data[i], _dt);
+}
+
+//////////////////////////////////////////////////
+void Noise::SampleNormal(double *_out, const size_t _count)
+{
+  const unsigned int lanes = NoisePrivate::kLanes;
+  double u1[lanes];
+  double u2[lanes];
+  double z[2 * lanes];
+
+  // Box-Muller on every lane, each pair of uniforms gives two values
+  for (size_t i = 0; i < _count; i += 2 * lanes)
+  {
+    this->dataPtr->NextUniform(u1);
+    this->dataPtr->NextUniform(u2);
+
+    for (unsigned int l = 0; l < lanes; ++l)
+    {
+      const double r = std::sqrt(-2.0 * std::log(u1[l]));
+      const double theta = 2.0 * IGN_PI * u2[l];
+      z[l] = r * std::cos(theta);
+      z[l + lanes] = r * std::sin(theta);
+    }
+
+    const size_t n = std::min(static_cast<size_t>(2 * lanes), _count - i);
+    std::copy(z, z + n, _out + i);
+  }
+}
+
 //////////////////////////////////////////////////
 Noise::NoiseType Noise::GetNoiseType() const
 {
@@ -18,6 +18,9 @@
 #ifndef _GAZEBO_NOISE_HH_
 #define _GAZEBO_NOISE_HH_
 
+#include <cstddef>
+#include <memory>
+#include <random>
 #include <vector>
 #include <string>
 
@@ -32,6 +35,9 @@ namespace gazebo
 {
   namespace sensors
   {
+    // Forward declare private data class
+    class NoisePrivate;
+
     /// \addtogroup gazebo_sensors
     /// \{
 
@@ -88,6 +94,26 @@ namespace gazebo
       /// \return Data with noise applied.
       public: virtual double ApplyImpl(double _in, double _dt = 0.0);
 
+      /// \brief Apply noise to an array of values in place, as if Apply
+      /// was called on each of them in order. Use this for sensors that
+      /// produce many values with the same noise model, such as ray
+      /// sensors.
+      /// \param[in, out] _data Values to apply noise to.
+      /// \param[in] _count Number of values.
+      /// \param[in] _dt Time since the previous call, passed on for each
+      /// value.
+      public: void Apply(double *_data, const size_t _count,
+                  const double _dt = 0.0);
+
+      /// \brief Apply noise to an array of values. This gets overriden by
+      /// derived classes, and called by Apply. The default calls ApplyImpl
+      /// on each value.
+      /// \param[in, out] _data Values to apply noise to.
+      /// \param[in] _count Number of values.
+      /// \param[in] _dt Time since the previous call.
+      public: virtual void ApplyBatchImpl(double *_data, const size_t _count,
+                  const double _dt);
+
       /// \brief Finalize the noise model
       public: virtual void Fini();
 
@@ -123,6 +149,23 @@ namespace gazebo
       /// \param[in] _out Output stream
       public: virtual void Print(std::ostream &_out) const;
 
+      /// \brief Seed the random number stream of this noise model. Each
+      /// noise model draws from its own stream, so that its output does
+      /// not depend on the order in which sensors are updated.
+      /// \param[in] _seed The seed.
+      public: virtual void SetSeed(const uint32_t _seed);
+
+      /// \brief Random number stream of this noise model. By default it is
+      /// seeded from ignition::math::Rand.
+      protected: std::mt19937 generator;
+
+      /// \brief Fill an array with standard normal values. This draws
+      /// several values at a time from a fast stream, seeded together with
+      /// the generator, and is meant for ApplyBatchImpl.
+      /// \param[out] _out Array to fill.
+      /// \param[in] _count Number of values.
+      protected: void SampleNormal(double *_out, const size_t _count);
+
       /// \brief Which type of noise we're applying
       private: NoiseType type;
 
@@ -134,6 +177,10 @@ namespace gazebo
 
       /// \brief Callback function for applying custom noise to sensor data.
       private: std::function<double (double, double)> customNoiseCallbackTime;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<NoisePrivate> dataPtr;
     };
     /// \}
   }
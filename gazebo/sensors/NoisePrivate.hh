@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef _GAZEBO_SENSORS_NOISE_PRIVATE_HH_
+#define _GAZEBO_SENSORS_NOISE_PRIVATE_HH_
+
+#include <cstdint>
+#include <random>
+
+namespace gazebo
+{
+  namespace sensors
+  {
+    /// \internal
+    /// \brief Noise private data.
+    class NoisePrivate
+    {
+      /// \brief Number of independent streams advanced together.
+      public: static const unsigned int kLanes = 4;
+
+      /// \brief Seed the streams from a generator.
+      /// \param[in] _gen Generator to draw the seeds from.
+      public: void Seed(std::mt19937 &_gen)
+      {
+        uint64_t x = (static_cast<uint64_t>(_gen()) << 32) | _gen();
+        for (unsigned int w = 0; w < 4; ++w)
+        {
+          for (unsigned int l = 0; l < kLanes; ++l)
+          {
+            // splitmix64, which never yields an all zero state
+            uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            this->state[w][l] = z ^ (z >> 31);
+          }
+        }
+      }
+
+      /// \brief Draw one uniform value in (0, 1] from every stream.
+      /// \param[out] _out One value per stream.
+      public: void NextUniform(double _out[kLanes])
+      {
+        // xoshiro256+, laid out word-major so the lanes vectorize
+        for (unsigned int l = 0; l < kLanes; ++l)
+        {
+          const uint64_t result = this->state[0][l] + this->state[3][l];
+          const uint64_t t = this->state[1][l] << 17;
+
+          this->state[2][l] ^= this->state[0][l];
+          this->state[3][l] ^= this->state[1][l];
+          this->state[1][l] ^= this->state[2][l];
+          this->state[0][l] ^= this->state[3][l];
+          this->state[2][l] ^= t;
+          this->state[3][l] =
+              (this->state[3][l] << 45) | (this->state[3][l] >> 19);
+
+          _out[l] = ((result >> 11) + 1) * (1.0 / 9007199254740992.0);
+        }
+      }
+
+      /// \brief State of the streams, indexed by word then lane.
+      public: uint64_t state[4][kLanes];
+    };
+  }
+}
+#endif
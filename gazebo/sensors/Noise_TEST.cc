@@ -17,12 +17,16 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <vector>
+
 #include <boost/accumulators/accumulators.hpp>
 #include <boost/accumulators/statistics/stats.hpp>
 #include <boost/accumulators/statistics/mean.hpp>
 #include <boost/accumulators/statistics/variance.hpp>
 #include <boost/bind/bind.hpp>
 
+#include <ignition/math/Helpers.hh>
 #include <ignition/math/Rand.hh>
 
 #include "gazebo/sensors/Noise.hh"
@@ -159,6 +163,94 @@ void GaussianNoise(sensors::NoisePtr _noise, unsigned int _count)
               variance, g_sigma*sqrt(sampleVariance2));
 }
 
+////////////////////////////////////////////////////////////////
+// Noise models seeded alike produce the same values, whatever else draws
+// random numbers in between
+TEST_F(NoiseTest, Seed)
+{
+  sensors::NoisePtr noise1 = sensors::NoiseFactory::NewNoiseModel(
+      NoiseSdf("gaussian", 0.5, 1.0, 0.1, 0.2, 0));
+  sensors::NoisePtr noise2 = sensors::NoiseFactory::NewNoiseModel(
+      NoiseSdf("gaussian", 0.5, 1.0, 0.1, 0.2, 0));
+  sensors::NoisePtr noise3 = sensors::NoiseFactory::NewNoiseModel(
+      NoiseSdf("gaussian", 0.5, 1.0, 0.1, 0.2, 0));
+
+  noise1->SetSeed(1234);
+  noise2->SetSeed(1234);
+  noise3->SetSeed(4321);
+
+  bool differs = false;
+  for (unsigned int i = 0; i < g_applyCount; ++i)
+  {
+    double value1 = noise1->Apply(0.0);
+    ignition::math::Rand::DblNormal(0, 1);
+    double value2 = noise2->Apply(0.0);
+    EXPECT_DOUBLE_EQ(value1, value2);
+
+    differs = differs || !ignition::math::equal(value1, noise3->Apply(0.0));
+  }
+  EXPECT_TRUE(differs);
+}
+
+////////////////////////////////////////////////////////////////
+// Batch application has the same statistics as applying one by one, and
+// is reproducible once seeded
+TEST_F(NoiseTest, ApplyBatch)
+{
+  sensors::NoisePtr noise = sensors::NoiseFactory::NewNoiseModel(
+      NoiseSdf("gaussian", 0.5, 1.0, 0.1, 0.2, 0));
+  sensors::GaussianNoiseModelPtr noiseModel =
+      std::dynamic_pointer_cast<sensors::GaussianNoiseModel>(noise);
+  ASSERT_TRUE(noiseModel != nullptr);
+
+  // Odd count to exercise a partial block
+  const size_t count = 10001;
+  const double x = 42.0;
+  std::vector<double> data(count, x);
+  noise->Apply(data.data(), data.size());
+
+  boost::accumulators::accumulator_set<double,
+    boost::accumulators::stats<boost::accumulators::tag::mean,
+                               boost::accumulators::tag::variance > > acc;
+  for (auto y : data)
+    acc(y);
+
+  double mean = noiseModel->GetMean() + noiseModel->GetBias();
+  double stddev = noiseModel->GetStdDev();
+  EXPECT_NEAR(boost::accumulators::mean(acc), x + mean,
+      g_sigma * stddev / sqrt(count));
+
+  double variance = stddev * stddev;
+  double sampleVariance2 = 2 * variance * variance / (count - 1);
+  EXPECT_NEAR(boost::accumulators::variance(acc),
+      variance, g_sigma * sqrt(sampleVariance2));
+
+  // Same seed, same values
+  std::vector<double> data1(count, 0.0);
+  std::vector<double> data2(count, 0.0);
+  noise->SetSeed(1234);
+  noise->Apply(data1.data(), data1.size());
+  noise->SetSeed(1234);
+  noise->Apply(data2.data(), data2.size());
+  for (size_t i = 0; i < count; ++i)
+    EXPECT_DOUBLE_EQ(data1[i], data2[i]);
+
+  // Quantization applies to every value
+  noise = sensors::NoiseFactory::NewNoiseModel(
+      NoiseSdf("gaussian_quantized", 0.0, 1.0, 0.0, 0.0, 0.5));
+  noise->Apply(data.data(), data.size());
+  for (auto y : data)
+    EXPECT_DOUBLE_EQ(std::round(y / 0.5) * 0.5, y);
+
+  // None leaves the values alone
+  noise = sensors::NoiseFactory::NewNoiseModel(
+      NoiseSdf("none", 0, 0, 0, 0, 0));
+  data.assign(count, x);
+  noise->Apply(data.data(), data.size());
+  for (auto y : data)
+    EXPECT_DOUBLE_EQ(x, y);
+}
+
 //////////////////////////////////////////////////
 // Test noise application
 TEST_F(NoiseTest, ApplyNone)
@@ -372,6 +464,13 @@ TEST_F(NoiseTest, OnApplyNoise)
     double value = noise->Apply(i);
     EXPECT_DOUBLE_EQ(value, i*2);
   }
+
+  // The batch version goes through the callback too
+  std::vector<double> data = {1.0, 2.0, 3.0};
+  noise->Apply(data.data(), data.size());
+  EXPECT_DOUBLE_EQ(data[0], 2.0);
+  EXPECT_DOUBLE_EQ(data[1], 4.0);
+  EXPECT_DOUBLE_EQ(data[2], 6.0);
 }
 
 /////////////////////////////////////////////////
@@ -14,12 +14,17 @@
  * limitations under the License.
  *
 */
+#include <string>
+#include <unordered_set>
+
 #include <ignition/common/Profiler.hh>
 
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/transport/transport.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/Entity.hh"
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/ProximityIndex.hh"
 
 #include "gazebo/sensors/RFIDTag.hh"
 #include "gazebo/sensors/SensorFactory.hh"
@@ -31,6 +36,17 @@ using namespace sensors;
 
 GZ_REGISTER_STATIC_SENSOR("rfid", RFIDSensor)
 
+/// \brief Distance within which tags are detected, in meters.
+static const double kTagRange = 5.0;
+
+/// \brief Get the name of the top level model from a scoped name.
+/// \param[in] _scopedName Scoped name of a link, such as a sensor parent.
+/// \return Name of the top level model.
+static std::string TopModelName(const std::string &_scopedName)
+{
+  return _scopedName.substr(0, _scopedName.find("::"));
+}
+
 /////////////////////////////////////////////////
 RFIDSensor::RFIDSensor()
 : Sensor(sensors::OTHER),
@@ -112,6 +128,11 @@ void RFIDSensor::Fini()
 void RFIDSensor::Init()
 {
   Sensor::Init();
+
+  // Let the world maintain its proximity index, so that EvaluateTags only
+  // checks the tags near the sensor
+  if (this->world)
+    this->world->SetProximityIndexEnabled(true);
 }
 
 //////////////////////////////////////////////////
@@ -126,9 +147,11 @@ bool RFIDSensor::UpdateImpl(const bool /*_force*/)
   if (this->dataPtr->scanPub)
   {
     IGN_PROFILE_BEGIN("Publish");
-    msgs::Pose msg;
-    msgs::Set(&msg, this->dataPtr->entity->WorldPose());
-    this->dataPtr->scanPub->Publish(msg);
+    this->dataPtr->scanPub->PublishIfSubscribed<msgs::Pose>(
+        [this](msgs::Pose &_msg)
+        {
+          msgs::Set(&_msg, this->dataPtr->entity->WorldPose());
+        });
     IGN_PROFILE_END();
   }
 
@@ -138,11 +161,28 @@ bool RFIDSensor::UpdateImpl(const bool /*_force*/)
 //////////////////////////////////////////////////
 void RFIDSensor::EvaluateTags()
 {
+  // Models whose bounding sphere reaches the detection range. Tags hang off
+  // links, so their scoped name starts with the top level model.
+  const physics::ProximityIndex &index = this->world->ModelProximityIndex();
+  const bool indexed = this->world->ProximityIndexEnabled() && index.Built();
+  std::unordered_set<std::string> nearby;
+  if (indexed)
+  {
+    for (auto const &model : index.ModelsInRadius(
+        this->dataPtr->entity->WorldPose().Pos(), kTagRange))
+    {
+      nearby.insert(model->GetName());
+    }
+  }
+
   std::vector<RFIDTag*>::const_iterator ci;
 
   // iterate through the tags contained given rfid tag manager
   for (ci = this->dataPtr->tags.begin(); ci != this->dataPtr->tags.end(); ++ci)
   {
+    if (indexed && nearby.count(TopModelName((*ci)->ParentName())) == 0)
+      continue;
+
     ignition::math::Pose3d pos = (*ci)->TagPose();
     // std::cout << "link: " << tagModelPtr->GetName() << std::endl;
     // std::cout << "link pos: x" << pos.pos.x
@@ -161,7 +201,7 @@ bool RFIDSensor::CheckTagRange(const ignition::math::Pose3d &_pose)
 
   // std::cout << v.GetLength() << std::endl;
 
-  if (v.Length() <= 5.0)
+  if (v.Length() <= kTagRange)
   {
     // std::cout << "detected " <<  v.GetLength() << std::endl;
     return true;
@@ -95,29 +95,11 @@ bool RFIDTag::UpdateImpl(const bool /*_force*/)
 {
   if (this->dataPtr->scanPub)
   {
-    msgs::Pose msg;
-    msgs::Set(&msg, this->dataPtr->entity->WorldPose());
-
-    // msg.set_position(link->WorldPose().Pos());
-    // msg.set_orientation(link->WorldPose().Rot());
-    // msgs::LaserScan msg;
-
-    // msg.set_frame(this->link->GetScopedName());
-    // msgs::Set(msg.mutable_offset(), this->GetPose());
-    // msg.set_angle_min( this->GetAngleMin().Radian() );
-    // msg.set_angle_max( this->GetAngleMax().Radian() );
-    // msg.set_angle_step( this->GetAngleResolution() );
-
-    // msg.set_range_min( this->GetRangeMin() );
-    // msg.set_range_max( this->GetRangeMax() );
-
-    // for (unsigned int i = 0; i < (unsigned int)this->GetRangeCount(); i++)
-    // {
-    //   msg.add_ranges(this->laserShape->GetRange(i));
-    //   msg.add_intensities(0);
-    // }
-
-    this->dataPtr->scanPub->Publish(msg);
+    this->dataPtr->scanPub->PublishIfSubscribed<msgs::Pose>(
+        [this](msgs::Pose &_msg)
+        {
+          msgs::Set(&_msg, this->dataPtr->entity->WorldPose());
+        });
     // std::cout << "update impl for rfidtag called" << std::endl;
   }
 
@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "gazebo/sensors/RayPointCloud.hh"
+
+using namespace gazebo;
+using namespace sensors;
+
+namespace gazebo
+{
+  namespace sensors
+  {
+    /// \internal
+    /// \brief Private data for RayPointCloud.
+    class RayPointCloudPrivate
+    {
+      /// \brief Horizontal angle of the first ray.
+      public: double angleMin = 0;
+
+      /// \brief Horizontal angle between rays.
+      public: double angleStep = 0;
+
+      /// \brief Number of horizontal rays.
+      public: unsigned int count = 0;
+
+      /// \brief Vertical angle of the first ray.
+      public: double verticalAngleMin = 0;
+
+      /// \brief Vertical angle between rays.
+      public: double verticalAngleStep = 0;
+
+      /// \brief Number of vertical rays.
+      public: unsigned int verticalCount = 0;
+
+      /// \brief Unit direction of each ray, three floats per ray, in the
+      /// order of the ranges.
+      public: std::vector<float> directions;
+    };
+  }
+}
+
+/////////////////////////////////////////////////
+RayPointCloud::RayPointCloud()
+  : dataPtr(new RayPointCloudPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+RayPointCloud::~RayPointCloud()
+{
+}
+
+/////////////////////////////////////////////////
+std::string RayPointCloud::Topic(const std::string &_scanTopic)
+{
+  const std::string suffix = "scan";
+  if (_scanTopic.size() > suffix.size() &&
+      _scanTopic.compare(_scanTopic.size() - suffix.size(), suffix.size(),
+        suffix) == 0 &&
+      _scanTopic[_scanTopic.size() - suffix.size() - 1] == '/')
+  {
+    return _scanTopic.substr(0, _scanTopic.size() - suffix.size()) + "points";
+  }
+  return _scanTopic + "/points";
+}
+
+/////////////////////////////////////////////////
+unsigned int RayPointCloud::Fill(const msgs::LaserScanStamped &_scan,
+    msgs::PointCloudPackedStamped &_msg)
+{
+  const msgs::LaserScan &scan = _scan.scan();
+  const unsigned int count = scan.count();
+  const unsigned int verticalCount =
+      scan.has_vertical_count() ? scan.vertical_count() : 1;
+
+  // Rebuild the ray directions when the scan geometry changes
+  if (count != this->dataPtr->count ||
+      verticalCount != this->dataPtr->verticalCount ||
+      scan.angle_min() != this->dataPtr->angleMin ||
+      scan.angle_step() != this->dataPtr->angleStep ||
+      scan.vertical_angle_min() != this->dataPtr->verticalAngleMin ||
+      scan.vertical_angle_step() != this->dataPtr->verticalAngleStep)
+  {
+    this->dataPtr->count = count;
+    this->dataPtr->verticalCount = verticalCount;
+    this->dataPtr->angleMin = scan.angle_min();
+    this->dataPtr->angleStep = scan.angle_step();
+    this->dataPtr->verticalAngleMin = scan.vertical_angle_min();
+    this->dataPtr->verticalAngleStep = scan.vertical_angle_step();
+
+    this->dataPtr->directions.resize(3 * count * verticalCount);
+    float *dir = this->dataPtr->directions.data();
+    for (unsigned int v = 0; v < verticalCount; ++v)
+    {
+      const double pitch = scan.vertical_angle_min() +
+          v * scan.vertical_angle_step();
+      for (unsigned int h = 0; h < count; ++h)
+      {
+        const double yaw = scan.angle_min() + h * scan.angle_step();
+        *dir++ = static_cast<float>(std::cos(pitch) * std::cos(yaw));
+        *dir++ = static_cast<float>(std::cos(pitch) * std::sin(yaw));
+        *dir++ = static_cast<float>(std::sin(pitch));
+      }
+    }
+  }
+
+  const int rays = std::min(scan.ranges_size(),
+      static_cast<int>(this->dataPtr->directions.size() / 3));
+  const bool hasIntensities = scan.intensities_size() >= rays;
+
+  std::string *data = _msg.mutable_data();
+  data->resize(rays * 4 * sizeof(float));
+  char *out = &(*data)[0];
+
+  unsigned int points = 0;
+  const float *dir = this->dataPtr->directions.data();
+  for (int i = 0; i < rays; ++i, dir += 3)
+  {
+    const double range = scan.ranges(i);
+    if (!std::isfinite(range))
+      continue;
+
+    const float r = static_cast<float>(range);
+    const float point[4] = {dir[0] * r, dir[1] * r, dir[2] * r,
+        hasIntensities ? static_cast<float>(scan.intensities(i)) : 0.0f};
+    std::memcpy(out + points * sizeof(point), point, sizeof(point));
+    ++points;
+  }
+  data->resize(points * 4 * sizeof(float));
+
+  _msg.mutable_time()->CopyFrom(_scan.time());
+  _msg.set_frame(scan.frame());
+  _msg.mutable_world_pose()->CopyFrom(scan.world_pose());
+  _msg.set_count(points);
+  return points;
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_SENSORS_RAYPOINTCLOUD_HH_
+#define GAZEBO_SENSORS_RAYPOINTCLOUD_HH_
+
+#include <memory>
+#include <string>
+
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace sensors
+  {
+    // Forward declare private data class
+    class RayPointCloudPrivate;
+
+    /// \addtogroup gazebo_sensors
+    /// \{
+
+    /// \class RayPointCloud RayPointCloud.hh sensors/sensors.hh
+    /// \brief Converts the ranges of a laser scan to a packed point cloud,
+    /// in the frame of the sensor. Used by RaySensor and GpuRaySensor to
+    /// publish points next to their scans, so consumers don't have to
+    /// redo the conversion from LaserScan messages.
+    ///
+    /// The ray directions are computed once and kept until the scan
+    /// angles or counts change. Ranges that aren't finite, which is how
+    /// out of range readings are reported, produce no point.
+    class GZ_SENSORS_VISIBLE RayPointCloud
+    {
+      /// \brief Constructor.
+      public: RayPointCloud();
+
+      /// \brief Destructor.
+      public: ~RayPointCloud();
+
+      /// \brief Get the point cloud topic that goes with a scan topic.
+      /// \param[in] _scanTopic Topic of the scans, such as
+      /// "~/model/link/laser/scan".
+      /// \return The scan topic with its last "scan" part replaced by
+      /// "points", or with "/points" appended.
+      public: static std::string Topic(const std::string &_scanTopic);
+
+      /// \brief Fill a point cloud message from a scan. The points are
+      /// written straight into the message's data buffer, which keeps its
+      /// capacity between calls.
+      /// \param[in] _scan Scan with ranges and intensities.
+      /// \param[out] _msg Message to fill.
+      /// \return Number of points.
+      public: unsigned int Fill(const msgs::LaserScanStamped &_scan,
+                  msgs::PointCloudPackedStamped &_msg);
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<RayPointCloudPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <limits>
+
+#include <ignition/math/Helpers.hh>
+
+#include "gazebo/sensors/RayPointCloud.hh"
+
+using namespace gazebo;
+
+/////////////////////////////////////////////////
+TEST(RayPointCloudTest, Topic)
+{
+  EXPECT_EQ(sensors::RayPointCloud::Topic("~/model/link/laser/scan"),
+      "~/model/link/laser/points");
+  EXPECT_EQ(sensors::RayPointCloud::Topic("~/model/link/laser"),
+      "~/model/link/laser/points");
+  EXPECT_EQ(sensors::RayPointCloud::Topic("~/model/link/laserscan"),
+      "~/model/link/laserscan/points");
+}
+
+/////////////////////////////////////////////////
+TEST(RayPointCloudTest, Fill)
+{
+  msgs::LaserScanStamped scanMsg;
+  msgs::Set(scanMsg.mutable_time(), common::Time(1, 500));
+  msgs::LaserScan *scan = scanMsg.mutable_scan();
+  scan->set_frame("laser");
+  msgs::Set(scan->mutable_world_pose(),
+      ignition::math::Pose3d(1, 2, 3, 0, 0, 0));
+  scan->set_count(3);
+  scan->set_angle_min(-IGN_PI_2);
+  scan->set_angle_max(IGN_PI_2);
+  scan->set_angle_step(IGN_PI_2);
+  scan->set_vertical_count(1);
+  scan->set_vertical_angle_min(0);
+  scan->set_vertical_angle_max(0);
+  scan->set_vertical_angle_step(0);
+  scan->set_range_min(0.1);
+  scan->set_range_max(10);
+  scan->add_ranges(1);
+  scan->add_ranges(std::numeric_limits<double>::infinity());
+  scan->add_ranges(2);
+  scan->add_intensities(0.5);
+  scan->add_intensities(0);
+  scan->add_intensities(0.25);
+
+  sensors::RayPointCloud cloud;
+  msgs::PointCloudPackedStamped cloudMsg;
+  EXPECT_EQ(cloud.Fill(scanMsg, cloudMsg), 2u);
+  EXPECT_EQ(cloudMsg.count(), 2u);
+  EXPECT_EQ(cloudMsg.frame(), "laser");
+  EXPECT_EQ(msgs::Convert(cloudMsg.time()), common::Time(1, 500));
+  EXPECT_EQ(msgs::ConvertIgn(cloudMsg.world_pose()).Pos(),
+      ignition::math::Vector3d(1, 2, 3));
+  ASSERT_EQ(cloudMsg.data().size(), 2 * 4 * sizeof(float));
+
+  float points[8];
+  std::memcpy(points, cloudMsg.data().data(), sizeof(points));
+  EXPECT_NEAR(points[0], 0, 1e-6);
+  EXPECT_NEAR(points[1], -1, 1e-6);
+  EXPECT_NEAR(points[2], 0, 1e-6);
+  EXPECT_FLOAT_EQ(points[3], 0.5f);
+  EXPECT_NEAR(points[4], 0, 1e-6);
+  EXPECT_NEAR(points[5], 2, 1e-6);
+  EXPECT_NEAR(points[6], 0, 1e-6);
+  EXPECT_FLOAT_EQ(points[7], 0.25f);
+
+  // Refilling with fewer valid ranges shrinks the buffer
+  scan->set_ranges(0, std::numeric_limits<double>::infinity());
+  EXPECT_EQ(cloud.Fill(scanMsg, cloudMsg), 1u);
+  EXPECT_EQ(cloudMsg.data().size(), 4 * sizeof(float));
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -75,6 +75,9 @@ void RaySensor::Load(const std::string &_worldName)
   Sensor::Load(_worldName);
   this->dataPtr->scanPub =
     this->node->Advertise<msgs::LaserScanStamped>(this->Topic(), 50);
+  this->dataPtr->cloudPub =
+    this->node->Advertise<msgs::PointCloudPackedStamped>(
+        RayPointCloud::Topic(this->Topic()), 50);
 
   GZ_ASSERT(this->world != nullptr,
       "RaySensor did not get a valid World pointer");
@@ -132,6 +135,7 @@ void RaySensor::Fini()
   Sensor::Fini();
 
   this->dataPtr->scanPub.reset();
+  this->dataPtr->cloudPub.reset();
 
   if (this->dataPtr->laserCollision)
   {
@@ -377,14 +381,28 @@ bool RaySensor::UpdateImpl(const bool /*_force*/)
   scan->set_range_min(this->RangeMin());
   scan->set_range_max(this->RangeMax());
 
-  scan->clear_ranges();
-  scan->clear_intensities();
-
   unsigned int rayCount = this->RayCount();
   unsigned int rangeCount = this->RangeCount();
   unsigned int verticalRayCount = this->VerticalRayCount();
   unsigned int verticalRangeCount = this->VerticalRangeCount();
 
+  // Clearing keeps the capacity, so after the first scan refilling the
+  // message does not allocate
+  const size_t capacity = scan->ranges().Capacity() +
+      scan->intensities().Capacity();
+  scan->clear_ranges();
+  scan->clear_intensities();
+  scan->mutable_ranges()->Reserve(rangeCount * verticalRangeCount);
+  scan->mutable_intensities()->Reserve(rangeCount * verticalRangeCount);
+  this->CountBufferAllocation(capacity, scan->ranges().Capacity() +
+      scan->intensities().Capacity());
+
+  // Ranges that need noise are collected and noised in one batch
+  // currently supports only one noise model per laser sensor
+  const bool noisy = this->noises.find(RAY_NOISE) != this->noises.end();
+  this->dataPtr->noiseIndices.clear();
+  this->dataPtr->noiseRanges.clear();
+
   // Interpolation: for every point in range count, compute interpolated value
   // using four bounding ray samples.
   // (vja, hja)   (vja, hjb)
@@ -487,24 +505,41 @@ bool RaySensor::UpdateImpl(const bool /*_force*/)
       {
         range = -ignition::math::INF_D;
       }
-      else if (this->noises.find(RAY_NOISE) !=
-               this->noises.end())
+      else if (noisy)
       {
-        // currently supports only one noise model per laser sensor
-        range = this->noises[RAY_NOISE]->Apply(range);
-        range = ignition::math::clamp(range,
-            this->RangeMin(), this->RangeMax());
+        this->dataPtr->noiseIndices.push_back(scan->ranges_size());
+        this->dataPtr->noiseRanges.push_back(range);
       }
 
       scan->add_ranges(range);
       scan->add_intensities(intensity);
     }
   }
+
+  if (!this->dataPtr->noiseRanges.empty())
+  {
+    this->noises[RAY_NOISE]->Apply(this->dataPtr->noiseRanges.data(),
+        this->dataPtr->noiseRanges.size());
+    for (size_t k = 0; k < this->dataPtr->noiseRanges.size(); ++k)
+    {
+      scan->set_ranges(this->dataPtr->noiseIndices[k],
+          ignition::math::clamp(this->dataPtr->noiseRanges[k],
+            this->RangeMin(), this->RangeMax()));
+    }
+  }
   IGN_PROFILE_END();
 
   IGN_PROFILE_BEGIN("Publish");
   if (this->dataPtr->scanPub && this->dataPtr->scanPub->HasConnections())
     this->dataPtr->scanPub->Publish(this->dataPtr->laserMsg);
+
+  // Points are only computed for subscribers
+  if (this->dataPtr->cloudPub && this->dataPtr->cloudPub->HasConnections())
+  {
+    this->dataPtr->cloud.Fill(this->dataPtr->laserMsg,
+        this->dataPtr->cloudMsg);
+    this->dataPtr->cloudPub->Publish(this->dataPtr->cloudMsg);
+  }
   IGN_PROFILE_END();
 
   return true;
@@ -514,7 +549,8 @@ bool RaySensor::UpdateImpl(const bool /*_force*/)
 bool RaySensor::IsActive() const
 {
   return Sensor::IsActive() ||
-    (this->dataPtr->scanPub && this->dataPtr->scanPub->HasConnections());
+    (this->dataPtr->scanPub && this->dataPtr->scanPub->HasConnections()) ||
+    (this->dataPtr->cloudPub && this->dataPtr->cloudPub->HasConnections());
 }
 
 //////////////////////////////////////////////////
@@ -18,9 +18,11 @@
 #define _GAZEBO_SENSORS_RAYSENSOR_PRIVATE_HH_
 
 #include <mutex>
+#include <vector>
 
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/sensors/RayPointCloud.hh"
 #include "gazebo/transport/TransportTypes.hh"
 
 namespace gazebo
@@ -43,11 +45,26 @@ namespace gazebo
       /// \brief Publisher for the scans
       public: transport::PublisherPtr scanPub;
 
+      /// \brief Publisher for point clouds built from the scans.
+      public: transport::PublisherPtr cloudPub;
+
+      /// \brief Converts the scans to point clouds.
+      public: RayPointCloud cloud;
+
+      /// \brief Point cloud message, reused between updates.
+      public: msgs::PointCloudPackedStamped cloudMsg;
+
       /// \brief Mutex to protect laserMsg
       public: std::mutex mutex;
 
       /// \brief Laser message.
       public: msgs::LaserScanStamped laserMsg;
+
+      /// \brief Scan indices of the ranges that get noise this update.
+      public: std::vector<int> noiseIndices;
+
+      /// \brief Ranges that get noise this update, noised in one batch.
+      public: std::vector<double> noiseRanges;
     };
   }
 }
@@ -14,6 +14,9 @@
  * limitations under the License.
  *
 */
+#include <chrono>
+
+#include <ignition/math/Rand.hh>
 #include "ignition/common/Profiler.hh"
 
 #include "gazebo/transport/transport.hh"
@@ -49,6 +52,18 @@ sdf::ElementPtr SensorPrivate::sdfSensor;
 
 bool Sensor::useStrictRate = false;
 
+//////////////////////////////////////////////////
+/// \brief Count an update that produced data in the sensor timing.
+/// \param[in] _data Private data of the sensor.
+/// \param[in] _start Start of the update.
+static void addUpdateTime(SensorPrivate &_data,
+    const std::chrono::steady_clock::time_point &_start)
+{
+  ++_data.updateCount;
+  _data.updateNsec += std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - _start).count();
+}
+
 //////////////////////////////////////////////////
 Sensor::Sensor(SensorCategory _cat)
 : dataPtr(new SensorPrivate)
@@ -162,6 +177,24 @@ void Sensor::Init()
 {
   this->SetUpdateRate(this->sdf->Get<double>("update_rate"));
 
+  // Give every noise model its own random stream, derived from the global
+  // seed and the sensor's name. Sensors may be updated in parallel, so the
+  // streams must not depend on update order.
+  for (auto &noise : this->noises)
+  {
+    if (!noise.second)
+      continue;
+
+    // FNV-1a hash of the scoped name and noise type
+    uint32_t seed = 2166136261u;
+    std::string key = this->ScopedName() + "::" +
+      std::to_string(static_cast<int>(noise.first));
+    for (const char c : key)
+      seed = (seed ^ static_cast<unsigned char>(c)) * 16777619u;
+
+    noise.second->SetSeed(seed ^ ignition::math::Rand::Seed());
+  }
+
   // Load the plugins
   if (this->sdf->HasElement("plugin"))
   {
@@ -238,8 +271,12 @@ void Sensor::Update(const bool _force)
   {
     if (this->useStrictRate)
     {
+      auto start = std::chrono::steady_clock::now();
       if (this->UpdateImpl(_force))
+      {
+        addUpdateTime(*this->dataPtr, start);
         this->updated();
+      }
     }
     else
     {
@@ -276,8 +313,10 @@ void Sensor::Update(const bool _force)
           this->dataPtr->updateDelay = common::Time::Zero;
       }
 
+      auto start = std::chrono::steady_clock::now();
       if (this->UpdateImpl(_force))
       {
+        addUpdateTime(*this->dataPtr, start);
         std::lock_guard<std::mutex> lock(this->dataPtr->mutexLastUpdateTime);
         this->lastUpdateTime = simTime;
         this->updated();
@@ -418,6 +457,51 @@ common::Time Sensor::LastMeasurementTime() const
   return this->lastMeasurementTime;
 }
 
+//////////////////////////////////////////////////
+common::Time Sensor::NextUpdateTime() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutexLastUpdateTime);
+
+  // Same condition as in Sensor::Update and Sensor::NeedsUpdate
+  common::Time last = this->useStrictRate ?
+    this->lastMeasurementTime : this->lastUpdateTime;
+  return last + this->updatePeriod - this->dataPtr->updateDelay;
+}
+
+//////////////////////////////////////////////////
+uint64_t Sensor::BufferAllocations() const
+{
+  return this->dataPtr->bufferAllocations;
+}
+
+//////////////////////////////////////////////////
+void Sensor::CountBufferAllocation(const size_t _before, const size_t _after)
+{
+  if (_before != _after)
+    ++this->dataPtr->bufferAllocations;
+}
+
+//////////////////////////////////////////////////
+SensorTiming Sensor::Timing() const
+{
+  SensorTiming timing;
+  timing.updates = this->dataPtr->updateCount;
+  timing.updateTime = this->dataPtr->updateNsec;
+  timing.renders = this->dataPtr->renderCount;
+  timing.renderTime = this->dataPtr->renderNsec;
+  return timing;
+}
+
+//////////////////////////////////////////////////
+void Sensor::AddRenderTime(
+    const std::chrono::steady_clock::time_point &_start)
+{
+  ++this->dataPtr->renderCount;
+  this->dataPtr->renderNsec += std::chrono::duration_cast<
+      std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+      _start).count();
+}
+
 //////////////////////////////////////////////////
 std::string Sensor::Type() const
 {
@@ -17,6 +17,7 @@
 #ifndef GAZEBO_SENSORS_SENSOR_HH_
 #define GAZEBO_SENSORS_SENSOR_HH_
 
+#include <chrono>
 #include <vector>
 #include <memory>
 #include <map>
@@ -46,6 +47,24 @@ namespace gazebo
     /// \addtogroup gazebo_sensors
     /// \{
 
+    /// \brief Wall time a sensor spent producing data since it was loaded,
+    /// see Sensor::Timing.
+    struct SensorTiming
+    {
+      /// \brief Number of updates that produced data.
+      uint64_t updates = 0;
+
+      /// \brief Time spent in those updates, in nanoseconds. This includes
+      /// reading back rendered data and publishing it.
+      uint64_t updateTime = 0;
+
+      /// \brief Number of renders, zero for sensors that do not render.
+      uint64_t renders = 0;
+
+      /// \brief Time spent rendering, in nanoseconds.
+      uint64_t renderTime = 0;
+    };
+
     /// \class Sensor Sensor.hh sensors/sensors.hh
     /// \brief Base class for sensors
     class GZ_SENSORS_VISIBLE Sensor
@@ -134,6 +153,25 @@ namespace gazebo
       /// \return Time of last measurement.
       public: common::Time LastMeasurementTime() const;
 
+      /// \brief Get the simulation time at which the sensor is next due
+      /// for an update, based on its update rate and last update.
+      /// \return Simulation time of the next update. It is not later than
+      /// the current time if the sensor updates on every step.
+      public: common::Time NextUpdateTime() const;
+
+      /// \brief Get the number of times the sensor allocated or grew the
+      /// buffers of its outgoing messages. Message objects are reused, so
+      /// the count stops increasing once the sensor reaches a steady state;
+      /// a count that keeps growing means allocations on every update.
+      /// \return Number of buffer allocations so far.
+      public: uint64_t BufferAllocations() const;
+
+      /// \brief Get the time the sensor spent producing data. The counters
+      /// are atomic, so they can be read from any thread while the sensor
+      /// updates.
+      /// \return Counters accumulated since the sensor was loaded.
+      public: SensorTiming Timing() const;
+
       /// \brief Return true if user requests the sensor to be visualized
       ///        via tag:  <visualize>true</visualize> in SDF.
       /// \return True if visualized, false if not.
@@ -201,6 +239,20 @@ namespace gazebo
       /// \return True when sensor should be updated.
       protected: virtual bool NeedsUpdate();
 
+      /// \brief Count a message buffer allocation if a buffer's capacity
+      /// changed while it was filled.
+      /// \param[in] _before Capacity before filling the buffer.
+      /// \param[in] _after Capacity after filling the buffer.
+      /// \sa BufferAllocations
+      protected: void CountBufferAllocation(const size_t _before,
+                     const size_t _after);
+
+      /// \brief Count a render that just finished in the sensor timing.
+      /// \param[in] _start Time the render started.
+      /// \sa Timing
+      protected: void AddRenderTime(
+                     const std::chrono::steady_clock::time_point &_start);
+
       /// \brief Load a plugin for this sensor.
       /// \param[in] _sdf SDF parameters.
       private: void LoadPlugin(sdf::ElementPtr _sdf);
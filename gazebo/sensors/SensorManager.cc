@@ -15,9 +15,15 @@
  *
 */
 
+#include <algorithm>
+#include <cstdlib>
 #include <functional>
+#include <queue>
+#include <set>
 #include <boost/bind/bind.hpp>
 
+#include "gazebo/common/SamplingProfiler.hh"
+#include "gazebo/common/StartupTrace.hh"
 #include "gazebo/physics/Link.hh"
 #include "gazebo/physics/Model.hh"
 #include "gazebo/physics/PhysicsIface.hh"
@@ -25,6 +31,8 @@
 #include "gazebo/physics/PhysicsIface.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/rendering/Camera.hh"
+#include "gazebo/rendering/RenderingIface.hh"
+#include "gazebo/rendering/Scene.hh"
 #include "gazebo/sensors/CameraSensor.hh"
 #include "gazebo/sensors/Sensor.hh"
 #include "gazebo/sensors/SensorFactory.hh"
@@ -42,62 +50,87 @@ using namespace sensors;
 /// for timing coordination.
 boost::mutex g_sensorTimingMutex;
 
-/// \brief Flag to indicate if number of sensors has changed and that the
-/// max update rate needs to be recalculated
-bool g_sensorsDirty = true;
-
-/// Performance metrics variables
-/// \brief last sensor measurement sim time
-std::map<std::string, gazebo::common::Time> sensorsLastMeasurementTime;
-
-/// \brief last sensor measurement real time
-std::map<std::string, gazebo::common::Time> worldLastMeasurementTime;
-
-/// \brief Data structure for storing metric data to be published
-struct sensorPerformanceMetricsType
+/// \brief Number of threads that update the sensors of a parallel sensor
+/// container, including the container's own thread. Set with
+/// GAZEBO_SENSOR_THREADS; zero or one updates the sensors serially.
+/// \return Thread count.
+static unsigned int sensorThreadCount()
 {
-  /// \brief sensor real time update rate
-  double sensorRealUpdateRate;
-
-  /// \brief sensor sim time update rate
-  double sensorSimUpdateRate;
-
-  /// \brief Rendering sensor average real time update rate. The difference
-  /// between sensorAvgFps and sensorRealUpdateRte is that sensorAvgFps is
-  /// for rendering sensors only and the rate is averaged over a fixed
-  /// window size, whereas the sensorSimUpdateRate stores the instantaneous
-  /// update rate and it is filled by all sensors.
-  double sensorAvgFPS;
-};
-
-/// \brief A map of sensor name to its performance metrics data
-std::map<std::string, struct sensorPerformanceMetricsType>
-    sensorPerformanceMetrics;
+  const char *env = std::getenv("GAZEBO_SENSOR_THREADS");
+  if (env)
+  {
+    try
+    {
+      return std::stoul(env);
+    }
+    catch(...)
+    {
+      gzwarn << "Invalid GAZEBO_SENSOR_THREADS[" << env << "]\n";
+    }
+  }
 
-/// \brief Publisher for run-time simulation performance metrics.
-transport::PublisherPtr performanceMetricsPub;
+  return std::min(4u, boost::thread::hardware_concurrency());
+}
 
-/// \brief Node for publishing performance metrics
-transport::NodePtr node = nullptr;
+/// \brief Check whether a sensor only touches its own state during an
+/// update, so that it can be updated in parallel with other sensors.
+/// \param[in] _sensor The sensor.
+/// \param[in] _engineType Type of the physics engine.
+/// \return True if the sensor can be updated in parallel.
+static bool parallelSafe(const SensorPtr &_sensor,
+    const std::string &_engineType)
+{
+  static const std::set<std::string> types = {
+    "altimeter", "contact", "force_torque", "gps", "imu", "magnetometer",
+    "sonar"};
 
-/// \brief Last sim time measured for performance metrics
-common::Time lastSimTime;
+  // ODE ray intersections lock the physics engine, other engines are not
+  // known to be safe.
+  if (_sensor->Type() == "ray")
+    return _engineType == "ode";
 
-/// \brief Last real time measured for performance metrics
-common::Time lastRealTime;
+  return types.count(_sensor->Type()) > 0;
+}
 
 //////////////////////////////////////////////////
 SensorManager::SensorManager()
   : initialized(false), removeAllSensors(false)
 {
+  const char *rate = std::getenv("GAZEBO_PERFORMANCE_METRICS_RATE");
+  if (rate)
+  {
+    try
+    {
+      this->metricsRate = std::stod(rate);
+    }
+    catch(...)
+    {
+      gzwarn << "Invalid GAZEBO_PERFORMANCE_METRICS_RATE[" << rate << "]\n";
+    }
+  }
+
+  const char *pipeline = std::getenv("GAZEBO_LOCKSTEP_PIPELINE");
+  if (pipeline)
+  {
+    try
+    {
+      this->lockstepPipeline = std::stoul(pipeline);
+    }
+    catch(...)
+    {
+      gzwarn << "Invalid GAZEBO_LOCKSTEP_PIPELINE[" << pipeline << "]\n";
+    }
+  }
+
   // sensors::IMAGE container
-  this->sensorContainers.push_back(new ImageSensorContainer());
+  this->sensorContainers.push_back(
+      new ImageSensorContainer(this->lockstepPipeline > 0));
 
   // sensors::RAY container
-  this->sensorContainers.push_back(new SensorContainer());
+  this->sensorContainers.push_back(new SensorContainer(true));
 
   // sensors::OTHER container
-  this->sensorContainers.push_back(new SensorContainer());
+  this->sensorContainers.push_back(new SensorContainer(true));
 }
 
 //////////////////////////////////////////////////
@@ -164,8 +197,12 @@ void SensorManager::WaitForSensors(double _clk, double _dt)
 {
   double tnext = this->NextRequiredTimestamp();
 
+  // Rendering the required timestamp only needs its poses, which the scene
+  // holds back from later steps, so physics can keep going meanwhile.
+  const double ahead = this->lockstepPipeline * _dt;
+
   while (!std::isnan(tnext)
-      && ignition::math::lessOrNearEqual(tnext - _dt / 2.0, _clk)
+      && ignition::math::lessOrNearEqual(tnext + ahead - _dt / 2.0, _clk)
       && physics::worlds_running())
   {
     this->WaitForPrerendered(0.001);
@@ -173,124 +210,102 @@ void SensorManager::WaitForSensors(double _clk, double _dt)
   }
 }
 
-void PublishPerformanceMetrics()
+void SensorManager::SetPerformanceMetricsRate(const double _rate)
+{
+  this->metricsRate = _rate;
+}
+
+//////////////////////////////////////////////////
+double SensorManager::PerformanceMetricsRate() const
+{
+  return this->metricsRate;
+}
+
+//////////////////////////////////////////////////
+void SensorManager::PublishPerformanceMetrics()
 {
-  if (node == nullptr)
+  physics::WorldPtr world = physics::get_world();
+  if (!this->metricsNode)
   {
-    auto world = physics::get_world();
-    // Transport
-    node = transport::NodePtr(new transport::Node());
-    node->Init(world->Name());
-    performanceMetricsPub =
-     node->Advertise<msgs::PerformanceMetrics>(
-         "/gazebo/performance_metrics", 10, 5);
+    this->metricsNode = transport::NodePtr(new transport::Node());
+    this->metricsNode->Init(world->Name());
+    this->metricsPub =
+      this->metricsNode->Advertise<msgs::PerformanceMetrics>(
+          "/gazebo/performance_metrics", 10, 5);
   }
 
-  if (!performanceMetricsPub || !performanceMetricsPub->HasConnections())
+  if (!this->metricsPub || !this->metricsPub->HasConnections())
+    return;
+
+  common::Time wallTime = common::Time::GetWallTime();
+  if (this->metricsRate > 0 &&
+      wallTime - this->metricsWallTime < common::Time(1.0 / this->metricsRate))
   {
     return;
   }
 
-  physics::WorldPtr world = physics::get_world(
-    gazebo::physics::get_world()->Name());
-
-  /// Outgoing run-time simulation performance metrics.
-  msgs::PerformanceMetrics performanceMetricsMsg;
-
   // Real time factor
   common::Time realTime = world->RealTime();
-  common::Time diffRealtime = realTime - lastRealTime;
+  common::Time diffRealTime = realTime - this->metricsRealTime;
   common::Time simTime = world->SimTime();
-  common::Time diffSimTime = simTime - lastSimTime;
-  common::Time realTimeFactor;
+  common::Time diffSimTime = simTime - this->metricsSimTime;
 
   if (ignition::math::equal(diffSimTime.Double(), 0.0))
     return;
 
-  if (realTime == 0)
-    realTimeFactor = 0;
+  /// Outgoing run-time simulation performance metrics.
+  msgs::PerformanceMetrics msg;
+  if (realTime == 0 || diffRealTime <= 0)
+    msg.set_real_time_factor(0);
   else
-    realTimeFactor = diffSimTime / diffRealtime;
+    msg.set_real_time_factor((diffSimTime / diffRealTime).Double());
 
-  performanceMetricsMsg.set_real_time_factor(realTimeFactor.Double());
+  // Rates over the window since the previous message. A sensor seen for
+  // the first time only starts the window.
+  std::map<uint32_t, SensorTiming> timings;
+  for (auto const &sensor : this->GetSensors())
+  {
+    SensorTiming timing = sensor->Timing();
+    timings[sensor->Id()] = timing;
 
-  lastRealTime = realTime;
-  lastSimTime = simTime;
+    auto lastIter = this->metricsTimings.find(sensor->Id());
+    if (lastIter == this->metricsTimings.end() || diffRealTime <= 0)
+      continue;
+    const SensorTiming &last = lastIter->second;
 
-  /// update sim time for sensors
-  for (auto model: world->Models())
-  {
-    for (auto link: model->GetLinks())
+    const uint64_t updates = timing.updates - last.updates;
+    const uint64_t renders = timing.renders - last.renders;
+
+    auto sensorMsg = msg.add_sensor();
+    sensorMsg->set_name(sensor->Name());
+    sensorMsg->set_sim_update_rate(updates / diffSimTime.Double());
+    sensorMsg->set_real_update_rate(updates / diffRealTime.Double());
+
+    if (updates > 0)
     {
-      for (unsigned int i = 0; i < link->GetSensorCount(); i++)
-      {
-        std::string name = link->GetSensorName(i);
-        sensors::SensorPtr sensor = sensors::get_sensor(name);
-
-        auto ret = sensorsLastMeasurementTime.insert(
-            std::pair<std::string, gazebo::common::Time>(name, 0));
-        worldLastMeasurementTime.insert(
-                std::pair<std::string, gazebo::common::Time>(name, 0));
-        if (ret.second == false)
-        {
-          double updateSimRate =
-            (sensor->LastMeasurementTime() - sensorsLastMeasurementTime[name])
-            .Double();
-          if (updateSimRate > 0.0)
-          {
-            sensorsLastMeasurementTime[name] = sensor->LastMeasurementTime();
-            double updateRealRate =
-              (world->RealTime() - worldLastMeasurementTime[name]).Double();
-
-            struct sensorPerformanceMetricsType emptySensorPerfomanceMetrics;
-            auto ret2 = sensorPerformanceMetrics.insert(
-                std::pair<std::string, struct sensorPerformanceMetricsType>
-                  (name, emptySensorPerfomanceMetrics));
-            if (ret2.second == false)
-            {
-              ret2.first->second.sensorSimUpdateRate =
-                  1.0/updateSimRate;
-              ret2.first->second.sensorRealUpdateRate =
-                  1.0/updateRealRate;
-              worldLastMeasurementTime[name] = world->RealTime();
-
-              // Special case for stereo cameras
-              sensors::CameraSensorPtr cameraSensor =
-                std::dynamic_pointer_cast<sensors::CameraSensor>(sensor);
-              if (nullptr != cameraSensor)
-              {
-                ret2.first->second.sensorAvgFPS =
-                    cameraSensor->Camera()->AvgFPS();
-              }
-              else
-              {
-                ret2.first->second.sensorAvgFPS = -1;
-              }
-            }
-          }
-        }
-      }
+      sensorMsg->set_update_time(
+          (timing.updateTime - last.updateTime) * 1e-6 / updates);
     }
-  }
-
-  for (auto sensorPerformanceMetric: sensorPerformanceMetrics)
-  {
-    msgs::PerformanceMetrics::PerformanceSensorMetrics
-        *performanceSensorMetricsMsg = performanceMetricsMsg.add_sensor();
-    performanceSensorMetricsMsg->set_name(sensorPerformanceMetric.first);
-    performanceSensorMetricsMsg->set_real_update_rate(
-      sensorPerformanceMetric.second.sensorRealUpdateRate);
-    performanceSensorMetricsMsg->set_sim_update_rate(
-      sensorPerformanceMetric.second.sensorSimUpdateRate);
-    if (sensorPerformanceMetric.second.sensorAvgFPS >= 0.0)
+    if (renders > 0)
     {
-      performanceSensorMetricsMsg->set_fps(
-        sensorPerformanceMetric.second.sensorAvgFPS);
+      sensorMsg->set_render_time(
+          (timing.renderTime - last.renderTime) * 1e-6 / renders);
     }
+
+    // Special case for stereo cameras
+    sensors::CameraSensorPtr cameraSensor =
+      std::dynamic_pointer_cast<sensors::CameraSensor>(sensor);
+    if (cameraSensor && cameraSensor->Camera())
+      sensorMsg->set_fps(cameraSensor->Camera()->AvgFPS());
   }
 
+  this->metricsTimings.swap(timings);
+  this->metricsWallTime = wallTime;
+  this->metricsRealTime = realTime;
+  this->metricsSimTime = simTime;
+
   // Publish data
-  performanceMetricsPub->Publish(performanceMetricsMsg);
+  this->metricsPub->Publish(msg);
 }
 
 //////////////////////////////////////////////////
@@ -317,7 +332,11 @@ void SensorManager::Update(bool _force)
         GZ_ASSERT(this->sensorContainers[sensor->Category()] != nullptr,
             "Sensor container is null");
 
-        sensor->Init();
+        {
+          common::StartupTraceScope trace("Sensor::Init", "sensors",
+              sensor->ScopedName());
+          sensor->Init();
+        }
         this->sensorContainers[sensor->Category()]->AddSensor(sensor);
       }
       this->initSensors.clear();
@@ -369,7 +388,7 @@ void SensorManager::Update(bool _force)
   if (this->sensorContainers[sensors::IMAGE]->sensors.size() > 0)
     this->sensorContainers[sensors::IMAGE]->Update(_force);
 
-  PublishPerformanceMetrics();
+  this->PublishPerformanceMetrics();
 }
 
 //////////////////////////////////////////////////
@@ -416,6 +435,7 @@ double SensorManager::NextRequiredTimestamp()
 //////////////////////////////////////////////////
 void SensorManager::Init()
 {
+  common::StartupTraceScope trace("SensorManager::Init", "sensors");
   boost::recursive_mutex::scoped_lock lock(this->mutex);
 
   this->simTimeEventHandler = new SimTimeEventHandler();
@@ -463,6 +483,12 @@ void SensorManager::Fini()
   this->initSensors.clear();
   this->worlds.clear();
 
+  this->metricsPub.reset();
+  if (this->metricsNode)
+    this->metricsNode->Fini();
+  this->metricsNode.reset();
+  this->metricsTimings.clear();
+
   delete this->simTimeEventHandler;
   this->simTimeEventHandler = nullptr;
 
@@ -499,6 +525,13 @@ std::string SensorManager::CreateSensor(sdf::ElementPtr _elem,
     return std::string();
   }
 
+  if (sensor->Category() == sensors::IMAGE && !sensors::rendering_enabled())
+  {
+    gzwarn << "Rendering is disabled, skipping sensor of type[" << type
+           << "] on [" << _parentName << "]\n";
+    return std::string();
+  }
+
   // Must come before sensor->Load
   sensor->SetParent(_parentName, _parentId);
 
@@ -638,11 +671,17 @@ void SensorManager::RemoveSensors()
 }
 
 //////////////////////////////////////////////////
-SensorManager::SensorContainer::SensorContainer()
+SensorManager::SensorContainer::SensorContainer(bool _parallel)
 {
   this->stop = true;
   this->initialized = false;
   this->runThread = nullptr;
+  this->parallel = _parallel;
+  this->scheduleDirty = true;
+  this->pass = 0;
+  this->nextGroup = 0;
+  this->pendingGroups = 0;
+  this->forceUpdate = false;
 }
 
 //////////////////////////////////////////////////
@@ -668,6 +707,7 @@ void SensorManager::SensorContainer::Init()
 //////////////////////////////////////////////////
 void SensorManager::SensorContainer::Fini()
 {
+  boost::mutex::scoped_lock passLock(this->passMutex);
   boost::recursive_mutex::scoped_lock lock(this->mutex);
 
   Sensor_V::iterator iter;
@@ -682,16 +722,36 @@ void SensorManager::SensorContainer::Fini()
   // Remove all the sensors from the current sensor vector.
   this->sensors.clear();
 
+  this->scheduleDirty = true;
+
   this->initialized = false;
 }
 
 //////////////////////////////////////////////////
 void SensorManager::SensorContainer::Run()
 {
+  // Cleared here as well as in RunLoop, so that the workers don't see a
+  // stale stop flag.
+  this->stop = false;
+
+  physics::WorldPtr world = physics::get_world();
+  if (world && world->Physics())
+    this->physicsType = world->Physics()->GetType();
+
   this->runThread = new boost::thread(
       boost::bind(&SensorManager::SensorContainer::RunLoop, this));
 
   GZ_ASSERT(this->runThread, "Unable to create boost::thread.");
+
+  if (this->parallel)
+  {
+    unsigned int threads = sensorThreadCount();
+    for (unsigned int i = 1; i < threads; ++i)
+    {
+      this->workers.push_back(new boost::thread(
+          boost::bind(&SensorManager::SensorContainer::WorkerLoop, this)));
+    }
+  }
 }
 
 //////////////////////////////////////////////////
@@ -708,6 +768,17 @@ void SensorManager::SensorContainer::Stop()
     delete this->runThread;
     this->runThread = nullptr;
   }
+
+  {
+    boost::mutex::scoped_lock workLock(this->workMutex);
+    this->workCondition.notify_all();
+  }
+  for (auto &worker : this->workers)
+  {
+    worker->join();
+    delete worker;
+  }
+  this->workers.clear();
 }
 
 //////////////////////////////////////////////////
@@ -734,11 +805,24 @@ void SensorManager::SensorContainer::RunLoop()
   // large step size.
   double maxSensorUpdate = engine->GetMaxStepSize() * 1000;
 
+  // Sensors that update on every step are due again after one step.
+  common::Time minPeriod(engine->GetMaxStepSize());
+
   // Release engine pointer, we don't need it in the loop
   engine.reset();
 
-  common::Time sleepTime, startTime, eventTime, diffTime;
-  double maxUpdateRate = 0;
+  common::Time startTime, eventTime, diffTime, lastSimTime;
+
+  // Sensors ordered by the simulation time at which they are next due, so
+  // that the loop only wakes up when there is work to do.
+  typedef std::pair<common::Time, SensorPtr> DueSensor;
+  auto later = [](const DueSensor &_a, const DueSensor &_b)
+  {
+    return _a.first > _b.first;
+  };
+  typedef std::priority_queue<DueSensor, std::vector<DueSensor>,
+          decltype(later)> DueQueue;
+  DueQueue queue(later);
 
   boost::mutex tmpMutex;
   boost::mutex::scoped_lock lock2(tmpMutex);
@@ -752,36 +836,7 @@ void SensorManager::SensorContainer::RunLoop()
       return;
   }
 
-
-  auto computeMaxUpdateRate = [&]()
-  {
-    {
-      boost::recursive_mutex::scoped_lock lock(this->mutex);
-
-      if (!g_sensorsDirty)
-        return;
-
-      // Get the minimum update rate from the sensors.
-      for (Sensor_V::iterator iter = this->sensors.begin();
-          iter != this->sensors.end() && !this->stop; ++iter)
-      {
-        GZ_ASSERT((*iter) != nullptr, "Sensor is null");
-        maxUpdateRate = std::max((*iter)->UpdateRate(), maxUpdateRate);
-      }
-
-      g_sensorsDirty = false;
-    }
-
-    // Calculate an appropriate sleep time.
-    if (maxUpdateRate > 0)
-      sleepTime.Set(1.0 / (maxUpdateRate));
-    else
-      sleepTime.Set(0, 1e6);
-  };
-
-  computeMaxUpdateRate();
-
-  IGN_PROFILE_THREAD_NAME("SensorManager");
+  common::SetThreadName("SensorManager");
 
   while (!this->stop)
   {
@@ -796,23 +851,68 @@ void SensorManager::SensorContainer::RunLoop()
         return;
     }
 
-    computeMaxUpdateRate();
-
     // Get the start time of the update.
     startTime = world->SimTime();
 
-    IGN_PROFILE_BEGIN("UpdateSensors");
-    this->Update(false);
-    IGN_PROFILE_END();
+    {
+      boost::mutex::scoped_lock passLock(this->passMutex);
+
+      // Collect the sensors that are due
+      Sensor_V due;
+      {
+        boost::recursive_mutex::scoped_lock lock(this->mutex);
+
+        // Reschedule everything when sensors come and go, or when time
+        // goes backwards.
+        if (this->scheduleDirty || startTime < lastSimTime)
+        {
+          queue = DueQueue(later);
+          for (auto &sensor : this->sensors)
+          {
+            GZ_ASSERT(sensor != nullptr, "Sensor is null");
+            queue.push(DueSensor(sensor->NextUpdateTime(), sensor));
+          }
+          this->scheduleDirty = false;
+        }
+        lastSimTime = startTime;
+
+        while (!queue.empty() && queue.top().first <= startTime)
+        {
+          due.push_back(queue.top().second);
+          queue.pop();
+        }
+      }
+
+      IGN_PROFILE_BEGIN("UpdateSensors");
+      if (!due.empty())
+        this->UpdateSensors(due, false);
+      IGN_PROFILE_END();
+
+      // Put the updated sensors back in the queue. Sensors that did not
+      // update, for instance because they are inactive, are checked again
+      // after one period.
+      boost::recursive_mutex::scoped_lock lock(this->mutex);
+      if (!this->scheduleDirty)
+      {
+        for (auto &sensor : due)
+        {
+          common::Time next = sensor->NextUpdateTime();
+          if (next <= startTime)
+          {
+            double rate = sensor->UpdateRate();
+            next = startTime +
+              (rate > 0 ? common::Time(1.0 / rate) : minPeriod);
+          }
+          queue.push(DueSensor(next, sensor));
+        }
+      }
+    }
 
     // Compute the time it took to update the sensors.
     // It's possible that the world time was reset during the Update. This
     // would case a negative diffTime. Instead, just use a event time of zero
     diffTime = std::max(common::Time::Zero, world->SimTime() - startTime);
 
-    // Set the default sleep time
-    eventTime = std::max(common::Time::Zero, sleepTime - diffTime);
-
     // Make sure update time is reasonable.
     // During log playback, time can jump forward an arbitrary amount.
     if (diffTime.sec >= maxSensorUpdate && !util::LogPlay::Instance()->IsOpen())
@@ -823,14 +923,22 @@ void SensorManager::SensorContainer::RunLoop()
         << "This warning can be ignored during log playback" << std::endl;
     }
 
-    // Make sure eventTime is not negative.
-    if (eventTime < common::Time::Zero)
+    boost::mutex::scoped_lock timingLock(g_sensorTimingMutex);
+
+    // Sleep until the next sensor is due. Sensors that are already due, or
+    // a schedule that needs rebuilding, are handled right away.
     {
-      gzerr << "Time to next sensor update is negative." << std::endl;
-      continue;
+      boost::recursive_mutex::scoped_lock lock(this->mutex);
+      if (this->scheduleDirty)
+        eventTime = common::Time::Zero;
+      else if (queue.empty())
+        eventTime = minPeriod;
+      else
+        eventTime = queue.top().first - world->SimTime();
     }
 
-    boost::mutex::scoped_lock timingLock(g_sensorTimingMutex);
+    if (eventTime <= common::Time::Zero)
+      continue;
 
     // Add an event to trigger when the appropriate simulation time has been
     // reached.
@@ -850,22 +958,145 @@ void SensorManager::SensorContainer::RunLoop()
 //////////////////////////////////////////////////
 void SensorManager::SensorContainer::Update(bool _force)
 {
-  boost::recursive_mutex::scoped_lock lock(this->mutex);
+  boost::mutex::scoped_lock passLock(this->passMutex);
+
+  Sensor_V all;
+  {
+    boost::recursive_mutex::scoped_lock lock(this->mutex);
 
-  if (this->sensors.empty())
-    gzlog << "Updating a sensor container without any sensors.\n";
+    if (this->sensors.empty())
+      gzlog << "Updating a sensor container without any sensors.\n";
 
-  // Update all the sensors in this container.
-  for (Sensor_V::iterator iter = this->sensors.begin();
-       iter != this->sensors.end(); ++iter)
+    all = this->sensors;
+  }
+
+  this->UpdateSensors(all, _force);
+}
+
+//////////////////////////////////////////////////
+void SensorManager::SensorContainer::UpdateSensors(const Sensor_V &_sensors,
+    bool _force)
+{
+  if (this->workers.empty())
   {
-    GZ_ASSERT((*iter) != nullptr, "Sensor is null");
-    IGN_PROFILE_BEGIN((*iter)->Name().c_str());
-    (*iter)->Update(_force);
-    IGN_PROFILE_END();
+    boost::recursive_mutex::scoped_lock lock(this->mutex);
+
+    // Update the sensors one after the other.
+    for (Sensor_V::const_iterator iter = _sensors.begin();
+         iter != _sensors.end(); ++iter)
+    {
+      GZ_ASSERT((*iter) != nullptr, "Sensor is null");
+      IGN_PROFILE_BEGIN((*iter)->Name().c_str());
+      (*iter)->Update(_force);
+      IGN_PROFILE_END();
+    }
+    return;
+  }
+
+  // Start a new pass
+  unsigned int currentPass;
+  {
+    boost::mutex::scoped_lock workLock(this->workMutex);
+
+    this->BuildGroups(_sensors);
+    this->nextGroup = 0;
+    this->pendingGroups = this->groups.size();
+    this->forceUpdate = _force;
+    currentPass = ++this->pass;
+  }
+  this->workCondition.notify_all();
+
+  // Help the workers, then wait for the groups they are still updating
+  this->UpdateGroups(currentPass);
+
+  boost::mutex::scoped_lock workLock(this->workMutex);
+  while (this->pendingGroups > 0)
+    this->doneCondition.wait(workLock);
+}
+
+//////////////////////////////////////////////////
+void SensorManager::SensorContainer::WorkerLoop()
+{
+  physics::WorldPtr world = physics::get_world();
+  GZ_ASSERT(world != nullptr, "Pointer to World is null");
+  world->Physics()->InitForThread();
+  world.reset();
+  common::SetThreadName("SensorWorker");
+
+  unsigned int lastPass = 0;
+  while (true)
+  {
+    {
+      boost::mutex::scoped_lock workLock(this->workMutex);
+      while (!this->stop && this->pass == lastPass)
+        this->workCondition.wait(workLock);
+
+      if (this->stop)
+        return;
+
+      lastPass = this->pass;
+    }
+
+    this->UpdateGroups(lastPass);
+  }
+}
+
+//////////////////////////////////////////////////
+void SensorManager::SensorContainer::UpdateGroups(const unsigned int _pass)
+{
+  while (true)
+  {
+    size_t index;
+    bool force;
+    {
+      boost::mutex::scoped_lock workLock(this->workMutex);
+      if (this->pass != _pass || this->nextGroup >= this->groups.size())
+        return;
+      index = this->nextGroup++;
+      force = this->forceUpdate;
+    }
+
+    for (auto &sensor : this->groups[index])
+    {
+      IGN_PROFILE_BEGIN(sensor->Name().c_str());
+      sensor->Update(force);
+      IGN_PROFILE_END();
+    }
+
+    boost::mutex::scoped_lock workLock(this->workMutex);
+    if (--this->pendingGroups == 0)
+      this->doneCondition.notify_all();
   }
 }
 
+//////////////////////////////////////////////////
+void SensorManager::SensorContainer::BuildGroups(const Sensor_V &_sensors)
+{
+  // Sensors of the same model are kept together, since they read the same
+  // links. Sensors that may touch shared state share one group.
+  std::map<std::string, Sensor_V> models;
+  Sensor_V serial;
+  for (auto &sensor : _sensors)
+  {
+    GZ_ASSERT(sensor != nullptr, "Sensor is null");
+    if (!parallelSafe(sensor, this->physicsType))
+    {
+      serial.push_back(sensor);
+      continue;
+    }
+
+    std::string model = sensor->ParentName();
+    model = model.substr(0, model.find("::"));
+    models[model].push_back(sensor);
+  }
+
+  this->groups.clear();
+  if (!serial.empty())
+    this->groups.push_back(serial);
+  for (auto &model : models)
+    this->groups.push_back(model.second);
+}
+
 //////////////////////////////////////////////////
 SensorPtr SensorManager::SensorContainer::GetSensor(const std::string &_name,
                                                     bool _useLeafName) const
@@ -901,7 +1132,7 @@ void SensorManager::SensorContainer::AddSensor(SensorPtr _sensor)
   {
     boost::recursive_mutex::scoped_lock lock(this->mutex);
     this->sensors.push_back(_sensor);
-    g_sensorsDirty = true;
+    this->scheduleDirty = true;
   }
 
   // Tell the run loop that we have received a sensor
@@ -911,6 +1142,7 @@ void SensorManager::SensorContainer::AddSensor(SensorPtr _sensor)
 //////////////////////////////////////////////////
 bool SensorManager::SensorContainer::RemoveSensor(const std::string &_name)
 {
+  boost::mutex::scoped_lock passLock(this->passMutex);
   boost::recursive_mutex::scoped_lock lock(this->mutex);
 
   Sensor_V::iterator iter;
@@ -931,7 +1163,7 @@ bool SensorManager::SensorContainer::RemoveSensor(const std::string &_name)
     }
   }
 
-  g_sensorsDirty = true;
+  this->scheduleDirty = true;
 
   return removed;
 }
@@ -949,6 +1181,7 @@ void SensorManager::SensorContainer::ResetLastUpdateTimes()
     GZ_ASSERT((*iter) != nullptr, "Sensor is null");
     (*iter)->ResetLastUpdateTime();
   }
+  this->scheduleDirty = true;
 
   // Tell the run loop that world time has been reset.
   this->runCondition.notify_one();
@@ -957,6 +1190,7 @@ void SensorManager::SensorContainer::ResetLastUpdateTimes()
 //////////////////////////////////////////////////
 void SensorManager::SensorContainer::RemoveSensors()
 {
+  boost::mutex::scoped_lock passLock(this->passMutex);
   boost::recursive_mutex::scoped_lock lock(this->mutex);
 
   Sensor_V::iterator iter;
@@ -968,14 +1202,33 @@ void SensorManager::SensorContainer::RemoveSensors()
     (*iter)->Fini();
   }
 
-  g_sensorsDirty = true;
-
   this->sensors.clear();
+
+  this->scheduleDirty = true;
+}
+
+//////////////////////////////////////////////////
+SensorManager::ImageSensorContainer::ImageSensorContainer(
+    const bool _holdPoses)
+  : holdPoses(_holdPoses)
+{
 }
 
 //////////////////////////////////////////////////
 void SensorManager::ImageSensorContainer::Update(bool _force)
 {
+  // Physics may be past the next required timestamp, show the scene as it
+  // was at that timestamp
+  if (this->holdPoses && rendering::lockstep_enabled())
+  {
+    rendering::ScenePtr scene = rendering::get_scene();
+    if (scene)
+    {
+      scene->SetPoseTimeLimit(
+          SensorManager::Instance()->NextRequiredTimestamp());
+    }
+  }
+
   // Prerender phase
   event::Events::preRender();
 
@@ -1016,58 +1269,26 @@ SimTimeEventHandler::SimTimeEventHandler()
 /////////////////////////////////////////////////
 SimTimeEventHandler::~SimTimeEventHandler()
 {
-  // Cleanup the events.
-  for (std::list<SimTimeEvent*>::iterator iter = this->events.begin();
-       iter != this->events.end(); ++iter)
-  {
-    GZ_ASSERT(*iter != nullptr, "SimTimeEvent is null");
-    delete *iter;
-  }
-  this->events.clear();
 }
 
 /////////////////////////////////////////////////
 void SimTimeEventHandler::AddRelativeEvent(const common::Time &_time,
                                            boost::condition_variable *_var)
 {
-  boost::mutex::scoped_lock lock(this->mutex);
-
   physics::WorldPtr world = physics::get_world();
   GZ_ASSERT(world != nullptr, "World pointer is null");
 
-  // Create the new event.
-  SimTimeEvent *event = new SimTimeEvent;
-  event->time = world->SimTime() + _time;
-  event->condition = _var;
-
-  // Add the event to the list.
-  this->events.push_back(event);
+  this->scheduler.Schedule(world->SimTime() + _time, [_var]()
+      {
+        _var->notify_all();
+      });
 }
 
 /////////////////////////////////////////////////
 void SimTimeEventHandler::OnUpdate(const common::UpdateInfo &_info)
 {
   boost::mutex::scoped_lock timingLock(g_sensorTimingMutex);
-  boost::mutex::scoped_lock lock(this->mutex);
 
-  // Iterate over all the events.
-  for (std::list<SimTimeEvent*>::iterator iter = this->events.begin();
-      iter != this->events.end();)
-  {
-    GZ_ASSERT(*iter != nullptr, "SimTimeEvent is null");
-
-    // Find events that have a time less than or equal to simulation
-    // time.
-    if ((*iter)->time <= _info.simTime)
-    {
-      // Notify the event by triggering its condition.
-      (*iter)->condition->notify_all();
-
-      // Remove the event.
-      delete *iter;
-      this->events.erase(iter++);
-    }
-    else
-      ++iter;
-  }
+  // Notify the events whose time has been reached
+  this->scheduler.Update(_info.simTime);
 }
@@ -27,6 +27,7 @@
 #include <sdf/sdf.hh>
 
 #include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/common/SimTimeScheduler.hh"
 #include "gazebo/common/SingletonT.hh"
 #include "gazebo/common/UpdateInfo.hh"
 #include "gazebo/sensors/SensorTypes.hh"
@@ -43,16 +44,6 @@ namespace gazebo
   namespace sensors
   {
     /// \cond
-    /// \brief A simulation time event
-    class GZ_SENSORS_VISIBLE SimTimeEvent
-    {
-      /// \brief The time at which to trigger the condition.
-      public: common::Time time;
-
-      /// \brief The condition to notify.
-      public: boost::condition_variable *condition;
-    };
-
     /// \brief Monitors simulation time, and notifies conditions when
     /// a specified time has been reached.
     class GZ_SENSORS_VISIBLE SimTimeEventHandler
@@ -75,11 +66,9 @@ namespace gazebo
       /// \param[in] _info Update timing information.
       private: void OnUpdate(const common::UpdateInfo &_info);
 
-      /// \brief Mutex to mantain thread safety.
-      private: boost::mutex mutex;
-
-      /// \brief The list of events to handle.
-      private: std::list<SimTimeEvent*> events;
+      /// \brief Pending events, only the expired ones are visited on
+      /// update.
+      private: common::SimTimeScheduler scheduler;
 
       /// \brief Connect to the World::UpdateBegin event.
       private: event::ConnectionPtr updateConnection;
@@ -179,7 +168,23 @@ namespace gazebo
       /// \brief Reset last update times in all sensors.
       public: void ResetLastUpdateTimes();
 
-      /// \brief Block until all sensors do not need current world tick
+      /// \brief Set how often the performance metrics are published on
+      /// /gazebo/performance_metrics, while the topic has subscribers. The
+      /// default is 1 Hz, or the GAZEBO_PERFORMANCE_METRICS_RATE environment
+      /// variable.
+      /// \param[in] _rate Messages per second of wall time, zero or less to
+      /// publish after every sensor update pass.
+      public: void SetPerformanceMetricsRate(const double _rate);
+
+      /// \brief Get how often the performance metrics are published.
+      /// \return Messages per second of wall time.
+      /// \sa SetPerformanceMetricsRate
+      public: double PerformanceMetricsRate() const;
+
+      /// \brief Block until all sensors do not need current world tick.
+      /// With GAZEBO_LOCKSTEP_PIPELINE set to a number of steps, physics
+      /// may run up to that many steps past the next required timestamp
+      /// while the scene holds the poses of that timestamp for rendering.
       /// \param[in] _clk simulated clock of the world
       /// \param[in] _dt world time step
       private: void WaitForSensors(double _clk, double _dt);
@@ -193,6 +198,10 @@ namespace gazebo
       /// \param[in] _sensor Pointer to a sensor to add.
       private: void AddSensor(SensorPtr _sensor);
 
+      /// \brief Publish the sensor rates and timings measured since the
+      /// previous call, if the rate allows and somebody listens.
+      private: void PublishPerformanceMetrics();
+
       /// \cond
       /// \brief A container for sensors of a specific type. This is used to
       /// separate sensors which rely on the rendering engine from those
@@ -202,7 +211,11 @@ namespace gazebo
       private: class SensorContainer
                {
                  /// \brief Constructor
-                 public: SensorContainer();
+                 /// \param[in] _parallel True to update the sensors on a
+                 /// pool of worker threads, with the sensors of each
+                 /// model kept together on one thread. The pool size is
+                 /// read from GAZEBO_SENSOR_THREADS.
+                 public: explicit SensorContainer(bool _parallel = false);
 
                  /// \brief Destructor
                  public: virtual ~SensorContainer();
@@ -255,6 +268,28 @@ namespace gazebo
                  /// runThread.
                  private: void RunLoop();
 
+                 /// \brief A loop run by each worker thread, which helps
+                 /// with every update pass.
+                 private: void WorkerLoop();
+
+                 /// \brief Update sensor groups until none are left in
+                 /// the given update pass.
+                 /// \param[in] _pass The update pass.
+                 private: void UpdateGroups(const unsigned int _pass);
+
+                 /// \brief Update some of the sensors, in parallel if
+                 /// there are workers. Must be called with passMutex
+                 /// locked.
+                 /// \param[in] _sensors Sensors to update.
+                 /// \param[in] _force True to force the sensors to update.
+                 private: void UpdateSensors(const Sensor_V &_sensors,
+                                             bool _force);
+
+                 /// \brief Sort sensors into groups that are updated in
+                 /// parallel. Must be called with workMutex locked.
+                 /// \param[in] _sensors Sensors to sort.
+                 private: void BuildGroups(const Sensor_V &_sensors);
+
                  /// \brief The set of sensors to maintain.
                  public: Sensor_V sensors;
 
@@ -274,6 +309,54 @@ namespace gazebo
                  /// \brief Condition used to block the RunLoop if no
                  /// sensors are present.
                  private: boost::condition_variable runCondition;
+
+                 /// \brief True if sensor updates may run in parallel.
+                 private: bool parallel;
+
+                 /// \brief Threads that help with each update pass.
+                 private: std::vector<boost::thread *> workers;
+
+                 /// \brief Sensors of the current pass grouped by parent
+                 /// model. Each group is updated in order by one thread.
+                 private: std::vector<Sensor_V> groups;
+
+                 /// \brief True if the RunLoop has to rebuild its queue
+                 /// of due sensors, because sensors were added or removed
+                 /// or time was reset. Protected by mutex.
+                 private: bool scheduleDirty;
+
+                 /// \brief Type of the physics engine, set by Run.
+                 private: std::string physicsType;
+
+                 /// \brief Current update pass, incremented every time
+                 /// the workers are woken up.
+                 private: unsigned int pass;
+
+                 /// \brief Index of the next group to update in the
+                 /// current pass.
+                 private: size_t nextGroup;
+
+                 /// \brief Number of groups of the current pass that have
+                 /// not finished updating.
+                 private: size_t pendingGroups;
+
+                 /// \brief Force flag of the current pass.
+                 private: bool forceUpdate;
+
+                 /// \brief Protects the update pass state.
+                 private: boost::mutex workMutex;
+
+                 /// \brief Held for a whole parallel update pass, so that
+                 /// sensors are not finalized while a worker updates them.
+                 /// The sensors mutex is not held during the pass, which
+                 /// lets sensor callbacks look up other sensors.
+                 private: boost::mutex passMutex;
+
+                 /// \brief Wakes up the workers for a new pass.
+                 private: boost::condition_variable workCondition;
+
+                 /// \brief Signals the end of a pass.
+                 private: boost::condition_variable doneCondition;
                };
       /// \endcond
 
@@ -282,6 +365,13 @@ namespace gazebo
       /// the SensorContainer.
       private: class ImageSensorContainer : public SensorContainer
                {
+                 /// \brief Constructor.
+                 /// \param[in] _holdPoses True to keep the scene at the
+                 /// next timestamp required by a sensor while physics runs
+                 /// ahead, for a pipelined lockstep.
+                 public: explicit ImageSensorContainer(
+                             const bool _holdPoses = false);
+
                  /// \brief Wait until pre-rendering phase is over.
                  /// \param[in] _timeoutsec timeout expressed in seconds
                  /// \return True if timeout has NOT been met
@@ -294,6 +384,10 @@ namespace gazebo
 
                  /// \brief used to wait for the end of prerendering
                  private: std::condition_variable conditionPrerendered;
+
+                 /// \brief True to hold back poses past the next required
+                 /// timestamp.
+                 private: bool holdPoses;
                };
       /// \endcond
 
@@ -340,6 +434,32 @@ namespace gazebo
 
       /// \brief Connect to the remove sensor event.
       private: event::ConnectionPtr removeSensorConnection;
+
+      /// \brief Performance metrics messages per second of wall time.
+      private: double metricsRate = 1.0;
+
+      /// \brief Steps physics may run ahead of the rendering sensors in
+      /// lockstep, zero to wait for them on every required timestamp.
+      private: unsigned int lockstepPipeline = 0;
+
+      /// \brief Node for publishing performance metrics.
+      private: transport::NodePtr metricsNode;
+
+      /// \brief Publisher of performance metrics.
+      private: transport::PublisherPtr metricsPub;
+
+      /// \brief Wall time of the last performance metrics message.
+      private: common::Time metricsWallTime;
+
+      /// \brief World real time of the last performance metrics message.
+      private: common::Time metricsRealTime;
+
+      /// \brief World sim time of the last performance metrics message.
+      private: common::Time metricsSimTime;
+
+      /// \brief Sensor timings at the last performance metrics message, by
+      /// sensor id.
+      private: std::map<uint32_t, SensorTiming> metricsTimings;
     };
     /// \}
   }
@@ -17,6 +17,7 @@
 #ifndef GAZEBO_SENSORS_SENSOR_PRIVATE_HH_
 #define GAZEBO_SENSORS_SENSOR_PRIVATE_HH_
 
+#include <atomic>
 #include <mutex>
 #include <sdf/sdf.hh>
 
@@ -51,6 +52,18 @@ namespace gazebo
       /// \brief The sensors unique ID.
       public: uint32_t id;
 
+      /// \brief Number of message buffer allocations, see
+      /// Sensor::BufferAllocations.
+      public: std::atomic<uint64_t> bufferAllocations{0};
+
+      /// \brief Counters of Sensor::Timing.
+      /// \{
+      public: std::atomic<uint64_t> updateCount{0};
+      public: std::atomic<uint64_t> updateNsec{0};
+      public: std::atomic<uint64_t> renderCount{0};
+      public: std::atomic<uint64_t> renderNsec{0};
+      /// \}
+
       /// \brief An SDF pointer that allows us to only read the sensor.sdf
       /// file once, which in turns limits disk reads.
       public: static sdf::ElementPtr sdfSensor;
@@ -16,7 +16,9 @@
 */
 
 #include <gtest/gtest.h>
+#include <chrono>
 #include <condition_variable>
+#include <thread>
 #include "gazebo/physics/PhysicsIface.hh"
 #include "gazebo/common/Time.hh"
 #include "gazebo/test/ServerFixture.hh"
@@ -207,6 +209,87 @@ TEST_F(Sensor_TEST, SetPose)
   EXPECT_EQ(sensor.Pose(), ignition::math::Pose3d(0, 1, 2, 3, 4, 5));
 }
 
+/////////////////////////////////////////////////
+/// \brief Next update time follows the update rate
+TEST_F(Sensor_TEST, NextUpdateTime)
+{
+  sensors::Sensor sensor(gazebo::sensors::OTHER);
+  EXPECT_EQ(sensor.NextUpdateTime(), common::Time::Zero);
+
+  sensor.SetUpdateRate(10);
+  EXPECT_EQ(sensor.NextUpdateTime(), common::Time(0.1));
+
+  sensor.SetUpdateRate(0);
+  EXPECT_EQ(sensor.NextUpdateTime(), common::Time::Zero);
+}
+
+/////////////////////////////////////////////////
+/// \brief Sensor that fills a buffer the way sensors fill their messages
+class BufferSensor : public sensors::Sensor
+{
+  public: BufferSensor() : sensors::Sensor(sensors::OTHER) {}
+
+  public: void Fill(std::string &_buffer, const size_t _size)
+  {
+    const size_t capacity = _buffer.capacity();
+    _buffer.assign(_size, 'x');
+    this->CountBufferAllocation(capacity, _buffer.capacity());
+  }
+};
+
+/////////////////////////////////////////////////
+/// \brief Refilling a buffer of the same size is not counted
+TEST_F(Sensor_TEST, BufferAllocations)
+{
+  BufferSensor sensor;
+  EXPECT_EQ(sensor.BufferAllocations(), 0u);
+
+  std::string buffer;
+  sensor.Fill(buffer, 1 << 20);
+  EXPECT_EQ(sensor.BufferAllocations(), 1u);
+
+  for (int i = 0; i < 10; ++i)
+    sensor.Fill(buffer, 1 << 20);
+  EXPECT_EQ(sensor.BufferAllocations(), 1u);
+
+  sensor.Fill(buffer, 1 << 22);
+  EXPECT_EQ(sensor.BufferAllocations(), 2u);
+}
+
+/////////////////////////////////////////////////
+/// \brief Sensor that pretends to render
+class RenderSensor : public sensors::Sensor
+{
+  public: RenderSensor() : sensors::Sensor(sensors::IMAGE) {}
+
+  public: void Render()
+  {
+    auto start = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    this->AddRenderTime(start);
+  }
+};
+
+/////////////////////////////////////////////////
+/// \brief Renders are counted with their duration
+TEST_F(Sensor_TEST, Timing)
+{
+  RenderSensor sensor;
+  sensors::SensorTiming timing = sensor.Timing();
+  EXPECT_EQ(timing.updates, 0u);
+  EXPECT_EQ(timing.updateTime, 0u);
+  EXPECT_EQ(timing.renders, 0u);
+  EXPECT_EQ(timing.renderTime, 0u);
+
+  sensor.Render();
+  sensor.Render();
+
+  timing = sensor.Timing();
+  EXPECT_EQ(timing.updates, 0u);
+  EXPECT_EQ(timing.renders, 2u);
+  EXPECT_GE(timing.renderTime, 4000000u);
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
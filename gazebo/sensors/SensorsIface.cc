@@ -29,6 +29,7 @@
 using namespace gazebo;
 
 bool g_disable = false;
+bool g_renderingDisabled = false;
 
 /////////////////////////////////////////////////
 bool sensors::load()
@@ -39,6 +40,12 @@ bool sensors::load()
   // Register all the sensor types
   sensors::SensorFactory::RegisterAll();
 
+  if (g_renderingDisabled)
+  {
+    gzmsg << "Rendering is disabled, sensors that render won't be created\n";
+    return true;
+  }
+
   // Load the rendering system
   return gazebo::rendering::load();
 }
@@ -50,7 +57,7 @@ bool sensors::init()
     return true;
 
   // The rendering engine will run headless
-  if (!gazebo::rendering::init())
+  if (!g_renderingDisabled && !gazebo::rendering::init())
   {
     gzthrow("Unable to intialize the rendering engine");
     return false;
@@ -68,7 +75,8 @@ bool sensors::fini()
     return true;
 
   sensors::SensorManager::Instance()->Fini();
-  rendering::fini();
+  if (!g_renderingDisabled)
+    rendering::fini();
   return true;
 }
 
@@ -152,6 +160,18 @@ void sensors::enable()
   g_disable = false;
 }
 
+/////////////////////////////////////////////////
+void sensors::disable_rendering()
+{
+  g_renderingDisabled = true;
+}
+
+/////////////////////////////////////////////////
+bool sensors::rendering_enabled()
+{
+  return !g_renderingDisabled;
+}
+
 /////////////////////////////////////////////////
 bool sensors::running()
 {
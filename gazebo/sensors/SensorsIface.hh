@@ -100,6 +100,17 @@ namespace gazebo
     GZ_SENSORS_VISIBLE
     void enable();
 
+    /// \brief Run without the rendering engine: load, init and fini skip
+    /// it, and sensors that render (cameras, GPU lasers) are not created.
+    /// Must be called before load.
+    GZ_SENSORS_VISIBLE
+    void disable_rendering();
+
+    /// \brief Get whether sensors use the rendering engine.
+    /// \return False if disable_rendering was called.
+    GZ_SENSORS_VISIBLE
+    bool rendering_enabled();
+
     /// \brief Return true if the manager is running.
     /// \return True if manager is running.
     GAZEBO_VISIBLE
@@ -14,10 +14,17 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <string>
+#include <unordered_set>
+
 #include <ignition/common/Profiler.hh>
 #include <ignition/math/Pose3.hh>
 
 #include "gazebo/msgs/msgs.hh"
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/ProximityIndex.hh"
+#include "gazebo/physics/World.hh"
 #include "gazebo/sensors/SensorFactory.hh"
 #include "gazebo/sensors/SensorManager.hh"
 #include "gazebo/transport/Node.hh"
@@ -32,6 +39,14 @@ using namespace sensors;
 
 GZ_REGISTER_STATIC_SENSOR("wireless_receiver", WirelessReceiver)
 
+/// \brief Get the name of the top level model from a scoped name.
+/// \param[in] _scopedName Scoped name of a link, such as a sensor parent.
+/// \return Name of the top level model.
+static std::string TopModelName(const std::string &_scopedName)
+{
+  return _scopedName.substr(0, _scopedName.find("::"));
+}
+
 /////////////////////////////////////////////////
 WirelessReceiver::WirelessReceiver()
 : WirelessTransceiver(),
@@ -48,6 +63,10 @@ WirelessReceiver::~WirelessReceiver()
 void WirelessReceiver::Init()
 {
   WirelessTransceiver::Init();
+
+  // The proximity index tells UpdateImpl which transmitters are close
+  // enough to be heard
+  this->world->SetProximityIndexEnabled(true);
 }
 
 /////////////////////////////////////////////////
@@ -107,7 +126,8 @@ bool WirelessReceiver::UpdateImpl(const bool /*_force*/)
   IGN_PROFILE_BEGIN("Update");
 
   std::string txEssid;
-  msgs::WirelessNodes msg;
+  msgs::WirelessNodes &msg = this->dataPtr->msg;
+  msg.Clear();
   double rxPower;
   double txFreq;
 
@@ -115,10 +135,45 @@ bool WirelessReceiver::UpdateImpl(const bool /*_force*/)
 
   ignition::math::Pose3d myPos = this->referencePose;
   Sensor_V sensors = SensorManager::Instance()->GetSensors();
+
+  // Models that may hold a transmitter in range, so that the others are
+  // skipped without testing their line of sight. A transmitter is offset
+  // from its link, whose origin is within the bounding sphere of the model.
+  const physics::ProximityIndex &index = this->world->ModelProximityIndex();
+  const bool indexed = this->world->ProximityIndexEnabled() && index.Built();
+  std::unordered_set<std::string> nearby;
+  if (indexed)
+  {
+    double radius = 0;
+    for (auto const &sensor : sensors)
+    {
+      if (sensor->Type() != "wireless_transmitter")
+        continue;
+
+      auto transmitter = std::static_pointer_cast<WirelessTransmitter>(sensor);
+      if (transmitter->Freq() < this->MinFreqFiltered() ||
+          transmitter->Freq() > this->MaxFreqFiltered())
+      {
+        continue;
+      }
+      radius = std::max(radius,
+          transmitter->Range(this->Gain(), this->Sensitivity()) +
+          transmitter->Pose().Pos().Length());
+    }
+
+    for (auto const &model : index.ModelsInRadius(myPos.Pos(), radius))
+      nearby.insert(model->GetName());
+  }
+
   for (Sensor_V::iterator it = sensors.begin(); it != sensors.end(); ++it)
   {
     if ((*it)->Type() == "wireless_transmitter")
     {
+      // Sensors hang off links, so their scoped name starts with the top
+      // level model
+      if (indexed && nearby.count(TopModelName((*it)->ParentName())) == 0)
+        continue;
+
       std::shared_ptr<gazebo::sensors::WirelessTransmitter> transmitter =
           std::static_pointer_cast<WirelessTransmitter>(*it);
 
@@ -17,6 +17,8 @@
 #ifndef _GAZEBO_SENSORS_WIRELESSRECEIVER_PRIVATE_HH_
 #define _GAZEBO_SENSORS_WIRELESSRECEIVER_PRIVATE_HH_
 
+#include "gazebo/msgs/msgs.hh"
+
 namespace gazebo
 {
   namespace sensors
@@ -33,6 +35,10 @@ namespace gazebo
 
       /// \brief Antenna's sensitivity of the receiver (dBm).
       public: double sensitivity = -90.0;
+
+      /// \brief Message of the nodes heard, reused so that the cleared
+      /// nodes and their ESSID strings are filled again on each update.
+      public: msgs::WirelessNodes msg;
     };
   }
 }
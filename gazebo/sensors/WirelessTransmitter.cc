@@ -14,10 +14,16 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
 #include <ignition/math/Rand.hh>
 
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/physics/physics.hh"
+#include "gazebo/physics/SpatialIndex.hh"
 #include "gazebo/sensors/SensorFactory.hh"
 #include "gazebo/transport/Node.hh"
 #include "gazebo/transport/Publisher.hh"
@@ -83,6 +89,10 @@ void WirelessTransmitter::Init()
   // between the transmitter and a given point.
   this->dataPtr->testRay = boost::dynamic_pointer_cast<RayShape>(
       this->world->Physics()->CreateShape("ray", CollisionPtr()));
+
+  // The spatial index tells SignalStrength() which models lie along a
+  // line of sight, so that it can reuse earlier ray tests
+  this->world->SetSpatialIndexEnabled(true);
 }
 
 //////////////////////////////////////////////////
@@ -92,40 +102,42 @@ bool WirelessTransmitter::UpdateImpl(const bool /*_force*/)
 
   if (this->dataPtr->visualize)
   {
-    msgs::PropagationGrid msg;
-    ignition::math::Pose3d pos;
-    ignition::math::Pose3d worldPose;
-    double strength;
-    msgs::PropagationParticle *p;
-
-    // Iterate using a rectangular grid, but only choose the points within
-    // a circunference of radius MaxRadius
-    for (double x = -this->dataPtr->MaxRadius;
-         x <= this->dataPtr->MaxRadius; x += this->dataPtr->Step)
-    {
-      for (double y = -this->dataPtr->MaxRadius;
-           y <= this->dataPtr->MaxRadius; y += this->dataPtr->Step)
-      {
-        pos.Set(x, y, 0.0, 0, 0, 0);
-
-        worldPose = pos + this->referencePose;
-
-        if (this->referencePose.Pos().Distance(worldPose.Pos()) <=
-            this->dataPtr->MaxRadius)
+    this->pub->PublishIfSubscribed<msgs::PropagationGrid>(
+        [this](msgs::PropagationGrid &_msg)
         {
-          // For the propagation model assume the receiver antenna has the same
-          // gain as the transmitter
-          strength = this->SignalStrength(worldPose, this->Gain());
-
-          // Add a new particle to the grid
-          p = msg.add_particle();
-          p->set_x(x);
-          p->set_y(y);
-          p->set_signal_level(strength);
-        }
-      }
-    }
-    this->pub->Publish(msg);
+          ignition::math::Pose3d pos;
+          ignition::math::Pose3d worldPose;
+          double strength;
+          msgs::PropagationParticle *p;
+
+          // Iterate using a rectangular grid, but only choose the points
+          // within a circunference of radius MaxRadius
+          for (double x = -this->dataPtr->MaxRadius;
+               x <= this->dataPtr->MaxRadius; x += this->dataPtr->Step)
+          {
+            for (double y = -this->dataPtr->MaxRadius;
+                 y <= this->dataPtr->MaxRadius; y += this->dataPtr->Step)
+            {
+              pos.Set(x, y, 0.0, 0, 0, 0);
+
+              worldPose = pos + this->referencePose;
+
+              if (this->referencePose.Pos().Distance(worldPose.Pos()) <=
+                  this->dataPtr->MaxRadius)
+              {
+                // For the propagation model assume the receiver antenna has
+                // the same gain as the transmitter
+                strength = this->SignalStrength(worldPose, this->Gain());
+
+                // Add a new particle to the grid
+                p = _msg.add_particle();
+                p->set_x(x);
+                p->set_y(y);
+                p->set_signal_level(strength);
+              }
+            }
+          }
+        });
   }
 
   return true;
@@ -148,8 +160,6 @@ double WirelessTransmitter::SignalStrength(
     const ignition::math::Pose3d &_receiver,
     const double _rxGain)
 {
-  std::string entityName;
-  double dist;
   ignition::math::Vector3d end = _receiver.Pos();
   ignition::math::Vector3d start = this->referencePose.Pos();
 
@@ -160,19 +170,9 @@ double WirelessTransmitter::SignalStrength(
     end.Z() += 0.00001;
   }
 
-  // Acquire the mutex for avoiding race condition with the physics engine
-  boost::recursive_mutex::scoped_lock lock(*(
-        this->world->Physics()->GetPhysicsUpdateMutex()));
-
   // Compute the value of n depending on the obstacles between Tx and Rx
   double n = WirelessTransmitterPrivate::NEmpty;
-
-  // Looking for obstacles between start and end points
-  this->dataPtr->testRay->SetPoints(start, end);
-  this->dataPtr->testRay->GetIntersection(dist, entityName);
-
-  // ToDo: The ray intersects with my own collision model. Fix it.
-  if (entityName != "")
+  if (this->Obstructed(start, end))
   {
     n = WirelessTransmitterPrivate::NObstacle;
   }
@@ -190,6 +190,98 @@ double WirelessTransmitter::SignalStrength(
   return rxPower;
 }
 
+/////////////////////////////////////////////////
+double WirelessTransmitter::Range(const double _rxGain,
+    const double _sensitivity) const
+{
+  // Strongest signal of SignalStrength: no obstacle and no noise
+  double wavelength = common::SpeedOfLight / (this->Freq() * 1000000);
+  double margin = this->Power() + this->Gain() + _rxGain +
+      20 * log10(wavelength) - 20 * log10(4 * M_PI) - _sensitivity;
+
+  return std::max(1.0,
+      std::pow(10.0, margin / (10 * WirelessTransmitterPrivate::NEmpty)));
+}
+
+/////////////////////////////////////////////////
+bool WirelessTransmitter::Obstructed(const ignition::math::Vector3d &_start,
+    const ignition::math::Vector3d &_end)
+{
+  std::lock_guard<std::mutex> cacheLock(this->dataPtr->lineOfSightMutex);
+
+  // Models whose boxes cross the segment, as of the last index refresh
+  const SpatialIndex &index = this->world->ModelSpatialIndex();
+  const bool indexed = this->world->SpatialIndexEnabled() && index.Size() > 0;
+  std::vector<std::pair<const Model *, ignition::math::AxisAlignedBox>>
+      occluders;
+  if (indexed)
+  {
+    for (auto const &model : index.ModelsOnRay(_start, _end))
+    {
+      ignition::math::AxisAlignedBox box;
+      if (index.BoundingBox(model.get(), box))
+        occluders.push_back(std::make_pair(model.get(), box));
+    }
+
+    // Nothing along the segment, no need for a ray test
+    if (occluders.empty())
+      return false;
+
+    std::sort(occluders.begin(), occluders.end(),
+        [](const std::pair<const Model *, ignition::math::AxisAlignedBox> &_a,
+           const std::pair<const Model *, ignition::math::AxisAlignedBox> &_b)
+        {
+          return _a.first < _b.first;
+        });
+  }
+
+  const auto key = std::make_tuple(_end.X(), _end.Y(), _end.Z());
+  if (indexed)
+  {
+    // Reuse the last test from this point unless an end or an occluder
+    // moved since
+    auto iter = this->dataPtr->lineOfSight.find(key);
+    if (iter != this->dataPtr->lineOfSight.end() &&
+        iter->second.start == _start && iter->second.occluders == occluders)
+    {
+      return iter->second.obstructed;
+    }
+  }
+
+  bool obstructed;
+  {
+    // Acquire the mutex for avoiding race condition with the physics engine
+    boost::recursive_mutex::scoped_lock lock(*(
+          this->world->Physics()->GetPhysicsUpdateMutex()));
+
+    // Looking for obstacles between start and end points
+    std::string entityName;
+    double dist;
+    this->dataPtr->testRay->SetPoints(_start, _end);
+    this->dataPtr->testRay->GetIntersection(dist, entityName);
+
+    // ToDo: The ray intersects with my own collision model. Fix it.
+    obstructed = !entityName.empty();
+  }
+
+  if (indexed)
+  {
+    if (this->dataPtr->lineOfSight.size() >=
+        WirelessTransmitterPrivate::MaxLineOfSightCache)
+    {
+      this->dataPtr->lineOfSight.clear();
+    }
+
+    WirelessTransmitterPrivate::LineOfSight &entry =
+        this->dataPtr->lineOfSight[key];
+    entry.start = _start;
+    entry.occluders.swap(occluders);
+    entry.obstructed = obstructed;
+  }
+
+  return obstructed;
+}
+
 /////////////////////////////////////////////////
 double WirelessTransmitter::ModelStdDev() const
 {
@@ -68,11 +68,29 @@ namespace gazebo
       public: double SignalStrength(const ignition::math::Pose3d &_receiver,
           const double _rxGain);
 
+      /// \brief Get the distance beyond which SignalStrength is always
+      /// lower than a receiver's sensitivity, whatever the obstacles and
+      /// the noise.
+      /// \param[in] _rxGain Receiver gain value
+      /// \param[in] _sensitivity Receiver sensitivity (dBm).
+      /// \return Range in meters, at least 1.
+      public: double Range(const double _rxGain,
+          const double _sensitivity) const;
+
       /// \brief Get the std dev of the Gaussian random variable used in the
       /// propagation model.
       /// \return The standard deviation of the propagation model.
       public: double ModelStdDev() const;
 
+      /// \brief Check if something blocks the line of sight between two
+      /// points. Reuses the previous result for the same end point while
+      /// neither end nor any model along the segment has moved.
+      /// \param[in] _start Start of the segment.
+      /// \param[in] _end End of the segment.
+      /// \return True if an obstacle lies between the points.
+      private: bool Obstructed(const ignition::math::Vector3d &_start,
+          const ignition::math::Vector3d &_end);
+
       /// \internal
       /// \brief Private data pointer
       private: std::unique_ptr<WirelessTransmitterPrivate> dataPtr;
@@ -17,7 +17,16 @@
 #ifndef _GAZEBO_SENSORS_WIRELESSTRANSMITTER_PRIVATE_HH_
 #define _GAZEBO_SENSORS_WIRELESSTRANSMITTER_PRIVATE_HH_
 
+#include <map>
+#include <mutex>
 #include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <ignition/math/AxisAlignedBox.hh>
+#include <ignition/math/Vector3.hh>
+
 #include "gazebo/physics/PhysicsTypes.hh"
 
 namespace gazebo
@@ -59,6 +68,32 @@ namespace gazebo
 
       // \brief Ray used to test for collisions when placing entities
       public: physics::RayShapePtr testRay;
+
+      /// \brief Result of a line of sight ray test, valid as long as its
+      /// end points and the boxes of the models along it are unchanged.
+      public: class LineOfSight
+      {
+        /// \brief Start of the tested segment.
+        public: ignition::math::Vector3d start;
+
+        /// \brief Models whose spatial index box crossed the segment, with
+        /// their boxes at the time of the test.
+        public: std::vector<std::pair<const physics::Model *,
+                    ignition::math::AxisAlignedBox>> occluders;
+
+        /// \brief True if the ray hit something.
+        public: bool obstructed = false;
+      };
+
+      /// \brief Maximum number of cached line of sight results.
+      public: static const size_t MaxLineOfSightCache = 4096;
+
+      /// \brief Line of sight results, keyed by receiver position.
+      public: std::map<std::tuple<double, double, double>, LineOfSight>
+              lineOfSight;
+
+      /// \brief Protects lineOfSight and testRay.
+      public: std::mutex lineOfSightMutex;
     };
   }
 }
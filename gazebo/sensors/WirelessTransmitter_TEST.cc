@@ -24,6 +24,7 @@ class WirelessTransmitter_TEST : public ServerFixture
     public: WirelessTransmitter_TEST();
     public: void TestCreateWirelessTransmitter();
     public: void TestSignalStrength();
+    public: void TestRange();
     public: void TestUpdateImpl();
     public: void TestUpdateImplNoVisual();
     public: void TestInvalidFreq();
@@ -159,6 +160,26 @@ void WirelessTransmitter_TEST::TestSignalStrength()
   EXPECT_NEAR(signStrengthAvg, -62.0, this->tx->ModelStdDev());
 }
 
+/////////////////////////////////////////////////
+/// \brief Test that no signal is heard beyond the range
+void WirelessTransmitter_TEST::TestRange()
+{
+  const double rxGain = 2.5;
+  const double sensitivity = -90.0;
+  const double range = this->tx->Range(rxGain, sensitivity);
+  EXPECT_GT(range, 1.0);
+
+  // A more sensitive receiver hears further
+  EXPECT_GT(this->tx->Range(rxGain, sensitivity - 10), range);
+
+  ignition::math::Pose3d rxPose(
+      ignition::math::Vector3d(range + 0.1, 0.0, 0.055),
+      ignition::math::Quaterniond(0, 0, 0));
+  this->tx->Update(true);
+  for (int i = 0; i < 100; ++i)
+    EXPECT_LT(this->tx->SignalStrength(rxPose, rxGain), sensitivity);
+}
+
 /////////////////////////////////////////////////
 /// \brief Callback executed for every propagation grid message received
 void WirelessTransmitter_TEST::TxMsg(const ConstPropagationGridPtr &_msg)
@@ -254,6 +275,12 @@ TEST_F(WirelessTransmitter_TEST, TestSignalStrength)
   TestSignalStrength();
 }
 
+/////////////////////////////////////////////////
+TEST_F(WirelessTransmitter_TEST, TestRange)
+{
+  TestRange();
+}
+
 /////////////////////////////////////////////////
 TEST_F(WirelessTransmitter_TEST, TestUpdateImpl)
 {
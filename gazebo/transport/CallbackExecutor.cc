@@ -0,0 +1,359 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cstdlib>
+#include <deque>
+#include <limits>
+#include <vector>
+#include <boost/lexical_cast.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/SamplingProfiler.hh"
+#include "gazebo/transport/CallbackExecutor.hh"
+
+namespace gazebo
+{
+namespace transport
+{
+/// \brief Upper bound for GAZEBO_CALLBACK_THREADS.
+static const unsigned int kMaxCallbackThreads = 64;
+
+/// \brief Number of jobs an executor runs on the shared pool before
+/// letting the other executors run.
+static const std::size_t kSharedBatch = 16;
+
+/////////////////////////////////////////////////
+/// \brief Thread pool shared by the SHARED executors, started on first
+/// use.
+class SharedPool
+{
+  /// \brief Constructor. Starts the threads.
+  public: SharedPool()
+  {
+    unsigned int count = std::max(boost::thread::hardware_concurrency(), 1u);
+
+    const char *env = std::getenv("GAZEBO_CALLBACK_THREADS");
+    if (env)
+    {
+      try
+      {
+        count = boost::lexical_cast<unsigned int>(env);
+      }
+      catch(...)
+      {
+        gzwarn << "Invalid GAZEBO_CALLBACK_THREADS[" << env << "]\n";
+      }
+    }
+    count = std::min(std::max(count, 1u), kMaxCallbackThreads);
+
+    for (unsigned int i = 0; i < count; ++i)
+      this->threads.push_back(new boost::thread(&SharedPool::Run, this));
+  }
+
+  /// \brief Destructor. Stops the threads, dropping the queued jobs.
+  public: ~SharedPool()
+  {
+    {
+      boost::mutex::scoped_lock lock(this->mutex);
+      this->stop = true;
+      this->jobs.clear();
+    }
+    this->condition.notify_all();
+
+    for (auto thread : this->threads)
+    {
+      thread->join();
+      delete thread;
+    }
+  }
+
+  /// \brief Get the pool.
+  /// \return The pool shared by all executors.
+  public: static SharedPool &Instance()
+  {
+    static SharedPool pool;
+    return pool;
+  }
+
+  /// \brief Queue a job.
+  /// \param[in] _job Job to run on one of the threads.
+  public: void Post(const CallbackExecutor::Job &_job)
+  {
+    {
+      boost::mutex::scoped_lock lock(this->mutex);
+      if (this->stop)
+        return;
+      this->jobs.push_back(_job);
+    }
+    this->condition.notify_one();
+  }
+
+  /// \brief Main loop of the threads.
+  private: void Run()
+  {
+    common::SetThreadName("CallbackPool");
+    boost::mutex::scoped_lock lock(this->mutex);
+    while (true)
+    {
+      while (!this->stop && this->jobs.empty())
+        this->condition.wait(lock);
+      if (this->stop)
+        return;
+
+      CallbackExecutor::Job job = this->jobs.front();
+      this->jobs.pop_front();
+
+      lock.unlock();
+      job();
+      lock.lock();
+    }
+  }
+
+  /// \brief Threads of the pool.
+  public: std::vector<boost::thread *> threads;
+
+  /// \brief Queued jobs.
+  private: std::deque<CallbackExecutor::Job> jobs;
+
+  /// \brief Protects jobs and stop.
+  private: boost::mutex mutex;
+
+  /// \brief Signaled when a job is queued or the pool stops.
+  private: boost::condition_variable condition;
+
+  /// \brief True once the pool is stopping.
+  private: bool stop = false;
+};
+
+/////////////////////////////////////////////////
+class CallbackExecutorPrivate
+{
+  /// \brief Kind of executor and queue size.
+  public: SubscriptionExecutor options;
+
+  /// \brief Queued jobs.
+  public: std::deque<CallbackExecutor::Job> jobs;
+
+  /// \brief Protects the members below.
+  public: mutable boost::mutex mutex;
+
+  /// \brief Signaled when a job is queued, a job finishes or the executor
+  /// stops.
+  public: boost::condition_variable condition;
+
+  /// \brief Thread of a dedicated executor.
+  public: boost::thread *thread = nullptr;
+
+  /// \brief True while a job runs.
+  public: bool running = false;
+
+  /// \brief True while a drain is queued on the shared pool.
+  public: bool scheduled = false;
+
+  /// \brief True once stopped.
+  public: bool stopped = false;
+
+  /// \brief Number of dropped jobs.
+  public: uint64_t dropped = 0;
+};
+
+/// \brief Executor whose job is running on the calling thread, if any.
+static thread_local CallbackExecutorPrivate *currentExecutor = nullptr;
+
+/////////////////////////////////////////////////
+/// \brief Run queued jobs.
+/// \param[in] _data Executor to run.
+/// \param[in] _maxJobs Maximum number of jobs to run.
+static void Drain(const boost::shared_ptr<CallbackExecutorPrivate> &_data,
+    const std::size_t _maxJobs)
+{
+  boost::mutex::scoped_lock lock(_data->mutex);
+
+  std::size_t count = 0;
+  while (!_data->stopped && !_data->jobs.empty() && count++ < _maxJobs)
+  {
+    CallbackExecutor::Job job = _data->jobs.front();
+    _data->jobs.pop_front();
+    _data->running = true;
+
+    lock.unlock();
+    currentExecutor = _data.get();
+    job();
+    currentExecutor = nullptr;
+    lock.lock();
+
+    _data->running = false;
+    _data->condition.notify_all();
+  }
+
+  if (_data->options.kind != SubscriptionExecutor::SHARED)
+    return;
+
+  // Jobs are left, queue another drain behind the other executors
+  if (!_data->stopped && !_data->jobs.empty())
+  {
+    lock.unlock();
+    boost::shared_ptr<CallbackExecutorPrivate> data = _data;
+    SharedPool::Instance().Post([data]() {Drain(data, kSharedBatch);});
+  }
+  else
+  {
+    _data->scheduled = false;
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Main loop of the thread of a dedicated executor.
+/// \param[in] _data Executor to run.
+static void RunDedicated(boost::shared_ptr<CallbackExecutorPrivate> _data)
+{
+  common::SetThreadName("CallbackDedicated");
+  boost::mutex::scoped_lock lock(_data->mutex);
+  while (!_data->stopped)
+  {
+    if (_data->jobs.empty())
+    {
+      _data->condition.wait(lock);
+      continue;
+    }
+
+    lock.unlock();
+    Drain(_data, std::numeric_limits<std::size_t>::max());
+    lock.lock();
+  }
+}
+}
+}
+
+using namespace gazebo;
+using namespace transport;
+
+/////////////////////////////////////////////////
+CallbackExecutor::CallbackExecutor(const SubscriptionExecutor &_options)
+  : dataPtr(new CallbackExecutorPrivate)
+{
+  this->dataPtr->options = _options;
+  if (this->dataPtr->options.kind == SubscriptionExecutor::INLINE)
+    this->dataPtr->options.kind = SubscriptionExecutor::SHARED;
+
+  if (this->dataPtr->options.kind == SubscriptionExecutor::DEDICATED)
+    this->dataPtr->thread = new boost::thread(&RunDedicated, this->dataPtr);
+}
+
+/////////////////////////////////////////////////
+CallbackExecutor::~CallbackExecutor()
+{
+  this->Stop();
+}
+
+/////////////////////////////////////////////////
+unsigned int CallbackExecutor::SharedThreadCount()
+{
+  return SharedPool::Instance().threads.size();
+}
+
+/////////////////////////////////////////////////
+bool CallbackExecutor::Post(const Job &_job)
+{
+  bool schedule = false;
+  {
+    boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+    if (this->dataPtr->stopped)
+      return false;
+
+    this->dataPtr->jobs.push_back(_job);
+    if (this->dataPtr->options.queueSize > 0 &&
+        this->dataPtr->jobs.size() > this->dataPtr->options.queueSize)
+    {
+      this->dataPtr->jobs.pop_front();
+      ++this->dataPtr->dropped;
+    }
+
+    if (this->dataPtr->options.kind == SubscriptionExecutor::SHARED &&
+        !this->dataPtr->scheduled)
+    {
+      this->dataPtr->scheduled = true;
+      schedule = true;
+    }
+  }
+
+  if (schedule)
+  {
+    boost::shared_ptr<CallbackExecutorPrivate> data = this->dataPtr;
+    SharedPool::Instance().Post([data]() {Drain(data, kSharedBatch);});
+  }
+  else
+  {
+    this->dataPtr->condition.notify_all();
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+void CallbackExecutor::Wait()
+{
+  if (currentExecutor == this->dataPtr.get())
+    return;
+
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+  while (this->dataPtr->running)
+    this->dataPtr->condition.wait(lock);
+}
+
+/////////////////////////////////////////////////
+void CallbackExecutor::Stop()
+{
+  boost::thread *thread = nullptr;
+  {
+    boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+    this->dataPtr->stopped = true;
+    this->dataPtr->jobs.clear();
+    std::swap(thread, this->dataPtr->thread);
+  }
+  this->dataPtr->condition.notify_all();
+
+  if (thread)
+  {
+    // A job that stops its own executor cannot wait for itself, the
+    // thread exits once the job returns.
+    if (thread->get_id() == boost::this_thread::get_id())
+      thread->detach();
+    else
+      thread->join();
+    delete thread;
+  }
+
+  this->Wait();
+}
+
+/////////////////////////////////////////////////
+std::size_t CallbackExecutor::QueueSize() const
+{
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+  return this->dataPtr->jobs.size();
+}
+
+/////////////////////////////////////////////////
+uint64_t CallbackExecutor::DroppedCount() const
+{
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+  return this->dataPtr->dropped;
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_TRANSPORT_CALLBACKEXECUTOR_HH_
+#define GAZEBO_TRANSPORT_CALLBACKEXECUTOR_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "gazebo/transport/SubscribeOptions.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace transport
+  {
+    // Forward declare private class.
+    class CallbackExecutorPrivate;
+
+    /// \addtogroup gazebo_transport
+    /// \{
+
+    /// \class CallbackExecutor CallbackExecutor.hh transport/transport.hh
+    /// \brief Runs the jobs of one topic in order, either on its own
+    /// thread or on a thread pool shared by all executors, see
+    /// SubscriptionExecutor. Jobs are queued by Post and the oldest ones
+    /// are dropped when the queue is full.
+    ///
+    /// \remarks
+    ///  Environment Variables:
+    ///   - GAZEBO_CALLBACK_THREADS: Number of threads of the shared pool,
+    /// defaults to the number of cores.
+    class GZ_TRANSPORT_VISIBLE CallbackExecutor
+    {
+      /// \brief A job to run.
+      public: typedef boost::function<void ()> Job;
+
+      /// \brief Constructor.
+      /// \param[in] _options Kind of executor and queue size. INLINE is
+      /// treated as SHARED.
+      public: explicit CallbackExecutor(const SubscriptionExecutor &_options);
+
+      /// \brief Destructor. Stops the executor.
+      public: virtual ~CallbackExecutor();
+
+      /// \brief Queue a job.
+      /// \param[in] _job Job to run.
+      /// \return False if the executor is stopped.
+      public: bool Post(const Job &_job);
+
+      /// \brief Wait for the job that is running, if any. Returns
+      /// immediately when called from that job.
+      public: void Wait();
+
+      /// \brief Drop the queued jobs, wait for the running one and stop
+      /// accepting new jobs.
+      public: void Stop();
+
+      /// \brief Get the number of queued jobs.
+      /// \return Number of jobs waiting to run.
+      public: std::size_t QueueSize() const;
+
+      /// \brief Get the number of jobs dropped because the queue was full.
+      /// \return Number of dropped jobs.
+      public: uint64_t DroppedCount() const;
+
+      /// \brief Get the number of threads of the shared pool.
+      /// \return Number of threads.
+      public: static unsigned int SharedThreadCount();
+
+      /// \internal
+      /// \brief Pointer to private data. It is shared with the threads
+      /// running the jobs, so that an executor can be destroyed by one of
+      /// its own jobs.
+      private: boost::shared_ptr<CallbackExecutorPrivate> dataPtr;
+    };
+
+    /// \def CallbackExecutorPtr
+    /// \brief Shared_ptr to CallbackExecutor
+    typedef boost::shared_ptr<CallbackExecutor> CallbackExecutorPtr;
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "gazebo/transport/CallbackExecutor.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class CallbackExecutor : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Wait until a condition holds.
+/// \param[in] _cond Condition to check.
+/// \return True if the condition held within a few seconds.
+template<typename Cond>
+static bool WaitFor(const Cond &_cond)
+{
+  for (int i = 0; i < 500 && !_cond(); ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  return _cond();
+}
+
+/////////////////////////////////////////////////
+TEST_F(CallbackExecutor, Order)
+{
+  for (auto options : {transport::SubscriptionExecutor::Dedicated(0),
+                       transport::SubscriptionExecutor::Shared(0)})
+  {
+    transport::CallbackExecutorPtr executor(
+        new transport::CallbackExecutor(options));
+
+    std::mutex mutex;
+    std::vector<int> order;
+    for (int i = 0; i < 100; ++i)
+    {
+      EXPECT_TRUE(executor->Post([&, i]()
+          {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(i);
+          }));
+    }
+
+    EXPECT_TRUE(WaitFor([&]()
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          return order.size() == 100u;
+        }));
+
+    for (int i = 0; i < 100; ++i)
+      EXPECT_EQ(order[i], i);
+    EXPECT_EQ(executor->DroppedCount(), 0u);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(CallbackExecutor, DropOldest)
+{
+  transport::CallbackExecutorPtr executor(new transport::CallbackExecutor(
+        transport::SubscriptionExecutor::Dedicated(2)));
+
+  // Block the executor so that the next jobs stay queued
+  std::atomic<bool> release(false);
+  std::atomic<bool> started(false);
+  executor->Post([&]()
+      {
+        started = true;
+        while (!release)
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      });
+  ASSERT_TRUE(WaitFor([&]() {return started.load();}));
+
+  std::vector<int> ran;
+  for (int i = 0; i < 5; ++i)
+    executor->Post([&ran, i]() {ran.push_back(i);});
+
+  EXPECT_EQ(executor->QueueSize(), 2u);
+  EXPECT_EQ(executor->DroppedCount(), 3u);
+
+  release = true;
+  EXPECT_TRUE(WaitFor([&]() {return executor->QueueSize() == 0u;}));
+  executor->Stop();
+
+  ASSERT_EQ(ran.size(), 2u);
+  EXPECT_EQ(ran[0], 3);
+  EXPECT_EQ(ran[1], 4);
+}
+
+/////////////////////////////////////////////////
+TEST_F(CallbackExecutor, NoHeadOfLineBlocking)
+{
+  transport::CallbackExecutorPtr slow(new transport::CallbackExecutor(
+        transport::SubscriptionExecutor::Dedicated()));
+  transport::CallbackExecutorPtr fast(new transport::CallbackExecutor(
+        transport::SubscriptionExecutor::Shared()));
+
+  std::atomic<bool> release(false);
+  slow->Post([&]()
+      {
+        while (!release)
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      });
+
+  // The fast topic is served while the slow callback runs
+  std::atomic<int> count(0);
+  for (int i = 0; i < 10; ++i)
+    fast->Post([&]() {++count;});
+  EXPECT_TRUE(WaitFor([&]() {return count == 10;}));
+
+  release = true;
+}
+
+/////////////////////////////////////////////////
+TEST_F(CallbackExecutor, Stop)
+{
+  transport::CallbackExecutorPtr executor(new transport::CallbackExecutor(
+        transport::SubscriptionExecutor::Shared()));
+
+  std::atomic<bool> running(false);
+  std::atomic<bool> done(false);
+  executor->Post([&]()
+      {
+        running = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        done = true;
+      });
+  ASSERT_TRUE(WaitFor([&]() {return running.load();}));
+
+  // Stop waits for the running job and refuses new ones
+  executor->Stop();
+  EXPECT_TRUE(done);
+  EXPECT_FALSE(executor->Post([]() {}));
+
+  // A job can destroy its own executor
+  transport::CallbackExecutorPtr self(new transport::CallbackExecutor(
+        transport::SubscriptionExecutor::Dedicated()));
+  std::atomic<bool> destroyed(false);
+  self->Post([&]()
+      {
+        self.reset();
+        destroyed = true;
+      });
+  EXPECT_TRUE(WaitFor([&]() {return destroyed.load();}));
+
+  EXPECT_GE(transport::CallbackExecutor::SharedThreadCount(), 1u);
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
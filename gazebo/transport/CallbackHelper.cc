@@ -39,6 +39,19 @@ std::string CallbackHelper::GetMsgType() const
   return std::string();
 }
 
+/////////////////////////////////////////////////
+bool CallbackHelper::HandleBuffer(const MessageBufferPtr &_buffer,
+    boost::function<void(uint32_t)> _cb, uint32_t _id)
+{
+  return this->HandleData(*_buffer, _cb, _id);
+}
+
+/////////////////////////////////////////////////
+bool CallbackHelper::Throttled()
+{
+  return false;
+}
+
 /////////////////////////////////////////////////
 bool CallbackHelper::GetLatching() const
 {
@@ -29,6 +29,7 @@
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/common/Exception.hh"
 
+#include "gazebo/transport/TraceStamps.hh"
 #include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/util/system.hh"
 
@@ -64,6 +65,22 @@ namespace gazebo
       public: virtual bool HandleData(const std::string &_newdata,
                   boost::function<void(uint32_t)> _cb, uint32_t _id) = 0;
 
+      /// \brief Process new incoming data held in a shared buffer. The
+      /// default implementation calls HandleData.
+      /// \param[in] _buffer Incoming data to be processed
+      /// \param[in] _cb If non-null, callback to be invoked which signals
+      /// that transmission is complete.
+      /// \param[in] _id ID associated with the message data.
+      /// \return true if successfully processed; false otherwise
+      public: virtual bool HandleBuffer(const MessageBufferPtr &_buffer,
+                  boost::function<void(uint32_t)> _cb, uint32_t _id);
+
+      /// \brief Check whether the next published message should be
+      /// skipped by this callback, for callbacks that limit their rate.
+      /// Returning false counts the message as sent.
+      /// \return True to skip the message. The default is false.
+      public: virtual bool Throttled();
+
       /// \brief Process new incoming message
       /// \param[in] _newMsg Incoming message to be processed
       /// \return true if successfully processed; false otherwise
@@ -146,6 +163,8 @@ namespace gazebo
                 this->SetLatching(false);
                 boost::shared_ptr<M> m(new M);
                 m->ParseFromString(_newdata);
+                if (TraceStamps::Enabled())
+                  TraceStamps::Add(*m, msgs::TraceStamp::CALLBACK);
                 this->callback(m);
                 if (!_cb.empty())
                   _cb(_id);
@@ -198,7 +217,14 @@ namespace gazebo
                   boost::function<void(uint32_t)> _cb, uint32_t _id)
               {
                 this->SetLatching(false);
-                this->callback(_newdata);
+                if (TraceStamps::Enabled())
+                {
+                  std::string data(_newdata);
+                  TraceStamps::Append(data, msgs::TraceStamp::CALLBACK);
+                  this->callback(data);
+                }
+                else
+                  this->callback(_newdata);
                 if (!_cb.empty())
                   _cb(_id);
                 return true;
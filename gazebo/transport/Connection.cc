@@ -49,6 +49,11 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <string>
+
 #include <boost/bind/bind.hpp>
 #include <boost/function.hpp>
 #include <boost/lexical_cast.hpp>
@@ -59,10 +64,90 @@
 #include "gazebo/transport/IOManager.hh"
 #include "gazebo/transport/ConnectionManager.hh"
 #include "gazebo/transport/Connection.hh"
+#include "gazebo/transport/TraceStamps.hh"
 
 using namespace gazebo;
 using namespace transport;
 
+/// \brief Tag of the messages that are not subject to a queue size.
+static const unsigned int kUntagged = std::numeric_limits<unsigned int>::max();
+
+/// \brief Maximum number of messages in a write batch, so that the
+/// header and data buffers stay below the usual IOV_MAX of 1024.
+static const std::size_t kMaxBatchMessages = 512;
+
+/// \brief Digits of the message headers.
+static const char kHexDigits[] = "0123456789abcdef";
+
+/////////////////////////////////////////////////
+/// \brief Write the header of a message, same as printf("%08x") without
+/// parsing a format for every message.
+/// \param[out] _header HEADER_LENGTH characters to write to.
+/// \param[in] _size Size of the message.
+static void WriteHeader(char *_header, uint32_t _size)
+{
+  for (int i = HEADER_LENGTH - 1; i >= 0; --i, _size >>= 4)
+    _header[i] = kHexDigits[_size & 0xf];
+}
+
+/////////////////////////////////////////////////
+/// \brief Copy a message and append a trace stamp to the copy.
+/// \param[in] _buffer Message, which can be shared with other
+/// connections.
+/// \param[in] _stage Stage to stamp.
+/// \return The stamped copy.
+static MessageBufferPtr Stamped(const MessageBufferPtr &_buffer,
+    const msgs::TraceStamp::Stage _stage)
+{
+  boost::shared_ptr<std::string> data(new std::string());
+  data->reserve(_buffer->size() + 32);
+  data->append(*_buffer);
+  TraceStamps::Append(*data, _stage);
+  return data;
+}
+
+/////////////////////////////////////////////////
+/// \brief Settings shared by all connections, read from the environment
+/// on first use.
+struct WriteSettings
+{
+  /// \brief Constructor.
+  WriteSettings()
+  {
+    const char *batchEnv = std::getenv("GAZEBO_TRANSPORT_BATCH_BYTES");
+    if (batchEnv)
+    {
+      try
+      {
+        this->batchBytes = boost::lexical_cast<std::size_t>(batchEnv);
+      }
+      catch(...)
+      {
+        gzwarn << "Invalid GAZEBO_TRANSPORT_BATCH_BYTES[" << batchEnv
+               << "]\n";
+      }
+    }
+
+    const char *flushEnv = std::getenv("GAZEBO_TRANSPORT_FLUSH");
+    this->flushOnWrite = flushEnv && std::string(flushEnv) == "immediate";
+  }
+
+  /// \brief See Connection::SetWriteBatchSize.
+  std::atomic<std::size_t> batchBytes{65536};
+
+  /// \brief See Connection::SetFlushOnWrite.
+  std::atomic<bool> flushOnWrite{false};
+};
+
+/////////////////////////////////////////////////
+/// \brief Get the write settings.
+/// \return Settings shared by all connections.
+static WriteSettings &Settings()
+{
+  static WriteSettings settings;
+  return settings;
+}
+
 extern void dummy_callback_fn(uint32_t);
 
 unsigned int Connection::idCounter = 0;
@@ -94,6 +179,7 @@ Connection::Connection()
     iomanager = new IOManager();
 
   this->socket = new boost::asio::ip::tcp::socket(iomanager->GetIO());
+  this->strand = new boost::asio::io_service::strand(iomanager->GetIO());
 
   iomanager->IncCount();
   this->id = idCounter++;
@@ -126,6 +212,9 @@ Connection::~Connection()
 {
   this->Shutdown();
 
+  delete this->strand;
+  this->strand = NULL;
+
   if (iomanager)
   {
     iomanager->DecCount();
@@ -186,8 +275,9 @@ bool Connection::Connect(const std::string &_host, unsigned int _port)
   // Use async connect so that we can use a custom timeout. This is useful
   // when trying to detect network errors.
   this->socket->async_connect(*endpointIter++,
-      common::weakBind(&Connection::OnConnect, this->shared_from_this(),
-        boost::asio::placeholders::error, endpointIter));
+      this->strand->wrap(iomanager->Timed(
+          common::weakBind(&Connection::OnConnect, this->shared_from_this(),
+            boost::asio::placeholders::error, endpointIter))));
 
   // Wait for at most 60 seconds for a connection to be established.
   // The connectionCondition notification occurs in ::OnConnect.
@@ -233,8 +323,9 @@ void Connection::Listen(unsigned int port, const AcceptCallback &_acceptCB)
   this->acceptConn = ConnectionPtr(new Connection());
 
   this->acceptor->async_accept(*this->acceptConn->socket,
-      common::weakBind(&Connection::OnAccept, this->shared_from_this(),
-                  boost::asio::placeholders::error));
+      this->strand->wrap(iomanager->Timed(
+          common::weakBind(&Connection::OnAccept, this->shared_from_this(),
+            boost::asio::placeholders::error))));
 }
 
 //////////////////////////////////////////////////
@@ -262,8 +353,9 @@ void Connection::OnAccept(const boost::system::error_code &e)
     this->acceptConn = ConnectionPtr(new Connection());
 
     this->acceptor->async_accept(*this->acceptConn->socket,
-        common::weakBind(&Connection::OnAccept, this->shared_from_this(),
-          boost::asio::placeholders::error));
+        this->strand->wrap(iomanager->Timed(
+            common::weakBind(&Connection::OnAccept, this->shared_from_this(),
+              boost::asio::placeholders::error))));
   }
   else
   {
@@ -303,28 +395,78 @@ void Connection::EnqueueMsg(const std::string &_buffer,
     return;
   }
 
-  char headerBuffer[HEADER_LENGTH + 1];
-  snprintf(headerBuffer, HEADER_LENGTH + 1, "%08x",
-      static_cast<unsigned int>(_buffer.size()));
+  this->EnqueueMsg(MessageBufferPtr(new std::string(_buffer)), _cb, _id,
+      _force);
+}
+
+//////////////////////////////////////////////////
+void Connection::EnqueueMsg(const MessageBufferPtr &_buffer,
+    boost::function<void(uint32_t)> _cb, uint32_t _id, bool _force)
+{
+  this->Enqueue(_buffer, _cb, _id, kUntagged, 0, _force);
+}
+
+//////////////////////////////////////////////////
+void Connection::EnqueueMsg(const MessageBufferPtr &_buffer,
+    boost::function<void(uint32_t)> _cb, uint32_t _id,
+    const unsigned int _tag, const unsigned int _queueSize)
+{
+  this->Enqueue(_buffer, _cb, _id, _tag, _queueSize, false);
+}
+
+//////////////////////////////////////////////////
+void Connection::Enqueue(const MessageBufferPtr &_buffer,
+    boost::function<void(uint32_t)> _cb, uint32_t _id,
+    const unsigned int _tag, const unsigned int _queueSize, bool _force)
+{
+  // Don't enqueue empty messages
+  if (!_buffer || _buffer->empty() || !this->IsOpen())
+  {
+    return;
+  }
+
+  // Only topic data, which is tagged, is traced
+  MessageBufferPtr buffer = _buffer;
+  if (_tag != kUntagged && TraceStamps::Enabled())
+    buffer = Stamped(_buffer, msgs::TraceStamp::ENQUEUE);
+
+  char headerBuffer[HEADER_LENGTH];
+  WriteHeader(headerBuffer, static_cast<uint32_t>(buffer->size()));
+
+  // Callbacks of the messages dropped to respect the queue size
+  std::vector<std::pair<boost::function<void(uint32_t)>, uint32_t> > dropped;
 
   {
     boost::recursive_mutex::scoped_lock lock(this->writeMutex);
 
+    if (_queueSize > 0)
+      this->DropQueued(_tag, _queueSize - 1, dropped);
+
+    // The batch at the front is not extended while it is being written,
+    // since the buffer sequence handed to asio references it.
     if (this->writeQueue.empty() ||
         (this->writeCount > 0 && this->writeQueue.size() == 1) ||
-        (this->writeQueue.back().size() + HEADER_LENGTH + _buffer.size() >
-         4096))
+        this->writeQueue.back().payloads.size() >= kMaxBatchMessages ||
+        (this->writeQueue.back().size + HEADER_LENGTH + buffer->size() >
+         Settings().batchBytes))
     {
-      this->writeQueue.push_back(std::string(headerBuffer) + _buffer);
-      this->callbacks.push_back({std::make_pair(_cb, _id)});
-    }
-    else
-    {
-      this->writeQueue.back() += std::string(headerBuffer) + _buffer;
-      this->callbacks.back().push_back(std::make_pair(_cb, _id));
+      this->writeQueue.push_back(WriteBatch());
+      this->callbacks.push_back({});
     }
+
+    WriteBatch &batch = this->writeQueue.back();
+    batch.headers.append(headerBuffer, HEADER_LENGTH);
+    batch.payloads.push_back(buffer);
+    batch.tags.push_back(_tag);
+    batch.size += HEADER_LENGTH + buffer->size();
+    this->callbacks.back().push_back(std::make_pair(_cb, _id));
   }
 
+  // A dropped message counts as sent for its publisher
+  for (auto const &callback : dropped)
+    if (!callback.first.empty())
+      callback.first(callback.second);
+
   if (_force)
   {
     this->ProcessWriteQueue();
@@ -355,24 +497,26 @@ void Connection::ProcessWriteQueue(bool _blocking)
 
   this->writeCount++;
 
+  if (TraceStamps::Enabled())
+    this->StampWrite(this->writeQueue.front());
+
   // Write the serialized data to the socket. We use
   // "gather-write" to send both the head and the data in
   // a single write operation
   if (!_blocking)
   {
     boost::asio::async_write(*this->socket,
-        boost::asio::buffer(this->writeQueue.front().c_str(),
-          this->writeQueue.front().size()),
-          common::weakBind(&Connection::OnWrite, this->shared_from_this(),
-            boost::asio::placeholders::error));
+        WriteBuffers(this->writeQueue.front()),
+          this->strand->wrap(iomanager->Timed(
+            common::weakBind(&Connection::OnWrite, this->shared_from_this(),
+              boost::asio::placeholders::error))));
   }
   else
   {
     try
     {
       boost::asio::write(*this->socket,
-          boost::asio::buffer(this->writeQueue.front().c_str(),
-            this->writeQueue.front().size()));
+          WriteBuffers(this->writeQueue.front()));
     }
     catch(...)
     {
@@ -383,6 +527,101 @@ void Connection::ProcessWriteQueue(bool _blocking)
   }
 }
 
+//////////////////////////////////////////////////
+void Connection::DropQueued(const unsigned int _tag, const unsigned int _keep,
+    std::vector<std::pair<boost::function<void(uint32_t)>, uint32_t> >
+    &_dropped)
+{
+  // Skip the batch that is being written
+  auto batchIter = this->writeQueue.begin();
+  auto cbIter = this->callbacks.begin();
+  if (this->writeCount > 0 && batchIter != this->writeQueue.end())
+  {
+    ++batchIter;
+    ++cbIter;
+  }
+
+  unsigned int count = 0;
+  for (auto iter = batchIter; iter != this->writeQueue.end(); ++iter)
+    count += std::count(iter->tags.begin(), iter->tags.end(), _tag);
+
+  if (count <= _keep)
+    return;
+
+  // Drop the oldest messages first
+  unsigned int drop = count - _keep;
+  while (batchIter != this->writeQueue.end() && drop > 0)
+  {
+    for (std::size_t i = 0; i < batchIter->tags.size() && drop > 0;)
+    {
+      if (batchIter->tags[i] != _tag)
+      {
+        ++i;
+        continue;
+      }
+
+      batchIter->headers.erase(i * HEADER_LENGTH, HEADER_LENGTH);
+      batchIter->size -= HEADER_LENGTH + batchIter->payloads[i]->size();
+      batchIter->payloads.erase(batchIter->payloads.begin() + i);
+      batchIter->tags.erase(batchIter->tags.begin() + i);
+      _dropped.push_back((*cbIter)[i]);
+      cbIter->erase(cbIter->begin() + i);
+      --drop;
+    }
+
+    if (batchIter->payloads.empty())
+    {
+      batchIter = this->writeQueue.erase(batchIter);
+      cbIter = this->callbacks.erase(cbIter);
+    }
+    else
+    {
+      ++batchIter;
+      ++cbIter;
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void Connection::StampWrite(WriteBatch &_batch)
+{
+  for (std::size_t i = 0; i < _batch.payloads.size(); ++i)
+  {
+    if (_batch.tags[i] == kUntagged)
+      continue;
+
+    MessageBufferPtr stamped = Stamped(_batch.payloads[i],
+        msgs::TraceStamp::SOCKET_WRITE);
+    _batch.size += stamped->size() - _batch.payloads[i]->size();
+    WriteHeader(&_batch.headers[i * HEADER_LENGTH],
+        static_cast<uint32_t>(stamped->size()));
+    _batch.payloads[i] = stamped;
+  }
+}
+
+//////////////////////////////////////////////////
+std::vector<boost::asio::const_buffer> Connection::WriteBuffers(
+    const WriteBatch &_batch)
+{
+  std::vector<boost::asio::const_buffer> buffers;
+  buffers.reserve(_batch.payloads.size() * 2);
+  for (std::size_t i = 0; i < _batch.payloads.size(); ++i)
+  {
+    buffers.push_back(boost::asio::buffer(
+          _batch.headers.data() + i * HEADER_LENGTH, HEADER_LENGTH));
+    buffers.push_back(boost::asio::buffer(*_batch.payloads[i]));
+  }
+  return buffers;
+}
+
+//////////////////////////////////////////////////
+std::vector<IOThreadStats> Connection::IOStats()
+{
+  if (!iomanager)
+    return std::vector<IOThreadStats>();
+  return iomanager->ThreadStats();
+}
+
 //////////////////////////////////////////////////
 std::string Connection::GetLocalURI() const
 {
@@ -426,6 +665,34 @@ void Connection::OnWrite(const boost::system::error_code &_e)
     // It will reach this point if the remote connection disconnects.
     this->Shutdown();
   }
+  else if (Settings().flushOnWrite)
+  {
+    this->ProcessWriteQueue();
+  }
+}
+
+//////////////////////////////////////////////////
+void Connection::SetWriteBatchSize(const std::size_t _bytes)
+{
+  Settings().batchBytes = _bytes;
+}
+
+//////////////////////////////////////////////////
+std::size_t Connection::WriteBatchSize()
+{
+  return Settings().batchBytes;
+}
+
+//////////////////////////////////////////////////
+void Connection::SetFlushOnWrite(const bool _flush)
+{
+  Settings().flushOnWrite = _flush;
+}
+
+//////////////////////////////////////////////////
+bool Connection::FlushOnWrite()
+{
+  return Settings().flushOnWrite;
 }
 
 //////////////////////////////////////////////////
@@ -630,13 +897,21 @@ unsigned int Connection::GetRemotePort() const
 //////////////////////////////////////////////////
 std::size_t Connection::ParseHeader(const std::string &header)
 {
+  // Same as reading with std::hex, without building a stream for every
+  // message. Parsing stops at the first character that is not a digit.
   std::size_t data_size = 0;
-  std::istringstream is(header);
-
-  if (!(is >> std::hex >> data_size))
+  for (const char c : header)
   {
-    // Header doesn't seem to be valid. Inform the caller
-    boost::system::error_code error(boost::asio::error::invalid_argument);
+    int digit;
+    if (c >= '0' && c <= '9')
+      digit = c - '0';
+    else if (c >= 'a' && c <= 'f')
+      digit = c - 'a' + 10;
+    else if (c >= 'A' && c <= 'F')
+      digit = c - 'A' + 10;
+    else
+      break;
+    data_size = (data_size << 4) | digit;
   }
 
   return data_size;
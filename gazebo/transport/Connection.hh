@@ -44,6 +44,7 @@
 #include <iostream>
 #include <iomanip>
 #include <deque>
+#include <list>
 #include <utility>
 
 #include "gazebo/common/Event.hh"
@@ -53,6 +54,8 @@
 #if TBB_VERSION_MAJOR >= 2021
 #include "gazebo/transport/TaskGroup.hh"
 #endif
+#include "gazebo/transport/IOManager.hh"
+#include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/util/system.hh"
 
 #define HEADER_LENGTH 8
@@ -63,7 +66,6 @@ namespace gazebo
   {
     extern GZ_TRANSPORT_VISIBLE bool is_stopped();
 
-    class IOManager;
     class Connection;
     typedef boost::shared_ptr<Connection> ConnectionPtr;
 
@@ -120,6 +122,10 @@ namespace gazebo
     /// IP lookup.
     ///   - GAZEBO_HOSTNAME: Hostame to export. Setting this will override
     /// both GAZEBO_IP and the default IP lookup.
+    ///   - GAZEBO_TRANSPORT_BATCH_BYTES: Maximum number of bytes of queued
+    /// messages sent in a single write, see SetWriteBatchSize.
+    ///   - GAZEBO_TRANSPORT_FLUSH: Set to "immediate" to send the next
+    /// batch as soon as a write completes, see SetFlushOnWrite.
     ///
     /// \class Connection Connection.hh transport/transport.hh
     /// \brief Single TCP/IP connection manager
@@ -193,6 +199,35 @@ namespace gazebo
       /// to the socket, otherwise just enqueue the data for asynchronous write
       public: void EnqueueMsg(const std::string &_buffer, bool _force = false);
 
+      /// \brief Write shared data to the socket. The buffer is kept by
+      /// reference until it has been written, so the same buffer can be
+      /// enqueued on many connections without copying it.
+      /// \param[in] _buffer Data to write
+      /// \param[in] _cb If non-null, callback to be invoked after
+      /// transmission is complete.
+      /// \param[in] _id ID associated with the message data.
+      /// \param[in] _force If true, block until the data has been written
+      /// to the socket, otherwise just enqueue the data for asynchronous write
+      public: void EnqueueMsg(const MessageBufferPtr &_buffer,
+                  boost::function<void(uint32_t)> _cb, uint32_t _id,
+                  bool _force = false);
+
+      /// \brief Write shared data to the socket, keeping a bounded number
+      /// of queued messages per tag. When the limit is reached, the oldest
+      /// queued messages with the same tag are dropped, and their
+      /// callbacks are invoked as if they had been sent.
+      /// \param[in] _buffer Data to write
+      /// \param[in] _cb If non-null, callback to be invoked after
+      /// transmission is complete.
+      /// \param[in] _id ID associated with the message data.
+      /// \param[in] _tag Identifies the messages sharing the limit, such
+      /// as the messages to one subscriber.
+      /// \param[in] _queueSize Maximum number of queued messages with the
+      /// tag, including this one. Zero means no limit.
+      public: void EnqueueMsg(const MessageBufferPtr &_buffer,
+                  boost::function<void(uint32_t)> _cb, uint32_t _id,
+                  const unsigned int _tag, const unsigned int _queueSize);
+
       /// \brief Get the local URI
       /// \return The local URI
       public: std::string GetLocalURI() const;
@@ -225,6 +260,33 @@ namespace gazebo
       /// \return The local hostname
       public: static std::string GetLocalHostname();
 
+      /// \brief Set the maximum size of the batches of queued messages
+      /// sent in a single write. Small messages queued while a write is in
+      /// flight are gathered until the batch reaches this size. Defaults
+      /// to 64 KiB.
+      /// \param[in] _bytes Size in bytes, at least one message is always
+      /// sent per batch.
+      public: static void SetWriteBatchSize(const std::size_t _bytes);
+
+      /// \brief Get the maximum size of a write batch.
+      /// \return Size in bytes.
+      public: static std::size_t WriteBatchSize();
+
+      /// \brief Set when queued batches are sent. By default a batch is
+      /// sent on the next ConnectionManager update. Flushing on write sends
+      /// the next batch from the completion of the previous write, which
+      /// lowers latency on busy connections.
+      /// \param[in] _flush True to flush on write completion.
+      public: static void SetFlushOnWrite(const bool _flush);
+
+      /// \brief Get whether batches are sent as soon as a write completes.
+      /// \return True if flushing on write completion.
+      public: static bool FlushOnWrite();
+
+      /// \brief Get the load of the threads that serve all connections.
+      /// \return One entry per IO thread, empty if there is no connection.
+      public: static std::vector<IOThreadStats> IOStats();
+
       /// \brief Peform an asyncronous read
       /// param[in] _handler Callback to invoke on received data
       public: template<typename Handler>
@@ -243,9 +305,10 @@ namespace gazebo
                 this->inboundHeader.resize(HEADER_LENGTH);
                 boost::asio::async_read(*this->socket,
                     boost::asio::buffer(this->inboundHeader),
-                    common::weakBind(f, this->shared_from_this(),
+                    this->strand->wrap(iomanager->Timed(
+                        common::weakBind(f, this->shared_from_this(),
                                 boost::asio::placeholders::error,
-                                boost::make_tuple(_handler)));
+                                boost::make_tuple(_handler)))));
               }
 
       /// \brief Handle a completed read of a message header.
@@ -284,9 +347,10 @@ namespace gazebo
 
                     boost::asio::async_read(*this->socket,
                         boost::asio::buffer(this->inboundData),
-                        common::weakBind(f, this->shared_from_this(),
+                        this->strand->wrap(iomanager->Timed(
+                            common::weakBind(f, this->shared_from_this(),
                                     boost::asio::placeholders::error,
-                                    _handler));
+                                    _handler))));
                   }
                   else
                   {
@@ -414,11 +478,69 @@ namespace gazebo
       /// \brief Socket pointer
       private: boost::asio::ip::tcp::socket *socket;
 
+      /// \brief Serializes the completion handlers of this connection
+      /// when the IO service runs on several threads.
+      private: boost::asio::io_service::strand *strand;
+
       /// \brief Accepts new connections.
       private: boost::asio::ip::tcp::acceptor *acceptor;
 
-      /// \brief Outgoing data queue
-      private: std::deque<std::string> writeQueue;
+      /// \brief Messages sent in a single gather write.
+      private: struct WriteBatch
+               {
+                 /// \brief Header of each message, HEADER_LENGTH
+                 /// characters each.
+                 std::string headers;
+
+                 /// \brief Data of each message.
+                 std::vector<MessageBufferPtr> payloads;
+
+                 /// \brief Tag of each message, see EnqueueMsg.
+                 std::vector<unsigned int> tags;
+
+                 /// \brief Total size of the headers and data.
+                 std::size_t size = 0;
+               };
+
+      /// \brief Add a message to the write queue.
+      /// \param[in] _buffer Data to write
+      /// \param[in] _cb Callback invoked after transmission.
+      /// \param[in] _id ID associated with the message data.
+      /// \param[in] _tag Tag of the message.
+      /// \param[in] _queueSize Maximum number of queued messages with the
+      /// tag, zero for no limit.
+      /// \param[in] _force True to write the queue right away.
+      private: void Enqueue(const MessageBufferPtr &_buffer,
+                   boost::function<void(uint32_t)> _cb, uint32_t _id,
+                   const unsigned int _tag, const unsigned int _queueSize,
+                   bool _force);
+
+      /// \brief Remove the oldest queued messages with a tag, leaving at
+      /// most a number of them. The batch being written is not changed.
+      /// Must be called with writeMutex locked.
+      /// \param[in] _tag Tag of the messages.
+      /// \param[in] _keep Number of messages to keep.
+      /// \param[out] _dropped Callbacks of the removed messages.
+      private: void DropQueued(const unsigned int _tag,
+                   const unsigned int _keep,
+                   std::vector<std::pair<boost::function<void(uint32_t)>,
+                   uint32_t> > &_dropped);
+
+      /// \brief Get the buffers to write for a batch, alternating between
+      /// the header and the data of each message.
+      /// \param[in] _batch Batch to write.
+      /// \return Buffer sequence referencing the batch.
+      private: static std::vector<boost::asio::const_buffer> WriteBuffers(
+                   const WriteBatch &_batch);
+
+      /// \brief Append a socket write trace stamp to the topic data of a
+      /// batch, see TraceStamps.
+      /// \param[in,out] _batch Batch about to be written.
+      private: static void StampWrite(WriteBatch &_batch);
+
+      /// \brief Outgoing data queue. A list, so that batches can be
+      /// dropped without moving the one being written.
+      private: std::list<WriteBatch> writeQueue;
 
       /// \brief List of callbacks, paired with writeQueue. The callbacks
       /// are used to notify a publisher when a message is successfully sent.
@@ -14,11 +14,16 @@
  * limitations under the License.
  *
 */
+#include <cstdlib>
+#include <fstream>
 #include <boost/bind/bind.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/lexical_cast.hpp>
 
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Events.hh"
+#include "gazebo/common/SamplingProfiler.hh"
 #include "gazebo/transport/TopicManager.hh"
 #include "gazebo/transport/ConnectionManager.hh"
 
@@ -71,6 +76,7 @@ class TopicManagerConnectionTask
 ConnectionManager::ConnectionManager()
 {
   this->tmpIndex = 0;
+  this->tableVersion = 0;
   this->initialized = false;
   this->stop = false;
   this->stopped = true;
@@ -130,13 +136,11 @@ bool ConnectionManager::Init(const std::string &_masterHost,
     return false;
   }
 
-  std::string initData, namespacesData, publishersData;
+  std::string initData;
 
   try
   {
     this->masterConn->Read(initData);
-    this->masterConn->Read(namespacesData);
-    this->masterConn->Read(publishersData);
   }
   catch(...)
   {
@@ -166,37 +170,23 @@ bool ConnectionManager::Init(const std::string &_masterHost,
   else
     gzerr << "Didn't receive an init from the master" << std::endl;
 
-  packet.ParseFromString(namespacesData);
-  if (packet.type() == "topic_namepaces_init")
+  // The topic table is cached per master in the user's gazebo directory,
+  // unless GAZEBO_TOPIC_CACHE names another file or is empty.
+  const char *cacheEnv = std::getenv("GAZEBO_TOPIC_CACHE");
+  const char *homeEnv = std::getenv("HOME");
+  if (cacheEnv)
+    this->topicCachePath = cacheEnv;
+  else if (homeEnv)
   {
-    msgs::GzString_V result;
-    result.ParseFromString(packet.serialized_data());
-    boost::mutex::scoped_lock lock(this->namespaceMutex);
-
-    for (int i = 0; i < result.data_size(); i++)
-    {
-      this->namespaces.push_back(std::string(result.data(i)));
-    }
-    this->namespaceCondition.notify_all();
+    this->topicCachePath = (boost::filesystem::path(homeEnv) / ".gazebo" /
+        ("topics-" + _masterHost + "-" +
+         boost::lexical_cast<std::string>(_masterPort))).string();
   }
   else
-    gzerr << "Did not get topic_namespaces_init msg from master" << std::endl;
-
-  packet.ParseFromString(publishersData);
-  if (packet.type() == "publishers_init")
-  {
-    msgs::Publishers pubs;
-    pubs.ParseFromString(packet.serialized_data());
+    this->topicCachePath.clear();
 
-    boost::recursive_mutex::scoped_lock lock(this->listMutex);
-    for (int i = 0; i < pubs.publisher_size(); i++)
-    {
-      const msgs::Publish &p = pubs.publisher(i);
-      this->publishers.push_back(p);
-    }
-  }
-  else
-    gzerr << "Did not get publishers_init msg from master" << std::endl;
+  if (!this->SyncTopicTable())
+    return false;
 
   this->masterConn->AsyncRead(
       boost::bind(&ConnectionManager::OnMasterRead, this, _1));
@@ -246,9 +236,13 @@ void ConnectionManager::Fini()
     boost::recursive_mutex::scoped_lock lock(this->connectionMutex);
     this->connections.clear();
   }
+  this->SaveTopicCache();
+
   this->publishers.clear();
   this->namespaces.clear();
   this->masterMessages.clear();
+  this->tableEpoch.clear();
+  this->tableVersion = 0;
 
   this->initialized = false;
 }
@@ -307,6 +301,7 @@ void ConnectionManager::RunUpdate()
 //////////////////////////////////////////////////
 void ConnectionManager::Run()
 {
+  common::SetThreadName("ConnectionManager");
   boost::mutex::scoped_lock lock(this->updateMutex);
 
   this->stopped = false;
@@ -356,27 +351,15 @@ void ConnectionManager::ProcessMessage(const std::string &_data)
   msgs::Packet packet;
   packet.ParseFromString(_data);
 
-  if (packet.type() == "publisher_add")
-  {
-    msgs::Publish result;
-    result.ParseFromString(packet.serialized_data());
-    this->publishers.push_back(result);
-  }
-  else if (packet.type() == "publisher_del")
+  if (packet.type() == "publisher_add" || packet.type() == "publisher_del")
   {
     msgs::Publish result;
     result.ParseFromString(packet.serialized_data());
 
-    std::list<msgs::Publish>::iterator iter = this->publishers.begin();
-    while (iter != this->publishers.end())
-    {
-      if ((*iter).topic() == result.topic() &&
-          (*iter).host() == result.host() &&
-          (*iter).port() == result.port())
-        iter = this->publishers.erase(iter);
-      else
-        ++iter;
-    }
+    boost::recursive_mutex::scoped_lock lock(this->listMutex);
+    this->ApplyPublisherChange(result, packet.type() == "publisher_add");
+    if (result.has_version() && result.version() > this->tableVersion)
+      this->tableVersion = result.version();
   }
   else if (packet.type() == "topic_namespace_add")
   {
@@ -495,6 +478,13 @@ void ConnectionManager::OnRead(ConnectionPtr _connection,
     // via the connection
     SubscriptionTransportPtr subLink(new SubscriptionTransport());
     subLink->Init(_connection, sub.latching());
+    if (sub.has_shm_name())
+      subLink->OpenRing(sub.shm_name());
+
+    SubscriptionQoS qos;
+    qos.queueSize = sub.queue_size();
+    qos.maxRate = sub.max_rate();
+    subLink->SetQoS(qos);
 
     // Connect the publisher to this transport mechanism
     TopicManager::Instance()->ConnectPubToSub(sub.topic(), subLink);
@@ -615,26 +605,178 @@ void ConnectionManager::Subscribe(const std::string &_topic,
     return;
   }
 
-  // TODO:
-  // Find a current connection on the topic
-  // ConnectionPtr conn = this->FindConnection(topic);
+  msgs::Subscribe msg;
+  msg.set_topic(_topic);
+  msg.set_msg_type(_msgType);
+  msg.set_host(this->serverConn->GetLocalAddress());
+  msg.set_port(this->serverConn->GetLocalPort());
+  msg.set_latching(_latching);
 
-  // If the connection to a remote publisher does not exist, then we need
-  // to establish a connection.
-  // if (!conn)
+  // Connect to the publishers we already know about without waiting for
+  // the master. The master only reports the ones newer than our table.
+  std::list<std::string> known;
   {
-    msgs::Subscribe msg;
-    msg.set_topic(_topic);
-    msg.set_msg_type(_msgType);
-    msg.set_host(this->serverConn->GetLocalAddress());
-    msg.set_port(this->serverConn->GetLocalPort());
-    msg.set_latching(_latching);
+    boost::recursive_mutex::scoped_lock lock(this->listMutex);
+    msg.set_table_version(this->tableVersion);
+    for (auto const &pub : this->publishers)
+    {
+      if (pub.topic() == _topic)
+        known.push_back(msgs::Package("publisher_subscribe", pub));
+    }
+  }
 
-    // Inform the master that we want to subscribe to a topic.
-    // This will result in Connection::OnMasterRead getting called with a
-    // packet type of "publisher_update"
-    this->masterConn->EnqueueMsg(msgs::Package("subscribe", msg));
+  if (!known.empty())
+  {
+    {
+      boost::recursive_mutex::scoped_lock lock(this->masterMessagesMutex);
+      this->masterMessages.splice(this->masterMessages.end(), known);
+    }
+    this->TriggerUpdate();
   }
+
+  // Inform the master that we want to subscribe to a topic.
+  // This will result in Connection::OnMasterRead getting called with a
+  // packet type of "publisher_subscribe"
+  this->masterConn->EnqueueMsg(msgs::Package("subscribe", msg));
+}
+
+//////////////////////////////////////////////////
+bool ConnectionManager::SyncTopicTable()
+{
+  msgs::TopicTable cached;
+  this->LoadTopicCache(cached);
+
+  msgs::TopicTable request;
+  request.set_epoch(cached.epoch());
+  request.set_version(cached.version());
+
+  std::string tableData;
+  try
+  {
+    this->masterConn->EnqueueMsg(
+        msgs::Package("topic_table_sync", request), true);
+    this->masterConn->Read(tableData);
+  }
+  catch(...)
+  {
+    gzerr << "Unable to read the topic table from master" << std::endl;
+    return false;
+  }
+
+  msgs::Packet packet;
+  packet.ParseFromString(tableData);
+  if (packet.type() != "topic_table")
+  {
+    gzerr << "Did not get topic_table msg from master" << std::endl;
+    return false;
+  }
+
+  msgs::TopicTable table;
+  table.ParseFromString(packet.serialized_data());
+
+  {
+    boost::recursive_mutex::scoped_lock lock(this->listMutex);
+    this->publishers.clear();
+
+    // A delta applies on top of the cached table
+    if (!table.full())
+    {
+      for (int i = 0; i < cached.publisher_size(); ++i)
+        this->publishers.push_back(cached.publisher(i));
+      for (int i = 0; i < table.removed_size(); ++i)
+        this->ApplyPublisherChange(table.removed(i), false);
+    }
+
+    for (int i = 0; i < table.publisher_size(); ++i)
+      this->ApplyPublisherChange(table.publisher(i), true);
+
+    this->tableEpoch = table.epoch();
+    this->tableVersion = table.version();
+  }
+
+  {
+    boost::mutex::scoped_lock lock(this->namespaceMutex);
+    this->namespaces.clear();
+    for (int i = 0; i < table.topic_namespace_size(); ++i)
+      this->namespaces.push_back(table.topic_namespace(i));
+    this->namespaceCondition.notify_all();
+  }
+
+  this->SaveTopicCache();
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+void ConnectionManager::ApplyPublisherChange(const msgs::Publish &_pub,
+                                             bool _added)
+{
+  std::list<msgs::Publish>::iterator iter = this->publishers.begin();
+  while (iter != this->publishers.end())
+  {
+    if ((*iter).topic() == _pub.topic() &&
+        (*iter).host() == _pub.host() &&
+        (*iter).port() == _pub.port())
+      iter = this->publishers.erase(iter);
+    else
+      ++iter;
+  }
+
+  if (_added)
+    this->publishers.push_back(_pub);
+}
+
+//////////////////////////////////////////////////
+void ConnectionManager::LoadTopicCache(msgs::TopicTable &_table) const
+{
+  _table.Clear();
+  if (this->topicCachePath.empty())
+    return;
+
+  std::ifstream in(this->topicCachePath.c_str(), std::ios::binary);
+  if (!in || !_table.ParseFromIstream(&in))
+    _table.Clear();
+}
+
+//////////////////////////////////////////////////
+void ConnectionManager::SaveTopicCache()
+{
+  if (this->topicCachePath.empty() || this->tableEpoch.empty())
+    return;
+
+  msgs::TopicTable table;
+  {
+    boost::recursive_mutex::scoped_lock lock(this->listMutex);
+    table.set_epoch(this->tableEpoch);
+    table.set_version(this->tableVersion);
+    table.set_full(true);
+    for (auto const &pub : this->publishers)
+      table.add_publisher()->CopyFrom(pub);
+  }
+
+  // Write to a private file and rename it, so that other processes never
+  // read a partial table.
+  boost::filesystem::path path(this->topicCachePath);
+  boost::filesystem::path tmpPath(this->topicCachePath + "." +
+      boost::filesystem::unique_path().string());
+
+  boost::system::error_code ec;
+  if (path.has_parent_path())
+    boost::filesystem::create_directories(path.parent_path(), ec);
+
+  {
+    std::ofstream out(tmpPath.string().c_str(),
+        std::ios::binary | std::ios::trunc);
+    if (!out || !table.SerializeToOstream(&out))
+    {
+      gzlog << "Unable to write topic cache[" << tmpPath.string() << "]\n";
+      return;
+    }
+  }
+
+  boost::filesystem::rename(tmpPath, path, ec);
+  if (ec)
+    boost::filesystem::remove(tmpPath, ec);
 }
 
 //////////////////////////////////////////////////
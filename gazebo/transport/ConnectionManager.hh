@@ -167,6 +167,27 @@ namespace gazebo
       /// \brief Run the manager update loop once
       private: void RunUpdate();
 
+      /// \brief Request the master's topic table. Only the changes since
+      /// the locally cached table are transferred when possible.
+      /// \return True if the topic table was received.
+      private: bool SyncTopicTable();
+
+      /// \brief Apply a publisher change to the topic table. The caller
+      /// must hold listMutex.
+      /// \param[in] _pub The publisher.
+      /// \param[in] _added True if the publisher was added, false if it
+      /// was removed.
+      private: void ApplyPublisherChange(const msgs::Publish &_pub,
+                                         bool _added);
+
+      /// \brief Load the topic table cached by local processes.
+      /// \param[out] _table The cached table. Left empty if there is no
+      /// usable cache.
+      private: void LoadTopicCache(msgs::TopicTable &_table) const;
+
+      /// \brief Save the topic table for other local processes.
+      private: void SaveTopicCache();
+
       /// \brief Condition used to trigger an update.
       private: boost::condition_variable updateCondition;
 
@@ -197,6 +218,16 @@ namespace gazebo
       /// \brief Condition used for synchronization
       private: boost::condition_variable namespaceCondition;
 
+      /// \brief Epoch of the master the topic table came from.
+      private: std::string tableEpoch;
+
+      /// \brief Version of the topic table, protected by listMutex.
+      private: uint64_t tableVersion;
+
+      /// \brief File where the topic table is cached. Empty to disable
+      /// caching.
+      private: std::string topicCachePath;
+
 #if TBB_VERSION_MAJOR >= 2021
       /// \brief For managing asynchronous tasks with tbb
       private: TaskGroup taskGroup;
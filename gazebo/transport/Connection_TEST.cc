@@ -64,6 +64,24 @@ TEST_F(Connection, IPWhiteList)
     setenv("GAZEBO_IP_WHITE_LIST", ipEnv, 1);
 }
 
+/////////////////////////////////////////////////
+TEST_F(Connection, WriteSettings)
+{
+  const std::size_t batchSize = transport::Connection::WriteBatchSize();
+  const bool flush = transport::Connection::FlushOnWrite();
+  EXPECT_GT(batchSize, 0u);
+
+  transport::Connection::SetWriteBatchSize(1024);
+  EXPECT_EQ(transport::Connection::WriteBatchSize(), 1024u);
+
+  transport::Connection::SetFlushOnWrite(!flush);
+  EXPECT_EQ(transport::Connection::FlushOnWrite(), !flush);
+
+  // Restore values
+  transport::Connection::SetWriteBatchSize(batchSize);
+  transport::Connection::SetFlushOnWrite(flush);
+}
+
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -14,16 +14,38 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
 #include <atomic>
-#include <boost/bind/bind.hpp>
+#include <cstdlib>
 #include <boost/thread/thread.hpp>
 #include <iostream>
+#include <memory>
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/SamplingProfiler.hh"
 #include "gazebo/transport/IOManager.hh"
 
 namespace gazebo
 {
 namespace transport
 {
+/// \brief Index of the calling thread in the IOManager thread pool, -1
+/// for other threads.
+static thread_local int ioThreadIndex = -1;
+
+/// \brief Upper bound for GAZEBO_IO_THREADS.
+static const unsigned int kMaxIOThreads = 64;
+
+/////////////////////////////////////////////////
+/// \brief Load counters of one thread.
+struct IOThreadCounters
+{
+  /// \brief Number of handlers run.
+  std::atomic<uint64_t> handlerCount{0};
+
+  /// \brief Time spent in handlers, in nanoseconds.
+  std::atomic<uint64_t> busyNs{0};
+};
+
 /////////////////////////////////////////////////
 class IOManagerPrivate
 {
@@ -36,8 +58,14 @@ class IOManagerPrivate
   /// \brief Reference count of connections using this IOManager.
   public: std::atomic_int count;
 
-  /// \brief Thread for IOManager.
-  public: boost::thread *thread = nullptr;
+  /// \brief Threads running the io_service.
+  public: std::vector<boost::thread *> threads;
+
+  /// \brief Load of each thread, same order as threads.
+  public: std::unique_ptr<IOThreadCounters[]> counters;
+
+  /// \brief Number of threads, kept after the threads are stopped.
+  public: unsigned int threadCount = 1;
 };
 
 /////////////////////////////////////////////////
@@ -48,8 +76,34 @@ IOManager::IOManager()
   this->dataPtr->work = new boost::asio::io_service::work(
       *this->dataPtr->io_service);
   this->dataPtr->count = 0;
-  this->dataPtr->thread = new boost::thread(boost::bind(
-      &boost::asio::io_service::run, this->dataPtr->io_service));
+
+  const char *env = std::getenv("GAZEBO_IO_THREADS");
+  if (env)
+  {
+    const int count = std::atoi(env);
+    if (count < 1)
+    {
+      gzwarn << "Invalid GAZEBO_IO_THREADS[" << env << "], using 1\n";
+    }
+    else
+    {
+      this->dataPtr->threadCount =
+          std::min(static_cast<unsigned int>(count), kMaxIOThreads);
+    }
+  }
+
+  this->dataPtr->counters.reset(
+      new IOThreadCounters[this->dataPtr->threadCount]);
+  for (unsigned int i = 0; i < this->dataPtr->threadCount; ++i)
+  {
+    boost::asio::io_service *io = this->dataPtr->io_service;
+    this->dataPtr->threads.push_back(new boost::thread([io, i]()
+    {
+      common::SetThreadName("IOManager" + std::to_string(i));
+      ioThreadIndex = static_cast<int>(i);
+      io->run();
+    }));
+  }
 }
 
 /////////////////////////////////////////////////
@@ -72,12 +126,46 @@ void IOManager::Stop()
 {
   this->dataPtr->io_service->reset();
   this->dataPtr->io_service->stop();
-  if (this->dataPtr->thread)
+  for (auto &thread : this->dataPtr->threads)
+  {
+    thread->join();
+    delete thread;
+  }
+  this->dataPtr->threads.clear();
+}
+
+/////////////////////////////////////////////////
+unsigned int IOManager::ThreadCount() const
+{
+  return this->dataPtr->threadCount;
+}
+
+/////////////////////////////////////////////////
+std::vector<IOThreadStats> IOManager::ThreadStats() const
+{
+  std::vector<IOThreadStats> stats(this->dataPtr->threadCount);
+  for (unsigned int i = 0; i < this->dataPtr->threadCount; ++i)
+  {
+    stats[i].handlerCount = this->dataPtr->counters[i].handlerCount;
+    stats[i].busyTime = this->dataPtr->counters[i].busyNs * 1e-9;
+  }
+  return stats;
+}
+
+/////////////////////////////////////////////////
+void IOManager::RecordHandler(
+    const std::chrono::steady_clock::duration &_duration)
+{
+  if (ioThreadIndex < 0 ||
+      ioThreadIndex >= static_cast<int>(this->dataPtr->threadCount))
   {
-    this->dataPtr->thread->join();
-    delete this->dataPtr->thread;
-    this->dataPtr->thread = nullptr;
+    return;
   }
+
+  IOThreadCounters &counters = this->dataPtr->counters[ioThreadIndex];
+  counters.handlerCount++;
+  counters.busyNs += std::chrono::duration_cast<std::chrono::nanoseconds>(
+      _duration).count();
 }
 
 /////////////////////////////////////////////////
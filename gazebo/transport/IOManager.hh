@@ -17,6 +17,10 @@
 #ifndef GAZEBO_TRANSPORT_IOMANAGER_HH_
 #define GAZEBO_TRANSPORT_IOMANAGER_HH_
 
+#include <chrono>
+#include <cstdint>
+#include <utility>
+#include <vector>
 #include <boost/asio.hpp>
 #include "gazebo/util/system.hh"
 
@@ -27,11 +31,29 @@ namespace gazebo
     // Forward declare private class.
     class IOManagerPrivate;
 
+    template<typename Handler> class IOTimedHandler;
+
     /// \addtogroup gazebo_transport
     /// \{
 
+    /// \brief Load of one I/O thread.
+    struct IOThreadStats
+    {
+      /// \brief Number of handlers run by the thread.
+      uint64_t handlerCount = 0;
+
+      /// \brief Time spent running handlers, in seconds.
+      double busyTime = 0;
+    };
+
     /// \class IOManager IOManager.hh transport/transport.hh
     /// \brief Manages boost::asio IO
+    ///
+    /// \remarks
+    ///  Environment Variables:
+    ///   - GAZEBO_IO_THREADS: Number of threads running the io_service,
+    /// defaults to 1. Each connection serializes its own handlers through
+    /// a strand, so different connections are served in parallel.
     class GZ_TRANSPORT_VISIBLE IOManager
     {
       /// \brief Constructor
@@ -57,10 +79,65 @@ namespace gazebo
       /// \brief Stop the IO service
       public: void Stop();
 
+      /// \brief Get the number of threads running the IO service.
+      /// \return Number of threads.
+      public: unsigned int ThreadCount() const;
+
+      /// \brief Get the load of each thread since it started.
+      /// \return One entry per thread.
+      public: std::vector<IOThreadStats> ThreadStats() const;
+
+      /// \brief Wrap a completion handler, so that the time spent running
+      /// it is added to the load of the thread that runs it.
+      /// \param[in] _handler Handler to wrap.
+      /// \return Wrapped handler.
+      public: template<typename Handler>
+              IOTimedHandler<Handler> Timed(const Handler &_handler)
+              {
+                return IOTimedHandler<Handler>(this, _handler);
+              }
+
+      /// \brief Add a handler run to the load of the calling thread. Does
+      /// nothing if the caller is not one of the IO threads.
+      /// \param[in] _duration Time spent in the handler.
+      public: void RecordHandler(
+                  const std::chrono::steady_clock::duration &_duration);
+
       /// \internal
       /// \brief Pointer to private data.
       private: IOManagerPrivate *dataPtr;
     };
+
+    /// \brief Completion handler that records its run time with an
+    /// IOManager, see IOManager::Timed.
+    template<typename Handler>
+    class IOTimedHandler
+    {
+      /// \brief Constructor
+      /// \param[in] _manager Manager the time is recorded with.
+      /// \param[in] _handler Handler to run.
+      public: IOTimedHandler(IOManager *_manager, const Handler &_handler)
+              : manager(_manager), handler(_handler)
+              {
+              }
+
+      /// \brief Run the handler.
+      /// \param[in] _args Arguments passed on to the handler.
+      public: template<typename... Args>
+              void operator()(Args &&... _args)
+              {
+                const auto start = std::chrono::steady_clock::now();
+                this->handler(std::forward<Args>(_args)...);
+                this->manager->RecordHandler(
+                    std::chrono::steady_clock::now() - start);
+              }
+
+      /// \brief Manager the time is recorded with.
+      private: IOManager *manager;
+
+      /// \brief Wrapped handler.
+      private: Handler handler;
+    };
     /// \}
   }
 }
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <stdlib.h>
+#include <thread>
+
+#include "gazebo/transport/IOManager.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class IOManager : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(IOManager, ThreadPool)
+{
+  setenv("GAZEBO_IO_THREADS", "4", 1);
+  transport::IOManager manager;
+  unsetenv("GAZEBO_IO_THREADS");
+  EXPECT_EQ(manager.ThreadCount(), 4u);
+
+  std::atomic<int> done(0);
+  const int count = 100;
+  for (int i = 0; i < count; ++i)
+  {
+    manager.GetIO().post(manager.Timed([&done]()
+    {
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+      done++;
+    }));
+  }
+
+  for (int i = 0; i < 500 && done < count; ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_EQ(done, count);
+
+  auto stats = manager.ThreadStats();
+  ASSERT_EQ(stats.size(), 4u);
+
+  uint64_t handlers = 0;
+  double busy = 0;
+  for (auto const &thread : stats)
+  {
+    handlers += thread.handlerCount;
+    busy += thread.busyTime;
+  }
+  EXPECT_EQ(handlers, static_cast<uint64_t>(count));
+  EXPECT_GT(busy, count * 100e-6 * 0.5);
+
+  // Handlers run outside the pool are not counted
+  manager.Timed([]() {})();
+  stats = manager.ThreadStats();
+  handlers = 0;
+  for (auto const &thread : stats)
+    handlers += thread.handlerCount;
+  EXPECT_EQ(handlers, static_cast<uint64_t>(count));
+}
+
+/////////////////////////////////////////////////
+TEST_F(IOManager, DefaultThreadCount)
+{
+  unsetenv("GAZEBO_IO_THREADS");
+  transport::IOManager manager;
+  EXPECT_EQ(manager.ThreadCount(), 1u);
+
+  setenv("GAZEBO_IO_THREADS", "0", 1);
+  transport::IOManager invalid;
+  unsetenv("GAZEBO_IO_THREADS");
+  EXPECT_EQ(invalid.ThreadCount(), 1u);
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
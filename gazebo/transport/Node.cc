@@ -63,10 +63,15 @@ void Node::Fini()
     this->publishers.clear();
   }
 
+  // Stop the executors without holding incomingMutex, their jobs take it
+  std::map<std::string, CallbackExecutorPtr> oldExecutors;
   {
     boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
     this->callbacks.clear();
+    oldExecutors.swap(this->executors);
   }
+  for (auto &executor : oldExecutors)
+    executor.second->Stop();
 }
 
 //////////////////////////////////////////////////
@@ -194,6 +199,21 @@ void Node::ProcessPublishers()
 /////////////////////////////////////////////////
 bool Node::HandleData(const std::string &_topic, const std::string &_msg)
 {
+  CallbackExecutorPtr executor = this->Executor(_topic);
+  if (executor)
+  {
+    boost::weak_ptr<Node> weakThis = shared_from_this();
+    std::string topic = _topic;
+    std::string msg = _msg;
+    executor->Post([weakThis, topic, msg]()
+        {
+          NodePtr node = weakThis.lock();
+          if (node)
+            node->DispatchData(topic, msg);
+        });
+    return true;
+  }
+
   boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
   this->incomingMsgs[_topic].push_back(_msg);
   ConnectionManager::Instance()->TriggerUpdate();
@@ -203,6 +223,20 @@ bool Node::HandleData(const std::string &_topic, const std::string &_msg)
 /////////////////////////////////////////////////
 bool Node::HandleMessage(const std::string &_topic, MessagePtr _msg)
 {
+  CallbackExecutorPtr executor = this->Executor(_topic);
+  if (executor)
+  {
+    boost::weak_ptr<Node> weakThis = shared_from_this();
+    std::string topic = _topic;
+    executor->Post([weakThis, topic, _msg]()
+        {
+          NodePtr node = weakThis.lock();
+          if (node)
+            node->DispatchMessage(topic, _msg);
+        });
+    return true;
+  }
+
   boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
   this->incomingMsgsLocal[_topic].push_back(_msg);
   ConnectionManager::Instance()->TriggerUpdate();
@@ -299,6 +333,42 @@ void Node::ProcessIncoming()
   }
 }
 
+/////////////////////////////////////////////////
+void Node::DispatchData(const std::string &_topic, const std::string &_msg)
+{
+  // Copy the callbacks so that other topics are not blocked while they run
+  Callback_L cbs;
+  {
+    boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
+    Callback_M::iterator cbIter = this->callbacks.find(_topic);
+    if (cbIter == this->callbacks.end())
+      return;
+    cbs = cbIter->second;
+  }
+
+  for (auto &cb : cbs)
+  {
+    using namespace boost::placeholders;
+    cb->HandleData(_msg, boost::bind(&dummy_callback_fn, _1), 0);
+  }
+}
+
+/////////////////////////////////////////////////
+void Node::DispatchMessage(const std::string &_topic, MessagePtr _msg)
+{
+  Callback_L cbs;
+  {
+    boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
+    Callback_M::iterator cbIter = this->callbacks.find(_topic);
+    if (cbIter == this->callbacks.end())
+      return;
+    cbs = cbIter->second;
+  }
+
+  for (auto &cb : cbs)
+    cb->HandleMessage(_msg);
+}
+
 //////////////////////////////////////////////////
 void Node::InsertLatchedMsg(const std::string &_topic, const std::string &_msg)
 {
@@ -362,6 +432,59 @@ bool Node::HasLatchedSubscriber(const std::string &_topic) const
   return false;
 }
 
+/////////////////////////////////////////////////
+void Node::SetQoS(const std::string &_topic, const SubscriptionQoS &_qos)
+{
+  boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
+  this->qos[this->DecodeTopicName(_topic)] = _qos;
+}
+
+/////////////////////////////////////////////////
+SubscriptionQoS Node::QoS(const std::string &_topic) const
+{
+  boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
+  auto iter = this->qos.find(_topic);
+  if (iter != this->qos.end())
+    return iter->second;
+  return SubscriptionQoS();
+}
+
+/////////////////////////////////////////////////
+void Node::SetExecutor(const std::string &_topic,
+    const SubscriptionExecutor &_executor)
+{
+  CallbackExecutorPtr oldExecutor;
+  {
+    boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
+    const std::string topic = this->DecodeTopicName(_topic);
+
+    auto iter = this->executors.find(topic);
+    if (iter != this->executors.end())
+    {
+      oldExecutor = iter->second;
+      this->executors.erase(iter);
+    }
+
+    if (_executor.kind != SubscriptionExecutor::INLINE)
+    {
+      this->executors[topic].reset(new CallbackExecutor(_executor));
+    }
+  }
+
+  if (oldExecutor)
+    oldExecutor->Stop();
+}
+
+/////////////////////////////////////////////////
+CallbackExecutorPtr Node::Executor(const std::string &_topic) const
+{
+  boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
+  auto iter = this->executors.find(_topic);
+  if (iter != this->executors.end())
+    return iter->second;
+  return CallbackExecutorPtr();
+}
+
 /////////////////////////////////////////////////
 void Node::RemoveCallback(const std::string &_topic, unsigned int _id)
 {
@@ -39,6 +39,7 @@
 #if TBB_VERSION_MAJOR >= 2021
 #include "gazebo/transport/TaskGroup.hh"
 #endif
+#include "gazebo/transport/CallbackExecutor.hh"
 #include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/transport/TopicManager.hh"
 #include "gazebo/util/system.hh"
@@ -171,6 +172,30 @@ namespace gazebo
       /// \return True if a latched subscriber exists.
       public: bool HasLatchedSubscriber(const std::string &_topic) const;
 
+      /// \brief Set the quality of service of the subscriptions of this
+      /// node to a topic. It is sent to the remote publishers when the
+      /// node connects to them, so it must be set before subscribing.
+      /// \param[in] _topic Name of the topic.
+      /// \param[in] _qos Policy to request from the publishers.
+      public: void SetQoS(const std::string &_topic,
+                          const SubscriptionQoS &_qos);
+
+      /// \brief Get the quality of service of the subscriptions of this
+      /// node to a topic.
+      /// \param[in] _topic Name of the topic, already decoded.
+      /// \return The policy, without limits if none was set.
+      public: SubscriptionQoS QoS(const std::string &_topic) const;
+
+      /// \brief Set where the callbacks of this node for a topic run.
+      /// Messages of a topic with a DEDICATED or SHARED executor are
+      /// deserialized and dispatched on that executor as soon as they
+      /// arrive, instead of waiting for ProcessIncoming. Messages still
+      /// queued when the executor is replaced are dropped.
+      /// \param[in] _topic Name of the topic.
+      /// \param[in] _executor Executor of the callbacks.
+      public: void SetExecutor(const std::string &_topic,
+                               const SubscriptionExecutor &_executor);
+
 
       /// \brief A convenience function for a one-time publication of
       /// a message. This is inefficient, compared to
@@ -420,6 +445,25 @@ namespace gazebo
       /// \param[in] _id Id of the callback.
       public: void RemoveCallback(const std::string &_topic, unsigned int _id);
 
+      /// \brief Run the callbacks of a topic on serialized data. Called
+      /// by the executor of the topic.
+      /// \param[in] _topic Name of the topic.
+      /// \param[in] _msg Serialized message.
+      private: void DispatchData(const std::string &_topic,
+                                 const std::string &_msg);
+
+      /// \brief Run the callbacks of a topic on a local message. Called
+      /// by the executor of the topic.
+      /// \param[in] _topic Name of the topic.
+      /// \param[in] _msg The message.
+      private: void DispatchMessage(const std::string &_topic,
+                                    MessagePtr _msg);
+
+      /// \brief Get the executor of a topic.
+      /// \param[in] _topic Name of the topic.
+      /// \return The executor, null if the callbacks run inline.
+      private: CallbackExecutorPtr Executor(const std::string &_topic) const;
+
       /// \internal
       /// \brief Private implementation of Init() and TryInit()
       /// \param[in] _space Namespace to initialize this Node to. Use an empty
@@ -446,6 +490,13 @@ namespace gazebo
       private: Callback_M callbacks;
       private: std::map<std::string, std::list<std::string> > incomingMsgs;
 
+      /// \brief Quality of service of each topic, see SetQoS.
+      private: std::map<std::string, SubscriptionQoS> qos;
+
+      /// \brief Executor of each topic whose callbacks do not run inline,
+      /// see SetExecutor.
+      private: std::map<std::string, CallbackExecutorPtr> executors;
+
       /// \brief List of newly arrive messages
       private: std::map<std::string, std::list<MessagePtr> > incomingMsgsLocal;
 
@@ -456,7 +507,7 @@ namespace gazebo
 
       private: boost::mutex publisherMutex;
       private: boost::mutex publisherDeleteMutex;
-      private: boost::recursive_mutex incomingMutex;
+      private: mutable boost::recursive_mutex incomingMutex;
 
       /// \brief make sure we don't call ProcessingIncoming simultaneously
       /// from separate threads.
@@ -15,6 +15,7 @@
  *
 */
 
+#include <vector>
 #include <boost/bind/bind.hpp>
 #include <boost/function.hpp>
 #include "gazebo/common/WeakBind.hh"
@@ -90,10 +91,21 @@ void Publication::AddSubscription(const CallbackHelperPtr _callback)
       for (std::map<uint32_t, MessagePtr>::iterator pubIter =
           this->prevMsgs.begin(); pubIter != this->prevMsgs.end(); ++pubIter)
       {
-        if (pubIter->second)
+        if (!pubIter->second)
+          continue;
+
+        // Remote subscribers share one serialized copy of each latched
+        // message.
+        if (_callback->IsLocal())
         {
           _callback->HandleMessage(pubIter->second);
         }
+        else
+        {
+          using namespace boost::placeholders;
+          _callback->HandleBuffer(this->PrevBuffer(pubIter->first),
+              boost::bind(&dummy_callback_fn, _1), 0);
+        }
       }
       _callback->SetLatching(false);
     }
@@ -105,6 +117,20 @@ void Publication::SetPrevMsg(uint32_t _pubId, MessagePtr _msg)
 {
   boost::mutex::scoped_lock lock(this->callbackMutex);
   this->prevMsgs[_pubId] = _msg;
+  this->prevBuffers.erase(_pubId);
+}
+
+//////////////////////////////////////////////////
+MessageBufferPtr Publication::PrevBuffer(const uint32_t _pubId)
+{
+  MessageBufferPtr &buffer = this->prevBuffers[_pubId];
+  if (!buffer)
+  {
+    boost::shared_ptr<std::string> data(new std::string());
+    this->prevMsgs[_pubId]->SerializeToString(data.get());
+    buffer = data;
+  }
+  return buffer;
 }
 
 //////////////////////////////////////////////////
@@ -112,6 +138,7 @@ void Publication::ClearPrevMsgs()
 {
   boost::mutex::scoped_lock lock(this->callbackMutex);
   this->prevMsgs.clear();
+  this->prevBuffers.clear();
 }
 
 //////////////////////////////////////////////////
@@ -321,14 +348,45 @@ int Publication::Publish(MessagePtr _msg, boost::function<void(uint32_t)> _cb,
 
     if (!this->callbacks.empty())
     {
-      std::string data;
-      _msg->SerializeToString(&data);
+      // Apply the rate limits first, so that the message is not
+      // serialized when every subscriber skips it.
+      std::vector<bool> throttled;
+      bool send = false;
+      for (auto &callback : this->callbacks)
+      {
+        throttled.push_back(callback->Throttled());
+        send = send || !throttled.back();
+      }
+
+      // Serialize once, and share the buffer with every remote
+      // subscriber and with the latch if this is the latest message.
+      MessageBufferPtr buffer;
+      if (send)
+      {
+        boost::shared_ptr<std::string> data(new std::string());
+        _msg->SerializeToString(data.get());
+        buffer = data;
+        for (auto &prev : this->prevMsgs)
+        {
+          if (prev.second == _msg)
+            this->prevBuffers[prev.first] = buffer;
+        }
+      }
+
       std::list<CallbackHelperPtr>::iterator cbIter;
       cbIter = this->callbacks.begin();
 
-      while (cbIter != this->callbacks.end())
+      for (std::size_t i = 0; cbIter != this->callbacks.end(); ++i)
       {
-        if ((*cbIter)->HandleData(data, _cb, _id))
+        if (throttled[i])
+        {
+          // Skipped messages complete right away
+          if (!_cb.empty())
+            _cb(_id);
+          ++result;
+          ++cbIter;
+        }
+        else if ((*cbIter)->HandleBuffer(buffer, _cb, _id))
         {
           ++result;
           ++cbIter;
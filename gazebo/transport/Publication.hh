@@ -167,6 +167,13 @@ namespace gazebo
       /// \brief Remove nodes that have been marked for removal
       private: void RemoveNodes();
 
+      /// \brief Get the serialized last message of a publisher,
+      /// serializing it on first use. Must be called with callbackMutex
+      /// locked.
+      /// \param[in] _pubId Id of the publisher, must be in prevMsgs.
+      /// \return Serialized message.
+      private: MessageBufferPtr PrevBuffer(const uint32_t _pubId);
+
       /// \brief Unique if of the publication.
       private: unsigned int id;
 
@@ -211,6 +218,10 @@ namespace gazebo
 
       /// \brief Publishers and their last messages.
       private: std::map<uint32_t, MessagePtr> prevMsgs;
+
+      /// \brief Serialized last messages of the publishers, filled when
+      /// a message is published or latched to a remote subscriber.
+      private: std::map<uint32_t, MessageBufferPtr> prevBuffers;
     };
     /// \}
   }
@@ -14,17 +14,38 @@
  * limitations under the License.
  *
 */
+#ifdef __linux__
+  #include <unistd.h>
+#endif
+#include <sstream>
 #include <boost/function.hpp>
 #include "gazebo/transport/TopicManager.hh"
 #include "gazebo/transport/ConnectionManager.hh"
 #include "gazebo/transport/PublicationTransport.hh"
+#include "gazebo/transport/TraceStamps.hh"
 #include "gazebo/common/WeakBind.hh"
+#include "gazebo/common/SamplingProfiler.hh"
 
 using namespace gazebo;
 using namespace transport;
 
 int PublicationTransport::counter = 0;
 
+/// \brief Size of the data area of a shared memory ring. Segments are
+/// sparse, so pages are only committed once messages reach them. This
+/// holds a few uncompressed 1080p images.
+static const uint64_t kRingCapacity = 32 * 1024 * 1024;
+
+/////////////////////////////////////////////////
+/// \brief Check whether both ends of a connection are on this host.
+/// \param[in] _conn Connection to check.
+/// \return True if the remote address is a local one.
+static bool IsSameHost(const ConnectionPtr &_conn)
+{
+  const std::string remote = _conn->GetRemoteAddress();
+  return remote == _conn->GetLocalAddress() || remote.find("127.") == 0;
+}
+
 /////////////////////////////////////////////////
 PublicationTransport::PublicationTransport(const std::string &_topic,
                                            const std::string &_msgType)
@@ -37,6 +58,8 @@ PublicationTransport::PublicationTransport(const std::string &_topic,
 /////////////////////////////////////////////////
 PublicationTransport::~PublicationTransport()
 {
+  this->StopRing();
+
   if (this->connection)
   {
     msgs::Subscribe sub;
@@ -54,7 +77,8 @@ PublicationTransport::~PublicationTransport()
 }
 
 /////////////////////////////////////////////////
-void PublicationTransport::Init(const ConnectionPtr &_conn, bool _latched)
+void PublicationTransport::Init(const ConnectionPtr &_conn, bool _latched,
+    const SubscriptionQoS &_qos)
 {
   this->connection = _conn;
   msgs::Subscribe sub;
@@ -63,6 +87,23 @@ void PublicationTransport::Init(const ConnectionPtr &_conn, bool _latched)
   sub.set_host(this->connection->GetLocalAddress());
   sub.set_port(this->connection->GetLocalPort());
   sub.set_latching(_latched);
+  if (_qos.queueSize > 0)
+    sub.set_queue_size(_qos.queueSize);
+  if (_qos.maxRate > 0)
+    sub.set_max_rate(_qos.maxRate);
+
+#ifdef __linux__
+  if (ShmRing::Enabled() && IsSameHost(this->connection))
+  {
+    std::ostringstream name;
+    name << "/gazebo_" << getpid() << "_" << this->id;
+    this->ring.reset(new ShmRing());
+    if (this->ring->Create(name.str(), kRingCapacity))
+      sub.set_shm_name(name.str());
+    else
+      this->ring.reset();
+  }
+#endif
 
   this->connection->EnqueueMsg(msgs::Package("sub", sub));
 
@@ -71,6 +112,63 @@ void PublicationTransport::Init(const ConnectionPtr &_conn, bool _latched)
   using namespace boost::placeholders;
   this->connection->AsyncRead(common::weakBind(&PublicationTransport::OnPublish,
         this->shared_from_this(), _1));
+
+  if (this->ring)
+  {
+    this->ringThread = new boost::thread(
+        boost::bind(&PublicationTransport::RingLoop,
+          boost::weak_ptr<PublicationTransport>(this->shared_from_this())));
+  }
+}
+
+/////////////////////////////////////////////////
+void PublicationTransport::RingLoop(
+    boost::weak_ptr<PublicationTransport> _self)
+{
+  common::SetThreadName("PublicationRing");
+  // Reused for every message, so that large messages do not reallocate
+  std::string data;
+  while (true)
+  {
+    // Hold a reference while reading, so that the transport is only
+    // destroyed between two reads.
+    PublicationTransportPtr self = _self.lock();
+    if (!self || self->ringStop || !self->ring->IsOpen())
+      break;
+
+    if (self->ring->Read(data, 100) && !self->ringStop && self->callback)
+    {
+      if (TraceStamps::Enabled())
+        TraceStamps::Append(data, msgs::TraceStamp::RECEIVE);
+      (self->callback)(data);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void PublicationTransport::StopRing()
+{
+  this->ringStop = true;
+  if (this->ringThread)
+  {
+    // The last reference can be dropped by the ring thread itself, which
+    // must not join itself.
+    if (this->ringThread->get_id() == boost::this_thread::get_id())
+      this->ringThread->detach();
+    else
+      this->ringThread->join();
+    delete this->ringThread;
+    this->ringThread = nullptr;
+  }
+
+  if (this->ring)
+    this->ring->Close();
+}
+
+/////////////////////////////////////////////////
+bool PublicationTransport::HasRing() const
+{
+  return this->ring != nullptr;
 }
 
 
@@ -93,7 +191,13 @@ void PublicationTransport::OnPublish(const std::string &_data)
 
     if (!_data.empty())
     {
-      if (this->callback)
+      if (this->callback && TraceStamps::Enabled())
+      {
+        std::string data(_data);
+        TraceStamps::Append(data, msgs::TraceStamp::RECEIVE);
+        (this->callback)(data);
+      }
+      else if (this->callback)
         (this->callback)(_data);
     }
   }
@@ -120,6 +224,8 @@ std::string PublicationTransport::GetMsgType() const
 /////////////////////////////////////////////////
 void PublicationTransport::Fini()
 {
+  this->StopRing();
+
   /// Cancel all async operatiopns.
   if (this->connection)
   {
@@ -20,9 +20,14 @@
 
 #include <boost/function.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
+#include <boost/thread.hpp>
+#include <memory>
 #include <string>
 
 #include "gazebo/transport/Connection.hh"
+#include "gazebo/transport/ShmRing.hh"
+#include "gazebo/transport/SubscribeOptions.hh"
 #include "gazebo/common/Event.hh"
 #include "gazebo/util/system.hh"
 
@@ -37,6 +42,12 @@ namespace gazebo
     /// transport/transport.hh
     /// \brief Reads data from a remote advertiser, and passes the data
     /// along to local subscribers
+    ///
+    /// When the advertiser runs on the same host, the transport also
+    /// creates a shared memory ring and offers it in the subscription
+    /// request. An advertiser that opens the ring writes the topic data
+    /// to it, and the connection only carries the messages that did not
+    /// fit in the ring.
     class GZ_TRANSPORT_VISIBLE PublicationTransport :
         public boost::enable_shared_from_this<PublicationTransport>
     {
@@ -53,7 +64,9 @@ namespace gazebo
       /// \param[in] _conn The underlying connection.
       /// \param[in] _latched True to grab the last message sent on the
       /// topic.
-      public: void Init(const ConnectionPtr &_conn, bool _latched);
+      /// \param[in] _qos Quality of service requested from the publisher.
+      public: void Init(const ConnectionPtr &_conn, bool _latched,
+                  const SubscriptionQoS &_qos = SubscriptionQoS());
 
       /// \brief Finalize the transport
       public: void Fini();
@@ -75,10 +88,24 @@ namespace gazebo
       /// \return The topic type
       public: std::string GetMsgType() const;
 
+      /// \brief Check whether the transport reads from a shared memory
+      /// ring in addition to the connection.
+      /// \return True if a ring was created for this transport.
+      public: bool HasRing() const;
+
       /// \brief Called when data is published.
       /// \param[in] _data Data to be published.
       private: void OnPublish(const std::string &_data);
 
+      /// \brief Read messages from the ring until it is closed or the
+      /// transport is destroyed.
+      /// \param[in] _self The transport.
+      private: static void RingLoop(
+                   boost::weak_ptr<PublicationTransport> _self);
+
+      /// \brief Stop the ring thread and close the ring.
+      private: void StopRing();
+
       /// \brief The topic for this publication transport.
       private: std::string topic;
 
@@ -96,6 +123,15 @@ namespace gazebo
 
       /// \brief The unique id for the publication transport.
       private: int id;
+
+      /// \brief Shared memory ring, null if the advertiser is remote.
+      private: std::unique_ptr<ShmRing> ring;
+
+      /// \brief Thread reading from the ring.
+      private: boost::thread *ringThread = nullptr;
+
+      /// \brief Set to stop the ring thread.
+      private: bool ringStop = false;
     };
     /// \}
   }
@@ -21,9 +21,11 @@
 #include <ignition/math/Helpers.hh>
 
 #include "gazebo/common/Exception.hh"
+#include "gazebo/common/MemoryAccount.hh"
 #include "gazebo/common/WeakBind.hh"
 #include "gazebo/transport/Node.hh"
 #include "gazebo/transport/TopicManager.hh"
+#include "gazebo/transport/TraceStamps.hh"
 #include "gazebo/transport/Publisher.hh"
 
 using namespace gazebo;
@@ -31,6 +33,36 @@ using namespace transport;
 
 uint32_t Publisher::idCounter = 0;
 
+/// \brief Maximum number of sent messages a publisher keeps for reuse.
+/// Two covers the message the publication holds as the latest one and the
+/// one before it, which is free again by the next publish.
+static const size_t kMaxRecycled = 2;
+
+//////////////////////////////////////////////////
+/// \brief Get the memory account of the publisher queues.
+/// \return The account.
+static common::MemoryAccount *QueueAccount()
+{
+  // The registry keeps the account alive, also for publishers destroyed
+  // at exit
+  static common::MemoryAccount *account = common::MemoryAccount::Get(
+      "transport/publisher_queues").get();
+  return account;
+}
+
+//////////////////////////////////////////////////
+/// \brief Get the serialized size of a message, which is cached in it.
+/// \param[in] _msg The message.
+/// \return Size in bytes.
+static int64_t MessageBytes(const google::protobuf::Message &_msg)
+{
+#if GOOGLE_PROTOBUF_VERSION < 3001000
+  return _msg.ByteSize();
+#else
+  return _msg.ByteSizeLong();
+#endif
+}
+
 //////////////////////////////////////////////////
 Publisher::Publisher(const std::string &_topic, const std::string &_msgType,
                      unsigned int _limit, double _hzRate)
@@ -59,6 +91,21 @@ bool Publisher::HasConnections() const
        this->publication->GetNodeCount() > 0));
 }
 
+//////////////////////////////////////////////////
+void Publisher::SetUpdateRate(const double _hzRate)
+{
+  this->updatePeriod = _hzRate > 0 ? 1.0 / _hzRate : 0;
+}
+
+//////////////////////////////////////////////////
+bool Publisher::Throttled() const
+{
+  return this->updatePeriod > 0 &&
+      this->prevPublishTime != common::Time(0, 0) &&
+      (common::Time::GetWallTime() - this->prevPublishTime).Double() <
+      this->updatePeriod;
+}
+
 //////////////////////////////////////////////////
 void Publisher::WaitForConnection() const
 {
@@ -115,9 +162,14 @@ void Publisher::PublishImpl(const google::protobuf::Message &_message,
     this->prevPublishTime = this->currentTime;
   }
 
-  // Save the latest message
-  MessagePtr msgPtr(_message.New());
+  // Save the latest message. A message sent earlier that nobody holds
+  // anymore is copied into, so its fields keep their allocations.
+  MessagePtr msgPtr = this->RecycledMessage();
+  if (!msgPtr)
+    msgPtr.reset(_message.New());
   msgPtr->CopyFrom(_message);
+  if (TraceStamps::Enabled())
+    TraceStamps::Add(*msgPtr, msgs::TraceStamp::PUBLISH);
 
   this->publication->SetPrevMsg(this->id, msgPtr);
 
@@ -125,9 +177,12 @@ void Publisher::PublishImpl(const google::protobuf::Message &_message,
     boost::mutex::scoped_lock lock(this->mutex);
 
     this->messages.push_back(msgPtr);
+    int64_t bytes = MessageBytes(*msgPtr);
 
     if (this->messages.size() > this->queueLimit)
     {
+      // The size of the front message was computed when it was queued
+      bytes -= this->messages.front()->GetCachedSize();
       this->messages.pop_front();
 
       if (!queueLimitWarned)
@@ -139,6 +194,9 @@ void Publisher::PublishImpl(const google::protobuf::Message &_message,
         queueLimitWarned = true;
       }
     }
+
+    this->queuedBytes += bytes;
+    QueueAccount()->Add(bytes);
   }
 
   TopicManager::Instance()->AddNodeToProcess(this->node);
@@ -177,6 +235,8 @@ void Publisher::SendMessage()
     std::copy(this->messages.begin(), this->messages.end(),
         std::back_inserter(localBuffer));
     this->messages.clear();
+    QueueAccount()->Add(-this->queuedBytes);
+    this->queuedBytes = 0;
   }
 
   // Only send messages if there is something to send
@@ -246,12 +306,42 @@ void Publisher::SendMessage()
       }
     }
 
+    // Keep a few of the sent messages to copy later ones into
+    {
+      boost::mutex::scoped_lock lock(this->mutex);
+      for (auto &msg : localBuffer)
+      {
+        if (this->recycled.size() >= kMaxRecycled)
+          break;
+        this->recycled.push_back(msg);
+      }
+    }
+
     // Clear the local buffer.
     localBuffer.clear();
     localIds.clear();
   }
 }
 
+//////////////////////////////////////////////////
+MessagePtr Publisher::RecycledMessage()
+{
+  boost::mutex::scoped_lock lock(this->mutex);
+  for (auto iter = this->recycled.begin(); iter != this->recycled.end();
+       ++iter)
+  {
+    // The count can only drop while we look at it, so a message only
+    // referenced here is not read by any subscriber or the publication
+    if (iter->use_count() == 1)
+    {
+      MessagePtr msg = *iter;
+      this->recycled.erase(iter);
+      return msg;
+    }
+  }
+  return MessagePtr();
+}
+
 //////////////////////////////////////////////////
 void Publisher::SetNode(NodePtr _node)
 {
@@ -318,7 +408,13 @@ void Publisher::Fini()
 {
   if (!this->messages.empty())
     this->SendMessage();
-  this->messages.clear();
+
+  {
+    boost::mutex::scoped_lock lock(this->mutex);
+    this->messages.clear();
+    QueueAccount()->Add(-this->queuedBytes);
+    this->queuedBytes = 0;
+  }
 
   if (!this->topic.empty())
     TopicManager::Instance()->Unadvertise(this->topic, this->id);
@@ -24,6 +24,7 @@
 #include <google/protobuf/message.h>
 #include <boost/thread.hpp>
 #include <boost/shared_ptr.hpp>
+#include <cstdint>
 #include <string>
 #include <list>
 #include <map>
@@ -101,6 +102,53 @@ namespace gazebo
               void Publish(M _message, bool _block = false)
               { this->PublishImpl(_message, _block); }
 
+      /// \brief Build and publish a message only if the topic has
+      /// subscribers, so that no time is spent filling messages that nobody
+      /// reads. Messages that the publisher's rate would drop are not built
+      /// either. A skipped message is not latched, so use Publish for
+      /// topics that latching subscribers rely on.
+      /// \param[in] _build Called with an empty message to fill, only when
+      /// the topic has subscribers.
+      /// \param[in] _block See Publish.
+      /// \return True if the message was built and published.
+      public: template<typename M, typename BuildFn>
+              bool PublishIfSubscribed(BuildFn &&_build, bool _block = false)
+              {
+                if (!this->HasConnections() || this->Throttled())
+                  return false;
+
+                M msg;
+                _build(msg);
+                this->PublishImpl(msg, _block);
+                return true;
+              }
+
+      /// \brief Same as PublishIfSubscribed above, but fill a message
+      /// owned by the caller. The message is cleared first, and protobuf
+      /// keeps the cleared repeated submessages for reuse, so publishing
+      /// large messages every step doesn't allocate them again.
+      /// \param[in,out] _msg Message to clear, fill and publish.
+      /// \param[in] _build Called with the cleared message, only when the
+      /// topic has subscribers.
+      /// \param[in] _block See Publish.
+      /// \return True if the message was built and published.
+      public: template<typename M, typename BuildFn>
+              bool PublishIfSubscribed(M &_msg, BuildFn &&_build,
+                                       bool _block = false)
+              {
+                if (!this->HasConnections() || this->Throttled())
+                  return false;
+
+                _msg.Clear();
+                _build(_msg);
+                this->PublishImpl(_msg, _block);
+                return true;
+              }
+
+      /// \brief Change the rate given to Node::Advertise.
+      /// \param[in] _hzRate Maximum rate in Hz, zero for no limit.
+      public: void SetUpdateRate(const double _hzRate);
+
       /// \brief Get the number of outgoing messages
       /// \return The number of outgoing messages
       public: unsigned int GetOutgoingCount() const;
@@ -147,6 +195,16 @@ namespace gazebo
       private: void PublishImpl(const google::protobuf::Message &_message,
                                 bool _block);
 
+      /// \brief Check whether a message published now would be dropped
+      /// because of the rate given to Advertise.
+      /// \return True if the last message went out less than a period ago.
+      private: bool Throttled() const;
+
+      /// \brief Take a sent message that is no longer referenced anywhere
+      /// else, so that the next message can be copied into it.
+      /// \return The message, or null if every sent message is still used.
+      private: MessagePtr RecycledMessage();
+
       /// \brief Callback when a publish is completed
       /// \param[in] _id ID associated with the publication.
       private: void OnPublishComplete(uint32_t _id);
@@ -172,6 +230,13 @@ namespace gazebo
       /// \brief List of messages to publish.
       private: std::list<MessagePtr> messages;
 
+      /// \brief Messages already sent, reused by RecycledMessage once
+      /// the publication and subscribers have released them.
+      private: std::list<MessagePtr> recycled;
+
+      /// \brief Serialized size of the queued messages, in bytes.
+      private: int64_t queuedBytes = 0;
+
       /// \brief For mutual exclusion.
       private: mutable boost::mutex mutex;
 
@@ -0,0 +1,296 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifdef __linux__
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/transport/ShmClock.hh"
+#include "gazebo/transport/ShmRing.hh"
+#include "gazebo/transport/TransportIface.hh"
+
+using namespace gazebo;
+using namespace transport;
+
+namespace gazebo
+{
+  namespace transport
+  {
+    /// \brief Identifies a clock segment.
+    static const uint32_t kShmClockMagic = 0x677a636b;
+
+    /// \brief Clock segment, written with a sequence lock: the writer makes
+    /// the sequence odd while it updates the fields, and readers retry
+    /// when the sequence was odd or changed during their read.
+    struct ShmClockHeader
+    {
+      /// \brief Set to kShmClockMagic once the writer has set up the clock.
+      std::atomic<uint32_t> magic;
+
+      /// \brief Set when the writer closes the clock.
+      std::atomic<uint32_t> closed;
+
+      /// \brief Sequence lock.
+      std::atomic<uint64_t> sequence;
+
+      /// \brief Seconds of simulation time.
+      std::atomic<int64_t> sec;
+
+      /// \brief Nanoseconds of simulation time.
+      std::atomic<int64_t> nsec;
+
+      /// \brief World iterations.
+      std::atomic<uint64_t> iterations;
+
+      /// \brief Non zero if the world is paused.
+      std::atomic<uint32_t> paused;
+    };
+
+    static_assert(ATOMIC_LLONG_LOCK_FREE == 2,
+        "clock fields must be lock free to be shared between processes");
+  }
+}
+
+//////////////////////////////////////////////////
+ShmClock::ShmClock()
+{
+}
+
+//////////////////////////////////////////////////
+ShmClock::~ShmClock()
+{
+  this->Close();
+}
+
+//////////////////////////////////////////////////
+bool ShmClock::Enabled()
+{
+  return ShmRing::Enabled();
+}
+
+//////////////////////////////////////////////////
+std::string ShmClock::SegmentName(const std::string &_worldName)
+{
+  std::string host;
+  unsigned int port = 0;
+  get_master_uri(host, port);
+
+  std::string world = _worldName;
+  std::replace(world.begin(), world.end(), '/', '_');
+
+  std::ostringstream segment;
+  segment << "/gazebo_clock_" << port << "_" << world;
+  return segment.str();
+}
+
+//////////////////////////////////////////////////
+bool ShmClock::Create(const std::string &_name)
+{
+#ifndef __linux__
+  return false;
+#else
+  this->Close();
+
+  // Names include the master port, so an existing segment was left by a
+  // server that did not shut down
+  shm_unlink(_name.c_str());
+  int fd = shm_open(_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+  if (fd < 0)
+  {
+    gzwarn << "Unable to create shared memory clock[" << _name << "]: "
+           << std::strerror(errno) << "\n";
+    return false;
+  }
+
+  if (ftruncate(fd, sizeof(ShmClockHeader)) != 0 || !this->Map(fd, true))
+  {
+    gzwarn << "Unable to size shared memory clock[" << _name << "]\n";
+    close(fd);
+    shm_unlink(_name.c_str());
+    return false;
+  }
+  close(fd);
+
+  this->name = _name;
+  this->owner = true;
+
+  this->header->closed = 0;
+  this->header->sequence = 0;
+  this->header->sec = 0;
+  this->header->nsec = 0;
+  this->header->iterations = 0;
+  this->header->paused = 0;
+  this->header->magic.store(kShmClockMagic, std::memory_order_release);
+
+  return true;
+#endif
+}
+
+//////////////////////////////////////////////////
+bool ShmClock::Open(const std::string &_name)
+{
+#ifndef __linux__
+  return false;
+#else
+  this->Close();
+
+  // Readers only need read access, any user may track the clock
+  int fd = shm_open(_name.c_str(), O_RDONLY, 0);
+  if (fd < 0)
+    return false;
+
+  if (!this->Map(fd, false))
+  {
+    close(fd);
+    return false;
+  }
+  close(fd);
+
+  if (this->header->magic.load(std::memory_order_acquire) != kShmClockMagic)
+  {
+    munmap(this->header, sizeof(ShmClockHeader));
+    this->header = nullptr;
+    return false;
+  }
+
+  this->name = _name;
+  this->owner = false;
+  return true;
+#endif
+}
+
+//////////////////////////////////////////////////
+bool ShmClock::Map(const int _fd, const bool _writable)
+{
+#ifndef __linux__
+  return false;
+#else
+  struct stat st;
+  if (fstat(_fd, &st) != 0 ||
+      static_cast<size_t>(st.st_size) < sizeof(ShmClockHeader))
+  {
+    return false;
+  }
+
+  void *addr = mmap(nullptr, sizeof(ShmClockHeader),
+      _writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, _fd, 0);
+  if (addr == MAP_FAILED)
+    return false;
+
+  this->header = static_cast<ShmClockHeader *>(addr);
+  return true;
+#endif
+}
+
+//////////////////////////////////////////////////
+void ShmClock::Close()
+{
+#ifdef __linux__
+  if (!this->header)
+    return;
+
+  if (this->owner)
+  {
+    this->header->closed = 1;
+    shm_unlink(this->name.c_str());
+  }
+
+  munmap(this->header, sizeof(ShmClockHeader));
+  this->header = nullptr;
+  this->owner = false;
+#endif
+}
+
+//////////////////////////////////////////////////
+bool ShmClock::Write(const common::Time &_simTime,
+    const uint64_t _iterations, const bool _paused)
+{
+#ifndef __linux__
+  return false;
+#else
+  if (!this->header || !this->owner)
+    return false;
+
+  const uint64_t seq =
+      this->header->sequence.load(std::memory_order_relaxed);
+  this->header->sequence.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  this->header->sec.store(_simTime.sec, std::memory_order_relaxed);
+  this->header->nsec.store(_simTime.nsec, std::memory_order_relaxed);
+  this->header->iterations.store(_iterations, std::memory_order_relaxed);
+  this->header->paused.store(_paused, std::memory_order_relaxed);
+
+  this->header->sequence.store(seq + 2, std::memory_order_release);
+  return true;
+#endif
+}
+
+//////////////////////////////////////////////////
+bool ShmClock::Read(common::Time &_simTime, uint64_t &_iterations,
+    bool &_paused) const
+{
+#ifndef __linux__
+  return false;
+#else
+  if (!this->IsOpen())
+    return false;
+
+  while (true)
+  {
+    const uint64_t before =
+        this->header->sequence.load(std::memory_order_acquire);
+    if (before & 1)
+      continue;
+
+    const int64_t sec = this->header->sec.load(std::memory_order_relaxed);
+    const int64_t nsec = this->header->nsec.load(std::memory_order_relaxed);
+    const uint64_t iterations =
+        this->header->iterations.load(std::memory_order_relaxed);
+    const uint32_t paused =
+        this->header->paused.load(std::memory_order_relaxed);
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (this->header->sequence.load(std::memory_order_relaxed) != before)
+      continue;
+
+    _simTime.Set(static_cast<int32_t>(sec), static_cast<int32_t>(nsec));
+    _iterations = iterations;
+    _paused = paused != 0;
+    return true;
+  }
+#endif
+}
+
+//////////////////////////////////////////////////
+bool ShmClock::IsOpen() const
+{
+#ifndef __linux__
+  return false;
+#else
+  return this->header && !this->header->closed;
+#endif
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_TRANSPORT_SHMCLOCK_HH_
+#define GAZEBO_TRANSPORT_SHMCLOCK_HH_
+
+#include <cstdint>
+#include <string>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace transport
+  {
+    /// \addtogroup gazebo_transport
+    /// \{
+
+    /// \brief Layout of a clock segment.
+    struct ShmClockHeader;
+
+    /// \class ShmClock ShmClock.hh transport/transport.hh
+    /// \brief Simulation clock of a world in POSIX shared memory. The
+    /// server writes it on every iteration and any number of processes on
+    /// the same host read it whenever they need the time, without a
+    /// subscription or a message per iteration. Processes on other hosts
+    /// subscribe to the world's ~/clock topic instead, which is published
+    /// at a limited rate.
+    ///
+    /// The writer creates the segment and owns its name, see SegmentName.
+    /// Reads never block the writer: a read that overlaps a write is
+    /// retried.
+    class GZ_TRANSPORT_VISIBLE ShmClock
+    {
+      /// \brief Constructor.
+      public: ShmClock();
+
+      /// \brief Destructor. Closes the clock.
+      public: virtual ~ShmClock();
+
+      /// \brief Create a segment as the writer. A stale segment of the
+      /// same name, left by a process that died, is replaced.
+      /// \param[in] _name Name of the segment.
+      /// \return True if the segment was created and mapped.
+      public: bool Create(const std::string &_name);
+
+      /// \brief Open a segment created by a writer, as a reader.
+      /// \param[in] _name Name of the segment.
+      /// \return True if the segment was opened and mapped.
+      public: bool Open(const std::string &_name);
+
+      /// \brief Close the clock. Readers see the clock as closed once the
+      /// writer closes it, and the writer removes the segment name.
+      public: void Close();
+
+      /// \brief Set the clock. Only the writer may call this.
+      /// \param[in] _simTime Simulation time.
+      /// \param[in] _iterations World iterations.
+      /// \param[in] _paused True if the world is paused.
+      /// \return False if this is not an open writer.
+      public: bool Write(const common::Time &_simTime,
+                         const uint64_t _iterations, const bool _paused);
+
+      /// \brief Read the clock.
+      /// \param[out] _simTime Simulation time.
+      /// \param[out] _iterations World iterations.
+      /// \param[out] _paused True if the world is paused.
+      /// \return False if the clock is not open or was closed by the
+      /// writer.
+      public: bool Read(common::Time &_simTime, uint64_t &_iterations,
+                        bool &_paused) const;
+
+      /// \brief Check whether the clock is mapped and the writer has not
+      /// closed it.
+      /// \return True if the clock is usable.
+      public: bool IsOpen() const;
+
+      /// \brief Get the name of the clock segment of a world served by
+      /// the gazebo master of this process, see GAZEBO_MASTER_URI.
+      /// \param[in] _worldName Name of the world.
+      /// \return Segment name.
+      public: static std::string SegmentName(const std::string &_worldName);
+
+      /// \brief Check whether shared memory clocks are available, see
+      /// ShmRing::Enabled.
+      /// \return True if clocks should be shared between local processes.
+      public: static bool Enabled();
+
+      /// \brief Map a segment.
+      /// \param[in] _fd File descriptor of the segment.
+      /// \param[in] _writable True to map it for writing.
+      /// \return True on success.
+      private: bool Map(const int _fd, const bool _writable);
+
+      /// \brief The mapped segment.
+      private: ShmClockHeader *header = nullptr;
+
+      /// \brief Name of the segment.
+      private: std::string name;
+
+      /// \brief True if this end created the segment.
+      private: bool owner = false;
+    };
+    /// \}
+  }
+}
+#endif
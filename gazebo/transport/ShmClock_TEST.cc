@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+#include <atomic>
+#include <string>
+#include <sstream>
+#include <thread>
+#ifdef __linux__
+  #include <unistd.h>
+#endif
+
+#include "gazebo/transport/ShmClock.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class ShmClock : public gazebo::testing::AutoLogFixture { };
+
+#ifdef __linux__
+/////////////////////////////////////////////////
+/// \brief Name of a segment that is unique to this test process.
+/// \param[in] _suffix Appended to the name.
+/// \return Segment name.
+static std::string SegmentName(const std::string &_suffix)
+{
+  std::ostringstream name;
+  name << "/gazebo_test_" << getpid() << "_" << _suffix;
+  return name.str();
+}
+
+/////////////////////////////////////////////////
+TEST_F(ShmClock, WriteRead)
+{
+  const std::string name = SegmentName("clock");
+
+  transport::ShmClock reader;
+  EXPECT_FALSE(reader.Open(name));
+
+  transport::ShmClock writer;
+  ASSERT_TRUE(writer.Create(name));
+  EXPECT_TRUE(writer.IsOpen());
+
+  ASSERT_TRUE(reader.Open(name));
+  EXPECT_FALSE(reader.Write(common::Time(1, 0), 1, false));
+
+  common::Time simTime;
+  uint64_t iterations = 1;
+  bool paused = true;
+  EXPECT_TRUE(reader.Read(simTime, iterations, paused));
+  EXPECT_EQ(common::Time::Zero, simTime);
+  EXPECT_EQ(0u, iterations);
+  EXPECT_FALSE(paused);
+
+  EXPECT_TRUE(writer.Write(common::Time(12, 345), 12001, true));
+  EXPECT_TRUE(reader.Read(simTime, iterations, paused));
+  EXPECT_EQ(common::Time(12, 345), simTime);
+  EXPECT_EQ(12001u, iterations);
+  EXPECT_TRUE(paused);
+
+  // Readers see the clock closed once the writer is gone
+  writer.Close();
+  EXPECT_FALSE(reader.IsOpen());
+  EXPECT_FALSE(reader.Read(simTime, iterations, paused));
+
+  transport::ShmClock late;
+  EXPECT_FALSE(late.Open(name));
+}
+
+/////////////////////////////////////////////////
+TEST_F(ShmClock, StaleSegment)
+{
+  const std::string name = SegmentName("stale");
+
+  // A writer that did not close leaves its segment behind
+  transport::ShmClock stale;
+  ASSERT_TRUE(stale.Create(name));
+  EXPECT_TRUE(stale.Write(common::Time(5, 0), 5000, false));
+
+  transport::ShmClock writer;
+  ASSERT_TRUE(writer.Create(name));
+
+  transport::ShmClock reader;
+  ASSERT_TRUE(reader.Open(name));
+  common::Time simTime;
+  uint64_t iterations;
+  bool paused;
+  EXPECT_TRUE(reader.Read(simTime, iterations, paused));
+  EXPECT_EQ(0u, iterations);
+}
+
+/////////////////////////////////////////////////
+TEST_F(ShmClock, Consistent)
+{
+  const std::string name = SegmentName("consistent");
+
+  transport::ShmClock writer;
+  ASSERT_TRUE(writer.Create(name));
+  transport::ShmClock reader;
+  ASSERT_TRUE(reader.Open(name));
+
+  // The time is always iterations milliseconds, a torn read breaks that
+  std::atomic<bool> done(false);
+  std::thread writerThread([&writer, &done]()
+  {
+    for (uint64_t i = 1; i <= 200000; ++i)
+      writer.Write(common::Time(i * 0.001), i, false);
+    done = true;
+  });
+
+  uint64_t previous = 0;
+  while (!done)
+  {
+    common::Time simTime;
+    uint64_t iterations;
+    bool paused;
+    ASSERT_TRUE(reader.Read(simTime, iterations, paused));
+    EXPECT_GE(iterations, previous);
+    EXPECT_EQ(common::Time(iterations * 0.001), simTime);
+    previous = iterations;
+  }
+  writerThread.join();
+}
+#endif
+
+/////////////////////////////////////////////////
+TEST_F(ShmClock, SegmentName)
+{
+  const std::string name = transport::ShmClock::SegmentName("my/world");
+  EXPECT_EQ(0u, name.find("/gazebo_clock_"));
+  EXPECT_EQ(std::string::npos, name.find('/', 1));
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,359 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifdef __linux__
+  #include <fcntl.h>
+  #include <semaphore.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <time.h>
+  #include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/transport/ShmRing.hh"
+
+using namespace gazebo;
+using namespace transport;
+
+namespace gazebo
+{
+  namespace transport
+  {
+    /// \brief Identifies a ring segment.
+    static const uint32_t kShmRingMagic = 0x677a7262;
+
+    /// \brief Offset of the data area, past the header.
+    static const uint64_t kShmRingDataOffset = 256;
+
+    /// \brief Size of the length that precedes each message.
+    static const uint64_t kShmRingLength = sizeof(uint32_t);
+
+#ifdef __linux__
+    /// \brief Shared state at the start of a segment. The read and write
+    /// positions only ever grow, their difference is the amount of data
+    /// in the ring.
+    struct ShmRingHeader
+    {
+      /// \brief Set to kShmRingMagic once the reader has set up the ring.
+      uint32_t magic;
+
+      /// \brief Set when either end closes the ring.
+      std::atomic<uint32_t> closed;
+
+      /// \brief Size of the data area.
+      uint64_t capacity;
+
+      /// \brief Write position, only changed by the writer.
+      std::atomic<uint64_t> head;
+
+      /// \brief Read position, only changed by the reader.
+      std::atomic<uint64_t> tail;
+
+      /// \brief Posted by the writer after each message.
+      sem_t ready;
+    };
+
+    static_assert(sizeof(ShmRingHeader) <= kShmRingDataOffset,
+        "ring header overlaps the data area");
+    static_assert(ATOMIC_LLONG_LOCK_FREE == 2,
+        "ring positions must be lock free to be shared between processes");
+#else
+    struct ShmRingHeader {};
+#endif
+  }
+}
+
+//////////////////////////////////////////////////
+ShmRing::ShmRing()
+{
+}
+
+//////////////////////////////////////////////////
+ShmRing::~ShmRing()
+{
+  this->Close();
+}
+
+//////////////////////////////////////////////////
+bool ShmRing::Enabled()
+{
+#ifndef __linux__
+  return false;
+#else
+  const char *env = std::getenv("GAZEBO_SHM_TRANSPORT");
+  return !env || std::string(env) != "0";
+#endif
+}
+
+//////////////////////////////////////////////////
+bool ShmRing::Create(const std::string &_name, const uint64_t _capacity)
+{
+#ifndef __linux__
+  return false;
+#else
+  this->Close();
+
+  int fd = shm_open(_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0)
+  {
+    gzwarn << "Unable to create shared memory segment[" << _name << "]: "
+           << std::strerror(errno) << "\n";
+    return false;
+  }
+
+  const uint64_t size = kShmRingDataOffset + _capacity;
+  if (ftruncate(fd, size) != 0 || !this->Map(fd, size))
+  {
+    gzwarn << "Unable to size shared memory segment[" << _name << "]\n";
+    close(fd);
+    shm_unlink(_name.c_str());
+    return false;
+  }
+  close(fd);
+
+  this->name = _name;
+  this->owner = true;
+
+  this->header->closed = 0;
+  this->header->capacity = _capacity;
+  this->header->head = 0;
+  this->header->tail = 0;
+  sem_init(&this->header->ready, 1, 0);
+  std::atomic_thread_fence(std::memory_order_release);
+  this->header->magic = kShmRingMagic;
+
+  return true;
+#endif
+}
+
+//////////////////////////////////////////////////
+bool ShmRing::Open(const std::string &_name)
+{
+#ifndef __linux__
+  return false;
+#else
+  this->Close();
+
+  int fd = shm_open(_name.c_str(), O_RDWR, 0600);
+  if (fd < 0)
+    return false;
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 ||
+      static_cast<uint64_t>(st.st_size) <= kShmRingDataOffset ||
+      !this->Map(fd, st.st_size))
+  {
+    close(fd);
+    return false;
+  }
+  close(fd);
+
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (this->header->magic != kShmRingMagic ||
+      this->header->capacity + kShmRingDataOffset > this->mappedSize)
+  {
+    gzwarn << "Shared memory segment[" << _name << "] is not a ring\n";
+    munmap(this->header, this->mappedSize);
+    this->header = nullptr;
+    this->data = nullptr;
+    this->mappedSize = 0;
+    return false;
+  }
+
+  this->name = _name;
+  this->owner = false;
+  return true;
+#endif
+}
+
+//////////////////////////////////////////////////
+bool ShmRing::Map(const int _fd, const uint64_t _size)
+{
+#ifndef __linux__
+  return false;
+#else
+  void *addr = mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_SHARED,
+      _fd, 0);
+  if (addr == MAP_FAILED)
+    return false;
+
+  this->header = static_cast<ShmRingHeader *>(addr);
+  this->data = static_cast<char *>(addr) + kShmRingDataOffset;
+  this->mappedSize = _size;
+  return true;
+#endif
+}
+
+//////////////////////////////////////////////////
+void ShmRing::Close()
+{
+#ifdef __linux__
+  boost::mutex::scoped_lock lock(this->writeMutex);
+  if (!this->header)
+    return;
+
+  this->header->closed = 1;
+  // Wake up a reader blocked in Read
+  sem_post(&this->header->ready);
+
+  munmap(this->header, this->mappedSize);
+  this->header = nullptr;
+  this->data = nullptr;
+  this->mappedSize = 0;
+
+  // The writer keeps its own mapping, so the name can go as soon as the
+  // reader is done with it.
+  if (this->owner)
+    shm_unlink(this->name.c_str());
+  this->owner = false;
+#endif
+}
+
+//////////////////////////////////////////////////
+bool ShmRing::IsOpen() const
+{
+#ifndef __linux__
+  return false;
+#else
+  return this->header && !this->header->closed;
+#endif
+}
+
+//////////////////////////////////////////////////
+std::string ShmRing::Name() const
+{
+  return this->name;
+}
+
+//////////////////////////////////////////////////
+uint64_t ShmRing::Capacity() const
+{
+#ifndef __linux__
+  return 0;
+#else
+  return this->header ? this->header->capacity : 0;
+#endif
+}
+
+//////////////////////////////////////////////////
+void ShmRing::CopyIn(const uint64_t _pos, const char *_src,
+    const uint64_t _size)
+{
+#ifdef __linux__
+  const uint64_t capacity = this->header->capacity;
+  const uint64_t offset = _pos % capacity;
+  const uint64_t first = std::min(_size, capacity - offset);
+  std::memcpy(this->data + offset, _src, first);
+  std::memcpy(this->data, _src + first, _size - first);
+#endif
+}
+
+//////////////////////////////////////////////////
+void ShmRing::CopyOut(const uint64_t _pos, char *_dst,
+    const uint64_t _size) const
+{
+#ifdef __linux__
+  const uint64_t capacity = this->header->capacity;
+  const uint64_t offset = _pos % capacity;
+  const uint64_t first = std::min(_size, capacity - offset);
+  std::memcpy(_dst, this->data + offset, first);
+  std::memcpy(_dst + first, this->data, _size - first);
+#endif
+}
+
+//////////////////////////////////////////////////
+bool ShmRing::Write(const std::string &_data)
+{
+#ifndef __linux__
+  return false;
+#else
+  boost::mutex::scoped_lock lock(this->writeMutex);
+  if (!this->IsOpen() || _data.size() > UINT32_MAX)
+    return false;
+
+  const uint64_t head = this->header->head.load(std::memory_order_relaxed);
+  const uint64_t tail = this->header->tail.load(std::memory_order_acquire);
+  const uint64_t size = kShmRingLength + _data.size();
+  if (size > this->header->capacity - (head - tail))
+    return false;
+
+  const uint32_t length = static_cast<uint32_t>(_data.size());
+  this->CopyIn(head, reinterpret_cast<const char *>(&length),
+      kShmRingLength);
+  this->CopyIn(head + kShmRingLength, _data.data(), _data.size());
+
+  this->header->head.store(head + size, std::memory_order_release);
+  sem_post(&this->header->ready);
+  return true;
+#endif
+}
+
+//////////////////////////////////////////////////
+bool ShmRing::Read(std::string &_data, const unsigned int _timeoutMs)
+{
+#ifndef __linux__
+  return false;
+#else
+  if (!this->header)
+    return false;
+
+  struct timespec deadline;
+  clock_gettime(CLOCK_REALTIME, &deadline);
+  deadline.tv_sec += _timeoutMs / 1000;
+  deadline.tv_nsec += (_timeoutMs % 1000) * 1000000L;
+  if (deadline.tv_nsec >= 1000000000L)
+  {
+    deadline.tv_sec += 1;
+    deadline.tv_nsec -= 1000000000L;
+  }
+
+  while (true)
+  {
+    const uint64_t tail = this->header->tail.load(std::memory_order_relaxed);
+    const uint64_t head = this->header->head.load(std::memory_order_acquire);
+    if (head != tail)
+    {
+      uint32_t length = 0;
+      this->CopyOut(tail, reinterpret_cast<char *>(&length), kShmRingLength);
+      _data.resize(length);
+      if (length > 0)
+        this->CopyOut(tail + kShmRingLength, &_data[0], length);
+
+      this->header->tail.store(tail + kShmRingLength + length,
+          std::memory_order_release);
+      return true;
+    }
+
+    if (this->header->closed)
+      return false;
+
+    // The semaphore is posted once per message but several messages can
+    // be taken per wake up, so a wake up on an empty ring just loops.
+    if (sem_timedwait(&this->header->ready, &deadline) != 0 &&
+        errno != EINTR)
+    {
+      return false;
+    }
+  }
+#endif
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_TRANSPORT_SHMRING_HH_
+#define GAZEBO_TRANSPORT_SHMRING_HH_
+
+#include <cstdint>
+#include <string>
+
+#include <boost/thread/mutex.hpp>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace transport
+  {
+    /// \addtogroup gazebo_transport
+    /// \{
+
+    /// \brief Layout of the start of a ring buffer segment.
+    struct ShmRingHeader;
+
+    /// \class ShmRing ShmRing.hh transport/transport.hh
+    /// \brief Single reader ring buffer in POSIX shared memory, used to
+    /// carry topic data between processes on the same host without going
+    /// through a socket.
+    ///
+    /// The reader creates the segment and owns its name, the writer opens
+    /// it by name. Each message is stored as a 32 bit length followed by
+    /// the serialized data, copied straight from the caller's buffer into
+    /// the segment. Writes never block: a message that does not fit in
+    /// the free space is refused, so that the caller can fall back to the
+    /// socket.
+    class GZ_TRANSPORT_VISIBLE ShmRing
+    {
+      /// \brief Constructor.
+      public: ShmRing();
+
+      /// \brief Destructor. Closes the ring.
+      public: virtual ~ShmRing();
+
+      /// \brief Create a new segment as the reader.
+      /// \param[in] _name Name of the segment, unique on the host.
+      /// \param[in] _capacity Size of the data area in bytes.
+      /// \return True if the segment was created and mapped.
+      public: bool Create(const std::string &_name, const uint64_t _capacity);
+
+      /// \brief Open a segment created by a reader, as the writer.
+      /// \param[in] _name Name of the segment.
+      /// \return True if the segment was opened and mapped.
+      public: bool Open(const std::string &_name);
+
+      /// \brief Close the ring. The other end sees the ring as closed,
+      /// and the segment name is removed if this end created it.
+      public: void Close();
+
+      /// \brief Append a message to the ring.
+      /// \param[in] _data Serialized message.
+      /// \return False if the ring is closed or the message does not fit
+      /// in the free space.
+      public: bool Write(const std::string &_data);
+
+      /// \brief Take the oldest message from the ring, waiting for one if
+      /// the ring is empty.
+      /// \param[out] _data Serialized message. Its storage is reused, so
+      /// passing the same string on every call avoids reallocations.
+      /// \param[in] _timeoutMs Maximum time to wait in milliseconds.
+      /// \return True if a message was read.
+      public: bool Read(std::string &_data, const unsigned int _timeoutMs);
+
+      /// \brief Check whether the ring is mapped and neither end has
+      /// closed it.
+      /// \return True if the ring is usable.
+      public: bool IsOpen() const;
+
+      /// \brief Get the name of the segment.
+      /// \return Name given to Create or Open.
+      public: std::string Name() const;
+
+      /// \brief Get the size of the data area.
+      /// \return Capacity in bytes, 0 if the ring is not mapped.
+      public: uint64_t Capacity() const;
+
+      /// \brief Check whether shared memory transport is available. It is
+      /// only implemented on Linux, and is disabled when the
+      /// GAZEBO_SHM_TRANSPORT environment variable is set to 0.
+      /// \return True if rings should be used between local processes.
+      public: static bool Enabled();
+
+      /// \brief Copy bytes into the data area, wrapping at the end.
+      /// \param[in] _pos Position in the ring.
+      /// \param[in] _src Bytes to copy.
+      /// \param[in] _size Number of bytes.
+      private: void CopyIn(const uint64_t _pos, const char *_src,
+                           const uint64_t _size);
+
+      /// \brief Copy bytes out of the data area, wrapping at the end.
+      /// \param[in] _pos Position in the ring.
+      /// \param[out] _dst Destination buffer.
+      /// \param[in] _size Number of bytes.
+      private: void CopyOut(const uint64_t _pos, char *_dst,
+                            const uint64_t _size) const;
+
+      /// \brief Map a segment and set the data pointers.
+      /// \param[in] _fd File descriptor of the segment.
+      /// \param[in] _size Size of the segment.
+      /// \return True on success.
+      private: bool Map(const int _fd, const uint64_t _size);
+
+      /// \brief Header at the start of the mapped segment.
+      private: ShmRingHeader *header = nullptr;
+
+      /// \brief Start of the data area.
+      private: char *data = nullptr;
+
+      /// \brief Size of the mapped segment.
+      private: uint64_t mappedSize = 0;
+
+      /// \brief Name of the segment.
+      private: std::string name;
+
+      /// \brief True if this end created the segment.
+      private: bool owner = false;
+
+      /// \brief Serializes writers from the same process.
+      private: boost::mutex writeMutex;
+    };
+    /// \}
+  }
+}
+#endif
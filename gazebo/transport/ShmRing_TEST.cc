@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <string>
+#include <sstream>
+#ifdef __linux__
+  #include <unistd.h>
+#endif
+
+#include "gazebo/transport/ShmRing.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class ShmRing : public gazebo::testing::AutoLogFixture { };
+
+#ifdef __linux__
+/////////////////////////////////////////////////
+/// \brief Name of a segment that is unique to this test process.
+/// \param[in] _suffix Appended to the name.
+/// \return Segment name.
+static std::string SegmentName(const std::string &_suffix)
+{
+  std::ostringstream name;
+  name << "/gazebo_test_" << getpid() << "_" << _suffix;
+  return name.str();
+}
+
+/////////////////////////////////////////////////
+TEST_F(ShmRing, WriteRead)
+{
+  const std::string name = SegmentName("write_read");
+
+  transport::ShmRing reader;
+  ASSERT_TRUE(reader.Create(name, 64));
+  EXPECT_TRUE(reader.IsOpen());
+  EXPECT_EQ(reader.Capacity(), 64u);
+  EXPECT_EQ(reader.Name(), name);
+
+  // The name is taken
+  transport::ShmRing other;
+  EXPECT_FALSE(other.Create(name, 64));
+
+  transport::ShmRing writer;
+  ASSERT_TRUE(writer.Open(name));
+  EXPECT_EQ(writer.Capacity(), 64u);
+
+  std::string data;
+  EXPECT_FALSE(reader.Read(data, 10));
+
+  EXPECT_TRUE(writer.Write("hello"));
+  EXPECT_TRUE(writer.Write(""));
+  EXPECT_TRUE(writer.Write(std::string("a\0b", 3)));
+
+  EXPECT_TRUE(reader.Read(data, 10));
+  EXPECT_EQ(data, "hello");
+  EXPECT_TRUE(reader.Read(data, 10));
+  EXPECT_EQ(data, "");
+  EXPECT_TRUE(reader.Read(data, 10));
+  EXPECT_EQ(data, std::string("a\0b", 3));
+  EXPECT_FALSE(reader.Read(data, 10));
+
+  // Messages larger than the free space are refused
+  EXPECT_FALSE(writer.Write(std::string(61, 'x')));
+  EXPECT_TRUE(writer.Write(std::string(60, 'x')));
+  EXPECT_FALSE(writer.Write("y"));
+  EXPECT_TRUE(reader.Read(data, 10));
+  EXPECT_EQ(data, std::string(60, 'x'));
+
+  // Messages that wrap around the end of the data area
+  for (int i = 0; i < 20; ++i)
+  {
+    std::string msg(10 + i, 'a' + i);
+    EXPECT_TRUE(writer.Write(msg));
+    EXPECT_TRUE(reader.Read(data, 10));
+    EXPECT_EQ(data, msg);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(ShmRing, Close)
+{
+  const std::string name = SegmentName("close");
+
+  transport::ShmRing writer;
+  EXPECT_FALSE(writer.Open(name));
+
+  transport::ShmRing *reader = new transport::ShmRing();
+  ASSERT_TRUE(reader->Create(name, 1024));
+  ASSERT_TRUE(writer.Open(name));
+  EXPECT_TRUE(writer.Write("data"));
+
+  // Closing the reader removes the name and stops the writer
+  delete reader;
+  EXPECT_FALSE(writer.IsOpen());
+  EXPECT_FALSE(writer.Write("data"));
+
+  transport::ShmRing again;
+  EXPECT_FALSE(again.Open(name));
+
+  // Closing the writer stops the reader once the ring is drained
+  transport::ShmRing reader2;
+  ASSERT_TRUE(reader2.Create(name, 1024));
+  ASSERT_TRUE(writer.Open(name));
+  EXPECT_TRUE(writer.Write("last"));
+  writer.Close();
+  EXPECT_FALSE(reader2.IsOpen());
+
+  std::string data;
+  EXPECT_TRUE(reader2.Read(data, 10));
+  EXPECT_EQ(data, "last");
+  EXPECT_FALSE(reader2.Read(data, 10));
+}
+
+/////////////////////////////////////////////////
+TEST_F(ShmRing, Enabled)
+{
+  EXPECT_TRUE(transport::ShmRing::Enabled());
+  setenv("GAZEBO_SHM_TRANSPORT", "0", 1);
+  EXPECT_FALSE(transport::ShmRing::Enabled());
+  unsetenv("GAZEBO_SHM_TRANSPORT");
+}
+#endif
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -17,6 +17,7 @@
 #ifndef _SUBSCRIBEOPTIONS_HH_
 #define _SUBSCRIBEOPTIONS_HH_
 
+#include <algorithm>
 #include <boost/function.hpp>
 #include <boost/shared_ptr.hpp>
 #include <string>
@@ -30,6 +31,120 @@ namespace gazebo
     /// \addtogroup gazebo_transport
     /// \{
 
+    /// \brief Quality of service of a subscription. The policy is sent to
+    /// the remote publishers, which apply it before serializing and
+    /// queueing messages, so slow subscribers cannot grow the publisher's
+    /// write queues. See Node::SetQoS.
+    struct GZ_TRANSPORT_VISIBLE SubscriptionQoS
+    {
+      /// \brief Maximum number of messages queued for the subscriber,
+      /// the oldest ones are dropped first. Zero means no limit.
+      unsigned int queueSize = 0;
+
+      /// \brief Maximum rate in Hz at which messages are sent. Zero means
+      /// no limit.
+      double maxRate = 0;
+
+      /// \brief Only keep the most recent message.
+      /// \return The policy.
+      static SubscriptionQoS LatestOnly()
+      {
+        return KeepLatest(1);
+      }
+
+      /// \brief Keep at most a number of the most recent messages.
+      /// \param[in] _count Number of messages.
+      /// \return The policy.
+      static SubscriptionQoS KeepLatest(const unsigned int _count)
+      {
+        SubscriptionQoS qos;
+        qos.queueSize = _count;
+        return qos;
+      }
+
+      /// \brief Send messages at most at a given rate.
+      /// \param[in] _rate Rate in Hz.
+      /// \return The policy.
+      static SubscriptionQoS RateLimited(const double _rate)
+      {
+        SubscriptionQoS qos;
+        qos.maxRate = _rate;
+        return qos;
+      }
+
+      /// \brief Combine the policies of two subscribers that share a
+      /// connection, keeping the least restrictive of each limit.
+      /// \param[in] _other The other policy.
+      /// \return Combined policy.
+      SubscriptionQoS Merge(const SubscriptionQoS &_other) const
+      {
+        SubscriptionQoS qos;
+        qos.queueSize = (this->queueSize == 0 || _other.queueSize == 0) ?
+            0 : std::max(this->queueSize, _other.queueSize);
+        qos.maxRate = (this->maxRate <= 0 || _other.maxRate <= 0) ?
+            0 : std::max(this->maxRate, _other.maxRate);
+        return qos;
+      }
+    };
+
+    /// \brief Where the callbacks of a subscription run. By default they
+    /// run inline, one message at a time for all topics, from
+    /// ConnectionManager. A topic with its own executor is deserialized and
+    /// dispatched away from that thread, so a slow callback only delays its
+    /// own topic. Messages of a topic are always handled in order. See
+    /// Node::SetExecutor.
+    struct GZ_TRANSPORT_VISIBLE SubscriptionExecutor
+    {
+      /// \brief Kinds of executors.
+      enum Kind
+      {
+        /// \brief Run from ConnectionManager with the other topics.
+        INLINE,
+
+        /// \brief Run on a thread owned by the topic.
+        DEDICATED,
+
+        /// \brief Run on the thread pool shared by all executors.
+        SHARED
+      };
+
+      /// \brief Kind of executor.
+      Kind kind = INLINE;
+
+      /// \brief Maximum number of messages waiting for the callbacks, the
+      /// oldest ones are dropped first. Zero means no limit.
+      unsigned int queueSize = 0;
+
+      /// \brief Run the callbacks inline.
+      /// \return The executor.
+      static SubscriptionExecutor Inline()
+      {
+        return SubscriptionExecutor();
+      }
+
+      /// \brief Run the callbacks on a thread owned by the topic.
+      /// \param[in] _queueSize Maximum number of waiting messages.
+      /// \return The executor.
+      static SubscriptionExecutor Dedicated(const unsigned int _queueSize = 64)
+      {
+        SubscriptionExecutor executor;
+        executor.kind = DEDICATED;
+        executor.queueSize = _queueSize;
+        return executor;
+      }
+
+      /// \brief Run the callbacks on the shared thread pool.
+      /// \param[in] _queueSize Maximum number of waiting messages.
+      /// \return The executor.
+      static SubscriptionExecutor Shared(const unsigned int _queueSize = 64)
+      {
+        SubscriptionExecutor executor;
+        executor.kind = SHARED;
+        executor.queueSize = _queueSize;
+        return executor;
+      }
+    };
+
     /// \class SubscribeOptions SubscribeOptions.hh transport/transport.hh
     /// \brief Options for a subscription
     class GZ_TRANSPORT_VISIBLE SubscribeOptions
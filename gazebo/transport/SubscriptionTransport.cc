@@ -18,6 +18,7 @@
 #include <boost/function.hpp>
 #include "gazebo/transport/ConnectionManager.hh"
 #include "gazebo/transport/SubscriptionTransport.hh"
+#include "gazebo/transport/TraceStamps.hh"
 
 using namespace gazebo;
 using namespace transport;
@@ -32,6 +33,8 @@ SubscriptionTransport::SubscriptionTransport()
 //////////////////////////////////////////////////
 SubscriptionTransport::~SubscriptionTransport()
 {
+  if (this->ring)
+    this->ring->Close();
   ConnectionManager::Instance()->RemoveConnection(this->connection);
   this->connection.reset();
 }
@@ -43,23 +46,88 @@ void SubscriptionTransport::Init(ConnectionPtr _conn, bool _latching)
   this->latching = _latching;
 }
 
+//////////////////////////////////////////////////
+bool SubscriptionTransport::OpenRing(const std::string &_name)
+{
+  this->ring.reset(new ShmRing());
+  if (!this->ring->Open(_name))
+  {
+    // Most likely a subscriber in another container sharing the address
+    this->ring.reset();
+    return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+void SubscriptionTransport::SetQoS(const SubscriptionQoS &_qos)
+{
+  this->qos = _qos;
+}
+
+//////////////////////////////////////////////////
+SubscriptionQoS SubscriptionTransport::QoS() const
+{
+  return this->qos;
+}
+
+//////////////////////////////////////////////////
+bool SubscriptionTransport::Throttled()
+{
+  if (this->qos.maxRate <= 0)
+    return false;
+
+  const auto now = std::chrono::steady_clock::now();
+  const std::chrono::duration<double> period(1.0 / this->qos.maxRate);
+  if (this->lastSend.time_since_epoch().count() != 0 &&
+      now - this->lastSend < period)
+  {
+    return true;
+  }
+
+  this->lastSend = now;
+  return false;
+}
+
+//////////////////////////////////////////////////
+bool SubscriptionTransport::HasRing() const
+{
+  return this->ring && this->ring->IsOpen();
+}
+
 //////////////////////////////////////////////////
 bool SubscriptionTransport::HandleMessage(MessagePtr _newMsg)
 {
-  std::string data;
-  _newMsg->SerializeToString(&data);
+  boost::shared_ptr<std::string> data(new std::string());
+  _newMsg->SerializeToString(data.get());
   using namespace boost::placeholders;
-  return this->HandleData(data, boost::bind(&dummy_callback_fn, _1), 0);
+  return this->HandleBuffer(data, boost::bind(&dummy_callback_fn, _1), 0);
 }
 
 //////////////////////////////////////////////////
 bool SubscriptionTransport::HandleData(const std::string &_newdata,
     boost::function<void(uint32_t)> _cb, uint32_t _id)
+{
+  return this->HandleBuffer(MessageBufferPtr(new std::string(_newdata)),
+      _cb, _id);
+}
+
+//////////////////////////////////////////////////
+bool SubscriptionTransport::HandleBuffer(const MessageBufferPtr &_buffer,
+    boost::function<void(uint32_t)> _cb, uint32_t _id)
 {
   bool result = false;
   if (this->connection->IsOpen())
   {
-    this->connection->EnqueueMsg(_newdata, _cb, _id);
+    // The ring write is complete once it returns, so the callback is
+    // invoked right away.
+    if (this->ring && this->WriteRing(_buffer))
+      _cb(_id);
+    else
+    {
+      this->connection->EnqueueMsg(_buffer, _cb, _id, this->GetId(),
+          this->qos.queueSize);
+    }
     result = true;
   }
   else
@@ -68,6 +136,21 @@ bool SubscriptionTransport::HandleData(const std::string &_newdata,
   return result;
 }
 
+//////////////////////////////////////////////////
+bool SubscriptionTransport::WriteRing(const MessageBufferPtr &_buffer)
+{
+  if (!TraceStamps::Enabled())
+    return this->ring->Write(*_buffer);
+
+  // The ring write takes the place of the socket write
+  std::string data;
+  data.reserve(_buffer->size() + 64);
+  data.append(*_buffer);
+  TraceStamps::Append(data, msgs::TraceStamp::ENQUEUE);
+  TraceStamps::Append(data, msgs::TraceStamp::SOCKET_WRITE);
+  return this->ring->Write(data);
+}
+
 //////////////////////////////////////////////////
 const ConnectionPtr &SubscriptionTransport::GetConnection() const
 {
@@ -19,10 +19,14 @@
 
 #include <boost/function.hpp>
 #include <boost/shared_ptr.hpp>
+#include <chrono>
+#include <memory>
 #include <string>
 
 #include "Connection.hh"
 #include "CallbackHelper.hh"
+#include "ShmRing.hh"
+#include "SubscribeOptions.hh"
 #include "gazebo/util/system.hh"
 
 namespace gazebo
@@ -50,6 +54,28 @@ namespace gazebo
       /// don't latch
       public: void Init(ConnectionPtr _conn, bool _latching);
 
+      /// \brief Write data to a shared memory ring offered by a subscriber
+      /// on the same host. Messages that do not fit in the ring are still
+      /// sent over the connection.
+      /// \param[in] _name Name of the ring, from the subscription request.
+      /// \return True if the ring was opened.
+      public: bool OpenRing(const std::string &_name);
+
+      /// \brief Set the quality of service requested by the subscriber.
+      /// \param[in] _qos Policy to apply to the outgoing messages.
+      public: void SetQoS(const SubscriptionQoS &_qos);
+
+      /// \brief Get the quality of service requested by the subscriber.
+      /// \return Policy applied to the outgoing messages.
+      public: SubscriptionQoS QoS() const;
+
+      // Documentation inherited
+      public: virtual bool Throttled();
+
+      /// \brief Check whether data is written to a shared memory ring.
+      /// \return True if a ring is open.
+      public: bool HasRing() const;
+
       /// \brief Output a message to a connection
       /// \param[in] _newdata The message to be handled
       /// \return true if the message was handled successfully, false otherwise
@@ -59,6 +85,10 @@ namespace gazebo
       public: virtual bool HandleData(const std::string &_newdata,
                   boost::function<void(uint32_t)> _cb, uint32_t _id);
 
+      // Documentation inherited
+      public: virtual bool HandleBuffer(const MessageBufferPtr &_buffer,
+                  boost::function<void(uint32_t)> _cb, uint32_t _id);
+
       // Documentation inherited
       public: virtual bool HandleMessage(MessagePtr _newMsg);
 
@@ -71,7 +101,22 @@ namespace gazebo
       /// is tied to a  remote connection
       public: virtual bool IsLocal() const;
 
+      /// \brief Write a message to the shared memory ring, with trace
+      /// stamps when tracing is enabled.
+      /// \param[in] _buffer Serialized message.
+      /// \return False if the ring is full.
+      private: bool WriteRing(const MessageBufferPtr &_buffer);
+
       private: ConnectionPtr connection;
+
+      /// \brief Shared memory ring, null if the subscriber is remote.
+      private: std::unique_ptr<ShmRing> ring;
+
+      /// \brief Quality of service requested by the subscriber.
+      private: SubscriptionQoS qos;
+
+      /// \brief Time the last message passed the rate limit.
+      private: std::chrono::steady_clock::time_point lastSend;
     };
     /// \}
   }
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+
+#include "gazebo/transport/SubscriptionTransport.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class SubscriptionTransport : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(SubscriptionTransport, QoSMerge)
+{
+  transport::SubscriptionQoS none;
+  EXPECT_EQ(none.queueSize, 0u);
+  EXPECT_DOUBLE_EQ(none.maxRate, 0.0);
+
+  auto latest = transport::SubscriptionQoS::LatestOnly();
+  EXPECT_EQ(latest.queueSize, 1u);
+
+  auto keep = transport::SubscriptionQoS::KeepLatest(5);
+  EXPECT_EQ(keep.queueSize, 5u);
+
+  auto rate = transport::SubscriptionQoS::RateLimited(10);
+  EXPECT_DOUBLE_EQ(rate.maxRate, 10.0);
+
+  // The least restrictive limits win
+  EXPECT_EQ(latest.Merge(keep).queueSize, 5u);
+  EXPECT_EQ(latest.Merge(none).queueSize, 0u);
+  EXPECT_DOUBLE_EQ(rate.Merge(transport::SubscriptionQoS::RateLimited(
+          20)).maxRate, 20.0);
+  EXPECT_DOUBLE_EQ(rate.Merge(latest).maxRate, 0.0);
+}
+
+/////////////////////////////////////////////////
+TEST_F(SubscriptionTransport, Throttled)
+{
+  transport::SubscriptionTransport sub;
+  EXPECT_FALSE(sub.Throttled());
+  EXPECT_FALSE(sub.Throttled());
+
+  sub.SetQoS(transport::SubscriptionQoS::RateLimited(10));
+  EXPECT_DOUBLE_EQ(sub.QoS().maxRate, 10.0);
+
+  // The first message passes, the next ones wait for the period
+  EXPECT_FALSE(sub.Throttled());
+  EXPECT_TRUE(sub.Throttled());
+  EXPECT_TRUE(sub.Throttled());
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(120));
+  EXPECT_FALSE(sub.Throttled());
+  EXPECT_TRUE(sub.Throttled());
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -343,22 +343,27 @@ void TopicManager::ConnectSubToPub(const msgs::Publish &_pub)
             _pub.msg_type()));
 
       bool latched = false;
+      SubscriptionQoS qos;
       boost::mutex::scoped_lock lock(this->subscriberMutex);
       SubNodeMap::iterator nodeIter = this->subscribedNodes.find(_pub.topic());
 
       // Find if any local node has a latched subscriber for the new topic
-      // publication transport.
+      // publication transport, and the policy that satisfies all of them.
       if (nodeIter != this->subscribedNodes.end())
       {
         std::list<NodePtr>::iterator cbIter;
         for (cbIter = nodeIter->second.begin();
-             cbIter != nodeIter->second.end() && !latched; ++cbIter)
+             cbIter != nodeIter->second.end(); ++cbIter)
         {
-          latched = (*cbIter)->HasLatchedSubscriber(_pub.topic());
+          latched = latched || (*cbIter)->HasLatchedSubscriber(_pub.topic());
+          if (cbIter == nodeIter->second.begin())
+            qos = (*cbIter)->QoS(_pub.topic());
+          else
+            qos = qos.Merge((*cbIter)->QoS(_pub.topic()));
         }
       }
 
-      publink->Init(conn, latched);
+      publink->Init(conn, latched, qos);
 
       publication->AddTransport(publink);
     }
@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/unknown_field_set.h>
+#include <google/protobuf/wire_format_lite.h>
+
+#include "gazebo/transport/TraceStamps.hh"
+
+using namespace gazebo;
+using namespace transport;
+
+using google::protobuf::internal::WireFormatLite;
+
+/// \brief Whether messages are stamped, initialized from the environment.
+static std::atomic<bool> g_enabled(std::getenv("GAZEBO_TRANSPORT_TRACE") &&
+    std::string(std::getenv("GAZEBO_TRANSPORT_TRACE")) == "1");
+
+//////////////////////////////////////////////////
+/// \brief Create a stamp for the current time.
+/// \param[in] _stage Stage of the stamp.
+/// \return The stamp.
+static msgs::TraceStamp MakeStamp(const msgs::TraceStamp::Stage _stage)
+{
+  msgs::TraceStamp stamp;
+  stamp.set_stage(_stage);
+  stamp.set_wall_ns(TraceStamps::Now());
+  return stamp;
+}
+
+//////////////////////////////////////////////////
+/// \brief Append a varint to a buffer.
+/// \param[in,out] _data Buffer to append to.
+/// \param[in] _value Value to encode.
+static void AppendVarint(std::string &_data, uint64_t _value)
+{
+  while (_value >= 0x80)
+  {
+    _data.push_back(static_cast<char>((_value & 0x7f) | 0x80));
+    _value >>= 7;
+  }
+  _data.push_back(static_cast<char>(_value));
+}
+
+//////////////////////////////////////////////////
+bool TraceStamps::Enabled()
+{
+  return g_enabled;
+}
+
+//////////////////////////////////////////////////
+void TraceStamps::SetEnabled(const bool _enabled)
+{
+  g_enabled = _enabled;
+}
+
+//////////////////////////////////////////////////
+int64_t TraceStamps::Now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+//////////////////////////////////////////////////
+void TraceStamps::Add(google::protobuf::Message &_msg,
+    const msgs::TraceStamp::Stage _stage)
+{
+  const msgs::TraceStamp stamp = MakeStamp(_stage);
+  const google::protobuf::Reflection *reflection = _msg.GetReflection();
+
+  const google::protobuf::FieldDescriptor *field =
+      _msg.GetDescriptor()->FindFieldByNumber(kField);
+  if (field && field->is_repeated() &&
+      field->message_type() == msgs::TraceStamp::descriptor())
+  {
+    reflection->AddMessage(&_msg, field)->CopyFrom(stamp);
+  }
+  else
+  {
+    reflection->MutableUnknownFields(&_msg)->AddLengthDelimited(kField,
+        stamp.SerializeAsString());
+  }
+}
+
+//////////////////////////////////////////////////
+void TraceStamps::Append(std::string &_data,
+    const msgs::TraceStamp::Stage _stage)
+{
+  const std::string stamp = MakeStamp(_stage).SerializeAsString();
+  AppendVarint(_data, WireFormatLite::MakeTag(kField,
+        WireFormatLite::WIRETYPE_LENGTH_DELIMITED));
+  AppendVarint(_data, stamp.size());
+  _data.append(stamp);
+}
+
+//////////////////////////////////////////////////
+std::vector<msgs::TraceStamp> TraceStamps::Read(const std::string &_data)
+{
+  std::vector<msgs::TraceStamp> stamps;
+  google::protobuf::io::CodedInputStream input(
+      reinterpret_cast<const uint8_t *>(_data.data()),
+      static_cast<int>(_data.size()));
+  // Images are larger than the default limit
+  input.SetTotalBytesLimit(std::numeric_limits<int>::max()
+#if GOOGLE_PROTOBUF_VERSION < 3006000
+      , -1
+#endif
+      );
+
+  const uint32_t stampTag = WireFormatLite::MakeTag(kField,
+      WireFormatLite::WIRETYPE_LENGTH_DELIMITED);
+  while (uint32_t tag = input.ReadTag())
+  {
+    if (tag != stampTag)
+    {
+      if (!WireFormatLite::SkipField(&input, tag))
+        return std::vector<msgs::TraceStamp>();
+      continue;
+    }
+
+    std::string bytes;
+    uint32_t size;
+    if (!input.ReadVarint32(&size) || !input.ReadString(&bytes, size))
+      return std::vector<msgs::TraceStamp>();
+
+    msgs::TraceStamp stamp;
+    if (stamp.ParseFromString(bytes))
+      stamps.push_back(stamp);
+  }
+
+  return stamps;
+}
+
+//////////////////////////////////////////////////
+std::string TraceStamps::StageName(const msgs::TraceStamp::Stage _stage)
+{
+  std::string name = msgs::TraceStamp::Stage_Name(_stage);
+  std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+  return name;
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_TRANSPORT_TRACESTAMPS_HH_
+#define GAZEBO_TRANSPORT_TRACESTAMPS_HH_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <google/protobuf/message.h>
+
+#include "gazebo/msgs/trace_stamp.pb.h"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace transport
+  {
+    /// \addtogroup gazebo_transport
+    /// \{
+
+    /// \class TraceStamps TraceStamps.hh transport/transport.hh
+    /// \brief Stamps messages with the wall time at which they pass each
+    /// stage between a sensor and a subscriber callback, to measure the
+    /// latency of the transport end to end.
+    ///
+    /// The stamps are msgs::TraceStamp messages in field 2047 of the
+    /// message. Messages that declare the field, like msgs::ImageStamped,
+    /// expose them to typed subscribers, other messages carry them as
+    /// unknown fields. Since protobuf merges repeated fields that are
+    /// concatenated, the transport stamps serialized messages by appending
+    /// to their data, without parsing them.
+    ///
+    /// Tracing is enabled when the GAZEBO_TRANSPORT_TRACE environment
+    /// variable is set to 1, in each process that should add stamps. The
+    /// wall clocks of the processes must agree, so latencies are only
+    /// meaningful on one host or between synchronized hosts.
+    class GZ_TRANSPORT_VISIBLE TraceStamps
+    {
+      /// \brief Field number of the stamps in a message.
+      public: static const int kField = 2047;
+
+      /// \brief Whether messages are stamped.
+      /// \return True if tracing is enabled.
+      public: static bool Enabled();
+
+      /// \brief Enable or disable tracing in this process.
+      /// \param[in] _enabled True to stamp messages.
+      public: static void SetEnabled(const bool _enabled);
+
+      /// \brief Get the current wall time.
+      /// \return Nanoseconds since the epoch.
+      public: static int64_t Now();
+
+      /// \brief Add a stamp with the current time to a message.
+      /// \param[in,out] _msg Message to stamp.
+      /// \param[in] _stage Stage the message is at.
+      public: static void Add(google::protobuf::Message &_msg,
+                              const msgs::TraceStamp::Stage _stage);
+
+      /// \brief Add a stamp with the current time to a serialized message.
+      /// \param[in,out] _data Serialized message to stamp.
+      /// \param[in] _stage Stage the message is at.
+      public: static void Append(std::string &_data,
+                                 const msgs::TraceStamp::Stage _stage);
+
+      /// \brief Read the stamps of a serialized message.
+      /// \param[in] _data Serialized message of any type.
+      /// \return The stamps, in the order they were added. Empty if the
+      /// message isn't stamped or can't be parsed.
+      public: static std::vector<msgs::TraceStamp> Read(
+                  const std::string &_data);
+
+      /// \brief Get the name of a stage.
+      /// \param[in] _stage The stage.
+      /// \return Lower case name, e.g. "socket_write".
+      public: static std::string StageName(
+                  const msgs::TraceStamp::Stage _stage);
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+#include <string>
+
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/transport/TraceStamps.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class TraceStamps : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(TraceStamps, AppendRead)
+{
+  msgs::Int msg;
+  msg.set_data(42);
+  std::string data;
+  ASSERT_TRUE(msg.SerializeToString(&data));
+  EXPECT_TRUE(transport::TraceStamps::Read(data).empty());
+
+  const int64_t before = transport::TraceStamps::Now();
+  transport::TraceStamps::Append(data, msgs::TraceStamp::ENQUEUE);
+  transport::TraceStamps::Append(data, msgs::TraceStamp::SOCKET_WRITE);
+
+  auto stamps = transport::TraceStamps::Read(data);
+  ASSERT_EQ(stamps.size(), 2u);
+  EXPECT_EQ(stamps[0].stage(), msgs::TraceStamp::ENQUEUE);
+  EXPECT_EQ(stamps[1].stage(), msgs::TraceStamp::SOCKET_WRITE);
+  EXPECT_GE(stamps[0].wall_ns(), before);
+  EXPECT_GE(stamps[1].wall_ns(), stamps[0].wall_ns());
+
+  // The stamps don't change the message
+  msgs::Int parsed;
+  ASSERT_TRUE(parsed.ParseFromString(data));
+  EXPECT_EQ(parsed.data(), 42);
+
+  EXPECT_TRUE(transport::TraceStamps::Read("garbage").empty());
+}
+
+/////////////////////////////////////////////////
+TEST_F(TraceStamps, AddDeclaredField)
+{
+  msgs::ImageStamped msg;
+  msgs::Set(msg.mutable_time(), common::Time(1, 0));
+  msg.mutable_image()->set_width(1);
+  msg.mutable_image()->set_height(1);
+  msg.mutable_image()->set_pixel_format(0);
+  msg.mutable_image()->set_step(1);
+  msg.mutable_image()->set_data("x");
+
+  transport::TraceStamps::Add(msg, msgs::TraceStamp::RENDER);
+  ASSERT_EQ(msg.trace_size(), 1);
+  EXPECT_EQ(msg.trace(0).stage(), msgs::TraceStamp::RENDER);
+
+  // Stamps appended to the data merge with the declared field
+  std::string data;
+  ASSERT_TRUE(msg.SerializeToString(&data));
+  transport::TraceStamps::Append(data, msgs::TraceStamp::RECEIVE);
+
+  msgs::ImageStamped parsed;
+  ASSERT_TRUE(parsed.ParseFromString(data));
+  ASSERT_EQ(parsed.trace_size(), 2);
+  EXPECT_EQ(parsed.trace(1).stage(), msgs::TraceStamp::RECEIVE);
+  EXPECT_EQ(parsed.image().data(), "x");
+}
+
+/////////////////////////////////////////////////
+TEST_F(TraceStamps, AddUnknownField)
+{
+  msgs::Int msg;
+  msg.set_data(7);
+  transport::TraceStamps::Add(msg, msgs::TraceStamp::PUBLISH);
+
+  std::string data;
+  ASSERT_TRUE(msg.SerializeToString(&data));
+  auto stamps = transport::TraceStamps::Read(data);
+  ASSERT_EQ(stamps.size(), 1u);
+  EXPECT_EQ(stamps[0].stage(), msgs::TraceStamp::PUBLISH);
+}
+
+/////////////////////////////////////////////////
+TEST_F(TraceStamps, Enabled)
+{
+  const bool enabled = transport::TraceStamps::Enabled();
+  transport::TraceStamps::SetEnabled(!enabled);
+  EXPECT_EQ(transport::TraceStamps::Enabled(), !enabled);
+  transport::TraceStamps::SetEnabled(enabled);
+
+  EXPECT_EQ(transport::TraceStamps::StageName(
+        msgs::TraceStamp::SOCKET_WRITE), "socket_write");
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -23,6 +23,7 @@
 #include "gazebo/transport/Node.hh"
 #include "gazebo/transport/Publisher.hh"
 #include "gazebo/transport/Subscriber.hh"
+#include "gazebo/transport/Connection.hh"
 #include "gazebo/transport/ConnectionManager.hh"
 #include "gazebo/transport/TransportIface.hh"
 
@@ -154,6 +155,12 @@ void transport::pause_incoming(bool _pause)
   transport::TopicManager::Instance()->PauseIncoming(_pause);
 }
 
+/////////////////////////////////////////////////
+std::vector<transport::IOThreadStats> transport::io_thread_stats()
+{
+  return transport::Connection::IOStats();
+}
+
 /////////////////////////////////////////////////
 void on_response(ConstResponsePtr &_msg)
 {
@@ -361,7 +368,7 @@ bool transport::getMinimalComms()
 /////////////////////////////////////////////////
 transport::ConnectionPtr transport::connectToMaster()
 {
-  std::string data, namespacesData, publishersData;
+  std::string data;
   msgs::Packet packet;
 
   std::string host;
@@ -375,10 +382,9 @@ transport::ConnectionPtr transport::connectToMaster()
   {
     try
     {
-      // Read the verification message
+      // Read the verification message. The master only sends its topic
+      // table to clients that ask for it.
       connection->Read(data);
-      connection->Read(namespacesData);
-      connection->Read(publishersData);
     }
     catch(...)
     {
@@ -25,7 +25,9 @@
 #include <string>
 #include <list>
 #include <map>
+#include <vector>
 
+#include "gazebo/transport/IOManager.hh"
 #include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/transport/SubscribeOptions.hh"
 #include "gazebo/transport/Node.hh"
@@ -95,6 +97,13 @@ namespace gazebo
     GZ_TRANSPORT_VISIBLE
     void pause_incoming(bool _pause);
 
+    /// \brief Get the load of the threads that read and write the
+    /// connections of this process. The number of threads is set with the
+    /// GAZEBO_IO_THREADS environment variable.
+    /// \return One entry per IO thread.
+    GZ_TRANSPORT_VISIBLE
+    std::vector<IOThreadStats> io_thread_stats();
+
     /// \brief Send a request and receive a response.  This call will block
     /// until a response is received.
     /// \param[in] _worldName The name of the world to which the request
@@ -17,6 +17,7 @@
 #ifndef GAZEBO_TRANSPORT_TRANSPORTTYPES_HH_
 #define GAZEBO_TRANSPORT_TRANSPORTTYPES_HH_
 
+#include <string>
 #include <boost/shared_ptr.hpp>
 // avoid collision from Mac OS X's ConditionalMacros.h
 // see gazebo issue #1289
@@ -44,6 +45,11 @@ namespace gazebo
     /// \brief Shared_ptr to protobuf message
     typedef boost::shared_ptr<google::protobuf::Message> MessagePtr;
 
+    /// \def MessageBufferPtr
+    /// \brief Shared_ptr to an immutable serialized message, shared by
+    /// every connection the message is written to.
+    typedef boost::shared_ptr<const std::string> MessageBufferPtr;
+
     /// \def PublisherPtr
     /// \brief Shared_ptr to Publisher object
     typedef boost::shared_ptr<Publisher> PublisherPtr;
@@ -0,0 +1,469 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <limits>
+#include <sstream>
+#include <vector>
+
+#include <boost/iostreams/copy.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/util/BinaryLog.hh"
+
+using namespace gazebo;
+using namespace util;
+
+/// \brief Magic string at the start of a binary log.
+static const char kFileMagic[] = "GZLOGBIN";
+
+/// \brief Magic string at the start of each chunk.
+static const char kChunkMagic[] = "GZCK";
+
+/// \brief Magic string at the start of the index.
+static const char kIndexMagic[] = "GZIX";
+
+/// \brief Magic string at the end of a log with an index.
+static const char kTrailerMagic[] = "GZLOGIDX";
+
+/// \brief Size of the fixed part of a chunk, before the columns.
+static const uint64_t kChunkHeaderSize = 16;
+
+/// \brief Nanoseconds in a second.
+static const int64_t kNsecPerSec = 1000000000;
+
+/// \brief Marks a frame without a sim time.
+static const int64_t kNoTime = -1;
+
+/// \brief Marks a frame without iterations.
+static const uint64_t kNoIterations = std::numeric_limits<uint64_t>::max();
+
+/////////////////////////////////////////////////
+/// \brief Append an unsigned integer in little endian order.
+/// \param[in,out] _out Bytes to append to.
+/// \param[in] _value Value to append.
+/// \param[in] _bytes Number of bytes of the value.
+static void AppendUint(std::string &_out, const uint64_t _value,
+    const unsigned int _bytes)
+{
+  for (unsigned int i = 0; i < _bytes; ++i)
+    _out.push_back(static_cast<char>((_value >> (8 * i)) & 0xff));
+}
+
+/////////////////////////////////////////////////
+/// \brief Read an unsigned integer stored in little endian order.
+/// \param[in] _in Stream to read from.
+/// \param[in] _bytes Number of bytes of the value.
+/// \param[out] _value Value read.
+/// \return False if the stream ended.
+static bool ReadUint(std::istream &_in, const unsigned int _bytes,
+    uint64_t &_value)
+{
+  unsigned char buffer[8];
+  if (!_in.read(reinterpret_cast<char *>(buffer), _bytes))
+    return false;
+
+  _value = 0;
+  for (unsigned int i = 0; i < _bytes; ++i)
+    _value |= static_cast<uint64_t>(buffer[i]) << (8 * i);
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Convert a sim time to nanoseconds.
+/// \param[in] _time Sim time.
+/// \return Nanoseconds.
+static int64_t ToNsec(const common::Time &_time)
+{
+  return static_cast<int64_t>(_time.sec) * kNsecPerSec + _time.nsec;
+}
+
+/////////////////////////////////////////////////
+/// \brief Convert nanoseconds to a sim time.
+/// \param[in] _nsec Nanoseconds.
+/// \return Sim time.
+static common::Time FromNsec(const int64_t _nsec)
+{
+  return common::Time(static_cast<int32_t>(_nsec / kNsecPerSec),
+                      static_cast<int32_t>(_nsec % kNsecPerSec));
+}
+
+/////////////////////////////////////////////////
+/// \brief Check the magic string at the current position of a stream.
+/// \param[in] _in Stream to read from.
+/// \param[in] _magic Expected magic string.
+/// \param[in] _size Size of the magic string.
+/// \return True if the stream holds the magic string.
+static bool ReadMagic(std::istream &_in, const char *_magic,
+    const size_t _size)
+{
+  std::string magic(_size, '\0');
+  return _in.read(&magic[0], _size) && magic == std::string(_magic, _size);
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the text of an element in a frame.
+/// \param[in] _frame The frame.
+/// \param[in] _tag Name of the element.
+/// \param[out] _text Text of the first such element.
+/// \return False if the frame has no such element.
+static bool ElementText(const std::string &_frame, const std::string &_tag,
+    std::string &_text)
+{
+  const std::string startTag = "<" + _tag + ">";
+  const std::string endTag = "</" + _tag + ">";
+
+  auto from = _frame.find(startTag);
+  if (from == std::string::npos)
+    return false;
+  from += startTag.size();
+
+  auto to = _frame.find(endTag, from);
+  if (to == std::string::npos)
+    return false;
+
+  _text = _frame.substr(from, to - from);
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::string BinaryLog::EncodeHeader(const std::string &_header)
+{
+  std::string out(kFileMagic, sizeof(kFileMagic) - 1);
+  AppendUint(out, _header.size(), 4);
+  out.append(_header);
+  return out;
+}
+
+/////////////////////////////////////////////////
+std::string BinaryLog::EncodeChunk(const std::string &_frames,
+    ChunkInfo *_info)
+{
+  const std::string startFrame = "<sdf ";
+  const std::string endFrame = "</sdf>";
+
+  // Build the columns, the time and iterations are only searched for
+  // once here instead of on every seek of every replay
+  std::vector<int64_t> times;
+  std::vector<uint64_t> iterations;
+  std::vector<uint32_t> offsets;
+  ChunkInfo info;
+
+  size_t from = _frames.find(startFrame);
+  while (from != std::string::npos)
+  {
+    size_t to = _frames.find(endFrame, from);
+    if (to == std::string::npos)
+      break;
+    to += endFrame.size();
+
+    const std::string frame = _frames.substr(from, to - from);
+
+    std::string text;
+    int64_t time = kNoTime;
+    if (ElementText(frame, "sim_time", text))
+    {
+      common::Time simTime;
+      std::istringstream stream(text);
+      stream >> simTime;
+      time = ToNsec(simTime);
+
+      if (!info.hasTime)
+        info.firstTime = simTime;
+      info.lastTime = simTime;
+      info.hasTime = true;
+    }
+    times.push_back(time);
+
+    uint64_t iters = kNoIterations;
+    if (ElementText(frame, "iterations", text))
+    {
+      std::istringstream stream(text);
+      stream >> iters;
+
+      if (!info.hasIterations)
+        info.firstIterations = iters;
+      info.hasIterations = true;
+    }
+    iterations.push_back(iters);
+
+    offsets.push_back(from);
+    from = _frames.find(startFrame, to);
+  }
+
+  if (offsets.empty())
+    return std::string();
+
+  std::string payload;
+  {
+    boost::iostreams::filtering_ostream out;
+    out.push(boost::iostreams::zlib_compressor());
+    out.push(std::back_inserter(payload));
+    boost::iostreams::copy(boost::make_iterator_range(_frames), out);
+  }
+
+  std::string out(kChunkMagic, sizeof(kChunkMagic) - 1);
+  AppendUint(out, offsets.size(), 4);
+  AppendUint(out, payload.size(), 8);
+  for (auto time : times)
+    AppendUint(out, static_cast<uint64_t>(time), 8);
+  for (auto iters : iterations)
+    AppendUint(out, iters, 8);
+  for (auto offset : offsets)
+    AppendUint(out, offset, 4);
+
+  if (_info)
+  {
+    info.offset = out.size();
+    info.size = payload.size();
+    info.frameCount = offsets.size();
+    *_info = info;
+  }
+
+  out.append(payload);
+  return out;
+}
+
+/////////////////////////////////////////////////
+std::string BinaryLog::EncodeIndex(const std::vector<ChunkInfo> &_chunks,
+    const uint64_t _offset)
+{
+  std::string out(kIndexMagic, sizeof(kIndexMagic) - 1);
+  AppendUint(out, _chunks.size(), 4);
+  for (const auto &info : _chunks)
+  {
+    AppendUint(out, info.start, 8);
+    AppendUint(out, info.offset, 8);
+    AppendUint(out, info.size, 8);
+    AppendUint(out, info.frameCount, 4);
+    AppendUint(out, (info.hasTime ? 1u : 0u) | (info.hasIterations ? 2u : 0u),
+        1);
+    AppendUint(out, static_cast<uint64_t>(ToNsec(info.firstTime)), 8);
+    AppendUint(out, static_cast<uint64_t>(ToNsec(info.lastTime)), 8);
+    AppendUint(out, info.firstIterations, 8);
+  }
+
+  AppendUint(out, _offset, 8);
+  out.append(kTrailerMagic, sizeof(kTrailerMagic) - 1);
+  return out;
+}
+
+/////////////////////////////////////////////////
+bool BinaryLog::ReadHeader(std::istream &_in, std::string &_header)
+{
+  if (!ReadMagic(_in, kFileMagic, sizeof(kFileMagic) - 1))
+    return false;
+
+  uint64_t size;
+  if (!ReadUint(_in, 4, size))
+    return false;
+
+  _header.resize(size);
+  return size == 0 || static_cast<bool>(_in.read(&_header[0], size));
+}
+
+/////////////////////////////////////////////////
+bool BinaryLog::ReadIndex(std::istream &_in, std::vector<ChunkInfo> &_chunks)
+{
+  const std::streamoff trailerSize = 8 + sizeof(kTrailerMagic) - 1;
+
+  _in.clear();
+  _in.seekg(0, std::ios::end);
+  const std::streamoff fileSize = _in.tellg();
+  if (!_in || fileSize < trailerSize)
+    return false;
+
+  uint64_t offset;
+  _in.seekg(fileSize - trailerSize);
+  if (!ReadUint(_in, 8, offset) ||
+      !ReadMagic(_in, kTrailerMagic, sizeof(kTrailerMagic) - 1) ||
+      offset >= static_cast<uint64_t>(fileSize))
+  {
+    _in.clear();
+    return false;
+  }
+
+  _in.seekg(offset);
+  uint64_t count;
+  if (!ReadMagic(_in, kIndexMagic, sizeof(kIndexMagic) - 1) ||
+      !ReadUint(_in, 4, count))
+  {
+    _in.clear();
+    return false;
+  }
+
+  _chunks.clear();
+  _chunks.reserve(count);
+  for (uint64_t i = 0; i < count; ++i)
+  {
+    ChunkInfo info;
+    uint64_t frameCount, flags, firstTime, lastTime;
+    if (!ReadUint(_in, 8, info.start) || !ReadUint(_in, 8, info.offset) ||
+        !ReadUint(_in, 8, info.size) || !ReadUint(_in, 4, frameCount) ||
+        !ReadUint(_in, 1, flags) || !ReadUint(_in, 8, firstTime) ||
+        !ReadUint(_in, 8, lastTime) || !ReadUint(_in, 8, info.firstIterations))
+    {
+      _in.clear();
+      _chunks.clear();
+      return false;
+    }
+
+    info.frameCount = frameCount;
+    info.hasTime = (flags & 1u) != 0;
+    info.hasIterations = (flags & 2u) != 0;
+    info.firstTime = FromNsec(static_cast<int64_t>(firstTime));
+    info.lastTime = FromNsec(static_cast<int64_t>(lastTime));
+    _chunks.push_back(info);
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool BinaryLog::ReadChunkInfo(std::istream &_in, ChunkInfo &_info)
+{
+  const std::streamoff start = _in.tellg();
+
+  std::string magic(sizeof(kChunkMagic) - 1, '\0');
+  if (!_in.read(&magic[0], magic.size()))
+    return false;
+
+  // The index follows the last chunk
+  if (magic == std::string(kIndexMagic, sizeof(kIndexMagic) - 1))
+    return false;
+
+  if (magic != std::string(kChunkMagic, sizeof(kChunkMagic) - 1))
+  {
+    gzerr << "Invalid chunk in binary log file\n";
+    return false;
+  }
+
+  uint64_t frameCount, size;
+  if (!ReadUint(_in, 4, frameCount) || !ReadUint(_in, 8, size))
+    return false;
+
+  _info = ChunkInfo();
+  _info.start = start;
+  _info.frameCount = frameCount;
+  _info.size = size;
+
+  for (uint64_t i = 0; i < frameCount; ++i)
+  {
+    uint64_t value;
+    if (!ReadUint(_in, 8, value))
+      return false;
+
+    int64_t time = static_cast<int64_t>(value);
+    if (time == kNoTime)
+      continue;
+
+    if (!_info.hasTime)
+      _info.firstTime = FromNsec(time);
+    _info.lastTime = FromNsec(time);
+    _info.hasTime = true;
+  }
+
+  for (uint64_t i = 0; i < frameCount; ++i)
+  {
+    uint64_t value;
+    if (!ReadUint(_in, 8, value))
+      return false;
+
+    if (value != kNoIterations && !_info.hasIterations)
+    {
+      _info.firstIterations = value;
+      _info.hasIterations = true;
+    }
+  }
+
+  // The frame offsets are only needed when seeking, see ReadFrames
+  _in.seekg(frameCount * 4, std::ios::cur);
+  _info.offset = _in.tellg();
+
+  // Make sure the whole payload was written
+  _in.seekg(0, std::ios::end);
+  if (!_in || static_cast<uint64_t>(_in.tellg()) < _info.offset + size)
+    return false;
+
+  _in.seekg(_info.offset + size);
+  return static_cast<bool>(_in);
+}
+
+/////////////////////////////////////////////////
+bool BinaryLog::ReadFrames(std::istream &_in, const ChunkInfo &_info,
+    std::vector<FrameInfo> &_frames)
+{
+  _frames.assign(_info.frameCount, FrameInfo());
+
+  _in.clear();
+  _in.seekg(_info.start + kChunkHeaderSize);
+  for (auto &frame : _frames)
+  {
+    uint64_t value;
+    if (!ReadUint(_in, 8, value))
+      return false;
+
+    int64_t time = static_cast<int64_t>(value);
+    frame.hasTime = time != kNoTime;
+    if (frame.hasTime)
+      frame.time = FromNsec(time);
+  }
+
+  _in.seekg(_info.frameCount * 8, std::ios::cur);
+  for (auto &frame : _frames)
+  {
+    uint64_t value;
+    if (!ReadUint(_in, 4, value))
+      return false;
+    frame.offset = value;
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool BinaryLog::ReadChunk(std::istream &_in, const ChunkInfo &_info,
+    std::string &_frames)
+{
+  std::string payload(_info.size, '\0');
+
+  _in.clear();
+  _in.seekg(_info.offset);
+  if (_info.size > 0 && !_in.read(&payload[0], _info.size))
+  {
+    gzerr << "Unable to read chunk of binary log file\n";
+    return false;
+  }
+
+  _frames.clear();
+  try
+  {
+    boost::iostreams::filtering_ostream out;
+    out.push(boost::iostreams::zlib_decompressor());
+    out.push(std::back_inserter(_frames));
+    boost::iostreams::copy(boost::make_iterator_range(payload), out);
+  }
+  catch(boost::iostreams::zlib_error &_e)
+  {
+    gzerr << "Unable to decompress chunk of binary log file: "
+          << _e.what() << "\n";
+    return false;
+  }
+
+  return true;
+}
@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef _GAZEBO_UTIL_BINARYLOG_HH_
+#define _GAZEBO_UTIL_BINARYLOG_HH_
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace util
+  {
+    /// \internal
+    /// \brief Reads and writes state logs recorded with the "binary"
+    /// encoding.
+    ///
+    /// The file starts with an 8 byte magic string and the same XML
+    /// header as other logs. It is followed by chunks, each one holding
+    /// the frames of one LogRecord update:
+    ///
+    ///   "GZCK", frame count (u32), payload size (u64)
+    ///   sim time of each frame in nanoseconds (i64, -1 if none)
+    ///   iterations of each frame (u64, max if none)
+    ///   offset of each frame in the uncompressed payload (u32)
+    ///   payload: the frames, zlib compressed
+    ///
+    /// A log that was stopped cleanly ends with an index of its chunks:
+    ///
+    ///   "GZIX", chunk count (u32)
+    ///   for each chunk: start, payload offset and payload size (u64),
+    ///   frame count (u32), flags (u8), first and last sim time (i64),
+    ///   first iterations (u64)
+    ///   offset of the index (u64), "GZLOGIDX"
+    ///
+    /// All integers are little endian. The columns and the index let a
+    /// reader open the file and seek to any frame without decompressing
+    /// more than the chunk holding it.
+    class GZ_UTIL_VISIBLE BinaryLog
+    {
+      /// \brief Summary of a chunk, read from its columns.
+      public: class ChunkInfo
+      {
+        /// \brief Offset of the chunk in the file.
+        public: uint64_t start = 0;
+
+        /// \brief Offset of the compressed payload in the file.
+        public: uint64_t offset = 0;
+
+        /// \brief Size of the compressed payload.
+        public: uint64_t size = 0;
+
+        /// \brief Number of frames.
+        public: uint32_t frameCount = 0;
+
+        /// \brief True if at least one frame has a sim time.
+        public: bool hasTime = false;
+
+        /// \brief Sim time of the first frame that has one.
+        public: common::Time firstTime;
+
+        /// \brief Sim time of the last frame that has one.
+        public: common::Time lastTime;
+
+        /// \brief True if at least one frame has iterations.
+        public: bool hasIterations = false;
+
+        /// \brief Iterations of the first frame that has them.
+        public: uint64_t firstIterations = 0;
+      };
+
+      /// \brief Position and time of a frame in its chunk.
+      public: class FrameInfo
+      {
+        /// \brief True if the frame has a sim time.
+        public: bool hasTime = false;
+
+        /// \brief Sim time of the frame.
+        public: common::Time time;
+
+        /// \brief Offset of the frame in the uncompressed payload.
+        public: uint32_t offset = 0;
+      };
+
+      /// \brief Encode the start of a binary log.
+      /// \param[in] _header Complete XML document holding the header.
+      /// \return Bytes to write at the start of the file.
+      public: static std::string EncodeHeader(const std::string &_header);
+
+      /// \brief Encode frames into a chunk.
+      /// \param[in] _frames Concatenated <sdf> frames.
+      /// \param[out] _info If not null, summary of the chunk with offsets
+      /// relative to the start of the chunk.
+      /// \return Bytes of the chunk, empty if there are no frames.
+      public: static std::string EncodeChunk(const std::string &_frames,
+                  ChunkInfo *_info = nullptr);
+
+      /// \brief Encode the index written at the end of a log.
+      /// \param[in] _chunks Summary of every chunk, with file offsets.
+      /// \param[in] _offset Offset of the index in the file.
+      /// \return Bytes to write at the end of the file.
+      public: static std::string EncodeIndex(
+                  const std::vector<ChunkInfo> &_chunks,
+                  const uint64_t _offset);
+
+      /// \brief Read the start of a binary log.
+      /// \param[in] _in Stream positioned at the start of the file.
+      /// \param[out] _header XML document holding the header.
+      /// \return False if the stream is not a binary log.
+      public: static bool ReadHeader(std::istream &_in, std::string &_header);
+
+      /// \brief Read the index at the end of a log.
+      /// \param[in] _in Stream of the file.
+      /// \param[out] _chunks Summary of every chunk.
+      /// \return False if the log has no index, which happens when
+      /// recording was interrupted.
+      public: static bool ReadIndex(std::istream &_in,
+                  std::vector<ChunkInfo> &_chunks);
+
+      /// \brief Read the columns of the next chunk and skip its payload.
+      /// \param[in] _in Stream positioned at the start of a chunk.
+      /// \param[out] _info Summary of the chunk.
+      /// \return False at the end of the chunks, or if the chunk is
+      /// incomplete, which happens when recording was interrupted.
+      public: static bool ReadChunkInfo(std::istream &_in,
+                  ChunkInfo &_info);
+
+      /// \brief Read the time and position of every frame of a chunk.
+      /// \param[in] _in Stream of the file.
+      /// \param[in] _info Summary of the chunk.
+      /// \param[out] _frames Time and position of each frame.
+      /// \return False if the columns could not be read.
+      public: static bool ReadFrames(std::istream &_in,
+                  const ChunkInfo &_info, std::vector<FrameInfo> &_frames);
+
+      /// \brief Read and decompress the frames of a chunk.
+      /// \param[in] _in Stream of the file.
+      /// \param[in] _info Summary of the chunk.
+      /// \param[out] _frames Concatenated <sdf> frames.
+      /// \return False if the payload could not be read.
+      public: static bool ReadChunk(std::istream &_in,
+                  const ChunkInfo &_info, std::string &_frames);
+    };
+  }
+}
+#endif
@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/util/BinaryLog.hh"
+#include "gazebo/util/LogPlay.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class BinaryLog_TEST : public gazebo::testing::AutoLogFixture { };
+
+/// \brief Header of the test logs.
+static const char kHeader[] =
+  "<?xml version='1.0'?>\n<gazebo_log>\n<header>\n"
+  "<log_version>1.0</log_version>\n"
+  "<gazebo_version>11.0.0</gazebo_version>\n"
+  "<rand_seed>1</rand_seed>\n</header>\n</gazebo_log>\n";
+
+/////////////////////////////////////////////////
+/// \brief Make a state frame.
+/// \param[in] _sec Sim time seconds.
+/// \param[in] _iterations Iterations.
+/// \return The frame.
+static std::string Frame(const int _sec, const int _iterations)
+{
+  std::ostringstream stream;
+  stream << "<sdf version='1.6'><state world='default'><sim_time>" << _sec
+         << " 5</sim_time><iterations>" << _iterations
+         << "</iterations></state></sdf>";
+  return stream.str();
+}
+
+/////////////////////////////////////////////////
+TEST_F(BinaryLog_TEST, RoundTrip)
+{
+  const std::string world = "<sdf version ='1.6'>\n<world/></sdf>\n";
+  const std::string first = world + Frame(1, 1000);
+  const std::string second = Frame(2, 2000) + Frame(3, 3000);
+
+  std::stringstream stream;
+  stream << util::BinaryLog::EncodeHeader(kHeader)
+         << util::BinaryLog::EncodeChunk(first)
+         << util::BinaryLog::EncodeChunk(second);
+
+  std::string header;
+  ASSERT_TRUE(util::BinaryLog::ReadHeader(stream, header));
+  EXPECT_EQ(kHeader, header);
+
+  util::BinaryLog::ChunkInfo info1, info2, info3;
+  ASSERT_TRUE(util::BinaryLog::ReadChunkInfo(stream, info1));
+  ASSERT_TRUE(util::BinaryLog::ReadChunkInfo(stream, info2));
+  EXPECT_FALSE(util::BinaryLog::ReadChunkInfo(stream, info3));
+
+  // The world frame has no time
+  EXPECT_EQ(2u, info1.frameCount);
+  EXPECT_TRUE(info1.hasTime);
+  EXPECT_EQ(common::Time(1, 5), info1.firstTime);
+  EXPECT_EQ(common::Time(1, 5), info1.lastTime);
+  EXPECT_TRUE(info1.hasIterations);
+  EXPECT_EQ(1000u, info1.firstIterations);
+
+  EXPECT_EQ(2u, info2.frameCount);
+  EXPECT_EQ(common::Time(2, 5), info2.firstTime);
+  EXPECT_EQ(common::Time(3, 5), info2.lastTime);
+
+  std::string frames;
+  EXPECT_TRUE(util::BinaryLog::ReadChunk(stream, info2, frames));
+  EXPECT_EQ(second, frames);
+  EXPECT_TRUE(util::BinaryLog::ReadChunk(stream, info1, frames));
+  EXPECT_EQ(first, frames);
+
+  // Not a binary log
+  std::stringstream xml(kHeader);
+  EXPECT_FALSE(util::BinaryLog::ReadHeader(xml, header));
+}
+
+/////////////////////////////////////////////////
+TEST_F(BinaryLog_TEST, Play)
+{
+  boost::filesystem::path path = boost::filesystem::temp_directory_path() /
+    boost::filesystem::unique_path("gazebo_binary_log_%%%%%%.log");
+
+  {
+    std::ofstream out(path.string(), std::ios::out | std::ios::binary);
+    out << util::BinaryLog::EncodeHeader(kHeader)
+        << util::BinaryLog::EncodeChunk(
+            "<sdf version ='1.6'>\n<world/></sdf>\n" + Frame(1, 1000))
+        << util::BinaryLog::EncodeChunk(Frame(2, 2000) + Frame(3, 3000));
+
+    // A chunk cut short by an interrupted recording is ignored
+    std::string last = util::BinaryLog::EncodeChunk(Frame(4, 4000));
+    out << last.substr(0, last.size() / 2);
+  }
+
+  util::LogPlay *player = util::LogPlay::Instance();
+  ASSERT_NO_THROW(player->Open(path.string()));
+  EXPECT_TRUE(player->IsOpen());
+  EXPECT_EQ("binary", player->Encoding());
+  EXPECT_EQ(2u, player->ChunkCount());
+  EXPECT_EQ(common::Time(1, 5), player->LogStartTime());
+  EXPECT_EQ(common::Time(3, 5), player->LogEndTime());
+  EXPECT_TRUE(player->HasIterations());
+  EXPECT_EQ(1000u, player->InitialIterations());
+
+  std::string frame;
+  EXPECT_TRUE(player->Rewind());
+  EXPECT_TRUE(player->Step(frame));
+  EXPECT_EQ(Frame(1, 1000), frame);
+  EXPECT_TRUE(player->Step(frame));
+  EXPECT_EQ(Frame(2, 2000), frame);
+  EXPECT_TRUE(player->Step(frame));
+  EXPECT_EQ(Frame(3, 3000), frame);
+  EXPECT_FALSE(player->Step(frame));
+
+  EXPECT_TRUE(player->StepBack(frame));
+  EXPECT_EQ(Frame(2, 2000), frame);
+
+  // Seek lands on the last frame before the time
+  EXPECT_TRUE(player->Seek(common::Time(2, 6)));
+  EXPECT_TRUE(player->Step(frame));
+  EXPECT_EQ(Frame(3, 3000), frame);
+
+  boost::filesystem::remove(path);
+}
+
+/////////////////////////////////////////////////
+TEST_F(BinaryLog_TEST, Index)
+{
+  boost::filesystem::path path = boost::filesystem::temp_directory_path() /
+    boost::filesystem::unique_path("gazebo_binary_log_%%%%%%.log");
+
+  // Write the log the way LogRecord does
+  std::string data = util::BinaryLog::EncodeHeader(kHeader);
+  std::vector<util::BinaryLog::ChunkInfo> chunks;
+  for (const auto &frames : {
+      "<sdf version ='1.6'>\n<world/></sdf>\n" + Frame(1, 1000),
+      Frame(2, 2000) + Frame(3, 3000), Frame(4, 4000)})
+  {
+    util::BinaryLog::ChunkInfo info;
+    std::string chunk = util::BinaryLog::EncodeChunk(frames, &info);
+    info.start = data.size();
+    info.offset += info.start;
+    chunks.push_back(info);
+    data += chunk;
+  }
+  data += util::BinaryLog::EncodeIndex(chunks, data.size());
+
+  {
+    std::ofstream out(path.string(), std::ios::out | std::ios::binary);
+    out << data;
+  }
+
+  std::stringstream stream(data);
+  std::vector<util::BinaryLog::ChunkInfo> index;
+  ASSERT_TRUE(util::BinaryLog::ReadIndex(stream, index));
+  ASSERT_EQ(chunks.size(), index.size());
+  for (size_t i = 0; i < chunks.size(); ++i)
+  {
+    EXPECT_EQ(chunks[i].start, index[i].start);
+    EXPECT_EQ(chunks[i].offset, index[i].offset);
+    EXPECT_EQ(chunks[i].size, index[i].size);
+    EXPECT_EQ(chunks[i].frameCount, index[i].frameCount);
+    EXPECT_EQ(chunks[i].firstTime, index[i].firstTime);
+    EXPECT_EQ(chunks[i].lastTime, index[i].lastTime);
+    EXPECT_EQ(chunks[i].firstIterations, index[i].firstIterations);
+  }
+
+  // The columns give the position of every frame
+  std::vector<util::BinaryLog::FrameInfo> frames;
+  ASSERT_TRUE(util::BinaryLog::ReadFrames(stream, index[1], frames));
+  ASSERT_EQ(2u, frames.size());
+  EXPECT_EQ(0u, frames[0].offset);
+  EXPECT_EQ(Frame(2, 2000).size(), frames[1].offset);
+  EXPECT_EQ(common::Time(3, 5), frames[1].time);
+
+  util::LogPlay *player = util::LogPlay::Instance();
+  ASSERT_NO_THROW(player->Open(path.string()));
+  EXPECT_EQ(3u, player->ChunkCount());
+  EXPECT_EQ(common::Time(4, 5), player->LogEndTime());
+
+  std::string frame;
+  EXPECT_TRUE(player->Seek(common::Time(3, 0)));
+  EXPECT_TRUE(player->Step(frame));
+  EXPECT_EQ(Frame(3, 3000), frame);
+  EXPECT_TRUE(player->Step(frame));
+  EXPECT_EQ(Frame(4, 4000), frame);
+
+  // Before the first frame
+  EXPECT_TRUE(player->Seek(common::Time(0, 0)));
+  EXPECT_TRUE(player->Step(frame));
+  EXPECT_EQ(Frame(1, 1000), frame);
+
+  boost::filesystem::remove(path);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -14,9 +14,14 @@
  * limitations under the License.
  *
  */
+#include <algorithm>
 #include <functional>
+#include <map>
+#include <memory>
 #include <set>
 #include <string>
+#include <utility>
+#include <vector>
 #include <ignition/math/Rand.hh>
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
@@ -114,6 +119,7 @@ bool IntrospectionManager::Register(const std::string &_item,
   this->dataPtr->allItems[_item] = _cb;
 
   this->dataPtr->itemsUpdated = true;
+  this->dataPtr->planDirty = true;
 
   return true;
 }
@@ -135,6 +141,7 @@ bool IntrospectionManager::Unregister(const std::string &_item)
   this->dataPtr->allItems.erase(_item);
 
   this->dataPtr->itemsUpdated = true;
+  this->dataPtr->planDirty = true;
 
   return true;
 }
@@ -146,6 +153,7 @@ void IntrospectionManager::Clear()
   this->dataPtr->allItemsKeys.clear();
   this->dataPtr->allItems.clear();
   this->dataPtr->itemsUpdated = true;
+  this->dataPtr->planDirty = true;
 }
 
 //////////////////////////////////////////////////
@@ -164,110 +172,163 @@ std::set<std::string> IntrospectionManager::Items() const
 //////////////////////////////////////////////////
 void IntrospectionManager::Update()
 {
-  std::map<std::string, IntrospectionFilter> filtersCopy;
-  std::map<std::string, ObservedItem> observedItemsCopy;
-  std::map<std::string, std::function <gazebo::msgs::Any ()>> usedItemsCopy;
+  if (++this->dataPtr->skippedUpdates < this->dataPtr->updatePeriod)
+    return;
+  this->dataPtr->skippedUpdates = 0;
 
+  std::shared_ptr<const IntrospectionPlan> plan;
   {
     std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (this->dataPtr->planDirty)
+      this->CompilePlan();
+    plan = this->dataPtr->plan;
+  }
 
-    filtersCopy = this->dataPtr->filters;
-    observedItemsCopy = this->dataPtr->observedItems;
-
-    for (const auto &observedItem: this->dataPtr->observedItems)
+  // Size the buffers once per plan, the item names never change after
+  if (this->dataPtr->bufferVersion != plan->version)
+  {
+    this->dataPtr->values.assign(plan->callbacks.size(), gazebo::msgs::Any());
+    this->dataPtr->filterMsgs.resize(plan->filters.size());
+    for (size_t i = 0; i < plan->filters.size(); ++i)
     {
-      auto &item = observedItem.first;
-      // Sanity check: Make sure that someone registered this item.
-      if (this->dataPtr->allItemsKeys.count(item) == 0)
-      {
-        continue;
-      }
-
-      usedItemsCopy[item] = this->dataPtr->allItems[item];
+      auto &msg = this->dataPtr->filterMsgs[i];
+      msg.Clear();
+      for (auto const index : plan->filters[i].items)
+        msg.add_param()->set_name(plan->names[index]);
     }
+    this->dataPtr->bufferVersion = plan->version;
+  }
+
+  // Only evaluate the items of filters that somebody listens to.
+  auto &evaluated = this->dataPtr->evaluated;
+  evaluated.assign(plan->callbacks.size(), false);
+  for (auto const &filter : plan->filters)
+  {
+    if (!filter.pub.HasConnections())
+      continue;
 
-    for (auto& filter: filtersCopy)
+    for (auto const index : filter.items)
     {
-      for (auto const &item : filter.second.items)
+      if (evaluated[index])
+        continue;
+      evaluated[index] = true;
+
+      auto &value = this->dataPtr->values[index];
+      try
       {
-        // Sanity check: Make sure that someone registered this item.
-        if (this->dataPtr->allItemsKeys.count(item) == 0)
-        {
-          continue;
-        }
-        usedItemsCopy[item] = this->dataPtr->allItems[item];
+        value = plan->callbacks[index]();
+      }
+      catch(...)
+      {
+        gzerr << "Exception caught calling user callback" << std::endl;
+        value.Clear();
       }
     }
   }
 
-  for (auto &observedItem : observedItemsCopy)
+  // Prepare and publish the next message of each filter.
+  for (size_t i = 0; i < plan->filters.size(); ++i)
   {
-    auto &item = observedItem.first;
-    auto itemIter = usedItemsCopy.find(item);
-
-    // Sanity check: Make sure that we can update the item.
-    if (itemIter == usedItemsCopy.end())
+    auto const &filter = plan->filters[i];
+    if (!filter.pub.HasConnections())
       continue;
 
-    try
+    auto &nextMsg = this->dataPtr->filterMsgs[i];
+    bool complete = true;
+    for (size_t j = 0; j < filter.items.size(); ++j)
     {
-      // Update the values of the items under observation.
-      gazebo::msgs::Any value = itemIter->second();
-      auto &lastValue = observedItem.second.lastValue;
-      lastValue.CopyFrom(value);
+      auto const &value = this->dataPtr->values[filter.items[j]];
+      if (value.type() == gazebo::msgs::Any::NONE)
+        complete = false;
+      else
+        nextMsg.mutable_param(j)->mutable_value()->CopyFrom(value);
     }
-    catch(...)
-    {
-      gzerr << "Exception caught calling user callback" << std::endl;
-      continue;
-    }
-  }
-
-  // Prepare the next message to be sent in each filter.
-  for (auto &filter : filtersCopy)
-  {
-    // First of all, clear the old message.
-    auto &nextMsg = filter.second.msg;
-    nextMsg.Clear();
 
-    // Insert the last value of each item under observation for this filter.
-    for (auto const &item : filter.second.items)
+    // Leave out the items whose callback failed (rare, so it's fine to
+    // build a new message).
+    gazebo::msgs::Param_V partialMsg;
+    if (!complete)
     {
-      // Sanity check: Make sure that someone registered this item.
-      if (usedItemsCopy.find(item) == usedItemsCopy.end())
-        continue;
+      for (size_t j = 0; j < filter.items.size(); ++j)
+      {
+        auto const &value = this->dataPtr->values[filter.items[j]];
+        if (value.type() != gazebo::msgs::Any::NONE)
+          partialMsg.add_param()->CopyFrom(nextMsg.param(j));
+      }
 
-      // Sanity check: Make sure that the value was updated.
-      // (e.g.: an exception was not raised).
-      auto &lastValue = observedItemsCopy[item].lastValue;
-      if (lastValue.type() == gazebo::msgs::Any::NONE)
+      // Sanity check: Make sure that we have at least one item updated.
+      if (partialMsg.param_size() == 0)
         continue;
+    }
 
-      auto nextParam = nextMsg.add_param();
-      nextParam->set_name(item);
-      nextParam->mutable_value()->CopyFrom(lastValue);
+    // Publishers are shared handles, publish through a copy since the plan
+    // is const
+    auto pub = filter.pub;
+    if (!pub.Publish(complete ? nextMsg : partialMsg))
+    {
+      gzerr << "Error publishing update for topic [" << filter.topic << "]"
+        << std::endl;
     }
+  }
 
-    // Sanity check: Make sure that we have at least one item updated.
-    if (nextMsg.param_size() == 0)
-      continue;
+  this->NotifyUpdates();
+}
 
-    // Publish the update for this filter.
+//////////////////////////////////////////////////
+void IntrospectionManager::CompilePlan()
+{
+  std::shared_ptr<IntrospectionPlan> plan(new IntrospectionPlan);
+  if (this->dataPtr->plan)
+    plan->version = this->dataPtr->plan->version + 1;
+  else
+    plan->version = 1;
+
+  std::map<std::string, size_t> indices;
+  for (auto const &filter : this->dataPtr->filters)
+  {
     std::string topicName = this->dataPtr->prefix + "filter/" + filter.first;
+    auto pubIter = this->dataPtr->filterPubs.find(topicName);
+    if (pubIter == this->dataPtr->filterPubs.end())
+      continue;
 
+    IntrospectionPlan::Filter planFilter;
+    planFilter.pub = pubIter->second;
+    planFilter.topic = topicName;
+    for (auto const &item : filter.second.items)
     {
-      std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-      if (this->dataPtr->filterPubs.find(topicName) ==
-          this->dataPtr->filterPubs.end() ||
-          !this->dataPtr->filterPubs[topicName].Publish(nextMsg))
+      // Sanity check: Make sure that someone registered this item.
+      auto itemIter = this->dataPtr->allItems.find(item);
+      if (itemIter == this->dataPtr->allItems.end())
+        continue;
+
+      auto index = indices.find(item);
+      if (index == indices.end())
       {
-        gzerr << "Error publishing update for topic [" << topicName << "]"
-          << std::endl;
+        index = indices.emplace(item, plan->names.size()).first;
+        plan->names.push_back(item);
+        plan->callbacks.push_back(itemIter->second);
       }
+      planFilter.items.push_back(index->second);
     }
+
+    if (!planFilter.items.empty())
+      plan->filters.push_back(std::move(planFilter));
   }
 
-  this->NotifyUpdates();
+  this->dataPtr->plan = plan;
+  this->dataPtr->planDirty = false;
+}
+
+//////////////////////////////////////////////////
+void IntrospectionManager::SetUpdatePeriod(const unsigned int _period)
+{
+  this->dataPtr->updatePeriod = std::max(1u, _period);
+}
+
+//////////////////////////////////////////////////
+unsigned int IntrospectionManager::UpdatePeriod() const
+{
+  return this->dataPtr->updatePeriod;
 }
 
 //////////////////////////////////////////////////
@@ -336,6 +397,8 @@ bool IntrospectionManager::NewFilterImpl(const std::set<std::string> &_newItems,
   for (auto const &item : _newItems)
     this->dataPtr->observedItems[item].filters.emplace(_filterId);
 
+  this->dataPtr->planDirty = true;
+
   return true;
 }
 
@@ -393,6 +456,8 @@ bool IntrospectionManager::UpdateFilterImpl(const std::string &_filterId,
     }
   }
 
+  this->dataPtr->planDirty = true;
+
   return true;
 }
 
@@ -441,6 +506,8 @@ bool IntrospectionManager::RemoveFilterImpl(const std::string &_filterId)
       this->dataPtr->observedItems.erase(oldItem);
   }
 
+  this->dataPtr->planDirty = true;
+
   return true;
 }
 
@@ -92,6 +92,17 @@ namespace gazebo
       /// "/introspection/<manager_id>/items_update".
       public: void Update();
 
+      /// \brief Only evaluate and publish the items every _period calls to
+      /// Update, to lower the cost of introspection under load.
+      /// \param[in] _period Number of calls to Update per publication, one
+      /// (the default) publishes on every call. Zero is treated as one.
+      public: void SetUpdatePeriod(const unsigned int _period);
+
+      /// \brief Get the number of calls to Update per publication.
+      /// \return The update period.
+      /// \sa SetUpdatePeriod
+      public: unsigned int UpdatePeriod() const;
+
       /// \brief If there are changes in the items list since the last update,
       /// a new message is published under the topic
       /// "/introspection/<manager_id>/items_update".
@@ -135,6 +146,10 @@ namespace gazebo
       /// \return True if the filter was successfully removed or false otherwise
       private: bool RemoveFilterImpl(const std::string &_filterId);
 
+      /// \brief Compile the filters and registered items into a new
+      /// evaluation plan. The mutex must be locked.
+      private: void CompilePlan();
+
       /// \brief Internal callback for creating a filter via service request.
       /// \param[in] _req Input parameter of the service request. The service
       /// expects a collection of one or more parameters with name "item" and a
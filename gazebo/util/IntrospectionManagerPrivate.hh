@@ -17,11 +17,15 @@
 #ifndef GAZEBO_UTIL_INTROSPECTION_MANAGER_PRIVATE_HH_
 #define GAZEBO_UTIL_INTROSPECTION_MANAGER_PRIVATE_HH_
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <set>
 #include <string>
+#include <vector>
 #include <ignition/transport.hh>
 #include "gazebo/msgs/any.pb.h"
 #include "gazebo/msgs/param_v.pb.h"
@@ -36,22 +40,47 @@ namespace gazebo
     {
       /// \brief Items observed by this filter.
       std::set<std::string> items;
-
-      /// \brief Message containing the next update. A message is a collection
-      /// of items and values.
-      msgs::Param_V msg;
     };
 
-    /// \brief Todo.
+    /// \brief An item observed by at least one filter.
     struct ObservedItem
     {
-      /// \brief ToDo.
-      gazebo::msgs::Any lastValue;
-
-      /// \brief ToDo.
+      /// \brief Filters observing the item.
       std::set<std::string> filters;
     };
 
+    /// \brief What IntrospectionManager::Update evaluates and publishes,
+    /// compiled from the filters and registered items whenever one of them
+    /// changes. A plan is never modified once shared, so Update uses it
+    /// without holding the mutex.
+    struct IntrospectionPlan
+    {
+      /// \brief A filter with a publisher.
+      struct Filter
+      {
+        /// \brief Publisher of the filter updates.
+        ignition::transport::Node::Publisher pub;
+
+        /// \brief Topic of the filter updates.
+        std::string topic;
+
+        /// \brief Indices of the filter's items in callbacks.
+        std::vector<size_t> items;
+      };
+
+      /// \brief Increases with every new plan.
+      uint64_t version = 0;
+
+      /// \brief Names of the items observed by at least one filter.
+      std::vector<std::string> names;
+
+      /// \brief Callback of each item in names.
+      std::vector<std::function<gazebo::msgs::Any ()>> callbacks;
+
+      /// \brief Filters with at least one registered item.
+      std::vector<Filter> filters;
+    };
+
     /// \brief Private data for the IntrospectionManager class.
     class IntrospectionManagerPrivate
     {
@@ -102,6 +131,35 @@ namespace gazebo
 
       /// \brief Items update publisher for ignition transport.
       public: ignition::transport::Node::Publisher itemsUpdatePub;
+
+      /// \brief Current evaluation plan, replaced as a whole.
+      public: std::shared_ptr<const IntrospectionPlan> plan;
+
+      /// \brief True when the filters or registered items changed since
+      /// the plan was compiled.
+      public: bool planDirty = true;
+
+      /// \brief Version of the plan the buffers below were sized for.
+      /// Only used by Update.
+      public: uint64_t bufferVersion = 0;
+
+      /// \brief Number of calls to Update per publication.
+      public: std::atomic<unsigned int> updatePeriod{1};
+
+      /// \brief Calls to Update since the last publication. Only used by
+      /// Update.
+      public: unsigned int skippedUpdates = 0;
+
+      /// \brief Latest value of each item of the plan. Only used by Update.
+      public: std::vector<gazebo::msgs::Any> values;
+
+      /// \brief True for the items evaluated in the current update. Only
+      /// used by Update.
+      public: std::vector<bool> evaluated;
+
+      /// \brief Next message of each filter of the plan, with the item
+      /// names already set. Only used by Update.
+      public: std::vector<msgs::Param_V> filterMsgs;
     };
   }
 }
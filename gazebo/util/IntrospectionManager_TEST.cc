@@ -240,6 +240,56 @@ TEST_F(IntrospectionManagerTest, UpdateItems)
   EXPECT_EQ(items.param_size(), 0);
 }
 
+/////////////////////////////////////////////////
+TEST_F(IntrospectionManagerTest, UpdatePeriod)
+{
+  EXPECT_EQ(this->manager->UpdatePeriod(), 1u);
+
+  // Zero behaves as one.
+  this->manager->SetUpdatePeriod(0);
+  EXPECT_EQ(this->manager->UpdatePeriod(), 1u);
+
+  bool executed = false;
+  std::function<void(const gazebo::msgs::Param_V&)> subCb =
+    [&executed](const gazebo::msgs::Param_V &)
+    {
+      executed = true;
+    };
+
+  std::string topic = "/introspection/" + this->manager->Id() + "/items_update";
+  ignition::transport::Node node;
+  EXPECT_TRUE(node.Subscribe(topic, subCb));
+
+  // Flush the pending notifications of the fixture's items.
+  this->manager->Update();
+  for (int i = 0; i < 10 && !executed; ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_TRUE(executed);
+  executed = false;
+
+  auto func = []()
+  {
+    return 1.0;
+  };
+  EXPECT_TRUE(this->manager->Register<double>("item4", func));
+
+  // Only every third call to Update does any work.
+  this->manager->SetUpdatePeriod(3);
+  EXPECT_EQ(this->manager->UpdatePeriod(), 3u);
+  this->manager->Update();
+  this->manager->Update();
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+  EXPECT_FALSE(executed);
+
+  this->manager->Update();
+  for (int i = 0; i < 10 && !executed; ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_TRUE(executed);
+
+  this->manager->SetUpdatePeriod(1);
+  EXPECT_TRUE(this->manager->Unregister("item4"));
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
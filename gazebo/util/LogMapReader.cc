@@ -0,0 +1,232 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <exception>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/util/LogMapReader.hh"
+#include "gazebo/util/LogPlayPrivate.hh"
+
+using namespace gazebo;
+using namespace util;
+
+/// \brief XML tag delimiting the beginning of a frame.
+static const boost::string_ref kStartFrame("<sdf ");
+
+/// \brief XML tag delimiting the end of a frame.
+static const boost::string_ref kEndFrame("</sdf>");
+
+/////////////////////////////////////////////////
+/// \brief Find a string in a view, starting at a position.
+/// \param[in] _data View to search.
+/// \param[in] _what String to look for.
+/// \param[in] _pos Position to start at.
+/// \return Position of _what in _data, npos if not found.
+static size_t Find(const boost::string_ref &_data,
+    const boost::string_ref &_what, const size_t _pos)
+{
+  if (_pos > _data.size())
+    return boost::string_ref::npos;
+
+  size_t result = _data.substr(_pos).find(_what);
+  return result == boost::string_ref::npos ? result : result + _pos;
+}
+
+/////////////////////////////////////////////////
+bool LogMapReader::Open(const std::string &_filename)
+{
+  this->Close();
+
+  try
+  {
+    this->file.open(_filename);
+  }
+  catch(std::exception &_e)
+  {
+    gzerr << "Unable to map log file[" << _filename << "]: " << _e.what()
+      << "\n";
+    return false;
+  }
+
+  if (!this->file.is_open())
+    return false;
+
+  // Binary logs start with a magic string instead of XML
+  const boost::string_ref data(this->file.data(), this->file.size());
+  if (data.starts_with("GZLOGBIN") ||
+      data.find("<gazebo_log>") == boost::string_ref::npos)
+  {
+    this->Close();
+    return false;
+  }
+
+  // Index the chunks without parsing the XML, the frames are never
+  // looked at until a chunk is decoded.
+  const boost::string_ref kChunk("<chunk");
+  const boost::string_ref kEndChunk("</chunk>");
+  const boost::string_ref kCData("<![CDATA[");
+  const boost::string_ref kEndCData("]]>");
+
+  size_t start = Find(data, kChunk, 0);
+  this->header = data.substr(0,
+      start == boost::string_ref::npos ? data.size() : start);
+
+  while (start != boost::string_ref::npos)
+  {
+    size_t tagEnd = Find(data, ">", start);
+    size_t end = Find(data, kEndChunk, start);
+    if (tagEnd == boost::string_ref::npos || end == boost::string_ref::npos ||
+        tagEnd > end)
+    {
+      break;
+    }
+
+    ChunkRef chunk;
+
+    // Encoding attribute, in single or double quotes
+    const boost::string_ref tag = data.substr(start, tagEnd - start);
+    size_t attr = tag.find("encoding=");
+    if (attr != boost::string_ref::npos && attr + 10 < tag.size())
+    {
+      const char quote[] = {tag[attr + 9], '\0'};
+      size_t close = Find(tag, quote, attr + 10);
+      if (close != boost::string_ref::npos)
+        chunk.encoding = tag.substr(attr + 10, close - attr - 10);
+    }
+
+    // Data, inside a CDATA section if there is one
+    boost::string_ref body = data.substr(tagEnd + 1, end - tagEnd - 1);
+    size_t cdata = body.find(kCData);
+    if (cdata != boost::string_ref::npos)
+    {
+      body.remove_prefix(cdata + kCData.size());
+      size_t cdataEnd = body.rfind(kEndCData);
+      if (cdataEnd != boost::string_ref::npos)
+        body = body.substr(0, cdataEnd);
+    }
+    chunk.text = body;
+
+    this->chunks.push_back(chunk);
+    start = Find(data, kChunk, end + kEndChunk.size());
+  }
+
+  if (this->chunks.empty())
+  {
+    this->Close();
+    return false;
+  }
+
+  this->filename = _filename;
+  return true;
+}
+
+/////////////////////////////////////////////////
+void LogMapReader::Close()
+{
+  if (this->file.is_open())
+    this->file.close();
+
+  this->filename.clear();
+  this->header.clear();
+  this->chunks.clear();
+  this->nextChunk = 0;
+  this->currentChunk.clear();
+  this->pos = 0;
+}
+
+/////////////////////////////////////////////////
+bool LogMapReader::IsOpen() const
+{
+  return this->file.is_open();
+}
+
+/////////////////////////////////////////////////
+boost::string_ref LogMapReader::Header() const
+{
+  return this->header;
+}
+
+/////////////////////////////////////////////////
+size_t LogMapReader::ChunkCount() const
+{
+  return this->chunks.size();
+}
+
+/////////////////////////////////////////////////
+boost::string_ref LogMapReader::ChunkEncoding(const size_t _index) const
+{
+  if (_index >= this->chunks.size())
+    return boost::string_ref();
+  return this->chunks[_index].encoding;
+}
+
+/////////////////////////////////////////////////
+boost::string_ref LogMapReader::ChunkText(const size_t _index) const
+{
+  if (_index >= this->chunks.size())
+    return boost::string_ref();
+  return this->chunks[_index].text;
+}
+
+/////////////////////////////////////////////////
+bool LogMapReader::Chunk(const size_t _index, std::string &_data) const
+{
+  if (_index >= this->chunks.size())
+    return false;
+
+  const ChunkRef &chunk = this->chunks[_index];
+  return LogPlayPrivate::DecodeChunk(chunk.encoding.to_string(),
+      chunk.text.data(), chunk.text.size(), this->filename, _data);
+}
+
+/////////////////////////////////////////////////
+bool LogMapReader::Step(std::string &_frame)
+{
+  boost::string_ref frame;
+  while (!NextFrame(this->currentChunk, this->pos, frame))
+  {
+    if (this->nextChunk >= this->chunks.size() ||
+        !this->Chunk(this->nextChunk, this->currentChunk))
+    {
+      return false;
+    }
+
+    ++this->nextChunk;
+    this->pos = 0;
+  }
+
+  _frame.assign(frame.data(), frame.size());
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool LogMapReader::NextFrame(const boost::string_ref &_data, size_t &_pos,
+    boost::string_ref &_frame)
+{
+  size_t from = Find(_data, kStartFrame, _pos);
+  if (from == boost::string_ref::npos)
+    return false;
+
+  size_t to = Find(_data, kEndFrame, from);
+  if (to == boost::string_ref::npos)
+    return false;
+  to += kEndFrame.size();
+
+  _frame = _data.substr(from, to - from);
+  _pos = to;
+  return true;
+}
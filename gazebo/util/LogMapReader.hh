@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef _GAZEBO_UTIL_LOGMAPREADER_HH_
+#define _GAZEBO_UTIL_LOGMAPREADER_HH_
+
+#include <string>
+#include <vector>
+
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <boost/utility/string_ref.hpp>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace util
+  {
+    /// \internal
+    /// \brief Reads an XML state log through a memory map.
+    ///
+    /// Open() maps the file and indexes its chunks without parsing the
+    /// XML or copying anything. Chunks are exposed as views into the map
+    /// and decoded one at a time, so scanning a log needs memory for a
+    /// single decoded chunk instead of the whole document. Logs recorded
+    /// with the binary encoding are not handled, LogPlay already reads
+    /// them one chunk at a time.
+    class GZ_UTIL_VISIBLE LogMapReader
+    {
+      /// \brief Map a log file and index its chunks.
+      /// \param[in] _filename Path of the log file.
+      /// \return False if the file can not be mapped or is not an XML log.
+      public: bool Open(const std::string &_filename);
+
+      /// \brief Unmap the file.
+      public: void Close();
+
+      /// \brief Check if a file is open.
+      /// \return True if a file is mapped.
+      public: bool IsOpen() const;
+
+      /// \brief The part of the file before the first chunk, holding the
+      /// XML declaration, the opening <gazebo_log> tag and the header.
+      /// \return View into the map.
+      public: boost::string_ref Header() const;
+
+      /// \brief Number of chunks in the file.
+      /// \return Chunk count.
+      public: size_t ChunkCount() const;
+
+      /// \brief Encoding of a chunk.
+      /// \param[in] _index Index of the chunk.
+      /// \return View into the map, empty if the index is out of range.
+      public: boost::string_ref ChunkEncoding(const size_t _index) const;
+
+      /// \brief Encoded data of a chunk, without its CDATA markup.
+      /// \param[in] _index Index of the chunk.
+      /// \return View into the map, empty if the index is out of range.
+      public: boost::string_ref ChunkText(const size_t _index) const;
+
+      /// \brief Decode a chunk.
+      /// \param[in] _index Index of the chunk.
+      /// \param[out] _data Storage for the chunk's data.
+      /// \return True if the chunk was successfully decoded.
+      public: bool Chunk(const size_t _index, std::string &_data) const;
+
+      /// \brief Get the next frame, decoding chunks as they are reached.
+      /// The first frame is the SDF description of the world, as with
+      /// LogPlay::Step.
+      /// \param[out] _frame The frame.
+      /// \return False at the end of the log or on a decoding error.
+      public: bool Step(std::string &_frame);
+
+      /// \brief Find the next frame of decoded chunk data.
+      /// \param[in] _data Decoded chunk data.
+      /// \param[in,out] _pos Where to start looking, moved past the frame.
+      /// \param[out] _frame View of the frame in _data.
+      /// \return False if no complete frame follows _pos.
+      public: static bool NextFrame(const boost::string_ref &_data,
+                  size_t &_pos, boost::string_ref &_frame);
+
+      /// \brief Location of a chunk in the map.
+      private: class ChunkRef
+      {
+        /// \brief Encoding attribute of the chunk.
+        public: boost::string_ref encoding;
+
+        /// \brief Encoded data of the chunk.
+        public: boost::string_ref text;
+      };
+
+      /// \brief The mapped file.
+      private: boost::iostreams::mapped_file_source file;
+
+      /// \brief Path of the mapped file.
+      private: std::string filename;
+
+      /// \brief Part of the file before the first chunk.
+      private: boost::string_ref header;
+
+      /// \brief Chunks of the file, in order.
+      private: std::vector<ChunkRef> chunks;
+
+      /// \brief Index of the next chunk Step() decodes.
+      private: size_t nextChunk = 0;
+
+      /// \brief Chunk being stepped through.
+      private: std::string currentChunk;
+
+      /// \brief Position of Step() in the current chunk.
+      private: size_t pos = 0;
+    };
+  }
+}
+#endif
@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+#include <boost/iostreams/copy.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <fstream>
+#include <string>
+
+#include "gazebo/common/Base64.hh"
+#include "gazebo/util/BinaryLog.hh"
+#include "gazebo/util/LogMapReader.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class LogMapReader_TEST : public gazebo::testing::AutoLogFixture { };
+
+/// \brief Header of the test logs.
+static const char kHeader[] =
+  "<?xml version='1.0'?>\n<gazebo_log>\n<header>\n"
+  "<log_version>1.0</log_version>\n"
+  "<gazebo_version>11.0.0</gazebo_version>\n"
+  "<rand_seed>1</rand_seed>\n</header>\n";
+
+/// \brief World description frame.
+static const char kWorld[] = "<sdf version ='1.6'>\n<world/></sdf>\n";
+
+/////////////////////////////////////////////////
+/// \brief Make a state frame.
+/// \param[in] _sec Sim time seconds.
+/// \return The frame.
+static std::string Frame(const int _sec)
+{
+  return "<sdf version='1.6'><state world='default'><sim_time>" +
+    std::to_string(_sec) + " 0</sim_time></state></sdf>";
+}
+
+/////////////////////////////////////////////////
+/// \brief Make a zlib chunk.
+/// \param[in] _data Data of the chunk.
+/// \return The chunk element.
+static std::string ZlibChunk(const std::string &_data)
+{
+  std::string str;
+  {
+    boost::iostreams::filtering_ostream out;
+    out.push(boost::iostreams::zlib_compressor());
+    out.push(std::back_inserter(str));
+    boost::iostreams::copy(boost::make_iterator_range(_data), out);
+  }
+
+  std::string chunk = "<chunk encoding='zlib'>\n<![CDATA[";
+  Base64Encode(str.c_str(), str.size(), chunk);
+  return chunk + "]]>\n</chunk>\n";
+}
+
+/////////////////////////////////////////////////
+TEST_F(LogMapReader_TEST, Step)
+{
+  boost::filesystem::path path = boost::filesystem::temp_directory_path() /
+    boost::filesystem::unique_path("gazebo_map_log_%%%%%%.log");
+
+  {
+    std::ofstream out(path.string(), std::ios::out | std::ios::binary);
+    out << kHeader
+        << "<chunk encoding='txt'>\n<![CDATA[" << kWorld << Frame(1)
+        << "]]>\n</chunk>\n"
+        << ZlibChunk(Frame(2) + Frame(3))
+        << "<chunk encoding=\"txt\"><![CDATA[]]></chunk>\n"
+        << "</gazebo_log>\n";
+  }
+
+  util::LogMapReader reader;
+  ASSERT_TRUE(reader.Open(path.string()));
+  EXPECT_TRUE(reader.IsOpen());
+  EXPECT_EQ(std::string(kHeader), reader.Header().to_string());
+  EXPECT_EQ(3u, reader.ChunkCount());
+  EXPECT_EQ("txt", reader.ChunkEncoding(0).to_string());
+  EXPECT_EQ("zlib", reader.ChunkEncoding(1).to_string());
+  EXPECT_EQ("txt", reader.ChunkEncoding(2).to_string());
+  EXPECT_EQ(kWorld + Frame(1), reader.ChunkText(0).to_string());
+  EXPECT_TRUE(reader.ChunkText(2).empty());
+  EXPECT_TRUE(reader.ChunkText(3).empty());
+
+  // Frames are streamed across chunks, empty chunks are skipped
+  std::string frame;
+  EXPECT_TRUE(reader.Step(frame));
+  EXPECT_EQ("<sdf version ='1.6'>\n<world/></sdf>", frame);
+  EXPECT_TRUE(reader.Step(frame));
+  EXPECT_EQ(Frame(1), frame);
+  EXPECT_TRUE(reader.Step(frame));
+  EXPECT_EQ(Frame(2), frame);
+  EXPECT_TRUE(reader.Step(frame));
+  EXPECT_EQ(Frame(3), frame);
+  EXPECT_FALSE(reader.Step(frame));
+
+  reader.Close();
+  EXPECT_FALSE(reader.IsOpen());
+  EXPECT_EQ(0u, reader.ChunkCount());
+
+  boost::filesystem::remove(path);
+}
+
+/////////////////////////////////////////////////
+TEST_F(LogMapReader_TEST, NotXml)
+{
+  util::LogMapReader reader;
+  EXPECT_FALSE(reader.Open("/this/file/does/not/exist.log"));
+  EXPECT_FALSE(reader.IsOpen());
+
+  // Binary logs are left to LogPlay
+  boost::filesystem::path path = boost::filesystem::temp_directory_path() /
+    boost::filesystem::unique_path("gazebo_map_log_%%%%%%.log");
+  {
+    std::ofstream out(path.string(), std::ios::out | std::ios::binary);
+    out << util::BinaryLog::EncodeHeader(std::string(kHeader) +
+        "</gazebo_log>\n") << util::BinaryLog::EncodeChunk(Frame(1));
+  }
+  EXPECT_FALSE(reader.Open(path.string()));
+  EXPECT_FALSE(reader.IsOpen());
+
+  boost::filesystem::remove(path);
+}
+
+/////////////////////////////////////////////////
+TEST_F(LogMapReader_TEST, NextFrame)
+{
+  const std::string data = Frame(1) + "\n" + Frame(2) + "<sdf version";
+
+  size_t pos = 0;
+  boost::string_ref frame;
+  EXPECT_TRUE(util::LogMapReader::NextFrame(data, pos, frame));
+  EXPECT_EQ(Frame(1), frame.to_string());
+  EXPECT_TRUE(util::LogMapReader::NextFrame(data, pos, frame));
+  EXPECT_EQ(Frame(2), frame.to_string());
+
+  // An incomplete frame is not returned
+  EXPECT_FALSE(util::LogMapReader::NextFrame(data, pos, frame));
+  pos = data.size() + 10;
+  EXPECT_FALSE(util::LogMapReader::NextFrame(data, pos, frame));
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
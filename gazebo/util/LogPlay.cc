@@ -23,6 +23,10 @@
 #endif
 
 #include <algorithm>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/iostreams/filter/bzip2.hpp>
@@ -37,9 +41,14 @@
 
 #include <ignition/math/Rand.hh>
 
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Base64.hh"
+#include "gazebo/util/BinaryLog.hh"
 #include "gazebo/util/LogRecord.hh"
 
 #include "gazebo/util/LogPlayPrivate.hh"
@@ -60,9 +69,17 @@ LogPlay::~LogPlay()
 {
 }
 
+/////////////////////////////////////////////////
+void LogPlay::SetReadAhead(const unsigned int _count)
+{
+  this->dataPtr->readAheadCount = _count;
+}
+
 /////////////////////////////////////////////////
 void LogPlay::Open(const std::string &_logFile)
 {
+  // The read-ahead thread reads the document about to be replaced
+  this->dataPtr->readAhead.reset();
   this->dataPtr->currentChunk.clear();
 
   boost::filesystem::path path(_logFile);
@@ -72,9 +89,12 @@ void LogPlay::Open(const std::string &_logFile)
   if (boost::filesystem::is_directory(path))
     gzthrow("Invalid logfile [" + _logFile + "]. This is a directory.");
 
+  // Binary logs only keep their header as XML
+  this->dataPtr->binary = this->dataPtr->OpenBinary(_logFile);
+
   // Flag use to indicate if a parser failure has occurred
-  bool xmlParserFail = this->dataPtr->xmlDoc.LoadFile(_logFile.c_str()) !=
-    tinyxml2::XML_SUCCESS;
+  bool xmlParserFail = !this->dataPtr->binary &&
+    this->dataPtr->xmlDoc.LoadFile(_logFile.c_str()) != tinyxml2::XML_SUCCESS;
 
   // Parse the log file
   if (xmlParserFail)
@@ -156,12 +176,28 @@ void LogPlay::Open(const std::string &_logFile)
   // Extract the initial "iterations" value from the log.
   this->dataPtr->iterationsFound = this->ReadIterations();
 
+  if (this->dataPtr->binary)
+  {
+    if (this->dataPtr->binaryChunks.empty())
+      gzthrow("Unable to find the first chunk");
+
+    if (!this->dataPtr->BinaryChunkData(0, this->dataPtr->currentChunk))
+      gzthrow("Unable to decode log file");
+
+    this->dataPtr->start = 0;
+    this->dataPtr->end = -1 * this->dataPtr->kEndFrame.size();
+    this->dataPtr->StartReadAhead();
+    return;
+  }
+
   this->dataPtr->logCurrXml =
     this->dataPtr->logStartXml->FirstChildElement("chunk");
 
   if (!this->dataPtr->logCurrXml)
     gzthrow("Unable to find the first chunk");
 
+  this->dataPtr->xmlIndex = 0;
+
   if (!this->dataPtr->ChunkData(this->dataPtr->logCurrXml,
                                 this->dataPtr->currentChunk))
   {
@@ -170,6 +206,7 @@ void LogPlay::Open(const std::string &_logFile)
 
   this->dataPtr->start = 0;
   this->dataPtr->end = -1 * this->dataPtr->kEndFrame.size();
+  this->dataPtr->StartReadAhead();
 }
 
 /////////////////////////////////////////////////
@@ -261,6 +298,25 @@ void LogPlay::ReadLogTimes()
   std::string chunk;
   bool found = false;
 
+  // The time index of binary logs has the times already
+  if (this->dataPtr->binary)
+  {
+    for (const auto &info : this->dataPtr->binaryChunks)
+    {
+      if (info.hasTime)
+      {
+        if (!found)
+          this->dataPtr->logStartTime = info.firstTime;
+        this->dataPtr->logEndTime = info.lastTime;
+        found = true;
+      }
+    }
+
+    if (!found)
+      gzwarn << "Unable to find <sim_time> tags in any chunk." << std::endl;
+    return;
+  }
+
   auto chunkXml = this->dataPtr->logStartXml->FirstChildElement("chunk");
 
   // Try to read the start time of the log.
@@ -336,13 +392,28 @@ bool LogPlay::ReadIterations()
   const std::string kStartDelim = "<iterations>";
   const std::string kEndDelim = "</iterations>";
 
+  if (this->dataPtr->binary)
+  {
+    auto numChunksToTry = std::min(this->dataPtr->binaryChunks.size(),
+        static_cast<size_t>(this->dataPtr->kNumChunksToTry));
+    for (size_t i = 0; i < numChunksToTry; ++i)
+    {
+      if (this->dataPtr->binaryChunks[i].hasIterations)
+      {
+        this->dataPtr->initialIterations =
+          this->dataPtr->binaryChunks[i].firstIterations;
+        return true;
+      }
+    }
+  }
+
   auto chunkXml = this->dataPtr->logStartXml->FirstChildElement("chunk");
 
   // Read the first "iterations" value of the log from the first chunk.
   auto numChunksToTry =
     std::min(this->ChunkCount(), this->dataPtr->kNumChunksToTry);
 
-  for (unsigned int i = 0; i < numChunksToTry; ++i)
+  for (unsigned int i = 0; !this->dataPtr->binary && i < numChunksToTry; ++i)
   {
     if (!chunkXml)
     {
@@ -536,19 +607,34 @@ bool LogPlay::Rewind()
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
   this->dataPtr->currentChunk.clear();
-  this->dataPtr->logCurrXml =
-    this->dataPtr->logStartXml->FirstChildElement("chunk");
-
-  if (!this->dataPtr->logCurrXml)
+  if (this->dataPtr->binary)
   {
-    gzerr << "Unable to jump to the beginning of the log file\n";
-    return false;
-  }
+    if (this->dataPtr->binaryChunks.empty())
+    {
+      gzerr << "Unable to jump to the beginning of the log file\n";
+      return false;
+    }
 
-  if (!this->dataPtr->ChunkData(this->dataPtr->logCurrXml,
-                                this->dataPtr->currentChunk))
+    if (!this->dataPtr->BinaryChunkData(0, this->dataPtr->currentChunk))
+      return false;
+  }
+  else
   {
-    return false;
+    this->dataPtr->logCurrXml =
+      this->dataPtr->logStartXml->FirstChildElement("chunk");
+    this->dataPtr->xmlIndex = 0;
+
+    if (!this->dataPtr->logCurrXml)
+    {
+      gzerr << "Unable to jump to the beginning of the log file\n";
+      return false;
+    }
+
+    if (!this->dataPtr->ChunkData(this->dataPtr->logCurrXml,
+                                  this->dataPtr->currentChunk))
+    {
+      return false;
+    }
   }
 
   // Skip first <sdf> block (it doesn't have a world state).
@@ -576,19 +662,38 @@ bool LogPlay::Forward()
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
   // Get the last chunk.
-  this->dataPtr->logCurrXml =
-    this->dataPtr->logStartXml->LastChildElement("chunk");
-
-  if (!this->dataPtr->logCurrXml)
+  if (this->dataPtr->binary)
   {
-    gzerr << "Unable to jump to the end of the log file\n";
-    return false;
-  }
+    if (this->dataPtr->binaryChunks.empty())
+    {
+      gzerr << "Unable to jump to the end of the log file\n";
+      return false;
+    }
 
-  if (!this->dataPtr->ChunkData(this->dataPtr->logCurrXml,
-                                this->dataPtr->currentChunk))
+    if (!this->dataPtr->BinaryChunkData(
+          this->dataPtr->binaryChunks.size() - 1,
+          this->dataPtr->currentChunk))
+    {
+      return false;
+    }
+  }
+  else
   {
-    return false;
+    this->dataPtr->logCurrXml =
+      this->dataPtr->logStartXml->LastChildElement("chunk");
+    this->dataPtr->xmlIndex = this->ChunkCount() - 1;
+
+    if (!this->dataPtr->logCurrXml)
+    {
+      gzerr << "Unable to jump to the end of the log file\n";
+      return false;
+    }
+
+    if (!this->dataPtr->ChunkData(this->dataPtr->logCurrXml,
+                                  this->dataPtr->currentChunk))
+    {
+      return false;
+    }
   }
 
   this->dataPtr->start = this->dataPtr->currentChunk.size() - 1;
@@ -610,6 +715,10 @@ bool LogPlay::Seek(const common::Time &_time)
 
   common::Time logTime = this->dataPtr->logStartTime;
 
+  // The time index of binary logs locates the frame directly
+  if (this->dataPtr->binary)
+    return this->dataPtr->BinarySeek(_time) || this->Rewind();
+
   // 1st step: Locate the chunk: We're looking for the first chunk that has
   // a time greater than the target time.
   int64_t imin = 0;
@@ -690,6 +799,12 @@ bool LogPlay::Seek(const common::Time &_time)
 /////////////////////////////////////////////////
 bool LogPlay::Chunk(unsigned int _index, std::string &_data) const
 {
+  if (this->dataPtr->binary)
+  {
+    return _index < this->dataPtr->binaryChunks.size() &&
+      this->dataPtr->BinaryChunkData(_index, _data);
+  }
+
   unsigned int count = 0;
   this->dataPtr->logCurrXml =
     this->dataPtr->logStartXml->FirstChildElement("chunk");
@@ -701,6 +816,7 @@ bool LogPlay::Chunk(unsigned int _index, std::string &_data) const
       this->dataPtr->logCurrXml->NextSiblingElement("chunk");
   }
 
+  this->dataPtr->xmlIndex = count;
   if (this->dataPtr->logCurrXml && count == _index)
     return this->dataPtr->ChunkData(this->dataPtr->logCurrXml, _data);
   else
@@ -728,11 +844,23 @@ bool LogPlayPrivate::ChunkData(
     gzthrow("Encoding missing for a chunk in log file[" + this->filename + "]");
   }
 
-  if (this->encoding == "txt")
-    _data = _xml->GetText();
-  else if (this->encoding == "bz2")
+  const char *text = _xml->GetText();
+  if (!text)
+    text = "";
+  return DecodeChunk(this->encoding, text, std::strlen(text), this->filename,
+      _data);
+}
+
+/////////////////////////////////////////////////
+bool LogPlayPrivate::DecodeChunk(const std::string &_encoding,
+    const char *_text, const size_t _size, const std::string &_filename,
+    std::string &_data)
+{
+  if (_encoding == "txt")
+    _data.assign(_text, _size);
+  else if (_encoding == "bz2")
   {
-    std::string data = _xml->GetText();
+    std::string data(_text, _size);
     std::string buffer;
 
     // Decode the base64 string
@@ -749,9 +877,9 @@ bool LogPlayPrivate::ChunkData(
       _data += '\0';
     }
   }
-  else if (this->encoding == "zlib")
+  else if (_encoding == "zlib")
   {
-    std::string data = _xml->GetText();
+    std::string data(_text, _size);
     std::string buffer;
 
     // Decode the base64 string
@@ -768,10 +896,37 @@ bool LogPlayPrivate::ChunkData(
       _data += '\0';
     }
   }
+#ifdef HAVE_ZSTD
+  else if (_encoding == "zstd")
+  {
+    std::string buffer = Base64Decode(std::string(_text, _size));
+
+    // Decompress the zstd data, its frame holds the uncompressed size
+    unsigned long long size =
+        ZSTD_getFrameContentSize(buffer.data(), buffer.size());
+    if (size == ZSTD_CONTENTSIZE_ERROR || size == ZSTD_CONTENTSIZE_UNKNOWN)
+    {
+      gzerr << "Invalid zstd chunk in log file[" << _filename << "]\n";
+      return false;
+    }
+
+    _data.resize(size);
+    size_t result = ZSTD_decompress(&_data[0], _data.size(),
+        buffer.data(), buffer.size());
+    if (ZSTD_isError(result))
+    {
+      gzerr << "Unable to decompress a chunk of log file[" << _filename
+        << "]: " << ZSTD_getErrorName(result) << "\n";
+      return false;
+    }
+    _data.resize(result);
+    _data += '\0';
+  }
+#endif
   else
   {
-    gzerr << "Invalid encoding[" << this->encoding << "] in log file["
-      << this->filename << "]\n";
+    gzerr << "Invalid encoding[" << _encoding << "] in log file["
+      << _filename << "]\n";
     return false;
   }
 
@@ -787,6 +942,9 @@ std::string LogPlay::Encoding() const
 /////////////////////////////////////////////////
 unsigned int LogPlay::ChunkCount() const
 {
+  if (this->dataPtr->binary)
+    return this->dataPtr->binaryChunks.size();
+
   unsigned int count = 0;
   auto xml = this->dataPtr->logStartXml->FirstChildElement("chunk");
 
@@ -802,13 +960,43 @@ unsigned int LogPlay::ChunkCount() const
 /////////////////////////////////////////////////
 bool LogPlay::NextChunk()
 {
+  if (this->dataPtr->binary)
+  {
+    size_t index = this->dataPtr->binaryIndex + 1;
+    if (index >= this->dataPtr->binaryChunks.size())
+      return false;
+
+    if (this->dataPtr->readAhead &&
+        this->dataPtr->readAhead->Take(index, this->dataPtr->currentChunk))
+    {
+      this->dataPtr->binaryIndex = index;
+      this->dataPtr->encoding = "binary";
+    }
+    else if (!this->dataPtr->BinaryChunkData(index,
+          this->dataPtr->currentChunk))
+    {
+      return false;
+    }
+
+    this->dataPtr->start = 0;
+    this->dataPtr->end = -1 * this->dataPtr->kEndFrame.size();
+    return true;
+  }
+
   auto next = this->dataPtr->logCurrXml->NextSiblingElement("chunk");
   if (!next)
     return false;
 
   this->dataPtr->logCurrXml = next;
-  if (!this->dataPtr->ChunkData(this->dataPtr->logCurrXml,
-                                this->dataPtr->currentChunk))
+  ++this->dataPtr->xmlIndex;
+  if (this->dataPtr->readAhead &&
+      this->dataPtr->readAhead->Take(this->dataPtr->xmlIndex,
+        this->dataPtr->currentChunk))
+  {
+    this->dataPtr->encoding = next->Attribute("encoding");
+  }
+  else if (!this->dataPtr->ChunkData(this->dataPtr->logCurrXml,
+                                     this->dataPtr->currentChunk))
   {
     return false;
   }
@@ -822,11 +1010,26 @@ bool LogPlay::NextChunk()
 /////////////////////////////////////////////////
 bool LogPlay::PrevChunk()
 {
+  if (this->dataPtr->binary)
+  {
+    if (this->dataPtr->binaryIndex == 0 ||
+        !this->dataPtr->BinaryChunkData(this->dataPtr->binaryIndex - 1,
+          this->dataPtr->currentChunk))
+    {
+      return false;
+    }
+
+    this->dataPtr->start = this->dataPtr->currentChunk.size() - 1;
+    this->dataPtr->end = this->dataPtr->currentChunk.size() - 1;
+    return true;
+  }
+
   auto prev = this->dataPtr->logCurrXml->PreviousSiblingElement("chunk");
   if (!prev)
     return false;
 
   this->dataPtr->logCurrXml = prev;
+  --this->dataPtr->xmlIndex;
   if (!this->dataPtr->ChunkData(this->dataPtr->logCurrXml,
                                 this->dataPtr->currentChunk))
   {
@@ -838,3 +1041,146 @@ bool LogPlay::PrevChunk()
 
   return true;
 }
+
+/////////////////////////////////////////////////
+void LogPlayPrivate::StartReadAhead()
+{
+  unsigned int count = this->readAheadCount;
+  if (count == 0)
+    return;
+
+  if (this->binary)
+  {
+    // The thread reads through its own stream of the file
+    auto file = std::make_shared<std::ifstream>(this->filename,
+        std::ios::in | std::ios::binary);
+    auto chunks = this->binaryChunks;
+    this->readAhead.reset(new LogReadAhead(
+        [file, chunks](const size_t _index, std::string &_data)
+        {
+          return BinaryLog::ReadChunk(*file, chunks[_index], _data);
+        }, chunks.size(), count));
+    return;
+  }
+
+  // Read the text of every chunk here: tinyxml2 finishes parsing strings
+  // on first access, which must not race with the playback thread.
+  std::vector<std::pair<std::string, const char *>> chunks;
+  for (auto xml = this->logStartXml->FirstChildElement("chunk"); xml;
+       xml = xml->NextSiblingElement("chunk"))
+  {
+    const char *enc = xml->Attribute("encoding");
+    const char *text = xml->GetText();
+    if (!enc || !text)
+      break;
+    chunks.push_back(std::make_pair(std::string(enc), text));
+  }
+
+  std::string logFile = this->filename;
+  this->readAhead.reset(new LogReadAhead(
+      [chunks, logFile](const size_t _index, std::string &_data)
+      {
+        const char *text = chunks[_index].second;
+        return DecodeChunk(chunks[_index].first, text, std::strlen(text),
+            logFile, _data);
+      }, chunks.size(), count));
+}
+
+/////////////////////////////////////////////////
+bool LogPlayPrivate::OpenBinary(const std::string &_filename)
+{
+  this->binaryChunks.clear();
+  this->binaryIndex = 0;
+  if (this->binaryFile.is_open())
+    this->binaryFile.close();
+
+  this->binaryFile.open(_filename, std::ios::in | std::ios::binary);
+
+  std::string header;
+  if (!BinaryLog::ReadHeader(this->binaryFile, header) ||
+      this->xmlDoc.Parse(header.c_str()) != tinyxml2::XML_SUCCESS)
+  {
+    this->binaryFile.close();
+    return false;
+  }
+
+  // Logs that were stopped cleanly end with an index. Otherwise index
+  // every chunk, a chunk cut short by the interruption ends the index.
+  const std::streamoff firstChunk = this->binaryFile.tellg();
+  if (!BinaryLog::ReadIndex(this->binaryFile, this->binaryChunks))
+  {
+    this->binaryFile.clear();
+    this->binaryFile.seekg(firstChunk);
+
+    BinaryLog::ChunkInfo info;
+    while (BinaryLog::ReadChunkInfo(this->binaryFile, info))
+      this->binaryChunks.push_back(info);
+  }
+  this->binaryFile.clear();
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool LogPlayPrivate::BinaryChunkData(const size_t _index, std::string &_data)
+{
+  if (!BinaryLog::ReadChunk(this->binaryFile, this->binaryChunks[_index],
+        _data))
+  {
+    return false;
+  }
+
+  this->binaryIndex = _index;
+  this->encoding = "binary";
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool LogPlayPrivate::BinarySeek(const common::Time &_time)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+
+  // Last chunk that starts before the time
+  size_t index = this->binaryChunks.size();
+  for (size_t i = 0; i < this->binaryChunks.size(); ++i)
+  {
+    const auto &info = this->binaryChunks[i];
+    if (info.hasTime && info.firstTime < _time)
+      index = i;
+    else if (info.hasTime)
+      break;
+  }
+
+  std::vector<BinaryLog::FrameInfo> frames;
+  if (index == this->binaryChunks.size() ||
+      !BinaryLog::ReadFrames(this->binaryFile, this->binaryChunks[index],
+        frames))
+  {
+    return false;
+  }
+
+  // Last frame before the time, the next Step returns the one after it
+  auto frame = frames.rend();
+  for (auto iter = frames.rbegin(); iter != frames.rend(); ++iter)
+  {
+    if (iter->hasTime && iter->time < _time)
+    {
+      frame = iter;
+      break;
+    }
+  }
+
+  if (frame == frames.rend() ||
+      !this->BinaryChunkData(index, this->currentChunk))
+  {
+    return false;
+  }
+
+  auto to = this->currentChunk.find(this->kEndFrame, frame->offset);
+  if (to == std::string::npos)
+    return false;
+
+  this->start = frame->offset;
+  this->end = to;
+  return true;
+}
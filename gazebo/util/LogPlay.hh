@@ -63,6 +63,12 @@ namespace gazebo
       /// instead of a regular file, or Gazebo was unable to parse it.
       public: void Open(const std::string &_logFile);
 
+      /// \brief Set how many chunks are decoded ahead of playback on a
+      /// background thread, from the next call to Open. Defaults to the
+      /// GAZEBO_LOG_READ_AHEAD environment variable.
+      /// \param[in] _count Number of chunks, 0 to decode them on demand.
+      public: void SetReadAhead(const unsigned int _count);
+
       /// \brief Return true if a file is open.
       /// \return True if a log file is open.
       public: bool IsOpen() const;
@@ -25,10 +25,15 @@
 #include <tinyxml2.h>
 #endif
 
+#include <fstream>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 
 #include "gazebo/common/Time.hh"
+#include "gazebo/util/BinaryLog.hh"
+#include "gazebo/util/LogReadAhead.hh"
 #include "gazebo/util/system.hh"
 
 namespace gazebo
@@ -47,6 +52,40 @@ namespace gazebo
                   tinyxml2::XMLElement *_xml,
                   std::string &_data);
 
+      /// \brief Decode the data of a chunk. Does not touch any member, so it
+      /// can run on the read-ahead thread.
+      /// \param[in] _encoding Encoding of the chunk.
+      /// \param[in] _text Text of the chunk element.
+      /// \param[in] _size Length of the text.
+      /// \param[in] _filename Name of the log file, for error messages.
+      /// \param[out] _data Storage for the chunk's data.
+      /// \return True if the chunk was successfully decoded.
+      public: static bool DecodeChunk(const std::string &_encoding,
+                  const char *_text, const size_t _size,
+                  const std::string &_filename, std::string &_data);
+
+      /// \brief Start decoding chunks in the background if the
+      /// GAZEBO_LOG_READ_AHEAD environment variable is set.
+      public: void StartReadAhead();
+
+      /// \brief Open a log file recorded with the binary encoding. Parses
+      /// its header into xmlDoc and indexes its chunks.
+      /// \param[in] _filename Path of the log file.
+      /// \return False if the file is not a binary log.
+      public: bool OpenBinary(const std::string &_filename);
+
+      /// \brief Load a chunk of a binary log and make it the current one.
+      /// \param[in] _index Index of the chunk.
+      /// \param[out] _data Storage for the chunk's data.
+      /// \return True if the chunk was successfully read.
+      public: bool BinaryChunkData(const size_t _index, std::string &_data);
+
+      /// \brief Seek a binary log with its index, without decompressing
+      /// any chunk but the one holding the frame.
+      /// \param[in] _time Time to seek to.
+      /// \return False if no frame is before the time.
+      public: bool BinarySeek(const common::Time &_time);
+
       /// \brief Max number of chunks to inspect when looking for XML elements.
       public: const unsigned int kNumChunksToTry = 2u;
 
@@ -111,8 +150,30 @@ namespace gazebo
       /// may not include this tag in the log files.
       public: bool iterationsFound = false;
 
+      /// \brief True if the open log file uses the binary encoding.
+      public: bool binary = false;
+
+      /// \brief Stream of the open binary log file.
+      public: std::ifstream binaryFile;
+
+      /// \brief Index of the chunks of the open binary log file.
+      public: std::vector<BinaryLog::ChunkInfo> binaryChunks;
+
+      /// \brief Index of the current chunk of the open binary log file.
+      public: size_t binaryIndex = 0;
+
+      /// \brief Index of the current chunk of an open XML log file.
+      public: size_t xmlIndex = 0;
+
       /// \brief A mutex to avoid race conditions.
       public: std::mutex mutex;
+
+      /// \brief Number of chunks decoded ahead of playback.
+      public: unsigned int readAheadCount = LogReadAhead::Count();
+
+      /// \brief Decodes upcoming chunks in the background, null if disabled.
+      /// Declared last so it stops before the data it reads is destroyed.
+      public: std::unique_ptr<LogReadAhead> readAhead;
     };
   }
 }
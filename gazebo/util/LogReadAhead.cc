@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "gazebo/common/SamplingProfiler.hh"
+#include "gazebo/util/LogReadAhead.hh"
+
+using namespace gazebo;
+using namespace util;
+
+/////////////////////////////////////////////////
+LogReadAhead::LogReadAhead(const Decoder &_decoder, const size_t _chunkCount,
+    const unsigned int _count)
+  : decoder(_decoder), chunkCount(_chunkCount), count(_count),
+    busy(_chunkCount)
+{
+  this->thread = std::thread(&LogReadAhead::Run, this);
+}
+
+/////////////////////////////////////////////////
+LogReadAhead::~LogReadAhead()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->stop = true;
+  }
+  this->condition.notify_all();
+  this->thread.join();
+}
+
+/////////////////////////////////////////////////
+unsigned int LogReadAhead::Count()
+{
+  const char *env = std::getenv("GAZEBO_LOG_READ_AHEAD");
+  if (!env)
+    return 0;
+
+  int value = std::atoi(env);
+  return value > 0 ? value : 0;
+}
+
+/////////////////////////////////////////////////
+bool LogReadAhead::Take(const size_t _index, std::string &_data)
+{
+  std::unique_lock<std::mutex> lock(this->mutex);
+
+  this->condition.wait(lock, [&]() {return this->busy != _index;});
+
+  bool result = false;
+  auto iter = this->chunks.find(_index);
+  if (iter != this->chunks.end())
+  {
+    _data.swap(iter->second);
+    result = true;
+  }
+
+  // Move the window past the chunk and drop what falls out of it
+  this->next = _index + 1;
+  for (iter = this->chunks.begin(); iter != this->chunks.end();)
+  {
+    if (iter->first < this->next || iter->first >= this->next + this->count)
+      iter = this->chunks.erase(iter);
+    else
+      ++iter;
+  }
+  this->failed.erase(this->failed.begin(),
+      this->failed.lower_bound(this->next));
+
+  lock.unlock();
+  this->condition.notify_all();
+
+  return result;
+}
+
+/////////////////////////////////////////////////
+void LogReadAhead::Run()
+{
+  common::SetThreadName("LogReadAhead");
+  std::unique_lock<std::mutex> lock(this->mutex);
+  while (!this->stop)
+  {
+    // First chunk of the window that is not decoded yet
+    size_t index = this->next;
+    size_t last = std::min(this->next + this->count, this->chunkCount);
+    while (index < last &&
+        (this->chunks.count(index) || this->failed.count(index)))
+    {
+      ++index;
+    }
+
+    if (index >= last)
+    {
+      this->condition.wait(lock);
+      continue;
+    }
+
+    this->busy = index;
+    lock.unlock();
+
+    std::string data;
+    bool decoded = this->decoder(index, data);
+
+    lock.lock();
+    this->busy = this->chunkCount;
+
+    // Failures are left for the playback thread to decode and report
+    if (!decoded)
+      this->failed.insert(index);
+    else if (index >= this->next && index < this->next + this->count)
+      this->chunks[index].swap(data);
+
+    lock.unlock();
+    this->condition.notify_all();
+    lock.lock();
+  }
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef _GAZEBO_UTIL_LOGREADAHEAD_HH_
+#define _GAZEBO_UTIL_LOGREADAHEAD_HH_
+
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace util
+  {
+    /// \internal
+    /// \brief Decodes the chunks of a log file ahead of playback.
+    ///
+    /// A background thread decodes up to Count() chunks following the one
+    /// last taken, so stepping across a chunk boundary finds the next
+    /// chunk already decompressed.
+    class GZ_UTIL_VISIBLE LogReadAhead
+    {
+      /// \brief Decodes a chunk. Called from the background thread, it
+      /// must not touch state used by the playback thread.
+      /// \param[in] _index Index of the chunk.
+      /// \param[out] _data Storage for the chunk's data.
+      /// \return True if the chunk was successfully decoded.
+      public: using Decoder =
+                  std::function<bool(const size_t _index, std::string &_data)>;
+
+      /// \brief Constructor. Starts the background thread.
+      /// \param[in] _decoder Function decoding a chunk.
+      /// \param[in] _chunkCount Number of chunks in the log.
+      /// \param[in] _count Number of chunks to decode ahead.
+      public: LogReadAhead(const Decoder &_decoder, const size_t _chunkCount,
+                  const unsigned int _count);
+
+      /// \brief Destructor. Stops the background thread.
+      public: ~LogReadAhead();
+
+      /// \brief Number of chunks to decode ahead, from the
+      /// GAZEBO_LOG_READ_AHEAD environment variable.
+      /// \return 0 if read-ahead is disabled.
+      public: static unsigned int Count();
+
+      /// \brief Take a chunk decoded in the background, then start decoding
+      /// the chunks that follow it. Waits if the chunk is being decoded.
+      /// \param[in] _index Index of the chunk.
+      /// \param[out] _data Storage for the chunk's data.
+      /// \return False if the chunk was not decoded ahead, the caller
+      /// should decode it itself.
+      public: bool Take(const size_t _index, std::string &_data);
+
+      /// \brief Background thread loop.
+      private: void Run();
+
+      /// \brief Function decoding a chunk.
+      private: Decoder decoder;
+
+      /// \brief Number of chunks in the log.
+      private: size_t chunkCount;
+
+      /// \brief Number of chunks to decode ahead.
+      private: unsigned int count;
+
+      /// \brief First chunk of the window to decode.
+      private: size_t next = 0;
+
+      /// \brief Chunk being decoded, chunkCount if none.
+      private: size_t busy;
+
+      /// \brief Decoded chunks, by index.
+      private: std::map<size_t, std::string> chunks;
+
+      /// \brief Chunks that failed to decode in the window.
+      private: std::set<size_t> failed;
+
+      /// \brief True when the thread should exit.
+      private: bool stop = false;
+
+      /// \brief Protects the members above.
+      private: std::mutex mutex;
+
+      /// \brief Signals a change of window or a decoded chunk.
+      private: std::condition_variable condition;
+
+      /// \brief Background thread.
+      private: std::thread thread;
+    };
+  }
+}
+#endif
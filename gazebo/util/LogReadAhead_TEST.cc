@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <string>
+
+#include "gazebo/util/LogReadAhead.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class LogReadAhead_TEST : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(LogReadAhead_TEST, Take)
+{
+  std::atomic<unsigned int> decodes(0);
+  util::LogReadAhead readAhead(
+      [&](const size_t _index, std::string &_data)
+      {
+        ++decodes;
+        _data = std::to_string(_index);
+        return _index != 3;
+      }, 5, 2);
+
+  // Chunks are handed out in order, each Take moves the window
+  std::string data;
+  for (size_t i = 0; i < 3; ++i)
+  {
+    // The first window is decoded as soon as the thread starts
+    for (int j = 0; j < 100 && decodes < i + 2; ++j)
+      common::Time::MSleep(10);
+    EXPECT_TRUE(readAhead.Take(i, data));
+    EXPECT_EQ(data, std::to_string(i));
+  }
+
+  // Chunk 3 fails to decode, the caller has to decode it itself
+  for (int j = 0; j < 100 && decodes < 5; ++j)
+    common::Time::MSleep(10);
+  EXPECT_FALSE(readAhead.Take(3, data));
+  EXPECT_TRUE(readAhead.Take(4, data));
+  EXPECT_EQ(data, "4");
+
+  // Past the last chunk nothing is decoded
+  EXPECT_FALSE(readAhead.Take(5, data));
+}
+
+/////////////////////////////////////////////////
+TEST_F(LogReadAhead_TEST, Jump)
+{
+  util::LogReadAhead readAhead(
+      [&](const size_t _index, std::string &_data)
+      {
+        _data = std::to_string(_index);
+        return true;
+      }, 100, 3);
+
+  // A chunk far from the window was not decoded, the next ones will be
+  std::string data;
+  EXPECT_FALSE(readAhead.Take(50, data));
+  bool taken = false;
+  for (int j = 0; j < 100 && !taken; ++j)
+  {
+    common::Time::MSleep(10);
+    taken = readAhead.Take(51, data);
+  }
+  EXPECT_TRUE(taken);
+  EXPECT_EQ(data, "51");
+}
+
+/////////////////////////////////////////////////
+TEST_F(LogReadAhead_TEST, Count)
+{
+  unsetenv("GAZEBO_LOG_READ_AHEAD");
+  EXPECT_EQ(util::LogReadAhead::Count(), 0u);
+
+  setenv("GAZEBO_LOG_READ_AHEAD", "4", 1);
+  EXPECT_EQ(util::LogReadAhead::Count(), 4u);
+
+  setenv("GAZEBO_LOG_READ_AHEAD", "-1", 1);
+  EXPECT_EQ(util::LogReadAhead::Count(), 0u);
+  unsetenv("GAZEBO_LOG_READ_AHEAD");
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
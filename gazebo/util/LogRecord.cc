@@ -25,6 +25,8 @@
   #define access _access
 #endif
 
+#include <algorithm>
+#include <cstdint>
 #include <functional>
 
 #include <boost/archive/iterators/base64_from_binary.hpp>
@@ -38,7 +40,14 @@
 #include <boost/iostreams/filter/zlib.hpp>
 #include <boost/iostreams/filtering_stream.hpp>
 #include <boost/iostreams/copy.hpp>
+#include <fstream>
 #include <iomanip>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
 
 #include <ignition/math/Rand.hh>
 
@@ -48,16 +57,137 @@
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Events.hh"
 #include "gazebo/common/Exception.hh"
+#include "gazebo/common/MemoryAccount.hh"
+#include "gazebo/common/SamplingProfiler.hh"
 #include "gazebo/common/Time.hh"
 #include "gazebo/common/SystemPaths.hh"
 #include "gazebo/gazebo_config.h"
 #include "gazebo/transport/transport.hh"
+#include "gazebo/util/BinaryLog.hh"
 #include "gazebo/util/LogRecordPrivate.hh"
 #include "gazebo/util/LogRecord.hh"
 
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
 using namespace gazebo;
 using namespace gazebo::util;
 
+/// \brief Uncompressed size above which the data of an update is split
+/// into several chunks compressed in parallel.
+static const size_t kParallelChunkSize = 256 * 1024;
+
+#ifdef HAVE_ZSTD
+/// \brief Compression level used for zstd chunks.
+static const int kZstdLevel = 3;
+#endif
+
+//////////////////////////////////////////////////
+/// \brief Split log data into pieces that end on a frame boundary.
+/// \param[in] _data Data returned by a log callback.
+/// \return Begin and end offset of each piece.
+static std::vector<std::pair<size_t, size_t>> SplitFrames(
+    const std::string &_data)
+{
+  std::vector<std::pair<size_t, size_t>> pieces;
+
+  size_t count = std::min<size_t>(
+      std::max(1u, std::thread::hardware_concurrency()),
+      _data.size() / kParallelChunkSize);
+
+  size_t begin = 0;
+  for (size_t i = 1; i < count && begin < _data.size(); ++i)
+  {
+    size_t end = _data.find("</sdf>",
+        std::max(begin, i * _data.size() / count));
+    if (end == std::string::npos)
+      break;
+    end += 6;
+    pieces.push_back(std::make_pair(begin, end));
+    begin = end;
+  }
+
+  if (begin < _data.size())
+    pieces.push_back(std::make_pair(begin, _data.size()));
+
+  return pieces;
+}
+
+//////////////////////////////////////////////////
+/// \brief Compress log data into an XML chunk.
+/// \param[in] _data Data to compress.
+/// \param[in] _encoding One of the encodings of LogRecord::Start, other
+/// than binary.
+/// \return The chunk element.
+static std::string EncodeChunk(const std::string &_data,
+    const std::string &_encoding)
+{
+  std::string chunk;
+  chunk.append("<chunk encoding='");
+  chunk.append(_encoding);
+  chunk.append("'>\n");
+
+  chunk.append("<![CDATA[");
+  // Compress the data.
+  if (_encoding == "bz2")
+  {
+    std::string str;
+
+    // Compress to bzip2
+    {
+      boost::iostreams::filtering_ostream out;
+      out.push(boost::iostreams::bzip2_compressor());
+      out.push(std::back_inserter(str));
+      boost::iostreams::copy(boost::make_iterator_range(_data), out);
+    }
+
+    // Encode in base64.
+    Base64Encode(str.c_str(), str.size(), chunk);
+  }
+  else if (_encoding == "zlib")
+  {
+    std::string str;
+
+    // Compress to zlib
+    {
+      boost::iostreams::filtering_ostream out;
+      out.push(boost::iostreams::zlib_compressor());
+      out.push(std::back_inserter(str));
+      boost::iostreams::copy(boost::make_iterator_range(_data), out);
+    }
+
+    // Encode in base64.
+    Base64Encode(str.c_str(), str.size(), chunk);
+  }
+#ifdef HAVE_ZSTD
+  else if (_encoding == "zstd")
+  {
+    std::string str(ZSTD_compressBound(_data.size()), '\0');
+    size_t size = ZSTD_compress(&str[0], str.size(), _data.data(),
+        _data.size(), kZstdLevel);
+    if (ZSTD_isError(size))
+    {
+      gzerr << "Unable to compress log data: " << ZSTD_getErrorName(size)
+        << "\n";
+      return std::string();
+    }
+    str.resize(size);
+
+    // Encode in base64.
+    Base64Encode(str.c_str(), str.size(), chunk);
+  }
+#endif
+  else if (_encoding == "txt")
+    chunk.append(_data);
+  else
+    gzerr << "Unknown log file encoding[" << _encoding << "]\n";
+  chunk.append("]]>\n");
+
+  chunk.append("</chunk>\n");
+  return chunk;
+}
+
 //////////////////////////////////////////////////
 LogRecord::LogRecord()
 : dataPtr(new LogRecordPrivate)
@@ -139,7 +269,11 @@ bool LogRecord::Start(const LogRecordParams &_params)
 {
   this->dataPtr->period = _params.period;
   this->dataPtr->filter = _params.filter;
+  this->dataPtr->keyframePeriod = _params.keyframePeriod;
+  this->dataPtr->positionTolerance = _params.positionTolerance;
+  this->dataPtr->orientationTolerance = _params.orientationTolerance;
   this->dataPtr->recordResources = _params.recordResources;
+  this->dataPtr->topics = _params.topics;
   return this->Start(_params.encoding, _params.path);
 }
 
@@ -186,9 +320,33 @@ bool LogRecord::Start(const std::string &_encoding, const std::string &_path)
   if (!boost::filesystem::exists(this->dataPtr->logCompletePath))
     boost::filesystem::create_directories(this->dataPtr->logCompletePath);
 
-  if (_encoding != "bz2" && _encoding != "txt" && _encoding != "zlib")
+  // Resources are shared by the recordings next to this one. Keep the
+  // store on the same file system so they can be hard linked.
+  boost::filesystem::path storeParent = this->dataPtr->logBasePath;
+  if (!_path.empty())
+  {
+    storeParent = boost::filesystem::absolute(_path);
+    if (storeParent.filename() == ".")
+      storeParent = storeParent.parent_path();
+    storeParent = storeParent.parent_path();
+  }
+  this->dataPtr->resourceStorePath = storeParent / ".resources";
+
+  bool validEncoding = _encoding == "bz2" || _encoding == "txt" ||
+      _encoding == "zlib" || _encoding == "binary";
+#ifdef HAVE_ZSTD
+  validEncoding = validEncoding || _encoding == "zstd";
+#endif
+  if (!validEncoding)
+  {
+#ifdef HAVE_ZSTD
     gzthrow("Invalid log encoding[" + _encoding +
-            "]. Must be one of [bz2, zlib, txt]");
+            "]. Must be one of [bz2, zlib, zstd, txt, binary]");
+#else
+    gzthrow("Invalid log encoding[" + _encoding +
+            "]. Must be one of [bz2, zlib, txt, binary]");
+#endif
+  }
 
   this->dataPtr->encoding = _encoding;
 
@@ -202,6 +360,13 @@ bool LogRecord::Start(const std::string &_encoding, const std::string &_path)
       iter->second->Start(this->dataPtr->logCompletePath);
   }
 
+  if (!this->dataPtr->topics.empty())
+  {
+    this->dataPtr->topicRecorder.Start(
+        (this->dataPtr->logCompletePath / "topics.log").string(),
+        this->dataPtr->topics);
+  }
+
   this->dataPtr->running = true;
   this->dataPtr->paused = false;
   this->dataPtr->firstUpdate = true;
@@ -334,6 +499,30 @@ void LogRecord::SetFilter(const std::string &_filter)
   this->dataPtr->filter = _filter;
 }
 
+//////////////////////////////////////////////////
+double LogRecord::KeyframePeriod() const
+{
+  return this->dataPtr->keyframePeriod;
+}
+
+//////////////////////////////////////////////////
+double LogRecord::PositionTolerance() const
+{
+  return this->dataPtr->positionTolerance;
+}
+
+//////////////////////////////////////////////////
+double LogRecord::OrientationTolerance() const
+{
+  return this->dataPtr->orientationTolerance;
+}
+
+//////////////////////////////////////////////////
+void LogRecord::SetSimTime(const common::Time &_time)
+{
+  this->dataPtr->topicRecorder.SetSimTime(_time);
+}
+
 //////////////////////////////////////////////////
 bool LogRecord::Running() const
 {
@@ -524,6 +713,144 @@ bool LogRecord::FirstUpdate() const
   return this->dataPtr->firstUpdate;
 }
 
+//////////////////////////////////////////////////
+/// \brief Get the name of a file in the content addressed store: a hash
+/// of its content followed by its size.
+/// \param[in] _file Path to the file.
+/// \param[in,out] _hashes Names already computed, to avoid reading
+/// unchanged files again.
+/// \return The name, or an empty string if the file can't be read.
+static std::string StoreName(const boost::filesystem::path &_file,
+    std::map<std::string, std::string> &_hashes)
+{
+  boost::system::error_code ec;
+  const auto size = boost::filesystem::file_size(_file, ec);
+  if (ec)
+    return "";
+  const auto modified = boost::filesystem::last_write_time(_file, ec);
+  if (ec)
+    return "";
+
+  std::ostringstream key;
+  key << _file.string() << ":" << size << ":" << modified;
+  auto cached = _hashes.find(key.str());
+  if (cached != _hashes.end())
+    return cached->second;
+
+  std::ifstream in(_file.string(), std::ios::binary);
+  if (!in)
+    return "";
+
+  // 64 bit FNV-1a
+  uint64_t hash = 14695981039346656037ULL;
+  std::vector<char> buffer(64 * 1024);
+  while (in)
+  {
+    in.read(buffer.data(), buffer.size());
+    for (std::streamsize i = 0; i < in.gcount(); ++i)
+    {
+      hash ^= static_cast<unsigned char>(buffer[i]);
+      hash *= 1099511628211ULL;
+    }
+  }
+
+  std::ostringstream name;
+  name << std::hex << std::setw(16) << std::setfill('0') << hash
+       << std::dec << "-" << size;
+  _hashes[key.str()] = name.str();
+  return name.str();
+}
+
+//////////////////////////////////////////////////
+/// \brief Put a file in the content addressed store, if it is not there
+/// yet, and hard link it to its destination. Falls back to a plain copy
+/// if the store can't be used.
+/// \param[in] _src File to save.
+/// \param[in] _dest Destination in the log directory.
+/// \param[in] _store Content addressed store.
+/// \param[in,out] _hashes See StoreName().
+/// \return True on success.
+static bool StoreFile(const boost::filesystem::path &_src,
+    const boost::filesystem::path &_dest,
+    const boost::filesystem::path &_store,
+    std::map<std::string, std::string> &_hashes)
+{
+  boost::system::error_code ec;
+  boost::filesystem::create_directories(_dest.parent_path(), ec);
+  if (ec)
+    return false;
+
+  const std::string name = StoreName(_src, _hashes);
+  if (!name.empty())
+  {
+    boost::filesystem::path stored = _store / name;
+    if (!boost::filesystem::exists(stored))
+    {
+      // Copy under a unique name first, so that a concurrent recording
+      // never links a partial file.
+      boost::filesystem::create_directories(_store, ec);
+      boost::filesystem::path tmp = _store / boost::filesystem::unique_path(
+          ".%%%%-%%%%-%%%%-%%%%");
+      if (!ec)
+      {
+        boost::filesystem::copy_file(_src, tmp, ec);
+        if (!ec)
+          boost::filesystem::rename(tmp, stored, ec);
+        if (ec)
+          boost::filesystem::remove(tmp, ec);
+      }
+    }
+
+    boost::filesystem::remove(_dest, ec);
+    boost::filesystem::create_hard_link(stored, _dest, ec);
+    if (!ec)
+      return true;
+  }
+
+  boost::filesystem::remove(_dest, ec);
+  boost::filesystem::copy_file(_src, _dest, ec);
+  return !ec;
+}
+
+//////////////////////////////////////////////////
+/// \brief Save all the files of a directory, see StoreFile().
+/// \param[in] _src Directory to save.
+/// \param[in] _dest Destination in the log directory.
+/// \param[in] _store Content addressed store.
+/// \param[in,out] _hashes See StoreName().
+/// \return True on success.
+static bool StoreDir(const boost::filesystem::path &_src,
+    const boost::filesystem::path &_dest,
+    const boost::filesystem::path &_store,
+    std::map<std::string, std::string> &_hashes)
+{
+  boost::system::error_code ec;
+  if (!boost::filesystem::is_directory(_src, ec))
+    return false;
+
+  bool result = true;
+  boost::filesystem::recursive_directory_iterator it(_src, ec);
+  for (; !ec && it != boost::filesystem::recursive_directory_iterator();
+       it.increment(ec))
+  {
+    if (!boost::filesystem::is_regular_file(it->status()))
+      continue;
+
+    // The iterator prefixes every path with _src
+    std::string relative =
+        it->path().string().substr(_src.string().size());
+    relative.erase(0, relative.find_first_not_of("/\\"));
+
+    if (!StoreFile(it->path(), _dest / relative, _store, _hashes))
+    {
+      gzerr << "Failed to copy file from '" << it->path().string()
+            << "' to '" << (_dest / relative).string() << "'" << std::endl;
+      result = false;
+    }
+  }
+  return result && !ec;
+}
+
 //////////////////////////////////////////////////
 bool LogRecord::SaveModels(const std::set<std::string> &_models)
 {
@@ -532,37 +859,30 @@ bool LogRecord::SaveModels(const std::set<std::string> &_models)
       this->dataPtr->savedModels.begin(), this->dataPtr->savedModels.end(),
       std::inserter(diff, diff.begin()));
 
-  for (auto &model: diff)
+  std::lock_guard<std::mutex> lock(this->dataPtr->resourceMutex);
+  for (auto &model : diff)
   {
     if (model.empty())
       continue;
 
     this->dataPtr->savedModels.insert(model);
 
-    bool modelFound = false;
-    for (const auto &path : common::SystemPaths::Instance()->GetModelPaths())
-    {
-      boost::filesystem::path srcModelPath(path);
-      srcModelPath /= model;
-      if (boost::filesystem::exists(srcModelPath))
-      {
-        modelFound = true;
-        boost::filesystem::path destModelPath =
-          this->dataPtr->logCompletePath / model;
-        if (!gazebo::common::copyDir(srcModelPath, destModelPath))
-        {
-          gzerr << "Failed to copy model from '" << srcModelPath.string()
-                 << "' to '" << destModelPath.string() << "'" << std::endl;
-        }
-        break;
-      }
-    }
+    LogRecordPrivate::Resource resource;
+    resource.name = model;
+    resource.model = true;
+    resource.logPath = this->dataPtr->logCompletePath;
+    resource.storePath = this->dataPtr->resourceStorePath;
+    this->dataPtr->resourceQueue.push_back(resource);
+  }
 
-    if (!modelFound)
+  if (!this->dataPtr->resourceQueue.empty())
+  {
+    if (!this->dataPtr->resourceThread)
     {
-      gzwarn << "Model: " << model << " not found, "
-        << "please check the value of env variable GAZEBO_MODEL_PATH\n";
+      this->dataPtr->resourceThread.reset(new std::thread(
+          std::bind(&LogRecord::RunResources, this)));
     }
+    this->dataPtr->resourceCondition.notify_all();
   }
   return true;
 }
@@ -573,13 +893,13 @@ bool LogRecord::SaveFiles(const std::set<std::string> &_files)
   if (_files.empty())
     return false;
 
-  bool saveError = false;
   std::set<std::string> diff;
   std::set_difference(_files.begin(), _files.end(),
       this->dataPtr->savedFiles.begin(),
       this->dataPtr->savedFiles.end(),
       std::inserter(diff, diff.begin()));
 
+  std::lock_guard<std::mutex> lock(this->dataPtr->resourceMutex);
   for (auto &file : diff)
   {
     if (file.empty())
@@ -587,87 +907,137 @@ bool LogRecord::SaveFiles(const std::set<std::string> &_files)
 
     this->dataPtr->savedFiles.insert(file);
 
-    bool fileFound = false;
-    std::string prefix = "file://";
-    std::string fileName = file;
+    LogRecordPrivate::Resource resource;
+    resource.name = file;
+    resource.logPath = this->dataPtr->logCompletePath;
+    resource.storePath = this->dataPtr->resourceStorePath;
+    this->dataPtr->resourceQueue.push_back(resource);
+  }
+
+  if (!this->dataPtr->resourceQueue.empty())
+  {
+    if (!this->dataPtr->resourceThread)
+    {
+      this->dataPtr->resourceThread.reset(new std::thread(
+          std::bind(&LogRecord::RunResources, this)));
+    }
+    this->dataPtr->resourceCondition.notify_all();
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+void LogRecord::RunResources()
+{
+  common::SetThreadName("LogRecordResources");
+
+  std::unique_lock<std::mutex> lock(this->dataPtr->resourceMutex);
+  while (true)
+  {
+    this->dataPtr->resourceCondition.wait(lock, [this]
+        {
+          return this->dataPtr->stopThread ||
+                 !this->dataPtr->resourceQueue.empty();
+        });
+
+    // Stopped, and everything has been saved
+    if (this->dataPtr->resourceQueue.empty())
+      break;
+
+    LogRecordPrivate::Resource resource =
+        this->dataPtr->resourceQueue.front();
+    this->dataPtr->resourceQueue.pop_front();
+    lock.unlock();
 
-    boost::filesystem::path srcPath;
-    if (fileName.compare(0, prefix.size(), prefix) == 0)
+    auto &hashes = this->dataPtr->resourceHashes;
+    if (resource.model)
     {
-      // strip prefix
-      fileName = file.substr(prefix.size());
-      // search in gazebo path
-      for (const auto &path : common::SystemPaths::Instance()->GetGazeboPaths())
+      bool modelFound = false;
+      for (const auto &path :
+           common::SystemPaths::Instance()->GetModelPaths())
       {
-        auto p = boost::filesystem::path(path) / fileName;
-        if (common::exists(p.string()))
+        boost::filesystem::path srcModelPath(path);
+        srcModelPath /= resource.name;
+        if (boost::filesystem::exists(srcModelPath))
         {
-          srcPath = path;
-          fileFound = true;
+          modelFound = true;
+          StoreDir(srcModelPath, resource.logPath / resource.name,
+              resource.storePath, hashes);
           break;
         }
       }
-    }
 
-    // if not found in gazebo path or resource has abs path then check local
-    // filesystem
-    if (!fileFound || fileName[0] == '/')
-    {
-      fileFound = common::exists(fileName);
+      if (!modelFound)
+      {
+        gzwarn << "Model: " << resource.name << " not found, "
+          << "please check the value of env variable GAZEBO_MODEL_PATH\n";
+      }
     }
-
-    // copy resource
-    // NOTE: if file is a mesh, e.g. box.dae, it could contain reference to
-    // to texture files in other directories. A hacky workaround is to copy
-    // entire model dir
-    if (fileFound)
+    else
     {
-      // HACK! copy entire model dir if mesh
-      size_t meshIdx = fileName.find("/meshes/");
-      if (meshIdx != std::string::npos)
+      bool fileFound = false;
+      std::string prefix = "file://";
+      std::string fileName = resource.name;
+
+      boost::filesystem::path srcPath;
+      if (fileName.compare(0, prefix.size(), prefix) == 0)
       {
-        auto modelPath =
-            boost::filesystem::path(fileName.substr(0, meshIdx));
-        srcPath = srcPath / modelPath;
-        boost::filesystem::path destPath =
-          this->dataPtr->logCompletePath / modelPath;
-        boost::system::error_code errorCode;
-        boost::filesystem::create_directories(destPath, errorCode);
-        if (errorCode != boost::system::errc::success ||
-            !gazebo::common::copyDir(srcPath, destPath))
+        // strip prefix
+        fileName = resource.name.substr(prefix.size());
+        // search in gazebo path
+        for (const auto &path :
+             common::SystemPaths::Instance()->GetGazeboPaths())
         {
-          gzerr << "Failed to copy model from '" << srcPath.string()
-                 << "' to '" << destPath.string() << "'" << std::endl;
-          saveError = true;
+          auto p = boost::filesystem::path(path) / fileName;
+          if (common::exists(p.string()))
+          {
+            srcPath = path;
+            fileFound = true;
+            break;
+          }
         }
       }
-      // else copy only the specified file
-      else
+
+      // if not found in gazebo path or resource has abs path then check
+      // local filesystem
+      if (!fileFound || fileName[0] == '/')
+      {
+        fileFound = common::exists(fileName);
+      }
+
+      // copy resource
+      // NOTE: if file is a mesh, e.g. box.dae, it could contain reference
+      // to texture files in other directories. A hacky workaround is to
+      // copy entire model dir
+      if (fileFound)
       {
-        srcPath = srcPath / fileName;
-        boost::filesystem::path destPath =
-          this->dataPtr->logCompletePath / fileName;
-        boost::system::error_code errorCode;
-        boost::filesystem::create_directories(
-            destPath.parent_path(), errorCode);
-        if (errorCode == boost::system::errc::success)
-          boost::filesystem::copy_file(srcPath, destPath, errorCode);
-        else
+        // HACK! copy entire model dir if mesh
+        size_t meshIdx = fileName.find("/meshes/");
+        if (meshIdx != std::string::npos)
+        {
+          auto modelPath =
+              boost::filesystem::path(fileName.substr(0, meshIdx));
+          StoreDir(srcPath / modelPath, resource.logPath / modelPath,
+              resource.storePath, hashes);
+        }
+        // else copy only the specified file
+        else if (!StoreFile(srcPath / fileName,
+              resource.logPath / fileName, resource.storePath, hashes))
         {
-          gzerr << "Failed to copy file from '" << srcPath.string()
-                 << "' to '" << destPath.string() << "'" << std::endl;
-          saveError = true;
+          gzerr << "Failed to copy file from '"
+                << (srcPath / fileName).string() << "' to '"
+                << (resource.logPath / fileName).string() << "'"
+                << std::endl;
         }
       }
+      else
+      {
+        gzerr << "File: " << resource.name << " not found!" << std::endl;
+      }
     }
-    else
-    {
-      gzerr << "File: " << file << " not found!" << std::endl;
-      saveError = true;
-    }
-  }
 
-  return !saveError;
+    lock.lock();
+  }
 }
 
 //////////////////////////////////////////////////
@@ -677,9 +1047,23 @@ void LogRecord::Notify()
     this->dataPtr->updateCondition.notify_all();
 }
 
+//////////////////////////////////////////////////
+/// \brief Update the memory account of the log buffers. The write mutex
+/// must be locked.
+/// \param[in] _logs The logs.
+static void AccountBuffers(const LogRecordPrivate::Log_M &_logs)
+{
+  int64_t bytes = 0;
+  for (auto const &log : _logs)
+    bytes += log.second->BufferSize();
+
+  common::MemoryAccount::Get("util/log_record_buffers")->Set(bytes);
+}
+
 //////////////////////////////////////////////////
 void LogRecord::RunUpdate()
 {
+  common::SetThreadName("LogRecordUpdate");
   std::unique_lock<std::mutex> updateLock(this->dataPtr->updateMutex);
   this->dataPtr->startThreadCondition.notify_all();
 
@@ -711,6 +1095,7 @@ void LogRecord::Update()
       {
         size += this->dataPtr->updateIter->second->Update();
       }
+      AccountBuffers(this->dataPtr->logs);
     }
 
     if (this->dataPtr->firstUpdate)
@@ -733,6 +1118,7 @@ void LogRecord::Update()
 //////////////////////////////////////////////////
 void LogRecord::RunWrite()
 {
+  common::SetThreadName("LogRecordWrite");
   // Wait for new data.
   std::unique_lock<std::mutex> lock(this->dataPtr->runWriteMutex);
   this->dataPtr->startThreadCondition.notify_all();
@@ -758,6 +1144,7 @@ void LogRecord::Write(const bool /*_force*/)
   {
     this->dataPtr->updateIter->second->Write();
   }
+  AccountBuffers(this->dataPtr->logs);
 }
 
 //////////////////////////////////////////////////
@@ -796,49 +1183,41 @@ unsigned int LogRecordPrivate::Log::Update()
     {
       const std::string &encodingLocal = this->parent->Encoding();
 
-      this->buffer.append("<chunk encoding='");
-      this->buffer.append(encodingLocal);
-      this->buffer.append("'>\n");
+      // Compress frame aligned pieces of the data in parallel, each one
+      // becomes a chunk of its own and they are appended in order.
+      std::vector<std::pair<size_t, size_t>> pieces = SplitFrames(data);
+      std::vector<std::string> chunks(pieces.size());
+      std::vector<BinaryLog::ChunkInfo> infos(pieces.size());
 
-      this->buffer.append("<![CDATA[");
-      // Compress the data.
-      if (encodingLocal == "bz2")
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, pieces.size(), 1),
+          [&](const tbb::blocked_range<size_t> &_range)
       {
-        std::string str;
-
-        // Compress to bzip2
+        for (size_t i = _range.begin(); i != _range.end(); ++i)
         {
-          boost::iostreams::filtering_ostream out;
-          out.push(boost::iostreams::bzip2_compressor());
-          out.push(std::back_inserter(str));
-          boost::iostreams::copy(boost::make_iterator_range(data), out);
+          std::string piece = data.substr(pieces[i].first,
+              pieces[i].second - pieces[i].first);
+
+          // Binary chunks carry their own time index instead of XML markup
+          if (encodingLocal == "binary")
+            chunks[i] = BinaryLog::EncodeChunk(piece, &infos[i]);
+          else
+            chunks[i] = EncodeChunk(piece, encodingLocal);
         }
+      });
 
-        // Encode in base64.
-        Base64Encode(str.c_str(), str.size(), this->buffer);
-      }
-      else if (encodingLocal == "zlib")
+      for (size_t i = 0; i < chunks.size(); ++i)
       {
-        std::string str;
+        if (chunks[i].empty())
+          continue;
 
-        // Compress to zlib
+        if (encodingLocal == "binary")
         {
-          boost::iostreams::filtering_ostream out;
-          out.push(boost::iostreams::zlib_compressor());
-          out.push(std::back_inserter(str));
-          boost::iostreams::copy(boost::make_iterator_range(data), out);
+          infos[i].start = this->fileSize + this->buffer.size();
+          infos[i].offset += infos[i].start;
+          this->chunkIndex.push_back(infos[i]);
         }
-
-        // Encode in base64.
-        Base64Encode(str.c_str(), str.size(), this->buffer);
+        this->buffer.append(chunks[i]);
       }
-      else if (encodingLocal == "txt")
-        this->buffer.append(data);
-      else
-        gzerr << "Unknown log file encoding[" << encodingLocal << "]\n";
-      this->buffer.append("]]>\n");
-
-      this->buffer.append("</chunk>\n");
     }
   }
 
@@ -877,8 +1256,19 @@ void LogRecordPrivate::Log::Stop()
     this->Update();
     this->Write();
 
-    std::string xmlEnd = "</gazebo_log>";
-    this->logFile.write(xmlEnd.c_str(), xmlEnd.size());
+    // The binary header is a complete document already, the file ends
+    // with the index of its chunks instead
+    if (this->parent->Encoding() == "binary")
+    {
+      std::string index =
+        BinaryLog::EncodeIndex(this->chunkIndex, this->fileSize);
+      this->logFile.write(index.c_str(), index.size());
+    }
+    else
+    {
+      std::string xmlEnd = "</gazebo_log>";
+      this->logFile.write(xmlEnd.c_str(), xmlEnd.size());
+    }
 
     this->logFile.close();
   }
@@ -891,6 +1281,8 @@ void LogRecordPrivate::Log::Start(const boost::filesystem::path &_path)
 {
   // Make the full path for the log file
   this->completePath = _path / this->relativeFilename;
+  this->fileSize = 0;
+  this->chunkIndex.clear();
 
   // Make sure the file does not exist
   if (boost::filesystem::exists(this->completePath))
@@ -906,7 +1298,13 @@ void LogRecordPrivate::Log::Start(const boost::filesystem::path &_path)
          << "<rand_seed>" << ignition::math::Rand::Seed() << "</rand_seed>\n"
          << "</header>\n";
 
-  this->buffer.append(stream.str());
+  if (this->parent->Encoding() == "binary")
+  {
+    stream << "</gazebo_log>\n";
+    this->buffer.append(BinaryLog::EncodeHeader(stream.str()));
+  }
+  else
+    this->buffer.append(stream.str());
 }
 
 //////////////////////////////////////////////////
@@ -940,6 +1338,7 @@ void LogRecordPrivate::Log::Write()
   // Write out the contents of the buffer.
   this->logFile.write(this->buffer.c_str(), this->buffer.size());
   this->logFile.flush();
+  this->fileSize += this->buffer.size();
 
   // Clear the buffer.
   this->buffer.clear();
@@ -1030,6 +1429,7 @@ void LogRecord::PublishLogStatus()
 //////////////////////////////////////////////////
 void LogRecord::Cleanup()
 {
+  common::SetThreadName("LogRecordCleanup");
   std::unique_lock<std::mutex> lock(this->dataPtr->controlMutex);
   this->dataPtr->startThreadCondition.notify_all();
 
@@ -1072,12 +1472,22 @@ void LogRecord::Cleanup()
 
   this->Write(true);
 
+  // Wait for the resource thread to save what is still queued
+  {
+    std::lock_guard<std::mutex> resourceLock(this->dataPtr->resourceMutex);
+    this->dataPtr->resourceCondition.notify_all();
+  }
+  if (this->dataPtr->resourceThread)
+    this->dataPtr->resourceThread->join();
+  this->dataPtr->resourceThread.reset();
+
   // Stop all the logs
   for (LogRecordPrivate::Log_M::iterator iter = this->dataPtr->logs.begin();
       iter != this->dataPtr->logsEnd; ++iter)
   {
     iter->second->Stop();
   }
+  this->dataPtr->topicRecorder.Stop();
 
   // Reset the times
   this->dataPtr->startTime = this->dataPtr->currTime = common::Time();
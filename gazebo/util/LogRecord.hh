@@ -20,6 +20,7 @@
 #include <fstream>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/common/SingletonT.hh"
@@ -38,7 +39,7 @@ namespace gazebo
     /// \sa LogRecord::Start
     class LogRecordParams
     {
-      /// \brief The type of encoding (txt, zlib, or bz2).
+      /// \brief The type of encoding (txt, zlib, bz2, zstd or binary).
       public: std::string encoding = "zlib";
 
       /// \brief Path in which to store log files.
@@ -51,9 +52,26 @@ namespace gazebo
       /// \brief Log filter string
       public: std::string filter;
 
+      /// \brief Sim time in seconds between two full states. In between,
+      /// only the models and lights that moved past the tolerances are
+      /// recorded. A value <= 0 records every state in full.
+      public: double keyframePeriod = -1;
+
+      /// \brief Distance in meters a model or link has to move before it
+      /// is recorded again between full states.
+      public: double positionTolerance = 1e-3;
+
+      /// \brief Angle in radians a model or link has to turn before it is
+      /// recorded again between full states.
+      public: double orientationTolerance = 1e-3;
+
       /// \brief Recording resources. True will record state logs
       /// together with model meshes and materials.
       public: bool recordResources = false;
+
+      /// \brief Topics whose messages are recorded to topics.log, next to
+      /// the state log, stamped with the sim time of the last state.
+      public: std::vector<std::string> topics;
     };
 
     // Forward declare private data class
@@ -153,6 +171,27 @@ namespace gazebo
       /// \param[in] _filter New log record filter regex string
       public: void SetFilter(const std::string &_filter);
 
+      /// \brief Get the sim time between two full states.
+      /// \return Period in seconds, <= 0 if every state is recorded in
+      /// full.
+      /// \sa LogRecordParams::keyframePeriod
+      public: double KeyframePeriod() const;
+
+      /// \brief Get the distance a model or link has to move before it is
+      /// recorded again between full states.
+      /// \return Tolerance in meters.
+      public: double PositionTolerance() const;
+
+      /// \brief Get the angle a model or link has to turn before it is
+      /// recorded again between full states.
+      /// \return Tolerance in radians.
+      public: double OrientationTolerance() const;
+
+      /// \brief Set the sim time recorded topic messages are stamped with.
+      /// Called by the world with every state it captures.
+      /// \param[in] _time Sim time of the state.
+      public: void SetSimTime(const common::Time &_time);
+
       /// \brief Get whether the model meshes and materials are saved when
       /// recording.
       /// \return True if model meshes and materials are saved when recording.
@@ -176,14 +215,17 @@ namespace gazebo
       public: bool Start(const LogRecordParams &_params);
 
       /// \brief Start the logger.
-      /// \param[in] _encoding The type of encoding (txt, zlib, or bz2).
+      /// \param[in] _encoding The type of encoding (txt, zlib, bz2, zstd
+      /// or binary). zstd is only available if Gazebo was built with it.
       /// \param[in] _path Path in which to store log files.
       public: bool Start(const std::string &_encoding="zlib",
                          const std::string &_path="");
 
       /// \brief Get the encoding used.
-      /// \return Either [txt, zlib, or bz2], where txt is plain txt and bz2
-      /// and zlib are compressed data with Base64 encoding.
+      /// \return Either [txt, zlib, bz2, zstd or binary], where txt is plain
+      /// txt and bz2, zlib and zstd are compressed data with Base64
+      /// encoding. binary logs hold raw zlib compressed chunks indexed by
+      /// sim time.
       public: const std::string &Encoding() const;
 
       /// \brief Get the filename for a log object.
@@ -215,13 +257,17 @@ namespace gazebo
       /// \return True if an Update has not yet been completed.
       public: bool FirstUpdate() const;
 
-      /// \brief Return true if all the models are saved successfully.
-      /// \return True if all the models are saved successfully.
+      /// \brief Queue models that have not been saved yet. They are copied
+      /// into the log directory by a background thread, see
+      /// RunResources().
+      /// \return True if the models were queued.
       public: bool SaveModels(const std::set<std::string> &models);
 
-      /// \brief Return true if all the files are saved successfully.
-      /// \return True if all the files are saved successfully, and false if
-      /// there are errors saving the files.
+      /// \brief Queue files that have not been saved yet. They are copied
+      /// into the log directory by a background thread, see
+      /// RunResources().
+      /// \return True if the files were queued, and false if there are no
+      /// files to save.
       public: bool SaveFiles(const std::set<std::string> &resources);
 
       /// \brief Write all logs.
@@ -244,6 +290,12 @@ namespace gazebo
       /// \brief Run the Write loop.
       private: void RunWrite();
 
+      /// \brief Copy the queued models and files into the log directory.
+      /// Each file is stored once, named after its content, in a store
+      /// shared by all the recordings and hard linked into the log
+      /// directory.
+      private: void RunResources();
+
       /// \brief Clear and delete the log buffers.
       private: void ClearLogs();
 
@@ -17,15 +17,20 @@
 #ifndef _GAZEBO_UTIL_LOGRECORD_PRIVATE_HH_
 #define _GAZEBO_UTIL_LOGRECORD_PRIVATE_HH_
 
+#include <deque>
 #include <list>
 #include <map>
 #include <set>
 #include <string>
 #include <thread>
+#include <vector>
 #include <functional>
 #include <condition_variable>
 #include <boost/filesystem.hpp>
 
+#include "gazebo/util/BinaryLog.hh"
+#include "gazebo/util/LogTopicRecorder.hh"
+
 namespace gazebo
 {
   namespace util
@@ -101,6 +106,13 @@ namespace gazebo
 
         /// \brief Complete file path.
         public: boost::filesystem::path completePath;
+
+        /// \brief Number of bytes written to the log file.
+        public: uint64_t fileSize = 0;
+
+        /// \brief Chunks written so far with the binary encoding, saved as
+        /// an index at the end of the file.
+        public: std::vector<BinaryLog::ChunkInfo> chunkIndex;
       };
 
       /// \def Log_M
@@ -209,6 +221,15 @@ namespace gazebo
       /// \brief Record filter string.
       public: std::string filter = "";
 
+      /// \brief Sim time between two full states.
+      public: double keyframePeriod = -1.0;
+
+      /// \brief Position tolerance between full states.
+      public: double positionTolerance = 1e-3;
+
+      /// \brief Orientation tolerance between full states.
+      public: double orientationTolerance = 1e-3;
+
       /// \brief Record with model resources.
       public: bool recordResources = false;
 
@@ -217,6 +238,47 @@ namespace gazebo
 
       /// \brief List of saved files if record with resources is enabled.
       public: std::set<std::string> savedFiles;
+
+      /// \brief A model or file waiting to be copied into a log directory.
+      public: class Resource
+      {
+        /// \brief Name of the model, or uri of the file.
+        public: std::string name;
+
+        /// \brief True if this is a model, false if it is a file.
+        public: bool model = false;
+
+        /// \brief Log directory to copy it into.
+        public: boost::filesystem::path logPath;
+
+        /// \brief Content addressed store to hard link it from.
+        public: boost::filesystem::path storePath;
+      };
+
+      /// \brief Resources waiting for the resource thread.
+      public: std::deque<Resource> resourceQueue;
+
+      /// \brief Thread copying the resources, see RunResources().
+      public: std::unique_ptr<std::thread> resourceThread;
+
+      /// \brief Protects resourceQueue.
+      public: std::mutex resourceMutex;
+
+      /// \brief Signals new resources, or the end of the recording.
+      public: std::condition_variable resourceCondition;
+
+      /// \brief Content addressed store of the current recording.
+      public: boost::filesystem::path resourceStorePath;
+
+      /// \brief Store names of the files already hashed, indexed by path,
+      /// size and modification time. Only used by the resource thread.
+      public: std::map<std::string, std::string> resourceHashes;
+
+      /// \brief Topics to record.
+      public: std::vector<std::string> topics;
+
+      /// \brief Writes the messages of the recorded topics.
+      public: LogTopicRecorder topicRecorder;
     };
     /// \}
   }
@@ -22,6 +22,7 @@
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/SystemPaths.hh"
 #include "gazebo/common/Time.hh"
+#include "gazebo/gazebo_config.h"
 #include "gazebo/util/LogRecord.hh"
 #include "test/util.hh"
 
@@ -184,6 +185,35 @@ TEST_F(LogRecord_TEST, Start_zlib)
   }
 }
 
+/////////////////////////////////////////////////
+/// \brief Test LogRecord Start with zstd compression
+TEST_F(LogRecord_TEST, Start_zstd)
+{
+  gazebo::util::LogRecord *recorder = gazebo::util::LogRecord::Instance();
+
+  EXPECT_TRUE(recorder->Init("test"));
+
+#ifdef HAVE_ZSTD
+  EXPECT_TRUE(recorder->Start("zstd"));
+  EXPECT_TRUE(recorder->Running());
+  EXPECT_EQ(recorder->Encoding(), std::string("zstd"));
+
+  recorder->Stop();
+  EXPECT_FALSE(recorder->Running());
+
+  // Logger may still be writing so make sure we exit cleanly
+  int i = 0;
+  while (!recorder->IsReadyToStart())
+  {
+    gazebo::common::Time::MSleep(100);
+    if ((++i % 50) == 0)
+      gzdbg << "Waiting for recorder->IsReadyToStart()" << std::endl;
+  }
+#else
+  EXPECT_THROW(recorder->Start("zstd"), gazebo::common::Exception);
+#endif
+}
+
 /////////////////////////////////////////////////
 /// \brief Test LogRecord filter
 TEST_F(LogRecord_TEST, Filter)
@@ -0,0 +1,305 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/SamplingProfiler.hh"
+#include "gazebo/transport/Node.hh"
+#include "gazebo/util/LogTopicRecorder.hh"
+
+using namespace gazebo;
+using namespace util;
+
+/// \brief Magic string at the start of a topic log.
+static const char kFileMagic[] = "GZTOPICS";
+
+/// \brief Magic string at the start of each message.
+static const char kMessageMagic[] = "GZMS";
+
+/// \brief Queued bytes above which messages are dropped.
+static const size_t kMaxQueuedBytes = 512 * 1024 * 1024;
+
+/// \brief Nanoseconds in a second.
+static const int64_t kNsecPerSec = 1000000000;
+
+/////////////////////////////////////////////////
+/// \brief Append an unsigned integer in little endian order.
+/// \param[in,out] _out Bytes to append to.
+/// \param[in] _value Value to append.
+/// \param[in] _bytes Number of bytes of the value.
+static void AppendUint(std::string &_out, const uint64_t _value,
+    const unsigned int _bytes)
+{
+  for (unsigned int i = 0; i < _bytes; ++i)
+    _out.push_back(static_cast<char>((_value >> (8 * i)) & 0xff));
+}
+
+/////////////////////////////////////////////////
+/// \brief Read an unsigned integer stored in little endian order.
+/// \param[in] _in Stream to read from.
+/// \param[in] _bytes Number of bytes of the value.
+/// \param[out] _value Value read.
+/// \return False if the stream ended.
+static bool ReadUint(std::istream &_in, const unsigned int _bytes,
+    uint64_t &_value)
+{
+  unsigned char buffer[8];
+  if (!_in.read(reinterpret_cast<char *>(buffer), _bytes))
+    return false;
+
+  _value = 0;
+  for (unsigned int i = 0; i < _bytes; ++i)
+    _value |= static_cast<uint64_t>(buffer[i]) << (8 * i);
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Convert a time to nanoseconds.
+/// \param[in] _time Time.
+/// \return Nanoseconds.
+static int64_t ToNsec(const common::Time &_time)
+{
+  return static_cast<int64_t>(_time.sec) * kNsecPerSec + _time.nsec;
+}
+
+/////////////////////////////////////////////////
+/// \brief Convert nanoseconds to a time.
+/// \param[in] _nsec Nanoseconds.
+/// \return Time.
+static common::Time FromNsec(const int64_t _nsec)
+{
+  return common::Time(static_cast<int32_t>(_nsec / kNsecPerSec),
+                      static_cast<int32_t>(_nsec % kNsecPerSec));
+}
+
+/////////////////////////////////////////////////
+LogTopicRecorder::~LogTopicRecorder()
+{
+  this->Stop();
+}
+
+/////////////////////////////////////////////////
+bool LogTopicRecorder::Start(const std::string &_filename,
+    const std::vector<std::string> &_topics)
+{
+  if (this->thread)
+  {
+    gzerr << "Topic recording has already been started\n";
+    return false;
+  }
+
+  this->file.open(_filename, std::ios::out | std::ios::binary);
+  if (!this->file.is_open())
+  {
+    gzerr << "Unable to open file[" << _filename << "] for writing\n";
+    return false;
+  }
+  this->file.write(kFileMagic, sizeof(kFileMagic) - 1);
+
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->queue.clear();
+    this->queuedBytes = 0;
+    this->dropped = 0;
+    this->running = true;
+  }
+  this->thread.reset(new std::thread(&LogTopicRecorder::Run, this));
+
+  if (!_topics.empty())
+  {
+    this->node = transport::NodePtr(new transport::Node());
+    this->node->Init();
+
+    for (const auto &topic : _topics)
+    {
+      std::unique_ptr<Subscription> subscription(new Subscription);
+      subscription->recorder = this;
+      subscription->topic = topic;
+      subscription->sub = this->node->Subscribe(topic,
+          &Subscription::OnMessage, subscription.get());
+      this->subscriptions.push_back(std::move(subscription));
+    }
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+void LogTopicRecorder::Stop()
+{
+  // No message is added once the subscriptions are gone
+  this->subscriptions.clear();
+  if (this->node)
+    this->node->Fini();
+  this->node.reset();
+
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->running = false;
+  }
+  this->condition.notify_one();
+
+  if (this->thread && this->thread->joinable())
+    this->thread->join();
+  this->thread.reset();
+
+  if (this->file.is_open())
+    this->file.close();
+
+  if (this->dropped > 0)
+  {
+    gzwarn << "Dropped " << this->dropped << " topic messages that could "
+      << "not be written to disk fast enough\n";
+  }
+}
+
+/////////////////////////////////////////////////
+bool LogTopicRecorder::Running() const
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  return this->running;
+}
+
+/////////////////////////////////////////////////
+void LogTopicRecorder::SetSimTime(const common::Time &_time)
+{
+  this->simTime = ToNsec(_time);
+}
+
+/////////////////////////////////////////////////
+void LogTopicRecorder::Add(const std::string &_topic,
+    const std::string &_data)
+{
+  common::Time wallTime = common::Time::GetWallTime();
+
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (!this->running)
+      return;
+
+    if (this->queuedBytes + _data.size() > kMaxQueuedBytes)
+    {
+      ++this->dropped;
+      return;
+    }
+
+    this->queue.emplace_back();
+    Message &msg = this->queue.back();
+    msg.topic = _topic;
+    msg.simTime = FromNsec(this->simTime);
+    msg.wallTime = wallTime;
+    msg.data = _data;
+    this->queuedBytes += _data.size();
+  }
+  this->condition.notify_one();
+}
+
+/////////////////////////////////////////////////
+uint64_t LogTopicRecorder::Dropped() const
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  return this->dropped;
+}
+
+/////////////////////////////////////////////////
+void LogTopicRecorder::Run()
+{
+  common::SetThreadName("LogTopicRecorder");
+  std::vector<Message> messages;
+  std::string header;
+
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(this->mutex);
+      this->condition.wait(lock, [this]()
+          {
+            return !this->running || !this->queue.empty();
+          });
+
+      if (this->queue.empty())
+        break;
+
+      std::swap(messages, this->queue);
+      this->queuedBytes = 0;
+    }
+
+    // Only the small record headers are built, message data is written
+    // from where it was queued
+    for (const auto &msg : messages)
+    {
+      header.assign(kMessageMagic, sizeof(kMessageMagic) - 1);
+      AppendUint(header, ToNsec(msg.simTime), 8);
+      AppendUint(header, ToNsec(msg.wallTime), 8);
+      AppendUint(header, msg.topic.size(), 4);
+      header.append(msg.topic);
+      AppendUint(header, msg.data.size(), 4);
+
+      this->file.write(header.data(), header.size());
+      this->file.write(msg.data.data(), msg.data.size());
+    }
+    messages.clear();
+  }
+
+  this->file.flush();
+}
+
+/////////////////////////////////////////////////
+bool LogTopicRecorder::ReadHeader(std::istream &_in)
+{
+  char magic[sizeof(kFileMagic) - 1];
+  return _in.read(magic, sizeof(magic)) &&
+    std::string(magic, sizeof(magic)) == kFileMagic;
+}
+
+/////////////////////////////////////////////////
+bool LogTopicRecorder::ReadMessage(std::istream &_in, Message &_msg)
+{
+  char magic[sizeof(kMessageMagic) - 1];
+  if (!_in.read(magic, sizeof(magic)) ||
+      std::string(magic, sizeof(magic)) != kMessageMagic)
+  {
+    return false;
+  }
+
+  uint64_t simTime, wallTime, size;
+  if (!ReadUint(_in, 8, simTime) || !ReadUint(_in, 8, wallTime) ||
+      !ReadUint(_in, 4, size))
+  {
+    return false;
+  }
+
+  _msg.topic.resize(size);
+  if (size > 0 && !_in.read(&_msg.topic[0], size))
+    return false;
+
+  if (!ReadUint(_in, 4, size))
+    return false;
+
+  _msg.data.resize(size);
+  if (size > 0 && !_in.read(&_msg.data[0], size))
+    return false;
+
+  _msg.simTime = FromNsec(static_cast<int64_t>(simTime));
+  _msg.wallTime = FromNsec(static_cast<int64_t>(wallTime));
+  return true;
+}
+
+/////////////////////////////////////////////////
+void LogTopicRecorder::Subscription::OnMessage(const std::string &_data)
+{
+  this->recorder->Add(this->topic, _data);
+}
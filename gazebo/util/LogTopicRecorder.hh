@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef _GAZEBO_UTIL_LOGTOPICRECORDER_HH_
+#define _GAZEBO_UTIL_LOGTOPICRECORDER_HH_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/transport/TransportTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace util
+  {
+    /// \internal
+    /// \brief Records the messages of transport topics next to a state
+    /// log.
+    ///
+    /// Topics are subscribed to in process and their serialized messages
+    /// are queued for a writer thread, which swaps out the whole queue and
+    /// writes it without copying the messages again. Each message is
+    /// stamped with the sim time of the last state captured by the world
+    /// and the wall time it was received at, the same time base as the
+    /// state log. The file holds an 8 byte magic string followed by one
+    /// record per message:
+    ///
+    ///   "GZMS", sim time and wall time in nanoseconds (i64),
+    ///   topic size (u32), topic, data size (u32), data
+    ///
+    /// All integers are little endian.
+    class GZ_UTIL_VISIBLE LogTopicRecorder
+    {
+      /// \brief A recorded message.
+      public: class Message
+      {
+        /// \brief Topic the message was published on.
+        public: std::string topic;
+
+        /// \brief Sim time of the last captured state.
+        public: common::Time simTime;
+
+        /// \brief Wall time the message was received at.
+        public: common::Time wallTime;
+
+        /// \brief Serialized message.
+        public: std::string data;
+      };
+
+      /// \brief Constructor.
+      public: LogTopicRecorder() = default;
+
+      /// \brief Destructor. Stops recording.
+      public: ~LogTopicRecorder();
+
+      /// \brief Open the file, start the writer thread and subscribe to
+      /// the topics.
+      /// \param[in] _filename File to write.
+      /// \param[in] _topics Topics to record.
+      /// \return False if already running or the file can not be opened.
+      public: bool Start(const std::string &_filename,
+                  const std::vector<std::string> &_topics);
+
+      /// \brief Unsubscribe, write the queued messages and close the file.
+      public: void Stop();
+
+      /// \brief Check if recording.
+      /// \return True between Start() and Stop().
+      public: bool Running() const;
+
+      /// \brief Set the sim time messages are stamped with.
+      /// \param[in] _time Sim time of the last captured state.
+      public: void SetSimTime(const common::Time &_time);
+
+      /// \brief Queue a message for writing. Messages are dropped while
+      /// too much data is already waiting for the disk.
+      /// \param[in] _topic Topic of the message.
+      /// \param[in] _data Serialized message.
+      public: void Add(const std::string &_topic, const std::string &_data);
+
+      /// \brief Number of messages dropped since Start().
+      /// \return Dropped message count.
+      public: uint64_t Dropped() const;
+
+      /// \brief Read the magic string at the start of a topic log.
+      /// \param[in] _in Stream positioned at the start of the file.
+      /// \return False if the stream is not a topic log.
+      public: static bool ReadHeader(std::istream &_in);
+
+      /// \brief Read the next message of a topic log.
+      /// \param[in] _in Stream positioned at a record.
+      /// \param[out] _msg The message.
+      /// \return False at the end of the file or on an incomplete record.
+      public: static bool ReadMessage(std::istream &_in, Message &_msg);
+
+      /// \brief Writer thread.
+      private: void Run();
+
+      /// \brief Subscription to one topic.
+      private: class Subscription
+      {
+        /// \brief Forward a message to the recorder.
+        /// \param[in] _data Serialized message.
+        public: void OnMessage(const std::string &_data);
+
+        /// \brief Recorder to forward messages to.
+        public: LogTopicRecorder *recorder = nullptr;
+
+        /// \brief Topic subscribed to.
+        public: std::string topic;
+
+        /// \brief Transport subscriber.
+        public: transport::SubscriberPtr sub;
+      };
+
+      /// \brief Node used to subscribe.
+      private: transport::NodePtr node;
+
+      /// \brief One subscription per topic.
+      private: std::vector<std::unique_ptr<Subscription>> subscriptions;
+
+      /// \brief The file written.
+      private: std::ofstream file;
+
+      /// \brief Writer thread.
+      private: std::unique_ptr<std::thread> thread;
+
+      /// \brief Messages waiting for the writer thread.
+      private: std::vector<Message> queue;
+
+      /// \brief Bytes of data in the queue.
+      private: size_t queuedBytes = 0;
+
+      /// \brief Messages dropped since Start().
+      private: uint64_t dropped = 0;
+
+      /// \brief True while recording.
+      private: bool running = false;
+
+      /// \brief Protects the queue and the counters.
+      private: mutable std::mutex mutex;
+
+      /// \brief Signals the writer thread.
+      private: std::condition_variable condition;
+
+      /// \brief Sim time stamped on messages, in nanoseconds.
+      private: std::atomic<int64_t> simTime{0};
+    };
+  }
+}
+#endif
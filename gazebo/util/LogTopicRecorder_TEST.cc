@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "gazebo/util/LogTopicRecorder.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class LogTopicRecorder_TEST : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(LogTopicRecorder_TEST, WriteRead)
+{
+  std::string filename = "/tmp/__gz_log_topic_recorder_test.log";
+
+  util::LogTopicRecorder recorder;
+  EXPECT_FALSE(recorder.Running());
+
+  // Nothing is queued before recording starts
+  recorder.Add("/gazebo/default/ignored", "ignored");
+
+  ASSERT_TRUE(recorder.Start(filename, {}));
+  EXPECT_TRUE(recorder.Running());
+  EXPECT_FALSE(recorder.Start(filename, {}));
+
+  recorder.SetSimTime(common::Time(1, 500));
+  recorder.Add("/gazebo/default/camera", std::string("a\0b", 3));
+  recorder.SetSimTime(common::Time(2, 0));
+  recorder.Add("/gazebo/default/laser", "");
+  recorder.Stop();
+  EXPECT_FALSE(recorder.Running());
+  EXPECT_EQ(recorder.Dropped(), 0u);
+
+  // Stopped recorders drop nothing and write nothing
+  recorder.Add("/gazebo/default/ignored", "ignored");
+
+  std::ifstream in(filename, std::ios::binary);
+  ASSERT_TRUE(in.is_open());
+  ASSERT_TRUE(util::LogTopicRecorder::ReadHeader(in));
+
+  util::LogTopicRecorder::Message msg;
+  ASSERT_TRUE(util::LogTopicRecorder::ReadMessage(in, msg));
+  EXPECT_EQ(msg.topic, "/gazebo/default/camera");
+  EXPECT_EQ(msg.data, std::string("a\0b", 3));
+  EXPECT_EQ(msg.simTime, common::Time(1, 500));
+  EXPECT_GT(msg.wallTime, common::Time::Zero);
+
+  ASSERT_TRUE(util::LogTopicRecorder::ReadMessage(in, msg));
+  EXPECT_EQ(msg.topic, "/gazebo/default/laser");
+  EXPECT_TRUE(msg.data.empty());
+  EXPECT_EQ(msg.simTime, common::Time(2, 0));
+
+  EXPECT_FALSE(util::LogTopicRecorder::ReadMessage(in, msg));
+
+  in.close();
+  std::remove(filename.c_str());
+}
+
+/////////////////////////////////////////////////
+TEST_F(LogTopicRecorder_TEST, InvalidFile)
+{
+  util::LogTopicRecorder recorder;
+  EXPECT_FALSE(recorder.Start("/nonexistent/dir/topics.log", {}));
+  EXPECT_FALSE(recorder.Running());
+
+  std::istringstream in("GZLOGBIN");
+  EXPECT_FALSE(util::LogTopicRecorder::ReadHeader(in));
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
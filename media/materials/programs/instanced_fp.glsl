@@ -0,0 +1,22 @@
+uniform vec4 lightDirection;
+uniform vec4 lightDiffuse;
+uniform vec4 ambientLight;
+
+uniform vec4 diffuseColor;
+uniform vec4 ambientColor;
+uniform float useTexture;
+uniform sampler2D diffuseMap;
+
+varying vec3 worldNormal;
+varying vec2 uv;
+
+void main()
+{
+  vec3 normal = normalize(worldNormal);
+  float nDotL = max(dot(normal, -normalize(lightDirection.xyz)), 0.0);
+
+  vec4 base = mix(vec4(1.0), texture2D(diffuseMap, uv), useTexture);
+
+  gl_FragColor = vec4(base.rgb * (ambientLight.rgb * ambientColor.rgb +
+      lightDiffuse.rgb * diffuseColor.rgb * nDotL), diffuseColor.a);
+}
@@ -0,0 +1,21 @@
+// Instance world matrix, one row per texture coordinate set after the
+// mesh's own, filled by Ogre's basic hardware instancing
+uniform mat4 viewProjMatrix;
+
+varying vec3 worldNormal;
+varying vec2 uv;
+
+void main()
+{
+  mat4 worldMatrix;
+  worldMatrix[0] = gl_MultiTexCoord1;
+  worldMatrix[1] = gl_MultiTexCoord2;
+  worldMatrix[2] = gl_MultiTexCoord3;
+  worldMatrix[3] = vec4(0.0, 0.0, 0.0, 1.0);
+
+  vec4 worldPos = gl_Vertex * worldMatrix;
+  worldNormal = (vec4(gl_Normal, 0.0) * worldMatrix).xyz;
+
+  gl_Position = viewProjMatrix * worldPos;
+  uv = gl_MultiTexCoord0.xy;
+}
@@ -20,19 +20,28 @@ uniform float c3;
 // depends on the type of math function sin (X), tan (Y), or identity (Z)
 uniform vec3 fun;
 
+// 1 to show two back to back lenses side by side, 0 for a single lens
+uniform float dual;
+
 varying vec2 frag_pos;
 
 float pi = 3.141592653;
-float r = length(frag_pos);
-
-vec3 map(float th)
-{
-  // spherical to cartesian conversion
-  return vec3(-sin(th)*frag_pos.x/r, sin(th)*frag_pos.y/r, cos(th));
-}
 
 void main()
 {
+  vec2 pos = frag_pos;
+
+  // the left half of the image holds the front lens, the right half the
+  // lens looking backwards
+  float back = 0.0;
+  if (dual > 0.5)
+  {
+    back = step(pos.x, 0.0);
+    pos = vec2(2.0*pos.x + mix(-1.0, 1.0, back), 2.0*pos.y);
+  }
+
+  float r = length(pos);
+
   // calculate angle from optical axis based on the mapping function specified
   float param = r/(c1*f);
   float theta = 0.0;
@@ -45,7 +54,10 @@ void main()
   theta = (theta-c3)*c2;
 
   // compute the direction vector that will be used to sample from the cubemap
-  vec3 tc = map(theta);
+  // (spherical to cartesian conversion)
+  vec3 tc = vec3(-sin(theta)*pos.x/r, sin(theta)*pos.y/r, cos(theta));
+  if (back > 0.5)
+    tc.xz = -tc.xz;
 
   // sample and set resulting color
   gl_FragColor = vec4(textureCube(envMap, tc).rgb, 1);
@@ -31,11 +31,23 @@
   using raw_type = void;
 #endif
 
+#ifdef __linux__
+  #include <linux/futex.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
+
 #if defined(_MSC_VER)
 #include <BaseTsd.h>
 typedef SSIZE_T ssize_t;
 #endif
 
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstring>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -110,6 +122,40 @@ struct fdmPacket
   double positionXYZ[3];
 };
 
+/// \brief Layout of the shared memory block used for lockstep with a
+/// co-located SITL process, instead of the UDP sockets.
+///
+/// The SITL side writes a servo packet and then increments servoSeq, the
+/// plugin waits for servoSeq to change, reads the packet, writes the fdm
+/// packet and then increments fdmSeq. Both sides wake the other through a
+/// futex on the counter they increment.
+struct SharedLockstep
+{
+  /// \brief Set to kMagic once the block is initialized.
+  std::atomic<uint32_t> magic;
+
+  /// \brief Layout version, kVersion.
+  uint32_t version;
+
+  /// \brief Incremented by SITL after writing servo.
+  std::atomic<uint32_t> servoSeq;
+
+  /// \brief Incremented by the plugin after writing fdm.
+  std::atomic<uint32_t> fdmSeq;
+
+  /// \brief Last servo packet from SITL.
+  ServoPacket servo;
+
+  /// \brief Last fdm packet from the plugin.
+  fdmPacket fdm;
+
+  /// \brief Value of magic, "ACSM".
+  static const uint32_t kMagic = 0x4d534341;
+
+  /// \brief Current layout version.
+  static const uint32_t kVersion = 1;
+};
+
 /// \brief Rotor class
 class Rotor
 {
@@ -230,6 +276,125 @@ class gazebo::ArduCopterPluginPrivate
     #endif
   }
 
+  /// \brief Create and map the shared memory block used instead of the
+  /// sockets.
+  /// \param[in] _name POSIX shared memory name, such as "/arducopter0".
+  /// \return True on success.
+  public: bool OpenShared(const std::string &_name)
+  {
+#ifdef __linux__
+    int fd = shm_open(_name.c_str(), O_CREAT | O_RDWR, 0600);
+    if (fd < 0)
+    {
+      gzerr << "Unable to open shared memory [" << _name << "]: "
+            << strerror(errno) << "\n";
+      return false;
+    }
+
+    void *mem = MAP_FAILED;
+    if (ftruncate(fd, sizeof(SharedLockstep)) == 0)
+    {
+      mem = mmap(nullptr, sizeof(SharedLockstep), PROT_READ | PROT_WRITE,
+          MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (mem == MAP_FAILED)
+    {
+      gzerr << "Unable to map shared memory [" << _name << "]: "
+            << strerror(errno) << "\n";
+      shm_unlink(_name.c_str());
+      return false;
+    }
+
+    this->shared = static_cast<SharedLockstep *>(mem);
+    this->sharedName = _name;
+
+    // Keep the counters of a block left by a previous run, SITL may
+    // already be waiting on them
+    if (this->shared->magic.load() != SharedLockstep::kMagic ||
+        this->shared->version != SharedLockstep::kVersion)
+    {
+      this->shared->version = SharedLockstep::kVersion;
+      this->shared->servoSeq = 0;
+      this->shared->fdmSeq = 0;
+      this->shared->magic = SharedLockstep::kMagic;
+    }
+    this->servoSeq = this->shared->servoSeq.load();
+    return true;
+#else
+    gzwarn << "Shared memory lockstep [" << _name << "] is only available "
+           << "on Linux.\n";
+    return false;
+#endif
+  }
+
+  /// \brief Unmap and remove the shared memory block.
+  public: void CloseShared()
+  {
+#ifdef __linux__
+    if (!this->shared)
+      return;
+    munmap(this->shared, sizeof(SharedLockstep));
+    shm_unlink(this->sharedName.c_str());
+    this->shared = nullptr;
+#endif
+  }
+
+  /// \brief Wait for the next servo packet in shared memory.
+  /// \param[out] _pkt The packet.
+  /// \param[in] _timeoutMs Milliseconds to wait for the packet.
+  /// \return Size of the packet, or -1 on timeout.
+  public: ssize_t RecvShared(ServoPacket &_pkt, uint32_t _timeoutMs)
+  {
+#ifdef __linux__
+    uint32_t seq = this->shared->servoSeq.load(std::memory_order_acquire);
+    if (seq == this->servoSeq)
+    {
+      struct timespec ts;
+      ts.tv_sec = _timeoutMs / 1000;
+      ts.tv_nsec = (_timeoutMs % 1000) * 1000000L;
+
+      // Returns right away if SITL published in between, spurious wake ups
+      // count as a timeout and are retried on the next step
+      syscall(SYS_futex, reinterpret_cast<uint32_t *>(&this->shared->servoSeq),
+          FUTEX_WAIT, seq, &ts, nullptr, 0);
+      seq = this->shared->servoSeq.load(std::memory_order_acquire);
+      if (seq == this->servoSeq)
+        return -1;
+    }
+    this->servoSeq = seq;
+    _pkt = this->shared->servo;
+    return sizeof(_pkt);
+#else
+    (void)_pkt;
+    (void)_timeoutMs;
+    return -1;
+#endif
+  }
+
+  /// \brief Publish an fdm packet in shared memory and wake SITL.
+  /// \param[in] _pkt The packet.
+  public: void SendShared(const fdmPacket &_pkt)
+  {
+#ifdef __linux__
+    this->shared->fdm = _pkt;
+    this->shared->fdmSeq.fetch_add(1, std::memory_order_release);
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(&this->shared->fdmSeq),
+        FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+#else
+    (void)_pkt;
+#endif
+  }
+
+  /// \brief Shared memory block, null when using the sockets.
+  public: SharedLockstep *shared = nullptr;
+
+  /// \brief Name of the shared memory block.
+  public: std::string sharedName;
+
+  /// \brief Last servo sequence number read from shared memory.
+  public: uint32_t servoSeq = 0;
+
   /// \brief Pointer to the update event connection.
   public: event::ConnectionPtr updateConnection;
 
@@ -303,6 +468,7 @@ ArduCopterPlugin::ArduCopterPlugin()
 /////////////////////////////////////////////////
 ArduCopterPlugin::~ArduCopterPlugin()
 {
+  this->dataPtr->CloseShared();
 }
 
 /////////////////////////////////////////////////
@@ -455,6 +621,16 @@ void ArduCopterPlugin::Load(physics::ModelPtr _model, sdf::ElementPtr _sdf)
   getSdfParam<int>(_sdf, "connectionTimeoutMaxCount",
     this->dataPtr->connectionTimeoutMaxCount, 10);
 
+  // Lockstep through shared memory with a co-located SITL, the sockets
+  // are kept as the fallback
+  std::string sharedMemory;
+  if (getSdfParam<std::string>(_sdf, "sharedMemory", sharedMemory, "") &&
+      this->dataPtr->OpenShared(sharedMemory))
+  {
+    gzmsg << "ArduCopter lockstep through shared memory [" << sharedMemory
+          << "]\n";
+  }
+
   // Listen to the update event. This event is broadcast every simulation
   // iteration.
   this->dataPtr->updateConnection = event::Events::ConnectWorldUpdateBegin(
@@ -547,7 +723,9 @@ void ArduCopterPlugin::ReceiveMotorCommand()
     // Otherwise skip quickly and do not set control force.
     waitMs = 1;
   }
-  ssize_t recvSize = this->dataPtr->Recv(&pkt, sizeof(ServoPacket), waitMs);
+  ssize_t recvSize = this->dataPtr->shared ?
+    this->dataPtr->RecvShared(pkt, waitMs) :
+    this->dataPtr->Recv(&pkt, sizeof(ServoPacket), waitMs);
   ssize_t expectedPktSize =
     sizeof(pkt.motorSpeed[0])*this->dataPtr->rotors.size();
   if ((recvSize == -1) || (recvSize < expectedPktSize))
@@ -699,6 +877,12 @@ void ArduCopterPlugin::SendState() const
   pkt.velocityXYZ[1] = velNEDFrame.Y();
   pkt.velocityXYZ[2] = velNEDFrame.Z();
 
+  if (this->dataPtr->shared)
+  {
+    this->dataPtr->SendShared(pkt);
+    return;
+  }
+
   struct sockaddr_in sockaddr;
   this->dataPtr->MakeSockAddr("127.0.0.1", 9003, sockaddr);
 
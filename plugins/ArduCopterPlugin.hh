@@ -45,6 +45,10 @@ namespace gazebo
   /// <imuName>     scoped name for the imu sensor
   /// <connectionTimeoutMaxCount> timeout before giving up on
   ///                             controller synchronization
+  /// <sharedMemory> optional POSIX shared memory name, such as
+  ///                "/arducopter0", to lockstep with a SITL process on
+  ///                the same Linux host instead of using UDP. The layout
+  ///                is SharedLockstep in ArduCopterPlugin.cc.
   class GZ_PLUGIN_VISIBLE ArduCopterPlugin : public ModelPlugin
   {
     /// \brief Constructor.
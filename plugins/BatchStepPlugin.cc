@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <ignition/transport/Node.hh>
+
+#include "gazebo/physics/physics.hh"
+#include "plugins/BatchStepPlugin.hh"
+
+namespace gazebo
+{
+  /// \brief Private data for the BatchStepPlugin class
+  class BatchStepPluginPrivate
+  {
+    /// \brief Node offering the service.
+    public: ignition::transport::Node node;
+
+    /// \brief Serializes the requests.
+    public: std::mutex mutex;
+
+    /// \brief Stepper of the current configuration.
+    public: std::unique_ptr<physics::BatchStepper> stepper;
+
+    /// \brief Worlds of the stepper.
+    public: std::vector<physics::WorldPtr> worlds;
+
+    /// \brief Reset flag of each world, reused across requests.
+    public: std::vector<uint8_t> resets;
+  };
+}
+
+using namespace gazebo;
+
+// Register this plugin with the simulator
+GZ_REGISTER_SYSTEM_PLUGIN(BatchStepPlugin)
+
+/////////////////////////////////////////////////
+BatchStepPlugin::BatchStepPlugin()
+  : dataPtr(new BatchStepPluginPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+BatchStepPlugin::~BatchStepPlugin()
+{
+  this->dataPtr->node.UnadvertiseSrv("/gazebo/batch_step");
+}
+
+/////////////////////////////////////////////////
+void BatchStepPlugin::Load(int /*_argc*/, char ** /*_argv*/)
+{
+  if (!this->dataPtr->node.Advertise("/gazebo/batch_step",
+      &BatchStepPlugin::OnBatchStep, this))
+  {
+    gzerr << "Unable to advertise the /gazebo/batch_step service\n";
+  }
+}
+
+/////////////////////////////////////////////////
+bool BatchStepPlugin::OnBatchStep(const msgs::BatchStepRequest &_req,
+    msgs::BatchStepResponse &_rep)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  // The worlds are only known once the server has loaded them
+  if (!this->dataPtr->stepper || _req.joint_size() > 0 ||
+      _req.link_size() > 0)
+  {
+    this->dataPtr->worlds = physics::get_worlds();
+    if (this->dataPtr->worlds.empty())
+    {
+      gzerr << "No world to step\n";
+      return false;
+    }
+
+    this->dataPtr->stepper.reset(new physics::BatchStepper(
+        this->dataPtr->worlds,
+        {_req.joint().begin(), _req.joint().end()},
+        {_req.link().begin(), _req.link().end()}));
+    this->dataPtr->resets.assign(this->dataPtr->worlds.size(), 0);
+  }
+
+  auto &stepper = *this->dataPtr->stepper;
+  if (!stepper.Valid())
+    return false;
+
+  const size_t actionCount = stepper.WorldCount() * stepper.ActionSize();
+  if (_req.action_size() > 0 &&
+      static_cast<size_t>(_req.action_size()) != actionCount)
+  {
+    gzerr << "Expected " << actionCount << " actions, got "
+          << _req.action_size() << "\n";
+    return false;
+  }
+
+  auto &resets = this->dataPtr->resets;
+  std::fill(resets.begin(), resets.end(), 0);
+  for (auto const index : _req.reset())
+  {
+    if (index < resets.size())
+      resets[index] = 1;
+  }
+
+  for (auto const &world : this->dataPtr->worlds)
+    _rep.add_world(world->Name());
+  _rep.set_values_per_world(stepper.ObservationSize());
+
+  // Write the observations straight into the reply
+  _rep.mutable_observation()->Resize(
+      stepper.WorldCount() * stepper.ObservationSize(), 0.0);
+  return stepper.Step(
+      _req.action_size() > 0 ? _req.action().data() : nullptr,
+      _req.steps(), _rep.mutable_observation()->mutable_data(),
+      resets.data(), _req.flags());
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PLUGINS_BATCHSTEPPLUGIN_HH_
+#define GAZEBO_PLUGINS_BATCHSTEPPLUGIN_HH_
+
+#include <memory>
+
+#include "gazebo/common/Plugin.hh"
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  // Forward declare private data class
+  class BatchStepPluginPrivate;
+
+  /// \brief A system plugin that offers the ignition transport service
+  /// /gazebo/batch_step, which steps every world of the server with one
+  /// request, see physics::BatchStepper. Combined with --world_copies it
+  /// lets a reinforcement learning trainer drive N environments with one
+  /// round trip per step instead of N:
+  ///
+  ///     gzserver -u --world_copies 16 -s libBatchStepPlugin.so my.world
+  ///
+  /// The first request names the joints and links, the following ones
+  /// only carry the efforts and the worlds to reset.
+  class GZ_PLUGIN_VISIBLE BatchStepPlugin : public SystemPlugin
+  {
+    /// \brief Constructor.
+    public: BatchStepPlugin();
+
+    /// \brief Destructor.
+    public: virtual ~BatchStepPlugin();
+
+    // Documentation inherited
+    public: virtual void Load(int _argc, char **_argv);
+
+    /// \brief Service callback.
+    /// \param[in] _req Efforts, resets and optionally a new configuration.
+    /// \param[out] _rep Observations of all the worlds.
+    /// \return True if the worlds were stepped.
+    private: bool OnBatchStep(const msgs::BatchStepRequest &_req,
+                              msgs::BatchStepResponse &_rep);
+
+    /// \internal
+    /// \brief Pointer to private data.
+    private: std::unique_ptr<BatchStepPluginPrivate> dataPtr;
+  };
+}
+#endif
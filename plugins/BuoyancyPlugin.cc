@@ -120,7 +120,7 @@ void BuoyancyPlugin::Load(physics::ModelPtr _model, sdf::ElementPtr _sdf)
 
   // For links the user didn't input, precompute the center of volume and
   // density. This will be accurate for simple shapes.
-  for (auto link : this->model->GetLinks())
+  for (auto const &link : this->model->GetLinks())
   {
     int id = link->GetId();
     if (this->volPropsMap.find(id) == this->volPropsMap.end())
@@ -130,7 +130,7 @@ void BuoyancyPlugin::Load(physics::ModelPtr _model, sdf::ElementPtr _sdf)
 
       // The center of volume of the link is a weighted average over the pose
       // of each collision shape, where the weight is the volume of the shape
-      for (auto collision : link->GetCollisions())
+      for (auto const &collision : link->GetCollisions())
       {
         double volume = collision->GetShape()->ComputeVolume();
         volumeSum += volume;
@@ -156,7 +156,7 @@ void BuoyancyPlugin::OnUpdate()
 {
   IGN_PROFILE("BuoyancyPlugin::OnUpdate");
   IGN_PROFILE_BEGIN("Update");
-  for (auto link : this->model->GetLinks())
+  for (auto const &link : this->model->GetLinks())
   {
     VolumeProperties volumeProperties = this->volPropsMap[link->GetId()];
     double volume = volumeProperties.volume;
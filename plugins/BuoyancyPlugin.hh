@@ -57,6 +57,9 @@ namespace gazebo
   /// to compute these properties from the link collision shapes. This
   /// computation will not be accurate if the object is not composed of simple
   /// collision shapes.
+  ///
+  /// Each instance has its own update callback, see BuoyancyWorldPlugin
+  /// for worlds with many floating models or a fluid surface.
   class GZ_PLUGIN_VISIBLE BuoyancyPlugin : public ModelPlugin
   {
     /// \brief Constructor.
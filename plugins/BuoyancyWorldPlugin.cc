@@ -0,0 +1,389 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <ignition/common/Profiler.hh>
+#include <ignition/math/Helpers.hh>
+#include <ignition/math/Matrix3.hh>
+
+#include "gazebo/common/Assert.hh"
+#include "gazebo/common/Events.hh"
+#include "gazebo/physics/physics.hh"
+#include "plugins/BuoyancyWorldPlugin.hh"
+
+namespace gazebo
+{
+  /// \brief Volume properties of a link, in the link frame.
+  struct FluidVolume
+  {
+    /// \brief Center of volume, where buoyancy applies.
+    ignition::math::Vector3d cov;
+
+    /// \brief Volume in m^3.
+    double volume = 0;
+
+    /// \brief Center of the collision bounding box.
+    ignition::math::Vector3d boxCenter;
+
+    /// \brief Half extents of the collision bounding box.
+    ignition::math::Vector3d boxHalfSize;
+  };
+
+  /// \brief A registered link.
+  struct FluidLink
+  {
+    /// \brief The link, valid while the cache version is unchanged.
+    physics::Link *link = nullptr;
+
+    /// \brief Index of the link in the kinematics cache.
+    size_t index = 0;
+
+    /// \brief Volume properties of the link.
+    FluidVolume volume;
+  };
+
+  /// \brief Forces on a registered link in the current step.
+  struct FluidForces
+  {
+    /// \brief Submerged fraction of the link, nothing applies when 0.
+    double fraction = 0;
+
+    /// \brief Buoyancy in the link frame, applied at the center of
+    /// volume.
+    ignition::math::Vector3d buoyancy;
+
+    /// \brief Damping force in the world frame.
+    ignition::math::Vector3d force;
+
+    /// \brief Damping torque in the world frame.
+    ignition::math::Vector3d torque;
+  };
+
+  /// \brief Private data for the BuoyancyWorldPlugin class
+  class BuoyancyWorldPluginPrivate
+  {
+    /// \brief The world.
+    public: physics::WorldPtr world;
+
+    /// \brief Connection to World Update events.
+    public: event::ConnectionPtr updateConnection;
+
+    /// \brief Density of the fluid in kg/m^3.
+    public: double fluidDensity = 999.1026;
+
+    /// \brief Height of the fluid surface.
+    public: double fluidLevel = std::numeric_limits<double>::infinity();
+
+    /// \brief Damping force per m/s of a fully submerged link.
+    public: double linearDamping = 0;
+
+    /// \brief Damping torque per rad/s of a fully submerged link.
+    public: double angularDamping = 0;
+
+    /// \brief True to compute the forces on several threads.
+    public: bool parallel = true;
+
+    /// \brief Names of the top level models to handle, all if empty.
+    public: std::set<std::string> models;
+
+    /// \brief Volume properties given in SDF, by scoped link name.
+    public: std::map<std::string, FluidVolume> sdfVolumes;
+
+    /// \brief Volume properties of every link seen so far, by id, so
+    /// that rebuilds don't recompute them.
+    public: std::unordered_map<uint32_t, FluidVolume> volumes;
+
+    /// \brief Registered links.
+    public: std::vector<FluidLink> links;
+
+    /// \brief Forces of each registered link, reused across steps.
+    public: std::vector<FluidForces> forces;
+
+    /// \brief Kinematics cache version the links were registered from.
+    public: uint64_t version = 0;
+
+    /// \brief True once the links have been registered.
+    public: bool built = false;
+  };
+}
+
+using namespace gazebo;
+
+GZ_REGISTER_WORLD_PLUGIN(BuoyancyWorldPlugin)
+
+/// \brief Compute the volume properties of a link from its collisions.
+/// \param[in] _link The link.
+/// \return Volume properties in the link frame.
+static FluidVolume ComputeVolume(const physics::Link &_link)
+{
+  FluidVolume result;
+  const ignition::math::Pose3d linkPose = _link.WorldPose();
+
+  // The center of volume is a weighted average over the pose of each
+  // collision shape, where the weight is the volume of the shape
+  ignition::math::Vector3d weightedPosSum;
+  for (auto const &collision : _link.GetCollisions())
+  {
+    const double volume = collision->GetShape()->ComputeVolume();
+    result.volume += volume;
+    weightedPosSum += volume * collision->WorldPose().Pos();
+  }
+  if (result.volume > 0)
+  {
+    result.cov = linkPose.Rot().RotateVectorReverse(
+        weightedPosSum / result.volume - linkPose.Pos());
+  }
+
+  // Bound the world box in the link frame, through its corners
+  const ignition::math::AxisAlignedBox box = _link.BoundingBox();
+  ignition::math::Vector3d min(std::numeric_limits<double>::max(),
+      std::numeric_limits<double>::max(), std::numeric_limits<double>::max());
+  ignition::math::Vector3d max = -min;
+  for (int i = 0; i < 8; ++i)
+  {
+    const ignition::math::Vector3d corner(
+        (i & 1) ? box.Max().X() : box.Min().X(),
+        (i & 2) ? box.Max().Y() : box.Min().Y(),
+        (i & 4) ? box.Max().Z() : box.Min().Z());
+    const ignition::math::Vector3d local = linkPose.Rot().RotateVectorReverse(
+        corner - linkPose.Pos());
+    min.Min(local);
+    max.Max(local);
+  }
+  result.boxCenter = (min + max) * 0.5;
+  result.boxHalfSize = (max - min) * 0.5;
+  return result;
+}
+
+/////////////////////////////////////////////////
+BuoyancyWorldPlugin::BuoyancyWorldPlugin()
+  : WorldPlugin(), dataPtr(new BuoyancyWorldPluginPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+BuoyancyWorldPlugin::~BuoyancyWorldPlugin()
+{
+}
+
+/////////////////////////////////////////////////
+void BuoyancyWorldPlugin::Load(physics::WorldPtr _world,
+    sdf::ElementPtr _sdf)
+{
+  GZ_ASSERT(_world != nullptr, "Received NULL world pointer");
+  GZ_ASSERT(_sdf != nullptr, "Received NULL SDF pointer");
+  this->dataPtr->world = _world;
+
+  if (_sdf->HasElement("fluid_density"))
+    this->dataPtr->fluidDensity = _sdf->Get<double>("fluid_density");
+  if (_sdf->HasElement("fluid_level"))
+    this->dataPtr->fluidLevel = _sdf->Get<double>("fluid_level");
+  if (_sdf->HasElement("linear_damping"))
+    this->dataPtr->linearDamping = _sdf->Get<double>("linear_damping");
+  if (_sdf->HasElement("angular_damping"))
+    this->dataPtr->angularDamping = _sdf->Get<double>("angular_damping");
+  if (_sdf->HasElement("parallel"))
+    this->dataPtr->parallel = _sdf->Get<bool>("parallel");
+
+  for (auto elem = _sdf->HasElement("model") ? _sdf->GetElement("model") :
+       nullptr; elem; elem = elem->GetNextElement("model"))
+  {
+    this->dataPtr->models.insert(elem->Get<std::string>());
+  }
+
+  for (auto elem = _sdf->HasElement("link") ? _sdf->GetElement("link") :
+       nullptr; elem; elem = elem->GetNextElement("link"))
+  {
+    const std::string name = elem->Get<std::string>("name");
+    if (name.empty() || !elem->HasElement("center_of_volume") ||
+        !elem->HasElement("volume") || elem->Get<double>("volume") <= 0)
+    {
+      gzwarn << "BuoyancyWorldPlugin <link> [" << name << "] needs a name, "
+             << "a <center_of_volume> and a positive <volume>, skipping"
+             << std::endl;
+      continue;
+    }
+
+    FluidVolume &volume = this->dataPtr->sdfVolumes[name];
+    volume.cov = elem->Get<ignition::math::Vector3d>("center_of_volume");
+    volume.volume = elem->Get<double>("volume");
+  }
+
+  _world->SetLinkKinematicsCacheEnabled(true);
+
+  // At the end of the update, while the link kinematics cache is current.
+  // The forces apply to the next step.
+  this->dataPtr->updateConnection = event::Events::ConnectWorldUpdateEnd(
+      std::bind(&BuoyancyWorldPlugin::OnUpdate, this));
+}
+
+/////////////////////////////////////////////////
+void BuoyancyWorldPlugin::Rebuild()
+{
+  const physics::LinkKinematicsCache &cache =
+      this->dataPtr->world->LinkKinematics();
+
+  this->dataPtr->links.clear();
+  const std::vector<physics::Link *> &links = cache.Links();
+  for (size_t i = 0; i < links.size(); ++i)
+  {
+    physics::Link *link = links[i];
+    if (link->IsStatic())
+      continue;
+
+    const std::string scopedName = link->GetScopedName();
+    if (!this->dataPtr->models.empty() &&
+        !this->dataPtr->models.count(scopedName.substr(0,
+        scopedName.find("::"))))
+    {
+      continue;
+    }
+
+    auto iter = this->dataPtr->volumes.find(link->GetId());
+    if (iter == this->dataPtr->volumes.end())
+    {
+      FluidVolume volume = ComputeVolume(*link);
+      auto sdfIter = this->dataPtr->sdfVolumes.find(scopedName);
+      if (sdfIter != this->dataPtr->sdfVolumes.end())
+      {
+        volume.cov = sdfIter->second.cov;
+        volume.volume = sdfIter->second.volume;
+      }
+      iter = this->dataPtr->volumes.emplace(link->GetId(), volume).first;
+    }
+
+    // Links without collisions neither float nor sink
+    if (iter->second.volume <= 0)
+      continue;
+
+    FluidLink fluidLink;
+    fluidLink.link = link;
+    fluidLink.index = i;
+    fluidLink.volume = iter->second;
+    this->dataPtr->links.push_back(fluidLink);
+  }
+  this->dataPtr->forces.resize(this->dataPtr->links.size());
+}
+
+/////////////////////////////////////////////////
+void BuoyancyWorldPlugin::OnUpdate()
+{
+  IGN_PROFILE("BuoyancyWorldPlugin::OnUpdate");
+
+  const physics::LinkKinematicsCache &cache =
+      this->dataPtr->world->LinkKinematics();
+  if (!this->dataPtr->built || this->dataPtr->version != cache.Version())
+  {
+    this->Rebuild();
+    this->dataPtr->version = cache.Version();
+    this->dataPtr->built = true;
+  }
+
+  const auto &poses = cache.Poses();
+  const auto &linearVels = cache.LinearVels();
+  const auto &angularVels = cache.AngularVels();
+  const ignition::math::Vector3d gravity = this->dataPtr->world->Gravity();
+  const double level = this->dataPtr->fluidLevel;
+  const double density = this->dataPtr->fluidDensity;
+  const double linearDamping = this->dataPtr->linearDamping;
+  const double angularDamping = this->dataPtr->angularDamping;
+  const auto &links = this->dataPtr->links;
+  auto &forces = this->dataPtr->forces;
+
+  // Each link only depends on its own state
+  auto compute = [&](const size_t _begin, const size_t _end)
+  {
+    for (size_t i = _begin; i < _end; ++i)
+    {
+      const FluidLink &fluidLink = links[i];
+      const FluidVolume &volume = fluidLink.volume;
+      const ignition::math::Pose3d &pose = poses[fluidLink.index];
+      FluidForces &out = forces[i];
+
+      // Vertical extent of the link frame box in the world
+      const ignition::math::Matrix3d rot(pose.Rot());
+      const double centerZ = pose.Pos().Z() +
+          pose.Rot().RotateVector(volume.boxCenter).Z();
+      const double halfHeight =
+          std::abs(rot(2, 0)) * volume.boxHalfSize.X() +
+          std::abs(rot(2, 1)) * volume.boxHalfSize.Y() +
+          std::abs(rot(2, 2)) * volume.boxHalfSize.Z();
+      if (halfHeight > 0)
+      {
+        out.fraction = ignition::math::clamp(
+            (level - (centerZ - halfHeight)) / (2 * halfHeight), 0.0, 1.0);
+      }
+      else
+      {
+        out.fraction = centerZ < level ? 1.0 : 0.0;
+      }
+      if (out.fraction <= 0)
+        continue;
+
+      // By Archimedes' principle, the weight of the displaced fluid
+      out.buoyancy = pose.Rot().RotateVectorReverse(
+          -density * volume.volume * out.fraction * gravity);
+      out.force = -linearDamping * out.fraction * linearVels[fluidLink.index];
+      out.torque =
+          -angularDamping * out.fraction * angularVels[fluidLink.index];
+    }
+  };
+
+  IGN_PROFILE_BEGIN("Compute");
+  if (this->dataPtr->parallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, links.size(), 64),
+        [&compute](const tbb::blocked_range<size_t> &_r)
+        {
+          compute(_r.begin(), _r.end());
+        });
+  }
+  else
+  {
+    compute(0, links.size());
+  }
+  IGN_PROFILE_END();
+
+  // Engines don't support concurrent force accumulation, apply serially
+  IGN_PROFILE_BEGIN("Apply");
+  boost::recursive_mutex::scoped_lock lock(
+      *this->dataPtr->world->Physics()->GetPhysicsUpdateMutex());
+  for (size_t i = 0; i < links.size(); ++i)
+  {
+    const FluidForces &out = forces[i];
+    if (out.fraction <= 0)
+      continue;
+
+    physics::Link *link = links[i].link;
+    link->AddLinkForce(out.buoyancy, links[i].volume.cov);
+    if (linearDamping != 0)
+      link->AddForce(out.force);
+    if (angularDamping != 0)
+      link->AddTorque(out.torque);
+  }
+  IGN_PROFILE_END();
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PLUGINS_BUOYANCYWORLDPLUGIN_HH_
+#define GAZEBO_PLUGINS_BUOYANCYWORLDPLUGIN_HH_
+
+#include <memory>
+
+#include "gazebo/common/Plugin.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  // Forward declare private data class
+  class BuoyancyWorldPluginPrivate;
+
+  /// \brief A world plugin that simulates a fluid for every dynamic link of
+  /// the world from a single update callback, instead of one
+  /// BuoyancyPlugin per model. Links are found through the world's
+  /// physics::LinkKinematicsCache, which the plugin enables, and their
+  /// poses and velocities are read from its arrays.
+  ///
+  /// The fluid fills the space below <fluid_level>. The bounding box of
+  /// each link's collisions is cached in the link frame when the link is
+  /// registered, and every step the submerged fraction of its height
+  /// scales the buoyancy and the damping of the link. Volumes and centers
+  /// of volume are computed from the collision shapes as in
+  /// BuoyancyPlugin, or given per link.
+  ///
+  /// <plugin name="fluid" filename="libBuoyancyWorldPlugin.so">
+  ///   <fluid_density>999.1026</fluid_density>
+  ///   <!-- Height of the surface, no surface when omitted -->
+  ///   <fluid_level>0</fluid_level>
+  ///   <!-- Force per m/s and torque per rad/s on a fully submerged link -->
+  ///   <linear_damping>0</linear_damping>
+  ///   <angular_damping>0</angular_damping>
+  ///   <!-- Compute the forces on several threads -->
+  ///   <parallel>true</parallel>
+  ///   <!-- Only these top level models, all of them when omitted -->
+  ///   <model>boat</model>
+  ///   <link name="boat::hull">
+  ///     <center_of_volume>0 0 0.1</center_of_volume>
+  ///     <volume>0.4</volume>
+  ///   </link>
+  /// </plugin>
+  class GZ_PLUGIN_VISIBLE BuoyancyWorldPlugin : public WorldPlugin
+  {
+    /// \brief Constructor.
+    public: BuoyancyWorldPlugin();
+
+    /// \brief Destructor.
+    public: virtual ~BuoyancyWorldPlugin();
+
+    // Documentation inherited
+    public: virtual void Load(physics::WorldPtr _world,
+                              sdf::ElementPtr _sdf);
+
+    /// \brief Callback for World Update End events.
+    private: void OnUpdate();
+
+    /// \brief Register the links of the kinematics cache, after entities
+    /// were added or removed.
+    private: void Rebuild();
+
+    /// \internal
+    /// \brief Pointer to private data.
+    private: std::unique_ptr<BuoyancyWorldPluginPrivate> dataPtr;
+  };
+}
+#endif
@@ -131,16 +131,12 @@ double LinearBatteryPlugin::OnUpdateVoltage(const common::BatteryPtr &_battery)
   IGN_PROFILE("LinearBatteryPlugin::OnUpdateVoltage");
   IGN_PROFILE_BEGIN("Update");
   double dt = this->world->Physics()->GetMaxStepSize();
-  double totalpower = 0.0;
   double k = dt / this->tau;
 
   if (fabs(_battery->Voltage()) < 1e-3)
     return 0.0;
 
-  for (auto powerLoad : _battery->PowerLoads())
-    totalpower += powerLoad.second;
-
-  this->iraw = totalpower / _battery->Voltage();
+  this->iraw = _battery->TotalPowerLoad() / _battery->Voltage();
 
   this->ismooth = this->ismooth + k * (this->iraw - this->ismooth);
 
@@ -0,0 +1,426 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ignition/math/Helpers.hh>
+#include <ignition/transport/Node.hh>
+
+#include "gazebo/common/Events.hh"
+#include "gazebo/physics/physics.hh"
+#include "plugins/PartitionPlugin.hh"
+
+namespace gazebo
+{
+  /// \brief Private data for the PartitionPlugin class
+  class PartitionPluginPrivate
+  {
+    /// \brief Pointer to the world.
+    public: physics::WorldPtr world;
+
+    /// \brief Connection to the world update end event.
+    public: event::ConnectionPtr updateEndConnection;
+
+    /// \brief Node shared with the other partitions.
+    public: ignition::transport::Node node;
+
+    /// \brief Publisher of the state of this partition, on secondaries.
+    public: ignition::transport::Node::Publisher statePub;
+
+    /// \brief Publisher of the merged state, on the primary.
+    public: ignition::transport::Node::Publisher clockPub;
+
+    /// \brief Region of each partition.
+    public: std::vector<ignition::math::AxisAlignedBox> regions;
+
+    /// \brief Index of this partition.
+    public: int partition = 0;
+
+    /// \brief Distance to another region under which a model is shared.
+    public: double margin = 1.0;
+
+    /// \brief Iterations between two exchanges.
+    public: unsigned int syncPeriod = 1;
+
+    /// \brief Time to wait for the other partitions.
+    public: std::chrono::milliseconds timeout{5000};
+
+    /// \brief True once the other partitions were discovered.
+    public: bool connected = false;
+
+    /// \brief Models simulated by another partition.
+    public: std::set<std::string> ghosts;
+
+    /// \brief Protects states and clocks.
+    public: std::mutex mutex;
+
+    /// \brief Notified when a state or clock arrives.
+    public: std::condition_variable cond;
+
+    /// \brief States of the other partitions by iteration, on the primary.
+    public: std::map<uint64_t, std::vector<msgs::PartitionStep>> states;
+
+    /// \brief Merged states by iteration, on secondaries.
+    public: std::map<uint64_t, msgs::PartitionStep> clocks;
+  };
+}
+
+using namespace gazebo;
+GZ_REGISTER_WORLD_PLUGIN(PartitionPlugin)
+
+/// \brief Switch a model between simulated and ghost.
+/// \param[in] _model Model.
+/// \param[in] _ghost True to stop simulating the model.
+static void SetGhost(const physics::ModelPtr &_model, const bool _ghost)
+{
+  for (auto const &link : _model->GetLinks())
+    link->SetKinematic(_ghost);
+}
+
+/// \brief Write the state of a model.
+/// \param[out] _msg Message to fill.
+/// \param[in] _model Model.
+/// \param[in] _owner Partition that simulates the model.
+static void FillEntity(msgs::PartitionEntity *_msg,
+    const physics::ModelPtr &_model, const int _owner)
+{
+  _msg->set_name(_model->GetScopedName());
+  _msg->set_owner(_owner);
+  for (auto const &link : _model->GetLinks())
+  {
+    msgs::Pose *pose = _msg->add_link_pose();
+    msgs::Set(pose, link->WorldPose());
+    pose->set_name(link->GetName());
+    msgs::Set(_msg->add_linear_velocity(), link->WorldLinearVel());
+    msgs::Set(_msg->add_angular_velocity(), link->WorldAngularVel());
+  }
+}
+
+/// \brief Set the state of a model.
+/// \param[in] _msg State sent by the partition that simulates it.
+/// \param[in] _model Model.
+static void ApplyEntity(const msgs::PartitionEntity &_msg,
+    const physics::ModelPtr &_model)
+{
+  auto links = _model->GetLinks();
+  if (static_cast<int>(links.size()) != _msg.link_pose_size() ||
+      _msg.linear_velocity_size() != _msg.link_pose_size() ||
+      _msg.angular_velocity_size() != _msg.link_pose_size())
+  {
+    gzerr << "Model [" << _msg.name() << "] has different links in the "
+          << "partitions, is the world file the same?\n";
+    return;
+  }
+
+  for (size_t i = 0; i < links.size(); ++i)
+  {
+    links[i]->SetWorldPose(msgs::ConvertIgn(_msg.link_pose(i)));
+    links[i]->SetLinearVel(msgs::ConvertIgn(_msg.linear_velocity(i)));
+    links[i]->SetAngularVel(msgs::ConvertIgn(_msg.angular_velocity(i)));
+  }
+}
+
+/////////////////////////////////////////////////
+PartitionPlugin::PartitionPlugin()
+  : WorldPlugin(), dataPtr(new PartitionPluginPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+PartitionPlugin::~PartitionPlugin()
+{
+  this->dataPtr->updateEndConnection.reset();
+}
+
+/////////////////////////////////////////////////
+void PartitionPlugin::Load(physics::WorldPtr _world, sdf::ElementPtr _sdf)
+{
+  this->dataPtr->world = _world;
+
+  if (_sdf->HasElement("region"))
+  {
+    for (auto elem = _sdf->GetElement("region"); elem;
+         elem = elem->GetNextElement("region"))
+    {
+      this->dataPtr->regions.push_back(ignition::math::AxisAlignedBox(
+          elem->Get<ignition::math::Vector3d>("min"),
+          elem->Get<ignition::math::Vector3d>("max")));
+    }
+  }
+
+  if (_sdf->HasElement("partition"))
+    this->dataPtr->partition = _sdf->Get<int>("partition");
+  const char *partitionEnv = std::getenv("GAZEBO_PARTITION");
+  if (partitionEnv && partitionEnv[0] != '\0')
+    this->dataPtr->partition = std::atoi(partitionEnv);
+
+  if (this->dataPtr->partition < 0 || this->dataPtr->partition >=
+      static_cast<int>(this->dataPtr->regions.size()))
+  {
+    gzerr << "PartitionPlugin: partition [" << this->dataPtr->partition
+          << "] has no <region>, the world won't be partitioned\n";
+    return;
+  }
+
+  if (_sdf->HasElement("margin"))
+    this->dataPtr->margin = _sdf->Get<double>("margin");
+  if (_sdf->HasElement("sync_period"))
+  {
+    this->dataPtr->syncPeriod =
+        std::max(1u, _sdf->Get<unsigned int>("sync_period"));
+  }
+  if (_sdf->HasElement("timeout"))
+  {
+    this->dataPtr->timeout = std::chrono::milliseconds(
+        static_cast<int64_t>(_sdf->Get<double>("timeout") * 1000));
+  }
+
+  std::string group = "default";
+  if (_sdf->HasElement("group"))
+    group = _sdf->Get<std::string>("group");
+  const std::string prefix = "/partition/" + group;
+
+  if (this->dataPtr->partition == 0)
+  {
+    this->dataPtr->node.Subscribe(prefix + "/state",
+        &PartitionPlugin::OnState, this);
+    this->dataPtr->clockPub =
+        this->dataPtr->node.Advertise<msgs::PartitionStep>(prefix + "/clock");
+  }
+  else
+  {
+    this->dataPtr->node.Subscribe(prefix + "/clock",
+        &PartitionPlugin::OnClock, this);
+    this->dataPtr->statePub =
+        this->dataPtr->node.Advertise<msgs::PartitionStep>(prefix + "/state");
+  }
+
+  // Every partition loads the same models, and agrees on who owns them
+  for (auto const &model : _world->Models())
+  {
+    if (model->IsStatic())
+      continue;
+
+    if (Owner(this->dataPtr->regions, model->WorldPose().Pos()) !=
+        this->dataPtr->partition)
+    {
+      SetGhost(model, true);
+      this->dataPtr->ghosts.insert(model->GetScopedName());
+    }
+  }
+
+  this->dataPtr->updateEndConnection = event::Events::ConnectWorldUpdateEnd(
+      std::bind(&PartitionPlugin::OnWorldUpdateEnd, this));
+
+  gzmsg << "Partition [" << this->dataPtr->partition << "] of ["
+        << this->dataPtr->regions.size() << "] in group [" << group
+        << "] simulates [" << _world->ModelCount() -
+           this->dataPtr->ghosts.size() << "] models\n";
+}
+
+/////////////////////////////////////////////////
+int PartitionPlugin::Owner(
+    const std::vector<ignition::math::AxisAlignedBox> &_regions,
+    const ignition::math::Vector3d &_pos)
+{
+  int nearest = -1;
+  double nearestDistance = std::numeric_limits<double>::max();
+  for (size_t i = 0; i < _regions.size(); ++i)
+  {
+    const double distance = Distance(_regions[i], _pos);
+    if (distance < nearestDistance)
+    {
+      nearest = static_cast<int>(i);
+      nearestDistance = distance;
+    }
+  }
+  return nearest;
+}
+
+/////////////////////////////////////////////////
+double PartitionPlugin::Distance(
+    const ignition::math::AxisAlignedBox &_region,
+    const ignition::math::Vector3d &_pos)
+{
+  const ignition::math::Vector3d closest(
+      ignition::math::clamp(_pos.X(), _region.Min().X(), _region.Max().X()),
+      ignition::math::clamp(_pos.Y(), _region.Min().Y(), _region.Max().Y()),
+      ignition::math::clamp(_pos.Z(), _region.Min().Z(), _region.Max().Z()));
+  return closest.Distance(_pos);
+}
+
+/////////////////////////////////////////////////
+void PartitionPlugin::OnState(const msgs::PartitionStep &_msg)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->states[_msg.iteration()].push_back(_msg);
+  this->dataPtr->cond.notify_all();
+}
+
+/////////////////////////////////////////////////
+void PartitionPlugin::OnClock(const msgs::PartitionStep &_msg)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->clocks[_msg.iteration()] = _msg;
+  this->dataPtr->cond.notify_all();
+}
+
+/////////////////////////////////////////////////
+void PartitionPlugin::OnWorldUpdateEnd()
+{
+  const uint64_t iteration = this->dataPtr->world->Iterations();
+  if (iteration % this->dataPtr->syncPeriod != 0)
+    return;
+
+  const int self = this->dataPtr->partition;
+  const bool primary = self == 0;
+  const size_t others = this->dataPtr->regions.size() - 1;
+
+  msgs::PartitionStep step;
+  step.set_partition(self);
+  step.set_iteration(iteration);
+  msgs::Set(step.mutable_sim_time(), this->dataPtr->world->SimTime());
+
+  for (auto const &model : this->dataPtr->world->Models())
+  {
+    if (model->IsStatic() ||
+        this->dataPtr->ghosts.count(model->GetScopedName()))
+    {
+      continue;
+    }
+
+    const ignition::math::Vector3d pos = model->WorldPose().Pos();
+    const int owner = Owner(this->dataPtr->regions, pos);
+    if (owner != self)
+    {
+      // Hand off, the new owner starts from this state
+      FillEntity(step.add_entity(), model, owner);
+      SetGhost(model, true);
+      this->dataPtr->ghosts.insert(model->GetScopedName());
+      gzmsg << "Handing off [" << model->GetScopedName()
+            << "] to partition [" << owner << "]\n";
+      continue;
+    }
+
+    for (size_t i = 0; i < this->dataPtr->regions.size(); ++i)
+    {
+      if (static_cast<int>(i) != self &&
+          Distance(this->dataPtr->regions[i], pos) < this->dataPtr->margin)
+      {
+        FillEntity(step.add_entity(), model, self);
+        break;
+      }
+    }
+  }
+
+  // Messages sent before discovery are lost
+  if (!this->dataPtr->connected && others > 0)
+  {
+    auto &pub = primary ? this->dataPtr->clockPub : this->dataPtr->statePub;
+    auto deadline = std::chrono::steady_clock::now() + this->dataPtr->timeout;
+    while (!pub.HasConnections() && std::chrono::steady_clock::now() < deadline)
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    this->dataPtr->connected = pub.HasConnections();
+  }
+
+  msgs::PartitionStep merged;
+  std::unique_lock<std::mutex> lock(this->dataPtr->mutex);
+  if (primary)
+  {
+    auto &states = this->dataPtr->states;
+    if (!this->dataPtr->cond.wait_for(lock, this->dataPtr->timeout, [&]
+        {
+          return states[iteration].size() >= others;
+        }))
+    {
+      gzwarn << "Partition states of iteration [" << iteration << "]: ["
+             << states[iteration].size() << "] of [" << others
+             << "] arrived in time\n";
+    }
+
+    merged = step;
+    for (auto const &state : states[iteration])
+    {
+      for (auto const &entity : state.entity())
+        *merged.add_entity() = entity;
+    }
+    states.erase(states.begin(), states.upper_bound(iteration));
+    lock.unlock();
+
+    this->dataPtr->clockPub.Publish(merged);
+  }
+  else
+  {
+    lock.unlock();
+    this->dataPtr->statePub.Publish(step);
+    lock.lock();
+
+    auto &clocks = this->dataPtr->clocks;
+    if (!this->dataPtr->cond.wait_for(lock, this->dataPtr->timeout, [&]
+        {
+          return clocks.count(iteration) > 0;
+        }))
+    {
+      gzwarn << "No clock from the primary partition for iteration ["
+             << iteration << "]\n";
+      return;
+    }
+    merged = clocks[iteration];
+    clocks.erase(clocks.begin(), clocks.upper_bound(iteration));
+    lock.unlock();
+
+    const common::Time simTime = msgs::Convert(merged.sim_time());
+    if (simTime != this->dataPtr->world->SimTime())
+      this->dataPtr->world->SetSimTime(simTime);
+  }
+
+  for (auto const &entity : merged.entity())
+  {
+    // The state of our own models comes back from the primary
+    const bool ghost = this->dataPtr->ghosts.count(entity.name()) > 0;
+    if (entity.owner() == self && !ghost)
+      continue;
+
+    physics::ModelPtr model =
+        this->dataPtr->world->ModelByName(entity.name());
+    if (!model)
+      continue;
+
+    if (entity.owner() == self)
+    {
+      SetGhost(model, false);
+      this->dataPtr->ghosts.erase(entity.name());
+      gzmsg << "Taking over [" << entity.name() << "]\n";
+    }
+    else if (!ghost)
+    {
+      SetGhost(model, true);
+      this->dataPtr->ghosts.insert(entity.name());
+    }
+    ApplyEntity(entity, model);
+  }
+}
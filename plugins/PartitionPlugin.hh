@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PLUGINS_PARTITIONPLUGIN_HH_
+#define GAZEBO_PLUGINS_PARTITIONPLUGIN_HH_
+
+#include <memory>
+#include <vector>
+
+#include <ignition/math/AxisAlignedBox.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/common/Plugin.hh"
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  // Forward declare private data class
+  class PartitionPluginPrivate;
+
+  /// \brief A world plugin that splits one world across several gzserver
+  /// processes, one per region of space.
+  ///
+  /// Every process loads the same world file. Each one simulates the
+  /// models whose origin lies in its region and keeps the other models as
+  /// kinematic ghosts. Every sync_period iterations, each partition sends
+  /// the state of its models that are within margin of another region,
+  /// and hands off the models that left its region to the partition they
+  /// entered. The primary, partition 0, waits for the state of all the
+  /// partitions, merges it and sends it back. That message is the clock:
+  /// a partition only goes on once it has the merged state of the current
+  /// iteration, and it takes the primary's simulation time.
+  ///
+  /// The partitions talk over Ignition Transport, which finds its peers on
+  /// the network by itself, so each gzserver keeps its own master. Run the
+  /// processes with the same IGN_PARTITION to keep several distributed
+  /// worlds apart, and give each one its index with the GAZEBO_PARTITION
+  /// environment variable, which overrides <partition>.
+  ///
+  /// Static models are simulated by every partition. Models must be in
+  /// the world file of every partition, models inserted at runtime aren't
+  /// shared.
+  ///
+  /// <plugin name="partition" filename="libPartitionPlugin.so">
+  ///   <!-- Topic namespace of this distributed world -->
+  ///   <group>city</group>
+  ///   <!-- Index of this process in the list of regions -->
+  ///   <partition>0</partition>
+  ///   <!-- One region per partition, models outside of all the regions
+  ///        belong to the nearest one -->
+  ///   <region><min>-500 -500 -10</min><max>0 500 100</max></region>
+  ///   <region><min>0 -500 -10</min><max>500 500 100</max></region>
+  ///   <!-- Distance to another region under which a model is shared -->
+  ///   <margin>2</margin>
+  ///   <!-- Iterations between two exchanges -->
+  ///   <sync_period>1</sync_period>
+  ///   <!-- Seconds to wait for the other partitions before going on -->
+  ///   <timeout>5</timeout>
+  /// </plugin>
+  class GZ_PLUGIN_VISIBLE PartitionPlugin : public WorldPlugin
+  {
+    /// \brief Constructor.
+    public: PartitionPlugin();
+
+    /// \brief Destructor.
+    public: virtual ~PartitionPlugin();
+
+    // Documentation inherited
+    public: virtual void Load(physics::WorldPtr _world,
+                              sdf::ElementPtr _sdf);
+
+    /// \brief Get the partition a position belongs to.
+    /// \param[in] _regions Region of each partition.
+    /// \param[in] _pos Position in the world frame.
+    /// \return Index of the first region that contains the position, or of
+    /// the nearest region if none does. -1 if there are no regions.
+    public: static int Owner(
+                const std::vector<ignition::math::AxisAlignedBox> &_regions,
+                const ignition::math::Vector3d &_pos);
+
+    /// \brief Get the distance from a position to a region.
+    /// \param[in] _region Region.
+    /// \param[in] _pos Position in the world frame.
+    /// \return Distance, 0 inside the region.
+    public: static double Distance(
+                const ignition::math::AxisAlignedBox &_region,
+                const ignition::math::Vector3d &_pos);
+
+    /// \brief Exchange the boundary state with the other partitions.
+    private: void OnWorldUpdateEnd();
+
+    /// \brief Callback for the state of the other partitions, on the
+    /// primary.
+    /// \param[in] _msg State of a partition.
+    private: void OnState(const msgs::PartitionStep &_msg);
+
+    /// \brief Callback for the merged state sent by the primary.
+    /// \param[in] _msg Merged state.
+    private: void OnClock(const msgs::PartitionStep &_msg);
+
+    /// \internal
+    /// \brief Pointer to private data.
+    private: std::unique_ptr<PartitionPluginPrivate> dataPtr;
+  };
+}
+#endif
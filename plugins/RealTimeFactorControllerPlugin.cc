@@ -0,0 +1,372 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <string>
+
+#include "gazebo/common/Events.hh"
+#include "gazebo/msgs/real_time_factor_control.pb.h"
+#include "gazebo/physics/PhysicsEngine.hh"
+#include "gazebo/physics/World.hh"
+#include "gazebo/sensors/Sensor.hh"
+#include "gazebo/sensors/SensorManager.hh"
+#include "gazebo/transport/transport.hh"
+#include "gazebo/util/IntrospectionManager.hh"
+#include "plugins/RealTimeFactorControllerPlugin.hh"
+
+namespace gazebo
+{
+  /// \brief Private data for the RealTimeFactorControllerPlugin class
+  class RealTimeFactorControllerPluginPrivate
+  {
+    /// \brief The world.
+    public: physics::WorldPtr world;
+
+    /// \brief Node for communication.
+    public: transport::NodePtr node;
+
+    /// \brief Publisher of the controller's decisions.
+    public: transport::PublisherPtr pub;
+
+    /// \brief Connection to the world update begin event.
+    public: event::ConnectionPtr updateBeginConnection;
+
+    /// \brief Connection to the world update end event.
+    public: event::ConnectionPtr updateEndConnection;
+
+    /// \brief Real-time factor to hold.
+    public: double target = 1.0;
+
+    /// \brief Relative deviation from the target that is tolerated.
+    public: double tolerance = 0.05;
+
+    /// \brief Wall time between decisions.
+    public: common::Time window = common::Time(1.0);
+
+    /// \brief Smallest step size, also the one the controller returns to.
+    public: double minStepSize = 0;
+
+    /// \brief Largest step size.
+    public: double maxStepSize = 0;
+
+    /// \brief True if the physics update rate is throttled, in which case
+    /// it follows the step size.
+    public: bool throttled = false;
+
+    /// \brief True to lower the sensors' update rates under load.
+    public: bool shedSensors = true;
+
+    /// \brief Lowest scale of the sensors' original update rates.
+    public: double minSensorRateScale = 0.25;
+
+    /// \brief Current scale of the sensors' original update rates.
+    public: double sensorRateScale = 1.0;
+
+    /// \brief Original update rate of the sensors that were scaled, by
+    /// scoped name.
+    public: std::map<std::string, double> sensorRates;
+
+    /// \brief True to publish introspection items less often under load.
+    public: bool shedIntrospection = true;
+
+    /// \brief Longest introspection update period.
+    public: unsigned int maxIntrospectionPeriod = 10;
+
+    /// \brief Simulation time at the start of the window.
+    public: common::Time windowSimTime;
+
+    /// \brief World real time at the start of the window.
+    public: common::Time windowRealTime;
+
+    /// \brief True once the window start times are set.
+    public: bool windowStarted = false;
+
+    /// \brief Wall time spent updating the world in the window.
+    public: std::chrono::steady_clock::duration busy =
+        std::chrono::steady_clock::duration::zero();
+
+    /// \brief Wall time at the start of the current world update.
+    public: std::chrono::steady_clock::time_point updateStart;
+  };
+}
+
+using namespace gazebo;
+GZ_REGISTER_WORLD_PLUGIN(RealTimeFactorControllerPlugin)
+
+/// \brief Below this fraction of busy wall time the world has room to
+/// undo earlier decisions.
+static const double kHeadroomBusy = 0.7;
+
+/// \brief Factor by which the step size shrinks back per window.
+static const double kStepShrink = 1.25;
+
+/////////////////////////////////////////////////
+RealTimeFactorControllerPlugin::RealTimeFactorControllerPlugin()
+  : WorldPlugin(), dataPtr(new RealTimeFactorControllerPluginPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+RealTimeFactorControllerPlugin::~RealTimeFactorControllerPlugin()
+{
+  this->dataPtr->updateBeginConnection.reset();
+  this->dataPtr->updateEndConnection.reset();
+  this->dataPtr->pub.reset();
+  if (this->dataPtr->node)
+    this->dataPtr->node->Fini();
+}
+
+/////////////////////////////////////////////////
+void RealTimeFactorControllerPlugin::Load(physics::WorldPtr _world,
+    sdf::ElementPtr _sdf)
+{
+  this->dataPtr->world = _world;
+  auto physics = _world->Physics();
+
+  this->dataPtr->target = physics->GetTargetRealTimeFactor();
+  if (_sdf->HasElement("target"))
+    this->dataPtr->target = _sdf->Get<double>("target");
+  if (_sdf->HasElement("tolerance"))
+    this->dataPtr->tolerance = _sdf->Get<double>("tolerance");
+  if (_sdf->HasElement("window"))
+    this->dataPtr->window = common::Time(_sdf->Get<double>("window"));
+
+  this->dataPtr->minStepSize = physics->GetMaxStepSize();
+  if (_sdf->HasElement("min_step_size"))
+    this->dataPtr->minStepSize = _sdf->Get<double>("min_step_size");
+  this->dataPtr->maxStepSize = 4 * this->dataPtr->minStepSize;
+  if (_sdf->HasElement("max_step_size"))
+    this->dataPtr->maxStepSize = _sdf->Get<double>("max_step_size");
+
+  if (_sdf->HasElement("shed_sensors"))
+    this->dataPtr->shedSensors = _sdf->Get<bool>("shed_sensors");
+  if (_sdf->HasElement("min_sensor_rate_scale"))
+  {
+    this->dataPtr->minSensorRateScale =
+        _sdf->Get<double>("min_sensor_rate_scale");
+  }
+  if (_sdf->HasElement("shed_introspection"))
+    this->dataPtr->shedIntrospection = _sdf->Get<bool>("shed_introspection");
+  if (_sdf->HasElement("max_introspection_period"))
+  {
+    this->dataPtr->maxIntrospectionPeriod =
+        _sdf->Get<unsigned int>("max_introspection_period");
+  }
+
+  if (this->dataPtr->target <= 0 || this->dataPtr->minStepSize <= 0 ||
+      this->dataPtr->maxStepSize < this->dataPtr->minStepSize ||
+      this->dataPtr->minSensorRateScale <= 0 ||
+      this->dataPtr->minSensorRateScale > 1)
+  {
+    gzerr << "RealTimeFactorControllerPlugin needs a positive <target>, "
+          << "0 < <min_step_size> <= <max_step_size> and "
+          << "0 < <min_sensor_rate_scale> <= 1\n";
+    return;
+  }
+
+  this->dataPtr->throttled = physics->GetRealTimeUpdateRate() > 0;
+  this->ApplyStepSize(this->dataPtr->minStepSize);
+
+  this->dataPtr->node = transport::NodePtr(new transport::Node());
+  this->dataPtr->node->Init(_world->Name());
+  this->dataPtr->pub = this->dataPtr->node->Advertise<
+      msgs::RealTimeFactorControl>("~/real_time_factor_control");
+
+  this->dataPtr->updateBeginConnection =
+      event::Events::ConnectWorldUpdateBegin(std::bind(
+      &RealTimeFactorControllerPlugin::OnWorldUpdateBegin, this,
+      std::placeholders::_1));
+  this->dataPtr->updateEndConnection = event::Events::ConnectWorldUpdateEnd(
+      std::bind(&RealTimeFactorControllerPlugin::OnWorldUpdateEnd, this));
+
+  gzmsg << "Holding the real-time factor at " << this->dataPtr->target
+        << " with step sizes in [" << this->dataPtr->minStepSize << ", "
+        << this->dataPtr->maxStepSize << "]\n";
+}
+
+/////////////////////////////////////////////////
+void RealTimeFactorControllerPlugin::OnWorldUpdateBegin(
+    const common::UpdateInfo &_info)
+{
+  if (!this->dataPtr->windowStarted)
+  {
+    this->dataPtr->windowSimTime = _info.simTime;
+    this->dataPtr->windowRealTime = _info.realTime;
+    this->dataPtr->busy = std::chrono::steady_clock::duration::zero();
+    this->dataPtr->windowStarted = true;
+  }
+  else if (_info.realTime - this->dataPtr->windowRealTime >=
+      this->dataPtr->window)
+  {
+    this->Decide(_info);
+
+    // Measure the effect of the decision over a fresh window
+    this->dataPtr->windowSimTime = _info.simTime;
+    this->dataPtr->windowRealTime = _info.realTime;
+    this->dataPtr->busy = std::chrono::steady_clock::duration::zero();
+  }
+
+  this->dataPtr->updateStart = std::chrono::steady_clock::now();
+}
+
+/////////////////////////////////////////////////
+void RealTimeFactorControllerPlugin::OnWorldUpdateEnd()
+{
+  this->dataPtr->busy +=
+      std::chrono::steady_clock::now() - this->dataPtr->updateStart;
+}
+
+/////////////////////////////////////////////////
+void RealTimeFactorControllerPlugin::Decide(const common::UpdateInfo &_info)
+{
+  // The world's real time excludes pauses, like its own real-time factor
+  const double realElapsed =
+      (_info.realTime - this->dataPtr->windowRealTime).Double();
+  const double simElapsed =
+      (_info.simTime - this->dataPtr->windowSimTime).Double();
+  if (realElapsed <= 0)
+    return;
+
+  const double rtf = simElapsed / realElapsed;
+  const double busy =
+      std::chrono::duration<double>(this->dataPtr->busy).count() /
+      realElapsed;
+
+  auto physics = this->dataPtr->world->Physics();
+  auto introspection = util::IntrospectionManager::Instance();
+  const double stepSize = physics->GetMaxStepSize();
+  const unsigned int period = introspection->UpdatePeriod();
+  const double target = this->dataPtr->target;
+
+  msgs::RealTimeFactorControl::Action action =
+      msgs::RealTimeFactorControl::NONE;
+  if (rtf < target * (1 - this->dataPtr->tolerance))
+  {
+    // Overloaded: the largest lever first, since it is the only one that
+    // speeds up physics itself
+    if (stepSize < this->dataPtr->maxStepSize)
+    {
+      this->ApplyStepSize(std::min(this->dataPtr->maxStepSize,
+          stepSize * target / std::max(rtf, 1e-3)));
+      action = msgs::RealTimeFactorControl::INCREASE_STEP_SIZE;
+    }
+    else if (this->dataPtr->shedSensors &&
+        this->dataPtr->sensorRateScale > this->dataPtr->minSensorRateScale)
+    {
+      this->ApplySensorRateScale(std::max(this->dataPtr->minSensorRateScale,
+          this->dataPtr->sensorRateScale / 2));
+      action = msgs::RealTimeFactorControl::SHED_SENSORS;
+    }
+    else if (this->dataPtr->shedIntrospection &&
+        period < this->dataPtr->maxIntrospectionPeriod)
+    {
+      introspection->SetUpdatePeriod(
+          std::min(this->dataPtr->maxIntrospectionPeriod, period * 2));
+      action = msgs::RealTimeFactorControl::SHED_INTROSPECTION;
+    }
+    else
+    {
+      action = msgs::RealTimeFactorControl::SATURATED;
+    }
+  }
+  else if (busy < kHeadroomBusy ||
+      rtf > target * (1 + this->dataPtr->tolerance))
+  {
+    // Headroom: undo in reverse order, the step size last since it
+    // matters most for accuracy
+    if (period > 1)
+    {
+      introspection->SetUpdatePeriod(period / 2);
+      action = msgs::RealTimeFactorControl::RESTORE_INTROSPECTION;
+    }
+    else if (this->dataPtr->sensorRateScale < 1)
+    {
+      this->ApplySensorRateScale(
+          std::min(1.0, this->dataPtr->sensorRateScale * 2));
+      action = msgs::RealTimeFactorControl::RESTORE_SENSORS;
+    }
+    else if (stepSize > this->dataPtr->minStepSize)
+    {
+      this->ApplyStepSize(std::max(this->dataPtr->minStepSize,
+          stepSize / kStepShrink));
+      action = msgs::RealTimeFactorControl::DECREASE_STEP_SIZE;
+    }
+  }
+
+  if (action != msgs::RealTimeFactorControl::NONE &&
+      action != msgs::RealTimeFactorControl::SATURATED)
+  {
+    gzmsg << "Real-time factor " << rtf << " (busy " << busy * 100
+          << "%): " << msgs::RealTimeFactorControl::Action_Name(action)
+          << "\n";
+  }
+
+  msgs::RealTimeFactorControl msg;
+  msgs::Set(msg.mutable_sim_time(), _info.simTime);
+  msg.set_target(target);
+  msg.set_real_time_factor(rtf);
+  msg.set_busy(busy);
+  msg.set_max_step_size(physics->GetMaxStepSize());
+  msg.set_real_time_update_rate(physics->GetRealTimeUpdateRate());
+  msg.set_sensor_rate_scale(this->dataPtr->sensorRateScale);
+  msg.set_introspection_period(introspection->UpdatePeriod());
+  msg.set_action(action);
+  this->dataPtr->pub->Publish(msg);
+}
+
+/////////////////////////////////////////////////
+void RealTimeFactorControllerPlugin::ApplyStepSize(const double _stepSize)
+{
+  auto physics = this->dataPtr->world->Physics();
+  physics->SetMaxStepSize(_stepSize);
+
+  // A throttled world sleeps to hold rate * step size at the target, the
+  // rate has to follow the step size or a larger step only adds sleep
+  if (this->dataPtr->throttled)
+    physics->SetRealTimeUpdateRate(this->dataPtr->target / _stepSize);
+}
+
+/////////////////////////////////////////////////
+void RealTimeFactorControllerPlugin::ApplySensorRateScale(const double _scale)
+{
+  this->dataPtr->sensorRateScale = _scale;
+
+  const std::string worldName = this->dataPtr->world->Name();
+  for (auto const &sensor : sensors::SensorManager::Instance()->GetSensors())
+  {
+    if (sensor->WorldName() != worldName)
+      continue;
+
+    // Remember the original rate the first time a sensor is scaled,
+    // sensors created later join in at the current scale
+    auto iter = this->dataPtr->sensorRates.find(sensor->ScopedName());
+    if (iter == this->dataPtr->sensorRates.end())
+    {
+      // Unthrottled sensors have no rate to scale
+      if (sensor->UpdateRate() <= 0)
+        continue;
+      iter = this->dataPtr->sensorRates.emplace(sensor->ScopedName(),
+          sensor->UpdateRate()).first;
+    }
+    sensor->SetUpdateRate(iter->second * _scale);
+  }
+
+  if (_scale >= 1)
+    this->dataPtr->sensorRates.clear();
+}
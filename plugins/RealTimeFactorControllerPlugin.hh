@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PLUGINS_REALTIMEFACTORCONTROLLERPLUGIN_HH_
+#define GAZEBO_PLUGINS_REALTIMEFACTORCONTROLLERPLUGIN_HH_
+
+#include <memory>
+
+#include "gazebo/common/Plugin.hh"
+#include "gazebo/common/UpdateInfo.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  // Forward declare private data class
+  class RealTimeFactorControllerPluginPrivate;
+
+  /// \brief A world plugin that holds the real-time factor at a target
+  /// when the world can't keep up. Once per window it measures the
+  /// real-time factor and the fraction of wall time spent updating the
+  /// world, and when the factor is too low it takes the first of these
+  /// steps that is still possible:
+  ///
+  ///   1. increase the physics step size, up to <max_step_size>,
+  ///   2. halve the sensors' update rates, down to <min_sensor_rate_scale>
+  ///      of their original rates,
+  ///   3. publish introspection items half as often, down to once every
+  ///      <max_introspection_period> world updates.
+  ///
+  /// When there is headroom again the steps are undone in reverse order,
+  /// and the step size shrinks back to <min_step_size>. Changing the step
+  /// size changes the accuracy of the simulation, leave <max_step_size>
+  /// equal to <min_step_size> to only shed the optional work.
+  ///
+  /// Every decision is published as a msgs::RealTimeFactorControl on
+  /// "~/real_time_factor_control".
+  ///
+  /// <plugin name="rtf_controller"
+  ///         filename="libRealTimeFactorControllerPlugin.so">
+  ///   <!-- Defaults to the physics <real_time_factor> -->
+  ///   <target>1.0</target>
+  ///   <tolerance>0.05</tolerance>
+  ///   <!-- Wall time between decisions, in seconds -->
+  ///   <window>1.0</window>
+  ///   <!-- Default to the physics step size and four times that -->
+  ///   <min_step_size>0.001</min_step_size>
+  ///   <max_step_size>0.004</max_step_size>
+  ///   <shed_sensors>true</shed_sensors>
+  ///   <min_sensor_rate_scale>0.25</min_sensor_rate_scale>
+  ///   <shed_introspection>true</shed_introspection>
+  ///   <max_introspection_period>10</max_introspection_period>
+  /// </plugin>
+  class GZ_PLUGIN_VISIBLE RealTimeFactorControllerPlugin : public WorldPlugin
+  {
+    /// \brief Constructor.
+    public: RealTimeFactorControllerPlugin();
+
+    /// \brief Destructor.
+    public: virtual ~RealTimeFactorControllerPlugin();
+
+    // Documentation inherited
+    public: virtual void Load(physics::WorldPtr _world,
+                              sdf::ElementPtr _sdf);
+
+    /// \brief Callback at the start of a world update.
+    /// \param[in] _info Update information.
+    private: void OnWorldUpdateBegin(const common::UpdateInfo &_info);
+
+    /// \brief Callback at the end of a world update.
+    private: void OnWorldUpdateEnd();
+
+    /// \brief Evaluate the window that just ended and act on it.
+    /// \param[in] _info Update information at the end of the window.
+    private: void Decide(const common::UpdateInfo &_info);
+
+    /// \brief Apply a physics step size, keeping the real-time factor
+    /// implied by the update rate at the target.
+    /// \param[in] _stepSize New step size in seconds.
+    private: void ApplyStepSize(const double _stepSize);
+
+    /// \brief Apply a scale to the update rates of all sensors.
+    /// \param[in] _scale Scale of the original rates, in (0, 1].
+    private: void ApplySensorRateScale(const double _scale);
+
+    /// \internal
+    /// \brief Pointer to private data.
+    private: std::unique_ptr<RealTimeFactorControllerPluginPrivate> dataPtr;
+  };
+}
+#endif
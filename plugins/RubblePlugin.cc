@@ -169,6 +169,10 @@ void RubblePlugin::Load(physics::WorldPtr _world, sdf::ElementPtr _sdf)
     }*/
   }
 
+  // Insert all the rubble in one batch
+  this->world->InsertModels(this->models);
+  this->models.clear();
+
   // Disable compound objects for now.
   /*
   int i =0;
@@ -186,98 +190,106 @@ void RubblePlugin::Init()
 }
 
 /////////////////////////////////////////////////
-void RubblePlugin::MakeCinderBlock(const std::string &_name,
-                                   ignition::math::Pose3d &_pose,
-                                   ignition::math::Vector3d &_size,
-                                   const double _mass)
+/// \brief Parse the model used for a kind of rubble. The name, pose, mass,
+/// inertia and size are set on each clone.
+/// \param[in] _autoDisable True to allow the model to be auto disabled.
+/// \return The <model> element.
+static sdf::ElementPtr RubbleTemplate(const bool _autoDisable)
 {
   std::ostringstream newModelStr;
-
-  float sx = _size.X();
-  float sy = _size.Y();
-  float sz = _size.Z();
-
   newModelStr << "<sdf version='" << SDF_VERSION << "'>"
-    "<model name='" << _name << "'>"
-    "<pose>" << _pose << "</pose>"
+    "<model name='rubble'>";
+  if (_autoDisable)
+    newModelStr << "<allow_auto_disable>true</allow_auto_disable>";
+  newModelStr <<
+    "<pose>0 0 0 0 0 0</pose>"
     "<link name='link'>"
       "<velocity_decay>"
         "<linear>0.01</linear>"
         "<angular>0.01</angular>"
       "</velocity_decay>"
-      "<inertial><mass>" << _mass << "</mass>"
+      "<inertial><mass>1</mass>"
         "<inertia>"
-        "<ixx>" << (1.0/12.0) * _mass * (sy*sy + sz*sz) << "</ixx>"
-        "<iyy>" << (1.0/12.0) * _mass * (sz*sz + sx*sx) << "</iyy>"
-        "<izz>" << (1.0/12.0) * _mass * (sx*sx + sy*sy) << "</izz>"
-        "<ixy>" << 0.0 << "</ixy>"
-        "<ixz>" << 0.0 << "</ixz>"
-        "<iyz>" << 0.0 << "</iyz>"
+        "<ixx>1</ixx>"
+        "<iyy>1</iyy>"
+        "<izz>1</izz>"
+        "<ixy>0</ixy>"
+        "<ixz>0</ixz>"
+        "<iyz>0</iyz>"
         "</inertia>"
       "</inertial>"
       "<collision name='collision'>"
         "<geometry>"
-          "<box><size>" << _size << "</size></box>"
+          "<box><size>1 1 1</size></box>"
         "</geometry>"
       "</collision>"
       "<visual name='visual'>"
         "<geometry>"
-          "<box><size>" << _size << "</size></box>"
+          "<box><size>1 1 1</size></box>"
         "</geometry>"
       "</visual>"
     "</link>"
   "</model>"
   "</sdf>";
 
-  this->world->InsertModelString(newModelStr.str());
+  sdf::SDF sdf;
+  sdf.SetFromString(newModelStr.str());
+  return sdf.Root()->GetElement("model");
 }
 
 /////////////////////////////////////////////////
-void RubblePlugin::MakeBox(const std::string &_name,
-                           ignition::math::Pose3d &_pose,
-                           ignition::math::Vector3d &_size,
-                           const double _mass)
+void RubblePlugin::MakeRubble(const sdf::ElementPtr &_template,
+                              const std::string &_name,
+                              const ignition::math::Pose3d &_pose,
+                              const ignition::math::Vector3d &_size,
+                              const double _mass)
 {
-  std::ostringstream newModelStr;
-
   float sx = _size.X();
   float sy = _size.Y();
   float sz = _size.Z();
 
-  newModelStr << "<sdf version='" << SDF_VERSION << "'>"
-    "<model name='" << _name << "'>"
-    "<allow_auto_disable>true</allow_auto_disable>"
-    "<pose>" << _pose << "</pose>"
-    "<link name='link'>"
-      "<velocity_decay>"
-        "<linear>0.01</linear>"
-        "<angular>0.01</angular>"
-      "</velocity_decay>"
-      "<inertial><mass>" << _mass << "</mass>"
-        "<inertia>"
-        "<ixx>" << (1.0/12.0) * _mass * (sy*sy + sz*sz) << "</ixx>"
-        "<iyy>" << (1.0/12.0) * _mass * (sz*sz + sx*sx) << "</iyy>"
-        "<izz>" << (1.0/12.0) * _mass * (sx*sx + sy*sy) << "</izz>"
-        "<ixy>" << 0.0 << "</ixy>"
-        "<ixz>" << 0.0 << "</ixz>"
-        "<iyz>" << 0.0 << "</iyz>"
-        "</inertia>"
-      "</inertial>"
-      "<collision name='collision'>"
-        "<geometry>"
-          "<box><size>" << _size << "</size></box>"
-        "</geometry>"
-      "</collision>"
-      "<visual name='visual'>"
-        "<geometry>"
-          "<box><size>" << _size << "</size></box>"
-        "</geometry>"
-      "</visual>"
-    "</link>"
-  "</model>"
-  "</sdf>";
+  sdf::ElementPtr model = _template->Clone();
+  model->GetAttribute("name")->Set(_name);
+  model->GetElement("pose")->Set(_pose);
 
-  this->world->InsertModelString(newModelStr.str());
+  sdf::ElementPtr link = model->GetElement("link");
+  sdf::ElementPtr inertial = link->GetElement("inertial");
+  inertial->GetElement("mass")->Set(_mass);
+  sdf::ElementPtr inertia = inertial->GetElement("inertia");
+  inertia->GetElement("ixx")->Set((1.0/12.0) * _mass * (sy*sy + sz*sz));
+  inertia->GetElement("iyy")->Set((1.0/12.0) * _mass * (sz*sz + sx*sx));
+  inertia->GetElement("izz")->Set((1.0/12.0) * _mass * (sx*sx + sy*sy));
+
+  link->GetElement("collision")->GetElement("geometry")->GetElement("box")
+      ->GetElement("size")->Set(_size);
+  link->GetElement("visual")->GetElement("geometry")->GetElement("box")
+      ->GetElement("size")->Set(_size);
+
+  this->models.push_back(model);
+}
+
+/////////////////////////////////////////////////
+void RubblePlugin::MakeCinderBlock(const std::string &_name,
+                                   ignition::math::Pose3d &_pose,
+                                   ignition::math::Vector3d &_size,
+                                   const double _mass)
+{
+  if (!this->cinderBlockTemplate)
+    this->cinderBlockTemplate = RubbleTemplate(false);
+
+  this->MakeRubble(this->cinderBlockTemplate, _name, _pose, _size, _mass);
+}
+
+/////////////////////////////////////////////////
+void RubblePlugin::MakeBox(const std::string &_name,
+                           ignition::math::Pose3d &_pose,
+                           ignition::math::Vector3d &_size,
+                           const double _mass)
+{
+  if (!this->boxTemplate)
+    this->boxTemplate = RubbleTemplate(true);
+
+  this->MakeRubble(this->boxTemplate, _name, _pose, _size, _mass);
 }
 
 /////////////////////////////////////////////////
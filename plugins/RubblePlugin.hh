@@ -51,6 +51,18 @@ namespace gazebo
                                   ignition::math::Vector3d &_size,
                                   const double _mass);
 
+    /// \brief Clone a box model template and queue it for insertion.
+    /// \param[in] _template Model to clone.
+    /// \param[in] _name Name of the model.
+    /// \param[in] _pose Pose of the model.
+    /// \param[in] _size Size of the box.
+    /// \param[in] _mass Mass of the box.
+    private: void MakeRubble(const sdf::ElementPtr &_template,
+                             const std::string &_name,
+                             const ignition::math::Pose3d &_pose,
+                             const ignition::math::Vector3d &_size,
+                             const double _mass);
+
     // private: void MakeCylinder(const std::string &_name,
     //    ignition::math::Vector3d &_pos,
     //    ignition::math::Vector3d &_size, double _mass);
@@ -74,6 +86,15 @@ namespace gazebo
 
     // private: void MakeCompound(const std::string &_name, CompoundObj &_obj);
     private: physics::WorldPtr world;
+
+    /// \brief Template of the boxes, parsed once.
+    private: sdf::ElementPtr boxTemplate;
+
+    /// \brief Template of the cinder blocks, parsed once.
+    private: sdf::ElementPtr cinderBlockTemplate;
+
+    /// \brief Models made by Load, inserted together.
+    private: std::vector<sdf::ElementPtr> models;
   };
 }
 #endif
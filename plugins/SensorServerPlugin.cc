@@ -0,0 +1,334 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include <ignition/math/Pose3.hh>
+
+#include "gazebo/common/Events.hh"
+#include "gazebo/physics/physics.hh"
+#include "gazebo/rendering/RenderingIface.hh"
+#include "gazebo/sensors/sensors.hh"
+#include "gazebo/transport/transport.hh"
+#include "plugins/SensorServerPlugin.hh"
+
+namespace gazebo
+{
+  /// \brief Private data for the SensorServerPlugin class
+  class SensorServerPluginPrivate
+  {
+    /// \brief Pointer to the world.
+    public: physics::WorldPtr world;
+
+    /// \brief Connection to the world update event of the role.
+    public: event::ConnectionPtr updateConnection;
+
+    /// \brief Node for communication.
+    public: transport::NodePtr node;
+
+    /// \brief Publisher of pose frames, on the physics server.
+    public: transport::PublisherPtr posesPub;
+
+    /// \brief Subscriber to acknowledgements, on the physics server.
+    public: transport::SubscriberPtr ackSub;
+
+    /// \brief Subscriber to pose frames, on the sensor server.
+    public: transport::SubscriberPtr posesSub;
+
+    /// \brief Publisher of acknowledgements, on the sensor server.
+    public: transport::PublisherPtr ackPub;
+
+    /// \brief Simulation time between two frames.
+    public: common::Time period;
+
+    /// \brief True to wait for the sensor server.
+    public: bool lockstep = true;
+
+    /// \brief Time to wait for an acknowledgement.
+    public: std::chrono::milliseconds timeout{5000};
+
+    /// \brief Simulation time of the next frame, on the physics server.
+    public: common::Time nextFrameTime;
+
+    /// \brief Time of the last frame sent, on the physics server.
+    public: common::Time sentTime;
+
+    /// \brief True once a frame was sent.
+    public: bool sent = false;
+
+    /// \brief True if the sensor server was connected at the last frame.
+    public: bool connected = false;
+
+    /// \brief Last pose sent for each link, on the physics server.
+    public: std::map<std::string, ignition::math::Pose3d> sentPoses;
+
+    /// \brief Links by scoped name, on the sensor server.
+    public: std::map<std::string, physics::LinkPtr> links;
+
+    /// \brief Time of the frame to acknowledge, on the sensor server.
+    public: common::Time renderedTime;
+
+    /// \brief True if renderedTime must be acknowledged.
+    public: bool pendingAck = false;
+
+    /// \brief Protects ackTime and frames.
+    public: std::mutex mutex;
+
+    /// \brief Notified when an acknowledgement or a frame arrives.
+    public: std::condition_variable cond;
+
+    /// \brief Last acknowledged time, on the physics server.
+    public: common::Time ackTime;
+
+    /// \brief Frames not applied yet, on the sensor server.
+    public: std::deque<ConstPosesStampedPtr> frames;
+  };
+}
+
+using namespace gazebo;
+GZ_REGISTER_WORLD_PLUGIN(SensorServerPlugin)
+
+/// \brief Get the links of a model and of its nested models.
+/// \param[in] _model Model.
+/// \param[out] _links Links to append to.
+static void CollectLinks(const physics::ModelPtr &_model,
+    physics::Link_V &_links)
+{
+  for (auto const &link : _model->GetLinks())
+    _links.push_back(link);
+  for (auto const &nested : _model->NestedModels())
+    CollectLinks(nested, _links);
+}
+
+/////////////////////////////////////////////////
+SensorServerPlugin::SensorServerPlugin()
+  : WorldPlugin(), dataPtr(new SensorServerPluginPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+SensorServerPlugin::~SensorServerPlugin()
+{
+  this->dataPtr->updateConnection.reset();
+  this->dataPtr->posesSub.reset();
+  this->dataPtr->ackSub.reset();
+  if (this->dataPtr->node)
+    this->dataPtr->node->Fini();
+}
+
+/////////////////////////////////////////////////
+void SensorServerPlugin::Load(physics::WorldPtr _world, sdf::ElementPtr _sdf)
+{
+  this->dataPtr->world = _world;
+
+  std::string role = "physics";
+  if (_sdf->HasElement("role"))
+    role = _sdf->Get<std::string>("role");
+  const char *roleEnv = std::getenv("GAZEBO_SENSOR_SERVER_ROLE");
+  if (roleEnv && roleEnv[0] != '\0')
+    role = roleEnv;
+
+  double rate = 30;
+  if (_sdf->HasElement("update_rate"))
+    rate = _sdf->Get<double>("update_rate");
+  this->dataPtr->period = rate > 0 ? 1.0 / rate : 0.0;
+  if (_sdf->HasElement("lockstep"))
+    this->dataPtr->lockstep = _sdf->Get<bool>("lockstep");
+  if (_sdf->HasElement("timeout"))
+  {
+    this->dataPtr->timeout = std::chrono::milliseconds(
+        static_cast<int64_t>(_sdf->Get<double>("timeout") * 1000));
+  }
+
+  this->dataPtr->node = transport::NodePtr(new transport::Node());
+  this->dataPtr->node->Init(_world->Name());
+
+  if (role == "physics")
+  {
+    if (sensors::rendering_enabled())
+    {
+      gzwarn << "The physics server of a sensor server renders its own "
+             << "sensors too, start it with --physics_only\n";
+    }
+
+    this->dataPtr->posesPub =
+        this->dataPtr->node->Advertise<msgs::PosesStamped>(
+        "~/sensor_server/poses");
+    this->dataPtr->ackSub = this->dataPtr->node->Subscribe(
+        "~/sensor_server/ack", &SensorServerPlugin::OnAck, this);
+    this->dataPtr->updateConnection = event::Events::ConnectWorldUpdateEnd(
+        std::bind(&SensorServerPlugin::OnPhysicsUpdateEnd, this));
+  }
+  else if (role == "sensors")
+  {
+    if (!rendering::lockstep_enabled())
+    {
+      gzwarn << "Without --lockstep, the sensor server acknowledges frames "
+             << "before they are rendered\n";
+    }
+
+    // The world only follows the physics server
+    _world->SetPhysicsEnabled(false);
+    _world->Physics()->SetRealTimeUpdateRate(0);
+
+    // The physics server runs the sensors that don't render
+    for (auto const &sensor : sensors::SensorManager::Instance()->GetSensors())
+    {
+      if (sensor->Category() != sensors::IMAGE)
+        sensors::remove_sensor(sensor->ScopedName());
+    }
+
+    for (auto const &model : _world->Models())
+    {
+      physics::Link_V links;
+      CollectLinks(model, links);
+      for (auto const &link : links)
+        this->dataPtr->links[link->GetScopedName()] = link;
+    }
+
+    this->dataPtr->posesSub = this->dataPtr->node->Subscribe(
+        "~/sensor_server/poses", &SensorServerPlugin::OnPoses, this);
+    this->dataPtr->ackPub =
+        this->dataPtr->node->Advertise<msgs::Time>("~/sensor_server/ack");
+    this->dataPtr->updateConnection = event::Events::ConnectWorldUpdateBegin(
+        std::bind(&SensorServerPlugin::OnSensorsUpdateBegin, this));
+  }
+  else
+  {
+    gzerr << "SensorServerPlugin role must be physics or sensors, not ["
+          << role << "]\n";
+  }
+}
+
+/////////////////////////////////////////////////
+void SensorServerPlugin::OnPhysicsUpdateEnd()
+{
+  const common::Time simTime = this->dataPtr->world->SimTime();
+  if (simTime < this->dataPtr->nextFrameTime)
+    return;
+  this->dataPtr->nextFrameTime = simTime + this->dataPtr->period;
+
+  // A sensor server that just connected needs all the poses
+  const bool connected = this->dataPtr->posesPub->HasConnections();
+  if (connected && !this->dataPtr->connected)
+    this->dataPtr->sentPoses.clear();
+  this->dataPtr->connected = connected;
+
+  // Only links that moved since the last frame
+  msgs::PosesStamped msg;
+  msgs::Set(msg.mutable_time(), simTime);
+  for (auto const &model : this->dataPtr->world->Models())
+  {
+    if (model->IsStatic())
+      continue;
+
+    physics::Link_V links;
+    CollectLinks(model, links);
+    for (auto const &link : links)
+    {
+      const std::string name = link->GetScopedName();
+      const ignition::math::Pose3d pose = link->WorldPose();
+      auto iter = this->dataPtr->sentPoses.find(name);
+      if (iter != this->dataPtr->sentPoses.end() && iter->second == pose)
+        continue;
+
+      this->dataPtr->sentPoses[name] = pose;
+      msgs::Pose *poseMsg = msg.add_pose();
+      msgs::Set(poseMsg, pose);
+      poseMsg->set_name(name);
+    }
+  }
+
+  // The sensor server renders the previous frame meanwhile
+  if (this->dataPtr->lockstep && this->dataPtr->sent && connected)
+  {
+    std::unique_lock<std::mutex> lock(this->dataPtr->mutex);
+    if (!this->dataPtr->cond.wait_for(lock, this->dataPtr->timeout, [&]
+        {
+          return this->dataPtr->ackTime >= this->dataPtr->sentTime;
+        }))
+    {
+      gzwarn << "The sensor server did not acknowledge the frame at ["
+             << this->dataPtr->sentTime << "]\n";
+    }
+  }
+
+  this->dataPtr->posesPub->Publish(msg);
+  this->dataPtr->sentTime = simTime;
+  this->dataPtr->sent = true;
+}
+
+/////////////////////////////////////////////////
+void SensorServerPlugin::OnAck(ConstTimePtr &_msg)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->ackTime = msgs::Convert(*_msg);
+  this->dataPtr->cond.notify_all();
+}
+
+/////////////////////////////////////////////////
+void SensorServerPlugin::OnPoses(ConstPosesStampedPtr &_msg)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->frames.push_back(_msg);
+  this->dataPtr->cond.notify_all();
+}
+
+/////////////////////////////////////////////////
+void SensorServerPlugin::OnSensorsUpdateBegin()
+{
+  // In lockstep, the world waited for the sensors due at the previous
+  // frame before this step
+  if (this->dataPtr->pendingAck)
+  {
+    msgs::Time ack;
+    msgs::Set(&ack, this->dataPtr->renderedTime);
+    this->dataPtr->ackPub->Publish(ack);
+    this->dataPtr->pendingAck = false;
+  }
+
+  ConstPosesStampedPtr frame;
+  {
+    std::unique_lock<std::mutex> lock(this->dataPtr->mutex);
+    while (this->dataPtr->frames.empty())
+    {
+      if (!physics::worlds_running())
+        return;
+      this->dataPtr->cond.wait_for(lock, std::chrono::milliseconds(100));
+    }
+    frame = this->dataPtr->frames.front();
+    this->dataPtr->frames.pop_front();
+  }
+
+  const common::Time frameTime = msgs::Convert(frame->time());
+  this->dataPtr->world->SetSimTime(frameTime);
+  for (auto const &pose : frame->pose())
+  {
+    auto iter = this->dataPtr->links.find(pose.name());
+    if (iter != this->dataPtr->links.end())
+      iter->second->SetWorldPose(msgs::ConvertIgn(pose));
+  }
+
+  this->dataPtr->renderedTime = frameTime;
+  this->dataPtr->pendingAck = true;
+}
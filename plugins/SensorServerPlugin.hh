@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PLUGINS_SENSORSERVERPLUGIN_HH_
+#define GAZEBO_PLUGINS_SENSORSERVERPLUGIN_HH_
+
+#include <memory>
+
+#include "gazebo/common/Plugin.hh"
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  // Forward declare private data class
+  class SensorServerPluginPrivate;
+
+  /// \brief A world plugin that moves the rendering sensors of a world to
+  /// another gzserver process, typically on a GPU host.
+  ///
+  /// Both processes load the same world file and share one master: the
+  /// sensor server is started with GAZEBO_MASTER_URI pointing at the
+  /// physics server, so its sensors publish on the topics clients already
+  /// use.
+  ///
+  /// With the physics role, the plugin publishes the world pose of the
+  /// links that moved, at update_rate in simulation time, on
+  /// ~/sensor_server/poses. Run that server with --physics_only so it
+  /// skips the rendering sensors.
+  ///
+  /// With the sensors role, physics is disabled and the world only steps
+  /// when a pose frame arrives: the plugin sets the link poses and the
+  /// simulation time of the frame, and the rendering sensors render them.
+  /// Sensors that don't render are removed, they run on the physics
+  /// server. Run that server with --lockstep --minimal_comms, so sensors
+  /// render every frame they are due at and the world doesn't publish
+  /// poses to clients twice. Once the frame is rendered, the plugin sends
+  /// its time back on ~/sensor_server/ack.
+  ///
+  /// In lockstep, the physics server waits for the sensor server to
+  /// acknowledge a frame before it publishes the next one, so rendering a
+  /// frame overlaps with the physics steps up to the next one.
+  ///
+  /// <plugin name="sensor_server" filename="libSensorServerPlugin.so">
+  ///   <!-- physics or sensors, GAZEBO_SENSOR_SERVER_ROLE overrides it -->
+  ///   <role>physics</role>
+  ///   <!-- Pose frames per second of simulation time -->
+  ///   <update_rate>30</update_rate>
+  ///   <!-- Wait for the sensor server before the next frame -->
+  ///   <lockstep>true</lockstep>
+  ///   <!-- Seconds to wait for an acknowledgement -->
+  ///   <timeout>5</timeout>
+  /// </plugin>
+  class GZ_PLUGIN_VISIBLE SensorServerPlugin : public WorldPlugin
+  {
+    /// \brief Constructor.
+    public: SensorServerPlugin();
+
+    /// \brief Destructor.
+    public: virtual ~SensorServerPlugin();
+
+    // Documentation inherited
+    public: virtual void Load(physics::WorldPtr _world,
+                              sdf::ElementPtr _sdf);
+
+    /// \brief Publish a pose frame when one is due, on the physics server.
+    private: void OnPhysicsUpdateEnd();
+
+    /// \brief Callback for acknowledgements, on the physics server.
+    /// \param[in] _msg Time of the rendered frame.
+    private: void OnAck(ConstTimePtr &_msg);
+
+    /// \brief Wait for the next pose frame and apply it, on the sensor
+    /// server.
+    private: void OnSensorsUpdateBegin();
+
+    /// \brief Callback for pose frames, on the sensor server.
+    /// \param[in] _msg Link poses.
+    private: void OnPoses(ConstPosesStampedPtr &_msg);
+
+    /// \internal
+    /// \brief Pointer to private data.
+    private: std::unique_ptr<SensorServerPluginPrivate> dataPtr;
+  };
+}
+#endif
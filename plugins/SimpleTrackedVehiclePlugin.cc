@@ -15,7 +15,11 @@
  *
 */
 
+#include <algorithm>
 #include <functional>
+#include <limits>
+#include <map>
+#include <utility>
 #include <vector>
 
 #include <boost/version.hpp>
@@ -50,6 +54,68 @@ using namespace physics;
 /// \brief This is a temporary workaround to keep ABI compatibility in
 /// Gazebo 9. It should be deleted starting with Gazebo 10.
 unordered_map<LinkPtr, unordered_map<Tracks, Link_V> > globalTracks;
+
+/// \brief Contacts of the current step sorted by the tracked vehicle they
+/// touch. Built by the first vehicle that drives its tracks in a step, so
+/// the contact list is walked once per step instead of once per vehicle.
+/// Global for the same ABI reason as globalTracks.
+struct TrackedVehicleContactRoutes
+{
+  /// \brief Contact manager the routes were built from.
+  ContactManager *manager = nullptr;
+
+  /// \brief World iteration the routes were built for.
+  uint32_t iteration = std::numeric_limits<uint32_t>::max();
+
+  /// \brief Number of contacts the routes were built from.
+  unsigned int contactCount = 0;
+
+  /// \brief Number of plugins driving each model.
+  unordered_map<const Model *, unsigned int> vehicles;
+
+  /// \brief Contacts touching each vehicle model.
+  unordered_map<const Model *, vector<Contact *> > contacts;
+};
+TrackedVehicleContactRoutes globalContactRoutes;
+
+/// \brief Get the contacts of the current step touching a vehicle,
+/// routing all the contacts first if it wasn't done yet for this step.
+/// \param[in] _manager Contact manager of the world.
+/// \param[in] _model The vehicle model.
+/// \param[in] _iteration Current world iteration.
+/// \return Contacts touching the vehicle.
+static const vector<Contact *> &RoutedContacts(ContactManager *_manager,
+    const Model *_model, const uint32_t _iteration)
+{
+  auto &routes = globalContactRoutes;
+  if (routes.manager != _manager || routes.iteration != _iteration ||
+      routes.contactCount != _manager->GetContactCount())
+  {
+    routes.manager = _manager;
+    routes.iteration = _iteration;
+    routes.contactCount = _manager->GetContactCount();
+    for (auto &route : routes.contacts)
+      route.second.clear();
+
+    // Beware! There may be invalid contacts beyond GetContactCount()...
+    const auto &contacts = _manager->GetContacts();
+    for (unsigned int i = 0; i < routes.contactCount; ++i)
+    {
+      Contact *contact = contacts[i];
+      const Model *model1 = contact->collision1->GetLink()->GetModel().get();
+      const Model *model2 = contact->collision2->GetLink()->GetModel().get();
+
+      if (routes.vehicles.count(model1))
+        routes.contacts[model1].push_back(contact);
+      if (model2 != model1 && routes.vehicles.count(model2))
+        routes.contacts[model2].push_back(contact);
+    }
+  }
+
+  static const vector<Contact *> empty;
+  auto iter = routes.contacts.find(_model);
+  return iter == routes.contacts.end() ? empty : iter->second;
+}
 }
 
 using namespace gazebo;
@@ -64,6 +130,17 @@ SimpleTrackedVehiclePlugin::~SimpleTrackedVehiclePlugin()
     {
       globalTracks.erase(this->body);
     }
+
+    if (this->beforePhysicsUpdateConnection)
+    {
+      const Model *model = this->body->GetModel().get();
+      auto iter = globalContactRoutes.vehicles.find(model);
+      if (iter != globalContactRoutes.vehicles.end() && --iter->second == 0)
+      {
+        globalContactRoutes.vehicles.erase(iter);
+        globalContactRoutes.contacts.erase(model);
+      }
+    }
   }
 }
 
@@ -208,6 +285,11 @@ void SimpleTrackedVehiclePlugin::Init()
   // a real contact subscriber)
   this->contactManager->SetNeverDropContacts(true);
 
+  // receive the contacts of this model when the contacts are routed
+  ++globalContactRoutes.vehicles[model.get()];
+  // force a rebuild of the routes
+  globalContactRoutes.manager = nullptr;
+
   // set correct categories and collide bitmasks
   this->SetGeomCategories();
 
@@ -342,18 +424,24 @@ void SimpleTrackedVehiclePlugin::DriveTracks(
   // For each contact, compute the friction force direction and speed of
   // surface movement.
   ////////////////////////////////////////////////////////////////////////
-  size_t i = 0;
-  const auto contacts = this->contactManager->GetContacts();
   const auto model = this->body->GetModel();
+  // only the contacts touching this vehicle
+  const auto &contacts = RoutedContacts(this->contactManager, model.get(),
+      model->GetWorld()->Iterations());
+
+  // ODE contact joints of the track bodies, sorted by the pair of
+  // geometries in contact. Each body's joints are walked once instead of
+  // once per contact.
+  using GeomKey = std::pair<dGeomID, dGeomID>;
+  auto GeomPair = [](dGeomID _g1, dGeomID _g2)
+  {
+    return _g1 < _g2 ? GeomKey(_g1, _g2) : GeomKey(_g2, _g1);
+  };
+  std::map<GeomKey, std::vector<dContact *>> jointContacts;
+  std::vector<dBodyID> walkedBodies;
 
   for (auto contact : contacts)
   {
-    // Beware! There may be invalid contacts beyond GetContactCount()...
-    if (i == this->contactManager->GetContactCount())
-      break;
-
-    ++i;
-
     if (contact->collision1->GetSurface()->collideWithoutContact ||
       contact->collision2->GetSurface()->collideWithoutContact)
       continue;
@@ -369,13 +457,6 @@ void SimpleTrackedVehiclePlugin::DriveTracks(
       continue;
     }
 
-    if (model != contact->collision1->GetLink()->GetModel() &&
-        model != contact->collision2->GetLink()->GetModel())
-    {
-      // Verify one of the collisions' bodies is a track of this vehicle
-      continue;
-    }
-
     dBodyID body1 = dynamic_cast<physics::ODELink&>(
       *contact->collision1->GetLink()).GetODEId();
     dBodyID body2 = dynamic_cast<physics::ODELink& >(
@@ -415,16 +496,36 @@ void SimpleTrackedVehiclePlugin::DriveTracks(
       (dGeomGetCategoryBits(trackGeom) & LEFT_CATEGORY) != 0 ?
       leftBeltSpeed : rightBeltSpeed;
 
-    // remember if we've found at least one contact joint (we should!)
-    bool foundContact = false;
-    for (auto contactIterator = ContactIterator::begin(body1, geom1, geom2);
-         contactIterator != ContactIterator::end();
-         ++contactIterator)
+    if (std::find(walkedBodies.begin(), walkedBodies.end(), body1) ==
+        walkedBodies.end())
     {
-      dContact* odeContact = contactIterator.getPointer();
+      walkedBodies.push_back(body1);
+      const int jointCount = dBodyGetNumJoints(body1);
+      for (int j = 0; j < jointCount; ++j)
+      {
+        const auto joint = dBodyGetJoint(body1, j);
+        if (dJointGetType(joint) != dJointTypeContact)
+          continue;
+
+        // HACK private ODE data, see ContactIterator::operator++
+        dContact *odeContact =
+          &(static_cast<dxJointContact*>(joint)->contact);
+        jointContacts[GeomPair(odeContact->geom.g1, odeContact->geom.g2)]
+          .push_back(odeContact);
+      }
+    }
 
-      // now we're sure it is a contact between our two geometries
-      foundContact = true;
+    // we should find at least one contact joint
+    auto jointIter = jointContacts.find(GeomPair(geom1, geom2));
+    if (jointIter == jointContacts.end())
+    {
+      gzwarn << "No ODE contact joint found for contact " <<
+             contact->DebugString() << std::endl;
+      continue;
+    }
+
+    for (dContact *odeContact : jointIter->second)
+    {
 
       const ignition::math::Vector3d contactWorldPosition(
         odeContact->geom.pos[0],
@@ -476,13 +577,6 @@ void SimpleTrackedVehiclePlugin::DriveTracks(
       odeContact->surface.motion1 = this->ComputeSurfaceMotion(
         beltSpeed, beltDirection, frictionDirection);
     }
-
-    if (!foundContact)
-    {
-      gzwarn << "No ODE contact joint found for contact " <<
-             contact->DebugString() << std::endl;
-      continue;
-    }
   }
   IGN_PROFILE_END();
 }
@@ -16,6 +16,9 @@
 */
 
 #include <curl/curl.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
 #include <boost/filesystem.hpp>
 
 #include <ignition/math/Angle.hh>
@@ -66,6 +69,7 @@ namespace gazebo
     /// \param[in] _apiKey Google API key
     /// \param[in] _saveDirPath Location in local filesystem to save tile
     /// images.
+    /// \return Filenames of the tiles, relative to _saveDirPath.
     public: std::vector<std::string> DownloadMapTiles(const double _centerLat,
         const double _centerLon, const unsigned int _zoom,
         const unsigned int _tileSizePx,
@@ -95,6 +99,19 @@ namespace gazebo
     public: double GroundResolution(const double _lat,
         const unsigned int _zoom) const;
 
+    /// \brief Get a tile from the tile cache, or download it and add it to
+    /// the cache.
+    /// \param[in] _url URL of the tile.
+    /// \param[in] _cacheName Filename of the tile in the tile cache.
+    /// \param[in] _path Path to save the tile to.
+    public: void FetchTile(const std::string &_url,
+        const std::string &_cacheName, const std::string &_path);
+
+    /// \brief Download the tiles, create the map model and spawn it. Runs
+    /// on buildThread.
+    /// \param[in] _modelPath Path to save the model to.
+    public: void BuildModel(const boost::filesystem::path &_modelPath);
+
     /// \brief Spawn a model into the world
     /// \param[in] _name Name of model
     /// \param[in] _pose Pose of model
@@ -132,6 +149,24 @@ namespace gazebo
     /// files.
     public: bool useCache = false;
 
+    /// \brief True to keep downloaded tiles in tileCachePath.
+    public: bool cacheTiles = true;
+
+    /// \brief Directory of the tile cache.
+    public: boost::filesystem::path tileCachePath;
+
+    /// \brief Maximum number of concurrent tile downloads.
+    public: unsigned int maxDownloads = 4u;
+
+    /// \brief Thread that downloads the tiles and creates the model.
+    public: std::thread buildThread;
+
+    /// \brief Set to stop downloading tiles when the plugin is destroyed.
+    public: std::atomic<bool> stop{false};
+
+    /// \brief True if curl_global_init was called.
+    public: bool curlInitialized = false;
+
     /// \brief Google API key
     public: std::string apiKey;
 
@@ -163,6 +198,7 @@ size_t WriteData(void *_ptr, size_t _size, size_t _nmemb, FILE *_stream)
 }
 
 /////////////////////////////////////////////////
+/// \return True if the file was downloaded with a successful status code.
 bool DownloadFile(const std::string &_url, const std::string &_outputFile)
 {
   if (_url.empty())
@@ -172,6 +208,8 @@ bool DownloadFile(const std::string &_url, const std::string &_outputFile)
 
   curl_easy_setopt(curl, CURLOPT_URL, _url.c_str());
   curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteData);
+  // Tiles are downloaded from several threads, don't use signals
+  curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
 
   FILE *fp = fopen(_outputFile.c_str(), "wb");
   if (!fp)
@@ -179,6 +217,7 @@ bool DownloadFile(const std::string &_url, const std::string &_outputFile)
     gzerr << "Could not download model[" << _url << "] because we were"
       << "unable to write to file[" << _outputFile << "]."
       << "Please fix file permissions.";
+    curl_easy_cleanup(curl);
     return false;
   }
   curl_easy_setopt(curl, CURLOPT_WRITEDATA, fp);
@@ -206,13 +245,13 @@ bool DownloadFile(const std::string &_url, const std::string &_outputFile)
   fclose(fp);
 
   // Update the status code.
-  int statusCode = 0;
+  long statusCode = 0;
   curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &statusCode);
 
   // Cleaning.
   curl_easy_cleanup(curl);
 
-  return true;
+  return success == CURLE_OK && statusCode == 200;
 }
 
 
@@ -261,6 +300,18 @@ StaticMapPlugin::StaticMapPlugin()
 {
 }
 
+/////////////////////////////////////////////////
+StaticMapPlugin::~StaticMapPlugin()
+{
+  // Tiles being downloaded are finished, the others are skipped
+  this->dataPtr->stop = true;
+  if (this->dataPtr->buildThread.joinable())
+    this->dataPtr->buildThread.join();
+
+  if (this->dataPtr->curlInitialized)
+    curl_global_cleanup();
+}
+
 /////////////////////////////////////////////////
 void StaticMapPlugin::Load(physics::WorldPtr _world, sdf::ElementPtr _sdf)
 {
@@ -322,6 +373,15 @@ void StaticMapPlugin::Load(physics::WorldPtr _world, sdf::ElementPtr _sdf)
   if (_sdf->HasElement("use_cache"))
     this->dataPtr->useCache = _sdf->Get<bool>("use_cache");
 
+  if (_sdf->HasElement("cache_tiles"))
+    this->dataPtr->cacheTiles = _sdf->Get<bool>("cache_tiles");
+
+  if (_sdf->HasElement("max_downloads"))
+  {
+    this->dataPtr->maxDownloads = std::max(1u,
+        _sdf->Get<unsigned int>("max_downloads"));
+  }
+
   if (_sdf->HasElement("pose"))
     this->dataPtr->modelPose = _sdf->Get<ignition::math::Pose3d>("pose");
 
@@ -349,8 +409,10 @@ void StaticMapPlugin::Init()
     return;
 
   // check if model exists locally
-  auto basePath = common::SystemPaths::Instance()->GetLogPath() /
-        boost::filesystem::path("models");
+  auto logPath = boost::filesystem::path(
+      common::SystemPaths::Instance()->GetLogPath());
+  auto basePath = logPath / "models";
+  this->dataPtr->tileCachePath = logPath / "map_tiles";
 
   this->dataPtr->node = transport::NodePtr(new transport::Node());
   this->dataPtr->node->Init();
@@ -367,56 +429,70 @@ void StaticMapPlugin::Init()
     return;
   }
 
+  // curl_global_init isn't thread safe, call it before the downloads start
+  this->dataPtr->curlInitialized =
+      curl_global_init(CURL_GLOBAL_DEFAULT) == CURLE_OK;
+
+  // Don't hold up the world while the tiles are downloaded
+  this->dataPtr->buildThread = std::thread(
+      &StaticMapPluginPrivate::BuildModel, this->dataPtr.get(), modelPath);
+}
 
+/////////////////////////////////////////////////
+void StaticMapPluginPrivate::BuildModel(
+    const boost::filesystem::path &_modelPath)
+{
   // create tmp dir to save model files
   boost::filesystem::path tmpModelPath =
-      boost::filesystem::temp_directory_path() / this->dataPtr->modelName;
+      boost::filesystem::temp_directory_path() / this->modelName;
   boost::filesystem::path scriptsPath(tmpModelPath / "materials" / "scripts");
   boost::filesystem::create_directories(scriptsPath);
   boost::filesystem::path texturesPath(tmpModelPath / "materials" / "textures");
   boost::filesystem::create_directories(texturesPath);
 
   // download map tile images into model/materials/textures
-  std::vector<std::string> tiles = this->dataPtr->DownloadMapTiles(
-      this->dataPtr->center.X(),
-      this->dataPtr->center.Y(),
-      this->dataPtr->zoom,
-      this->dataPtr->tileSizePx,
-      this->dataPtr->worldSize,
-      this->dataPtr->mapType,
-      this->dataPtr->apiKey,
+  std::vector<std::string> tiles = this->DownloadMapTiles(
+      this->center.X(),
+      this->center.Y(),
+      this->zoom,
+      this->tileSizePx,
+      this->worldSize,
+      this->mapType,
+      this->apiKey,
       texturesPath.string());
+  if (this->stop)
+    return;
 
   // assume square model for now
   unsigned int xNumTiles = std::sqrt(tiles.size());
   unsigned int yNumTiles = xNumTiles;
 
-  double tileWorldSize = this->dataPtr->GroundResolution(
-      IGN_DTOR(this->dataPtr->center.X()), this->dataPtr->zoom)
-      * this->dataPtr->tileSizePx;
+  double tileWorldSize = this->GroundResolution(
+      IGN_DTOR(this->center.X()), this->zoom)
+      * this->tileSizePx;
 
   // create model and spawn it into the world
-  if (this->dataPtr->CreateMapTileModel(
-      this->dataPtr->modelName, tileWorldSize,
+  if (this->CreateMapTileModel(
+      this->modelName, tileWorldSize,
       xNumTiles, yNumTiles, tiles, tmpModelPath.string()))
   {
     // verify model dir is created
     if (common::exists(tmpModelPath.string()))
     {
       // remove existing map model
-      if (common::exists(modelPath.string()))
-        boost::filesystem::remove_all(modelPath);
+      if (common::exists(_modelPath.string()))
+        boost::filesystem::remove_all(_modelPath);
 
       try
       {
         // move new map model to gazebo model path
-        boost::filesystem::rename(tmpModelPath, modelPath);
+        boost::filesystem::rename(tmpModelPath, _modelPath);
       }
       catch(boost::filesystem::filesystem_error &_e)
       {
         // rename failed. Could be an invalid cross-device link error
         // try copy and remove method
-        bool result = common::copyDir(tmpModelPath, modelPath);
+        bool result = common::copyDir(tmpModelPath, _modelPath);
         if (result)
         {
           boost::filesystem::remove_all(tmpModelPath);
@@ -424,13 +500,13 @@ void StaticMapPlugin::Init()
         else
         {
           gzerr<< "Unable to copy model from '" << tmpModelPath.string()
-                 << "' to '" << modelPath.string() << "'" << std::endl;
+                 << "' to '" << _modelPath.string() << "'" << std::endl;
           return;
         }
       }
       // spawn the model
-      this->dataPtr->SpawnModel("model://" + this->dataPtr->modelName,
-          this->dataPtr->modelPose);
+      this->SpawnModel("model://" + this->modelName,
+          this->modelPose);
     }
     else
       gzerr << "Failed to create model: " << tmpModelPath.string() << std::endl;
@@ -493,8 +569,10 @@ std::vector<std::string> StaticMapPluginPrivate::DownloadMapTiles(
     y += halfTileSize;
   double startx = x;
 
-  // download map tiles using google static map API
+  // compute the url and filenames of the map tiles
   std::string url = "https://maps.googleapis.com/maps/api/staticmap";
+  std::vector<std::string> urls;
+  std::vector<std::string> cacheNames;
   for (unsigned int i = 0; i < yNumTiles; ++i)
   {
     for (unsigned int j = 0; j < xNumTiles; ++j)
@@ -505,7 +583,6 @@ std::vector<std::string> StaticMapPluginPrivate::DownloadMapTiles(
       // convert world point to lat lon
       auto latLon = MercatorProjection::PointToLatLon(point);
 
-      // download tile image
       std::stringstream query;
       query << "?center="
             << std::setprecision(9)
@@ -515,22 +592,91 @@ std::vector<std::string> StaticMapPluginPrivate::DownloadMapTiles(
             << "&size=" << _tileSizePx << "x" << _tileSizePx
             << "&maptype=" << _mapType
             << "&key=" << _apiKey;
-      std::string fullURL = url + query.str();
+      urls.push_back(url + query.str());
+
       std::stringstream filename;
       filename << "tile_"
                << std::setprecision(9) << latLon.LatitudeReference().Degree()
                << "_" << latLon.LongitudeReference().Degree() << ".png";
-      std::string fullPath = _saveDirPath + "/" + filename.str();
-      DownloadFile(fullURL, fullPath);
-      gzmsg << "Downloading map tile: " << filename.str() << std::endl;
-      mapTileFilenames.push_back(filename.str());
+      this->mapTileFilenames.push_back(filename.str());
+
+      // the cache is shared by all maps, so the key includes everything
+      // that changes the image
+      std::stringstream cacheName;
+      cacheName << _mapType << "_" << _zoom << "_" << _tileSizePx << "_"
+                << filename.str();
+      cacheNames.push_back(cacheName.str());
 
       x += _tileSizePx;
     }
     x = startx;
     y += _tileSizePx;
   }
-  return mapTileFilenames;
+
+  // download map tiles using google static map API, a few at a time
+  std::atomic<size_t> next(0);
+  auto fetch = [&]()
+  {
+    for (size_t t = next++; t < urls.size() && !this->stop; t = next++)
+    {
+      this->FetchTile(urls[t], cacheNames[t],
+          _saveDirPath + "/" + this->mapTileFilenames[t]);
+    }
+  };
+
+  std::vector<std::thread> workers;
+  const size_t workerCount = std::min<size_t>(this->maxDownloads, urls.size());
+  for (size_t w = 1; w < workerCount; ++w)
+    workers.emplace_back(fetch);
+  fetch();
+  for (auto &worker : workers)
+    worker.join();
+
+  return this->mapTileFilenames;
+}
+
+/////////////////////////////////////////////////
+void StaticMapPluginPrivate::FetchTile(const std::string &_url,
+    const std::string &_cacheName, const std::string &_path)
+{
+  boost::filesystem::path cached = this->tileCachePath / _cacheName;
+  boost::system::error_code ec;
+  if (this->cacheTiles && boost::filesystem::file_size(cached, ec) > 0 &&
+      !ec)
+  {
+    boost::filesystem::remove(_path, ec);
+    boost::filesystem::copy_file(cached, _path, ec);
+    if (!ec)
+    {
+      gzmsg << "Using cached map tile: " << _cacheName << std::endl;
+      return;
+    }
+  }
+
+  gzmsg << "Downloading map tile: " << _cacheName << std::endl;
+  if (!DownloadFile(_url, _path))
+  {
+    gzwarn << "Failed to download map tile: " << _cacheName << std::endl;
+    return;
+  }
+
+  if (!this->cacheTiles)
+    return;
+
+  // copy under a temporary name first, so that a partly written tile is
+  // never picked up from the cache
+  boost::filesystem::create_directories(this->tileCachePath, ec);
+  boost::filesystem::path tmp = this->tileCachePath /
+      boost::filesystem::unique_path(_cacheName + ".%%%%-%%%%.tmp");
+  boost::filesystem::copy_file(_path, tmp, ec);
+  if (!ec)
+    boost::filesystem::rename(tmp, cached, ec);
+  if (ec)
+  {
+    gzwarn << "Unable to cache map tile [" << cached.string() << "]: "
+           << ec.message() << std::endl;
+    boost::filesystem::remove(tmp, ec);
+  }
 }
 
 /////////////////////////////////////////////////
@@ -52,11 +52,23 @@ namespace gazebo
   ///              API documentation for more details.
   /// <use_cache>  Use model in gazebo model path if exists, otherwise
   ///              recreate the model and save it in <HOME>/.gazebo/models
+  /// <cache_tiles> Keep downloaded tiles in <HOME>/.gazebo/map_tiles and
+  ///              reuse them when a tile with the same map type, zoom, size
+  ///              and center is needed again. Defaults to true.
+  /// <max_downloads> Maximum number of tiles downloaded at the same time.
+  ///              Defaults to 4.
+  ///
+  /// The tiles are fetched and the model is created in the background, the
+  /// model is spawned once they're ready, so the world doesn't wait for the
+  /// downloads to start.
   class GZ_PLUGIN_VISIBLE StaticMapPlugin : public WorldPlugin
   {
     /// \brief Constructor.
     public: StaticMapPlugin();
 
+    /// \brief Destructor.
+    public: virtual ~StaticMapPlugin();
+
     /// \brief Load the plugin.
     /// \param[in] _world Pointer to world
     /// \param[in] _sdf Pointer to the SDF configuration.
@@ -0,0 +1,216 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <string>
+
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector2.hh>
+
+#include "plugins/StreamingViewGUIPlugin.hh"
+
+namespace gazebo
+{
+  /// \brief Private data for the StreamingViewGUIPlugin class
+  class StreamingViewGUIPluginPrivate
+  {
+    /// \brief Node for communication.
+    public: transport::NodePtr node;
+
+    /// \brief Subscriber to the compressed images.
+    public: transport::SubscriberPtr imageSub;
+
+    /// \brief Publisher of motion commands.
+    public: transport::PublisherPtr controlPub;
+
+    /// \brief Label showing the frames.
+    public: QLabel *frameLabel = nullptr;
+
+    /// \brief Latest frame, kept to rescale it on resize.
+    public: QImage frame;
+
+    /// \brief Mouse position of the last press or move event.
+    public: QPoint lastMousePos;
+  };
+}
+
+using namespace gazebo;
+
+// Register this plugin with the simulator
+GZ_REGISTER_GUI_PLUGIN(StreamingViewGUIPlugin)
+
+/// \brief Radians turned per pixel of mouse motion.
+static const double kLookSpeed = 0.005;
+
+/// \brief Meters panned per pixel of mouse motion.
+static const double kPanSpeed = 0.01;
+
+/// \brief Meters moved per wheel step.
+static const double kZoomSpeed = 0.5;
+
+/////////////////////////////////////////////////
+StreamingViewGUIPlugin::StreamingViewGUIPlugin()
+  : GUIPlugin(), dataPtr(new StreamingViewGUIPluginPrivate)
+{
+  this->setStyleSheet("QFrame { background-color : black; }");
+
+  QHBoxLayout *mainLayout = new QHBoxLayout;
+  QFrame *mainFrame = new QFrame();
+  QVBoxLayout *frameLayout = new QVBoxLayout();
+
+  this->dataPtr->frameLabel = new QLabel(tr("Waiting for frames..."));
+  this->dataPtr->frameLabel->setAlignment(Qt::AlignCenter);
+  this->dataPtr->frameLabel->setSizePolicy(QSizePolicy::Ignored,
+      QSizePolicy::Ignored);
+  this->dataPtr->frameLabel->setStyleSheet("QLabel { color : white; }");
+  this->dataPtr->frameLabel->setAttribute(
+      Qt::WA_TransparentForMouseEvents);
+  frameLayout->addWidget(this->dataPtr->frameLabel);
+  frameLayout->setContentsMargins(0, 0, 0, 0);
+  mainFrame->setLayout(frameLayout);
+
+  mainLayout->addWidget(mainFrame);
+  mainLayout->setContentsMargins(0, 0, 0, 0);
+  this->setLayout(mainLayout);
+
+  this->resize(640, 480);
+
+  connect(this, SIGNAL(FrameReceived(QImage)), this, SLOT(OnFrame(QImage)),
+      Qt::QueuedConnection);
+}
+
+/////////////////////////////////////////////////
+StreamingViewGUIPlugin::~StreamingViewGUIPlugin()
+{
+  this->dataPtr->imageSub.reset();
+  this->dataPtr->controlPub.reset();
+  if (this->dataPtr->node)
+    this->dataPtr->node->Fini();
+}
+
+/////////////////////////////////////////////////
+void StreamingViewGUIPlugin::Load(sdf::ElementPtr _elem)
+{
+  if (_elem->HasElement("size"))
+  {
+    auto s = _elem->Get<ignition::math::Vector2d>("size");
+    this->resize(s.X(), s.Y());
+  }
+
+  if (_elem->HasElement("pos"))
+  {
+    auto p = _elem->Get<ignition::math::Vector2d>("pos");
+    this->move(p.X(), p.Y());
+  }
+
+  if (!_elem->HasElement("topic"))
+  {
+    gzerr << "StreamingViewGUIPlugin needs the <topic> of a camera's "
+          << "compressed images\n";
+    return;
+  }
+
+  std::string controlTopic = "~/streaming_view/control";
+  if (_elem->HasElement("control_topic"))
+    controlTopic = _elem->Get<std::string>("control_topic");
+
+  this->dataPtr->node = transport::NodePtr(new transport::Node());
+  this->dataPtr->node->Init();
+  this->dataPtr->controlPub =
+      this->dataPtr->node->Advertise<msgs::Pose>(controlTopic);
+
+  // The server only encodes frames while this subscription exists
+  this->dataPtr->imageSub = this->dataPtr->node->Subscribe(
+      _elem->Get<std::string>("topic"), &StreamingViewGUIPlugin::OnImage,
+      this);
+}
+
+/////////////////////////////////////////////////
+void StreamingViewGUIPlugin::OnImage(ConstCompressedImageStampedPtr &_msg)
+{
+  // Decode on the transport thread, the GUI thread only draws
+  QImage image = QImage::fromData(
+      reinterpret_cast<const uchar *>(_msg->data().data()),
+      _msg->data().size());
+  if (image.isNull())
+  {
+    gzerr << "Unable to decode a [" << _msg->format() << "] frame\n";
+    return;
+  }
+
+  emit FrameReceived(image);
+}
+
+/////////////////////////////////////////////////
+void StreamingViewGUIPlugin::OnFrame(QImage _image)
+{
+  this->dataPtr->frame = _image;
+  this->dataPtr->frameLabel->setPixmap(QPixmap::fromImage(_image.scaled(
+      this->dataPtr->frameLabel->size(), Qt::KeepAspectRatio,
+      Qt::FastTransformation)));
+}
+
+/////////////////////////////////////////////////
+void StreamingViewGUIPlugin::Move(const double _forward, const double _left,
+    const double _up, const double _pitch, const double _yaw)
+{
+  if (!this->dataPtr->controlPub)
+    return;
+
+  msgs::Pose msg;
+  msgs::Set(&msg, ignition::math::Pose3d(_forward, _left, _up,
+      0, _pitch, _yaw));
+  this->dataPtr->controlPub->Publish(msg);
+}
+
+/////////////////////////////////////////////////
+void StreamingViewGUIPlugin::mousePressEvent(QMouseEvent *_event)
+{
+  this->dataPtr->lastMousePos = _event->pos();
+  _event->accept();
+}
+
+/////////////////////////////////////////////////
+void StreamingViewGUIPlugin::mouseMoveEvent(QMouseEvent *_event)
+{
+  QPoint delta = _event->pos() - this->dataPtr->lastMousePos;
+  this->dataPtr->lastMousePos = _event->pos();
+
+  if (_event->buttons() & Qt::LeftButton)
+  {
+    this->Move(0, 0, 0, delta.y() * kLookSpeed, -delta.x() * kLookSpeed);
+  }
+  else if (_event->buttons() & (Qt::RightButton | Qt::MiddleButton))
+  {
+    // Drag the scene along with the mouse
+    this->Move(0, delta.x() * kPanSpeed, delta.y() * kPanSpeed, 0, 0);
+  }
+  _event->accept();
+}
+
+/////////////////////////////////////////////////
+void StreamingViewGUIPlugin::wheelEvent(QWheelEvent *_event)
+{
+  this->Move(_event->angleDelta().y() / 120.0 * kZoomSpeed, 0, 0, 0, 0);
+  _event->accept();
+}
+
+/////////////////////////////////////////////////
+void StreamingViewGUIPlugin::resizeEvent(QResizeEvent *_event)
+{
+  GUIPlugin::resizeEvent(_event);
+  if (!this->dataPtr->frame.isNull())
+    this->OnFrame(this->dataPtr->frame);
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PLUGINS_STREAMINGVIEWGUIPLUGIN_HH_
+#define GAZEBO_PLUGINS_STREAMINGVIEWGUIPLUGIN_HH_
+
+#include <memory>
+
+#include <gazebo/gui/GuiPlugin.hh>
+#ifndef Q_MOC_RUN  // See: https://bugreports.qt-project.org/browse/QTBUG-22829
+# include <gazebo/transport/transport.hh>
+#endif
+
+namespace gazebo
+{
+  // Forward declare private data class
+  class StreamingViewGUIPluginPrivate;
+
+  /// \brief A GUI plugin that shows the view of a camera rendered by the
+  /// server, see StreamingViewPlugin. It decodes the camera's compressed
+  /// images and turns mouse input into motion commands:
+  ///
+  ///     left drag: look around
+  ///     right or middle drag: pan
+  ///     wheel: move forward and backward
+  ///
+  /// <plugin name="streaming_view" filename="libStreamingViewGUIPlugin.so">
+  ///   <topic>~/model/link/camera/image/compressed</topic>
+  ///   <control_topic>~/streaming_view/control</control_topic>
+  ///   <pos>pixel_x_pos pixel_y_pos</pos>
+  ///   <size>pixel_width pixel_height</size>
+  /// </plugin>
+  class GZ_PLUGIN_VISIBLE StreamingViewGUIPlugin : public GUIPlugin
+  {
+    Q_OBJECT
+
+    /// \brief Constructor.
+    public: StreamingViewGUIPlugin();
+
+    /// \brief Destructor.
+    public: virtual ~StreamingViewGUIPlugin();
+
+    // Documentation inherited
+    public: void Load(sdf::ElementPtr _elem);
+
+    /// \brief Signal emitted from the transport thread with a decoded
+    /// frame.
+    /// \param[in] _image The frame.
+    signals: void FrameReceived(QImage _image);
+
+    /// \brief Show a decoded frame.
+    /// \param[in] _image The frame.
+    private slots: void OnFrame(QImage _image);
+
+    /// \brief Callback for compressed images.
+    /// \param[in] _msg The encoded frame.
+    private: void OnImage(ConstCompressedImageStampedPtr &_msg);
+
+    /// \brief Publish a relative camera motion.
+    /// \param[in] _forward Translation along the camera's x axis.
+    /// \param[in] _left Translation along the camera's y axis.
+    /// \param[in] _up Translation along the camera's z axis.
+    /// \param[in] _pitch Rotation about the camera's y axis, in radians.
+    /// \param[in] _yaw Rotation about the world z axis, in radians.
+    private: void Move(const double _forward, const double _left,
+                       const double _up, const double _pitch,
+                       const double _yaw);
+
+    // Documentation inherited
+    protected: void mousePressEvent(QMouseEvent *_event);
+
+    // Documentation inherited
+    protected: void mouseMoveEvent(QMouseEvent *_event);
+
+    // Documentation inherited
+    protected: void wheelEvent(QWheelEvent *_event);
+
+    // Documentation inherited
+    protected: void resizeEvent(QResizeEvent *_event);
+
+    /// \internal
+    /// \brief Pointer to private data.
+    private: std::unique_ptr<StreamingViewGUIPluginPrivate> dataPtr;
+  };
+}
+#endif
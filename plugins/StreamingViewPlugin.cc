@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <functional>
+#include <mutex>
+#include <string>
+
+#include <ignition/math/Pose3.hh>
+
+#include "gazebo/common/Events.hh"
+#include "gazebo/rendering/Camera.hh"
+#include "gazebo/sensors/CameraSensor.hh"
+#include "gazebo/transport/transport.hh"
+#include "plugins/StreamingViewPlugin.hh"
+
+namespace gazebo
+{
+  /// \brief Private data for the StreamingViewPlugin class
+  class StreamingViewPluginPrivate
+  {
+    /// \brief Camera sensor the plugin is attached to.
+    public: sensors::CameraSensorPtr sensor;
+
+    /// \brief Rendering camera of the sensor.
+    public: rendering::CameraPtr camera;
+
+    /// \brief Node for communication.
+    public: transport::NodePtr node;
+
+    /// \brief Subscriber to control messages.
+    public: transport::SubscriberPtr controlSub;
+
+    /// \brief Connection to the pre-render event.
+    public: event::ConnectionPtr preRenderConnection;
+
+    /// \brief Protects the accumulated motion.
+    public: std::mutex mutex;
+
+    /// \brief Translation in the camera frame not yet applied.
+    public: ignition::math::Vector3d translation;
+
+    /// \brief Pitch not yet applied, in radians.
+    public: double pitch = 0;
+
+    /// \brief Yaw not yet applied, in radians.
+    public: double yaw = 0;
+
+    /// \brief True if there is motion to apply.
+    public: bool pending = false;
+  };
+}
+
+using namespace gazebo;
+GZ_REGISTER_SENSOR_PLUGIN(StreamingViewPlugin)
+
+/////////////////////////////////////////////////
+StreamingViewPlugin::StreamingViewPlugin()
+  : SensorPlugin(), dataPtr(new StreamingViewPluginPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+StreamingViewPlugin::~StreamingViewPlugin()
+{
+  this->dataPtr->preRenderConnection.reset();
+  this->dataPtr->controlSub.reset();
+  if (this->dataPtr->node)
+    this->dataPtr->node->Fini();
+}
+
+/////////////////////////////////////////////////
+void StreamingViewPlugin::Load(sensors::SensorPtr _sensor,
+    sdf::ElementPtr _sdf)
+{
+  this->dataPtr->sensor =
+      std::dynamic_pointer_cast<sensors::CameraSensor>(_sensor);
+  if (!this->dataPtr->sensor)
+  {
+    gzerr << "StreamingViewPlugin must be attached to a camera sensor\n";
+    return;
+  }
+  this->dataPtr->camera = this->dataPtr->sensor->Camera();
+
+  std::string format = "jpeg";
+  if (_sdf->HasElement("format"))
+    format = _sdf->Get<std::string>("format");
+  int quality = 70;
+  if (_sdf->HasElement("quality"))
+    quality = _sdf->Get<int>("quality");
+  this->dataPtr->sensor->SetCompression(format, quality);
+
+  std::string controlTopic = "~/streaming_view/control";
+  if (_sdf->HasElement("control_topic"))
+    controlTopic = _sdf->Get<std::string>("control_topic");
+
+  this->dataPtr->node = transport::NodePtr(new transport::Node());
+  this->dataPtr->node->Init(this->dataPtr->sensor->WorldName());
+  this->dataPtr->controlSub = this->dataPtr->node->Subscribe(controlTopic,
+      &StreamingViewPlugin::OnControl, this);
+
+  // The camera belongs to the rendering thread, move it from there
+  this->dataPtr->preRenderConnection = event::Events::ConnectPreRender(
+      std::bind(&StreamingViewPlugin::OnPreRender, this));
+
+  gzmsg << "Streaming [" << this->dataPtr->sensor->CompressedTopic()
+        << "], controlled by [" << controlTopic << "]\n";
+}
+
+/////////////////////////////////////////////////
+void StreamingViewPlugin::OnControl(ConstPosePtr &_msg)
+{
+  auto pose = msgs::ConvertIgn(*_msg);
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->translation += pose.Pos();
+  this->dataPtr->pitch += pose.Rot().Pitch();
+  this->dataPtr->yaw += pose.Rot().Yaw();
+  this->dataPtr->pending = true;
+}
+
+/////////////////////////////////////////////////
+void StreamingViewPlugin::OnPreRender()
+{
+  ignition::math::Vector3d translation;
+  double pitch;
+  double yaw;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (!this->dataPtr->pending)
+      return;
+
+    translation = this->dataPtr->translation;
+    pitch = this->dataPtr->pitch;
+    yaw = this->dataPtr->yaw;
+    this->dataPtr->translation = ignition::math::Vector3d::Zero;
+    this->dataPtr->pitch = 0;
+    this->dataPtr->yaw = 0;
+    this->dataPtr->pending = false;
+  }
+
+  auto pose = this->dataPtr->camera->WorldPose();
+  pose.Pos() += pose.Rot().RotateVector(translation);
+  pose.Rot() = ignition::math::Quaterniond(0, 0, yaw) * pose.Rot() *
+      ignition::math::Quaterniond(0, pitch, 0);
+  pose.Rot().Normalize();
+  this->dataPtr->camera->SetWorldPose(pose);
+}
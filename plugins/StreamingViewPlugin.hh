@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PLUGINS_STREAMINGVIEWPLUGIN_HH_
+#define GAZEBO_PLUGINS_STREAMINGVIEWPLUGIN_HH_
+
+#include <memory>
+
+#include "gazebo/common/Plugin.hh"
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  // Forward declare private data class
+  class StreamingViewPluginPrivate;
+
+  /// \brief A camera sensor plugin that lets a remote client steer the
+  /// camera. Together with StreamingViewGUIPlugin, the server renders the
+  /// view and the client only decodes the camera's compressed images, so
+  /// the client needs no meshes, textures or GPU for it.
+  ///
+  /// Pose messages received on the control topic are relative motions:
+  /// the position is a translation in the camera frame (x forward, y left,
+  /// z up), the roll is ignored, the pitch turns about the camera's y axis
+  /// and the yaw about the world z axis.
+  ///
+  /// <sensor name="camera" type="camera">
+  ///   <always_on>1</always_on>
+  ///   ...
+  ///   <plugin name="streaming_view" filename="libStreamingViewPlugin.so">
+  ///     <control_topic>~/streaming_view/control</control_topic>
+  ///     <format>jpeg</format>
+  ///     <quality>70</quality>
+  ///   </plugin>
+  /// </sensor>
+  class GZ_PLUGIN_VISIBLE StreamingViewPlugin : public SensorPlugin
+  {
+    /// \brief Constructor.
+    public: StreamingViewPlugin();
+
+    /// \brief Destructor.
+    public: virtual ~StreamingViewPlugin();
+
+    // Documentation inherited
+    public: virtual void Load(sensors::SensorPtr _sensor,
+                              sdf::ElementPtr _sdf);
+
+    /// \brief Callback for control messages.
+    /// \param[in] _msg Relative camera motion.
+    private: void OnControl(ConstPosePtr &_msg);
+
+    /// \brief Apply the accumulated motion on the rendering thread.
+    private: void OnPreRender();
+
+    /// \internal
+    /// \brief Pointer to private data.
+    private: std::unique_ptr<StreamingViewPluginPrivate> dataPtr;
+  };
+}
+#endif
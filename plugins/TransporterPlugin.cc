@@ -152,7 +152,7 @@ void TransporterPlugin::Update()
   IGN_PROFILE("TransporterPlugin::Update");
   IGN_PROFILE_BEGIN("Update");
   // Get all the models
-  physics::Model_V models = this->dataPtr->world->Models();
+  const physics::Model_V &models = this->dataPtr->world->Models();
 
   std::lock_guard<std::mutex> lock(this->dataPtr->padMutex);
 
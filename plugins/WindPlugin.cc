@@ -225,7 +225,11 @@ void WindPlugin::Load(physics::WorldPtr _world, sdf::ElementPtr _sdf)
   wind.SetLinearVelFunc(std::bind(&WindPlugin::LinearVel, this,
         std::placeholders::_1, std::placeholders::_2));
 
-  this->dataPtr->updateConnection = event::Events::ConnectWorldUpdateBegin(
+  // Read the velocities of all links in bulk, see Wind::ApplyLinearDrag
+  this->dataPtr->world->SetLinkKinematicsCacheEnabled(true);
+
+  // At the end of the update, while the link kinematics cache is current
+  this->dataPtr->updateConnection = event::Events::ConnectWorldUpdateEnd(
           std::bind(&WindPlugin::OnUpdate, this));
 }
 
@@ -297,28 +301,7 @@ void WindPlugin::OnUpdate()
   IGN_PROFILE_BEGIN("Update");
   // Update loop for using the force on mass approximation
   // This is not recommended. Please use the LiftDragPlugin instead.
-
-  // Get all the models
-  physics::Model_V models = this->dataPtr->world->Models();
-
-  // Process each model.
-  for (auto const &model : models)
-  {
-    // Get all the links
-    physics::Link_V links = model->GetLinks();
-
-    // Process each link.
-    for (auto const &link : links)
-    {
-      // Skip links for which the wind is disabled
-      if (!link->WindMode())
-        continue;
-
-      // Add wind velocity as a force to the body
-      link->AddRelativeForce(link->GetInertial()->Mass() *
-          this->dataPtr->forceApproximationScalingFactor *
-          (link->RelativeWindLinearVel() - link->RelativeLinearVel()));
-    }
-  }
+  this->dataPtr->world->Wind().ApplyLinearDrag(
+      this->dataPtr->forceApproximationScalingFactor);
   IGN_PROFILE_END();
 }
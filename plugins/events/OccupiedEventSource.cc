@@ -34,8 +34,10 @@ using namespace gazebo;
 
 ////////////////////////////////////////////////////////////////////////////////
 OccupiedEventSource::OccupiedEventSource(transport::PublisherPtr _pub,
-    physics::WorldPtr _world, const std::map<std::string, RegionPtr> &_regions)
-  : EventSource(_pub, "occupied", _world), regions(_regions)
+    physics::WorldPtr _world, const std::map<std::string, RegionPtr> &_regions,
+    RegionOccupancyPtr _occupancy)
+  : EventSource(_pub, "occupied", _world), regions(_regions),
+    occupancy(_occupancy)
 {
 }
 
@@ -94,6 +96,8 @@ void OccupiedEventSource::Load(const sdf::ElementPtr _sdf)
 
     this->msg.set_data(data);
 
+    this->occupancy->Track(this->regionName);
+
     // Connect to the update event.
     this->updateConnection = event::Events::ConnectWorldUpdateBegin(
         std::bind(&OccupiedEventSource::Update, this));
@@ -103,21 +107,9 @@ void OccupiedEventSource::Load(const sdf::ElementPtr _sdf)
 /////////////////////////////////////////////////
 void OccupiedEventSource::Update()
 {
-  // Get all the models.
-  physics::Model_V models = this->world->Models();
+  this->occupancy->Update();
 
-  // Process each model.
-  for (physics::Model_V::iterator iter = models.begin();
-       iter != models.end(); ++iter)
-  {
-    // Skip models that are static
-    if ((*iter)->IsStatic())
-      continue;
-
-    // If inside, then transmit the desired message.
-    if (this->regions[this->regionName]->Contains((*iter)->WorldPose().Pos()))
-    {
-      this->msgPub->Publish(this->msg);
-    }
-  }
+  // Transmit the desired message while a non static model is inside.
+  if (this->occupancy->Count(this->regionName) > 0)
+    this->msgPub->Publish(this->msg);
 }
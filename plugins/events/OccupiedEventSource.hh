@@ -29,6 +29,7 @@
 #include <gazebo/util/system.hh>
 
 #include "Region.hh"
+#include "RegionOccupancy.hh"
 #include "EventSource.hh"
 
 namespace gazebo
@@ -60,7 +61,8 @@ namespace gazebo
     // Documentation inherited
     public: OccupiedEventSource(transport::PublisherPtr _pub,
                 physics::WorldPtr _world,
-                const std::map<std::string, RegionPtr> &_regions);
+                const std::map<std::string, RegionPtr> &_regions,
+                RegionOccupancyPtr _occupancy);
 
     /// \brief Destructor.
     public: ~OccupiedEventSource() = default;
@@ -91,6 +93,9 @@ namespace gazebo
 
     /// \brief The region used for the in region check.
     private: std::string regionName;
+
+    /// \brief Occupancy of the regions, shared with the other events.
+    private: RegionOccupancyPtr occupancy;
   };
 }
 #endif
@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <functional>
+
+#include <gazebo/common/Events.hh>
+#include <gazebo/physics/Model.hh>
+#include <gazebo/physics/SpatialIndex.hh>
+#include <gazebo/physics/World.hh>
+
+#include "plugins/events/EventSource.hh"
+#include "plugins/events/RegionOccupancy.hh"
+
+using namespace gazebo;
+
+/////////////////////////////////////////////////
+RegionOccupancy::RegionOccupancy(physics::WorldPtr _world,
+    const std::map<std::string, RegionPtr> &_regions)
+  : world(_world), regions(_regions)
+{
+  this->world->SetSpatialIndexEnabled(true);
+
+  this->spawnConnection = SimEventConnector::ConnectSpawnModel(
+      std::bind(&RegionOccupancy::OnSpawnModel, this,
+      std::placeholders::_1, std::placeholders::_2));
+}
+
+/////////////////////////////////////////////////
+bool RegionOccupancy::Track(const std::string &_region)
+{
+  if (this->regions.find(_region) == this->regions.end())
+    return false;
+
+  // Keep the current state if the region is already tracked
+  this->inside.insert(std::make_pair(_region, std::set<std::string>()));
+  return true;
+}
+
+/////////////////////////////////////////////////
+void RegionOccupancy::OnSpawnModel(const std::string &/*_model*/,
+    bool /*_alive*/)
+{
+  this->unindexedDirty = true;
+}
+
+/////////////////////////////////////////////////
+void RegionOccupancy::RefreshUnindexed()
+{
+  const physics::SpatialIndex &index = this->world->ModelSpatialIndex();
+
+  this->unindexed.clear();
+  ignition::math::AxisAlignedBox box;
+  for (auto const &model : this->world->Models())
+  {
+    if (!model->IsStatic() && !index.BoundingBox(model.get(), box))
+      this->unindexed.push_back(model);
+  }
+  this->modelCount = this->world->ModelCount();
+}
+
+/////////////////////////////////////////////////
+void RegionOccupancy::Update()
+{
+  if (this->inside.empty())
+    return;
+
+  uint32_t iteration = this->world->Iterations();
+  if (this->updated && iteration == this->lastIteration)
+    return;
+  this->updated = true;
+  this->lastIteration = iteration;
+
+  // The spatial index is refreshed after the entity list changes, so
+  // also check the model count to catch models it hadn't seen yet
+  if (this->unindexedDirty.exchange(false) ||
+      this->world->ModelCount() != this->modelCount)
+  {
+    this->RefreshUnindexed();
+  }
+
+  const physics::SpatialIndex &index = this->world->ModelSpatialIndex();
+
+  for (auto &occupancy : this->inside)
+  {
+    const RegionPtr &region = this->regions.at(occupancy.first);
+
+    std::set<std::string> current;
+    auto test = [&](const physics::ModelPtr &_model)
+    {
+      if (!_model->IsStatic() && region->Contains(_model->WorldPose().Pos()))
+        current.insert(_model->GetName());
+    };
+
+    for (auto const &box : region->boxes)
+    {
+      for (auto const &model : index.ModelsInBox(box))
+        test(model);
+    }
+    for (auto const &model : this->unindexed)
+      test(model);
+
+    std::set<std::string> &previous = occupancy.second;
+    if (current == previous)
+      continue;
+
+    for (auto const &name : current)
+    {
+      if (previous.find(name) == previous.end())
+        this->transition(occupancy.first, name, true);
+    }
+    for (auto const &name : previous)
+    {
+      if (current.find(name) == current.end())
+        this->transition(occupancy.first, name, false);
+    }
+    previous.swap(current);
+  }
+}
+
+/////////////////////////////////////////////////
+size_t RegionOccupancy::Count(const std::string &_region) const
+{
+  auto iter = this->inside.find(_region);
+  if (iter == this->inside.end())
+    return 0;
+  return iter->second.size();
+}
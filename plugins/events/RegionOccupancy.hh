@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PLUGINS_EVENTS_REGIONOCCUPANCY_HH_
+#define GAZEBO_PLUGINS_EVENTS_REGIONOCCUPANCY_HH_
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <gazebo/common/Event.hh>
+#include <gazebo/physics/PhysicsTypes.hh>
+
+#include "Region.hh"
+
+namespace gazebo
+{
+  /// \brief Keeps track of the non static models inside each region of a
+  /// SimEventsPlugin, shared by all the events of the plugin.
+  ///
+  /// Candidates come from the world's spatial index, which only recomputes
+  /// the boxes of models that moved, so a region costs a grid lookup and a
+  /// point test per nearby model instead of a test per model in the world.
+  /// Models without collisions are not in the spatial index, those are
+  /// kept in a side list, refreshed when models are spawned or deleted,
+  /// and tested directly. A model is only found when its collision box
+  /// overlaps the region, which holds unless its origin is away from all
+  /// of its collisions.
+  class RegionOccupancy
+  {
+    /// \brief Constructor.
+    /// \param[in] _world The world the regions belong to.
+    /// \param[in] _regions Map of region names to regions.
+    public: RegionOccupancy(physics::WorldPtr _world,
+                const std::map<std::string, RegionPtr> &_regions);
+
+    /// \brief Start tracking a region. Only tracked regions are refreshed.
+    /// \param[in] _region Name of the region.
+    /// \return False if there is no region with that name.
+    public: bool Track(const std::string &_region);
+
+    /// \brief Refresh the occupancy of the tracked regions. Cheap to call
+    /// more than once per iteration, only the first call does work.
+    public: void Update();
+
+    /// \brief Get the number of non static models inside a region, as of
+    /// the last update.
+    /// \param[in] _region Name of a tracked region.
+    /// \return Number of models, 0 if the region isn't tracked.
+    public: size_t Count(const std::string &_region) const;
+
+    /// \brief Connect to the transition event, fired from Update when a
+    /// model enters or leaves a tracked region.
+    /// \param[in] _subscriber Called with the region name, the model name
+    /// and true if the model entered the region.
+    /// \return Connection to keep alive.
+    public: template<typename T>
+            event::ConnectionPtr ConnectTransition(T _subscriber)
+            { return this->transition.Connect(_subscriber); }
+
+    /// \brief Called when a model is spawned or deleted.
+    /// \param[in] _model Name of the model.
+    /// \param[in] _alive True if the model was spawned.
+    private: void OnSpawnModel(const std::string &_model, bool _alive);
+
+    /// \brief Rebuild the list of models missing from the spatial index.
+    private: void RefreshUnindexed();
+
+    /// \brief World the regions belong to.
+    private: physics::WorldPtr world;
+
+    /// \brief Map of region names to regions.
+    private: const std::map<std::string, RegionPtr> &regions;
+
+    /// \brief Names of the models inside each tracked region.
+    private: std::map<std::string, std::set<std::string>> inside;
+
+    /// \brief Non static models that aren't in the spatial index.
+    private: physics::Model_V unindexed;
+
+    /// \brief True if the unindexed list must be rebuilt.
+    private: std::atomic<bool> unindexedDirty{true};
+
+    /// \brief Model count of the last refresh of the unindexed list.
+    private: unsigned int modelCount = 0;
+
+    /// \brief Iteration of the last update.
+    private: uint32_t lastIteration = 0;
+
+    /// \brief True once Update ran at least once.
+    private: bool updated = false;
+
+    /// \brief Fired when a model enters or leaves a region.
+    private: event::EventT<void (const std::string &, const std::string &,
+                 bool)> transition;
+
+    /// \brief Connection to the spawn model event.
+    private: event::ConnectionPtr spawnConnection;
+  };
+
+  /// \def RegionOccupancyPtr
+  /// \brief Shared pointer to a region occupancy.
+  typedef std::shared_ptr<RegionOccupancy> RegionOccupancyPtr;
+}
+#endif
@@ -129,8 +129,14 @@ void SimEventsPlugin::Load(physics::WorldPtr _parent, sdf::ElementPtr _sdf)
     }
     else if (eventType == "occupied")
     {
+      // Regions are only indexed when an event needs their occupancy
+      if (!this->occupancy)
+      {
+        this->occupancy.reset(
+            new RegionOccupancy(this->world, this->regions));
+      }
       event.reset(new OccupiedEventSource(this->pub,
-            this->world, this->regions));
+            this->world, this->regions, this->occupancy));
     }
     else if (eventType == "existence" )
     {
@@ -23,6 +23,7 @@
 #include <string>
 #include <vector>
 
+#include "RegionOccupancy.hh"
 #include "SimEventsException.hh"
 #include "SimStateEventSource.hh"
 
@@ -64,6 +65,10 @@ namespace gazebo
     /// \brief List of all sim event emitters
     private: std::vector<EventSourcePtr> events;
 
+    /// \brief Occupancy of the regions, created by the first event that
+    /// needs it
+    private: RegionOccupancyPtr occupancy;
+
     /// \brief Node for communication.
     private: transport::NodePtr node;
 
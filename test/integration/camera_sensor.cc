@@ -51,6 +51,9 @@ std::string pixelFormat = "";
 // list of timestamped images used by the Timestamp test
 std::vector<gazebo::msgs::ImageStamped> g_imagesStamped;
 
+// list of compressed images used by the Compressed test
+std::vector<gazebo::msgs::CompressedImageStamped> g_compressedImages;
+
 float *depthImg = nullptr;
 
 /////////////////////////////////////////////////
@@ -75,6 +78,13 @@ void OnImage(ConstImageStampedPtr &_msg)
   g_imagesStamped.push_back(imgStamped);
 }
 
+/////////////////////////////////////////////////
+void OnCompressedImage(ConstCompressedImageStampedPtr &_msg)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  g_compressedImages.push_back(*_msg);
+}
+
 /////////////////////////////////////////////////
 void OnNewRGBPointCloud(int* _imageCounter, float* _imageDest,
                   const float *_image,
@@ -394,6 +404,78 @@ TEST_F(CameraSensor, TopicName)
       std::string::npos);
 }
 
+/////////////////////////////////////////////////
+TEST_F(CameraSensor, Compressed)
+{
+  Load("worlds/empty_test.world");
+
+  // Make sure the render engine is available.
+  if (rendering::RenderEngine::Instance()->GetRenderPathType() ==
+      rendering::RenderEngine::NONE)
+  {
+    gzerr << "No rendering engine, unable to run camera test\n";
+    return;
+  }
+
+  std::string modelName = "camera_model";
+  std::string cameraName = "camera_sensor";
+  unsigned int width  = 320;
+  unsigned int height = 240;
+  double updateRate = 10;
+  ignition::math::Pose3d setPose(ignition::math::Vector3d(-5, 0, 5),
+      ignition::math::Quaterniond(0, IGN_DTOR(15), 0));
+  SpawnCamera(modelName, cameraName, setPose.Pos(),
+      setPose.Rot().Euler(), width, height, updateRate);
+  sensors::SensorPtr sensor = sensors::get_sensor(cameraName);
+  sensors::CameraSensorPtr camSensor =
+    std::dynamic_pointer_cast<sensors::CameraSensor>(sensor);
+  ASSERT_TRUE(camSensor != nullptr);
+
+  EXPECT_EQ(camSensor->CompressedTopic(), camSensor->Topic() + "/compressed");
+  EXPECT_EQ(camSensor->CompressionFormat(), "jpeg");
+  EXPECT_EQ(camSensor->CompressionQuality(), 80);
+
+  // Invalid settings are ignored, the quality is clamped
+  camSensor->SetCompression("tiff", 50);
+  EXPECT_EQ(camSensor->CompressionFormat(), "jpeg");
+  camSensor->SetCompression("png", 500);
+  EXPECT_EQ(camSensor->CompressionFormat(), "png");
+  EXPECT_EQ(camSensor->CompressionQuality(), 100);
+  camSensor->SetCompression("jpeg", 50);
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    g_compressedImages.clear();
+  }
+  transport::SubscriberPtr sub = this->node->Subscribe(
+      camSensor->CompressedTopic(), OnCompressedImage);
+
+  int sleep = 0;
+  while (sleep++ < 300)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (!g_compressedImages.empty())
+        break;
+    }
+    common::Time::MSleep(10);
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  ASSERT_FALSE(g_compressedImages.empty());
+  const msgs::CompressedImageStamped &image = g_compressedImages[0];
+  EXPECT_EQ(image.format(), "jpeg");
+  EXPECT_EQ(image.width(), width);
+  EXPECT_EQ(image.height(), height);
+  EXPECT_GT(image.data().size(), 0u);
+  EXPECT_LT(image.data().size(), width * height * 3);
+
+  common::Image decoded;
+  EXPECT_TRUE(decoded.LoadFromBuffer(image.data()));
+  EXPECT_EQ(decoded.GetWidth(), width);
+  EXPECT_EQ(decoded.GetHeight(), height);
+}
+
 /////////////////////////////////////////////////
 TEST_F(CameraSensor, FillMsg)
 {
@@ -1123,6 +1123,54 @@ TEST_F(HeightmapTest, DartCollisionDetectorSelectionOde)
 #endif
 }
 
+/////////////////////////////////////////////////
+TEST_F(HeightmapTest, DartCollisionDetectorSetParam)
+{
+#ifndef HAVE_DART
+  gzdbg << "Not testing DART because it is not installed." << std::endl;
+  return;
+#endif
+
+  Load("worlds/empty.world", true, "dart");
+
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_NE(world, nullptr);
+
+  physics::PhysicsEnginePtr engine = world->Physics();
+  ASSERT_NE(engine, nullptr);
+
+#ifdef HAVE_DART
+  // Collision detectors can be switched at runtime
+  for (const std::string cd : {"dart", "fcl"})
+  {
+    EXPECT_TRUE(engine->SetParam("collision_detector", cd));
+    EXPECT_EQ(cd,
+        boost::any_cast<std::string>(engine->GetParam("collision_detector")));
+  }
+
+  // ODE is disabled and unknown detectors are refused, the current one is
+  // kept.
+  EXPECT_FALSE(engine->SetParam("collision_detector", std::string("ode")));
+  EXPECT_FALSE(engine->SetParam("collision_detector", std::string("foo")));
+  EXPECT_EQ("fcl",
+      boost::any_cast<std::string>(engine->GetParam("collision_detector")));
+
+  // Boxed LCP solvers
+  for (const std::string solver : {"pgs", "dantzig"})
+  {
+    EXPECT_TRUE(engine->SetParam("solver_type", solver));
+    EXPECT_EQ(solver,
+        boost::any_cast<std::string>(engine->GetParam("solver_type")));
+  }
+  EXPECT_FALSE(engine->SetParam("solver_type", std::string("foo")));
+  EXPECT_EQ("dantzig",
+      boost::any_cast<std::string>(engine->GetParam("solver_type")));
+
+  // The simulation keeps running with the new settings
+  world->Step(100);
+#endif
+}
+
 
 /////////////////////////////////////////////////
 TEST_P(HeightmapTest, TerrainCollision)
@@ -1167,6 +1215,51 @@ TEST_P(HeightmapTest, TerrainCollisionAsymmetric)
   TerrainCollisionAsymmetric(GetParam());
 }
 
+/////////////////////////////////////////////////
+// A sphere rolling on a heightmap whose heights are kept in tiles
+TEST_F(HeightmapTest, TiledCollisionOde)
+{
+  Load("worlds/heightmap_test_with_sphere_tiled.world", true, "ode");
+
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_NE(world, nullptr);
+
+  physics::ModelPtr heightmap = GetModel("heightmap");
+  ASSERT_NE(heightmap, nullptr);
+  physics::HeightmapShapePtr shape =
+    boost::dynamic_pointer_cast<physics::HeightmapShape>(
+        heightmap->GetLink("link")->GetCollision("collision")->GetShape());
+  ASSERT_NE(shape, nullptr);
+
+  EXPECT_TRUE(shape->Tiled());
+  EXPECT_EQ(shape->TileSize(), 32u);
+  EXPECT_EQ(shape->VertexCount().X(), 257);
+
+  // Nothing touched the terrain yet
+  EXPECT_EQ(shape->ResidentTileCount(), 0u);
+
+  world->Step(5000);
+
+  // Only the tiles under the path of the sphere were filled
+  EXPECT_GT(shape->ResidentTileCount(), 0u);
+  EXPECT_LE(shape->ResidentTileCount(), 16u);
+
+  physics::ModelPtr sphere = GetModel("test_sphere");
+  ASSERT_NE(sphere, nullptr);
+
+  // The sphere rolled into the valley
+  const double minHeight = shape->GetMinHeight();
+  const double radius = 0.5;
+  ignition::math::Pose3d spherePose = sphere->WorldPose();
+  EXPECT_LE(spherePose.Pos().Z(), (minHeight + radius*1.01));
+  EXPECT_GE(spherePose.Pos().Z(), (minHeight + radius*0.99));
+
+  // Heights of tiles that were dropped are filled again
+  for (int i = 0; i < 257; i += 8)
+    EXPECT_GE(shape->GetHeight(i, i), minHeight);
+  EXPECT_LE(shape->ResidentTileCount(), 16u);
+}
+
 /////////////////////////////////////////////////
 //
 // Disabled: segfaults ocassionally
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <mutex>
+#include <string>
+
+#include <ignition/math/Pose3.hh>
+#include <ignition/transport/Node.hh>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+class PartitionPluginTest : public ServerFixture
+{
+  /// \brief Callback for the merged state sent by the primary.
+  /// \param[in] _msg Merged state.
+  public: void OnClock(const msgs::PartitionStep &_msg)
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->clock = _msg;
+  }
+
+  /// \brief Wait for the merged state of an iteration.
+  /// \param[in] _iteration Iteration.
+  /// \return True if it arrived.
+  public: bool WaitForClock(const uint64_t _iteration)
+  {
+    for (int i = 0; i < 200; ++i)
+    {
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (this->clock.iteration() == _iteration)
+          return true;
+      }
+      common::Time::MSleep(10);
+    }
+    return false;
+  }
+
+  /// \brief Last merged state.
+  public: msgs::PartitionStep clock;
+
+  /// \brief Protects clock.
+  public: std::mutex mutex;
+};
+
+/////////////////////////////////////////////////
+// The server runs the primary partition, the test plays the second one.
+TEST_F(PartitionPluginTest, BoundaryAndHandoff)
+{
+  const std::string prefix = "/partition/partition_plugin_test";
+  ignition::transport::Node node;
+  node.Subscribe(prefix + "/clock", &PartitionPluginTest::OnClock, this);
+  auto statePub = node.Advertise<msgs::PartitionStep>(prefix + "/state");
+
+  this->Load("worlds/partition_plugin.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  physics::ModelPtr boxA = world->ModelByName("box_a");
+  physics::ModelPtr boxB = world->ModelByName("box_b");
+  ASSERT_NE(nullptr, boxA);
+  ASSERT_NE(nullptr, boxB);
+
+  // box_b is in the region of the second partition
+  EXPECT_FALSE(boxA->GetLink("link")->GetKinematic());
+  EXPECT_TRUE(boxB->GetLink("link")->GetKinematic());
+
+  for (int i = 0; i < 50 && !statePub.HasConnections(); ++i)
+    common::Time::MSleep(100);
+  ASSERT_TRUE(statePub.HasConnections());
+
+  // The second partition moves box_b near the boundary
+  msgs::PartitionStep state;
+  state.set_partition(1);
+  state.set_iteration(world->Iterations() + 1);
+  msgs::Set(state.mutable_sim_time(), common::Time::Zero);
+  msgs::PartitionEntity *entity = state.add_entity();
+  entity->set_name("box_b");
+  entity->set_owner(1);
+  msgs::Set(entity->add_link_pose(),
+      ignition::math::Pose3d(1, 0, 0.5, 0, 0, 0));
+  msgs::Set(entity->add_linear_velocity(), ignition::math::Vector3d::Zero);
+  msgs::Set(entity->add_angular_velocity(), ignition::math::Vector3d::Zero);
+  statePub.Publish(state);
+
+  world->Step(1);
+  EXPECT_NEAR(boxB->WorldPose().Pos().X(), 1, 1e-6);
+  EXPECT_TRUE(boxB->GetLink("link")->GetKinematic());
+  ASSERT_TRUE(this->WaitForClock(state.iteration()));
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    EXPECT_EQ(1, this->clock.entity_size());
+  }
+
+  // Then hands it off to the primary
+  state.set_iteration(world->Iterations() + 1);
+  entity->set_owner(0);
+  msgs::Set(entity->mutable_link_pose(0),
+      ignition::math::Pose3d(-1, 0, 0.5, 0, 0, 0));
+  statePub.Publish(state);
+
+  world->Step(1);
+  EXPECT_NEAR(boxB->WorldPose().Pos().X(), -1, 1e-3);
+  EXPECT_FALSE(boxB->GetLink("link")->GetKinematic());
+
+  // box_a crosses over to the second partition
+  boxA->SetWorldPose(ignition::math::Pose3d(5, 0, 0.5, 0, 0, 0));
+  state.set_iteration(world->Iterations() + 1);
+  state.clear_entity();
+  statePub.Publish(state);
+
+  world->Step(1);
+  EXPECT_TRUE(boxA->GetLink("link")->GetKinematic());
+  ASSERT_TRUE(this->WaitForClock(state.iteration()));
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    bool handedOff = false;
+    for (auto const &sent : this->clock.entity())
+      handedOff = handedOff || (sent.name() == "box_a" && sent.owner() == 1);
+    EXPECT_TRUE(handedOff);
+  }
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
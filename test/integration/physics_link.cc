@@ -64,6 +64,11 @@ class PhysicsLinkTest : public ServerFixture,
   /// \param[in] _physicsEngine Type of physics engine to use.
   public: void GetWorldEnergy(const std::string &_physicsEngine);
 
+  /// \brief Test that a fast link with continuous collision detection
+  /// doesn't go through a thin wall.
+  /// \param[in] _physicsEngine Type of physics engine to use.
+  public: void ContinuousCollision(const std::string &_physicsEngine);
+
   /// \brief Test Link::GetWorldInertia* functions.
   /// \param[in] _physicsEngine Physics engine to use.
   public: void GetWorldInertia(const std::string &_physicsEngine);
@@ -820,6 +825,46 @@ void PhysicsLinkTest::SetVelocity(const std::string &_physicsEngine)
   EXPECT_NEAR(rpy.Z(), 0.0, g_tolerance);
 }
 
+/////////////////////////////////////////////////
+void PhysicsLinkTest::ContinuousCollision(const std::string &_physicsEngine)
+{
+  if (_physicsEngine != "ode" && _physicsEngine != "bullet")
+  {
+    gzerr << "Continuous collision detection isn't supported by "
+          << _physicsEngine << std::endl;
+    return;
+  }
+
+  Load("worlds/empty.world", true, _physicsEngine);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+  world->SetGravity(ignition::math::Vector3d::Zero);
+
+  const double dt = world->Physics()->GetMaxStepSize();
+
+  // Wall thinner than the distance travelled by the sphere in one step
+  SpawnBox("wall", ignition::math::Vector3d(0.02, 2, 2),
+      ignition::math::Vector3d(1, 0, 1), ignition::math::Vector3d::Zero,
+      true);
+  SpawnSphere("bullet", ignition::math::Vector3d(0, 0, 1),
+      ignition::math::Vector3d::Zero, ignition::math::Vector3d::Zero, 0.05);
+
+  physics::ModelPtr model = world->ModelByName("bullet");
+  ASSERT_TRUE(model != NULL);
+  physics::LinkPtr link = model->GetLink();
+  ASSERT_TRUE(link != NULL);
+
+  EXPECT_FALSE(link->CCD());
+  link->SetCCD(true);
+  EXPECT_TRUE(link->CCD());
+  EXPECT_NEAR(link->CCDRadius(), 0.05, 1e-3);
+
+  // 0.2 m per step with the default step size
+  link->SetLinearVel(ignition::math::Vector3d(0.2 / dt, 0, 0));
+  world->Step(50);
+  EXPECT_LT(link->WorldPose().Pos().X(), 1.0);
+}
+
 /////////////////////////////////////////////////
 TEST_P(PhysicsLinkTest, AddForce)
 {
@@ -838,6 +883,12 @@ TEST_P(PhysicsLinkTest, GetWorldEnergy)
   GetWorldEnergy(GetParam());
 }
 
+/////////////////////////////////////////////////
+TEST_P(PhysicsLinkTest, ContinuousCollision)
+{
+  ContinuousCollision(GetParam());
+}
+
 /////////////////////////////////////////////////
 TEST_P(PhysicsLinkTest, GetWorldInertia)
 {
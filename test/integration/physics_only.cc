@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include "gazebo/rendering/RenderingIface.hh"
+#include "gazebo/sensors/SensorsIface.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+class PhysicsOnlyTest : public ServerFixture
+{
+};
+
+/////////////////////////////////////////////////
+// With --physics_only, the rendering engine doesn't start, sensors that
+// render are skipped and the other sensors still run.
+TEST_F(PhysicsOnlyTest, SkipRendering)
+{
+  LoadArgs(" -u --physics_only worlds/camera_pose_test.world");
+  EXPECT_FALSE(sensors::rendering_enabled());
+
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  // The model is loaded without its cameras
+  EXPECT_NE(nullptr, world->ModelByName("rotated_box"));
+  EXPECT_EQ(nullptr, sensors::get_sensor("cam1"));
+  EXPECT_EQ(nullptr, sensors::get_sensor("mcam1"));
+  EXPECT_EQ(nullptr, rendering::get_scene());
+
+  SpawnImuSensor("imu_model", "imu_sensor");
+  sensors::SensorPtr imu = sensors::get_sensor("imu_sensor");
+  ASSERT_NE(nullptr, imu);
+
+  world->Step(100);
+  EXPECT_EQ(100u, world->Iterations());
+  imu->Update(true);
+  EXPECT_GT(imu->LastMeasurementTime(), common::Time::Zero);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <mutex>
+#include <vector>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+class SensorServerPluginTest : public ServerFixture
+{
+  /// \brief Callback for pose frames, acknowledges them like a sensor
+  /// server.
+  /// \param[in] _msg Pose frame.
+  public: void OnPoses(ConstPosesStampedPtr &_msg)
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->frames.push_back(*_msg);
+    }
+    msgs::Time ack = _msg->time();
+    this->ackPub->Publish(ack);
+  }
+
+  /// \brief Publisher of acknowledgements.
+  public: transport::PublisherPtr ackPub;
+
+  /// \brief Pose frames received.
+  public: std::vector<msgs::PosesStamped> frames;
+
+  /// \brief Protects frames.
+  public: std::mutex mutex;
+};
+
+/////////////////////////////////////////////////
+// The physics role publishes the links that moved at the update rate.
+TEST_F(SensorServerPluginTest, PoseFrames)
+{
+  this->Load("worlds/sensor_server_plugin.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  transport::NodePtr node(new transport::Node());
+  node->Init();
+  this->ackPub = node->Advertise<msgs::Time>("~/sensor_server/ack");
+  transport::SubscriberPtr sub = node->Subscribe("~/sensor_server/poses",
+      &SensorServerPluginTest::OnPoses, this);
+
+  // Frames at 0.001, 0.101 and 0.201 seconds
+  world->Step(250);
+
+  for (int i = 0; i < 100; ++i)
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      if (this->frames.size() >= 3u)
+        break;
+    }
+    common::Time::MSleep(10);
+  }
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+  ASSERT_EQ(3u, this->frames.size());
+  for (auto const &frame : this->frames)
+  {
+    // The ground plane is static and the box falls
+    ASSERT_EQ(1, frame.pose_size());
+    EXPECT_EQ("box::link", frame.pose(0).name());
+  }
+  EXPECT_NEAR(0.101, msgs::Convert(this->frames[1].time()).Double(), 1e-6);
+  EXPECT_GT(this->frames[0].pose(0).position().z(),
+            this->frames[2].pose(0).position().z());
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -153,6 +153,40 @@ TEST_F(TransportTest, PubSub)
   subs.clear();
 }
 
+/////////////////////////////////////////////////
+TEST_F(TransportTest, PublishIfSubscribed)
+{
+  Load("worlds/empty.world");
+
+  transport::NodePtr node = transport::NodePtr(new transport::Node());
+  node->Init();
+  transport::PublisherPtr pub =
+      node->Advertise<msgs::GzString>("~/test/lazy_publish");
+
+  // Nobody listens, the message is not even built
+  int built = 0;
+  auto build = [&built](msgs::GzString &_msg)
+      {
+        ++built;
+        _msg.set_data("lazy");
+      };
+  EXPECT_FALSE(pub->PublishIfSubscribed<msgs::GzString>(build));
+  EXPECT_EQ(built, 0);
+
+  g_stringMsg = false;
+  transport::SubscriberPtr sub = node->Subscribe("~/test/lazy_publish",
+      &ReceiveStringMsg);
+  EXPECT_TRUE(pub->WaitForConnection(common::Time(5, 0)));
+
+  EXPECT_TRUE(pub->PublishIfSubscribed<msgs::GzString>(build));
+  EXPECT_EQ(built, 1);
+
+  int sleep = 0;
+  while (!g_stringMsg && sleep++ < 300)
+    common::Time::MSleep(10);
+  EXPECT_TRUE(g_stringMsg);
+}
+
 /////////////////////////////////////////////////
 TEST_F(TransportTest, DirectPublish)
 {
@@ -450,6 +484,92 @@ TEST_F(TransportTest, IfaceGetAdvertisedTopics)
   EXPECT_TRUE(topicMap.find("gazebo.msgs.PosesStamped") != topicMap.end());
 }
 
+/////////////////////////////////////////////////
+/// \brief Ask the master for its topic table over a raw connection.
+/// Table updates the master sends in between are skipped.
+msgs::TopicTable SyncTopicTable(transport::ConnectionPtr _conn,
+    const std::string &_epoch, uint64_t _version)
+{
+  msgs::TopicTable request;
+  request.set_epoch(_epoch);
+  request.set_version(_version);
+  _conn->EnqueueMsg(msgs::Package("topic_table_sync", request), true);
+
+  msgs::TopicTable table;
+  msgs::Packet packet;
+  std::string data;
+  do
+  {
+    _conn->Read(data);
+    packet.ParseFromString(data);
+  } while (packet.type() != "topic_table");
+
+  table.ParseFromString(packet.serialized_data());
+  return table;
+}
+
+/////////////////////////////////////////////////
+// Reconnecting clients only get the topic table changes they missed
+TEST_F(TransportTest, TopicTableSync)
+{
+  Load("worlds/empty.world");
+
+  transport::ConnectionPtr conn = transport::connectToMaster();
+  ASSERT_TRUE(conn != NULL);
+
+  // Unknown epoch: the full table
+  msgs::TopicTable full = SyncTopicTable(conn, "", 0);
+  EXPECT_TRUE(full.full());
+  EXPECT_FALSE(full.epoch().empty());
+  EXPECT_GT(full.version(), 0u);
+  EXPECT_GT(full.topic_namespace_size(), 0);
+
+  bool hasWorldStats = false;
+  for (int i = 0; i < full.publisher_size(); ++i)
+  {
+    hasWorldStats = hasWorldStats ||
+      full.publisher(i).topic() == "/gazebo/default/world_stats";
+  }
+  EXPECT_TRUE(hasWorldStats);
+
+  // Up to date: an empty delta
+  msgs::TopicTable same = SyncTopicTable(conn, full.epoch(), full.version());
+  EXPECT_FALSE(same.full());
+  EXPECT_EQ(same.version(), full.version());
+  EXPECT_EQ(same.publisher_size(), 0);
+  EXPECT_EQ(same.removed_size(), 0);
+
+  // One new publisher: a delta with only that publisher
+  transport::NodePtr node(new transport::Node());
+  node->Init();
+  transport::PublisherPtr pub =
+    node->Advertise<msgs::GzString>("~/topic_table_sync");
+  common::Time::MSleep(500);
+
+  msgs::TopicTable delta = SyncTopicTable(conn, full.epoch(), full.version());
+  EXPECT_FALSE(delta.full());
+  EXPECT_GT(delta.version(), full.version());
+  ASSERT_EQ(delta.publisher_size(), 1);
+  EXPECT_EQ(delta.publisher(0).topic(), "/gazebo/default/topic_table_sync");
+  EXPECT_EQ(delta.removed_size(), 0);
+
+  // The publisher goes away again: reported as removed
+  pub.reset();
+  common::Time::MSleep(500);
+
+  delta = SyncTopicTable(conn, full.epoch(), full.version());
+  EXPECT_FALSE(delta.full());
+  EXPECT_EQ(delta.publisher_size(), 0);
+  ASSERT_EQ(delta.removed_size(), 1);
+  EXPECT_EQ(delta.removed(0).topic(), "/gazebo/default/topic_table_sync");
+
+  // A version from another master: the full table
+  msgs::TopicTable other = SyncTopicTable(conn, "other", full.version());
+  EXPECT_TRUE(other.full());
+
+  conn->Shutdown();
+}
+
 /////////////////////////////////////////////////
 // Test clearing buffers
 TEST_F(TransportTest, ClearBuffers)
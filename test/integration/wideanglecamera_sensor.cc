@@ -226,6 +226,65 @@ TEST_F(WideAngleCameraSensor, Projection)
 #endif
 }
 
+/////////////////////////////////////////////////
+TEST_F(WideAngleCameraSensor, DualFisheyeProjection)
+{
+#if not defined(__APPLE__)
+  Load("worlds/usercamera_test.world");
+
+  // Make sure the render engine is available.
+  if (rendering::RenderEngine::Instance()->GetRenderPathType() ==
+      rendering::RenderEngine::NONE)
+  {
+    gzerr << "No rendering engine, unable to run wide angle camera test\n";
+    return;
+  }
+
+  // Spawn a wide angle camera
+  std::string modelName = "camera_model";
+  std::string cameraName = "camera_sensor";
+  unsigned int width  = 320;
+  unsigned int height = 240;
+  double updateRate = 10;
+  ignition::math::Pose3d setPose = ignition::math::Pose3d::Zero;
+  SpawnWideAngleCamera(modelName, cameraName, setPose.Pos(),
+      setPose.Rot().Euler(), width, height, updateRate, 6.0);
+  sensors::SensorPtr sensor = sensors::get_sensor(cameraName);
+  sensors::WideAngleCameraSensorPtr camSensor =
+      std::dynamic_pointer_cast<sensors::WideAngleCameraSensor>(sensor);
+
+  rendering::WideAngleCameraPtr camera =
+      boost::dynamic_pointer_cast<rendering::WideAngleCamera>(
+      camSensor->Camera());
+  ASSERT_NE(camera, nullptr);
+
+  EXPECT_FALSE(camera->DualFisheye());
+  camera->SetDualFisheye(true);
+  EXPECT_TRUE(camera->DualFisheye());
+
+  // point in front of camera is at the center of the left half
+  auto screenPt = camera->Project3d(ignition::math::Vector3d::UnitX);
+  EXPECT_FLOAT_EQ(camera->ViewportWidth() * 0.25, screenPt.X());
+  EXPECT_FLOAT_EQ(camera->ViewportHeight() * 0.5, screenPt.Y());
+  EXPECT_LT(screenPt.Z(), 1.0);
+
+  // point behind camera is at the center of the right half
+  screenPt = camera->Project3d(-ignition::math::Vector3d::UnitX);
+  EXPECT_FLOAT_EQ(camera->ViewportWidth() * 0.75, screenPt.X());
+  EXPECT_FLOAT_EQ(camera->ViewportHeight() * 0.5, screenPt.Y());
+  EXPECT_LT(screenPt.Z(), 1.0);
+
+  // point behind and to the left of camera is on the right of the back lens
+  screenPt = camera->Project3d(ignition::math::Vector3d(-1, 0.5, 0.0));
+  EXPECT_GT(screenPt.X(), camera->ViewportWidth() * 0.75);
+  EXPECT_LT(screenPt.Z(), 1.0);
+
+  camera->SetDualFisheye(false);
+  screenPt = camera->Project3d(ignition::math::Vector3d::UnitX);
+  EXPECT_FLOAT_EQ(camera->ViewportWidth() * 0.5, screenPt.X());
+#endif
+}
+
 /////////////////////////////////////////////////
 TEST_F(WideAngleCameraSensor, TextureFormat)
 {
@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <string>
+
+#include "gazebo/test/ServerFixture.hh"
+#include "gazebo/physics/physics.hh"
+
+using namespace gazebo;
+class WorldCopies : public ServerFixture
+{
+};
+
+/////////////////////////////////////////////////
+// Load several copies of a world in one server, and check that they are
+// stepped independently.
+TEST_F(WorldCopies, Independent)
+{
+  this->LoadArgs("-u --world_copies 3 worlds/shapes.world");
+
+  EXPECT_FALSE(physics::has_world("default"));
+  physics::WorldPtr worlds[3];
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    const std::string name = "default_" + std::to_string(i);
+    ASSERT_TRUE(physics::has_world(name));
+    worlds[i] = physics::get_world(name);
+    ASSERT_NE(nullptr, worlds[i]);
+    EXPECT_EQ(name, worlds[i]->Name());
+    EXPECT_TRUE(worlds[i]->IsPaused());
+  }
+
+  // Only the second copy moves
+  physics::ModelPtr box = worlds[1]->ModelByName("box");
+  ASSERT_NE(nullptr, box);
+  box->SetWorldPose(ignition::math::Pose3d(0, 0, 3, 0, 0, 0));
+
+  worlds[0]->Step(100);
+  worlds[1]->Step(100);
+  EXPECT_EQ(100u, worlds[0]->Iterations());
+  EXPECT_EQ(100u, worlds[1]->Iterations());
+  EXPECT_EQ(0u, worlds[2]->Iterations());
+
+  // The copies that weren't touched end up in the same state
+  worlds[2]->Step(100);
+  for (const auto &name : {"box", "sphere", "cylinder"})
+  {
+    EXPECT_EQ(worlds[0]->ModelByName(name)->WorldPose(),
+              worlds[2]->ModelByName(name)->WorldPose()) << name;
+  }
+  EXPECT_GT(box->WorldPose().Pos().Z(),
+            worlds[0]->ModelByName("box")->WorldPose().Pos().Z() + 1.0);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,219 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_TEST_PERFORMANCE_PERFORMANCEREPORT_HH_
+#define GAZEBO_TEST_PERFORMANCE_PERFORMANCEREPORT_HH_
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/asio/ip/host_name.hpp>
+
+#include "gazebo/gazebo_config.h"
+
+namespace gazebo
+{
+  namespace test
+  {
+    // Common report of the performance targets, so that a dashboard can
+    // track their metrics over time. Each target writes one JSON document:
+    //
+    // {
+    //   "schema": 1,
+    //   "target": "set_world_pose",
+    //   "version": "11.14.0",
+    //   "host": "builder-3",
+    //   "time": "2026-10-15T08:00:00Z",
+    //   "metrics": [
+    //     {"test": "SetWorldPoseTest.Stress", "name": "calls_per_second",
+    //      "value": 2.1e6, "unit": "1/s", "better": "higher",
+    //      "samples": [...]}
+    //   ]
+    // }
+    //
+    // "samples" is optional and holds the raw measurements behind a value,
+    // which lets tools/perf_compare.py estimate the noise of a single run.
+    // The document is written to <target>.json in the directory named by
+    // GAZEBO_PERFORMANCE_REPORT_DIR, or to the standard output if it isn't
+    // set.
+    namespace performance
+    {
+      /// \brief Whether larger or smaller values of a metric are better.
+      enum class Better
+      {
+        /// \brief Smaller is better, e.g. durations.
+        LOWER,
+
+        /// \brief Larger is better, e.g. rates.
+        HIGHER
+      };
+
+      /// \brief A measurement of a test.
+      struct Metric
+      {
+        /// \brief Name of the test, "Suite.Test".
+        std::string test;
+
+        /// \brief Name of the metric, unique within the test.
+        std::string name;
+
+        /// \brief Value of the metric.
+        double value;
+
+        /// \brief Unit of the value, e.g. "s" or "1/s".
+        std::string unit;
+
+        /// \brief Direction of improvement.
+        Better better;
+
+        /// \brief Raw measurements behind the value, can be empty.
+        std::vector<double> samples;
+      };
+
+      /// \brief Metrics recorded so far.
+      /// \return The metrics.
+      inline std::vector<Metric> &Metrics()
+      {
+        static std::vector<Metric> metrics;
+        return metrics;
+      }
+
+      /// \brief Mutex protecting Metrics().
+      /// \return The mutex.
+      inline std::mutex &MetricsMutex()
+      {
+        static std::mutex mutex;
+        return mutex;
+      }
+
+      /// \brief Record a metric of the running test.
+      /// \param[in] _name Name of the metric.
+      /// \param[in] _value Value of the metric.
+      /// \param[in] _unit Unit of the value.
+      /// \param[in] _better Direction of improvement.
+      /// \param[in] _samples Raw measurements behind the value.
+      inline void Record(const std::string &_name, const double _value,
+          const std::string &_unit, const Better _better = Better::LOWER,
+          const std::vector<double> &_samples = {})
+      {
+        const ::testing::TestInfo *info =
+            ::testing::UnitTest::GetInstance()->current_test_info();
+
+        Metric metric;
+        if (info)
+          metric.test = std::string(info->test_case_name()) + "." +
+              info->name();
+        metric.name = _name;
+        metric.value = _value;
+        metric.unit = _unit;
+        metric.better = _better;
+        metric.samples = _samples;
+
+        std::lock_guard<std::mutex> lock(MetricsMutex());
+        Metrics().push_back(metric);
+      }
+
+      /// \brief Write a number, null if it isn't finite.
+      /// \param[in] _out Stream to write to.
+      /// \param[in] _value Number to write.
+      inline void WriteNumber(std::ostream &_out, const double _value)
+      {
+        if (std::isfinite(_value))
+          _out << _value;
+        else
+          _out << "null";
+      }
+
+      /// \brief Write the report of the recorded metrics.
+      /// \param[in] _out Stream to write to.
+      /// \param[in] _target Name of the performance target.
+      inline void WriteJson(std::ostream &_out, const std::string &_target)
+      {
+        char time[32];
+        const std::time_t now = std::time(nullptr);
+        std::strftime(time, sizeof(time), "%Y-%m-%dT%H:%M:%SZ",
+            std::gmtime(&now));
+
+        std::lock_guard<std::mutex> lock(MetricsMutex());
+        _out.precision(9);
+        _out << "{\n  \"schema\": 1,\n"
+             << "  \"target\": \"" << _target << "\",\n"
+             << "  \"version\": \"" << GAZEBO_VERSION_FULL << "\",\n"
+             << "  \"host\": \"" << boost::asio::ip::host_name() << "\",\n"
+             << "  \"time\": \"" << time << "\",\n"
+             << "  \"metrics\": [";
+        for (size_t i = 0; i < Metrics().size(); ++i)
+        {
+          const Metric &metric = Metrics()[i];
+          _out << (i == 0 ? "\n" : ",\n")
+               << "    {\"test\": \"" << metric.test << "\", "
+               << "\"name\": \"" << metric.name << "\", "
+               << "\"value\": ";
+          WriteNumber(_out, metric.value);
+          _out << ", \"unit\": \"" << metric.unit << "\", "
+               << "\"better\": \""
+               << (metric.better == Better::LOWER ? "lower" : "higher")
+               << "\"";
+          if (!metric.samples.empty())
+          {
+            _out << ", \"samples\": [";
+            for (size_t j = 0; j < metric.samples.size(); ++j)
+            {
+              if (j > 0)
+                _out << ", ";
+              WriteNumber(_out, metric.samples[j]);
+            }
+            _out << "]";
+          }
+          _out << "}";
+        }
+        _out << "\n  ]\n}\n";
+      }
+
+      /// \brief Write the report where GAZEBO_PERFORMANCE_REPORT_DIR
+      /// says, call at the end of main.
+      /// \param[in] _target Name of the performance target.
+      inline void WriteReport(const std::string &_target)
+      {
+        const char *dir = std::getenv("GAZEBO_PERFORMANCE_REPORT_DIR");
+        if (!dir || dir[0] == '\0')
+        {
+          WriteJson(std::cout, _target);
+          return;
+        }
+
+        const std::string filename = std::string(dir) + "/" + _target +
+            ".json";
+        std::ofstream file(filename);
+        if (file)
+          WriteJson(file, _target);
+        else
+          std::cerr << "Unable to write performance report " << filename
+                    << "\n";
+      }
+    }
+  }
+}
+#endif
@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <tuple>
+
+#include "gazebo/gazebo_config.h"
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+/// \brief Physics engine, with "bullet_mt" for the multithreaded Bullet
+/// world, and number of boxes.
+typedef std::tuple<const char *, unsigned int> EngineBoxCount;
+
+class BulletMultithreadedTest
+  : public ServerFixture, public testing::WithParamInterface<EngineBoxCount>
+{
+  /// \brief Time the world update of a debris pile.
+  /// \param[in] _engine Physics engine.
+  /// \param[in] _count Number of boxes in the pile.
+  public: void DebrisPile(const std::string &_engine,
+                          const unsigned int _count);
+};
+
+/////////////////////////////////////////////////
+void BulletMultithreadedTest::DebrisPile(const std::string &_engine,
+    const unsigned int _count)
+{
+  const bool multithreaded = _engine == "bullet_mt";
+#ifndef HAVE_BULLET
+  if (_engine != "ode")
+  {
+    gzwarn << "Built without Bullet, skipping\n";
+    return;
+  }
+#endif
+
+  Load("worlds/empty.world", true, multithreaded ? "bullet" : _engine);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  physics::PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != NULL);
+  if (multithreaded && !physics->SetParam("multithreaded", true))
+  {
+    gzwarn << "Multithreaded Bullet world not available, skipping\n";
+    return;
+  }
+
+  // Same pile as the ODE parallel quickstep test, so that the timings can
+  // be compared.
+  const unsigned int side = static_cast<unsigned int>(
+      std::ceil(std::sqrt(_count / 4.0)));
+  for (unsigned int i = 0; i < _count; ++i)
+  {
+    const unsigned int layer = i / (side * side);
+    const unsigned int cell = i % (side * side);
+    std::ostringstream sdfStr;
+    sdfStr << "<sdf version='" << SDF_VERSION << "'>"
+      << "<model name='box_" << i << "'>"
+      << "  <pose>" << 1.01 * (cell % side) + 0.5 * (layer % 2) << " "
+      << 1.01 * (cell / side) << " " << 0.5 + 1.01 * layer
+      << " 0 0 0</pose>"
+      << "  <link name='link'>"
+      << "    <collision name='collision'>"
+      << "      <geometry><box><size>1 1 1</size></box></geometry>"
+      << "    </collision>"
+      << "  </link>"
+      << "</model>"
+      << "</sdf>";
+    world->InsertModelString(sdfStr.str());
+  }
+
+  // Models are inserted on the next update
+  int sleep = 0;
+  while (world->ModelCount() < _count + 1 && sleep++ < 100)
+  {
+    world->Step(1);
+    common::Time::MSleep(10);
+  }
+  ASSERT_EQ(world->ModelCount(), _count + 1);
+
+  // Let the pile settle, so that the contacts are in place
+  world->Step(100);
+
+  const unsigned int steps = 500;
+  common::Time startTime = common::Time::GetWallTime();
+  world->Step(steps);
+  common::Time elapsed = common::Time::GetWallTime() - startTime;
+
+  gzdbg << "boxes[" << _count << "] engine[" << _engine << "] "
+        << "time per step[" << elapsed.Double() / steps * 1e3 << " ms]\n";
+
+  // Nothing should have sunk into the ground
+  for (unsigned int i = 0; i < _count; ++i)
+  {
+    physics::ModelPtr box = world->ModelByName("box_" + std::to_string(i));
+    ASSERT_TRUE(box != NULL);
+    EXPECT_GT(box->WorldPose().Pos().Z(), 0.4);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_P(BulletMultithreadedTest, DebrisPile)
+{
+  DebrisPile(std::get<0>(GetParam()), std::get<1>(GetParam()));
+}
+
+INSTANTIATE_TEST_CASE_P(EnginesBoxCounts, BulletMultithreadedTest,
+    ::testing::Combine(::testing::Values("ode", "bullet", "bullet_mt"),
+                       ::testing::Values(64u, 256u, 1024u)));
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,578 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+// Contact heavy scenes, stepped with every physics engine that gazebo was
+// built with:
+//
+//   box_pile: 512 boxes dropped in a heap
+//   granular: 1000 small spheres poured into a box
+//   bin_picking: mesh parts dropped into a bin, the parts and the bin are
+//     all triangle meshes so every contact is mesh on mesh
+//   tracked_rubble: the tracked vehicle of tracked_vehicle_simple.world
+//     driving over rubble (ODE only, like the tracked vehicle plugin)
+//
+// For each scene and engine the report gives the contacts per step, the
+// solver iterations per step, the wall time of collision detection and of
+// the solver per step, and the real time factor. These are the reference
+// numbers for changes to the narrow phase and to the solvers.
+//
+// Collision time is measured from Events::worldUpdateBegin to
+// Events::beforePhysicsUpdate, which also covers Model::Update, and solve
+// time from there to Events::worldUpdateEnd, which also covers the pose
+// propagation after the solver. Solver iterations are the ones used by
+// ODE's quickstep, the configured ones for the other engines that have
+// them, and null otherwise.
+//
+// The scenes are generated with a fixed seed. Setting
+// GAZEBO_BENCHMARK_WORLDS to a directory writes them there as world files
+// that gzserver opens. The report is written as JSON to the file named by
+// the GAZEBO_BENCHMARK_OUTPUT environment variable, or to the standard
+// output if it isn't set.
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/any.hpp>
+#include <boost/filesystem.hpp>
+#include <ignition/math/Rand.hh>
+
+#include "gazebo/gazebo_config.h"
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+#include "gazebo/test/helper_physics_generator.hh"
+#include "test_config.h"
+
+using namespace gazebo;
+
+/// \brief Measurements of one scene with one engine.
+struct ContactSample
+{
+  /// \brief Name of the scene.
+  std::string scene;
+
+  /// \brief Name of the physics engine.
+  std::string engine;
+
+  /// \brief Number of timed steps.
+  unsigned int steps;
+
+  /// \brief Average number of contacts per step.
+  double contactsPerStep;
+
+  /// \brief Average solver iterations per step, negative if unknown.
+  double solverIterations;
+
+  /// \brief True if solverIterations are the iterations used, false if
+  /// they are the configured ones.
+  bool iterationsUsed;
+
+  /// \brief Wall time of collision detection per step, in milliseconds.
+  double collisionMs;
+
+  /// \brief Wall time of the solver per step, in milliseconds.
+  double solveMs;
+
+  /// \brief Simulated time over wall time.
+  double rtf;
+};
+
+/// \brief Samples of all the tests, written out by main.
+static std::vector<ContactSample> g_samples;
+
+/// \brief Protects g_samples.
+static std::mutex g_samplesMutex;
+
+/// \brief Get a numeric physics engine parameter.
+/// \param[in] _physics Physics engine.
+/// \param[in] _key Name of the parameter.
+/// \param[out] _value Value of the parameter.
+/// \return False if the engine doesn't have it.
+static bool NumericParam(physics::PhysicsEnginePtr _physics,
+    const std::string &_key, double &_value)
+{
+  boost::any value;
+  if (!_physics->GetParam(_key, value))
+    return false;
+
+  if (value.type() == typeid(int))
+    _value = boost::any_cast<int>(value);
+  else if (value.type() == typeid(unsigned int))
+    _value = boost::any_cast<unsigned int>(value);
+  else if (value.type() == typeid(double))
+    _value = boost::any_cast<double>(value);
+  else
+    return false;
+  return true;
+}
+
+/// \brief SDF of a static box.
+/// \param[in] _name Name of the model.
+/// \param[in] _pos Position of the box.
+/// \param[in] _size Size of the box.
+/// \return SDF string.
+static std::string WallSdf(const std::string &_name,
+    const ignition::math::Vector3d &_pos,
+    const ignition::math::Vector3d &_size)
+{
+  std::ostringstream sdfStr;
+  sdfStr << "<model name='" << _name << "'>"
+    << "  <static>true</static>"
+    << "  <pose>" << _pos << " 0 0 0</pose>"
+    << "  <link name='link'>"
+    << "    <collision name='collision'>"
+    << "      <geometry><box><size>" << _size << "</size></box></geometry>"
+    << "    </collision>"
+    << "  </link>"
+    << "</model>";
+  return sdfStr.str();
+}
+
+/// \brief SDF of a dynamic body.
+/// \param[in] _name Name of the model.
+/// \param[in] _pose Pose of the body.
+/// \param[in] _mass Mass of the body.
+/// \param[in] _geometry SDF of the geometry.
+/// \param[in] _static True for a static body.
+/// \return SDF string.
+static std::string BodySdf(const std::string &_name,
+    const ignition::math::Pose3d &_pose, const double _mass,
+    const std::string &_geometry, const bool _static = false)
+{
+  std::ostringstream sdfStr;
+  sdfStr << "<model name='" << _name << "'>"
+    << "  <static>" << (_static ? "true" : "false") << "</static>"
+    << "  <pose>" << _pose << "</pose>"
+    << "  <link name='link'>"
+    << "    <inertial><mass>" << _mass << "</mass>"
+    << "<inertia><ixx>" << 0.01 * _mass << "</ixx><iyy>" << 0.01 * _mass
+    << "</iyy><izz>" << 0.01 * _mass << "</izz></inertia></inertial>"
+    << "    <collision name='collision'>"
+    << "      <geometry>" << _geometry << "</geometry>"
+    << "    </collision>"
+    << "  </link>"
+    << "</model>";
+  return sdfStr.str();
+}
+
+/// \brief Get a random orientation.
+/// \return Orientation.
+static ignition::math::Quaterniond RandomRot()
+{
+  return ignition::math::Quaterniond(
+      ignition::math::Rand::DblUniform(0, IGN_PI),
+      ignition::math::Rand::DblUniform(0, IGN_PI),
+      ignition::math::Rand::DblUniform(0, IGN_PI));
+}
+
+/// \brief Wrap models in a world with a ground plane.
+/// \param[in] _models SDF of the models.
+/// \return SDF string.
+static std::string WorldSdf(const std::string &_models)
+{
+  std::ostringstream sdfStr;
+  sdfStr << "<?xml version='1.0'?>"
+    << "<sdf version='" << SDF_VERSION << "'>"
+    << "<world name='default'>"
+    << "  <include><uri>model://ground_plane</uri></include>"
+    << _models
+    << "</world></sdf>";
+  return sdfStr.str();
+}
+
+/// \brief 512 boxes of random sizes above a small area, they fall in a
+/// heap.
+/// \return World SDF.
+static std::string BoxPileSdf()
+{
+  std::ostringstream models;
+  for (int i = 0; i < 512; ++i)
+  {
+    const double size = ignition::math::Rand::DblUniform(0.1, 0.3);
+    std::ostringstream name, geometry;
+    name << "box_" << i;
+    geometry << "<box><size>" << size << " " << size << " " << size
+             << "</size></box>";
+    models << BodySdf(name.str(), ignition::math::Pose3d(
+        ignition::math::Vector3d(0.35 * (i % 8) - 1.2,
+          0.35 * ((i / 8) % 8) - 1.2, 0.3 + 0.35 * (i / 64)),
+        RandomRot()), 1.0, geometry.str());
+  }
+  return WorldSdf(models.str());
+}
+
+/// \brief 1000 spheres of 2 to 3 cm of radius poured into a 1 m box.
+/// \return World SDF.
+static std::string GranularSdf()
+{
+  std::ostringstream models;
+  models << WallSdf("wall_px", {0.55, 0, 0.25}, {0.1, 1.2, 0.5})
+         << WallSdf("wall_nx", {-0.55, 0, 0.25}, {0.1, 1.2, 0.5})
+         << WallSdf("wall_py", {0, 0.55, 0.25}, {1.0, 0.1, 0.5})
+         << WallSdf("wall_ny", {0, -0.55, 0.25}, {1.0, 0.1, 0.5});
+  for (int i = 0; i < 1000; ++i)
+  {
+    std::ostringstream name, geometry;
+    name << "grain_" << i;
+    geometry << "<sphere><radius>"
+             << ignition::math::Rand::DblUniform(0.02, 0.03)
+             << "</radius></sphere>";
+    models << BodySdf(name.str(), ignition::math::Pose3d(
+        0.07 * (i % 10) - 0.32, 0.07 * ((i / 10) % 10) - 0.32,
+        0.1 + 0.07 * (i / 100), 0, 0, 0), 0.05, geometry.str());
+  }
+  return WorldSdf(models.str());
+}
+
+/// \brief Mesh parts dropped into a bin made of meshes.
+/// \return World SDF.
+static std::string BinPickingSdf()
+{
+  // The cube of box.dae spans 2 m
+  const std::string meshUri = std::string("file://") + TEST_PATH +
+      "/data/box.dae";
+  auto mesh = [&meshUri](const ignition::math::Vector3d &_size)
+  {
+    std::ostringstream geometry;
+    geometry << "<mesh><uri>" << meshUri << "</uri><scale>"
+             << _size / 2.0 << "</scale></mesh>";
+    return geometry.str();
+  };
+
+  std::ostringstream models;
+  models << BodySdf("bin_bottom", {0, 0, 0.025, 0, 0, 0}, 1,
+              mesh({0.8, 0.6, 0.05}), true)
+         << BodySdf("bin_px", {0.425, 0, 0.2, 0, 0, 0}, 1,
+              mesh({0.05, 0.6, 0.4}), true)
+         << BodySdf("bin_nx", {-0.425, 0, 0.2, 0, 0, 0}, 1,
+              mesh({0.05, 0.6, 0.4}), true)
+         << BodySdf("bin_py", {0, 0.325, 0.2, 0, 0, 0}, 1,
+              mesh({0.9, 0.05, 0.4}), true)
+         << BodySdf("bin_ny", {0, -0.325, 0.2, 0, 0, 0}, 1,
+              mesh({0.9, 0.05, 0.4}), true);
+  for (int i = 0; i < 60; ++i)
+  {
+    std::ostringstream name;
+    name << "part_" << i;
+    const ignition::math::Vector3d size(
+        ignition::math::Rand::DblUniform(0.05, 0.15),
+        ignition::math::Rand::DblUniform(0.05, 0.1),
+        ignition::math::Rand::DblUniform(0.02, 0.05));
+    models << BodySdf(name.str(), ignition::math::Pose3d(
+        ignition::math::Vector3d(0.15 * (i % 4) - 0.225,
+          0.15 * ((i / 4) % 3) - 0.15, 0.2 + 0.1 * (i / 12)),
+        RandomRot()), 0.2, mesh(size));
+  }
+  return WorldSdf(models.str());
+}
+
+/// \brief SDF of rubble in front of the tracked vehicle.
+/// \return SDF strings of the models.
+static std::vector<std::string> RubbleSdfs()
+{
+  std::vector<std::string> sdfs;
+  for (int i = 0; i < 80; ++i)
+  {
+    std::ostringstream name, geometry;
+    name << "rubble_" << i;
+    if (i % 2)
+    {
+      geometry << "<cylinder><radius>"
+               << ignition::math::Rand::DblUniform(0.03, 0.08)
+               << "</radius><length>"
+               << ignition::math::Rand::DblUniform(0.1, 0.4)
+               << "</length></cylinder>";
+    }
+    else
+    {
+      geometry << "<box><size>"
+               << ignition::math::Rand::DblUniform(0.05, 0.2) << " "
+               << ignition::math::Rand::DblUniform(0.05, 0.2) << " "
+               << ignition::math::Rand::DblUniform(0.03, 0.1)
+               << "</size></box>";
+    }
+    sdfs.push_back("<sdf version='" + std::string(SDF_VERSION) + "'>" +
+        BodySdf(name.str(), ignition::math::Pose3d(
+          ignition::math::Vector3d(
+            ignition::math::Rand::DblUniform(0.8, 3.0),
+            ignition::math::Rand::DblUniform(-0.6, 0.6), 0.15),
+          RandomRot()), ignition::math::Rand::DblUniform(0.2, 2.0),
+          geometry.str()) + "</sdf>");
+  }
+  return sdfs;
+}
+
+class ContactBenchmarkTest : public ServerFixture,
+                             public testing::WithParamInterface<const char*>
+{
+  /// \brief Load a generated world.
+  /// \param[in] _scene Name of the scene.
+  /// \param[in] _sdf SDF of the world.
+  /// \param[in] _physicsEngine Physics engine to use.
+  protected: void LoadScene(const std::string &_scene,
+                            const std::string &_sdf,
+                            const std::string &_physicsEngine);
+
+  /// \brief Let a scene settle, then time the steps and record a sample.
+  /// \param[in] _scene Name of the scene.
+  /// \param[in] _world World to step.
+  /// \param[in] _steps Number of timed steps.
+  protected: void Measure(const std::string &_scene,
+                          physics::WorldPtr _world,
+                          const unsigned int _steps);
+};
+
+/////////////////////////////////////////////////
+void ContactBenchmarkTest::LoadScene(const std::string &_scene,
+    const std::string &_sdf, const std::string &_physicsEngine)
+{
+  const char *dir = std::getenv("GAZEBO_BENCHMARK_WORLDS");
+  if (dir && dir[0] != '\0')
+  {
+    std::ofstream out(std::string(dir) + "/contact_" + _scene + ".world");
+    out << _sdf;
+  }
+
+  boost::filesystem::path worldFile =
+      boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path("gz_contact_%%%%%%%%.world");
+  {
+    std::ofstream out(worldFile.string());
+    ASSERT_TRUE(out.good());
+    out << _sdf;
+  }
+  Load(worldFile.string(), true, _physicsEngine);
+  boost::filesystem::remove(worldFile);
+}
+
+/////////////////////////////////////////////////
+void ContactBenchmarkTest::Measure(const std::string &_scene,
+    physics::WorldPtr _world, const unsigned int _steps)
+{
+  // Keep the contacts even though nobody subscribes, so that the contact
+  // count reflects the scene
+  physics::PhysicsEnginePtr physics = _world->Physics();
+  physics::ContactManager *contacts = physics->GetContactManager();
+  contacts->SetNeverDropContacts(true);
+
+  // Let the bodies fall and touch before timing
+  _world->Step(200);
+
+  // The callbacks run on the world thread while Step blocks this one
+  std::chrono::steady_clock::time_point begin, collided;
+  std::chrono::steady_clock::duration collision{0}, solve{0};
+  std::vector<event::ConnectionPtr> connections;
+  connections.push_back(event::Events::ConnectWorldUpdateBegin(
+      [&begin](const common::UpdateInfo &)
+      {
+        begin = std::chrono::steady_clock::now();
+      }));
+  connections.push_back(event::Events::ConnectBeforePhysicsUpdate(
+      [&](const common::UpdateInfo &)
+      {
+        collided = std::chrono::steady_clock::now();
+        collision += collided - begin;
+      }));
+  connections.push_back(event::Events::ConnectWorldUpdateEnd(
+      [&]()
+      {
+        solve += std::chrono::steady_clock::now() - collided;
+      }));
+
+  double configuredIters = -1;
+  const bool usedIters = physics->GetType() == "ode";
+  if (!usedIters)
+    NumericParam(physics, "iters", configuredIters);
+
+  uint64_t contactCount = 0;
+  double iterations = 0;
+  const common::Time simStart = _world->SimTime();
+  const auto wallStart = std::chrono::steady_clock::now();
+  for (unsigned int i = 0; i < _steps; ++i)
+  {
+    _world->Step(1);
+    contactCount += contacts->GetContactCount();
+
+    double used = 0;
+    if (usedIters && NumericParam(physics, "iters_used", used))
+      iterations += used;
+  }
+  const auto wallEnd = std::chrono::steady_clock::now();
+  connections.clear();
+  contacts->SetNeverDropContacts(false);
+
+  const double simElapsed = (_world->SimTime() - simStart).Double();
+  const double wallElapsed = std::chrono::duration<double>(
+      wallEnd - wallStart).count();
+
+  ContactSample sample;
+  sample.scene = _scene;
+  sample.engine = physics->GetType();
+  sample.steps = _steps;
+  sample.contactsPerStep = static_cast<double>(contactCount) / _steps;
+  sample.solverIterations = usedIters ? iterations / _steps : configuredIters;
+  sample.iterationsUsed = usedIters;
+  sample.collisionMs = std::chrono::duration<double, std::milli>(
+      collision).count() / _steps;
+  sample.solveMs = std::chrono::duration<double, std::milli>(
+      solve).count() / _steps;
+  sample.rtf = wallElapsed > 0 ? simElapsed / wallElapsed : 0.0;
+
+  gzdbg << "scene[" << sample.scene << "] engine[" << sample.engine << "] "
+        << "contacts per step[" << sample.contactsPerStep << "] "
+        << "solver iterations[" << sample.solverIterations << "] "
+        << "collision ms[" << sample.collisionMs << "] "
+        << "solve ms[" << sample.solveMs << "] "
+        << "rtf[" << sample.rtf << "]\n";
+
+  std::lock_guard<std::mutex> lock(g_samplesMutex);
+  g_samples.push_back(sample);
+}
+
+/////////////////////////////////////////////////
+TEST_P(ContactBenchmarkTest, BoxPile)
+{
+  ignition::math::Rand::Seed(7);
+  LoadScene("box_pile", BoxPileSdf(), GetParam());
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+  Measure("box_pile", world, 500);
+}
+
+/////////////////////////////////////////////////
+TEST_P(ContactBenchmarkTest, Granular)
+{
+  ignition::math::Rand::Seed(7);
+  LoadScene("granular", GranularSdf(), GetParam());
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+  Measure("granular", world, 500);
+}
+
+/////////////////////////////////////////////////
+TEST_P(ContactBenchmarkTest, BinPicking)
+{
+  ignition::math::Rand::Seed(7);
+  LoadScene("bin_picking", BinPickingSdf(), GetParam());
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+  Measure("bin_picking", world, 500);
+}
+
+/////////////////////////////////////////////////
+TEST_P(ContactBenchmarkTest, TrackedRubble)
+{
+  // The tracked vehicle plugin relies on ODE specific contact handling
+  const std::string physicsEngine = GetParam();
+  if (physicsEngine != "ode")
+  {
+    gzdbg << "Tracked vehicles only work with ODE, skipping "
+          << physicsEngine << "\n";
+    return;
+  }
+
+  Load("worlds/tracked_vehicle_simple.world", true, physicsEngine);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  ignition::math::Rand::Seed(7);
+  const std::vector<std::string> sdfs = RubbleSdfs();
+  const unsigned int count = world->ModelCount() + sdfs.size();
+  for (auto const &sdfStr : sdfs)
+    world->InsertModelString(sdfStr);
+
+  // Models are inserted on the next update
+  int sleep = 0;
+  while (world->ModelCount() < count && sleep++ < 300)
+  {
+    world->Step(1);
+    common::Time::MSleep(10);
+  }
+  ASSERT_EQ(world->ModelCount(), count);
+
+  // Drive over the rubble
+  transport::PublisherPtr cmdPub =
+      this->node->Advertise<msgs::Twist>("~/simple_tracked/cmd_vel_twist");
+  msgs::Twist cmd;
+  msgs::Set(cmd.mutable_linear(), ignition::math::Vector3d(1, 0, 0));
+  msgs::Set(cmd.mutable_angular(), ignition::math::Vector3d::Zero);
+  cmdPub->WaitForConnection();
+  cmdPub->Publish(cmd);
+
+  Measure("tracked_rubble", world, 1000);
+}
+
+INSTANTIATE_TEST_CASE_P(PhysicsEngines, ContactBenchmarkTest,
+                        PHYSICS_ENGINE_VALUES);
+
+/// \brief Write the samples as a JSON document.
+/// \param[in] _out Stream to write to.
+static void WriteJson(std::ostream &_out)
+{
+  std::lock_guard<std::mutex> lock(g_samplesMutex);
+  _out << "{\n  \"version\": \"" << GAZEBO_VERSION_FULL << "\",\n"
+       << "  \"samples\": [";
+  for (size_t i = 0; i < g_samples.size(); ++i)
+  {
+    const ContactSample &sample = g_samples[i];
+    _out << (i == 0 ? "\n" : ",\n")
+         << "    {\"scene\": \"" << sample.scene << "\", "
+         << "\"engine\": \"" << sample.engine << "\", "
+         << "\"steps\": " << sample.steps << ", "
+         << "\"contacts_per_step\": " << sample.contactsPerStep << ", "
+         << "\"solver_iterations\": ";
+    if (sample.solverIterations < 0)
+      _out << "null";
+    else
+      _out << sample.solverIterations;
+    _out << ", \"solver_iterations_used\": "
+         << (sample.iterationsUsed ? "true" : "false") << ", "
+         << "\"collision_ms_per_step\": " << sample.collisionMs << ", "
+         << "\"solve_ms_per_step\": " << sample.solveMs << ", "
+         << "\"rtf\": " << sample.rtf << "}";
+  }
+  _out << "\n  ]\n}\n";
+}
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  const int result = RUN_ALL_TESTS();
+
+  const char *output = std::getenv("GAZEBO_BENCHMARK_OUTPUT");
+  if (output && output[0] != '\0')
+  {
+    std::ofstream file(output);
+    if (file)
+      WriteJson(file);
+    else
+      std::cerr << "Unable to write benchmark results to " << output << "\n";
+  }
+  else
+  {
+    WriteJson(std::cout);
+  }
+
+  return result;
+}
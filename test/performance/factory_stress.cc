@@ -14,7 +14,11 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <vector>
+
 #include "gazebo/test/ServerFixture.hh"
+#include "PerformanceReport.hh"
 
 using namespace gazebo;
 class FactoryStressTest : public ServerFixture
@@ -30,17 +34,52 @@ void OnWorldStats(ConstWorldStatisticsPtr &/*_msg*/)
 TEST_F(FactoryStressTest, Bookshelf)
 {
   Load("worlds/empty.world");
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
 
   gazebo::transport::SubscriberPtr sub =
     this->node->Subscribe("~/world_stats", &OnWorldStats);
 
+  double resident, share;
+  this->GetMemInfo(resident, share);
+  const double startResident = resident;
+
+  // Time until the model appears in, and disappears from, the world
+  std::vector<double> spawnTimes;
+  std::vector<double> removeTimes;
   for (int i = 0; i < 100; ++i)
   {
+    common::Time start = common::Time::GetWallTime();
     SpawnModel("model://bookshelf");
-    gazebo::common::Time::MSleep(500);
+    for (int j = 0; j < 500 && !world->ModelByName("bookshelf"); ++j)
+      gazebo::common::Time::MSleep(1);
+    common::Time elapsed = common::Time::GetWallTime() - start;
+    spawnTimes.push_back(elapsed.Double());
+    gazebo::common::Time::MSleep(static_cast<unsigned int>(
+        std::max(0.0, 500 - elapsed.Double() * 1e3)));
+
+    start = common::Time::GetWallTime();
     RemoveModel("bookshelf");
+    for (int j = 0; j < 500 && world->ModelByName("bookshelf"); ++j)
+      gazebo::common::Time::MSleep(1);
+    removeTimes.push_back((common::Time::GetWallTime() - start).Double());
   }
 
+  this->GetMemInfo(resident, share);
+
+  auto median = [](std::vector<double> _values)
+  {
+    std::nth_element(_values.begin(), _values.begin() + _values.size() / 2,
+        _values.end());
+    return _values[_values.size() / 2];
+  };
+  test::performance::Record("spawn_time", median(spawnTimes), "s",
+      test::performance::Better::LOWER, spawnTimes);
+  test::performance::Record("remove_time", median(removeTimes), "s",
+      test::performance::Better::LOWER, removeTimes);
+  test::performance::Record("resident_growth", resident - startResident,
+      "KiB");
+
   sub.reset();
 }
 
@@ -48,5 +87,7 @@ TEST_F(FactoryStressTest, Bookshelf)
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
-  return RUN_ALL_TESTS();
+  const int result = RUN_ALL_TESTS();
+  test::performance::WriteReport("factory_stress");
+  return result;
 }
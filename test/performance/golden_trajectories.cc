@@ -0,0 +1,333 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+// Determinism and performance regression harness. Canonical worlds are run
+// with a fixed --seed for a fixed number of iterations while the poses of
+// their models are sampled, and the step time is measured. Each world is
+// run twice in the same process, and the two trajectories must match.
+// Both are then compared against a golden trajectory:
+//
+//   - a pose further than the tolerance from its golden pose fails the test
+//     (GAZEBO_GOLDEN_POS_TOL meters and GAZEBO_GOLDEN_ROT_TOL radians,
+//     1e-6 by default);
+//   - a step time more than GAZEBO_GOLDEN_TIME_TOL (0.25 by default) slower
+//     than the golden one fails the test, only if the golden trajectory was
+//     recorded on the same host since timings are not comparable across
+//     machines.
+//
+// Golden trajectories are read from test/data/golden_trajectories, or from
+// the directory named by GAZEBO_GOLDEN_PATH. Run with GAZEBO_GOLDEN_UPDATE=1
+// to record them; worlds without a golden trajectory are only checked for
+// run to run determinism.
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <ignition/math/Rand.hh>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+#include "test_config.h"
+
+using namespace gazebo;
+
+/// \brief Seed of the random number generator.
+static const unsigned int kSeed = 7;
+
+/// \brief Number of iterations of each run.
+static const unsigned int kIterations = 2000;
+
+/// \brief Poses are sampled every this many iterations.
+static const unsigned int kSampleEvery = 100;
+
+/// \brief Trajectories of the models of a world and the time it took.
+struct Trajectory
+{
+  /// \brief Host the trajectory was recorded on.
+  std::string host;
+
+  /// \brief Wall time per step in nanoseconds.
+  double nsPerStep = 0;
+
+  /// \brief Sampled poses, indexed by iteration and scoped model name.
+  std::map<unsigned int, std::map<std::string, ignition::math::Pose3d>>
+      poses;
+};
+
+/// \brief Get the name of this host.
+/// \return The host name.
+static std::string HostName()
+{
+  char name[256] = "";
+  gethostname(name, sizeof(name) - 1);
+  return name;
+}
+
+/// \brief Get a tolerance from the environment.
+/// \param[in] _name Name of the environment variable.
+/// \param[in] _default Value if the variable is not set.
+/// \return The tolerance.
+static double Tolerance(const char *_name, const double _default)
+{
+  const char *value = std::getenv(_name);
+  return value && value[0] != '\0' ? std::atof(value) : _default;
+}
+
+/// \brief Get the golden trajectory file of a world.
+/// \param[in] _world Path of the world, relative to the source tree.
+/// \return Path of the golden file.
+static boost::filesystem::path GoldenFile(const std::string &_world)
+{
+  const char *dir = std::getenv("GAZEBO_GOLDEN_PATH");
+  boost::filesystem::path path = dir && dir[0] != '\0' ?
+      boost::filesystem::path(dir) :
+      boost::filesystem::path(TEST_PATH) / "data" / "golden_trajectories";
+
+  std::string name = boost::filesystem::path(_world).stem().string();
+  return path / (name + ".txt");
+}
+
+/// \brief Write a trajectory.
+/// \param[in] _trajectory The trajectory.
+/// \param[in] _file File to write.
+/// \return True on success.
+static bool WriteTrajectory(const Trajectory &_trajectory,
+    const boost::filesystem::path &_file)
+{
+  boost::system::error_code ec;
+  boost::filesystem::create_directories(_file.parent_path(), ec);
+
+  std::ofstream out(_file.string());
+  if (!out)
+    return false;
+
+  out.precision(17);
+  out << "host " << _trajectory.host << "\n"
+      << "ns_per_step " << _trajectory.nsPerStep << "\n";
+  for (auto const &sample : _trajectory.poses)
+  {
+    for (auto const &pose : sample.second)
+    {
+      out << "pose " << sample.first << " " << pose.first << " "
+          << pose.second << "\n";
+    }
+  }
+  return out.good();
+}
+
+/// \brief Read a trajectory.
+/// \param[in] _file File to read.
+/// \param[out] _trajectory The trajectory.
+/// \return True on success.
+static bool ReadTrajectory(const boost::filesystem::path &_file,
+    Trajectory &_trajectory)
+{
+  std::ifstream in(_file.string());
+  if (!in)
+    return false;
+
+  std::string line;
+  while (std::getline(in, line))
+  {
+    std::istringstream stream(line);
+    std::string key;
+    stream >> key;
+    if (key == "host")
+    {
+      stream >> _trajectory.host;
+    }
+    else if (key == "ns_per_step")
+    {
+      stream >> _trajectory.nsPerStep;
+    }
+    else if (key == "pose")
+    {
+      unsigned int iteration;
+      std::string name;
+      ignition::math::Pose3d pose;
+      stream >> iteration >> name >> pose;
+      _trajectory.poses[iteration][name] = pose;
+    }
+  }
+  return true;
+}
+
+/// \brief Compare two trajectories.
+/// \param[in] _expected Reference trajectory.
+/// \param[in] _actual Trajectory to check.
+/// \param[in] _what Description of the comparison, for the messages.
+static void ExpectSameTrajectory(const Trajectory &_expected,
+    const Trajectory &_actual, const std::string &_what)
+{
+  const double posTol = Tolerance("GAZEBO_GOLDEN_POS_TOL", 1e-6);
+  const double rotTol = Tolerance("GAZEBO_GOLDEN_ROT_TOL", 1e-6);
+
+  ASSERT_EQ(_expected.poses.size(), _actual.poses.size()) << _what;
+  for (auto const &sample : _expected.poses)
+  {
+    auto actualSample = _actual.poses.find(sample.first);
+    ASSERT_TRUE(actualSample != _actual.poses.end())
+        << _what << ": no sample at iteration " << sample.first;
+    ASSERT_EQ(sample.second.size(), actualSample->second.size()) << _what;
+
+    for (auto const &pose : sample.second)
+    {
+      auto actual = actualSample->second.find(pose.first);
+      ASSERT_TRUE(actual != actualSample->second.end())
+          << _what << ": no model " << pose.first;
+
+      const double posError =
+          (actual->second.Pos() - pose.second.Pos()).Length();
+      const double rotError = std::abs(
+          (pose.second.Rot().Inverse() * actual->second.Rot()).Euler()
+          .Length());
+
+      // Report the first drift only, later ones follow from it
+      if (posError > posTol || rotError > rotTol)
+      {
+        FAIL() << _what << ": " << pose.first << " drifted at iteration "
+               << sample.first << ", position error " << posError
+               << " m, rotation error " << rotError << " rad\n"
+               << "  expected " << pose.second << "\n"
+               << "  actual   " << actual->second;
+      }
+    }
+  }
+}
+
+class GoldenTrajectoryTest : public ServerFixture,
+                             public testing::WithParamInterface<const char*>
+{
+  /// \brief Run the world from its initial state and record a trajectory.
+  /// \param[in] _world The world.
+  /// \return The trajectory.
+  protected: Trajectory Run(physics::WorldPtr _world);
+};
+
+/////////////////////////////////////////////////
+Trajectory GoldenTrajectoryTest::Run(physics::WorldPtr _world)
+{
+  Trajectory trajectory;
+  trajectory.host = HostName();
+
+  auto sample = [&trajectory, &_world](const unsigned int _iteration)
+  {
+    for (auto const &model : _world->Models())
+    {
+      if (!model->IsStatic())
+      {
+        trajectory.poses[_iteration][model->GetScopedName()] =
+            model->WorldPose();
+      }
+    }
+  };
+
+  sample(0);
+  std::chrono::steady_clock::duration elapsed{0};
+  for (unsigned int i = 1; i <= kIterations; ++i)
+  {
+    auto start = std::chrono::steady_clock::now();
+    _world->Step(1);
+    elapsed += std::chrono::steady_clock::now() - start;
+
+    if (i % kSampleEvery == 0)
+      sample(i);
+  }
+
+  trajectory.nsPerStep = std::chrono::duration<double, std::nano>(
+      elapsed).count() / kIterations;
+  return trajectory;
+}
+
+/////////////////////////////////////////////////
+TEST_P(GoldenTrajectoryTest, Compare)
+{
+  const std::string worldFile = GetParam();
+
+  std::ostringstream args;
+  args << "-u --seed " << kSeed << " "
+       << (boost::filesystem::path(PROJECT_SOURCE_PATH) / worldFile).string();
+  LoadArgs(args.str());
+  physics::WorldPtr world = physics::get_world();
+  ASSERT_TRUE(world != nullptr);
+
+  Trajectory first = Run(world);
+
+  // Start over from the same state and seed
+  world->Reset();
+  ignition::math::Rand::Seed(kSeed);
+  Trajectory second = Run(world);
+
+  ExpectSameTrajectory(first, second, worldFile + " run to run");
+
+  const boost::filesystem::path goldenFile = GoldenFile(worldFile);
+  const char *update = std::getenv("GAZEBO_GOLDEN_UPDATE");
+  if (update && std::string(update) == "1")
+  {
+    // Keep the faster run as the reference time
+    Trajectory &best = first.nsPerStep < second.nsPerStep ? first : second;
+    EXPECT_TRUE(WriteTrajectory(best, goldenFile));
+    gzmsg << "Recorded " << goldenFile << "\n";
+    return;
+  }
+
+  Trajectory golden;
+  if (!ReadTrajectory(goldenFile, golden))
+  {
+    gzwarn << "No golden trajectory " << goldenFile
+           << ", run with GAZEBO_GOLDEN_UPDATE=1 to record one\n";
+    return;
+  }
+
+  ExpectSameTrajectory(golden, first, worldFile + " against golden");
+
+  const double nsPerStep = std::min(first.nsPerStep, second.nsPerStep);
+  gzdbg << worldFile << ": " << nsPerStep << " ns per step, golden "
+        << golden.nsPerStep << " ns per step on " << golden.host << "\n";
+  if (golden.host == first.host && golden.nsPerStep > 0)
+  {
+    const double timeTol = Tolerance("GAZEBO_GOLDEN_TIME_TOL", 0.25);
+    EXPECT_LE(nsPerStep, golden.nsPerStep * (1 + timeTol))
+        << worldFile << " slowed down";
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(CanonicalWorlds, GoldenTrajectoryTest,
+    ::testing::Values(
+      "worlds/shapes.world",
+      "worlds/friction_pyramid.world",
+      "worlds/seesaw.world",
+      "worlds/joints.world",
+      "test/worlds/drop_test.world"));
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -18,6 +18,7 @@
 
 #include "gazebo/util/IntrospectionManager.hh"
 #include "gazebo/test/ServerFixture.hh"
+#include "PerformanceReport.hh"
 
 #include "ignition/math/Pose3.hh"
 
@@ -92,4 +93,17 @@ TEST_F(IntrospectionManagerTest, IntrospectionManagerStressTest)
   // Not exactly median, but really close.
   std::cerr << "Median: " << times[n/2] << std::endl;
   std::cerr << "Mean: " << sum / static_cast<double>(n) << std::endl;
+
+  test::performance::Record("update_time_median", times[n/2], "s",
+      test::performance::Better::LOWER, times);
+  test::performance::Record("update_time_max", times.back(), "s");
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  const int result = RUN_ALL_TESTS();
+  test::performance::WriteReport("introspectionmanager_stress");
+  return result;
 }
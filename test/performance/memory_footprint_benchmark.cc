@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+// Loads standard worlds and reports the memory held by each subsystem, as
+// counted by the common::MemoryAccount accounts, next to the resident
+// memory of the process. Worlds are loaded one after the other in the same
+// process, and caches such as the mesh manager outlive a world, so the
+// accounts of a world include what the previous worlds left behind; run a
+// single world with --gtest_filter to measure it alone. The report is
+// written as JSON to the file named by the GAZEBO_BENCHMARK_OUTPUT
+// environment variable, or to the standard output if it isn't set.
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "gazebo/gazebo_config.h"
+#include "gazebo/common/MemoryAccount.hh"
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+#include "test_config.h"
+
+using namespace gazebo;
+
+/// \brief Bytes held by one account.
+struct AccountSample
+{
+  /// \brief Name of the account.
+  std::string name;
+
+  /// \brief Bytes held after stepping the world.
+  int64_t bytes;
+
+  /// \brief Largest number of bytes held so far.
+  int64_t peak;
+};
+
+/// \brief Measurements of one world.
+struct FootprintSample
+{
+  /// \brief World file.
+  std::string world;
+
+  /// \brief Resident memory after stepping, in megabytes.
+  double rssMb;
+
+  /// \brief Growth of the resident memory while loading and stepping, in
+  /// megabytes.
+  double rssGrowthMb;
+
+  /// \brief Every account.
+  std::vector<AccountSample> accounts;
+};
+
+/// \brief Samples of all the tests, written out by main.
+static std::vector<FootprintSample> g_samples;
+
+/// \brief Protects g_samples.
+static std::mutex g_samplesMutex;
+
+/// \brief Get the resident memory of the process.
+/// \return Resident memory in megabytes, 0 if unknown.
+static double ResidentMemory()
+{
+  std::ifstream status("/proc/self/status");
+  std::string token;
+  while (status >> token)
+  {
+    if (token == "VmRSS:")
+    {
+      double kb = 0;
+      status >> kb;
+      return kb / 1024.0;
+    }
+  }
+  return 0;
+}
+
+class MemoryFootprintTest : public ServerFixture,
+                            public testing::WithParamInterface<const char *>
+{
+  /// \brief Load and step a world, and record a sample.
+  /// \param[in] _world World file.
+  public: void Measure(const std::string &_world);
+};
+
+/////////////////////////////////////////////////
+void MemoryFootprintTest::Measure(const std::string &_world)
+{
+  const double rssStart = ResidentMemory();
+  Load(_world, true);
+  physics::WorldPtr world = physics::get_world();
+  ASSERT_TRUE(world != nullptr);
+
+  // Fill the publisher queues and the heightmap tiles
+  world->Step(500);
+
+  FootprintSample sample;
+  sample.world = _world;
+  sample.rssMb = ResidentMemory();
+  sample.rssGrowthMb = sample.rssMb - rssStart;
+
+  gzdbg << "world[" << _world << "] rss mb[" << sample.rssMb << "]\n";
+  for (auto const &account : common::MemoryAccount::All())
+  {
+    AccountSample accountSample;
+    accountSample.name = account->Name();
+    accountSample.bytes = account->Bytes();
+    accountSample.peak = account->Peak();
+    sample.accounts.push_back(accountSample);
+
+    gzdbg << "  " << accountSample.name << " bytes[" << accountSample.bytes
+          << "] peak[" << accountSample.peak << "]\n";
+  }
+
+  // The publisher queues are accounted in every world
+  EXPECT_FALSE(sample.accounts.empty());
+
+  std::lock_guard<std::mutex> lock(g_samplesMutex);
+  g_samples.push_back(sample);
+}
+
+/////////////////////////////////////////////////
+TEST_P(MemoryFootprintTest, Footprint)
+{
+  Measure(GetParam());
+}
+
+INSTANTIATE_TEST_CASE_P(Worlds, MemoryFootprintTest, ::testing::Values(
+    "worlds/empty.world",
+    "worlds/shapes.world",
+    "worlds/heightmap.world",
+    "worlds/pioneer2dx.world"));
+
+/// \brief Write the samples as a JSON document.
+/// \param[in] _out Stream to write to.
+static void WriteJson(std::ostream &_out)
+{
+  std::lock_guard<std::mutex> lock(g_samplesMutex);
+  _out << "{\n  \"version\": \"" << GAZEBO_VERSION_FULL << "\",\n"
+       << "  \"samples\": [";
+  for (size_t i = 0; i < g_samples.size(); ++i)
+  {
+    const FootprintSample &sample = g_samples[i];
+    _out << (i == 0 ? "\n" : ",\n")
+         << "    {\"world\": \"" << sample.world << "\", "
+         << "\"rss_mb\": " << sample.rssMb << ", "
+         << "\"rss_growth_mb\": " << sample.rssGrowthMb << ", "
+         << "\"accounts\": {";
+    for (size_t j = 0; j < sample.accounts.size(); ++j)
+    {
+      const AccountSample &account = sample.accounts[j];
+      _out << (j == 0 ? "" : ", ")
+           << "\"" << account.name << "\": {\"bytes\": " << account.bytes
+           << ", \"peak\": " << account.peak << "}";
+    }
+    _out << "}}";
+  }
+  _out << "\n  ]\n}\n";
+}
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  const int result = RUN_ALL_TESTS();
+
+  const char *output = std::getenv("GAZEBO_BENCHMARK_OUTPUT");
+  if (output && output[0] != '\0')
+  {
+    std::ofstream file(output);
+    if (file)
+      WriteJson(file);
+    else
+      std::cerr << "Unable to write benchmark results to " << output << "\n";
+  }
+  else
+  {
+    WriteJson(std::cout);
+  }
+
+  return result;
+}
@@ -0,0 +1,259 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+// Microbenchmarks of primitives on the hot paths of the physics loop and
+// state logging. Each benchmark reports the heap allocations per
+// iteration in the "allocs" counter. Run with
+//   gazebo_microbench --benchmark_filter=<regex>
+// and use --benchmark_out=<file> --benchmark_out_format=json to compare
+// runs.
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#include <benchmark/benchmark.h>
+
+#include "gazebo/gazebo.hh"
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/physics/physics.hh"
+#include "test_config.h"
+
+using namespace gazebo;
+
+/// \brief Number of heap allocations made by the process.
+static std::atomic<uint64_t> g_allocations(0);
+
+/////////////////////////////////////////////////
+void *operator new(std::size_t _size)
+{
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void *ptr = std::malloc(_size ? _size : 1))
+    return ptr;
+  throw std::bad_alloc();
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_ptr) noexcept
+{
+  std::free(_ptr);
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_ptr, std::size_t) noexcept
+{
+  std::free(_ptr);
+}
+
+/// \brief Reports the allocations made during its lifetime, per
+/// iteration of a benchmark.
+class AllocationCounter
+{
+  /// \brief Constructor.
+  /// \param[in] _state State of the benchmark to report to.
+  public: explicit AllocationCounter(benchmark::State &_state)
+          : state(_state), start(g_allocations.load())
+  {
+  }
+
+  /// \brief Destructor, sets the "allocs" counter.
+  public: ~AllocationCounter()
+  {
+    this->state.counters["allocs"] = benchmark::Counter(
+        static_cast<double>(g_allocations.load() - this->start),
+        benchmark::Counter::kAvgIterations);
+  }
+
+  /// \brief State of the benchmark.
+  private: benchmark::State &state;
+
+  /// \brief Allocation count at construction.
+  private: uint64_t start;
+};
+
+/// \brief World shared by the benchmarks.
+static physics::WorldPtr g_world;
+
+/////////////////////////////////////////////////
+static void WorldStateLoad(benchmark::State &_state)
+{
+  physics::WorldState worldState;
+  AllocationCounter counter(_state);
+  for (auto _ : _state)
+    worldState.Load(g_world);
+}
+BENCHMARK(WorldStateLoad);
+
+/////////////////////////////////////////////////
+static void WorldStateDiff(benchmark::State &_state)
+{
+  physics::ModelPtr model = g_world->ModelByName("box");
+  const ignition::math::Pose3d pose = model->WorldPose();
+  physics::WorldState before(g_world);
+  model->SetWorldPose(pose + ignition::math::Pose3d(0.1, 0, 0, 0, 0, 0));
+  physics::WorldState after(g_world);
+  model->SetWorldPose(pose);
+
+  AllocationCounter counter(_state);
+  for (auto _ : _state)
+  {
+    physics::WorldState diff = after - before;
+    benchmark::DoNotOptimize(diff);
+  }
+}
+BENCHMARK(WorldStateDiff);
+
+/////////////////////////////////////////////////
+static void ModelStateConstruct(benchmark::State &_state)
+{
+  physics::ModelPtr model = g_world->ModelByName("box");
+  AllocationCounter counter(_state);
+  for (auto _ : _state)
+  {
+    physics::ModelState modelState(model);
+    benchmark::DoNotOptimize(modelState);
+  }
+}
+BENCHMARK(ModelStateConstruct);
+
+/////////////////////////////////////////////////
+static void LinkStateConstruct(benchmark::State &_state)
+{
+  physics::LinkPtr link = g_world->ModelByName("box")->GetLink("link");
+  AllocationCounter counter(_state);
+  for (auto _ : _state)
+  {
+    physics::LinkState linkState(link);
+    benchmark::DoNotOptimize(linkState);
+  }
+}
+BENCHMARK(LinkStateConstruct);
+
+/////////////////////////////////////////////////
+static void MsgsSetPose(benchmark::State &_state)
+{
+  const ignition::math::Pose3d pose(1, 2, 3, 0.1, 0.2, 0.3);
+  msgs::Pose msg;
+  AllocationCounter counter(_state);
+  for (auto _ : _state)
+  {
+    msgs::Set(&msg, pose);
+    benchmark::DoNotOptimize(msg);
+  }
+}
+BENCHMARK(MsgsSetPose);
+
+/////////////////////////////////////////////////
+static void MsgsConvertPose(benchmark::State &_state)
+{
+  msgs::Pose msg;
+  msgs::Set(&msg, ignition::math::Pose3d(1, 2, 3, 0.1, 0.2, 0.3));
+  AllocationCounter counter(_state);
+  for (auto _ : _state)
+  {
+    ignition::math::Pose3d pose = msgs::ConvertIgn(msg);
+    benchmark::DoNotOptimize(pose);
+  }
+}
+BENCHMARK(MsgsConvertPose);
+
+/////////////////////////////////////////////////
+static void BaseGetByName(benchmark::State &_state)
+{
+  // The last model inserted, so that the search visits the others first
+  physics::ModelPtr model = g_world->Models().back();
+  const std::string name = model->GetLinks().front()->GetScopedName();
+  physics::BasePtr root = g_world->ModelByName("ground_plane")->GetParent();
+
+  AllocationCounter counter(_state);
+  for (auto _ : _state)
+  {
+    physics::BasePtr base = root->GetByName(name);
+    benchmark::DoNotOptimize(base);
+  }
+}
+BENCHMARK(BaseGetByName);
+
+/////////////////////////////////////////////////
+static void EntitySetWorldPose(benchmark::State &_state)
+{
+  physics::ModelPtr model = g_world->ModelByName("box");
+  const ignition::math::Pose3d pose = model->WorldPose();
+  AllocationCounter counter(_state);
+  for (auto _ : _state)
+    model->SetWorldPose(pose);
+}
+BENCHMARK(EntitySetWorldPose);
+
+/////////////////////////////////////////////////
+static void ContactManagerNewContact(benchmark::State &_state)
+{
+  physics::ContactManager *manager =
+      g_world->Physics()->GetContactManager();
+  manager->SetNeverDropContacts(true);
+
+  physics::Collision *box = g_world->ModelByName("box")->GetLink("link")
+      ->GetCollisions().front().get();
+  physics::Collision *ground = g_world->ModelByName("ground_plane")
+      ->GetLink("link")->GetCollisions().front().get();
+  const common::Time time(1, 0);
+
+  AllocationCounter counter(_state);
+  unsigned int count = 0;
+  for (auto _ : _state)
+  {
+    benchmark::DoNotOptimize(manager->NewContact(box, ground, time));
+
+    // Like a physics step, which clears the contacts of the previous one
+    if (++count == 100)
+    {
+      manager->Clear();
+      count = 0;
+    }
+  }
+  manager->Clear();
+  manager->SetNeverDropContacts(false);
+}
+BENCHMARK(ContactManagerNewContact);
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    return 1;
+
+  if (!gazebo::setupServer())
+    return 1;
+
+  g_world = gazebo::loadWorld(PROJECT_SOURCE_PATH "/worlds/shapes.world");
+  if (!g_world)
+  {
+    gazebo::shutdown();
+    return 1;
+  }
+
+  // Step once so that the states hold real data
+  gazebo::runWorld(g_world, 1);
+
+  benchmark::RunSpecifiedBenchmarks();
+
+  g_world.reset();
+  gazebo::shutdown();
+  return 0;
+}
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cmath>
+#include <sstream>
+#include <string>
+
+#include "gazebo/gazebo_config.h"
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class ODEParallelQuickStepTest
+  : public ServerFixture, public testing::WithParamInterface<unsigned int>
+{
+  /// \brief Time the world update of a debris pile with the quick and
+  /// parallel_quick step types.
+  /// \param[in] _count Number of boxes in the pile.
+  public: void DebrisPile(const unsigned int _count);
+};
+
+/////////////////////////////////////////////////
+void ODEParallelQuickStepTest::DebrisPile(const unsigned int _count)
+{
+#ifndef HAVE_PARALLEL_QUICKSTEP
+  gzwarn << "Built without the parallel quickstep solver, parallel_quick "
+         << "falls back to quick\n";
+#endif
+
+  Load("worlds/empty.world", true, "ode");
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  // Layers of boxes stacked on a square footprint, with every other layer
+  // offset so that each box rests on several others and the contact count
+  // grows with the size of the pile.
+  const unsigned int side = static_cast<unsigned int>(
+      std::ceil(std::sqrt(_count / 4.0)));
+  for (unsigned int i = 0; i < _count; ++i)
+  {
+    const unsigned int layer = i / (side * side);
+    const unsigned int cell = i % (side * side);
+    std::ostringstream sdfStr;
+    sdfStr << "<sdf version='" << SDF_VERSION << "'>"
+      << "<model name='box_" << i << "'>"
+      << "  <pose>" << 1.01 * (cell % side) + 0.5 * (layer % 2) << " "
+      << 1.01 * (cell / side) << " " << 0.5 + 1.01 * layer
+      << " 0 0 0</pose>"
+      << "  <link name='link'>"
+      << "    <collision name='collision'>"
+      << "      <geometry><box><size>1 1 1</size></box></geometry>"
+      << "    </collision>"
+      << "  </link>"
+      << "</model>"
+      << "</sdf>";
+    world->InsertModelString(sdfStr.str());
+  }
+
+  // Models are inserted on the next update
+  int sleep = 0;
+  while (world->ModelCount() < _count + 1 && sleep++ < 100)
+  {
+    world->Step(1);
+    common::Time::MSleep(10);
+  }
+  ASSERT_EQ(world->ModelCount(), _count + 1);
+
+  const unsigned int steps = 500;
+  for (const std::string type : {"quick", "parallel_quick"})
+  {
+    world->Reset();
+    ASSERT_TRUE(world->Physics()->SetParam("solver_type", type));
+
+    // Let the pile settle, so that the contacts are in place
+    world->Step(100);
+
+    common::Time startTime = common::Time::GetWallTime();
+    world->Step(steps);
+    common::Time elapsed = common::Time::GetWallTime() - startTime;
+
+    gzdbg << "boxes[" << _count << "] solver_type[" << type << "] "
+          << "contacts["
+          << world->Physics()->GetContactManager()->GetContactCount() << "] "
+          << "time per step[" << elapsed.Double() / steps * 1e3 << " ms]\n";
+
+    // Nothing should have sunk into the ground
+    for (unsigned int i = 0; i < _count; ++i)
+    {
+      physics::ModelPtr box = world->ModelByName("box_" + std::to_string(i));
+      ASSERT_TRUE(box != NULL);
+      EXPECT_GT(box->WorldPose().Pos().Z(), 0.4);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_P(ODEParallelQuickStepTest, DebrisPile)
+{
+  DebrisPile(GetParam());
+}
+
+INSTANTIATE_TEST_CASE_P(BoxCounts, ODEParallelQuickStepTest,
+    ::testing::Values(64u, 256u, 1024u));
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "quickstep_kernels.h"
+
+// Number of constraint rows and bodies, about the size of a pile of boxes.
+static const int kRows = 4096;
+static const int kBodies = 512;
+
+/////////////////////////////////////////////////
+/// \brief Scalar dot product, in the order the vector kernels use.
+static dReal VectorOrderDot6(const dReal *_a, const dReal *_b)
+{
+#if defined(ODE_SSE) || defined(ODE_AVX) || defined(ODE_NEON)
+  const dReal even = (_a[0] * _b[0] + _a[2] * _b[2]) + _a[4] * _b[4];
+  const dReal odd = (_a[1] * _b[1] + _a[3] * _b[3]) + _a[5] * _b[5];
+  return even + odd;
+#else
+  return _a[0] * _b[0] + _a[1] * _b[1] + _a[2] * _b[2] +
+         _a[3] * _b[3] + _a[4] * _b[4] + _a[5] * _b[5];
+#endif
+}
+
+/////////////////////////////////////////////////
+/// \brief Plain scalar dot product, used as the timing baseline.
+static dReal ScalarDot6(const dReal *_a, const dReal *_b)
+{
+  return _a[0] * _b[0] + _a[1] * _b[1] + _a[2] * _b[2] +
+         _a[3] * _b[3] + _a[4] * _b[4] + _a[5] * _b[5];
+}
+
+/////////////////////////////////////////////////
+/// \brief Plain scalar a += delta * b.
+static void ScalarSum6(dReal *_a, const dReal _delta, const dReal *_b)
+{
+  for (int i = 0; i < 6; ++i)
+    _a[i] += _delta * _b[i];
+}
+
+/////////////////////////////////////////////////
+class PGSKernelTest : public ::testing::Test
+{
+  protected: void SetUp() override
+  {
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<dReal> dist(-1.0, 1.0);
+    std::uniform_int_distribution<int> bodyDist(0, kBodies - 1);
+
+    this->J.resize(kRows * 12);
+    for (auto &v : this->J)
+      v = dist(gen);
+    this->caccel.resize(kBodies * 6);
+    for (auto &v : this->caccel)
+      v = dist(gen);
+    this->jb.resize(kRows * 2);
+    for (auto &b : this->jb)
+      b = bodyDist(gen);
+  }
+
+  /// \brief One PGS style sweep over the rows: the residual of a row is
+  /// read from the constraint accelerations of its two bodies, which are
+  /// then updated with the row.
+  /// \param[in] _dot Dot product kernel.
+  /// \param[in] _sum Axpy kernel.
+  /// \param[in,out] _caccel Constraint accelerations.
+  /// \return Sum of the residuals.
+  protected: template<typename Dot, typename Sum>
+  dReal Sweep(Dot _dot, Sum _sum, std::vector<dReal> &_caccel) const
+  {
+    dReal total = 0;
+    for (int i = 0; i < kRows; ++i)
+    {
+      const dReal *J_ptr = &this->J[i * 12];
+      dReal *caccel_ptr1 = &_caccel[6 * this->jb[i * 2]];
+      dReal *caccel_ptr2 = &_caccel[6 * this->jb[i * 2 + 1]];
+      dReal delta = -_dot(caccel_ptr1, J_ptr) - _dot(caccel_ptr2, J_ptr + 6);
+      delta *= 1e-3;
+      _sum(caccel_ptr1, delta, J_ptr);
+      _sum(caccel_ptr2, delta, J_ptr + 6);
+      total += delta;
+    }
+    return total;
+  }
+
+  /// \brief Time a number of sweeps.
+  /// \param[in] _dot Dot product kernel.
+  /// \param[in] _sum Axpy kernel.
+  /// \param[in] _iterations Number of sweeps.
+  /// \return Elapsed wall time in seconds.
+  protected: template<typename Dot, typename Sum>
+  double Time(Dot _dot, Sum _sum, const int _iterations) const
+  {
+    std::vector<dReal> accel = this->caccel;
+    const auto start = std::chrono::steady_clock::now();
+    dReal total = 0;
+    for (int i = 0; i < _iterations; ++i)
+      total += this->Sweep(_dot, _sum, accel);
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    // Keep the result alive
+    EXPECT_FALSE(std::isnan(total));
+    return elapsed.count();
+  }
+
+  protected: std::vector<dReal> J;
+  protected: std::vector<dReal> caccel;
+  protected: std::vector<int> jb;
+};
+
+/////////////////////////////////////////////////
+// The kernels built into ODE give bit identical results to a scalar
+// version that adds in the same order, whichever instruction set they use.
+TEST_F(PGSKernelTest, Identical)
+{
+  std::vector<dReal> kernelAccel = this->caccel;
+  std::vector<dReal> refAccel = this->caccel;
+  for (int iteration = 0; iteration < 10; ++iteration)
+  {
+    const dReal kernelTotal = this->Sweep(ode::quickstep::dot6,
+        ode::quickstep::sum6, kernelAccel);
+    const dReal refTotal = this->Sweep(VectorOrderDot6, ScalarSum6,
+        refAccel);
+    EXPECT_EQ(kernelTotal, refTotal);
+  }
+
+  for (size_t i = 0; i < kernelAccel.size(); ++i)
+    EXPECT_EQ(kernelAccel[i], refAccel[i]) << i;
+}
+
+/////////////////////////////////////////////////
+TEST_F(PGSKernelTest, Benchmark)
+{
+  const int iterations = 2000;
+  const double scalar = this->Time(ScalarDot6, ScalarSum6, iterations);
+  const double kernel = this->Time(ode::quickstep::dot6,
+      ode::quickstep::sum6, iterations);
+
+  std::cout << "rows[" << kRows << "] sweeps[" << iterations << "]\n"
+            << "  scalar [" << scalar << " s]\n"
+            << "  kernel [" << kernel << " s] ("
+#if defined(ODE_AVX)
+            << "AVX2"
+#elif defined(ODE_NEON)
+            << "NEON"
+#elif defined(ODE_SSE)
+            << "SSE2"
+#else
+            << "scalar"
+#endif
+            << ")\n";
+}
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cmath>
+#include <sstream>
+#include <string>
+
+#include "gazebo/physics/ode/ODEPhysics.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class ODESpaceTypeTest : public ServerFixture,
+                         public testing::WithParamInterface<unsigned int>
+{
+  /// \brief Time the world update for each broadphase space type.
+  /// \param[in] _count Number of boxes to spawn.
+  public: void Broadphase(const unsigned int _count);
+};
+
+/////////////////////////////////////////////////
+void ODESpaceTypeTest::Broadphase(const unsigned int _count)
+{
+  Load("worlds/empty.world", true, "ode");
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  physics::ODEPhysicsPtr physics =
+      boost::dynamic_pointer_cast<physics::ODEPhysics>(world->Physics());
+  ASSERT_TRUE(physics != NULL);
+
+  // Boxes resting on the ground in a square grid, so that every step has
+  // one ground contact per box and no box to box contacts.
+  const unsigned int side =
+      static_cast<unsigned int>(std::ceil(std::sqrt(_count)));
+  for (unsigned int i = 0; i < _count; ++i)
+  {
+    std::ostringstream sdfStr;
+    sdfStr << "<sdf version='" << SDF_VERSION << "'>"
+      << "<model name='box_" << i << "'>"
+      << "  <pose>" << 2.0 * (i % side) << " " << 2.0 * (i / side)
+      << " 0.5 0 0 0</pose>"
+      << "  <link name='link'>"
+      << "    <collision name='collision'>"
+      << "      <geometry><box><size>1 1 1</size></box></geometry>"
+      << "    </collision>"
+      << "  </link>"
+      << "</model>"
+      << "</sdf>";
+    world->InsertModelString(sdfStr.str());
+  }
+
+  // Models are inserted on the next update
+  int sleep = 0;
+  while (world->ModelCount() < _count + 1 && sleep++ < 100)
+  {
+    world->Step(1);
+    common::Time::MSleep(10);
+  }
+  ASSERT_EQ(world->ModelCount(), _count + 1);
+
+  const unsigned int steps = 200;
+  for (const std::string type : {"hash", "sap", "quadtree"})
+  {
+    ASSERT_TRUE(physics->SetParam("space_type", type));
+
+    // Warm up the space
+    world->Step(10);
+
+    common::Time startTime = common::Time::GetWallTime();
+    world->Step(steps);
+    common::Time elapsed = common::Time::GetWallTime() - startTime;
+
+    gzdbg << "boxes[" << _count << "] space_type[" << type << "] "
+          << "time per step[" << elapsed.Double() / steps * 1e3 << " ms]\n";
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_P(ODESpaceTypeTest, Broadphase)
+{
+  Broadphase(GetParam());
+}
+
+INSTANTIATE_TEST_CASE_P(BoxCounts, ODESpaceTypeTest,
+    ::testing::Values(100u, 400u, 1600u));
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
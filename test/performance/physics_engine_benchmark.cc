@@ -0,0 +1,557 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+// Steps a fixed suite of scenes with every physics engine that gazebo was
+// built with, and reports the time per step, the real time factor and the
+// number of heap allocations per step as JSON. The report is written to the
+// file named by the GAZEBO_BENCHMARK_OUTPUT environment variable, or to the
+// standard output if it isn't set.
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/sensors/sensors.hh"
+#include "gazebo/test/ServerFixture.hh"
+#include "gazebo/test/helper_physics_generator.hh"
+#include "test_config.h"
+
+using namespace gazebo;
+
+/// \brief Number of heap allocations made by the process.
+static std::atomic<uint64_t> g_allocations(0);
+
+/////////////////////////////////////////////////
+void *operator new(std::size_t _size)
+{
+  ++g_allocations;
+  void *ptr = std::malloc(_size == 0 ? 1 : _size);
+  if (!ptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+
+/////////////////////////////////////////////////
+void *operator new[](std::size_t _size)
+{
+  ++g_allocations;
+  void *ptr = std::malloc(_size == 0 ? 1 : _size);
+  if (!ptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_ptr) noexcept
+{
+  std::free(_ptr);
+}
+
+/////////////////////////////////////////////////
+void operator delete[](void *_ptr) noexcept
+{
+  std::free(_ptr);
+}
+
+/// \brief Measurements of one scene with one engine.
+struct BenchmarkSample
+{
+  /// \brief Name of the scene.
+  std::string scene;
+
+  /// \brief Name of the physics engine.
+  std::string engine;
+
+  /// \brief Number of timed steps.
+  unsigned int steps;
+
+  /// \brief Wall time per step in nanoseconds.
+  double nsPerStep;
+
+  /// \brief Simulated time over wall time.
+  double rtf;
+
+  /// \brief Heap allocations per step.
+  double allocationsPerStep;
+};
+
+/// \brief Samples of all the tests, written out by main.
+static std::vector<BenchmarkSample> g_samples;
+
+/// \brief Protects g_samples.
+static std::mutex g_samplesMutex;
+
+class PhysicsBenchmarkTest : public ServerFixture,
+                             public testing::WithParamInterface<const char*>
+{
+  /// \brief Stacks of boxes resting on each other.
+  /// \param[in] _physicsEngine Physics engine to use.
+  public: void BoxStacks(const std::string &_physicsEngine);
+
+  /// \brief Articulated humanoids falling down and lying on the ground.
+  /// \param[in] _physicsEngine Physics engine to use.
+  public: void Humanoid(const std::string &_physicsEngine);
+
+  /// \brief Tracked vehicle driving on flat ground.
+  /// \param[in] _physicsEngine Physics engine to use.
+  public: void TrackedVehicle(const std::string &_physicsEngine);
+
+  /// \brief Ray sensors scanning a field of boxes.
+  /// \param[in] _physicsEngine Physics engine to use.
+  public: void RaySensors(const std::string &_physicsEngine);
+
+  /// \brief Pile of mesh collisions.
+  /// \param[in] _physicsEngine Physics engine to use.
+  public: void MeshPile(const std::string &_physicsEngine);
+
+  /// \brief Insert models and wait until they are in the world.
+  /// \param[in] _world World to insert the models into.
+  /// \param[in] _sdfs SDF strings of the models.
+  protected: void InsertModels(physics::WorldPtr _world,
+                               const std::vector<std::string> &_sdfs);
+
+  /// \brief Let a scene settle, then time the steps and record a sample.
+  /// \param[in] _scene Name of the scene.
+  /// \param[in] _world World to step.
+  /// \param[in] _steps Number of timed steps.
+  /// \param[in] _perStep Optional work done after each step, such as
+  /// updating sensors. It is part of the timed loop.
+  protected: void Measure(const std::string &_scene,
+                          physics::WorldPtr _world, const unsigned int _steps,
+                          std::function<void()> _perStep = nullptr);
+};
+
+/// \brief SDF of a box model.
+/// \param[in] _name Name of the model.
+/// \param[in] _pos Position of the model.
+/// \param[in] _size Size of the box.
+/// \return SDF string.
+static std::string BoxSdf(const std::string &_name,
+    const ignition::math::Vector3d &_pos, const double _size)
+{
+  std::ostringstream sdfStr;
+  sdfStr << "<sdf version='" << SDF_VERSION << "'>"
+    << "<model name='" << _name << "'>"
+    << "  <pose>" << _pos << " 0 0 0</pose>"
+    << "  <link name='link'>"
+    << "    <collision name='collision'>"
+    << "      <geometry><box><size>" << _size << " " << _size << " "
+    << _size << "</size></box></geometry>"
+    << "    </collision>"
+    << "  </link>"
+    << "</model>"
+    << "</sdf>";
+  return sdfStr.str();
+}
+
+/// \brief SDF of a link of the humanoid.
+/// \param[in] _name Name of the link.
+/// \param[in] _pos Position of the link in the model frame.
+/// \param[in] _mass Mass of the link.
+/// \param[in] _geometry SDF of the collision geometry.
+/// \return SDF string.
+static std::string HumanoidLinkSdf(const std::string &_name,
+    const ignition::math::Vector3d &_pos, const double _mass,
+    const std::string &_geometry)
+{
+  std::ostringstream sdfStr;
+  sdfStr << "<link name='" << _name << "'>"
+    << "  <pose>" << _pos << " 0 0 0</pose>"
+    << "  <inertial>"
+    << "    <mass>" << _mass << "</mass>"
+    << "    <inertia><ixx>" << 0.05 * _mass << "</ixx><iyy>" << 0.05 * _mass
+    << "</iyy><izz>" << 0.02 * _mass << "</izz></inertia>"
+    << "  </inertial>"
+    << "  <collision name='collision'>"
+    << "    <geometry>" << _geometry << "</geometry>"
+    << "  </collision>"
+    << "</link>";
+  return sdfStr.str();
+}
+
+/// \brief SDF of a revolute joint of the humanoid.
+/// \param[in] _name Name of the joint.
+/// \param[in] _parent Parent link.
+/// \param[in] _child Child link.
+/// \param[in] _axis Axis of rotation.
+/// \return SDF string.
+static std::string HumanoidJointSdf(const std::string &_name,
+    const std::string &_parent, const std::string &_child,
+    const ignition::math::Vector3d &_axis)
+{
+  std::ostringstream sdfStr;
+  sdfStr << "<joint name='" << _name << "' type='revolute'>"
+    << "  <parent>" << _parent << "</parent>"
+    << "  <child>" << _child << "</child>"
+    << "  <axis>"
+    << "    <xyz>" << _axis << "</xyz>"
+    << "    <limit><lower>-1.5</lower><upper>1.5</upper></limit>"
+    << "    <dynamics><damping>0.5</damping></dynamics>"
+    << "  </axis>"
+    << "</joint>";
+  return sdfStr.str();
+}
+
+/// \brief SDF of a humanoid with 11 links and 10 revolute joints.
+/// \param[in] _name Name of the model.
+/// \param[in] _pos Position of the model.
+/// \return SDF string.
+static std::string HumanoidSdf(const std::string &_name,
+    const ignition::math::Vector3d &_pos)
+{
+  const std::string limb =
+      "<cylinder><radius>0.05</radius><length>0.4</length></cylinder>";
+
+  std::ostringstream sdfStr;
+  sdfStr << "<sdf version='" << SDF_VERSION << "'>"
+    << "<model name='" << _name << "'>"
+    << "  <pose>" << _pos << " 0 0 0</pose>"
+    << HumanoidLinkSdf("pelvis", {0, 0, 1.0}, 8,
+        "<box><size>0.3 0.2 0.15</size></box>")
+    << HumanoidLinkSdf("torso", {0, 0, 1.35}, 20,
+        "<box><size>0.35 0.2 0.5</size></box>")
+    << HumanoidLinkSdf("head", {0, 0, 1.75}, 4,
+        "<sphere><radius>0.12</radius></sphere>")
+    << HumanoidLinkSdf("left_upper_arm", {0, 0.25, 1.4}, 2, limb)
+    << HumanoidLinkSdf("left_lower_arm", {0, 0.25, 0.98}, 1.5, limb)
+    << HumanoidLinkSdf("right_upper_arm", {0, -0.25, 1.4}, 2, limb)
+    << HumanoidLinkSdf("right_lower_arm", {0, -0.25, 0.98}, 1.5, limb)
+    << HumanoidLinkSdf("left_thigh", {0, 0.1, 0.7}, 7, limb)
+    << HumanoidLinkSdf("left_shin", {0, 0.1, 0.25}, 4, limb)
+    << HumanoidLinkSdf("right_thigh", {0, -0.1, 0.7}, 7, limb)
+    << HumanoidLinkSdf("right_shin", {0, -0.1, 0.25}, 4, limb)
+    << HumanoidJointSdf("waist", "pelvis", "torso", {0, 1, 0})
+    << HumanoidJointSdf("neck", "torso", "head", {0, 0, 1})
+    << HumanoidJointSdf("left_shoulder", "torso", "left_upper_arm", {1, 0, 0})
+    << HumanoidJointSdf("left_elbow", "left_upper_arm", "left_lower_arm",
+        {0, 1, 0})
+    << HumanoidJointSdf("right_shoulder", "torso", "right_upper_arm",
+        {1, 0, 0})
+    << HumanoidJointSdf("right_elbow", "right_upper_arm", "right_lower_arm",
+        {0, 1, 0})
+    << HumanoidJointSdf("left_hip", "pelvis", "left_thigh", {0, 1, 0})
+    << HumanoidJointSdf("left_knee", "left_thigh", "left_shin", {0, 1, 0})
+    << HumanoidJointSdf("right_hip", "pelvis", "right_thigh", {0, 1, 0})
+    << HumanoidJointSdf("right_knee", "right_thigh", "right_shin", {0, 1, 0})
+    << "</model>"
+    << "</sdf>";
+  return sdfStr.str();
+}
+
+/////////////////////////////////////////////////
+void PhysicsBenchmarkTest::InsertModels(physics::WorldPtr _world,
+    const std::vector<std::string> &_sdfs)
+{
+  const unsigned int count = _world->ModelCount() + _sdfs.size();
+  for (const auto &sdfStr : _sdfs)
+    _world->InsertModelString(sdfStr);
+
+  // Models are inserted on the next update
+  int sleep = 0;
+  while (_world->ModelCount() < count && sleep++ < 300)
+  {
+    _world->Step(1);
+    common::Time::MSleep(10);
+  }
+  ASSERT_EQ(_world->ModelCount(), count);
+}
+
+/////////////////////////////////////////////////
+void PhysicsBenchmarkTest::Measure(const std::string &_scene,
+    physics::WorldPtr _world, const unsigned int _steps,
+    std::function<void()> _perStep)
+{
+  // Let contacts and caches settle before timing
+  _world->Step(50);
+
+  const common::Time simStart = _world->SimTime();
+  const uint64_t allocStart = g_allocations;
+  const auto wallStart = std::chrono::steady_clock::now();
+  for (unsigned int i = 0; i < _steps; ++i)
+  {
+    _world->Step(1);
+    if (_perStep)
+      _perStep();
+  }
+  const auto wallEnd = std::chrono::steady_clock::now();
+  const uint64_t allocEnd = g_allocations;
+  const double simElapsed = (_world->SimTime() - simStart).Double();
+  const double wallElapsed = std::chrono::duration<double>(
+      wallEnd - wallStart).count();
+
+  BenchmarkSample sample;
+  sample.scene = _scene;
+  sample.engine = _world->Physics()->GetType();
+  sample.steps = _steps;
+  sample.nsPerStep = wallElapsed * 1e9 / _steps;
+  sample.rtf = wallElapsed > 0 ? simElapsed / wallElapsed : 0.0;
+  sample.allocationsPerStep =
+      static_cast<double>(allocEnd - allocStart) / _steps;
+
+  gzdbg << "scene[" << sample.scene << "] engine[" << sample.engine << "] "
+        << "ns per step[" << sample.nsPerStep << "] "
+        << "rtf[" << sample.rtf << "] "
+        << "allocations per step[" << sample.allocationsPerStep << "]\n";
+
+  std::lock_guard<std::mutex> lock(g_samplesMutex);
+  g_samples.push_back(sample);
+}
+
+/////////////////////////////////////////////////
+void PhysicsBenchmarkTest::BoxStacks(const std::string &_physicsEngine)
+{
+  Load("worlds/empty.world", true, _physicsEngine);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  // 5 x 5 stacks of 10 boxes
+  std::vector<std::string> sdfs;
+  for (int x = 0; x < 5; ++x)
+  {
+    for (int y = 0; y < 5; ++y)
+    {
+      for (int z = 0; z < 10; ++z)
+      {
+        std::ostringstream name;
+        name << "box_" << x << "_" << y << "_" << z;
+        sdfs.push_back(BoxSdf(name.str(),
+            ignition::math::Vector3d(2.0 * x, 2.0 * y, 0.5 + 1.001 * z), 1));
+      }
+    }
+  }
+  InsertModels(world, sdfs);
+
+  Measure("box_stacks", world, 500);
+}
+
+/////////////////////////////////////////////////
+void PhysicsBenchmarkTest::Humanoid(const std::string &_physicsEngine)
+{
+  Load("worlds/empty.world", true, _physicsEngine);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  std::vector<std::string> sdfs;
+  for (int i = 0; i < 10; ++i)
+  {
+    std::ostringstream name;
+    name << "humanoid_" << i;
+    sdfs.push_back(HumanoidSdf(name.str(),
+        ignition::math::Vector3d(2.0 * (i % 5), 2.0 * (i / 5), 0.05)));
+  }
+  InsertModels(world, sdfs);
+
+  Measure("humanoid", world, 500);
+}
+
+/////////////////////////////////////////////////
+void PhysicsBenchmarkTest::TrackedVehicle(const std::string &_physicsEngine)
+{
+  // The tracked vehicle plugin relies on ODE specific contact handling
+  if (_physicsEngine != "ode")
+  {
+    gzdbg << "Tracked vehicles only work with ODE, skipping "
+          << _physicsEngine << "\n";
+    return;
+  }
+
+  Load("worlds/tracked_vehicle_simple.world", true, _physicsEngine);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  physics::ModelPtr vehicle = world->ModelByName("simple_tracked");
+  ASSERT_TRUE(vehicle != nullptr);
+
+  // Drive forward so that the tracks are busy
+  transport::PublisherPtr cmdPub =
+      this->node->Advertise<msgs::Twist>("~/simple_tracked/cmd_vel_twist");
+  msgs::Twist cmd;
+  msgs::Set(cmd.mutable_linear(), ignition::math::Vector3d(1, 0, 0));
+  msgs::Set(cmd.mutable_angular(), ignition::math::Vector3d(0, 0, 0.2));
+  cmdPub->WaitForConnection();
+  cmdPub->Publish(cmd);
+
+  Measure("tracked_vehicle", world, 500);
+}
+
+/////////////////////////////////////////////////
+void PhysicsBenchmarkTest::RaySensors(const std::string &_physicsEngine)
+{
+  Load("worlds/empty.world", true, _physicsEngine);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  // Field of static boxes to scan
+  std::vector<std::string> sdfs;
+  for (int i = 0; i < 50; ++i)
+  {
+    std::ostringstream name;
+    name << "target_" << i;
+    const double angle = i * 0.1256;
+    const double radius = 3 + i % 3;
+    sdfs.push_back(BoxSdf(name.str(), ignition::math::Vector3d(
+        radius * std::cos(angle), radius * std::sin(angle), 0.25), 0.5));
+  }
+  InsertModels(world, sdfs);
+
+  std::vector<sensors::RaySensorPtr> rays;
+  for (int i = 0; i < 4; ++i)
+  {
+    std::ostringstream modelName, sensorName;
+    modelName << "ray_model_" << i;
+    sensorName << "ray_sensor_" << i;
+    SpawnRaySensor(modelName.str(), sensorName.str(),
+        ignition::math::Vector3d(0.2 * i, 0, 0.5),
+        ignition::math::Vector3d::Zero, -3.1, 3.1, -0.2, 0.2,
+        0.08, 10, 0.01, 360, 8);
+
+    sensors::RaySensorPtr ray =
+        std::dynamic_pointer_cast<sensors::RaySensor>(
+        sensors::get_sensor(sensorName.str()));
+    ASSERT_TRUE(ray != nullptr);
+    ray->Init();
+    rays.push_back(ray);
+  }
+
+  Measure("ray_sensors", world, 200, [&rays]()
+  {
+    for (auto &ray : rays)
+      ray->Update(true);
+  });
+}
+
+/////////////////////////////////////////////////
+void PhysicsBenchmarkTest::MeshPile(const std::string &_physicsEngine)
+{
+  Load("worlds/empty.world", true, _physicsEngine);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  const std::string meshUri = std::string("file://") + TEST_PATH +
+      "/data/box.dae";
+
+  // Loose pile of meshes dropped on top of each other
+  std::vector<std::string> sdfs;
+  for (int i = 0; i < 100; ++i)
+  {
+    std::ostringstream name, sdfStr;
+    name << "mesh_" << i;
+    sdfStr << "<sdf version='" << SDF_VERSION << "'>"
+      << "<model name='" << name.str() << "'>"
+      << "  <pose>" << 0.3 * (i % 4) << " " << 0.3 * ((i / 4) % 4) << " "
+      << 0.3 + 0.3 * (i / 16) << " " << 0.1 * i << " 0 0</pose>"
+      << "  <link name='link'>"
+      << "    <collision name='collision'>"
+      << "      <geometry><mesh><uri>" << meshUri << "</uri>"
+      << "<scale>0.25 0.25 0.25</scale></mesh></geometry>"
+      << "    </collision>"
+      << "  </link>"
+      << "</model>"
+      << "</sdf>";
+    sdfs.push_back(sdfStr.str());
+  }
+  InsertModels(world, sdfs);
+
+  Measure("mesh_pile", world, 500);
+}
+
+/////////////////////////////////////////////////
+TEST_P(PhysicsBenchmarkTest, BoxStacks)
+{
+  BoxStacks(GetParam());
+}
+
+/////////////////////////////////////////////////
+TEST_P(PhysicsBenchmarkTest, Humanoid)
+{
+  Humanoid(GetParam());
+}
+
+/////////////////////////////////////////////////
+TEST_P(PhysicsBenchmarkTest, TrackedVehicle)
+{
+  TrackedVehicle(GetParam());
+}
+
+/////////////////////////////////////////////////
+TEST_P(PhysicsBenchmarkTest, RaySensors)
+{
+  RaySensors(GetParam());
+}
+
+/////////////////////////////////////////////////
+TEST_P(PhysicsBenchmarkTest, MeshPile)
+{
+  MeshPile(GetParam());
+}
+
+INSTANTIATE_TEST_CASE_P(PhysicsEngines, PhysicsBenchmarkTest,
+                        PHYSICS_ENGINE_VALUES);
+
+/// \brief Write the samples as a JSON document.
+/// \param[in] _out Stream to write to.
+static void WriteJson(std::ostream &_out)
+{
+  std::lock_guard<std::mutex> lock(g_samplesMutex);
+  _out << "{\n  \"samples\": [";
+  for (size_t i = 0; i < g_samples.size(); ++i)
+  {
+    const BenchmarkSample &sample = g_samples[i];
+    _out << (i == 0 ? "\n" : ",\n")
+         << "    {\"scene\": \"" << sample.scene << "\", "
+         << "\"engine\": \"" << sample.engine << "\", "
+         << "\"steps\": " << sample.steps << ", "
+         << "\"ns_per_step\": " << sample.nsPerStep << ", "
+         << "\"rtf\": " << sample.rtf << ", "
+         << "\"allocations_per_step\": " << sample.allocationsPerStep << "}";
+  }
+  _out << "\n  ]\n}\n";
+}
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  const int result = RUN_ALL_TESTS();
+
+  const char *output = std::getenv("GAZEBO_BENCHMARK_OUTPUT");
+  if (output && output[0] != '\0')
+  {
+    std::ofstream file(output);
+    if (file)
+      WriteJson(file);
+    else
+      std::cerr << "Unable to write benchmark results to " << output << "\n";
+  }
+  else
+  {
+    WriteJson(std::cout);
+  }
+
+  return result;
+}
@@ -0,0 +1,435 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+// Measures the throughput of the rendering sensors: camera resolutions,
+// depth camera counts and GPU lidar sample counts are swept with the
+// sensors updating as fast as they can. For each configuration it reports
+// the frames per second of each sensor, the CPU time of the render phase,
+// the GPU time of the render phase, measured with OpenGL timer queries,
+// and the readback latency, from the end of the render phase to the
+// delivery of a frame. The report is written as JSON to the file named by
+// the GAZEBO_BENCHMARK_OUTPUT environment variable, or to the standard
+// output if it isn't set.
+
+#define GL_GLEXT_PROTOTYPES
+#include <GL/gl.h>
+#include <GL/glext.h>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gazebo/rendering/rendering.hh"
+#include "gazebo/sensors/sensors.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+/// \brief Kind of sensor swept by a configuration.
+enum class SensorKind
+{
+  /// \brief Camera.
+  CAMERA,
+
+  /// \brief Depth camera.
+  DEPTH,
+
+  /// \brief GPU lidar.
+  GPU_LIDAR
+};
+
+/// \brief One configuration of the sweep.
+struct RenderConfig
+{
+  /// \brief Name of the series the configuration belongs to.
+  std::string series;
+
+  /// \brief Kind of sensor.
+  SensorKind kind;
+
+  /// \brief Number of sensors.
+  unsigned int count;
+
+  /// \brief Image width, or horizontal samples of a lidar.
+  unsigned int width;
+
+  /// \brief Image height, or vertical samples of a lidar.
+  unsigned int height;
+};
+
+/// \brief Print a configuration, used by gtest in the test names.
+/// \param[in] _config The configuration.
+/// \param[in] _out Stream to print to.
+static void PrintTo(const RenderConfig &_config, std::ostream *_out)
+{
+  *_out << _config.series << "_" << _config.count << "x" << _config.width
+        << "x" << _config.height;
+}
+
+/// \brief Measurements of one configuration.
+struct RenderSample
+{
+  /// \brief The configuration.
+  RenderConfig config;
+
+  /// \brief Frames per second, averaged over the sensors.
+  double fps;
+
+  /// \brief CPU time of a render phase, in milliseconds.
+  double renderMs;
+
+  /// \brief GPU time of a render phase, in milliseconds, negative if
+  /// timer queries are not supported.
+  double gpuMs;
+
+  /// \brief Time from the end of the render phase to the delivery of a
+  /// frame, in milliseconds.
+  double readbackMs;
+};
+
+/// \brief Samples of all the tests, written out by main.
+static std::vector<RenderSample> g_samples;
+
+/// \brief Protects g_samples.
+static std::mutex g_samplesMutex;
+
+/// \brief Timing collected by callbacks on the rendering thread.
+class RenderTiming
+{
+  /// \brief Called before the sensors render.
+  public: void OnRenderBegin()
+  {
+    if (!this->measuring)
+      return;
+
+    if (this->query == 0 && !this->noQueries)
+    {
+      glGenQueries(1, &this->query);
+      this->noQueries = glGetError() != GL_NO_ERROR || this->query == 0;
+    }
+
+    // The previous phase is complete, its frames have been read back
+    if (this->queryPending)
+    {
+      GLuint64 ns = 0;
+      glGetQueryObjectui64v(this->query, GL_QUERY_RESULT, &ns);
+      this->gpuNs += ns;
+      ++this->gpuPhases;
+      this->queryPending = false;
+    }
+
+    if (!this->noQueries)
+      glBeginQuery(GL_TIME_ELAPSED, this->query);
+    this->renderStart = std::chrono::steady_clock::now();
+    this->inPhase = true;
+  }
+
+  /// \brief Called after the sensors render.
+  public: void OnRenderEnd()
+  {
+    if (!this->inPhase)
+      return;
+
+    if (!this->noQueries)
+    {
+      glEndQuery(GL_TIME_ELAPSED);
+      this->queryPending = true;
+    }
+    this->renderNs += std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - this->renderStart).count();
+    ++this->phases;
+    this->inPhase = false;
+  }
+
+  /// \brief Called before the sensors read their frames back.
+  public: void OnPostRender()
+  {
+    this->postRenderStart = std::chrono::steady_clock::now();
+  }
+
+  /// \brief Called when a sensor delivers a frame.
+  public: void OnFrame()
+  {
+    if (!this->measuring)
+      return;
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->readbackNs += std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - this->postRenderStart).count();
+    ++this->frames;
+  }
+
+  /// \brief True while measuring.
+  public: std::atomic<bool> measuring{false};
+
+  /// \brief Protects the frame counters, sensors may deliver frames from
+  /// several threads.
+  public: std::mutex mutex;
+
+  /// \brief Timer query of the render phase.
+  public: GLuint query = 0;
+
+  /// \brief True if timer queries are not supported.
+  public: bool noQueries = false;
+
+  /// \brief True if the result of the query has not been read.
+  public: bool queryPending = false;
+
+  /// \brief True between OnRenderBegin and OnRenderEnd.
+  public: bool inPhase = false;
+
+  /// \brief Start of the current render phase.
+  public: std::chrono::steady_clock::time_point renderStart;
+
+  /// \brief Start of the current post render phase.
+  public: std::chrono::steady_clock::time_point postRenderStart;
+
+  /// \brief Number of render phases timed on the CPU.
+  public: uint64_t phases = 0;
+
+  /// \brief Cumulative CPU time of the render phases.
+  public: uint64_t renderNs = 0;
+
+  /// \brief Number of render phases timed on the GPU.
+  public: uint64_t gpuPhases = 0;
+
+  /// \brief Cumulative GPU time of the render phases.
+  public: uint64_t gpuNs = 0;
+
+  /// \brief Number of frames delivered.
+  public: uint64_t frames = 0;
+
+  /// \brief Cumulative readback latency.
+  public: uint64_t readbackNs = 0;
+};
+
+class RenderingSensorBenchmark
+  : public ServerFixture, public testing::WithParamInterface<RenderConfig>
+{
+  /// \brief Spawn the sensors of a configuration, let them run and
+  /// record a sample.
+  /// \param[in] _config The configuration.
+  public: void Measure(const RenderConfig &_config);
+};
+
+/////////////////////////////////////////////////
+void RenderingSensorBenchmark::Measure(const RenderConfig &_config)
+{
+  Load("worlds/shapes.world");
+
+  RenderTiming timing;
+
+  // Callbacks run in the order they were connected: these two run before
+  // the sensors that are about to be spawned
+  event::ConnectionPtr beginConnection = event::Events::ConnectRender(
+      std::bind(&RenderTiming::OnRenderBegin, &timing));
+  event::ConnectionPtr postRenderConnection =
+      event::Events::ConnectPostRender(
+      std::bind(&RenderTiming::OnPostRender, &timing));
+
+  std::vector<event::ConnectionPtr> frameConnections;
+  auto onFrame = [&timing](const void *, unsigned int, unsigned int,
+      unsigned int, const std::string &)
+  {
+    timing.OnFrame();
+  };
+
+  for (unsigned int i = 0; i < _config.count; ++i)
+  {
+    std::ostringstream modelName, sensorName;
+    modelName << "sensor_model_" << i;
+    sensorName << "sensor_" << i;
+
+    // Look at the shapes from around them
+    const double yaw = 2 * IGN_PI * i / _config.count;
+    const ignition::math::Vector3d pos(-4 * std::cos(yaw),
+        -4 * std::sin(yaw), 1);
+    const ignition::math::Vector3d rpy(0, 0.2, yaw);
+
+    sensors::SensorPtr sensor;
+    switch (_config.kind)
+    {
+      case SensorKind::CAMERA:
+      {
+        SpawnCamera(modelName.str(), sensorName.str(), pos, rpy,
+            _config.width, _config.height, 0);
+        auto camera = std::dynamic_pointer_cast<sensors::CameraSensor>(
+            sensors::get_sensor(sensorName.str()));
+        ASSERT_TRUE(camera != nullptr);
+        frameConnections.push_back(camera->Camera()->ConnectNewImageFrame(
+            onFrame));
+        sensor = camera;
+        break;
+      }
+      case SensorKind::DEPTH:
+      {
+        SpawnDepthCameraSensor(modelName.str(), sensorName.str(), pos, rpy,
+            _config.width, _config.height, 0);
+        auto depth = std::dynamic_pointer_cast<sensors::DepthCameraSensor>(
+            sensors::get_sensor(sensorName.str()));
+        ASSERT_TRUE(depth != nullptr);
+        frameConnections.push_back(
+            depth->DepthCamera()->ConnectNewDepthFrame(onFrame));
+        sensor = depth;
+        break;
+      }
+      case SensorKind::GPU_LIDAR:
+      {
+        SpawnGpuRaySensorVertical(modelName.str(), sensorName.str(), pos,
+            ignition::math::Vector3d(0, 0, yaw), -IGN_PI, IGN_PI, -0.26,
+            0.26, 0.1, 30, 0.01, _config.width, _config.height);
+        auto lidar = std::dynamic_pointer_cast<sensors::GpuRaySensor>(
+            sensors::get_sensor(sensorName.str()));
+        ASSERT_TRUE(lidar != nullptr);
+        frameConnections.push_back(lidar->ConnectNewLaserFrame(onFrame));
+        sensor = lidar;
+        break;
+      }
+    }
+
+    // As fast as possible
+    sensor->SetUpdateRate(0);
+  }
+
+  // This one runs after the sensors
+  event::ConnectionPtr endConnection = event::Events::ConnectRender(
+      std::bind(&RenderTiming::OnRenderEnd, &timing));
+
+  // Let the sensors warm up, then measure for a few seconds
+  common::Time::MSleep(1000);
+  timing.measuring = true;
+  const auto wallStart = std::chrono::steady_clock::now();
+  common::Time::MSleep(5000);
+  timing.measuring = false;
+  const double wallElapsed = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - wallStart).count();
+
+  // Wait for the render thread to leave the callbacks
+  common::Time::MSleep(100);
+  frameConnections.clear();
+  endConnection.reset();
+  postRenderConnection.reset();
+  beginConnection.reset();
+
+  RenderSample sample;
+  sample.config = _config;
+  {
+    std::lock_guard<std::mutex> lock(timing.mutex);
+    sample.fps = timing.frames / wallElapsed / _config.count;
+    sample.readbackMs = timing.frames ?
+        timing.readbackNs * 1e-6 / timing.frames : 0.0;
+  }
+  sample.renderMs = timing.phases ?
+      timing.renderNs * 1e-6 / timing.phases : 0.0;
+  sample.gpuMs = timing.gpuPhases ?
+      timing.gpuNs * 1e-6 / timing.gpuPhases : -1.0;
+
+  gzdbg << "series[" << _config.series << "] count[" << _config.count
+        << "] size[" << _config.width << "x" << _config.height << "] "
+        << "fps[" << sample.fps << "] "
+        << "render ms[" << sample.renderMs << "] "
+        << "gpu ms[" << sample.gpuMs << "] "
+        << "readback ms[" << sample.readbackMs << "]\n";
+
+  EXPECT_GT(sample.fps, 0.0);
+
+  std::lock_guard<std::mutex> lock(g_samplesMutex);
+  g_samples.push_back(sample);
+}
+
+/////////////////////////////////////////////////
+TEST_P(RenderingSensorBenchmark, Throughput)
+{
+  Measure(GetParam());
+}
+
+// One camera at increasing resolutions
+INSTANTIATE_TEST_CASE_P(CameraResolution, RenderingSensorBenchmark,
+    ::testing::Values(
+    RenderConfig{"camera_resolution", SensorKind::CAMERA, 1, 320, 240},
+    RenderConfig{"camera_resolution", SensorKind::CAMERA, 1, 640, 480},
+    RenderConfig{"camera_resolution", SensorKind::CAMERA, 1, 1280, 720},
+    RenderConfig{"camera_resolution", SensorKind::CAMERA, 1, 1920, 1080}));
+
+// Increasing numbers of VGA depth cameras
+INSTANTIATE_TEST_CASE_P(DepthCount, RenderingSensorBenchmark,
+    ::testing::Values(
+    RenderConfig{"depth_count", SensorKind::DEPTH, 1, 640, 480},
+    RenderConfig{"depth_count", SensorKind::DEPTH, 2, 640, 480},
+    RenderConfig{"depth_count", SensorKind::DEPTH, 4, 640, 480},
+    RenderConfig{"depth_count", SensorKind::DEPTH, 8, 640, 480}));
+
+// One GPU lidar with increasing numbers of samples
+INSTANTIATE_TEST_CASE_P(LidarSamples, RenderingSensorBenchmark,
+    ::testing::Values(
+    RenderConfig{"lidar_samples", SensorKind::GPU_LIDAR, 1, 360, 1},
+    RenderConfig{"lidar_samples", SensorKind::GPU_LIDAR, 1, 1024, 16},
+    RenderConfig{"lidar_samples", SensorKind::GPU_LIDAR, 1, 2048, 32},
+    RenderConfig{"lidar_samples", SensorKind::GPU_LIDAR, 1, 2048, 64}));
+
+/// \brief Write the samples as a JSON document.
+/// \param[in] _out Stream to write to.
+static void WriteJson(std::ostream &_out)
+{
+  std::lock_guard<std::mutex> lock(g_samplesMutex);
+  _out << "{\n  \"samples\": [";
+  for (size_t i = 0; i < g_samples.size(); ++i)
+  {
+    const RenderSample &sample = g_samples[i];
+    _out << (i == 0 ? "\n" : ",\n")
+         << "    {\"series\": \"" << sample.config.series << "\", "
+         << "\"count\": " << sample.config.count << ", "
+         << "\"width\": " << sample.config.width << ", "
+         << "\"height\": " << sample.config.height << ", "
+         << "\"fps\": " << sample.fps << ", "
+         << "\"render_ms\": " << sample.renderMs << ", "
+         << "\"gpu_ms\": " << sample.gpuMs << ", "
+         << "\"readback_ms\": " << sample.readbackMs << "}";
+  }
+  _out << "\n  ]\n}\n";
+}
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  const int result = RUN_ALL_TESTS();
+
+  const char *output = std::getenv("GAZEBO_BENCHMARK_OUTPUT");
+  if (output && output[0] != '\0')
+  {
+    std::ofstream file(output);
+    if (file)
+      WriteJson(file);
+    else
+      std::cerr << "Unable to write benchmark results to " << output << "\n";
+  }
+  else
+  {
+    WriteJson(std::cout);
+  }
+
+  return result;
+}
@@ -19,6 +19,7 @@
 #include "gazebo/physics/PhysicsIface.hh"
 #include "gazebo/common/Time.hh"
 #include "gazebo/test/ServerFixture.hh"
+#include "PerformanceReport.hh"
 
 using namespace gazebo;
 class SensorStress_TEST : public ServerFixture
@@ -65,6 +66,7 @@ TEST_F(SensorStress_TEST, ResetWorldStressTest)
   g_hokuyoMsgCount = 0;
 
   // Subscribe to hokuyo laser scan messages
+  common::Time startTime = common::Time::GetWallTime();
   transport::NodePtr node = transport::NodePtr(new transport::Node());
   node->Init();
   transport::SubscriberPtr sceneSub = node->Subscribe(
@@ -77,6 +79,8 @@ TEST_F(SensorStress_TEST, ResetWorldStressTest)
     g_countCondition.wait(lock);
     gzdbg << "counted " << g_hokuyoMsgCount << " hokuyo messages\n";
   }
+  test::performance::Record("time_to_20_scans",
+      (common::Time::GetWallTime() - startTime).Double(), "s");
 
   EXPECT_GT(g_hokuyoMsgCount, 19u);
 
@@ -91,6 +95,8 @@ TEST_F(SensorStress_TEST, ResetWorldStressTest)
 
   common::Time::MSleep(300);
 
+  const unsigned int resetStartCount = g_hokuyoMsgCount;
+  startTime = common::Time::GetWallTime();
   int i;
   for (i = 0; i < 20; ++i)
   {
@@ -98,11 +104,17 @@ TEST_F(SensorStress_TEST, ResetWorldStressTest)
     gzdbg << "counted " << g_hokuyoMsgCount << " hokuyo messages\n";
     common::Time::MSleep(200);
   }
+  test::performance::Record("scans_per_second_during_resets",
+      (g_hokuyoMsgCount - resetStartCount) /
+      (common::Time::GetWallTime() - startTime).Double(), "1/s",
+      test::performance::Better::HIGHER);
 }
 
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
-  return RUN_ALL_TESTS();
+  const int result = RUN_ALL_TESTS();
+  test::performance::WriteReport("sensor_stress");
+  return result;
 }
@@ -15,7 +15,11 @@
  *
 */
 
+#include <utility>
+#include <vector>
+
 #include "gazebo/test/ServerFixture.hh"
+#include "PerformanceReport.hh"
 
 using namespace gazebo;
 
@@ -42,14 +46,62 @@ TEST_F(SetWorldPoseTest, Stress)
 
   gzdbg << "Time elapsed while setting world pose ["
         << endTime - startTime << "]\n";
+  test::performance::Record("elapsed", (endTime - startTime).Double(), "s");
+  test::performance::Record("calls_per_second",
+      10000000 / (endTime - startTime).Double(), "1/s",
+      test::performance::Better::HIGHER);
 
   EXPECT_LT(endTime - startTime, common::Time(15, 0));
 }
 
+/////////////////////////////////////////////////
+TEST_F(SetWorldPoseTest, Batch)
+{
+  Load("worlds/shapes.world");
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  physics::ModelPtr box = world->ModelByName("box");
+  physics::ModelPtr sphere = world->ModelByName("sphere");
+  physics::ModelPtr cylinder = world->ModelByName("cylinder");
+  ASSERT_TRUE(box != NULL);
+  ASSERT_TRUE(sphere != NULL);
+  ASSERT_TRUE(cylinder != NULL);
+
+  std::vector<std::pair<physics::ModelPtr, ignition::math::Pose3d>> poses =
+    {{box, ignition::math::Pose3d(1, 2, 3, 0, 0, 0)},
+     {sphere, ignition::math::Pose3d(4, 5, 6, 0, 0, 0)},
+     {cylinder, ignition::math::Pose3d(7, 8, 9, 0, 0, 0)}};
+  const unsigned int iterations = 1000000;
+
+  common::Time startTime = common::Time::GetWallTime();
+  for (unsigned int i = 0; i < iterations; ++i)
+  {
+    for (auto const &modelPose : poses)
+      modelPose.first->SetWorldPose(modelPose.second);
+  }
+  common::Time singleTime = common::Time::GetWallTime() - startTime;
+
+  startTime = common::Time::GetWallTime();
+  for (unsigned int i = 0; i < iterations; ++i)
+    world->SetModelPoses(poses);
+  common::Time batchTime = common::Time::GetWallTime() - startTime;
+
+  gzdbg << "Time elapsed setting " << poses.size() << " poses one at a time ["
+        << singleTime << "], in a batch [" << batchTime << "]\n";
+  test::performance::Record("single_elapsed", singleTime.Double(), "s");
+  test::performance::Record("batch_elapsed", batchTime.Double(), "s");
+
+  for (auto const &modelPose : poses)
+    EXPECT_EQ(modelPose.second, modelPose.first->WorldPose());
+}
+
 /////////////////////////////////////////////////
 /// Main
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
-  return RUN_ALL_TESTS();
+  const int result = RUN_ALL_TESTS();
+  test::performance::WriteReport("set_world_pose");
+  return result;
 }
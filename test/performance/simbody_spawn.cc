@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <sstream>
+#include <string>
+
+#include "gazebo/gazebo_config.h"
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class SimbodySpawnTest : public ServerFixture,
+                         public testing::WithParamInterface<int>
+{
+  /// \brief Time the spawning of boxes for a topology batch size.
+  /// \param[in] _batchSize Value of the topology_batch_size parameter.
+  public: void SpawnBoxes(const int _batchSize);
+};
+
+/////////////////////////////////////////////////
+void SimbodySpawnTest::SpawnBoxes(const int _batchSize)
+{
+#ifndef HAVE_SIMBODY
+  gzwarn << "Built without Simbody, skipping\n";
+  return;
+#endif
+
+  Load("worlds/empty.world", true, "simbody");
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  physics::PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != NULL);
+  ASSERT_TRUE(physics->SetParam("topology_batch_size", _batchSize));
+  EXPECT_EQ(_batchSize,
+      boost::any_cast<int>(physics->GetParam("topology_batch_size")));
+
+  const unsigned int count = 50;
+  common::Time startTime = common::Time::GetWallTime();
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    std::ostringstream sdfStr;
+    sdfStr << "<sdf version='" << SDF_VERSION << "'>"
+      << "<model name='box_" << i << "'>"
+      << "  <pose>" << 2.0 * i << " 0 0.5 0 0 0</pose>"
+      << "  <link name='link'>"
+      << "    <collision name='collision'>"
+      << "      <geometry><box><size>1 1 1</size></box></geometry>"
+      << "    </collision>"
+      << "  </link>"
+      << "</model>"
+      << "</sdf>";
+    world->InsertModelString(sdfStr.str());
+  }
+
+  // Models are inserted on the next update
+  int sleep = 0;
+  while (world->ModelCount() < count + 1 && sleep++ < 1000)
+  {
+    world->Step(1);
+    common::Time::MSleep(1);
+  }
+  ASSERT_EQ(world->ModelCount(), count + 1);
+
+  // Pending models are realized before the next step
+  world->Step(1);
+  common::Time elapsed = common::Time::GetWallTime() - startTime;
+
+  gzdbg << "boxes[" << count << "] topology_batch_size[" << _batchSize
+        << "] spawn time[" << elapsed.Double() * 1e3 << " ms] "
+        << "last spawn latency["
+        << boost::any_cast<double>(physics->GetParam("spawn_latency")) * 1e3
+        << " ms]\n";
+
+  // All the boxes are simulated and resting on the ground
+  world->Step(500);
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    physics::ModelPtr model = world->ModelByName("box_" + std::to_string(i));
+    ASSERT_TRUE(model != NULL);
+    EXPECT_NEAR(model->WorldPose().Pos().Z(), 0.5, 0.05);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_P(SimbodySpawnTest, SpawnBoxes)
+{
+  SpawnBoxes(GetParam());
+}
+
+INSTANTIATE_TEST_CASE_P(BatchSizes, SimbodySpawnTest,
+    ::testing::Values(1, 10, 0));
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,309 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+// Measures the startup of gzserver on reference worlds. Each world is
+// started twice in a fresh process: cold, with empty SDF and mesh caches,
+// then warm, with the caches filled by the cold start. The operating
+// system's file cache is not dropped, which needs root, so the cold start
+// still reads files from memory after the first world. The server writes
+// its startup trace (see common::StartupTrace) once it runs, and the
+// report gives the time from spawning the process to the end of the
+// startup, and the time spent in each category of the trace (sdf,
+// model_db, mesh, world, physics, plugin, sensors, rendering). Phases
+// nest, so a category includes the time of the categories it calls. A
+// third, warm start runs with --physics_only, which skips the rendering
+// engine, and each start also reports the resident memory of the server
+// once it runs. The report is written as JSON to the file named by the
+// GAZEBO_BENCHMARK_OUTPUT environment variable, or to the standard output
+// if it isn't set.
+
+#include <gtest/gtest.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "gazebo/gazebo_config.h"
+#include "test/util.hh"
+
+/// \brief Measurements of one start.
+struct StartupSample
+{
+  /// \brief World file.
+  std::string world;
+
+  /// \brief True for a start with empty caches.
+  bool cold;
+
+  /// \brief True for a start with --physics_only.
+  bool physicsOnly;
+
+  /// \brief Time from spawning gzserver to the end of its startup, in
+  /// milliseconds.
+  double startupMs;
+
+  /// \brief Time spent in each category of the trace, in milliseconds.
+  std::map<std::string, double> categoryMs;
+
+  /// \brief Resident memory of the server once it runs, in megabytes.
+  double rssMb;
+};
+
+/// \brief Samples of all the tests, written out by main.
+static std::vector<StartupSample> g_samples;
+
+/// \brief Get the monotonic time used by the startup trace.
+/// \return Time in microseconds.
+static int64_t Now()
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/// \brief Read a whole file.
+/// \param[in] _filename File to read.
+/// \return Content, empty if the file can't be read.
+static std::string ReadFile(const std::string &_filename)
+{
+  std::ifstream in(_filename);
+  std::stringstream content;
+  content << in.rdbuf();
+  return content.str();
+}
+
+/// \brief Get the resident memory of a process.
+/// \param[in] _pid Process id.
+/// \return Resident memory in megabytes, 0 if it can't be read.
+static double ResidentMb(const pid_t _pid)
+{
+  std::istringstream status(
+      ReadFile("/proc/" + std::to_string(_pid) + "/status"));
+  std::string line;
+  while (std::getline(status, line))
+  {
+    if (line.compare(0, 6, "VmRSS:") == 0)
+      return std::stod(line.substr(6)) / 1024.0;
+  }
+  return 0;
+}
+
+class StartupTest : public gazebo::testing::AutoLogFixture,
+                    public testing::WithParamInterface<const char *>
+{
+  /// \brief Start gzserver on a world and record its startup.
+  /// \param[in] _world World file.
+  /// \param[in] _cacheDir Directory of the SDF and mesh caches.
+  /// \param[in] _cold True if the caches are empty.
+  /// \param[in] _physicsOnly True to start without rendering.
+  /// \return True if the server started.
+  public: bool Measure(const std::string &_world,
+                       const boost::filesystem::path &_cacheDir,
+                       const bool _cold, const bool _physicsOnly = false);
+};
+
+/////////////////////////////////////////////////
+bool StartupTest::Measure(const std::string &_world,
+    const boost::filesystem::path &_cacheDir, const bool _cold,
+    const bool _physicsOnly)
+{
+  boost::filesystem::path traceDir =
+      boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path("gz_startup_%%%%%%%%");
+  boost::filesystem::create_directories(traceDir);
+  const std::string traceFile = (traceDir / "gzserver.json").string();
+
+  const int64_t spawnTime = Now();
+  pid_t pid = fork();
+  EXPECT_GE(pid, 0);
+  if (pid < 0)
+    return false;
+  if (pid == 0)
+  {
+    setenv("GAZEBO_STARTUP_TRACE", traceDir.string().c_str(), 1);
+    setenv("GAZEBO_SDF_CACHE", (_cacheDir / "sdf").string().c_str(), 1);
+    setenv("GAZEBO_MESH_CACHE", (_cacheDir / "mesh").string().c_str(), 1);
+    if (_physicsOnly)
+    {
+      execlp("gzserver", "gzserver", "--physics_only", _world.c_str(),
+          NULL);
+    }
+    else
+    {
+      execlp("gzserver", "gzserver", _world.c_str(), NULL);
+    }
+    _exit(127);
+  }
+
+  // The trace is written once the world runs
+  std::string trace;
+  for (int i = 0; i < 1200; ++i)
+  {
+    trace = ReadFile(traceFile);
+    if (trace.find("displayTimeUnit") != std::string::npos)
+      break;
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+  const double rssMb = ResidentMb(pid);
+
+  kill(pid, SIGINT);
+  int status;
+  bool exited = false;
+  for (int i = 0; i < 100 && !exited; ++i)
+  {
+    exited = waitpid(pid, &status, WNOHANG) == pid;
+    if (!exited)
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+  if (!exited)
+  {
+    kill(pid, SIGKILL);
+    waitpid(pid, &status, 0);
+  }
+  boost::filesystem::remove_all(traceDir);
+
+  EXPECT_NE(trace.find("displayTimeUnit"), std::string::npos)
+    << "gzserver did not finish starting [" << _world << "]";
+  if (trace.find("displayTimeUnit") == std::string::npos)
+    return false;
+
+  StartupSample sample;
+  sample.world = _world;
+  sample.cold = _cold;
+  sample.physicsOnly = _physicsOnly;
+  sample.startupMs = 0;
+  sample.rssMb = rssMb;
+
+  // One event per line
+  const std::regex phase(
+      "\"cat\":\"([^\"]*)\",\"ph\":\"X\",\"dur\":([0-9]+)");
+  const std::regex mark("startup complete.*\"ts\":([0-9]+)");
+  std::istringstream lines(trace);
+  std::string line;
+  std::smatch match;
+  while (std::getline(lines, line))
+  {
+    if (std::regex_search(line, match, phase))
+      sample.categoryMs[match[1]] += std::stod(match[2]) / 1000.0;
+    else if (std::regex_search(line, match, mark))
+      sample.startupMs = (std::stod(match[1]) - spawnTime) / 1000.0;
+  }
+  EXPECT_GT(sample.startupMs, 0.0);
+
+  std::cout << _world << (_cold ? " cold" : " warm")
+            << (_physicsOnly ? " physics only" : "") << " startup ms["
+            << sample.startupMs << "] rss MB[" << sample.rssMb << "]\n";
+  for (auto const &category : sample.categoryMs)
+    std::cout << "  " << category.first << " ms[" << category.second << "]\n";
+
+  g_samples.push_back(sample);
+  return true;
+}
+
+/////////////////////////////////////////////////
+TEST_P(StartupTest, ColdWarm)
+{
+  boost::filesystem::path cacheDir =
+      boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path("gz_startup_cache_%%%%%%%%");
+  boost::filesystem::create_directories(cacheDir / "sdf");
+  boost::filesystem::create_directories(cacheDir / "mesh");
+
+  Measure(GetParam(), cacheDir, true);
+  if (Measure(GetParam(), cacheDir, false) &&
+      Measure(GetParam(), cacheDir, false, true))
+  {
+    const StartupSample &warm = g_samples[g_samples.size() - 2];
+    const StartupSample &physicsOnly = g_samples.back();
+    std::cout << GetParam() << " physics only saves startup ms["
+              << warm.startupMs - physicsOnly.startupMs << "] rss MB["
+              << warm.rssMb - physicsOnly.rssMb << "]\n";
+  }
+
+  boost::filesystem::remove_all(cacheDir);
+}
+
+INSTANTIATE_TEST_CASE_P(Worlds, StartupTest, ::testing::Values(
+    "worlds/empty.world",
+    "worlds/shapes.world",
+    "worlds/heightmap.world",
+    "worlds/pioneer2dx.world"));
+
+/// \brief Write the samples as a JSON document.
+/// \param[in] _out Stream to write to.
+static void WriteJson(std::ostream &_out)
+{
+  _out << "{\n  \"version\": \"" << GAZEBO_VERSION_FULL << "\",\n"
+       << "  \"samples\": [";
+  for (size_t i = 0; i < g_samples.size(); ++i)
+  {
+    const StartupSample &sample = g_samples[i];
+    _out << (i == 0 ? "\n" : ",\n")
+         << "    {\"world\": \"" << sample.world << "\", "
+         << "\"start\": \"" << (sample.cold ? "cold" : "warm") << "\", "
+         << "\"mode\": \"" << (sample.physicsOnly ? "physics_only" : "full")
+         << "\", "
+         << "\"startup_ms\": " << sample.startupMs << ", "
+         << "\"rss_mb\": " << sample.rssMb << ", "
+         << "\"category_ms\": {";
+    bool first = true;
+    for (auto const &category : sample.categoryMs)
+    {
+      _out << (first ? "" : ", ") << "\"" << category.first << "\": "
+           << category.second;
+      first = false;
+    }
+    _out << "}}";
+  }
+  _out << "\n  ]\n}\n";
+}
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  const int result = RUN_ALL_TESTS();
+
+  const char *output = std::getenv("GAZEBO_BENCHMARK_OUTPUT");
+  if (output && output[0] != '\0')
+  {
+    std::ofstream file(output);
+    if (file)
+      WriteJson(file);
+    else
+      std::cerr << "Unable to write benchmark results to " << output << "\n";
+  }
+  else
+  {
+    WriteJson(std::cout);
+  }
+
+  return result;
+}
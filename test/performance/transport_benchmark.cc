@@ -0,0 +1,589 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+// Sweeps message sizes from 64 B to 8 MB and the number of subscribers from
+// 1 to 32 over the local, TCP and shared memory transports, and reports the
+// p50 and p99 latency and the throughput as JSON. Remote subscribers are
+// separate processes running this executable with the
+// --transport-benchmark-subscriber argument. The report is written to the
+// file named by the GAZEBO_BENCHMARK_OUTPUT environment variable, or to the
+// standard output if it isn't set.
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gazebo/test/ServerFixture.hh"
+#include "gazebo/transport/ShmRing.hh"
+#include "gazebo/transport/transport.hh"
+
+using namespace gazebo;
+
+extern char **environ;
+
+/// \brief Suffix of the topic of the paced messages used to measure the
+/// latency.
+static const char kLatencyTopic[] = "/latency";
+
+/// \brief Suffix of the topic of the back to back messages used to measure
+/// the throughput.
+static const char kThroughputTopic[] = "/throughput";
+
+/// \brief Argument that starts a remote subscriber instead of the tests.
+static const char kSubscriberArg[] = "--transport-benchmark-subscriber";
+
+/// \brief Message sizes of the sweep, in bytes.
+static const std::vector<size_t> kMessageSizes =
+    {64, 1024, 16 * 1024, 256 * 1024, 1024 * 1024, 8 * 1024 * 1024};
+
+/// \brief Subscriber counts of the sweep.
+static const std::vector<unsigned int> kSubscriberCounts =
+    {1, 2, 4, 8, 16, 32};
+
+/// \brief Seconds without a new message after which a receiver gives up.
+static const int kIdleTimeout = 10;
+
+/// \brief Measurements of one transport, message size and subscriber count.
+struct BenchmarkSample
+{
+  /// \brief Name of the transport.
+  std::string transport;
+
+  /// \brief Size of the message payload in bytes.
+  size_t messageSize;
+
+  /// \brief Number of subscribers.
+  unsigned int subscribers;
+
+  /// \brief Number of messages published for the throughput.
+  unsigned int messages;
+
+  /// \brief Fraction of the throughput messages that were received.
+  double delivered;
+
+  /// \brief Median latency in microseconds.
+  double p50LatencyUs;
+
+  /// \brief 99th percentile latency in microseconds.
+  double p99LatencyUs;
+
+  /// \brief Payload received by all the subscribers per second, in MB/s.
+  double throughputMBps;
+};
+
+/// \brief Samples of all the tests, written out by main.
+static std::vector<BenchmarkSample> g_samples;
+
+/// \brief Protects g_samples.
+static std::mutex g_samplesMutex;
+
+/////////////////////////////////////////////////
+/// \brief Current time of the monotonic clock. On Linux it is shared by
+/// all processes, so stamps can be compared across the remote subscribers.
+/// \return Nanoseconds since an arbitrary epoch.
+static int64_t NowNs()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/////////////////////////////////////////////////
+/// \brief Number of paced messages used for the latency.
+/// \param[in] _size Message size.
+/// \return Number of messages.
+static unsigned int LatencyCount(const size_t _size)
+{
+  return std::max<size_t>(10, std::min<size_t>(200, (16 << 20) / _size));
+}
+
+/////////////////////////////////////////////////
+/// \brief Number of back to back messages used for the throughput.
+/// \param[in] _size Message size.
+/// \return Number of messages.
+static unsigned int ThroughputCount(const size_t _size)
+{
+  return std::max<size_t>(10, std::min<size_t>(2000, (128 << 20) / _size));
+}
+
+/// \brief Receives the messages of one subscriber.
+class Receiver
+{
+  /// \brief Callback of the latency topic.
+  /// \param[in] _msg Stamped message.
+  public: void OnLatency(ConstImageStampedPtr &_msg)
+  {
+    const int64_t now = NowNs();
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->latencies.push_back(
+        now - (_msg->time().sec() * 1000000000LL + _msg->time().nsec()));
+    this->lastActivity = now;
+  }
+
+  /// \brief Callback of the throughput topic.
+  /// \param[in] _msg Stamped message.
+  public: void OnThroughput(ConstImageStampedPtr &/*_msg*/)
+  {
+    const int64_t now = NowNs();
+    std::lock_guard<std::mutex> lock(this->mutex);
+    ++this->received;
+    this->lastReceive = now;
+    this->lastActivity = now;
+  }
+
+  /// \brief Wait until the expected messages arrived, or nothing arrived
+  /// for kIdleTimeout seconds.
+  /// \param[in] _latencyCount Expected number of latency messages.
+  /// \param[in] _throughputCount Expected number of throughput messages.
+  public: void Wait(const unsigned int _latencyCount,
+                    const unsigned int _throughputCount)
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->lastActivity = NowNs();
+    }
+
+    while (true)
+    {
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (this->latencies.size() >= _latencyCount &&
+            this->received >= _throughputCount)
+          return;
+        if (NowNs() - this->lastActivity > kIdleTimeout * 1000000000LL)
+          return;
+      }
+      common::Time::MSleep(1);
+    }
+  }
+
+  /// \brief Latency of each message of the latency topic, in nanoseconds.
+  public: std::vector<int64_t> latencies;
+
+  /// \brief Number of messages received on the throughput topic.
+  public: unsigned int received = 0;
+
+  /// \brief Time of the last message of the throughput topic.
+  public: int64_t lastReceive = 0;
+
+  /// \brief Time of the last message of any topic.
+  public: int64_t lastActivity = 0;
+
+  /// \brief Protects the members.
+  public: std::mutex mutex;
+};
+
+class TransportBenchmarkTest : public ServerFixture
+{
+  /// \brief Run the whole sweep over one transport.
+  /// \param[in] _transport "local", "tcp" or "shm".
+  public: void Sweep(const std::string &_transport);
+
+  /// \brief Measure one message size and subscriber count.
+  /// \param[in] _transport "local", "tcp" or "shm".
+  /// \param[in] _size Message size.
+  /// \param[in] _subscribers Number of subscribers.
+  protected: void Measure(const std::string &_transport, const size_t _size,
+                          const unsigned int _subscribers);
+
+  /// \brief Start remote subscriber processes.
+  /// \param[in] _transport "tcp" or "shm".
+  /// \param[in] _prefix Prefix of the topics.
+  /// \param[in] _count Number of processes.
+  /// \param[in] _latencyCount Expected number of latency messages.
+  /// \param[in] _throughputCount Expected number of throughput messages.
+  /// \param[out] _files Result file of each process.
+  /// \return Pids of the processes.
+  protected: std::vector<pid_t> Spawn(const std::string &_transport,
+                 const std::string &_prefix, const unsigned int _count, const unsigned int _latencyCount,
+                 const unsigned int _throughputCount,
+                 std::vector<std::string> &_files);
+};
+
+/////////////////////////////////////////////////
+std::vector<pid_t> TransportBenchmarkTest::Spawn(
+    const std::string &_transport, const std::string &_prefix,
+    const unsigned int _count, const unsigned int _latencyCount, const unsigned int _throughputCount,
+    std::vector<std::string> &_files)
+{
+  // The subscriber side decides whether to use shared memory
+  std::vector<std::string> env;
+  for (char **var = environ; *var; ++var)
+  {
+    if (std::string(*var).find("GAZEBO_SHM_TRANSPORT=") != 0)
+      env.push_back(*var);
+  }
+  env.push_back(std::string("GAZEBO_SHM_TRANSPORT=") +
+      (_transport == "shm" ? "1" : "0"));
+
+  std::vector<pid_t> pids;
+  for (unsigned int i = 0; i < _count; ++i)
+  {
+    std::ostringstream file;
+    file << "/tmp/gazebo_transport_benchmark_" << getpid() << "_" << i;
+    _files.push_back(file.str());
+
+    std::vector<std::string> args = {"/proc/self/exe", kSubscriberArg, _prefix,
+        std::to_string(_latencyCount), std::to_string(_throughputCount),
+        file.str()};
+
+    // Build the arrays before forking, the child only calls exec
+    std::vector<char *> argv, envp;
+    for (auto &arg : args)
+      argv.push_back(&arg[0]);
+    argv.push_back(nullptr);
+    for (auto &var : env)
+      envp.push_back(&var[0]);
+    envp.push_back(nullptr);
+
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+      execve(argv[0], argv.data(), envp.data());
+      _exit(127);
+    }
+    if (pid > 0)
+      pids.push_back(pid);
+    else
+      gzerr << "Unable to start a remote subscriber\n";
+  }
+  return pids;
+}
+
+/////////////////////////////////////////////////
+void TransportBenchmarkTest::Measure(const std::string &_transport,
+    const size_t _size, const unsigned int _subscribers)
+{
+  const bool local = _transport == "local";
+  const unsigned int latencyCount = LatencyCount(_size);
+  const unsigned int throughputCount = ThroughputCount(_size);
+
+  // Fresh topics, so that the subscribers of the previous measurements are
+  // not counted
+  std::ostringstream prefix;
+  prefix << "~/benchmark/" << _transport << "_" << _size << "_"
+         << _subscribers;
+  const std::string latencyTopic = prefix.str() + kLatencyTopic;
+  const std::string throughputTopic = prefix.str() + kThroughputTopic;
+
+  transport::PublisherPtr latencyPub =
+      this->node->Advertise<msgs::ImageStamped>(latencyTopic,
+      latencyCount + 1);
+  transport::PublisherPtr throughputPub =
+      this->node->Advertise<msgs::ImageStamped>(throughputTopic,
+      throughputCount + 1);
+
+  // Local subscribers are nodes of this process, remote ones are processes
+  std::vector<transport::NodePtr> nodes;
+  std::vector<transport::SubscriberPtr> subs;
+  std::vector<Receiver> receivers(local ? _subscribers : 0);
+  std::vector<pid_t> pids;
+  std::vector<std::string> files;
+  if (local)
+  {
+    for (auto &receiver : receivers)
+    {
+      transport::NodePtr subNode(new transport::Node());
+      subNode->Init("default");
+      subs.push_back(subNode->Subscribe(latencyTopic,
+            &Receiver::OnLatency, &receiver));
+      subs.push_back(subNode->Subscribe(throughputTopic,
+            &Receiver::OnThroughput, &receiver));
+      nodes.push_back(subNode);
+    }
+  }
+  else
+  {
+    pids = this->Spawn(_transport, prefix.str(), _subscribers, latencyCount,
+        throughputCount, files);
+  }
+
+  // Wait for every subscriber to be connected
+  int sleep = 0;
+  while (sleep++ < 3000)
+  {
+    if (local ? latencyPub->HasConnections() &&
+                throughputPub->HasConnections() :
+        latencyPub->GetRemoteSubscriptionCount() >= pids.size() &&
+        throughputPub->GetRemoteSubscriptionCount() >= pids.size())
+      break;
+    common::Time::MSleep(10);
+  }
+  EXPECT_LT(sleep, 3000);
+
+  msgs::ImageStamped msg;
+  msg.mutable_image()->set_width(_size);
+  msg.mutable_image()->set_height(1);
+  msg.mutable_image()->set_pixel_format(0);
+  msg.mutable_image()->set_step(_size);
+  msg.mutable_image()->set_data(std::string(_size, 'x'));
+
+  // Paced messages, so that the latency does not include queueing behind
+  // the previous ones. Leave time for 100 MB/s to every subscriber.
+  const int64_t interval = std::max<int64_t>(2000000,
+      static_cast<int64_t>(_size) * _subscribers * 10);
+  for (unsigned int i = 0; i < latencyCount; ++i)
+  {
+    const int64_t stamp = NowNs();
+    msg.mutable_time()->set_sec(stamp / 1000000000LL);
+    msg.mutable_time()->set_nsec(stamp % 1000000000LL);
+    latencyPub->Publish(msg);
+    while (NowNs() - stamp < interval)
+      common::Time::NSleep(100000);
+  }
+
+  // Back to back messages for the throughput
+  const int64_t start = NowNs();
+  for (unsigned int i = 0; i < throughputCount; ++i)
+    throughputPub->Publish(msg);
+
+  std::vector<int64_t> latencies;
+  uint64_t received = 0;
+  int64_t end = start;
+  if (local)
+  {
+    for (auto &receiver : receivers)
+    {
+      receiver.Wait(latencyCount, throughputCount);
+      std::lock_guard<std::mutex> lock(receiver.mutex);
+      latencies.insert(latencies.end(), receiver.latencies.begin(),
+          receiver.latencies.end());
+      received += receiver.received;
+      end = std::max(end, receiver.lastReceive);
+    }
+  }
+  else
+  {
+    for (unsigned int i = 0; i < pids.size(); ++i)
+    {
+      int status = 0;
+      waitpid(pids[i], &status, 0);
+      EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+      // First line: received count and time of the last message, second
+      // line: the latencies
+      std::ifstream file(files[i]);
+      unsigned int count = 0;
+      int64_t last = 0;
+      if (file >> count >> last)
+      {
+        received += count;
+        end = std::max(end, last);
+        int64_t latency;
+        while (file >> latency)
+          latencies.push_back(latency);
+      }
+      std::remove(files[i].c_str());
+    }
+  }
+
+  subs.clear();
+  for (auto &subNode : nodes)
+    subNode->Fini();
+  latencyPub.reset();
+  throughputPub.reset();
+
+  BenchmarkSample sample;
+  sample.transport = _transport;
+  sample.messageSize = _size;
+  sample.subscribers = _subscribers;
+  sample.messages = throughputCount;
+  sample.delivered = static_cast<double>(received) /
+      (static_cast<double>(throughputCount) * _subscribers);
+  sample.p50LatencyUs = 0;
+  sample.p99LatencyUs = 0;
+  if (!latencies.empty())
+  {
+    std::sort(latencies.begin(), latencies.end());
+    sample.p50LatencyUs = latencies[latencies.size() / 2] * 1e-3;
+    sample.p99LatencyUs = latencies[std::min(latencies.size() - 1,
+        latencies.size() * 99 / 100)] * 1e-3;
+  }
+  const double elapsed = (end - start) * 1e-9;
+  sample.throughputMBps = elapsed > 0 ?
+      received * static_cast<double>(_size) / elapsed / (1 << 20) : 0.0;
+
+  EXPECT_GT(sample.delivered, 0.0);
+
+  gzdbg << "transport[" << sample.transport << "] "
+        << "size[" << sample.messageSize << "] "
+        << "subscribers[" << sample.subscribers << "] "
+        << "delivered[" << sample.delivered << "] "
+        << "p50[" << sample.p50LatencyUs << " us] "
+        << "p99[" << sample.p99LatencyUs << " us] "
+        << "throughput[" << sample.throughputMBps << " MB/s]\n";
+
+  std::lock_guard<std::mutex> lock(g_samplesMutex);
+  g_samples.push_back(sample);
+}
+
+/////////////////////////////////////////////////
+void TransportBenchmarkTest::Sweep(const std::string &_transport)
+{
+  Load("worlds/empty.world");
+
+  for (auto size : kMessageSizes)
+  {
+    for (auto subscribers : kSubscriberCounts)
+      Measure(_transport, size, subscribers);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(TransportBenchmarkTest, Local)
+{
+  Sweep("local");
+}
+
+/////////////////////////////////////////////////
+TEST_F(TransportBenchmarkTest, Tcp)
+{
+  Sweep("tcp");
+}
+
+/////////////////////////////////////////////////
+TEST_F(TransportBenchmarkTest, Shm)
+{
+  if (!transport::ShmRing::Enabled())
+  {
+    gzdbg << "Shared memory transport is disabled, skipping\n";
+    return;
+  }
+  Sweep("shm");
+}
+
+/////////////////////////////////////////////////
+/// \brief Main of a remote subscriber process. Receives the messages of
+/// one Measure call and writes what it received to a file.
+/// \param[in] _prefix Prefix of the topics.
+/// \param[in] _latencyCount Expected number of latency messages.
+/// \param[in] _throughputCount Expected number of throughput messages.
+/// \param[in] _file Result file.
+/// \return Exit status.
+static int RunSubscriber(const std::string &_prefix,
+    const unsigned int _latencyCount,
+    const unsigned int _throughputCount, const std::string &_file)
+{
+  if (!transport::init())
+    return 1;
+  transport::run();
+
+  Receiver receiver;
+  {
+    transport::NodePtr subNode(new transport::Node());
+    subNode->Init("default");
+    transport::SubscriberPtr latencySub = subNode->Subscribe(
+        _prefix + kLatencyTopic, &Receiver::OnLatency, &receiver);
+    transport::SubscriberPtr throughputSub = subNode->Subscribe(
+        _prefix + kThroughputTopic, &Receiver::OnThroughput, &receiver);
+
+    // Nothing arrives until the publisher saw every subscriber, which can
+    // take a while with many processes
+    {
+      std::lock_guard<std::mutex> lock(receiver.mutex);
+      receiver.lastActivity = NowNs();
+    }
+    while (true)
+    {
+      {
+        std::lock_guard<std::mutex> lock(receiver.mutex);
+        if (!receiver.latencies.empty() || receiver.received > 0 ||
+            NowNs() - receiver.lastActivity > 60 * 1000000000LL)
+          break;
+      }
+      common::Time::MSleep(10);
+    }
+    receiver.Wait(_latencyCount, _throughputCount);
+
+    latencySub.reset();
+    throughputSub.reset();
+    subNode->Fini();
+  }
+
+  std::ofstream file(_file);
+  std::lock_guard<std::mutex> lock(receiver.mutex);
+  file << receiver.received << " " << receiver.lastReceive << "\n";
+  for (auto latency : receiver.latencies)
+    file << latency << " ";
+  file << "\n";
+  file.close();
+
+  transport::fini();
+  return file ? 0 : 1;
+}
+
+/// \brief Write the samples as a JSON document.
+/// \param[in] _out Stream to write to.
+static void WriteJson(std::ostream &_out)
+{
+  std::lock_guard<std::mutex> lock(g_samplesMutex);
+  _out << "{\n  \"samples\": [";
+  for (size_t i = 0; i < g_samples.size(); ++i)
+  {
+    const BenchmarkSample &sample = g_samples[i];
+    _out << (i == 0 ? "\n" : ",\n")
+         << "    {\"transport\": \"" << sample.transport << "\", "
+         << "\"message_size\": " << sample.messageSize << ", "
+         << "\"subscribers\": " << sample.subscribers << ", "
+         << "\"messages\": " << sample.messages << ", "
+         << "\"delivered\": " << sample.delivered << ", "
+         << "\"p50_latency_us\": " << sample.p50LatencyUs << ", "
+         << "\"p99_latency_us\": " << sample.p99LatencyUs << ", "
+         << "\"throughput_mb_per_s\": " << sample.throughputMBps << "}";
+  }
+  _out << "\n  ]\n}\n";
+}
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  if (argc == 6 && std::string(argv[1]) == kSubscriberArg)
+  {
+    return RunSubscriber(argv[2], std::stoul(argv[3]), std::stoul(argv[4]),
+        argv[5]);
+  }
+
+  ::testing::InitGoogleTest(&argc, argv);
+  const int result = RUN_ALL_TESTS();
+
+  const char *output = std::getenv("GAZEBO_BENCHMARK_OUTPUT");
+  if (output && output[0] != '\0')
+  {
+    std::ofstream file(output);
+    if (file)
+      WriteJson(file);
+    else
+      std::cerr << "Unable to write benchmark results to " << output << "\n";
+  }
+  else
+  {
+    WriteJson(std::cout);
+  }
+
+  return result;
+}
@@ -17,6 +17,7 @@
 
 #include <boost/thread.hpp>
 #include "gazebo/test/ServerFixture.hh"
+#include "PerformanceReport.hh"
 #include "RAMLibrary.hh"
 
 using namespace gazebo;
@@ -111,6 +112,10 @@ TEST_F(TransportStressTest, LocalPublish)
   // Out time time for human testing purposes
   gzmsg << "Time to publish " << g_localPublishCount  << " messages = "
     << diff << "\n";
+  test::performance::Record("publish_receive_time", diff.Double(), "s");
+  test::performance::Record("messages_per_second",
+      g_localPublishCount / diff.Double(), "1/s",
+      test::performance::Better::HIGHER);
 
   delete [] fakeData;
 }
@@ -232,6 +237,8 @@ TEST_F(TransportStressTest, ManyNodes)
 
   gzmsg << "Time to receive " << g_localPublishCount << " = "
     << receiveDiff << std::endl;
+  test::performance::Record("publish_time", pubDiff.Double(), "s");
+  test::performance::Record("receive_time", receiveDiff.Double(), "s");
 
   delete [] fakeData;
 }
@@ -241,5 +248,7 @@ TEST_F(TransportStressTest, ManyNodes)
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
-  return RUN_ALL_TESTS();
+  const int result = RUN_ALL_TESTS();
+  test::performance::WriteReport("transport_stress");
+  return result;
 }
@@ -0,0 +1,376 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+// Generates worlds of N robots, each with M ray sensors and an arm of K
+// revolute joints, and measures how the startup time, the resident memory,
+// the time per step and the number of contacts grow with N, M and K. Each
+// series varies one of them and keeps the others fixed, and the worlds are
+// generated deterministically so that reports of different commits can be
+// compared point by point. The report is written as JSON to the file named
+// by the GAZEBO_BENCHMARK_OUTPUT environment variable, or to the standard
+// output if it isn't set.
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "gazebo/gazebo_config.h"
+#include "gazebo/physics/physics.hh"
+#include "gazebo/sensors/sensors.hh"
+#include "gazebo/test/ServerFixture.hh"
+#include "test_config.h"
+
+using namespace gazebo;
+
+/// \brief Size of a generated world.
+struct WorldScale
+{
+  /// \brief Name of the series the world belongs to.
+  std::string series;
+
+  /// \brief Number of robots.
+  unsigned int robots;
+
+  /// \brief Number of ray sensors per robot.
+  unsigned int sensors;
+
+  /// \brief Number of revolute joints per robot.
+  unsigned int joints;
+};
+
+/// \brief Print a world scale, used by gtest in the test names.
+/// \param[in] _scale The world scale.
+/// \param[in] _out Stream to print to.
+static void PrintTo(const WorldScale &_scale, std::ostream *_out)
+{
+  *_out << _scale.series << "_n" << _scale.robots << "_m" << _scale.sensors
+        << "_k" << _scale.joints;
+}
+
+/// \brief Measurements of one world.
+struct ScalingSample
+{
+  /// \brief Size of the world.
+  WorldScale scale;
+
+  /// \brief Wall time to load the world and create its sensors, in
+  /// milliseconds.
+  double startupMs;
+
+  /// \brief Growth of the resident memory while loading, in megabytes.
+  double rssMb;
+
+  /// \brief Number of timed steps.
+  unsigned int steps;
+
+  /// \brief Wall time per step, sensors included, in nanoseconds.
+  double nsPerStep;
+
+  /// \brief Simulated time over wall time.
+  double rtf;
+
+  /// \brief Average number of contacts per step.
+  double contactsPerStep;
+};
+
+/// \brief Samples of all the tests, written out by main.
+static std::vector<ScalingSample> g_samples;
+
+/// \brief Protects g_samples.
+static std::mutex g_samplesMutex;
+
+/// \brief Get the resident memory of the process.
+/// \return Resident memory in megabytes, 0 if unknown.
+static double ResidentMemory()
+{
+  std::ifstream status("/proc/self/status");
+  std::string token;
+  while (status >> token)
+  {
+    if (token == "VmRSS:")
+    {
+      double kb = 0;
+      status >> kb;
+      return kb / 1024.0;
+    }
+  }
+  return 0;
+}
+
+/// \brief SDF of a robot: a base resting on the ground with ray sensors,
+/// and an arm of revolute joints on top of it.
+/// \param[in] _name Name of the model.
+/// \param[in] _pos Position of the model.
+/// \param[in] _sensors Number of ray sensors.
+/// \param[in] _joints Number of joints of the arm.
+/// \return SDF string.
+static std::string RobotSdf(const std::string &_name,
+    const ignition::math::Vector3d &_pos, const unsigned int _sensors,
+    const unsigned int _joints)
+{
+  std::ostringstream sdfStr;
+  sdfStr << "<model name='" << _name << "'>"
+    << "  <pose>" << _pos << " 0 0 0</pose>"
+    << "  <link name='base'>"
+    << "    <pose>0 0 0.1 0 0 0</pose>"
+    << "    <inertial><mass>10</mass></inertial>"
+    << "    <collision name='collision'>"
+    << "      <geometry><box><size>0.5 0.5 0.2</size></box></geometry>"
+    << "    </collision>";
+  for (unsigned int i = 0; i < _sensors; ++i)
+  {
+    // Spread the sensors around the base so that they see other robots
+    const double yaw = 2 * IGN_PI * i / _sensors;
+    sdfStr << "    <sensor name='ray_" << i << "' type='ray'>"
+      << "      <pose>0 0 0.15 0 0 " << yaw << "</pose>"
+      << "      <always_on>1</always_on>"
+      << "      <update_rate>0</update_rate>"
+      << "      <ray>"
+      << "        <scan><horizontal><samples>32</samples>"
+      << "<min_angle>-0.5</min_angle><max_angle>0.5</max_angle>"
+      << "</horizontal></scan>"
+      << "        <range><min>0.1</min><max>10</max></range>"
+      << "      </ray>"
+      << "    </sensor>";
+  }
+  sdfStr << "  </link>";
+
+  std::string parent = "base";
+  for (unsigned int i = 0; i < _joints; ++i)
+  {
+    std::ostringstream link;
+    link << "arm_" << i;
+    sdfStr << "  <link name='" << link.str() << "'>"
+      << "    <pose>0 0 " << 0.35 + 0.2 * i << " 0 0 0</pose>"
+      << "    <inertial><mass>0.2</mass></inertial>"
+      << "    <collision name='collision'>"
+      << "      <geometry><cylinder><radius>0.03</radius>"
+      << "<length>0.18</length></cylinder></geometry>"
+      << "    </collision>"
+      << "  </link>"
+      << "  <joint name='joint_" << i << "' type='revolute'>"
+      << "    <parent>" << parent << "</parent>"
+      << "    <child>" << link.str() << "</child>"
+      << "    <pose>0 0 -0.1 0 0 0</pose>"
+      << "    <axis>"
+      << "      <xyz>" << (i % 2 ? "0 1 0" : "0 0 1") << "</xyz>"
+      << "      <dynamics><damping>0.1</damping></dynamics>"
+      << "    </axis>"
+      << "  </joint>";
+    parent = link.str();
+  }
+  sdfStr << "</model>";
+  return sdfStr.str();
+}
+
+/// \brief SDF of a world of robots laid out on a grid.
+/// \param[in] _scale Size of the world.
+/// \return SDF string.
+static std::string WorldSdf(const WorldScale &_scale)
+{
+  std::ostringstream sdfStr;
+  sdfStr << "<?xml version='1.0'?>"
+    << "<sdf version='" << SDF_VERSION << "'>"
+    << "<world name='default'>"
+    << "  <include><uri>model://ground_plane</uri></include>";
+
+  unsigned int columns = 1;
+  while (columns * columns < _scale.robots)
+    ++columns;
+  for (unsigned int i = 0; i < _scale.robots; ++i)
+  {
+    std::ostringstream name;
+    name << "robot_" << i;
+    sdfStr << RobotSdf(name.str(), ignition::math::Vector3d(
+        1.5 * (i % columns), 1.5 * (i / columns), 0), _scale.sensors,
+        _scale.joints);
+  }
+  sdfStr << "</world></sdf>";
+  return sdfStr.str();
+}
+
+class WorldScalingTest : public ServerFixture,
+                         public testing::WithParamInterface<WorldScale>
+{
+  /// \brief Generate, load and step a world, and record a sample.
+  /// \param[in] _scale Size of the world.
+  public: void Measure(const WorldScale &_scale);
+};
+
+/////////////////////////////////////////////////
+void WorldScalingTest::Measure(const WorldScale &_scale)
+{
+  boost::filesystem::path worldFile =
+      boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path("gz_scaling_%%%%%%%%.world");
+  {
+    std::ofstream out(worldFile.string());
+    ASSERT_TRUE(out.good());
+    out << WorldSdf(_scale);
+  }
+
+  const double rssStart = ResidentMemory();
+  const auto loadStart = std::chrono::steady_clock::now();
+  Load(worldFile.string(), true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  // Sensors are created asynchronously by the sensor manager
+  const unsigned int sensorCount = _scale.robots * _scale.sensors;
+  sensors::Sensor_V allSensors;
+  int sleep = 0;
+  while ((allSensors = sensors::SensorManager::Instance()->GetSensors())
+      .size() < sensorCount && sleep++ < 1000)
+  {
+    common::Time::MSleep(10);
+  }
+  ASSERT_EQ(allSensors.size(), sensorCount);
+  const auto loadEnd = std::chrono::steady_clock::now();
+  const double rssEnd = ResidentMemory();
+  boost::filesystem::remove(worldFile);
+
+  // Keep the contacts even though nobody subscribes, so that the contact
+  // count reflects the scene
+  physics::ContactManager *contacts =
+      world->Physics()->GetContactManager();
+  contacts->SetNeverDropContacts(true);
+
+  // Let the robots settle on the ground before timing
+  world->Step(50);
+
+  const unsigned int steps = 200;
+  uint64_t contactCount = 0;
+  const common::Time simStart = world->SimTime();
+  const auto wallStart = std::chrono::steady_clock::now();
+  for (unsigned int i = 0; i < steps; ++i)
+  {
+    world->Step(1);
+    contactCount += contacts->GetContactCount();
+    for (auto &sensor : allSensors)
+      sensor->Update(true);
+  }
+  const auto wallEnd = std::chrono::steady_clock::now();
+  const double simElapsed = (world->SimTime() - simStart).Double();
+  const double wallElapsed = std::chrono::duration<double>(
+      wallEnd - wallStart).count();
+  contacts->SetNeverDropContacts(false);
+
+  ScalingSample sample;
+  sample.scale = _scale;
+  sample.startupMs = std::chrono::duration<double, std::milli>(
+      loadEnd - loadStart).count();
+  sample.rssMb = rssEnd - rssStart;
+  sample.steps = steps;
+  sample.nsPerStep = wallElapsed * 1e9 / steps;
+  sample.rtf = wallElapsed > 0 ? simElapsed / wallElapsed : 0.0;
+  sample.contactsPerStep = static_cast<double>(contactCount) / steps;
+
+  gzdbg << "robots[" << _scale.robots << "] sensors[" << _scale.sensors
+        << "] joints[" << _scale.joints << "] "
+        << "startup ms[" << sample.startupMs << "] "
+        << "rss mb[" << sample.rssMb << "] "
+        << "ns per step[" << sample.nsPerStep << "] "
+        << "rtf[" << sample.rtf << "] "
+        << "contacts per step[" << sample.contactsPerStep << "]\n";
+
+  std::lock_guard<std::mutex> lock(g_samplesMutex);
+  g_samples.push_back(sample);
+}
+
+/////////////////////////////////////////////////
+TEST_P(WorldScalingTest, Scale)
+{
+  Measure(GetParam());
+}
+
+// Robots, with 2 sensors and 2 joints each
+INSTANTIATE_TEST_CASE_P(Robots, WorldScalingTest, ::testing::Values(
+    WorldScale{"robots", 1, 2, 2},
+    WorldScale{"robots", 10, 2, 2},
+    WorldScale{"robots", 50, 2, 2},
+    WorldScale{"robots", 100, 2, 2},
+    WorldScale{"robots", 200, 2, 2}));
+
+// Sensors per robot, with 10 robots of 2 joints
+INSTANTIATE_TEST_CASE_P(Sensors, WorldScalingTest, ::testing::Values(
+    WorldScale{"sensors", 10, 0, 2},
+    WorldScale{"sensors", 10, 4, 2},
+    WorldScale{"sensors", 10, 16, 2},
+    WorldScale{"sensors", 10, 64, 2}));
+
+// Joints per robot, with 10 robots of 2 sensors
+INSTANTIATE_TEST_CASE_P(Joints, WorldScalingTest, ::testing::Values(
+    WorldScale{"joints", 10, 2, 0},
+    WorldScale{"joints", 10, 2, 8},
+    WorldScale{"joints", 10, 2, 32},
+    WorldScale{"joints", 10, 2, 128}));
+
+/// \brief Write the samples as a JSON document.
+/// \param[in] _out Stream to write to.
+static void WriteJson(std::ostream &_out)
+{
+  std::lock_guard<std::mutex> lock(g_samplesMutex);
+  _out << "{\n  \"version\": \"" << GAZEBO_VERSION_FULL << "\",\n"
+       << "  \"samples\": [";
+  for (size_t i = 0; i < g_samples.size(); ++i)
+  {
+    const ScalingSample &sample = g_samples[i];
+    _out << (i == 0 ? "\n" : ",\n")
+         << "    {\"series\": \"" << sample.scale.series << "\", "
+         << "\"robots\": " << sample.scale.robots << ", "
+         << "\"sensors_per_robot\": " << sample.scale.sensors << ", "
+         << "\"joints_per_robot\": " << sample.scale.joints << ", "
+         << "\"startup_ms\": " << sample.startupMs << ", "
+         << "\"rss_mb\": " << sample.rssMb << ", "
+         << "\"steps\": " << sample.steps << ", "
+         << "\"ns_per_step\": " << sample.nsPerStep << ", "
+         << "\"rtf\": " << sample.rtf << ", "
+         << "\"contacts_per_step\": " << sample.contactsPerStep << "}";
+  }
+  _out << "\n  ]\n}\n";
+}
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  const int result = RUN_ALL_TESTS();
+
+  const char *output = std::getenv("GAZEBO_BENCHMARK_OUTPUT");
+  if (output && output[0] != '\0')
+  {
+    std::ofstream file(output);
+    if (file)
+      WriteJson(file);
+    else
+      std::cerr << "Unable to write benchmark results to " << output << "\n";
+  }
+  else
+  {
+    WriteJson(std::cout);
+  }
+
+  return result;
+}
@@ -19,7 +19,11 @@
 #include <tinyxml.h>
 #include <boost/filesystem.hpp>
 #include <boost/algorithm/string.hpp>
+#include <algorithm>
+#include <map>
 #include <streambuf>
+#include <utility>
+#include <vector>
 
 #include <gazebo/common/common.hh>
 #include <gazebo/transport/transport.hh>
@@ -901,7 +905,13 @@ StatsCommand::StatsCommand()
     ("world-name,w", po::value<std::string>(), "World name.")
     ("duration,d", po::value<uint64_t>(), "Duration (seconds) to run.")
     ("plot,p", "Output comma-separated values, useful for processing and "
-     "plotting.");
+     "plotting.")
+    ("timing,t", "Print the distribution of the time spent in each stage "
+     "of the world update loop, in microseconds, instead.")
+    ("plugins", "Print the time spent in the event callbacks of each "
+     "plugin instead. The server must run with GAZEBO_PLUGIN_TIMING set.")
+    ("top", "Show a live view of where the wall time of each second goes, "
+     "by subsystem and by plugin, instead.");
 }
 
 /////////////////////////////////////////////////
@@ -911,6 +921,24 @@ void StatsCommand::HelpDetailed()
     "\tPrint gzserver statics to standard out. If a name for the world, \n"
     "\toption -w, is not specified, the first world found on \n"
     "\tthe Gazebo master will be used.\n"
+    "\n"
+    "\tWith -t, print the wall time spent in each stage of the world \n"
+    "\tupdate loop (collision, physics, sensors wait, message \n"
+    "\tprocessing, log capture) over the last second, in microseconds.\n"
+    "\n"
+    "\tWith --plugins, print the number of event callbacks run by each \n"
+    "\tworld and model plugin, their cumulative time in milliseconds \n"
+    "\tand the longest one in microseconds. Requires gzserver to run \n"
+    "\twith the GAZEBO_PLUGIN_TIMING environment variable set.\n"
+    "\n"
+    "\tWith --top, refresh a view of the real-time factor and of the \n"
+    "\tshare of wall time spent in collision, physics, plugins, the rest \n"
+    "\tof the update, logging, waiting for sensors, message processing \n"
+    "\tand sleeping over the last second, followed by the busiest \n"
+    "\tplugins. Plugins only show up when gzserver runs with \n"
+    "\tGAZEBO_PLUGIN_TIMING set, otherwise their time is part of the \n"
+    "\trest of the update. With -p, print one line of comma-separated \n"
+    "\tmilliseconds per second instead.\n"
     << std::endl;
 }
 
@@ -925,8 +953,15 @@ bool StatsCommand::RunImpl()
   transport::NodePtr node(new transport::Node());
   node->Init(worldName);
 
-  transport::SubscriberPtr sub =
-    node->Subscribe("~/world_stats", &StatsCommand::CB, this);
+  transport::SubscriberPtr sub;
+  if (this->vm.count("top"))
+    sub = node->Subscribe("~/performance", &StatsCommand::TopCB, this);
+  else if (this->vm.count("plugins"))
+    sub = node->Subscribe("~/performance", &StatsCommand::PluginsCB, this);
+  else if (this->vm.count("timing"))
+    sub = node->Subscribe("~/performance", &StatsCommand::TimingCB, this);
+  else
+    sub = node->Subscribe("~/world_stats", &StatsCommand::CB, this);
 
   boost::mutex::scoped_lock lock(this->sigMutex);
   if (this->vm.count("duration"))
@@ -1003,6 +1038,214 @@ void StatsCommand::CB(ConstWorldStatisticsPtr &_msg)
         percent, simTime.Double(), realTime.Double(), paused);
 }
 
+/////////////////////////////////////////////////
+void StatsCommand::TimingCB(ConstStepTimingPtr &_msg)
+{
+  GZ_ASSERT(_msg, "Invalid message received");
+
+  if (this->vm.count("plot"))
+  {
+    static bool first = true;
+    if (first)
+    {
+      std::cout << "# simtime (sec), stage, count, min, mean, p50, p90, "
+        << "p99, p99.9, max (usec), allocations per run\n";
+      first = false;
+    }
+    for (auto const &stage : _msg->stage())
+    {
+      printf("%16.6f, %s, %llu, %.1f, %.1f, %.1f, %.1f, %.1f, %.1f, %.1f, "
+          "%.1f\n", msgs::Convert(_msg->sim_time()).Double(),
+          stage.name().c_str(), static_cast<unsigned long long>(stage.count()),
+          stage.min(), stage.mean(), stage.p50(), stage.p90(), stage.p99(),
+          stage.p999(), stage.max(),
+          stage.has_allocations() ? stage.allocations() : -1.0);
+    }
+    fflush(stdout);
+    return;
+  }
+
+  printf("SimTime[%4.2f] Window[%4.2f]\n",
+      msgs::Convert(_msg->sim_time()).Double(),
+      msgs::Convert(_msg->window()).Double());
+  printf("  %-13s %8s %9s %9s %9s %9s %9s %9s %9s\n", "stage", "count",
+      "mean", "p50", "p90", "p99", "p99.9", "max", "allocs");
+  for (auto const &stage : _msg->stage())
+  {
+    printf("  %-13s %8llu %9.1f %9.1f %9.1f %9.1f %9.1f %9.1f",
+        stage.name().c_str(), static_cast<unsigned long long>(stage.count()),
+        stage.mean(), stage.p50(), stage.p90(), stage.p99(), stage.p999(),
+        stage.max());
+    if (stage.has_allocations())
+      printf(" %9.1f\n", stage.allocations());
+    else
+      printf(" %9s\n", "-");
+  }
+  fflush(stdout);
+}
+
+/////////////////////////////////////////////////
+void StatsCommand::PluginsCB(ConstStepTimingPtr &_msg)
+{
+  GZ_ASSERT(_msg, "Invalid message received");
+
+  // Slowest plugins first
+  std::vector<const msgs::StepTiming::Plugin *> plugins;
+  for (auto const &plugin : _msg->plugin())
+    plugins.push_back(&plugin);
+  std::sort(plugins.begin(), plugins.end(),
+      [](const msgs::StepTiming::Plugin *_a,
+         const msgs::StepTiming::Plugin *_b)
+      {
+        return _a->total() > _b->total();
+      });
+
+  if (this->vm.count("plot"))
+  {
+    static bool first = true;
+    if (first)
+    {
+      std::cout << "# simtime (sec), plugin, calls, total (msec), "
+        << "max (usec)\n";
+      first = false;
+    }
+    for (auto const plugin : plugins)
+    {
+      printf("%16.6f, %s, %llu, %.3f, %.1f\n",
+          msgs::Convert(_msg->sim_time()).Double(), plugin->name().c_str(),
+          static_cast<unsigned long long>(plugin->calls()), plugin->total(),
+          plugin->max());
+    }
+    fflush(stdout);
+    return;
+  }
+
+  printf("SimTime[%4.2f]\n", msgs::Convert(_msg->sim_time()).Double());
+  if (plugins.empty())
+  {
+    printf("  No plugin timing, is GAZEBO_PLUGIN_TIMING set for the "
+        "server?\n");
+  }
+  else
+  {
+    printf("  %-40s %10s %12s %10s\n", "plugin", "calls", "total(ms)",
+        "max(us)");
+  }
+  for (auto const plugin : plugins)
+  {
+    printf("  %-40s %10llu %12.3f %10.1f\n", plugin->name().c_str(),
+        static_cast<unsigned long long>(plugin->calls()), plugin->total(),
+        plugin->max());
+  }
+  fflush(stdout);
+}
+
+/////////////////////////////////////////////////
+void StatsCommand::TopCB(ConstStepTimingPtr &_msg)
+{
+  GZ_ASSERT(_msg, "Invalid message received");
+
+  const common::Time simTime = msgs::Convert(_msg->sim_time());
+  const double window = msgs::Convert(_msg->window()).Double() * 1e3;
+  if (window <= 0)
+    return;
+
+  // Total milliseconds of each stage in the window
+  std::map<std::string, double> stages;
+  for (auto const &stage : _msg->stage())
+    stages[stage.name()] = stage.mean() * stage.count() * 1e-3;
+
+  // Plugin totals are cumulative, the window only owns the difference
+  std::vector<std::pair<double, std::string>> plugins;
+  double pluginsTotal = 0;
+  for (auto const &plugin : _msg->plugin())
+  {
+    double &prev = this->pluginTotals[plugin.name()];
+    const double delta = std::max(0.0, plugin.total() - prev);
+    prev = plugin.total();
+    plugins.push_back(std::make_pair(delta, plugin.name()));
+    pluginsTotal += delta;
+  }
+  std::sort(plugins.rbegin(), plugins.rend());
+
+  // Collision, physics and log capture run inside the update, and so do
+  // most plugin callbacks
+  const double update = stages["update"];
+  const double other = std::max(0.0, update - stages["collision"] -
+      stages["physics"] - stages["log"] - pluginsTotal);
+  const double idle = std::max(0.0, window - update -
+      stages["sensors_wait"] - stages["messages"]);
+
+  const std::vector<std::pair<std::string, double>> rows =
+  {
+    {"collision", stages["collision"]},
+    {"physics", stages["physics"]},
+    {"plugins", pluginsTotal},
+    {"update other", other},
+    {"log", stages["log"]},
+    {"sensors wait", stages["sensors_wait"]},
+    {"messages", stages["messages"]},
+    {"idle", idle}
+  };
+
+  // The first message has no previous sim time to measure against
+  double factor = -1;
+  if (this->topSimTime != common::Time::Zero)
+    factor = (simTime - this->topSimTime).Double() * 1e3 / window;
+  this->topSimTime = simTime;
+
+  if (this->vm.count("plot"))
+  {
+    static bool first = true;
+    if (first)
+    {
+      std::cout << "# simtime (sec), real-time factor";
+      for (auto const &row : rows)
+        std::cout << ", " << row.first << " (msec)";
+      std::cout << ", window (msec)\n";
+      first = false;
+    }
+    printf("%16.6f, %.4f", simTime.Double(), factor);
+    for (auto const &row : rows)
+      printf(", %.3f", row.second);
+    printf(", %.3f\n", window);
+    fflush(stdout);
+    return;
+  }
+
+  // Clear the terminal and draw from the top left corner
+  printf("\033[H\033[2J");
+  if (factor < 0)
+    printf("SimTime[%4.2f] Factor[-]\n\n", simTime.Double());
+  else
+    printf("SimTime[%4.2f] Factor[%4.2f]\n\n", simTime.Double(), factor);
+
+  const int barWidth = 40;
+  printf("  %-13s %10s %7s\n", "subsystem", "ms/s", "share");
+  for (auto const &row : rows)
+  {
+    const double share = row.second / window;
+    const int width = std::min(barWidth,
+        static_cast<int>(share * barWidth + 0.5));
+    printf("  %-13s %10.2f %6.1f%% %s\n", row.first.c_str(),
+        row.second * 1e3 / window, share * 100,
+        std::string(width, '#').c_str());
+  }
+
+  if (!plugins.empty())
+  {
+    printf("\n  %-40s %10s %7s\n", "plugin", "ms/s", "share");
+    const size_t maxPlugins = 10;
+    for (size_t i = 0; i < plugins.size() && i < maxPlugins; ++i)
+    {
+      printf("  %-40s %10.2f %6.1f%%\n", plugins[i].second.c_str(),
+          plugins[i].first * 1e3 / window,
+          plugins[i].first / window * 100);
+    }
+  }
+  fflush(stdout);
+}
+
 /////////////////////////////////////////////////
 SDFCommand::SDFCommand()
   : Command("sdf",
@@ -17,8 +17,9 @@
 #ifndef _GAZEBO_GZ_HH_
 #define _GAZEBO_GZ_HH_
 
-#include <string>
 #include <list>
+#include <map>
+#include <string>
 #include <boost/thread.hpp>
 #include <boost/program_options.hpp>
 #include <ignition/math/Pose3.hh>
@@ -195,6 +196,25 @@ namespace gazebo
     /// \param[in] _msg World statistics message.
     private: void CB(ConstWorldStatisticsPtr &_msg);
 
+    /// \brief Step timing callback.
+    /// \param[in] _msg Step timing message.
+    private: void TimingCB(ConstStepTimingPtr &_msg);
+
+    /// \brief Plugin timing callback.
+    /// \param[in] _msg Step timing message.
+    private: void PluginsCB(ConstStepTimingPtr &_msg);
+
+    /// \brief Live breakdown callback.
+    /// \param[in] _msg Step timing message.
+    private: void TopCB(ConstStepTimingPtr &_msg);
+
+    /// \brief Cumulative time of each plugin in the previous step timing
+    /// message, in milliseconds.
+    private: std::map<std::string, double> pluginTotals;
+
+    /// \brief Sim time of the previous step timing message.
+    private: common::Time topSimTime;
+
     /// \brief Sim time buffer
     private: std::list<common::Time> simTimes;
 
@@ -22,6 +22,14 @@
 #include <boost/iostreams/filtering_stream.hpp>
 #include <boost/iostreams/copy.hpp>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 #include <ignition/math/Pose3.hh>
 #include <ignition/math/Vector3.hh>
 
@@ -533,6 +541,103 @@ StateFilter::StateFilter(bool _xmlOutput, const std::string &_stamp,
 void StateFilter::Init(const std::string &_filter)
 {
   this->filter.Init(_filter);
+
+  // Same model name matching as ModelFilter::Filter
+  this->pruneModels = false;
+  if (!this->filter.parts.empty() && !this->filter.parts.front().empty() &&
+      this->filter.parts.front() != "*")
+  {
+    std::string regexStr = this->filter.parts.front();
+    boost::replace_all(regexStr, "*", ".*");
+    this->modelRegex = boost::regex(regexStr);
+    this->pruneModels = true;
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the position just past the end of an XML element.
+/// \param[in] _xml XML text.
+/// \param[in] _pos Position of the element's opening tag.
+/// \return Position after the element, npos if it is not closed.
+static size_t ElementEnd(const std::string &_xml, size_t _pos)
+{
+  int depth = 0;
+  while (_pos != std::string::npos)
+  {
+    size_t close = _xml.find('>', _pos);
+    if (close == std::string::npos)
+      return close;
+
+    if (_xml[_pos + 1] == '/')
+      --depth;
+    else if (_xml[close - 1] != '/')
+      ++depth;
+
+    if (depth == 0)
+      return close + 1;
+
+    _pos = _xml.find('<', close + 1);
+  }
+  return _pos;
+}
+
+/////////////////////////////////////////////////
+/// \brief Remove the model states whose name does not match a regex from
+/// the text of a state, so they are never parsed.
+/// \param[in] _stateString A frame of a log file.
+/// \param[in] _regex Names of the models to keep.
+/// \return The frame without the other model states.
+static std::string PruneModels(const std::string &_stateString,
+    const boost::regex &_regex)
+{
+  std::string result;
+  result.reserve(_stateString.size());
+
+  // Model states are the <model> children of <state>, inside <sdf>.
+  // The ones in <insertions> are deeper and always kept.
+  int depth = 0;
+  size_t copied = 0;
+  size_t pos = _stateString.find('<');
+  while (pos != std::string::npos)
+  {
+    size_t close = _stateString.find('>', pos);
+    if (close == std::string::npos)
+      break;
+
+    if (depth == 2 && _stateString.compare(pos, 7, "<model ") == 0)
+    {
+      std::string tag = _stateString.substr(pos, close - pos);
+      size_t name = tag.find("name=");
+      std::string modelName;
+      if (name != std::string::npos && name + 6 < tag.size())
+      {
+        size_t nameEnd = tag.find(tag[name + 5], name + 6);
+        modelName = tag.substr(name + 6, nameEnd - name - 6);
+      }
+
+      size_t end = ElementEnd(_stateString, pos);
+      if (end != std::string::npos && !boost::regex_match(modelName, _regex))
+      {
+        result.append(_stateString, copied, pos - copied);
+        copied = end;
+        pos = _stateString.find('<', end);
+        continue;
+      }
+    }
+
+    if (_stateString[pos + 1] == '/')
+      --depth;
+    else if (_stateString[pos + 1] != '?' && _stateString[pos + 1] != '!' &&
+        _stateString[close - 1] != '/')
+    {
+      ++depth;
+    }
+
+    pos = _stateString.find('<', close + 1);
+  }
+
+  result.append(_stateString, copied, std::string::npos);
+  return result;
 }
 
 /////////////////////////////////////////////////
@@ -540,9 +645,27 @@ std::string StateFilter::Filter(const std::string &_stateString)
 {
   gazebo::physics::WorldState state;
 
+  // Skip states that the rate would drop before parsing them
+  if (this->hz > 0.0 && this->prevTime != gazebo::common::Time::Zero)
+  {
+    size_t from = _stateString.find("<sim_time>");
+    size_t to = _stateString.find("</sim_time>");
+    if (from != std::string::npos && to != std::string::npos && from < to)
+    {
+      gazebo::common::Time simTime;
+      std::stringstream ss(_stateString.substr(from + 10, to - from - 10));
+      ss >> simTime;
+      if ((simTime - this->prevTime).Double() < 1.0 / this->hz)
+        return std::string();
+    }
+  }
+
   // Read and parse the state information
   g_stateSdf->Clear();
-  sdf::readString(_stateString, g_stateSdf);
+  if (this->pruneModels)
+    sdf::readString(PruneModels(_stateString, this->modelRegex), g_stateSdf);
+  else
+    sdf::readString(_stateString, g_stateSdf);
   state.Load(g_stateSdf);
 
   std::ostringstream result;
@@ -622,7 +745,17 @@ LogCommand::LogCommand()
      "Valid in conjunction with the output command. See also the "
      "--output argument.")
     ("filter", po::value<std::string>(),
-     "Filter output. Valid only with the echo, step, and output commands");
+     "Filter output. Valid only with the echo, step, and output commands")
+    ("export,x", po::value<std::string>(),
+     "Export entity trajectories to a CSV file, one row per entity and "
+     "state. Chunks of the log are processed in parallel. See also the "
+     "--entities and --fields arguments.")
+    ("entities", po::value<std::string>(),
+     "Regular expression matched against scoped model and link names "
+     "(model::link) to export. Exports every model and link by default.")
+    ("fields", po::value<std::string>(),
+     "Comma separated fields to export: pose, velocity, acceleration, "
+     "wrench. Models only have a pose. Defaults to pose.");
 }
 
 /////////////////////////////////////////////////
@@ -681,8 +814,14 @@ bool LogCommand::RunImpl()
       return false;
     }
 
+    // Filtered XML logs are streamed through a memory map instead of
+    // being parsed as a whole by LogPlay
+    bool stream = ((!filter.empty() &&
+      (this->vm.count("output") || this->vm.count("echo"))) ||
+      this->vm.count("export")) && this->mapReader.Open(filename);
+
     // Load log file from string
-    if (!this->LoadLogFromFile(filename))
+    if (!stream && !this->LoadLogFromFile(filename))
     {
       return false;
     }
@@ -692,7 +831,16 @@ bool LogCommand::RunImpl()
   g_stateSdf.reset(new sdf::Element);
   sdf::initFile("state.sdf", g_stateSdf);
 
-  if (this->vm.count("output"))
+  if (this->vm.count("export"))
+  {
+    std::string entities = this->vm.count("entities") ?
+      this->vm["entities"].as<std::string>() : ".*";
+    std::string fields = this->vm.count("fields") ?
+      this->vm["fields"].as<std::string>() : "pose";
+
+    this->Export(this->vm["export"].as<std::string>(), entities, fields);
+  }
+  else if (this->vm.count("output"))
   {
     std::string encoding = this->vm.count("encoding") ?
       this->vm["encoding"].as<std::string>() : "";
@@ -831,7 +979,7 @@ void LogCommand::Output(const std::string &_outFilename,
   }
 
   gazebo::util::LogPlay *play = gazebo::util::LogPlay::Instance();
-  if (!play->IsOpen())
+  if (!play->IsOpen() && !this->mapReader.IsOpen())
   {
     std::cerr << "No source log file specified. Use the -f command line "
       << "argument.\n";
@@ -840,7 +988,12 @@ void LogCommand::Output(const std::string &_outFilename,
 
   std::string stateString, bufferString;
 
-  std::string encoding = _encoding.empty() ? play->Encoding() : _encoding;
+  std::string encoding = _encoding.empty() ? this->LogEncoding() : _encoding;
+
+  // Binary and zstd logs are converted to zlib chunks, the only codecs
+  // written here are the ones every build can read back
+  if (_encoding.empty() && (encoding == "binary" || encoding == "zstd"))
+    encoding = "zlib";
   if (encoding != "txt" && encoding != "zlib" && encoding != "bz2")
   {
     std::cerr << "Invalid log file encoding[" << encoding << "]. "
@@ -852,7 +1005,7 @@ void LogCommand::Output(const std::string &_outFilename,
   // Output the header
   if (!_raw)
   {
-    std::string header = play->Header();
+    std::string header = this->LogHeader();
     outFile.write(header.c_str(), header.size());
   }
 
@@ -860,7 +1013,7 @@ void LogCommand::Output(const std::string &_outFilename,
   filter.Init(_filter);
 
   unsigned int i = 0;
-  while (play->Step(stateString))
+  while (this->NextFrame(stateString))
   {
     if (i == 0 && !_raw)
     {
@@ -896,18 +1049,17 @@ void LogCommand::Output(const std::string &_outFilename,
 void LogCommand::Echo(const std::string &_filter, bool _raw,
     const std::string &_stamp, double _hz)
 {
-  gazebo::util::LogPlay *play = gazebo::util::LogPlay::Instance();
   std::string stateString;
 
   // Output the header
   if (!_raw)
-    std::cout << play->Header() << std::endl;
+    std::cout << this->LogHeader() << std::endl;
 
   StateFilter filter(!_raw, _stamp, _hz);
   filter.Init(_filter);
 
   unsigned int i = 0;
-  while (play->Step(stateString))
+  while (this->NextFrame(stateString))
   {
     if (i > 0)
       stateString = filter.Filter(stateString);
@@ -980,6 +1132,211 @@ void LogCommand::Step(const std::string &_filter, bool _raw,
     std::cout << "</gazebo_log>\n";
 }
 
+/////////////////////////////////////////////////
+/// \brief Write the columns of a pose, velocity, acceleration or wrench.
+/// \param[in] _pose Value to write, rotation as roll, pitch and yaw.
+/// \param[in] _out Stream to write to.
+static void ExportPose(const ignition::math::Pose3d &_pose,
+    std::ostream &_out)
+{
+  ignition::math::Vector3d euler = _pose.Rot().Euler();
+  _out << ',' << _pose.Pos().X() << ',' << _pose.Pos().Y()
+    << ',' << _pose.Pos().Z() << ',' << euler.X() << ',' << euler.Y()
+    << ',' << euler.Z();
+}
+
+/////////////////////////////////////////////////
+/// \brief Write the rows of a model, its links and nested models.
+/// \param[in] _state State of the model.
+/// \param[in] _prefix Scope of the model, empty or ending with "::".
+/// \param[in] _time Sim time column.
+/// \param[in] _entities Scoped names to export.
+/// \param[in] _fields Fields to export.
+/// \param[in] _out Stream to write to.
+static void ExportModel(const physics::ModelState &_state,
+    const std::string &_prefix, const std::string &_time,
+    const boost::regex &_entities, const std::vector<std::string> &_fields,
+    std::ostream &_out)
+{
+  std::string name = _prefix + _state.GetName();
+  if (boost::regex_match(name, _entities))
+  {
+    _out << _time << ',' << name;
+    for (const auto &field : _fields)
+    {
+      if (field == "pose")
+        ExportPose(_state.Pose(), _out);
+      else
+        _out << ",,,,,,";
+    }
+    _out << '\n';
+  }
+
+  for (const auto &link : _state.GetLinkStates())
+  {
+    std::string linkName = name + "::" + link.second.GetName();
+    if (!boost::regex_match(linkName, _entities))
+      continue;
+
+    _out << _time << ',' << linkName;
+    for (const auto &field : _fields)
+    {
+      if (field == "pose")
+        ExportPose(link.second.Pose(), _out);
+      else if (field == "velocity")
+        ExportPose(link.second.Velocity(), _out);
+      else if (field == "acceleration")
+        ExportPose(link.second.Acceleration(), _out);
+      else
+        ExportPose(link.second.Wrench(), _out);
+    }
+    _out << '\n';
+  }
+
+  for (const auto &nested : _state.NestedModelStates())
+    ExportModel(nested.second, name + "::", _time, _entities, _fields, _out);
+}
+
+/////////////////////////////////////////////////
+/// \brief Write the rows of every state in a decoded chunk.
+/// \param[in] _data Decoded chunk.
+/// \param[in] _entities Scoped names to export.
+/// \param[in] _fields Fields to export.
+/// \param[in] _stateSdf State element to parse into.
+/// \param[in] _out Stream to write to.
+static void ExportChunk(const std::string &_data,
+    const boost::regex &_entities, const std::vector<std::string> &_fields,
+    sdf::ElementPtr _stateSdf, std::ostream &_out)
+{
+  size_t pos = 0;
+  boost::string_ref frame;
+  while (gazebo::util::LogMapReader::NextFrame(_data, pos, frame))
+  {
+    // The world description is not a state
+    if (frame.find("<world") != boost::string_ref::npos)
+      continue;
+
+    _stateSdf->Clear();
+    sdf::readString(frame.to_string(), _stateSdf);
+
+    gazebo::physics::WorldState state;
+    state.Load(_stateSdf);
+
+    std::ostringstream time;
+    time.precision(9);
+    time << std::fixed << state.GetSimTime().Double();
+
+    for (const auto &model : state.GetModelStates())
+    {
+      ExportModel(model.second, "", time.str(), _entities, _fields, _out);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void LogCommand::Export(const std::string &_outFilename,
+    const std::string &_entities, const std::string &_fields)
+{
+  gazebo::util::LogPlay *play = gazebo::util::LogPlay::Instance();
+  if (!play->IsOpen() && !this->mapReader.IsOpen())
+  {
+    std::cerr << "No source log file specified. Use the -f command line "
+      << "argument.\n";
+    return;
+  }
+
+  std::vector<std::string> fields;
+  boost::split(fields, _fields, boost::is_any_of(","));
+  for (const auto &field : fields)
+  {
+    if (field != "pose" && field != "velocity" && field != "acceleration" &&
+        field != "wrench")
+    {
+      std::cerr << "Invalid field[" << field << "]. "
+        << "Use any of: pose, velocity, acceleration, wrench.\n";
+      return;
+    }
+  }
+
+  boost::regex entities;
+  try
+  {
+    entities.assign(_entities);
+  }
+  catch(boost::regex_error &_e)
+  {
+    std::cerr << "Invalid entities expression[" << _entities << "]\n";
+    return;
+  }
+
+  std::ofstream outFile(_outFilename, std::fstream::out);
+  if (!outFile.is_open())
+  {
+    std::cerr << "Unable to open file[" << _outFilename << "] for writing.\n";
+    return;
+  }
+
+  outFile << "sim_time,entity";
+  for (const auto &field : fields)
+  {
+    for (const auto &column : {"x", "y", "z", "roll", "pitch", "yaw"})
+      outFile << ',' << field << '_' << column;
+  }
+  outFile << '\n';
+
+  size_t chunkCount = this->mapReader.IsOpen() ?
+    this->mapReader.ChunkCount() : play->ChunkCount();
+
+  // Mapped chunks decode independently, LogPlay has to be called from one
+  // thread at a time but the states are still parsed in parallel
+  std::mutex playMutex;
+
+  // Chunks are exported in batches, so the rows can be written in order
+  // without holding the whole log in memory
+  const size_t batch =
+    std::max(1u, std::thread::hardware_concurrency()) * 2;
+  std::vector<std::string> rows(batch);
+  std::vector<char> failed(batch);
+
+  for (size_t first = 0; first < chunkCount; first += batch)
+  {
+    size_t last = std::min(chunkCount, first + batch);
+
+    tbb::parallel_for(tbb::blocked_range<size_t>(first, last, 1),
+        [&](const tbb::blocked_range<size_t> &_range)
+    {
+      std::string data;
+      sdf::ElementPtr stateSdf = g_stateSdf->Clone();
+      for (size_t i = _range.begin(); i != _range.end(); ++i)
+      {
+        bool decoded;
+        if (this->mapReader.IsOpen())
+          decoded = this->mapReader.Chunk(i, data);
+        else
+        {
+          std::lock_guard<std::mutex> lock(playMutex);
+          decoded = play->Chunk(static_cast<unsigned int>(i), data);
+        }
+
+        std::ostringstream out;
+        if (decoded)
+          ExportChunk(data, entities, fields, stateSdf, out);
+        rows[i - first] = out.str();
+        failed[i - first] = !decoded;
+      }
+    });
+
+    for (size_t i = first; i < last; ++i)
+    {
+      if (failed[i - first])
+        std::cerr << "Unable to decode chunk[" << i << "]\n";
+      outFile << rows[i - first];
+    }
+  }
+
+  outFile.close();
+}
+
 /////////////////////////////////////////////////
 void LogCommand::Record(bool _start)
 {
@@ -1067,6 +1424,30 @@ bool LogCommand::LoadLogFromFile(const std::string &_filename)
   return true;
 }
 
+/////////////////////////////////////////////////
+bool LogCommand::NextFrame(std::string &_frame)
+{
+  if (this->mapReader.IsOpen())
+    return this->mapReader.Step(_frame);
+  return gazebo::util::LogPlay::Instance()->Step(_frame);
+}
+
+/////////////////////////////////////////////////
+std::string LogCommand::LogHeader() const
+{
+  if (this->mapReader.IsOpen())
+    return this->mapReader.Header().to_string();
+  return gazebo::util::LogPlay::Instance()->Header();
+}
+
+/////////////////////////////////////////////////
+std::string LogCommand::LogEncoding() const
+{
+  if (this->mapReader.IsOpen())
+    return this->mapReader.ChunkEncoding(0).to_string();
+  return gazebo::util::LogPlay::Instance()->Encoding();
+}
+
 /////////////////////////////////////////////////
 void LogCommand::OutputWriter(std::ofstream &_outFile,
     const std::string &_stateString, const bool _raw,
@@ -20,7 +20,10 @@
 #include <string>
 #include <list>
 
+#include <boost/regex.hpp>
+
 #include <gazebo/physics/WorldState.hh>
+#include "gazebo/util/LogMapReader.hh"
 #include "gz.hh"
 
 namespace gazebo
@@ -180,6 +183,13 @@ namespace gazebo
     /// \brief Filter for a model.
     private: ModelFilter filter;
 
+    /// \brief Names of the models to keep, matched against the model
+    /// states before a state is parsed.
+    private: boost::regex modelRegex;
+
+    /// \brief True if the filter keeps only some models.
+    private: bool pruneModels = false;
+
     /// \brief Rate at which to output states.
     private: double hz;
 
@@ -240,6 +250,15 @@ namespace gazebo
     private: void Step(const std::string &_filter, bool _raw,
                  const std::string &_stamp, double _hz);
 
+    /// \brief Export trajectories of models and links to a CSV file.
+    /// \param[in] _outFilename Output filename.
+    /// \param[in] _entities Regular expression of the scoped names of the
+    /// models and links to export.
+    /// \param[in] _fields Comma separated fields to export, among
+    /// (pose, velocity, acceleration, wrench).
+    private: void Export(const std::string &_outFilename,
+                 const std::string &_entities, const std::string &_fields);
+
     /// \brief Start or stop logging
     /// \param[in] _start True to start logging
     private: void Record(bool _start);
@@ -260,6 +279,19 @@ namespace gazebo
     private: bool LoadLogFromFile(const std::string &_filename);
 
 
+    /// \brief Get the next frame of the open log file.
+    /// \param[out] _frame The frame.
+    /// \return False at the end of the log.
+    private: bool NextFrame(std::string &_frame);
+
+    /// \brief Header of the open log file.
+    /// \return The header, up to and excluding the first chunk.
+    private: std::string LogHeader() const;
+
+    /// \brief Encoding of the first chunk of the open log file.
+    /// \return The encoding.
+    private: std::string LogEncoding() const;
+
     /// \brief Write data to a file.
     /// \param[in] _outFile Output file stream reference.
     /// \param[in] _stateString SDF state string to write
@@ -271,6 +303,10 @@ namespace gazebo
 
     /// \brief Node pointer.
     private: gazebo::transport::NodePtr node;
+
+    /// \brief Maps XML logs that are filtered, so they are streamed
+    /// instead of loaded by LogPlay.
+    private: gazebo::util::LogMapReader mapReader;
   };
 }
 #endif
@@ -24,7 +24,9 @@
 #include <sdf/sdf_config.h>
 
 #include <stdio.h>
+#include <fstream>
 #include <string>
+#include <vector>
 
 // This header file isn't needed if shasums are used
 // #include "test/data/pr2_state_log_expected.h"
@@ -474,6 +476,43 @@ TEST(gz_log, Output)
 #endif
 }
 
+/////////////////////////////////////////////////
+/// Check that 'gz log -x' writes one row per selected entity and state
+TEST(gz_log, Export)
+{
+  std::ostringstream csvStream;
+  csvStream << "/tmp/__gz_log_export_test" << std::this_thread::get_id()
+    << ".csv";
+
+  custom_exec(GZ_LOG_PATH + " -x " + csvStream.str() +
+      " --entities pr2 --fields pose -f " + PROJECT_SOURCE_PATH +
+      "/test/data/pr2_state.log");
+
+  std::ifstream csv(csvStream.str());
+  ASSERT_TRUE(csv.is_open());
+
+  std::string line;
+  std::getline(csv, line);
+  EXPECT_EQ(line, "sim_time,entity,pose_x,pose_y,pose_z,pose_roll,"
+      "pose_pitch,pose_yaw");
+
+  std::vector<std::string> rows;
+  while (std::getline(csv, line))
+    rows.push_back(line);
+
+  // pr2_state.log holds two states after the world description
+  ASSERT_EQ(rows.size(), 2u);
+  EXPECT_NE(rows[0].find(",pr2,"), std::string::npos);
+  EXPECT_NE(rows[1].find(",pr2,"), std::string::npos);
+
+  // Invalid fields write nothing
+  std::remove(csvStream.str().c_str());
+  custom_exec(GZ_LOG_PATH + " -x " + csvStream.str() +
+      " --fields color -f " + PROJECT_SOURCE_PATH +
+      "/test/data/pr2_state.log");
+  EXPECT_FALSE(std::ifstream(csvStream.str()).is_open());
+}
+
 /////////////////////////////////////////////////
 /// Main
 int main(int argc, char **argv)
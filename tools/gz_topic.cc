@@ -14,6 +14,11 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <iomanip>
+#include <utility>
+#include <vector>
+
 #include <google/protobuf/text_format.h>
 
 #include <gazebo/gui/qt.h>
@@ -52,11 +57,14 @@ TopicCommand::TopicCommand()
      "View topic data using a QT widget.")
     ("hz,z", po::value<std::string>(), "Get publish frequency.")
     ("bw,b", po::value<std::string>(), "Get topic bandwidth.")
+    ("latency,y", po::value<std::string>(), "Get the latency of each stage "
+     "of the messages on a topic. The publishing process must run with "
+     "GAZEBO_TRANSPORT_TRACE=1.")
     ("publish,p", po::value<std::string>(), "Publish message on a topic.")
     ("request,r", po::value<std::string>(), "Send a request.")
     ("unformatted,u", "Output data from echo without formatting.")
     ("duration,d", po::value<uint64_t>(), "Duration (seconds) to run. "
-     "Applicable with echo, hz, and bw")
+     "Applicable with echo, hz, bw, and latency")
     ("msg,m", po::value<std::string>(), "Message to send on topic. "
      "Applicable with publish and request")
     ("file,f", po::value<std::string>(), "Path to a file containing the "
@@ -96,6 +104,8 @@ bool TopicCommand::RunImpl()
     this->Hz(this->vm["hz"].as<std::string>());
   else if (this->vm.count("bw"))
     this->Bw(this->vm["bw"].as<std::string>());
+  else if (this->vm.count("latency"))
+    this->Latency(this->vm["latency"].as<std::string>());
   else if (this->vm.count("view"))
     this->View(this->vm["view"].as<std::string>());
   else if (this->vm.count("publish"))
@@ -347,6 +357,94 @@ void TopicCommand::Bw(const std::string &_topic)
     this->sigCondition.wait(lock);
 }
 
+/////////////////////////////////////////////////
+/// \brief Get a percentile of sorted values.
+/// \param[in] _sorted Values in ascending order, not empty.
+/// \param[in] _p Percentile in [0, 1].
+/// \return The value.
+static double Percentile(const std::vector<double> &_sorted, const double _p)
+{
+  std::size_t index = static_cast<std::size_t>(_p * _sorted.size());
+  return _sorted[std::min(index, _sorted.size() - 1)];
+}
+
+/////////////////////////////////////////////////
+void TopicCommand::LatencyCB(const std::string &_data)
+{
+  common::Time curTime = common::Time::GetWallTime();
+
+  // Latency of each stage since the previous one, in milliseconds
+  std::vector<msgs::TraceStamp> stamps = transport::TraceStamps::Read(_data);
+  for (std::size_t i = 1; i < stamps.size(); ++i)
+  {
+    this->latencies[std::make_pair(stamps[i - 1].stage(),
+        stamps[i].stage())].push_back(
+        (stamps[i].wall_ns() - stamps[i - 1].wall_ns()) * 1e-6);
+  }
+  if (stamps.size() > 2)
+  {
+    this->latencyTotal.push_back(
+        (stamps.back().wall_ns() - stamps.front().wall_ns()) * 1e-6);
+  }
+  else if (!this->latencyWarned)
+  {
+    // Only this process stamped the message
+    std::cerr << "Messages are not stamped by the publisher, run it with "
+              << "GAZEBO_TRANSPORT_TRACE=1\n";
+    this->latencyWarned = true;
+  }
+
+  // One second time window
+  if (curTime - this->prevMsgTime <= common::Time(1, 0))
+    return;
+  this->prevMsgTime = curTime;
+
+  auto print = [](const std::string &_name, std::vector<double> &_values)
+  {
+    std::sort(_values.begin(), _values.end());
+    std::cout << std::setw(28) << std::left << _name << std::right
+              << std::fixed << std::setprecision(3)
+              << std::setw(10) << Percentile(_values, 0.5)
+              << std::setw(10) << Percentile(_values, 0.9)
+              << std::setw(10) << Percentile(_values, 0.99)
+              << std::setw(10) << _values.back() << "\n";
+  };
+
+  std::cout << "Messages[" << this->latencyTotal.size() << "]\n"
+            << std::setw(28) << std::left << "  latency (ms)" << std::right
+            << std::setw(10) << "p50" << std::setw(10) << "p90"
+            << std::setw(10) << "p99" << std::setw(10) << "max" << "\n";
+  for (auto &latency : this->latencies)
+  {
+    print("  " + transport::TraceStamps::StageName(latency.first.first) +
+        " -> " + transport::TraceStamps::StageName(latency.first.second),
+        latency.second);
+  }
+  if (!this->latencyTotal.empty())
+    print("  total", this->latencyTotal);
+
+  this->latencies.clear();
+  this->latencyTotal.clear();
+}
+
+/////////////////////////////////////////////////
+void TopicCommand::Latency(const std::string &_topic)
+{
+  // Stamp the receive and callback stages in this process
+  transport::TraceStamps::SetEnabled(true);
+
+  this->prevMsgTime = common::Time::GetWallTime();
+  transport::SubscriberPtr sub = node->Subscribe(_topic,
+      &TopicCommand::LatencyCB, this);
+
+  boost::mutex::scoped_lock lock(this->sigMutex);
+  if (this->vm.count("duration"))
+    this->sigCondition.timed_wait(lock,
+        boost::posix_time::seconds(this->vm["duration"].as<uint64_t>()));
+  else
+    this->sigCondition.wait(lock);
+}
+
 /////////////////////////////////////////////////
 void TopicCommand::View(const std::string &_topic)
 {
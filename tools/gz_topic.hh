@@ -17,7 +17,9 @@
 #ifndef _GZ_TOPIC_HH_
 #define _GZ_TOPIC_HH_
 
+#include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "gz.hh"
@@ -72,6 +74,15 @@ namespace gazebo
     /// \param[in] _topic Topic name.
     private: void Bw(const std::string &_topic);
 
+    /// \brief Subscription callback used by Latency().
+    /// \param[in] _data Message data.
+    private: void LatencyCB(const std::string &_data);
+
+    /// \brief Output the latency of each stage of the messages on a
+    /// topic, from their trace stamps, see transport::TraceStamps.
+    /// \param[in] _topic Topic name.
+    private: void Latency(const std::string &_topic);
+
     /// \brief View topic information using QT.
     /// \param[in] _topic Name of the topic to view. Empty will bring up
     /// a topic selector.
@@ -103,6 +114,18 @@ namespace gazebo
 
     /// \brief Buffer of message publish times, used by Bw().
     private: std::vector<common::Time> bwTime;
+
+    /// \brief Latencies in milliseconds between consecutive stages of the
+    /// messages of the current window, used by Latency().
+    private: std::map<std::pair<msgs::TraceStamp::Stage,
+             msgs::TraceStamp::Stage>, std::vector<double>> latencies;
+
+    /// \brief Latencies in milliseconds from the first to the last stamp
+    /// of the messages of the current window, used by Latency().
+    private: std::vector<double> latencyTotal;
+
+    /// \brief True once the warning about unstamped messages was printed.
+    private: bool latencyWarned = false;
   };
 }
 #endif
@@ -0,0 +1,229 @@
+#!/usr/bin/env python3
+#
+# Copyright (C) 2026 Open Source Robotics Foundation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+"""Compare the performance reports of two sets of runs.
+
+The reports are the JSON documents that the performance targets write to
+GAZEBO_PERFORMANCE_REPORT_DIR, see test/performance/PerformanceReport.hh.
+Each argument is a report or a directory of reports. Passing several runs
+of the same targets, for example one directory per run, lets the noise of
+the machine be measured; a single run falls back to the raw samples of the
+metrics that have them.
+
+A metric regresses when it got worse by more than both the relative
+threshold and the given number of noise deviations, so that a noisy
+machine does not flag random changes.
+
+  perf_compare.py --baseline base1 base2 base3 --current run1
+  perf_compare.py --history perf.jsonl --current run1
+
+With --history, the current medians are appended to the file as one JSON
+line, and when no --baseline is given, the last --window entries of the
+file are the baseline. This tracks trends on a CI machine.
+
+The exit code is 1 if a metric regressed.
+"""
+
+import argparse
+import json
+import math
+import os
+import statistics
+import sys
+import time
+
+
+def load_reports(paths):
+    """Load the reports of files and directories of files."""
+    reports = []
+    for path in paths:
+        if os.path.isdir(path):
+            files = sorted(os.path.join(path, name)
+                           for name in os.listdir(path)
+                           if name.endswith('.json'))
+        else:
+            files = [path]
+        for filename in files:
+            with open(filename) as f:
+                report = json.load(f)
+            if report.get('schema') != 1:
+                sys.stderr.write('Skipping %s, unknown schema\n' % filename)
+                continue
+            reports.append(report)
+    return reports
+
+
+def collect(reports):
+    """Group the metrics of reports by target, test and name."""
+    metrics = {}
+    for report in reports:
+        for metric in report['metrics']:
+            if metric['value'] is None:
+                continue
+            key = (report['target'], metric['test'], metric['name'])
+            entry = metrics.setdefault(key, {
+                'unit': metric['unit'],
+                'better': metric['better'],
+                'values': [],
+                'samples': [],
+            })
+            entry['values'].append(metric['value'])
+            entry['samples'].extend(
+                s for s in metric.get('samples', []) if s is not None)
+    return metrics
+
+
+def load_history(filename, window):
+    """Get the last entries of a history file as baseline metrics."""
+    if not os.path.exists(filename):
+        return {}
+    with open(filename) as f:
+        entries = [json.loads(line) for line in f if line.strip()]
+    metrics = {}
+    for entry in entries[-window:]:
+        for metric in entry['metrics']:
+            key = (metric['target'], metric['test'], metric['name'])
+            metrics.setdefault(key, {
+                'unit': metric['unit'],
+                'better': metric['better'],
+                'values': [],
+                'samples': [],
+            })['values'].append(metric['value'])
+    return metrics
+
+
+def robust_sigma(values):
+    """Standard deviation estimated from the median absolute deviation."""
+    if len(values) < 2:
+        return 0.0
+    median = statistics.median(values)
+    return 1.4826 * statistics.median(abs(v - median) for v in values)
+
+
+def noise(entry):
+    """Standard error of the median value of a metric."""
+    if len(entry['values']) >= 3:
+        return robust_sigma(entry['values'])
+    if len(entry['samples']) >= 3:
+        # Standard error of the median of the samples
+        return (1.2533 * robust_sigma(entry['samples']) /
+                math.sqrt(len(entry['samples'])))
+    return 0.0
+
+
+def compare(baseline, current, threshold, deviations):
+    """Compare two sets of metrics, return rows of results."""
+    rows = []
+    for key in sorted(set(baseline) | set(current)):
+        if key not in current:
+            rows.append((key, None, None, None, 'missing'))
+            continue
+        cur = current[key]
+        cur_value = statistics.median(cur['values'])
+        if key not in baseline:
+            rows.append((key, None, cur_value, None, 'new'))
+            continue
+        base = baseline[key]
+        base_value = statistics.median(base['values'])
+
+        delta = cur_value - base_value
+        change = delta / abs(base_value) if base_value else math.inf
+        # Positive when the metric got worse
+        worse = delta if cur['better'] == 'lower' else -delta
+        tolerance = max(threshold * abs(base_value),
+                        deviations * math.hypot(noise(base), noise(cur)))
+        if worse > tolerance:
+            status = 'REGRESSION'
+        elif -worse > tolerance:
+            status = 'improved'
+        else:
+            status = 'ok'
+        rows.append((key, base_value, cur_value, change, status))
+    return rows
+
+
+def append_history(filename, current):
+    """Append the medians of the current metrics to a history file."""
+    entry = {
+        'time': time.strftime('%Y-%m-%dT%H:%M:%SZ', time.gmtime()),
+        'metrics': [{
+            'target': key[0],
+            'test': key[1],
+            'name': key[2],
+            'value': statistics.median(entry['values']),
+            'unit': entry['unit'],
+            'better': entry['better'],
+        } for key, entry in sorted(current.items())],
+    }
+    with open(filename, 'a') as f:
+        f.write(json.dumps(entry) + '\n')
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('--baseline', nargs='+', default=[],
+                        help='Reports or directories of the baseline runs.')
+    parser.add_argument('--current', nargs='+', required=True,
+                        help='Reports or directories of the current runs.')
+    parser.add_argument('--history',
+                        help='File of past results to compare with and to '
+                             'append the current results to.')
+    parser.add_argument('--window', type=int, default=10,
+                        help='Number of history entries used as baseline.')
+    parser.add_argument('--threshold', type=float, default=0.1,
+                        help='Relative change ignored as noise.')
+    parser.add_argument('--deviations', type=float, default=3.0,
+                        help='Number of noise deviations ignored.')
+    parser.add_argument('--json', action='store_true',
+                        help='Print the results as JSON.')
+    args = parser.parse_args()
+
+    current = collect(load_reports(args.current))
+    if args.baseline:
+        baseline = collect(load_reports(args.baseline))
+    elif args.history:
+        baseline = load_history(args.history, args.window)
+    else:
+        parser.error('either --baseline or --history is required')
+
+    rows = compare(baseline, current, args.threshold, args.deviations)
+
+    if args.json:
+        print(json.dumps([{
+            'target': key[0], 'test': key[1], 'name': key[2],
+            'baseline': base, 'current': cur, 'change': change,
+            'status': status,
+        } for key, base, cur, change, status in rows], indent=2))
+    else:
+        def fmt(value):
+            return '-' if value is None else '%.4g' % value
+        for key, base, cur, change, status in rows:
+            unit = (current.get(key) or baseline.get(key))['unit']
+            print('%-10s %s %s %s: %s -> %s %s (%s)' % (
+                status, key[0], key[1], key[2], fmt(base), fmt(cur), unit,
+                '-' if change is None else '%+.1f%%' % (100 * change)))
+
+    if args.history:
+        append_history(args.history, current)
+
+    regressions = [row for row in rows if row[4] == 'REGRESSION']
+    return 1 if regressions else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())